@@ -78,6 +78,9 @@ public:
                 kfree_sized((void*)chunk, m_chunk_size);
             }
         });
+        m_head_chunk = 0;
+        m_current_chunk = 0;
+        m_byte_offset_into_current_chunk = 0;
     }
 
 protected:
@@ -179,15 +182,14 @@ public:
     void destroy_all()
     {
         this->for_each_chunk([&](auto chunk) {
-            auto base_ptr = align_up_to(chunk + sizeof(typename Allocator::ChunkHeader), alignof(T));
-            // Compute the offset of the first byte *after* this chunk:
-            FlatPtr end_offset = base_ptr + this->m_chunk_size - chunk - sizeof(typename Allocator::ChunkHeader);
+            auto base_offset = align_up_to(chunk + sizeof(typename Allocator::ChunkHeader), alignof(T)) - chunk;
+            // Objects are packed back to back from the base, so every object that fits before the end is a valid one.
+            // Filled chunks end at the chunk size, the current chunk ends wherever the last allocation did.
+            FlatPtr end_offset = this->m_chunk_size;
             if (chunk == this->m_current_chunk)
                 end_offset = this->m_byte_offset_into_current_chunk;
-            // Compute the offset of the first byte *after* the last valid object, in case the end of the chunk does not align with the end of an object:
-            end_offset = (end_offset / sizeof(T)) * sizeof(T);
-            for (; base_ptr - chunk < end_offset; base_ptr += sizeof(T))
-                reinterpret_cast<T*>(base_ptr)->~T();
+            for (auto offset = base_offset; offset + sizeof(T) <= end_offset; offset += sizeof(T))
+                reinterpret_cast<T*>(chunk + offset)->~T();
         });
     }
 };
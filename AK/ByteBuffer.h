@@ -179,6 +179,20 @@ public:
         m_size = 0;
     }
 
+    // Like clear(), but keeps the storage around for whatever is appended next.
+    void clear_with_capacity()
+    {
+        m_size = 0;
+    }
+
+    // Removes `count` bytes starting at `offset`, moving whatever follows them down, without giving up any capacity.
+    void remove(size_t offset, size_t count)
+    {
+        VERIFY(offset + count <= m_size);
+        __builtin_memmove(data() + offset, data() + offset + count, m_size - offset - count);
+        m_size -= count;
+    }
+
     enum class ZeroFillNewElements {
         No,
         Yes,
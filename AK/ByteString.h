@@ -296,7 +296,13 @@ public:
     template<Arithmetic T>
     [[nodiscard]] static ByteString number(T value)
     {
-        return formatted("{}", value);
+        // OPTIMIZATION: Integers skip the format machinery and go straight into the string's storage.
+        if constexpr (Detail::DecimalFormattableInteger<T>) {
+            char buffer[Detail::max_decimal_integer_length];
+            return ByteString { Detail::format_decimal_integer(value, buffer) };
+        } else {
+            return formatted("{}", value);
+        }
     }
 
     [[nodiscard]] StringView view() const& { return { characters(), length() }; }
@@ -17,6 +17,10 @@ public:
         : m_value(adopt_ref(*new T))
     {
     }
+    CopyOnWrite(NonnullRefPtr<T> value)
+        : m_value(move(value))
+    {
+    }
     T& mutable_value()
     {
         if (m_value->ref_count() > 1)
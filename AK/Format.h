@@ -355,6 +355,42 @@ struct StandardFormatter {
     void parse(TypeErasedFormatParams&, FormatParser&);
 };
 
+namespace Detail {
+
+// The longest decimal integer is -9223372036854775808, which has 19 digits plus a sign; u64's maximum has 20 digits.
+static constexpr size_t max_decimal_integer_length = 20;
+
+// Integers that "{}" formats as plain decimal numbers, as opposed to characters or booleans.
+template<typename T>
+concept DecimalFormattableInteger = Integral<T> && !OneOfIgnoringCV<T, bool, char, wchar_t>;
+
+// Writes value the way "{}" would, into the end of buffer, and returns a view of the written part.
+template<DecimalFormattableInteger T>
+constexpr StringView format_decimal_integer(T value, char (&buffer)[max_decimal_integer_length])
+{
+    using UnsignedT = MakeUnsigned<RemoveCV<T>>;
+    bool is_negative = false;
+    auto magnitude = static_cast<UnsignedT>(value);
+    if constexpr (IsSigned<T>) {
+        if (value < 0) {
+            is_negative = true;
+            magnitude = static_cast<UnsignedT>(0 - magnitude);
+        }
+    }
+
+    size_t start = max_decimal_integer_length;
+    do {
+        buffer[--start] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (is_negative)
+        buffer[--start] = '-';
+
+    return { buffer + start, max_decimal_integer_length - start };
+}
+
+}
+
 template<Integral T>
 struct Formatter<T> : StandardFormatter {
     Formatter() = default;
@@ -95,6 +95,9 @@ class HashTable;
 template<typename T, typename TraitsForT = Traits<T>>
 using OrderedHashTable = HashTable<T, TraitsForT, true>;
 
+template<typename T, typename TraitsForT = Traits<T>>
+class SwissHashTable;
+
 template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>, bool IsOrdered = false>
 class HashMap;
 
@@ -191,6 +194,7 @@ using AK::String;
 using AK::StringBuilder;
 using AK::StringImpl;
 using AK::StringView;
+using AK::SwissHashTable;
 using AK::TrailingCodePointTransformation;
 using AK::Traits;
 using AK::UnixDateTime;
@@ -18,6 +18,18 @@ constexpr bool is_space(int ch)
     return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
 }
 
+// Returns whether any byte of the word is a quotation mark, a reverse solidus or a control character.
+static constexpr bool word_may_need_escape_handling(FlatPtr word)
+{
+    constexpr FlatPtr ones = explode_byte(0x01);
+    constexpr FlatPtr high_bits = explode_byte(0x80);
+
+    auto has_zero_byte = [&](FlatPtr value) { return (value - ones) & ~value & high_bits; };
+    auto has_byte_less_than_space = (word - explode_byte(0x20)) & ~word & high_bits;
+
+    return has_zero_byte(word ^ explode_byte('"')) || has_zero_byte(word ^ explode_byte('\\')) || has_byte_less_than_space;
+}
+
 // ECMA-404 9 String
 // Boils down to
 // STRING = "\"" *("[^\"\\]" | "\\" ("[\"\\bfnrt]" | "u[0-9A-Za-z]{4}")) "\""
@@ -46,6 +58,17 @@ ErrorOr<ByteString> JsonParser::consume_and_unescape_string()
         //       hence we don't need to bother with a code-point iterator,
         //       as a simple byte iterator suffices, which GenericLexer provides by default
         size_t literal_characters = 0;
+
+        // OPTIMIZATION: Skip over a machine word's worth of bytes at a time while none of them need a closer look.
+        auto remaining_input = m_input.substring_view(m_index);
+        while (literal_characters + sizeof(FlatPtr) <= remaining_input.length()) {
+            FlatPtr word;
+            __builtin_memcpy(&word, remaining_input.characters_without_null_termination() + literal_characters, sizeof(word));
+            if (word_may_need_escape_handling(word))
+                break;
+            literal_characters += sizeof(word);
+        }
+
         for (;;) {
             char ch = peek(literal_characters);
             // Note: We get a 0 byte when we hit EOF
@@ -61,7 +84,7 @@ ErrorOr<ByteString> JsonParser::consume_and_unescape_string()
                 break;
             ++literal_characters;
         }
-        final_sb.append(consume(literal_characters));
+        auto literal = consume(literal_characters);
 
         // We have checked all cases except end-of-string and escaped characters in the loop above,
         // so we now only have to handle those two cases
@@ -69,9 +92,15 @@ ErrorOr<ByteString> JsonParser::consume_and_unescape_string()
 
         if (ch == '"') {
             consume();
+            // OPTIMIZATION: Strings without any escapes (i.e. most of them) don't need to go through a StringBuilder.
+            if (final_sb.is_empty())
+                return ByteString { literal };
+            final_sb.append(literal);
             break;
         }
 
+        final_sb.append(literal);
+
         ignore(); // '\'
 
         switch (peek()) {
@@ -176,7 +176,13 @@ public:
     template<Arithmetic T>
     [[nodiscard]] static String number(T value)
     {
-        return MUST(formatted("{}", value));
+        // OPTIMIZATION: Integers skip the format machinery. Most of them fit in a short string and don't allocate at all.
+        if constexpr (Detail::DecimalFormattableInteger<T>) {
+            char buffer[Detail::max_decimal_integer_length];
+            return from_utf8_without_validation(Detail::format_decimal_integer(value, buffer).bytes());
+        } else {
+            return MUST(formatted("{}", value));
+        }
     }
 
     template<Arithmetic T>
@@ -17,6 +17,8 @@
 #include <AK/Utf16View.h>
 #include <AK/Utf32View.h>
 
+#include <simdutf.h>
+
 namespace AK {
 
 static constexpr auto STRING_BASE_PREFIX_SIZE = sizeof(Detail::StringData);
@@ -224,12 +226,55 @@ void StringBuilder::append_code_point(u32 code_point)
 
 ErrorOr<void> StringBuilder::try_append(Utf16View const& utf16_view)
 {
-    for (size_t i = 0; i < utf16_view.length_in_code_units();) {
-        auto code_point = utf16_view.code_point_at(i);
-        TRY(try_append_code_point(code_point));
+    // Transcode each run of valid UTF-16 in bulk, and only append the lonely surrogates between runs one at a time.
+    auto remaining = utf16_view;
+
+    while (!remaining.is_empty()) {
+        size_t valid_code_units = 0;
+        if (remaining.validate(valid_code_units))
+            valid_code_units = remaining.length_in_code_units();
+
+        if (valid_code_units > 0) {
+            auto const* data = remaining.char_data();
+
+            auto utf8_length = [&]() {
+                switch (remaining.endianness()) {
+                case Endianness::Host:
+                    return simdutf::utf8_length_from_utf16(data, valid_code_units);
+                case Endianness::Big:
+                    return simdutf::utf8_length_from_utf16be(data, valid_code_units);
+                case Endianness::Little:
+                    return simdutf::utf8_length_from_utf16le(data, valid_code_units);
+                }
+                VERIFY_NOT_REACHED();
+            }();
+
+            TRY(will_append(utf8_length));
+            auto offset = m_buffer.size();
+            TRY(m_buffer.try_resize(offset + utf8_length));
+            auto* output = reinterpret_cast<char*>(m_buffer.data() + offset);
+
+            [[maybe_unused]] auto result = [&]() {
+                switch (remaining.endianness()) {
+                case Endianness::Host:
+                    return simdutf::convert_valid_utf16_to_utf8(data, valid_code_units, output);
+                case Endianness::Big:
+                    return simdutf::convert_valid_utf16be_to_utf8(data, valid_code_units, output);
+                case Endianness::Little:
+                    return simdutf::convert_valid_utf16le_to_utf8(data, valid_code_units, output);
+                }
+                VERIFY_NOT_REACHED();
+            }();
+            ASSERT(result == utf8_length);
+        }
 
-        i += (code_point > 0xffff ? 2 : 1);
+        if (valid_code_units == remaining.length_in_code_units())
+            break;
+
+        TRY(try_append_code_point(remaining.code_unit_at(valid_code_units)));
+        remaining = remaining.substring_view(valid_code_units + 1);
     }
+
     return {};
 }
 
@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Concepts.h>
+#include <AK/Error.h>
+#include <AK/HashTable.h>
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Traits.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
+
+namespace AK {
+
+namespace Detail {
+
+// A control byte describes one slot of a SwissHashTable:
+// - Empty (0x80) and Deleted (0xfe) have their high bit set,
+// - Full slots store the top 7 bits of their value's hash (0x00..0x7f).
+static constexpr u8 swiss_control_empty = 0x80;
+static constexpr u8 swiss_control_deleted = 0xfe;
+
+// A window of 16 consecutive control bytes, which are matched against a single byte all at once.
+// Every match returns a bitmask where bit N is set if control byte N matched.
+class SwissGroup {
+public:
+    static constexpr size_t width = 16;
+
+    explicit SwissGroup(u8 const* control)
+#if defined(__SSE2__)
+        : m_control(_mm_loadu_si128(reinterpret_cast<__m128i const*>(control)))
+    {
+    }
+#else
+    {
+        __builtin_memcpy(m_control, control, width);
+    }
+#endif
+
+    ALWAYS_INLINE u16 match(u8 byte) const
+    {
+#if defined(__SSE2__)
+        return static_cast<u16>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_control, _mm_set1_epi8(static_cast<char>(byte)))));
+#else
+        u16 mask = 0;
+        for (size_t i = 0; i < width; ++i)
+            mask |= static_cast<u16>(m_control[i] == byte) << i;
+        return mask;
+#endif
+    }
+
+    ALWAYS_INLINE u16 match_empty() const { return match(swiss_control_empty); }
+
+    ALWAYS_INLINE u16 match_empty_or_deleted() const
+    {
+#if defined(__SSE2__)
+        return static_cast<u16>(_mm_movemask_epi8(m_control));
+#else
+        u16 mask = 0;
+        for (size_t i = 0; i < width; ++i)
+            mask |= static_cast<u16>(m_control[i] >> 7) << i;
+        return mask;
+#endif
+    }
+
+private:
+#if defined(__SSE2__)
+    __m128i m_control;
+#else
+    u8 m_control[width];
+#endif
+};
+
+}
+
+template<typename SwissHashTableType, typename T>
+class SwissHashTableIterator {
+    friend SwissHashTableType;
+
+public:
+    bool operator==(SwissHashTableIterator const& other) const { return m_control == other.m_control; }
+    bool operator!=(SwissHashTableIterator const& other) const { return m_control != other.m_control; }
+    T& operator*() { return *m_slot; }
+    T* operator->() { return m_slot; }
+    void operator++()
+    {
+        ++m_control;
+        ++m_slot;
+        skip_to_full();
+    }
+
+private:
+    SwissHashTableIterator(u8 const* control, u8 const* control_end, T* slot)
+        : m_control(control)
+        , m_control_end(control_end)
+        , m_slot(slot)
+    {
+    }
+
+    void skip_to_full()
+    {
+        while (m_control != m_control_end && (*m_control & Detail::swiss_control_empty)) {
+            ++m_control;
+            ++m_slot;
+        }
+    }
+
+    u8 const* m_control { nullptr };
+    u8 const* m_control_end { nullptr };
+    T* m_slot { nullptr };
+};
+
+// A set datastructure based on a hash table with closed hashing, laid out like Abseil's "Swiss tables".
+// The hash of each value is split in two: the low bits pick the group of slots to start probing at, and the top 7 bits
+// are stored in a control byte per slot, separately from the values. A lookup compares 16 control bytes at a time and
+// only touches the values whose control byte matched.
+// This is an alternative to HashTable for unordered sets with large numbers of lookups, and offers the same interface
+// minus ordered iteration. Unlike HashTable, removal leaves a tombstone behind and never moves other values around.
+template<typename T, typename TraitsForT>
+class SwissHashTable {
+    static constexpr size_t group_width = Detail::SwissGroup::width;
+
+public:
+    SwissHashTable() = default;
+    explicit SwissHashTable(size_t capacity) { ensure_capacity(capacity); }
+
+    ~SwissHashTable()
+    {
+        if (!m_control)
+            return;
+
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (auto& value : *this)
+                value.~T();
+        }
+
+        kfree_sized(m_control, size_in_bytes(m_capacity));
+    }
+
+    SwissHashTable(SwissHashTable const& other)
+    {
+        ensure_capacity(other.size());
+        for (auto& it : other)
+            set(it);
+    }
+
+    SwissHashTable& operator=(SwissHashTable const& other)
+    {
+        SwissHashTable temporary(other);
+        swap(*this, temporary);
+        return *this;
+    }
+
+    SwissHashTable(SwissHashTable&& other) noexcept
+        : m_control(exchange(other.m_control, nullptr))
+        , m_slots(exchange(other.m_slots, nullptr))
+        , m_size(exchange(other.m_size, 0))
+        , m_capacity(exchange(other.m_capacity, 0))
+        , m_growth_left(exchange(other.m_growth_left, 0))
+    {
+    }
+
+    SwissHashTable& operator=(SwissHashTable&& other) noexcept
+    {
+        SwissHashTable temporary { move(other) };
+        swap(*this, temporary);
+        return *this;
+    }
+
+    friend void swap(SwissHashTable& a, SwissHashTable& b) noexcept
+    {
+        swap(a.m_control, b.m_control);
+        swap(a.m_slots, b.m_slots);
+        swap(a.m_size, b.m_size);
+        swap(a.m_capacity, b.m_capacity);
+        swap(a.m_growth_left, b.m_growth_left);
+    }
+
+    [[nodiscard]] bool is_empty() const { return m_size == 0; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    ErrorOr<void> try_ensure_capacity(size_t capacity)
+    {
+        if (capacity <= m_size + m_growth_left)
+            return {};
+        return try_rehash(capacity_for_size(capacity));
+    }
+    void ensure_capacity(size_t capacity)
+    {
+        MUST(try_ensure_capacity(capacity));
+    }
+
+    [[nodiscard]] bool contains(T const& value) const
+    {
+        return find(value) != end();
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] bool contains(K const& value) const
+    {
+        return find(value) != end();
+    }
+
+    using Iterator = SwissHashTableIterator<SwissHashTable, T>;
+
+    [[nodiscard]] Iterator begin()
+    {
+        Iterator iterator(m_control, m_control + m_capacity, m_slots);
+        iterator.skip_to_full();
+        return iterator;
+    }
+
+    [[nodiscard]] Iterator end()
+    {
+        return Iterator(m_control + m_capacity, m_control + m_capacity, m_slots + m_capacity);
+    }
+
+    using ConstIterator = SwissHashTableIterator<SwissHashTable const, T const>;
+
+    [[nodiscard]] ConstIterator begin() const
+    {
+        ConstIterator iterator(m_control, m_control + m_capacity, m_slots);
+        iterator.skip_to_full();
+        return iterator;
+    }
+
+    [[nodiscard]] ConstIterator end() const
+    {
+        return ConstIterator(m_control + m_capacity, m_control + m_capacity, m_slots + m_capacity);
+    }
+
+    void clear()
+    {
+        *this = SwissHashTable();
+    }
+
+    void clear_with_capacity()
+    {
+        if (m_capacity == 0)
+            return;
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (auto& value : *this)
+                value.~T();
+        }
+        __builtin_memset(m_control, Detail::swiss_control_empty, m_capacity + group_width);
+        m_size = 0;
+        m_growth_left = growth_for_capacity(m_capacity);
+    }
+
+    template<typename U = T>
+    ErrorOr<HashSetResult> try_set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        auto hash = TraitsForT::hash(value);
+        if (auto* slot = lookup_with_hash(hash, [&](auto& entry) { return TraitsForT::equals(entry, static_cast<T const&>(value)); })) {
+            if (existing_entry_behavior == HashSetExistingEntryBehavior::Replace) {
+                *slot = forward<U>(value);
+                return HashSetResult::ReplacedExistingEntry;
+            }
+            return HashSetResult::KeptExistingEntry;
+        }
+
+        if (m_growth_left == 0) {
+            // If at least half of the used slots are tombstones, rehashing at the same capacity gets rid of them.
+            // Otherwise, double the capacity.
+            auto new_capacity = m_capacity;
+            if (m_size >= growth_for_capacity(m_capacity) / 2)
+                new_capacity = max(m_capacity * 2, group_width);
+            TRY(try_rehash(new_capacity));
+        }
+
+        auto index = find_insert_index(hash);
+        if (m_control[index] == Detail::swiss_control_empty)
+            --m_growth_left;
+        new (&m_slots[index]) T(forward<U>(value));
+        set_control(index, tag_for_hash(hash));
+        ++m_size;
+        return HashSetResult::InsertedNewEntry;
+    }
+    template<typename U = T>
+    HashSetResult set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        return MUST(try_set(forward<U>(value), existing_entry_behavior));
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] Iterator find(unsigned hash, TUnaryPredicate predicate)
+    {
+        return iterator_for_slot<Iterator>(lookup_with_hash(hash, move(predicate)));
+    }
+
+    [[nodiscard]] Iterator find(T const& value)
+    {
+        return find(TraitsForT::hash(value), [&](auto& entry) { return TraitsForT::equals(entry, value); });
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] ConstIterator find(unsigned hash, TUnaryPredicate predicate) const
+    {
+        return iterator_for_slot<ConstIterator>(lookup_with_hash(hash, move(predicate)));
+    }
+
+    [[nodiscard]] ConstIterator find(T const& value) const
+    {
+        return find(TraitsForT::hash(value), [&](auto& entry) { return TraitsForT::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] Iterator find(K const& value)
+    {
+        return find(Traits<K>::hash(value), [&](auto& entry) { return Traits<T>::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] ConstIterator find(K const& value) const
+    {
+        return find(Traits<K>::hash(value), [&](auto& entry) { return Traits<T>::equals(entry, value); });
+    }
+
+    bool remove(T const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) bool remove(K const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    // Unlike HashTable, this does not invalidate the iterator; it can still be advanced to the next value.
+    void remove(Iterator& iterator)
+    {
+        VERIFY(iterator != end());
+        delete_index(iterator.m_control - m_control);
+    }
+
+    template<typename TUnaryPredicate>
+    bool remove_all_matching(TUnaryPredicate const& predicate)
+    {
+        bool has_removed_anything = false;
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if ((m_control[i] & Detail::swiss_control_empty) || !predicate(m_slots[i]))
+                continue;
+            delete_index(i);
+            has_removed_anything = true;
+        }
+        return has_removed_anything;
+    }
+
+    [[nodiscard]] Vector<T> values() const
+    {
+        Vector<T> list;
+        list.ensure_capacity(size());
+        for (auto& value : *this)
+            list.unchecked_append(value);
+        return list;
+    }
+
+private:
+    // At most 7/8ths of the slots are used (by values or tombstones), so every probe sequence is guaranteed to end.
+    static constexpr size_t growth_for_capacity(size_t capacity) { return capacity - capacity / 8; }
+
+    static constexpr size_t capacity_for_size(size_t size)
+    {
+        size_t capacity = group_width;
+        while (growth_for_capacity(capacity) < size)
+            capacity *= 2;
+        return capacity;
+    }
+
+    // The control bytes are followed by a copy of the first group's bytes, so a group can be loaded at any index
+    // without wrapping around. The slots follow after that.
+    static constexpr size_t slots_offset(size_t capacity) { return align_up_to(capacity + group_width, alignof(T)); }
+    static constexpr size_t size_in_bytes(size_t capacity) { return slots_offset(capacity) + capacity * sizeof(T); }
+
+    static constexpr u8 tag_for_hash(unsigned hash) { return hash >> 25; }
+
+    void set_control(size_t index, u8 control)
+    {
+        m_control[index] = control;
+        if (index < group_width)
+            m_control[m_capacity + index] = control;
+    }
+
+    template<typename IteratorType>
+    IteratorType iterator_for_slot(T* slot) const
+    {
+        if (!slot)
+            return IteratorType(m_control + m_capacity, m_control + m_capacity, m_slots + m_capacity);
+        auto index = slot - m_slots;
+        return IteratorType(m_control + index, m_control + m_capacity, slot);
+    }
+
+    ErrorOr<void> try_rehash(size_t new_capacity)
+    {
+        VERIFY(growth_for_capacity(new_capacity) >= m_size);
+
+        auto* new_control = static_cast<u8*>(kmalloc(size_in_bytes(new_capacity)));
+        if (!new_control)
+            return Error::from_errno(ENOMEM);
+        __builtin_memset(new_control, Detail::swiss_control_empty, new_capacity + group_width);
+
+        auto* old_control = m_control;
+        auto* old_slots = m_slots;
+        auto old_capacity = m_capacity;
+
+        m_control = new_control;
+        m_slots = reinterpret_cast<T*>(new_control + slots_offset(new_capacity));
+        m_capacity = new_capacity;
+        m_growth_left = growth_for_capacity(new_capacity) - m_size;
+
+        if (!old_control)
+            return {};
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_control[i] & Detail::swiss_control_empty)
+                continue;
+            auto& value = old_slots[i];
+            auto hash = TraitsForT::hash(value);
+            auto index = find_insert_index(hash);
+            new (&m_slots[index]) T(move(value));
+            set_control(index, tag_for_hash(hash));
+            value.~T();
+        }
+
+        kfree_sized(old_control, size_in_bytes(old_capacity));
+        return {};
+    }
+
+    // Probes groups at triangular offsets from the starting index, which visits every group since the capacity is a
+    // power of two.
+    template<typename Callback>
+    ALWAYS_INLINE auto probe(unsigned hash, Callback callback) const
+    {
+        auto mask = m_capacity - 1;
+        size_t index = hash & mask;
+        for (size_t stride = group_width;; stride += group_width) {
+            Detail::SwissGroup group { m_control + index };
+            if (auto result = callback(group, index); result.has_value())
+                return result.release_value();
+            index = (index + stride) & mask;
+        }
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] T* lookup_with_hash(unsigned hash, TUnaryPredicate predicate) const
+    {
+        if (is_empty())
+            return nullptr;
+
+        auto tag = tag_for_hash(hash);
+        auto mask = m_capacity - 1;
+        return probe(hash, [&](auto const& group, size_t index) -> Optional<T*> {
+            for (auto matches = group.match(tag); matches; matches &= matches - 1) {
+                auto* slot = &m_slots[(index + count_trailing_zeroes(matches)) & mask];
+                if (predicate(*slot))
+                    return slot;
+            }
+            if (group.match_empty())
+                return static_cast<T*>(nullptr);
+            return {};
+        });
+    }
+
+    size_t find_insert_index(unsigned hash) const
+    {
+        auto mask = m_capacity - 1;
+        return probe(hash, [&](auto const& group, size_t index) -> Optional<size_t> {
+            if (auto available = group.match_empty_or_deleted())
+                return (index + count_trailing_zeroes(available)) & mask;
+            return {};
+        });
+    }
+
+    void delete_index(size_t index)
+    {
+        m_slots[index].~T();
+        --m_size;
+
+        // If no group that covers this slot has ever been completely full, no probe sequence can have skipped past this
+        // slot, and we can mark it as empty instead of leaving a tombstone behind.
+        auto mask = m_capacity - 1;
+        auto empty_before = Detail::SwissGroup { m_control + ((index - group_width) & mask) }.match_empty();
+        auto empty_after = Detail::SwissGroup { m_control + index }.match_empty();
+        bool was_never_full = empty_before && empty_after
+            && static_cast<size_t>(count_leading_zeroes(empty_before) + count_trailing_zeroes(empty_after)) < group_width;
+
+        if (was_never_full) {
+            set_control(index, Detail::swiss_control_empty);
+            ++m_growth_left;
+        } else {
+            set_control(index, Detail::swiss_control_deleted);
+        }
+    }
+
+    u8* m_control { nullptr };
+    T* m_slots { nullptr };
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
+    size_t m_growth_left { 0 };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::SwissHashTable;
+#endif
@@ -36,49 +36,58 @@ static constexpr u16 host_code_unit(u16 code_unit, Endianness endianness)
     VERIFY_NOT_REACHED();
 }
 
-template<OneOf<Utf8View, Utf32View> UtfViewType>
-static ErrorOr<Utf16Data> to_utf16_slow(UtfViewType const& view, Endianness endianness)
-{
-    Utf16Data utf16_data;
-    TRY(utf16_data.try_ensure_capacity(view.length()));
-
-    for (auto code_point : view)
-        TRY(code_point_to_utf16(utf16_data, code_point, endianness));
-
-    return utf16_data;
-}
-
 ErrorOr<Utf16Data> utf8_to_utf16(StringView utf8_view, Endianness endianness)
 {
     return utf8_to_utf16(Utf8View { utf8_view }, endianness);
 }
 
-ErrorOr<Utf16Data> utf8_to_utf16(Utf8View const& utf8_view, Endianness endianness)
+static ErrorOr<void> append_valid_utf8_as_utf16(Utf16Data& utf16_data, Utf8View const& utf8_view, Endianness endianness)
 {
-    // All callers want to allow lonely surrogates, which simdutf does not permit.
-    if (!utf8_view.validate(Utf8View::AllowSurrogates::No)) [[unlikely]]
-        return to_utf16_slow(utf8_view, endianness);
-    if (utf8_view.is_empty())
-        return Utf16Data {};
-
     auto const* data = reinterpret_cast<char const*>(utf8_view.bytes());
     auto length = utf8_view.byte_length();
 
-    Utf16Data utf16_data;
-    TRY(utf16_data.try_resize(simdutf::utf16_length_from_utf8(data, length)));
+    auto offset = utf16_data.size();
+    TRY(utf16_data.try_resize(offset + simdutf::utf16_length_from_utf8(data, length)));
+    auto* output = reinterpret_cast<char16_t*>(utf16_data.data() + offset);
 
     [[maybe_unused]] auto result = [&]() {
         switch (endianness) {
         case Endianness::Host:
-            return simdutf::convert_utf8_to_utf16(data, length, reinterpret_cast<char16_t*>(utf16_data.data()));
+            return simdutf::convert_valid_utf8_to_utf16(data, length, output);
         case Endianness::Big:
-            return simdutf::convert_utf8_to_utf16be(data, length, reinterpret_cast<char16_t*>(utf16_data.data()));
+            return simdutf::convert_valid_utf8_to_utf16be(data, length, output);
         case Endianness::Little:
-            return simdutf::convert_utf8_to_utf16le(data, length, reinterpret_cast<char16_t*>(utf16_data.data()));
+            return simdutf::convert_valid_utf8_to_utf16le(data, length, output);
         }
         VERIFY_NOT_REACHED();
     }();
-    ASSERT(result == utf16_data.size());
+    ASSERT(offset + result == utf16_data.size());
+
+    return {};
+}
+
+ErrorOr<Utf16Data> utf8_to_utf16(Utf8View const& utf8_view, Endianness endianness)
+{
+    Utf16Data utf16_data;
+    auto remaining = utf8_view;
+
+    // NOTE: All callers want to allow lonely surrogates and invalid sequences, which simdutf does not permit. So we
+    //       transcode each valid run in bulk, and only decode whatever lies between those runs one code point at a time.
+    while (!remaining.is_empty()) {
+        size_t valid_bytes = 0;
+        if (remaining.validate(valid_bytes, Utf8View::AllowSurrogates::No))
+            valid_bytes = remaining.byte_length();
+
+        if (valid_bytes > 0)
+            TRY(append_valid_utf8_as_utf16(utf16_data, remaining.substring_view(0, valid_bytes), endianness));
+
+        if (valid_bytes == remaining.byte_length())
+            break;
+
+        auto invalid_part = remaining.substring_view(valid_bytes).begin();
+        TRY(code_point_to_utf16(utf16_data, *invalid_part, endianness));
+        remaining = remaining.substring_view(valid_bytes + invalid_part.underlying_code_point_length_in_bytes());
+    }
 
     return utf16_data;
 }
@@ -162,16 +171,11 @@ ErrorOr<String> Utf16View::to_utf8(AllowInvalidCodeUnits allow_invalid_code_unit
     if (allow_invalid_code_units == AllowInvalidCodeUnits::No)
         return String::from_utf16(*this);
 
-    StringBuilder builder;
-
-    for (size_t i = 0; i < length_in_code_units(); ++i) {
-        auto code_point = code_point_at(i);
-        TRY(builder.try_append_code_point(code_point));
-
-        if (code_point >= first_supplementary_plane_code_point)
-            ++i;
-    }
+    if (validate()) [[likely]]
+        return String::from_utf16(*this);
 
+    StringBuilder builder;
+    TRY(builder.try_append(*this));
     return builder.to_string_without_validation();
 }
 
@@ -31,6 +31,7 @@
 #include <LibWebView/RequestServerAdapter.h>
 #include <WebContent/ConnectionFromClient.h>
 #include <WebContent/PageHost.h>
+#include <WebContent/StoragePlugin.h>
 
 static ErrorOr<NonnullRefPtr<Requests::RequestClient>> bind_request_server_service()
 {
@@ -79,6 +80,7 @@ ErrorOr<int> service_main(int ipc_socket)
 
     auto webcontent_socket = TRY(Core::LocalSocket::adopt_fd(ipc_socket));
     auto webcontent_client = TRY(WebContent::ConnectionFromClient::try_create(move(webcontent_socket)));
+    Web::Platform::StoragePlugin::install(*new WebContent::StoragePlugin(*webcontent_client));
 
     return event_loop.exec();
 }
@@ -67,6 +67,7 @@
 
 - (void)handleResize;
 - (void)handleDevicePixelRatioChange;
+- (void)handleScreenChange;
 - (void)handleScroll;
 - (void)handleVisibility:(BOOL)is_visible;
 
@@ -197,6 +197,17 @@ struct HideCursor {
     [self updateStatusLabelPosition];
 }
 
+- (void)handleScreenChange
+{
+    auto* screen = [[self window] screen];
+    if (screen == nil)
+        return;
+
+    if (@available(macOS 12, *)) {
+        m_web_view_bridge->set_maximum_frames_per_second([screen maximumFramesPerSecond]);
+    }
+}
+
 - (void)handleScroll
 {
     [self updateViewportRect:Ladybird::WebViewBridge::ForResize::No];
@@ -1546,6 +1557,7 @@ static void copy_data_to_clipboard(StringView data, NSPasteboardType pasteboard_
 {
     [super viewDidMoveToWindow];
     [self handleResize];
+    [self handleScreenChange];
 }
 
 - (void)viewDidEndLiveResize
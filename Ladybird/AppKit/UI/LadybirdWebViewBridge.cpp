@@ -46,6 +46,12 @@ void WebViewBridge::set_device_pixel_ratio(float device_pixel_ratio)
     client().async_set_device_pixels_per_css_pixel(m_client_state.page_index, m_device_pixel_ratio * m_zoom_level);
 }
 
+void WebViewBridge::set_maximum_frames_per_second(double maximum_frames_per_second)
+{
+    m_maximum_frames_per_second = maximum_frames_per_second;
+    client().async_set_maximum_frames_per_second(m_client_state.page_index, maximum_frames_per_second);
+}
+
 void WebViewBridge::set_system_visibility_state(bool is_visible)
 {
     client().async_set_system_visibility_state(m_client_state.page_index, is_visible);
@@ -173,6 +179,8 @@ void WebViewBridge::initialize_client(CreateNewClient create_new_client)
     client().async_set_window_handle(m_client_state.page_index, m_client_state.client_handle);
 
     client().async_set_device_pixels_per_css_pixel(m_client_state.page_index, m_device_pixel_ratio);
+    if (m_maximum_frames_per_second.has_value())
+        client().async_set_maximum_frames_per_second(m_client_state.page_index, *m_maximum_frames_per_second);
     client().async_set_preferred_color_scheme(m_client_state.page_index, m_preferred_color_scheme);
     update_palette();
 
@@ -31,6 +31,8 @@ public:
     void set_device_pixel_ratio(float device_pixel_ratio);
     float inverse_device_pixel_ratio() const { return 1.0f / m_device_pixel_ratio; }
 
+    void set_maximum_frames_per_second(double maximum_frames_per_second);
+
     void set_system_visibility_state(bool is_visible);
 
     enum class ForResize {
@@ -73,6 +75,7 @@ private:
     Web::CSS::PreferredColorScheme m_preferred_color_scheme { Web::CSS::PreferredColorScheme::Auto };
     Web::CSS::PreferredContrast m_preferred_contrast { Web::CSS::PreferredContrast::Auto };
     Web::CSS::PreferredMotion m_preferred_motion { Web::CSS::PreferredMotion::Auto };
+    Optional<double> m_maximum_frames_per_second;
 };
 
 }
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibIPC/Statistics.h>
 #include <LibWeb/Loader/UserAgent.h>
 #include <LibWebView/Application.h>
 #include <LibWebView/SearchEngine.h>
@@ -346,6 +347,12 @@ static NSString* const TOOLBAR_TAB_OVERVIEW_IDENTIFIER = @"ToolbarTabOverviewIde
     [self debugRequest:"dump-local-storage" argument:""];
 }
 
+- (void)dumpIPCStatistics:(id)sender
+{
+    IPC::Statistics::dump();
+    [self debugRequest:"dump-ipc-statistics" argument:""];
+}
+
 - (void)toggleLineBoxBorders:(id)sender
 {
     m_settings.should_show_line_box_borders = !m_settings.should_show_line_box_borders;
@@ -627,6 +634,11 @@ static NSString* const TOOLBAR_TAB_OVERVIEW_IDENTIFIER = @"ToolbarTabOverviewIde
     [[[self tab] web_view] handleDevicePixelRatioChange];
 }
 
+- (void)windowDidChangeScreen:(NSNotification*)notification
+{
+    [[[self tab] web_view] handleScreenChange];
+}
+
 - (BOOL)validateMenuItem:(NSMenuItem*)item
 {
     if ([item action] == @selector(toggleLineBoxBorders:)) {
@@ -20,6 +20,11 @@
 
 namespace Ladybird {
 
+ByteString FontPlugin::font_index_path()
+{
+    return ByteString::formatted("{}/Ladybird/FontIndex", Core::StandardPaths::cache_directory());
+}
+
 FontPlugin::FontPlugin(bool is_layout_test_mode, Gfx::SystemFontProvider* font_provider)
     : m_is_layout_test_mode(is_layout_test_mode)
 {
@@ -34,9 +39,12 @@ FontPlugin::FontPlugin(bool is_layout_test_mode, Gfx::SystemFontProvider* font_p
         font_provider = &static_cast<Gfx::PathFontProvider&>(Gfx::FontDatabase::the().install_system_font_provider(make<Gfx::PathFontProvider>()));
     if (is<Gfx::PathFontProvider>(*font_provider)) {
         auto& path_font_provider = static_cast<Gfx::PathFontProvider&>(*font_provider);
+        if (!path_font_provider.has_index_path())
+            path_font_provider.set_index_path(font_index_path());
         // Load anything we can find in the system's font directories
         for (auto const& path : Core::StandardPaths::font_directories().release_value_but_fixme_should_propagate_errors())
             path_font_provider.load_all_fonts_from_uri(MUST(String::formatted("file://{}", path)));
+        path_font_provider.save_index_if_changed();
     }
 
     update_generic_fonts();
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteString.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibGfx/Font/FontDatabase.h>
@@ -25,6 +26,9 @@ public:
 
     void update_generic_fonts();
 
+    // Where PathFontProvider keeps what it knows about the font files it has seen, shared by all processes.
+    static ByteString font_index_path();
+
 private:
     Vector<FlyString> m_generic_font_names;
     RefPtr<Gfx::Font> m_default_font;
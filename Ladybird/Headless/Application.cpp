@@ -17,6 +17,7 @@ namespace Ladybird {
 Application::Application(Badge<WebView::Application>, Main::Arguments&)
     : resources_folder(s_ladybird_resource_root)
     , test_concurrency(Core::System::hardware_concurrency())
+    , render_concurrency(Core::System::hardware_concurrency())
 {
 }
 
@@ -35,6 +36,16 @@ void Application::create_platform_arguments(Core::ArgsParser& args_parser)
     args_parser.add_option(is_layout_test_mode, "Enable layout test mode", "layout-test-mode");
     args_parser.add_option(rebaseline, "Rebaseline any executed layout or text tests", "rebaseline");
     args_parser.add_option(log_slowest_tests, "Log the tests with the slowest run times", "log-slowest-tests");
+    args_parser.add_option(benchmark_corpus_path, "Benchmark the rendering of the pages in path, and print the results as JSON", "benchmark", 0, "corpus-path");
+    args_parser.add_option(benchmark_iterations, "Number of times to load each benchmarked page (default: 5)", "benchmark-iterations", 0, "n");
+    args_parser.add_option(benchmark_baseline_path, "Compare the benchmark results against the results stored at path", "benchmark-baseline", 0, "baseline-path");
+    args_parser.add_option(benchmark_regression_threshold, "Percentage by which a benchmark result may exceed the baseline (default: 10)", "benchmark-threshold", 0, "percent");
+    args_parser.add_option(paint_trace_path, "Along with the screenshot, save a trace of the painting of the page in Chrome's trace event format to path", "dump-paint-trace", 0, "path");
+    args_parser.add_option(render_jobs_path, "Render the pages listed as JSON lines in path (or - for stdin), and print a JSON line with the result of each", "render-jobs", 0, "jobs-path");
+    args_parser.add_option(render_concurrency, "Maximum number of pages to render at once", "render-concurrency", 0, "jobs");
+    args_parser.add_option(render_jobs_per_process, "Number of pages a WebContent process renders before it is replaced (default: 0, never)", "render-jobs-per-process", 0, "n");
+    args_parser.add_option(render_timeout_ms, "Maximum time to spend rendering one page (default: 30000)", "render-timeout", 0, "ms");
+    args_parser.add_option(render_memory_limit_mib, "Replace a WebContent process once it uses more memory than this after rendering a page (default: 0, no limit)", "render-memory-limit", 0, "MiB");
 }
 
 void Application::create_platform_options(WebView::ChromeOptions& chrome_options, WebView::WebContentOptions& web_content_options)
@@ -44,9 +55,27 @@ void Application::create_platform_options(WebView::ChromeOptions& chrome_options
         is_layout_test_mode = true;
     }
 
+    if (!benchmark_corpus_path.is_empty()) {
+        // Benchmarks should measure the same work on every run, which layout test mode gives us by sticking to the
+        // bundled fonts and the CPU painter.
+        is_layout_test_mode = true;
+    }
+
+    if (!render_jobs_path.is_empty()) {
+        // Each render job waits for a new WebContent process to finish its initial load before using it, which a spare
+        // process would have done before anything could listen for it.
+        chrome_options.spare_web_content_processes = 0;
+    }
+
     if (is_layout_test_mode) {
         // Allow window.open() to succeed for tests.
         chrome_options.allow_popups = WebView::AllowPopups::Yes;
+
+        // The views for tests are all opened up front, so a spare WebContent process would never be used.
+        chrome_options.spare_web_content_processes = 0;
+
+        // Tests must not see the cookies or local storage that an earlier run left behind.
+        chrome_options.disable_sql_database = WebView::DisableSQLDatabase::Yes;
     }
 
     if (dump_gc_graph) {
@@ -54,6 +83,9 @@ void Application::create_platform_options(WebView::ChromeOptions& chrome_options
         test_concurrency = 1;
     }
 
+    if (!paint_trace_path.is_empty())
+        web_content_options.enable_paint_tracing = WebView::EnablePaintTracing::Yes;
+
     web_content_options.is_layout_test_mode = is_layout_test_mode ? WebView::IsLayoutTestMode::Yes : WebView::IsLayoutTestMode::No;
 }
 
@@ -76,6 +108,13 @@ ErrorOr<HeadlessWebView*> Application::create_web_view(Core::AnonymousBuffer the
     return m_web_views.last().ptr();
 }
 
+void Application::destroy_web_view(HeadlessWebView& web_view)
+{
+    m_web_views.remove_first_matching([&](auto const& candidate) {
+        return candidate.ptr() == &web_view;
+    });
+}
+
 void Application::destroy_web_views()
 {
     m_web_views.clear();
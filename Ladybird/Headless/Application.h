@@ -38,6 +38,7 @@ public:
     static ImageDecoderClient::Client& image_decoder_client() { return *the().m_image_decoder_client; }
 
     ErrorOr<HeadlessWebView*> create_web_view(Core::AnonymousBuffer theme, Gfx::IntSize window_size);
+    void destroy_web_view(HeadlessWebView&);
     void destroy_web_views();
 
     template<typename Callback>
@@ -60,6 +61,16 @@ public:
     bool test_dry_run { false };
     bool rebaseline { false };
     bool log_slowest_tests { false };
+    ByteString benchmark_corpus_path;
+    size_t benchmark_iterations { 5 };
+    ByteString benchmark_baseline_path;
+    double benchmark_regression_threshold { 10 };
+    ByteString paint_trace_path;
+    ByteString render_jobs_path;
+    size_t render_concurrency { 1 };
+    size_t render_jobs_per_process { 0 };
+    int render_timeout_ms { 30000 };
+    size_t render_memory_limit_mib { 0 };
 
 private:
     RefPtr<Requests::RequestClient> m_request_client;
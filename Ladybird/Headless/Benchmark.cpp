@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <AK/Time.h>
+#include <Ladybird/Headless/Application.h>
+#include <Ladybird/Headless/Benchmark.h>
+#include <Ladybird/Headless/HeadlessWebView.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/File.h>
+#include <LibCore/Promise.h>
+#include <LibCore/Timer.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibGfx/Bitmap.h>
+#include <LibURL/URL.h>
+
+namespace Ladybird {
+
+static constexpr int benchmark_page_timeout_ms = 30000;
+
+// The metrics we take from the document's rendering statistics, see Web::DOM::RenderingStatistics::to_json().
+static constexpr Array rendering_statistics_metrics {
+    "styleUpdateTime"sv,
+    "styleUpdateCellsAllocated"sv,
+    "layoutUpdateTime"sv,
+    "layoutUpdateCellsAllocated"sv,
+    "displayListRecordTime"sv,
+    "displayListRecordCellsAllocated"sv,
+    "displayListReplayTime"sv,
+};
+
+// The time from starting to load the page until the screenshot of it has arrived, as seen by the UI process.
+static constexpr auto total_time_metric = "totalTime"sv;
+
+static bool is_time_metric(StringView metric)
+{
+    return metric.ends_with("Time"sv);
+}
+
+static ErrorOr<void> collect_benchmark_pages(Vector<ByteString>& pages, StringView path)
+{
+    Core::DirIterator it(path, Core::DirIterator::Flags::SkipDots);
+
+    while (it.has_next()) {
+        auto page_path = TRY(FileSystem::real_path(it.next_full_path()));
+
+        if (FileSystem::is_directory(page_path)) {
+            TRY(collect_benchmark_pages(pages, page_path));
+            continue;
+        }
+
+        if (page_path.ends_with(".html"sv) || page_path.ends_with(".svg"sv))
+            pages.append(move(page_path));
+    }
+
+    return {};
+}
+
+static ErrorOr<void> load_page(HeadlessWebView& view, URL::URL const& url)
+{
+    auto promise = Core::Promise<Empty>::construct();
+
+    auto timer = Core::Timer::create_single_shot(benchmark_page_timeout_ms, [promise]() {
+        promise->reject(Error::from_string_literal("Timed out loading page"));
+    });
+
+    view.on_load_finish = [promise, url](auto const& loaded_url) {
+        // We don't want subframe loads to count as the page having loaded.
+        if (url.equals(loaded_url, URL::ExcludeFragment::Yes) && !promise->is_resolved() && !promise->is_rejected())
+            promise->resolve({});
+    };
+
+    view.load(url);
+    timer->start();
+
+    auto result = promise->await();
+    timer->stop();
+    view.on_load_finish = {};
+
+    TRY(result);
+    return {};
+}
+
+static ErrorOr<HashMap<StringView, u64>> run_benchmark_iteration(HeadlessWebView& view, URL::URL const& url)
+{
+    // Start every iteration from a fresh document, so that each one measures the same work.
+    TRY(load_page(view, URL::URL { "about:blank"sv }));
+
+    auto start_time = MonotonicTime::now();
+    TRY(load_page(view, url));
+
+    // Taking a screenshot makes sure the page has been painted at least once.
+    (void)TRY(view.take_screenshot()->await());
+    auto total_time = MonotonicTime::now() - start_time;
+
+    auto statistics_json = TRY(view.request_internal_page_info(WebView::PageInfoType::RenderingStatistics)->await());
+    auto statistics = TRY(JsonValue::from_string(statistics_json));
+    if (!statistics.is_object())
+        return Error::from_string_literal("No rendering statistics for page");
+
+    HashMap<StringView, u64> metrics;
+    for (auto metric : rendering_statistics_metrics)
+        metrics.set(metric, statistics.as_object().get_u64(metric).value_or(0));
+    metrics.set(total_time_metric, static_cast<u64>(total_time.to_microseconds()));
+
+    return metrics;
+}
+
+static u64 median(Vector<u64> values)
+{
+    VERIFY(!values.is_empty());
+    quick_sort(values);
+    return values[values.size() / 2];
+}
+
+static ErrorOr<JsonObject> load_baseline(StringView path)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto baseline = TRY(JsonValue::from_string(TRY(file->read_until_eof())));
+    if (!baseline.is_object() || !baseline.as_object().has_object("pages"sv))
+        return Error::from_string_literal("Benchmark baseline has no pages");
+    return baseline.as_object().get_object("pages"sv).value();
+}
+
+static JsonArray find_regressions(JsonObject const& pages, JsonObject const& baseline_pages, double threshold_percent)
+{
+    // Differences in time below this are noise, no matter how large they are relative to the baseline.
+    static constexpr u64 minimum_time_regression_us = 1000;
+
+    JsonArray regressions;
+
+    pages.for_each_member([&](auto const& page, auto const& value) {
+        auto baseline = baseline_pages.get_object(page);
+        if (!baseline.has_value())
+            return;
+
+        value.as_object().for_each_member([&](auto const& metric, auto const& current_value) {
+            auto baseline_value = baseline->get_u64(metric);
+            if (!baseline_value.has_value() || *baseline_value == 0)
+                return;
+
+            auto current = current_value.template as_integer<u64>();
+            if (static_cast<double>(current) <= static_cast<double>(*baseline_value) * (1 + threshold_percent / 100))
+                return;
+            if (is_time_metric(metric) && current - *baseline_value < minimum_time_regression_us)
+                return;
+
+            JsonObject regression;
+            regression.set("page"sv, page);
+            regression.set("metric"sv, metric);
+            regression.set("baseline"sv, *baseline_value);
+            regression.set("current"sv, current);
+            regressions.must_append(move(regression));
+        });
+    });
+
+    return regressions;
+}
+
+ErrorOr<void> run_benchmarks(Core::AnonymousBuffer const& theme, Gfx::IntSize window_size)
+{
+    auto& app = Application::the();
+
+    Vector<ByteString> pages;
+    TRY(collect_benchmark_pages(pages, app.benchmark_corpus_path));
+    if (pages.is_empty())
+        return Error::from_string_literal("No pages found in benchmark corpus");
+    quick_sort(pages);
+
+    // Pages are benchmarked one at a time, so that they don't compete with each other for the CPU.
+    auto& view = *TRY(app.create_web_view(theme, window_size));
+    view.clear_content_filters();
+
+    auto iterations = max(app.benchmark_iterations, 1uz);
+    JsonObject results;
+
+    for (auto const& page : pages) {
+        auto name = LexicalPath::relative_path(page, app.benchmark_corpus_path);
+        warnln("Benchmarking {}...", name);
+
+        auto url = URL::create_with_file_scheme(page);
+        HashMap<StringView, Vector<u64>> samples;
+
+        for (size_t i = 0; i < iterations; ++i) {
+            auto metrics = TRY(run_benchmark_iteration(view, url));
+            for (auto const& metric : metrics)
+                samples.ensure(metric.key).append(metric.value);
+        }
+
+        JsonObject page_results;
+        for (auto const& sample : samples)
+            page_results.set(sample.key, median(sample.value));
+        results.set(name, move(page_results));
+    }
+
+    app.destroy_web_views();
+
+    JsonObject output;
+    output.set("iterations"sv, iterations);
+
+    JsonArray regressions;
+    if (!app.benchmark_baseline_path.is_empty()) {
+        auto baseline_pages = TRY(load_baseline(app.benchmark_baseline_path));
+        regressions = find_regressions(results, baseline_pages, app.benchmark_regression_threshold);
+        output.set("regressions"sv, regressions);
+    }
+
+    output.set("pages"sv, move(results));
+    outln("{}", output.to_byte_string());
+
+    if (regressions.is_empty())
+        return {};
+
+    for (auto const& regression : regressions.values()) {
+        auto const& object = regression.as_object();
+        warnln("Regression: {} {}: {} -> {}", *object.get_byte_string("page"sv), *object.get_byte_string("metric"sv), *object.get_u64("baseline"sv), *object.get_u64("current"sv));
+    }
+
+    return Error::from_string_literal("Rendering performance regressed against the baseline");
+}
+
+}
@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <LibCore/Forward.h>
+#include <LibGfx/Size.h>
+
+namespace Ladybird {
+
+// Loads every page of the benchmark corpus a number of times, and prints the median time and GC allocations that style,
+// layout, display list recording and display list replay took for each page as JSON. If a baseline is given, pages that
+// got slower than the baseline beyond the threshold are reported as regressions, and an error is returned.
+ErrorOr<void> run_benchmarks(Core::AnonymousBuffer const& theme, Gfx::IntSize window_size);
+
+}
@@ -29,11 +29,8 @@ ErrorOr<NonnullOwnPtr<HeadlessWebView>> HeadlessWebView::create(Core::AnonymousB
 {
     auto view = TRY(adopt_nonnull_own_or_enomem(new (nothrow) HeadlessWebView(window_size)));
 
-    auto request_server_socket = TRY(connect_new_request_server_client(Application::request_client()));
-    auto image_decoder_socket = TRY(connect_new_image_decoder_client(Application::image_decoder_client()));
-
     auto candidate_web_content_paths = TRY(get_paths_for_helper_process("WebContent"sv));
-    view->m_client_state.client = TRY(launch_web_content_process(*view, candidate_web_content_paths, move(image_decoder_socket), move(request_server_socket)));
+    view->m_client_state.client = TRY(launch_web_content_process(*view, candidate_web_content_paths, Application::image_decoder_client(), Application::request_client()));
 
     view->client().async_update_system_theme(0, move(theme));
     view->client().async_set_viewport_size(0, view->viewport_size());
@@ -46,6 +43,11 @@ ErrorOr<NonnullOwnPtr<HeadlessWebView>> HeadlessWebView::create(Core::AnonymousB
         view->client().async_connect_to_webdriver(0, *web_driver_ipc_path);
 
     view->m_client_state.client->on_web_content_process_crash = [&view = *view] {
+        if (view.on_web_content_process_crash) {
+            view.on_web_content_process_crash();
+            return;
+        }
+
         warnln("\033[31;1mWebContent Crashed!!\033[0m");
         warnln("    Last page loaded: {}", view.url());
         VERIFY_NOT_REACHED();
@@ -59,6 +61,16 @@ void HeadlessWebView::clear_content_filters()
     client().async_set_content_filters(0, {});
 }
 
+void HeadlessWebView::set_viewport_size(Gfx::IntSize viewport_size)
+{
+    if (m_viewport_size == viewport_size)
+        return;
+
+    m_viewport_size = viewport_size;
+    client().async_set_viewport_size(0, this->viewport_size());
+    client().async_set_window_size(0, this->viewport_size());
+}
+
 NonnullRefPtr<Core::Promise<RefPtr<Gfx::Bitmap>>> HeadlessWebView::take_screenshot()
 {
     VERIFY(!m_pending_screenshot);
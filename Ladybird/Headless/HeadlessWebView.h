@@ -23,6 +23,12 @@ public:
     static ErrorOr<NonnullOwnPtr<HeadlessWebView>> create(Core::AnonymousBuffer theme, Gfx::IntSize window_size);
 
     void clear_content_filters();
+    void set_viewport_size(Gfx::IntSize);
+
+    pid_t web_content_pid() { return client().pid(); }
+
+    // If this isn't set, a crashing WebContent process takes the whole application down with it.
+    Function<void()> on_web_content_process_crash;
 
     NonnullRefPtr<Core::Promise<RefPtr<Gfx::Bitmap>>> take_screenshot();
 
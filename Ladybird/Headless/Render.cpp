@@ -0,0 +1,455 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/Queue.h>
+#include <AK/Time.h>
+#include <Ladybird/Headless/Application.h>
+#include <Ladybird/Headless/HeadlessWebView.h>
+#include <Ladybird/Headless/Render.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/Promise.h>
+#include <LibCore/System.h>
+#include <LibCore/Timer.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageFormats/JPEGWriter.h>
+#include <LibGfx/ImageFormats/PNGWriter.h>
+#include <LibGfx/ImageFormats/WebPWriter.h>
+#include <LibURL/URL.h>
+#include <LibWebView/URL.h>
+#include <signal.h>
+
+namespace Ladybird {
+
+enum class RenderOutputFormat {
+    PNG,
+    JPEG,
+    WebP,
+};
+
+struct RenderJob {
+    size_t index { 0 };
+    URL::URL url;
+    ByteString output_path;
+    RenderOutputFormat format { RenderOutputFormat::PNG };
+    Gfx::IntSize viewport_size;
+    int delay_ms { 0 };
+};
+
+static ErrorOr<RenderOutputFormat> output_format_for_path(StringView path)
+{
+    if (path.ends_with(".png"sv, CaseSensitivity::CaseInsensitive))
+        return RenderOutputFormat::PNG;
+    if (path.ends_with(".jpg"sv, CaseSensitivity::CaseInsensitive) || path.ends_with(".jpeg"sv, CaseSensitivity::CaseInsensitive))
+        return RenderOutputFormat::JPEG;
+    if (path.ends_with(".webp"sv, CaseSensitivity::CaseInsensitive))
+        return RenderOutputFormat::WebP;
+    return Error::from_string_literal("Unsupported output format, expected .png, .jpg or .webp");
+}
+
+static ErrorOr<RenderJob> parse_render_job(StringView line, Gfx::IntSize window_size)
+{
+    auto json = TRY(JsonValue::from_string(line));
+    if (!json.is_object())
+        return Error::from_string_literal("Render job is not a JSON object");
+    auto const& object = json.as_object();
+
+    auto raw_url = object.get_byte_string("url"sv);
+    auto output_path = object.get_byte_string("output"sv);
+    if (!raw_url.has_value() || !output_path.has_value())
+        return Error::from_string_literal("Render job needs a URL and an output path");
+
+    auto url = WebView::sanitize_url(*raw_url);
+    if (!url.has_value())
+        return Error::from_string_literal("Render job has an invalid URL");
+
+    RenderJob job;
+    job.url = url.release_value();
+    job.output_path = output_path.release_value();
+    job.format = TRY(output_format_for_path(job.output_path));
+    job.viewport_size = {
+        object.get_i32("width"sv).value_or(window_size.width()),
+        object.get_i32("height"sv).value_or(window_size.height()),
+    };
+    if (job.viewport_size.width() <= 0 || job.viewport_size.height() <= 0)
+        return Error::from_string_literal("Render job has an invalid viewport size");
+    job.delay_ms = max(object.get_i32("delay"sv).value_or(0), 0);
+
+    return job;
+}
+
+static ErrorOr<void> write_render_output(RenderJob const& job, Gfx::Bitmap const& bitmap)
+{
+    auto output_file = TRY(Core::File::open(job.output_path, Core::File::OpenMode::Write));
+
+    switch (job.format) {
+    case RenderOutputFormat::PNG: {
+        auto image_buffer = TRY(Gfx::PNGWriter::encode(bitmap));
+        TRY(output_file->write_until_depleted(image_buffer.bytes()));
+        break;
+    }
+    case RenderOutputFormat::JPEG:
+        TRY(Gfx::JPEGWriter::encode(*output_file, bitmap));
+        break;
+    case RenderOutputFormat::WebP:
+        TRY(Gfx::WebPWriter::encode(*output_file, bitmap));
+        break;
+    }
+
+    return {};
+}
+
+class RenderJobRunner {
+public:
+    RenderJobRunner(Core::AnonymousBuffer const& theme, Gfx::IntSize window_size)
+        : m_theme(theme)
+        , m_window_size(window_size)
+        , m_done(Core::Promise<Empty>::construct())
+    {
+        auto worker_count = max(Application::the().render_concurrency, 1uz);
+        for (size_t i = 0; i < worker_count; ++i)
+            m_workers.append(make<Worker>());
+    }
+
+    ErrorOr<void> run();
+
+private:
+    struct Worker {
+        HeadlessWebView* view { nullptr };
+        size_t jobs_rendered_by_process { 0 };
+
+        Optional<RenderJob> job;
+        MonotonicTime start_time { MonotonicTime::now_coarse() };
+        RefPtr<Core::Timer> timeout_timer;
+        RefPtr<Core::Timer> delay_timer;
+
+        // Callbacks for a job that already finished, e.g. by timing out, check this to find out that they are stale.
+        u64 generation { 0 };
+    };
+
+    enum class ProcessState {
+        Healthy,
+        Crashed,
+        Unresponsive,
+    };
+
+    void receive_jobs(ReadonlyBytes);
+    void did_receive_all_jobs();
+    void report_result(RenderJob const&, ErrorOr<void> const&, Optional<AK::Duration> time = {});
+
+    void dispatch_jobs();
+    ErrorOr<void> start_job(Worker&, RenderJob);
+    void load_job(Worker&);
+    void take_screenshot(Worker&);
+    void finish_job(Worker&, ErrorOr<void>, ProcessState = ProcessState::Healthy);
+    bool should_replace_process(Worker&) const;
+    void replace_process(Worker&, ProcessState);
+
+    Core::AnonymousBuffer m_theme;
+    Gfx::IntSize m_window_size;
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+    Queue<RenderJob> m_queued_jobs;
+
+    ByteBuffer m_partial_line;
+    size_t m_next_job_index { 0 };
+    bool m_received_all_jobs { false };
+    RefPtr<Core::Notifier> m_stdin_notifier;
+
+    size_t m_succeeded_count { 0 };
+    size_t m_failed_count { 0 };
+
+    NonnullRefPtr<Core::Promise<Empty>> m_done;
+};
+
+ErrorOr<void> RenderJobRunner::run()
+{
+    auto const& path = Application::the().render_jobs_path;
+
+    if (path == "-"sv) {
+        // NOTE: When jobs are piped in, we start rendering the first ones while the rest are still arriving.
+        m_stdin_notifier = Core::Notifier::construct(STDIN_FILENO, Core::Notifier::Type::Read);
+        m_stdin_notifier->on_activation = [this]() {
+            Array<u8, 16 * KiB> buffer;
+            auto nread = Core::System::read(STDIN_FILENO, buffer);
+            if (nread.is_error()) {
+                if (nread.error().code() == EAGAIN || nread.error().code() == EINTR)
+                    return;
+                warnln("Unable to read render jobs: {}", nread.error());
+                nread = 0;
+            }
+
+            if (nread.value() == 0) {
+                m_stdin_notifier->set_enabled(false);
+                did_receive_all_jobs();
+                return;
+            }
+
+            receive_jobs(buffer.span().trim(nread.value()));
+        };
+    } else {
+        auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+        receive_jobs(TRY(file->read_until_eof()));
+        did_receive_all_jobs();
+    }
+
+    auto result = m_done->await();
+    m_stdin_notifier = nullptr;
+    Application::the().destroy_web_views();
+
+    TRY(result);
+
+    warnln("Rendered {} pages, {} failed", m_succeeded_count, m_failed_count);
+    if (m_failed_count != 0)
+        return Error::from_string_literal("Failed to render some pages");
+    return {};
+}
+
+void RenderJobRunner::receive_jobs(ReadonlyBytes bytes)
+{
+    m_partial_line.append(bytes);
+
+    StringView lines { m_partial_line };
+    size_t consumed = 0;
+
+    while (true) {
+        auto newline = lines.find('\n', consumed);
+        if (!newline.has_value())
+            break;
+
+        auto line = lines.substring_view(consumed, *newline - consumed).trim_whitespace();
+        consumed = *newline + 1;
+        if (line.is_empty())
+            continue;
+
+        auto index = m_next_job_index++;
+        auto job = parse_render_job(line, m_window_size);
+        if (job.is_error()) {
+            report_result(RenderJob { .index = index }, job.release_error());
+            continue;
+        }
+
+        job.value().index = index;
+        m_queued_jobs.enqueue(job.release_value());
+    }
+
+    m_partial_line = MUST(m_partial_line.slice(consumed, m_partial_line.size() - consumed));
+    dispatch_jobs();
+}
+
+void RenderJobRunner::did_receive_all_jobs()
+{
+    if (!m_partial_line.is_empty()) {
+        // The last job doesn't need to end with a newline.
+        receive_jobs("\n"sv.bytes());
+    }
+
+    m_received_all_jobs = true;
+    dispatch_jobs();
+}
+
+void RenderJobRunner::report_result(RenderJob const& job, ErrorOr<void> const& result, Optional<AK::Duration> time)
+{
+    JsonObject object;
+    object.set("job"sv, job.index);
+    if (job.url.is_valid())
+        object.set("url"sv, job.url.serialize());
+    if (!job.output_path.is_empty())
+        object.set("output"sv, job.output_path);
+    object.set("result"sv, result.is_error() ? "error"sv : "ok"sv);
+    if (result.is_error())
+        object.set("error"sv, ByteString::formatted("{}", result.error()));
+    if (time.has_value())
+        object.set("time"sv, time->to_milliseconds());
+
+    outln("{}", object.to_byte_string());
+
+    if (result.is_error())
+        ++m_failed_count;
+    else
+        ++m_succeeded_count;
+}
+
+void RenderJobRunner::dispatch_jobs()
+{
+    for (auto& worker : m_workers) {
+        if (m_queued_jobs.is_empty())
+            break;
+        if (worker->job.has_value())
+            continue;
+
+        if (auto result = start_job(*worker, m_queued_jobs.dequeue()); result.is_error()) {
+            m_done->reject(result.release_error());
+            return;
+        }
+    }
+
+    if (!m_received_all_jobs || !m_queued_jobs.is_empty())
+        return;
+
+    auto all_workers_are_idle = all_of(m_workers, [](auto const& worker) { return !worker->job.has_value(); });
+    if (all_workers_are_idle && !m_done->is_resolved() && !m_done->is_rejected())
+        m_done->resolve({});
+}
+
+ErrorOr<void> RenderJobRunner::start_job(Worker& worker, RenderJob job)
+{
+    worker.job = move(job);
+
+    if (worker.view) {
+        load_job(worker);
+        return {};
+    }
+
+    auto& view = *TRY(Application::the().create_web_view(m_theme, m_window_size));
+    view.clear_content_filters();
+
+    worker.view = &view;
+    worker.jobs_rendered_by_process = 0;
+
+    view.on_web_content_process_crash = [this, &worker]() {
+        Core::deferred_invoke([this, &worker]() {
+            if (worker.job.has_value())
+                finish_job(worker, Error::from_string_literal("WebContent process crashed"), ProcessState::Crashed);
+            else
+                replace_process(worker, ProcessState::Crashed);
+        });
+    };
+
+    // We have to wait for the initial about:blank load to complete before loading the page, see run_tests().
+    view.on_load_finish = [this, &worker](auto const&) {
+        worker.view->on_load_finish = {};
+        Core::deferred_invoke([this, &worker]() {
+            load_job(worker);
+        });
+    };
+
+    return {};
+}
+
+void RenderJobRunner::load_job(Worker& worker)
+{
+    VERIFY(worker.view);
+    VERIFY(worker.job.has_value());
+
+    auto& view = *worker.view;
+    auto const& job = *worker.job;
+    auto generation = ++worker.generation;
+
+    worker.start_time = MonotonicTime::now();
+    worker.timeout_timer = Core::Timer::create_single_shot(Application::the().render_timeout_ms, [this, &worker, generation]() {
+        if (generation == worker.generation)
+            finish_job(worker, Error::from_string_literal("Timed out rendering page"), ProcessState::Unresponsive);
+    });
+
+    view.on_load_finish = [this, &worker, generation, url = job.url](auto const& loaded_url) {
+        // We don't want subframe loads to count as the page having loaded.
+        if (generation != worker.generation || !url.equals(loaded_url, URL::ExcludeFragment::Yes))
+            return;
+        worker.view->on_load_finish = {};
+
+        if (worker.job->delay_ms == 0) {
+            take_screenshot(worker);
+            return;
+        }
+
+        worker.delay_timer = Core::Timer::create_single_shot(worker.job->delay_ms, [this, &worker, generation]() {
+            if (generation == worker.generation)
+                take_screenshot(worker);
+        });
+        worker.delay_timer->start();
+    };
+
+    view.set_viewport_size(job.viewport_size);
+    view.load(job.url);
+    worker.timeout_timer->start();
+}
+
+void RenderJobRunner::take_screenshot(Worker& worker)
+{
+    auto generation = worker.generation;
+
+    worker.view->take_screenshot()->when_resolved([this, &worker, generation](RefPtr<Gfx::Bitmap>& screenshot) {
+        if (generation != worker.generation)
+            return;
+        if (!screenshot) {
+            finish_job(worker, Error::from_string_literal("No screenshot available"));
+            return;
+        }
+        finish_job(worker, write_render_output(*worker.job, *screenshot));
+    });
+}
+
+void RenderJobRunner::finish_job(Worker& worker, ErrorOr<void> result, ProcessState process_state)
+{
+    VERIFY(worker.job.has_value());
+
+    ++worker.generation;
+    if (worker.timeout_timer)
+        worker.timeout_timer->stop();
+    if (worker.delay_timer)
+        worker.delay_timer->stop();
+    if (worker.view && process_state == ProcessState::Healthy)
+        worker.view->on_load_finish = {};
+
+    auto job = worker.job.release_value();
+    report_result(job, result, MonotonicTime::now() - worker.start_time);
+    ++worker.jobs_rendered_by_process;
+
+    // NOTE: We're likely inside one of the view's callbacks here, so we leave it alone until they have returned.
+    Core::deferred_invoke([this, &worker, process_state]() {
+        if (process_state != ProcessState::Healthy || should_replace_process(worker))
+            replace_process(worker, process_state);
+        dispatch_jobs();
+    });
+}
+
+bool RenderJobRunner::should_replace_process(Worker& worker) const
+{
+    auto const& app = Application::the();
+
+    if (app.render_jobs_per_process != 0 && worker.jobs_rendered_by_process >= app.render_jobs_per_process)
+        return true;
+
+    if (app.render_memory_limit_mib != 0) {
+        Application::the().update_process_statistics();
+
+        auto memory_usage = Application::the().process_memory_usage(worker.view->web_content_pid());
+        if (memory_usage.has_value() && *memory_usage > app.render_memory_limit_mib * MiB)
+            return true;
+    }
+
+    return false;
+}
+
+void RenderJobRunner::replace_process(Worker& worker, ProcessState process_state)
+{
+    if (!worker.view)
+        return;
+
+    auto pid = worker.view->web_content_pid();
+
+    // The process exits on its own once it has no views left, unless it is stuck, e.g. in a script that never ends.
+    Application::the().destroy_web_view(*worker.view);
+    worker.view = nullptr;
+
+    if (process_state == ProcessState::Unresponsive) {
+        if (auto result = Core::System::kill(pid, SIGKILL); result.is_error())
+            warnln("Unable to kill WebContent process {}: {}", pid, result.error());
+    }
+}
+
+ErrorOr<void> run_render_jobs(Core::AnonymousBuffer const& theme, Gfx::IntSize window_size)
+{
+    RenderJobRunner runner { theme, window_size };
+    return runner.run();
+}
+
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <LibCore/Forward.h>
+#include <LibGfx/Size.h>
+
+namespace Ladybird {
+
+// Renders the pages of a queue of jobs into image files, spread across a number of WebContent processes. Each job is a
+// line of JSON, for example:
+//
+//     {"url": "https://ladybird.org", "output": "ladybird.png", "width": 1280, "height": 720, "delay": 500}
+//
+// The viewport size defaults to the window size, and the delay is how many milliseconds to wait between the page
+// having loaded and taking the screenshot. The image format follows from the extension of the output path, which may
+// be .png, .jpg or .webp. Jobs are read as they arrive, so the queue may be fed through stdin. A line of JSON with the
+// result of each job is printed as it completes.
+ErrorOr<void> run_render_jobs(Core::AnonymousBuffer const& theme, Gfx::IntSize window_size);
+
+}
@@ -12,7 +12,9 @@
 #include <AK/Platform.h>
 #include <AK/String.h>
 #include <Ladybird/Headless/Application.h>
+#include <Ladybird/Headless/Benchmark.h>
 #include <Ladybird/Headless/HeadlessWebView.h>
+#include <Ladybird/Headless/Render.h>
 #include <Ladybird/Headless/Test.h>
 #include <Ladybird/Utilities.h>
 #include <LibCore/EventLoop.h>
@@ -26,6 +28,15 @@
 #include <LibGfx/SystemTheme.h>
 #include <LibURL/URL.h>
 
+static ErrorOr<void> save_paint_trace(Ladybird::HeadlessWebView& view, StringView output_file_path)
+{
+    auto paint_trace = TRY(view.request_internal_page_info(WebView::PageInfoType::PaintTrace)->await());
+
+    auto output_file = TRY(Core::File::open(output_file_path, Core::File::OpenMode::Write));
+    TRY(output_file->write_until_depleted(paint_trace.bytes()));
+    return {};
+}
+
 static ErrorOr<NonnullRefPtr<Core::Timer>> load_page_for_screenshot_and_exit(Core::EventLoop& event_loop, Ladybird::HeadlessWebView& view, URL::URL const& url, int screenshot_timeout)
 {
     // FIXME: Allow passing the output path as an argument.
@@ -51,6 +62,12 @@ static ErrorOr<NonnullRefPtr<Core::Timer>> load_page_for_screenshot_and_exit(Cor
                 warnln("No screenshot available");
             }
 
+            if (auto const& paint_trace_path = Ladybird::Application::the().paint_trace_path; !paint_trace_path.is_empty()) {
+                outln("Saving paint trace to {}", paint_trace_path);
+                if (auto result = save_paint_trace(view, paint_trace_path); result.is_error())
+                    warnln("Unable to save paint trace: {}", result.error());
+            }
+
             event_loop.quit(0);
         });
 
@@ -81,6 +98,19 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 0;
     }
 
+    if (!app->benchmark_corpus_path.is_empty()) {
+        app->benchmark_corpus_path = LexicalPath::absolute_path(TRY(FileSystem::current_working_directory()), app->benchmark_corpus_path);
+        TRY(Ladybird::run_benchmarks(theme, window_size));
+
+        return 0;
+    }
+
+    if (!app->render_jobs_path.is_empty()) {
+        TRY(Ladybird::run_render_jobs(theme, window_size));
+
+        return 0;
+    }
+
     auto& view = *TRY(app->create_web_view(move(theme), window_size));
 
     VERIFY(!WebView::Application::chrome_options().urls.is_empty());
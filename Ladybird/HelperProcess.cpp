@@ -7,6 +7,7 @@
 #include "HelperProcess.h"
 #include "Utilities.h"
 #include <AK/Enumerate.h>
+#include <LibCore/EventLoop.h>
 #include <LibCore/Process.h>
 #include <LibWebView/Application.h>
 
@@ -71,12 +72,16 @@ static ErrorOr<NonnullRefPtr<ClientType>> launch_server_process(
     VERIFY_NOT_REACHED();
 }
 
-ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
-    WebView::ViewImplementation& view,
+template<typename... ClientArguments>
+static ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process_impl(
     ReadonlySpan<ByteString> candidate_web_content_paths,
-    IPC::File image_decoder_socket,
-    Optional<IPC::File> request_server_socket)
+    ImageDecoderClient::Client& image_decoder_client,
+    Requests::RequestClient& request_client,
+    ClientArguments&&... client_arguments)
 {
+    auto request_server_socket = TRY(connect_new_request_server_client(request_client));
+    auto image_decoder_socket = TRY(connect_new_image_decoder_client(image_decoder_client));
+
     auto const& web_content_options = WebView::Application::web_content_options();
 
     Vector<ByteString> arguments {
@@ -96,6 +101,8 @@ ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
         arguments.append("--log-all-js-exceptions"sv);
     if (web_content_options.enable_idl_tracing == WebView::EnableIDLTracing::Yes)
         arguments.append("--enable-idl-tracing"sv);
+    if (web_content_options.enable_paint_tracing == WebView::EnablePaintTracing::Yes)
+        arguments.append("--enable-paint-tracing"sv);
     if (web_content_options.enable_http_cache == WebView::EnableHTTPCache::Yes)
         arguments.append("--enable-http-cache"sv);
     if (web_content_options.expose_internals_object == WebView::ExposeInternalsObject::Yes)
@@ -108,15 +115,53 @@ ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
         arguments.append("--mach-server-name"sv);
         arguments.append(server.value());
     }
-    if (request_server_socket.has_value()) {
-        arguments.append("--request-server-socket"sv);
-        arguments.append(ByteString::number(request_server_socket->fd()));
-    }
+
+    arguments.append("--request-server-socket"sv);
+    arguments.append(ByteString::number(request_server_socket.fd()));
 
     arguments.append("--image-decoder-socket"sv);
     arguments.append(ByteString::number(image_decoder_socket.fd()));
 
-    return launch_server_process<WebView::WebContentClient>("WebContent"sv, candidate_web_content_paths, move(arguments), view);
+    return launch_server_process<WebView::WebContentClient>("WebContent"sv, candidate_web_content_paths, move(arguments), forward<ClientArguments>(client_arguments)...);
+}
+
+static void launch_spare_web_content_processes(
+    ReadonlySpan<ByteString> candidate_web_content_paths,
+    NonnullRefPtr<ImageDecoderClient::Client> image_decoder_client,
+    NonnullRefPtr<Requests::RequestClient> request_client)
+{
+    // NOTE: We wait until the current event loop iteration is over, so that launching a spare doesn't hold up the view
+    //       that just got its process.
+    Core::deferred_invoke([candidate_web_content_paths = Vector<ByteString> { candidate_web_content_paths }, image_decoder_client = move(image_decoder_client), request_client = move(request_client)]() {
+        auto& application = WebView::Application::the();
+
+        while (application.needs_spare_web_content_client()) {
+            auto spare_client = launch_web_content_process_impl(candidate_web_content_paths, *image_decoder_client, *request_client);
+            if (spare_client.is_error()) {
+                dbgln("Unable to launch a spare WebContent process: {}", spare_client.error());
+                return;
+            }
+
+            application.add_spare_web_content_client(spare_client.release_value());
+        }
+    });
+}
+
+ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
+    WebView::ViewImplementation& view,
+    ReadonlySpan<ByteString> candidate_web_content_paths,
+    ImageDecoderClient::Client& image_decoder_client,
+    Requests::RequestClient& request_client)
+{
+    RefPtr<WebView::WebContentClient> client = WebView::Application::the().take_spare_web_content_client();
+
+    if (client)
+        client->set_initial_view(view);
+    else
+        client = TRY(launch_web_content_process_impl(candidate_web_content_paths, image_decoder_client, request_client, view));
+
+    launch_spare_web_content_processes(candidate_web_content_paths, image_decoder_client, request_client);
+    return client.release_nonnull();
 }
 
 ErrorOr<NonnullRefPtr<ImageDecoderClient::Client>> launch_image_decoder_process(ReadonlySpan<ByteString> candidate_image_decoder_paths)
@@ -130,17 +175,46 @@ ErrorOr<NonnullRefPtr<ImageDecoderClient::Client>> launch_image_decoder_process(
     return launch_server_process<ImageDecoderClient::Client>("ImageDecoder"sv, candidate_image_decoder_paths, arguments);
 }
 
-ErrorOr<NonnullRefPtr<Web::HTML::WebWorkerClient>> launch_web_worker_process(ReadonlySpan<ByteString> candidate_web_worker_paths, NonnullRefPtr<Requests::RequestClient> request_client)
+static ErrorOr<NonnullRefPtr<Web::HTML::WebWorkerClient>> launch_web_worker_process_impl(ReadonlySpan<ByteString> candidate_web_worker_paths, Requests::RequestClient& request_client)
 {
     Vector<ByteString> arguments;
 
-    auto socket = TRY(connect_new_request_server_client(*request_client));
+    auto socket = TRY(connect_new_request_server_client(request_client));
     arguments.append("--request-server-socket"sv);
     arguments.append(ByteString::number(socket.fd()));
 
     return launch_server_process<Web::HTML::WebWorkerClient>("WebWorker"sv, candidate_web_worker_paths, move(arguments));
 }
 
+static void launch_spare_web_worker_processes(ReadonlySpan<ByteString> candidate_web_worker_paths, NonnullRefPtr<Requests::RequestClient> request_client)
+{
+    // NOTE: As with WebContent processes, this waits until the worker that asked for a process has gotten it.
+    Core::deferred_invoke([candidate_web_worker_paths = Vector<ByteString> { candidate_web_worker_paths }, request_client = move(request_client)]() {
+        auto& application = WebView::Application::the();
+
+        while (application.needs_spare_web_worker_client()) {
+            auto spare_client = launch_web_worker_process_impl(candidate_web_worker_paths, *request_client);
+            if (spare_client.is_error()) {
+                dbgln("Unable to launch a spare WebWorker process: {}", spare_client.error());
+                return;
+            }
+
+            application.add_spare_web_worker_client(spare_client.release_value());
+        }
+    });
+}
+
+ErrorOr<NonnullRefPtr<Web::HTML::WebWorkerClient>> launch_web_worker_process(ReadonlySpan<ByteString> candidate_web_worker_paths, NonnullRefPtr<Requests::RequestClient> request_client)
+{
+    RefPtr<Web::HTML::WebWorkerClient> client = WebView::Application::the().take_spare_web_worker_client();
+
+    if (!client)
+        client = TRY(launch_web_worker_process_impl(candidate_web_worker_paths, *request_client));
+
+    launch_spare_web_worker_processes(candidate_web_worker_paths, move(request_client));
+    return client.release_nonnull();
+}
+
 ErrorOr<NonnullRefPtr<Requests::RequestClient>> launch_request_server_process(ReadonlySpan<ByteString> candidate_request_server_paths, StringView serenity_resource_root)
 {
     Vector<ByteString> arguments;
@@ -153,6 +227,9 @@ ErrorOr<NonnullRefPtr<Requests::RequestClient>> launch_request_server_process(Re
     for (auto const& certificate : WebView::Application::chrome_options().certificates)
         arguments.append(ByteString::formatted("--certificate={}", certificate));
 
+    if (WebView::Application::web_content_options().enable_http_cache == WebView::EnableHTTPCache::Yes)
+        arguments.append("--enable-http-disk-cache"sv);
+
     if (auto server = mach_server_name(); server.has_value()) {
         arguments.append("--mach-server-name"sv);
         arguments.append(server.value());
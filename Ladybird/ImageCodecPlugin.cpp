@@ -13,6 +13,97 @@
 
 namespace Ladybird {
 
+class ImageDecoderFrameStream final : public Web::Platform::FrameStream {
+public:
+    explicit ImageDecoderFrameStream(NonnullRefPtr<ImageDecoderClient::FrameStream> stream)
+        : m_stream(move(stream))
+    {
+        m_stream->on_frames_decoded = [this](u32 start_frame_index, Vector<ImageDecoderClient::Frame>& frames) {
+            if (!on_frames_decoded)
+                return;
+            Vector<Web::Platform::Frame> decoded_frames;
+            for (auto& frame : frames)
+                decoded_frames.empend(move(frame.bitmap), frame.duration);
+            on_frames_decoded(start_frame_index, decoded_frames);
+        };
+    }
+
+    virtual ~ImageDecoderFrameStream() override
+    {
+        m_stream->on_frames_decoded = nullptr;
+    }
+
+    virtual void request_frames(size_t start_frame_index, size_t frame_count) override
+    {
+        m_stream->request_frames(start_frame_index, frame_count);
+    }
+
+private:
+    NonnullRefPtr<ImageDecoderClient::FrameStream> m_stream;
+};
+
+static Web::Platform::DecodedImage to_platform_decoded_image(ImageDecoderClient::DecodedImage& result)
+{
+    // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
+    Web::Platform::DecodedImage decoded_image;
+    decoded_image.is_animated = result.is_animated;
+    decoded_image.loop_count = result.loop_count;
+    decoded_image.natural_size = result.natural_size;
+    decoded_image.frame_count = result.frame_stream ? result.frame_stream->frame_count() : result.frames.size();
+    if (result.frame_stream)
+        decoded_image.frame_stream = adopt_ref(*new ImageDecoderFrameStream(result.frame_stream.release_nonnull()));
+    for (auto& frame : result.frames) {
+        decoded_image.frames.empend(move(frame.bitmap), frame.duration);
+    }
+    return decoded_image;
+}
+
+class ImageDecoderDecodingSession final : public Web::Platform::DecodingSession {
+public:
+    explicit ImageDecoderDecodingSession(NonnullRefPtr<ImageDecoderClient::DecodingSession> session)
+        : m_session(move(session))
+    {
+        m_session->on_partial_image = [this](NonnullRefPtr<Gfx::Bitmap> bitmap) {
+            if (on_partial_image)
+                on_partial_image(move(bitmap));
+        };
+    }
+
+    virtual ~ImageDecoderDecodingSession() override
+    {
+        m_session->on_partial_image = nullptr;
+    }
+
+    virtual ErrorOr<void> append(ReadonlyBytes bytes) override
+    {
+        return m_session->append(bytes);
+    }
+
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> finish(Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size) override
+    {
+        auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
+        if (on_resolved)
+            promise->on_resolution = move(on_resolved);
+        if (on_rejected)
+            promise->on_rejection = move(on_rejected);
+
+        (void)m_session->finish(
+            [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
+                promise->resolve(to_platform_decoded_image(result));
+                return {};
+            },
+            [promise](auto& error) {
+                promise->reject(Error::copy(error));
+            },
+            ideal_size);
+
+        return promise;
+    }
+
+private:
+    NonnullRefPtr<ImageDecoderClient::DecodingSession> m_session;
+};
+
 ImageCodecPlugin::ImageCodecPlugin(NonnullRefPtr<ImageDecoderClient::Client> client)
     : m_client(move(client))
 {
@@ -31,7 +122,7 @@ void ImageCodecPlugin::set_client(NonnullRefPtr<ImageDecoderClient::Client> clie
 
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
-NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size)
 {
     auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
     if (on_resolved)
@@ -47,21 +138,26 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
     auto image_decoder_promise = m_client->decode_image(
         bytes,
         [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
-            // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
-            Web::Platform::DecodedImage decoded_image;
-            decoded_image.is_animated = result.is_animated;
-            decoded_image.loop_count = result.loop_count;
-            for (auto& frame : result.frames) {
-                decoded_image.frames.empend(move(frame.bitmap), frame.duration);
-            }
-            promise->resolve(move(decoded_image));
+            promise->resolve(to_platform_decoded_image(result));
             return {};
         },
         [promise](auto& error) {
             promise->reject(Error::copy(error));
-        });
+        },
+        ideal_size);
 
     return promise;
 }
 
+RefPtr<Web::Platform::DecodingSession> ImageCodecPlugin::start_decoding_session()
+{
+    if (!m_client)
+        return nullptr;
+
+    auto session = m_client->start_decoding_session();
+    if (!session)
+        return nullptr;
+    return adopt_ref(*new ImageDecoderDecodingSession(session.release_nonnull()));
+}
+
 }
@@ -19,6 +19,7 @@
 #include <AK/TypeCasts.h>
 #include <Ladybird/Qt/TabBar.h>
 #include <Ladybird/Utilities.h>
+#include <LibIPC/Statistics.h>
 #include <LibWeb/CSS/PreferredColorScheme.h>
 #include <LibWeb/CSS/PreferredContrast.h>
 #include <LibWeb/CSS/PreferredMotion.h>
@@ -90,6 +91,10 @@ BrowserWindow::BrowserWindow(Vector<URL::URL> const& initial_urls, IsPopupWindow
             if (m_device_pixel_ratio != devicePixelRatio())
                 device_pixel_ratio_changed(devicePixelRatio());
 
+            for_each_tab([](auto& tab) {
+                tab.view().update_maximum_frames_per_second();
+            });
+
             // Listen for logicalDotsPerInchChanged signals on new screen
             QObject::disconnect(m_current_screen, &QScreen::logicalDotsPerInchChanged, nullptr, nullptr);
             m_current_screen = screen;
@@ -437,6 +442,13 @@ BrowserWindow::BrowserWindow(Vector<URL::URL> const& initial_urls, IsPopupWindow
         debug_request("dump-local-storage");
     });
 
+    auto* dump_ipc_statistics_action = new QAction("Dump &IPC Statistics", this);
+    debug_menu->addAction(dump_ipc_statistics_action);
+    QObject::connect(dump_ipc_statistics_action, &QAction::triggered, this, [this] {
+        IPC::Statistics::dump();
+        debug_request("dump-ipc-statistics");
+    });
+
     debug_menu->addSeparator();
 
     m_show_line_box_borders_action = new QAction("Show Line Box Borders", this);
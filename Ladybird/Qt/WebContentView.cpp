@@ -41,6 +41,7 @@
 #include <QPaintEvent>
 #include <QPainter>
 #include <QPalette>
+#include <QScreen>
 #include <QScrollBar>
 #include <QTextEdit>
 #include <QTimer>
@@ -556,6 +557,12 @@ void WebContentView::set_device_pixel_ratio(double device_pixel_ratio)
     handle_resize();
 }
 
+void WebContentView::update_maximum_frames_per_second()
+{
+    if (auto* screen = this->screen())
+        client().async_set_maximum_frames_per_second(m_client_state.page_index, screen->refreshRate());
+}
+
 void WebContentView::update_viewport_size()
 {
     auto scaled_width = int(viewport()->width() * m_device_pixel_ratio);
@@ -575,6 +582,7 @@ void WebContentView::showEvent(QShowEvent* event)
 {
     QAbstractScrollArea::showEvent(event);
     client().async_set_system_visibility_state(m_client_state.page_index, true);
+    update_maximum_frames_per_second();
 }
 
 void WebContentView::hideEvent(QHideEvent* event)
@@ -647,15 +655,11 @@ void WebContentView::initialize_client(WebView::ViewImplementation::CreateNewCli
         m_client_state = {};
 
         auto& request_server_client = static_cast<Ladybird::Application*>(QApplication::instance())->request_server_client;
-
-        // FIXME: Fail to open the tab, rather than crashing the whole application if this fails
-        auto request_server_socket = connect_new_request_server_client(*request_server_client).release_value_but_fixme_should_propagate_errors();
-
         auto image_decoder = static_cast<Ladybird::Application*>(QApplication::instance())->image_decoder_client();
-        auto image_decoder_socket = connect_new_image_decoder_client(*image_decoder).release_value_but_fixme_should_propagate_errors();
 
+        // FIXME: Fail to open the tab, rather than crashing the whole application if this fails
         auto candidate_web_content_paths = get_paths_for_helper_process("WebContent"sv).release_value_but_fixme_should_propagate_errors();
-        auto new_client = launch_web_content_process(*this, candidate_web_content_paths, AK::move(image_decoder_socket), AK::move(request_server_socket)).release_value_but_fixme_should_propagate_errors();
+        auto new_client = launch_web_content_process(*this, candidate_web_content_paths, *image_decoder, *request_server_client).release_value_but_fixme_should_propagate_errors();
 
         m_client_state.client = new_client;
     } else {
@@ -672,6 +676,7 @@ void WebContentView::initialize_client(WebView::ViewImplementation::CreateNewCli
     client().async_set_window_handle(m_client_state.page_index, m_client_state.client_handle);
 
     client().async_set_device_pixels_per_css_pixel(m_client_state.page_index, m_device_pixel_ratio);
+    update_maximum_frames_per_second();
     update_palette();
 
     update_screen_rects();
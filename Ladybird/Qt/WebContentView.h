@@ -76,6 +76,7 @@ public:
     void set_window_size(Gfx::IntSize);
     void set_window_position(Gfx::IntPoint);
     void set_device_pixel_ratio(double);
+    void update_maximum_frames_per_second();
 
     enum class PaletteMode {
         Default,
@@ -11,12 +11,14 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/Process.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 #include <LibTLS/Certificate.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 
 #if defined(AK_OS_MACOS)
 #    include <LibCore/Platform/ProcessStatisticsMach.h>
@@ -42,12 +44,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<ByteString> certificates;
     StringView mach_server_name;
     bool wait_for_debugger = false;
+    bool enable_http_disk_cache = false;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(serenity_resource_root, "Absolute path to directory for serenity resources", "serenity-resource-root", 'r', "serenity-resource-root");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
+    args_parser.add_option(enable_http_disk_cache, "Enable HTTP disk cache", "enable-http-disk-cache");
     args_parser.parse(arguments);
 
     if (wait_for_debugger)
@@ -64,6 +68,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     Core::EventLoop event_loop;
 
+    // NOTE: The disk cache hands the results of its I/O back to the event loop, so it has to be created after it.
+    if (enable_http_disk_cache) {
+        static constexpr u64 maximum_disk_cache_size = 256 * MiB;
+        auto disk_cache_directory = ByteString::formatted("{}/Ladybird/HTTP", Core::StandardPaths::cache_directory());
+        RequestServer::g_disk_cache = RequestServer::DiskCache::create(move(disk_cache_directory), maximum_disk_cache_size);
+    }
+
 #if defined(AK_OS_MACOS)
     if (!mach_server_name.is_empty())
         Core::Platform::register_with_mach_server(mach_server_name);
@@ -71,5 +82,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<RequestServer::ConnectionFromClient>());
 
-    return event_loop.exec();
+    auto exit_code = event_loop.exec();
+
+    // NOTE: Let the disk cache finish writing while the event loop it reports back to is still around.
+    RequestServer::g_disk_cache = nullptr;
+    return exit_code;
 }
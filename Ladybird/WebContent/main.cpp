@@ -31,6 +31,7 @@
 #include <LibWeb/Platform/EventLoopPluginSerenity.h>
 #include <WebContent/ConnectionFromClient.h>
 #include <WebContent/PageClient.h>
+#include <WebContent/StoragePlugin.h>
 #include <WebContent/WebDriverConnection.h>
 
 #if defined(HAVE_QT)
@@ -64,6 +65,10 @@ namespace Web::Fetch::Fetching {
 extern bool g_http_cache_enabled;
 }
 
+namespace Web::Painting {
+extern bool g_enable_paint_tracing;
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     AK::set_rich_debug_enabled(true);
@@ -102,6 +107,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool wait_for_debugger = false;
     bool log_all_js_exceptions = false;
     bool enable_idl_tracing = false;
+    bool enable_paint_tracing = false;
     bool enable_http_cache = false;
     bool force_cpu_painting = false;
     bool force_fontconfig = false;
@@ -119,6 +125,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(log_all_js_exceptions, "Log all JavaScript exceptions", "log-all-js-exceptions");
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
+    args_parser.add_option(enable_paint_tracing, "Enable paint tracing", "enable-paint-tracing");
     args_parser.add_option(enable_http_cache, "Enable HTTP cache", "enable-http-cache");
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
@@ -133,6 +140,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (force_fontconfig) {
         font_provider.set_name_but_fixme_should_create_custom_system_font_provider("FontConfig"_string);
     }
+    font_provider.set_index_path(Ladybird::FontPlugin::font_index_path());
     font_provider.load_all_fonts_from_uri("resource://fonts"sv);
 
     // Layout test mode implies internals object is exposed and the Skia CPU backend is used
@@ -180,6 +188,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         Web::WebIDL::g_enable_idl_tracing = true;
     }
 
+    if (enable_paint_tracing) {
+        Web::Painting::g_enable_paint_tracing = true;
+    }
+
     auto maybe_content_filter_error = load_content_filters(config_path);
     if (maybe_content_filter_error.is_error())
         dbgln("Failed to load content filters: {}", maybe_content_filter_error.error());
@@ -190,6 +202,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     auto webcontent_socket = TRY(Core::take_over_socket_from_system_server("WebContent"sv));
     auto webcontent_client = TRY(WebContent::ConnectionFromClient::try_create(move(webcontent_socket)));
+    Web::Platform::StoragePlugin::install(*new WebContent::StoragePlugin(*webcontent_client));
 
     webcontent_client->on_image_decoder_connection = [&](auto& socket_file) {
         auto maybe_error = reinitialize_image_decoder(socket_file);
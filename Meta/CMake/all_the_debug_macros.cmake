@@ -17,6 +17,7 @@ set(GHASH_PROCESS_DEBUG ON)
 set(GIF_DEBUG ON)
 set(HEAP_DEBUG ON)
 set(HIGHLIGHT_FOCUSED_FRAME_DEBUG ON)
+set(HTML_LONG_TASK_DEBUG ON)
 set(HTML_SCRIPT_DEBUG ON)
 set(HTTPJOB_DEBUG ON)
 set(HUNKS_DEBUG ON)
@@ -510,6 +510,10 @@ void do_message_for_proxy(SourceGenerator message_generator, Endpoint const& end
         } else if (is_try) {
             message_generator.append(R"~~~(
         auto result = m_connection.template send_sync_but_allow_failure<Messages::@endpoint.name@::@message.pascal_name@>()~~~");
+        } else if (message.is_synchronous) {
+            message_generator.append(R"~~~(
+        // FIXME: Handle post_message failures.
+        (void) m_connection.post_message_ignoring_response(Messages::@endpoint.name@::@message.pascal_name@ { )~~~");
         } else {
             message_generator.append(R"~~~(
         // FIXME: Handle post_message failures.
@@ -562,10 +566,47 @@ void do_message_for_proxy(SourceGenerator message_generator, Endpoint const& end
     })~~~");
     };
 
+    auto do_implement_proxy_with_response = [&](ByteString const& name, Vector<Parameter> const& parameters) {
+        message_generator.set("message.pascal_name", pascal_case(message.name));
+        message_generator.set("message.response_type", pascal_case(message.response_name()));
+        message_generator.set("handler_name", name);
+        message_generator.append(R"~~~(
+    NonnullRefPtr<Core::Promise<NonnullOwnPtr<Messages::@endpoint.name@::@message.response_type@>>> async_@handler_name@_with_response()~~~");
+
+        for (size_t i = 0; i < parameters.size(); ++i) {
+            auto const& parameter = parameters[i];
+            auto argument_generator = message_generator.fork();
+            argument_generator.set("argument.type", parameter.type);
+            argument_generator.set("argument.name", parameter.name);
+            argument_generator.append("@argument.type@ @argument.name@");
+            if (i != parameters.size() - 1)
+                argument_generator.append(", ");
+        }
+
+        message_generator.append(R"~~~() {
+        return m_connection.template send_async<Messages::@endpoint.name@::@message.pascal_name@>()~~~");
+
+        for (size_t i = 0; i < parameters.size(); ++i) {
+            auto const& parameter = parameters[i];
+            auto argument_generator = message_generator.fork();
+            argument_generator.set("argument.name", parameter.name);
+            if (is_primitive_or_simple_type(parameters[i].type))
+                argument_generator.append("@argument.name@");
+            else
+                argument_generator.append("move(@argument.name@)");
+            if (i != parameters.size() - 1)
+                argument_generator.append(", ");
+        }
+
+        message_generator.appendln(R"~~~();
+    })~~~");
+    };
+
     do_implement_proxy(message.name, message.inputs, message.is_synchronous, false);
     if (message.is_synchronous) {
         do_implement_proxy(message.name, message.inputs, false, false);
         do_implement_proxy(message.name, message.inputs, true, true);
+        do_implement_proxy_with_response(message.name, message.inputs);
     }
 }
 
@@ -73,6 +73,7 @@ static bool is_platform_object(Type const& type)
         "NavigationDestination"sv,
         "NavigationHistoryEntry"sv,
         "Node"sv,
+        "OffscreenCanvas"sv,
         "Path2D"sv,
         "PerformanceEntry"sv,
         "PerformanceMark"sv,
@@ -463,7 +464,10 @@ static void generate_to_integral(SourceGenerator& scoped_generator, ParameterTyp
     scoped_generator.set("enforce_range", parameter.extended_attributes.contains("EnforceRange") ? "Yes" : "No");
     scoped_generator.set("clamp", parameter.extended_attributes.contains("Clamp") ? "Yes" : "No");
 
-    if ((!optional && !parameter.type->is_nullable()) || optional_default_value.has_value()) {
+    // NOTE: A default value of null leaves the value empty, which needs an Optional just like having no default does.
+    bool has_non_null_default_value = optional_default_value.has_value() && optional_default_value.value() != "null"sv;
+
+    if ((!optional && !parameter.type->is_nullable()) || has_non_null_default_value) {
         scoped_generator.append(R"~~~(
     @cpp_type@ @cpp_name@;
 )~~~");
@@ -493,7 +497,7 @@ static void generate_to_integral(SourceGenerator& scoped_generator, ParameterTyp
 )~~~");
     }
 
-    if (optional_default_value.has_value()) {
+    if (has_non_null_default_value) {
         scoped_generator.append(R"~~~(
     else
         @cpp_name@ = static_cast<@cpp_type@>(@parameter.optional_default_value@);
@@ -1951,6 +1955,14 @@ enum class IsConstructor {
 
 static void generate_return_statement(SourceGenerator& generator, IDL::Type const& return_type, IDL::Interface const& interface)
 {
+    // NOTE: "retval" is always a local that dies here, so hand its string over instead of bumping its refcount.
+    if (return_type.is_string() && !return_type.is_nullable()) {
+        generator.append(R"~~~(
+    return JS::PrimitiveString::create(vm, move(retval));
+)~~~");
+        return;
+    }
+
     return generate_wrap_statement(generator, "retval", return_type, interface, "return"sv);
 }
 
@@ -3387,7 +3399,9 @@ void @class_name@::initialize(JS::Realm& realm)
 {
     auto this_value = vm.this_value();
     JS::Object* this_object = nullptr;
-    if (this_value.is_nullish())
+    if (this_value.is_object())
+        this_object = &this_value.as_object();
+    else if (this_value.is_nullish())
         this_object = &vm.current_realm()->global_object();
     else
         this_object = TRY(this_value.to_object(vm));
@@ -4213,6 +4227,7 @@ static void generate_using_namespace_definitions(SourceGenerator& generator)
     using namespace Web::PerformanceTimeline;
     using namespace Web::RequestIdleCallback;
     using namespace Web::ResizeObserver;
+    using namespace Web::ResourceTiming;
     using namespace Web::Selection;
     using namespace Web::StorageAPI;
     using namespace Web::Streams;
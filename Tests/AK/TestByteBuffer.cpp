@@ -63,6 +63,25 @@ TEST_CASE(zero_fill_new_elements_on_growth)
     EXPECT_EQ(buffer.span(), (Array<u8, 10> { 2, 2, 2, 2, 2, 2, 2, 2, 0, 0 }));
 }
 
+TEST_CASE(remove_and_clear_with_capacity)
+{
+    auto buffer = MUST(ByteBuffer::create_zeroed(64));
+    for (size_t i = 0; i < buffer.size(); ++i)
+        buffer[i] = static_cast<u8>(i);
+    auto capacity = buffer.capacity();
+
+    buffer.remove(0, 60);
+    EXPECT_EQ(buffer.span(), (Array<u8, 4> { 60, 61, 62, 63 }));
+    EXPECT_EQ(buffer.capacity(), capacity);
+
+    buffer.remove(1, 2);
+    EXPECT_EQ(buffer.span(), (Array<u8, 2> { 60, 63 }));
+
+    buffer.clear_with_capacity();
+    EXPECT(buffer.is_empty());
+    EXPECT_EQ(buffer.capacity(), capacity);
+}
+
 BENCHMARK_CASE(append)
 {
     ByteBuffer bb;
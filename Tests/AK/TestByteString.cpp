@@ -8,6 +8,7 @@
 
 #include <AK/ByteString.h>
 #include <AK/DeprecatedFlyString.h>
+#include <AK/NumericLimits.h>
 #include <AK/StringBuilder.h>
 #include <AK/Vector.h>
 #include <cstring>
@@ -129,6 +130,15 @@ TEST_CASE(to_int)
     EXPECT_EQ(ByteString("-123").to_number<int>().value(), -123);
 }
 
+TEST_CASE(number)
+{
+    EXPECT_EQ(ByteString::number(0), "0");
+    EXPECT_EQ(ByteString::number(-123), "-123");
+    EXPECT_EQ(ByteString::number(NumericLimits<i64>::min()), "-9223372036854775808");
+    EXPECT_EQ(ByteString::number(NumericLimits<u64>::max()), "18446744073709551615");
+    EXPECT_EQ(ByteString::number(0.25), "0.25");
+}
+
 TEST_CASE(to_lowercase)
 {
     EXPECT(ByteString("ABC").to_lowercase() == "abc");
@@ -327,3 +327,17 @@ TEST_CASE(move_assign)
     EXPECT_EQ(second.size(), static_cast<size_t>(3));
     EXPECT_EQ(second.get(2), Optional<int>(20));
 }
+
+BENCHMARK_CASE(hashmap_set_and_get)
+{
+    HashMap<u32, u32> map;
+    for (u32 i = 0; i < 1'000'000; ++i)
+        map.set(i * 2654435761u, i);
+
+    u32 sum = 0;
+    for (u32 i = 0; i < 1'000'000; ++i)
+        sum += map.get(i * 2654435761u).value_or(0);
+    Test::do_not_optimize(sum);
+
+    EXPECT_EQ(map.size(), 1'000'000u);
+}
@@ -12,6 +12,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/MemoryStream.h>
+#include <AK/NumericLimits.h>
 #include <AK/StringBuilder.h>
 #include <AK/Try.h>
 #include <AK/Utf8View.h>
@@ -262,6 +263,20 @@ TEST_CASE(ak_format)
     EXPECT_EQ(foo, "Hello friends"sv);
 }
 
+TEST_CASE(number)
+{
+    EXPECT_EQ(String::number(0), "0"sv);
+    EXPECT_EQ(String::number(-42), "-42"sv);
+    EXPECT_EQ(String::number(NumericLimits<i64>::min()), "-9223372036854775808"sv);
+    EXPECT_EQ(String::number(NumericLimits<u64>::max()), "18446744073709551615"sv);
+    EXPECT_EQ(String::number(static_cast<u8>(255)), "255"sv);
+    EXPECT_EQ(String::number(1.5), "1.5"sv);
+    EXPECT_EQ(String::number(true), "true"sv);
+
+    EXPECT(String::number(1234567).is_short_string());
+    EXPECT(!String::number(12345678).is_short_string());
+}
+
 TEST_CASE(replace)
 {
     {
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteString.h>
+#include <AK/HashTable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/SwissHashTable.h>
+#include <AK/Vector.h>
+
+TEST_CASE(construct)
+{
+    using IntTable = SwissHashTable<int>;
+    EXPECT(IntTable().is_empty());
+    EXPECT_EQ(IntTable().size(), 0u);
+    EXPECT(IntTable().begin() == IntTable().end());
+    EXPECT(!IntTable().contains(1));
+}
+
+TEST_CASE(basic_move)
+{
+    SwissHashTable<int> foo;
+    foo.set(1);
+    EXPECT_EQ(foo.size(), 1u);
+    auto bar = move(foo);
+    EXPECT_EQ(bar.size(), 1u);
+    EXPECT_EQ(foo.size(), 0u);
+    foo = move(bar);
+    EXPECT_EQ(bar.size(), 0u);
+    EXPECT_EQ(foo.size(), 1u);
+    EXPECT(foo.contains(1));
+}
+
+TEST_CASE(set_existing_entry)
+{
+    SwissHashTable<int> table;
+    EXPECT_EQ(table.set(1), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(table.set(1), AK::HashSetResult::ReplacedExistingEntry);
+    EXPECT_EQ(table.set(1, AK::HashSetExistingEntryBehavior::Keep), AK::HashSetResult::KeptExistingEntry);
+    EXPECT_EQ(table.size(), 1u);
+}
+
+TEST_CASE(range_loop)
+{
+    SwissHashTable<ByteString> strings;
+    EXPECT_EQ(strings.set("One"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.set("Two"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.set("Three"), AK::HashSetResult::InsertedNewEntry);
+
+    int loop_counter = 0;
+    for (auto& it : strings) {
+        EXPECT_EQ(it.is_empty(), false);
+        ++loop_counter;
+    }
+    EXPECT_EQ(loop_counter, 3);
+}
+
+TEST_CASE(many_strings)
+{
+    SwissHashTable<ByteString> strings;
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.set(ByteString::number(i)), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.size(), 999u);
+    for (int i = 0; i < 999; ++i)
+        EXPECT(strings.contains(ByteString::number(i)));
+    EXPECT(!strings.contains("foo"));
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.remove(ByteString::number(i)), true);
+    EXPECT_EQ(strings.is_empty(), true);
+}
+
+TEST_CASE(many_collisions)
+{
+    struct StringCollisionTraits : public DefaultTraits<ByteString> {
+        static unsigned hash(ByteString const&) { return 0; }
+    };
+
+    SwissHashTable<ByteString, StringCollisionTraits> strings;
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.set(ByteString::number(i)), AK::HashSetResult::InsertedNewEntry);
+
+    EXPECT_EQ(strings.set("foo"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.size(), 1000u);
+
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.remove(ByteString::number(i)), true);
+
+    EXPECT(strings.find("foo") != strings.end());
+}
+
+TEST_CASE(capacity_leak)
+{
+    SwissHashTable<int> table;
+    for (size_t i = 0; i < 10000; ++i) {
+        table.set(i);
+        table.remove(i);
+    }
+    EXPECT(table.capacity() < 100u);
+}
+
+TEST_CASE(tombstones_are_reused)
+{
+    struct IntCollisionTraits : public DefaultTraits<int> {
+        static unsigned hash(int) { return 0; }
+    };
+
+    SwissHashTable<int, IntCollisionTraits> table;
+    for (int i = 0; i < 100; ++i)
+        table.set(i);
+    auto capacity = table.capacity();
+
+    for (int i = 100; i < 10000; ++i) {
+        EXPECT(table.remove(i - 100));
+        table.set(i);
+    }
+
+    EXPECT_EQ(table.size(), 100u);
+    EXPECT_EQ(table.capacity(), capacity);
+    for (int i = 9900; i < 10000; ++i)
+        EXPECT(table.contains(i));
+}
+
+TEST_CASE(non_trivial_type_table)
+{
+    SwissHashTable<NonnullOwnPtr<int>> table;
+
+    table.set(make<int>(3));
+    table.set(make<int>(11));
+
+    for (int i = 0; i < 1000; ++i) {
+        table.set(make<int>(-i));
+    }
+    for (int i = 0; i < 10000; ++i) {
+        table.set(make<int>(i));
+        table.remove(make<int>(i));
+    }
+
+    EXPECT_EQ(table.remove_all_matching([&](auto&) { return true; }), true);
+    EXPECT(table.is_empty());
+    EXPECT_EQ(table.remove_all_matching([&](auto&) { return true; }), false);
+}
+
+TEST_CASE(iterator_removal)
+{
+    SwissHashTable<int> map;
+    for (int i = 0; i < 100; ++i)
+        map.set(i);
+
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        if (*it % 2 == 0)
+            map.remove(it);
+    }
+
+    EXPECT_EQ(map.size(), 50u);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(map.contains(i), i % 2 == 1);
+}
+
+TEST_CASE(clear_with_capacity)
+{
+    SwissHashTable<ByteString> table;
+    for (int i = 0; i < 100; ++i)
+        table.set(ByteString::number(i));
+    auto capacity = table.capacity();
+
+    table.clear_with_capacity();
+    EXPECT(table.is_empty());
+    EXPECT_EQ(table.capacity(), capacity);
+    EXPECT(!table.contains("1"));
+
+    table.set("1");
+    EXPECT(table.contains("1"));
+}
+
+TEST_CASE(copy)
+{
+    SwissHashTable<int> table;
+    for (int i = 0; i < 1000; ++i)
+        table.set(i);
+
+    auto copy = table;
+    EXPECT_EQ(copy.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT(copy.contains(i));
+}
+
+// Benchmarks comparing HashTable's Robin Hood probing with SwissHashTable's group probing.
+
+static constexpr size_t benchmark_key_count = 100'000;
+
+static Vector<u32> sequential_keys()
+{
+    Vector<u32> keys;
+    for (u32 i = 0; i < benchmark_key_count; ++i)
+        keys.append(i);
+    return keys;
+}
+
+static Vector<u32> scattered_keys()
+{
+    // A fixed LCG keeps the keys the same between runs and between the two tables.
+    Vector<u32> keys;
+    u32 state = 0x12345678;
+    for (size_t i = 0; i < benchmark_key_count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        keys.append(state);
+    }
+    return keys;
+}
+
+static Vector<FlatPtr> pointer_keys()
+{
+    // Heap addresses are 16-byte aligned and clustered, which is the common case for sets of pointers.
+    Vector<FlatPtr> keys;
+    for (size_t i = 0; i < benchmark_key_count; ++i)
+        keys.append(0x7f0000001000 + i * 48);
+    return keys;
+}
+
+static Vector<ByteString> string_keys()
+{
+    Vector<ByteString> keys;
+    for (size_t i = 0; i < benchmark_key_count; ++i)
+        keys.append(ByteString::formatted("property_{}", i));
+    return keys;
+}
+
+template<typename Table, typename Key>
+static void insert_and_look_up(Vector<Key> const& keys)
+{
+    Table table;
+    for (auto const& key : keys)
+        table.set(key);
+
+    // Look up every key once, then probe for as many values that are not in the table.
+    size_t found = 0;
+    for (auto const& key : keys) {
+        if (table.contains(key))
+            ++found;
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (table.find(static_cast<unsigned>(i * 2654435761u), [](auto const&) { return false; }) != table.end())
+            ++found;
+    }
+    EXPECT_EQ(found, keys.size());
+}
+
+template<typename Table, typename Key>
+static void insert_and_remove(Vector<Key> const& keys)
+{
+    Table table;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        table.set(keys[i]);
+        if (i >= 1000)
+            table.remove(keys[i - 1000]);
+    }
+    EXPECT_EQ(table.size(), 1000u);
+}
+
+BENCHMARK_CASE(sequential_ints_hash_table)
+{
+    insert_and_look_up<HashTable<u32>>(sequential_keys());
+}
+
+BENCHMARK_CASE(sequential_ints_swiss_hash_table)
+{
+    insert_and_look_up<SwissHashTable<u32>>(sequential_keys());
+}
+
+BENCHMARK_CASE(scattered_ints_hash_table)
+{
+    insert_and_look_up<HashTable<u32>>(scattered_keys());
+}
+
+BENCHMARK_CASE(scattered_ints_swiss_hash_table)
+{
+    insert_and_look_up<SwissHashTable<u32>>(scattered_keys());
+}
+
+BENCHMARK_CASE(pointers_hash_table)
+{
+    insert_and_look_up<HashTable<FlatPtr>>(pointer_keys());
+}
+
+BENCHMARK_CASE(pointers_swiss_hash_table)
+{
+    insert_and_look_up<SwissHashTable<FlatPtr>>(pointer_keys());
+}
+
+BENCHMARK_CASE(strings_hash_table)
+{
+    insert_and_look_up<HashTable<ByteString>>(string_keys());
+}
+
+BENCHMARK_CASE(strings_swiss_hash_table)
+{
+    insert_and_look_up<SwissHashTable<ByteString>>(string_keys());
+}
+
+BENCHMARK_CASE(sliding_window_hash_table)
+{
+    insert_and_remove<HashTable<u32>>(scattered_keys());
+}
+
+BENCHMARK_CASE(sliding_window_swiss_hash_table)
+{
+    insert_and_remove<SwissHashTable<u32>>(scattered_keys());
+}
@@ -65,6 +65,18 @@ TEST_CASE(encode_utf8)
         EXPECT_EQ(MUST(view.to_utf8(Utf16View::AllowInvalidCodeUnits::Yes)), "\xed\xa0\xbd"sv);
         EXPECT(view.to_utf8(Utf16View::AllowInvalidCodeUnits::No).is_error());
     }
+    {
+        // Lonely surrogates in between valid runs.
+        auto encoded = Array { (u16)0x61, 0xd800, 0x62, 0xd83d, 0xde00, 0xdc00, 0x63 };
+        Utf16View view { encoded };
+        auto utf8 = MUST(view.to_utf8(Utf16View::AllowInvalidCodeUnits::Yes));
+        EXPECT_EQ(utf8, "a\xed\xa0\x80"
+                        "b😀\xed\xb0\x80"
+                        "c"sv);
+
+        auto round_trip = MUST(AK::utf8_to_utf16(utf8));
+        EXPECT(Utf16View { round_trip } == view);
+    }
 }
 
 TEST_CASE(decode_utf16)
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibArchive/MappedZip.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ThreadPool.h>
+
+#define TEST_INPUT(x) ("test-inputs/" x)
+
+static constexpr auto lorem_line = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.\n"sv;
+
+// Members are only read on the shared thread pool if it has more than one thread, which it does not on single-core
+// machines.
+static void use_several_threads()
+{
+    Threading::ThreadPool::shut_down_default();
+    Threading::ThreadPool::set_default_thread_count(4);
+}
+
+TEST_CASE(look_up_members)
+{
+    auto zip = TRY_OR_FAIL(Archive::MappedZip::open(TEST_INPUT("archive.zip"sv)));
+
+    auto members = zip->members();
+    EXPECT_EQ(members.size(), 3u);
+    EXPECT_EQ(members[0].name, "hello.txt"sv);
+    EXPECT_EQ(members[1].name, "lorem.txt"sv);
+    EXPECT_EQ(members[2].name, "nested/empty.txt"sv);
+
+    auto const* hello = zip->find_member("hello.txt"sv);
+    EXPECT_EQ(hello, &members[0]);
+    EXPECT_EQ(hello->compression_method, Archive::ZipCompressionMethod::Store);
+    EXPECT_EQ(TRY_OR_FAIL(zip->read_member(*hello)).bytes(), "Hello, world!\n"sv.bytes());
+
+    auto const* lorem = zip->find_member("lorem.txt"sv);
+    EXPECT_EQ(lorem, &members[1]);
+    EXPECT_EQ(lorem->compression_method, Archive::ZipCompressionMethod::Deflate);
+    auto lorem_contents = TRY_OR_FAIL(zip->read_member(*lorem));
+    EXPECT_EQ(lorem_contents.size(), lorem_line.length() * 8);
+    for (size_t offset = 0; offset < lorem_contents.size(); offset += lorem_line.length())
+        EXPECT_EQ(lorem_contents.bytes().slice(offset, lorem_line.length()), lorem_line.bytes());
+
+    auto const* empty = zip->find_member("nested/empty.txt"sv);
+    EXPECT_EQ(empty, &members[2]);
+    EXPECT(TRY_OR_FAIL(zip->read_member(*empty)).is_empty());
+}
+
+TEST_CASE(look_up_missing_members)
+{
+    auto zip = TRY_OR_FAIL(Archive::MappedZip::open(TEST_INPUT("archive.zip"sv)));
+
+    EXPECT_EQ(zip->find_member("missing.txt"sv), nullptr);
+    EXPECT_EQ(zip->find_member(""sv), nullptr);
+    EXPECT_EQ(zip->find_member("nested"sv), nullptr);
+    EXPECT_EQ(zip->find_member("nested/"sv), nullptr);
+    EXPECT_EQ(zip->find_member("HELLO.TXT"sv), nullptr);
+    EXPECT_EQ(zip->find_member("hello.txt/"sv), nullptr);
+}
+
+TEST_CASE(read_member_stream)
+{
+    auto zip = TRY_OR_FAIL(Archive::MappedZip::open(TEST_INPUT("archive.zip"sv)));
+
+    auto stream = TRY_OR_FAIL(zip->open_member(*zip->find_member("lorem.txt"sv)));
+    for (size_t i = 0; i < 8; ++i) {
+        Array<u8, lorem_line.length()> line;
+        TRY_OR_FAIL(stream->read_until_filled(line));
+        EXPECT_EQ(line.span(), lorem_line.bytes());
+    }
+    EXPECT(TRY_OR_FAIL(stream->read_until_eof()).is_empty());
+    EXPECT(stream->is_eof());
+}
+
+TEST_CASE(read_several_members)
+{
+    use_several_threads();
+
+    auto zip = TRY_OR_FAIL(Archive::MappedZip::open(TEST_INPUT("archive.zip"sv)));
+
+    Vector<Archive::ZipMember const*> members;
+    for (auto const& member : zip->members())
+        members.append(&member);
+
+    auto contents = TRY_OR_FAIL(zip->read_members(members));
+    EXPECT_EQ(contents.size(), 3u);
+    EXPECT_EQ(contents[0].bytes(), "Hello, world!\n"sv.bytes());
+    EXPECT_EQ(contents[1].size(), lorem_line.length() * 8);
+    EXPECT(contents[2].is_empty());
+}
+
+TEST_CASE(reject_truncated_central_directory)
+{
+    // The end of central directory record claims three members, but the central directory only holds two.
+    EXPECT(Archive::MappedZip::open(TEST_INPUT("truncated-central-directory.zip"sv)).is_error());
+}
+
+TEST_CASE(reject_corrupted_member)
+{
+    auto zip = TRY_OR_FAIL(Archive::MappedZip::open(TEST_INPUT("corrupted-member.zip"sv)));
+
+    auto const* hello = zip->find_member("hello.txt"sv);
+    EXPECT(hello);
+    EXPECT(zip->read_member(*hello).is_error());
+
+    auto stream = TRY_OR_FAIL(zip->open_member(*hello));
+    EXPECT(stream->read_until_eof().is_error());
+
+    // The other members are not affected, but reading them together with the corrupted one fails.
+    use_several_threads();
+    EXPECT(!zip->read_member(*zip->find_member("lorem.txt"sv)).is_error());
+    Array<Archive::ZipMember const*, 2> members { zip->find_member("lorem.txt"sv), hello };
+    EXPECT(zip->read_members(members).is_error());
+}
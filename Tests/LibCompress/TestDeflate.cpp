@@ -8,6 +8,7 @@
 
 #include <AK/Array.h>
 #include <AK/BitStream.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/MemoryStream.h>
 #include <AK/Random.h>
 #include <LibCompress/Deflate.h>
@@ -152,6 +153,27 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(deflate_round_trip_compress_skewed)
+{
+    // Make some bytes far rarer than others, so that their codes are longer than what a single table lookup can decode
+    auto original = ByteBuffer::create_uninitialized(64 * KiB).release_value();
+    for (auto& byte : original.bytes())
+        byte = count_trailing_zeroes(get_random<u32>() | 0x80000000) * 8 + (get_random<u8>() & 7);
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::FAST));
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
+TEST_CASE(deflate_round_trip_compress_in_parallel)
+{
+    auto size = Compress::DeflateCompressor::parallel_chunk_size * 5 + 1234;
+    auto original = ByteBuffer::create_zeroed(size).release_value();
+    fill_with_random(original.bytes().trim(size / 2)); // the zeroes in the second half make for back references within each chunk
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all_in_parallel(original, Compress::DeflateCompressor::CompressionLevel::FAST, 4));
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
@@ -176,3 +198,15 @@ TEST_CASE(ossfuzz_58046)
     auto test_data = TRY_OR_FAIL(test_file->read_until_eof());
     EXPECT(Compress::DeflateDecompressor::decompress_all(test_data).is_error());
 }
+
+BENCHMARK_CASE(deflate_compress_and_decompress_text)
+{
+    // Repetitive, text-like input, so the compressor spends its time on match finding rather than on literals.
+    auto original = ByteBuffer::create_uninitialized(4 * MiB).release_value();
+    for (size_t i = 0; i < original.size(); ++i)
+        original[i] = "the quick brown fox jumps over the lazy dog "sv[(i * 7 + i / 1024) % 44];
+
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::GOOD));
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT_EQ(uncompressed.size(), original.size());
+}
@@ -2057,3 +2057,92 @@ TEST_CASE(xz_utils_unsupported_filter_flags_3)
     auto buffer_or_error = decompressor->read_until_eof(PAGE_SIZE);
     EXPECT(buffer_or_error.is_error());
 }
+
+// A file with two streams of two blocks each, followed by stream padding, as created by `xz --block-size`.
+static constexpr Array<u8, 496> multiple_streams_and_blocks {
+    0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, 0x04, 0xE6, 0xD6, 0xB4, 0x46, 0x02, 0x00, 0x21, 0x01,
+    0x16, 0x00, 0x00, 0x00, 0x74, 0x2F, 0xE5, 0xA3, 0xE0, 0x01, 0xFF, 0x00, 0x4F, 0x5D, 0x00, 0x24,
+    0x19, 0x49, 0x98, 0x6F, 0x10, 0x15, 0x88, 0x4C, 0x89, 0xFC, 0x9A, 0x2D, 0x80, 0xFA, 0xDB, 0xCF,
+    0xD0, 0x52, 0xAF, 0xB6, 0xAE, 0xA3, 0xDC, 0x21, 0x8B, 0x58, 0xA9, 0xA2, 0x98, 0xBC, 0xBF, 0x44,
+    0x23, 0x14, 0xFC, 0xB6, 0x7D, 0xC1, 0xEA, 0xBB, 0x92, 0x60, 0xEA, 0xEF, 0xDF, 0x69, 0x84, 0xA3,
+    0x80, 0x4A, 0x57, 0x3C, 0x60, 0xA5, 0x0C, 0x15, 0x73, 0x24, 0x90, 0xF1, 0xED, 0xD5, 0x39, 0xB9,
+    0x79, 0xDC, 0x33, 0x98, 0x93, 0x75, 0xC4, 0xE4, 0x3D, 0x1D, 0x6C, 0x96, 0x2E, 0x20, 0x00, 0x00,
+    0xF1, 0x73, 0x13, 0x44, 0x44, 0xD6, 0x19, 0x2E, 0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00,
+    0x74, 0x2F, 0xE5, 0xA3, 0xE0, 0x01, 0xFF, 0x00, 0x4F, 0x5D, 0x00, 0x38, 0x18, 0x4A, 0xAA, 0x9C,
+    0x01, 0xC3, 0xE3, 0x02, 0xC8, 0x01, 0x46, 0xC6, 0x0D, 0x3C, 0x22, 0x24, 0x4C, 0x27, 0xF8, 0x39,
+    0xC5, 0x23, 0xDB, 0x47, 0xA9, 0xA6, 0xB9, 0x68, 0x45, 0x2A, 0x23, 0x2C, 0x5C, 0x22, 0x59, 0x3A,
+    0xDE, 0xED, 0x2E, 0x40, 0x92, 0x15, 0xA7, 0x74, 0x91, 0x12, 0x19, 0xB3, 0xAC, 0xE9, 0xE9, 0x46,
+    0x26, 0x0C, 0x89, 0xA8, 0x4E, 0x64, 0x3B, 0x98, 0xAB, 0xCB, 0xFF, 0xDF, 0x34, 0xE6, 0xDD, 0xFF,
+    0xC7, 0xB2, 0x91, 0xF6, 0xA2, 0x41, 0xB0, 0x46, 0x00, 0x00, 0x00, 0x00, 0xCE, 0x50, 0x13, 0xF3,
+    0x5E, 0x4E, 0xFF, 0x14, 0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x74, 0x2F, 0xE5, 0xA3,
+    0xE0, 0x00, 0xAF, 0x00, 0x3C, 0x5D, 0x00, 0x05, 0x13, 0x0C, 0x23, 0xA2, 0xA2, 0xB5, 0xE8, 0x6A,
+    0xF2, 0x7A, 0xA4, 0xA7, 0xD0, 0x8E, 0xF9, 0x0B, 0xCC, 0x3C, 0x28, 0xBF, 0x7F, 0x14, 0x7E, 0x2D,
+    0x04, 0x3D, 0x02, 0xB3, 0xF8, 0x6C, 0x3B, 0x1A, 0xF6, 0xDC, 0x03, 0x03, 0x8F, 0x5D, 0x9C, 0xBC,
+    0x8B, 0x2B, 0x5A, 0x1E, 0x01, 0x59, 0x58, 0x32, 0xBC, 0x5C, 0x7B, 0x87, 0x47, 0x71, 0xEA, 0x0B,
+    0xD5, 0x87, 0x00, 0x00, 0x9E, 0x56, 0x3D, 0x2B, 0xFF, 0x43, 0xAB, 0xF9, 0x00, 0x03, 0x6B, 0x80,
+    0x04, 0x6B, 0x80, 0x04, 0x58, 0xB0, 0x01, 0x00, 0x47, 0x13, 0x52, 0x99, 0x14, 0x17, 0x3B, 0x30,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x04, 0x59, 0x5A, 0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, 0x04,
+    0xE6, 0xD6, 0xB4, 0x46, 0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x74, 0x2F, 0xE5, 0xA3,
+    0xE0, 0x02, 0x4D, 0x00, 0x53, 0x5D, 0x00, 0x32, 0x9C, 0xCA, 0xD9, 0x34, 0xD4, 0xB7, 0x17, 0x97,
+    0x74, 0xE8, 0xE7, 0xC0, 0x79, 0x79, 0xE5, 0xD2, 0x8B, 0x5B, 0x42, 0x4D, 0xDF, 0xAC, 0x92, 0xFC,
+    0x8F, 0x1F, 0x36, 0x8C, 0x23, 0x45, 0xDB, 0x3C, 0x27, 0x0C, 0x9C, 0x07, 0x4B, 0x2B, 0x9B, 0x6B,
+    0xA2, 0x67, 0xAD, 0x22, 0x57, 0x41, 0xEA, 0x81, 0xEA, 0xB6, 0x96, 0x05, 0x82, 0xDD, 0xCC, 0xFF,
+    0x55, 0xB6, 0x4B, 0x89, 0xF9, 0xC5, 0x80, 0xEE, 0xCE, 0x78, 0x29, 0x04, 0x43, 0x74, 0x54, 0x82,
+    0x33, 0x8C, 0xBB, 0xBA, 0x07, 0x00, 0x89, 0x9F, 0x14, 0x00, 0x00, 0x00, 0xA5, 0x34, 0x66, 0x25,
+    0xB8, 0xDD, 0xA0, 0xBB, 0x00, 0x01, 0x6F, 0xCE, 0x04, 0x00, 0x00, 0x00, 0xBF, 0xA8, 0xB0, 0xE3,
+    0xB1, 0xC4, 0x67, 0xFB, 0x02, 0x00, 0x00, 0x00, 0x00, 0x04, 0x59, 0x5A, 0x00, 0x00, 0x00, 0x00
+};
+
+TEST_CASE(decompress_all_multiple_streams_and_blocks)
+{
+    auto const& compressed = multiple_streams_and_blocks;
+
+    auto stream = MUST(try_make<FixedMemoryStream>(compressed));
+    auto decompressor = MUST(Compress::XzDecompressor::create(move(stream)));
+    auto expected = MUST(decompressor->read_until_eof(PAGE_SIZE));
+    EXPECT_EQ(expected.size(), 1790u);
+
+    for (size_t thread_count : { 1, 2, 4 }) {
+        auto buffer = MUST(Compress::XzDecompressor::decompress_all(compressed, thread_count));
+        EXPECT_EQ(buffer.span(), expected.span());
+    }
+
+    // A damaged block is reported no matter which thread decompresses it.
+    auto damaged = MUST(ByteBuffer::copy(compressed));
+    damaged[100] ^= 0x55;
+    EXPECT(Compress::XzDecompressor::decompress_all(damaged, 4).is_error());
+}
+
+TEST_CASE(decompress_all_many_blocks_on_several_threads)
+{
+    // Concatenated streams make up a valid file, so this gives us more blocks than threads.
+    constexpr size_t copy_count = 16;
+    ByteBuffer compressed;
+    for (size_t i = 0; i < copy_count; ++i)
+        MUST(compressed.try_append(multiple_streams_and_blocks));
+
+    auto expected_copy = MUST(Compress::XzDecompressor::decompress_all(multiple_streams_and_blocks, 1));
+    ByteBuffer expected;
+    for (size_t i = 0; i < copy_count; ++i)
+        MUST(expected.try_append(expected_copy));
+
+    // NOTE: The threads are started no matter how many cores there are.
+    for (size_t thread_count : { 2, 3, 8, 64 }) {
+        auto buffer = MUST(Compress::XzDecompressor::decompress_all(compressed, thread_count));
+        EXPECT_EQ(buffer.span(), expected.span());
+    }
+
+    // Damage a block in the middle of the file, which is unlikely to be decompressed on the calling thread.
+    auto damaged = MUST(ByteBuffer::copy(compressed));
+    damaged[multiple_streams_and_blocks.size() * (copy_count / 2) + 100] ^= 0x55;
+    for (size_t thread_count : { 2, 8 })
+        EXPECT(Compress::XzDecompressor::decompress_all(damaged, thread_count).is_error());
+
+    // An index that claims a different uncompressed size for a block than it has is reported as well.
+    auto damaged_index = MUST(ByteBuffer::copy(compressed));
+    auto const end_of_damaged_copy = multiple_streams_and_blocks.size() * (copy_count / 2 + 1);
+    // Stream padding, stream footer, index CRC32, index padding, and the second byte of the last record's uncompressed size.
+    damaged_index[end_of_damaged_copy - 4 - 12 - 4 - 3 - 1] ^= 0x01;
+    for (size_t thread_count : { 1, 8 })
+        EXPECT(Compress::XzDecompressor::decompress_all(damaged_index, thread_count).is_error());
+}
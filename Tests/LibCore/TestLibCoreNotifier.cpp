@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/System.h>
+#include <LibCore/Timer.h>
+#include <LibTest/TestCase.h>
+#include <unistd.h>
+
+TEST_CASE(notifiers_on_the_same_fd_all_fire)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Core::EventLoop event_loop;
+    IGNORE_USE_IN_ESCAPING_LAMBDA auto pipe_fds = MUST(Core::System::pipe2(0));
+    auto idle_pipe_fds = MUST(Core::System::pipe2(0));
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA int activation_count = 0;
+    IGNORE_USE_IN_ESCAPING_LAMBDA auto on_readable = [&] {
+        if (++activation_count == 2)
+            event_loop.quit(0);
+    };
+
+    auto first_read_notifier = Core::Notifier::construct(pipe_fds[0], Core::NotificationType::Read);
+    first_read_notifier->on_activation = [&] { on_readable(); };
+    auto second_read_notifier = Core::Notifier::construct(pipe_fds[0], Core::NotificationType::Read);
+    second_read_notifier->on_activation = [&] { on_readable(); };
+
+    auto idle_notifier = Core::Notifier::construct(idle_pipe_fds[0], Core::NotificationType::Read);
+    idle_notifier->on_activation = [] { FAIL("Notifier for an empty pipe was activated"); };
+
+    auto write_notifier = Core::Notifier::construct(pipe_fds[1], Core::NotificationType::Write);
+    write_notifier->on_activation = [&] {
+        write_notifier->set_enabled(false);
+        MUST(Core::System::write(pipe_fds[1], "x"sv.bytes()));
+    };
+
+    auto reaper = Core::Timer::create_single_shot(1000, [&event_loop] { event_loop.quit(1); });
+    reaper->start();
+
+    EXPECT_EQ(event_loop.exec(), 0);
+    EXPECT_EQ(activation_count, 2);
+
+    first_read_notifier->set_enabled(false);
+    second_read_notifier->set_enabled(false);
+    idle_notifier->set_enabled(false);
+    for (auto fd : { pipe_fds[0], pipe_fds[1], idle_pipe_fds[0], idle_pipe_fds[1] })
+        MUST(Core::System::close(fd));
+}
+
+TEST_CASE(disabled_notifiers_do_not_fire)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Core::EventLoop event_loop;
+    auto pipe_fds = MUST(Core::System::pipe2(0));
+    MUST(Core::System::write(pipe_fds[1], "x"sv.bytes()));
+
+    auto notifier = Core::Notifier::construct(pipe_fds[0], Core::NotificationType::Read);
+    notifier->on_activation = [] { FAIL("Disabled notifier was activated"); };
+    notifier->set_enabled(false);
+
+    auto timer = Core::Timer::create_single_shot(50, [&event_loop] { event_loop.quit(0); });
+    timer->start();
+    EXPECT_EQ(event_loop.exec(), 0);
+
+    MUST(Core::System::close(pipe_fds[0]));
+    MUST(Core::System::close(pipe_fds[1]));
+}
+
+TEST_CASE(regular_files_are_always_readable)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Core::EventLoop event_loop;
+    char path[] = "/tmp/TestLibCoreNotifier.XXXXXX";
+    auto fd = MUST(Core::System::mkstemp(path));
+    MUST(Core::System::unlink({ path, sizeof(path) - 1 }));
+    MUST(Core::System::write(fd, "contents"sv.bytes()));
+    MUST(Core::System::lseek(fd, 0, SEEK_SET));
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA int activation_count = 0;
+    auto notifier = Core::Notifier::construct(fd, Core::NotificationType::Read);
+    notifier->on_activation = [&] {
+        if (++activation_count == 3)
+            event_loop.quit(0);
+    };
+
+    auto reaper = Core::Timer::create_single_shot(1000, [&event_loop] { event_loop.quit(1); });
+    reaper->start();
+    EXPECT_EQ(event_loop.exec(), 0);
+
+    notifier->set_enabled(false);
+    MUST(Core::System::close(fd));
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Timer.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(timers_fire_in_order_of_their_deadlines)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Core::EventLoop event_loop;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Vector<int> fired_intervals;
+
+    // NOTE: These are far enough apart to end up on different levels of the timer wheel.
+    Vector<NonnullRefPtr<Core::Timer>> timers;
+    for (int interval : { 300, 5, 70, 0, 130, 20 }) {
+        timers.append(Core::Timer::create_single_shot(interval, [&, interval] {
+            fired_intervals.append(interval);
+            if (fired_intervals.size() == 6)
+                event_loop.quit(0);
+        }));
+        timers.last()->start();
+    }
+
+    EXPECT_EQ(event_loop.exec(), 0);
+    EXPECT_EQ(fired_intervals, (Vector<int> { 0, 5, 20, 70, 130, 300 }));
+}
+
+TEST_CASE(timers_do_not_fire_early)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Core::EventLoop event_loop;
+    IGNORE_USE_IN_ESCAPING_LAMBDA auto elapsed_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    IGNORE_USE_IN_ESCAPING_LAMBDA i64 elapsed_milliseconds = 0;
+
+    auto timer = Core::Timer::create_single_shot(100, [&] {
+        elapsed_milliseconds = elapsed_timer.elapsed_milliseconds();
+        event_loop.quit(0);
+    });
+    timer->start();
+
+    EXPECT_EQ(event_loop.exec(), 0);
+    EXPECT(elapsed_milliseconds >= 100);
+}
+
+TEST_CASE(stopped_timers_do_not_fire)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Core::EventLoop event_loop;
+    IGNORE_USE_IN_ESCAPING_LAMBDA size_t fired_count = 0;
+
+    Vector<NonnullRefPtr<Core::Timer>> timers;
+    for (int i = 0; i < 1000; ++i) {
+        timers.append(Core::Timer::create_single_shot(i % 50, [&] { ++fired_count; }));
+        timers.last()->start();
+    }
+    for (size_t i = 0; i < timers.size(); i += 2)
+        timers[i]->stop();
+
+    auto reaper = Core::Timer::create_single_shot(100, [&event_loop] { event_loop.quit(0); });
+    reaper->start();
+
+    EXPECT_EQ(event_loop.exec(), 0);
+    EXPECT_EQ(fired_count, 500u);
+}
+
+TEST_CASE(repeating_timer_keeps_firing)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Core::EventLoop event_loop;
+    IGNORE_USE_IN_ESCAPING_LAMBDA int fired_count = 0;
+
+    auto timer = Core::Timer::create_repeating(10, [&] {
+        if (++fired_count == 5)
+            event_loop.quit(0);
+    });
+    timer->start();
+
+    auto reaper = Core::Timer::create_single_shot(1000, [&event_loop] { event_loop.quit(1); });
+    reaper->start();
+
+    EXPECT_EQ(event_loop.exec(), 0);
+    EXPECT_EQ(fired_count, 5);
+}
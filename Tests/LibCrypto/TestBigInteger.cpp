@@ -201,6 +201,22 @@ TEST_CASE(test_unsigned_bigint_multiplication_with_big_numbers2)
     EXPECT_EQ(result.words(), expected_result);
 }
 
+TEST_CASE(test_unsigned_bigint_multiplication_with_karatsuba_sized_numbers)
+{
+    // F(2n) = F(n) * (2 * F(n + 1) - F(n))
+    for (size_t n : { 3000, 5000, 20000 }) {
+        auto fib_n = bigint_fibonacci(n);
+        auto twice_fib_n_plus_1 = bigint_fibonacci(n + 1).shift_left(1);
+        EXPECT_EQ(fib_n.multiplied_by(twice_fib_n_plus_1.minus(fib_n)), bigint_fibonacci(2 * n));
+    }
+
+    // F(m + n) = F(m) * F(n + 1) + F(m - 1) * F(n), where the operands are of quite different lengths.
+    size_t m = 20000;
+    size_t n = 3000;
+    auto result = bigint_fibonacci(m).multiplied_by(bigint_fibonacci(n + 1)).plus(bigint_fibonacci(m - 1).multiplied_by(bigint_fibonacci(n)));
+    EXPECT_EQ(result, bigint_fibonacci(m + n));
+}
+
 TEST_CASE(test_unsigned_bigint_simple_division)
 {
     Crypto::UnsignedBigInteger num1(27194);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
 #include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Checksum/CRC32.h>
 #include <LibCrypto/Checksum/cksum.h>
@@ -63,3 +64,59 @@ TEST_CASE(test_crc32)
     do_test("The quick brown fox jumps over the lazy dog"sv.bytes(), 0x414FA339);
     do_test("various CRC algorithms input data"sv.bytes(), 0x9BD366AE);
 }
+
+// NOTE: These are long enough to go through the vectorized implementations, and not a multiple of their block sizes.
+static ByteBuffer long_checksum_input()
+{
+    auto input = ByteBuffer::create_uninitialized(100'003).release_value();
+    u32 state = 1;
+    for (auto& byte : input.bytes()) {
+        state = state * 1103515245 + 12345;
+        byte = state >> 24;
+    }
+    return input;
+}
+
+TEST_CASE(test_adler32_long_input)
+{
+    auto input = long_checksum_input();
+
+    for (size_t offset : { 0, 1, 7 }) {
+        auto data = input.bytes().slice(offset);
+
+        u32 a = 1;
+        u32 b = 0;
+        for (auto byte : data) {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        EXPECT_EQ(Crypto::Checksum::Adler32(data).digest(), b << 16 | a);
+
+        Crypto::Checksum::Adler32 incremental;
+        incremental.update(data.trim(12'345));
+        incremental.update(data.slice(12'345));
+        EXPECT_EQ(incremental.digest(), b << 16 | a);
+    }
+}
+
+TEST_CASE(test_crc32_long_input)
+{
+    auto input = long_checksum_input();
+
+    for (size_t offset : { 0, 1, 7 }) {
+        auto data = input.bytes().slice(offset);
+
+        u32 crc = ~0u;
+        for (auto byte : data) {
+            crc ^= byte;
+            for (size_t i = 0; i < 8; ++i)
+                crc = (crc >> 1) ^ ((crc & 1) * 0xEDB88320);
+        }
+        EXPECT_EQ(Crypto::Checksum::CRC32(data).digest(), ~crc);
+
+        Crypto::Checksum::CRC32 incremental;
+        incremental.update(data.trim(12'345));
+        incremental.update(data.slice(12'345));
+        EXPECT_EQ(incremental.digest(), ~crc);
+    }
+}
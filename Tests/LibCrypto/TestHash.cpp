@@ -241,6 +241,25 @@ TEST_CASE(test_SHA256_hash_split_into_blocks)
     EXPECT(memcmp(result, digest.data, Crypto::Hash::SHA256::digest_size()) == 0);
 }
 
+TEST_CASE(test_SHA256_hash_million_a_in_uneven_updates)
+{
+    u8 result[] {
+        0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67, 0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0
+    };
+    u8 data[1000];
+    memset(data, 'a', sizeof(data));
+
+    Crypto::Hash::SHA256 sha;
+    size_t hashed = 0;
+    for (size_t update_size = 1; hashed < 1'000'000; update_size = update_size * 7 % 1000 + 1) {
+        auto length = min(update_size, 1'000'000 - hashed);
+        sha.update(data, length);
+        hashed += length;
+    }
+    auto digest = sha.digest();
+    EXPECT(memcmp(result, digest.data, Crypto::Hash::SHA256::digest_size()) == 0);
+}
+
 TEST_CASE(test_SHA384_name)
 {
     Crypto::Hash::SHA384 sha;
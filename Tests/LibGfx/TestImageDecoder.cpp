@@ -274,6 +274,26 @@ TEST_CASE(test_jpeg_sof2_successive_aproximation)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 600, 800 }));
 }
 
+TEST_CASE(test_jpeg_decode_to_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+
+    // NOTE: libjpeg scales by eighths, so we end up with the smallest of those that covers the ideal size.
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 140, 190 }));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(592, 800));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(148, 200));
+}
+
+TEST_CASE(test_jpeg_sof2_incomplete)
+{
+    // NOTE: This cuts the image off in its third scan, so we only get a coarse version of it.
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/successive_approximation.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes().trim(5300)));
+
+    TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 600, 800 }));
+}
+
 TEST_CASE(test_jpeg_empty_icc)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/gradient_empty_icc.jpg"sv)));
@@ -339,6 +359,26 @@ TEST_CASE(test_png)
     TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
 }
 
+TEST_CASE(test_png_decode_to_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 30, 60 }));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(64, 138));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(32, 69));
+}
+
+TEST_CASE(test_png_incomplete)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes().trim(file->size() / 2)));
+
+    // NOTE: The rows that we didn't get data for are left transparent.
+    auto frame = TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
+    EXPECT_EQ(frame.image->get_pixel(0, frame.image->height() - 1).alpha(), 0);
+}
+
 TEST_CASE(test_exif)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/exif.png"sv)));
@@ -653,6 +693,16 @@ TEST_CASE(test_webp_simple_lossy)
     EXPECT_EQ(frame.image->get_pixel(198, 202), Gfx::Color(0x7a, 0xaa, 0xd5, 255));
 }
 
+TEST_CASE(test_webp_decode_to_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/simple-vp8.webp"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::WebPImageDecoderPlugin::create(file->bytes()));
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 60, 30 }));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(240, 240));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(60, 60));
+}
+
 TEST_CASE(test_webp_simple_lossless)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/simple-vp8l.webp"sv)));
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibGfx/CMYKBitmap.h>
+#include <LibGfx/Color.h>
+#include <LibGfx/PixelKernels.h>
+#include <LibTest/TestCase.h>
+
+// NOTE: 1031 is prime, so the pixels hit every remainder of the vector loops, and cover a wide range of channel values.
+static Vector<Gfx::ARGB32> make_test_pixels()
+{
+    Vector<Gfx::ARGB32> pixels;
+    u32 state = 0x12345678;
+    for (size_t i = 0; i < 1031; ++i) {
+        state = state * 1664525 + 1013904223;
+        pixels.append(state);
+    }
+    // Make sure the edges of the alpha range are in there too.
+    pixels[0] &= 0x00ffffff;
+    pixels[1] |= 0xff000000;
+    pixels[2] = 0x80808080;
+    return pixels;
+}
+
+TEST_CASE(swap_red_and_blue)
+{
+    auto pixels = make_test_pixels();
+    Vector<Gfx::ARGB32> swapped;
+    swapped.resize(pixels.size());
+
+    Gfx::PixelKernels::swap_red_and_blue(pixels, swapped);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        auto color = Color::from_argb(pixels[i]);
+        EXPECT_EQ(swapped[i], Color(color.blue(), color.green(), color.red(), color.alpha()).value());
+    }
+
+    // Swapping in place twice gives back what we started with.
+    Gfx::PixelKernels::swap_red_and_blue(swapped, swapped);
+    EXPECT_EQ(swapped, pixels);
+}
+
+TEST_CASE(premultiply_alpha)
+{
+    auto pixels = make_test_pixels();
+    auto premultiplied = pixels;
+
+    Gfx::PixelKernels::premultiply_alpha(premultiplied);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        auto color = Color::from_argb(pixels[i]);
+        EXPECT_EQ(premultiplied[i], color.with_alpha(color.alpha(), Gfx::AlphaType::Premultiplied).value());
+    }
+}
+
+TEST_CASE(unpremultiply_alpha)
+{
+    auto pixels = make_test_pixels();
+    Gfx::PixelKernels::premultiply_alpha(pixels);
+    auto unpremultiplied = pixels;
+
+    Gfx::PixelKernels::unpremultiply_alpha(unpremultiplied);
+    for (size_t i = 0; i < pixels.size(); ++i)
+        EXPECT_EQ(unpremultiplied[i], Color::from_argb(pixels[i]).to_unpremultiplied().value());
+}
+
+TEST_CASE(cmyk_to_bgrx)
+{
+    auto pixels = make_test_pixels();
+    Vector<Gfx::CMYK> cmyk;
+    for (auto pixel : pixels)
+        cmyk.append({ static_cast<u8>(pixel), static_cast<u8>(pixel >> 8), static_cast<u8>(pixel >> 16), static_cast<u8>(pixel >> 24) });
+    Vector<Gfx::ARGB32> rgb;
+    rgb.resize(cmyk.size());
+
+    Gfx::PixelKernels::cmyk_to_bgrx(cmyk, rgb);
+    for (size_t i = 0; i < cmyk.size(); ++i) {
+        u8 k = 255 - cmyk[i].k;
+        EXPECT_EQ(rgb[i], Color((255 - cmyk[i].c) * k / 255, (255 - cmyk[i].m) * k / 255, (255 - cmyk[i].y) * k / 255).value());
+    }
+}
+
+TEST_CASE(rgb_lookup_transform)
+{
+    // An identity transform that swaps the red and blue channels in its matrix.
+    Gfx::PixelKernels::RGBLookupTransform transform;
+    transform.matrix = Gfx::FloatMatrix3x3(0, 0, 1, 0, 1, 0, 1, 0, 0);
+    for (size_t channel = 0; channel < 3; ++channel) {
+        for (size_t i = 0; i < 256; ++i)
+            transform.input_tables[channel][i] = i / 255.0f;
+        for (size_t i = 0; i < Gfx::PixelKernels::RGBLookupTransform::output_table_size; ++i)
+            transform.output_tables[channel][i] = round(255.0f * i / (Gfx::PixelKernels::RGBLookupTransform::output_table_size - 1));
+    }
+
+    auto pixels = make_test_pixels();
+    auto transformed = pixels;
+    Gfx::PixelKernels::apply_rgb_lookup_transform(transformed, transform);
+
+    Vector<Gfx::ARGB32> swapped;
+    swapped.resize(pixels.size());
+    Gfx::PixelKernels::swap_red_and_blue(pixels, swapped);
+    EXPECT_EQ(transformed, swapped);
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibIPC/Message.h>
+#include <LibIPC/SendQueue.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+
+struct MessageTag {
+    u32 producer { 0 };
+    u32 sequence { 0 };
+};
+
+static IPC::MessageBuffer make_message(u32 producer, u32 sequence)
+{
+    IPC::MessageBuffer message;
+    MessageTag tag { producer, sequence };
+    MUST(message.append_data(reinterpret_cast<u8 const*>(&tag), sizeof(tag)));
+    return message;
+}
+
+static MessageTag tag_of(IPC::MessageBuffer const& message)
+{
+    // NOTE: The tag follows the space the buffer reserves for the message size.
+    auto data = message.data();
+    VERIFY(data.size() >= sizeof(MessageTag));
+    MessageTag tag;
+    data.slice(data.size() - sizeof(tag)).copy_to({ &tag, sizeof(tag) });
+    return tag;
+}
+
+TEST_CASE(messages_from_one_thread_keep_their_order)
+{
+    auto queue = make_ref_counted<IPC::SendQueue>();
+
+    // Enough messages to overflow the ring several times over.
+    constexpr u32 message_count = IPC::SendQueue::capacity * 10;
+    for (u32 i = 0; i < message_count; ++i)
+        queue->enqueue(make_message(0, i));
+
+    for (u32 i = 0; i < message_count; ++i) {
+        auto message = queue->dequeue();
+        EXPECT(message.has_value());
+        EXPECT_EQ(tag_of(*message).sequence, i);
+    }
+    EXPECT(!queue->dequeue().has_value());
+}
+
+TEST_CASE(messages_posted_after_an_overflow_do_not_overtake_it)
+{
+    auto queue = make_ref_counted<IPC::SendQueue>();
+
+    u32 sequence = 0;
+    for (; sequence < IPC::SendQueue::capacity + 5; ++sequence)
+        queue->enqueue(make_message(0, sequence));
+
+    // This frees up slots in the ring, but the messages that follow must still go after the overflowed ones.
+    for (u32 i = 0; i < 10; ++i)
+        EXPECT_EQ(tag_of(*queue->dequeue()).sequence, i);
+
+    for (u32 i = 0; i < 5; ++i, ++sequence)
+        queue->enqueue(make_message(0, sequence));
+
+    for (u32 i = 10; i < sequence; ++i) {
+        auto message = queue->dequeue();
+        EXPECT(message.has_value());
+        EXPECT_EQ(tag_of(*message).sequence, i);
+    }
+    EXPECT(!queue->dequeue().has_value());
+
+    // Once drained, the ring is used again.
+    queue->enqueue(make_message(0, sequence));
+    EXPECT_EQ(tag_of(*queue->dequeue()).sequence, sequence);
+}
+
+TEST_CASE(messages_from_several_threads_keep_their_order)
+{
+    auto queue = make_ref_counted<IPC::SendQueue>();
+
+    constexpr u32 producer_count = 4;
+    constexpr u32 messages_per_producer = 10000;
+
+    Vector<NonnullRefPtr<Threading::Thread>> producers;
+    for (u32 producer = 0; producer < producer_count; ++producer) {
+        producers.append(Threading::Thread::construct([queue, producer] {
+            for (u32 i = 0; i < messages_per_producer; ++i)
+                queue->enqueue(make_message(producer, i));
+            return 0;
+        }));
+    }
+    for (auto& producer : producers)
+        producer->start();
+
+    Array<u32, producer_count> next_sequence {};
+    u32 received = 0;
+    bool in_order = true;
+    while (received < producer_count * messages_per_producer) {
+        auto message = queue->dequeue();
+        if (!message.has_value()) {
+            EXPECT(queue->wait_for_messages());
+            continue;
+        }
+
+        auto tag = tag_of(*message);
+        VERIFY(tag.producer < producer_count);
+        if (tag.sequence != next_sequence[tag.producer])
+            in_order = false;
+        next_sequence[tag.producer] = tag.sequence + 1;
+        ++received;
+    }
+
+    for (auto& producer : producers)
+        (void)producer->join();
+
+    EXPECT(in_order);
+    for (u32 producer = 0; producer < producer_count; ++producer)
+        EXPECT_EQ(next_sequence[producer], messages_per_producer);
+    EXPECT(!queue->dequeue().has_value());
+}
+
+TEST_CASE(stopping_wakes_up_the_send_thread)
+{
+    auto queue = make_ref_counted<IPC::SendQueue>();
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> was_running = true;
+    auto send_thread = Threading::Thread::construct([queue, &was_running] {
+        was_running.store(queue->wait_for_messages());
+        return 0;
+    });
+    send_thread->start();
+
+    queue->stop();
+    (void)send_thread->join();
+    EXPECT(!was_running.load());
+}
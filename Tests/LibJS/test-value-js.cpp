@@ -114,3 +114,61 @@ TEST_CASE(non_canon_nans)
 
 #undef EXPECT_TO_BE_NAN
 }
+
+TEST_CASE(number_to_string)
+{
+    EXPECT_EQ(number_to_string(0.0), "0"sv);
+    EXPECT_EQ(number_to_string(-0.0), "0"sv);
+    EXPECT_EQ(number_to_string(123.0), "123"sv);
+    EXPECT_EQ(number_to_string(-123.0), "-123"sv);
+    EXPECT_EQ(number_to_string(9007199254740991.0), "9007199254740991"sv);
+    EXPECT_EQ(number_to_string(9007199254740992.0), "9007199254740992"sv);
+    EXPECT_EQ(number_to_string(1e20), "100000000000000000000"sv);
+    EXPECT_EQ(number_to_string(1e21), "1e+21"sv);
+    EXPECT_EQ(number_to_string(1.5), "1.5"sv);
+    EXPECT_EQ(number_to_string(0.1), "0.1"sv);
+    EXPECT_EQ(number_to_string(-1e-7), "-1e-7"sv);
+    EXPECT_EQ(number_to_string(NAN), "NaN"sv);
+    EXPECT_EQ(number_to_string(-INFINITY), "-Infinity"sv);
+}
+
+TEST_CASE(string_to_number)
+{
+    EXPECT_EQ(string_to_number("123"sv), 123.0);
+    EXPECT_EQ(string_to_number("  -42\n"sv), -42.0);
+    EXPECT_EQ(string_to_number("+7"sv), 7.0);
+    EXPECT_EQ(string_to_number("007"sv), 7.0);
+    EXPECT(signbit(string_to_number("-0"sv)));
+    EXPECT_EQ(string_to_number("0x10"sv), 16.0);
+    EXPECT_EQ(string_to_number("1e3"sv), 1000.0);
+    EXPECT_EQ(string_to_number("12345678901234567"sv), 12345678901234568.0);
+    EXPECT_EQ(string_to_number(""sv), 0.0);
+    EXPECT(isnan(string_to_number("-"sv)));
+    EXPECT(isnan(string_to_number("12a"sv)));
+}
+
+BENCHMARK_CASE(number_to_string_integers)
+{
+    for (size_t i = 0; i < 1'000'000; ++i)
+        (void)number_to_string(static_cast<double>(i * 7919));
+}
+
+BENCHMARK_CASE(number_to_string_fractions)
+{
+    for (size_t i = 0; i < 1'000'000; ++i)
+        (void)number_to_string(static_cast<double>(i) / 64.0 + 0.1);
+}
+
+BENCHMARK_CASE(string_to_number_integers)
+{
+    Vector<String> strings;
+    for (size_t i = 0; i < 1000; ++i)
+        strings.append(String::number(i * 7919));
+
+    double sum = 0;
+    for (size_t i = 0; i < 1000; ++i) {
+        for (auto const& string : strings)
+            sum += string_to_number(string);
+    }
+    EXPECT(sum > 0);
+}
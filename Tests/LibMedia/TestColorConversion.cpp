@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibMedia/Color/ColorConverter.h>
+#include <LibTest/TestCase.h>
+
+static constexpr auto output_cicp = Media::CodingIndependentCodePoints(Media::ColorPrimaries::BT709, Media::TransferCharacteristics::SRGB, Media::MatrixCoefficients::BT709, Media::VideoFullRangeFlag::Full);
+
+template<typename T>
+static void expect_fixed_point_conversion_matches(u8 bit_depth, Media::CodingIndependentCodePoints cicp, int tolerance, int compare_from = 0)
+{
+    auto fixed_point_converter = Media::FixedPointColorConverter::create(bit_depth, cicp, output_cicp);
+    EXPECT(fixed_point_converter.has_value());
+    auto converter = MUST(Media::ColorConverter::create(bit_depth, cicp, output_cicp));
+
+    // Walk through Y, U and V with different step sizes, so that the row covers many combinations of them. The width
+    // is not a multiple of four, to make sure that the last pixels of a row are converted as well.
+    u32 const maximum_value = (1u << bit_depth) - 1;
+    Vector<T> y_row;
+    Vector<T> u_row;
+    Vector<T> v_row;
+    for (u32 i = 0; i < 1023; i++) {
+        y_row.append(static_cast<T>((i * 7) % (maximum_value + 1)));
+        u_row.append(static_cast<T>((i * 13) % (maximum_value + 1)));
+        v_row.append(static_cast<T>((i * 29) % (maximum_value + 1)));
+    }
+
+    Vector<u32> output;
+    output.resize(y_row.size());
+    fixed_point_converter->convert_row(y_row.data(), u_row.data(), v_row.data(), output.data(), output.size());
+
+    for (size_t i = 0; i < output.size(); i++) {
+        auto expected = converter.convert_yuv(y_row[i], u_row[i], v_row[i]);
+        auto actual = Gfx::Color::from_argb(output[i]);
+        EXPECT_EQ(actual.alpha(), 255);
+        auto expect_close = [&](int actual_value, int expected_value) {
+            if (expected_value >= compare_from)
+                EXPECT(abs(actual_value - expected_value) <= tolerance);
+        };
+        expect_close(actual.red(), expected.red());
+        expect_close(actual.green(), expected.green());
+        expect_close(actual.blue(), expected.blue());
+    }
+}
+
+TEST_CASE(fixed_point_conversion_without_transfer_conversion)
+{
+    for (auto matrix_coefficients : { Media::MatrixCoefficients::BT601, Media::MatrixCoefficients::BT709, Media::MatrixCoefficients::BT2020NonConstantLuminance }) {
+        for (auto range : { Media::VideoFullRangeFlag::Studio, Media::VideoFullRangeFlag::Full }) {
+            auto cicp = Media::CodingIndependentCodePoints(Media::ColorPrimaries::BT709, Media::TransferCharacteristics::SRGB, matrix_coefficients, range);
+            expect_fixed_point_conversion_matches<u8>(8, cicp, 1);
+            expect_fixed_point_conversion_matches<u16>(10, cicp, 1);
+            expect_fixed_point_conversion_matches<u16>(12, cicp, 1);
+        }
+    }
+}
+
+TEST_CASE(fixed_point_conversion_with_transfer_conversion)
+{
+    // NOTE: ColorConverter interpolates the transfer functions between far fewer points. That is too coarse for the steep
+    //       start of the sRGB curve, so we only compare the values above it.
+    auto cicp = Media::CodingIndependentCodePoints(Media::ColorPrimaries::BT709, Media::TransferCharacteristics::BT709, Media::MatrixCoefficients::BT709, Media::VideoFullRangeFlag::Studio);
+    expect_fixed_point_conversion_matches<u8>(8, cicp, 2, 32);
+    expect_fixed_point_conversion_matches<u16>(10, cicp, 2, 32);
+}
+
+TEST_CASE(fixed_point_conversion_unsupported)
+{
+    auto bt2020_primaries = Media::CodingIndependentCodePoints(Media::ColorPrimaries::BT2020, Media::TransferCharacteristics::BT709, Media::MatrixCoefficients::BT2020NonConstantLuminance, Media::VideoFullRangeFlag::Studio);
+    EXPECT(!Media::FixedPointColorConverter::create(10, bt2020_primaries, output_cicp).has_value());
+
+    auto hdr = Media::CodingIndependentCodePoints(Media::ColorPrimaries::BT709, Media::TransferCharacteristics::SMPTE2084, Media::MatrixCoefficients::BT709, Media::VideoFullRangeFlag::Studio);
+    EXPECT(!Media::FixedPointColorConverter::create(10, hdr, output_cicp).has_value());
+}
@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/EventLoop.h>
+#include <LibCore/MappedFile.h>
 #include <LibTest/TestCase.h>
 
 #include <LibMedia/Containers/Matroska/Reader.h>
+#include <LibMedia/StreamedMediaData.h>
 
 TEST_CASE(master_elements_containing_crc32)
 {
@@ -23,3 +26,95 @@ TEST_CASE(master_elements_containing_crc32)
     MUST(matroska_reader.seek_to_random_access_point(iterator, AK::Duration::from_seconds(7)));
     MUST(iterator.next_block());
 }
+
+struct StreamedFile {
+    // Hands the reader the data in small pieces, and only when it runs out.
+    template<typename Function>
+    auto receive_until_success(Function function)
+    {
+        while (true) {
+            auto result = function();
+            if (!result.is_error() || result.error().category() != Media::DecoderErrorCategory::NeedsMoreInput)
+                return result;
+            VERIFY(receive_position < contents.size());
+            auto chunk = contents.slice(receive_position, min(4 * KiB, contents.size() - receive_position));
+            streamed_data->write(receive_position, chunk);
+            receive_position += chunk.size();
+        }
+    }
+
+    ReadonlyBytes contents;
+    RefPtr<Media::StreamedMediaData> streamed_data;
+    size_t receive_position { 0 };
+};
+
+TEST_CASE(streamed_data_matches_complete_data)
+{
+    Core::EventLoop event_loop;
+    auto file = MUST(Core::MappedFile::map("vp9_in_webm.webm"sv));
+
+    StreamedFile streamed_file;
+    streamed_file.contents = file->bytes();
+    streamed_file.streamed_data = MUST(Media::StreamedMediaData::create(file->bytes().size(), [&](size_t offset) {
+        streamed_file.receive_position = offset;
+    }));
+    streamed_file.streamed_data->request_data_at(0);
+
+    auto reader = MUST(Media::Matroska::Reader::from_data(file->bytes()));
+    auto streamed_reader = MUST(streamed_file.receive_until_success([&] { return Media::Matroska::Reader::from_streamed_data(*streamed_file.streamed_data); }));
+    EXPECT(!streamed_file.streamed_data->is_complete());
+
+    auto iterator = MUST(reader.create_sample_iterator(1));
+    auto streamed_iterator = MUST(streamed_file.receive_until_success([&] { return streamed_reader.create_sample_iterator(1); }));
+
+    size_t block_count = 0;
+    while (true) {
+        auto block = iterator.next_block();
+        auto streamed_block = streamed_file.receive_until_success([&] { return streamed_iterator.next_block(); });
+        if (block.is_error()) {
+            EXPECT_EQ(block.error().category(), Media::DecoderErrorCategory::EndOfStream);
+            EXPECT(streamed_block.is_error());
+            EXPECT_EQ(streamed_block.error().category(), Media::DecoderErrorCategory::EndOfStream);
+            break;
+        }
+        EXPECT(!streamed_block.is_error());
+        EXPECT_EQ(block.value().timestamp(), streamed_block.value().timestamp());
+        EXPECT_EQ(block.value().frame_count(), streamed_block.value().frame_count());
+        EXPECT(block.value().frame(0) == streamed_block.value().frame(0));
+        block_count++;
+    }
+    EXPECT(block_count > 0);
+    EXPECT(streamed_file.streamed_data->is_complete());
+}
+
+TEST_CASE(streamed_data_seeks_without_receiving_everything)
+{
+    Core::EventLoop event_loop;
+    auto file = MUST(Core::MappedFile::map("master_elements_containing_crc32.mkv"sv));
+
+    StreamedFile streamed_file;
+    streamed_file.contents = file->bytes();
+    Vector<size_t> requested_offsets;
+    streamed_file.streamed_data = MUST(Media::StreamedMediaData::create(file->bytes().size(), [&](size_t offset) {
+        requested_offsets.append(offset);
+        streamed_file.receive_position = offset;
+    },
+        16 * KiB));
+    streamed_file.streamed_data->request_data_at(0);
+
+    auto reader = MUST(Media::Matroska::Reader::from_data(file->bytes()));
+    auto streamed_reader = MUST(streamed_file.receive_until_success([&] { return Media::Matroska::Reader::from_streamed_data(*streamed_file.streamed_data); }));
+
+    auto iterator = MUST(reader.seek_to_random_access_point(MUST(reader.create_sample_iterator(1)), AK::Duration::from_seconds(7)));
+    auto streamed_iterator = MUST(streamed_file.receive_until_success([&] { return streamed_reader.create_sample_iterator(1); }));
+    streamed_iterator = MUST(streamed_file.receive_until_success([&] { return streamed_reader.seek_to_random_access_point(streamed_iterator, AK::Duration::from_seconds(7)); }));
+
+    auto block = MUST(iterator.next_block());
+    auto streamed_block = MUST(streamed_file.receive_until_success([&] { return streamed_iterator.next_block(); }));
+    EXPECT_EQ(block.timestamp(), streamed_block.timestamp());
+    EXPECT(block.frame(0) == streamed_block.frame(0));
+
+    // The cues and the cluster we seeked to should have been asked for with range requests.
+    EXPECT(requested_offsets.size() > 1);
+    EXPECT(!streamed_file.streamed_data->is_complete());
+}
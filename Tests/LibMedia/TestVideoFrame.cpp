@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <LibMedia/VideoFrame.h>
+#include <LibTest/TestCase.h>
+
+static constexpr auto cicp = Media::CodingIndependentCodePoints(Media::ColorPrimaries::BT709, Media::TransferCharacteristics::BT709, Media::MatrixCoefficients::BT709, Media::VideoFullRangeFlag::Studio);
+
+// The value of each sample tells where it came from, so that we can check that it ended up in the right place.
+static u16 luma_sample(size_t row, size_t column) { return static_cast<u16>(row * 16 + column); }
+static u16 u_sample(size_t row, size_t column) { return static_cast<u16>(128 + row * 16 + column); }
+static u16 v_sample(size_t row, size_t column) { return static_cast<u16>(192 + row * 16 + column); }
+
+template<typename T>
+static void expect_planes_match(Media::SubsampledYUVFrame& frame, Gfx::Size<size_t> luma_size, Gfx::Size<size_t> chroma_size)
+{
+    auto const* y_plane = frame.get_plane_data<T>(0);
+    for (size_t row = 0; row < luma_size.height(); row++) {
+        for (size_t column = 0; column < luma_size.width(); column++)
+            EXPECT_EQ(y_plane[row * luma_size.width() + column], luma_sample(row, column));
+    }
+
+    auto const* u_plane = frame.get_plane_data<T>(1);
+    auto const* v_plane = frame.get_plane_data<T>(2);
+    for (size_t row = 0; row < chroma_size.height(); row++) {
+        for (size_t column = 0; column < chroma_size.width(); column++) {
+            EXPECT_EQ(u_plane[row * chroma_size.width() + column], u_sample(row, column));
+            EXPECT_EQ(v_plane[row * chroma_size.width() + column], v_sample(row, column));
+        }
+    }
+}
+
+TEST_CASE(nv12_frame)
+{
+    // An odd size makes the chroma planes round up, and the strides leave padding at the end of each row, like
+    // FFmpeg's frames do.
+    Gfx::Size<u32> const size { 5, 3 };
+    Media::Subsampling const subsampling { true, true };
+    constexpr size_t y_stride = 8;
+    constexpr size_t uv_stride = 8;
+
+    Vector<u8> y_data;
+    y_data.resize(y_stride * 3);
+    y_data.span().fill(0xFF);
+    for (size_t row = 0; row < 3; row++) {
+        for (size_t column = 0; column < 5; column++)
+            y_data[row * y_stride + column] = static_cast<u8>(luma_sample(row, column));
+    }
+
+    Vector<u8> uv_data;
+    uv_data.resize(uv_stride * 2);
+    uv_data.span().fill(0xFF);
+    for (size_t row = 0; row < 2; row++) {
+        for (size_t column = 0; column < 3; column++) {
+            uv_data[row * uv_stride + column * 2] = static_cast<u8>(u_sample(row, column));
+            uv_data[row * uv_stride + column * 2 + 1] = static_cast<u8>(v_sample(row, column));
+        }
+    }
+
+    auto frame = TRY_OR_FAIL(Media::SubsampledYUVFrame::try_create_from_semi_planar_data({}, size, 8, cicp, subsampling, y_data.span(), y_stride, uv_data.span(), uv_stride));
+    EXPECT_EQ(frame->size(), size);
+    EXPECT_EQ(frame->bit_depth(), 8);
+    expect_planes_match<u8>(*frame, { 5, 3 }, { 3, 2 });
+}
+
+TEST_CASE(p010_frame)
+{
+    // P010 stores its 10-bit samples in the high bits of each 16-bit value, and the low bits should be ignored.
+    Gfx::Size<u32> const size { 4, 2 };
+    Media::Subsampling const subsampling { true, true };
+    constexpr size_t y_stride = 12;
+    constexpr size_t uv_stride = 10;
+
+    auto stored_sample = [](u16 sample) { return static_cast<u16>(sample << 6 | 0x3F); };
+
+    Vector<u8> y_data;
+    y_data.resize(y_stride * 2);
+    y_data.span().fill(0xFF);
+    for (size_t row = 0; row < 2; row++) {
+        for (size_t column = 0; column < 4; column++) {
+            auto value = stored_sample(luma_sample(row, column));
+            memcpy(&y_data[row * y_stride + column * 2], &value, sizeof(value));
+        }
+    }
+
+    // NOTE: The last row doesn't need to be padded to the full stride.
+    Vector<u8> uv_data;
+    uv_data.resize(8);
+    for (size_t column = 0; column < 2; column++) {
+        auto u_value = stored_sample(u_sample(0, column));
+        auto v_value = stored_sample(v_sample(0, column));
+        memcpy(&uv_data[column * 4], &u_value, sizeof(u_value));
+        memcpy(&uv_data[column * 4 + 2], &v_value, sizeof(v_value));
+    }
+
+    auto frame = TRY_OR_FAIL(Media::SubsampledYUVFrame::try_create_from_semi_planar_data({}, size, 10, cicp, subsampling, y_data.span(), y_stride, uv_data.span(), uv_stride));
+    EXPECT_EQ(frame->bit_depth(), 10);
+    expect_planes_match<u16>(*frame, { 4, 2 }, { 2, 1 });
+}
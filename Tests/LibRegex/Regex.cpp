@@ -1090,6 +1090,84 @@ TEST_CASE(optimizer_alternation)
     }
 }
 
+TEST_CASE(optimizer_match_start)
+{
+    Array tests {
+        // Pattern, Subject, Expected match
+        Tuple { "\\d+px"sv, "width: 120px;"sv, "120px"sv },
+        Tuple { "(x|y)z"sv, "aaayz"sv, "yz"sv },
+        Tuple { "[b-d]+a"sv, "aaacba"sv, "cba"sv },
+        Tuple { "(?:foo)+bar"sv, "fofoofoobar"sv, "foobar"sv },
+        Tuple { "\\bword\\b"sv, "swords word"sv, "word"sv },
+        Tuple { "[^a]b"sv, "aabab"sv, "ab"sv },
+        Tuple { "(?<=a)b"sv, "cbab"sv, "b"sv },
+        Tuple { "foo\\d+"sv, "fo foo foo42"sv, "foo42"sv },
+        Tuple { "https?:\\/\\/"sv, "http:/ https://"sv, "https://"sv },
+        Tuple { "(ab)(cd)e"sv, "abcdabcde"sv, "abcde"sv },
+        Tuple { "ab\\bc|x"sv, "x abc"sv, "x"sv },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.get<0>(), ECMAScriptFlags::Global | (ECMAScriptFlags)regex::AllFlags::SingleMatch);
+        auto result = re.match(test.get<1>());
+        EXPECT(result.success);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), test.get<2>());
+    }
+
+    {
+        // The starting character of a case-insensitive pattern may differ in case.
+        Regex<ECMA262> re("b+c"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive | (ECMAScriptFlags)regex::AllFlags::SingleMatch);
+        auto result = re.match("aaBbC"sv);
+        EXPECT(result.success);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), "BbC"sv);
+    }
+    {
+        // A literal prefix that doesn't occur in the subject at all.
+        Regex<ECMA262> re("needle[0-9]"sv, ECMAScriptFlags::Global);
+        EXPECT_EQ(re.match("haystack needl needle"sv).success, false);
+    }
+    {
+        // A sticky pattern must still fail if the very first position can't start a match.
+        Regex<ECMA262> re("b+"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Sticky);
+        EXPECT_EQ(re.match("abb"sv).success, false);
+    }
+    {
+        Regex<ECMA262> re("bc+"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Sticky);
+        EXPECT_EQ(re.match("abc"sv).success, false);
+    }
+}
+
+TEST_CASE(lockstep_matching)
+{
+    // These take exponential time to backtrack through, so the matcher has to switch over to running all paths in lockstep.
+    auto subject = ByteString::repeated('a', 40);
+    auto subject_with_b = ByteString::formatted("{}b", subject);
+    {
+        Regex<ECMA262> re("(a|aa)*c"sv);
+        EXPECT_EQ(re.match(subject).success, false);
+    }
+    {
+        Regex<ECMA262> re("^(a|a?)+$"sv);
+        EXPECT_EQ(re.match(subject_with_b).success, false);
+    }
+    {
+        Regex<ECMA262> re("(a|aa)*c|(a+)b"sv);
+        auto result = re.match(subject_with_b);
+        EXPECT(result.success);
+        EXPECT_EQ(result.matches.first().view, subject_with_b.view());
+        EXPECT_EQ(result.capture_group_matches.first().at(1).view, subject.view());
+    }
+    {
+        // Captures must be the same as the ones backtracking would have found.
+        Regex<ECMA262> re("(a|aa)*(b)"sv);
+        auto result = re.match("xaaab"sv);
+        EXPECT(result.success);
+        EXPECT_EQ(result.matches.first().view, "aaab"sv);
+        EXPECT_EQ(result.capture_group_matches.first().at(0).view, "a"sv);
+        EXPECT_EQ(result.capture_group_matches.first().at(1).view, "b"sv);
+    }
+}
+
 TEST_CASE(start_anchor)
 {
     // Ensure that a circumflex at the start only matches the start of the line.
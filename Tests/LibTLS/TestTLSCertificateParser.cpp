@@ -6,6 +6,7 @@
 
 #include <AK/Base64.h>
 #include <LibTLS/Certificate.h>
+#include <LibTLS/CertificateCache.h>
 #include <LibTest/TestCase.h>
 
 TEST_CASE(certificate_with_malformed_tbscertificate_should_fail_gracefully)
@@ -94,3 +95,35 @@ TEST_CASE(test_private_key_info_decode)
     };
     EXPECT_EQ(key.coefficient(), Crypto::UnsignedBigInteger(coefficient, sizeof(coefficient)));
 }
+
+TEST_CASE(test_certificate_cache)
+{
+    // $ openssl req -x509 -newkey ec -pkeyopt ec_paramgen_curve:prime256v1 -nodes -days 36500 -subj "/CN=example.com"
+    constexpr auto certificate_der = "MIIBgjCCASmgAwIBAgIUPvqTsOqHb27yvXJMVXg71tGJB9QwCgYIKoZIzj0EAwIw"
+                                     "FjEUMBIGA1UEAwwLZXhhbXBsZS5jb20wIBcNMjYxMDE0MTczNzM2WhgPMjEyNjA5"
+                                     "MjAxNzM3MzZaMBYxFDASBgNVBAMMC2V4YW1wbGUuY29tMFkwEwYHKoZIzj0CAQYI"
+                                     "KoZIzj0DAQcDQgAEU/5e/gILH5HjvMzgOl+ojdqp5NvR6BvU+49Pd1XoNlnRkKVv"
+                                     "PJuWaqwWKMvuv6P7RqC++S73sKO4USH5/ql8wKNTMFEwHQYDVR0OBBYEFHpGGBOC"
+                                     "gz6KiUT3k4u+bxB3OG88MB8GA1UdIwQYMBaAFHpGGBOCgz6KiUT3k4u+bxB3OG88"
+                                     "MA8GA1UdEwEB/wQFMAMBAf8wCgYIKoZIzj0EAwIDRwAwRAIgCr076guBWJVCZuiC"
+                                     "ex88k90uqF7KiD/CmrpGU+8yi9wCIFjqrt1nGmEEK5JgsOVFfMLedUsrvz5y1bXC"
+                                     "MBb4cd41"sv;
+    auto decoded_certificate_der = TRY_OR_FAIL(decode_base64(certificate_der));
+
+    auto& cache = TLS::CertificateCache::the();
+    cache.clear();
+
+    auto certificate = TRY_OR_FAIL(cache.parse_certificate(decoded_certificate_der));
+    auto cached_certificate = TRY_OR_FAIL(cache.parse_certificate(decoded_certificate_der));
+    EXPECT_EQ(certificate.fingerprint.size(), 32u);
+    EXPECT_EQ(cached_certificate.fingerprint, certificate.fingerprint);
+    EXPECT_EQ(cached_certificate.subject.common_name(), "example.com"sv);
+    EXPECT_EQ(cached_certificate.original_asn1, decoded_certificate_der);
+
+    EXPECT(!cache.has_verified_signature(certificate, certificate));
+    cache.did_verify_signature(certificate, certificate);
+    EXPECT(cache.has_verified_signature(certificate, cached_certificate));
+
+    cache.clear();
+    EXPECT(!cache.has_verified_signature(certificate, certificate));
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteString.h>
+#include <LibTLS/SessionCache.h>
+#include <LibTLS/TLSv12.h>
+#include <LibTest/TestCase.h>
+#include <unistd.h>
+
+static TLS::SessionCache::Session make_session(u8 id, AK::Duration lifetime = AK::Duration::from_seconds(60))
+{
+    return {
+        .session_id = MUST(ByteBuffer::copy(Array<u8, 1> { id })),
+        .session_ticket = {},
+        .master_key = MUST(ByteBuffer::create_zeroed(48)),
+        .cipher = TLS::CipherSuite::TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256,
+        .extended_master_secret = true,
+        .expiry = UnixDateTime::now() + lifetime,
+    };
+}
+
+TEST_CASE(session_cache_remembers_sessions_per_host)
+{
+    auto& cache = TLS::SessionCache::the();
+    cache.clear();
+
+    EXPECT(!cache.session_for_host("example.com"sv).has_value());
+
+    cache.did_negotiate_session("example.com", make_session(1));
+    cache.did_negotiate_session("example.org", make_session(2));
+
+    auto session = cache.session_for_host("example.com"sv);
+    EXPECT(session.has_value());
+    EXPECT_EQ(session->session_id[0], 1);
+    EXPECT_EQ(session->cipher, TLS::CipherSuite::TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256);
+    EXPECT_EQ(cache.session_for_host("example.org"sv)->session_id[0], 2);
+
+    // A newer session replaces the one we had with that host.
+    cache.did_negotiate_session("example.com", make_session(3));
+    EXPECT_EQ(cache.session_for_host("example.com"sv)->session_id[0], 3);
+
+    cache.forget_session_for_host("example.com"sv);
+    EXPECT(!cache.session_for_host("example.com"sv).has_value());
+    EXPECT(cache.session_for_host("example.org"sv).has_value());
+
+    cache.clear();
+    EXPECT(!cache.session_for_host("example.org"sv).has_value());
+}
+
+TEST_CASE(session_cache_caps_session_lifetime)
+{
+    auto& cache = TLS::SessionCache::the();
+    cache.clear();
+
+    cache.did_negotiate_session("example.com", make_session(1, AK::Duration::from_seconds(24 * 60 * 60)));
+
+    auto session = cache.session_for_host("example.com"sv);
+    EXPECT(session.has_value());
+    EXPECT(session->expiry <= UnixDateTime::now() + TLS::SessionCache::maximum_session_lifetime);
+}
+
+TEST_CASE(session_cache_forgets_expired_sessions)
+{
+    auto& cache = TLS::SessionCache::the();
+    cache.clear();
+
+    cache.did_negotiate_session("example.com", make_session(1, AK::Duration::from_seconds(-1)));
+    EXPECT(!cache.session_for_host("example.com"sv).has_value());
+
+    cache.did_negotiate_session("example.com", make_session(2, AK::Duration::from_milliseconds(50)));
+    EXPECT(cache.session_for_host("example.com"sv).has_value());
+
+    usleep(100'000);
+    EXPECT(!cache.session_for_host("example.com"sv).has_value());
+}
+
+TEST_CASE(session_cache_evicts_a_session_when_full)
+{
+    auto& cache = TLS::SessionCache::the();
+    cache.clear();
+
+    auto host_name = [](size_t i) { return ByteString::formatted("host{}.example.com", i); };
+    auto remembered_session_count = [&](size_t host_count) {
+        size_t count = 0;
+        for (size_t i = 0; i < host_count; ++i) {
+            if (cache.session_for_host(host_name(i)).has_value())
+                ++count;
+        }
+        return count;
+    };
+
+    for (size_t i = 0; i < TLS::SessionCache::maximum_session_count; ++i)
+        cache.did_negotiate_session(host_name(i), make_session(static_cast<u8>(i)));
+    EXPECT_EQ(remembered_session_count(TLS::SessionCache::maximum_session_count), TLS::SessionCache::maximum_session_count);
+
+    // Replacing the session of a host we already know about must not evict anyone else.
+    cache.did_negotiate_session(host_name(0), make_session(42));
+    EXPECT_EQ(remembered_session_count(TLS::SessionCache::maximum_session_count), TLS::SessionCache::maximum_session_count);
+    EXPECT_EQ(cache.session_for_host(host_name(0))->session_id[0], 42);
+
+    auto new_host = host_name(TLS::SessionCache::maximum_session_count);
+    cache.did_negotiate_session(new_host, make_session(1));
+    EXPECT(cache.session_for_host(new_host).has_value());
+    EXPECT_EQ(remembered_session_count(TLS::SessionCache::maximum_session_count + 1), TLS::SessionCache::maximum_session_count);
+
+    cache.clear();
+}
+
+TEST_CASE(session_cache_evicts_expired_sessions_first)
+{
+    auto& cache = TLS::SessionCache::the();
+    cache.clear();
+
+    auto host_name = [](size_t i) { return ByteString::formatted("host{}.example.com", i); };
+
+    cache.did_negotiate_session(host_name(0), make_session(0, AK::Duration::from_milliseconds(50)));
+    for (size_t i = 1; i < TLS::SessionCache::maximum_session_count; ++i)
+        cache.did_negotiate_session(host_name(i), make_session(static_cast<u8>(i)));
+
+    usleep(100'000);
+
+    auto new_host = host_name(TLS::SessionCache::maximum_session_count);
+    cache.did_negotiate_session(new_host, make_session(1));
+    EXPECT(cache.session_for_host(new_host).has_value());
+    for (size_t i = 1; i < TLS::SessionCache::maximum_session_count; ++i)
+        EXPECT(cache.session_for_host(host_name(i)).has_value());
+
+    cache.clear();
+}
+
+TEST_CASE(parse_new_session_ticket)
+{
+    TLS::TLSv12::NewSessionTicket new_session_ticket;
+
+    {
+        // Length, lifetime hint of 300 seconds, and a ticket of 3 bytes.
+        Array<u8, 12> message { 0x00, 0x00, 0x09, 0x00, 0x00, 0x01, 0x2c, 0x00, 0x03, 0xaa, 0xbb, 0xcc };
+        EXPECT_EQ(TLS::TLSv12::parse_new_session_ticket(message, new_session_ticket), 12);
+        EXPECT_EQ(new_session_ticket.lifetime_hint, 300u);
+        EXPECT_EQ(new_session_ticket.ticket, (Array<u8, 3> { 0xaa, 0xbb, 0xcc }.span()));
+
+        EXPECT_EQ(TLS::TLSv12::parse_new_session_ticket(message.span().trim(2), new_session_ticket), (i8)TLS::Error::NeedMoreData);
+        EXPECT_EQ(TLS::TLSv12::parse_new_session_ticket(message.span().trim(11), new_session_ticket), (i8)TLS::Error::NeedMoreData);
+    }
+
+    {
+        // An empty ticket.
+        Array<u8, 9> message { 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+        EXPECT_EQ(TLS::TLSv12::parse_new_session_ticket(message, new_session_ticket), 9);
+        EXPECT(new_session_ticket.ticket.is_empty());
+    }
+
+    {
+        // Too short to hold the lifetime hint and the ticket length.
+        Array<u8, 8> message { 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00 };
+        EXPECT_EQ(TLS::TLSv12::parse_new_session_ticket(message, new_session_ticket), (i8)TLS::Error::BrokenPacket);
+    }
+
+    {
+        // The ticket is longer than the message.
+        Array<u8, 11> message { 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xaa, 0xbb };
+        EXPECT_EQ(TLS::TLSv12::parse_new_session_ticket(message, new_session_ticket), (i8)TLS::Error::BrokenPacket);
+    }
+
+    {
+        // The message has trailing bytes after the ticket.
+        Array<u8, 11> message { 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xaa, 0xbb };
+        EXPECT_EQ(TLS::TLSv12::parse_new_session_ticket(message, new_session_ticket), (i8)TLS::Error::BrokenPacket);
+    }
+}
@@ -70,3 +70,28 @@ TEST_CASE(test_utf16le_decode)
     auto utf8 = MUST(decoder.to_utf8(test_string));
     EXPECT_EQ(utf8, "säk😀"sv);
 }
+
+TEST_CASE(test_latin1_decode)
+{
+    auto decoder = TextCodec::Latin1Decoder();
+    auto test_string = "A longer run of ASCII text, then s\xe4k and \xff"sv;
+
+    auto utf8 = MUST(decoder.to_utf8(test_string));
+    EXPECT_EQ(utf8, "A longer run of ASCII text, then säk and ÿ"sv);
+
+    EXPECT_EQ(MUST(decoder.to_utf8("only ASCII"sv)), "only ASCII"sv);
+    EXPECT_EQ(MUST(decoder.to_utf8(""sv)), ""sv);
+}
+
+TEST_CASE(test_windows1252_decode)
+{
+    auto decoder = TextCodec::decoder_for_exact_name("windows-1252"sv);
+    EXPECT(decoder.has_value());
+
+    // 0x80 is the euro sign, and 0x93 and 0x94 are curly double quotes.
+    auto test_string = "\x93Price: \x80"
+                       "5\x94, that's all."sv;
+
+    EXPECT(decoder->validate(test_string));
+    EXPECT_EQ(MUST(decoder->to_utf8(test_string)), "“Price: €5”, that's all."sv);
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ThreadPool.h>
+#include <unistd.h>
+
+TEST_CASE(all_submitted_tasks_run)
+{
+    Threading::ThreadPool pool(4);
+    EXPECT_EQ(pool.thread_count(), 4u);
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<int> counter = 0;
+    for (int i = 0; i < 1000; ++i)
+        (void)pool.submit([&counter] { counter.fetch_add(1); });
+
+    pool.wait_for_all();
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST_CASE(tasks_can_submit_more_tasks)
+{
+    Threading::ThreadPool pool(2);
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<int> counter = 0;
+    for (int i = 0; i < 10; ++i) {
+        (void)pool.submit([&pool, &counter] {
+            for (int j = 0; j < 10; ++j)
+                (void)pool.submit([&counter] { counter.fetch_add(1); });
+        });
+    }
+
+    pool.wait_for_all();
+    EXPECT_EQ(counter.load(), 100);
+}
+
+TEST_CASE(idle_workers_steal_from_busy_ones)
+{
+    Threading::ThreadPool pool(2);
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> release_blocker = false;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<int> counter = 0;
+
+    // Everything below is queued on the worker that is busy with this task, so the other one has to steal it.
+    (void)pool.submit([&] {
+        for (int i = 0; i < 10; ++i)
+            (void)pool.submit([&counter] { counter.fetch_add(1); });
+        while (counter.load() < 10 && !release_blocker.load())
+            usleep(1000);
+    });
+
+    for (int i = 0; i < 1000 && counter.load() < 10; ++i)
+        usleep(1000);
+    release_blocker.store(true);
+
+    pool.wait_for_all();
+    EXPECT_EQ(counter.load(), 10);
+}
+
+TEST_CASE(higher_priority_tasks_run_first)
+{
+    Threading::ThreadPool pool(1);
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> release_blocker = false;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Vector<Threading::ThreadPool::Priority> order;
+
+    (void)pool.submit([&release_blocker] {
+        while (!release_blocker.load())
+            usleep(1000);
+    });
+
+    using enum Threading::ThreadPool::Priority;
+    for (auto priority : { Low, Normal, High })
+        (void)pool.submit([&order, priority] { order.append(priority); }, priority);
+
+    release_blocker.store(true);
+    pool.wait_for_all();
+
+    EXPECT_EQ(order.size(), 3u);
+    EXPECT(order[0] == High);
+    EXPECT(order[1] == Normal);
+    EXPECT(order[2] == Low);
+}
+
+TEST_CASE(canceled_tasks_do_not_run)
+{
+    Threading::ThreadPool pool(1);
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> release_blocker = false;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> did_run = false;
+
+    (void)pool.submit([&release_blocker] {
+        while (!release_blocker.load())
+            usleep(1000);
+    });
+
+    auto task = pool.submit([&did_run] { did_run.store(true); });
+    task->cancel();
+    EXPECT(task->is_canceled());
+
+    release_blocker.store(true);
+    pool.wait_for_all();
+    EXPECT(!did_run.load());
+}
+
+TEST_CASE(shutting_down_drops_pending_tasks)
+{
+    Threading::ThreadPool pool(1);
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> release_blocker = false;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<int> counter = 0;
+
+    (void)pool.submit([&release_blocker] {
+        while (!release_blocker.load())
+            usleep(1000);
+    });
+    for (int i = 0; i < 10; ++i)
+        (void)pool.submit([&counter] { counter.fetch_add(1); });
+
+    release_blocker.store(true);
+    pool.shut_down();
+
+    // Nothing may be left waiting for the dropped tasks.
+    pool.wait_for_all();
+    EXPECT(counter.load() <= 10);
+}
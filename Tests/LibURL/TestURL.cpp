@@ -531,3 +531,33 @@ TEST_CASE(invalid_domain_code_points)
         EXPECT(!url.is_valid());
     }
 }
+
+TEST_CASE(normalized_special_url)
+{
+    {
+        auto url = URL::Parser::basic_parse("https://example.com:8443/a//b/?x=1&y=2#frag"sv);
+        EXPECT(url.is_valid());
+        EXPECT_EQ(url.scheme(), "https");
+        EXPECT_EQ(MUST(url.serialized_host()), "example.com");
+        EXPECT_EQ(url.port(), 8443);
+        EXPECT_EQ(url.paths().size(), 4u);
+        EXPECT_EQ(url.serialize_path(), "/a//b/");
+        EXPECT_EQ(url.query(), "x=1&y=2");
+        EXPECT_EQ(url.fragment(), "frag");
+    }
+    {
+        auto url = URL::Parser::basic_parse("wss://example.com:443?"sv);
+        EXPECT_EQ(url.serialize(), "wss://example.com/?");
+        EXPECT_EQ(url.paths().size(), 1u);
+        EXPECT(!url.port().has_value());
+    }
+    EXPECT_EQ(URL::Parser::basic_parse("http://example.com/"sv).serialize(), "http://example.com/");
+    EXPECT_EQ(URL::Parser::basic_parse("http://example.com:080/"sv).serialize(), "http://example.com/");
+
+    // Inputs that are not already normalized still go through the full parser.
+    EXPECT_EQ(URL::Parser::basic_parse("http://EXAMPLE.com/a/./b/../c"sv).serialize(), "http://example.com/a/c");
+    EXPECT_EQ(URL::Parser::basic_parse("http://example.com/a b?c d#e f"sv).serialize(), "http://example.com/a%20b?c%20d#e%20f");
+    EXPECT_EQ(URL::Parser::basic_parse("http://example.com/a\\b"sv).serialize(), "http://example.com/a/b");
+    EXPECT_EQ(URL::Parser::basic_parse("http://0x7f.1/"sv).serialize(), "http://127.0.0.1/");
+    EXPECT(!URL::Parser::basic_parse("http://example.com:65536/"sv).is_valid());
+}
@@ -199,6 +199,41 @@ TEST_CASE(character_reference_in_attribute)
     END_ENUMERATION();
 }
 
+TEST_CASE(long_quoted_attributes)
+{
+    auto tokens = run_tokenizer("<p foo=\"a long value with \u00fcn\u00efcode and more\">"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 43u);
+    EXPECT_TAG_TOKEN_ATTRIBUTE_COUNT(1);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(foo, "a long value with \u00fcn\u00efcode and more", 3u, 6u, 7u, 43u);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+TEST_CASE(special_characters_in_long_quoted_attributes)
+{
+    auto tokens = run_tokenizer("<p foo='a long value with a line break\r\nand a &#38; in it' bar=\"one\0two\">"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_EQ(current_token->type(), Token::Type::StartTag);
+    NEXT_TOKEN();
+    EXPECT_TAG_TOKEN_ATTRIBUTE_COUNT(2);
+    EXPECT_EQ(last_token->raw_attribute("foo"_fly_string)->value, "a long value with a line break\nand a & in it"sv);
+    EXPECT_EQ(last_token->raw_attribute("bar"_fly_string)->value, "one\ufffdtwo"sv);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+TEST_CASE(long_comment)
+{
+    auto tokens = run_tokenizer("<!-- A comment that is long enough to be scanned in chunks - with dashes,\r\nline breaks <and> \u00fcn\u00efcode -->"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_EQ(current_token->type(), Token::Type::Comment);
+    EXPECT_EQ(current_token->comment(), " A comment that is long enough to be scanned in chunks - with dashes,\nline breaks <and> \u00fcn\u00efcode "sv);
+    EXPECT_COMMENT_TOKEN();
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
 TEST_CASE(comment)
 {
     auto tokens = run_tokenizer("<p><!-- This is a comment --></p>"sv);
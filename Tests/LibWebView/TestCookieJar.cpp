@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Cookie/ParsedCookie.h>
+#include <LibWebView/CookieJar.h>
+
+static void set_cookie(WebView::CookieJar& cookie_jar, StringView url_string, StringView cookie_string)
+{
+    URL::URL url { url_string };
+    auto parsed_cookie = Web::Cookie::parse_cookie(url, cookie_string);
+    VERIFY(parsed_cookie.has_value());
+    cookie_jar.set_cookie(url, *parsed_cookie, Web::Cookie::Source::Http);
+}
+
+static String get_cookie(WebView::CookieJar& cookie_jar, StringView url_string)
+{
+    return cookie_jar.get_cookie(URL::URL { url_string }, Web::Cookie::Source::Http);
+}
+
+TEST_CASE(host_only_cookies)
+{
+    auto cookie_jar = WebView::CookieJar::create();
+    set_cookie(*cookie_jar, "https://www.example.com/"sv, "a=1"sv);
+
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://www.example.com/"sv), "a=1"sv);
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://example.com/"sv), ""sv);
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://sub.www.example.com/"sv), ""sv);
+}
+
+TEST_CASE(domain_cookies)
+{
+    auto cookie_jar = WebView::CookieJar::create();
+    set_cookie(*cookie_jar, "https://www.example.com/"sv, "a=1; Domain=example.com"sv);
+
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://example.com/"sv), "a=1"sv);
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://www.example.com/"sv), "a=1"sv);
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://a.b.example.com/"sv), "a=1"sv);
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://notexample.com/"sv), ""sv);
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://example.org/"sv), ""sv);
+}
+
+TEST_CASE(cookies_from_several_domains_are_sorted_by_path)
+{
+    auto cookie_jar = WebView::CookieJar::create();
+    set_cookie(*cookie_jar, "https://www.example.com/"sv, "a=1; Domain=example.com; Path=/"sv);
+    set_cookie(*cookie_jar, "https://www.example.com/"sv, "b=2; Path=/foo"sv);
+    set_cookie(*cookie_jar, "https://www.example.com/"sv, "c=3; Path=/bar"sv);
+
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://www.example.com/foo/baz"sv), "b=2; a=1"sv);
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://www.example.com/bar"sv), "c=3; a=1"sv);
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://example.com/foo"sv), "a=1"sv);
+}
+
+TEST_CASE(replaced_and_expired_cookies)
+{
+    auto cookie_jar = WebView::CookieJar::create();
+    set_cookie(*cookie_jar, "https://example.com/"sv, "a=1"sv);
+    set_cookie(*cookie_jar, "https://example.com/"sv, "a=2"sv);
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://example.com/"sv), "a=2"sv);
+    EXPECT_EQ(cookie_jar->get_all_cookies().size(), 1u);
+
+    set_cookie(*cookie_jar, "https://example.com/"sv, "a=3; Max-Age=0"sv);
+    EXPECT_EQ(get_cookie(*cookie_jar, "https://example.com/"sv), ""sv);
+    EXPECT_EQ(cookie_jar->get_all_cookies().size(), 0u);
+}
@@ -41,3 +41,50 @@ TEST_CASE(predefined_character_reference)
     auto const& content = node.children[0]->content.get<XML::Node::Text>();
     EXPECT_EQ(content.builder.string_view(), "Well hello &, <, >, ', and \"!");
 }
+
+TEST_CASE(long_char_data)
+{
+    // Long enough runs of character data that their ends fall inside, and at the edges of, machine words.
+    for (size_t length = 0; length < 40; ++length) {
+        auto text = ByteString::repeated('x', length);
+        for (auto terminator : { "<"sv, "&amp;<"sv, "]<"sv, "]]<"sv }) {
+            auto source = ByteString::formatted("<a>{}{}/a>", text, terminator);
+            XML::Parser parser(source);
+            auto document = MUST(parser.parse());
+            auto const& node = document.root().content.get<XML::Node::Element>();
+            auto expected_text = ByteString::formatted("{}{}", text, terminator.substring_view(0, terminator.length() - 1).replace("&amp;"sv, "&"sv, ReplaceMode::All));
+            if (expected_text.is_empty())
+                continue;
+            EXPECT_EQ(node.children[0]->content.get<XML::Node::Text>().builder.string_view(), expected_text);
+        }
+
+        auto source = ByteString::formatted("<a>{}]]></a>", text);
+        XML::Parser parser(source);
+        EXPECT(parser.parse().is_error());
+    }
+}
+
+TEST_CASE(listener_events)
+{
+    struct RecordingListener : public XML::Listener {
+        virtual void element_start(XML::Name const& name, HashMap<XML::Name, ByteString> const& attributes) override
+        {
+            events.append(ByteString::formatted("<{} {}>", name, attributes.get("id"sv).value_or("-")));
+        }
+        virtual void element_end(XML::Name const& name) override { events.append(ByteString::formatted("</{}>", name)); }
+        virtual void text(StringView text) override
+        {
+            if (!text.is_empty())
+                events.append(text);
+        }
+
+        Vector<ByteString> events;
+    };
+
+    XML::Parser parser("<a id='1'>hello<b/><c id='2'>world &amp; more</c></a>"sv);
+    RecordingListener listener;
+    MUST(parser.parse_with_listener(listener));
+
+    Vector<ByteString> expected { "<a 1>", "hello", "<b ->", "</b>", "<c 2>", "world ", "&", " more", "</c>", "</a>" };
+    EXPECT_EQ(listener.events, expected);
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/BitStream.h>
+#include <AK/MemoryStream.h>
+#include <LibArchive/MappedZip.h>
+#include <LibCompress/Deflate.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Archive {
+
+ErrorOr<NonnullOwnPtr<MappedZip>> MappedZip::open(StringView path)
+{
+    return open(TRY(Core::MappedFile::map(path)));
+}
+
+ErrorOr<NonnullOwnPtr<MappedZip>> MappedZip::open(NonnullOwnPtr<Core::MappedFile> file)
+{
+    auto zip = Zip::try_create(file->bytes());
+    if (!zip.has_value())
+        return Error::from_string_literal("File is not a supported zip archive");
+
+    Vector<ZipMember> members;
+    HashMap<String, size_t> member_indices;
+    TRY(zip->for_each_member([&](ZipMember const& member) -> ErrorOr<IterationDecision> {
+        // NOTE: Names should be unique, but if they are not, the first member wins, as with ZIP readers that don't index.
+        if (!member_indices.contains(member.name))
+            TRY(member_indices.try_set(member.name, members.size()));
+        TRY(members.try_append(member));
+        return IterationDecision::Continue;
+    }));
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) MappedZip(move(file), move(members), move(member_indices)));
+}
+
+MappedZip::MappedZip(NonnullOwnPtr<Core::MappedFile> file, Vector<ZipMember> members, HashMap<String, size_t> member_indices)
+    : m_file(move(file))
+    , m_members(move(members))
+    , m_member_indices(move(member_indices))
+{
+}
+
+ZipMember const* MappedZip::find_member(StringView name) const
+{
+    auto index = m_member_indices.get(name);
+    if (!index.has_value())
+        return nullptr;
+    return &m_members[*index];
+}
+
+ErrorOr<NonnullOwnPtr<Stream>> MappedZip::open_member(ZipMember const& member) const
+{
+    return TRY(ZipMemberStream::create(member));
+}
+
+ErrorOr<ByteBuffer> MappedZip::read_member(ZipMember const& member) const
+{
+    auto buffer = TRY(ByteBuffer::create_uninitialized(member.uncompressed_size));
+    auto stream = TRY(ZipMemberStream::create(member));
+    TRY(stream->read_until_filled(buffer));
+
+    // This makes the stream check the size and checksum of what we read.
+    u8 trailing_byte = 0;
+    if (!TRY(stream->read_some({ &trailing_byte, 1 })).is_empty())
+        return Error::from_string_literal("Zip member is larger than the central directory says");
+
+    return buffer;
+}
+
+// This thread takes on whichever members no worker has started yet, so a busy pool never makes us wait for longer than
+// reading all of them here would.
+ErrorOr<Vector<ByteBuffer>> MappedZip::read_members(ReadonlySpan<ZipMember const*> members) const
+{
+    Vector<ByteBuffer> buffers;
+    TRY(buffers.try_ensure_capacity(members.size()));
+
+    if (members.size() <= 1 || Threading::ThreadPool::the().thread_count() <= 1) {
+        for (auto const* member : members)
+            buffers.unchecked_append(TRY(read_member(*member)));
+        return buffers;
+    }
+
+    struct State : public AtomicRefCounted<State> {
+        Threading::Mutex mutex;
+        Threading::ConditionVariable all_finished { mutex };
+        Vector<bool> claimed;
+        Vector<ByteBuffer> buffers;
+        Optional<Error> error;
+        size_t error_index { 0 };
+        size_t finished_count { 0 };
+    };
+    auto state = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) State));
+    TRY(state->claimed.try_resize(members.size()));
+    TRY(state->buffers.try_resize(members.size()));
+
+    // NOTE: Workers that get to a member after it was claimed must not touch anything but the state, as we may have
+    //       returned by then.
+    auto read_one = [this, members](State& state, size_t index) {
+        {
+            Threading::MutexLocker locker(state.mutex);
+            if (state.claimed[index])
+                return;
+            state.claimed[index] = true;
+        }
+        auto buffer_or_error = read_member(*members[index]);
+
+        Threading::MutexLocker locker(state.mutex);
+        if (!buffer_or_error.is_error()) {
+            state.buffers[index] = buffer_or_error.release_value();
+        } else if (!state.error.has_value() || index < state.error_index) {
+            state.error = buffer_or_error.release_error();
+            state.error_index = index;
+        }
+        ++state.finished_count;
+        state.all_finished.broadcast();
+    };
+
+    for (size_t i = 1; i < members.size(); ++i)
+        (void)Threading::ThreadPool::the().submit([state, read_one, i] { read_one(*state, i); });
+    for (size_t i = 0; i < members.size(); ++i)
+        read_one(*state, i);
+
+    Threading::MutexLocker locker(state->mutex);
+    state->all_finished.wait_while([&] { return state->finished_count < members.size(); });
+    if (state->error.has_value())
+        return state->error.release_value();
+
+    for (auto& buffer : state->buffers)
+        buffers.unchecked_append(move(buffer));
+    return buffers;
+}
+
+ErrorOr<NonnullOwnPtr<ZipMemberStream>> ZipMemberStream::create(ZipMember const& member)
+{
+    auto compressed_stream = TRY(try_make<FixedMemoryStream>(member.compressed_data));
+
+    NonnullOwnPtr<Stream> stream = move(compressed_stream);
+    switch (member.compression_method) {
+    case ZipCompressionMethod::Store:
+        break;
+    case ZipCompressionMethod::Deflate: {
+        auto bit_stream = TRY(try_make<LittleEndianInputBitStream>(MaybeOwned<Stream> { move(stream) }));
+        stream = TRY(Compress::DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream> { move(bit_stream) }));
+        break;
+    }
+    default:
+        return Error::from_string_literal("Zip member uses an unsupported compression method");
+    }
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) ZipMemberStream(move(stream), member.uncompressed_size, member.crc32));
+}
+
+ZipMemberStream::ZipMemberStream(NonnullOwnPtr<Stream> stream, u32 expected_size, u32 expected_crc32)
+    : m_stream(move(stream))
+    , m_expected_size(expected_size)
+    , m_expected_crc32(expected_crc32)
+{
+}
+
+ErrorOr<Bytes> ZipMemberStream::read_some(Bytes bytes)
+{
+    auto result = TRY(m_stream->read_some(bytes));
+    m_checksum.update(result);
+    m_read_size += result.size();
+
+    if (m_read_size > m_expected_size)
+        return Error::from_string_literal("Zip member is larger than the central directory says");
+
+    if (m_stream->is_eof()) {
+        if (m_read_size != m_expected_size)
+            return Error::from_string_literal("Zip member is smaller than the central directory says");
+        if (m_checksum.digest() != m_expected_crc32)
+            return Error::from_string_literal("Zip member does not match its checksum");
+    }
+
+    return result;
+}
+
+ErrorOr<size_t> ZipMemberStream::write_some(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool ZipMemberStream::is_eof() const
+{
+    return m_stream->is_eof();
+}
+
+}
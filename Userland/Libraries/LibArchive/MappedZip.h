@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
+#include <AK/Stream.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibArchive/Zip.h>
+#include <LibCore/MappedFile.h>
+#include <LibCrypto/Checksum/CRC32.h>
+
+namespace Archive {
+
+// Reads the members of a zip file that stays mapped into memory, so that assets can be served straight out of a large
+// bundle without extracting it first. The central directory is indexed once up front, which makes looking up a member
+// by its name cheap, and the compressed data of every member is only touched when it is read.
+class MappedZip {
+    AK_MAKE_NONCOPYABLE(MappedZip);
+    AK_MAKE_NONMOVABLE(MappedZip);
+
+public:
+    static ErrorOr<NonnullOwnPtr<MappedZip>> open(StringView path);
+    static ErrorOr<NonnullOwnPtr<MappedZip>> open(NonnullOwnPtr<Core::MappedFile>);
+
+    // In the order of the central directory.
+    ReadonlySpan<ZipMember> members() const { return m_members; }
+    ZipMember const* find_member(StringView name) const;
+
+    // Decompresses the member as it is read from the returned stream, which fails once it reaches the end if the
+    // contents don't match the checksum. The stream must not outlive this MappedZip.
+    ErrorOr<NonnullOwnPtr<Stream>> open_member(ZipMember const&) const;
+
+    ErrorOr<ByteBuffer> read_member(ZipMember const&) const;
+
+    // Decompresses the given members on the shared thread pool, as members don't depend on each other. The contents are
+    // returned in the same order as the members were given, and if any of them fails, the first failure is returned.
+    ErrorOr<Vector<ByteBuffer>> read_members(ReadonlySpan<ZipMember const*>) const;
+
+private:
+    MappedZip(NonnullOwnPtr<Core::MappedFile>, Vector<ZipMember>, HashMap<String, size_t>);
+
+    NonnullOwnPtr<Core::MappedFile> m_file;
+    Vector<ZipMember> m_members;
+    HashMap<String, size_t> m_member_indices;
+};
+
+class ZipMemberStream : public Stream {
+public:
+    static ErrorOr<NonnullOwnPtr<ZipMemberStream>> create(ZipMember const&);
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+private:
+    ZipMemberStream(NonnullOwnPtr<Stream>, u32 expected_size, u32 expected_crc32);
+
+    NonnullOwnPtr<Stream> m_stream;
+    Crypto::Checksum::CRC32 m_checksum;
+    u32 m_expected_size { 0 };
+    u32 m_expected_crc32 { 0 };
+    u64 m_read_size { 0 };
+};
+
+}
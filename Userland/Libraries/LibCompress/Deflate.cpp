@@ -7,12 +7,14 @@
 
 #include <AK/Array.h>
 #include <AK/Assertions.h>
-#include <AK/BinarySearch.h>
+#include <AK/Atomic.h>
 #include <AK/MemoryStream.h>
 #include <string.h>
 
 #include <LibCompress/Deflate.h>
 #include <LibCompress/Huffman.h>
+#include <LibCore/System.h>
+#include <LibThreading/Thread.h>
 
 namespace Compress {
 
@@ -78,13 +80,13 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         return code;
     }
 
-    struct PrefixCode {
+    struct SymbolCode {
         u16 symbol_code { 0 };
         u16 symbol_value { 0 };
-        u16 code_length { 0 };
+        u8 code_length { 0 };
     };
-    Array<PrefixCode, 1 << CanonicalCode::max_allowed_prefixed_code_length> prefix_codes;
-    size_t number_of_prefix_codes = 0;
+    Vector<SymbolCode, 288> symbol_codes;
+    size_t max_code_length = 0;
 
     auto next_code = 0;
     for (size_t code_length = 1; code_length <= 15; ++code_length) {
@@ -98,20 +100,8 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             if (next_code > start_bit)
                 return Error::from_string_literal("Failed to decode code lengths");
 
-            if (code_length <= CanonicalCode::max_allowed_prefixed_code_length) {
-                if (number_of_prefix_codes >= prefix_codes.size())
-                    return Error::from_string_literal("Invalid canonical Huffman code");
-
-                auto& prefix_code = prefix_codes[number_of_prefix_codes++];
-                prefix_code.symbol_code = next_code;
-                prefix_code.symbol_value = symbol;
-                prefix_code.code_length = code_length;
-
-                code.m_max_prefixed_code_length = code_length;
-            } else {
-                code.m_symbol_codes.append(start_bit | next_code);
-                code.m_symbol_values.append(symbol);
-            }
+            TRY(symbol_codes.try_append({ static_cast<u16>(next_code), static_cast<u16>(symbol), static_cast<u8>(code_length) }));
+            max_code_length = code_length;
 
             if (code.m_bit_codes.size() < symbol + 1) {
                 TRY(code.m_bit_codes.try_resize(symbol + 1));
@@ -127,16 +117,48 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     if (next_code != (1 << 15))
         return Error::from_string_literal("Failed to decode code lengths");
 
-    for (auto [symbol_code, symbol_value, code_length] : prefix_codes) {
-        if (code_length == 0 || code_length > CanonicalCode::max_allowed_prefixed_code_length)
-            break;
+    auto const prefix_length = min(max_code_length, CanonicalCode::max_allowed_prefixed_code_length);
+    code.m_max_prefixed_code_length = prefix_length;
 
-        auto shift = code.m_max_prefixed_code_length - code_length;
+    // Short codes fill all the entries of the prefix table that they are a prefix of, while longer codes only tell us
+    // how large the table for the rest of their prefix has to be.
+    for (auto [symbol_code, symbol_value, code_length] : symbol_codes) {
+        if (code_length > prefix_length) {
+            auto& entry = code.m_prefix_table[fast_reverse16(symbol_code >> (code_length - prefix_length), prefix_length)];
+            entry.secondary_table_bits = max<u8>(entry.secondary_table_bits, code_length - prefix_length);
+            continue;
+        }
+
+        auto shift = prefix_length - code_length;
         symbol_code <<= shift;
 
         for (size_t j = 0; j < (1u << shift); ++j) {
-            auto index = fast_reverse16(symbol_code + j, code.m_max_prefixed_code_length);
-            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, code_length };
+            auto index = fast_reverse16(symbol_code + j, prefix_length);
+            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, code_length, 0 };
+        }
+    }
+
+    if (max_code_length <= prefix_length)
+        return code;
+
+    for (auto& entry : code.m_prefix_table) {
+        if (entry.secondary_table_bits == 0)
+            continue;
+        entry.symbol_value = code.m_secondary_table.size();
+        TRY(code.m_secondary_table.try_resize(code.m_secondary_table.size() + (1u << entry.secondary_table_bits)));
+    }
+
+    for (auto [symbol_code, symbol_value, code_length] : symbol_codes) {
+        if (code_length <= prefix_length)
+            continue;
+
+        auto suffix_length = code_length - prefix_length;
+        auto const& prefix_entry = code.m_prefix_table[fast_reverse16(symbol_code >> suffix_length, prefix_length)];
+        auto suffix = fast_reverse16(symbol_code & ((1u << suffix_length) - 1), suffix_length);
+
+        for (size_t j = 0; j < (1u << (prefix_entry.secondary_table_bits - suffix_length)); ++j) {
+            auto index = prefix_entry.symbol_value + (suffix | (j << suffix_length));
+            code.m_secondary_table[index] = PrefixTableEntry { symbol_value, code_length, 0 };
         }
     }
 
@@ -145,23 +167,44 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
 
 ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
 {
-    auto prefix = TRY(stream.peek_bits<size_t>(m_max_prefixed_code_length));
+    if (auto prefix_or_error = stream.peek_bits<size_t>(m_max_prefixed_code_length); !prefix_or_error.is_error()) [[likely]] {
+        auto const& prefix_entry = m_prefix_table[prefix_or_error.value()];
+
+        if (prefix_entry.secondary_table_bits == 0) {
+            if (prefix_entry.code_length == 0)
+                return Error::from_string_literal("Symbol exceeds maximum symbol number");
+            stream.discard_previously_peeked_bits(prefix_entry.code_length);
+            return prefix_entry.symbol_value;
+        }
 
-    if (auto [symbol_value, code_length] = m_prefix_table[prefix]; code_length != 0) {
-        stream.discard_previously_peeked_bits(code_length);
-        return symbol_value;
+        if (auto bits_or_error = stream.peek_bits<size_t>(m_max_prefixed_code_length + prefix_entry.secondary_table_bits); !bits_or_error.is_error()) [[likely]] {
+            auto const& entry = m_secondary_table[prefix_entry.symbol_value + (bits_or_error.value() >> m_max_prefixed_code_length)];
+            stream.discard_previously_peeked_bits(entry.code_length);
+            return entry.symbol_value;
+        }
     }
 
-    auto code_bits = TRY(stream.read_bits<u16>(m_max_prefixed_code_length));
-    code_bits = fast_reverse16(code_bits, m_max_prefixed_code_length);
-    code_bits |= 1 << m_max_prefixed_code_length;
+    return read_symbol_from_remaining_bits(stream);
+}
+
+// NOTE: Close to the end of the stream, there may be fewer bits left than we want to look up, even though the code that
+//       is actually there is short enough. So we try one more bit at a time, until we find a code that fits.
+ErrorOr<u32> CanonicalCode::read_symbol_from_remaining_bits(LittleEndianInputBitStream& stream) const
+{
+    for (size_t length = 1; length <= 15; ++length) {
+        auto bits = TRY(stream.peek_bits<size_t>(length));
 
-    for (size_t i = m_max_prefixed_code_length; i < 16; ++i) {
-        size_t index;
-        if (binary_search(m_symbol_codes.span(), code_bits, &index))
-            return m_symbol_values[index];
+        auto entry = m_prefix_table[bits & ((1u << m_max_prefixed_code_length) - 1)];
+        if (entry.secondary_table_bits != 0) {
+            if (length <= m_max_prefixed_code_length)
+                continue;
+            entry = m_secondary_table[entry.symbol_value + (bits >> m_max_prefixed_code_length)];
+        }
 
-        code_bits = code_bits << 1 | TRY(stream.read_bit());
+        if (entry.code_length != 0 && entry.code_length <= length) {
+            stream.discard_previously_peeked_bits(entry.code_length);
+            return entry.symbol_value;
+        }
     }
 
     return Error::from_string_literal("Symbol exceeds maximum symbol number");
@@ -169,8 +212,8 @@ ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) cons
 
 DeflateDecompressor::CompressedBlock::CompressedBlock(DeflateDecompressor& decompressor, CanonicalCode literal_codes, Optional<CanonicalCode> distance_codes)
     : m_decompressor(decompressor)
-    , m_literal_codes(literal_codes)
-    , m_distance_codes(distance_codes)
+    , m_literal_codes(move(literal_codes))
+    , m_distance_codes(move(distance_codes))
 {
 }
 
@@ -179,37 +222,56 @@ ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
     if (m_eof == true)
         return false;
 
-    auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
+    auto& input_stream = *m_decompressor.m_input_stream;
+    auto& output_buffer = m_decompressor.m_output_buffer;
+
+    // NOTE: Rather than going through the output buffer for every single literal, we collect runs of them here and write
+    //       them all at once, before the next back-reference or once we are done.
+    Array<u8, 256> literals;
+    size_t literal_count = 0;
+    auto flush_literals = [&] {
+        auto written = output_buffer.write(literals.span().trim(literal_count));
+        VERIFY(written == literal_count);
+        literal_count = 0;
+    };
 
-    if (symbol >= 286)
-        return Error::from_string_literal("Invalid deflate literal/length symbol");
+    // NOTE: We decode symbols for as long as the next one is guaranteed to fit, which is at most one back-reference.
+    while (output_buffer.empty_space() >= literal_count + max_back_reference_length) {
+        auto const symbol = TRY(m_literal_codes.read_symbol(input_stream));
 
-    if (symbol < EndOfBlock) {
-        u8 byte_symbol = symbol;
-        m_decompressor.m_output_buffer.write({ &byte_symbol, sizeof(byte_symbol) });
-        return true;
-    }
+        if (symbol >= 286)
+            return Error::from_string_literal("Invalid deflate literal/length symbol");
 
-    if (symbol == EndOfBlock) {
-        m_eof = true;
-        return false;
-    }
+        if (symbol < EndOfBlock) {
+            literals[literal_count++] = symbol;
+            if (literal_count == literals.size())
+                flush_literals();
+            continue;
+        }
 
-    if (!m_distance_codes.has_value())
-        return Error::from_string_literal("Distance codes have not been initialized");
+        flush_literals();
 
-    auto const length = TRY(m_decompressor.decode_length(symbol));
-    auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(*m_decompressor.m_input_stream));
-    if (distance_symbol >= 30)
-        return Error::from_string_literal("Invalid deflate distance symbol");
+        // NOTE: We still return true here, so that whatever we've decoded so far gets read. The next call returns false.
+        if (symbol == EndOfBlock) {
+            m_eof = true;
+            break;
+        }
 
-    auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
+        if (!m_distance_codes.has_value())
+            return Error::from_string_literal("Distance codes have not been initialized");
 
-    auto copied_length = TRY(m_decompressor.m_output_buffer.copy_from_seekback(distance, length));
+        auto const length = TRY(m_decompressor.decode_length(symbol));
+        auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(input_stream));
+        if (distance_symbol >= 30)
+            return Error::from_string_literal("Invalid deflate distance symbol");
 
-    // TODO: What should we do if the output buffer is full?
-    VERIFY(copied_length == length);
+        auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
+
+        auto copied_length = TRY(output_buffer.copy_from_seekback(distance, length));
+        VERIFY(copied_length == length);
+    }
 
+    flush_literals();
     return true;
 }
 
@@ -298,7 +360,7 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
                 TRY(decode_codes(literal_codes, distance_codes));
 
                 m_state = State::ReadingCompressedBlock;
-                new (&m_compressed_block) CompressedBlock(*this, literal_codes, distance_codes);
+                new (&m_compressed_block) CompressedBlock(*this, move(literal_codes), move(distance_codes));
 
                 continue;
             }
@@ -959,6 +1021,22 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
+ErrorOr<void> DeflateCompressor::finish_without_final_block()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size != 0)
+        TRY(flush());
+
+    TRY(m_output_stream->write_bits(0b000u, 3)); // not the final block, no compression
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xffff));
+    TRY(m_output_stream->flush_buffer_to_stream());
+
+    m_finished = true;
+    return {};
+}
+
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
@@ -973,4 +1051,78 @@ ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, Compres
     return buffer;
 }
 
+ErrorOr<ByteBuffer> DeflateCompressor::compress_all_in_parallel(ReadonlyBytes bytes, CompressionLevel compression_level, size_t thread_count)
+{
+    auto chunk_count = ceil_div(bytes.size(), parallel_chunk_size);
+    if (thread_count == 0)
+        thread_count = Core::System::hardware_concurrency();
+    thread_count = min(thread_count, chunk_count);
+    if (thread_count <= 1)
+        return compress_all(bytes, compression_level);
+
+    Vector<ErrorOr<ByteBuffer>> compressed_chunks;
+    TRY(compressed_chunks.try_ensure_capacity(chunk_count));
+    for (size_t i = 0; i < chunk_count; ++i)
+        compressed_chunks.unchecked_append(ByteBuffer {});
+
+    auto compress_chunk = [&](size_t index) -> ErrorOr<ByteBuffer> {
+        auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+        auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(*output_stream), compression_level));
+
+        TRY(deflate_stream->write_until_depleted(bytes.slice(index * parallel_chunk_size).trim(parallel_chunk_size)));
+        if (index == chunk_count - 1)
+            TRY(deflate_stream->final_flush());
+        else
+            TRY(deflate_stream->finish_without_final_block());
+
+        auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream->used_buffer_size()));
+        TRY(output_stream->read_until_filled(buffer));
+        return buffer;
+    };
+
+    Atomic<size_t> next_chunk { 0 };
+    auto compress_remaining_chunks = [&] {
+        while (true) {
+            auto index = next_chunk.fetch_add(1);
+            if (index >= chunk_count)
+                break;
+            compressed_chunks[index] = compress_chunk(index);
+        }
+    };
+
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto thread = Threading::Thread::try_create([&] {
+            compress_remaining_chunks();
+            return static_cast<intptr_t>(0);
+        },
+            "Deflate Compressor"sv);
+        if (thread.is_error())
+            break;
+        thread.value()->start();
+        threads.append(thread.release_value());
+    }
+
+    compress_remaining_chunks();
+
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    size_t total_size = 0;
+    for (auto& chunk : compressed_chunks) {
+        if (chunk.is_error())
+            return chunk.release_error();
+        total_size += chunk.value().size();
+    }
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(total_size));
+    size_t offset = 0;
+    for (auto& chunk : compressed_chunks) {
+        chunk.value().bytes().copy_to(buffer.bytes().slice(offset));
+        offset += chunk.value().size();
+    }
+
+    return buffer;
+}
+
 }
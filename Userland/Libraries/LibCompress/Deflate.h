@@ -31,19 +31,23 @@ public:
     static ErrorOr<CanonicalCode> from_bytes(ReadonlyBytes);
 
 private:
-    static constexpr size_t max_allowed_prefixed_code_length = 8;
+    ErrorOr<u32> read_symbol_from_remaining_bits(LittleEndianInputBitStream&) const;
+
+    // Codes of up to this length are decoded with a single table lookup. Longer ones take a second lookup, in a table of
+    // all the codes that start with the same max_allowed_prefixed_code_length bits.
+    static constexpr size_t max_allowed_prefixed_code_length = 9;
 
     struct PrefixTableEntry {
+        // NOTE: For the prefixes of longer codes, this is where the table of their remaining bits starts in m_secondary_table.
         u16 symbol_value { 0 };
-        u16 code_length { 0 };
+        u8 code_length { 0 };
+        u8 secondary_table_bits { 0 };
     };
 
-    // Decompression - indexed by code
-    Vector<u16, 286> m_symbol_codes;
-    Vector<u16, 286> m_symbol_values;
-
+    // Decompression - indexed by the (lsb-first) bits of a code
     Array<PrefixTableEntry, 1 << max_allowed_prefixed_code_length> m_prefix_table {};
     size_t m_max_prefixed_code_length { 0 };
+    Vector<PrefixTableEntry> m_secondary_table;
 
     // Compression - indexed by symbol
     // Deflate uses a maximum of 288 symbols (maximum of 32 for distances),
@@ -174,8 +178,18 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
+    // Ends the output at a byte boundary, with an empty stored block, but without marking it as the end of the deflate
+    // stream. This is how the output of several compressors can be concatenated into a single stream.
+    ErrorOr<void> finish_without_final_block();
+
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
+    // Compresses chunks of this size on up to thread_count threads (one per core if it is 0), and concatenates the results.
+    // NOTE: As we never look for matches outside of the block that is being compressed, compressing the chunks on their
+    //       own costs nothing but the few bytes it takes to end each of them at a byte boundary.
+    static constexpr size_t parallel_chunk_size = 128 * KiB;
+    static ErrorOr<ByteBuffer> compress_all_in_parallel(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD, size_t thread_count = 0);
+
 private:
     DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>, CompressionLevel = CompressionLevel::GOOD);
 
@@ -14,6 +14,7 @@
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
+#include <LibThreading/Thread.h>
 
 namespace Compress {
 
@@ -189,8 +190,9 @@ ErrorOr<size_t> GzipDecompressor::write_some(ReadonlyBytes)
     return Error::from_errno(EBADF);
 }
 
-GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream)
+GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream, size_t thread_count)
     : m_output_stream(move(stream))
+    , m_thread_count(thread_count)
 {
 }
 
@@ -210,11 +212,33 @@ ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
     header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
     header.operating_system = 3; // unix
     TRY(m_output_stream->write_until_depleted({ &header, sizeof(header) }));
-    auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
-    TRY(compressed_stream->write_until_depleted(bytes));
-    TRY(compressed_stream->final_flush());
+
     Crypto::Checksum::CRC32 crc32;
-    crc32.update(bytes);
+    if (m_thread_count == 1) {
+        auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
+        TRY(compressed_stream->write_until_depleted(bytes));
+        TRY(compressed_stream->final_flush());
+        crc32.update(bytes);
+    } else {
+        // NOTE: The checksum is computed on a thread of its own, so that it doesn't hold up writing the compressed data.
+        auto checksum_thread = Threading::Thread::try_create([&] {
+            crc32.update(bytes);
+            return static_cast<intptr_t>(0);
+        },
+            "Gzip Checksum"sv);
+        if (!checksum_thread.is_error())
+            checksum_thread.value()->start();
+
+        auto compressed = DeflateCompressor::compress_all_in_parallel(bytes, DeflateCompressor::CompressionLevel::GOOD, m_thread_count);
+
+        if (checksum_thread.is_error())
+            crc32.update(bytes);
+        else
+            (void)checksum_thread.value()->join();
+
+        TRY(m_output_stream->write_until_depleted(TRY(compressed)));
+    }
+
     TRY(m_output_stream->write_value<LittleEndian<u32>>(crc32.digest()));
     TRY(m_output_stream->write_value<LittleEndian<u32>>(bytes.size()));
     return bytes.size();
@@ -234,10 +258,10 @@ void GzipCompressor::close()
 {
 }
 
-ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
+ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes, size_t thread_count)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
-    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream) };
+    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream), thread_count };
 
     TRY(gzip_stream.write_until_depleted(bytes));
 
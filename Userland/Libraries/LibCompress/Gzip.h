@@ -83,7 +83,8 @@ private:
 
 class GzipCompressor final : public Stream {
 public:
-    GzipCompressor(MaybeOwned<Stream>);
+    // NOTE: With a thread_count other than 1, the data of each write is compressed with DeflateCompressor::compress_all_in_parallel().
+    GzipCompressor(MaybeOwned<Stream>, size_t thread_count = 1);
 
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
@@ -91,10 +92,11 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
-    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes);
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, size_t thread_count = 1);
 
 private:
     MaybeOwned<Stream> m_output_stream;
+    size_t m_thread_count { 1 };
 };
 
 }
@@ -190,6 +190,35 @@ bool LzmaDecompressor::has_reached_expected_data_size() const
     return m_total_processed_bytes >= m_options.uncompressed_size.value();
 }
 
+ErrorOr<void> LzmaDecompressor::refill_input_buffer()
+{
+    VERIFY(m_input_buffer_offset == m_input_buffer_size);
+    m_input_buffer_offset = 0;
+    m_input_buffer_size = 0;
+
+    // Without knowing where the compressed data ends, we can't read more of it than the range decoder asks for.
+    if (!m_options.input_ends_with_compressed_data) {
+        m_input_buffer[0] = TRY(m_stream->read_value<u8>());
+        m_input_buffer_size = 1;
+        return {};
+    }
+
+    auto read_bytes = TRY(m_stream->read_some(m_input_buffer));
+    if (read_bytes.is_empty())
+        return Error::from_string_literal("Reached the end of the LZMA input while decoding");
+
+    m_input_buffer_size = read_bytes.size();
+    return {};
+}
+
+ALWAYS_INLINE ErrorOr<u8> LzmaDecompressor::read_input_byte()
+{
+    if (m_input_buffer_offset == m_input_buffer_size) [[unlikely]]
+        TRY(refill_input_buffer());
+
+    return m_input_buffer[m_input_buffer_offset++];
+}
+
 ErrorOr<void> LzmaDecompressor::initialize_range_decoder()
 {
     // "The LZMA Encoder always writes ZERO in initial byte of compressed stream.
@@ -197,7 +226,7 @@ ErrorOr<void> LzmaDecompressor::initialize_range_decoder()
     //  LZMA Encoder. If initial byte is not equal to ZERO, the LZMA Decoder must
     //  stop decoding and report error."
     {
-        auto byte = TRY(m_stream->read_value<u8>());
+        auto byte = TRY(read_input_byte());
         if (byte != 0)
             return Error::from_string_literal("Initial byte of data stream is not zero");
     }
@@ -205,7 +234,7 @@ ErrorOr<void> LzmaDecompressor::initialize_range_decoder()
     // Read the initial bytes into the range decoder.
     m_range_decoder_code = 0;
     for (size_t i = 0; i < 4; i++) {
-        auto byte = TRY(m_stream->read_value<u8>());
+        auto byte = TRY(read_input_byte());
         m_range_decoder_code = m_range_decoder_code << 8 | byte;
     }
 
@@ -216,6 +245,9 @@ ErrorOr<void> LzmaDecompressor::initialize_range_decoder()
 
 ErrorOr<void> LzmaDecompressor::append_input_stream(MaybeOwned<Stream> stream, Optional<u64> uncompressed_size)
 {
+    if (m_input_buffer_offset != m_input_buffer_size)
+        return Error::from_string_literal("LZMA input contains more data than was decoded");
+
     m_stream = move(stream);
 
     TRY(initialize_range_decoder());
@@ -229,17 +261,17 @@ ErrorOr<void> LzmaDecompressor::append_input_stream(MaybeOwned<Stream> stream, O
     return {};
 }
 
-ErrorOr<void> LzmaDecompressor::normalize_range_decoder()
+ALWAYS_INLINE ErrorOr<void> LzmaDecompressor::normalize_range_decoder()
 {
     // "The Normalize() function keeps the "Range" value in described range."
 
-    if (m_range_decoder_range >= minimum_range_value)
+    if (m_range_decoder_range >= minimum_range_value) [[likely]]
         return {};
 
     m_range_decoder_range <<= 8;
     m_range_decoder_code <<= 8;
 
-    m_range_decoder_code |= TRY(m_stream->read_value<u8>());
+    m_range_decoder_code |= TRY(read_input_byte());
 
     VERIFY(m_range_decoder_range >= minimum_range_value);
 
@@ -330,7 +362,7 @@ ErrorOr<void> LzmaCompressor::encode_direct_bit(u8 value)
     return {};
 }
 
-ErrorOr<u8> LzmaDecompressor::decode_bit_with_probability(Probability& probability)
+ALWAYS_INLINE ErrorOr<u8> LzmaDecompressor::decode_bit_with_probability(Probability& probability)
 {
     // "The LZMA decoder provides the pointer to CProb variable that contains
     //  information about estimated probability for symbol 0 and the Range Decoder
@@ -340,18 +372,14 @@ ErrorOr<u8> LzmaDecompressor::decode_bit_with_probability(Probability& probabili
 
     dbgln_if(LZMA_DEBUG, "Decoding bit {} with probability = {:#x}, bound = {:#x}, code = {:#x}, range = {:#x}", m_range_decoder_code < bound ? 0 : 1, probability, bound, m_range_decoder_code, m_range_decoder_range);
 
-    if (m_range_decoder_code < bound) {
-        probability += ((1 << probability_bit_count) - probability) >> probability_shift_width;
-        m_range_decoder_range = bound;
-        TRY(normalize_range_decoder());
-        return 0;
-    } else {
-        probability -= probability >> probability_shift_width;
-        m_range_decoder_code -= bound;
-        m_range_decoder_range -= bound;
-        TRY(normalize_range_decoder());
-        return 1;
-    }
+    // NOTE: The decoded bits are about as unpredictable as the compressor could make them, so we select the new state
+    //       instead of branching on the bit, which lets the compiler use conditional moves.
+    u8 bit = m_range_decoder_code >= bound;
+    probability = bit ? probability - (probability >> probability_shift_width) : probability + (((1 << probability_bit_count) - probability) >> probability_shift_width);
+    m_range_decoder_code -= bit ? bound : 0;
+    m_range_decoder_range = bit ? m_range_decoder_range - bound : bound;
+    TRY(normalize_range_decoder());
+    return bit;
 }
 
 ErrorOr<void> LzmaCompressor::encode_bit_with_probability(Probability& probability, u8 value)
@@ -1182,6 +1210,9 @@ ErrorOr<Bytes> LzmaDecompressor::read_some(Bytes bytes)
 
         if (!is_range_decoder_in_clean_state())
             return Error::from_string_literal("LZMA stream ends in an unclean state");
+
+        if (m_input_buffer_offset != m_input_buffer_size)
+            return Error::from_string_literal("LZMA input contains more data than was decoded");
     }
 
     return m_dictionary->read(bytes);
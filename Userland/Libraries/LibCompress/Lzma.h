@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/CircularBuffer.h>
 #include <AK/FixedArray.h>
 #include <AK/MaybeOwned.h>
@@ -30,6 +31,10 @@ struct LzmaDecompressorOptions {
     u32 dictionary_size { 0 };
     Optional<u64> uncompressed_size;
     bool reject_end_of_stream_marker { false };
+
+    // Whether the input stream ends where the compressed data does, like the chunks of an LZMA2 stream. This lets the
+    // range decoder read its input in bulk, as it can't accidentally consume whatever follows the compressed data.
+    bool input_ends_with_compressed_data { false };
 };
 
 struct LzmaCompressorOptions {
@@ -190,6 +195,14 @@ private:
     u32 m_range_decoder_range { 0xFFFFFFFF };
     u32 m_range_decoder_code { 0 };
 
+    // Compressed data that has been read from the stream, but not yet consumed by the range decoder.
+    Array<u8, 4 * KiB> m_input_buffer;
+    size_t m_input_buffer_offset { 0 };
+    size_t m_input_buffer_size { 0 };
+
+    ErrorOr<u8> read_input_byte();
+    ErrorOr<void> refill_input_buffer();
+
     ErrorOr<void> initialize_range_decoder();
     ErrorOr<void> normalize_range_decoder();
     ErrorOr<u8> decode_direct_bit();
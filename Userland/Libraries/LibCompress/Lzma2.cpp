@@ -110,6 +110,9 @@ ErrorOr<Bytes> Lzma2Decompressor::read_some(Bytes bytes)
 
                     // Note: This is not specified anywhere. However, it is apparently tested by bad-1-lzma2-7.xz from the XZ utils test files.
                     .reject_end_of_stream_marker = true,
+
+                    // Every LZMA chunk is read from a stream that is constrained to its compressed size.
+                    .input_ends_with_compressed_data = true,
                 };
                 [[fallthrough]];
             }
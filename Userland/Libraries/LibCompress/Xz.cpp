@@ -4,11 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/ByteBuffer.h>
+#include <AK/Checked.h>
 #include <AK/MemoryStream.h>
 #include <LibCompress/Lzma2.h>
 #include <LibCompress/Xz.h>
+#include <LibCore/System.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/Thread.h>
 
 namespace Compress {
 
@@ -780,6 +784,7 @@ ErrorOr<Bytes> XzDecompressor::read_some(Bytes bytes)
             // Another XZ Stream might follow, so we just unset the current information and continue on the next read.
             m_stream_flags.clear();
             m_processed_blocks.clear();
+            m_current_block_stream.clear();
             return bytes.trim(0);
         }
 
@@ -812,4 +817,209 @@ void XzDecompressor::close()
 {
 }
 
+ErrorOr<Vector<XzDecompressor::BlockLocation>> XzDecompressor::locate_blocks(ReadonlyBytes bytes)
+{
+    // Every Stream ends with its Index and Stream Footer, so we find the blocks by walking the streams from the back.
+    Vector<BlockLocation> blocks;
+    size_t end_of_stream = bytes.size();
+
+    // 2.2. Stream Padding: "[...] the size of Stream Padding MUST be a multiple of four bytes."
+    // As the streams are a multiple of four bytes as well, so is the whole file.
+    if (end_of_stream % 4 != 0)
+        return Error::from_string_literal("XZ file size is not a multiple of four");
+
+    do {
+        while (end_of_stream >= 4 && bytes.slice(end_of_stream - 4, 4) == ReadonlyBytes { "\0\0\0\0", 4 })
+            end_of_stream -= 4;
+
+        if (end_of_stream < sizeof(XzStreamHeader) + sizeof(XzStreamFooter))
+            return Error::from_string_literal("XZ file is too short to contain a stream");
+
+        XzStreamFooter stream_footer {};
+        bytes.slice(end_of_stream - sizeof(stream_footer), sizeof(stream_footer)).copy_to({ &stream_footer, sizeof(stream_footer) });
+        TRY(stream_footer.validate());
+
+        auto const end_of_index = end_of_stream - sizeof(stream_footer);
+        auto const size_of_index = stream_footer.backward_size();
+        if (size_of_index > end_of_index - sizeof(XzStreamHeader))
+            return Error::from_string_literal("XZ index size is larger than the stream");
+        auto const start_of_index = end_of_index - size_of_index;
+
+        // 4. Index
+        FixedMemoryStream index_stream { bytes.slice(start_of_index, size_of_index) };
+        if (TRY(index_stream.read_value<u8>()) != 0x00)
+            return Error::from_string_literal("XZ index does not start with an Index Indicator");
+
+        u64 const number_of_records = TRY(index_stream.read_value<XzMultibyteInteger>());
+
+        Vector<BlockLocation> stream_blocks;
+        Checked<u64> size_of_blocks = 0;
+        for (u64 i = 0; i < number_of_records; i++) {
+            u64 const unpadded_size = TRY(index_stream.read_value<XzMultibyteInteger>());
+            if (unpadded_size < 5)
+                return Error::from_string_literal("XZ index contains a record with an unpadded size of less than five");
+
+            u64 const uncompressed_size = TRY(index_stream.read_value<XzMultibyteInteger>());
+
+            TRY(stream_blocks.try_append({
+                .data = {},
+                .stream_flags = stream_footer.flags,
+                .unpadded_size = unpadded_size,
+                .uncompressed_offset = 0,
+                .uncompressed_size = uncompressed_size,
+            }));
+
+            // 3.3. Block Padding pads the Block to a multiple of four bytes.
+            size_of_blocks += unpadded_size;
+            size_of_blocks += 3;
+            if (size_of_blocks.has_overflow())
+                return Error::from_string_literal("XZ index describes more data than there is");
+            size_of_blocks = size_of_blocks.value() & ~3ull;
+        }
+
+        // 4.4. Index Padding
+        while (MUST(index_stream.tell()) % 4 != 0) {
+            if (TRY(index_stream.read_value<u8>()) != 0)
+                return Error::from_string_literal("XZ index contains a non-null padding byte");
+        }
+
+        // 4.5. CRC32
+        // TODO: Validation of the index CRC32 is currently unimplemented.
+        TRY(index_stream.discard(sizeof(u32)));
+        if (!index_stream.is_eof())
+            return Error::from_string_literal("XZ index size does not match the stored size in the stream footer");
+
+        if (size_of_blocks.value() > start_of_index - sizeof(XzStreamHeader))
+            return Error::from_string_literal("XZ index describes more data than there is");
+        auto const start_of_stream = start_of_index - size_of_blocks.value() - sizeof(XzStreamHeader);
+
+        XzStreamHeader stream_header {};
+        bytes.slice(start_of_stream, sizeof(stream_header)).copy_to({ &stream_header, sizeof(stream_header) });
+        TRY(stream_header.validate());
+
+        if (ReadonlyBytes { &stream_header.flags, sizeof(XzStreamFlags) } != ReadonlyBytes { &stream_footer.flags, sizeof(XzStreamFlags) })
+            return Error::from_string_literal("XZ stream header flags don't match the stream footer");
+
+        // The blocks follow each other right after the stream header.
+        auto start_of_block = start_of_stream + sizeof(XzStreamHeader);
+        for (auto& block : stream_blocks) {
+            auto const block_size = align_up_to(block.unpadded_size, 4);
+            block.data = bytes.slice(start_of_block, block_size);
+            start_of_block += block_size;
+        }
+
+        TRY(blocks.try_prepend(move(stream_blocks)));
+        end_of_stream = start_of_stream;
+    } while (end_of_stream > 0);
+
+    Checked<u64> uncompressed_offset = 0;
+    for (auto& block : blocks) {
+        block.uncompressed_offset = uncompressed_offset.value();
+        uncompressed_offset += block.uncompressed_size;
+        if (uncompressed_offset.has_overflow() || uncompressed_offset.value() > NumericLimits<size_t>::max())
+            return Error::from_string_literal("XZ index describes more uncompressed data than we can hold");
+    }
+
+    return blocks;
+}
+
+ErrorOr<void> XzDecompressor::decompress_block(BlockLocation const& block, Bytes output)
+{
+    VERIFY(output.size() == block.uncompressed_size);
+
+    // This sets up a decompressor as if it was past the stream header, and then decodes the block as usual.
+    auto block_stream = TRY(try_make<FixedMemoryStream>(block.data));
+    auto counting_stream = TRY(try_make<CountingStream>(MaybeOwned<Stream> { move(block_stream) }));
+    XzDecompressor decompressor { move(counting_stream) };
+    decompressor.m_stream_flags = block.stream_flags;
+    decompressor.m_found_first_stream_header = true;
+
+    TRY(decompressor.load_next_block(TRY(decompressor.m_stream->read_value<u8>())));
+
+    auto& decompressed_stream = *decompressor.m_current_block_stream;
+    TRY(decompressed_stream->read_until_filled(output));
+    decompressor.m_current_block_uncompressed_size = output.size();
+
+    // 4.3. List of Records:
+    // "If the decoder has decoded all the Blocks of the Stream, it
+    //  MUST verify that the contents of the Records match the real
+    //  Unpadded Size and Uncompressed Size of the respective Blocks."
+    u8 trailing_byte = 0;
+    if (!TRY(decompressed_stream->read_some({ &trailing_byte, 1 })).is_empty() || !decompressed_stream->is_eof())
+        return Error::from_string_literal("Uncompressed size of XZ Block does not match the Index");
+
+    TRY(decompressor.finish_current_block());
+
+    if (decompressor.m_processed_blocks.first().unpadded_size != block.unpadded_size || !decompressor.m_stream->is_eof())
+        return Error::from_string_literal("Unpadded size of XZ Block does not match the Index");
+
+    return {};
+}
+
+ErrorOr<ByteBuffer> XzDecompressor::decompress_all(ReadonlyBytes bytes, size_t thread_count)
+{
+    auto decompress_in_order = [&]() -> ErrorOr<ByteBuffer> {
+        auto decompressor = TRY(XzDecompressor::create(TRY(try_make<FixedMemoryStream>(bytes))));
+        return decompressor->read_until_eof();
+    };
+
+    if (thread_count == 0)
+        thread_count = Core::System::hardware_concurrency();
+    if (thread_count <= 1)
+        return decompress_in_order();
+
+    // NOTE: If we can't make sense of the indexes, the file is broken somewhere, and decompressing it from the start
+    //       tells us where.
+    auto blocks_or_error = locate_blocks(bytes);
+    if (blocks_or_error.is_error())
+        return decompress_in_order();
+    auto blocks = blocks_or_error.release_value();
+
+    thread_count = min(thread_count, blocks.size());
+    if (thread_count <= 1)
+        return decompress_in_order();
+
+    auto const uncompressed_size = blocks.last().uncompressed_offset + blocks.last().uncompressed_size;
+    auto output = TRY(ByteBuffer::create_uninitialized(uncompressed_size));
+
+    Vector<ErrorOr<void>> results;
+    TRY(results.try_ensure_capacity(blocks.size()));
+    for (size_t i = 0; i < blocks.size(); ++i)
+        results.unchecked_append({});
+
+    Atomic<size_t> next_block { 0 };
+    auto decompress_remaining_blocks = [&] {
+        while (true) {
+            auto index = next_block.fetch_add(1);
+            if (index >= blocks.size())
+                break;
+            auto const& block = blocks[index];
+            results[index] = decompress_block(block, output.bytes().slice(block.uncompressed_offset, block.uncompressed_size));
+        }
+    };
+
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto thread = Threading::Thread::try_create([&] {
+            decompress_remaining_blocks();
+            return static_cast<intptr_t>(0);
+        },
+            "XZ Decompressor"sv);
+        if (thread.is_error())
+            break;
+        thread.value()->start();
+        threads.append(thread.release_value());
+    }
+
+    decompress_remaining_blocks();
+
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    for (auto& result : results)
+        TRY(result);
+
+    return output;
+}
+
 }
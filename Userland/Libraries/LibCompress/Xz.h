@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/CircularBuffer.h>
 #include <AK/ConstrainedStream.h>
 #include <AK/CountingStream.h>
@@ -156,6 +157,11 @@ class XzDecompressor : public Stream {
 public:
     static ErrorOr<NonnullOwnPtr<XzDecompressor>> create(MaybeOwned<Stream>);
 
+    // Decompresses all streams in the given data. Unless thread_count is 1, the blocks that the indexes list are
+    // decompressed on up to thread_count threads (one per core if it is 0), as every block is independent of the others.
+    // NOTE: Only files that were compressed into several blocks, like `xz -T` does, benefit from this.
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes, size_t thread_count = 1);
+
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
     virtual bool is_eof() const override;
@@ -165,6 +171,17 @@ public:
 private:
     XzDecompressor(NonnullOwnPtr<CountingStream>);
 
+    // Where a block is, and what the index of its stream says about it.
+    struct BlockLocation {
+        ReadonlyBytes data;
+        XzStreamFlags stream_flags;
+        u64 unpadded_size {};
+        u64 uncompressed_offset {};
+        u64 uncompressed_size {};
+    };
+    static ErrorOr<Vector<BlockLocation>> locate_blocks(ReadonlyBytes);
+    static ErrorOr<void> decompress_block(BlockLocation const&, Bytes output);
+
     ErrorOr<bool> load_next_stream();
     ErrorOr<void> load_next_block(u8 encoded_block_header_size);
     ErrorOr<void> finish_current_block();
@@ -4,7 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/BinaryHeap.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/IntrusiveList.h>
 #include <AK/Singleton.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Time.h>
@@ -20,6 +21,14 @@
 #include <sys/select.h>
 #include <unistd.h>
 
+#if defined(AK_OS_LINUX) && !defined(AK_OS_ANDROID)
+#    define EVENT_LOOP_USES_EPOLL
+#    include <sys/epoll.h>
+#elif defined(AK_OS_MACOS) || defined(AK_OS_IOS) || defined(AK_OS_FREEBSD) || defined(AK_OS_NETBSD) || defined(AK_OS_OPENBSD) || defined(AK_OS_DRAGONFLY)
+#    define EVENT_LOOP_USES_KQUEUE
+#    include <sys/event.h>
+#endif
+
 namespace Core {
 
 namespace {
@@ -69,6 +78,9 @@ public:
 
     bool is_scheduled() const { return m_index != INVALID_INDEX; }
 
+    IntrusiveListNode<EventLoopTimeout> wheel_node;
+    using List = IntrusiveList<&EventLoopTimeout::wheel_node>;
+
 protected:
     union {
         AK::Duration m_duration;
@@ -79,24 +91,37 @@ private:
     ssize_t m_index = INVALID_INDEX;
 };
 
+// The timeouts of a thread, kept in a hierarchical timing wheel, so that scheduling and unscheduling a timeout takes
+// constant time no matter how many there are (http://www.cs.columbia.edu/~nahum/w6998/papers/sosp87-timing-wheels.pdf).
+//
+// Time is split into ticks of a millisecond. Each level of the wheel has 64 slots, where a slot on level N spans 64^N
+// ticks. A timeout goes into the slot of the highest level on which its tick differs from the current one, and moves
+// down a level each time the current tick reaches the start of its slot, until it fires from level 0. Timeouts that
+// are due in the same tick fire together, in the order they were scheduled in.
 class TimeoutSet {
 public:
-    TimeoutSet() = default;
+    TimeoutSet()
+        : m_origin(MonotonicTime::now_coarse())
+    {
+    }
 
     Optional<MonotonicTime> next_timer_expiration()
     {
-        if (!m_heap.is_empty()) {
-            return m_heap.peek_min()->fire_time();
-        } else {
-            return {};
-        }
+        if (!m_expired_timeouts.is_empty())
+            return time_of_tick(m_current_tick);
+
+        // NOTE: This may be the time to move timeouts further down the wheel rather than to fire them, which makes us wake
+        //       up a bit more often than strictly necessary, but at most once per level and slot.
+        if (auto tick = next_tick_with_work(); tick.has_value())
+            return time_of_tick(*tick);
+        return {};
     }
 
     void absolutize_relative_timeouts(MonotonicTime current_time)
     {
         for (auto timeout : m_scheduled_timeouts) {
             timeout->absolutize({}, current_time);
-            m_heap.insert(timeout);
+            insert(*timeout);
         }
         m_scheduled_timeouts.clear();
     }
@@ -104,18 +129,47 @@ public:
     size_t fire_expired(MonotonicTime current_time)
     {
         size_t fired_count = 0;
-        while (!m_heap.is_empty()) {
-            auto& timeout = *m_heap.peek_min();
 
-            if (timeout.fire_time() <= current_time) {
+        // NOTE: Timeouts that are rescheduled while firing go back into the wheel, and don't fire again until their
+        //       next tick.
+        auto fire_all = [&](EventLoopTimeout::List& timeouts) {
+            EventLoopTimeout::List firing_timeouts;
+            move_all(timeouts, firing_timeouts);
+            while (auto* timeout = firing_timeouts.take_first()) {
+                timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
                 ++fired_count;
-                m_heap.pop_min();
-                timeout.set_index({}, EventLoopTimeout::INVALID_INDEX);
-                timeout.fire(*this, current_time);
-            } else {
+                timeout->fire(*this, current_time);
+            }
+        };
+
+        fire_all(m_expired_timeouts);
+
+        auto target_tick = floor_tick(current_time);
+        while (m_current_tick < target_tick) {
+            auto tick = next_tick_with_work();
+            if (!tick.has_value() || *tick > target_tick) {
+                m_current_tick = target_tick;
                 break;
             }
+            m_current_tick = *tick;
+
+            if ((m_current_tick & far_tick_mask) == 0)
+                reinsert_all(m_far_timeouts);
+
+            // NOTE: Higher levels go first, because their timeouts may move into a slot of a lower level at this tick.
+            for (size_t level = level_count - 1; level > 0; --level) {
+                if ((m_current_tick & tick_mask_below_level(level)) == 0)
+                    reinsert_slot(level, slot_index(m_current_tick, level));
+            }
+
+            auto slot = slot_index(m_current_tick, 0);
+            m_occupied_slots[0] &= ~(1ull << slot);
+            fire_all(m_slots[0][slot]);
+
+            // Timeouts that came down from a higher level straight into this tick are in the expired list now.
+            fire_all(m_expired_timeouts);
         }
+
         return fired_count;
     }
 
@@ -127,7 +181,7 @@ public:
 
     void schedule_absolute(EventLoopTimeout* timeout)
     {
-        m_heap.insert(timeout);
+        insert(*timeout);
     }
 
     void unschedule(EventLoopTimeout* timeout)
@@ -140,32 +194,146 @@ public:
             swap(m_scheduled_timeouts[i]->index({}), m_scheduled_timeouts[j]->index({}));
             (void)m_scheduled_timeouts.take_last();
         } else {
-            m_heap.pop(timeout->index({}));
+            auto index = static_cast<size_t>(timeout->index({}));
+            timeout->wheel_node.remove();
+            if (index < level_count * slots_per_level) {
+                auto level = index / slots_per_level;
+                auto slot = index % slots_per_level;
+                if (m_slots[level][slot].is_empty())
+                    m_occupied_slots[level] &= ~(1ull << slot);
+            }
         }
         timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
     }
 
     void clear()
     {
-        for (auto* timeout : m_heap.nodes_in_arbitrary_order())
-            timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
-        m_heap.clear();
+        auto clear_list = [](EventLoopTimeout::List& timeouts) {
+            while (auto* timeout = timeouts.take_first())
+                timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
+        };
+        for (auto& level : m_slots) {
+            for (auto& slot : level)
+                clear_list(slot);
+        }
+        m_occupied_slots.fill(0);
+        clear_list(m_expired_timeouts);
+        clear_list(m_far_timeouts);
+
         for (auto* timeout : m_scheduled_timeouts)
             timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
         m_scheduled_timeouts.clear();
     }
 
 private:
-    IntrusiveBinaryHeap<
-        EventLoopTimeout*,
-        decltype([](EventLoopTimeout* a, EventLoopTimeout* b) {
-            return a->fire_time() < b->fire_time();
-        }),
-        decltype([](EventLoopTimeout* timeout, size_t index) {
-            timeout->set_index({}, static_cast<ssize_t>(index));
-        }),
-        8>
-        m_heap;
+    static constexpr size_t bits_per_level = 6;
+    static constexpr size_t slots_per_level = 1 << bits_per_level;
+    static constexpr size_t level_count = 6;
+
+    // Timeouts further out than 64^6 ticks (about two years) wait in m_far_timeouts, until the current tick crosses a
+    // multiple of that.
+    static constexpr u64 far_tick_mask = (1ull << (bits_per_level * level_count)) - 1;
+
+    static constexpr ssize_t expired_index = level_count * slots_per_level;
+    static constexpr ssize_t far_index = expired_index + 1;
+
+    static constexpr u64 tick_mask_below_level(size_t level) { return (1ull << (bits_per_level * level)) - 1; }
+    static constexpr size_t slot_index(u64 tick, size_t level) { return (tick >> (bits_per_level * level)) & (slots_per_level - 1); }
+
+    u64 floor_tick(MonotonicTime time) const
+    {
+        auto nanoseconds = (time - m_origin).to_nanoseconds();
+        return nanoseconds <= 0 ? 0 : static_cast<u64>(nanoseconds) / 1'000'000;
+    }
+
+    // NOTE: Timeouts are never due before their fire time, so they round up.
+    u64 ceil_tick(MonotonicTime time) const
+    {
+        auto nanoseconds = (time - m_origin).to_nanoseconds();
+        return nanoseconds <= 0 ? 0 : (static_cast<u64>(nanoseconds) + 999'999) / 1'000'000;
+    }
+
+    MonotonicTime time_of_tick(u64 tick) const
+    {
+        return m_origin + AK::Duration::from_milliseconds(static_cast<i64>(tick));
+    }
+
+    static void move_all(EventLoopTimeout::List& from, EventLoopTimeout::List& to)
+    {
+        while (auto* timeout = from.take_first())
+            to.append(*timeout);
+    }
+
+    void insert(EventLoopTimeout& timeout)
+    {
+        auto tick = ceil_tick(timeout.fire_time());
+        if (tick <= m_current_tick) {
+            timeout.set_index({}, expired_index);
+            m_expired_timeouts.append(timeout);
+            return;
+        }
+
+        auto level = (count_required_bits(tick ^ m_current_tick) - 1) / bits_per_level;
+        if (level >= level_count) {
+            timeout.set_index({}, far_index);
+            m_far_timeouts.append(timeout);
+            return;
+        }
+
+        auto slot = slot_index(tick, level);
+        timeout.set_index({}, static_cast<ssize_t>(level * slots_per_level + slot));
+        m_slots[level][slot].append(timeout);
+        m_occupied_slots[level] |= 1ull << slot;
+    }
+
+    void reinsert_all(EventLoopTimeout::List& timeouts)
+    {
+        EventLoopTimeout::List moving_timeouts;
+        move_all(timeouts, moving_timeouts);
+        while (auto* timeout = moving_timeouts.take_first())
+            insert(*timeout);
+    }
+
+    void reinsert_slot(size_t level, size_t slot)
+    {
+        if ((m_occupied_slots[level] & (1ull << slot)) == 0)
+            return;
+        m_occupied_slots[level] &= ~(1ull << slot);
+        reinsert_all(m_slots[level][slot]);
+    }
+
+    // The next tick at which a timeout fires or moves down the wheel. A timeout on some level always sits in a later
+    // slot than the current tick's, so that is the first occupied slot, on whichever level it comes up first.
+    Optional<u64> next_tick_with_work() const
+    {
+        Optional<u64> next_tick;
+        for (size_t level = 0; level < level_count; ++level) {
+            auto occupied_slots = m_occupied_slots[level];
+            if (occupied_slots == 0)
+                continue;
+            auto slot = count_trailing_zeroes(occupied_slots);
+            auto level_start = m_current_tick & ~tick_mask_below_level(level + 1);
+            auto tick = level_start | (static_cast<u64>(slot) << (bits_per_level * level));
+            if (!next_tick.has_value() || tick < *next_tick)
+                next_tick = tick;
+        }
+
+        if (!m_far_timeouts.is_empty()) {
+            auto tick = (m_current_tick | far_tick_mask) + 1;
+            if (!next_tick.has_value() || tick < *next_tick)
+                next_tick = tick;
+        }
+        return next_tick;
+    }
+
+    MonotonicTime m_origin;
+    u64 m_current_tick { 0 };
+
+    Array<Array<EventLoopTimeout::List, slots_per_level>, level_count> m_slots;
+    Array<u64, level_count> m_occupied_slots {};
+    EventLoopTimeout::List m_expired_timeouts;
+    EventLoopTimeout::List m_far_timeouts;
+
     Vector<EventLoopTimeout*, 8> m_scheduled_timeouts;
 };
 
@@ -217,6 +385,381 @@ public:
     Atomic<bool> is_being_deleted { false };
 };
 
+// The notifiers of a thread, along with the thread's wake pipe, and a way to wait for any of them to become ready.
+//
+// Where the OS lets us, the kernel keeps track of the file descriptors we are interested in, so registering a notifier
+// only tells it about the change, and waiting only costs as much as the number of file descriptors that are ready.
+// Otherwise, we fall back to handing the whole set to poll() every time.
+class PollNotifierSet {
+public:
+    explicit PollNotifierSet(int wake_fd)
+    {
+        reset(wake_fd);
+    }
+
+    void did_fork(int wake_fd)
+    {
+        reset(wake_fd);
+    }
+
+    void add(Notifier& notifier)
+    {
+        m_notifier_by_ptr.set(&notifier, m_poll_fds.size());
+        m_notifier_by_index.append(&notifier);
+        m_poll_fds.append({
+            .fd = notifier.fd(),
+            .events = notification_type_to_poll_events(notifier.type()),
+            .revents = 0,
+        });
+    }
+
+    void remove(Notifier& notifier)
+    {
+        auto it = m_notifier_by_ptr.find(&notifier);
+        VERIFY(it != m_notifier_by_ptr.end());
+
+        size_t notifier_index = it->value;
+        m_notifier_by_ptr.remove(it);
+
+        if (notifier_index + 1 != m_poll_fds.size()) {
+            swap(m_poll_fds[notifier_index], m_poll_fds.last());
+            swap(m_notifier_by_index[notifier_index], m_notifier_by_index.last());
+            m_notifier_by_ptr.set(m_notifier_by_index[notifier_index], notifier_index);
+        }
+        m_poll_fds.take_last();
+        m_notifier_by_index.take_last();
+    }
+
+    ErrorOr<void> wait(int timeout)
+    {
+        m_ready_count = TRY(System::poll(m_poll_fds, timeout));
+        return {};
+    }
+
+    bool wake_pipe_is_readable() const
+    {
+        return has_flag(m_poll_fds[0].revents, POLLIN);
+    }
+
+    template<typename Callback>
+    void for_each_ready_notifier(Callback callback)
+    {
+        if (m_ready_count == 0)
+            return;
+
+        for (size_t i = 1; i < m_poll_fds.size(); ++i) {
+            // FIXME: Make the check work under Android, pehaps use ALooper
+#ifdef AK_OS_ANDROID
+            auto& notifier = *m_notifier_by_index[i];
+            callback(notifier, notifier.type());
+#else
+            auto& revents = m_poll_fds[i].revents;
+            auto& notifier = *m_notifier_by_index[i];
+
+            NotificationType type = NotificationType::None;
+            if (has_flag(revents, POLLIN))
+                type |= NotificationType::Read;
+            if (has_flag(revents, POLLOUT))
+                type |= NotificationType::Write;
+            if (has_flag(revents, POLLHUP))
+                type |= NotificationType::HangUp;
+            if (has_flag(revents, POLLERR))
+                type |= NotificationType::Error;
+            callback(notifier, type);
+#endif
+        }
+    }
+
+private:
+    void reset(int wake_fd)
+    {
+        m_poll_fds.clear();
+        m_notifier_by_ptr.clear();
+        m_notifier_by_index.clear();
+
+        m_poll_fds.append({ .fd = wake_fd, .events = POLLIN, .revents = 0 });
+        m_notifier_by_index.append(nullptr);
+    }
+
+    Vector<pollfd> m_poll_fds;
+    HashMap<Notifier*, size_t> m_notifier_by_ptr;
+    Vector<Notifier*> m_notifier_by_index;
+    int m_ready_count { 0 };
+};
+
+#if defined(EVENT_LOOP_USES_EPOLL) || defined(EVENT_LOOP_USES_KQUEUE)
+// The kernel knows about file descriptors rather than notifiers, and there may be several notifiers for one of them.
+class KernelNotifierSet {
+public:
+    static constexpr size_t max_events_per_wait = 256;
+
+    explicit KernelNotifierSet(int wake_fd)
+        : m_wake_fd(wake_fd)
+    {
+        create_kernel_queue();
+    }
+
+    ~KernelNotifierSet()
+    {
+        if (m_queue_fd != -1)
+            close(m_queue_fd);
+    }
+
+    void did_fork(int wake_fd)
+    {
+#    ifdef EVENT_LOOP_USES_EPOLL
+        // NOTE: We share the epoll instance with the parent, and must not change the parent's interest list.
+        close(m_queue_fd);
+#    endif
+        // NOTE: A kqueue is not inherited by the child, so there is nothing to close.
+        m_queue_fd = -1;
+        m_wake_fd = wake_fd;
+        m_notifiers_by_fd.clear();
+        create_kernel_queue();
+    }
+
+    void add(Notifier& notifier)
+    {
+        auto& entry = m_notifiers_by_fd.ensure(notifier.fd());
+        entry.notifiers.append(&notifier);
+        update_kernel_interest(notifier.fd(), entry);
+    }
+
+    void remove(Notifier& notifier)
+    {
+        auto it = m_notifiers_by_fd.find(notifier.fd());
+        VERIFY(it != m_notifiers_by_fd.end());
+
+        auto& entry = it->value;
+        entry.notifiers.remove_first_matching([&](auto* other) { return other == &notifier; });
+        update_kernel_interest(notifier.fd(), entry);
+
+        if (entry.notifiers.is_empty())
+            m_notifiers_by_fd.remove(it);
+    }
+
+    ErrorOr<void> wait(int timeout)
+    {
+        m_ready_fds.clear_with_capacity();
+        m_wake_pipe_is_readable = false;
+
+        // NOTE: File descriptors that the kernel cannot watch are always ready, so don't sleep if there are any.
+        if (m_always_ready_fd_count > 0)
+            timeout = 0;
+
+#    ifdef EVENT_LOOP_USES_EPOLL
+        auto ready_count = epoll_wait(m_queue_fd, m_events.data(), m_events.size(), timeout);
+        if (ready_count < 0)
+            return Error::from_syscall("epoll_wait"sv, -errno);
+
+        for (int i = 0; i < ready_count; ++i) {
+            auto const& event = m_events[i];
+            if (event.data.fd == m_wake_fd) {
+                m_wake_pipe_is_readable = has_flag(event.events, EPOLLIN);
+                continue;
+            }
+
+            NotificationType type = NotificationType::None;
+            if (has_flag(event.events, EPOLLIN))
+                type |= NotificationType::Read;
+            if (has_flag(event.events, EPOLLOUT))
+                type |= NotificationType::Write;
+            if (has_flag(event.events, EPOLLHUP))
+                type |= NotificationType::HangUp;
+            if (has_flag(event.events, EPOLLERR))
+                type |= NotificationType::Error;
+            m_ready_fds.append({ event.data.fd, type });
+        }
+#    else
+        struct timespec timeout_spec {
+            .tv_sec = timeout / 1000,
+            .tv_nsec = (timeout % 1000) * 1'000'000,
+        };
+        auto ready_count = kevent(m_queue_fd, nullptr, 0, m_events.data(), m_events.size(), timeout < 0 ? nullptr : &timeout_spec);
+        if (ready_count < 0)
+            return Error::from_syscall("kevent"sv, -errno);
+
+        for (int i = 0; i < ready_count; ++i) {
+            auto const& event = m_events[i];
+            auto fd = static_cast<int>(event.ident);
+            if (fd == m_wake_fd) {
+                m_wake_pipe_is_readable = event.filter == EVFILT_READ;
+                continue;
+            }
+
+            NotificationType type = NotificationType::None;
+            if (event.filter == EVFILT_READ)
+                type |= NotificationType::Read;
+            if (event.filter == EVFILT_WRITE)
+                type |= NotificationType::Write;
+            if ((event.flags & EV_EOF) != 0)
+                type |= NotificationType::HangUp;
+            if ((event.flags & EV_ERROR) != 0)
+                type |= NotificationType::Error;
+
+            // NOTE: Reading and writing are separate filters, so a file descriptor may show up twice.
+            auto ready_fd = m_ready_fds.find_if([&](auto const& ready_fd) { return ready_fd.fd == fd; });
+            if (ready_fd != m_ready_fds.end())
+                ready_fd->type |= type;
+            else
+                m_ready_fds.append({ fd, type });
+        }
+#    endif
+
+        return {};
+    }
+
+    bool wake_pipe_is_readable() const
+    {
+        return m_wake_pipe_is_readable;
+    }
+
+    template<typename Callback>
+    void for_each_ready_notifier(Callback callback)
+    {
+        for (auto const& ready_fd : m_ready_fds) {
+            auto it = m_notifiers_by_fd.find(ready_fd.fd);
+            if (it == m_notifiers_by_fd.end())
+                continue;
+            for (auto* notifier : it->value.notifiers)
+                callback(*notifier, ready_fd.type);
+        }
+
+        if (m_always_ready_fd_count == 0)
+            return;
+        for (auto& it : m_notifiers_by_fd) {
+            if (!it.value.is_always_ready)
+                continue;
+            for (auto* notifier : it.value.notifiers)
+                callback(*notifier, notifier->type());
+        }
+    }
+
+private:
+    struct NotifiersForFd {
+        Vector<Notifier*, 1> notifiers;
+        NotificationType registered_type { NotificationType::None };
+        bool is_registered { false };
+        bool is_always_ready { false };
+    };
+
+    struct ReadyFd {
+        int fd { -1 };
+        NotificationType type { NotificationType::None };
+    };
+
+    void create_kernel_queue()
+    {
+#    ifdef EVENT_LOOP_USES_EPOLL
+        m_queue_fd = epoll_create1(EPOLL_CLOEXEC);
+#    else
+        m_queue_fd = kqueue();
+#    endif
+        if (m_queue_fd < 0) {
+            warnln("\033[31;1mFailed to create event loop queue:\033[0m {}", Error::from_errno(errno));
+            VERIFY_NOT_REACHED();
+        }
+
+        NotifiersForFd wake_pipe;
+        if (auto result = change_kernel_interest(m_wake_fd, wake_pipe, NotificationType::Read); result.is_error()) {
+            warnln("\033[31;1mFailed to watch event loop pipe:\033[0m {}", result.error());
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    void update_kernel_interest(int fd, NotifiersForFd& entry)
+    {
+        NotificationType type = NotificationType::None;
+        for (auto* notifier : entry.notifiers)
+            type |= notifier->type() & (NotificationType::Read | NotificationType::Write);
+
+        if (entry.is_always_ready) {
+            if (entry.notifiers.is_empty())
+                --m_always_ready_fd_count;
+            return;
+        }
+
+        if (auto result = change_kernel_interest(fd, entry, type); result.is_error()) {
+            // NOTE: epoll refuses regular files, which poll() would always report as ready. Treat them the same.
+            if (result.error().code() == EPERM) {
+                entry.is_always_ready = true;
+                ++m_always_ready_fd_count;
+                return;
+            }
+            // NOTE: The file descriptor may already have been closed, which takes it out of the kernel queue as well.
+            if (!entry.notifiers.is_empty())
+                dbgln("EventLoopImplementationUnix: Unable to watch fd {}: {}", fd, result.error());
+        }
+    }
+
+    ErrorOr<void> change_kernel_interest(int fd, NotifiersForFd& entry, NotificationType type)
+    {
+        if (entry.is_registered && type == entry.registered_type)
+            return {};
+
+#    ifdef EVENT_LOOP_USES_EPOLL
+        int operation = EPOLL_CTL_MOD;
+        if (!entry.is_registered)
+            operation = EPOLL_CTL_ADD;
+        else if (type == NotificationType::None)
+            operation = EPOLL_CTL_DEL;
+
+        struct epoll_event event {};
+        if (has_flag(type, NotificationType::Read))
+            event.events |= EPOLLIN;
+        if (has_flag(type, NotificationType::Write))
+            event.events |= EPOLLOUT;
+        event.data.fd = fd;
+
+        entry.is_registered = operation != EPOLL_CTL_DEL;
+        entry.registered_type = type;
+        if (epoll_ctl(m_queue_fd, operation, fd, &event) < 0) {
+            entry.is_registered = false;
+            return Error::from_syscall("epoll_ctl"sv, -errno);
+        }
+#    else
+        Array<struct kevent, 2> changes;
+        size_t change_count = 0;
+        auto change_filter = [&](short filter, NotificationType filter_type) {
+            auto was_registered = entry.is_registered && has_flag(entry.registered_type, filter_type);
+            auto should_be_registered = has_flag(type, filter_type);
+            if (was_registered != should_be_registered)
+                EV_SET(&changes[change_count++], fd, filter, should_be_registered ? EV_ADD : EV_DELETE, 0, 0, nullptr);
+        };
+        change_filter(EVFILT_READ, NotificationType::Read);
+        change_filter(EVFILT_WRITE, NotificationType::Write);
+
+        entry.is_registered = type != NotificationType::None;
+        entry.registered_type = type;
+        if (change_count > 0 && kevent(m_queue_fd, changes.data(), change_count, nullptr, 0, nullptr) < 0) {
+            entry.is_registered = false;
+            return Error::from_syscall("kevent"sv, -errno);
+        }
+#    endif
+
+        return {};
+    }
+
+    int m_queue_fd { -1 };
+    int m_wake_fd { -1 };
+    bool m_wake_pipe_is_readable { false };
+
+    HashMap<int, NotifiersForFd> m_notifiers_by_fd;
+    size_t m_always_ready_fd_count { 0 };
+
+#    ifdef EVENT_LOOP_USES_EPOLL
+    Array<struct epoll_event, max_events_per_wait> m_events;
+#    else
+    Array<struct kevent, max_events_per_wait> m_events;
+#    endif
+    Vector<ReadyFd, max_events_per_wait> m_ready_fds;
+};
+
+using NotifierSet = KernelNotifierSet;
+#else
+using NotifierSet = PollNotifierSet;
+#endif
+
 struct ThreadData {
     static ThreadData& the()
     {
@@ -281,17 +824,16 @@ struct ThreadData {
         wake_pipe_fds = result.release_value();
 
         // The wake pipe informs us of POSIX signals as well as manual calls to wake()
-        VERIFY(poll_fds.size() == 0);
-        poll_fds.append({ .fd = wake_pipe_fds[0], .events = POLLIN, .revents = 0 });
-        notifier_by_index.append(nullptr);
+        if (!notifiers)
+            notifiers = make<NotifierSet>(wake_pipe_fds[0]);
+        else
+            notifiers->did_fork(wake_pipe_fds[0]);
     }
 
     // Each thread has its own timers, notifiers and a wake pipe.
     TimeoutSet timeouts;
 
-    Vector<pollfd> poll_fds;
-    HashMap<Notifier*, size_t> notifier_by_ptr;
-    Vector<Notifier*> notifier_by_index;
+    OwnPtr<NotifierSet> notifiers;
 
     // The wake pipe is used to notify another event loop that someone has called wake(), or a signal has been received.
     // wake() writes 0i32 into the pipe, signals write the signal number (guaranteed non-zero).
@@ -383,19 +925,19 @@ retry:
 
 try_select_again:
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
-    ErrorOr<int> error_or_marked_fd_count = System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout);
+    auto wait_result = thread_data.notifiers->wait(should_wait_forever ? -1 : timeout);
     auto time_after_poll = MonotonicTime::now_coarse();
     // Because POSIX, we might spuriously return from select() with EINTR; just select again.
-    if (error_or_marked_fd_count.is_error()) {
-        if (error_or_marked_fd_count.error().code() == EINTR)
+    if (wait_result.is_error()) {
+        if (wait_result.error().code() == EINTR)
             goto try_select_again;
-        dbgln("EventLoopImplementationUnix::wait_for_events: {}", error_or_marked_fd_count.error());
+        dbgln("EventLoopImplementationUnix::wait_for_events: {}", wait_result.error());
         VERIFY_NOT_REACHED();
     }
 
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (has_flag(thread_data.poll_fds[0].revents, POLLIN)) {
+    if (thread_data.notifiers->wake_pipe_is_readable()) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -424,32 +966,12 @@ try_select_again:
             goto retry;
     }
 
-    if (error_or_marked_fd_count.value() != 0) {
-        // Handle file system notifiers by making them normal events.
-        for (size_t i = 1; i < thread_data.poll_fds.size(); ++i) {
-            // FIXME: Make the check work under Android, pehaps use ALooper
-#ifdef AK_OS_ANDROID
-            auto& notifier = *thread_data.notifier_by_index[i];
-            ThreadEventQueue::current().post_event(notifier, make<NotifierActivationEvent>(notifier.fd(), notifier.type()));
-#else
-            auto& revents = thread_data.poll_fds[i].revents;
-            auto& notifier = *thread_data.notifier_by_index[i];
-
-            NotificationType type = NotificationType::None;
-            if (has_flag(revents, POLLIN))
-                type |= NotificationType::Read;
-            if (has_flag(revents, POLLOUT))
-                type |= NotificationType::Write;
-            if (has_flag(revents, POLLHUP))
-                type |= NotificationType::HangUp;
-            if (has_flag(revents, POLLERR))
-                type |= NotificationType::Error;
-            type &= notifier.type();
-            if (type != NotificationType::None)
-                ThreadEventQueue::current().post_event(notifier, make<NotifierActivationEvent>(notifier.fd(), type));
-#endif
-        }
-    }
+    // Handle file system notifiers by making them normal events.
+    thread_data.notifiers->for_each_ready_notifier([](Notifier& notifier, NotificationType type) {
+        type &= notifier.type();
+        if (type != NotificationType::None)
+            ThreadEventQueue::current().post_event(notifier, make<NotifierActivationEvent>(notifier.fd(), type));
+    });
 
     // Handle expired timers.
     thread_data.timeouts.fire_expired(time_after_poll);
@@ -526,9 +1048,6 @@ void EventLoopImplementationUnix::notify_forked_and_in_child()
 {
     auto& thread_data = ThreadData::the();
     thread_data.timeouts.clear();
-    thread_data.poll_fds.clear();
-    thread_data.notifier_by_ptr.clear();
-    thread_data.notifier_by_index.clear();
     thread_data.initialize_wake_pipe();
     if (auto* info = signals_info<false>()) {
         info->signal_handlers.clear();
@@ -683,15 +1202,7 @@ void EventLoopManagerUnix::unregister_timer(intptr_t timer_id)
 void EventLoopManagerUnix::register_notifier(Notifier& notifier)
 {
     auto& thread_data = ThreadData::the();
-
-    thread_data.notifier_by_ptr.set(&notifier, thread_data.poll_fds.size());
-    thread_data.notifier_by_index.append(&notifier);
-    thread_data.poll_fds.append({
-        .fd = notifier.fd(),
-        .events = notification_type_to_poll_events(notifier.type()),
-        .revents = 0,
-    });
-
+    thread_data.notifiers->add(notifier);
     notifier.set_owner_thread(s_thread_id);
 }
 
@@ -701,20 +1212,7 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
     if (!thread_data_ptr)
         return;
 
-    auto& thread_data = *thread_data_ptr;
-    auto it = thread_data.notifier_by_ptr.find(&notifier);
-    VERIFY(it != thread_data.notifier_by_ptr.end());
-
-    size_t notifier_index = it->value;
-    thread_data.notifier_by_ptr.remove(it);
-
-    if (notifier_index + 1 != thread_data.poll_fds.size()) {
-        swap(thread_data.poll_fds[notifier_index], thread_data.poll_fds.last());
-        swap(thread_data.notifier_by_index[notifier_index], thread_data.notifier_by_index.last());
-        thread_data.notifier_by_ptr.set(thread_data.notifier_by_index[notifier_index], notifier_index);
-    }
-    thread_data.poll_fds.take_last();
-    thread_data.notifier_by_index.take_last();
+    thread_data_ptr->notifiers->remove(notifier);
 }
 
 void EventLoopManagerUnix::did_post_event()
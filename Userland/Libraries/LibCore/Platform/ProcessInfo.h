@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Optional.h>
 #include <AK/Types.h>
 
 #if defined(AK_OS_MACH)
@@ -23,6 +24,9 @@ struct ProcessInfo {
     pid_t pid { 0 };
 
     u64 memory_usage_bytes { 0 };
+    // The process's share of the memory it uses, where memory shared with N processes counts for 1/N. Not every
+    // platform can tell us this.
+    Optional<u64> proportional_memory_usage_bytes;
     float cpu_percent { 0.0f };
 
     u64 time_spent_in_process { 0 };
@@ -15,6 +15,27 @@ static auto user_hz = sysconf(_SC_CLK_TCK);
 static auto page_size = sysconf(_SC_PAGESIZE);
 static auto ncpu_online = sysconf(_SC_NPROCESSORS_ONLN);
 
+static Optional<u64> read_proportional_memory_usage(pid_t pid)
+{
+    // NOTE: This makes the kernel walk all of the process's mappings, so it's not as cheap as reading its RSS.
+    auto smaps_rollup = Core::File::open(MUST(String::formatted("/proc/{}/smaps_rollup", pid)), Core::File::OpenMode::Read);
+    if (smaps_rollup.is_error())
+        return {};
+    auto contents = smaps_rollup.value()->read_until_eof();
+    if (contents.is_error())
+        return {};
+
+    for (auto line : StringView { contents.value() }.lines()) {
+        if (!line.starts_with("Pss:"sv))
+            continue;
+        auto kib = line.substring_view(4).trim_whitespace().split_view(' ').first().to_number<u64>();
+        if (!kib.has_value())
+            return {};
+        return *kib * KiB;
+    }
+    return {};
+}
+
 ErrorOr<void> update_process_statistics(ProcessStatistics& statistics)
 {
     // Read the total time scheduled from /proc/stat, and each process's usage from /proc/pid/stat
@@ -61,6 +82,7 @@ ErrorOr<void> update_process_statistics(ProcessStatistics& statistics)
             return Error::from_string_literal("Failed to parse /proc/pid/stat");
 
         process->memory_usage_bytes = rss * page_size;
+        process->proportional_memory_usage_bytes = read_proportional_memory_usage(process->pid);
 
         u64 const time_process = utime + stime;
         float const time_scheduled_diff = time_process - process->time_spent_in_process;
@@ -334,6 +334,9 @@ public:
     ErrorOr<Bytes> receive_message(Bytes buffer, int flags, Vector<int>& fds);
     ErrorOr<ssize_t> send_message(ReadonlyBytes msg, int flags, Vector<int, 1> fds = {});
 
+    // Sends the buffers one after the other with a single sendmsg(), along with the file descriptors, if any.
+    ErrorOr<ssize_t> send_message(ReadonlySpan<ReadonlyBytes> buffers, int flags, ReadonlySpan<int> fds = {});
+
     ErrorOr<pid_t> peer_pid() const;
     ErrorOr<Bytes> read_without_waiting(Bytes buffer);
 
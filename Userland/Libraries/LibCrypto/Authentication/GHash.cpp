@@ -9,6 +9,10 @@
 #include <AK/Types.h>
 #include <LibCrypto/Authentication/GHash.h>
 
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#endif
+
 namespace {
 
 static u32 to_u32(u8 const* b)
@@ -84,10 +88,54 @@ GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
     return digest;
 }
 
+#if ARCH(X86_64)
+// This is the carry-less multiplication, followed by a shift to undo the bit reflection of GHASH and the reduction
+// modulo the field polynomial, from Intel's "Carry-Less Multiplication Instruction and its Usage for Computing the GCM
+// Mode" paper. Besides being much faster, it takes the same time for any key.
+[[gnu::target("pclmul,sse4.1")]] static void galois_multiply_with_clmul(u32 (&z)[4], u32 const (&x)[4], u32 const (&y)[4])
+{
+    // NOTE: With the first word in the highest lane, these hold the bytes of each block in reverse order.
+    auto a = _mm_set_epi32(x[0], x[1], x[2], x[3]);
+    auto b = _mm_set_epi32(y[0], y[1], y[2], y[3]);
+
+    auto low = _mm_clmulepi64_si128(a, b, 0x00);
+    auto middle = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    auto high = _mm_clmulepi64_si128(a, b, 0x11);
+    low = _mm_xor_si128(low, _mm_slli_si128(middle, 8));
+    high = _mm_xor_si128(high, _mm_srli_si128(middle, 8));
+
+    // Shift the 256-bit product left by one bit.
+    auto low_carries = _mm_srli_epi32(low, 31);
+    auto high_carries = _mm_srli_epi32(high, 31);
+    low = _mm_or_si128(_mm_slli_epi32(low, 1), _mm_slli_si128(low_carries, 4));
+    high = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(high, 1), _mm_slli_si128(high_carries, 4)), _mm_srli_si128(low_carries, 12));
+
+    // Reduce it modulo x^128 + x^7 + x^2 + x + 1.
+    auto first = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(low, 31), _mm_slli_epi32(low, 30)), _mm_slli_epi32(low, 25));
+    auto first_carries = _mm_srli_si128(first, 4);
+    low = _mm_xor_si128(low, _mm_slli_si128(first, 12));
+    auto second = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(low, 1), _mm_srli_epi32(low, 2)), _mm_srli_epi32(low, 7));
+    second = _mm_xor_si128(second, first_carries);
+    high = _mm_xor_si128(high, _mm_xor_si128(low, second));
+
+    z[0] = _mm_extract_epi32(high, 3);
+    z[1] = _mm_extract_epi32(high, 2);
+    z[2] = _mm_extract_epi32(high, 1);
+    z[3] = _mm_cvtsi128_si32(high);
+}
+#endif
+
 /// Galois Field multiplication using <x^127 + x^7 + x^2 + x + 1>.
 /// Note that x, y, and z are strictly BE.
 void galois_multiply(u32 (&_z)[4], u32 const (&_x)[4], u32 const (&_y)[4])
 {
+#if ARCH(X86_64)
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")) {
+        galois_multiply_with_clmul(_z, _x, _y);
+        return;
+    }
+#endif
+
     // Note: Copied upfront to stack to avoid memory access in the loop.
     u32 x[4] { _x[0], _x[1], _x[2], _x[3] };
     u32 const y[4] { _y[0], _y[1], _y[2], _y[3] };
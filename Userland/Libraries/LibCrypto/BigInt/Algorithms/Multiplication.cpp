@@ -9,38 +9,191 @@
 
 namespace Crypto {
 
+using Word = UnsignedBigInteger::Word;
+using DoubleWord = u64;
+static_assert(sizeof(DoubleWord) == 2 * sizeof(Word));
+
+// Below this many words in the shorter operand, splitting the operands costs more than the word products it saves.
+static constexpr size_t karatsuba_threshold = 40;
+
+// accumulator[0..accumulator_length) += value[0..value_length), returning the carry out of the accumulator.
+static Word add_words(Word* accumulator, size_t accumulator_length, Word const* value, size_t value_length)
+{
+    VERIFY(value_length <= accumulator_length);
+
+    DoubleWord carry = 0;
+    size_t i = 0;
+    for (; i < value_length; ++i) {
+        carry += static_cast<DoubleWord>(accumulator[i]) + value[i];
+        accumulator[i] = static_cast<Word>(carry);
+        carry >>= UnsignedBigInteger::BITS_IN_WORD;
+    }
+    for (; carry && i < accumulator_length; ++i) {
+        carry += accumulator[i];
+        accumulator[i] = static_cast<Word>(carry);
+        carry >>= UnsignedBigInteger::BITS_IN_WORD;
+    }
+    return static_cast<Word>(carry);
+}
+
+// accumulator[0..accumulator_length) -= value[0..value_length), which must not be larger than the accumulator.
+static void subtract_words(Word* accumulator, size_t accumulator_length, Word const* value, size_t value_length)
+{
+    VERIFY(value_length <= accumulator_length);
+
+    Word borrow = 0;
+    size_t i = 0;
+    for (; i < value_length; ++i) {
+        DoubleWord difference = static_cast<DoubleWord>(accumulator[i]) - value[i] - borrow;
+        accumulator[i] = static_cast<Word>(difference);
+        borrow = (difference >> UnsignedBigInteger::BITS_IN_WORD) ? 1 : 0;
+    }
+    for (; borrow && i < accumulator_length; ++i)
+        borrow = accumulator[i]-- == 0 ? 1 : 0;
+    VERIFY(!borrow);
+}
+
+// output[0..left_length + right_length) = left * right
+static void multiply_words_schoolbook(Word const* left, size_t left_length, Word const* right, size_t right_length, Word* output)
+{
+    __builtin_memset(output, 0, (left_length + right_length) * sizeof(Word));
+    for (size_t i = 0; i < left_length; ++i) {
+        DoubleWord left_word = left[i];
+        if (left_word == 0)
+            continue;
+        DoubleWord carry = 0;
+        for (size_t j = 0; j < right_length; ++j) {
+            // NOTE: This can't overflow, as (2^32 - 1)^2 + 2 * (2^32 - 1) is 2^64 - 1.
+            carry += left_word * right[j] + output[i + j];
+            output[i + j] = static_cast<Word>(carry);
+            carry >>= UnsignedBigInteger::BITS_IN_WORD;
+        }
+        output[i + right_length] = static_cast<Word>(carry);
+    }
+}
+
+static size_t karatsuba_scratch_length(size_t length)
+{
+    if (length < karatsuba_threshold)
+        return 0;
+    size_t high_length = length - length / 2;
+    // Both sums of halves, their product, and whatever multiplying those sums needs in turn.
+    return 4 * (high_length + 1) + karatsuba_scratch_length(high_length + 1);
+}
+
+// output[0..2 * length) = left * right, where both operands are `length` words long.
+static void multiply_words_karatsuba(Word const* left, Word const* right, size_t length, Word* output, Word* scratch)
+{
+    if (length < karatsuba_threshold) {
+        multiply_words_schoolbook(left, length, right, length, output);
+        return;
+    }
+
+    // Splitting both operands into low and high halves, x = x1 * B + x0 and y = y1 * B + y0, we have
+    // x * y = x1 * y1 * B^2 + ((x0 + x1) * (y0 + y1) - x0 * y0 - x1 * y1) * B + x0 * y0,
+    // which takes three multiplications of half the size instead of four.
+    size_t low_length = length / 2;
+    size_t high_length = length - low_length;
+    size_t sum_length = high_length + 1;
+
+    Word* low_product = output;
+    Word* high_product = output + 2 * low_length;
+    multiply_words_karatsuba(left, right, low_length, low_product, scratch);
+    multiply_words_karatsuba(left + low_length, right + low_length, high_length, high_product, scratch);
+
+    Word* left_sum = scratch;
+    Word* right_sum = left_sum + sum_length;
+    Word* middle_product = right_sum + sum_length;
+    Word* next_scratch = middle_product + 2 * sum_length;
+
+    auto add_halves = [&](Word const* number, Word* sum) {
+        __builtin_memcpy(sum, number + low_length, high_length * sizeof(Word));
+        sum[high_length] = 0;
+        add_words(sum, sum_length, number, low_length);
+    };
+    add_halves(left, left_sum);
+    add_halves(right, right_sum);
+
+    multiply_words_karatsuba(left_sum, right_sum, sum_length, middle_product, next_scratch);
+    subtract_words(middle_product, 2 * sum_length, low_product, 2 * low_length);
+    subtract_words(middle_product, 2 * sum_length, high_product, 2 * high_length);
+
+    // NOTE: The middle product is at most x1 * y0 + x0 * y1, so any of its words that don't fit in the output are zero.
+    size_t middle_length = min(2 * sum_length, 2 * length - low_length);
+    auto carry = add_words(output + low_length, 2 * length - low_length, middle_product, middle_length);
+    VERIFY(carry == 0);
+}
+
+static size_t karatsuba_in_pieces_scratch_length(size_t shorter_length)
+{
+    return 3 * shorter_length + karatsuba_scratch_length(shorter_length);
+}
+
+// output[0..longer_length + shorter_length) = longer * shorter
+static void multiply_words_karatsuba_in_pieces(Word const* longer, size_t longer_length, Word const* shorter, size_t shorter_length, Word* output, Word* scratch)
+{
+    // Each piece of the longer number is copied into the scratch space, followed by its product and whatever the
+    // Karatsuba multiplication needs. Copying lets us pad the last piece with zeros instead of special-casing it.
+    auto* piece = scratch;
+    auto* piece_product = piece + shorter_length;
+    auto* karatsuba_scratch = piece_product + 2 * shorter_length;
+
+    __builtin_memset(output, 0, (longer_length + shorter_length) * sizeof(Word));
+    for (size_t offset = 0; offset < longer_length; offset += shorter_length) {
+        size_t piece_length = min(shorter_length, longer_length - offset);
+        __builtin_memcpy(piece, longer + offset, piece_length * sizeof(Word));
+        __builtin_memset(piece + piece_length, 0, (shorter_length - piece_length) * sizeof(Word));
+
+        multiply_words_karatsuba(piece, shorter, shorter_length, piece_product, karatsuba_scratch);
+
+        size_t remaining_output_length = longer_length + shorter_length - offset;
+        auto carry = add_words(output + offset, remaining_output_length, piece_product, min(2 * shorter_length, remaining_output_length));
+        VERIFY(carry == 0);
+    }
+}
+
 /**
- * Complexity: O(N^2) where N is the number of words in the larger number
+ * Complexity: O(N^2) where N is the number of words in the smaller number, down to O(N^log2(3)) for numbers that are
+ * both large enough to use Karatsuba multiplication.
  * Multiplication method:
- * An integer is equal to the sum of the powers of two
- * according to the indices of its 'on' bits.
- * So to multiple x*y, we go over each '1' bit in x (say the i'th bit),
- * and add y<<i to the result.
+ * Small numbers are multiplied word by word, like one would on paper. When both numbers are long enough, the longer
+ * one is cut into pieces as long as the shorter one, and each piece is multiplied by the shorter number with the
+ * Karatsuba algorithm.
  */
 FLATTEN void UnsignedBigIntegerAlgorithms::multiply_without_allocation(
     UnsignedBigInteger const& left,
     UnsignedBigInteger const& right,
-    UnsignedBigInteger& temp_shift_result,
-    UnsignedBigInteger& temp_shift_plus,
-    UnsignedBigInteger& temp_shift,
+    UnsignedBigInteger& temp_scratch,
     UnsignedBigInteger& output)
 {
-    output.set_to_0();
+    VERIFY(&output != &left && &output != &right);
 
-    // iterate all bits
-    for (size_t word_index = 0; word_index < left.length(); ++word_index) {
-        for (size_t bit_index = 0; bit_index < UnsignedBigInteger::BITS_IN_WORD; ++bit_index) {
-            // If the bit is off - skip over it
-            if (!(left.m_words[word_index] & (1 << bit_index)))
-                continue;
+    auto const* longer = &left;
+    auto const* shorter = &right;
+    if (longer->trimmed_length() < shorter->trimmed_length())
+        swap(longer, shorter);
 
-            size_t shift_amount = word_index * UnsignedBigInteger::BITS_IN_WORD + bit_index;
+    size_t longer_length = longer->trimmed_length();
+    size_t shorter_length = shorter->trimmed_length();
 
-            // output += (right << shift_amount);
-            shift_left_without_allocation(right, shift_amount, temp_shift_result, temp_shift_plus, temp_shift);
-            add_into_accumulator_without_allocation(output, temp_shift);
-        }
+    output.set_to_0();
+    if (shorter_length == 0)
+        return;
+
+    output.m_words.resize_and_keep_capacity(longer_length + shorter_length);
+    auto* output_words = output.m_words.data();
+
+    if (shorter_length < karatsuba_threshold) {
+        multiply_words_schoolbook(longer->m_words.data(), longer_length, shorter->m_words.data(), shorter_length, output_words);
+    } else {
+        temp_scratch.set_to_0();
+        temp_scratch.m_words.resize_and_keep_capacity(karatsuba_in_pieces_scratch_length(shorter_length));
+        multiply_words_karatsuba_in_pieces(longer->m_words.data(), longer_length, shorter->m_words.data(), shorter_length, output_words, temp_scratch.m_words.data());
     }
+
+    // NOTE: The product of two trimmed numbers has at most one leading zero word.
+    if (output.m_words.last() == 0)
+        output.m_words.take_last();
 }
 
 }
@@ -4,40 +4,121 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/BitCast.h>
+#include <AK/Endian.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/Adler32.h>
 
+// See the comment in AK/SIMDExtras.h, none of the vector functions in here are visible outside of this file.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
 namespace Crypto::Checksum {
 
-void Adler32::update(ReadonlyBytes data)
+using AK::SIMD::u16x8;
+using AK::SIMD::u32x4;
+using AK::SIMD::u8x16;
+
+static constexpr u32 adler32_modulus = 65521;
+
+// Zero-extends the low or high half of the lanes of a vector into lanes twice as wide, by interleaving them with zeroes.
+// NOTE: __builtin_convertvector() does the same, but compilers tend to go through scalars for it without SSE4.1.
+template<typename Wide, typename Narrow>
+ALWAYS_INLINE static Wide widen_low_half(Narrow value)
 {
-    // See https://github.com/SerenityOS/serenity/pull/24408#discussion_r1609051678
-    constexpr size_t iterations_without_overflow = 380368439;
+    Narrow zero {};
+    if constexpr (AK::HostIsLittleEndian) {
+        if constexpr (sizeof(value[0]) == 1)
+            return bit_cast<Wide>(__builtin_shufflevector(value, zero, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23));
+        else
+            return bit_cast<Wide>(__builtin_shufflevector(value, zero, 0, 8, 1, 9, 2, 10, 3, 11));
+    } else {
+        if constexpr (sizeof(value[0]) == 1)
+            return bit_cast<Wide>(__builtin_shufflevector(value, zero, 16, 0, 17, 1, 18, 2, 19, 3, 20, 4, 21, 5, 22, 6, 23, 7));
+        else
+            return bit_cast<Wide>(__builtin_shufflevector(value, zero, 8, 0, 9, 1, 10, 2, 11, 3));
+    }
+}
+
+template<typename Wide, typename Narrow>
+ALWAYS_INLINE static Wide widen_high_half(Narrow value)
+{
+    Narrow zero {};
+    if constexpr (AK::HostIsLittleEndian) {
+        if constexpr (sizeof(value[0]) == 1)
+            return bit_cast<Wide>(__builtin_shufflevector(value, zero, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31));
+        else
+            return bit_cast<Wide>(__builtin_shufflevector(value, zero, 4, 12, 5, 13, 6, 14, 7, 15));
+    } else {
+        if constexpr (sizeof(value[0]) == 1)
+            return bit_cast<Wide>(__builtin_shufflevector(value, zero, 24, 8, 25, 9, 26, 10, 27, 11, 28, 12, 29, 13, 30, 14, 31, 15));
+        else
+            return bit_cast<Wide>(__builtin_shufflevector(value, zero, 12, 4, 13, 5, 14, 6, 15, 7));
+    }
+}
+
+// Adds whole blocks of 16 bytes to the state, with one vector lane for each position within them. For a block of n such
+// groups of 16 bytes, a grows by the sum of all bytes, and b by n * 16 * a plus the sum of each byte weighted by how
+// many bytes (including itself) are left from it to the end of the block.
+static void update_with_vectors(u64& state_a, u64& state_b, ReadonlyBytes& data)
+{
+    // NOTE: The prefix sums grow quadratically with the size of a block, this keeps them far away from overflowing.
+    constexpr size_t maximum_block_size = 5552;
+    static_assert(maximum_block_size % 16 == 0);
+
+    while (data.size() >= 16) {
+        auto block = data.trim(min(data.size() & ~static_cast<size_t>(15), maximum_block_size));
 
+        // sums[j][k] is the sum of the bytes at position 4 * j + k within each group of 16, and prefix_sums[j][k] the
+        // sum of those sums before each group.
+        Array<u32x4, 4> sums {};
+        Array<u32x4, 4> prefix_sums {};
+        for (auto const* group = block.data(); group != block.data() + block.size(); group += 16) {
+            auto bytes = AK::SIMD::load_unaligned<u8x16>(group);
+            prefix_sums[0] += sums[0];
+            prefix_sums[1] += sums[1];
+            prefix_sums[2] += sums[2];
+            prefix_sums[3] += sums[3];
+            auto low = widen_low_half<u16x8>(bytes);
+            auto high = widen_high_half<u16x8>(bytes);
+            sums[0] += widen_low_half<u32x4>(low);
+            sums[1] += widen_high_half<u32x4>(low);
+            sums[2] += widen_low_half<u32x4>(high);
+            sums[3] += widen_high_half<u32x4>(high);
+        }
+
+        u64 byte_sum = 0;
+        u64 weighted_sum = 0;
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t k = 0; k < 4; ++k) {
+                auto position = j * 4 + k;
+                byte_sum += sums[j][k];
+                weighted_sum += 16 * (prefix_sums[j][k] + sums[j][k]) - position * sums[j][k];
+            }
+        }
+
+        state_b = (state_b + block.size() * state_a + weighted_sum) % adler32_modulus;
+        state_a = (state_a + byte_sum) % adler32_modulus;
+        data = data.slice(block.size());
+    }
+}
+
+void Adler32::update(ReadonlyBytes data)
+{
     u64 state_a = m_state_a;
     u64 state_b = m_state_b;
-    while (data.size()) {
-        // You can verify that no overflow will happen here during at least
-        // `iterations_without_overflow` iterations using the following Python script:
-        //
-        // state_a = 65520
-        // state_b = 65520
-        // for i in range(380368439):
-        //     state_a += 255
-        //     state_b += state_a
-        // print(state_b < 2 ** 64)
-        auto chunk = data.slice(0, min(data.size(), iterations_without_overflow));
-        for (u8 byte : chunk) {
-            state_a += byte;
-            state_b += state_a;
-        }
-        state_a %= 65521;
-        state_b %= 65521;
-        data = data.slice(chunk.size());
+
+    update_with_vectors(state_a, state_b, data);
+
+    for (u8 byte : data) {
+        state_a += byte;
+        state_b += state_a;
     }
-    m_state_a = state_a;
-    m_state_b = state_b;
+    m_state_a = state_a % adler32_modulus;
+    m_state_b = state_b % adler32_modulus;
 }
 
 u32 Adler32::digest()
@@ -46,3 +127,5 @@ u32 Adler32::digest()
 }
 
 }
+
+#pragma GCC diagnostic pop
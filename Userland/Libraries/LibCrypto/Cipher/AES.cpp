@@ -4,10 +4,18 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Endian.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibCrypto/Cipher/AES.h>
 #include <LibCrypto/Cipher/AESTables.h>
 
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#elif defined(__ARM_FEATURE_AES)
+#    include <arm_neon.h>
+#endif
+
 namespace Crypto::Cipher {
 
 template<typename T>
@@ -39,8 +47,18 @@ ByteString AESCipherKey::to_byte_string() const
     return builder.to_byte_string();
 }
 
+void AESCipherKey::update_round_key_bytes()
+{
+    for (size_t i = 0; i < (rounds() + 1) * 4; ++i) {
+        auto word = AK::convert_between_host_and_big_endian(m_rd_keys[i]);
+        __builtin_memcpy(m_round_key_bytes + i * 4, &word, sizeof(word));
+    }
+}
+
 void AESCipherKey::expand_encrypt_key(ReadonlyBytes user_key, size_t bits)
 {
+    ScopeGuard update_round_key_bytes_when_done = [&] { update_round_key_bytes(); };
+
     u32* round_key;
     u32 temp;
     size_t i { 0 };
@@ -192,10 +210,86 @@ void AESCipherKey::expand_decrypt_key(ReadonlyBytes user_key, size_t bits)
                 AESTables::Decode3[AESTables::Encode1[(round_key[3]      ) & 0xff] & 0xff] ;
         // clang-format on
     }
+
+    update_round_key_bytes();
+}
+
+// NOTE: Both of these use the CPU's AES instructions, which unlike our tables take the same time for any key and data.
+//       Decryption takes the round keys of the equivalent inverse cipher, which is what expand_decrypt_key() produces.
+#if ARCH(X86_64)
+static bool has_aes_instructions()
+{
+    return __builtin_cpu_supports("aes");
+}
+
+[[gnu::target("aes")]] static void encrypt_block_with_aes_instructions(AESCipherKey const& key, u8 const* in, u8* out)
+{
+    auto const* round_keys = reinterpret_cast<__m128i const*>(key.round_key_bytes());
+    auto block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in)), _mm_load_si128(&round_keys[0]));
+    for (size_t i = 1; i < key.rounds(); ++i)
+        block = _mm_aesenc_si128(block, _mm_load_si128(&round_keys[i]));
+    block = _mm_aesenclast_si128(block, _mm_load_si128(&round_keys[key.rounds()]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), block);
+}
+
+[[gnu::target("aes")]] static void decrypt_block_with_aes_instructions(AESCipherKey const& key, u8 const* in, u8* out)
+{
+    auto const* round_keys = reinterpret_cast<__m128i const*>(key.round_key_bytes());
+    auto block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in)), _mm_load_si128(&round_keys[0]));
+    for (size_t i = 1; i < key.rounds(); ++i)
+        block = _mm_aesdec_si128(block, _mm_load_si128(&round_keys[i]));
+    block = _mm_aesdeclast_si128(block, _mm_load_si128(&round_keys[key.rounds()]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), block);
+}
+#elif defined(__ARM_FEATURE_AES)
+static bool has_aes_instructions()
+{
+    return true;
+}
+
+static void encrypt_block_with_aes_instructions(AESCipherKey const& key, u8 const* in, u8* out)
+{
+    auto const* round_keys = key.round_key_bytes();
+    auto block = vld1q_u8(in);
+    for (size_t i = 0; i < key.rounds() - 1; ++i)
+        block = vaesmcq_u8(vaeseq_u8(block, vld1q_u8(round_keys + i * 16)));
+    block = vaeseq_u8(block, vld1q_u8(round_keys + (key.rounds() - 1) * 16));
+    vst1q_u8(out, veorq_u8(block, vld1q_u8(round_keys + key.rounds() * 16)));
+}
+
+static void decrypt_block_with_aes_instructions(AESCipherKey const& key, u8 const* in, u8* out)
+{
+    auto const* round_keys = key.round_key_bytes();
+    auto block = vld1q_u8(in);
+    for (size_t i = 0; i < key.rounds() - 1; ++i)
+        block = vaesimcq_u8(vaesdq_u8(block, vld1q_u8(round_keys + i * 16)));
+    block = vaesdq_u8(block, vld1q_u8(round_keys + (key.rounds() - 1) * 16));
+    vst1q_u8(out, veorq_u8(block, vld1q_u8(round_keys + key.rounds() * 16)));
+}
+#else
+static bool has_aes_instructions()
+{
+    return false;
+}
+
+static void encrypt_block_with_aes_instructions(AESCipherKey const&, u8 const*, u8*)
+{
+    VERIFY_NOT_REACHED();
 }
 
+static void decrypt_block_with_aes_instructions(AESCipherKey const&, u8 const*, u8*)
+{
+    VERIFY_NOT_REACHED();
+}
+#endif
+
 void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+    if (has_aes_instructions()) {
+        encrypt_block_with_aes_instructions(key(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -285,6 +379,11 @@ void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 
 void AESCipher::decrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+    if (has_aes_instructions()) {
+        decrypt_block_with_aes_instructions(key(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
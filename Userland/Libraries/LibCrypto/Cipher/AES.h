@@ -79,6 +79,9 @@ struct AESCipherKey : public CipherKey {
     size_t rounds() const { return m_rounds; }
     size_t length() const { return m_bits / 8; }
 
+    // The same round keys, with each of them in the byte order of a block, which is what the AES instructions of CPUs use.
+    u8 const* round_key_bytes() const { return m_round_key_bytes; }
+
 protected:
     u32* round_keys()
     {
@@ -86,8 +89,11 @@ protected:
     }
 
 private:
+    void update_round_key_bytes();
+
     static constexpr size_t MAX_ROUND_COUNT = 14;
     u32 m_rd_keys[(MAX_ROUND_COUNT + 1) * 4] { 0 };
+    alignas(16) u8 m_round_key_bytes[(MAX_ROUND_COUNT + 1) * 16] { 0 };
     size_t m_rounds;
     size_t m_bits;
 };
@@ -8,6 +8,10 @@
 #include <AK/Types.h>
 #include <LibCrypto/Hash/SHA2.h>
 
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#endif
+
 namespace Crypto::Hash {
 constexpr static auto ROTRIGHT(u32 a, size_t b) { return (a >> b) | (a << (32 - b)); }
 constexpr static auto CH(u32 x, u32 y, u32 z) { return (x & y) ^ (z & ~x); }
@@ -25,8 +29,63 @@ constexpr static auto EP1(u64 x) { return ROTRIGHT(x, 14) ^ ROTRIGHT(x, 18) ^ RO
 constexpr static auto SIGN0(u64 x) { return ROTRIGHT(x, 1) ^ ROTRIGHT(x, 8) ^ (x >> 7); }
 constexpr static auto SIGN1(u64 x) { return ROTRIGHT(x, 19) ^ ROTRIGHT(x, 61) ^ (x >> 6); }
 
+#if ARCH(X86_64)
+// This keeps the state in the ABEF/CDGH layout that the SHA extensions work with, and does four rounds at a time, in two
+// steps of two. The message schedule for the next four rounds is computed alongside them.
+[[gnu::target("sha,sse4.1")]] static void sha256_transform_with_sha_instructions(u32 (&state)[8], u8 const* data)
+{
+    auto const byte_swap_mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    auto cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&state[0])), 0xb1);
+    auto efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&state[4])), 0x1b);
+    auto abef = _mm_alignr_epi8(cdab, efgh, 8);
+    auto cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+    auto const initial_abef = abef;
+    auto const initial_cdgh = cdgh;
+
+    __m128i messages[4];
+#    pragma GCC unroll 16
+    for (size_t group = 0; group < 16; ++group) {
+        auto& message = messages[group % 4];
+        if (group < 4)
+            message = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + group * 16)), byte_swap_mask);
+
+        auto message_plus_constants = _mm_add_epi32(message, _mm_loadu_si128(reinterpret_cast<__m128i const*>(&SHA256Constants::RoundConstants[group * 4])));
+        cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message_plus_constants);
+
+        if (group >= 3 && group < 15) {
+            auto& next_message = messages[(group + 1) % 4];
+            next_message = _mm_add_epi32(next_message, _mm_alignr_epi8(message, messages[(group + 3) % 4], 4));
+            next_message = _mm_sha256msg2_epu32(next_message, message);
+        }
+
+        abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message_plus_constants, 0x0e));
+
+        if (group >= 1 && group < 13) {
+            auto& previous_message = messages[(group + 3) % 4];
+            previous_message = _mm_sha256msg1_epu32(previous_message, message);
+        }
+    }
+
+    abef = _mm_add_epi32(abef, initial_abef);
+    cdgh = _mm_add_epi32(cdgh, initial_cdgh);
+
+    auto feba = _mm_shuffle_epi32(abef, 0x1b);
+    auto dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+#endif
+
 inline void SHA256::transform(u8 const* data)
 {
+#if ARCH(X86_64)
+    if (__builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1")) {
+        sha256_transform_with_sha_instructions(m_state, data);
+        return;
+    }
+#endif
+
     u32 m[64];
 
     size_t i = 0;
@@ -84,6 +143,21 @@ void update_buffer(u8* buffer, u8 const* input, size_t length, size_t& data_leng
 
 void SHA256::update(u8 const* message, size_t length)
 {
+    // NOTE: Once the buffer is empty, whole blocks can be hashed right where they are.
+    if (m_data_length != 0) {
+        auto buffered_length = min(length, BlockSize - m_data_length);
+        update_buffer<BlockSize>(m_data_buffer, message, buffered_length, m_data_length, [&]() {
+            transform(m_data_buffer);
+            m_bit_length += BlockSize * 8;
+        });
+        message += buffered_length;
+        length -= buffered_length;
+    }
+    for (; length >= BlockSize; message += BlockSize, length -= BlockSize) {
+        transform(message);
+        m_bit_length += BlockSize * 8;
+    }
+
     update_buffer<BlockSize>(m_data_buffer, message, length, m_data_length, [&]() {
         transform(m_data_buffer);
         m_bit_length += BlockSize * 8;
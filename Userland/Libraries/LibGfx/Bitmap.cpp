@@ -210,6 +210,67 @@ ErrorOr<NonnullRefPtr<Gfx::Bitmap>> Bitmap::cropped(Gfx::IntRect crop, Optional<
     return new_bitmap;
 }
 
+ErrorOr<NonnullRefPtr<Gfx::Bitmap>> Bitmap::box_downscaled(int factor) const
+{
+    VERIFY(factor >= 1);
+    VERIFY(format() == BitmapFormat::BGRA8888 || format() == BitmapFormat::BGRx8888);
+
+    IntSize new_size { ceil_div(width(), factor), ceil_div(height(), factor) };
+    auto new_bitmap = TRY(Gfx::Bitmap::create(format(), alpha_type(), new_size));
+
+    // NOTE: The colors of unpremultiplied pixels are weighed by their alpha, so that transparent ones don't darken the
+    //       edges of what's drawn.
+    bool const weigh_by_alpha = has_alpha_channel() && alpha_type() == AlphaType::Unpremultiplied;
+
+    struct Sum {
+        u64 blue { 0 };
+        u64 green { 0 };
+        u64 red { 0 };
+        u64 alpha { 0 };
+        u32 count { 0 };
+    };
+    Vector<Sum> sums;
+    TRY(sums.try_resize(new_size.width()));
+
+    for (int new_y = 0; new_y < new_size.height(); ++new_y) {
+        for (auto& sum : sums)
+            sum = {};
+
+        auto last_y = min((new_y + 1) * factor, height());
+        for (int y = new_y * factor; y < last_y; ++y) {
+            auto const* row = scanline(y);
+            for (int x = 0; x < width(); ++x) {
+                auto pixel = row[x];
+                auto& sum = sums[x / factor];
+                u64 alpha = has_alpha_channel() ? pixel >> 24 : 255;
+                u64 weight = weigh_by_alpha ? alpha : 1;
+                sum.blue += (pixel & 0xff) * weight;
+                sum.green += ((pixel >> 8) & 0xff) * weight;
+                sum.red += ((pixel >> 16) & 0xff) * weight;
+                sum.alpha += alpha;
+                ++sum.count;
+            }
+        }
+
+        auto* new_row = new_bitmap->scanline(new_y);
+        for (int new_x = 0; new_x < new_size.width(); ++new_x) {
+            auto const& sum = sums[new_x];
+            auto divisor = weigh_by_alpha ? sum.alpha : sum.count;
+            if (divisor == 0) {
+                new_row[new_x] = 0;
+                continue;
+            }
+            auto alpha = static_cast<u32>(sum.alpha / sum.count);
+            new_row[new_x] = (alpha << 24)
+                | (static_cast<u32>(sum.red / divisor) << 16)
+                | (static_cast<u32>(sum.green / divisor) << 8)
+                | static_cast<u32>(sum.blue / divisor);
+        }
+    }
+
+    return new_bitmap;
+}
+
 ErrorOr<NonnullRefPtr<Bitmap>> Bitmap::to_bitmap_backed_by_anonymous_buffer() const
 {
     if (m_buffer.is_valid()) {
@@ -74,6 +74,9 @@ public:
     ErrorOr<NonnullRefPtr<Gfx::Bitmap>> clone() const;
 
     ErrorOr<NonnullRefPtr<Gfx::Bitmap>> cropped(Gfx::IntRect, Optional<BitmapFormat> new_bitmap_format = {}) const;
+
+    // Shrinks the bitmap by averaging each square of factor by factor pixels into one.
+    ErrorOr<NonnullRefPtr<Gfx::Bitmap>> box_downscaled(int factor) const;
     ErrorOr<NonnullRefPtr<Gfx::Bitmap>> to_bitmap_backed_by_anonymous_buffer() const;
 
     [[nodiscard]] ShareableBitmap to_shareable_bitmap() const;
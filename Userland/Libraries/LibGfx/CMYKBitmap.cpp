@@ -6,6 +6,7 @@
 
 #include <AK/Checked.h>
 #include <LibGfx/CMYKBitmap.h>
+#include <LibGfx/PixelKernels.h>
 
 namespace Gfx {
 
@@ -26,13 +27,8 @@ ErrorOr<RefPtr<Bitmap>> CMYKBitmap::to_low_quality_rgb() const
     if (!m_rgb_bitmap) {
         m_rgb_bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { m_size.width(), m_size.height() }));
 
-        for (int y = 0; y < m_size.height(); ++y) {
-            for (int x = 0; x < m_size.width(); ++x) {
-                auto const& cmyk = scanline(y)[x];
-                u8 k = 255 - cmyk.k;
-                m_rgb_bitmap->scanline(y)[x] = Color((255 - cmyk.c) * k / 255, (255 - cmyk.m) * k / 255, (255 - cmyk.y) * k / 255).value();
-            }
-        }
+        for (int y = 0; y < m_size.height(); ++y)
+            PixelKernels::cmyk_to_bgrx({ scanline(y), static_cast<size_t>(m_size.width()) }, { m_rgb_bitmap->scanline(y), static_cast<size_t>(m_size.width()) });
     }
 
     return m_rgb_bitmap;
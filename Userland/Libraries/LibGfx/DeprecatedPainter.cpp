@@ -22,6 +22,7 @@
 #include <AK/Utf8View.h>
 #include <LibGfx/DeprecatedPath.h>
 #include <LibGfx/Palette.h>
+#include <LibGfx/PixelKernels.h>
 #include <LibGfx/Quad.h>
 #include <LibGfx/TextLayout.h>
 #include <stdio.h>
@@ -557,13 +558,7 @@ void DeprecatedPainter::blit(IntPoint position, Gfx::Bitmap const& source, IntRe
         u32 const* src = source.scanline(src_rect.top() + first_row) + src_rect.left() + first_column;
         size_t const src_skip = source.pitch() / sizeof(u32);
         for (int row = first_row; row < last_row; ++row) {
-            for (int i = 0; i < clipped_rect.width(); ++i) {
-                u32 rgba = src[i];
-                u32 bgra = (rgba & 0xff00ff00)
-                    | ((rgba & 0x000000ff) << 16)
-                    | ((rgba & 0x00ff0000) >> 16);
-                dst[i] = bgra;
-            }
+            PixelKernels::swap_red_and_blue({ src, static_cast<size_t>(clipped_rect.width()) }, { dst, static_cast<size_t>(clipped_rect.width()) });
             dst += dst_skip;
             src += src_skip;
         }
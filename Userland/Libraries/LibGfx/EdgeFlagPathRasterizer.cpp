@@ -323,19 +323,16 @@ auto EdgeFlagPathRasterizer<SamplesPerPixel>::accumulate_non_zero_scanline(EdgeE
     VERIFY(edge_extent.min_x >= 0);
     VERIFY(edge_extent.max_x < static_cast<int>(m_scanline.size()));
     for (int x = edge_extent.min_x; x <= edge_extent.max_x; x++) {
-        if (auto edges = m_scanline.data()[x]) {
-            // We only need to process the windings when we hit some edges.
-            for (auto y_sub = 0u; y_sub < SamplesPerPixel; y_sub++) {
-                auto subpixel_bit = 1 << y_sub;
-                if (edges & subpixel_bit) {
-                    auto winding = m_windings.data()[x].counts[y_sub];
-                    auto previous_winding_count = acc.winding.counts[y_sub];
-                    acc.winding.counts[y_sub] += winding;
-                    // Toggle fill on change to/from zero.
-                    if (bool(previous_winding_count) ^ bool(acc.winding.counts[y_sub]))
-                        acc.sample ^= subpixel_bit;
-                }
-            }
+        // We only need to process the windings when we hit some edges, and then only for the subpixels that were hit.
+        for (auto edges = m_scanline.data()[x]; edges; edges &= edges - 1) {
+            auto y_sub = count_trailing_zeroes(edges);
+            SampleType subpixel_bit = 1u << y_sub;
+            auto winding = m_windings.data()[x].counts[y_sub];
+            auto previous_winding_count = acc.winding.counts[y_sub];
+            acc.winding.counts[y_sub] += winding;
+            // Toggle fill on change to/from zero.
+            if (bool(previous_winding_count) ^ bool(acc.winding.counts[y_sub]))
+                acc.sample ^= subpixel_bit;
         }
         sample_callback(x, acc.sample);
         m_scanline.data()[x] = 0;
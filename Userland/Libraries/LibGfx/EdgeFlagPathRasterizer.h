@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Array.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/GenericShorthands.h>
 #include <AK/IntegralMath.h>
 #include <AK/Vector.h>
@@ -20,13 +21,6 @@ namespace Gfx {
 
 namespace Detail {
 
-static auto constexpr coverage_lut = [] {
-    Array<u8, 256> coverage_lut {};
-    for (u32 sample = 0; sample <= 255; sample++)
-        coverage_lut[sample] = AK::popcount(sample);
-    return coverage_lut;
-}();
-
 template<unsigned SamplesPerPixel>
 struct Sample {
     static_assert(!first_is_one_of(SamplesPerPixel, 8u, 16u, 32u), "EdgeFlagPathRasterizer: Invalid samples per pixel!");
@@ -49,7 +43,7 @@ struct Sample<8> {
 
     static u8 compute_coverage(Type sample)
     {
-        return coverage_lut[sample];
+        return AK::popcount(sample);
     }
 };
 
@@ -77,9 +71,7 @@ struct Sample<16> {
 
     static u8 compute_coverage(Type sample)
     {
-        return (
-            coverage_lut[(sample >> 0) & 0xff]
-            + coverage_lut[(sample >> 8) & 0xff]);
+        return AK::popcount(sample);
     }
 };
 
@@ -123,11 +115,7 @@ struct Sample<32> {
 
     static u8 compute_coverage(Type sample)
     {
-        return (
-            coverage_lut[(sample >> 0) & 0xff]
-            + coverage_lut[(sample >> 8) & 0xff]
-            + coverage_lut[(sample >> 16) & 0xff]
-            + coverage_lut[(sample >> 24) & 0xff]);
+        return AK::popcount(sample);
     }
 };
 
@@ -6,16 +6,156 @@
 
 #include <AK/Format.h>
 #include <AK/LexicalPath.h>
+#include <AK/StringBuilder.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/Resource.h>
+#include <LibCore/System.h>
 #include <LibGfx/Font/PathFontProvider.h>
 #include <LibGfx/Font/ScaledFont.h>
 #include <LibGfx/Font/WOFF/Loader.h>
+#include <unistd.h>
 
 namespace Gfx {
 
+// NOTE: Bump this whenever the format changes, or what we would store for the same font does.
+static constexpr auto index_header = "ladybird-font-index 1"sv;
+
 PathFontProvider::PathFontProvider() = default;
 PathFontProvider::~PathFontProvider() = default;
 
+void PathFontProvider::set_index_path(ByteString path)
+{
+    if (auto result = read_index(path); result.is_error()) {
+        if (!result.error().is_errno() || result.error().code() != ENOENT)
+            dbgln("PathFontProvider: Ignoring font index '{}': {}", path, result.error());
+        m_index.clear();
+    }
+    m_index_path = move(path);
+}
+
+void PathFontProvider::save_index_if_changed()
+{
+    if (!m_index_path.has_value() || !m_index_changed)
+        return;
+    if (auto result = write_index(*m_index_path); result.is_error()) {
+        dbgln("PathFontProvider: Failed to write font index '{}': {}", *m_index_path, result.error());
+        return;
+    }
+    m_index_changed = false;
+}
+
+ErrorOr<void> PathFontProvider::read_index(StringView path)
+{
+    auto file = TRY(Core::MappedFile::map(path));
+    StringView contents { file->bytes() };
+
+    auto lines = contents.lines();
+    if (lines.is_empty() || lines.first() != index_header)
+        return Error::from_string_literal("Unknown font index format");
+
+    // Each line is: uri, modification time, weight, width, slope, family; separated by tabs.
+    for (auto line : lines.span().slice(1)) {
+        auto fields = line.split_view('\t', SplitBehavior::KeepEmpty);
+        if (fields.size() != 6)
+            return Error::from_string_literal("Malformed font index entry");
+
+        auto modified_time = fields[1].to_number<i64>();
+        auto weight = fields[2].to_number<u16>();
+        auto width = fields[3].to_number<u16>();
+        auto slope = fields[4].to_number<u8>();
+        if (!modified_time.has_value() || !weight.has_value() || !width.has_value() || !slope.has_value())
+            return Error::from_string_literal("Malformed font index entry");
+
+        // Drop the entries of files that have been removed since, so the index doesn't keep growing as fonts come and go.
+        if (auto const file_scheme = "file://"sv; fields[0].starts_with(file_scheme)) {
+            if (Core::System::stat(fields[0].substring_view(file_scheme.length())).is_error()) {
+                m_index_changed = true;
+                continue;
+            }
+        }
+
+        m_index.set(TRY(String::from_utf8(fields[0])),
+            IndexEntry {
+                .modified_time = static_cast<time_t>(*modified_time),
+                .family = TRY(String::from_utf8(fields[5])),
+                .weight = *weight,
+                .width = *width,
+                .slope = *slope,
+            });
+    }
+    return {};
+}
+
+ErrorOr<void> PathFontProvider::write_index(StringView path) const
+{
+    StringBuilder builder;
+    builder.append(index_header);
+    builder.append('\n');
+    for (auto const& [uri, entry] : m_index) {
+        auto has_separators = [](String const& string) { return string.contains('\t') || string.contains('\n'); };
+        if (has_separators(uri) || has_separators(entry.family))
+            continue;
+        builder.appendff("{}\t{}\t{}\t{}\t{}\t{}\n", uri, static_cast<i64>(entry.modified_time), entry.weight, entry.width, entry.slope, entry.family);
+    }
+
+    // NOTE: Every WebContent process does this, so we write to a file of our own, and then move it into place in one go.
+    TRY(Core::Directory::create(LexicalPath(path).dirname(), Core::Directory::CreateDirectories::Yes));
+    auto temporary_path = ByteString::formatted("{}.{}", path, getpid());
+    {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(builder.string_view().bytes()));
+    }
+    TRY(Core::System::rename(temporary_path, path));
+    return {};
+}
+
+ErrorOr<NonnullRefPtr<Typeface>> PathFontProvider::load_typeface(Core::Resource const& resource, bool is_woff)
+{
+    if (is_woff)
+        return WOFF::try_load_from_resource(resource);
+    return Typeface::try_load_from_resource(resource);
+}
+
+void PathFontProvider::add_font_file(Core::Resource const& resource, bool is_woff)
+{
+    auto uri = resource.uri();
+    auto modified_time = resource.modified_time().value_or(0);
+
+    RefPtr<Typeface> typeface;
+    auto it = m_index.find(uri);
+    if (it == m_index.end() || it->value.modified_time != modified_time) {
+        IndexEntry new_entry { .modified_time = modified_time };
+        if (auto typeface_or_error = load_typeface(resource, is_woff); !typeface_or_error.is_error()) {
+            typeface = typeface_or_error.release_value();
+            new_entry.family = typeface->family();
+            new_entry.weight = typeface->weight();
+            new_entry.width = typeface->width();
+            new_entry.slope = typeface->slope();
+        }
+        m_index.set(uri, move(new_entry));
+        m_index_changed = true;
+        it = m_index.find(uri);
+    }
+
+    auto const& index_entry = it->value;
+    if (index_entry.family.is_empty())
+        return;
+
+    auto& family = m_typeface_by_family.ensure(FlyString { index_entry.family }, [] {
+        return Vector<TypefaceEntry> {};
+    });
+    family.append(TypefaceEntry {
+        .resource = resource,
+        .is_woff = is_woff,
+        .weight = index_entry.weight,
+        .width = index_entry.width,
+        .slope = index_entry.slope,
+        .typeface = move(typeface),
+    });
+}
+
 void PathFontProvider::load_all_fonts_from_uri(StringView uri)
 {
     auto root_or_error = Core::Resource::load_from_uri(uri);
@@ -33,34 +173,42 @@ void PathFontProvider::load_all_fonts_from_uri(StringView uri)
         auto path = LexicalPath(uri.bytes_as_string_view());
         if (path.has_extension(".ttf"sv) || path.has_extension(".ttc"sv)) {
             // FIXME: What about .otf
-            if (auto font_or_error = Typeface::try_load_from_resource(resource); !font_or_error.is_error()) {
-                auto font = font_or_error.release_value();
-                auto& family = m_typeface_by_family.ensure(font->family(), [] {
-                    return Vector<NonnullRefPtr<Typeface>> {};
-                });
-                family.append(font);
-            }
+            add_font_file(resource, false);
         } else if (path.has_extension(".woff"sv)) {
-            if (auto font_or_error = WOFF::try_load_from_resource(resource); !font_or_error.is_error()) {
-                auto font = font_or_error.release_value();
-                auto& family = m_typeface_by_family.ensure(font->family(), [] {
-                    return Vector<NonnullRefPtr<Typeface>> {};
-                });
-                family.append(font);
-            }
+            add_font_file(resource, true);
         }
         return IterationDecision::Continue;
     });
 }
 
+Typeface const* PathFontProvider::typeface_for_entry(TypefaceEntry& entry)
+{
+    if (entry.typeface)
+        return entry.typeface;
+    if (entry.failed_to_load)
+        return nullptr;
+
+    // NOTE: The file may have changed in ways its modification time doesn't tell us about since it was indexed.
+    auto typeface_or_error = load_typeface(entry.resource, entry.is_woff);
+    if (typeface_or_error.is_error()) {
+        dbgln("PathFontProvider: Failed to load indexed font '{}': {}", entry.resource->uri(), typeface_or_error.error());
+        entry.failed_to_load = true;
+        return nullptr;
+    }
+    entry.typeface = typeface_or_error.release_value();
+    return entry.typeface;
+}
+
 RefPtr<Gfx::Font> PathFontProvider::get_font(FlyString const& family, float point_size, unsigned weight, unsigned width, unsigned slope)
 {
     auto it = m_typeface_by_family.find(family);
     if (it == m_typeface_by_family.end())
         return nullptr;
-    for (auto const& typeface : it->value) {
-        if (typeface->weight() == weight && typeface->width() == width && typeface->slope() == slope)
-            return typeface->scaled_font(point_size);
+    for (auto& entry : it->value) {
+        if (entry.weight == weight && entry.width == width && entry.slope == slope) {
+            if (auto const* typeface = typeface_for_entry(entry))
+                return typeface->scaled_font(point_size);
+        }
     }
     return nullptr;
 }
@@ -70,8 +218,9 @@ void PathFontProvider::for_each_typeface_with_family_name(FlyString const& famil
     auto it = m_typeface_by_family.find(family_name);
     if (it == m_typeface_by_family.end())
         return;
-    for (auto const& typeface : it->value) {
-        callback(*typeface);
+    for (auto& entry : it->value) {
+        if (auto const* typeface = typeface_for_entry(entry))
+            callback(*typeface);
     }
 }
 
@@ -6,15 +6,21 @@
 
 #pragma once
 
+#include <AK/ByteString.h>
 #include <AK/FlyString.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
+#include <LibCore/Resource.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/Typeface.h>
 
 namespace Gfx {
 
+// Finds the fonts in a set of directories, but only loads a typeface once something asks for its family.
+//
+// NOTE: Telling the families and styles of font files apart means parsing them, so what we learn about each file is
+//       kept in an index on disk. Files that haven't changed since they were indexed are then never parsed at startup.
 class PathFontProvider final : public SystemFontProvider {
     AK_MAKE_NONCOPYABLE(PathFontProvider);
     AK_MAKE_NONMOVABLE(PathFontProvider);
@@ -25,6 +31,11 @@ public:
 
     void set_name_but_fixme_should_create_custom_system_font_provider(String name) { m_name = move(name); }
 
+    // Reads the index at the given path, if there is one, and keeps it up to date for fonts loaded afterwards.
+    void set_index_path(ByteString);
+    bool has_index_path() const { return m_index_path.has_value(); }
+    void save_index_if_changed();
+
     void load_all_fonts_from_uri(StringView);
 
     virtual RefPtr<Gfx::Font> get_font(FlyString const& family, float point_size, unsigned weight, unsigned width, unsigned slope) override;
@@ -32,8 +43,37 @@ public:
     virtual StringView name() const override { return m_name.bytes_as_string_view(); }
 
 private:
-    HashMap<FlyString, Vector<NonnullRefPtr<Typeface>>, AK::ASCIICaseInsensitiveFlyStringTraits> m_typeface_by_family;
+    struct IndexEntry {
+        time_t modified_time { 0 };
+        String family; // Empty for files that aren't fonts we can load.
+        u16 weight { 0 };
+        u16 width { 0 };
+        u8 slope { 0 };
+    };
+
+    struct TypefaceEntry {
+        NonnullRefPtr<Core::Resource> resource;
+        bool is_woff { false };
+        u16 weight { 0 };
+        u16 width { 0 };
+        u8 slope { 0 };
+        RefPtr<Typeface> typeface;
+        bool failed_to_load { false };
+    };
+
+    static ErrorOr<NonnullRefPtr<Typeface>> load_typeface(Core::Resource const&, bool is_woff);
+    Typeface const* typeface_for_entry(TypefaceEntry&);
+    void add_font_file(Core::Resource const&, bool is_woff);
+
+    ErrorOr<void> read_index(StringView path);
+    ErrorOr<void> write_index(StringView path) const;
+
+    HashMap<FlyString, Vector<TypefaceEntry>, AK::ASCIICaseInsensitiveFlyStringTraits> m_typeface_by_family;
     String m_name { "Path"_string };
+
+    Optional<ByteString> m_index_path;
+    HashMap<String, IndexEntry> m_index;
+    bool m_index_changed { false };
 };
 
 }
@@ -43,19 +43,11 @@ ScaledFont::ScaledFont(NonnullRefPtr<Typeface> typeface, float point_width, floa
     metrics.line_gap = skMetrics.fLeading;
 
     m_pixel_metrics = metrics;
-}
 
-ScaledFontMetrics ScaledFont::metrics() const
-{
-    SkFontMetrics sk_metrics;
-    skia_font(1).getMetrics(&sk_metrics);
-
-    ScaledFontMetrics metrics;
-    metrics.ascender = -sk_metrics.fAscent;
-    metrics.descender = sk_metrics.fDescent;
-    metrics.line_gap = sk_metrics.fLeading;
-    metrics.x_height = sk_metrics.fXHeight;
-    return metrics;
+    m_metrics.ascender = -skMetrics.fAscent;
+    m_metrics.descender = skMetrics.fDescent;
+    m_metrics.line_gap = skMetrics.fLeading;
+    m_metrics.x_height = skMetrics.fXHeight;
 }
 
 float ScaledFont::width(StringView view) const { return measure_text_width(Utf8View(view), *this); }
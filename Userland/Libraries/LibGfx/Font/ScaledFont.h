@@ -19,7 +19,7 @@ namespace Gfx {
 class ScaledFont final : public Gfx::Font {
 public:
     ScaledFont(NonnullRefPtr<Typeface>, float point_width, float point_height, unsigned dpi_x = DEFAULT_DPI, unsigned dpi_y = DEFAULT_DPI);
-    ScaledFontMetrics metrics() const;
+    ScaledFontMetrics const& metrics() const { return m_metrics; }
 
     // ^Gfx::Font
     virtual float point_size() const override;
@@ -52,6 +52,7 @@ private:
     float m_point_width { 0.0f };
     float m_point_height { 0.0f };
     Gfx::FontPixelMetrics m_pixel_metrics;
+    ScaledFontMetrics m_metrics;
 
     float m_pixel_size { 0.0f };
     int m_pixel_size_rounded_up { 0 };
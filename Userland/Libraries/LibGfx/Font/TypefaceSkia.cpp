@@ -11,6 +11,7 @@
 
 #include <core/SkData.h>
 #include <core/SkFontMgr.h>
+#include <core/SkGraphics.h>
 #include <core/SkRefCnt.h>
 #include <core/SkTypeface.h>
 #ifndef AK_OS_ANDROID
@@ -31,9 +32,18 @@ struct TypefaceSkia::Impl {
     sk_sp<SkTypeface> skia_typeface;
 };
 
+// NOTE: Skia keeps the images, paths and metrics of the glyphs it has rasterized, keyed by typeface, size, subpixel
+//       position and glyph id, so text is only rasterized again once it has fallen out of this cache. Its default
+//       budget of 2 MiB is too small to hold on to the glyphs of even a single text-heavy page at a few sizes.
+static constexpr size_t glyph_cache_budget = 32 * MiB;
+static constexpr int glyph_cache_count_limit = 16384;
+
 ErrorOr<NonnullRefPtr<TypefaceSkia>> TypefaceSkia::load_from_buffer(AK::ReadonlyBytes buffer, int ttc_index)
 {
     if (!s_font_manager) {
+        SkGraphics::SetFontCacheLimit(glyph_cache_budget);
+        SkGraphics::SetFontCacheCountLimit(glyph_cache_count_limit);
+
 #ifdef AK_OS_MACOS
         if (Gfx::FontDatabase::the().system_font_provider_name() != "FontConfig"sv) {
             s_font_manager = SkFontMgr_New_CoreText(nullptr);
@@ -58,6 +68,11 @@ ErrorOr<NonnullRefPtr<TypefaceSkia>> TypefaceSkia::load_from_buffer(AK::Readonly
     return adopt_ref(*new TypefaceSkia { make<TypefaceSkia::Impl>(skia_typeface), buffer, ttc_index });
 }
 
+void TypefaceSkia::purge_glyph_cache()
+{
+    SkGraphics::PurgeFontCache();
+}
+
 SkTypeface const* TypefaceSkia::sk_typeface() const
 {
     return impl().skia_typeface.get();
@@ -16,6 +16,9 @@ class TypefaceSkia : public Gfx::Typeface {
 public:
     static ErrorOr<NonnullRefPtr<TypefaceSkia>> load_from_buffer(ReadonlyBytes, int index = 0);
 
+    // Drops all of the rasterized glyphs that Skia keeps around, for when memory is short.
+    static void purge_glyph_cache();
+
     virtual u32 glyph_count() const override;
     virtual u16 units_per_em() const override;
     virtual u32 glyph_id_for_code_point(u32 code_point) const override;
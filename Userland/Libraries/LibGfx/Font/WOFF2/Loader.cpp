@@ -55,7 +55,9 @@ private:
 
 ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_externally_owned_memory(ReadonlyBytes bytes)
 {
+    // NOTE: The header tells us how big the decoded font is going to be, so we can avoid growing the buffer as we go.
     auto ttf_buffer = TRY(ByteBuffer::create_uninitialized(0));
+    TRY(ttf_buffer.try_ensure_capacity(min(woff2::ComputeWOFF2FinalSize(bytes.data(), bytes.size()), woff2::kDefaultMaxSize)));
     auto output = WOFF2ByteBufferOut { ttf_buffer };
     auto result = woff2::ConvertWOFF2ToTTF(bytes.data(), bytes.size(), &output);
     if (!result) {
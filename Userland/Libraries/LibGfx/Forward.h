@@ -28,6 +28,7 @@ class Line;
 class AntiAliasingPainter;
 class DeprecatedPainter;
 class Painter;
+class PaintingSurface;
 class Palette;
 class PaletteImpl;
 class DeprecatedPath;
@@ -1694,8 +1694,50 @@ Optional<MatrixMatrixConversion> Profile::matrix_matrix_conversion(Profile const
     return MatrixMatrixConversion(sourceRedTRC, sourceGreenTRC, sourceBlueTRC, matrix, destinationRedTRC, destinationGreenTRC, destinationBlueTRC);
 }
 
+PixelKernels::RGBLookupTransform MatrixMatrixConversion::to_lookup_transform() const
+{
+    auto evaluate_curve = [](TagData const& trc, float f) {
+        if (trc.type() == CurveTagData::Type)
+            return static_cast<CurveTagData const&>(trc).evaluate(f);
+        return static_cast<ParametricCurveTagData const&>(trc).evaluate(f);
+    };
+
+    auto evaluate_curve_inverse = [](TagData const& trc, float f) {
+        if (trc.type() == CurveTagData::Type)
+            return static_cast<CurveTagData const&>(trc).evaluate_inverse(f);
+        return static_cast<ParametricCurveTagData const&>(trc).evaluate_inverse(f);
+    };
+
+    PixelKernels::RGBLookupTransform transform;
+    transform.matrix = m_matrix;
+
+    TagData const* source_TRCs[] = { m_source_red_TRC.ptr(), m_source_green_TRC.ptr(), m_source_blue_TRC.ptr() };
+    TagData const* destination_TRCs[] = { m_destination_red_TRC.ptr(), m_destination_green_TRC.ptr(), m_destination_blue_TRC.ptr() };
+    for (size_t channel = 0; channel < 3; ++channel) {
+        for (size_t i = 0; i < 256; ++i)
+            transform.input_tables[channel][i] = evaluate_curve(*source_TRCs[channel], i / 255.0f);
+
+        for (size_t i = 0; i < PixelKernels::RGBLookupTransform::output_table_size; ++i) {
+            float device_value = evaluate_curve_inverse(*destination_TRCs[channel], i / static_cast<float>(PixelKernels::RGBLookupTransform::output_table_size - 1));
+            transform.output_tables[channel][i] = round(255 * clamp(device_value, 0.f, 1.f));
+        }
+    }
+
+    return transform;
+}
+
 ErrorOr<void> Profile::convert_image_matrix_matrix(Gfx::Bitmap& bitmap, MatrixMatrixConversion const& map) const
 {
+    // NOTE: Building the tables costs about as much as converting a few thousand pixels one by one, so small images
+    //       are still converted exactly.
+    static constexpr size_t minimum_pixel_count_for_lookup_transform = 64 * 64;
+
+    size_t pixel_count = bitmap.end() - bitmap.begin();
+    if (pixel_count >= minimum_pixel_count_for_lookup_transform) {
+        PixelKernels::apply_rgb_lookup_transform({ bitmap.begin(), pixel_count }, map.to_lookup_transform());
+        return {};
+    }
+
     for (auto& pixel : bitmap) {
         FloatVector3 rgb { (float)Color::from_argb(pixel).red(), (float)Color::from_argb(pixel).green(), (float)Color::from_argb(pixel).blue() };
         auto out = map.map(rgb / 255.0f);
@@ -18,6 +18,7 @@
 #include <LibGfx/ICC/DistinctFourCC.h>
 #include <LibGfx/ICC/TagTypes.h>
 #include <LibGfx/Matrix3x3.h>
+#include <LibGfx/PixelKernels.h>
 #include <LibGfx/Vector3.h>
 #include <LibURL/URL.h>
 
@@ -178,6 +179,10 @@ public:
 
     Color map(FloatVector3) const;
 
+    // Samples the curves of this conversion into tables, for converting whole bitmaps at a time.
+    // NOTE: The result of the transform may differ from that of map() by one level per channel.
+    PixelKernels::RGBLookupTransform to_lookup_transform() const;
+
 private:
     LutCurveType m_source_red_TRC;
     LutCurveType m_source_green_TRC;
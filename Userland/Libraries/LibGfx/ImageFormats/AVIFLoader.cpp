@@ -7,6 +7,7 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/Error.h>
+#include <LibCore/System.h>
 #include <LibGfx/ImageFormats/AVIFLoader.h>
 
 #include <avif/avif.h>
@@ -57,6 +58,11 @@ AVIFImageDecoderPlugin::~AVIFImageDecoderPlugin()
 {
 }
 
+static int decoding_thread_count()
+{
+    return static_cast<int>(min(Core::System::hardware_concurrency(), 4));
+}
+
 static ErrorOr<void> decode_avif_header(AVIFLoadingContext& context)
 {
     if (context.state >= AVIFLoadingContext::HeaderDecoded)
@@ -68,6 +74,9 @@ static ErrorOr<void> decode_avif_header(AVIFLoadingContext& context)
         if (context.decoder == nullptr) {
             return Error::from_string_literal("failed to allocate AVIF decoder");
         }
+
+        // NOTE: This lets dav1d decode the tiles and frames of an image on several threads.
+        context.decoder->maxThreads = decoding_thread_count();
     }
 
     avifResult result = avifDecoderSetIOMemory(context.decoder, context.data.data(), context.data.size());
@@ -109,6 +118,7 @@ static ErrorOr<void> decode_avif_image(AVIFLoadingContext& context)
         rgb.pixels = bitmap->scanline_u8(0);
         rgb.rowBytes = bitmap->pitch();
         rgb.format = avifRGBFormat::AVIF_RGB_FORMAT_BGRA;
+        rgb.maxThreads = decoding_thread_count();
 
         avifResult result = avifImageYUVToRGB(context.decoder->image, &rgb);
         if (result != AVIF_RESULT_OK)
@@ -5,6 +5,7 @@
  */
 
 #include <AK/LexicalPath.h>
+#include <AK/Math.h>
 #include <LibGfx/ImageFormats/AVIFLoader.h>
 #include <LibGfx/ImageFormats/BMPLoader.h>
 #include <LibGfx/ImageFormats/GIFLoader.h>
@@ -48,6 +49,20 @@ static ErrorOr<OwnPtr<ImageDecoderPlugin>> probe_and_sniff_for_appropriate_plugi
     return OwnPtr<ImageDecoderPlugin> {};
 }
 
+IntSize size_to_decode_at(IntSize natural_size, Optional<IntSize> ideal_size)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty() || natural_size.is_empty())
+        return natural_size;
+    if (ideal_size->width() >= natural_size.width() || ideal_size->height() >= natural_size.height())
+        return natural_size;
+
+    auto scale = max(static_cast<double>(ideal_size->width()) / natural_size.width(), static_cast<double>(ideal_size->height()) / natural_size.height());
+    return {
+        clamp(static_cast<int>(ceil(natural_size.width() * scale)), 1, natural_size.width()),
+        clamp(static_cast<int>(ceil(natural_size.height() * scale)), 1, natural_size.height()),
+    };
+}
+
 ErrorOr<RefPtr<ImageDecoder>> ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes bytes, [[maybe_unused]] Optional<ByteString> mime_type)
 {
     if (auto plugin = TRY(probe_and_sniff_for_appropriate_plugin(bytes)); plugin)
@@ -82,6 +82,7 @@ public:
     virtual size_t frame_count() { return 1; }
     virtual size_t first_animated_frame_index() { return 0; }
 
+    // If an ideal size is given, plugins may return a smaller bitmap than size(), as long as it still covers the ideal size.
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) = 0;
 
     virtual Optional<Metadata const&> metadata() { return OptionalNone {}; }
@@ -96,6 +97,10 @@ protected:
     ImageDecoderPlugin() = default;
 };
 
+// Returns the smallest size that keeps the aspect ratio of natural_size and still covers ideal_size. Images are never
+// scaled up, so this is natural_size if ideal_size is bigger in either dimension.
+IntSize size_to_decode_at(IntSize natural_size, Optional<IntSize> ideal_size);
+
 class ImageDecoder : public RefCounted<ImageDecoder> {
 public:
     static ErrorOr<RefPtr<ImageDecoder>> try_create_for_raw_bytes(ReadonlyBytes, Optional<ByteString> mime_type = {});
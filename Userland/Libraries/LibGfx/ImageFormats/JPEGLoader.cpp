@@ -25,20 +25,21 @@ struct JPEGLoadingContext {
 
     ReadonlyBytes data;
     Vector<u8> icc_data;
+    IntSize size;
 
     JPEGLoadingContext(ReadonlyBytes data)
         : data(data)
     {
     }
 
-    ErrorOr<void> decode();
+    ErrorOr<void> decode(Optional<IntSize> ideal_size);
 };
 
 struct JPEGErrorManager : jpeg_error_mgr {
     jmp_buf setjmp_buffer {};
 };
 
-ErrorOr<void> JPEGLoadingContext::decode()
+ErrorOr<void> JPEGLoadingContext::decode(Optional<IntSize> ideal_size)
 {
     struct jpeg_decompress_struct cinfo;
     struct JPEGErrorManager jerr;
@@ -83,13 +84,50 @@ ErrorOr<void> JPEGLoadingContext::decode()
         return Error::from_string_literal("Failed to read JPEG header");
     }
 
+    size = { static_cast<int>(cinfo.image_width), static_cast<int>(cinfo.image_height) };
+
+    // NOTE: libjpeg can scale the image down by N/8 as it decodes it, which also skips most of the inverse DCT work.
+    if (auto target_size = size_to_decode_at(size, ideal_size); target_size != size) {
+        for (unsigned numerator = 1; numerator < 8; ++numerator) {
+            if (ceil_div(cinfo.image_width * numerator, 8u) >= static_cast<unsigned>(target_size.width())
+                && ceil_div(cinfo.image_height * numerator, 8u) >= static_cast<unsigned>(target_size.height())) {
+                cinfo.scale_num = numerator;
+                cinfo.scale_denom = 8;
+                break;
+            }
+        }
+    }
+
     if (cinfo.jpeg_color_space == JCS_CMYK || cinfo.jpeg_color_space == JCS_YCCK) {
         cinfo.out_color_space = JCS_CMYK;
     } else {
         cinfo.out_color_space = JCS_EXT_BGRX;
     }
 
-    jpeg_start_decompress(&cinfo);
+    // NOTE: We decode progressive JPEGs in buffered-image mode, where we absorb all the scans there is data for and then
+    //       output the picture they make up. That way, an incomplete image still gives us a blurry version of all of it,
+    //       rather than nothing at all.
+    bool const is_progressive = jpeg_has_multiple_scans(&cinfo);
+    if (is_progressive)
+        cinfo.buffered_image = TRUE;
+
+    if (!jpeg_start_decompress(&cinfo)) {
+        jpeg_destroy_decompress(&cinfo);
+        return Error::from_string_literal("Not enough data to decode JPEG");
+    }
+
+    if (is_progressive) {
+        int status = 0;
+        do {
+            status = jpeg_consume_input(&cinfo);
+        } while (status != JPEG_SUSPENDED && status != JPEG_REACHED_EOI);
+
+        if (!jpeg_start_output(&cinfo, cinfo.input_scan_number)) {
+            jpeg_destroy_decompress(&cinfo);
+            return Error::from_string_literal("Not enough data to decode JPEG");
+        }
+    }
+
     bool could_read_all_scanlines = true;
 
     if (cinfo.out_color_space == JCS_EXT_BGRX) {
@@ -124,6 +162,9 @@ ErrorOr<void> JPEGLoadingContext::decode()
         free(icc_data_ptr);
     }
 
+    if (is_progressive && could_read_all_scanlines)
+        could_read_all_scanlines = jpeg_finish_output(&cinfo) && jpeg_input_complete(&cinfo);
+
     if (could_read_all_scanlines)
         jpeg_finish_decompress(&cinfo);
     else
@@ -151,11 +192,7 @@ IntSize JPEGImageDecoderPlugin::size()
 
     if (m_context->state == JPEGLoadingContext::State::Error)
         return {};
-    if (m_context->rgb_bitmap)
-        return m_context->rgb_bitmap->size();
-    if (m_context->cmyk_bitmap)
-        return m_context->cmyk_bitmap->size();
-    return {};
+    return m_context->size;
 }
 
 bool JPEGImageDecoderPlugin::sniff(ReadonlyBytes data)
@@ -171,7 +208,7 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(Readon
     return adopt_own(*new JPEGImageDecoderPlugin(make<JPEGLoadingContext>(data)));
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
@@ -180,7 +217,7 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
     if (m_context->state < JPEGLoadingContext::State::Decoded) {
-        TRY(m_context->decode());
+        TRY(m_context->decode(ideal_size));
         m_context->state = JPEGLoadingContext::State::Decoded;
     }
 
@@ -54,6 +54,7 @@ struct AnimationFrame {
 
 struct PNGLoadingContext {
     ReadonlyBytes data;
+    bool ran_out_of_data { false };
     IntSize size;
     u32 frame_count { 0 };
     u32 loop_count { 0 };
@@ -109,12 +110,23 @@ size_t PNGImageDecoderPlugin::frame_count()
     return m_context->frame_count;
 }
 
-ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index >= m_context->frame_descriptors.size())
         return Error::from_errno(EINVAL);
 
-    return m_context->frame_descriptors[index];
+    auto const& descriptor = m_context->frame_descriptors[index];
+
+    // NOTE: libpng can't decode at a smaller size, so we shrink still images by a whole factor once we have them. That
+    //       at least keeps only the small bitmap around.
+    if (ideal_size.has_value() && m_context->frame_count == 1 && descriptor.image) {
+        auto target_size = size_to_decode_at(m_context->size, ideal_size);
+        auto factor = min(m_context->size.width() / target_size.width(), m_context->size.height() / target_size.height());
+        if (factor >= 2)
+            return ImageFrameDescriptor { TRY(descriptor.image->box_downscaled(factor)), descriptor.duration };
+    }
+
+    return descriptor;
 }
 
 ErrorOr<Optional<ReadonlyBytes>> PNGImageDecoderPlugin::icc_data()
@@ -138,17 +150,27 @@ ErrorOr<bool> PNGImageDecoderPlugin::initialize()
 
     if (setjmp(png_jmpbuf(png_ptr))) {
         png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+
+        // NOTE: If the data ends partway through the first frame, we keep the rows we've got (or, for interlaced images,
+        //       the passes), so that an image can be shown while it's still loading. The rest stays transparent.
+        if (m_context->ran_out_of_data && m_context->decoded_frame_bitmap && m_context->frame_descriptors.is_empty()) {
+            m_context->frame_count = 1;
+            m_context->loop_count = 0;
+            m_context->frame_descriptors.append({ move(m_context->decoded_frame_bitmap), 0 });
+            return true;
+        }
         return false;
     }
 
-    png_set_read_fn(png_ptr, &m_context->data, [](png_structp png_ptr, png_bytep data, png_size_t length) {
-        auto* read_data = reinterpret_cast<ReadonlyBytes*>(png_get_io_ptr(png_ptr));
-        if (read_data->size() < length) {
+    png_set_read_fn(png_ptr, m_context.ptr(), [](png_structp png_ptr, png_bytep data, png_size_t length) {
+        auto* context = reinterpret_cast<PNGLoadingContext*>(png_get_io_ptr(png_ptr));
+        if (context->data.size() < length) {
+            context->ran_out_of_data = true;
             png_error(png_ptr, "Read error");
             return;
         }
-        memcpy(data, read_data->data(), length);
-        *read_data = read_data->slice(length);
+        memcpy(data, context->data.data(), length);
+        context->data = context->data.slice(length);
     });
 
     png_read_info(png_ptr, info_ptr);
@@ -18,6 +18,9 @@ struct PNGWriterOptions {
     // Data for the iCCP chunk.
     // FIXME: Allow writing cICP, sRGB, or gAMA instead too.
     Optional<ReadonlyBytes> icc_data;
+
+    // zlib compression level from 0 (store) to 9 (smallest). libpng's default is used if empty.
+    Optional<int> compression_level;
 };
 
 class PNGWriter {
@@ -115,7 +115,7 @@ static ErrorOr<void> decode_webp_header(WebPLoadingContext& context)
     return {};
 }
 
-static ErrorOr<void> decode_webp_image(WebPLoadingContext& context)
+static ErrorOr<void> decode_webp_image(WebPLoadingContext& context, Optional<IntSize> ideal_size)
 {
     VERIFY(context.state >= WebPLoadingContext::State::HeaderDecoded);
 
@@ -148,6 +148,29 @@ static ErrorOr<void> decode_webp_image(WebPLoadingContext& context)
 
             context.frame_descriptors.append(ImageFrameDescriptor { bitmap, duration });
         }
+    } else if (auto target_size = size_to_decode_at(context.size, ideal_size); target_size != context.size) {
+        // NOTE: libwebp can scale the image down as it decodes it, so we never have to hold the full-size bitmap.
+        auto bitmap_format = context.has_alpha ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
+        auto bitmap = TRY(Bitmap::create(bitmap_format, Gfx::AlphaType::Unpremultiplied, target_size));
+
+        WebPDecoderConfig config {};
+        if (!WebPInitDecoderConfig(&config))
+            return Error::from_string_literal("Failed to initialize webp decoder config");
+        config.options.use_scaling = 1;
+        config.options.scaled_width = target_size.width();
+        config.options.scaled_height = target_size.height();
+        config.output.colorspace = MODE_BGRA;
+        config.output.is_external_memory = 1;
+        config.output.u.RGBA.rgba = bitmap->scanline_u8(0);
+        config.output.u.RGBA.stride = bitmap->pitch();
+        config.output.u.RGBA.size = bitmap->data_size();
+
+        auto status = WebPDecode(context.data.data(), context.data.size(), &config);
+        WebPFreeDecBuffer(&config.output);
+        if (status != VP8_STATUS_OK)
+            return Error::from_string_literal("Failed to decode webp image into bitmap");
+
+        context.frame_descriptors.append(ImageFrameDescriptor { bitmap, 0 });
     } else {
         auto bitmap_format = context.has_alpha ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
         auto bitmap = TRY(Bitmap::create(bitmap_format, Gfx::AlphaType::Unpremultiplied, context.size));
@@ -204,7 +227,7 @@ size_t WebPImageDecoderPlugin::first_animated_frame_index()
     return 0;
 }
 
-ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index >= frame_count())
         return Error::from_string_literal("WebPImageDecoderPlugin: Invalid frame index");
@@ -213,7 +236,7 @@ ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Option
         return Error::from_string_literal("WebPImageDecoderPlugin: Decoding failed");
 
     if (m_context->state < WebPLoadingContext::State::BitmapDecoded) {
-        TRY(decode_webp_image(*m_context));
+        TRY(decode_webp_image(*m_context, ideal_size));
         m_context->state = WebPLoadingContext::State::BitmapDecoded;
     }
 
@@ -14,6 +14,13 @@
 
 namespace Gfx {
 
+// Something a painter made out of an immutable bitmap to draw it with, like a copy of it that lives on the GPU, kept around
+// so that drawing the same bitmap again doesn't have to make it again.
+class PreparedImmutableBitmap : public RefCounted<PreparedImmutableBitmap> {
+public:
+    virtual ~PreparedImmutableBitmap() = default;
+};
+
 class ImmutableBitmap final : public RefCounted<ImmutableBitmap> {
 public:
     static NonnullRefPtr<ImmutableBitmap> create(NonnullRefPtr<Bitmap> bitmap);
@@ -30,9 +37,14 @@ public:
 
     size_t id() const { return m_id; }
 
+    // NOTE: This doesn't change the bitmap, it only caches what drawing it takes, hence the const.
+    RefPtr<PreparedImmutableBitmap> const& prepared_bitmap() const { return m_prepared_bitmap; }
+    void set_prepared_bitmap(RefPtr<PreparedImmutableBitmap> prepared_bitmap) const { m_prepared_bitmap = move(prepared_bitmap); }
+
 private:
     NonnullRefPtr<Bitmap> m_bitmap;
     size_t m_id;
+    mutable RefPtr<PreparedImmutableBitmap> m_prepared_bitmap;
 
     explicit ImmutableBitmap(NonnullRefPtr<Bitmap> bitmap);
 };
@@ -6,6 +6,7 @@
 
 #include <LibGfx/Painter.h>
 #include <LibGfx/PainterSkia.h>
+#include <LibGfx/PaintingSurface.h>
 
 namespace Gfx {
 
@@ -16,4 +17,9 @@ NonnullOwnPtr<Painter> Painter::create(NonnullRefPtr<Gfx::Bitmap> target_bitmap)
     return make<PainterSkia>(move(target_bitmap));
 }
 
+NonnullOwnPtr<Painter> Painter::create(NonnullRefPtr<Gfx::PaintingSurface> target_surface)
+{
+    return make<PainterSkia>(move(target_surface));
+}
+
 }
@@ -17,6 +17,7 @@ namespace Gfx {
 class Painter {
 public:
     static NonnullOwnPtr<Gfx::Painter> create(NonnullRefPtr<Gfx::Bitmap>);
+    static NonnullOwnPtr<Gfx::Painter> create(NonnullRefPtr<Gfx::PaintingSurface>);
 
     virtual ~Painter();
 
@@ -8,7 +8,9 @@
 
 #include <AK/OwnPtr.h>
 #include <LibGfx/PainterSkia.h>
+#include <LibGfx/PaintingSurface.h>
 #include <LibGfx/PathSkia.h>
+#include <LibGfx/SkiaUtils.h>
 
 #include <AK/TypeCasts.h>
 #include <core/SkBitmap.h>
@@ -22,55 +24,19 @@
 #include <core/SkSurface.h>
 #include <effects/SkGradientShader.h>
 #include <effects/SkImageFilters.h>
-#include <gpu/GrDirectContext.h>
-#include <gpu/ganesh/SkSurfaceGanesh.h>
 #include <pathops/SkPathOps.h>
 
 namespace Gfx {
 
-static SkColorType to_skia_color_type(Gfx::BitmapFormat format)
-{
-    switch (format) {
-    case Gfx::BitmapFormat::Invalid:
-        return kUnknown_SkColorType;
-    case Gfx::BitmapFormat::BGRA8888:
-    case Gfx::BitmapFormat::BGRx8888:
-        return kBGRA_8888_SkColorType;
-    case Gfx::BitmapFormat::RGBA8888:
-        return kRGBA_8888_SkColorType;
-    default:
-        return kUnknown_SkColorType;
-    }
-}
-
-static SkAlphaType to_skia_alpha_type(Gfx::AlphaType alpha_type)
-{
-    switch (alpha_type) {
-    case AlphaType::Premultiplied:
-        return kPremul_SkAlphaType;
-    case AlphaType::Unpremultiplied:
-        return kUnpremul_SkAlphaType;
-    default:
-        VERIFY_NOT_REACHED();
-    }
-}
-
 struct PainterSkia::Impl {
-    NonnullRefPtr<Gfx::Bitmap> gfx_bitmap;
-    OwnPtr<SkBitmap> sk_bitmap;
-    OwnPtr<SkCanvas> sk_canvas;
+    NonnullRefPtr<Gfx::PaintingSurface> painting_surface;
 
-    Impl(NonnullRefPtr<Gfx::Bitmap> target_bitmap)
-        : gfx_bitmap(move(target_bitmap))
+    Impl(NonnullRefPtr<Gfx::PaintingSurface> painting_surface)
+        : painting_surface(move(painting_surface))
     {
-        sk_bitmap = make<SkBitmap>();
-        SkImageInfo info = SkImageInfo::Make(gfx_bitmap->width(), gfx_bitmap->height(), to_skia_color_type(gfx_bitmap->format()), to_skia_alpha_type(gfx_bitmap->alpha_type()));
-        sk_bitmap->installPixels(info, gfx_bitmap->scanline(0), gfx_bitmap->pitch());
-
-        sk_canvas = make<SkCanvas>(*sk_bitmap);
     }
 
-    SkCanvas* canvas() { return sk_canvas; }
+    SkCanvas* canvas() { return &painting_surface->canvas(); }
 };
 
 static constexpr SkRect to_skia_rect(auto const& rect)
@@ -100,7 +66,12 @@ static SkPathFillType to_skia_path_fill_type(Gfx::WindingRule winding_rule)
 }
 
 PainterSkia::PainterSkia(NonnullRefPtr<Gfx::Bitmap> target_bitmap)
-    : m_impl(adopt_own(*new Impl { move(target_bitmap) }))
+    : PainterSkia(PaintingSurface::wrap_bitmap(move(target_bitmap)))
+{
+}
+
+PainterSkia::PainterSkia(NonnullRefPtr<Gfx::PaintingSurface> painting_surface)
+    : m_impl(adopt_own(*new Impl { move(painting_surface) }))
 {
 }
 
@@ -112,6 +83,7 @@ void PainterSkia::clear_rect(Gfx::FloatRect const& rect, Gfx::Color color)
     paint.setColor(to_skia_color(color));
     paint.setBlendMode(SkBlendMode::kClear);
     impl().canvas()->drawRect(to_skia_rect(rect), paint);
+    impl().painting_surface->did_draw();
 }
 
 void PainterSkia::fill_rect(Gfx::FloatRect const& rect, Color color)
@@ -119,6 +91,7 @@ void PainterSkia::fill_rect(Gfx::FloatRect const& rect, Color color)
     SkPaint paint;
     paint.setColor(to_skia_color(color));
     impl().canvas()->drawRect(to_skia_rect(rect), paint);
+    impl().painting_surface->did_draw();
 }
 
 static SkSamplingOptions to_skia_sampling_options(Gfx::ScalingMode scaling_mode)
@@ -152,6 +125,7 @@ void PainterSkia::draw_bitmap(Gfx::FloatRect const& dst_rect, Gfx::Bitmap const&
         to_skia_sampling_options(scaling_mode),
         &paint,
         SkCanvas::kStrict_SrcRectConstraint);
+    impl().painting_surface->did_draw();
 }
 
 void PainterSkia::set_transform(Gfx::AffineTransform const& transform)
@@ -177,6 +151,7 @@ void PainterSkia::stroke_path(Gfx::Path const& path, Gfx::Color color, float thi
     paint.setColor(to_skia_color(color));
     auto sk_path = to_skia_path(path);
     impl().canvas()->drawPath(sk_path, paint);
+    impl().painting_surface->did_draw();
 }
 
 static SkPoint to_skia_point(auto const& point)
@@ -255,6 +230,7 @@ void PainterSkia::stroke_path(Gfx::Path const& path, Gfx::PaintStyle const& pain
     paint.setStyle(SkPaint::Style::kStroke_Style);
     paint.setStrokeWidth(thickness);
     impl().canvas()->drawPath(sk_path, paint);
+    impl().painting_surface->did_draw();
 }
 
 void PainterSkia::fill_path(Gfx::Path const& path, Gfx::Color color, Gfx::WindingRule winding_rule)
@@ -265,6 +241,7 @@ void PainterSkia::fill_path(Gfx::Path const& path, Gfx::Color color, Gfx::Windin
     auto sk_path = to_skia_path(path);
     sk_path.setFillType(to_skia_path_fill_type(winding_rule));
     impl().canvas()->drawPath(sk_path, paint);
+    impl().painting_surface->did_draw();
 }
 
 void PainterSkia::fill_path(Gfx::Path const& path, Gfx::PaintStyle const& paint_style, float global_alpha, Gfx::WindingRule winding_rule)
@@ -275,6 +252,7 @@ void PainterSkia::fill_path(Gfx::Path const& path, Gfx::PaintStyle const& paint_
     paint.setAntiAlias(true);
     paint.setAlphaf(global_alpha);
     impl().canvas()->drawPath(sk_path, paint);
+    impl().painting_surface->did_draw();
 }
 
 void PainterSkia::save()
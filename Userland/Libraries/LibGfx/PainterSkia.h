@@ -15,6 +15,7 @@ namespace Gfx {
 class PainterSkia final : public Painter {
 public:
     explicit PainterSkia(NonnullRefPtr<Gfx::Bitmap>);
+    explicit PainterSkia(NonnullRefPtr<Gfx::PaintingSurface>);
     virtual ~PainterSkia() override;
 
     virtual void clear_rect(Gfx::FloatRect const&, Color) override;
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#define AK_DONT_REPLACE_STD
+
+#include <LibGfx/PaintingSurface.h>
+#include <LibGfx/SkiaUtils.h>
+
+#include <core/SkCanvas.h>
+#include <core/SkPixmap.h>
+#include <core/SkSurface.h>
+#include <gpu/GrDirectContext.h>
+#include <gpu/ganesh/SkSurfaceGanesh.h>
+
+namespace Gfx {
+
+struct PaintingSurface::Impl {
+    sk_sp<SkSurface> surface;
+};
+
+static SkImageInfo image_info_for_bitmap(Bitmap const& bitmap)
+{
+    return SkImageInfo::Make(bitmap.width(), bitmap.height(), to_skia_color_type(bitmap.format()), to_skia_alpha_type(bitmap.alpha_type()));
+}
+
+NonnullRefPtr<PaintingSurface> PaintingSurface::wrap_bitmap(NonnullRefPtr<Bitmap> bitmap)
+{
+    auto surface = SkSurfaces::WrapPixels(image_info_for_bitmap(*bitmap), bitmap->scanline(0), bitmap->pitch());
+    VERIFY(surface);
+    return adopt_ref(*new PaintingSurface(move(bitmap), adopt_own(*new Impl { move(surface) }), false));
+}
+
+RefPtr<PaintingSurface> PaintingSurface::create_on_gpu(GrDirectContext& context, NonnullRefPtr<Bitmap> bitmap)
+{
+    auto surface = SkSurfaces::RenderTarget(&context, skgpu::Budgeted::kYes, image_info_for_bitmap(*bitmap));
+    if (!surface)
+        return nullptr;
+
+    // NOTE: Unlike the bitmap, a new render target isn't guaranteed to be cleared, so upload what the bitmap holds.
+    surface->writePixels(SkPixmap(image_info_for_bitmap(*bitmap), bitmap->scanline(0), bitmap->pitch()), 0, 0);
+    return adopt_ref(*new PaintingSurface(move(bitmap), adopt_own(*new Impl { move(surface) }), true));
+}
+
+PaintingSurface::PaintingSurface(NonnullRefPtr<Bitmap> bitmap, NonnullOwnPtr<Impl> impl, bool is_gpu_backed)
+    : m_bitmap(move(bitmap))
+    , m_impl(move(impl))
+    , m_is_gpu_backed(is_gpu_backed)
+{
+}
+
+PaintingSurface::~PaintingSurface() = default;
+
+SkCanvas& PaintingSurface::canvas() const
+{
+    return *m_impl->surface->getCanvas();
+}
+
+void PaintingSurface::flush()
+{
+    if (!m_has_unflushed_drawing)
+        return;
+    m_has_unflushed_drawing = false;
+
+    // NOTE: Reading the pixels back submits everything recorded on the GPU since the last flush, and waits for it.
+    SkPixmap pixmap(image_info_for_bitmap(*m_bitmap), m_bitmap->scanline(0), m_bitmap->pitch());
+    m_impl->surface->readPixels(pixmap, 0, 0);
+}
+
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/RefCounted.h>
+#include <LibGfx/Bitmap.h>
+
+class GrDirectContext;
+class SkCanvas;
+
+namespace Gfx {
+
+// A surface that a Painter draws on, whose contents end up in a bitmap. The surface either draws straight into the
+// pixels of the bitmap, or records its drawing on the GPU and only copies the result into the bitmap when flushed.
+class PaintingSurface : public RefCounted<PaintingSurface> {
+public:
+    static NonnullRefPtr<PaintingSurface> wrap_bitmap(NonnullRefPtr<Bitmap>);
+    static RefPtr<PaintingSurface> create_on_gpu(GrDirectContext&, NonnullRefPtr<Bitmap>);
+
+    ~PaintingSurface();
+
+    SkCanvas& canvas() const;
+
+    Bitmap& bitmap() const { return *m_bitmap; }
+    bool is_gpu_backed() const { return m_is_gpu_backed; }
+
+    // Must be called after drawing on the canvas, so that the next flush knows there's something to copy.
+    void did_draw() { m_has_unflushed_drawing = m_is_gpu_backed; }
+
+    // Makes the bitmap reflect everything that has been drawn on the canvas so far.
+    void flush();
+
+private:
+    struct Impl;
+
+    PaintingSurface(NonnullRefPtr<Bitmap>, NonnullOwnPtr<Impl>, bool is_gpu_backed);
+
+    NonnullRefPtr<Bitmap> m_bitmap;
+    NonnullOwnPtr<Impl> m_impl;
+    bool m_is_gpu_backed { false };
+    bool m_has_unflushed_drawing { false };
+};
+
+}
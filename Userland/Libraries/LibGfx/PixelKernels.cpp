@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <AK/SIMDExtras.h>
+#include <LibGfx/CMYKBitmap.h>
+#include <LibGfx/PixelKernels.h>
+
+// See the comment in AK/SIMDExtras.h, none of the vector functions in here are visible outside of this file.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace Gfx::PixelKernels {
+
+using AK::SIMD::f32x4;
+using AK::SIMD::i32x4;
+using AK::SIMD::u32x4;
+
+static_assert(AK::HostIsLittleEndian, "The kernels assume that the bytes of a pixel are laid out in little-endian order");
+
+static constexpr size_t pixels_per_vector = 4;
+
+ALWAYS_INLINE static u32x4 splat(u32 value)
+{
+    return AK::SIMD::expand4(value);
+}
+
+// Exact for all x in [0, 255 * 255], unlike the usual (x * 257) >> 16 approximation.
+ALWAYS_INLINE static u32x4 divide_by_255(u32x4 x)
+{
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+ALWAYS_INLINE static u32 divide_by_255(u32 x)
+{
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+ALWAYS_INLINE static u32 swap_red_and_blue(u32 pixel)
+{
+    return (pixel & 0xff00ff00) | ((pixel & 0x000000ff) << 16) | ((pixel & 0x00ff0000) >> 16);
+}
+
+void swap_red_and_blue(ReadonlySpan<ARGB32> source, Span<ARGB32> destination)
+{
+    VERIFY(source.size() == destination.size());
+
+    size_t i = 0;
+    for (; i + pixels_per_vector <= source.size(); i += pixels_per_vector) {
+        auto pixels = AK::SIMD::load_unaligned<u32x4>(&source[i]);
+        pixels = (pixels & splat(0xff00ff00)) | ((pixels & splat(0x000000ff)) << 16) | ((pixels & splat(0x00ff0000)) >> 16);
+        AK::SIMD::store_unaligned(&destination[i], pixels);
+    }
+    for (; i < source.size(); ++i)
+        destination[i] = swap_red_and_blue(source[i]);
+}
+
+void premultiply_alpha(Span<ARGB32> pixels)
+{
+    size_t i = 0;
+    for (; i + pixels_per_vector <= pixels.size(); i += pixels_per_vector) {
+        auto vector = AK::SIMD::load_unaligned<u32x4>(&pixels[i]);
+        auto alpha = vector >> 24;
+        auto red = divide_by_255(((vector >> 16) & 0xff) * alpha);
+        auto green = divide_by_255(((vector >> 8) & 0xff) * alpha);
+        auto blue = divide_by_255((vector & 0xff) * alpha);
+        AK::SIMD::store_unaligned(&pixels[i], (alpha << 24) | (red << 16) | (green << 8) | blue);
+    }
+    for (; i < pixels.size(); ++i)
+        pixels[i] = Color::from_argb(pixels[i]).with_alpha(pixels[i] >> 24, AlphaType::Premultiplied).value();
+}
+
+// For all alpha values a, and all color values c <= a, (c * table[a]) >> 16 is c * 255 / a.
+static constexpr auto unpremultiply_table = [] {
+    Array<u32, 256> table {};
+    for (u32 alpha = 1; alpha < 256; ++alpha)
+        table[alpha] = (255 * 65536 + alpha - 1) / alpha;
+    return table;
+}();
+
+void unpremultiply_alpha(Span<ARGB32> pixels)
+{
+    size_t i = 0;
+    for (; i + pixels_per_vector <= pixels.size(); i += pixels_per_vector) {
+        auto vector = AK::SIMD::load_unaligned<u32x4>(&pixels[i]);
+        auto alpha = vector >> 24;
+
+        // NOTE: Fully opaque and fully transparent pixels stay as they are, which is what nearly all pixels are.
+        auto is_partially_transparent = (alpha != 0) & (alpha != 255);
+        if (AK::SIMD::none(static_cast<i32x4>(is_partially_transparent)))
+            continue;
+
+        u32x4 factor = AK::SIMD::load4(&unpremultiply_table[alpha[0]], &unpremultiply_table[alpha[1]], &unpremultiply_table[alpha[2]], &unpremultiply_table[alpha[3]]);
+
+        // NOTE: Valid premultiplied colors are never brighter than their alpha, but we don't want those that are to wrap.
+        auto unpremultiply = [&](u32x4 channel) {
+            auto result = (channel * factor) >> 16;
+            return (result > 255) ? splat(255) : result;
+        };
+        auto red = unpremultiply((vector >> 16) & 0xff);
+        auto green = unpremultiply((vector >> 8) & 0xff);
+        auto blue = unpremultiply(vector & 0xff);
+        auto unpremultiplied = (alpha << 24) | (red << 16) | (green << 8) | blue;
+
+        AK::SIMD::store_unaligned(&pixels[i], is_partially_transparent ? unpremultiplied : vector);
+    }
+    for (; i < pixels.size(); ++i) {
+        u32 alpha = pixels[i] >> 24;
+        if (alpha == 0 || alpha == 255)
+            continue;
+        auto unpremultiply = [&](u32 channel) {
+            return min((channel * unpremultiply_table[alpha]) >> 16, 255u);
+        };
+        pixels[i] = (alpha << 24) | (unpremultiply((pixels[i] >> 16) & 0xff) << 16) | (unpremultiply((pixels[i] >> 8) & 0xff) << 8) | unpremultiply(pixels[i] & 0xff);
+    }
+}
+
+void cmyk_to_bgrx(ReadonlySpan<CMYK> source, Span<ARGB32> destination)
+{
+    VERIFY(source.size() == destination.size());
+    static_assert(sizeof(CMYK) == sizeof(u32));
+
+    size_t i = 0;
+    for (; i + pixels_per_vector <= source.size(); i += pixels_per_vector) {
+        auto cmyk = AK::SIMD::load_unaligned<u32x4>(&source[i]);
+        auto inverted = ~cmyk;
+        auto k = inverted >> 24;
+        auto red = divide_by_255((inverted & 0xff) * k);
+        auto green = divide_by_255(((inverted >> 8) & 0xff) * k);
+        auto blue = divide_by_255(((inverted >> 16) & 0xff) * k);
+        AK::SIMD::store_unaligned(&destination[i], splat(0xff000000) | (red << 16) | (green << 8) | blue);
+    }
+    for (; i < source.size(); ++i) {
+        u32 k = 255 - source[i].k;
+        destination[i] = 0xff000000
+            | divide_by_255((255 - source[i].c) * k) << 16
+            | divide_by_255((255 - source[i].m) * k) << 8
+            | divide_by_255((255 - source[i].y) * k);
+    }
+}
+
+void apply_rgb_lookup_transform(Span<ARGB32> pixels, RGBLookupTransform const& transform)
+{
+    auto const& input = transform.input_tables;
+    auto const& output = transform.output_tables;
+    auto const& elements = transform.matrix.elements();
+
+    // NOTE: Each column of the matrix is what one input channel contributes to all three output channels, so we can
+    //       compute the whole matrix product for a pixel with three vector multiply-adds.
+    f32x4 const red_column { elements[0][0], elements[1][0], elements[2][0], 0 };
+    f32x4 const green_column { elements[0][1], elements[1][1], elements[2][1], 0 };
+    f32x4 const blue_column { elements[0][2], elements[1][2], elements[2][2], 0 };
+    auto const scale = AK::SIMD::expand4(static_cast<float>(RGBLookupTransform::output_table_size - 1));
+
+    for (auto& pixel : pixels) {
+        auto linear = red_column * input[0][(pixel >> 16) & 0xff]
+            + green_column * input[1][(pixel >> 8) & 0xff]
+            + blue_column * input[2][pixel & 0xff];
+
+        linear = linear < 0.f ? AK::SIMD::expand4(0.f) : linear;
+        linear = linear > 1.f ? AK::SIMD::expand4(1.f) : linear;
+        auto index = AK::SIMD::to_i32x4(linear * scale + 0.5f);
+
+        pixel = (pixel & 0xff000000)
+            | output[0][index[0]] << 16
+            | output[1][index[1]] << 8
+            | output[2][index[2]];
+    }
+}
+
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Span.h>
+#include <LibGfx/Color.h>
+#include <LibGfx/Matrix3x3.h>
+
+namespace Gfx {
+
+struct CMYK;
+
+// Loops over whole rows of pixels that are run on every decoded image, written in terms of AK::SIMD vectors so that they
+// process several pixels at once with whatever vector instructions the target has (SSE2 on x86-64, NEON on AArch64).
+// Unless noted otherwise, the results are identical to those of the equivalent per-pixel operations on Color.
+namespace PixelKernels {
+
+// Turns RGBA8888 pixels into BGRA8888 ones, and vice versa. The source and destination may be the same.
+void swap_red_and_blue(ReadonlySpan<ARGB32> source, Span<ARGB32> destination);
+
+// Same as Color::with_alpha(alpha, AlphaType::Premultiplied) and Color::to_unpremultiplied(), for each pixel.
+// NOTE: Colors that are brighter than their alpha, and so never come out of premultiplying, are clamped to 255.
+void premultiply_alpha(Span<ARGB32>);
+void unpremultiply_alpha(Span<ARGB32>);
+
+// Same as the naive conversion in CMYKBitmap::to_low_quality_rgb(), producing BGRx8888 pixels.
+void cmyk_to_bgrx(ReadonlySpan<CMYK> source, Span<ARGB32> destination);
+
+// A color transform that linearizes each channel of 8-bit RGB, applies a 3x3 matrix, and then maps each channel back
+// through an output curve. All curves are sampled into tables up front, so that applying the transform doesn't need to
+// evaluate them for every pixel. This is how matrix/TRC based ICC profiles convert between each other.
+struct RGBLookupTransform {
+    static constexpr size_t output_table_size = 4096;
+
+    Array<Array<float, 256>, 3> input_tables;
+    FloatMatrix3x3 matrix;
+
+    // Indexed by the linear value of a channel in [0, 1], scaled to [0, output_table_size - 1] and rounded.
+    Array<Array<u8, output_table_size>, 3> output_tables;
+};
+
+// Applies the transform to the color channels of each pixel, leaving alpha alone.
+// NOTE: As the linear values are quantized to index the output tables, channels may end up one level off from what
+//       evaluating the curves directly would give.
+void apply_rgb_lookup_transform(Span<ARGB32>, RGBLookupTransform const&);
+
+}
+
+}
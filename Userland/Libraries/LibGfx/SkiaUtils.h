@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibGfx/Bitmap.h>
+
+#include <core/SkAlphaType.h>
+#include <core/SkColorType.h>
+
+namespace Gfx {
+
+SkColorType to_skia_color_type(Gfx::BitmapFormat);
+SkAlphaType to_skia_alpha_type(Gfx::AlphaType);
+
+}
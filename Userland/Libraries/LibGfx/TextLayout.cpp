@@ -6,17 +6,35 @@
  */
 
 #include "TextLayout.h"
+#include <AK/HashTable.h>
 #include <AK/TypeCasts.h>
 #include <LibGfx/Font/ScaledFont.h>
 #include <harfbuzz/hb.h>
 
 namespace Gfx {
 
-RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, Utf8View string, Gfx::Font const& font, GlyphRun::TextType text_type)
+// Shaping is by far the most expensive part of laying out text, and most text is laid out again unchanged on
+// every relayout. So we hold on to the glyphs of recently shaped text, positioned relative to a baseline start of (0, 0).
+struct ShapedText {
+    ByteString text;
+    NonnullRefPtr<Font const> font;
+    Vector<DrawGlyph> glyphs;
+    float width { 0 };
+};
+
+static constexpr size_t shaped_text_cache_capacity = 4096;
+static constexpr size_t maximum_cached_text_length = 4 * KiB;
+
+static unsigned shaped_text_hash(StringView text, Font const& font)
+{
+    return pair_int_hash(text.hash(), ptr_hash(&font));
+}
+
+static ShapedText shape_text_uncached(StringView text, Font const& font)
 {
     hb_buffer_t* buffer = hb_buffer_create();
     ScopeGuard destroy_buffer = [&]() { hb_buffer_destroy(buffer); };
-    hb_buffer_add_utf8(buffer, reinterpret_cast<char const*>(string.bytes()), string.byte_length(), 0, -1);
+    hb_buffer_add_utf8(buffer, text.characters_without_null_termination(), text.length(), 0, -1);
     hb_buffer_guess_segment_properties(buffer);
 
     u32 glyph_count;
@@ -29,8 +47,8 @@ RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, Utf8View string, Gfx::Fon
     glyph_info = hb_buffer_get_glyph_infos(buffer, &glyph_count);
     auto* positions = hb_buffer_get_glyph_positions(buffer, &glyph_count);
 
-    Vector<Gfx::DrawGlyph> glyph_run;
-    FloatPoint point = baseline_start;
+    Vector<Gfx::DrawGlyph> glyphs;
+    FloatPoint point;
     for (size_t i = 0; i < glyph_count; ++i) {
         if (input_glyph_info[i].codepoint == '\t')
             continue;
@@ -38,17 +56,60 @@ RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, Utf8View string, Gfx::Fon
         auto position = point
             - FloatPoint { 0, font.pixel_metrics().ascent }
             + FloatPoint { positions[i].x_offset, positions[i].y_offset } / text_shaping_resolution;
-        glyph_run.append({ position, glyph_info[i].codepoint });
+        glyphs.append({ position, glyph_info[i].codepoint });
         point += FloatPoint { positions[i].x_advance, positions[i].y_advance } / text_shaping_resolution;
     }
 
-    return adopt_ref(*new Gfx::GlyphRun(move(glyph_run), font, text_type, point.x()));
+    return { ByteString(text), font, move(glyphs), point.x() };
+}
+
+struct ShapedTextTraits : public DefaultTraits<ShapedText> {
+    static unsigned hash(ShapedText const& shaped_text) { return shaped_text_hash(shaped_text.text, *shaped_text.font); }
+    static bool equals(ShapedText const& a, ShapedText const& b) { return a.font.ptr() == b.font.ptr() && a.text == b.text; }
+};
+
+template<typename Callback>
+static decltype(auto) with_shaped_text(Utf8View const& string, Font const& font, Callback callback)
+{
+    auto text = string.as_string();
+    if (text.length() > maximum_cached_text_length)
+        return callback(shape_text_uncached(text, font));
+
+    // Least recently used first.
+    static OrderedHashTable<ShapedText, ShapedTextTraits> s_shaped_text_cache;
+
+    auto hash = shaped_text_hash(text, font);
+    auto matches = [&](ShapedText const& shaped_text) { return shaped_text.font.ptr() == &font && shaped_text.text == text; };
+
+    auto it = s_shaped_text_cache.find(hash, matches);
+    if (it != s_shaped_text_cache.end()) {
+        auto shaped_text = move(*it);
+        s_shaped_text_cache.remove(it);
+        s_shaped_text_cache.set(move(shaped_text));
+    } else {
+        if (s_shaped_text_cache.size() >= shaped_text_cache_capacity)
+            (void)s_shaped_text_cache.take_first();
+        s_shaped_text_cache.set(shape_text_uncached(text, font));
+    }
+    return callback(*s_shaped_text_cache.find(hash, matches));
+}
+
+RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, Utf8View string, Gfx::Font const& font, GlyphRun::TextType text_type)
+{
+    return with_shaped_text(string, font, [&](ShapedText const& shaped_text) {
+        Vector<DrawGlyph> glyphs;
+        glyphs.ensure_capacity(shaped_text.glyphs.size());
+        for (auto glyph : shaped_text.glyphs) {
+            glyph.translate_by(baseline_start);
+            glyphs.unchecked_append(glyph);
+        }
+        return adopt_ref(*new Gfx::GlyphRun(move(glyphs), font, text_type, baseline_start.x() + shaped_text.width));
+    });
 }
 
 float measure_text_width(Utf8View const& string, Gfx::Font const& font)
 {
-    auto glyph_run = shape_text({}, string, font, GlyphRun::TextType::Common);
-    return glyph_run->width();
+    return with_shaped_text(string, font, [](ShapedText const& shaped_text) { return shaped_text.width; });
 }
 
 }
@@ -6,14 +6,25 @@
  */
 
 #include <AK/Vector.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
 #include <LibCore/Timer.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/Statistics.h>
 #include <LibIPC/Stub.h>
 
 namespace IPC {
 
+// NOTE: The peer receives at most this many file descriptors at once, see LocalSocket::receive_message().
+static constexpr size_t max_file_descriptors_per_batch = 64;
+
+static u64 response_key(u32 endpoint_magic, int message_id)
+{
+    return (static_cast<u64>(endpoint_magic) << 32) | static_cast<u32>(message_id);
+}
+
 ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalSocket> socket, u32 local_endpoint_magic)
     : m_local_stub(local_stub)
     , m_socket(move(socket))
@@ -33,23 +44,31 @@ ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalS
 
     m_send_queue = adopt_ref(*new SendQueue);
     m_send_thread = Threading::Thread::construct([this, queue = m_send_queue]() -> intptr_t {
-        for (;;) {
-            queue->mutex.lock();
-            while (queue->messages.is_empty() && queue->running)
-                queue->condition.wait();
+        Vector<MessageBuffer, SendQueue::capacity> batch;
+        size_t batch_fd_count = 0;
 
-            if (!queue->running) {
-                queue->mutex.unlock();
-                break;
-            }
+        auto send_batch = [&] {
+            if (auto result = MessageBuffer::transfer_messages(*m_socket, batch); result.is_error())
+                dbgln("ConnectionBase::send_thread: {}", result.error());
+            batch.clear_with_capacity();
+            batch_fd_count = 0;
+        };
 
-            auto message = queue->messages.take_first();
-            queue->mutex.unlock();
+        while (queue->wait_for_messages()) {
+            // Send everything that has queued up by now in one go, rather than waking up the peer for each message.
+            for (auto message = queue->dequeue(); message.has_value(); message = queue->dequeue()) {
+                if (!batch.is_empty() && batch_fd_count + message->fd_count() > max_file_descriptors_per_batch)
+                    send_batch();
 
-            if (auto result = message.transfer_message(*m_socket); result.is_error()) {
-                dbgln("ConnectionBase::send_thread: {}", result.error());
-                continue;
+                batch_fd_count += message->fd_count();
+                batch.append(message.release_value());
+
+                if (batch.size() == SendQueue::capacity)
+                    send_batch();
             }
+
+            if (!batch.is_empty())
+                send_batch();
         }
         return 0;
     });
@@ -58,11 +77,7 @@ ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalS
 
 ConnectionBase::~ConnectionBase()
 {
-    {
-        Threading::MutexLocker locker(m_send_queue->mutex);
-        m_send_queue->running = false;
-        m_send_queue->condition.signal();
-    }
+    m_send_queue->stop();
     m_send_thread->detach();
 }
 
@@ -73,7 +88,10 @@ bool ConnectionBase::is_open() const
 
 ErrorOr<void> ConnectionBase::post_message(Message const& message)
 {
-    return post_message(TRY(message.encode()));
+    auto buffer = TRY(message.encode());
+    if (Statistics::is_enabled())
+        Statistics::record_sent_message(message, buffer.data_size());
+    return post_message(move(buffer));
 }
 
 ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
@@ -83,11 +101,7 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
     if (!m_socket->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
-    {
-        Threading::MutexLocker locker(m_send_queue->mutex);
-        m_send_queue->messages.append(move(buffer));
-        m_send_queue->condition.signal();
-    }
+    m_send_queue->enqueue(move(buffer));
 
     m_responsiveness_timer->start();
     return {};
@@ -96,9 +110,42 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
 void ConnectionBase::shutdown()
 {
     m_socket->close();
+
+    // NOTE: The responses to these will never arrive now.
+    auto pending_response_handlers = move(m_pending_response_handlers);
+    for (auto& it : pending_response_handlers) {
+        for (auto& handler : it.value) {
+            if (handler)
+                handler(nullptr);
+        }
+    }
+
     die();
 }
 
+void ConnectionBase::expect_response(u32 endpoint_magic, int message_id, ResponseHandler handler)
+{
+    m_pending_response_handlers.ensure(response_key(endpoint_magic, message_id)).append(move(handler));
+}
+
+void ConnectionBase::enqueue_parsed_message(NonnullOwnPtr<Message> message, size_t byte_count)
+{
+    if (Statistics::is_enabled()) {
+        Statistics::record_received_message(*message, byte_count);
+        m_message_arrival_times.set(message.ptr(), MonotonicTime::now());
+    }
+
+    auto it = m_pending_response_handlers.find(response_key(message->endpoint_magic(), message->message_id()));
+    if (it != m_pending_response_handlers.end()) {
+        auto handler = it->value.take_first();
+        if (it->value.is_empty())
+            m_pending_response_handlers.remove(it);
+        m_claimed_responses.set(message.ptr(), move(handler));
+    }
+
+    m_unprocessed_messages.append(move(message));
+}
+
 void ConnectionBase::shutdown_with_error(Error const& error)
 {
     dbgln("IPC::ConnectionBase ({:p}) had an error ({}), disconnecting.", this, error);
@@ -109,8 +156,24 @@ void ConnectionBase::handle_messages()
 {
     auto messages = move(m_unprocessed_messages);
     for (auto& message : messages) {
+        auto received_at = m_message_arrival_times.take(message.ptr());
+
+        if (auto handler = m_claimed_responses.take(message.ptr()); handler.has_value()) {
+            if (*handler)
+                (*handler)(move(message));
+            continue;
+        }
+
         if (message->endpoint_magic() == m_local_endpoint_magic) {
+            Optional<MonotonicTime> handling_started_at;
+            if (received_at.has_value())
+                handling_started_at = MonotonicTime::now();
+
             auto handler_result = m_local_stub.handle(*message);
+
+            if (handling_started_at.has_value())
+                Statistics::record_handled_message(*message, *handling_started_at - *received_at, MonotonicTime::now() - *handling_started_at);
+
             if (handler_result.is_error()) {
                 dbgln("IPC::ConnectionBase::handle_messages: {}", handler_result.error());
                 continue;
@@ -137,16 +200,13 @@ void ConnectionBase::wait_for_socket_to_become_readable()
     VERIFY(maybe_did_become_readable.value());
 }
 
-ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without_blocking()
+ErrorOr<ByteBuffer> ConnectionBase::read_as_much_as_possible_from_socket_without_blocking()
 {
-    Vector<u8> bytes;
+    // NOTE: New bytes are received right behind the partial message that was left over last time, if any.
+    auto bytes = move(m_unprocessed_bytes);
+    auto const unprocessed_byte_count = bytes.size();
 
-    if (!m_unprocessed_bytes.is_empty()) {
-        bytes.append(m_unprocessed_bytes.data(), m_unprocessed_bytes.size());
-        m_unprocessed_bytes.clear();
-    }
-
-    u8 buffer[4096];
+    static constexpr size_t receive_chunk_size = 64 * KiB;
     Vector<int> received_fds;
 
     bool should_shut_down = false;
@@ -158,7 +218,12 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
     };
 
     while (m_socket->is_open()) {
-        auto maybe_bytes_read = m_socket->receive_message({ buffer, 4096 }, MSG_DONTWAIT, received_fds);
+        auto const size_before_read = bytes.size();
+        auto buffer = TRY(bytes.get_bytes_for_writing(receive_chunk_size));
+
+        auto maybe_bytes_read = m_socket->receive_message(buffer, MSG_DONTWAIT, received_fds);
+        bytes.trim(size_before_read + (maybe_bytes_read.is_error() ? 0 : maybe_bytes_read.value().size()), false);
+
         if (maybe_bytes_read.is_error()) {
             auto error = maybe_bytes_read.release_error();
             if (error.is_syscall() && error.code() == EAGAIN) {
@@ -181,12 +246,11 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
             break;
         }
 
-        bytes.append(bytes_read.data(), bytes_read.size());
         for (auto const& fd : received_fds)
             m_unprocessed_fds.enqueue(IPC::File::adopt_fd(fd));
     }
 
-    if (!bytes.is_empty()) {
+    if (bytes.size() > unprocessed_byte_count) {
         m_responsiveness_timer->stop();
         did_become_responsive();
     } else if (should_shut_down) {
@@ -207,12 +271,15 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
         // Sometimes we might receive a partial message. That's okay, just stash away
         // the unprocessed bytes and we'll prepend them to the next incoming message
         // in the next run of this function.
-        auto remaining_bytes = TRY(ByteBuffer::copy(bytes.span().slice(index)));
         if (!m_unprocessed_bytes.is_empty()) {
             shutdown();
             return Error::from_string_literal("drain_messages_from_peer: Already have unprocessed bytes");
         }
-        m_unprocessed_bytes = move(remaining_bytes);
+        auto remaining_byte_count = bytes.size() - index;
+        if (index > 0)
+            memmove(bytes.data(), bytes.data() + index, remaining_byte_count);
+        bytes.trim(remaining_byte_count, false);
+        m_unprocessed_bytes = move(bytes);
     }
 
     if (!m_unprocessed_messages.is_empty()) {
@@ -232,8 +299,12 @@ OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32
             auto& message = m_unprocessed_messages[i];
             if (message->endpoint_magic() != endpoint_magic)
                 continue;
-            if (message->message_id() == message_id)
+            if (m_claimed_responses.contains(message.ptr()))
+                continue;
+            if (message->message_id() == message_id) {
+                m_message_arrival_times.remove(message.ptr());
                 return m_unprocessed_messages.take(i);
+            }
         }
 
         if (!m_socket->is_open())
@@ -246,18 +317,71 @@ OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32
     return {};
 }
 
-void ConnectionBase::try_parse_messages(Vector<u8> const& bytes, size_t& index)
+bool ConnectionBase::try_parse_out_of_line_message(u32 message_size)
+{
+    // NOTE: The anonymous buffer's file descriptor is sent with the header, ahead of the message's own file descriptors.
+    if (m_unprocessed_fds.is_empty()) {
+        dbgln("Out-of-line IPC message without a file descriptor");
+        return false;
+    }
+
+    auto buffer_size = message_size & ~out_of_line_message_flag;
+    auto buffer = Core::AnonymousBuffer::create_from_anon_fd(m_unprocessed_fds.dequeue().take_fd(), buffer_size);
+    if (buffer.is_error()) {
+        dbgln("Failed to map out-of-line IPC message: {}", buffer.error());
+        return false;
+    }
+
+    // NOTE: The size comes from the peer. Reading past the end of the file would raise SIGBUS rather than fail.
+    auto stat = Core::System::fstat(buffer.value().fd());
+    if (stat.is_error()) {
+        dbgln("Failed to stat out-of-line IPC message: {}", stat.error());
+        return false;
+    }
+    if (stat.value().st_size < 0 || static_cast<u64>(stat.value().st_size) < buffer_size) {
+        dbgln("Out-of-line IPC message of {} bytes is in a file of only {} bytes", buffer_size, stat.value().st_size);
+        return false;
+    }
+
+    // NOTE: The peer can still write to the shared memory, so we decode a copy of the message that it can't change while
+    //       we validate and decode it.
+    auto message_bytes = ByteBuffer::copy(buffer.value().data<u8>(), buffer_size);
+    if (message_bytes.is_error()) {
+        dbgln("Failed to copy out-of-line IPC message: {}", message_bytes.error());
+        return false;
+    }
+
+    if (auto message = try_parse_message(message_bytes.value(), m_unprocessed_fds)) {
+        enqueue_parsed_message(message.release_nonnull(), buffer_size);
+        return true;
+    }
+
+    dbgln("Failed to parse out-of-line IPC message of {} bytes", buffer_size);
+    return false;
+}
+
+void ConnectionBase::try_parse_messages(ReadonlyBytes bytes, size_t& index)
 {
     u32 message_size = 0;
-    for (; index + sizeof(message_size) < bytes.size(); index += message_size) {
+    for (; index + sizeof(message_size) <= bytes.size(); index += message_size) {
         memcpy(&message_size, bytes.data() + index, sizeof(message_size));
+
+        if ((message_size & out_of_line_message_flag) != 0) {
+            // NOTE: The header is all there is of this message in the socket, so it is consumed even if parsing fails.
+            auto header = exchange(message_size, 0);
+            index += sizeof(header);
+            if (!try_parse_out_of_line_message(header))
+                break;
+            continue;
+        }
+
         if (message_size == 0 || bytes.size() - index - sizeof(uint32_t) < message_size)
             break;
         index += sizeof(message_size);
         auto remaining_bytes = ReadonlyBytes { bytes.data() + index, message_size };
 
         if (auto message = try_parse_message(remaining_bytes, m_unprocessed_fds)) {
-            m_unprocessed_messages.append(message.release_nonnull());
+            enqueue_parsed_message(message.release_nonnull(), message_size);
             continue;
         }
 
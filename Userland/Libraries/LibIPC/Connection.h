@@ -8,12 +8,14 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/HashMap.h>
 #include <AK/Queue.h>
 #include <LibCore/EventReceiver.h>
+#include <LibCore/Promise.h>
 #include <LibIPC/File.h>
 #include <LibIPC/Forward.h>
-#include <LibThreading/ConditionVariable.h>
-#include <LibThreading/MutexProtected.h>
+#include <LibIPC/SendQueue.h>
+#include <LibIPC/Statistics.h>
 #include <LibThreading/Thread.h>
 
 namespace IPC {
@@ -32,6 +34,14 @@ public:
 
     Core::LocalSocket& socket() { return *m_socket; }
 
+    // Called with the response once it arrives, or with nullptr if the connection is shut down before that. A null
+    // handler drops the response.
+    using ResponseHandler = Function<void(OwnPtr<Message>)>;
+
+    // The peer answers requests in the order it receives them, so the next response of this type is the one to the
+    // request that was posted right before this is called.
+    void expect_response(u32 endpoint_magic, int message_id, ResponseHandler);
+
 protected:
     explicit ConnectionBase(IPC::Stub&, NonnullOwnPtr<Core::LocalSocket>, u32 local_endpoint_magic);
 
@@ -42,9 +52,11 @@ protected:
 
     OwnPtr<IPC::Message> wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id);
     void wait_for_socket_to_become_readable();
-    ErrorOr<Vector<u8>> read_as_much_as_possible_from_socket_without_blocking();
+    ErrorOr<ByteBuffer> read_as_much_as_possible_from_socket_without_blocking();
     ErrorOr<void> drain_messages_from_peer();
-    void try_parse_messages(Vector<u8> const& bytes, size_t& index);
+    void try_parse_messages(ReadonlyBytes bytes, size_t& index);
+    bool try_parse_out_of_line_message(u32 message_size);
+    void enqueue_parsed_message(NonnullOwnPtr<Message>, size_t byte_count);
 
     ErrorOr<void> post_message(MessageBuffer);
     void handle_messages();
@@ -56,18 +68,20 @@ protected:
     RefPtr<Core::Timer> m_responsiveness_timer;
 
     Vector<NonnullOwnPtr<Message>> m_unprocessed_messages;
+
+    // Handlers for responses that have not arrived yet, in the order of their requests, keyed by the response type.
+    HashMap<u64, Vector<ResponseHandler>> m_pending_response_handlers;
+
+    // Responses in m_unprocessed_messages that go to a handler, rather than to whoever waits for a message of their type.
+    HashMap<Message const*, ResponseHandler> m_claimed_responses;
+
+    // When IPC statistics are enabled, this is when each of m_unprocessed_messages was received.
+    HashMap<Message const*, MonotonicTime> m_message_arrival_times;
     Queue<IPC::File> m_unprocessed_fds;
     ByteBuffer m_unprocessed_bytes;
 
     u32 m_local_endpoint_magic { 0 };
 
-    struct SendQueue : public AtomicRefCounted<SendQueue> {
-        AK::SinglyLinkedList<MessageBuffer> messages;
-        Threading::Mutex mutex;
-        Threading::ConditionVariable condition { mutex };
-        bool running { true };
-    };
-
     RefPtr<Threading::Thread> m_send_thread;
     RefPtr<SendQueue> m_send_queue;
 };
@@ -89,9 +103,15 @@ public:
     template<typename RequestType, typename... Args>
     NonnullOwnPtr<typename RequestType::ResponseType> send_sync(Args&&... args)
     {
+        Optional<MonotonicTime> started_at;
+        if (Statistics::is_enabled())
+            started_at = MonotonicTime::now();
+
         MUST(post_message(RequestType(forward<Args>(args)...)));
         auto response = wait_for_specific_endpoint_message<typename RequestType::ResponseType, PeerEndpoint>();
         VERIFY(response);
+        if (started_at.has_value())
+            Statistics::record_round_trip(PeerEndpoint::static_magic(), RequestType::static_message_id(), MonotonicTime::now() - *started_at);
         return response.release_nonnull();
     }
 
@@ -103,6 +123,39 @@ public:
         return wait_for_specific_endpoint_message<typename RequestType::ResponseType, PeerEndpoint>();
     }
 
+    // Like send_sync(), but returns right away. The promise is resolved from the event loop once the response arrives,
+    // so several requests can be in flight at the same time.
+    template<typename RequestType, typename... Args>
+    NonnullRefPtr<Core::Promise<NonnullOwnPtr<typename RequestType::ResponseType>>> send_async(Args&&... args)
+    {
+        using ResponseType = typename RequestType::ResponseType;
+        auto promise = Core::Promise<NonnullOwnPtr<ResponseType>>::construct();
+
+        if (auto result = post_message(RequestType(forward<Args>(args)...)); result.is_error()) {
+            promise->reject(result.release_error());
+            return promise;
+        }
+
+        expect_response(PeerEndpoint::static_magic(), ResponseType::static_message_id(), [promise](OwnPtr<Message> response) {
+            if (!response) {
+                promise->reject(Error::from_string_literal("IPC connection was shut down before the response arrived"));
+                return;
+            }
+            promise->resolve(response.release_nonnull<ResponseType>());
+        });
+        return promise;
+    }
+
+    // For synchronous messages whose response nobody is interested in. The response is still accounted for, so that it
+    // is not mistaken for the response to a later request of the same type.
+    template<typename RequestType>
+    ErrorOr<void> post_message_ignoring_response(RequestType const& request)
+    {
+        TRY(post_message(request));
+        expect_response(PeerEndpoint::static_magic(), RequestType::ResponseType::static_message_id(), nullptr);
+        return {};
+    }
+
 protected:
     template<typename MessageType, typename Endpoint>
     OwnPtr<MessageType> wait_for_specific_endpoint_message()
@@ -5,6 +5,7 @@
  */
 
 #include <AK/Checked.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Socket.h>
 #include <LibCore/System.h>
 #include <LibIPC/Message.h>
@@ -38,7 +39,27 @@ ErrorOr<void> MessageBuffer::append_file_descriptor(int fd)
     return {};
 }
 
-ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket)
+ErrorOr<void> MessageBuffer::move_data_out_of_line()
+{
+    auto message_bytes = m_data.span().slice(sizeof(MessageSizeType));
+    if ((message_bytes.size() & out_of_line_message_flag) != 0)
+        return Error::from_string_literal("Message is too large for IPC encoding");
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(message_bytes.size()));
+    message_bytes.copy_to({ buffer.data<u8>(), buffer.size() });
+
+    // NOTE: The buffer's own file descriptor goes away with the buffer, the peer gets a duplicate of it.
+    auto fd = TRY(Core::System::dup(buffer.fd()));
+    auto auto_fd = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) AutoCloseFileDescriptor(fd)));
+    TRY(m_fds.try_prepend(move(auto_fd)));
+
+    MessageSizeType const header = out_of_line_message_flag | static_cast<MessageSizeType>(message_bytes.size());
+    m_data.resize(sizeof(MessageSizeType));
+    m_data.span().overwrite(0, reinterpret_cast<u8 const*>(&header), sizeof(header));
+    return {};
+}
+
+ErrorOr<void> MessageBuffer::prepare_for_transfer()
 {
     Checked<MessageSizeType> checked_message_size { m_data.size() };
     checked_message_size -= sizeof(MessageSizeType);
@@ -47,29 +68,46 @@ ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket)
         return Error::from_string_literal("Message is too large for IPC encoding");
 
     MessageSizeType const message_size = checked_message_size.value();
-    m_data.span().overwrite(0, reinterpret_cast<u8 const*>(&message_size), sizeof(message_size));
-
-    auto raw_fds = Vector<int, 1> {};
-    auto num_fds_to_transfer = m_fds.size();
-    if (num_fds_to_transfer > 0) {
-        raw_fds.ensure_capacity(num_fds_to_transfer);
-        for (auto& owned_fd : m_fds) {
-            raw_fds.unchecked_append(owned_fd->value());
-        }
+    if (message_size >= out_of_line_message_threshold) {
+        TRY(move_data_out_of_line());
+    } else {
+        m_data.span().overwrite(0, reinterpret_cast<u8 const*>(&message_size), sizeof(message_size));
     }
+    return {};
+}
 
-    ReadonlyBytes bytes_to_write { m_data.span() };
+ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket)
+{
+    return transfer_messages(socket, { this, 1 });
+}
 
-    while (!bytes_to_write.is_empty()) {
-        ErrorOr<ssize_t> maybe_nwritten = 0;
-        if (num_fds_to_transfer > 0) {
-            maybe_nwritten = socket.send_message(bytes_to_write, 0, raw_fds);
-            if (!maybe_nwritten.is_error())
-                num_fds_to_transfer = 0;
-        } else {
-            maybe_nwritten = socket.write_some(bytes_to_write);
+ErrorOr<void> MessageBuffer::transfer_messages(Core::LocalSocket& socket, Span<MessageBuffer> messages)
+{
+    Vector<ReadonlyBytes, 32> chunks_to_write;
+    Vector<int, 32> raw_fds;
+    TRY(chunks_to_write.try_ensure_capacity(messages.size()));
+
+    Optional<Error> first_error;
+    for (auto& message : messages) {
+        // NOTE: A message that can't be sent is left out, so that it doesn't take the rest of the batch down with it.
+        if (auto result = message.prepare_for_transfer(); result.is_error()) {
+            dbgln("IPC::transfer_messages: Dropping a message: {}", result.error());
+            if (!first_error.has_value())
+                first_error = result.release_error();
+            continue;
         }
 
+        chunks_to_write.unchecked_append(message.m_data.span());
+        for (auto& owned_fd : message.m_fds)
+            TRY(raw_fds.try_append(owned_fd->value()));
+    }
+
+    Span<ReadonlyBytes> remaining_chunks = chunks_to_write.span();
+    auto num_fds_to_transfer = raw_fds.size();
+
+    while (!remaining_chunks.is_empty()) {
+        // NOTE: The file descriptors only go out along with the first bytes that make it into the socket.
+        auto maybe_nwritten = socket.send_message(remaining_chunks, 0, raw_fds.span().trim(num_fds_to_transfer));
         if (maybe_nwritten.is_error()) {
             if (auto error = maybe_nwritten.release_error(); error.is_errno() && (error.code() == EAGAIN || error.code() == EWOULDBLOCK)) {
                 Vector<struct pollfd, 1> pollfds;
@@ -98,9 +136,20 @@ ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket)
             }
         }
 
-        bytes_to_write = bytes_to_write.slice(maybe_nwritten.value());
+        num_fds_to_transfer = 0;
+
+        // Skip over everything that was written. On a short write, the rest of the chunk it stopped in goes out next time.
+        size_t nwritten = maybe_nwritten.value();
+        while (!remaining_chunks.is_empty() && nwritten >= remaining_chunks[0].size()) {
+            nwritten -= remaining_chunks[0].size();
+            remaining_chunks = remaining_chunks.slice(1);
+        }
+        if (nwritten > 0)
+            remaining_chunks[0] = remaining_chunks[0].slice(nwritten);
     }
 
+    if (first_error.has_value())
+        return first_error.release_value();
     return {};
 }
 
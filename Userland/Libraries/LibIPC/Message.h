@@ -35,6 +35,15 @@ private:
     int m_fd;
 };
 
+// NOTE: Messages at least this big are sent out-of-line: the message goes into an anonymous buffer, and only the buffer's
+//       file descriptor is sent over the socket. This saves pushing big payloads through the socket buffers in pieces,
+//       and copying them together again on the receiving side.
+static constexpr size_t out_of_line_message_threshold = 64 * KiB;
+
+// The size header of an out-of-line message has this flag set, and no message bytes follow it. The remaining bits of the
+// header are the size of the message in the anonymous buffer, which is the first file descriptor sent with the header.
+static constexpr u32 out_of_line_message_flag = 1u << 31;
+
 class MessageBuffer {
 public:
     MessageBuffer();
@@ -46,7 +55,19 @@ public:
 
     ErrorOr<void> transfer_message(Core::LocalSocket& socket);
 
+    // Sends all the messages with as few writes to the socket as possible, passing along all their file descriptors at once.
+    // Messages that can't be prepared for sending are dropped, and the first error about them is returned once the others
+    // were sent.
+    static ErrorOr<void> transfer_messages(Core::LocalSocket& socket, Span<MessageBuffer> messages);
+
+    ReadonlyBytes data() const { return m_data; }
+    size_t data_size() const { return m_data.size(); }
+    size_t fd_count() const { return m_fds.size(); }
+
 private:
+    ErrorOr<void> prepare_for_transfer();
+    ErrorOr<void> move_data_out_of_line();
+
     Vector<u8, 1024> m_data;
     Vector<NonnullRefPtr<AutoCloseFileDescriptor>, 1> m_fds;
 };
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibIPC/SendQueue.h>
+
+namespace IPC {
+
+SendQueue::SendQueue()
+{
+    for (size_t i = 0; i < capacity; ++i)
+        m_slots[i].sequence.store(i, AK::MemoryOrder::memory_order_relaxed);
+}
+
+SendQueue::~SendQueue()
+{
+    while (try_dequeue_from_ring().has_value())
+        ;
+}
+
+bool SendQueue::try_enqueue_in_ring(MessageBuffer& message)
+{
+    auto position = m_enqueue_position.load(AK::MemoryOrder::memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    for (;;) {
+        slot = &m_slots[position % capacity];
+        auto sequence = slot->sequence.load(AK::MemoryOrder::memory_order_acquire);
+        auto difference = static_cast<ssize_t>(sequence) - static_cast<ssize_t>(position);
+
+        if (difference == 0) {
+            // The slot is free, try to claim it. On failure, position is updated to where the others got to.
+            if (m_enqueue_position.compare_exchange_strong(position, position + 1, AK::MemoryOrder::memory_order_relaxed))
+                break;
+        } else if (difference < 0) {
+            // The slot still holds a message from the previous lap, so the ring is full.
+            return false;
+        } else {
+            position = m_enqueue_position.load(AK::MemoryOrder::memory_order_relaxed);
+        }
+    }
+
+    new (slot->storage) MessageBuffer(move(message));
+    slot->sequence.store(position + 1, AK::MemoryOrder::memory_order_release);
+    return true;
+}
+
+Optional<MessageBuffer> SendQueue::try_dequeue_from_ring()
+{
+    auto& slot = m_slots[m_dequeue_position % capacity];
+    if (slot.sequence.load(AK::MemoryOrder::memory_order_acquire) != m_dequeue_position + 1)
+        return {};
+
+    auto message = move(slot.message());
+    slot.message().~MessageBuffer();
+
+    // Hand the slot back to the producers for their next lap around the ring.
+    slot.sequence.store(m_dequeue_position + capacity, AK::MemoryOrder::memory_order_release);
+    ++m_dequeue_position;
+    return message;
+}
+
+bool SendQueue::ring_has_messages() const
+{
+    auto const& slot = m_slots[m_dequeue_position % capacity];
+    return slot.sequence.load(AK::MemoryOrder::memory_order_acquire) == m_dequeue_position + 1;
+}
+
+bool SendQueue::ring_is_empty() const
+{
+    // NOTE: Unlike !ring_has_messages(), this is false while a thread has claimed the next slot but not yet filled it.
+    return m_enqueue_position.load(AK::MemoryOrder::memory_order_acquire) == m_dequeue_position;
+}
+
+Optional<MessageBuffer> SendQueue::try_dequeue_taken_overflow_message()
+{
+    if (m_dequeued_taken_overflow_message_count == m_taken_overflow_messages.size())
+        return {};
+    return move(m_taken_overflow_messages[m_dequeued_taken_overflow_message_count++]);
+}
+
+bool SendQueue::has_messages() const
+{
+    return m_dequeued_taken_overflow_message_count < m_taken_overflow_messages.size()
+        || ring_has_messages()
+        || (m_has_overflow_messages.load(AK::MemoryOrder::memory_order_acquire) && ring_is_empty());
+}
+
+void SendQueue::enqueue(MessageBuffer&& message)
+{
+    // NOTE: Once a message went into the overflow list, every message after it has to as well, until the send thread has
+    //       caught up. Otherwise, a later message from the same thread could overtake it through the ring.
+    if (m_has_overflow_messages.load(AK::MemoryOrder::memory_order_acquire) || !try_enqueue_in_ring(message)) {
+        Threading::MutexLocker locker(m_overflow_mutex);
+        m_overflow_messages.append(move(message));
+        m_has_overflow_messages.store(true, AK::MemoryOrder::memory_order_release);
+    }
+
+    // NOTE: This pairs with the fence in wait_for_messages(). Either we see that the send thread is about to wait, or
+    //       it sees our message before it does.
+    AK::atomic_thread_fence(AK::MemoryOrder::memory_order_seq_cst);
+    if (m_send_thread_is_waiting.load(AK::MemoryOrder::memory_order_relaxed)) {
+        Threading::MutexLocker locker(m_mutex);
+        m_condition.signal();
+    }
+}
+
+Optional<MessageBuffer> SendQueue::dequeue()
+{
+    if (auto message = try_dequeue_taken_overflow_message(); message.has_value())
+        return message;
+
+    // NOTE: Anything a thread put in the ring before it had to resort to the overflow list is visible once we see the
+    //       overflow flag, so by draining the ring first, we keep each thread's messages in order.
+    auto has_overflow_messages = m_has_overflow_messages.load(AK::MemoryOrder::memory_order_acquire);
+    if (auto message = try_dequeue_from_ring(); message.has_value())
+        return message;
+
+    // NOTE: The ring can look empty because a thread has claimed the next slot but not yet filled it. The slots after it
+    //       may hold messages that other threads posted before their overflow messages, so the overflow list has to wait
+    //       until that thread is done. It wakes us up once it is.
+    if (!has_overflow_messages || !ring_is_empty())
+        return {};
+
+    // NOTE: The messages we dequeued last time are only moved-from husks by now.
+    m_taken_overflow_messages.clear_with_capacity();
+    m_dequeued_taken_overflow_message_count = 0;
+    {
+        Threading::MutexLocker locker(m_overflow_mutex);
+        swap(m_taken_overflow_messages, m_overflow_messages);
+        m_has_overflow_messages.store(false, AK::MemoryOrder::memory_order_release);
+    }
+
+    return try_dequeue_taken_overflow_message();
+}
+
+bool SendQueue::wait_for_messages()
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    m_send_thread_is_waiting.store(true, AK::MemoryOrder::memory_order_relaxed);
+    AK::atomic_thread_fence(AK::MemoryOrder::memory_order_seq_cst);
+
+    while (m_running && !has_messages())
+        m_condition.wait();
+
+    m_send_thread_is_waiting.store(false, AK::MemoryOrder::memory_order_relaxed);
+    return m_running;
+}
+
+void SendQueue::stop()
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_running = false;
+    m_condition.signal();
+}
+
+}
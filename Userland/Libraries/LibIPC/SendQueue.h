@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibIPC/Message.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+
+namespace IPC {
+
+// The queue between the threads that post messages on a connection and the connection's send thread.
+//
+// Messages go into a fixed ring of slots that producers claim without taking a lock, so posting a message neither
+// allocates nor contends with the send thread (https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue).
+// Only if the ring is full, i.e. the peer is not keeping up, do messages go into an overflow list, which the send thread
+// drains in order once the ring is empty. That way, posting never blocks, even when the peer is waiting on us.
+class SendQueue : public AtomicRefCounted<SendQueue> {
+public:
+    static constexpr size_t capacity = 32;
+
+    SendQueue();
+    ~SendQueue();
+
+    void enqueue(MessageBuffer&&);
+
+    // Only to be called from the send thread. Returns messages in the order they were posted in on each thread.
+    Optional<MessageBuffer> dequeue();
+
+    // Only to be called from the send thread. Blocks until there are messages, returns false if the queue was stopped.
+    bool wait_for_messages();
+
+    void stop();
+
+private:
+    struct Slot {
+        Atomic<size_t> sequence { 0 };
+        alignas(MessageBuffer) u8 storage[sizeof(MessageBuffer)];
+
+        MessageBuffer& message() { return *reinterpret_cast<MessageBuffer*>(storage); }
+    };
+
+    bool try_enqueue_in_ring(MessageBuffer&);
+    Optional<MessageBuffer> try_dequeue_from_ring();
+    bool ring_has_messages() const;
+    bool ring_is_empty() const;
+    bool has_messages() const;
+    Optional<MessageBuffer> try_dequeue_taken_overflow_message();
+
+    Array<Slot, capacity> m_slots;
+    Atomic<size_t> m_enqueue_position { 0 };
+    size_t m_dequeue_position { 0 };
+
+    Threading::Mutex m_overflow_mutex;
+    Vector<MessageBuffer> m_overflow_messages;
+    Atomic<bool> m_has_overflow_messages { false };
+
+    // Overflow messages that the send thread took, and how many of them it has dequeued.
+    Vector<MessageBuffer> m_taken_overflow_messages;
+    size_t m_dequeued_taken_overflow_message_count { 0 };
+
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_condition { m_mutex };
+    Atomic<bool> m_send_thread_is_waiting { false };
+    bool m_running { true };
+};
+
+}
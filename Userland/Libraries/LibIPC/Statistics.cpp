@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/HashMap.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
+#include <LibCore/File.h>
+#include <LibIPC/Message.h>
+#include <LibIPC/Statistics.h>
+#include <LibThreading/Mutex.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace IPC {
+
+// Round trips are sorted into buckets by the number of bits in their length in microseconds, so bucket N holds those
+// below 2^N µs. The last bucket holds everything longer than that.
+static constexpr size_t round_trip_bucket_count = 24;
+
+struct DurationStatistics {
+    void record(AK::Duration duration)
+    {
+        auto microseconds = duration.to_microseconds();
+        ++count;
+        total_microseconds += microseconds;
+        max_microseconds = max(max_microseconds, microseconds);
+    }
+
+    JsonObject to_json() const
+    {
+        JsonObject object;
+        object.set("count", count);
+        object.set("total_us", total_microseconds);
+        object.set("max_us", max_microseconds);
+        return object;
+    }
+
+    i64 average_microseconds() const { return count == 0 ? 0 : total_microseconds / static_cast<i64>(count); }
+
+    u64 count { 0 };
+    i64 total_microseconds { 0 };
+    i64 max_microseconds { 0 };
+};
+
+struct MessageStatistics {
+    u32 endpoint_magic { 0 };
+    int message_id { 0 };
+    ByteString name;
+
+    u64 sent_count { 0 };
+    u64 sent_bytes { 0 };
+    u64 received_count { 0 };
+    u64 received_bytes { 0 };
+
+    DurationStatistics queueing_delay;
+    DurationStatistics handler_time;
+    DurationStatistics round_trip;
+    Array<u64, round_trip_bucket_count> round_trip_histogram {};
+};
+
+struct StatisticsState {
+    Threading::Mutex mutex;
+    HashMap<u64, MessageStatistics> messages;
+    ByteString trace_file_path;
+};
+
+// NOTE: This is never destroyed, so that messages that are sent or received while the process exits can still be counted.
+static StatisticsState& state()
+{
+    static auto* state = new StatisticsState;
+    return *state;
+}
+
+static MessageStatistics& statistics_for(u32 endpoint_magic, int message_id)
+{
+    auto key = (static_cast<u64>(endpoint_magic) << 32) | static_cast<u32>(message_id);
+    return state().messages.ensure(key, [&] {
+        return MessageStatistics { .endpoint_magic = endpoint_magic, .message_id = message_id };
+    });
+}
+
+static MessageStatistics& statistics_for(Message const& message)
+{
+    auto& statistics = statistics_for(message.endpoint_magic(), message.message_id());
+    if (statistics.name.is_empty())
+        statistics.name = message.message_name();
+    return statistics;
+}
+
+static void write_trace_file()
+{
+    auto path = ByteString::formatted("{}.{}.json", state().trace_file_path, getpid());
+
+    auto file = Core::File::open(path, Core::File::OpenMode::Write);
+    if (file.is_error()) {
+        warnln("Unable to open IPC statistics file {}: {}", path, file.error());
+        return;
+    }
+    if (auto result = file.value()->write_until_depleted(Statistics::to_json()); result.is_error())
+        warnln("Unable to write IPC statistics file {}: {}", path, result.error());
+}
+
+bool Statistics::is_enabled()
+{
+    static bool const is_enabled = [] {
+        auto const* path = getenv("LADYBIRD_IPC_STATISTICS");
+        if (!path)
+            return false;
+
+        if (*path != '\0') {
+            state().trace_file_path = path;
+            atexit(write_trace_file);
+        }
+        return true;
+    }();
+
+    return is_enabled;
+}
+
+void Statistics::record_sent_message(Message const& message, size_t byte_count)
+{
+    Threading::MutexLocker locker(state().mutex);
+    auto& statistics = statistics_for(message);
+    ++statistics.sent_count;
+    statistics.sent_bytes += byte_count;
+}
+
+void Statistics::record_received_message(Message const& message, size_t byte_count)
+{
+    Threading::MutexLocker locker(state().mutex);
+    auto& statistics = statistics_for(message);
+    ++statistics.received_count;
+    statistics.received_bytes += byte_count;
+}
+
+void Statistics::record_handled_message(Message const& message, AK::Duration queueing_delay, AK::Duration handler_time)
+{
+    Threading::MutexLocker locker(state().mutex);
+    auto& statistics = statistics_for(message);
+    statistics.queueing_delay.record(queueing_delay);
+    statistics.handler_time.record(handler_time);
+}
+
+void Statistics::record_round_trip(u32 endpoint_magic, int message_id, AK::Duration duration)
+{
+    auto microseconds = static_cast<u64>(max(duration.to_microseconds(), 0));
+    auto bucket = microseconds == 0 ? 0 : min(count_required_bits(microseconds), round_trip_bucket_count - 1);
+
+    Threading::MutexLocker locker(state().mutex);
+    auto& statistics = statistics_for(endpoint_magic, message_id);
+    statistics.round_trip.record(duration);
+    ++statistics.round_trip_histogram[bucket];
+}
+
+ByteString Statistics::to_json()
+{
+    Threading::MutexLocker locker(state().mutex);
+
+    JsonArray messages;
+    for (auto const& [key, statistics] : state().messages) {
+        JsonObject object;
+        object.set("endpoint_magic", statistics.endpoint_magic);
+        object.set("message_id", statistics.message_id);
+        object.set("name", statistics.name);
+        object.set("sent_count", statistics.sent_count);
+        object.set("sent_bytes", statistics.sent_bytes);
+        object.set("received_count", statistics.received_count);
+        object.set("received_bytes", statistics.received_bytes);
+        object.set("queueing_delay", statistics.queueing_delay.to_json());
+        object.set("handler_time", statistics.handler_time.to_json());
+
+        auto round_trip = statistics.round_trip.to_json();
+        JsonArray histogram;
+        for (auto count : statistics.round_trip_histogram)
+            histogram.must_append(count);
+        round_trip.set("histogram", move(histogram));
+        object.set("round_trip", move(round_trip));
+
+        messages.must_append(move(object));
+    }
+
+    JsonObject root;
+    root.set("pid", getpid());
+    root.set("messages", move(messages));
+    return root.to_byte_string();
+}
+
+void Statistics::dump()
+{
+    if (!is_enabled()) {
+        dbgln("IPC statistics are not being collected, set LADYBIRD_IPC_STATISTICS to enable them");
+        return;
+    }
+
+    Threading::MutexLocker locker(state().mutex);
+
+    Vector<MessageStatistics const*> messages;
+    for (auto const& it : state().messages)
+        messages.append(&it.value);
+    quick_sort(messages, [](auto const* a, auto const* b) {
+        return a->sent_bytes + a->received_bytes > b->sent_bytes + b->received_bytes;
+    });
+
+    dbgln("IPC statistics for process {}:", getpid());
+    for (auto const* statistics : messages) {
+        dbgln("  {} ({:#x}:{}): sent {} ({} bytes), received {} ({} bytes), queued {}us avg / {}us max, handled in {}us avg / {}us max, round trip {}us avg / {}us max",
+            statistics->name.is_empty() ? "(unknown)"sv : statistics->name.view(),
+            statistics->endpoint_magic,
+            statistics->message_id,
+            statistics->sent_count,
+            statistics->sent_bytes,
+            statistics->received_count,
+            statistics->received_bytes,
+            statistics->queueing_delay.average_microseconds(),
+            statistics->queueing_delay.max_microseconds,
+            statistics->handler_time.average_microseconds(),
+            statistics->handler_time.max_microseconds,
+            statistics->round_trip.average_microseconds(),
+            statistics->round_trip.max_microseconds);
+    }
+}
+
+}
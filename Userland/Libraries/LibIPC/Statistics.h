@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Time.h>
+#include <LibIPC/Forward.h>
+
+namespace IPC {
+
+// Counts the messages and bytes that go over this process's IPC connections, per endpoint and message, along with how
+// long received messages wait before they are handled, how long handling them takes, and how long send_sync() waits for
+// responses.
+//
+// Collecting statistics is enabled by setting LADYBIRD_IPC_STATISTICS in the environment. If it is set to a path, each
+// process writes its statistics to "<path>.<pid>.json" when it exits. Either way, they can be dumped at any time with
+// dump(), e.g. through the "dump-ipc-statistics" debug request.
+class Statistics {
+public:
+    static bool is_enabled();
+
+    static void record_sent_message(Message const&, size_t byte_count);
+    static void record_received_message(Message const&, size_t byte_count);
+    static void record_handled_message(Message const&, AK::Duration queueing_delay, AK::Duration handler_time);
+    static void record_round_trip(u32 endpoint_magic, int message_id, AK::Duration);
+
+    static ByteString to_json();
+    static void dump();
+};
+
+}
@@ -9,6 +9,80 @@
 
 namespace ImageDecoderClient {
 
+DecodingSession::DecodingSession(Client& client, i64 image_id)
+    : m_client(client)
+    , m_image_id(image_id)
+{
+    client.m_decoding_sessions.set(image_id, this);
+}
+
+DecodingSession::~DecodingSession()
+{
+    if (!m_client || m_is_finished)
+        return;
+
+    m_client->m_decoding_sessions.remove(m_image_id);
+    if (m_client->is_open())
+        m_client->async_cancel_decoding(m_image_id);
+}
+
+ErrorOr<void> DecodingSession::append(ReadonlyBytes encoded_data)
+{
+    VERIFY(!m_is_finished);
+    if (!m_client || !m_client->is_open() || encoded_data.is_empty())
+        return {};
+
+    m_client->async_append_to_decoding_session(m_image_id, TRY(ByteBuffer::copy(encoded_data)));
+    return {};
+}
+
+NonnullRefPtr<Core::Promise<DecodedImage>> DecodingSession::finish(Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size)
+{
+    VERIFY(!m_is_finished);
+    m_is_finished = true;
+
+    auto promise = Core::Promise<DecodedImage>::construct();
+    if (on_resolved)
+        promise->on_resolution = move(on_resolved);
+    if (on_rejected)
+        promise->on_rejection = move(on_rejected);
+
+    if (!m_client || !m_client->is_open()) {
+        promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
+        return promise;
+    }
+
+    // NOTE: From here on, this is decoded just like any other image.
+    m_client->m_decoding_sessions.remove(m_image_id);
+    m_client->m_pending_decoded_images.set(m_image_id, promise);
+    m_client->async_finish_decoding_session(m_image_id, ideal_size);
+    return promise;
+}
+
+FrameStream::FrameStream(Client& client, i64 image_id, u32 frame_count)
+    : m_client(client)
+    , m_image_id(image_id)
+    , m_frame_count(frame_count)
+{
+    client.m_frame_streams.set(image_id, this);
+}
+
+FrameStream::~FrameStream()
+{
+    if (!m_client)
+        return;
+
+    m_client->m_frame_streams.remove(m_image_id);
+    if (m_client->is_open())
+        m_client->async_release_image(m_image_id);
+}
+
+void FrameStream::request_frames(u32 start_frame_index, u32 frame_count)
+{
+    if (m_client && m_client->is_open())
+        m_client->async_decode_frames(m_image_id, start_frame_index, frame_count);
+}
+
 Client::Client(NonnullOwnPtr<Core::LocalSocket> socket)
     : IPC::ConnectionToServer<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>(*this, move(socket))
 {
@@ -57,7 +131,17 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
     return promise;
 }
 
-void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale)
+RefPtr<DecodingSession> Client::start_decoding_session(Optional<ByteString> mime_type)
+{
+    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::StartDecodingSession>(move(mime_type));
+    if (!response) {
+        dbgln("ImageDecoder disconnected trying to start decoding session");
+        return nullptr;
+    }
+    return adopt_ref(*new DecodingSession(*this, response->image_id()));
+}
+
+void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale, Gfx::IntSize natural_size)
 {
     auto const& bitmaps = bitmap_sequence.bitmaps;
     VERIFY(!bitmaps.is_empty());
@@ -73,6 +157,12 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gf
     image.is_animated = is_animated;
     image.loop_count = loop_count;
     image.scale = scale;
+    image.natural_size = natural_size;
+
+    // NOTE: If we've got fewer frames than the image has, ImageDecoder will keep it around for us until the stream
+    //       goes away, which takes care of releasing it even if we reject the promise below.
+    if (bitmaps.size() < frame_count)
+        image.frame_stream = adopt_ref(*new FrameStream(*this, image_id, frame_count));
     image.frames.ensure_capacity(bitmaps.size());
     for (size_t i = 0; i < bitmaps.size(); ++i) {
         if (!bitmaps[i].has_value()) {
@@ -87,6 +177,41 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gf
     promise->resolve(move(image));
 }
 
+void Client::did_decode_partial_image(i64 image_id, Gfx::BitmapSequence const& bitmap_sequence)
+{
+    auto* session = m_decoding_sessions.get(image_id).value_or(nullptr);
+    if (!session || !session->on_partial_image)
+        return;
+    if (bitmap_sequence.bitmaps.is_empty() || !bitmap_sequence.bitmaps.first().has_value())
+        return;
+
+    // NOTE: The callback may well drop the last reference to the session.
+    NonnullRefPtr protector = *session;
+    session->on_partial_image(*bitmap_sequence.bitmaps.first());
+}
+
+void Client::did_decode_frames(i64 image_id, u32 start_frame_index, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations)
+{
+    auto* stream = m_frame_streams.get(image_id).value_or(nullptr);
+    if (!stream || !stream->on_frames_decoded)
+        return;
+
+    Vector<Frame> frames;
+    frames.ensure_capacity(bitmap_sequence.bitmaps.size());
+    for (size_t i = 0; i < bitmap_sequence.bitmaps.size(); ++i) {
+        // NOTE: We stop at the first frame that failed, so that the frames we hand out are consecutive.
+        if (!bitmap_sequence.bitmaps[i].has_value()) {
+            dbgln("ImageDecoderClient: Invalid bitmap for image {} at index {}", image_id, start_frame_index + i);
+            break;
+        }
+        frames.unchecked_append({ *bitmap_sequence.bitmaps[i], durations[i] });
+    }
+
+    // NOTE: The callback may well drop the last reference to the stream.
+    NonnullRefPtr protector = *stream;
+    stream->on_frames_decoded(start_frame_index, frames);
+}
+
 void Client::did_fail_to_decode_image(i64 image_id, String const& error_message)
 {
     auto maybe_promise = m_pending_decoded_images.take(image_id);
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/WeakPtr.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
 #include <LibCore/Promise.h>
@@ -19,11 +20,63 @@ struct Frame {
     u32 duration { 0 };
 };
 
+class Client;
+
+// The frames of an animated image that ImageDecoder decodes as they are asked for, rather than all at once. The image
+// is released in ImageDecoder when the stream goes away.
+class FrameStream : public RefCounted<FrameStream> {
+public:
+    ~FrameStream();
+
+    u32 frame_count() const { return m_frame_count; }
+
+    // Frames that fail to decode are left out, so on_frames_decoded may be given fewer frames than were requested.
+    void request_frames(u32 start_frame_index, u32 frame_count);
+    Function<void(u32 start_frame_index, Vector<Frame>&)> on_frames_decoded;
+
+private:
+    friend class Client;
+
+    FrameStream(Client&, i64 image_id, u32 frame_count);
+
+    WeakPtr<Client> m_client;
+    i64 m_image_id { 0 };
+    u32 m_frame_count { 0 };
+};
+
 struct DecodedImage {
     bool is_animated { false };
     Gfx::FloatPoint scale { 1, 1 };
     u32 loop_count { 0 };
+
+    // NOTE: The frames may be smaller than this if the image was decoded for an ideal size.
+    Gfx::IntSize natural_size;
+
+    // NOTE: For animated images with many or large frames, this only holds the first few of them, and the stream
+    //       provides the others.
     Vector<Frame> frames;
+    RefPtr<FrameStream> frame_stream;
+};
+
+// An image whose encoded data is handed to ImageDecoder bit by bit as it arrives. Until the session is finished,
+// on_partial_image is called now and then with what ImageDecoder made of the data so far.
+class DecodingSession : public RefCounted<DecodingSession> {
+public:
+    ~DecodingSession();
+
+    ErrorOr<void> append(ReadonlyBytes);
+    NonnullRefPtr<Core::Promise<DecodedImage>> finish(Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {});
+
+    Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image;
+
+private:
+    friend class Client;
+
+    DecodingSession(Client&, i64 image_id);
+
+    WeakPtr<Client> m_client;
+    i64 m_image_id { 0 };
+    bool m_is_finished { false };
 };
 
 class Client final
@@ -36,15 +89,27 @@ public:
 
     NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
 
+    // Returns null if ImageDecoder has gone away.
+    RefPtr<DecodingSession> start_decoding_session(Optional<ByteString> mime_type = {});
+
     Function<void()> on_death;
 
 private:
+    friend class DecodingSession;
+    friend class FrameStream;
+
     virtual void die() override;
 
-    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale) override;
+    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale, Gfx::IntSize natural_size) override;
     virtual void did_fail_to_decode_image(i64 image_id, String const& error_message) override;
+    virtual void did_decode_partial_image(i64 image_id, Gfx::BitmapSequence const& bitmap_sequence) override;
+    virtual void did_decode_frames(i64 image_id, u32 start_frame_index, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations) override;
 
     HashMap<i64, NonnullRefPtr<Core::Promise<DecodedImage>>> m_pending_decoded_images;
+
+    // NOTE: These are weak references! Sessions and streams unregister themselves when they are finished or go away.
+    HashMap<i64, DecodingSession*> m_decoding_sessions;
+    HashMap<i64, FrameStream*> m_frame_streams;
 };
 
 }
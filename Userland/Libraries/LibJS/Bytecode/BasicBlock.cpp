@@ -10,11 +10,6 @@
 
 namespace JS::Bytecode {
 
-NonnullOwnPtr<BasicBlock> BasicBlock::create(u32 index, String name)
-{
-    return adopt_own(*new BasicBlock(index, move(name)));
-}
-
 BasicBlock::BasicBlock(u32 index, String name)
     : m_index(index)
     , m_name(move(name))
@@ -26,7 +26,7 @@ class BasicBlock {
     AK_MAKE_NONCOPYABLE(BasicBlock);
 
 public:
-    static NonnullOwnPtr<BasicBlock> create(u32 index, String name);
+    explicit BasicBlock(u32 index, String name);
     ~BasicBlock();
 
     u32 index() const { return m_index; }
@@ -65,8 +65,6 @@ public:
     void set_last_instruction_start_offset(size_t offset) { m_last_instruction_start_offset = offset; }
 
 private:
-    explicit BasicBlock(u32 index, String name);
-
     u32 m_index { 0 };
     Vector<u8> m_buffer;
     BasicBlock const* m_handler { nullptr };
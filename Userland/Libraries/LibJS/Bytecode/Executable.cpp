@@ -14,6 +14,61 @@ namespace JS::Bytecode {
 
 JS_DEFINE_ALLOCATOR(Executable);
 
+static PropertyLookupCache::Statistics s_property_lookup_cache_statistics;
+
+PropertyLookupCache::Statistics const& PropertyLookupCache::statistics()
+{
+    return s_property_lookup_cache_statistics;
+}
+
+PropertyLookupCache::State PropertyLookupCache::state() const
+{
+    if (is_megamorphic)
+        return State::Megamorphic;
+    size_t number_of_shapes = 0;
+    for (auto const& entry : entries) {
+        if (entry.shape)
+            ++number_of_shapes;
+    }
+    if (number_of_shapes == 0)
+        return State::Uninitialized;
+    if (number_of_shapes == 1)
+        return State::Monomorphic;
+    return State::Polymorphic;
+}
+
+PropertyLookupCache::Entry* PropertyLookupCache::entry_for_shape(Shape const& shape)
+{
+    if (is_megamorphic)
+        return nullptr;
+
+    Entry* empty_entry = nullptr;
+    size_t number_of_shapes = 0;
+    for (auto& entry : entries) {
+        if (entry.shape == &shape)
+            return &entry;
+        if (!entry.shape) {
+            if (!empty_entry)
+                empty_entry = &entry;
+            continue;
+        }
+        ++number_of_shapes;
+    }
+
+    if (empty_entry) {
+        if (number_of_shapes == 0)
+            ++s_property_lookup_cache_statistics.sites_that_became_monomorphic;
+        else if (number_of_shapes == 1)
+            ++s_property_lookup_cache_statistics.sites_that_became_polymorphic;
+        return empty_entry;
+    }
+
+    ++s_property_lookup_cache_statistics.sites_that_became_megamorphic;
+    is_megamorphic = true;
+    entries = {};
+    return nullptr;
+}
+
 Executable::Executable(
     Vector<u8> bytecode,
     NonnullOwnPtr<IdentifierTable> identifier_table,
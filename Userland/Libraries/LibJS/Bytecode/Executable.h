@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -23,13 +24,44 @@
 namespace JS::Bytecode {
 
 struct PropertyLookupCache {
-    WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    };
+
+    enum class State : u8 {
+        Uninitialized,
+        Monomorphic,
+        Polymorphic,
+        Megamorphic,
+    };
+
+    struct Statistics {
+        u64 sites_that_became_monomorphic { 0 };
+        u64 sites_that_became_polymorphic { 0 };
+        u64 sites_that_became_megamorphic { 0 };
+    };
+
+    [[nodiscard]] State state() const;
+
+    // Returns the entry that should be (re)populated for the given shape.
+    // If every entry is already taken by another live shape, the site is switched to the
+    // megamorphic state, where it stops caching altogether, and nullptr is returned.
+    [[nodiscard]] Entry* entry_for_shape(Shape const&);
+
+    [[nodiscard]] static Statistics const& statistics();
+
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+    bool is_megamorphic { false };
 };
 
-struct GlobalVariableCache : public PropertyLookupCache {
+struct GlobalVariableCache {
+    WeakPtr<Shape> shape;
+    Optional<u32> property_offset;
     u64 environment_serial_number { 0 };
     Optional<u32> environment_binding_index;
 };
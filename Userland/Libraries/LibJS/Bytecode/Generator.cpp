@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <AK/QuickSort.h>
 #include <AK/TemporaryChange.h>
 #include <LibJS/AST.h>
@@ -199,6 +200,78 @@ CodeGenerationErrorOr<void> Generator::emit_function_declaration_instantiation(E
     return {};
 }
 
+// If the block consists of nothing but an unconditional jump, returns the index of the block it jumps to.
+static Optional<size_t> jump_only_block_target(BasicBlock const& block)
+{
+    if (!block.is_terminated() || block.size() == 0)
+        return {};
+    auto const& instruction = *reinterpret_cast<Instruction const*>(block.data());
+    if (instruction.type() != Instruction::Type::Jump || instruction.length() != block.size())
+        return {};
+    return static_cast<Op::Jump const&>(instruction).target().basic_block_index();
+}
+
+// Pass: Retarget jumps to blocks that only jump elsewhere at the final destination.
+static size_t thread_jumps(Vector<BasicBlock*>& blocks)
+{
+    size_t threaded_labels = 0;
+    for (auto& block : blocks) {
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) {
+                auto target = label.basic_block_index();
+                // NOTE: We give up after a bounded number of steps, since jump-only blocks may form a cycle (e.g `for (;;) {}`).
+                for (size_t steps = 0; steps < blocks.size(); ++steps) {
+                    auto next_target = jump_only_block_target(*blocks[target]);
+                    if (!next_target.has_value() || *next_target == target)
+                        break;
+                    target = *next_target;
+                }
+                if (target != label.basic_block_index()) {
+                    label = Label { static_cast<u32>(target) };
+                    ++threaded_labels;
+                }
+            });
+            ++it;
+        }
+    }
+    return threaded_labels;
+}
+
+// Pass: Find the blocks that can be reached from the entry block, either through a label or as an exception handler.
+static Vector<bool> find_reachable_blocks(Vector<BasicBlock*>& blocks)
+{
+    Vector<bool> reachable;
+    reachable.resize(blocks.size());
+
+    Vector<size_t> worklist;
+    auto mark_reachable = [&](size_t index) {
+        if (reachable[index])
+            return;
+        reachable[index] = true;
+        worklist.append(index);
+    };
+
+    mark_reachable(0);
+    while (!worklist.is_empty()) {
+        auto& block = *blocks[worklist.take_last()];
+        if (block.handler())
+            mark_reachable(block.handler()->index());
+        if (block.finalizer())
+            mark_reachable(block.finalizer()->index());
+
+        InstructionStreamIterator it(block.instruction_stream());
+        while (!it.at_end()) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                mark_reachable(label.basic_block_index());
+            });
+            ++it;
+        }
+    }
+    return reachable;
+}
+
 CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNode const& node, FunctionKind enclosing_function_kind, GCPtr<ECMAScriptFunctionObject const> function, MustPropagateCompletion must_propagate_completion, Vector<DeprecatedFlyString> local_variable_names)
 {
     Generator generator(vm, function, must_propagate_completion);
@@ -290,6 +363,17 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
     auto number_of_registers = generator.m_next_register;
     auto number_of_constants = generator.m_constants.size();
 
+    auto number_of_threaded_jumps = thread_jumps(generator.m_root_basic_blocks);
+    auto reachable_blocks = find_reachable_blocks(generator.m_root_basic_blocks);
+    if constexpr (JS_BYTECODE_DEBUG) {
+        size_t number_of_unreachable_blocks = 0;
+        for (auto is_reachable : reachable_blocks) {
+            if (!is_reachable)
+                ++number_of_unreachable_blocks;
+        }
+        dbgln("Bytecode::Generator: threaded {} jump(s), skipping {} unreachable block(s) of {}", number_of_threaded_jumps, number_of_unreachable_blocks, generator.m_root_basic_blocks.size());
+    }
+
     // Pass: Rewrite the bytecode to use the correct register and constant indices.
     for (auto& block : generator.m_root_basic_blocks) {
         Bytecode::InstructionStreamIterator it(block->instruction_stream());
@@ -320,6 +404,10 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
         undefined_constant.value().operand().offset_index_by(number_of_registers);
 
     for (auto& block : generator.m_root_basic_blocks) {
+        // OPTIMIZATION: Blocks that can't be reached (e.g. code after a `return`) don't need to be emitted at all.
+        if (!reachable_blocks[block->index()])
+            continue;
+
         basic_block_start_offsets.append(bytecode.size());
         if (block->handler() || block->finalizer()) {
             unlinked_exception_handlers.append({
@@ -330,7 +418,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
             });
         }
 
-        block_offsets.set(block.ptr(), bytecode.size());
+        block_offsets.set(block, bytecode.size());
 
         for (auto& [offset, source_record] : block->source_map()) {
             source_map.set(bytecode.size() + offset, source_record);
@@ -418,7 +506,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
     }
     for (auto label_offset : label_offsets) {
         auto& label = *reinterpret_cast<Label*>(bytecode.data() + label_offset);
-        auto* block = generator.m_root_basic_blocks[label.basic_block_index()].ptr();
+        auto* block = generator.m_root_basic_blocks[label.basic_block_index()];
         label.set_address(block_offsets.get(block).value());
     }
 
@@ -1086,6 +1174,7 @@ void Generator::emit_get_by_id(ScopedOperand dst, ScopedOperand base, Identifier
 void Generator::emit_get_by_id_with_this(ScopedOperand dst, ScopedOperand base, IdentifierTableIndex id, ScopedOperand this_value)
 {
     if (m_identifier_table->get(id) == "length"sv) {
+        m_length_identifier = id;
         emit<Op::GetLengthWithThis>(dst, base, this_value, m_next_property_lookup_cache++);
         return;
     }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/BumpAllocator.h>
 #include <AK/OwnPtr.h>
 #include <AK/SinglyLinkedList.h>
 #include <LibJS/AST.h>
@@ -172,15 +173,16 @@ public:
     {
         if (name.is_empty())
             name = String::number(m_next_block++);
-        auto block = BasicBlock::create(m_root_basic_blocks.size(), name);
+        auto* block = m_basic_block_allocator.allocate(static_cast<u32>(m_root_basic_blocks.size()), name);
+        VERIFY(block);
         if (auto const* context = m_current_unwind_context) {
             if (context->handler().has_value())
                 block->set_handler(*m_root_basic_blocks[context->handler().value().basic_block_index()]);
             if (m_current_unwind_context->finalizer().has_value())
                 block->set_finalizer(*m_root_basic_blocks[context->finalizer().value().basic_block_index()]);
         }
-        m_root_basic_blocks.append(move(block));
-        return *m_root_basic_blocks.last();
+        m_root_basic_blocks.append(block);
+        return *block;
     }
 
     bool is_current_block_terminated() const
@@ -369,7 +371,9 @@ private:
     ASTNode const* m_current_ast_node { nullptr };
     UnwindContext const* m_current_unwind_context { nullptr };
 
-    Vector<NonnullOwnPtr<BasicBlock>> m_root_basic_blocks;
+    // The blocks only live as long as the generator, so they are bump-allocated and released all at once when it is done.
+    UniformBumpAllocator<BasicBlock> m_basic_block_allocator;
+    Vector<BasicBlock*> m_root_basic_blocks;
     NonnullOwnPtr<StringTable> m_string_table;
     NonnullOwnPtr<IdentifierTable> m_identifier_table;
     NonnullOwnPtr<RegexTable> m_regex_table;
@@ -10,9 +10,14 @@ namespace JS::Bytecode {
 
 IdentifierTableIndex IdentifierTable::insert(DeprecatedFlyString string)
 {
+    if (auto existing_index = m_indices.get(string); existing_index.has_value())
+        return *existing_index;
+
+    VERIFY(m_identifiers.size() < NumericLimits<u32>::max());
+    IdentifierTableIndex index { static_cast<u32>(m_identifiers.size()) };
+    m_indices.set(string, index);
     m_identifiers.append(move(string));
-    VERIFY(m_identifiers.size() <= NumericLimits<u32>::max());
-    return { static_cast<u32>(m_identifiers.size() - 1) };
+    return index;
 }
 
 DeprecatedFlyString const& IdentifierTable::get(IdentifierTableIndex index) const
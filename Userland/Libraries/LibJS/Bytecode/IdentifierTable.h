@@ -8,6 +8,7 @@
 
 #include <AK/DeprecatedFlyString.h>
 #include <AK/DistinctNumeric.h>
+#include <AK/HashMap.h>
 #include <AK/Vector.h>
 
 namespace JS::Bytecode {
@@ -31,6 +32,9 @@ public:
 
 private:
     Vector<DeprecatedFlyString> m_identifiers;
+
+    // Since identifiers are interned strings, this is keyed by pointer identity, and makes sure each identifier is only in the table once.
+    HashMap<DeprecatedFlyString, IdentifierTableIndex> m_indices;
 };
 
 }
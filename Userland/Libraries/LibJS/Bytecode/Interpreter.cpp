@@ -332,6 +332,91 @@ Interpreter::HandleExceptionResponse Interpreter::handle_exception(size_t& progr
     VERIFY_NOT_REACHED();
 }
 
+// NOTE: These handle the operands that can't have side effects and can't throw (almost always int32 or double),
+//       and return an empty Optional for anything that has to go through the generic operation.
+//       They are shared between the dispatch loop, where they are inlined, and the out-of-line execute_impl().
+static ALWAYS_INLINE Optional<Value> add_fast_path(Value lhs, Value rhs)
+{
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+    if (lhs.is_int32() && rhs.is_int32() && !Checked<i32>::addition_would_overflow(lhs.as_i32(), rhs.as_i32()))
+        return Value(lhs.as_i32() + rhs.as_i32());
+    return Value(lhs.as_double() + rhs.as_double());
+}
+
+static ALWAYS_INLINE Optional<Value> sub_fast_path(Value lhs, Value rhs)
+{
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+    if (lhs.is_int32() && rhs.is_int32() && !Checked<i32>::subtraction_would_overflow(lhs.as_i32(), rhs.as_i32()))
+        return Value(lhs.as_i32() - rhs.as_i32());
+    return Value(lhs.as_double() - rhs.as_double());
+}
+
+static ALWAYS_INLINE Optional<Value> mul_fast_path(Value lhs, Value rhs)
+{
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+    if (lhs.is_int32() && rhs.is_int32() && !Checked<i32>::multiplication_would_overflow(lhs.as_i32(), rhs.as_i32())) {
+        auto result = lhs.as_i32() * rhs.as_i32();
+        // NOTE: A zero product with a negative operand is -0, which can't be represented as an int32.
+        if (result != 0 || (lhs.as_i32() >= 0 && rhs.as_i32() >= 0))
+            return Value(result);
+    }
+    return Value(lhs.as_double() * rhs.as_double());
+}
+
+static ALWAYS_INLINE Optional<Value> mod_fast_path(Value lhs, Value rhs)
+{
+    // NOTE: With a non-negative dividend and a positive divisor, C++ and JS agree on the result (and its sign).
+    if (lhs.is_int32() && rhs.is_int32() && lhs.as_i32() >= 0 && rhs.as_i32() > 0)
+        return Value(lhs.as_i32() % rhs.as_i32());
+    return {};
+}
+
+#define JS_DEFINE_INT32_BITWISE_FAST_PATH(op_snake_case, int32_operator)                 \
+    static ALWAYS_INLINE Optional<Value> op_snake_case##_fast_path(Value lhs, Value rhs) \
+    {                                                                                    \
+        if (!lhs.is_int32() || !rhs.is_int32())                                          \
+            return {};                                                                   \
+        return Value(lhs.as_i32() int32_operator rhs.as_i32());                          \
+    }
+
+JS_DEFINE_INT32_BITWISE_FAST_PATH(bitwise_and, &)
+JS_DEFINE_INT32_BITWISE_FAST_PATH(bitwise_or, |)
+JS_DEFINE_INT32_BITWISE_FAST_PATH(bitwise_xor, ^)
+#undef JS_DEFINE_INT32_BITWISE_FAST_PATH
+
+#define JS_DEFINE_INT32_SHIFT_FAST_PATH(op_snake_case, shifted_type, shift_operator)      \
+    static ALWAYS_INLINE Optional<Value> op_snake_case##_fast_path(Value lhs, Value rhs)  \
+    {                                                                                     \
+        if (!lhs.is_int32() || !rhs.is_int32())                                           \
+            return {};                                                                    \
+        auto const shift_count = static_cast<u32>(rhs.as_i32()) % 32;                     \
+        return Value(static_cast<shifted_type>(lhs.as_i32()) shift_operator shift_count); \
+    }
+
+JS_DEFINE_INT32_SHIFT_FAST_PATH(left_shift, i32, <<)
+JS_DEFINE_INT32_SHIFT_FAST_PATH(right_shift, i32, >>)
+JS_DEFINE_INT32_SHIFT_FAST_PATH(unsigned_right_shift, u32, >>)
+#undef JS_DEFINE_INT32_SHIFT_FAST_PATH
+
+#define JS_DEFINE_NUMERIC_COMPARISON_FAST_PATH(op_snake_case, numeric_operator)          \
+    static ALWAYS_INLINE Optional<Value> op_snake_case##_fast_path(Value lhs, Value rhs) \
+    {                                                                                    \
+        if (!lhs.is_number() || !rhs.is_number())                                        \
+            return {};                                                                   \
+        if (lhs.is_int32() && rhs.is_int32())                                            \
+            return Value(lhs.as_i32() numeric_operator rhs.as_i32());                    \
+        return Value(lhs.as_double() numeric_operator rhs.as_double());                  \
+    }
+
+JS_DEFINE_NUMERIC_COMPARISON_FAST_PATH(less_than, <)
+JS_DEFINE_NUMERIC_COMPARISON_FAST_PATH(less_than_equals, <=)
+JS_DEFINE_NUMERIC_COMPARISON_FAST_PATH(greater_than, >)
+JS_DEFINE_NUMERIC_COMPARISON_FAST_PATH(greater_than_equals, >=)
+#undef JS_DEFINE_NUMERIC_COMPARISON_FAST_PATH
+
 // FIXME: GCC takes a *long* time to compile with flattening, and it will time out our CI. :|
 #if defined(AK_COMPILER_CLANG)
 #    define FLATTEN_ON_CLANG FLATTEN
@@ -407,6 +492,9 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
         handle_Jump: {
             auto& instruction = *reinterpret_cast<Op::Jump const*>(&bytecode[program_counter]);
+            // NOTE: Every loop goes through here, so this is where the profiler gets to sample code that doesn't call functions.
+            if (auto* sampling_profiler = vm().sampling_profiler()) [[unlikely]]
+                sampling_profiler->take_sample_if_requested();
             program_counter = instruction.target().address();
             goto start;
         }
@@ -563,14 +651,33 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
         DISPATCH_NEXT(name);                                                                \
     }
 
-            HANDLE_INSTRUCTION(Add);
+#define HANDLE_COMMON_BINARY_OP_WITH_FAST_PATH(OpTitleCase, op_snake_case)                                              \
+    handle_##OpTitleCase:                                                                                               \
+    {                                                                                                                   \
+        auto& instruction = *reinterpret_cast<Op::OpTitleCase const*>(&bytecode[program_counter]);                      \
+        auto lhs = get(instruction.lhs());                                                                              \
+        auto rhs = get(instruction.rhs());                                                                              \
+        if (auto result = op_snake_case##_fast_path(lhs, rhs); result.has_value()) {                                    \
+            set(instruction.dst(), result.release_value());                                                             \
+            DISPATCH_NEXT(OpTitleCase);                                                                                 \
+        }                                                                                                               \
+        auto result = op_snake_case(vm(), lhs, rhs);                                                                    \
+        if (result.is_error()) {                                                                                        \
+            if (handle_exception(program_counter, result.error_value()) == HandleExceptionResponse::ExitFromExecutable) \
+                return;                                                                                                 \
+            goto start;                                                                                                 \
+        }                                                                                                               \
+        set(instruction.dst(), result.release_value());                                                                 \
+        DISPATCH_NEXT(OpTitleCase);                                                                                     \
+    }
+
+            JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(HANDLE_COMMON_BINARY_OP_WITH_FAST_PATH)
+#undef HANDLE_COMMON_BINARY_OP_WITH_FAST_PATH
+
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(AddPrivateName);
             HANDLE_INSTRUCTION(ArrayAppend);
             HANDLE_INSTRUCTION(AsyncIteratorClose);
-            HANDLE_INSTRUCTION(BitwiseAnd);
             HANDLE_INSTRUCTION(BitwiseNot);
-            HANDLE_INSTRUCTION(BitwiseOr);
-            HANDLE_INSTRUCTION(BitwiseXor);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(BlockDeclarationInstantiation);
             HANDLE_INSTRUCTION(Call);
             HANDLE_INSTRUCTION(CallWithArgumentArray);
@@ -610,8 +717,6 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION(GetObjectPropertyIterator);
             HANDLE_INSTRUCTION(GetPrivateById);
             HANDLE_INSTRUCTION(GetBinding);
-            HANDLE_INSTRUCTION(GreaterThan);
-            HANDLE_INSTRUCTION(GreaterThanEquals);
             HANDLE_INSTRUCTION(HasPrivateId);
             HANDLE_INSTRUCTION(ImportCall);
             HANDLE_INSTRUCTION(In);
@@ -626,13 +731,8 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(LeaveLexicalEnvironment);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(LeavePrivateEnvironment);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(LeaveUnwindContext);
-            HANDLE_INSTRUCTION(LeftShift);
-            HANDLE_INSTRUCTION(LessThan);
-            HANDLE_INSTRUCTION(LessThanEquals);
             HANDLE_INSTRUCTION(LooselyEquals);
             HANDLE_INSTRUCTION(LooselyInequals);
-            HANDLE_INSTRUCTION(Mod);
-            HANDLE_INSTRUCTION(Mul);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(NewArray);
             HANDLE_INSTRUCTION(NewClass);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(NewFunction);
@@ -652,12 +752,10 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION(ResolveSuperBase);
             HANDLE_INSTRUCTION(ResolveThisBinding);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(RestoreScheduledJump);
-            HANDLE_INSTRUCTION(RightShift);
             HANDLE_INSTRUCTION(SetLexicalBinding);
             HANDLE_INSTRUCTION(SetVariableBinding);
             HANDLE_INSTRUCTION(StrictlyEquals);
             HANDLE_INSTRUCTION(StrictlyInequals);
-            HANDLE_INSTRUCTION(Sub);
             HANDLE_INSTRUCTION(SuperCallWithArgumentArray);
             HANDLE_INSTRUCTION(Throw);
             HANDLE_INSTRUCTION(ThrowIfNotObject);
@@ -667,7 +765,6 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION(TypeofBinding);
             HANDLE_INSTRUCTION(UnaryMinus);
             HANDLE_INSTRUCTION(UnaryPlus);
-            HANDLE_INSTRUCTION(UnsignedRightShift);
 
         handle_Await: {
             auto& instruction = *reinterpret_cast<Op::Await const*>(&bytecode[program_counter]);
@@ -726,10 +823,16 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
     if (reg(Register::this_value()).is_empty())
         reg(Register::this_value()) = running_execution_context.this_value;
 
+    // NOTE: When resuming a suspended generator or async function, its register window still holds the constants
+    //       from when it was last running this executable, so there's no need to copy them in again.
+    bool is_resuming_suspended_frame = entry_point.has_value() && running_execution_context.executable == &executable;
+
     running_execution_context.executable = &executable;
 
-    for (size_t i = 0; i < executable.constants.size(); ++i) {
-        running_execution_context.registers_and_constants_and_locals[executable.number_of_registers + i] = executable.constants[i];
+    if (!is_resuming_suspended_frame) {
+        for (size_t i = 0; i < executable.constants.size(); ++i) {
+            running_execution_context.registers_and_constants_and_locals[executable.number_of_registers + i] = executable.constants[i];
+        }
     }
 
     run_bytecode(entry_point.value_or(0));
@@ -981,26 +1084,20 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
 
     auto& shape = base_obj->shape();
 
-    if (cache.prototype) {
-        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-        bool can_use_cache = [&]() -> bool {
-            if (&shape != cache.shape)
-                return false;
-            if (!cache.prototype_chain_validity)
-                return false;
-            if (!cache.prototype_chain_validity->is_valid())
-                return false;
-            return true;
-        }();
-        if (can_use_cache) {
-            auto value = cache.prototype->get_direct(cache.property_offset.value());
+    for (auto& cache_entry : cache.entries) {
+        if (&shape != cache_entry.shape)
+            continue;
+        if (cache_entry.prototype) {
+            // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+            if (!cache_entry.prototype_chain_validity || !cache_entry.prototype_chain_validity->is_valid())
+                break;
+            auto value = cache_entry.prototype->get_direct(cache_entry.property_offset.value());
             if (value.is_accessor())
                 return TRY(call(vm, value.as_accessor().getter(), this_value));
             return value;
         }
-    } else if (&shape == cache.shape) {
         // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-        auto value = base_obj->get_direct(cache.property_offset.value());
+        auto value = base_obj->get_direct(cache_entry.property_offset.value());
         if (value.is_accessor())
             return TRY(call(vm, value.as_accessor().getter(), this_value));
         return value;
@@ -1010,15 +1107,19 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
     auto value = TRY(base_obj->internal_get(executable.get_identifier(property), this_value, &cacheable_metadata));
 
     if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache = {};
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
+        if (auto* cache_entry = cache.entry_for_shape(shape)) {
+            *cache_entry = {};
+            cache_entry->shape = shape;
+            cache_entry->property_offset = cacheable_metadata.property_offset.value();
+        }
     } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-        cache = {};
-        cache.shape = &base_obj->shape();
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.prototype = *cacheable_metadata.prototype;
-        cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        if (auto* cache_entry = cache.entry_for_shape(base_obj->shape())) {
+            *cache_entry = {};
+            cache_entry->shape = &base_obj->shape();
+            cache_entry->property_offset = cacheable_metadata.property_offset.value();
+            cache_entry->prototype = *cacheable_metadata.prototype;
+            cache_entry->prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        }
     }
 
     return value;
@@ -1187,17 +1288,43 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        if (cache) {
+            for (auto& cache_entry : cache->entries) {
+                if (cache_entry.shape != &object->shape())
+                    continue;
+                if (cache_entry.prototype) {
+                    // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache,
+                    //               we can call the setter we found in it last time directly.
+                    if (!cache_entry.prototype_chain_validity || !cache_entry.prototype_chain_validity->is_valid())
+                        break;
+                    auto accessor = cache_entry.prototype->get_direct(cache_entry.property_offset.value());
+                    if (!accessor.is_accessor() || !accessor.as_accessor().setter())
+                        break;
+                    (void)TRY(call(vm, accessor.as_accessor().setter(), this_value, value));
+                    return {};
+                }
+                object->put_direct(*cache_entry.property_offset, value);
+                return {};
+            }
         }
 
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
         if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+            if (auto* cache_entry = cache->entry_for_shape(object->shape())) {
+                *cache_entry = {};
+                cache_entry->shape = object->shape();
+                cache_entry->property_offset = cacheable_metadata.property_offset.value();
+            }
+        } else if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
+            if (auto* cache_entry = cache->entry_for_shape(object->shape())) {
+                *cache_entry = {};
+                cache_entry->shape = object->shape();
+                cache_entry->property_offset = cacheable_metadata.property_offset.value();
+                cache_entry->prototype = *cacheable_metadata.prototype;
+                cache_entry->prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+            }
         }
 
         if (!succeeded && vm.in_strict_mode()) {
@@ -1422,9 +1549,13 @@ inline Value new_regexp(VM& vm, ParsedRegex const& parsed_regex, ByteString cons
 
     // 3. Return ! RegExpCreate(pattern, flags).
     auto& realm = *vm.current_realm();
-    Regex<ECMA262> regex(parsed_regex.regex, parsed_regex.pattern, parsed_regex.flags);
+    auto regex = vm.regexp_cache().find(pattern, parsed_regex.flags);
+    if (!regex.has_value()) {
+        regex = Regex<ECMA262>(parsed_regex.regex, parsed_regex.pattern, parsed_regex.flags);
+        vm.regexp_cache().did_compile(pattern, parsed_regex.flags, *regex);
+    }
     // NOTE: We bypass RegExpCreate and subsequently RegExpAlloc as an optimization to use the already parsed values.
-    auto regexp_object = RegExpObject::create(realm, move(regex), pattern, flags);
+    auto regexp_object = RegExpObject::create(realm, regex.release_value(), pattern, flags);
     // RegExpAlloc has these two steps from the 'Legacy RegExp features' proposal.
     regexp_object->set_realm(realm);
     // We don't need to check 'If SameValue(newTarget, thisRealm.[[Intrinsics]].[[%RegExp%]]) is true'
@@ -1809,217 +1940,22 @@ JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(JS_DEFINE_EXECUTE_FOR_COMMON_BI
 JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(JS_DEFINE_TO_BYTE_STRING_FOR_COMMON_BINARY_OP)
 JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(JS_DEFINE_TO_BYTE_STRING_FOR_COMMON_BINARY_OP)
 
-ThrowCompletionOr<void> Add::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-
-    if (lhs.is_number() && rhs.is_number()) {
-        if (lhs.is_int32() && rhs.is_int32()) {
-            if (!Checked<i32>::addition_would_overflow(lhs.as_i32(), rhs.as_i32())) {
-                interpreter.set(m_dst, Value(lhs.as_i32() + rhs.as_i32()));
-                return {};
-            }
-        }
-        interpreter.set(m_dst, Value(lhs.as_double() + rhs.as_double()));
-        return {};
-    }
-
-    interpreter.set(m_dst, TRY(add(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> Mul::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-
-    if (lhs.is_number() && rhs.is_number()) {
-        if (lhs.is_int32() && rhs.is_int32()) {
-            if (!Checked<i32>::multiplication_would_overflow(lhs.as_i32(), rhs.as_i32())) {
-                interpreter.set(m_dst, Value(lhs.as_i32() * rhs.as_i32()));
-                return {};
-            }
-        }
-        interpreter.set(m_dst, Value(lhs.as_double() * rhs.as_double()));
-        return {};
-    }
-
-    interpreter.set(m_dst, TRY(mul(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> Sub::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-
-    if (lhs.is_number() && rhs.is_number()) {
-        if (lhs.is_int32() && rhs.is_int32()) {
-            if (!Checked<i32>::subtraction_would_overflow(lhs.as_i32(), rhs.as_i32())) {
-                interpreter.set(m_dst, Value(lhs.as_i32() - rhs.as_i32()));
-                return {};
-            }
-        }
-        interpreter.set(m_dst, Value(lhs.as_double() - rhs.as_double()));
-        return {};
-    }
-
-    interpreter.set(m_dst, TRY(sub(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> BitwiseXor::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-    if (lhs.is_int32() && rhs.is_int32()) {
-        interpreter.set(m_dst, Value(lhs.as_i32() ^ rhs.as_i32()));
-        return {};
-    }
-    interpreter.set(m_dst, TRY(bitwise_xor(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> BitwiseAnd::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-    if (lhs.is_int32() && rhs.is_int32()) {
-        interpreter.set(m_dst, Value(lhs.as_i32() & rhs.as_i32()));
-        return {};
-    }
-    interpreter.set(m_dst, TRY(bitwise_and(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> BitwiseOr::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-    if (lhs.is_int32() && rhs.is_int32()) {
-        interpreter.set(m_dst, Value(lhs.as_i32() | rhs.as_i32()));
-        return {};
-    }
-    interpreter.set(m_dst, TRY(bitwise_or(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> UnsignedRightShift::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-    if (lhs.is_int32() && rhs.is_int32()) {
-        auto const shift_count = static_cast<u32>(rhs.as_i32()) % 32;
-        interpreter.set(m_dst, Value(static_cast<u32>(lhs.as_i32()) >> shift_count));
-        return {};
-    }
-    interpreter.set(m_dst, TRY(unsigned_right_shift(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> RightShift::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-    if (lhs.is_int32() && rhs.is_int32()) {
-        auto const shift_count = static_cast<u32>(rhs.as_i32()) % 32;
-        interpreter.set(m_dst, Value(lhs.as_i32() >> shift_count));
-        return {};
-    }
-    interpreter.set(m_dst, TRY(right_shift(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> LeftShift::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-    if (lhs.is_int32() && rhs.is_int32()) {
-        auto const shift_count = static_cast<u32>(rhs.as_i32()) % 32;
-        interpreter.set(m_dst, Value(lhs.as_i32() << shift_count));
-        return {};
-    }
-    interpreter.set(m_dst, TRY(left_shift(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> LessThan::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-    if (lhs.is_number() && rhs.is_number()) {
-        if (lhs.is_int32() && rhs.is_int32()) {
-            interpreter.set(m_dst, Value(lhs.as_i32() < rhs.as_i32()));
-            return {};
-        }
-        interpreter.set(m_dst, Value(lhs.as_double() < rhs.as_double()));
-        return {};
-    }
-    interpreter.set(m_dst, TRY(less_than(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> LessThanEquals::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-    if (lhs.is_number() && rhs.is_number()) {
-        if (lhs.is_int32() && rhs.is_int32()) {
-            interpreter.set(m_dst, Value(lhs.as_i32() <= rhs.as_i32()));
-            return {};
-        }
-        interpreter.set(m_dst, Value(lhs.as_double() <= rhs.as_double()));
-        return {};
-    }
-    interpreter.set(m_dst, TRY(less_than_equals(vm, lhs, rhs)));
-    return {};
-}
-
-ThrowCompletionOr<void> GreaterThan::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-    if (lhs.is_number() && rhs.is_number()) {
-        if (lhs.is_int32() && rhs.is_int32()) {
-            interpreter.set(m_dst, Value(lhs.as_i32() > rhs.as_i32()));
-            return {};
-        }
-        interpreter.set(m_dst, Value(lhs.as_double() > rhs.as_double()));
-        return {};
+#define JS_DEFINE_EXECUTE_FOR_COMMON_BINARY_OP_WITH_FAST_PATH(OpTitleCase, op_snake_case)       \
+    ThrowCompletionOr<void> OpTitleCase::execute_impl(Bytecode::Interpreter& interpreter) const \
+    {                                                                                           \
+        auto& vm = interpreter.vm();                                                            \
+        auto const lhs = interpreter.get(m_lhs);                                                \
+        auto const rhs = interpreter.get(m_rhs);                                                \
+        if (auto result = op_snake_case##_fast_path(lhs, rhs); result.has_value()) {            \
+            interpreter.set(m_dst, result.release_value());                                     \
+            return {};                                                                          \
+        }                                                                                       \
+        interpreter.set(m_dst, TRY(op_snake_case(vm, lhs, rhs)));                               \
+        return {};                                                                              \
     }
-    interpreter.set(m_dst, TRY(greater_than(vm, lhs, rhs)));
-    return {};
-}
 
-ThrowCompletionOr<void> GreaterThanEquals::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto& vm = interpreter.vm();
-    auto const lhs = interpreter.get(m_lhs);
-    auto const rhs = interpreter.get(m_rhs);
-    if (lhs.is_number() && rhs.is_number()) {
-        if (lhs.is_int32() && rhs.is_int32()) {
-            interpreter.set(m_dst, Value(lhs.as_i32() >= rhs.as_i32()));
-            return {};
-        }
-        interpreter.set(m_dst, Value(lhs.as_double() >= rhs.as_double()));
-        return {};
-    }
-    interpreter.set(m_dst, TRY(greater_than_equals(vm, lhs, rhs)));
-    return {};
-}
+JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(JS_DEFINE_EXECUTE_FOR_COMMON_BINARY_OP_WITH_FAST_PATH)
+#undef JS_DEFINE_EXECUTE_FOR_COMMON_BINARY_OP_WITH_FAST_PATH
 
 static ThrowCompletionOr<Value> not_(VM&, Value value)
 {
@@ -2549,7 +2485,8 @@ ThrowCompletionOr<void> Call::execute_impl(Bytecode::Interpreter& interpreter) c
         return {};
     }
 
-    Vector<Value> argument_values;
+    // NOTE: Most calls pass only a handful of arguments, so we keep them on the stack to avoid a heap allocation per call.
+    Vector<Value, 8> argument_values;
     argument_values.ensure_capacity(m_argument_count);
     for (size_t i = 0; i < m_argument_count; ++i)
         argument_values.unchecked_append(interpreter.get(m_arguments[i]));
@@ -205,8 +205,10 @@ class PropertyAttributes;
 class PropertyDescriptor;
 class PropertyKey;
 class Realm;
+class RegExpCache;
 class Reference;
 class ScopeNode;
+class SamplingProfiler;
 class Script;
 class Shape;
 class Statement;
@@ -274,6 +276,7 @@ namespace Intl {
 JS_ENUMERATE_INTL_OBJECTS
 #undef __JS_ENUMERATE
 
+class FormatterCache;
 class Intl;
 class MathematicalValue;
 
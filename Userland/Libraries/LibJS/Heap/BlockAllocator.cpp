@@ -23,6 +23,11 @@
 namespace JS {
 
 BlockAllocator::~BlockAllocator()
+{
+    release_cached_blocks();
+}
+
+void BlockAllocator::release_cached_blocks()
 {
     for (auto* block : m_blocks) {
         ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
@@ -31,6 +36,7 @@ BlockAllocator::~BlockAllocator()
             VERIFY_NOT_REACHED();
         }
     }
+    m_blocks.clear();
 }
 
 void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
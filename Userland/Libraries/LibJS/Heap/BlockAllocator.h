@@ -19,6 +19,10 @@ public:
     void* allocate_block(char const* name);
     void deallocate_block(void*);
 
+    // Unmaps the blocks that are kept around to be handed out again. Their pages are only given back to the system lazily
+    // otherwise, and keep counting towards our memory usage until it needs them.
+    void release_cached_blocks();
+
 private:
     Vector<void*> m_blocks;
 };
@@ -55,6 +55,10 @@ public:
     State state() const { return m_state; }
     void set_state(State state) { m_state = state; }
 
+    // A cell is young until it has survived its first garbage collection.
+    bool is_young() const { return !m_has_survived_garbage_collection; }
+    void set_has_survived_garbage_collection() { m_has_survived_garbage_collection = true; }
+
     virtual StringView class_name() const = 0;
 
     class Visitor {
@@ -180,6 +184,7 @@ private:
     bool m_mark : 1 { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
     State m_state : 1 { State::Live };
+    bool m_has_survived_garbage_collection : 1 { false };
 };
 
 }
@@ -55,4 +55,12 @@ void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+void CellAllocator::block_did_become_sparse(Badge<Heap>, HeapBlock& block)
+{
+    // NOTE: We always allocate from the end of the usable block list, so moving sparse blocks to the front
+    //       means we fill up denser blocks first. This gives sparse blocks a chance to become completely empty.
+    VERIFY(!block.is_full());
+    m_usable_blocks.prepend(block);
+}
+
 }
@@ -65,6 +65,7 @@ void Heap::will_allocate(size_t size)
     }
 
     m_allocated_bytes_since_last_gc += size;
+    ++m_total_allocated_cells;
 }
 
 static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
@@ -118,14 +119,11 @@ static void for_each_cell_among_possible_pointers(HashTable<HeapBlock*> const& a
 
 class GraphConstructorVisitor final : public Cell::Visitor {
 public:
-    explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
         : m_heap(heap)
+        , m_all_live_heap_blocks(all_live_heap_blocks)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
 
         for (auto& [root, root_origin] : roots) {
             auto& graph_node = m_graph.ensure(bit_cast<FlatPtr>(root));
@@ -157,9 +155,9 @@ public:
 
         for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
             if (m_node_being_visited)
-                m_node_being_visited->edges.set(reinterpret_cast<FlatPtr>(&cell));
+                m_node_being_visited->edges.set(reinterpret_cast<FlatPtr>(cell));
 
-            if (m_graph.get(reinterpret_cast<FlatPtr>(&cell)).has_value())
+            if (m_graph.get(reinterpret_cast<FlatPtr>(cell)).has_value())
                 return;
             m_work_queue.append(*cell);
         });
@@ -171,13 +169,141 @@ public:
             auto cell = m_work_queue.take_last();
             m_node_being_visited = &m_graph.ensure(bit_cast<FlatPtr>(cell.ptr()));
             m_node_being_visited->class_name = cell->class_name();
+            m_node_being_visited->size = HeapBlock::from_cell(cell.ptr())->cell_size();
             cell->visit_edges(*this);
             m_node_being_visited = nullptr;
         }
     }
 
+    // Computes the immediate dominator of every node, and from that the retained size of every node,
+    // i.e. the number of bytes that would be freed if that node became unreachable.
+    // This uses the iterative algorithm from "A Simple, Fast Dominance Algorithm" by Cooper, Harvey and Kennedy,
+    // with a virtual node that has an edge to every root standing in for the root of the graph.
+    void compute_dominators()
+    {
+        static constexpr size_t virtual_root_index = 0;
+        static constexpr size_t undefined_index = NumericLimits<size_t>::max();
+
+        Vector<FlatPtr> addresses;
+        HashMap<FlatPtr, size_t> index_for_address;
+        addresses.ensure_capacity(m_graph.size() + 1);
+        addresses.append(0);
+        for (auto& it : m_graph) {
+            index_for_address.set(it.key, addresses.size());
+            addresses.append(it.key);
+        }
+
+        Vector<Vector<size_t>> successors;
+        successors.resize(addresses.size());
+        Vector<Vector<size_t>> predecessors;
+        predecessors.resize(addresses.size());
+        for (size_t i = 1; i < addresses.size(); ++i) {
+            auto& node = m_graph.find(addresses[i])->value;
+            if (node.root_origin.has_value()) {
+                successors[virtual_root_index].append(i);
+                predecessors[i].append(virtual_root_index);
+            }
+            for (auto edge : node.edges) {
+                auto target = index_for_address.get(edge);
+                if (!target.has_value())
+                    continue;
+                successors[i].append(*target);
+                predecessors[*target].append(i);
+            }
+        }
+
+        // Number the nodes in DFS postorder, without recursion since heap graphs can be very deep.
+        Vector<size_t> postorder_number;
+        postorder_number.resize(addresses.size());
+        Vector<size_t> nodes_in_postorder;
+        nodes_in_postorder.ensure_capacity(addresses.size());
+        {
+            Vector<bool> visited;
+            visited.resize(addresses.size());
+            struct StackEntry {
+                size_t node;
+                size_t next_successor;
+            };
+            Vector<StackEntry> stack;
+            stack.append({ virtual_root_index, 0 });
+            visited[virtual_root_index] = true;
+            while (!stack.is_empty()) {
+                auto node = stack.last().node;
+                auto& next_successor = stack.last().next_successor;
+                if (next_successor < successors[node].size()) {
+                    auto successor = successors[node][next_successor++];
+                    if (!visited[successor]) {
+                        visited[successor] = true;
+                        stack.append({ successor, 0 });
+                    }
+                    continue;
+                }
+                postorder_number[node] = nodes_in_postorder.size();
+                nodes_in_postorder.append(node);
+                stack.take_last();
+            }
+        }
+
+        Vector<size_t> immediate_dominator;
+        immediate_dominator.ensure_capacity(addresses.size());
+        for (size_t i = 0; i < addresses.size(); ++i)
+            immediate_dominator.unchecked_append(undefined_index);
+        immediate_dominator[virtual_root_index] = virtual_root_index;
+
+        auto intersect = [&](size_t a, size_t b) {
+            while (a != b) {
+                while (postorder_number[a] < postorder_number[b])
+                    a = immediate_dominator[a];
+                while (postorder_number[b] < postorder_number[a])
+                    b = immediate_dominator[b];
+            }
+            return a;
+        };
+
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (size_t i = nodes_in_postorder.size(); i-- > 0;) {
+                auto node = nodes_in_postorder[i];
+                if (node == virtual_root_index)
+                    continue;
+                auto new_immediate_dominator = undefined_index;
+                for (auto predecessor : predecessors[node]) {
+                    if (immediate_dominator[predecessor] == undefined_index)
+                        continue;
+                    if (new_immediate_dominator == undefined_index)
+                        new_immediate_dominator = predecessor;
+                    else
+                        new_immediate_dominator = intersect(predecessor, new_immediate_dominator);
+                }
+                if (immediate_dominator[node] != new_immediate_dominator) {
+                    immediate_dominator[node] = new_immediate_dominator;
+                    changed = true;
+                }
+            }
+        }
+
+        // A dominator always finishes after the nodes it dominates, so walking in postorder
+        // sees every node before its immediate dominator.
+        Vector<size_t> retained_size;
+        retained_size.resize(addresses.size());
+        for (size_t i = 1; i < addresses.size(); ++i)
+            retained_size[i] = m_graph.find(addresses[i])->value.size;
+        for (auto node : nodes_in_postorder) {
+            if (node == virtual_root_index)
+                continue;
+            auto dominator = immediate_dominator[node];
+            retained_size[dominator] += retained_size[node];
+            auto& graph_node = m_graph.find(addresses[node])->value;
+            graph_node.retained_size = retained_size[node];
+            if (dominator != virtual_root_index)
+                graph_node.immediate_dominator = addresses[dominator];
+        }
+    }
+
     AK::JsonObject dump()
     {
+        compute_dominators();
+
         auto graph = AK::JsonObject();
         for (auto& it : m_graph) {
             AK::JsonArray edges;
@@ -190,12 +316,18 @@ public:
                 auto type = it.value.root_origin->type;
                 auto location = it.value.root_origin->location;
                 switch (type) {
+                case HeapRoot::Type::HeapFunctionCapturedPointer:
+                    node.set("root"sv, "HeapFunctionCapturedPointer");
+                    break;
                 case HeapRoot::Type::Handle:
                     node.set("root"sv, ByteString::formatted("Handle {} {}:{}", location->function_name(), location->filename(), location->line_number()));
                     break;
                 case HeapRoot::Type::MarkedVector:
                     node.set("root"sv, "MarkedVector");
                     break;
+                case HeapRoot::Type::ConservativeVector:
+                    node.set("root"sv, "ConservativeVector");
+                    break;
                 case HeapRoot::Type::RegisterPointer:
                     node.set("root"sv, "RegisterPointer");
                     break;
@@ -214,6 +346,10 @@ public:
             }
             node.set("class_name"sv, it.value.class_name);
             node.set("edges"sv, edges);
+            node.set("size"sv, it.value.size);
+            node.set("retained_size"sv, it.value.retained_size);
+            if (it.value.immediate_dominator.has_value())
+                node.set("immediate_dominator"sv, ByteString::formatted("{}", *it.value.immediate_dominator));
             graph.set(ByteString::number(it.key), node);
         }
 
@@ -225,6 +361,9 @@ private:
         Optional<HeapRoot> root_origin;
         StringView class_name;
         HashTable<FlatPtr> edges {};
+        size_t size { 0 };
+        size_t retained_size { 0 };
+        Optional<FlatPtr> immediate_dominator;
     };
 
     GraphNode* m_node_being_visited { nullptr };
@@ -232,16 +371,18 @@ private:
     HashMap<FlatPtr, GraphNode> m_graph;
 
     Heap& m_heap;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    HashTable<HeapBlock*> const& m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
 AK::JsonObject Heap::dump_graph()
 {
+    HashTable<HeapBlock*> all_live_heap_blocks;
+    gather_all_live_heap_blocks(all_live_heap_blocks);
     HashMap<Cell*, HeapRoot> roots;
-    gather_roots(roots);
-    GraphConstructorVisitor visitor(*this, roots);
+    gather_roots(roots, all_live_heap_blocks);
+    GraphConstructorVisitor visitor(*this, roots, all_live_heap_blocks);
     visitor.visit_all_cells();
     return visitor.dump();
 }
@@ -260,18 +401,45 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
             m_should_gc_when_deferral_ends = true;
             return;
         }
+        HashTable<HeapBlock*> all_live_heap_blocks;
+        gather_all_live_heap_blocks(all_live_heap_blocks);
         HashMap<Cell*, HeapRoot> roots;
-        gather_roots(roots);
-        mark_live_cells(roots);
+        gather_roots(roots, all_live_heap_blocks);
+        mark_live_cells(roots, all_live_heap_blocks);
     }
     finalize_unmarked_cells();
     sweep_dead_cells(print_report, collection_measurement_timer);
 }
 
-void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
+bool Heap::collect_garbage_if_close_to_threshold()
+{
+    if (m_gc_deferrals || m_collecting_garbage)
+        return false;
+    if (m_allocated_bytes_since_last_gc < m_gc_bytes_threshold / 2)
+        return false;
+    m_allocated_bytes_since_last_gc = 0;
+    collect_garbage();
+    return true;
+}
+
+void Heap::release_free_blocks()
+{
+    for (auto& allocator : m_all_cell_allocators)
+        allocator.block_allocator().release_cached_blocks();
+}
+
+void Heap::gather_all_live_heap_blocks(HashTable<HeapBlock*>& all_live_heap_blocks)
+{
+    for_each_block([&](auto& block) {
+        all_live_heap_blocks.set(&block);
+        return IterationDecision::Continue;
+    });
+}
+
+void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
 {
     vm().gather_roots(roots);
-    gather_conservative_roots(roots);
+    gather_conservative_roots(roots, all_live_heap_blocks);
 
     for (auto& handle : m_handles)
         roots.set(handle.cell(), HeapRoot { .type = HeapRoot::Type::Handle, .location = &handle.source_location() });
@@ -308,7 +476,7 @@ void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, Fl
 }
 #endif
 
-NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot>& roots)
+NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot>& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
 {
     FlatPtr dummy;
 
@@ -353,12 +521,6 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
         }
     }
 
-    HashTable<HeapBlock*> all_live_heap_blocks;
-    for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
-        return IterationDecision::Continue;
-    });
-
     for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
         if (cell->state() == Cell::State::Live) {
             dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
@@ -371,14 +533,11 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
         : m_heap(heap)
+        , m_all_live_heap_blocks(all_live_heap_blocks)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
 
         for (auto* root : roots.keys()) {
             visit(root);
@@ -423,16 +582,16 @@ public:
 private:
     Heap& m_heap;
     Vector<NonnullGCPtr<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    HashTable<HeapBlock*> const& m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
+    MarkingVisitor visitor(*this, roots, all_live_heap_blocks);
 
     visitor.mark_all_live_cells();
 
@@ -465,32 +624,45 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
     Vector<HeapBlock*, 32> full_blocks_that_became_usable;
+    Vector<HeapBlock*, 32> sparse_blocks;
 
     size_t collected_cells = 0;
     size_t live_cells = 0;
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
+    size_t collected_young_cells = 0;
+    size_t surviving_young_cells = 0;
 
     for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
+        size_t live_cells_in_block = 0;
         bool block_was_full = block.is_full();
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
             if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+                if (cell->is_young())
+                    ++collected_young_cells;
                 block.deallocate(cell);
                 ++collected_cells;
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
-                block_has_live_cells = true;
+                if (cell->is_young()) {
+                    ++surviving_young_cells;
+                    cell->set_has_survived_garbage_collection();
+                }
+                ++live_cells_in_block;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
             }
         });
-        if (!block_has_live_cells)
+        if (live_cells_in_block == 0) {
             empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
+            return IterationDecision::Continue;
+        }
+        if (block_was_full != block.is_full())
             full_blocks_that_became_usable.append(&block);
+        if (live_cells_in_block * sparse_block_occupancy_divisor < block.cell_count())
+            sparse_blocks.append(&block);
         return IterationDecision::Continue;
     });
 
@@ -507,6 +679,11 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         block->cell_allocator().block_did_become_usable({}, *block);
     }
 
+    for (auto* block : sparse_blocks) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock sparse @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_did_become_sparse({}, *block);
+    }
+
     if constexpr (HEAP_DEBUG) {
         for_each_block([&](auto& block) {
             dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
@@ -529,6 +706,7 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
         dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        dbgln("    Young cells: {} collected, {} survived", collected_young_cells, surviving_young_cells);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
         dbgln("=============================================");
@@ -64,8 +64,21 @@ public:
     };
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
+
+    // Collects garbage ahead of time if enough has been allocated since the last collection that
+    // one is likely to be triggered soon anyway. Meant to be called by embedders when they are idle,
+    // so that the collection doesn't end up happening in the middle of time-sensitive work.
+    // Returns true if a collection was performed.
+    bool collect_garbage_if_close_to_threshold();
     AK::JsonObject dump_graph();
 
+    // Gives the memory of the heap blocks that garbage collection has emptied back to the system right away. This is for
+    // when memory is short, as it means that new blocks will have to be mapped for the next allocations.
+    void release_free_blocks();
+
+    // The number of cells that have been allocated over the lifetime of the heap, for telling how much a piece of work allocates.
+    u64 total_allocated_cells() const { return m_total_allocated_cells; }
+
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
@@ -113,10 +126,11 @@ private:
     void will_allocate(size_t);
 
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
-    void gather_roots(HashMap<Cell*, HeapRoot>&);
-    void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
+    void gather_all_live_heap_blocks(HashTable<HeapBlock*>&);
+    void gather_roots(HashMap<Cell*, HeapRoot>&, HashTable<HeapBlock*> const& all_live_heap_blocks);
+    void gather_conservative_roots(HashMap<Cell*, HeapRoot>&, HashTable<HeapBlock*> const& all_live_heap_blocks);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells, HashTable<HeapBlock*> const& all_live_heap_blocks);
     void finalize_unmarked_cells();
     void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
 
@@ -141,8 +155,13 @@ private:
     }
 
     static constexpr size_t GC_MIN_BYTES_THRESHOLD { 4 * 1024 * 1024 };
+
+    // Blocks where fewer than 1/N of the cells are live after a collection are allocated from last,
+    // giving their remaining cells a chance to die so the whole block can be returned to the system.
+    static constexpr size_t sparse_block_occupancy_divisor { 4 };
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
+    u64 m_total_allocated_cells { 0 };
 
     bool m_should_collect_on_every_allocation { false };
 
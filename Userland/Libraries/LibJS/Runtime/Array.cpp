@@ -81,8 +81,8 @@ NonnullGCPtr<Array> Array::create_from(Realm& realm, ReadonlySpan<Value> const&
     return array;
 }
 
-Array::Array(Object& prototype)
-    : Object(ConstructWithPrototypeTag::Tag, prototype)
+Array::Array(Object& prototype, MayInterfereWithIndexedPropertyAccess may_interfere_with_indexed_property_access)
+    : Object(ConstructWithPrototypeTag::Tag, prototype, may_interfere_with_indexed_property_access)
 {
     m_has_magical_length_property = true;
 }
@@ -184,38 +184,46 @@ ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object co
     // 1. Let items be a new empty List.
     auto items = MarkedVector<Value> { vm.heap() };
 
-    // 2. Let k be 0.
-    // 3. Repeat, while k < len,
-    for (size_t k = 0; k < length; ++k) {
-        // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_key = PropertyKey { k };
-
-        bool k_read;
-
-        // b. If holes is skip-holes, then
-        if (holes == Holes::SkipHoles) {
-            // i. Let kRead be ? HasProperty(obj, Pk).
-            k_read = TRY(object.has_property(property_key));
+    // OPTIMIZATION: Every index of a packed Array is present and a plain data property, so we can read them directly.
+    if (auto const* storage = packed_array_storage(object, length)) {
+        items.ensure_capacity(length);
+        for (size_t k = 0; k < length; ++k)
+            items.unchecked_append(storage->elements()[k]);
+    } else {
+
+        // 2. Let k be 0.
+        // 3. Repeat, while k < len,
+        for (size_t k = 0; k < length; ++k) {
+            // a. Let Pk be ! ToString(𝔽(k)).
+            auto property_key = PropertyKey { k };
+
+            bool k_read;
+
+            // b. If holes is skip-holes, then
+            if (holes == Holes::SkipHoles) {
+                // i. Let kRead be ? HasProperty(obj, Pk).
+                k_read = TRY(object.has_property(property_key));
+            }
+            // c. Else,
+            else {
+                // i. Assert: holes is read-through-holes.
+                VERIFY(holes == Holes::ReadThroughHoles);
+
+                // ii. Let kRead be true.
+                k_read = true;
+            }
+
+            // d. If kRead is true, then
+            if (k_read) {
+                // i. Let kValue be ? Get(obj, Pk).
+                auto k_value = TRY(object.get(property_key));
+
+                // ii. Append kValue to items.
+                items.append(k_value);
+            }
+
+            // e. Set k to k + 1.
         }
-        // c. Else,
-        else {
-            // i. Assert: holes is read-through-holes.
-            VERIFY(holes == Holes::ReadThroughHoles);
-
-            // ii. Let kRead be true.
-            k_read = true;
-        }
-
-        // d. If kRead is true, then
-        if (k_read) {
-            // i. Let kValue be ? Get(obj, Pk).
-            auto k_value = TRY(object.get(property_key));
-
-            // ii. Append kValue to items.
-            items.append(k_value);
-        }
-
-        // e. Set k to k + 1.
     }
 
     // 4. Sort items using an implementation-defined sequence of calls to SortCompare. If any such call returns an abrupt completion, stop before performing any further calls to SortCompare or steps in this algorithm and return that Completion Record.
@@ -260,6 +268,10 @@ ThrowCompletionOr<double> compare_array_elements(VM& vm, Value x, Value y, Funct
         return value_number.as_double();
     }
 
+    // OPTIMIZATION: Compare the decimal representations of int32s without allocating any strings.
+    if (x.is_int32() && y.is_int32())
+        return compare_int32s_as_strings(x.as_i32(), y.as_i32());
+
     // 5. Let xString be ? ToString(x).
     auto x_string = PrimitiveString::create(vm, TRY(x.to_byte_string(vm)));
 
@@ -284,6 +296,78 @@ ThrowCompletionOr<double> compare_array_elements(VM& vm, Value x, Value y, Funct
     return 0;
 }
 
+// OPTIMIZATION: The following helpers are used by fast paths that access the elements of an Array directly instead of
+//               going through [[HasProperty]], [[Get]], [[Set]] and [[Delete]] for every index.
+
+// Returns the storage of an Array with simple storage, if it doesn't interfere with indexed property access.
+// Every element in simple storage is a plain data property with default attributes, so for indices where an element
+// is present, HasProperty() is true, Get() returns the stored value, and Set() and Delete() can't fail.
+SimpleIndexedPropertyStorage* simple_array_storage(Object& object)
+{
+    return const_cast<SimpleIndexedPropertyStorage*>(simple_array_storage(const_cast<Object const&>(object)));
+}
+
+SimpleIndexedPropertyStorage const* simple_array_storage(Object const& object)
+{
+    if (!object.has_magical_length_property() || object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    return static_cast<SimpleIndexedPropertyStorage const*>(storage);
+}
+
+// Like simple_array_storage(), but only if every index below length is present, so the prototype chain is never consulted.
+SimpleIndexedPropertyStorage const* packed_array_storage(Object const& object, size_t length)
+{
+    auto const* storage = simple_array_storage(object);
+    if (!storage || storage->element_kind() == SimpleIndexedPropertyStorage::ElementKind::Holey || storage->array_like_size() != length)
+        return nullptr;
+    return storage;
+}
+
+// Returns whether setting a new index on an Array can't be observed or intercepted by its prototype chain,
+// i.e. the chain is %Array.prototype% -> %Object.prototype% and neither of them has any indexed properties.
+bool array_prototype_chain_has_no_indexed_properties(Object const& array)
+{
+    auto& intrinsics = array.shape().realm().intrinsics();
+
+    auto const* array_prototype = array.prototype();
+    if (array_prototype != intrinsics.array_prototype().ptr() || !array_prototype->indexed_properties().is_empty())
+        return false;
+
+    auto const* object_prototype = array_prototype->prototype();
+    return object_prototype == intrinsics.object_prototype().ptr() && object_prototype->indexed_properties().is_empty();
+}
+
+static StringView int32_to_decimal_string(i32 value, char (&buffer)[11])
+{
+    // NOTE: This can't overflow, as the magnitude of NumericLimits<i32>::min() fits in a u32.
+    auto magnitude = value < 0 ? 0u - static_cast<u32>(value) : static_cast<u32>(value);
+
+    size_t start = sizeof(buffer);
+    do {
+        buffer[--start] = '0' + (magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0)
+        buffer[--start] = '-';
+
+    return { buffer + start, sizeof(buffer) - start };
+}
+
+// Returns the result of comparing ! ToString(𝔽(x)) with ! ToString(𝔽(y)) as CompareArrayElements would, i.e. by code units.
+int compare_int32s_as_strings(i32 x, i32 y)
+{
+    if (x == y)
+        return 0;
+
+    char x_buffer[11];
+    char y_buffer[11];
+    return int32_to_decimal_string(x, x_buffer).compare(int32_to_decimal_string(y, y_buffer));
+}
+
 // NON-STANDARD: Used to return the value of the ephemeral length property
 ThrowCompletionOr<Optional<PropertyDescriptor>> Array::internal_get_own_property(PropertyKey const& property_key) const
 {
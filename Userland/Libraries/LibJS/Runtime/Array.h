@@ -50,7 +50,7 @@ public:
     [[nodiscard]] bool length_is_writable() const { return m_length_writable; }
 
 protected:
-    explicit Array(Object& prototype);
+    explicit Array(Object& prototype, MayInterfereWithIndexedPropertyAccess = MayInterfereWithIndexedPropertyAccess::No);
 
 private:
     ThrowCompletionOr<bool> set_length(PropertyDescriptor const&);
@@ -58,6 +58,10 @@ private:
     bool m_length_writable { true };
 };
 
+// NOTE: Array is the only kind of object with a magical length property.
+template<>
+inline bool Object::fast_is<Array>() const { return has_magical_length_property(); }
+
 enum class Holes {
     SkipHoles,
     ReadThroughHoles,
@@ -65,5 +69,11 @@ enum class Holes {
 
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
+int compare_int32s_as_strings(i32 x, i32 y);
+
+SimpleIndexedPropertyStorage* simple_array_storage(Object&);
+SimpleIndexedPropertyStorage const* simple_array_storage(Object const&);
+SimpleIndexedPropertyStorage const* packed_array_storage(Object const&, size_t length);
+bool array_prototype_chain_has_no_indexed_properties(Object const&);
 
 }
@@ -27,9 +27,10 @@ NonnullGCPtr<ArrayBuffer> ArrayBuffer::create(Realm& realm, ByteBuffer buffer)
     return realm.heap().allocate<ArrayBuffer>(realm, move(buffer), realm.intrinsics().array_buffer_prototype());
 }
 
-NonnullGCPtr<ArrayBuffer> ArrayBuffer::create(Realm& realm, ByteBuffer* buffer)
+NonnullGCPtr<ArrayBuffer> ArrayBuffer::create(Realm& realm, ByteBuffer* buffer, DataBlock::Shared shared)
 {
-    return realm.heap().allocate<ArrayBuffer>(realm, buffer, realm.intrinsics().array_buffer_prototype());
+    auto prototype = shared == DataBlock::Shared::Yes ? realm.intrinsics().shared_array_buffer_prototype() : realm.intrinsics().array_buffer_prototype();
+    return realm.heap().allocate<ArrayBuffer>(realm, buffer, prototype, shared);
 }
 
 ArrayBuffer::ArrayBuffer(ByteBuffer buffer, Object& prototype)
@@ -39,9 +40,9 @@ ArrayBuffer::ArrayBuffer(ByteBuffer buffer, Object& prototype)
 {
 }
 
-ArrayBuffer::ArrayBuffer(ByteBuffer* buffer, Object& prototype)
+ArrayBuffer::ArrayBuffer(ByteBuffer* buffer, Object& prototype, DataBlock::Shared shared)
     : Object(ConstructWithPrototypeTag::Tag, prototype)
-    , m_data_block(DataBlock { buffer, DataBlock::Shared::No })
+    , m_data_block(DataBlock { buffer, shared })
     , m_detach_key(js_undefined())
 {
 }
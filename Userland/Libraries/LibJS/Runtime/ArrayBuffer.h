@@ -61,7 +61,7 @@ class ArrayBuffer : public Object {
 public:
     static ThrowCompletionOr<NonnullGCPtr<ArrayBuffer>> create(Realm&, size_t);
     static NonnullGCPtr<ArrayBuffer> create(Realm&, ByteBuffer);
-    static NonnullGCPtr<ArrayBuffer> create(Realm&, ByteBuffer*);
+    static NonnullGCPtr<ArrayBuffer> create(Realm&, ByteBuffer*, DataBlock::Shared = DataBlock::Shared::No);
 
     virtual ~ArrayBuffer() override = default;
 
@@ -133,7 +133,7 @@ public:
 
 private:
     ArrayBuffer(ByteBuffer buffer, Object& prototype);
-    ArrayBuffer(ByteBuffer* buffer, Object& prototype);
+    ArrayBuffer(ByteBuffer* buffer, Object& prototype, DataBlock::Shared = DataBlock::Shared::No);
 
     virtual void visit_edges(Visitor&) override;
 
@@ -9,6 +9,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -145,6 +146,21 @@ static ThrowCompletionOr<Object*> array_species_create(VM& vm, Object& original_
     return TRY(construct(vm, constructor.as_function(), Value(length))).ptr();
 }
 
+// Performs HasProperty(O, Pk) and, if that returns true, Get(O, Pk). Returns an empty Optional if the property isn't present.
+static ThrowCompletionOr<Optional<Value>> get_if_present(Object& object, size_t index)
+{
+    // OPTIMIZATION: Read own elements of an Array with simple storage directly, as neither operation can have side effects then.
+    //               Callers must not hold on to the result of this check, since user code may change the array at any point.
+    if (auto const* storage = simple_array_storage(object); storage && index < storage->array_like_size()) {
+        if (auto element = storage->inline_get(static_cast<u32>(index)); element.has_value())
+            return element->value;
+    }
+
+    if (!TRY(object.has_property(index)))
+        return Optional<Value> {};
+    return TRY(object.get(index));
+}
+
 // 23.1.3.1 Array.prototype.at ( index ), https://tc39.es/ecma262/#sec-array.prototype.at
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::at)
 {
@@ -413,23 +429,17 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::filter)
     // 7. Repeat, while k < len,
     for (; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_key = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
-
         // c. If kPresent is true, then
-        if (k_present) {
-            // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(k));
-
+        //     i. Let kValue be ? Get(O, Pk).
+        if (auto k_value = TRY(get_if_present(object, k)); k_value.has_value()) {
             // ii. Let selected be ToBoolean(? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »)).
-            auto selected = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object)).to_boolean();
+            auto selected = TRY(call(vm, callback_function.as_function(), this_arg, *k_value, Value(k), object)).to_boolean();
 
             // iii. If selected is true, then
             if (selected) {
                 // 1. Perform ? CreateDataPropertyOrThrow(A, ! ToString(𝔽(to)), kValue).
-                TRY(array->create_data_property_or_throw(to, k_value));
+                TRY(array->create_data_property_or_throw(to, *k_value));
 
                 // 2. Set to to to + 1.
                 ++to;
@@ -698,18 +708,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_key = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
-
         // c. If kPresent is true, then
-        if (k_present) {
-            // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
-
+        //     i. Let kValue be ? Get(O, Pk).
+        if (auto k_value = TRY(get_if_present(object, k)); k_value.has_value()) {
             // ii. Perform ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
-            TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
+            TRY(call(vm, callback_function.as_function(), this_arg, *k_value, Value(k), object));
         }
 
         // d. Set k to k + 1.
@@ -742,6 +746,17 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // OPTIMIZATION: Every index of a packed Array is present and a plain data property, so we can search them directly.
+    if (auto const* storage = packed_array_storage(this_object, length)) {
+        auto const& elements = storage->elements();
+        for (u64 i = from_index; i < length; ++i) {
+            if (same_value_zero(elements[i], value_to_find))
+                return Value(true);
+        }
+        return Value(false);
+    }
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -795,6 +810,24 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Every index of a packed Array is present and a plain data property, so we can search them directly.
+    if (auto const* storage = packed_array_storage(object, length)) {
+        auto const& elements = storage->elements();
+        if (storage->element_kind() == SimpleIndexedPropertyStorage::ElementKind::PackedInt32 && search_element.is_int32()) {
+            auto value_to_find = search_element.as_i32();
+            for (; k < length; ++k) {
+                if (elements[k].as_i32() == value_to_find)
+                    return Value(k);
+            }
+            return Value(-1);
+        }
+        for (; k < length; ++k) {
+            if (is_strictly_equal(search_element, elements[k]))
+                return Value(k);
+        }
+        return Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -956,21 +989,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
     // 6. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_key = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
-
         // c. If kPresent is true, then
-        if (k_present) {
-            // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
-
+        //     i. Let kValue be ? Get(O, Pk).
+        if (auto k_value = TRY(get_if_present(object, k)); k_value.has_value()) {
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
-            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
+            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, *k_value, Value(k), object));
 
             // iii. Perform ? CreateDataPropertyOrThrow(A, Pk, mappedValue).
-            TRY(array->create_data_property_or_throw(property_key, mapped_value));
+            TRY(array->create_data_property_or_throw(k, mapped_value));
         }
 
         // d. Set k to k + 1.
@@ -990,6 +1017,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::pop)
         return js_undefined();
     }
     auto index = length - 1;
+
+    // OPTIMIZATION: If the last element is present in an Array with simple storage and a writable length,
+    //               taking it out of the storage is equivalent to the Get, Delete and Set below.
+    if (auto* storage = simple_array_storage(this_object); storage && length == storage->array_like_size() && static_cast<Array&>(*this_object).length_is_writable()) {
+        if (storage->inline_has_index(static_cast<u32>(index)))
+            return storage->take_last().value;
+    }
+
     auto element = TRY(this_object->get(index));
     TRY(this_object->delete_property_or_throw(index));
     TRY(this_object->set(vm.names.length, Value(index), Object::ShouldThrowExceptions::Yes));
@@ -1005,6 +1040,20 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
     auto new_length = length + argument_count;
     if (new_length > MAX_ARRAY_LIKE_INDEX)
         return vm.throw_completion<TypeError>(ErrorType::ArrayMaxSize);
+
+    // OPTIMIZATION: Appending to the storage of an extensible Array with a writable length is equivalent to the Sets below,
+    //               as long as nothing on its prototype chain can observe or intercept the new indices being set.
+    if (auto* storage = simple_array_storage(this_object); storage
+        && length == storage->array_like_size()
+        && new_length <= NumericLimits<u32>::max()
+        && static_cast<Array&>(*this_object).length_is_writable()
+        && MUST(this_object->is_extensible())
+        && array_prototype_chain_has_no_indexed_properties(this_object)) {
+        for (size_t i = 0; i < argument_count; ++i)
+            this_object->indexed_properties().append(vm.argument(i));
+        return Value(new_length);
+    }
+
     for (size_t i = 0; i < argument_count; ++i)
         TRY(this_object->set(length + i, vm.argument(i), Object::ShouldThrowExceptions::Yes));
     auto new_length_value = Value(new_length);
@@ -1280,11 +1329,8 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::slice)
     size_t k = actual_start;
 
     while (k < final) {
-        bool present = TRY(this_object->has_property(k));
-        if (present) {
-            auto value = TRY(this_object->get(k));
-            TRY(new_array->create_data_property_or_throw(index, value));
-        }
+        if (auto value = TRY(get_if_present(this_object, k)); value.has_value())
+            TRY(new_array->create_data_property_or_throw(index, *value));
 
         ++k;
         ++index;
@@ -1409,6 +1455,24 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     // 3. Let len be ? LengthOfArrayLike(obj).
     auto length = TRY(length_of_array_like(vm, object));
 
+    // OPTIMIZATION: A packed array of int32s has no holes for the prototype chain to fill in and no accessors,
+    //               so reading the elements can't have side effects. With the default comparator, the order then
+    //               only depends on the elements' decimal representations, and equal representations mean equal
+    //               values, so an unstable sort is indistinguishable from a stable one.
+    if (auto const* storage = packed_array_storage(object, length); storage && comparefn.is_undefined() && storage->element_kind() == SimpleIndexedPropertyStorage::ElementKind::PackedInt32) {
+        Vector<i32> values;
+        values.ensure_capacity(length);
+        for (size_t i = 0; i < length; ++i)
+            values.unchecked_append(storage->elements()[i].as_i32());
+
+        if (values.size() > 1)
+            quick_sort(values, [](i32 x, i32 y) { return compare_int32s_as_strings(x, y) < 0; });
+
+        for (size_t i = 0; i < length; ++i)
+            object->indexed_properties().put(i, Value(values[i]));
+        return object;
+    }
+
     // 4. Let SortCompare be a new Abstract Closure with parameters (x, y) that captures comparefn and performs the following steps when called:
     Function<ThrowCompletionOr<double>(Value, Value)> sort_compare = [&](auto x, auto y) -> ThrowCompletionOr<double> {
         // a. Return ? CompareArrayElements(x, y, comparefn).
@@ -1502,15 +1566,11 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::splice)
     // 14. Repeat, while k < actualDeleteCount,
     for (u64 k = 0; k < actual_delete_count; ++k) {
         // a. Let from be ! ToString(𝔽(actualStart + k)).
-        auto from = PropertyKey { actual_start + k };
-
         // b. If ? HasProperty(O, from) is true, then
-        if (TRY(this_object->has_property(from))) {
-            // i. Let fromValue be ? Get(O, from).
-            auto from_value = TRY(this_object->get(from));
-
+        //     i. Let fromValue be ? Get(O, from).
+        if (auto from_value = TRY(get_if_present(this_object, actual_start + k)); from_value.has_value()) {
             // ii. Perform ? CreateDataPropertyOrThrow(A, ! ToString(𝔽(k)), fromValue).
-            TRY(removed_elements->create_data_property_or_throw(k, from_value));
+            TRY(removed_elements->create_data_property_or_throw(k, *from_value));
         }
 
         // c. Set k to k + 1.
@@ -1519,6 +1579,27 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::splice)
     // 15. Perform ? Set(A, "length", 𝔽(actualDeleteCount), true).
     TRY(removed_elements->set(vm.names.length, Value(actual_delete_count), Object::ShouldThrowExceptions::Yes));
 
+    // OPTIMIZATION: For a packed Array with a writable length, steps 16 to 20 only move elements around, delete the ones at
+    //               the end and update the length, all of which we can do directly on its storage. If it grows, the same
+    //               conditions as for Array.prototype.push() apply to the new indices.
+    auto new_length = initial_length - actual_delete_count + item_count;
+    if (auto const* storage = packed_array_storage(this_object, initial_length); storage
+        && static_cast<Array&>(*this_object).length_is_writable()
+        && (new_length <= initial_length
+            || (new_length <= NumericLimits<u32>::max() && MUST(this_object->is_extensible()) && array_prototype_chain_has_no_indexed_properties(this_object)))) {
+        auto const& elements = storage->elements();
+
+        Vector<Value> new_elements;
+        new_elements.ensure_capacity(new_length);
+        new_elements.unchecked_append(elements.data(), actual_start);
+        for (size_t element_index = 2; element_index < vm.argument_count(); ++element_index)
+            new_elements.unchecked_append(vm.argument(element_index));
+        new_elements.unchecked_append(elements.data() + actual_start + actual_delete_count, initial_length - actual_start - actual_delete_count);
+
+        this_object->set_indexed_property_elements(move(new_elements));
+        return removed_elements;
+    }
+
     // 16. If itemCount < actualDeleteCount, then
     if (item_count < actual_delete_count) {
         // a. Set k to actualStart.
@@ -51,65 +51,69 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
     // 2. Let promise be ? PromiseResolve(%Promise%, value).
     auto* promise_object = TRY(promise_resolve(vm, realm.intrinsics().promise_constructor(), value));
 
-    // 3. Let fulfilledClosure be a new Abstract Closure with parameters (v) that captures asyncContext and performs the
-    //    following steps when called:
-    auto fulfilled_closure = [this](VM& vm) -> ThrowCompletionOr<Value> {
-        auto value = vm.argument(0);
+    // OPTIMIZATION: The closures below only capture asyncContext, which is the same for every await in this async function.
+    //               Since onFulfilled and onRejected are never exposed to user code, we can create them once and reuse them.
+    if (!m_on_fulfilled) {
+        // 3. Let fulfilledClosure be a new Abstract Closure with parameters (v) that captures asyncContext and performs the
+        //    following steps when called:
+        auto fulfilled_closure = [this](VM& vm) -> ThrowCompletionOr<Value> {
+            auto value = vm.argument(0);
 
-        // a. Let prevContext be the running execution context.
-        auto& prev_context = vm.running_execution_context();
+            // a. Let prevContext be the running execution context.
+            auto& prev_context = vm.running_execution_context();
 
-        // FIXME: b. Suspend prevContext.
+            // FIXME: b. Suspend prevContext.
 
-        // c. Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
-        TRY(vm.push_execution_context(*m_suspended_execution_context, {}));
+            // c. Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
+            TRY(vm.push_execution_context(*m_suspended_execution_context, {}));
 
-        // d. Resume the suspended evaluation of asyncContext using NormalCompletion(v) as the result of the operation that
-        //    suspended it.
-        continue_async_execution(vm, value, true);
+            // d. Resume the suspended evaluation of asyncContext using NormalCompletion(v) as the result of the operation that
+            //    suspended it.
+            continue_async_execution(vm, value, true);
 
-        // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack and
-        //    prevContext is the currently running execution context.
-        VERIFY(&vm.running_execution_context() == &prev_context);
+            // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack and
+            //    prevContext is the currently running execution context.
+            VERIFY(&vm.running_execution_context() == &prev_context);
 
-        // f. Return undefined.
-        return js_undefined();
-    };
+            // f. Return undefined.
+            return js_undefined();
+        };
 
-    // 4. Let onFulfilled be CreateBuiltinFunction(fulfilledClosure, 1, "", « »).
-    auto on_fulfilled = NativeFunction::create(realm, move(fulfilled_closure), 1, "");
+        // 4. Let onFulfilled be CreateBuiltinFunction(fulfilledClosure, 1, "", « »).
+        m_on_fulfilled = NativeFunction::create(realm, move(fulfilled_closure), 1, "");
 
-    // 5. Let rejectedClosure be a new Abstract Closure with parameters (reason) that captures asyncContext and performs the
-    //    following steps when called:
-    auto rejected_closure = [this](VM& vm) -> ThrowCompletionOr<Value> {
-        auto reason = vm.argument(0);
+        // 5. Let rejectedClosure be a new Abstract Closure with parameters (reason) that captures asyncContext and performs the
+        //    following steps when called:
+        auto rejected_closure = [this](VM& vm) -> ThrowCompletionOr<Value> {
+            auto reason = vm.argument(0);
 
-        // a. Let prevContext be the running execution context.
-        auto& prev_context = vm.running_execution_context();
+            // a. Let prevContext be the running execution context.
+            auto& prev_context = vm.running_execution_context();
 
-        // FIXME: b. Suspend prevContext.
+            // FIXME: b. Suspend prevContext.
 
-        // c. Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
-        TRY(vm.push_execution_context(*m_suspended_execution_context, {}));
+            // c. Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
+            TRY(vm.push_execution_context(*m_suspended_execution_context, {}));
 
-        // d. Resume the suspended evaluation of asyncContext using ThrowCompletion(reason) as the result of the operation that
-        //    suspended it.
-        continue_async_execution(vm, reason, false);
+            // d. Resume the suspended evaluation of asyncContext using ThrowCompletion(reason) as the result of the operation that
+            //    suspended it.
+            continue_async_execution(vm, reason, false);
 
-        // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack and
-        //    prevContext is the currently running execution context.
-        VERIFY(&vm.running_execution_context() == &prev_context);
+            // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack and
+            //    prevContext is the currently running execution context.
+            VERIFY(&vm.running_execution_context() == &prev_context);
 
-        // f. Return undefined.
-        return js_undefined();
-    };
+            // f. Return undefined.
+            return js_undefined();
+        };
 
-    // 6. Let onRejected be CreateBuiltinFunction(rejectedClosure, 1, "", « »).
-    auto on_rejected = NativeFunction::create(realm, move(rejected_closure), 1, "");
+        // 6. Let onRejected be CreateBuiltinFunction(rejectedClosure, 1, "", « »).
+        m_on_rejected = NativeFunction::create(realm, move(rejected_closure), 1, "");
+    }
 
     // 7. Perform PerformPromiseThen(promise, onFulfilled, onRejected).
     m_current_promise = verify_cast<Promise>(promise_object);
-    m_current_promise->perform_then(on_fulfilled, on_rejected, {});
+    m_current_promise->perform_then(m_on_fulfilled, m_on_rejected, {});
 
     // 8. Remove asyncContext from the execution context stack and restore the execution context that is at the top of the
     //    execution context stack as the running execution context.
@@ -125,21 +129,16 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
 
 void AsyncFunctionDriverWrapper::continue_async_execution(VM& vm, Value value, bool is_successful, IsInitialExecution is_initial_execution)
 {
-    auto generator_result = is_successful
-        ? m_generator_object->resume(vm, value, {})
-        : m_generator_object->resume_abrupt(vm, throw_completion(value), {});
+    auto generator_result = m_generator_object->resume_async_function(vm, is_successful ? normal_completion(value) : throw_completion(value));
 
     auto result = [&, this]() -> ThrowCompletionOr<void> {
         while (true) {
             if (generator_result.is_throw_completion())
                 return generator_result.throw_completion();
 
-            auto result = generator_result.release_value();
-            VERIFY(result.is_object());
-
-            auto promise_value = TRY(result.get(vm, vm.names.value));
+            auto [promise_value, done] = generator_result.release_value();
 
-            if (TRY(result.get(vm, vm.names.done)).to_boolean()) {
+            if (done) {
 
                 // We should not execute anymore, so we are safe to allow ourselves to be GC'd.
                 m_self_handle = {};
@@ -166,7 +165,7 @@ void AsyncFunctionDriverWrapper::continue_async_execution(VM& vm, Value value, b
             // We hit `await Promise`
             auto await_result = this->await(promise_value);
             if (await_result.is_throw_completion()) {
-                generator_result = m_generator_object->resume_abrupt(vm, await_result.release_error(), {});
+                generator_result = m_generator_object->resume_async_function(vm, await_result.release_error());
                 continue;
             }
             return {};
@@ -192,6 +191,8 @@ void AsyncFunctionDriverWrapper::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_top_level_promise);
     if (m_current_promise)
         visitor.visit(m_current_promise);
+    visitor.visit(m_on_fulfilled);
+    visitor.visit(m_on_rejected);
     if (m_suspended_execution_context)
         m_suspended_execution_context->visit_edges(visitor);
 }
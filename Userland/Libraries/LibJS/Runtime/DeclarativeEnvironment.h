@@ -70,6 +70,8 @@ public:
     [[nodiscard]] u64 environment_serial_number() const { return m_environment_serial_number; }
 
 private:
+    static u64 next_environment_serial_number();
+
     ThrowCompletionOr<Value> get_binding_value_direct(VM&, Binding const&) const;
     ThrowCompletionOr<void> set_mutable_binding_direct(VM&, Binding&, Value, bool strict);
 
@@ -129,7 +131,7 @@ private:
     Vector<Binding> m_bindings;
     Vector<DisposableResource> m_disposable_resource_stack;
 
-    u64 m_environment_serial_number { 0 };
+    u64 m_environment_serial_number { next_environment_serial_number() };
 };
 
 inline ThrowCompletionOr<Value> DeclarativeEnvironment::get_binding_value_direct(VM& vm, size_t index) const
@@ -102,6 +102,18 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
         return true;
     });
 
+    m_uses_this = parsing_insights.uses_this;
+    m_uses_this_from_environment = parsing_insights.uses_this_from_environment;
+}
+
+// OPTIMIZATION: Most functions in a typical script are created (e.g. as part of a module or bundle) but never called,
+//               so we don't analyze their declarations until the first time they are called.
+void ECMAScriptFunctionObject::analyze_function_declaration_instantiation()
+{
+    if (m_has_analyzed_function_declaration_instantiation)
+        return;
+    m_has_analyzed_function_declaration_instantiation = true;
+
     // NOTE: The following steps are from FunctionDeclarationInstantiation that could be executed once
     //       and then reused in all subsequent function instantiations.
 
@@ -331,8 +343,107 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
         }));
     }
 
-    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || parsing_insights.uses_this_from_environment || m_contains_direct_call_to_eval;
-    m_uses_this = parsing_insights.uses_this;
+    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || m_uses_this_from_environment || m_contains_direct_call_to_eval;
+
+    analyze_trivial_body();
+}
+
+void ECMAScriptFunctionObject::analyze_trivial_body()
+{
+    if (m_kind != FunctionKind::Normal || m_is_class_constructor || !m_has_simple_parameter_list || m_has_duplicates)
+        return;
+
+    if (!is<FunctionBody>(*m_ecmascript_code))
+        return;
+    auto const& body = static_cast<FunctionBody const&>(*m_ecmascript_code);
+    if (body.children().size() != 1 || !is<ReturnStatement>(*body.children().first()))
+        return;
+    auto const* return_value = static_cast<ReturnStatement const&>(*body.children().first()).argument();
+    if (!return_value)
+        return;
+
+    auto parameter_index_for = [&](Expression const& expression) -> Optional<u32> {
+        if (!expression.is_identifier())
+            return {};
+        auto const& name = static_cast<Identifier const&>(expression).string();
+        for (size_t i = 0; i < m_formal_parameters.size(); ++i) {
+            if (m_formal_parameters[i].binding.get<NonnullRefPtr<Identifier const>>()->string() == name)
+                return static_cast<u32>(i);
+        }
+        return {};
+    };
+
+    if (auto parameter_index = parameter_index_for(*return_value); parameter_index.has_value()) {
+        m_trivial_body_kind = TrivialBodyKind::ReturnParameter;
+        m_trivial_body_parameter_index = *parameter_index;
+        return;
+    }
+
+    if (!return_value->is_member_expression())
+        return;
+    auto const& member_expression = static_cast<MemberExpression const&>(*return_value);
+    if (member_expression.is_computed() || !member_expression.property().is_identifier())
+        return;
+
+    if (is<ThisExpression>(member_expression.object())) {
+        // NOTE: Arrow functions get `this` from their environment, not from the caller.
+        if (m_is_arrow_function)
+            return;
+        m_trivial_body_kind = TrivialBodyKind::ReturnPropertyOfThis;
+    } else if (auto parameter_index = parameter_index_for(member_expression.object()); parameter_index.has_value()) {
+        m_trivial_body_kind = TrivialBodyKind::ReturnPropertyOfParameter;
+        m_trivial_body_parameter_index = *parameter_index;
+    } else {
+        return;
+    }
+
+    m_trivial_body_reads_length = static_cast<Identifier const&>(member_expression.property()).string() == vm().names.length.as_string();
+}
+
+Optional<Value> ECMAScriptFunctionObject::try_evaluate_trivial_body(Value this_argument, ReadonlySpan<Value> arguments_list) const
+{
+    auto argument = [&](size_t index) {
+        return index < arguments_list.size() ? arguments_list[index] : js_undefined();
+    };
+
+    if (m_trivial_body_kind == TrivialBodyKind::ReturnParameter)
+        return argument(m_trivial_body_parameter_index);
+
+    auto base = m_trivial_body_kind == TrivialBodyKind::ReturnPropertyOfThis ? this_argument : argument(m_trivial_body_parameter_index);
+    if (!base.is_object())
+        return {};
+    auto& object = base.as_object();
+
+    // NOTE: This mirrors the fast paths of GetById and GetLength in the bytecode interpreter.
+    if (m_trivial_body_reads_length && object.has_magical_length_property())
+        return Value { object.indexed_properties().array_like_size() };
+
+    // The body's only property lookup is the one we're doing here, so its inline cache tells us where the property lives.
+    // On a cache miss, we let the regular call populate the cache.
+    if (!m_bytecode_executable || m_bytecode_executable->property_lookup_caches.size() != 1)
+        return {};
+
+    auto& shape = object.shape();
+    for (auto const& cache_entry : m_bytecode_executable->property_lookup_caches.first().entries) {
+        if (&shape != cache_entry.shape)
+            continue;
+
+        Value value;
+        if (cache_entry.prototype) {
+            if (!cache_entry.prototype_chain_validity || !cache_entry.prototype_chain_validity->is_valid())
+                return {};
+            value = cache_entry.prototype->get_direct(cache_entry.property_offset.value());
+        } else {
+            value = object.get_direct(cache_entry.property_offset.value());
+        }
+
+        // Getters have to run inside the function's own execution context.
+        if (value.is_accessor())
+            return {};
+        return value;
+    }
+
+    return {};
 }
 
 void ECMAScriptFunctionObject::initialize(Realm& realm)
@@ -382,6 +493,12 @@ ThrowCompletionOr<Value> ECMAScriptFunctionObject::internal_call(Value this_argu
     // 1. Let callerContext be the running execution context.
     // NOTE: No-op, kept by the VM in its execution context stack.
 
+    // OPTIMIZATION: Functions that merely return a parameter or one of its properties can usually skip all of the below.
+    if (m_trivial_body_kind != TrivialBodyKind::None) {
+        if (auto value = try_evaluate_trivial_body(this_argument, arguments_list); value.has_value())
+            return *value;
+    }
+
     auto callee_context = ExecutionContext::create();
 
     // Non-standard
@@ -570,6 +687,8 @@ void ECMAScriptFunctionObject::make_method(Object& home_object)
 // 10.2.1.1 PrepareForOrdinaryCall ( F, newTarget ), https://tc39.es/ecma262/#sec-prepareforordinarycall
 ThrowCompletionOr<void> ECMAScriptFunctionObject::prepare_for_ordinary_call(ExecutionContext& callee_context, Object* new_target)
 {
+    analyze_function_declaration_instantiation();
+
     auto& vm = this->vm();
 
     // Non-standard
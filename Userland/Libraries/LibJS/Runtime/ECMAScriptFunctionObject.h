@@ -114,6 +114,9 @@ private:
     virtual bool is_ecmascript_function_object() const override { return true; }
     virtual void visit_edges(Visitor&) override;
 
+    void analyze_function_declaration_instantiation();
+    void analyze_trivial_body();
+    Optional<Value> try_evaluate_trivial_body(Value this_argument, ReadonlySpan<Value> arguments_list) const;
     ThrowCompletionOr<void> prepare_for_ordinary_call(ExecutionContext& callee_context, Object* new_target);
     void ordinary_call_bind_this(ExecutionContext&, Value this_argument);
 
@@ -165,7 +168,21 @@ private:
     bool m_is_module_wrapper { false };
     bool m_function_environment_needed { false };
     bool m_uses_this { false };
+    bool m_uses_this_from_environment { false };
+    bool m_has_analyzed_function_declaration_instantiation { false };
     Vector<VariableNameToInitialize> m_var_names_to_initialize_binding;
+
+    // Non-standard: Functions whose body is nothing but `return this.foo`, `return parameter.foo` or `return parameter`.
+    // Calls to these can often be answered without setting up an execution context, see try_evaluate_trivial_body().
+    enum class TrivialBodyKind : u8 {
+        None,
+        ReturnParameter,
+        ReturnPropertyOfThis,
+        ReturnPropertyOfParameter,
+    };
+    TrivialBodyKind m_trivial_body_kind { TrivialBodyKind::None };
+    bool m_trivial_body_reads_length { false };
+    u32 m_trivial_body_parameter_index { 0 };
     Vector<DeprecatedFlyString> m_function_names_to_initialize_binding;
 
     size_t m_function_environment_bindings_count { 0 };
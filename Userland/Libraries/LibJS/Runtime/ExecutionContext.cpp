@@ -17,18 +17,40 @@ class ExecutionContextAllocator {
 public:
     NonnullOwnPtr<ExecutionContext> allocate()
     {
+        ExecutionContext* execution_context = nullptr;
         if (m_execution_contexts.is_empty())
-            return adopt_own(*new ExecutionContext);
-        void* slot = m_execution_contexts.take_last();
-        return adopt_own(*new (slot) ExecutionContext);
+            execution_context = new ExecutionContext;
+        else
+            execution_context = new (m_execution_contexts.take_last()) ExecutionContext;
+
+        if (!m_value_buffers.is_empty())
+            execution_context->arguments = m_value_buffers.take_last();
+        if (!m_value_buffers.is_empty())
+            execution_context->registers_and_constants_and_locals = m_value_buffers.take_last();
+        return adopt_own(*execution_context);
     }
+
     void deallocate(void* ptr)
     {
         m_execution_contexts.append(ptr);
     }
 
+    // NOTE: We hold on to the storage of the argument and register vectors of dead execution contexts, so that
+    //       a regular function call doesn't have to allocate new ones. Very large buffers are not kept around.
+    void recycle_value_buffer(Vector<Value>& buffer)
+    {
+        if (buffer.capacity() == 0 || buffer.capacity() > max_recycled_value_buffer_capacity || m_value_buffers.size() >= max_recycled_value_buffer_count)
+            return;
+        buffer.clear_with_capacity();
+        m_value_buffers.append(move(buffer));
+    }
+
 private:
+    static constexpr size_t max_recycled_value_buffer_capacity = 1024;
+    static constexpr size_t max_recycled_value_buffer_count = 256;
+
     Vector<void*> m_execution_contexts;
+    Vector<Vector<Value>> m_value_buffers;
 };
 
 static NeverDestroyed<ExecutionContextAllocator> s_execution_context_allocator;
@@ -49,6 +71,8 @@ ExecutionContext::ExecutionContext()
 
 ExecutionContext::~ExecutionContext()
 {
+    s_execution_context_allocator->recycle_value_buffer(arguments);
+    s_execution_context_allocator->recycle_value_buffer(registers_and_constants_and_locals);
 }
 
 NonnullOwnPtr<ExecutionContext> ExecutionContext::copy() const
@@ -77,6 +77,12 @@ ThrowCompletionOr<GeneratorObject::GeneratorState> GeneratorObject::validate(VM&
 }
 
 ThrowCompletionOr<Value> GeneratorObject::execute(VM& vm, Completion const& completion)
+{
+    auto result = TRY(execute_body(vm, completion));
+    return create_iterator_result_object(vm, result.value, result.done);
+}
+
+ThrowCompletionOr<GeneratorObject::IterationResult> GeneratorObject::execute_body(VM& vm, Completion const& completion)
 {
     // Loosely based on step 4 of https://tc39.es/ecma262/#sec-generatorstart mixed with https://tc39.es/ecma262/#sec-generatoryield at the end.
 
@@ -118,13 +124,13 @@ ThrowCompletionOr<Value> GeneratorObject::execute(VM& vm, Completion const& comp
     if (result_value.is_throw_completion()) {
         // Uncaught exceptions disable the generator.
         m_generator_state = GeneratorState::Completed;
-        return result_value;
+        return result_value.release_error();
     }
     m_previous_value = result_value.release_value();
     bool done = !generated_continuation(m_previous_value).has_value();
 
     m_generator_state = done ? GeneratorState::Completed : GeneratorState::SuspendedYield;
-    return create_iterator_result_object(vm, generated_value(m_previous_value), done);
+    return IterationResult { generated_value(m_previous_value), done };
 }
 
 // 27.5.3.3 GeneratorResume ( generator, value, generatorBrand ), https://tc39.es/ecma262/#sec-generatorresume
@@ -228,4 +234,23 @@ ThrowCompletionOr<Value> GeneratorObject::resume_abrupt(JS::VM& vm, JS::Completi
     return result;
 }
 
+// NOTE: This is GeneratorResume/GeneratorResumeAbrupt for the generator underlying an async function, which is only ever
+//       resumed by its AsyncFunctionDriverWrapper. As the driver immediately takes the iterator result apart again, we
+//       hand it the value and completion state directly instead of allocating a result object for every await.
+ThrowCompletionOr<GeneratorObject::IterationResult> GeneratorObject::resume_async_function(VM& vm, Completion const& completion)
+{
+    VERIFY(m_generator_state == GeneratorState::SuspendedStart || m_generator_state == GeneratorState::SuspendedYield);
+    VERIFY(completion.type() == Completion::Type::Normal || m_generator_state == GeneratorState::SuspendedYield);
+
+    auto const& method_context = vm.running_execution_context();
+
+    TRY(vm.push_execution_context(*m_execution_context, {}));
+    m_generator_state = GeneratorState::Executing;
+
+    auto result = execute_body(vm, completion);
+
+    VERIFY(&vm.running_execution_context() == &method_context);
+    return result;
+}
+
 }
@@ -24,6 +24,12 @@ public:
     ThrowCompletionOr<Value> resume(VM&, Value value, Optional<StringView> const& generator_brand);
     ThrowCompletionOr<Value> resume_abrupt(VM&, JS::Completion abrupt_completion, Optional<StringView> const& generator_brand);
 
+    struct IterationResult {
+        Value value;
+        bool done { false };
+    };
+    ThrowCompletionOr<IterationResult> resume_async_function(VM&, JS::Completion const&);
+
     enum class GeneratorState {
         SuspendedStart,
         SuspendedYield,
@@ -40,6 +46,8 @@ protected:
     virtual ThrowCompletionOr<Value> execute(VM&, JS::Completion const& completion);
 
 private:
+    ThrowCompletionOr<IterationResult> execute_body(VM&, JS::Completion const&);
+
     NonnullOwnPtr<ExecutionContext> m_execution_context;
     GCPtr<ECMAScriptFunctionObject> m_generating_function;
     Value m_previous_value;
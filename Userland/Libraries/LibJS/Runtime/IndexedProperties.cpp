@@ -18,6 +18,8 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto value : m_packed_elements)
+        update_element_kind(value);
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -43,10 +45,41 @@ void SimpleIndexedPropertyStorage::grow_storage_if_needed()
     }
 }
 
+void SimpleIndexedPropertyStorage::update_element_kind(Value value)
+{
+    switch (m_element_kind) {
+    case ElementKind::PackedInt32:
+        if (value.is_int32())
+            return;
+        [[fallthrough]];
+    case ElementKind::PackedNumber:
+        if (value.is_number()) {
+            m_element_kind = ElementKind::PackedNumber;
+            return;
+        }
+        [[fallthrough]];
+    case ElementKind::Packed:
+        if (!value.is_empty()) {
+            m_element_kind = ElementKind::Packed;
+            return;
+        }
+        [[fallthrough]];
+    case ElementKind::Holey:
+        m_element_kind = ElementKind::Holey;
+        return;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttributes attributes)
 {
     VERIFY(attributes == default_attributes);
 
+    // Writing past the end leaves holes between the old end and the new element.
+    if (index > m_array_size)
+        m_element_kind = ElementKind::Holey;
+    update_element_kind(value);
+
     if (index >= m_array_size) {
         m_array_size = index + 1;
         grow_storage_if_needed();
@@ -58,6 +91,7 @@ void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
     m_packed_elements[index] = {};
+    m_element_kind = ElementKind::Holey;
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
@@ -76,6 +110,11 @@ ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size == 0)
+        m_element_kind = ElementKind::PackedInt32;
+    else if (new_size > m_array_size)
+        m_element_kind = ElementKind::Holey;
+
     m_array_size = new_size;
     m_packed_elements.resize_and_keep_capacity(new_size);
     return true;
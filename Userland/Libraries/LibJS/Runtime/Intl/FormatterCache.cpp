@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Runtime/AbstractOperations.h>
+#include <LibJS/Runtime/Date.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/Intl/Collator.h>
+#include <LibJS/Runtime/Intl/CollatorConstructor.h>
+#include <LibJS/Runtime/Intl/DateTimeFormat.h>
+#include <LibJS/Runtime/Intl/FormatterCache.h>
+#include <LibJS/Runtime/Intl/NumberFormat.h>
+#include <LibJS/Runtime/Intl/NumberFormatConstructor.h>
+#include <LibJS/Runtime/Intrinsics.h>
+#include <LibJS/Runtime/Realm.h>
+#include <LibUnicode/Locale.h>
+
+namespace JS::Intl {
+
+static constexpr size_t max_number_of_formatters_to_remember = 16;
+
+GCPtr<Object> FormatterCache::find(Key const& key)
+{
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto const& entry = m_entries[i];
+        if (entry.kind != key.kind || entry.locales != key.locales || entry.default_locale != key.default_locale || entry.time_zone != key.time_zone)
+            continue;
+
+        // Keep the cache ordered from most to least recently used.
+        if (i != 0) {
+            auto moved_entry = m_entries.take(i);
+            m_entries.prepend(move(moved_entry));
+        }
+        return m_entries.first().object;
+    }
+    return {};
+}
+
+void FormatterCache::did_create(Key const& key, NonnullGCPtr<Object> object)
+{
+    if (m_entries.size() == max_number_of_formatters_to_remember)
+        m_entries.take_last();
+    m_entries.prepend({ key.kind, key.locales, MUST(String::from_utf8(key.default_locale)), key.time_zone, object });
+}
+
+void FormatterCache::visit_edges(Cell::Visitor& visitor)
+{
+    for (auto const& entry : m_entries)
+        visitor.visit(entry.object);
+}
+
+// NOTE: Constructing an Intl object with a String or undefined locales and undefined options doesn't call into user
+//       code, so the only inputs to the result are the locales string and the implementation's defaults.
+static Optional<FormatterCache::Key> cache_key_for(FormatterCache::Kind kind, Value locales, Value options)
+{
+    if (!options.is_undefined())
+        return {};
+    if (!locales.is_undefined() && !locales.is_string())
+        return {};
+
+    FormatterCache::Key key { kind, {}, Unicode::default_locale(), {} };
+    if (locales.is_string())
+        key.locales = locales.as_string().utf8_string();
+    return key;
+}
+
+template<typename ObjectType, typename Create>
+static ThrowCompletionOr<NonnullGCPtr<ObjectType>> find_or_create(VM& vm, Optional<FormatterCache::Key> const& key, Create create)
+{
+    auto& cache = vm.current_realm()->intrinsics().intl_formatter_cache();
+
+    if (key.has_value()) {
+        if (auto object = cache.find(*key))
+            return NonnullGCPtr { static_cast<ObjectType&>(*object) };
+    }
+
+    NonnullGCPtr<ObjectType> object = TRY(create());
+    if (key.has_value())
+        cache.did_create(*key, object);
+    return object;
+}
+
+ThrowCompletionOr<NonnullGCPtr<Collator>> implicit_collator(VM& vm, Value locales, Value options)
+{
+    auto& realm = *vm.current_realm();
+    auto key = cache_key_for(FormatterCache::Kind::Collator, locales, options);
+
+    return find_or_create<Collator>(vm, key, [&]() -> ThrowCompletionOr<NonnullGCPtr<Collator>> {
+        auto collator = TRY(construct(vm, realm.intrinsics().intl_collator_constructor(), locales, options));
+        return static_cast<Collator&>(*collator);
+    });
+}
+
+ThrowCompletionOr<NonnullGCPtr<NumberFormat>> implicit_number_format(VM& vm, Value locales, Value options)
+{
+    auto& realm = *vm.current_realm();
+    auto key = cache_key_for(FormatterCache::Kind::NumberFormat, locales, options);
+
+    return find_or_create<NumberFormat>(vm, key, [&]() -> ThrowCompletionOr<NonnullGCPtr<NumberFormat>> {
+        auto number_format = TRY(construct(vm, realm.intrinsics().intl_number_format_constructor(), locales, options));
+        return static_cast<NumberFormat&>(*number_format);
+    });
+}
+
+ThrowCompletionOr<NonnullGCPtr<DateTimeFormat>> implicit_date_time_format(VM& vm, Value locales, Value options, OptionRequired required, OptionDefaults defaults)
+{
+    auto& realm = *vm.current_realm();
+
+    Optional<FormatterCache::Key> key;
+    if (required == OptionRequired::Any && defaults == OptionDefaults::All)
+        key = cache_key_for(FormatterCache::Kind::DateTimeFormatAny, locales, options);
+    else if (required == OptionRequired::Date && defaults == OptionDefaults::Date)
+        key = cache_key_for(FormatterCache::Kind::DateTimeFormatDate, locales, options);
+    else if (required == OptionRequired::Time && defaults == OptionDefaults::Time)
+        key = cache_key_for(FormatterCache::Kind::DateTimeFormatTime, locales, options);
+
+    // NOTE: The default time zone is resolved when the DateTimeFormat is created, and the system time zone may change.
+    if (key.has_value())
+        key->time_zone = system_time_zone_identifier();
+
+    return find_or_create<DateTimeFormat>(vm, key, [&]() {
+        return create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, required, defaults);
+    });
+}
+
+}
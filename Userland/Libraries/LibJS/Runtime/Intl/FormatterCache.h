@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibJS/Runtime/Completion.h>
+#include <LibJS/Runtime/Intl/DateTimeFormatConstructor.h>
+
+namespace JS::Intl {
+
+// Intl objects created on behalf of implicit locale-sensitive calls, such as Number.prototype.toLocaleString or
+// String.prototype.localeCompare, so that calling them over and over again doesn't create a new ICU formatter or
+// collator every time. Only calls whose construction is unobservable (i.e. locales is undefined or a String, and
+// options is undefined) are cached, so a cached object is indistinguishable from a newly constructed one.
+class FormatterCache {
+    AK_MAKE_NONCOPYABLE(FormatterCache);
+    AK_MAKE_NONMOVABLE(FormatterCache);
+
+public:
+    enum class Kind {
+        Collator,
+        NumberFormat,
+        DateTimeFormatAny,
+        DateTimeFormatDate,
+        DateTimeFormatTime,
+    };
+
+    struct Key {
+        Kind kind;
+        Optional<String> locales;
+        StringView default_locale;
+        Optional<String> time_zone;
+    };
+
+    FormatterCache() = default;
+
+    GCPtr<Object> find(Key const&);
+    void did_create(Key const&, NonnullGCPtr<Object>);
+
+    void visit_edges(Cell::Visitor&);
+
+private:
+    struct Entry {
+        Kind kind;
+        Optional<String> locales;
+        String default_locale;
+        Optional<String> time_zone;
+        NonnullGCPtr<Object> object;
+    };
+
+    // Ordered from most to least recently used.
+    Vector<Entry> m_entries;
+};
+
+ThrowCompletionOr<NonnullGCPtr<Collator>> implicit_collator(VM&, Value locales, Value options);
+ThrowCompletionOr<NonnullGCPtr<NumberFormat>> implicit_number_format(VM&, Value locales, Value options);
+ThrowCompletionOr<NonnullGCPtr<DateTimeFormat>> implicit_date_time_format(VM&, Value locales, Value options, OptionRequired, OptionDefaults);
+
+}
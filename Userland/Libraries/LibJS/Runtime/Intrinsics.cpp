@@ -47,6 +47,7 @@
 #include <LibJS/Runtime/Intl/DisplayNamesPrototype.h>
 #include <LibJS/Runtime/Intl/DurationFormatConstructor.h>
 #include <LibJS/Runtime/Intl/DurationFormatPrototype.h>
+#include <LibJS/Runtime/Intl/FormatterCache.h>
 #include <LibJS/Runtime/Intl/Intl.h>
 #include <LibJS/Runtime/Intl/ListFormatConstructor.h>
 #include <LibJS/Runtime/Intl/ListFormatPrototype.h>
@@ -142,6 +143,13 @@ static void initialize_constructor(VM& vm, PropertyKey const& property_key, Obje
         prototype->define_direct_property(vm.names.constructor, &constructor, constructor_property_attributes);
 }
 
+Intrinsics::Intrinsics(Realm& realm)
+    : m_realm(realm)
+{
+}
+
+Intrinsics::~Intrinsics() = default;
+
 // 9.3.2 CreateIntrinsics ( realmRec ), https://tc39.es/ecma262/#sec-createintrinsics
 ThrowCompletionOr<NonnullGCPtr<Intrinsics>> Intrinsics::create(Realm& realm)
 {
@@ -373,6 +381,8 @@ void Intrinsics::visit_edges(Visitor& visitor)
     visitor.visit(m_async_generator_prototype);
     visitor.visit(m_generator_prototype);
     visitor.visit(m_intl_segments_prototype);
+    if (m_intl_formatter_cache)
+        m_intl_formatter_cache->visit_edges(visitor);
     visitor.visit(m_wrap_for_valid_iterator_prototype);
     visitor.visit(m_eval_function);
     visitor.visit(m_is_finite_function);
@@ -422,6 +432,13 @@ void Intrinsics::visit_edges(Visitor& visitor)
 #undef __JS_ENUMERATE
 }
 
+Intl::FormatterCache& Intrinsics::intl_formatter_cache()
+{
+    if (!m_intl_formatter_cache)
+        m_intl_formatter_cache = make<Intl::FormatterCache>();
+    return *m_intl_formatter_cache;
+}
+
 // 10.2.4 AddRestrictedFunctionProperties ( F, realm ), https://tc39.es/ecma262/#sec-addrestrictedfunctionproperties
 void add_restricted_function_properties(FunctionObject& function, Realm& realm)
 {
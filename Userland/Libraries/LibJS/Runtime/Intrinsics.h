@@ -18,6 +18,8 @@ class Intrinsics final : public Cell {
 public:
     static ThrowCompletionOr<NonnullGCPtr<Intrinsics>> create(Realm&);
 
+    virtual ~Intrinsics() override;
+
     NonnullGCPtr<Shape> empty_object_shape() { return *m_empty_object_shape; }
 
     NonnullGCPtr<Shape> new_object_shape() { return *m_new_object_shape; }
@@ -43,6 +45,9 @@ public:
     // Not included in JS_ENUMERATE_INTL_OBJECTS due to missing distinct constructor
     NonnullGCPtr<Object> intl_segments_prototype() { return *m_intl_segments_prototype; }
 
+    // Intl objects created by implicit calls like Number.prototype.toLocaleString, see Intl::FormatterCache.
+    Intl::FormatterCache& intl_formatter_cache();
+
     // Global object functions
     NonnullGCPtr<FunctionObject> eval_function() const { return *m_eval_function; }
     NonnullGCPtr<FunctionObject> is_finite_function() const { return *m_is_finite_function; }
@@ -96,10 +101,7 @@ public:
 #undef __JS_ENUMERATE
 
 private:
-    Intrinsics(Realm& realm)
-        : m_realm(realm)
-    {
-    }
+    explicit Intrinsics(Realm&);
 
     virtual void visit_edges(Visitor&) override;
 
@@ -141,6 +143,8 @@ private:
     // Not included in JS_ENUMERATE_INTL_OBJECTS due to missing distinct constructor
     GCPtr<Object> m_intl_segments_prototype;
 
+    OwnPtr<Intl::FormatterCache> m_intl_formatter_cache;
+
     // Global object functions
     GCPtr<FunctionObject> m_eval_function;
     GCPtr<FunctionObject> m_is_finite_function;
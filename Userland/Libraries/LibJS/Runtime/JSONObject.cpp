@@ -4,11 +4,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/FloatingPointStringConversions.h>
 #include <AK/Function.h>
+#include <AK/GenericLexer.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
 #include <AK/StringBuilder.h>
+#include <AK/TemporaryChange.h>
 #include <AK/TypeCasts.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf8View.h>
@@ -105,6 +108,23 @@ ThrowCompletionOr<Optional<ByteString>> JSONObject::stringify_impl(VM& vm, Value
         state.gap = ByteString::empty();
     }
 
+    // OPTIMIZATION: Trees of plain objects and arrays holding plain data can be serialized directly from their shapes
+    //               and indexed property storage. This never calls into user code, so if we run into anything else
+    //               we can throw away what we have so far and start over with the spec steps.
+    if (!state.replacer_function && !state.property_list.has_value() && state.gap.is_empty() && value.is_object()) {
+        auto& object_prototype = *realm.intrinsics().object_prototype();
+        auto& array_prototype = *realm.intrinsics().array_prototype();
+        auto has_to_json = [&](Object const& prototype) {
+            return prototype.shape().lookup(vm.names.toJSON.to_string_or_symbol()).has_value();
+        };
+        if (!has_to_json(object_prototype) && !has_to_json(array_prototype)) {
+            FastStringifyState fast_state { object_prototype, array_prototype };
+            StringBuilder builder;
+            if (serialize_json_value_without_side_effects(vm, fast_state, value, builder))
+                return builder.to_byte_string();
+        }
+    }
+
     auto wrapper = Object::create(realm, realm.intrinsics().object_prototype());
     MUST(wrapper->create_data_property_or_throw(ByteString::empty(), value));
     return serialize_json_property(vm, state, ByteString::empty(), wrapper);
@@ -350,11 +370,125 @@ ThrowCompletionOr<ByteString> JSONObject::serialize_json_array(VM& vm, Stringify
     return builder.to_byte_string();
 }
 
+// NOTE: Implements SerializeJSONProperty for values that can be serialized without observable side effects, i.e. plain
+//       data, and plain objects and arrays (with the default prototypes and without toJSON) holding only plain data.
+//       Returns false as soon as it runs into anything else, leaving the builder in an unspecified state.
+bool JSONObject::serialize_json_value_without_side_effects(VM& vm, FastStringifyState& state, Value value, StringBuilder& builder)
+{
+    // NOTE: Rather than keeping track of the objects we've seen, we give up on deep trees. That avoids the bookkeeping,
+    //       and leaves reporting cycles to the spec steps.
+    static constexpr size_t max_depth = 128;
+
+    if (value.is_null()) {
+        builder.append("null"sv);
+        return true;
+    }
+    if (value.is_boolean()) {
+        builder.append(value.as_bool() ? "true"sv : "false"sv);
+        return true;
+    }
+    if (value.is_int32()) {
+        builder.appendff("{}", value.as_i32());
+        return true;
+    }
+    if (value.is_number()) {
+        if (value.is_finite_number())
+            builder.append(number_to_byte_string(value.as_double()));
+        else
+            builder.append("null"sv);
+        return true;
+    }
+    if (value.is_string()) {
+        quote_json_string(builder, value.as_string().byte_string());
+        return true;
+    }
+    if (!value.is_object())
+        return false;
+
+    auto& object = value.as_object();
+    if (state.depth >= max_depth || object.may_interfere_with_indexed_property_access())
+        return false;
+    if (object.shape().lookup(vm.names.toJSON.to_string_or_symbol()).has_value())
+        return false;
+
+    auto const* storage = object.indexed_properties().storage();
+    if (storage && !storage->is_simple_storage())
+        return false;
+    auto const* elements = storage ? &static_cast<SimpleIndexedPropertyStorage const*>(storage)->elements() : nullptr;
+    auto element_count = storage ? min(storage->array_like_size(), elements->size()) : 0;
+
+    TemporaryChange depth_change(state.depth, state.depth + 1);
+
+    if (is<Array>(object) && object.shape().prototype() == &state.array_prototype) {
+        if (element_count != object.indexed_properties().array_like_size())
+            return false;
+        builder.append('[');
+        for (size_t i = 0; i < element_count; ++i) {
+            auto element = elements->at(i);
+            if (element.is_empty())
+                return false;
+            if (i != 0)
+                builder.append(',');
+            if (element.is_undefined() || element.is_symbol())
+                builder.append("null"sv);
+            else if (!serialize_json_value_without_side_effects(vm, state, element, builder))
+                return false;
+        }
+        builder.append(']');
+        return true;
+    }
+
+    // NOTE: Other kinds of objects can get %Object.prototype% as their prototype too, through Reflect.construct() or
+    //       Object.setPrototypeOf(). Those may have internal slots or exotic internal methods that only the spec steps
+    //       handle, so we only take plain objects here.
+    if (object.shape().prototype() != &state.object_prototype || object.class_name() != "Object"sv)
+        return false;
+
+    builder.append('{');
+    bool first = true;
+    auto serialize_property = [&](auto const& key, Value property_value) {
+        if (property_value.is_undefined() || property_value.is_symbol())
+            return true;
+        if (!first)
+            builder.append(',');
+        first = false;
+        quote_json_string(builder, key);
+        builder.append(':');
+        return serialize_json_value_without_side_effects(vm, state, property_value, builder);
+    };
+
+    // NOTE: This follows the order of OrdinaryOwnPropertyKeys: first the array indices, then the string keys in order of creation.
+    for (size_t i = 0; i < element_count; ++i) {
+        auto element = elements->at(i);
+        if (element.is_empty())
+            continue;
+        if (!serialize_property(ByteString::number(i), element))
+            return false;
+    }
+    for (auto const& [key, metadata] : object.shape().property_table()) {
+        if (key.is_symbol() || !metadata.attributes.is_enumerable())
+            continue;
+        auto property_value = object.get_direct(metadata.offset);
+        if (property_value.is_empty() || property_value.is_accessor())
+            return false;
+        if (!serialize_property(key.as_string(), property_value))
+            return false;
+    }
+    builder.append('}');
+    return true;
+}
+
 // 25.5.2.2 QuoteJSONString ( value ), https://tc39.es/ecma262/#sec-quotejsonstring
 ByteString JSONObject::quote_json_string(ByteString string)
 {
-    // 1. Let product be the String value consisting solely of the code unit 0x0022 (QUOTATION MARK).
     StringBuilder builder;
+    quote_json_string(builder, string);
+    return builder.to_byte_string();
+}
+
+void JSONObject::quote_json_string(StringBuilder& builder, StringView string)
+{
+    // 1. Let product be the String value consisting solely of the code unit 0x0022 (QUOTATION MARK).
     builder.append('"');
 
     // 2. For each code point C of StringToCodePoints(value), do
@@ -402,9 +536,258 @@ ByteString JSONObject::quote_json_string(ByteString string)
     builder.append('"');
 
     // 4. Return product.
-    return builder.to_byte_string();
 }
 
+// Builds JS values straight from the JSON text, without going through an intermediate AK::JsonValue tree.
+// The accepted grammar is the same as AK::JsonParser's (ECMA-404).
+// NOTE: Objects parsed with the same sequence of keys end up sharing a shape through the regular shape transitions.
+class JSONTextParser final : public GenericLexer {
+public:
+    JSONTextParser(VM& vm, StringView input)
+        : GenericLexer(input)
+        , m_vm(vm)
+        , m_realm(*vm.current_realm())
+    {
+    }
+
+    ThrowCompletionOr<Value> parse()
+    {
+        auto value = TRY(parse_value());
+        ignore_while(is_space);
+        if (!is_eof())
+            return syntax_error();
+        return value;
+    }
+
+private:
+    static constexpr bool is_space(char ch)
+    {
+        return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
+    }
+
+    Completion syntax_error()
+    {
+        return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+    }
+
+    ThrowCompletionOr<Value> parse_value()
+    {
+        ignore_while(is_space);
+        switch (peek()) {
+        case '{':
+            return parse_object();
+        case '[':
+            return parse_array();
+        case '"':
+            return PrimitiveString::create(m_vm, TRY(parse_string()));
+        case '-':
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9':
+            return parse_number();
+        case 't':
+            if (consume_specific("true"sv))
+                return Value(true);
+            break;
+        case 'f':
+            if (consume_specific("false"sv))
+                return Value(false);
+            break;
+        case 'n':
+            if (consume_specific("null"sv))
+                return js_null();
+            break;
+        }
+        return syntax_error();
+    }
+
+    ThrowCompletionOr<Value> parse_object()
+    {
+        if (m_vm.did_reach_stack_space_limit())
+            return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+        auto object = Object::create(m_realm, m_realm.intrinsics().object_prototype());
+        ignore(); // '{'
+        ignore_while(is_space);
+        if (consume_specific('}'))
+            return object;
+
+        for (;;) {
+            ignore_while(is_space);
+            if (peek() != '"')
+                return syntax_error();
+            auto key = TRY(parse_string());
+            ignore_while(is_space);
+            if (!consume_specific(':'))
+                return syntax_error();
+            auto value = TRY(parse_value());
+            object->define_direct_property(key, value, default_attributes);
+            ignore_while(is_space);
+            if (consume_specific('}'))
+                return object;
+            if (!consume_specific(','))
+                return syntax_error();
+        }
+    }
+
+    ThrowCompletionOr<Value> parse_array()
+    {
+        if (m_vm.did_reach_stack_space_limit())
+            return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+        auto array = MUST(Array::create(m_realm, 0));
+        ignore(); // '['
+        ignore_while(is_space);
+        if (consume_specific(']'))
+            return array;
+
+        for (size_t index = 0;; ++index) {
+            auto value = TRY(parse_value());
+            array->define_direct_property(index, value, default_attributes);
+            ignore_while(is_space);
+            if (consume_specific(']'))
+                return array;
+            if (!consume_specific(','))
+                return syntax_error();
+        }
+    }
+
+    // Returns the number of characters from the current position that can be copied into a string as-is.
+    size_t length_of_literal_characters() const
+    {
+        size_t length = 0;
+        for (;;) {
+            auto ch = peek(length);
+            // NOTE: peek() returns '\0' at the end of the input, which is a control character as well.
+            if (ch == '"' || ch == '\\' || is_ascii_c0_control(ch))
+                return length;
+            ++length;
+        }
+    }
+
+    ThrowCompletionOr<ByteString> parse_string()
+    {
+        ignore(); // '"'
+
+        // OPTIMIZATION: Most strings don't contain any escape sequences, so we can take them straight from the input.
+        auto length = length_of_literal_characters();
+        if (peek(length) == '"') {
+            auto string = consume(length);
+            ignore(); // '"'
+            return ByteString { string };
+        }
+
+        StringBuilder builder;
+        for (;;) {
+            builder.append(consume(length));
+            // NOTE: We use peek() and ignore() rather than consume(), since we might have reached the end of the input.
+            auto ch = peek();
+            ignore();
+            if (ch == '"')
+                return builder.to_byte_string();
+            if (ch != '\\')
+                return syntax_error();
+
+            ch = peek();
+            ignore();
+            switch (ch) {
+            case '"':
+            case '\\':
+            case '/':
+                builder.append(ch);
+                break;
+            case 'b':
+                builder.append('\b');
+                break;
+            case 'f':
+                builder.append('\f');
+                break;
+            case 'n':
+                builder.append('\n');
+                break;
+            case 'r':
+                builder.append('\r');
+                break;
+            case 't':
+                builder.append('\t');
+                break;
+            case 'u': {
+                auto code_point = decode_single_or_paired_surrogate();
+                if (code_point.is_error())
+                    return syntax_error();
+                builder.append_code_point(code_point.value());
+                break;
+            }
+            default:
+                return syntax_error();
+            }
+
+            length = length_of_literal_characters();
+        }
+    }
+
+    ThrowCompletionOr<Value> parse_number()
+    {
+        auto start = tell();
+
+        bool negative = consume_specific('-');
+        if (!is_ascii_digit(peek()))
+            return syntax_error();
+
+        // OPTIMIZATION: Integers that fit in a double's mantissa are accumulated directly, everything else goes
+        //               through the (correctly rounding) floating point parser.
+        constexpr size_t max_exactly_representable_digits = 15;
+        u64 integer = 0;
+        size_t digits = 0;
+        if (consume_specific('0')) {
+            if (is_ascii_digit(peek()))
+                return syntax_error();
+            digits = 1;
+        } else {
+            for (; is_ascii_digit(peek()); ++digits)
+                integer = integer * 10 + (consume() - '0');
+        }
+
+        bool is_integer = true;
+        if (consume_specific('.')) {
+            if (!is_ascii_digit(peek()))
+                return syntax_error();
+            ignore_while(is_ascii_digit);
+            is_integer = false;
+        }
+        if (consume_specific('e') || consume_specific('E')) {
+            if (!consume_specific('+'))
+                consume_specific('-');
+            if (!is_ascii_digit(peek()))
+                return syntax_error();
+            ignore_while(is_ascii_digit);
+            is_integer = false;
+        }
+
+        if (is_integer && digits <= max_exactly_representable_digits) {
+            auto value = static_cast<double>(integer);
+            return Value(negative ? -value : value);
+        }
+
+        auto number = input().substring_view(start, tell() - start);
+        auto const* characters = number.characters_without_null_termination();
+        auto result = parse_first_floating_point<double>(characters, characters + number.length());
+        if (!result.parsed_value())
+            return syntax_error();
+        return Value(result.value);
+    }
+
+    VM& m_vm;
+    Realm& m_realm;
+};
+
 // 25.5.1 JSON.parse ( text [ , reviver ] ), https://tc39.es/ecma262/#sec-json.parse
 JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
 {
@@ -413,10 +796,7 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
     auto string = TRY(vm.argument(0).to_byte_string(vm));
     auto reviver = vm.argument(1);
 
-    auto json = JsonValue::from_string(string);
-    if (json.is_error())
-        return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
-    Value unfiltered = parse_json_value(vm, json.value());
+    auto unfiltered = TRY(JSONTextParser(vm, string).parse());
     if (reviver.is_function()) {
         auto root = Object::create(realm, realm.intrinsics().object_prototype());
         auto root_name = ByteString::empty();
@@ -40,6 +40,14 @@ private:
     static ThrowCompletionOr<ByteString> serialize_json_object(VM&, StringifyState&, Object&);
     static ThrowCompletionOr<ByteString> serialize_json_array(VM&, StringifyState&, Object&);
     static ByteString quote_json_string(ByteString);
+    static void quote_json_string(StringBuilder&, StringView);
+
+    struct FastStringifyState {
+        Object const& object_prototype;
+        Object const& array_prototype;
+        size_t depth { 0 };
+    };
+    static bool serialize_json_value_without_side_effects(VM&, FastStringifyState&, Value, StringBuilder&);
 
     // Parse helpers
     static Object* parse_json_object(VM&, JsonObject const&);
@@ -23,71 +23,120 @@ Map::Map(Object& prototype)
 // 24.1.3.1 Map.prototype.clear ( ), https://tc39.es/ecma262/#sec-map.prototype.clear
 void Map::map_clear()
 {
-    m_keys.clear();
     m_entries.clear();
+    m_positions.clear();
+    m_removed_entry_count = 0;
 }
 
+// Once this many entries have been removed (and they make up at least half of all entries), we compact the entries.
+static constexpr size_t minimum_removed_entry_count_for_compaction = 16;
+
 // 24.1.3.3 Map.prototype.delete ( key ), https://tc39.es/ecma262/#sec-map.prototype.delete
 bool Map::map_remove(Value const& key)
 {
-    Optional<size_t> index;
-
-    for (auto it = m_keys.begin(); !it.is_end(); ++it) {
-        if (ValueTraits::equals(*it, key)) {
-            index = it.key();
-            break;
-        }
-    }
-
-    if (!index.has_value())
+    auto it = m_positions.find(key);
+    if (it == m_positions.end())
         return false;
 
-    m_keys.remove(*index);
-    m_entries.remove(key);
+    auto& entry = m_entries[it->value];
+    entry.key = {};
+    entry.value = {};
+    m_positions.remove(it);
+    ++m_removed_entry_count;
+
+    if (m_removed_entry_count >= minimum_removed_entry_count_for_compaction && m_removed_entry_count * 2 >= m_entries.size())
+        compact_entries();
     return true;
 }
 
 // 24.1.3.6 Map.prototype.get ( key ), https://tc39.es/ecma262/#sec-map.prototype.get
 Optional<Value> Map::map_get(Value const& key) const
 {
-    if (auto it = m_entries.find(key); it != m_entries.end())
-        return it->value;
+    if (auto it = m_positions.find(key); it != m_positions.end())
+        return m_entries[it->value].value;
     return {};
 }
 
 // 24.1.3.7 Map.prototype.has ( key ), https://tc39.es/ecma262/#sec-map.prototype.has
 bool Map::map_has(Value const& key) const
 {
-    return m_entries.contains(key);
+    return m_positions.contains(key);
 }
 
 // 24.1.3.9 Map.prototype.set ( key, value ), https://tc39.es/ecma262/#sec-map.prototype.set
 void Map::map_set(Value const& key, Value value)
 {
-    auto it = m_entries.find(key);
-    if (it != m_entries.end()) {
-        it->value = value;
+    auto it = m_positions.find(key);
+    if (it != m_positions.end()) {
+        m_entries[it->value].value = value;
     } else {
-        auto index = m_next_insertion_id++;
-        m_keys.insert(index, key);
-        m_entries.set(key, value);
+        m_positions.set(key, m_entries.size());
+        m_entries.append({ m_next_insertion_id++, key, value });
     }
 }
 
 size_t Map::map_size() const
 {
-    return m_keys.size();
+    return m_positions.size();
+}
+
+Optional<size_t> Map::find_position_of_next_entry(size_t insertion_id, size_t position_hint) const
+{
+    // The entries are sorted by insertion ID, so we're looking for the first one not below the given ID.
+    // While iterating, that's almost always going to be the one at the hinted position.
+    auto is_first_entry_not_below = [&](size_t position) {
+        return position <= m_entries.size()
+            && (position == 0 || m_entries[position - 1].insertion_id < insertion_id)
+            && (position == m_entries.size() || m_entries[position].insertion_id >= insertion_id);
+    };
+
+    auto position = position_hint;
+    if (!is_first_entry_not_below(position)) {
+        size_t low = 0;
+        size_t high = m_entries.size();
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (m_entries[middle].insertion_id < insertion_id)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        position = low;
+    }
+
+    for (; position < m_entries.size(); ++position) {
+        if (!m_entries[position].key.is_empty())
+            return position;
+    }
+    return {};
+}
+
+void Map::compact_entries()
+{
+    size_t live_entry_count = 0;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto& entry = m_entries[i];
+        if (entry.key.is_empty())
+            continue;
+        if (i != live_entry_count) {
+            m_positions.find(entry.key)->value = live_entry_count;
+            m_entries[live_entry_count] = entry;
+        }
+        ++live_entry_count;
+    }
+    m_entries.shrink(live_entry_count);
+    m_removed_entry_count = 0;
 }
 
 void Map::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
-    for (auto& value : m_entries) {
-        visitor.visit(value.key);
-        visitor.visit(value.value);
+    for (auto& entry : m_entries) {
+        visitor.visit(entry.key);
+        visitor.visit(entry.value);
     }
-    // NOTE: The entries in m_keys are already visited by the walk over m_entries above.
-    visitor.ignore(m_keys);
+    // NOTE: The keys in m_positions are already visited by the walk over m_entries above.
+    visitor.ignore(m_positions);
 }
 
 }
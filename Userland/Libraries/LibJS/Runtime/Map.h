@@ -7,7 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
-#include <AK/RedBlackTree.h>
+#include <AK/Vector.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/Value.h>
@@ -31,6 +31,11 @@ public:
     void map_set(Value const&, Value);
     size_t map_size() const;
 
+    struct Entry {
+        Value key;
+        Value value;
+    };
+
     struct EndIterator {
     };
 
@@ -38,26 +43,23 @@ public:
     struct IteratorImpl {
         bool is_end() const
         {
-            return m_map->m_keys.begin_from(m_index).is_end()
-                && m_map->m_keys.find_smallest_not_below_iterator(m_index).is_end();
+            return !find_entry().has_value();
         }
 
         IteratorImpl& operator++()
         {
             ++m_index;
+            ++m_position;
             return *this;
         }
 
-        decltype(auto) operator*()
-        {
-            ensure_next_element();
-            return *m_map->m_entries.find(*m_map->m_keys.begin_from(m_index));
-        }
-
-        decltype(auto) operator*() const
+        // NOTE: This returns a copy, as the entries may move around if the map is modified while iterating over it.
+        Entry operator*() const
         {
-            ensure_next_element();
-            return *m_map->m_entries.find(*m_map->m_keys.begin_from(m_index));
+            auto position = find_entry();
+            VERIFY(position.has_value());
+            auto const& entry = m_map->m_entries[*position];
+            return { entry.key, entry.value };
         }
 
         bool operator==(IteratorImpl const& other) const { return m_index == other.m_index && &m_map == &other.m_map; }
@@ -69,34 +71,29 @@ public:
         requires(IsConst)
             : m_map(map)
         {
-            ensure_index();
         }
 
         IteratorImpl(Map& map)
         requires(!IsConst)
             : m_map(map)
         {
-            ensure_index();
-        }
-
-        void ensure_index() const
-        {
-            if (m_map->m_keys.is_empty())
-                m_index = m_map->m_next_insertion_id;
-            else
-                m_index = m_map->m_keys.begin().key();
         }
 
-        void ensure_next_element() const
+        Optional<size_t> find_entry() const
         {
-            if (auto it = m_map->m_keys.find_smallest_not_below_iterator(m_index); it.is_end())
-                m_index = m_map->m_next_insertion_id;
-            else
-                m_index = it.key();
+            auto position = m_map->find_position_of_next_entry(m_index, m_position);
+            if (position.has_value()) {
+                m_index = m_map->m_entries[*position].insertion_id;
+                m_position = *position;
+            }
+            return position;
         }
 
         Conditional<IsConst, NonnullGCPtr<Map const>, NonnullGCPtr<Map>> m_map;
+        // NOTE: Positions change whenever the entries are compacted, so the insertion ID is what we actually go by.
+        //       The position only saves us from having to search for it every time.
         mutable size_t m_index { 0 };
+        mutable size_t m_position { 0 };
     };
 
     using Iterator = IteratorImpl<false>;
@@ -110,9 +107,21 @@ private:
     explicit Map(Object& prototype);
     virtual void visit_edges(Visitor& visitor) override;
 
+    Optional<size_t> find_position_of_next_entry(size_t insertion_id, size_t position_hint) const;
+    void compact_entries();
+
+    struct StoredEntry {
+        size_t insertion_id { 0 };
+        Value key;
+        Value value;
+    };
+
     size_t m_next_insertion_id { 0 };
-    RedBlackTree<size_t, Value> m_keys;
-    HashMap<Value, Value, ValueTraits> m_entries;
+    size_t m_removed_entry_count { 0 };
+
+    // Entries in insertion order (and thus sorted by insertion ID). Removed entries keep an empty key until the next compaction.
+    Vector<StoredEntry> m_entries;
+    HashMap<Value, size_t, ValueTraits> m_positions;
 };
 
 }
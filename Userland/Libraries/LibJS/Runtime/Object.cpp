@@ -955,7 +955,7 @@ ThrowCompletionOr<Value> Object::internal_get(PropertyKey const& property_key, V
 }
 
 // 10.1.9 [[Set]] ( P, V, Receiver ), https://tc39.es/ecma262/#sec-ordinary-object-internal-methods-and-internal-slots-set-p-v-receiver
-ThrowCompletionOr<bool> Object::internal_set(PropertyKey const& property_key, Value value, Value receiver, CacheablePropertyMetadata* cacheable_metadata)
+ThrowCompletionOr<bool> Object::internal_set(PropertyKey const& property_key, Value value, Value receiver, CacheablePropertyMetadata* cacheable_metadata, PropertyLookupPhase phase)
 {
     VERIFY(property_key.is_valid());
     VERIFY(!value.is_empty());
@@ -965,11 +965,11 @@ ThrowCompletionOr<bool> Object::internal_set(PropertyKey const& property_key, Va
     auto own_descriptor = TRY(internal_get_own_property(property_key));
 
     // 3. Return ? OrdinarySetWithOwnDescriptor(O, P, V, Receiver, ownDesc).
-    return ordinary_set_with_own_descriptor(property_key, value, receiver, own_descriptor, cacheable_metadata);
+    return ordinary_set_with_own_descriptor(property_key, value, receiver, own_descriptor, cacheable_metadata, phase);
 }
 
 // 10.1.9.2 OrdinarySetWithOwnDescriptor ( O, P, V, Receiver, ownDesc ), https://tc39.es/ecma262/#sec-ordinarysetwithowndescriptor
-ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey const& property_key, Value value, Value receiver, Optional<PropertyDescriptor> own_descriptor, CacheablePropertyMetadata* cacheable_metadata)
+ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey const& property_key, Value value, Value receiver, Optional<PropertyDescriptor> own_descriptor, CacheablePropertyMetadata* cacheable_metadata, PropertyLookupPhase phase)
 {
     VERIFY(property_key.is_valid());
     VERIFY(!value.is_empty());
@@ -985,7 +985,7 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
         // b. If parent is not null, then
         if (parent) {
             // i. Return ? parent.[[Set]](P, V, Receiver).
-            return TRY(parent->internal_set(property_key, value, receiver));
+            return TRY(parent->internal_set(property_key, value, receiver, cacheable_metadata, PropertyLookupPhase::PrototypeChain));
         }
         // c. Else,
         else {
@@ -1025,7 +1025,7 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
             // iii. Let valueDesc be the PropertyDescriptor { [[Value]]: V }.
             auto value_descriptor = PropertyDescriptor { .value = value };
 
-            if (cacheable_metadata && own_descriptor.has_value() && own_descriptor->property_offset.has_value() && shape().is_cacheable()) {
+            if (cacheable_metadata && phase == PropertyLookupPhase::OwnProperty && own_descriptor.has_value() && own_descriptor->property_offset.has_value() && shape().is_cacheable()) {
                 *cacheable_metadata = CacheablePropertyMetadata {
                     .type = CacheablePropertyMetadata::Type::OwnProperty,
                     .property_offset = own_descriptor->property_offset.value(),
@@ -1056,6 +1056,17 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
     if (!setter)
         return false;
 
+    // Non-standard: If the caller has requested cacheable metadata and the setter was found in the prototype chain, fill it in.
+    if (cacheable_metadata && phase == PropertyLookupPhase::PrototypeChain && own_descriptor->property_offset.has_value() && shape().is_cacheable()) {
+        VERIFY(shape().is_prototype_shape());
+        VERIFY(shape().prototype_chain_validity()->is_valid());
+        *cacheable_metadata = CacheablePropertyMetadata {
+            .type = CacheablePropertyMetadata::Type::InPrototypeChain,
+            .property_offset = own_descriptor->property_offset.value(),
+            .prototype = this,
+        };
+    }
+
     // 6. Perform ? Call(setter, Receiver, « V »).
     (void)TRY(call(vm, *setter, receiver, value));
 
@@ -14,6 +14,7 @@
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/PropertyKey.h>
+#include <LibJS/Runtime/StringPrototype.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Runtime/Value.h>
 
@@ -23,9 +24,12 @@ JS_DEFINE_ALLOCATOR(PrimitiveString);
 
 PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
     : m_is_rope(true)
+    , m_rope_depth(min(max(lhs.m_rope_depth, rhs.m_rope_depth) + 1, NumericLimits<u16>::max()))
     , m_lhs(&lhs)
     , m_rhs(&rhs)
 {
+    if (lhs.m_length_in_utf16_code_units != unknown_length && rhs.m_length_in_utf16_code_units != unknown_length)
+        m_length_in_utf16_code_units = lhs.m_length_in_utf16_code_units + rhs.m_length_in_utf16_code_units;
 }
 
 PrimitiveString::PrimitiveString(String string)
@@ -114,6 +118,16 @@ ByteString PrimitiveString::byte_string() const
     return *m_byte_string;
 }
 
+DeprecatedFlyString PrimitiveString::deprecated_fly_string() const
+{
+    DeprecatedFlyString fly_string { byte_string() };
+
+    // NOTE: We keep the interned string as our byte string, so that converting this string to a property key
+    //       again can skip the lookup in the table of interned strings.
+    m_byte_string = ByteString { fly_string };
+    return fly_string;
+}
+
 Utf16String PrimitiveString::utf16_string() const
 {
     resolve_rope_if_needed(EncodingPreference::UTF16);
@@ -136,24 +150,197 @@ Utf16View PrimitiveString::utf16_string_view() const
     return m_utf16_string->view();
 }
 
+size_t PrimitiveString::length_in_utf16_code_units() const
+{
+    if (m_length_in_utf16_code_units != unknown_length)
+        return m_length_in_utf16_code_units;
+
+    // NOTE: We compute the lengths of nested ropes without using recursion, for the same reason as in resolve_rope_if_needed().
+    //       Every node we pass through keeps its length, so this is only ever done once per node.
+    Vector<PrimitiveString const*> stack;
+    stack.append(this);
+    while (!stack.is_empty()) {
+        auto const* current = stack.last();
+        if (current->m_length_in_utf16_code_units != unknown_length) {
+            stack.take_last();
+            continue;
+        }
+
+        if (!current->m_is_rope) {
+            if (current->has_utf16_string())
+                current->m_length_in_utf16_code_units = current->m_utf16_string->length_in_code_units();
+            else if (current->has_utf8_string())
+                current->m_length_in_utf16_code_units = AK::utf16_code_unit_length_from_utf8(current->m_utf8_string->bytes_as_string_view());
+            else
+                current->m_length_in_utf16_code_units = current->utf16_string().length_in_code_units();
+            stack.take_last();
+            continue;
+        }
+
+        auto lhs_length = current->m_lhs->m_length_in_utf16_code_units;
+        auto rhs_length = current->m_rhs->m_length_in_utf16_code_units;
+        if (lhs_length != unknown_length && rhs_length != unknown_length) {
+            current->m_length_in_utf16_code_units = lhs_length + rhs_length;
+            stack.take_last();
+            continue;
+        }
+
+        if (rhs_length == unknown_length)
+            stack.append(current->m_rhs);
+        if (lhs_length == unknown_length)
+            stack.append(current->m_lhs);
+    }
+
+    return m_length_in_utf16_code_units;
+}
+
+bool PrimitiveString::should_access_rope_directly() const
+{
+    if (!m_is_rope || m_rope_depth > max_rope_depth_for_direct_access)
+        return false;
+
+    // Every direct access walks down the rope, so we only keep doing that while the total cost of the walks
+    // stays below the cost of resolving the rope once. Past that point the caller is most likely scanning
+    // the whole string, and is better served by a flat one.
+    if (m_direct_access_cost > NumericLimits<u32>::max() - m_rope_depth)
+        return false;
+    m_direct_access_cost += m_rope_depth;
+    return m_direct_access_cost <= length_in_utf16_code_units();
+}
+
+template<typename Callback>
+void PrimitiveString::for_each_utf16_piece_starting_at(size_t offset, Callback callback) const
+{
+    Vector<PrimitiveString const*> stack;
+    stack.append(this);
+    while (!stack.is_empty()) {
+        auto const* current = stack.take_last();
+
+        // Skip over entire subtrees that end before the offset.
+        auto length = current->length_in_utf16_code_units();
+        if (offset >= length) {
+            offset -= length;
+            continue;
+        }
+
+        if (current->m_is_rope) {
+            stack.append(current->m_rhs);
+            stack.append(current->m_lhs);
+            continue;
+        }
+
+        auto piece = current->utf16_string_view().substring_view(offset);
+        offset = 0;
+
+        if (callback(piece) == IterationDecision::Break)
+            return;
+    }
+}
+
+u16 PrimitiveString::utf16_code_unit_at(size_t index) const
+{
+    if (!should_access_rope_directly())
+        return utf16_string_view().code_unit_at(index);
+
+    auto const* current = this;
+    while (current->m_is_rope) {
+        auto lhs_length = current->m_lhs->length_in_utf16_code_units();
+        if (index < lhs_length) {
+            current = current->m_lhs;
+        } else {
+            index -= lhs_length;
+            current = current->m_rhs;
+        }
+    }
+
+    return current->utf16_string_view().code_unit_at(index);
+}
+
+Utf16String PrimitiveString::utf16_substring(size_t offset, size_t length) const
+{
+    if (!should_access_rope_directly())
+        return Utf16String::create(utf16_string_view().substring_view(offset, length));
+
+    Utf16Data code_units;
+    code_units.ensure_capacity(length);
+
+    for_each_utf16_piece_starting_at(offset, [&](Utf16View const& piece) {
+        auto piece_length = min(piece.length_in_code_units(), length - code_units.size());
+        code_units.append(piece.data(), piece_length);
+        return code_units.size() == length ? IterationDecision::Break : IterationDecision::Continue;
+    });
+
+    return Utf16String::create(move(code_units));
+}
+
+Optional<size_t> PrimitiveString::utf16_index_of(Utf16View const& search, size_t from_index) const
+{
+    if (!should_access_rope_directly())
+        return string_index_of(utf16_string_view(), search, from_index);
+
+    auto length = length_in_utf16_code_units();
+    auto search_length = search.length_in_code_units();
+
+    if (search_length == 0)
+        return from_index <= length ? from_index : Optional<size_t> {};
+    if (from_index >= length || search_length > length - from_index)
+        return {};
+
+    // We search each piece on its own, so that a match near the start doesn't require touching the rest of the rope.
+    // Matches that straddle two or more pieces are found by also searching the code units around each boundary,
+    // keeping the last (search_length - 1) code units we've seen in `carry`.
+    Optional<size_t> result;
+    size_t piece_offset = from_index;
+    Utf16Data carry;
+    Utf16Data window;
+
+    for_each_utf16_piece_starting_at(from_index, [&](Utf16View const& piece) {
+        auto piece_length = piece.length_in_code_units();
+
+        if (!carry.is_empty()) {
+            window.clear_with_capacity();
+            window.extend(carry);
+            window.append(piece.data(), min(piece_length, search_length - 1));
+
+            if (auto index = string_index_of(Utf16View { window.span() }, search, 0); index.has_value() && *index < carry.size()) {
+                result = piece_offset - carry.size() + *index;
+                return IterationDecision::Break;
+            }
+        }
+
+        if (auto index = string_index_of(piece, search, 0); index.has_value()) {
+            result = piece_offset + *index;
+            return IterationDecision::Break;
+        }
+
+        auto carried_piece_length = min(piece_length, search_length - 1);
+        auto kept_carry_length = min(carry.size(), search_length - 1 - carried_piece_length);
+        carry.remove(0, carry.size() - kept_carry_length);
+        carry.append(piece.data() + piece_length - carried_piece_length, carried_piece_length);
+
+        piece_offset += piece_length;
+        return IterationDecision::Continue;
+    });
+
+    return result;
+}
+
 ThrowCompletionOr<Optional<Value>> PrimitiveString::get(VM& vm, PropertyKey const& property_key) const
 {
     if (property_key.is_symbol())
         return Optional<Value> {};
     if (property_key.is_string()) {
         if (property_key.as_string() == vm.names.length.as_string()) {
-            auto length = utf16_string().length_in_code_units();
+            auto length = length_in_utf16_code_units();
             return Value(static_cast<double>(length));
         }
     }
     auto index = canonical_numeric_index_string(property_key, CanonicalIndexMode::IgnoreNumericRoundtrip);
     if (!index.is_index())
         return Optional<Value> {};
-    auto str = utf16_string_view();
-    auto length = str.length_in_code_units();
-    if (length <= index.as_index())
+    if (length_in_utf16_code_units() <= index.as_index())
         return Optional<Value> {};
-    return create(vm, Utf16String::create(str.substring_view(index.as_index(), 1)));
+    return create(vm, utf16_substring(index.as_index(), 1));
 }
 
 NonnullGCPtr<PrimitiveString> PrimitiveString::create(VM& vm, Utf16String string)
@@ -284,6 +471,7 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
 
         m_utf16_string = Utf16String::create(move(code_units));
         m_is_rope = false;
+        m_rope_depth = 0;
         m_lhs = nullptr;
         m_rhs = nullptr;
         return;
@@ -353,6 +541,7 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
     // NOTE: We've already produced valid UTF-8 above, so there's no need for additional validation.
     m_utf8_string = builder.to_string_without_validation();
     m_is_rope = false;
+    m_rope_depth = 0;
     m_lhs = nullptr;
     m_rhs = nullptr;
 }
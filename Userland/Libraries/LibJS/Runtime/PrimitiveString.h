@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/ByteString.h>
+#include <AK/DeprecatedFlyString.h>
 #include <AK/Optional.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
@@ -47,10 +48,19 @@ public:
     [[nodiscard]] ByteString byte_string() const;
     bool has_byte_string() const { return m_byte_string.has_value(); }
 
+    // Returns the interned form of this string, as used by property keys.
+    [[nodiscard]] DeprecatedFlyString deprecated_fly_string() const;
+
     [[nodiscard]] Utf16String utf16_string() const;
     [[nodiscard]] Utf16View utf16_string_view() const;
     bool has_utf16_string() const { return m_utf16_string.has_value(); }
 
+    // These operate on the string as a sequence of UTF-16 code units, without resolving ropes where possible.
+    [[nodiscard]] size_t length_in_utf16_code_units() const;
+    [[nodiscard]] u16 utf16_code_unit_at(size_t index) const;
+    [[nodiscard]] Utf16String utf16_substring(size_t offset, size_t length) const;
+    [[nodiscard]] Optional<size_t> utf16_index_of(Utf16View const& search, size_t from_index) const;
+
     ThrowCompletionOr<Optional<Value>> get(VM&, PropertyKey const&) const;
 
 private:
@@ -67,11 +77,27 @@ private:
     };
     void resolve_rope_if_needed(EncodingPreference) const;
 
+    bool should_access_rope_directly() const;
+
+    template<typename Callback>
+    void for_each_utf16_piece_starting_at(size_t offset, Callback) const;
+
+    // Ropes deeper than this are always resolved before accessing their code units.
+    static constexpr u32 max_rope_depth_for_direct_access = 256;
+
+    static constexpr size_t unknown_length = NumericLimits<size_t>::max();
+
+    // NOTE: Every string pays for these, so they are kept small enough to fit next to m_is_rope. The depth stops
+    //       counting once it is far past the limit for direct access, and the access cost once it would overflow.
     mutable bool m_is_rope { false };
+    mutable u16 m_rope_depth { 0 };
+    mutable u32 m_direct_access_cost { 0 };
 
     mutable GCPtr<PrimitiveString> m_lhs;
     mutable GCPtr<PrimitiveString> m_rhs;
 
+    mutable size_t m_length_in_utf16_code_units { unknown_length };
+
     mutable Optional<String> m_utf8_string;
     mutable Optional<ByteString> m_byte_string;
     mutable Optional<Utf16String> m_utf16_string;
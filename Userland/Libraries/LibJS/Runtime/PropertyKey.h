@@ -36,6 +36,8 @@ public:
             return PropertyKey { value.as_symbol() };
         if (value.is_integral_number() && value.as_double() >= 0 && value.as_double() < NumericLimits<u32>::max())
             return static_cast<u32>(value.as_double());
+        if (value.is_string())
+            return PropertyKey { value.as_string().deprecated_fly_string() };
         return TRY(value.to_byte_string(vm));
     }
 
@@ -145,6 +145,34 @@ ThrowCompletionOr<ByteString> parse_regex_pattern(VM& vm, StringView pattern, bo
     return result.release_value();
 }
 
+static constexpr size_t max_number_of_compiled_regexes_to_remember = 64;
+
+Optional<Regex<ECMA262>> RegExpCache::find(StringView pattern, regex::RegexOptions<ECMAScriptFlags> flags)
+{
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto& entry = m_entries[i];
+        if (entry.flags.value() != flags.value() || entry.pattern != pattern)
+            continue;
+
+        // Keep the cache ordered from most to least recently used.
+        if (i != 0) {
+            auto moved_entry = m_entries.take(i);
+            m_entries.prepend(move(moved_entry));
+        }
+        return m_entries.first().regex;
+    }
+    return {};
+}
+
+void RegExpCache::did_compile(ByteString pattern, regex::RegexOptions<ECMAScriptFlags> flags, Regex<ECMA262> const& regex)
+{
+    VERIFY(regex.parser_result.error == regex::Error::NoError);
+
+    if (m_entries.size() == max_number_of_compiled_regexes_to_remember)
+        m_entries.take_last();
+    m_entries.prepend({ move(pattern), flags, regex });
+}
+
 NonnullGCPtr<RegExpObject> RegExpObject::create(Realm& realm)
 {
     return realm.heap().allocate<RegExpObject>(realm, realm.intrinsics().regexp_prototype());
@@ -203,26 +231,33 @@ ThrowCompletionOr<NonnullGCPtr<RegExpObject>> RegExpObject::regexp_initialize(VM
         return vm.throw_completion<SyntaxError>(parsed_flags_or_error.release_error());
     auto parsed_flags = parsed_flags_or_error.release_value();
 
-    auto parsed_pattern = ByteString::empty();
-    if (!pattern.is_empty()) {
-        bool unicode = parsed_flags.has_flag_set(regex::ECMAScriptFlags::Unicode);
-        bool unicode_sets = parsed_flags.has_flag_set(regex::ECMAScriptFlags::UnicodeSets);
-
-        // 11. If u is true or v is true, then
-        //     a. Let patternText be StringToCodePoints(P).
-        // 12. Else,
-        //     a. Let patternText be the result of interpreting each of P's 16-bit elements as a Unicode BMP code point. UTF-16 decoding is not applied to the elements.
-        // 13. Let parseResult be ParsePattern(patternText, u, v).
-        parsed_pattern = TRY(parse_regex_pattern(vm, pattern, unicode, unicode_sets));
-    }
+    // NOTE: Steps 11 through 15 only depend on P and F, so we can skip them if we've compiled this regex before.
+    auto regex = vm.regexp_cache().find(pattern, parsed_flags);
+    if (!regex.has_value()) {
+        auto parsed_pattern = ByteString::empty();
+        if (!pattern.is_empty()) {
+            bool unicode = parsed_flags.has_flag_set(regex::ECMAScriptFlags::Unicode);
+            bool unicode_sets = parsed_flags.has_flag_set(regex::ECMAScriptFlags::UnicodeSets);
+
+            // 11. If u is true or v is true, then
+            //     a. Let patternText be StringToCodePoints(P).
+            // 12. Else,
+            //     a. Let patternText be the result of interpreting each of P's 16-bit elements as a Unicode BMP code point. UTF-16 decoding is not applied to the elements.
+            // 13. Let parseResult be ParsePattern(patternText, u, v).
+            parsed_pattern = TRY(parse_regex_pattern(vm, pattern, unicode, unicode_sets));
+        }
 
-    // 14. If parseResult is a non-empty List of SyntaxError objects, throw a SyntaxError exception.
-    Regex<ECMA262> regex(move(parsed_pattern), parsed_flags);
-    if (regex.parser_result.error != regex::Error::NoError)
-        return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, regex.error_string());
+        // 14. If parseResult is a non-empty List of SyntaxError objects, throw a SyntaxError exception.
+        Regex<ECMA262> compiled_regex(move(parsed_pattern), parsed_flags);
+        if (compiled_regex.parser_result.error != regex::Error::NoError)
+            return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, compiled_regex.error_string());
 
-    // 15. Assert: parseResult is a Pattern Parse Node.
-    VERIFY(regex.parser_result.error == regex::Error::NoError);
+        // 15. Assert: parseResult is a Pattern Parse Node.
+        VERIFY(compiled_regex.parser_result.error == regex::Error::NoError);
+
+        vm.regexp_cache().did_compile(pattern, parsed_flags, compiled_regex);
+        regex = move(compiled_regex);
+    }
 
     // 16. Set obj.[[OriginalSource]] to P.
     m_pattern = move(pattern);
@@ -234,7 +269,7 @@ ThrowCompletionOr<NonnullGCPtr<RegExpObject>> RegExpObject::regexp_initialize(VM
     // 19. Let rer be the RegExp Record { [[IgnoreCase]]: i, [[Multiline]]: m, [[DotAll]]: s, [[Unicode]]: u, [[CapturingGroupsCount]]: capturingGroupsCount }.
     // 20. Set obj.[[RegExpRecord]] to rer.
     // 21. Set obj.[[RegExpMatcher]] to CompilePattern of parseResult with argument rer.
-    m_regex = move(regex);
+    m_regex = regex.release_value();
 
     // 22. Perform ? Set(obj, "lastIndex", +0𝔽, true).
     TRY(set(vm.names.lastIndex, Value(0), Object::ShouldThrowExceptions::Yes));
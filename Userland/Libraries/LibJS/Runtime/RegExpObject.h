@@ -23,6 +23,29 @@ struct ParseRegexPatternError {
 ErrorOr<ByteString, ParseRegexPatternError> parse_regex_pattern(StringView pattern, bool unicode, bool unicode_sets);
 ThrowCompletionOr<ByteString> parse_regex_pattern(VM& vm, StringView pattern, bool unicode, bool unicode_sets);
 
+// Compiled regexes by source pattern and flags, so that creating the same RegExp over and over again (e.g. a regex
+// literal in a loop, or `new RegExp(pattern)` with a repeated pattern) doesn't have to parse and optimize it every time.
+class RegExpCache {
+    AK_MAKE_NONCOPYABLE(RegExpCache);
+    AK_MAKE_NONMOVABLE(RegExpCache);
+
+public:
+    RegExpCache() = default;
+
+    Optional<Regex<ECMA262>> find(StringView pattern, regex::RegexOptions<ECMAScriptFlags> flags);
+    void did_compile(ByteString pattern, regex::RegexOptions<ECMAScriptFlags> flags, Regex<ECMA262> const&);
+
+private:
+    struct Entry {
+        ByteString pattern;
+        regex::RegexOptions<ECMAScriptFlags> flags;
+        Regex<ECMA262> regex;
+    };
+
+    // Ordered from most to least recently used.
+    Vector<Entry> m_entries;
+};
+
 class RegExpObject : public Object {
     JS_OBJECT(RegExpObject, Object);
     JS_DECLARE_ALLOCATOR(RegExpObject);
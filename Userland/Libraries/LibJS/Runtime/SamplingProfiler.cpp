@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/ECMAScriptFunctionObject.h>
+#include <LibJS/Runtime/ExecutionContext.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/SourceCode.h>
+#include <LibThreading/Thread.h>
+#include <unistd.h>
+
+namespace JS {
+
+SamplingProfiler::SamplingProfiler(VM& vm, AK::Duration interval)
+    : m_vm(vm)
+{
+    auto interval_in_microseconds = max(interval.to_microseconds(), 1);
+    m_timer_thread = Threading::Thread::construct([this, interval_in_microseconds] {
+        while (!m_should_stop.load(AK::MemoryOrder::memory_order_relaxed)) {
+            usleep(interval_in_microseconds);
+            m_sample_requested.store(true, AK::MemoryOrder::memory_order_relaxed);
+        }
+        return 0;
+    },
+        "JS::SamplingProfiler"sv);
+    m_timer_thread->start();
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    m_should_stop.store(true, AK::MemoryOrder::memory_order_relaxed);
+    (void)m_timer_thread->join();
+}
+
+ByteString const& SamplingProfiler::location_of(SourceCode const& source_code, u32 offset)
+{
+    auto& cached_locations = m_cached_locations.ensure(&source_code, [&] {
+        return CachedLocations { source_code, {} };
+    });
+
+    return cached_locations.location_by_offset.ensure(offset, [&] {
+        auto position = source_code.range_from_offsets(offset, offset).start;
+        auto location = ByteString::formatted("{}:{}:{}", source_code.filename(), position.line, position.column);
+
+        // NOTE: Semicolons separate frames in the collapsed stack format, so we can't have any in the location.
+        return location.replace(";"sv, ","sv);
+    });
+}
+
+void SamplingProfiler::take_sample()
+{
+    m_sample_requested.store(false, AK::MemoryOrder::memory_order_relaxed);
+
+    auto const& stack = m_vm.execution_context_stack();
+    if (stack.is_empty())
+        return;
+
+    // NOTE: Each frame is named after its function, and located at the start of that function (or of the script), not at
+    //       the current position inside it. This keeps all samples of a function in the same flame graph frame.
+    StringBuilder builder;
+    for (auto const* context : stack) {
+        if (!builder.is_empty())
+            builder.append(';');
+
+        if (context->function_name && !context->function_name->is_empty())
+            builder.append(context->function_name->utf8_string_view());
+        else if (context->function)
+            builder.append("(anonymous)"sv);
+        else
+            builder.append("(top level)"sv);
+
+        Optional<UnrealizedSourceRange> source_range;
+        if (context->function && is<ECMAScriptFunctionObject>(*context->function))
+            source_range = static_cast<ECMAScriptFunctionObject const&>(*context->function).ecmascript_code().unrealized_source_range();
+        else if (context->executable)
+            source_range = UnrealizedSourceRange { context->executable->source_code, 0, 0 };
+
+        if (source_range.has_value() && source_range->source_code)
+            builder.appendff(" ({})", location_of(*source_range->source_code, source_range->start_offset));
+    }
+
+    m_sample_count_by_stack.ensure(builder.to_byte_string(), [] { return 0u; })++;
+    ++m_sample_count;
+}
+
+ByteString SamplingProfiler::to_collapsed_stacks() const
+{
+    Vector<ByteString const*> stacks;
+    stacks.ensure_capacity(m_sample_count_by_stack.size());
+    for (auto const& it : m_sample_count_by_stack)
+        stacks.unchecked_append(&it.key);
+    quick_sort(stacks, [](auto const* a, auto const* b) { return *a < *b; });
+
+    StringBuilder builder;
+    for (auto const* stack : stacks)
+        builder.appendff("{} {}\n", *stack, m_sample_count_by_stack.get(*stack).value());
+    return builder.to_byte_string();
+}
+
+}
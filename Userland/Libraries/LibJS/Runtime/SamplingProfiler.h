@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Time.h>
+#include <LibJS/Forward.h>
+#include <LibThreading/Forward.h>
+
+namespace JS {
+
+// A sampling profiler for JavaScript code. A background thread periodically requests a sample, which is taken the next
+// time the VM reaches a safe point (a function call or a jump). Samples are aggregated per call stack, and can be
+// exported in the "collapsed stack" format understood by flamegraph.pl, speedscope, etc.
+class SamplingProfiler {
+    AK_MAKE_NONCOPYABLE(SamplingProfiler);
+    AK_MAKE_NONMOVABLE(SamplingProfiler);
+
+public:
+    static constexpr AK::Duration default_interval = AK::Duration::from_milliseconds(1);
+
+    SamplingProfiler(VM&, AK::Duration interval);
+    ~SamplingProfiler();
+
+    ALWAYS_INLINE void take_sample_if_requested()
+    {
+        if (m_sample_requested.load(AK::MemoryOrder::memory_order_relaxed)) [[unlikely]]
+            take_sample();
+    }
+
+    [[nodiscard]] u64 sample_count() const { return m_sample_count; }
+
+    // One line per distinct call stack: the frames from outermost to innermost, separated by semicolons, followed by the
+    // number of times it was sampled.
+    [[nodiscard]] ByteString to_collapsed_stacks() const;
+
+private:
+    void take_sample();
+    ByteString const& location_of(SourceCode const&, u32 offset);
+
+    VM& m_vm;
+
+    Atomic<bool> m_sample_requested { false };
+    Atomic<bool> m_should_stop { false };
+    RefPtr<Threading::Thread> m_timer_thread;
+
+    // NOTE: We keep the source code alive, so that its address can't be reused by some other source code.
+    struct CachedLocations {
+        NonnullRefPtr<SourceCode const> source_code;
+        HashMap<u32, ByteString> location_by_offset;
+    };
+    HashMap<SourceCode const*, CachedLocations> m_cached_locations;
+
+    HashMap<ByteString, u64> m_sample_count_by_stack;
+    u64 m_sample_count { 0 };
+};
+
+}
@@ -469,17 +469,16 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::every)
     return true;
 }
 
-// NOTE: This function assumes that the index is valid within the TypedArray,
-//       and that the TypedArray is not detached.
-template<typename T>
-inline void fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 end, T value)
+// NOTE: This function assumes that the range is valid within the TypedArray, and that the TypedArray is not detached.
+//       The first element in the range must already have been set to the fill value.
+static void fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 end)
 {
     Checked<size_t> computed_begin = begin;
-    computed_begin *= sizeof(T);
+    computed_begin *= typed_array.element_size();
     computed_begin += typed_array.byte_offset();
 
     Checked<size_t> computed_end = end;
-    computed_end *= sizeof(T);
+    computed_end *= typed_array.element_size();
     computed_end += typed_array.byte_offset();
 
     if (computed_begin.has_overflow() || computed_end.has_overflow()) [[unlikely]] {
@@ -492,9 +491,12 @@ inline void fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 en
     }
 
     auto& array_buffer = *typed_array.viewed_array_buffer();
-    auto* slot = reinterpret_cast<T*>(array_buffer.buffer().offset_pointer(computed_begin.value()));
-    for (auto i = begin; i < end; ++i)
-        *(slot++) = value;
+    auto* slot = array_buffer.buffer().offset_pointer(computed_begin.value());
+    auto byte_length = computed_end.value() - computed_begin.value();
+
+    // Every element has the same bytes, so we can keep doubling the part of the range that has been filled.
+    for (size_t filled_byte_length = typed_array.element_size(); filled_byte_length < byte_length; filled_byte_length *= 2)
+        __builtin_memcpy(slot + filled_byte_length, slot, min(filled_byte_length, byte_length - filled_byte_length));
 }
 
 // 23.2.3.9 %TypedArray%.prototype.fill ( value [ , start [ , end ] ] ), https://tc39.es/ecma262/#sec-%typedarray%.prototype.fill
@@ -565,37 +567,10 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::fill)
     // 17. Set final to min(final, len).
     final = min(final, length);
 
-    if (value.is_int32()) {
-        switch (typed_array->kind()) {
-        case TypedArrayBase::Kind::Uint8Array:
-            fast_typed_array_fill<u8>(*typed_array, k, final, static_cast<u8>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Uint16Array:
-            fast_typed_array_fill<u16>(*typed_array, k, final, static_cast<u16>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Uint32Array:
-            fast_typed_array_fill<u32>(*typed_array, k, final, static_cast<u32>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Int8Array:
-            fast_typed_array_fill<i8>(*typed_array, k, final, static_cast<i8>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Int16Array:
-            fast_typed_array_fill<i16>(*typed_array, k, final, static_cast<i16>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Int32Array:
-            fast_typed_array_fill<i32>(*typed_array, k, final, value.as_i32());
-            return typed_array;
-        case TypedArrayBase::Kind::Uint8ClampedArray:
-            fast_typed_array_fill<u8>(*typed_array, k, final, clamp(value.as_i32(), 0, 255));
-            return typed_array;
-        default:
-            // FIXME: Support more TypedArray kinds.
-            break;
-        }
-    }
-
     // 18. Repeat, while k < final,
-    while (k < final) {
+    // OPTIMIZATION: Every element gets the same value, so there's no need to convert it for each of them. Instead, we set
+    //               the first element the usual way and copy its bytes over the rest of the range.
+    if (k < final) {
         // a. Let Pk be ! ToString(𝔽(k)).
         // b. Perform ! Set(O, Pk, value, true).
         CanonicalIndex canonical_index { CanonicalIndex::Type::Index, k };
@@ -608,8 +583,7 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::fill)
 #undef __JS_ENUMERATE
         }
 
-        // c. Set k to k + 1.
-        ++k;
+        fast_typed_array_fill(*typed_array, k, final);
     }
 
     // 19. Return O.
@@ -865,6 +839,78 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::for_each)
     return js_undefined();
 }
 
+template<typename T>
+static Optional<u32> fast_typed_array_find_number(TypedArrayBase const& typed_array, u32 begin, u32 end, Direction direction, double search_element, bool nan_is_equal)
+{
+    using UnderlyingBufferDataType = Conditional<IsSame<ClampedU8, T>, u8, T>;
+    auto const* data = reinterpret_cast<UnderlyingBufferDataType const*>(typed_array.viewed_array_buffer()->buffer().offset_pointer(typed_array.byte_offset()));
+
+    auto find = [&](auto matches) -> Optional<u32> {
+        if (direction == Direction::Ascending) {
+            for (auto i = begin; i < end; ++i) {
+                if (matches(data[i]))
+                    return i;
+            }
+        } else {
+            for (auto i = end; i > begin; --i) {
+                if (matches(data[i - 1]))
+                    return i - 1;
+            }
+        }
+        return {};
+    };
+
+    if constexpr (IsFloatingPoint<UnderlyingBufferDataType>) {
+        if (isnan(search_element)) {
+            if (!nan_is_equal)
+                return {};
+            return find([](auto element) { return isnan(element); });
+        }
+        if (!isinf(search_element) && fabs(search_element) > NumericLimits<UnderlyingBufferDataType>::max())
+            return {};
+    } else {
+        if (trunc(search_element) != search_element)
+            return {};
+        if (search_element < NumericLimits<UnderlyingBufferDataType>::min() || search_element > NumericLimits<UnderlyingBufferDataType>::max())
+            return {};
+    }
+
+    // If the search element doesn't survive the round trip through the element type, no element can be equal to it.
+    auto value = static_cast<UnderlyingBufferDataType>(search_element);
+    if (static_cast<double>(value) != search_element)
+        return {};
+
+    return find([value](auto element) { return element == value; });
+}
+
+// OPTIMIZATION: Searching a TypedArray for a Number doesn't require turning every element into a Value. Instead, we
+//               convert the search element to the element type once and look for it in the underlying buffer.
+//               Returns an empty Optional if this doesn't apply, in which case the caller has to do the search itself.
+static Optional<Optional<u32>> fast_typed_array_find(TypedArrayBase const& typed_array, u32 length, u32 begin, u32 end, Direction direction, Value search_element, bool nan_is_equal)
+{
+    if (typed_array.content_type() != TypedArrayBase::ContentType::Number)
+        return {};
+
+    // NOTE: Getting the index to start at may have run user code that shrunk or detached the underlying buffer,
+    //       in which case the missing elements behave like undefined.
+    auto typed_array_record = make_typed_array_with_buffer_witness_record(typed_array, ArrayBuffer::Order::Unordered);
+    if (is_typed_array_out_of_bounds(typed_array_record) || typed_array_length(typed_array_record) < length)
+        return {};
+
+    // A Number is never equal to anything but another Number.
+    if (!search_element.is_number())
+        return Optional<u32> {};
+
+    switch (typed_array.kind()) {
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type) \
+    case TypedArrayBase::Kind::ClassName:                                           \
+        return fast_typed_array_find_number<Type>(typed_array, begin, end, direction, search_element.as_double(), nan_is_equal);
+        JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+    }
+    VERIFY_NOT_REACHED();
+}
+
 // 23.2.3.16 %TypedArray%.prototype.includes ( searchElement [ , fromIndex ] ), https://tc39.es/ecma262/#sec-%typedarray%.prototype.includes
 JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::includes)
 {
@@ -917,6 +963,9 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::includes)
         k = relative_k;
     }
 
+    if (auto result = fast_typed_array_find(*typed_array, length, k, length, Direction::Ascending, search_element, true); result.has_value())
+        return Value { result->has_value() };
+
     // 11. Repeat, while k < len,
     while (k < length) {
         // a. Let elementK be ! Get(O, ! ToString(𝔽(k))).
@@ -986,6 +1035,9 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::index_of)
         k = relative_k;
     }
 
+    if (auto result = fast_typed_array_find(*typed_array, length, k, length, Direction::Ascending, search_element, false); result.has_value())
+        return result->has_value() ? Value { **result } : Value { -1 };
+
     // 11. Repeat, while k < len,
     while (k < length) {
         // a. Let kPresent be ! HasProperty(O, ! ToString(𝔽(k))).
@@ -1123,6 +1175,11 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::last_index_of)
         k = relative_k;
     }
 
+    if (k >= 0) {
+        if (auto result = fast_typed_array_find(*typed_array, length, 0, k + 1, Direction::Descending, search_element, false); result.has_value())
+            return result->has_value() ? Value { **result } : Value { -1 };
+    }
+
     // 9. Repeat, while k ≥ 0,
     while (k >= 0) {
         // a. Let kPresent be ! HasProperty(O, ! ToString(𝔽(k))).
@@ -1338,6 +1395,15 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::reduce_right)
     return accumulator;
 }
 
+// NOTE: This function assumes that the TypedArray is neither out of bounds nor detached.
+template<typename T>
+static void fast_typed_array_reverse(TypedArrayBase& typed_array, u32 length)
+{
+    auto* data = reinterpret_cast<T*>(typed_array.viewed_array_buffer()->buffer().offset_pointer(typed_array.byte_offset()));
+    for (u32 lower = 0; lower < length / 2; ++lower)
+        swap(data[lower], data[length - lower - 1]);
+}
+
 // 23.2.3.25 %TypedArray%.prototype.reverse ( ), https://tc39.es/ecma262/#sec-%typedarray%.prototype.reverse
 JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::reverse)
 {
@@ -1353,6 +1419,24 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::reverse)
     // 4. Let middle be floor(len / 2).
     auto middle = length / 2;
 
+    // OPTIMIZATION: Nothing can observe the order in which elements are swapped, so we can swap their bytes directly.
+    switch (typed_array->element_size()) {
+    case 1:
+        fast_typed_array_reverse<u8>(*typed_array, length);
+        return typed_array;
+    case 2:
+        fast_typed_array_reverse<u16>(*typed_array, length);
+        return typed_array;
+    case 4:
+        fast_typed_array_reverse<u32>(*typed_array, length);
+        return typed_array;
+    case 8:
+        fast_typed_array_reverse<u64>(*typed_array, length);
+        return typed_array;
+    default:
+        break;
+    }
+
     // 5. Let lower be 0.
     // 6. Repeat, while lower ≠ middle,
     for (u32 lower = 0; lower != middle; ++lower) {
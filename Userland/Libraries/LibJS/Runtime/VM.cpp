@@ -27,6 +27,7 @@
 #include <LibJS/Runtime/Iterator.h>
 #include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/PromiseCapability.h>
+#include <LibJS/Runtime/RegExpObject.h>
 #include <LibJS/Runtime/Reference.h>
 #include <LibJS/Runtime/Symbol.h>
 #include <LibJS/Runtime/VM.h>
@@ -65,6 +66,7 @@ VM::VM(OwnPtr<CustomData> custom_data, ErrorMessages error_messages)
     : m_heap(*this)
     , m_error_messages(move(error_messages))
     , m_custom_data(move(custom_data))
+    , m_regexp_cache(make<RegExpCache>())
 {
     m_bytecode_interpreter = make<Bytecode::Interpreter>(*this);
 
@@ -201,6 +203,43 @@ struct ExecutionContextRootsCollector : public Cell::Visitor {
     HashTable<GCPtr<Cell>> roots;
 };
 
+// Scripts shorter than this are cheap enough to parse that caching them isn't worth the memory.
+static constexpr size_t minimum_source_length_for_parsed_script_cache = 1 * KiB;
+static constexpr size_t max_number_of_parsed_scripts_to_remember = 16;
+
+RefPtr<Program> VM::find_parsed_script(StringView source_text, StringView filename, size_t line_number_offset)
+{
+    if (source_text.length() < minimum_source_length_for_parsed_script_cache)
+        return nullptr;
+
+    for (size_t i = 0; i < m_parsed_script_cache.size(); ++i) {
+        auto& entry = m_parsed_script_cache[i];
+        if (entry.line_number_offset != line_number_offset || entry.filename != filename)
+            continue;
+        if (entry.program->source_code().code().bytes_as_string_view() != source_text)
+            continue;
+
+        // Keep the cache ordered from most to least recently used.
+        auto program = entry.program;
+        if (i != 0) {
+            auto moved_entry = m_parsed_script_cache.take(i);
+            m_parsed_script_cache.prepend(move(moved_entry));
+        }
+        return program;
+    }
+    return nullptr;
+}
+
+void VM::did_parse_script(NonnullRefPtr<Program> program, StringView filename, size_t line_number_offset)
+{
+    if (program->source_code().code().bytes().size() < minimum_source_length_for_parsed_script_cache)
+        return;
+
+    if (m_parsed_script_cache.size() == max_number_of_parsed_scripts_to_remember)
+        m_parsed_script_cache.take_last();
+    m_parsed_script_cache.prepend({ filename, line_number_offset, move(program) });
+}
+
 void VM::gather_roots(HashMap<Cell*, HeapRoot>& roots)
 {
     roots.set(m_empty_string, HeapRoot { .type = HeapRoot::Type::VM });
@@ -714,6 +753,8 @@ void VM::push_execution_context(ExecutionContext& context)
 {
     if (!m_execution_context_stack.is_empty())
         m_execution_context_stack.last()->program_counter = bytecode_interpreter().program_counter();
+    if (m_sampling_profiler) [[unlikely]]
+        m_sampling_profiler->take_sample_if_requested();
     m_execution_context_stack.append(&context);
 }
 
@@ -750,6 +791,16 @@ static RefPtr<CachedSourceRange> get_source_range(ExecutionContext const* contex
     return context->cached_source_range;
 }
 
+void VM::start_sampling_profiler(AK::Duration interval)
+{
+    m_sampling_profiler = make<SamplingProfiler>(*this, interval);
+}
+
+OwnPtr<SamplingProfiler> VM::stop_sampling_profiler()
+{
+    return move(m_sampling_profiler);
+}
+
 Vector<StackTraceElement> VM::stack_trace() const
 {
     Vector<StackTraceElement> stack_trace;
@@ -25,6 +25,7 @@
 #include <LibJS/Runtime/ErrorTypes.h>
 #include <LibJS/Runtime/ExecutionContext.h>
 #include <LibJS/Runtime/Promise.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/Value.h>
 
 namespace JS {
@@ -75,6 +76,11 @@ public:
         return m_byte_string_cache;
     }
 
+    RefPtr<Program> find_parsed_script(StringView source_text, StringView filename, size_t line_number_offset);
+    void did_parse_script(NonnullRefPtr<Program>, StringView filename, size_t line_number_offset);
+
+    RegExpCache& regexp_cache() { return *m_regexp_cache; }
+
     PrimitiveString& empty_string() { return *m_empty_string; }
 
     PrimitiveString& single_ascii_character_string(u8 character)
@@ -278,6 +284,10 @@ public:
 
     Vector<StackTraceElement> stack_trace() const;
 
+    SamplingProfiler* sampling_profiler() { return m_sampling_profiler.ptr(); }
+    void start_sampling_profiler(AK::Duration interval = SamplingProfiler::default_interval);
+    OwnPtr<SamplingProfiler> stop_sampling_profiler();
+
 private:
     using ErrorMessages = AK::Array<String, to_underlying(ErrorMessage::__Count)>;
 
@@ -337,7 +347,19 @@ private:
 
     OwnPtr<Bytecode::Interpreter> m_bytecode_interpreter;
 
+    OwnPtr<SamplingProfiler> m_sampling_profiler;
+
     bool m_dynamic_imports_allowed { false };
+
+    // NOTE: This must come after m_heap, as the cached programs hold handles to their bytecode executables.
+    struct ParsedScript {
+        ByteString filename;
+        size_t line_number_offset { 0 };
+        NonnullRefPtr<Program> program;
+    };
+    Vector<ParsedScript> m_parsed_script_cache;
+
+    NonnullOwnPtr<RegExpCache> m_regexp_cache;
 };
 
 template<typename GlobalObjectType, typename... Args>
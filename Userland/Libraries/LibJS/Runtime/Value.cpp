@@ -205,15 +205,34 @@ static void number_to_string_impl(StringBuilder& builder, double d, NumberToStri
     builder.append(exponent_digits.data(), exponent_length);
 }
 
+// OPTIMIZATION: Integral doubles in the safe integer range are by far the most common numbers, and are always formatted
+//               as their plain decimal digits (n ≤ 21 in step 6), so they can skip the shortest round-trip conversion.
+static Optional<i64> as_safe_integer(double d)
+{
+    constexpr double max_safe_integer = 9007199254740991.0;
+    if (!(d >= -max_safe_integer && d <= max_safe_integer))
+        return {};
+    auto integer = static_cast<i64>(d);
+    if (static_cast<double>(integer) != d)
+        return {};
+    return integer;
+}
+
 String number_to_string(double d, NumberToStringMode mode)
 {
+    if (auto integer = as_safe_integer(d); integer.has_value())
+        return String::number(*integer);
+
     StringBuilder builder;
     number_to_string_impl(builder, d, mode);
-    return builder.to_string().release_value();
+    return builder.to_string_without_validation();
 }
 
 ByteString number_to_byte_string(double d, NumberToStringMode mode)
 {
+    if (auto integer = as_safe_integer(d); integer.has_value())
+        return ByteString::number(*integer);
+
     StringBuilder builder;
     number_to_string_impl(builder, d, mode);
     return builder.to_byte_string();
@@ -656,6 +675,30 @@ static Optional<NumberParseResult> parse_number_text(StringView text)
     return result;
 }
 
+static Optional<double> parse_short_decimal_integer(StringView text)
+{
+    // Up to 15 digits always fit in a double's 53-bit mantissa.
+    constexpr size_t max_exactly_representable_digits = 15;
+
+    bool negative = false;
+    if (text.starts_with('-') || text.starts_with('+')) {
+        negative = text[0] == '-';
+        text = text.substring_view(1);
+    }
+    if (text.is_empty() || text.length() > max_exactly_representable_digits)
+        return {};
+
+    u64 integer = 0;
+    for (auto character : text) {
+        if (!is_ascii_digit(character))
+            return {};
+        integer = integer * 10 + parse_ascii_digit(character);
+    }
+
+    auto value = static_cast<double>(integer);
+    return negative ? -value : value;
+}
+
 // 7.1.4.1.1 StringToNumber ( str ), https://tc39.es/ecma262/#sec-stringtonumber
 double string_to_number(StringView string)
 {
@@ -670,6 +713,11 @@ double string_to_number(StringView string)
     if (text == "-Infinity"sv)
         return -INFINITY;
 
+    // OPTIMIZATION: Short decimal integers with an optional sign are exactly representable, and by far the most common
+    //               input, so they skip the general parser.
+    if (auto integer = parse_short_decimal_integer(text); integer.has_value())
+        return *integer;
+
     auto result = parse_number_text(text);
 
     // 3. If literal is a List of errors, return NaN.
@@ -899,6 +947,8 @@ ThrowCompletionOr<PropertyKey> Value::to_property_key(VM& vm) const
     }
 
     // 3. Return ! ToString(key).
+    if (key.is_string())
+        return PropertyKey { key.as_string().deprecated_fly_string() };
     return MUST(key.to_byte_string(vm));
 }
 
@@ -17,6 +17,12 @@ JS_DEFINE_ALLOCATOR(Script);
 // 16.1.5 ParseScript ( sourceText, realm, hostDefined ), https://tc39.es/ecma262/#sec-parse-script
 Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView source_text, Realm& realm, StringView filename, HostDefined* host_defined, size_t line_number_offset)
 {
+    // OPTIMIZATION: Documents often evaluate the exact same script text more than once (reloads, the same library
+    //               in several frames, etc.) Parsing has no side effects, so we can hand out a previously parsed
+    //               Program instead. This also lets us reuse the bytecode already generated for its functions.
+    if (auto program = realm.vm().find_parsed_script(source_text, filename, line_number_offset))
+        return realm.heap().allocate_without_realm<Script>(realm, filename, program.release_nonnull(), host_defined);
+
     // 1. Let script be ParseText(sourceText, Script).
     auto parser = Parser(Lexer(source_text, filename, line_number_offset));
     auto script = parser.parse_program();
@@ -25,6 +31,8 @@ Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView sourc
     if (parser.has_errors())
         return parser.errors();
 
+    realm.vm().did_parse_script(script, filename, line_number_offset);
+
     // 3. Return Script Record { [[Realm]]: realm, [[ECMAScriptCode]]: script, [[HostDefined]]: hostDefined }.
     return realm.heap().allocate_without_realm<Script>(realm, filename, move(script), host_defined);
 }
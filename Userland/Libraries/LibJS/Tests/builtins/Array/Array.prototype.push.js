@@ -20,4 +20,28 @@ describe("normal behavior", () => {
         expect(a.push(1, 2, 3)).toBe(5);
         expect(a).toEqual(["hello", "friends", 1, 2, 3]);
     });
+
+    test("setters on the prototype chain are called for new indices", () => {
+        var a = [1, 2];
+        var setterCalls = 0;
+        Object.defineProperty(Array.prototype, 2, {
+            set() {
+                ++setterCalls;
+            },
+            configurable: true,
+        });
+        try {
+            expect(a.push(3)).toBe(3);
+            expect(setterCalls).toBe(1);
+            expect(a.hasOwnProperty(2)).toBeFalse();
+        } finally {
+            delete Array.prototype[2];
+        }
+    });
+
+    test("non-extensible arrays", () => {
+        var a = Object.preventExtensions([1, 2]);
+        expect(() => a.push(3)).toThrow(TypeError);
+        expect(a).toEqual([1, 2]);
+    });
 });
@@ -201,4 +201,25 @@ describe("Array.prototype.sort", () => {
         );
         Array.prototype.sort.call(obj);
     });
+
+    test("int32 arrays are sorted by their string representation", () => {
+        var arr = [10, 9, -2147483648, 2147483647, 1, -1, 0, -10, 100, 9];
+        expect(arr.sort()).toBe(arr);
+        expect(arr).toEqual([-1, -10, -2147483648, 0, 1, 10, 100, 2147483647, 9, 9]);
+
+        // Once a non-int32 value has been stored, the array must keep sorting correctly.
+        arr = [3, 20, 1];
+        arr[1] = 1.5;
+        expect(arr.sort()).toEqual([1, 1.5, 3]);
+
+        // Holes must still be filled in from the prototype chain.
+        arr = [3, 2, 1];
+        delete arr[1];
+        Object.prototype[1] = 0;
+        try {
+            expect(arr.sort()).toEqual([0, 1, 3]);
+        } finally {
+            delete Object.prototype[1];
+        }
+    });
 });
@@ -64,3 +64,17 @@ test("Invalid lengths", () => {
         Array.prototype.splice.call(obj, 0);
     }).toThrowWithMessage(RangeError, "Invalid array length");
 });
+
+test("Growing and shrinking packed arrays", () => {
+    var array = [1, 2, 3, 4, 5];
+    expect(array.splice(1, 2, "a", "b", "c", "d")).toEqual([2, 3]);
+    expect(array).toEqual([1, "a", "b", "c", "d", 4, 5]);
+
+    expect(array.splice(2, 4)).toEqual(["b", "c", "d", 4]);
+    expect(array).toEqual([1, "a", 5]);
+    expect(array.length).toBe(3);
+
+    expect(array.splice(0)).toEqual([1, "a", 5]);
+    expect(array).toEqual([]);
+    expect(array.length).toBe(0);
+});
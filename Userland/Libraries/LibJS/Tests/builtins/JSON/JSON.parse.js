@@ -30,6 +30,21 @@ test("syntax errors", () => {
         '{ "foo": "bar",}',
         '{ "foo": "bar", }',
         "",
+        "-",
+        "01",
+        "1.",
+        "1e",
+        "1e+",
+        ".5",
+        '"unterminated',
+        '"bad escape \\x"',
+        '"bad unicode escape \\u12"',
+        '"control\ncharacter"',
+        '"trailing backslash\\',
+        "[1 2]",
+        '{"foo" 1}',
+        "tru",
+        "nulll",
     ].forEach(test => {
         expect(() => {
             JSON.parse(test);
@@ -37,6 +52,29 @@ test("syntax errors", () => {
     });
 });
 
+test("strings", () => {
+    expect(JSON.parse('"\\"\\\\\\/\\b\\f\\n\\r\\t"')).toBe('"\\/\b\f\n\r\t');
+    expect(JSON.parse('"\\u0041\\u00e9\\u4e2d"')).toBe("Aé中");
+    expect(JSON.parse('"\\ud834\\udd1e"')).toBe("𝄞");
+    expect(JSON.parse('"before \\n after"')).toBe("before \n after");
+    expect(JSON.parse('"ünïcödé"')).toBe("ünïcödé");
+    expect(JSON.parse('""')).toBe("");
+});
+
+test("nested values and duplicate keys", () => {
+    expect(JSON.parse(' { "a" : [ 1 , { "b" : null } , [ ] , { } ] , "c" : -1.5e3 } ')).toEqual({
+        a: [1, { b: null }, [], {}],
+        c: -1500,
+    });
+
+    const object = JSON.parse('{"a":1,"b":2,"a":3}');
+    expect(Object.keys(object)).toEqual(["a", "b"]);
+    expect(object.a).toBe(3);
+
+    expect(Object.getPrototypeOf(JSON.parse('{"__proto__":[]}'))).toBe(Object.prototype);
+    expect(Object.keys(JSON.parse('{"1":true,"0":false}'))).toEqual(["0", "1"]);
+});
+
 test("negative zero", () => {
     ["-0", " \n-0", "-0  \t", "\n\t -0\n   ", "-0.0"].forEach(testCase => {
         expect(JSON.parse(testCase)).toEqual(-0.0);
@@ -71,6 +71,56 @@ describe("correct behavior", () => {
         expect(JSON.stringify("\ud83d\ud83d\ude04\ud83d\ude04\ude04")).toBe('"\\ud83d😄😄\\ude04"');
         expect(JSON.stringify("\ude04\ud83d\ude04\ud83d\ude04\ud83d")).toBe('"\\ude04😄😄\\ud83d"');
     });
+
+    test("plain objects and arrays", () => {
+        const o = { b: 1, a: [1, -2.5, "x", null, true, undefined, Symbol()], 1: "one", 0: { c: {} } };
+        o.d = undefined;
+        o.e = [[], [[]], { f: "\n\"" }];
+        expect(JSON.stringify(o)).toBe(
+            '{"0":{"c":{}},"1":"one","b":1,"a":[1,-2.5,"x",null,true,null,null],"e":[[],[[]],{"f":"\\n\\""}]}'
+        );
+        expect(JSON.stringify([NaN, -0, 1e21, 2 ** 31])).toBe("[null,0,1e+21,2147483648]");
+        expect(JSON.stringify([1, , 3])).toBe("[1,null,3]");
+        expect(JSON.stringify({ 2: "b", 0: "a", 5: "c" })).toBe('{"0":"a","2":"b","5":"c"}');
+    });
+
+    test("plain objects and arrays with observable property access", () => {
+        const withGetter = {
+            a: 1,
+            get b() {
+                return 2;
+            },
+        };
+        expect(JSON.stringify({ nested: withGetter })).toBe('{"nested":{"a":1,"b":2}}');
+
+        Array.prototype[1] = "from prototype";
+        expect(JSON.stringify([0, , 2])).toBe('[0,"from prototype",2]');
+        delete Array.prototype[1];
+
+        Object.prototype.toJSON = function () {
+            return Array.isArray(this) ? "array" : "object";
+        };
+        expect(JSON.stringify({ a: [] })).toBe('"object"');
+        delete Object.prototype.toJSON;
+
+        Array.prototype.toJSON = () => "array";
+        expect(JSON.stringify({ a: [1, 2] })).toBe('{"a":"array"}');
+        delete Array.prototype.toJSON;
+
+        expect(JSON.stringify({ a: { toJSON: () => 42 } })).toBe('{"a":42}');
+        expect(JSON.stringify({ a: new Number(1), b: new String("s"), c: [new Boolean(true)] })).toBe(
+            '{"a":1,"b":"s","c":[true]}'
+        );
+        expect(JSON.stringify(Object.setPrototypeOf(new Number(3), Object.prototype))).toBe("null");
+        expect(JSON.stringify(Reflect.construct(String, ["s"], Object))).toBe('"[object String]"');
+        expect(JSON.stringify({ a: Object.setPrototypeOf([1, 2], Object.prototype) })).toBe('{"a":[1,2]}');
+    });
+
+    test("deeply nested plain objects", () => {
+        let deep = {};
+        for (let i = 0; i < 300; ++i) deep = { a: [deep] };
+        expect(JSON.stringify(deep)).toBe('{"a":['.repeat(300) + "{}" + "]}".repeat(300));
+    });
 });
 
 describe("errors", () => {
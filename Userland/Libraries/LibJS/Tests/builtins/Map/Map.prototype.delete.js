@@ -82,4 +82,29 @@ describe("modification with active iterators", () => {
         expect(iterator.next()).toBeIteratorResultDone();
         expect(iterator.next()).toBeIteratorResultDone();
     });
+
+    test("iterators keep their place when many elements are deleted", () => {
+        const map = new Map();
+        for (let i = 0; i < 100; ++i) map.set(i, i);
+
+        const iterator = map.keys();
+        for (let i = 0; i < 10; ++i) expect(iterator.next()).toBeIteratorResultWithValue(i);
+
+        // Delete most of the elements on both sides of the iterator.
+        for (let i = 0; i < 100; ++i) {
+            if (i % 10 !== 0) expect(map.delete(i)).toBeTrue();
+        }
+        expect(map).toHaveSize(10);
+
+        map.set(5, "new");
+
+        for (let i = 10; i < 100; i += 10) expect(iterator.next()).toBeIteratorResultWithValue(i);
+        expect(iterator.next()).toBeIteratorResultWithValue(5);
+        expect(iterator.next()).toBeIteratorResultDone();
+
+        expect(Array.from(map.keys())).toEqual([0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 5]);
+        expect(map.get(90)).toBe(90);
+        expect(map.get(5)).toBe("new");
+        expect(map.has(1)).toBeFalse();
+    });
 });
@@ -13,6 +13,32 @@ describe("correct behavior", () => {
     test("length", () => {
         expect(Number.prototype.toLocaleString).toHaveLength(0);
     });
+
+    test("repeated calls with different locales", () => {
+        for (let i = 0; i < 3; ++i) {
+            expect((12345.5).toLocaleString("en")).toBe("12,345.5");
+            expect((12345.5).toLocaleString("de")).toBe("12.345,5");
+            expect((12345.5).toLocaleString("en", { maximumFractionDigits: 0 })).toBe("12,346");
+            expect(() => (1).toLocaleString("a-")).toThrowWithMessage(
+                RangeError,
+                "a- is not a structurally valid language tag"
+            );
+        }
+    });
+
+    test("options are read on every call", () => {
+        let getterCalls = 0;
+        const options = {
+            get useGrouping() {
+                ++getterCalls;
+                return false;
+            },
+        };
+
+        expect((12345).toLocaleString("en", options)).toBe("12345");
+        expect((12345).toLocaleString("en", options)).toBe("12345");
+        expect(getterCalls).toBe(2);
+    });
 });
 
 describe("special values", () => {
@@ -66,3 +66,23 @@ test("Incorrectly escaped code units not converted to invalid patterns", () => {
     expect(re.test("⫀")).toBeTrue();
     expect(re.test("\\u2abe")).toBeFalse(); // ⫀ is \u2abe
 });
+
+test("regexps created from the same pattern don't share state", () => {
+    const first = new RegExp("a+", "g");
+    const second = new RegExp("a+", "g");
+    expect(first.exec("aa aaa")[0]).toBe("aa");
+    expect(first.lastIndex).toBe(2);
+    expect(second.lastIndex).toBe(0);
+    expect(second.exec("aaa")[0]).toBe("aaa");
+    expect(first.exec("aa aaa")[0]).toBe("aaa");
+
+    expect(new RegExp("a+", "i").test("AA")).toBeTrue();
+    expect(new RegExp("a+").test("AA")).toBeFalse();
+
+    for (let i = 0; i < 2; ++i) {
+        const literal = /a+/g;
+        expect(literal.lastIndex).toBe(0);
+        expect(literal.exec("baa")[0]).toBe("aa");
+        expect(new RegExp("a+", "g").exec("ba")[0]).toBe("a");
+    }
+});
@@ -212,3 +212,27 @@ test("string coercion", () => {
     expect(result[0]).toBe("1");
     expect(result.index).toBe(0);
 });
+
+test("patterns starting with a literal", () => {
+    const text = "x".repeat(1000) + " see http://a/ and https://example.com/path " + "y".repeat(1000);
+
+    let result = /https?:\/\/([a-z.]+)\//.exec(text);
+    expect(result.index).toBe(1005);
+    expect(result[1]).toBe("a");
+
+    result = /https:\/\/([a-z.]+)\//.exec(text);
+    expect(result.index).toBe(1019);
+    expect(result[1]).toBe("example.com");
+
+    const global = /y{3}/g;
+    global.lastIndex = 1500;
+    expect(global.exec(text).index).toBe(1500);
+
+    expect(/ftp:/.exec(text)).toBeNull();
+    expect(/\d+px/.exec("width: 120px")[0]).toBe("120px");
+
+    const sticky = /ab/y;
+    expect(sticky.exec("cab")).toBeNull();
+    sticky.lastIndex = 1;
+    expect(sticky.exec("cab")[0]).toBe("ab");
+});
@@ -29,3 +29,21 @@ test("UTF-16", () => {
     expect(s.indexOf("\ude00")).toBe(1);
     expect(s.indexOf("a")).toBe(-1);
 });
+
+test("search across the pieces of a concatenated string", () => {
+    const makeString = () => {
+        let s = "";
+        for (const piece of ["hel", "lo ", "f", "r", "iends", " \ud83d", "\ude00"]) s += piece;
+        return s;
+    };
+
+    expect(makeString().indexOf("hello")).toBe(0);
+    expect(makeString().indexOf("lo fri")).toBe(3);
+    expect(makeString().indexOf("friends")).toBe(6);
+    expect(makeString().indexOf("friends", 7)).toBe(-1);
+    expect(makeString().indexOf("s 😀")).toBe(12);
+    expect(makeString().indexOf("😀")).toBe(14);
+    expect(makeString().indexOf("\ude00")).toBe(15);
+    expect(makeString().indexOf("", 16)).toBe(16);
+    expect(makeString().indexOf("enemies")).toBe(-1);
+});
@@ -25,3 +25,20 @@ test("UTF-16", () => {
     expect(s.slice(0, 1)).toBe("\ud83d");
     expect(s.slice(0, 2)).toBe("😀");
 });
+
+test("slicing a concatenated string", () => {
+    const makeString = () => {
+        let s = "";
+        for (const piece of ["hel", "lo ", "f", "r", "iends", " \ud83d", "\ude00"]) s += piece;
+        return s;
+    };
+
+    expect(makeString()).toHaveLength(16);
+    expect(makeString().slice(2, 8)).toBe("llo fr");
+    expect(makeString().slice(6, 13)).toBe("friends");
+    expect(makeString().slice(-2)).toBe("😀");
+    expect(makeString().slice(-3, -1)).toBe(" \ud83d");
+    expect(makeString().charAt(6)).toBe("f");
+    expect(makeString().charCodeAt(15)).toBe(0xde00);
+    expect(makeString()[4]).toBe("o");
+});
@@ -75,3 +75,22 @@ test("basic functionality", () => {
         expect(typedArray[2]).toBe(0n);
     });
 });
+
+test("filling with values that aren't int32", () => {
+    const float64 = new Float64Array(5);
+    expect(float64.fill(0.5, 1, 4)).toEqual(new Float64Array([0, 0.5, 0.5, 0.5, 0]));
+    expect(float64.fill(-0)).toBe(float64);
+    expect(Object.is(float64[4], -0)).toBeTrue();
+
+    const float32 = new Float32Array(3).fill(0.1);
+    expect(float32[2]).toBe(Math.fround(0.1));
+
+    const uint8 = new Uint8Array(37).fill(257.5);
+    expect(uint8.every(element => element === 1)).toBeTrue();
+
+    const int16 = new Int16Array(9).fill(-2, 2);
+    expect(int16).toEqual(new Int16Array([0, 0, -2, -2, -2, -2, -2, -2, -2]));
+
+    const bigint = new BigInt64Array(6).fill(-3n, 1, 5);
+    expect(bigint).toEqual(new BigInt64Array([0n, -3n, -3n, -3n, -3n, 0n]));
+});
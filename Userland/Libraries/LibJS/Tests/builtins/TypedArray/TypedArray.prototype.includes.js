@@ -62,3 +62,37 @@ test("basic functionality", () => {
         expect(typedArray.includes(2n, -2)).toBe(true);
     });
 });
+
+test("values that can't be stored in the element type", () => {
+    expect(new Uint8Array([0, 1, 255]).includes(256)).toBeFalse();
+    expect(new Uint8Array([0, 1, 255]).includes(1.5)).toBeFalse();
+    expect(new Uint8Array([0, 1, 255]).includes(-0)).toBeTrue();
+    expect(new Int8Array([-128, 0, 127]).includes(-129)).toBeFalse();
+    expect(new Int8Array([-128, 0, 127]).includes(-128)).toBeTrue();
+    expect(new Uint32Array([4294967295]).includes(4294967295)).toBeTrue();
+    expect(new Float32Array([0.1]).includes(0.1)).toBeFalse();
+    expect(new Float32Array([0.5]).includes(0.5)).toBeTrue();
+    expect(new Float32Array([Infinity]).includes(Infinity)).toBeTrue();
+    expect(new Float32Array([3.4028234663852886e38]).includes(1e39)).toBeFalse();
+    expect(new Int32Array([1, 2]).includes("1")).toBeFalse();
+    expect(new Int32Array([1, 2]).includes(undefined)).toBeFalse();
+});
+
+test("NaN", () => {
+    expect(new Float32Array([1, NaN]).includes(NaN)).toBeTrue();
+    expect(new Float64Array([1, NaN]).includes(NaN)).toBeTrue();
+    expect(new Float64Array([1, 2]).includes(NaN)).toBeFalse();
+    expect(new Int32Array([0]).includes(NaN)).toBeFalse();
+});
+
+test("buffer shrinking while getting fromIndex", () => {
+    const arrayBuffer = new ArrayBuffer(4, { maxByteLength: 8 });
+    const typedArray = new Uint8Array(arrayBuffer);
+    const fromIndex = {
+        valueOf() {
+            arrayBuffer.resize(2);
+            return 0;
+        },
+    };
+    expect(typedArray.includes(undefined, fromIndex)).toBeTrue();
+});
@@ -62,3 +62,22 @@ test("basic functionality", () => {
         expect(typedArray.indexOf(2n, -2)).toBe(1);
     });
 });
+
+test("searching without going through each element", () => {
+    const typedArray = new Float64Array([1, -0, NaN, 0.5, 1]);
+    expect(typedArray.indexOf(1)).toBe(0);
+    expect(typedArray.indexOf(0)).toBe(1);
+    expect(typedArray.indexOf(NaN)).toBe(-1);
+    expect(typedArray.indexOf(0.5)).toBe(3);
+    expect(typedArray.indexOf(1, 1)).toBe(4);
+    expect(typedArray.indexOf("1")).toBe(-1);
+    expect(typedArray.lastIndexOf(1)).toBe(4);
+    expect(typedArray.lastIndexOf(1, 3)).toBe(0);
+    expect(typedArray.lastIndexOf(-0)).toBe(1);
+    expect(typedArray.lastIndexOf(NaN)).toBe(-1);
+
+    const clamped = new Uint8ClampedArray([300, 255, -5]);
+    expect(clamped.indexOf(255)).toBe(0);
+    expect(clamped.indexOf(0)).toBe(2);
+    expect(clamped.lastIndexOf(255)).toBe(1);
+});
@@ -85,3 +85,13 @@ describe("basic functionality", () => {
         });
     });
 });
+
+test("elements keep their exact values", () => {
+    expect(new Float64Array([0.1, -0, 3]).reverse()).toEqual(new Float64Array([3, -0, 0.1]));
+    expect(new Uint8Array([1, 2, 3, 4, 5]).reverse()).toEqual(new Uint8Array([5, 4, 3, 2, 1]));
+    expect(new BigInt64Array([1n, -2n]).reverse()).toEqual(new BigInt64Array([-2n, 1n]));
+
+    const subarray = new Int16Array([1, 2, 3, 4, 5]).subarray(1, 4);
+    expect(subarray.reverse()).toEqual(new Int16Array([4, 3, 2]));
+    expect(new Int16Array(subarray.buffer)).toEqual(new Int16Array([1, 4, 3, 2, 5]));
+});
@@ -16,3 +16,139 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic inline cache returns the right property for each shape", () => {
+    function get(o) {
+        return o.value;
+    }
+    function set(o, value) {
+        o.value = value;
+    }
+
+    let objects = [
+        { value: 0 },
+        { a: 1, value: 1 },
+        { a: 1, b: 2, value: 2 },
+        { a: 1, b: 2, c: 3, value: 3 },
+        { a: 1, b: 2, c: 3, d: 4, value: 4 },
+        { a: 1, b: 2, c: 3, d: 4, e: 5, value: 5 },
+    ];
+
+    for (let i = 0; i < 3; ++i) {
+        for (let j = 0; j < objects.length; ++j) {
+            expect(get(objects[j])).toBe(j + i * 10);
+            set(objects[j], j + (i + 1) * 10);
+        }
+    }
+});
+
+test("Polymorphic inline cache sees prototype chain changes", () => {
+    class A {
+        method() {
+            return "A";
+        }
+    }
+    class B {
+        method() {
+            return "B";
+        }
+    }
+
+    function call(o) {
+        return o.method();
+    }
+
+    let a = new A();
+    let b = new B();
+    expect(call(a)).toBe("A");
+    expect(call(b)).toBe("B");
+
+    B.prototype.method = () => "B2";
+    expect(call(a)).toBe("A");
+    expect(call(b)).toBe("B2");
+});
+
+test("Inline cache for setter found in prototype chain", () => {
+    class A {
+        set value(v) {
+            this.stored = "A" + v;
+        }
+    }
+
+    function assign(o, v) {
+        o.value = v;
+    }
+
+    let a = new A();
+    assign(a, 1);
+    expect(a.stored).toBe("A1");
+    assign(a, 2);
+    expect(a.stored).toBe("A2");
+
+    Object.defineProperty(A.prototype, "value", {
+        set(v) {
+            this.stored = "B" + v;
+        },
+    });
+    assign(a, 3);
+    expect(a.stored).toBe("B3");
+
+    Object.defineProperty(A.prototype, "value", { value: 0, writable: true });
+    assign(a, 4);
+    expect(a.stored).toBe("B3");
+    expect(Object.getOwnPropertyDescriptor(a, "value").value).toBe(4);
+});
+
+test("Functions that only return a property see shape and prototype changes", () => {
+    function getX() {
+        return this.x;
+    }
+    const readY = o => o.y;
+
+    const proto = { x: "proto" };
+    const o = Object.create(proto);
+    o.y = 1;
+
+    for (let i = 0; i < 3; ++i) {
+        expect(getX.call(o)).toBe("proto");
+        expect(readY(o)).toBe(1);
+    }
+
+    proto.x = "changed";
+    expect(getX.call(o)).toBe("changed");
+
+    o.x = "own";
+    expect(getX.call(o)).toBe("own");
+
+    Object.defineProperty(o, "y", { get: () => "getter" });
+    expect(readY(o)).toBe("getter");
+
+    expect(readY({ y: 2 })).toBe(2);
+    expect(readY({ a: 0, y: 3 })).toBe(3);
+    expect(readY("string")).toBeUndefined();
+    expect(() => readY(null)).toThrowWithMessage(TypeError, `Cannot access property "y" on null object "o"`);
+});
+
+test("Functions that only return the length of a parameter", () => {
+    const length = a => a.length;
+
+    const array = [1, 2, 3];
+    expect(length(array)).toBe(3);
+    array.push(4);
+    expect(length(array)).toBe(4);
+    expect(length("hello")).toBe(5);
+    expect(length({ length: 42 })).toBe(42);
+});
+
+test("Functions that only return a parameter", () => {
+    const identity = x => x;
+    function second(a, b) {
+        return b;
+    }
+
+    expect(identity(1)).toBe(1);
+    expect(identity()).toBeUndefined();
+    expect(second(1, 2)).toBe(2);
+    expect(second(1)).toBeUndefined();
+    expect([1, 2, 3].map(identity)).toEqual([1, 2, 3]);
+});
@@ -0,0 +1,44 @@
+// NOTE: The operands are passed through a function so that the bytecode generator can't fold them.
+const compute = (f, lhs, rhs) => f(lhs, rhs);
+
+test("overflowing int32 arithmetic produces doubles", () => {
+    expect(compute((a, b) => a + b, 2147483647, 1)).toBe(2147483648);
+    expect(compute((a, b) => a - b, -2147483648, 1)).toBe(-2147483649);
+    expect(compute((a, b) => a * b, 65536, 65536)).toBe(4294967296);
+    expect(compute((a, b) => a * b, -2147483648, -1)).toBe(2147483648);
+});
+
+test("int32 multiplication producing negative zero", () => {
+    expect(compute((a, b) => a * b, -1, 0)).toBe(-0);
+    expect(compute((a, b) => a * b, 0, -5)).toBe(-0);
+    expect(compute((a, b) => a * b, 0, 5)).toBe(0);
+    expect(compute((a, b) => a * b, 0, 0)).toBe(0);
+});
+
+test("int32 modulo", () => {
+    expect(compute((a, b) => a % b, 10, 3)).toBe(1);
+    expect(compute((a, b) => a % b, 2147483647, 2)).toBe(1);
+    expect(compute((a, b) => a % b, 0, 5)).toBe(0);
+    expect(compute((a, b) => a % b, -4, 2)).toBe(-0);
+    expect(compute((a, b) => a % b, -7, 3)).toBe(-1);
+    expect(compute((a, b) => a % b, 7, -3)).toBe(1);
+    expect(compute((a, b) => a % b, 1, 0)).toBeNaN();
+    expect(compute((a, b) => a % b, -2147483648, -1)).toBe(-0);
+});
+
+test("int32 and double operands mixed in one loop", () => {
+    let sum = 0;
+    let product = 1;
+    let bits = 0;
+    for (let i = 0; i < 40; ++i) {
+        sum = sum + (i % 2 ? i : i + 0.5);
+        product = product * (i % 3 ? 2 : 1);
+        bits = bits ^ (i << i % 31);
+    }
+    expect(sum).toBe(790);
+    expect(product).toBe(2 ** 26);
+    expect(bits).toBe(1996960457);
+    expect(compute((a, b) => a < b, 1, 1.5)).toBeTrue();
+    expect(compute((a, b) => a >= b, "2", 1)).toBeTrue();
+    expect(compute((a, b) => a & b, 3.7, 1)).toBe(1);
+});
@@ -0,0 +1,24 @@
+test("Don't crash on super.length in a function that has no other .length accesses", () => {
+    class A {
+        get length() {
+            return 42;
+        }
+    }
+
+    class B extends A {
+        superLength() {
+            return super.length;
+        }
+    }
+
+    expect(new B().superLength()).toBe(42);
+
+    const o = {
+        __proto__: [1, 2, 3],
+        superLength() {
+            return super.length;
+        },
+    };
+
+    expect(o.superLength()).toBe(3);
+});
@@ -292,3 +292,54 @@ describe("await observably looks up constructor of Promise objects", () => {
     runQueuedPromiseJobs();
     expect(calls).toBe(4);
 });
+
+test("many awaits in one async function, mixing fulfillment and rejection", () => {
+    const log = [];
+    async function worker(name) {
+        for (let i = 0; i < 3; ++i) {
+            try {
+                log.push(`${name}:${await (i % 2 ? Promise.reject(i) : i)}`);
+            } catch (error) {
+                log.push(`${name}:caught ${error}`);
+            }
+        }
+        return name;
+    }
+
+    let results = null;
+    Promise.all([worker("a"), worker("b")]).then(values => {
+        results = values;
+    });
+    runQueuedPromiseJobs();
+
+    expect(log).toEqual(["a:0", "b:0", "a:caught 1", "b:caught 1", "a:2", "b:2"]);
+    expect(results).toEqual(["a", "b"]);
+});
+
+test("locals and constants survive being resumed after an await", () => {
+    async function accumulate() {
+        let total = 0;
+        const prefix = "total";
+        for (let i = 1; i <= 100; ++i) total += await i;
+        return `${prefix}: ${total}, ${1.5 + (await 0.25)}`;
+    }
+
+    async function rethrow() {
+        await null;
+        await Promise.reject(new Error("boom"));
+        return "unreachable";
+    }
+
+    let accumulated = null;
+    let rejection = null;
+    accumulate().then(value => {
+        accumulated = value;
+    });
+    rethrow().catch(error => {
+        rejection = error.message;
+    });
+    runQueuedPromiseJobs();
+
+    expect(accumulated).toBe("total: 5050, 1.75");
+    expect(rejection).toBe("boom");
+});
@@ -155,4 +155,101 @@ DecoderErrorOr<ColorConverter> ColorConverter::create(u8 bit_depth, CodingIndepe
     return ColorConverter(bit_depth, input_cicp, should_skip_color_remapping, should_tonemap, input_conversion_matrix, to_linear_lookup_table, color_primaries_matrix_4x4, to_non_linear_lookup_table);
 }
 
+Optional<FixedPointColorConverter> FixedPointColorConverter::create(u8 bit_depth, CodingIndependentCodePoints input_cicp, CodingIndependentCodePoints output_cicp)
+{
+    // Larger values could overflow the fixed-point math.
+    if (bit_depth > 12)
+        return {};
+
+    if (input_cicp.color_primaries() != output_cicp.color_primaries())
+        return {};
+
+    switch (input_cicp.transfer_characteristics()) {
+    case TransferCharacteristics::SMPTE2084:
+    case TransferCharacteristics::HLG:
+        return {};
+    default:
+        break;
+    }
+
+    // These are the same coefficients that ColorConverter uses, for U and V in the range of -1..1.
+    float v_to_red;
+    float u_to_green;
+    float v_to_green;
+    float u_to_blue;
+    switch (input_cicp.matrix_coefficients()) {
+    case MatrixCoefficients::BT470BG:
+    case MatrixCoefficients::BT601:
+        v_to_red = 0.70100f;
+        u_to_green = -0.17207f;
+        v_to_green = -0.35707f;
+        u_to_blue = 0.88600f;
+        break;
+    case MatrixCoefficients::BT709:
+        v_to_red = 0.78740f;
+        u_to_green = -0.09366f;
+        v_to_green = -0.23406f;
+        u_to_blue = 0.92780f;
+        break;
+    case MatrixCoefficients::BT2020ConstantLuminance:
+    case MatrixCoefficients::BT2020NonConstantLuminance:
+        v_to_red = 0.73730f;
+        u_to_green = -0.08228f;
+        v_to_green = -0.28568f;
+        u_to_blue = 0.94070f;
+        break;
+    default:
+        return {};
+    }
+
+    float maximum_value = (1u << bit_depth) - 1;
+    float y_min = 0.0f;
+    float y_max = maximum_value;
+    float uv_min = 0.0f;
+    float uv_max = maximum_value;
+    if (input_cicp.video_full_range_flag() == VideoFullRangeFlag::Studio) {
+        y_min = 16.0f / 255.0f * maximum_value;
+        y_max = 235.0f / 255.0f * maximum_value;
+        uv_min = y_min;
+        uv_max = 240.0f / 255.0f * maximum_value;
+    }
+    float uv_center = (uv_min + uv_max) / 2.0f;
+
+    // Scale Y to 0..intermediate_maximum, and U and V to -intermediate_maximum..intermediate_maximum, then fold the
+    // offsets of the ranges of Y, U and V into one offset per channel.
+    constexpr float one = 1 << fraction_bits;
+    float y_scale = intermediate_maximum / (y_max - y_min) * one;
+    float uv_scale = 2.0f * intermediate_maximum / (uv_max - uv_min) * one;
+
+    auto to_fixed_point = [](float value) { return static_cast<i32>(AK::round(value)); };
+    Coefficients coefficients {
+        .y = to_fixed_point(y_scale),
+        .v_to_red = to_fixed_point(v_to_red * uv_scale),
+        .u_to_green = to_fixed_point(u_to_green * uv_scale),
+        .v_to_green = to_fixed_point(v_to_green * uv_scale),
+        .u_to_blue = to_fixed_point(u_to_blue * uv_scale),
+        .red_offset = 0,
+        .green_offset = 0,
+        .blue_offset = 0,
+    };
+
+    // The offsets include rounding the results to the nearest integer.
+    float y_offset = -y_min * y_scale + one / 2.0f;
+    coefficients.red_offset = to_fixed_point(y_offset - uv_center * v_to_red * uv_scale);
+    coefficients.green_offset = to_fixed_point(y_offset - uv_center * (u_to_green + v_to_green) * uv_scale);
+    coefficients.blue_offset = to_fixed_point(y_offset - uv_center * u_to_blue * uv_scale);
+
+    if (input_cicp.transfer_characteristics() == output_cicp.transfer_characteristics())
+        return FixedPointColorConverter(coefficients, {});
+
+    Array<u8, intermediate_maximum + 1> transfer_lookup;
+    for (size_t i = 0; i < transfer_lookup.size(); i++) {
+        auto value = static_cast<float>(i) / intermediate_maximum;
+        value = TransferCharacteristicsConversion::to_linear_luminance(value, input_cicp.transfer_characteristics());
+        value = TransferCharacteristicsConversion::to_non_linear_luminance(max(0.0f, value), output_cicp.transfer_characteristics());
+        transfer_lookup[i] = static_cast<u8>(clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+    return FixedPointColorConverter(coefficients, transfer_lookup);
+}
+
 }
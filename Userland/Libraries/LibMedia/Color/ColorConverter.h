@@ -8,6 +8,8 @@
 
 #include <AK/Array.h>
 #include <AK/Function.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibMedia/Color/CodingIndependentCodePoints.h>
@@ -150,99 +152,6 @@ public:
         return Gfx::Color(r, g, b);
     }
 
-    // Fast conversion of 8-bit YUV to full-range RGB.
-    template<MatrixCoefficients MC, VideoFullRangeFlag FR, Unsigned T>
-    static ALWAYS_INLINE Gfx::Color convert_simple_yuv_to_rgb(T y_in, T u_in, T v_in)
-    {
-        static constexpr i32 bit_depth = 8;
-        static constexpr i32 maximum_value = (1 << bit_depth) - 1;
-        static constexpr i32 one = 1 << 14;
-        static constexpr auto fraction = [](i32 numerator, i32 denominator) constexpr {
-            auto temp = static_cast<i64>(numerator) * one;
-            return static_cast<i32>(temp / denominator);
-        };
-        static constexpr auto coef = [](i32 hundred_thousandths) constexpr {
-            return fraction(hundred_thousandths, 100'000);
-        };
-        static constexpr auto multiply = [](i32 a, i32 b) constexpr {
-            return (a * b) / one;
-        };
-
-        struct RangeFactors {
-            i32 y_offset, y_scale;
-            i32 uv_offset, uv_scale;
-        };
-
-        constexpr auto range_factors = [] {
-            RangeFactors range_factors;
-
-            i32 min = 0;
-            i32 y_max = 255;
-            i32 uv_max = 255;
-
-            if constexpr (FR == VideoFullRangeFlag::Studio) {
-                min = 16;
-                y_max = 235;
-                uv_max = 240;
-            }
-
-            range_factors.y_offset = -min * maximum_value / 255;
-            range_factors.y_scale = fraction(255, y_max - min);
-            range_factors.uv_offset = -((min + uv_max) * maximum_value) / (255 * 2);
-            range_factors.uv_scale = fraction(255, uv_max - min) * 2;
-
-            range_factors.y_scale = multiply(range_factors.y_scale, fraction(255, maximum_value));
-            range_factors.uv_scale = multiply(range_factors.uv_scale, fraction(255, maximum_value));
-
-            return range_factors;
-        }();
-
-        i32 y = y_in + range_factors.y_offset;
-        i32 u = u_in + range_factors.uv_offset;
-        i32 v = v_in + range_factors.uv_offset;
-
-        i32 red;
-        i32 green;
-        i32 blue;
-
-        constexpr i32 y_scale = range_factors.y_scale;
-        constexpr i32 uv_scale = range_factors.uv_scale;
-
-        // The equations below will have the following effects:
-        //  - Scale the Y, U and V values into the range 0...maximum_value*one for these fixed-point operations.
-        //  - Scale the values by the color range defined by VideoFullRangeFlag.
-        //  - Scale the U and V values by 2 to put them in the actual YCbCr coordinate space.
-        //  - Multiply by the YCbCr coefficients to convert to RGB.
-        if constexpr (MC == MatrixCoefficients::BT709) {
-            red = y * y_scale + v * multiply(coef(78740), uv_scale);
-            green = y * y_scale + u * multiply(coef(-9366), uv_scale) + v * multiply(coef(-23406), uv_scale);
-            blue = y * y_scale + u * multiply(coef(92780), uv_scale);
-        }
-
-        if constexpr (MC == MatrixCoefficients::BT601) {
-            red = y * y_scale + v * multiply(coef(70100), uv_scale);
-            green = y * y_scale + u * multiply(coef(-17207), uv_scale) + v * multiply(coef(-35707), uv_scale);
-            blue = y * y_scale + u * multiply(coef(88600), uv_scale);
-        }
-
-        if constexpr (MC == MatrixCoefficients::BT2020ConstantLuminance) {
-            red = y * y_scale + v * multiply(coef(73730), uv_scale);
-            green = y * y_scale + u * multiply(coef(-8228), uv_scale) + v * multiply(coef(-28568), uv_scale);
-            blue = y * y_scale + u * multiply(coef(94070), uv_scale);
-        }
-
-        red = clamp(red, 0, maximum_value * one);
-        green = clamp(green, 0, maximum_value * one);
-        blue = clamp(blue, 0, maximum_value * one);
-
-        // This compiles down to a bit shift if maximum_value == 255
-        red /= fraction(maximum_value, 255);
-        green /= fraction(maximum_value, 255);
-        blue /= fraction(maximum_value, 255);
-
-        return Gfx::Color(u8(red), u8(green), u8(blue));
-    }
-
 private:
     static constexpr size_t to_linear_size = 64;
     static constexpr size_t to_non_linear_size = 64;
@@ -269,4 +178,107 @@ private:
     InterpolatedLookupTable<to_non_linear_size> m_to_non_linear_lookup;
 };
 
+// Converts YUV to RGB with fixed-point math, four pixels at a time. This works for the common matrices as long as the
+// color primaries don't change and no tonemapping is needed, as converting between the transfer functions then only
+// depends on each channel by itself, and can be precomputed into a lookup table.
+class FixedPointColorConverter final {
+public:
+    static Optional<FixedPointColorConverter> create(u8 bit_depth, CodingIndependentCodePoints input_cicp, CodingIndependentCodePoints output_cicp);
+
+    template<Unsigned T>
+    ALWAYS_INLINE void convert_row(T const* y_row, T const* u_row, T const* v_row, u32* output, size_t width) const
+    {
+        size_t column = 0;
+        for (; column + 4 <= width; column += 4)
+            convert_four(&y_row[column], &u_row[column], &v_row[column], &output[column]);
+
+        if (column == width)
+            return;
+
+        // Pad the last pixels so that they can go through the same path.
+        Array<T, 4> y_rest {};
+        Array<T, 4> u_rest {};
+        Array<T, 4> v_rest {};
+        Array<u32, 4> output_rest {};
+        auto rest = width - column;
+        for (size_t i = 0; i < rest; i++) {
+            y_rest[i] = y_row[column + i];
+            u_rest[i] = u_row[column + i];
+            v_rest[i] = v_row[column + i];
+        }
+        convert_four(y_rest.data(), u_rest.data(), v_rest.data(), output_rest.data());
+        for (size_t i = 0; i < rest; i++)
+            output[column + i] = output_rest[i];
+    }
+
+private:
+    // The fixed-point values have this many fractional bits.
+    static constexpr i32 fraction_bits = 14;
+
+    // The RGB values are calculated with this many bits before either looking them up or scaling them down to 8 bits.
+    static constexpr i32 intermediate_bits = 12;
+    static constexpr i32 intermediate_maximum = (1 << intermediate_bits) - 1;
+
+    struct Coefficients {
+        i32 y;
+        i32 v_to_red;
+        i32 u_to_green;
+        i32 v_to_green;
+        i32 u_to_blue;
+        i32 red_offset;
+        i32 green_offset;
+        i32 blue_offset;
+    };
+
+    FixedPointColorConverter(Coefficients coefficients, Optional<Array<u8, intermediate_maximum + 1>> transfer_lookup)
+        : m_coefficients(coefficients)
+        , m_transfer_lookup(move(transfer_lookup))
+    {
+    }
+
+    template<Unsigned T>
+    ALWAYS_INLINE void convert_four(T const* y_in, T const* u_in, T const* v_in, u32* output) const
+    {
+        using namespace AK::SIMD;
+        using InputVector = Conditional<IsSame<T, u8>, u8x4, u16x4>;
+        static_assert(sizeof(T) <= sizeof(u16));
+
+        auto y = to_i32x4(load_unaligned<InputVector>(y_in));
+        auto u = to_i32x4(load_unaligned<InputVector>(u_in));
+        auto v = to_i32x4(load_unaligned<InputVector>(v_in));
+
+        auto const& c = m_coefficients;
+        auto y_term = y * c.y;
+        i32x4 red = (y_term + v * c.v_to_red + c.red_offset) >> fraction_bits;
+        i32x4 green = (y_term + u * c.u_to_green + v * c.v_to_green + c.green_offset) >> fraction_bits;
+        i32x4 blue = (y_term + u * c.u_to_blue + c.blue_offset) >> fraction_bits;
+
+        auto clamp_to_intermediate = [](i32x4 value) -> i32x4 {
+            return value < 0 ? 0 : (value > intermediate_maximum ? intermediate_maximum : value);
+        };
+        red = clamp_to_intermediate(red);
+        green = clamp_to_intermediate(green);
+        blue = clamp_to_intermediate(blue);
+
+        if (m_transfer_lookup.has_value()) {
+            auto const& lookup = *m_transfer_lookup;
+            for (size_t i = 0; i < 4; i++) {
+                red[i] = lookup[red[i]];
+                green[i] = lookup[green[i]];
+                blue[i] = lookup[blue[i]];
+            }
+        } else {
+            red >>= intermediate_bits - 8;
+            green >>= intermediate_bits - 8;
+            blue >>= intermediate_bits - 8;
+        }
+
+        auto pixels = 0xff000000u | (to_u32x4(red) << 16) | (to_u32x4(green) << 8) | to_u32x4(blue);
+        store_unaligned(output, pixels);
+    }
+
+    Coefficients m_coefficients;
+    Optional<Array<u8, intermediate_maximum + 1>> m_transfer_lookup;
+};
+
 }
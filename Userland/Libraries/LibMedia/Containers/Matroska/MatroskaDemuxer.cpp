@@ -25,6 +25,11 @@ DecoderErrorOr<NonnullOwnPtr<MatroskaDemuxer>> MatroskaDemuxer::from_data(Readon
     return make<MatroskaDemuxer>(TRY(Reader::from_data(data)));
 }
 
+DecoderErrorOr<NonnullOwnPtr<MatroskaDemuxer>> MatroskaDemuxer::from_streamed_data(NonnullRefPtr<StreamedMediaData> streamed_data)
+{
+    return make<MatroskaDemuxer>(TRY(Reader::from_streamed_data(move(streamed_data))));
+}
+
 DecoderErrorOr<Vector<Track>> MatroskaDemuxer::get_tracks_for_type(TrackType type)
 {
     TrackEntry::TrackType matroska_track_type;
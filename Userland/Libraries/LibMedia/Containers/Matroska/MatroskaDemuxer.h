@@ -15,12 +15,11 @@ namespace Media::Matroska {
 
 class MatroskaDemuxer final : public Demuxer {
 public:
-    // FIXME: We should instead accept some abstract data streaming type so that the demuxer
-    //        can work with non-contiguous data.
     static DecoderErrorOr<NonnullOwnPtr<MatroskaDemuxer>> from_file(StringView filename);
     static DecoderErrorOr<NonnullOwnPtr<MatroskaDemuxer>> from_mapped_file(NonnullOwnPtr<Core::MappedFile> mapped_file);
 
     static DecoderErrorOr<NonnullOwnPtr<MatroskaDemuxer>> from_data(ReadonlyBytes data);
+    static DecoderErrorOr<NonnullOwnPtr<MatroskaDemuxer>> from_streamed_data(NonnullRefPtr<StreamedMediaData> streamed_data);
 
     MatroskaDemuxer(Reader&& reader)
         : m_reader(move(reader))
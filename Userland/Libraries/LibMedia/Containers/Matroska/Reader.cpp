@@ -17,7 +17,24 @@
 
 namespace Media::Matroska {
 
-#define TRY_READ(expression) DECODER_TRY(DecoderErrorCategory::Corrupted, expression)
+// NOTE: Reads of streamed data that hasn't been received yet fail with EAGAIN. Since they can succeed later, they must
+//       not be reported as corruption.
+static DecoderError decoder_error_from_read_error(Error error, SourceLocation location = SourceLocation::current())
+{
+    if (error.is_errno() && error.code() == EAGAIN)
+        return DecoderError::with_description(DecoderErrorCategory::NeedsMoreInput, "Media data has not been received yet"sv);
+    return DecoderError::from_source_location(DecoderErrorCategory::Corrupted, error.string_literal(), location);
+}
+
+#define TRY_READ(expression)                                                                    \
+    ({                                                                                          \
+        auto&& _read_result = ((expression));                                                   \
+        if (_read_result.is_error()) [[unlikely]]                                               \
+            return decoder_error_from_read_error(_read_result.release_error());                 \
+        static_assert(!::AK::Detail::IsLvalueReference<decltype(_read_result.release_value())>, \
+            "Do not return a reference from a fallible expression");                            \
+        _read_result.release_value();                                                           \
+    })
 
 // RFC 8794 - Extensible Binary Meta Language
 // https://datatracker.ietf.org/doc/html/rfc8794
@@ -106,6 +123,14 @@ DecoderErrorOr<Reader> Reader::from_data(ReadonlyBytes data)
     return reader;
 }
 
+DecoderErrorOr<Reader> Reader::from_streamed_data(NonnullRefPtr<StreamedMediaData> streamed_data)
+{
+    Reader reader(streamed_data->bytes());
+    reader.m_streamed_data = move(streamed_data);
+    TRY(reader.parse_initial_data());
+    return reader;
+}
+
 // Returns the position of the first element that is read from this master element.
 static DecoderErrorOr<size_t> parse_master_element(Streamer& streamer, [[maybe_unused]] StringView element_name, Function<DecoderErrorOr<IterationDecision>(u64)> element_consumer)
 {
@@ -190,7 +215,7 @@ static DecoderErrorOr<EBMLHeader> parse_ebml_header(Streamer& streamer)
 
 DecoderErrorOr<void> Reader::parse_initial_data()
 {
-    Streamer streamer { m_data };
+    Streamer streamer { m_data, m_streamed_data.ptr() };
     auto first_element_id = TRY_READ(streamer.read_variable_size_integer(false));
     dbgln_if(MATROSKA_TRACE_DEBUG, "First element ID is {:#010x}\n", first_element_id);
     if (first_element_id != EBML_MASTER_ELEMENT_ID)
@@ -267,7 +292,7 @@ DecoderErrorOr<Optional<size_t>> Reader::find_first_top_level_element_with_id([[
         return m_seek_entries.get(element_id).release_value();
     }
 
-    Streamer streamer { m_data };
+    Streamer streamer { m_data, m_streamed_data.ptr() };
     if (m_last_top_level_element_position != 0)
         TRY_READ(streamer.seek_to_position(m_last_top_level_element_position));
     else
@@ -294,8 +319,10 @@ DecoderErrorOr<Optional<size_t>> Reader::find_first_top_level_element_with_id([[
         }
 
         auto result = streamer.read_unknown_element();
-        if (result.is_error())
-            return DecoderError::format(DecoderErrorCategory::Corrupted, "While seeking to {}: {}", element_name, result.release_error().string_literal());
+        if (result.is_error()) {
+            auto error = decoder_error_from_read_error(result.release_error());
+            return DecoderError::format(error.category(), "While seeking to {}: {}", element_name, error.description());
+        }
 
         m_last_top_level_element_position = streamer.position();
 
@@ -351,7 +378,7 @@ DecoderErrorOr<SegmentInformation> Reader::segment_information()
     auto position = TRY(find_first_top_level_element_with_id("Segment Information"sv, SEGMENT_INFORMATION_ELEMENT_ID));
     if (!position.has_value())
         return DecoderError::corrupted("No Segment Information element found"sv);
-    Streamer streamer { m_data };
+    Streamer streamer { m_data, m_streamed_data.ptr() };
     TRY_READ(streamer.seek_to_position(position.release_value()));
     m_segment_information = TRY(parse_information(streamer));
     return m_segment_information.value();
@@ -364,7 +391,7 @@ DecoderErrorOr<void> Reader::ensure_tracks_are_parsed()
     auto position = TRY(find_first_top_level_element_with_id("Tracks"sv, TRACK_ELEMENT_ID));
     if (!position.has_value())
         return DecoderError::corrupted("No Tracks element found"sv);
-    Streamer streamer { m_data };
+    Streamer streamer { m_data, m_streamed_data.ptr() };
     TRY_READ(streamer.seek_to_position(position.release_value()));
     TRY(parse_tracks(streamer));
     return {};
@@ -691,7 +718,7 @@ DecoderErrorOr<SampleIterator> Reader::create_sample_iterator(u64 track_number)
     auto position = optional_position.value() - get_element_id_size(CLUSTER_ELEMENT_ID) - m_segment_contents_position;
 
     dbgln_if(MATROSKA_DEBUG, "Creating sample iterator starting at {} relative to segment at {}", position, m_segment_contents_position);
-    return SampleIterator(this->m_mapped_file, segment_view, TRY(track_for_track_number(track_number)), TRY(segment_information()).timestamp_scale(), position);
+    return SampleIterator(this->m_mapped_file, m_streamed_data, segment_view, TRY(track_for_track_number(track_number)), TRY(segment_information()).timestamp_scale(), position);
 }
 
 static DecoderErrorOr<CueTrackPosition> parse_cue_track_position(Streamer& streamer)
@@ -700,7 +727,7 @@ static DecoderErrorOr<CueTrackPosition> parse_cue_track_position(Streamer& strea
 
     bool had_cluster_position = false;
 
-    TRY_READ(parse_master_element(streamer, "CueTrackPositions"sv, [&](u64 element_id) -> DecoderErrorOr<IterationDecision> {
+    TRY(parse_master_element(streamer, "CueTrackPositions"sv, [&](u64 element_id) -> DecoderErrorOr<IterationDecision> {
         switch (element_id) {
         case CUE_TRACK_ID:
             track_position.set_track_number(TRY_READ(streamer.read_u64()));
@@ -762,7 +789,7 @@ static DecoderErrorOr<CuePoint> parse_cue_point(Streamer& streamer, u64 timestam
             break;
         }
         case CUE_TRACK_POSITIONS_ID: {
-            auto track_position = TRY_READ(parse_cue_track_position(streamer));
+            auto track_position = TRY(parse_cue_track_position(streamer));
             DECODER_TRY_ALLOC(cue_point.track_positions().try_set(track_position.track_number(), track_position));
             break;
         }
@@ -818,9 +845,13 @@ DecoderErrorOr<void> Reader::ensure_cues_are_parsed()
     if (m_cues_have_been_parsed)
         return {};
     auto position = TRY(find_first_top_level_element_with_id("Cues"sv, CUES_ID));
-    if (!position.has_value())
-        return DecoderError::corrupted("No Tracks element found"sv);
-    Streamer streamer { m_data };
+    if (!position.has_value()) {
+        // Cues are optional, without them we seek by searching through the clusters.
+        m_cues.clear();
+        m_cues_have_been_parsed = true;
+        return {};
+    }
+    Streamer streamer { m_data, m_streamed_data.ptr() };
     TRY_READ(streamer.seek_to_position(position.release_value()));
     TRY(parse_cues(streamer));
     m_cues_have_been_parsed = true;
@@ -938,7 +969,7 @@ DecoderErrorOr<Block> SampleIterator::next_block()
     if (m_position >= m_data.size())
         return DecoderError::with_description(DecoderErrorCategory::EndOfStream, "Still at end of stream :^)"sv);
 
-    Streamer streamer { m_data };
+    Streamer streamer { m_data, m_streamed_data.ptr() };
     TRY_READ(streamer.seek_to_position(m_position));
 
     Optional<Block> block;
@@ -980,7 +1011,7 @@ DecoderErrorOr<void> SampleIterator::seek_to_cue_point(CuePoint const& cue_point
 {
     // This is a private function. The position getter can return optional, but the caller should already know that this track has a position.
     auto const& cue_position = cue_point.position_for_track(m_track->track_number()).release_value();
-    Streamer streamer { m_data };
+    Streamer streamer { m_data, m_streamed_data.ptr() };
     TRY_READ(streamer.seek_to_position(cue_position.cluster_position()));
 
     auto element_id = TRY_READ(streamer.read_variable_size_integer(false));
@@ -1000,6 +1031,7 @@ ErrorOr<ByteString> Streamer::read_string()
     auto string_length = TRY(read_variable_size_integer());
     if (remaining() < string_length)
         return Error::from_string_literal("String length extends past the end of the stream");
+    TRY(ensure_octets_are_available(string_length));
     auto string_data = data_as_chars();
     auto string_value = ByteString(string_data, strnlen(string_data, string_length));
     TRY(read_raw_octets(string_length));
@@ -1012,6 +1044,7 @@ ErrorOr<u8> Streamer::read_octet()
         dbgln_if(MATROSKA_TRACE_DEBUG, "Ran out of stream data");
         return Error::from_string_literal("Stream is out of data");
     }
+    TRY(ensure_octets_are_available(1));
     u8 byte = *data();
     m_octets_read.last()++;
     m_position++;
@@ -1082,10 +1115,19 @@ ErrorOr<ReadonlyBytes> Streamer::read_raw_octets(size_t num_octets)
 {
     if (remaining() < num_octets)
         return Error::from_string_literal("Tried to drop octets past the end of the stream");
+    TRY(ensure_octets_are_available(num_octets));
     ReadonlyBytes result = { data(), num_octets };
+    MUST(skip_octets(num_octets));
+    return result;
+}
+
+ErrorOr<void> Streamer::skip_octets(size_t num_octets)
+{
+    if (remaining() < num_octets)
+        return Error::from_string_literal("Tried to drop octets past the end of the stream");
     m_position += num_octets;
     m_octets_read.last() += num_octets;
-    return result;
+    return {};
 }
 
 ErrorOr<u64> Streamer::read_u64()
@@ -1122,7 +1164,8 @@ ErrorOr<void> Streamer::read_unknown_element()
 {
     auto element_length = TRY(read_variable_size_integer());
     dbgln_if(MATROSKA_TRACE_DEBUG, "Skipping unknown element of size {}.", element_length);
-    TRY(read_raw_octets(element_length));
+    // NOTE: We don't need the contents, so there's no reason to wait for them to be received.
+    TRY(skip_octets(element_length));
     return {};
 }
 
@@ -1131,7 +1174,22 @@ ErrorOr<void> Streamer::seek_to_position(size_t position)
     if (position >= m_data.size())
         return Error::from_string_literal("Attempted to seek past the end of the stream");
     m_position = position;
+    m_available_end = 0;
     return {};
 }
 
+ErrorOr<void> Streamer::ensure_octets_are_available(size_t num_octets)
+{
+    if (m_streamed_data == nullptr || m_position + num_octets <= m_available_end)
+        return {};
+
+    auto offset_in_resource = static_cast<size_t>(m_data.data() - m_streamed_data->bytes().data()) + m_position;
+    m_available_end = m_position + m_streamed_data->available_size_at(offset_in_resource);
+    if (m_position + num_octets <= m_available_end)
+        return {};
+
+    m_streamed_data->request_data_at(offset_in_resource + (m_available_end - m_position));
+    return Error::from_errno(EAGAIN);
+}
+
 }
@@ -12,6 +12,7 @@
 #include <AK/OwnPtr.h>
 #include <LibCore/MappedFile.h>
 #include <LibMedia/DecoderError.h>
+#include <LibMedia/StreamedMediaData.h>
 
 #include "Document.h"
 
@@ -28,6 +29,9 @@ public:
     static DecoderErrorOr<Reader> from_mapped_file(NonnullOwnPtr<Core::MappedFile> mapped_file);
 
     static DecoderErrorOr<Reader> from_data(ReadonlyBytes data);
+    // Anything that needs data that hasn't been received yet fails with DecoderErrorCategory::NeedsMoreInput after
+    // asking for the data, and can be tried again once more of it has come in.
+    static DecoderErrorOr<Reader> from_streamed_data(NonnullRefPtr<StreamedMediaData>);
 
     EBMLHeader const& header() const { return m_header.value(); }
 
@@ -61,6 +65,7 @@ private:
     DecoderErrorOr<void> seek_to_cue_for_timestamp(SampleIterator&, AK::Duration const&);
 
     RefPtr<Core::SharedMappedFile> m_mapped_file;
+    RefPtr<StreamedMediaData> m_streamed_data;
     ReadonlyBytes m_data;
 
     Optional<EBMLHeader> m_header;
@@ -90,8 +95,9 @@ public:
 private:
     friend class Reader;
 
-    SampleIterator(RefPtr<Core::SharedMappedFile> file, ReadonlyBytes data, TrackEntry& track, u64 timestamp_scale, size_t position)
+    SampleIterator(RefPtr<Core::SharedMappedFile> file, RefPtr<StreamedMediaData> streamed_data, ReadonlyBytes data, TrackEntry& track, u64 timestamp_scale, size_t position)
         : m_file(move(file))
+        , m_streamed_data(move(streamed_data))
         , m_data(data)
         , m_track(track)
         , m_segment_timestamp_scale(timestamp_scale)
@@ -102,6 +108,7 @@ private:
     DecoderErrorOr<void> seek_to_cue_point(CuePoint const& cue_point);
 
     RefPtr<Core::SharedMappedFile> m_file;
+    RefPtr<StreamedMediaData> m_streamed_data;
     ReadonlyBytes m_data;
     NonnullRefPtr<TrackEntry> m_track;
     u64 m_segment_timestamp_scale { 0 };
@@ -116,8 +123,10 @@ private:
 
 class Streamer {
 public:
-    Streamer(ReadonlyBytes data)
+    // If the data is part of streamed data, reads of anything that hasn't been received yet fail with EAGAIN.
+    Streamer(ReadonlyBytes data, StreamedMediaData* streamed_data = nullptr)
         : m_data(data)
+        , m_streamed_data(streamed_data)
     {
     }
 
@@ -161,8 +170,14 @@ public:
     ErrorOr<void> seek_to_position(size_t position);
 
 private:
+    ErrorOr<void> ensure_octets_are_available(size_t num_octets);
+    ErrorOr<void> skip_octets(size_t num_octets);
+
     ReadonlyBytes m_data;
+    StreamedMediaData* m_streamed_data { nullptr };
     size_t m_position { 0 };
+    // The received data extends at least this far from where we last checked.
+    size_t m_available_end { 0 };
     Vector<size_t> m_octets_read { 0 };
 };
 
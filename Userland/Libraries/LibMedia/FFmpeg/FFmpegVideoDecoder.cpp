@@ -10,10 +10,58 @@
 #include "FFmpegHelpers.h"
 #include "FFmpegVideoDecoder.h"
 
+extern "C" {
+#include <libavutil/hwcontext.h>
+}
+
 namespace Media::FFmpeg {
 
-static AVPixelFormat negotiate_output_format(AVCodecContext*, AVPixelFormat const* formats)
+// The hardware decoders are tried in this order, and only those that FFmpeg was built with can be used.
+static constexpr AVHWDeviceType preferred_hardware_device_types[] = {
+    AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+    AV_HWDEVICE_TYPE_D3D11VA,
+    AV_HWDEVICE_TYPE_VAAPI,
+};
+
+static AVPixelFormat hardware_pixel_format(AVCodec const* codec, AVHWDeviceType device_type)
 {
+    for (int i = 0;; i++) {
+        auto const* config = avcodec_get_hw_config(codec, i);
+        if (!config)
+            return AV_PIX_FMT_NONE;
+        if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) != 0 && config->device_type == device_type)
+            return config->pix_fmt;
+    }
+}
+
+// Returns a reference to a device that can decode the codec, or nullptr if there is none, in which case we decode in
+// software.
+static AVBufferRef* create_hardware_device(AVCodec const* codec)
+{
+    for (auto device_type : preferred_hardware_device_types) {
+        if (hardware_pixel_format(codec, device_type) == AV_PIX_FMT_NONE)
+            continue;
+
+        AVBufferRef* device = nullptr;
+        if (av_hwdevice_ctx_create(&device, device_type, nullptr, nullptr, 0) == 0)
+            return device;
+    }
+    return nullptr;
+}
+
+static AVPixelFormat negotiate_output_format(AVCodecContext* codec_context, AVPixelFormat const* formats)
+{
+    // NOTE: The hardware format is only offered if the device can decode this stream, e.g. if it supports the profile.
+    //       Otherwise, FFmpeg falls back to decoding in software into one of the formats below.
+    if (codec_context->hw_device_ctx) {
+        auto const* device_context = reinterpret_cast<AVHWDeviceContext const*>(codec_context->hw_device_ctx->data);
+        auto hardware_format = hardware_pixel_format(codec_context->codec, device_context->type);
+        for (auto const* format = formats; *format >= 0; format++) {
+            if (*format == hardware_format)
+                return hardware_format;
+        }
+    }
+
     while (*formats >= 0) {
         switch (*formats) {
         case AV_PIX_FMT_YUV420P:
@@ -60,6 +108,9 @@ DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create
 
     codec_context->thread_count = static_cast<int>(min(Core::System::hardware_concurrency(), 4));
 
+    // NOTE: The codec context takes ownership of the device, and releases it when it is freed.
+    codec_context->hw_device_ctx = create_hardware_device(codec);
+
     if (!codec_initialization_data.is_empty()) {
         if (codec_initialization_data.size() > NumericLimits<int>::max())
             return DecoderError::corrupted("Codec initialization data is too large"sv);
@@ -98,6 +149,7 @@ FFmpegVideoDecoder::~FFmpegVideoDecoder()
 {
     av_packet_free(&m_packet);
     av_frame_free(&m_frame);
+    av_frame_free(&m_hardware_transfer_frame);
     avcodec_free_context(&m_codec_context);
 }
 
@@ -127,17 +179,43 @@ DecoderErrorOr<void> FFmpegVideoDecoder::receive_sample(AK::Duration timestamp,
     }
 }
 
+DecoderErrorOr<AVFrame const*> FFmpegVideoDecoder::download_hardware_frame()
+{
+    if (!m_frame->hw_frames_ctx)
+        return m_frame;
+
+    if (!m_hardware_transfer_frame) {
+        m_hardware_transfer_frame = av_frame_alloc();
+        if (!m_hardware_transfer_frame)
+            return DecoderError::with_description(DecoderErrorCategory::Memory, "Failed to allocate FFmpeg frame"sv);
+    }
+    av_frame_unref(m_hardware_transfer_frame);
+
+    // NOTE: This lets FFmpeg choose the format, which is NV12 or P010 for the 4:2:0 video that hardware decoders handle.
+    if (av_hwframe_transfer_data(m_hardware_transfer_frame, m_frame, 0) < 0)
+        return DecoderError::with_description(DecoderErrorCategory::Unknown, "Failed to download frame from the hardware decoder"sv);
+    if (av_frame_copy_props(m_hardware_transfer_frame, m_frame) < 0)
+        return DecoderError::with_description(DecoderErrorCategory::Memory, "Failed to copy the properties of the hardware frame"sv);
+
+    if (m_hardware_transfer_frame->format != AV_PIX_FMT_NV12 && m_hardware_transfer_frame->format != AV_PIX_FMT_P010)
+        return DecoderError::format(DecoderErrorCategory::NotImplemented, "Hardware decoder output format {} is not supported", m_hardware_transfer_frame->format);
+
+    return m_hardware_transfer_frame;
+}
+
 DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame()
 {
     auto result = avcodec_receive_frame(m_codec_context, m_frame);
 
     switch (result) {
     case 0: {
-        auto color_primaries = static_cast<ColorPrimaries>(m_frame->color_primaries);
-        auto transfer_characteristics = static_cast<TransferCharacteristics>(m_frame->color_trc);
-        auto matrix_coefficients = static_cast<MatrixCoefficients>(m_frame->colorspace);
+        auto const* decoded_frame = TRY(download_hardware_frame());
+
+        auto color_primaries = static_cast<ColorPrimaries>(decoded_frame->color_primaries);
+        auto transfer_characteristics = static_cast<TransferCharacteristics>(decoded_frame->color_trc);
+        auto matrix_coefficients = static_cast<MatrixCoefficients>(decoded_frame->colorspace);
         auto color_range = [&] {
-            switch (m_frame->color_range) {
+            switch (decoded_frame->color_range) {
             case AVColorRange::AVCOL_RANGE_MPEG:
                 return VideoFullRangeFlag::Studio;
             case AVColorRange::AVCOL_RANGE_JPEG:
@@ -149,14 +227,16 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
         auto cicp = CodingIndependentCodePoints { color_primaries, transfer_characteristics, matrix_coefficients, color_range };
 
         size_t bit_depth = [&] {
-            switch (m_frame->format) {
+            switch (decoded_frame->format) {
             case AV_PIX_FMT_YUV420P:
             case AV_PIX_FMT_YUV422P:
             case AV_PIX_FMT_YUV444P:
+            case AV_PIX_FMT_NV12:
                 return 8;
             case AV_PIX_FMT_YUV420P10:
             case AV_PIX_FMT_YUV422P10:
             case AV_PIX_FMT_YUV444P10:
+            case AV_PIX_FMT_P010:
                 return 10;
             case AV_PIX_FMT_YUV420P12:
             case AV_PIX_FMT_YUV422P12:
@@ -168,10 +248,12 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
         size_t component_size = (bit_depth + 7) / 8;
 
         auto subsampling = [&]() -> Subsampling {
-            switch (m_frame->format) {
+            switch (decoded_frame->format) {
             case AV_PIX_FMT_YUV420P:
             case AV_PIX_FMT_YUV420P10:
             case AV_PIX_FMT_YUV420P12:
+            case AV_PIX_FMT_NV12:
+            case AV_PIX_FMT_P010:
                 return { true, true };
             case AV_PIX_FMT_YUV422P:
             case AV_PIX_FMT_YUV422P10:
@@ -187,30 +269,43 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
             }
         }();
 
-        auto size = Gfx::Size<u32> { m_frame->width, m_frame->height };
+        auto size = Gfx::Size<u32> { decoded_frame->width, decoded_frame->height };
 
-        auto timestamp = AK::Duration::from_microseconds(m_frame->pts);
-        auto frame = DECODER_TRY_ALLOC(SubsampledYUVFrame::try_create(timestamp, size, bit_depth, cicp, subsampling));
+        auto timestamp = AK::Duration::from_microseconds(decoded_frame->pts);
 
         for (u32 plane = 0; plane < 3; plane++) {
-            VERIFY(m_frame->linesize[plane] != 0);
-            if (m_frame->linesize[plane] < 0)
+            if (decoded_frame->linesize[plane] < 0)
                 return DecoderError::with_description(DecoderErrorCategory::NotImplemented, "Reversed scanlines are not supported"sv);
+        }
+
+        // Hardware decoders output the chroma samples interleaved in one plane, which we split while copying them anyway.
+        if (decoded_frame->format == AV_PIX_FMT_NV12 || decoded_frame->format == AV_PIX_FMT_P010) {
+            auto y_stride = static_cast<size_t>(decoded_frame->linesize[0]);
+            auto uv_stride = static_cast<size_t>(decoded_frame->linesize[1]);
+            auto y_data = ReadonlyBytes { decoded_frame->data[0], y_stride * size.height() };
+            auto uv_data = ReadonlyBytes { decoded_frame->data[1], uv_stride * subsampling.subsampled_size(size).height() };
+            return DECODER_TRY_ALLOC(SubsampledYUVFrame::try_create_from_semi_planar_data(timestamp, size, bit_depth, cicp, subsampling, y_data, y_stride, uv_data, uv_stride));
+        }
+
+        auto frame = DECODER_TRY_ALLOC(SubsampledYUVFrame::try_create(timestamp, size, bit_depth, cicp, subsampling));
+
+        for (u32 plane = 0; plane < 3; plane++) {
+            VERIFY(decoded_frame->linesize[plane] != 0);
 
             bool const use_subsampling = plane > 0;
             auto plane_size = (use_subsampling ? subsampling.subsampled_size(size) : size).to_type<size_t>();
 
             auto output_line_size = plane_size.width() * component_size;
-            VERIFY(output_line_size <= static_cast<size_t>(m_frame->linesize[plane]));
+            VERIFY(output_line_size <= static_cast<size_t>(decoded_frame->linesize[plane]));
 
-            auto const* source = m_frame->data[plane];
+            auto const* source = decoded_frame->data[plane];
             VERIFY(source != nullptr);
             auto* destination = frame->get_raw_plane_data(plane);
             VERIFY(destination != nullptr);
 
             for (size_t row = 0; row < plane_size.height(); row++) {
                 memcpy(destination, source, output_line_size);
-                source += m_frame->linesize[plane];
+                source += decoded_frame->linesize[plane];
                 destination += output_line_size;
             }
         }
@@ -27,9 +27,13 @@ public:
 private:
     DecoderErrorOr<void> decode_single_sample(AK::Duration timestamp, u8* data, int size);
 
+    // Returns the frame that was just decoded, after copying it into system memory if it was decoded in hardware.
+    DecoderErrorOr<AVFrame const*> download_hardware_frame();
+
     AVCodecContext* m_codec_context;
     AVPacket* m_packet;
     AVFrame* m_frame;
+    AVFrame* m_hardware_transfer_frame { nullptr };
 };
 
 }
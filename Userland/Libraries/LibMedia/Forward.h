@@ -12,6 +12,7 @@ class DecoderError;
 class FrameQueueItem;
 class PlaybackManager;
 class Sample;
+class StreamedMediaData;
 class Track;
 class VideoDecoder;
 class VideoFrame;
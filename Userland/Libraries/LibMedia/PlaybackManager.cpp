@@ -44,8 +44,15 @@ DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::from_data(Readon
     return create(move(demuxer));
 }
 
-PlaybackManager::PlaybackManager(NonnullOwnPtr<Demuxer>& demuxer, Track video_track, NonnullOwnPtr<VideoDecoder>&& decoder, VideoFrameQueue&& frame_queue)
+DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::from_streamed_data(NonnullRefPtr<StreamedMediaData> streamed_data)
+{
+    auto demuxer = TRY(Matroska::MatroskaDemuxer::from_streamed_data(streamed_data));
+    return create(move(demuxer), move(streamed_data));
+}
+
+PlaybackManager::PlaybackManager(NonnullOwnPtr<Demuxer>& demuxer, Track video_track, NonnullOwnPtr<VideoDecoder>&& decoder, VideoFrameQueue&& frame_queue, RefPtr<StreamedMediaData> streamed_data)
     : m_demuxer(move(demuxer))
+    , m_streamed_data(move(streamed_data))
     , m_selected_video_track(video_track)
     , m_frame_queue(move(frame_queue))
     , m_decoder(move(decoder))
@@ -196,6 +203,14 @@ void PlaybackManager::restart_playback()
     seek_to_timestamp(AK::Duration::zero());
 }
 
+void PlaybackManager::wait_for_more_media_data()
+{
+    // NOTE: We don't wait for long, so that we notice when we are told to stop decoding.
+    static constexpr auto maximum_wait_time = AK::Duration::from_milliseconds(100);
+    VERIFY(m_streamed_data);
+    (void)m_streamed_data->wait_for_data(maximum_wait_time);
+}
+
 void PlaybackManager::decode_and_queue_one_sample()
 {
 #if PLAYBACK_MANAGER_DEBUG
@@ -203,8 +218,17 @@ void PlaybackManager::decode_and_queue_one_sample()
 #endif
 
     FrameQueueItem item_to_enqueue;
+    bool needs_more_media_data = false;
 
     while (item_to_enqueue.is_empty()) {
+        if (needs_more_media_data || m_seek_is_waiting_for_data.load()) {
+            if (m_stop_decoding.load())
+                return;
+            wait_for_more_media_data();
+            needs_more_media_data = false;
+            continue;
+        }
+
         OwnPtr<VideoFrame> decoded_frame = nullptr;
         CodingIndependentCodePoints container_cicp;
 
@@ -214,6 +238,12 @@ void PlaybackManager::decode_and_queue_one_sample()
             // Get a sample to decode.
             auto sample_result = m_demuxer->get_next_sample_for_track(m_selected_video_track);
             if (sample_result.is_error()) {
+                // NOTE: The demuxer has asked for the data it is missing, so we wait for it outside the lock, letting
+                //       the main thread seek in the meantime.
+                if (sample_result.error().category() == DecoderErrorCategory::NeedsMoreInput && m_streamed_data) {
+                    needs_more_media_data = true;
+                    continue;
+                }
                 item_to_enqueue = FrameQueueItem::error_marker(sample_result.release_error(), FrameQueueItem::no_timestamp);
                 break;
             }
@@ -533,6 +563,7 @@ private:
 //        avoid triggering the timer to check the queue constantly. However, doing so may reduce the speed
 //        of seeking due to the decode thread having to wait for a signal to continue decoding.
 constexpr int buffering_or_seeking_decode_wait_time = 1;
+constexpr int seeking_data_wait_time = 50;
 
 class PlaybackManager::BufferingStateHandler : public PlaybackManager::ResumingStateHandler {
     using PlaybackManager::ResumingStateHandler::ResumingStateHandler;
@@ -577,14 +608,27 @@ private:
             earliest_available_sample = min(earliest_available_sample, manager().m_next_frame->timestamp());
         }
 
+        m_waiting_for_data = false;
+
         {
             Threading::MutexLocker demuxer_locker(manager().m_decoder_mutex);
 
             auto demuxer_seek_result = manager().seek_demuxer_to_most_recent_keyframe(m_target_timestamp, earliest_available_sample);
             if (demuxer_seek_result.is_error()) {
+                // The demuxer has asked for the data it needs to seek, which arrives on this thread, so we must let the
+                // event loop run until it does.
+                if (demuxer_seek_result.error().category() == DecoderErrorCategory::NeedsMoreInput && manager().m_streamed_data) {
+                    dbgln_if(PLAYBACK_MANAGER_DEBUG, "Waiting for media data to seek to timestamp target {}ms", m_target_timestamp.to_milliseconds());
+                    manager().m_seek_is_waiting_for_data.store(true);
+                    m_waiting_for_data = true;
+                    manager().set_state_update_timer(seeking_data_wait_time);
+                    return {};
+                }
+                manager().m_seek_is_waiting_for_data.store(false);
                 manager().dispatch_decoder_error(demuxer_seek_result.release_error());
                 return {};
             }
+            manager().m_seek_is_waiting_for_data.store(false);
             auto keyframe_timestamp = demuxer_seek_result.release_value();
 
 #if PLAYBACK_MANAGER_DEBUG
@@ -663,6 +707,9 @@ private:
     // We won't need this override when threaded, the queue can pause us in on_enter().
     ErrorOr<void> do_timed_state_update() override
     {
+        if (m_waiting_for_data)
+            return on_enter();
+
         dbgln_if(PLAYBACK_MANAGER_DEBUG, "Seeking wait finished, attempting to dequeue until timestamp.");
         return skip_samples_until_timestamp();
     }
@@ -671,6 +718,7 @@ private:
 
     AK::Duration m_target_timestamp { AK::Duration::zero() };
     SeekMode m_seek_mode { SeekMode::Accurate };
+    bool m_waiting_for_data { false };
 };
 
 class PlaybackManager::StoppedStateHandler : public PlaybackManager::PlaybackStateHandler {
@@ -699,7 +747,7 @@ private:
     PlaybackState get_state() const override { return PlaybackState::Stopped; }
 };
 
-DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::create(NonnullOwnPtr<Demuxer> demuxer)
+DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::create(NonnullOwnPtr<Demuxer> demuxer, RefPtr<StreamedMediaData> streamed_data)
 {
     auto video_tracks = TRY(demuxer->get_tracks_for_type(TrackType::Video));
     if (video_tracks.is_empty())
@@ -712,7 +760,7 @@ DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::create(NonnullOw
     auto codec_initialization_data = TRY(demuxer->get_codec_initialization_data_for_track(track));
     NonnullOwnPtr<VideoDecoder> decoder = TRY(FFmpeg::FFmpegVideoDecoder::try_create(codec_id, codec_initialization_data));
     auto frame_queue = DECODER_TRY_ALLOC(VideoFrameQueue::create());
-    auto playback_manager = DECODER_TRY_ALLOC(try_make<PlaybackManager>(demuxer, track, move(decoder), move(frame_queue)));
+    auto playback_manager = DECODER_TRY_ALLOC(try_make<PlaybackManager>(demuxer, track, move(decoder), move(frame_queue), move(streamed_data)));
 
     playback_manager->m_state_update_timer = Core::Timer::create_single_shot(0, [&self = *playback_manager] { self.timer_callback(); });
 
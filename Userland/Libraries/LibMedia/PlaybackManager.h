@@ -15,6 +15,7 @@
 #include <LibGfx/Bitmap.h>
 #include <LibMedia/Containers/Matroska/Document.h>
 #include <LibMedia/Demuxer.h>
+#include <LibMedia/StreamedMediaData.h>
 #include <LibThreading/ConditionVariable.h>
 #include <LibThreading/Mutex.h>
 #include <LibThreading/Thread.h>
@@ -115,8 +116,11 @@ public:
     static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_mapped_file(NonnullOwnPtr<Core::MappedFile> file);
 
     static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_data(ReadonlyBytes data);
+    // Fails with DecoderErrorCategory::NeedsMoreInput if the data needed to start playback hasn't been received yet.
+    // Once started, playback waits for the rest of the data as it needs it.
+    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_streamed_data(NonnullRefPtr<StreamedMediaData>);
 
-    PlaybackManager(NonnullOwnPtr<Demuxer>& demuxer, Track video_track, NonnullOwnPtr<VideoDecoder>&& decoder, VideoFrameQueue&& frame_queue);
+    PlaybackManager(NonnullOwnPtr<Demuxer>& demuxer, Track video_track, NonnullOwnPtr<VideoDecoder>&& decoder, VideoFrameQueue&& frame_queue, RefPtr<StreamedMediaData> streamed_data);
     ~PlaybackManager();
 
     void resume_playback();
@@ -155,7 +159,7 @@ private:
     class SeekingStateHandler;
     class StoppedStateHandler;
 
-    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> create(NonnullOwnPtr<Demuxer> demuxer);
+    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> create(NonnullOwnPtr<Demuxer> demuxer, RefPtr<StreamedMediaData> streamed_data = {});
 
     void timer_callback();
     // This must be called with m_demuxer_mutex locked!
@@ -165,6 +169,7 @@ private:
     void set_state_update_timer(int delay_ms);
 
     void decode_and_queue_one_sample();
+    void wait_for_more_media_data();
 
     void dispatch_decoder_error(DecoderError error);
     void dispatch_new_frame(RefPtr<Gfx::Bitmap> frame);
@@ -176,6 +181,7 @@ private:
     AK::Duration m_last_present_in_media_time = AK::Duration::zero();
 
     NonnullOwnPtr<Demuxer> m_demuxer;
+    RefPtr<StreamedMediaData> m_streamed_data;
     Threading::Mutex m_decoder_mutex;
     Track m_selected_video_track;
 
@@ -190,6 +196,8 @@ private:
     Threading::Mutex m_decode_wait_mutex;
     Threading::ConditionVariable m_decode_wait_condition;
     Atomic<bool> m_buffer_is_full { false };
+    // Set while a seek waits for streamed data, so that the decoder doesn't ask for the data at the old position.
+    Atomic<bool> m_seek_is_waiting_for_data { false };
 
     OwnPtr<PlaybackStateHandler> m_playback_handler;
     Optional<FrameQueueItem> m_next_frame;
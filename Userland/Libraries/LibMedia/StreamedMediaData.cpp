@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BinarySearch.h>
+#include <LibCore/EventLoop.h>
+#include <LibMedia/StreamedMediaData.h>
+
+namespace Media {
+
+ErrorOr<NonnullRefPtr<StreamedMediaData>> StreamedMediaData::create(size_t size, RangeRequestCallback range_request_callback, size_t maximum_read_ahead_distance)
+{
+    // NOTE: The buffer is never touched before data is written to it, so the parts that we don't receive don't take up
+    //       any memory.
+    auto data = TRY(ByteBuffer::create_uninitialized(size));
+    return adopt_nonnull_ref_or_enomem(new (nothrow) StreamedMediaData(move(data), move(range_request_callback), maximum_read_ahead_distance));
+}
+
+StreamedMediaData::StreamedMediaData(ByteBuffer data, RangeRequestCallback range_request_callback, size_t maximum_read_ahead_distance)
+    : m_data(move(data))
+    , m_range_request_callback(move(range_request_callback))
+    , m_maximum_read_ahead_distance(maximum_read_ahead_distance)
+    , m_receiving_event_loop(&Core::EventLoop::current())
+    , m_receiving_thread(pthread_self())
+{
+}
+
+void StreamedMediaData::write(size_t offset, ReadonlyBytes bytes)
+{
+    VERIFY(offset <= m_data.size());
+    bytes = bytes.trim(m_data.size() - offset);
+    if (bytes.is_empty())
+        return;
+    bytes.copy_to(m_data.bytes().slice(offset));
+
+    Threading::MutexLocker locker(m_mutex);
+    Range range { offset, offset + bytes.size() };
+
+    // Merge the new range with every range that it overlaps or touches.
+    size_t first_index = 0;
+    while (first_index < m_received_ranges.size() && m_received_ranges[first_index].end < range.start)
+        first_index++;
+    size_t last_index = first_index;
+    while (last_index < m_received_ranges.size() && m_received_ranges[last_index].start <= range.end) {
+        range.start = min(range.start, m_received_ranges[last_index].start);
+        range.end = max(range.end, m_received_ranges[last_index].end);
+        last_index++;
+    }
+    m_received_ranges.remove(first_index, last_index - first_index);
+    m_received_ranges.insert(first_index, range);
+
+    m_receive_position = offset + bytes.size();
+    m_data_received.broadcast();
+}
+
+void StreamedMediaData::did_finish_receiving()
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_receive_position.clear();
+    m_data_received.broadcast();
+}
+
+size_t StreamedMediaData::available_size_at(size_t offset) const
+{
+    Threading::MutexLocker locker(m_mutex);
+    auto* range = binary_search(m_received_ranges, offset, nullptr, [](size_t offset, Range const& range) -> int {
+        if (offset < range.start)
+            return -1;
+        if (offset >= range.end)
+            return 1;
+        return 0;
+    });
+    if (range == nullptr)
+        return 0;
+    return range->end - offset;
+}
+
+bool StreamedMediaData::is_complete() const
+{
+    Threading::MutexLocker locker(m_mutex);
+    return m_received_ranges.size() == 1 && m_received_ranges.first().start == 0 && m_received_ranges.first().end == m_data.size();
+}
+
+void StreamedMediaData::request_data_at(size_t offset)
+{
+    {
+        Threading::MutexLocker locker(m_mutex);
+        if (m_receive_position.has_value() && offset >= m_receive_position.value() && offset - m_receive_position.value() <= m_maximum_read_ahead_distance)
+            return;
+        m_receive_position = offset;
+    }
+
+    if (pthread_equal(pthread_self(), m_receiving_thread)) {
+        m_range_request_callback(offset);
+        return;
+    }
+    m_receiving_event_loop->deferred_invoke([self = NonnullRefPtr(*this), offset] {
+        self->m_range_request_callback(offset);
+    });
+    m_receiving_event_loop->wake();
+}
+
+bool StreamedMediaData::wait_for_data(AK::Duration timeout)
+{
+    VERIFY(!pthread_equal(pthread_self(), m_receiving_thread));
+    Threading::MutexLocker locker(m_mutex);
+    return m_data_received.wait_for(timeout);
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
+#include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/Forward.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <pthread.h>
+
+namespace Media {
+
+// The bytes of a media resource of a known size that is still being received, possibly out of order. This lets a
+// demuxer start on a resource before all of it is there, and ask for the parts it needs next when it seeks.
+//
+// Readers must not touch any part of bytes() before available_size_at() says that it has been received. When they find
+// that they need something that hasn't been, they call request_data_at() and try again later. The data arrives on the
+// thread that created this object, so that thread can never wait for it; other threads can use wait_for_data().
+class StreamedMediaData final : public AtomicRefCounted<StreamedMediaData> {
+public:
+    // Asks for the resource to be received from the given offset onwards, and replaces any previous request. This is
+    // always called on the thread that created the StreamedMediaData.
+    using RangeRequestCallback = Function<void(size_t offset)>;
+
+    // Data that the request underway will get to within the read-ahead distance is waited for, anything further away
+    // is asked for with a new range request.
+    static constexpr size_t default_maximum_read_ahead_distance = 1 * MiB;
+
+    static ErrorOr<NonnullRefPtr<StreamedMediaData>> create(size_t size, RangeRequestCallback, size_t maximum_read_ahead_distance = default_maximum_read_ahead_distance);
+
+    ReadonlyBytes bytes() const { return m_data.bytes(); }
+    size_t size() const { return m_data.size(); }
+
+    // These are for the receiving thread. write() is given the data that the last range request brought in, in order.
+    void write(size_t offset, ReadonlyBytes);
+    void did_finish_receiving();
+
+    // Returns how many bytes starting at the offset are available to read.
+    size_t available_size_at(size_t offset) const;
+    bool is_complete() const;
+
+    void request_data_at(size_t offset);
+
+    // Returns false if nothing was received before the timeout.
+    bool wait_for_data(AK::Duration timeout);
+
+private:
+    StreamedMediaData(ByteBuffer, RangeRequestCallback, size_t maximum_read_ahead_distance);
+
+    struct Range {
+        size_t start { 0 };
+        size_t end { 0 };
+    };
+
+    ByteBuffer m_data;
+    RangeRequestCallback m_range_request_callback;
+    size_t m_maximum_read_ahead_distance { 0 };
+
+    Core::EventLoop* m_receiving_event_loop { nullptr };
+    pthread_t m_receiving_thread;
+
+    mutable Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_data_received { m_mutex };
+
+    // Sorted and never overlapping or touching each other.
+    Vector<Range> m_received_ranges;
+    // Where the next byte of the request that is underway will be written.
+    Optional<size_t> m_receive_position;
+};
+
+}
@@ -62,6 +62,56 @@ ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create_from_d
     return frame;
 }
 
+template<typename T>
+static void copy_semi_planar_data(Gfx::Size<size_t> luma_size, Gfx::Size<size_t> chroma_size, u8 shift, ReadonlyBytes y_data, size_t y_stride, ReadonlyBytes uv_data, size_t uv_stride, T* y_plane, T* u_plane, T* v_plane)
+{
+    auto luma_row_size = luma_size.width() * sizeof(T);
+    auto chroma_row_size = chroma_size.width() * 2 * sizeof(T);
+    VERIFY(luma_row_size <= y_stride);
+    VERIFY(chroma_row_size <= uv_stride);
+    VERIFY(luma_size.height() == 0 || y_data.size() >= (luma_size.height() - 1) * y_stride + luma_row_size);
+    VERIFY(chroma_size.height() == 0 || uv_data.size() >= (chroma_size.height() - 1) * uv_stride + chroma_row_size);
+
+    for (size_t row = 0; row < luma_size.height(); row++) {
+        auto const* source_row = reinterpret_cast<T const*>(y_data.offset_pointer(row * y_stride));
+        auto* destination_row = &y_plane[row * luma_size.width()];
+        if (shift == 0) {
+            memcpy(destination_row, source_row, luma_row_size);
+            continue;
+        }
+        for (size_t column = 0; column < luma_size.width(); column++)
+            destination_row[column] = source_row[column] >> shift;
+    }
+
+    for (size_t row = 0; row < chroma_size.height(); row++) {
+        auto const* source_row = reinterpret_cast<T const*>(uv_data.offset_pointer(row * uv_stride));
+        auto* u_row = &u_plane[row * chroma_size.width()];
+        auto* v_row = &v_plane[row * chroma_size.width()];
+        for (size_t column = 0; column < chroma_size.width(); column++) {
+            u_row[column] = source_row[column * 2] >> shift;
+            v_row[column] = source_row[column * 2 + 1] >> shift;
+        }
+    }
+}
+
+ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create_from_semi_planar_data(
+    AK::Duration timestamp,
+    Gfx::Size<u32> size,
+    u8 bit_depth, CodingIndependentCodePoints cicp,
+    Subsampling subsampling,
+    ReadonlyBytes y_data, size_t y_stride, ReadonlyBytes uv_data, size_t uv_stride)
+{
+    auto frame = TRY(try_create(timestamp, size, bit_depth, cicp, subsampling));
+
+    auto luma_size = size.to_type<size_t>();
+    auto chroma_size = subsampling.subsampled_size(size).to_type<size_t>();
+    if (bit_depth > 8)
+        copy_semi_planar_data<u16>(luma_size, chroma_size, 16 - bit_depth, y_data, y_stride, uv_data, uv_stride, frame->get_plane_data<u16>(0), frame->get_plane_data<u16>(1), frame->get_plane_data<u16>(2));
+    else
+        copy_semi_planar_data<u8>(luma_size, chroma_size, 8 - bit_depth, y_data, y_stride, uv_data, uv_stride, frame->get_plane_data<u8>(0), frame->get_plane_data<u8>(1), frame->get_plane_data<u8>(2));
+    return frame;
+}
+
 SubsampledYUVFrame::~SubsampledYUVFrame()
 {
     free(m_y_buffer);
@@ -102,8 +152,8 @@ ALWAYS_INLINE void interpolate_row(u32 const row, u32 const width, T const* plan
     }
 }
 
-template<u32 subsampling_horizontal, u32 subsampling_vertical, typename T, typename Convert>
-ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert, u32 const width, u32 const height, T const* plane_y, T const* plane_u, T const* plane_v, Gfx::Bitmap& bitmap)
+template<u32 subsampling_horizontal, u32 subsampling_vertical, typename T, typename ConvertRow>
+ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(ConvertRow convert_row, u32 const width, u32 const height, T const* plane_y, T const* plane_u, T const* plane_v, Gfx::Bitmap& bitmap)
 {
     VERIFY(bitmap.width() >= 0);
     VERIFY(bitmap.height() >= 0);
@@ -144,16 +194,12 @@ ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert,
 
         auto const* y_row_a = &plane_y[static_cast<size_t>(row) * width];
         auto* scan_line_a = bitmap.scanline(static_cast<int>(row));
+        convert_row(y_row_a, u_row_a, v_row_a, scan_line_a, width);
 
-        for (size_t column = 0; column < width; column++) {
-            scan_line_a[column] = convert(y_row_a[column], u_row_a[column], v_row_a[column]).value();
-        }
         if constexpr (subsampling_vertical != 0) {
             auto const* y_row_b = &plane_y[static_cast<size_t>(row + 1) * width];
             auto* scan_line_b = bitmap.scanline(static_cast<int>(row + 1));
-            for (size_t column = 0; column < width; column++) {
-                scan_line_b[column] = convert(y_row_b[column], u_row_b[column], v_row_b[column]).value();
-            }
+            convert_row(y_row_b, u_row_b, v_row_b, scan_line_b, width);
         }
 
         AK::TypedTransfer<RemoveReference<decltype(*u_row_a)>>::move(u_row_a, u_row_b, width);
@@ -165,9 +211,7 @@ ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert,
         if ((height & 1) == 0) {
             auto const* y_row = &plane_y[static_cast<size_t>(height - 1) * width];
             auto* scan_line = bitmap.scanline(static_cast<int>(height - 1));
-            for (size_t column = 0; column < width; column++) {
-                scan_line[column] = convert(y_row[column], u_row_a[column], v_row_a[column]).value();
-            }
+            convert_row(y_row, u_row_a, v_row_a, scan_line, width);
         }
     }
 
@@ -183,20 +227,19 @@ static ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_selecting_converter(
 
     constexpr auto output_cicp = CodingIndependentCodePoints(ColorPrimaries::BT709, TransferCharacteristics::SRGB, MatrixCoefficients::BT709, VideoFullRangeFlag::Full);
 
-    if (bit_depth == 8 && cicp.transfer_characteristics() == output_cicp.transfer_characteristics() && cicp.color_primaries() == output_cicp.color_primaries() && cicp.video_full_range_flag() == VideoFullRangeFlag::Studio) {
-        switch (cicp.matrix_coefficients()) {
-        case MatrixCoefficients::BT470BG:
-        case MatrixCoefficients::BT601:
-            return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([](T y, T u, T v) { return ColorConverter::convert_simple_yuv_to_rgb<MatrixCoefficients::BT601, VideoFullRangeFlag::Studio>(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
-        case MatrixCoefficients::BT709:
-            return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([](T y, T u, T v) { return ColorConverter::convert_simple_yuv_to_rgb<MatrixCoefficients::BT709, VideoFullRangeFlag::Studio>(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
-        default:
-            break;
-        }
+    if (auto fixed_point_converter = FixedPointColorConverter::create(bit_depth, cicp, output_cicp); fixed_point_converter.has_value()) {
+        return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([&](T const* y_row, T const* u_row, T const* v_row, u32* scan_line, u32 row_width) {
+            fixed_point_converter->convert_row(y_row, u_row, v_row, scan_line, row_width);
+        },
+            width, height, plane_y, plane_u, plane_v, bitmap);
     }
 
     auto converter = TRY(ColorConverter::create(bit_depth, cicp, output_cicp));
-    return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([&](T y, T u, T v) { return converter.convert_yuv(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
+    return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([&](T const* y_row, T const* u_row, T const* v_row, u32* scan_line, u32 row_width) {
+        for (size_t column = 0; column < row_width; column++)
+            scan_line[column] = converter.convert_yuv(y_row[column], u_row[column], v_row[column]).value();
+    },
+        width, height, plane_y, plane_u, plane_v, bitmap);
 }
 
 template<u32 subsampling_horizontal, u32 subsampling_vertical>
@@ -73,6 +73,16 @@ public:
         Subsampling subsampling,
         ReadonlyBytes y_data, ReadonlyBytes u_data, ReadonlyBytes v_data);
 
+    // Creates a frame from a luma plane and a plane of interleaved chroma samples, as hardware decoders output them in the
+    // NV12 and P010 formats. Samples with more than 8 bits are expected in the high bits of each 16-bit value, like P010
+    // stores them. The strides are the distances between the starts of two rows, in bytes.
+    static ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> try_create_from_semi_planar_data(
+        AK::Duration timestamp,
+        Gfx::Size<u32> size,
+        u8 bit_depth, CodingIndependentCodePoints cicp,
+        Subsampling subsampling,
+        ReadonlyBytes y_data, size_t y_stride, ReadonlyBytes uv_data, size_t uv_stride);
+
     SubsampledYUVFrame(
         AK::Duration timestamp,
         Gfx::Size<u32> size,
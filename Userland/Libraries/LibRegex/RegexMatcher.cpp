@@ -54,6 +54,17 @@ Regex<Parser>::Regex(regex::Parser::Result parse_result, ByteString pattern, typ
         matcher = make<Matcher<Parser>>(this, regex_options | static_cast<decltype(regex_options.value())>(parse_result.options.value()));
 }
 
+template<class Parser>
+Regex<Parser>::Regex(Regex const& regex)
+    : pattern_value(regex.pattern_value)
+    , parser_result(regex.parser_result)
+    , start_offset(regex.start_offset)
+{
+    // NOTE: The bytecode has already been optimized, so there's no need to run the optimization passes again.
+    if (regex.matcher)
+        matcher = make<Matcher<Parser>>(this, regex.matcher->options());
+}
+
 template<class Parser>
 Regex<Parser>::Regex(Regex&& regex)
     : pattern_value(move(regex.pattern_value))
@@ -114,6 +125,60 @@ RegexResult Matcher<Parser>::match(RegexStringView view, Optional<typename Parse
     return match(views, regex_options);
 }
 
+// Mirrors how OpCode_Compare looks at the input for each of the compare types that can appear in starting_compares.
+static bool can_start_with(RegexStringView view, size_t position, Vector<CompareTypeAndValuePair> const& starting_compares)
+{
+    for (auto const& compare : starting_compares) {
+        switch (compare.type) {
+        case CharacterCompareType::Char:
+            if (view.code_unit_at(position) == compare.value)
+                return true;
+            break;
+        case CharacterCompareType::CharRange: {
+            auto range = (CharRange)compare.value;
+            auto ch = view[position];
+            if (ch >= range.from && ch <= range.to)
+                return true;
+            break;
+        }
+        case CharacterCompareType::CharClass:
+            if (OpCode_Compare::matches_character_class((CharClass)compare.value, view[position], false))
+                return true;
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+    return false;
+}
+
+// Finds the next occurrence of an ASCII literal at or after the given position, in code units.
+// Returns the position itself for kinds of view that we don't know how to search through quickly.
+static Optional<size_t> find_literal(RegexStringView view, StringView literal, size_t start)
+{
+    if (view.is_string_view())
+        return view.string_view().find(literal, start);
+
+    if (view.is_u16_view()) {
+        auto const& utf16_view = view.u16_view();
+        auto length = utf16_view.length_in_code_units();
+        if (literal.length() > length)
+            return {};
+        for (size_t position = start; position <= length - literal.length(); ++position) {
+            if (utf16_view.code_unit_at(position) != static_cast<u8>(literal[0]))
+                continue;
+            size_t i = 1;
+            while (i < literal.length() && utf16_view.code_unit_at(position + i) == static_cast<u8>(literal[i]))
+                ++i;
+            if (i == literal.length())
+                return position;
+        }
+        return {};
+    }
+
+    return start;
+}
+
 template<typename Parser>
 RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
 {
@@ -186,6 +251,12 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
     auto only_start_of_line = m_pattern->parser_result.optimization_data.only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Multiline);
 
+    // NOTE: Outside of unicode mode, a starting position is also the code unit offset, which keeps the check below simple.
+    //       Case-insensitive matching would need the same case folding as OpCode_Compare, so we don't bother.
+    auto const& starting_compares = m_pattern->parser_result.optimization_data.starting_compares;
+    auto const& literal_prefix = m_pattern->parser_result.optimization_data.literal_prefix;
+    auto can_use_match_start_optimization_data = !unicode && !input.regex_options.has_flag_set(AllFlags::Insensitive);
+
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -246,9 +317,27 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
+            if (can_use_match_start_optimization_data && literal_prefix.has_value() && view_index < view_length) {
+                auto next_possible_start = find_literal(view, *literal_prefix, view_index);
+                if (!next_possible_start.has_value())
+                    break;
+                if (*next_possible_start != view_index) {
+                    // NOTE: This is where we would have ended up after failing to match at every position in between.
+                    if (!continue_search || only_start_of_line)
+                        break;
+                    view_index = *next_possible_start;
+                }
+            }
+
             input.column = match_count;
             input.match_index = match_count;
 
+            if (can_use_match_start_optimization_data && starting_compares.has_value() && view_index < view_length && !can_start_with(view, view_index, *starting_compares)) {
+                if (!continue_search || only_start_of_line)
+                    break;
+                continue;
+            }
+
             state.string_position = view_index;
             state.string_position_in_code_units = view_index;
             state.instruction_position = 0;
@@ -447,7 +536,28 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
 
     auto& bytecode = m_pattern->parser_result.bytecode;
 
+    // NOTE: Backtracking can take exponential time (e.g. /(a|a)*b/), while running all paths in lockstep is bounded by
+    //       the bytecode size times the input length. Since backtracking is a lot cheaper on well-behaved patterns,
+    //       we only switch over once we've spent more operations than the lockstep matcher would need at most.
+    Optional<MatchState> initial_state;
+    size_t lockstep_operation_budget = 0;
+    size_t operations_at_start = operations;
+    if (m_pattern->parser_result.optimization_data.can_match_in_lockstep) {
+        initial_state = state;
+        lockstep_operation_budget = bytecode.size() * (input.view.length() - min(state.string_position, input.view.length()) + 1);
+    }
+
     for (;;) {
+        if (initial_state.has_value() && operations - operations_at_start > lockstep_operation_budget) {
+            MatchState lockstep_state = *initial_state;
+            if (auto result = execute_in_lockstep(input, lockstep_state, operations); result.has_value()) {
+                if (*result)
+                    state = move(lockstep_state);
+                return *result;
+            }
+            initial_state.clear();
+        }
+
         auto& opcode = bytecode.get_opcode(state);
         ++operations;
 
@@ -540,6 +650,111 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
     VERIFY_NOT_REACHED();
 }
 
+template<class Parser>
+Optional<bool> Matcher<Parser>::execute_in_lockstep(MatchInput const& input, MatchState& state, size_t& operations) const
+{
+    // This advances all paths through the bytecode one character at a time, ordered by priority (i.e. the order the
+    // backtracking matcher would try them in). Once a path reaches an instruction that a higher priority path has already
+    // reached at the same position, it can't lead to a better match and is dropped, which bounds the work per character.
+    auto& bytecode = m_pattern->parser_result.bytecode;
+
+    // NOTE: Steps are counted from 1, so a freshly zeroed entry means "not visited yet".
+    Vector<size_t> visited_in_step;
+    visited_in_step.resize(bytecode.size() + 1);
+
+    Vector<MatchState> current_paths;
+    Vector<MatchState> next_paths;
+    Vector<MatchState> pending_paths;
+    Optional<MatchState> best_match;
+    size_t step = 1;
+
+    // Runs a path up to the next instruction that consumes something (or ends the match), following forks in priority order.
+    auto add_path = [&](MatchState&& path, Vector<MatchState>& paths) {
+        pending_paths.append(move(path));
+        while (!pending_paths.is_empty()) {
+            auto path = pending_paths.take_last();
+            if (visited_in_step[path.instruction_position] == step)
+                continue;
+            visited_in_step[path.instruction_position] = step;
+
+            auto& opcode = bytecode.get_opcode(path);
+            if (opcode.opcode_id() == OpCodeId::Compare || opcode.opcode_id() == OpCodeId::Exit) {
+                paths.append(move(path));
+                continue;
+            }
+
+            ++operations;
+            auto result = opcode.execute(input, path);
+            path.instruction_position += opcode.size();
+
+            switch (result) {
+            case ExecutionResult::Continue:
+                pending_paths.append(move(path));
+                break;
+            case ExecutionResult::Fork_PrioHigh: {
+                // NOTE: There are no saved forks for ForkReplace* to replace here, the visited set already drops duplicates.
+                input.fork_to_replace.clear();
+                auto fork = path;
+                fork.instruction_position = path.fork_at_position;
+                pending_paths.append(move(path));
+                pending_paths.append(move(fork));
+                break;
+            }
+            case ExecutionResult::Fork_PrioLow: {
+                input.fork_to_replace.clear();
+                auto fork = path;
+                fork.instruction_position = path.fork_at_position;
+                pending_paths.append(move(fork));
+                pending_paths.append(move(path));
+                break;
+            }
+            case ExecutionResult::Failed:
+            case ExecutionResult::Failed_ExecuteLowPrioForks:
+            case ExecutionResult::Succeeded:
+                break;
+            }
+        }
+    };
+
+    add_path(move(state), current_paths);
+
+    while (!current_paths.is_empty()) {
+        ++step;
+        for (auto& path : current_paths) {
+            auto& opcode = bytecode.get_opcode(path);
+            ++operations;
+
+            if (opcode.opcode_id() == OpCodeId::Exit) {
+                if (opcode.execute(input, path) != ExecutionResult::Succeeded)
+                    continue;
+                // Everything after this path has a lower priority, so it can't produce a better match.
+                best_match = move(path);
+                break;
+            }
+
+            auto string_position = path.string_position;
+            if (opcode.execute(input, path) != ExecutionResult::Continue)
+                continue;
+
+            // The optimizer only lets us get here when every Compare consumes a single character, but be careful anyway.
+            if (path.string_position != string_position + 1)
+                return {};
+
+            path.instruction_position += opcode.size();
+            add_path(move(path), next_paths);
+        }
+
+        swap(current_paths, next_paths);
+        next_paths.clear_with_capacity();
+    }
+
+    if (!best_match.has_value())
+        return false;
+
+    state = best_match.release_value();
+    return true;
+}
+
 template class Matcher<PosixBasicParser>;
 template class Regex<PosixBasicParser>;
 
@@ -74,6 +74,7 @@ public:
 
 private:
     bool execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    Optional<bool> execute_in_lockstep(MatchInput const& input, MatchState& state, size_t& operations) const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
@@ -92,6 +93,7 @@ public:
     explicit Regex(ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
     Regex(regex::Parser::Result parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
     ~Regex() = default;
+    Regex(Regex const&);
     Regex(Regex&&);
     Regex& operator=(Regex&&);
 
@@ -232,6 +234,8 @@ private:
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
+    void fill_match_start_optimization_data();
+    void fill_lockstep_optimization_data();
 };
 
 // free standing functions for match, search and has_match
@@ -43,6 +43,174 @@ void Regex<Parser>::run_optimization_passes()
         parser_result.optimization_data.only_start_of_line = true;
 
     parser_result.bytecode.flatten();
+
+    fill_match_start_optimization_data();
+    fill_lockstep_optimization_data();
+}
+
+template<typename Parser>
+void Regex<Parser>::fill_match_start_optimization_data()
+{
+    // If the pattern starts with straight-line code, every match has to go through that code before anything else.
+    // That lets the matcher skip over starting positions without setting up a full VM run for each of them:
+    // - The first Compare tells us which characters a match can start with.
+    // - A run of plain character or string Compares gives us a literal that every match starts with.
+    auto& bytecode = parser_result.bytecode;
+    MatchState state;
+    StringBuilder literal_prefix;
+
+    auto finish = [&] {
+        if (!literal_prefix.is_empty())
+            parser_result.optimization_data.literal_prefix = literal_prefix.to_byte_string();
+    };
+
+    for (;; state.instruction_position += bytecode.get_opcode(state).size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+            // None of these consume anything or change the flow of execution.
+            continue;
+        case OpCodeId::Compare:
+            break;
+        default:
+            return finish();
+        }
+
+        auto& compare = static_cast<OpCode_Compare const&>(opcode);
+        if (compare.arguments_count() == 0)
+            return finish();
+
+        Vector<CompareTypeAndValuePair> compares;
+        Vector<ByteCodeValueType> literal;
+        size_t offset = state.instruction_position + 3;
+        for (size_t i = 0; i < compare.arguments_count(); ++i) {
+            auto compare_type = (CharacterCompareType)bytecode.at(offset++);
+            switch (compare_type) {
+            case CharacterCompareType::Char:
+                literal.append(bytecode.at(offset));
+                compares.append({ compare_type, bytecode.at(offset++) });
+                break;
+            case CharacterCompareType::CharRange:
+            case CharacterCompareType::CharClass:
+                compares.append({ compare_type, bytecode.at(offset++) });
+                break;
+            case CharacterCompareType::String: {
+                auto length = bytecode.at(offset++);
+                if (length == 0)
+                    return finish();
+                for (size_t j = 0; j < length; ++j)
+                    literal.append(bytecode.at(offset + j));
+                compares.append({ CharacterCompareType::Char, bytecode.at(offset) });
+                offset += length;
+                break;
+            }
+            case CharacterCompareType::LookupTable: {
+                auto count = bytecode.at(offset++);
+                for (size_t j = 0; j < count; ++j)
+                    compares.append({ CharacterCompareType::CharRange, bytecode.at(offset++) });
+                break;
+            }
+            default:
+                // Anything else (inversions, references, unicode properties, etc.) is too complicated to bother with.
+                return finish();
+            }
+        }
+
+        if (!parser_result.optimization_data.starting_compares.has_value())
+            parser_result.optimization_data.starting_compares = move(compares);
+
+        // NOTE: Multiple arguments to a Compare are alternatives, so only a lone Char or String compare extends the prefix.
+        //       We stick to ASCII, so that the prefix means the same thing for every kind of input view.
+        if (compare.arguments_count() != 1 || literal.is_empty() || !all_of(literal, [](auto ch) { return is_ascii(ch); }))
+            return finish();
+        for (auto ch : literal)
+            literal_prefix.append(static_cast<char>(ch));
+    }
+}
+
+template<typename Parser>
+void Regex<Parser>::fill_lockstep_optimization_data()
+{
+    // Running every path in lockstep and dropping all but the highest priority path at any (instruction, position) pair
+    // only gives the same result as backtracking if two such paths can't behave differently from there on.
+    // That rules out anything that looks at more than the current position (references, lookaround, repeat counters),
+    // as well as Compares that don't consume exactly one character.
+    // NOTE: Checkpoints are fine; two paths can only disagree on whether a loop iteration was empty if the one that
+    //       thinks it was has already been through the start of that loop at the same position.
+    auto& bytecode = parser_result.bytecode;
+    MatchState state;
+
+    for (; state.instruction_position < bytecode.size(); state.instruction_position += bytecode.get_opcode(state).size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Jump:
+        case OpCodeId::JumpNonEmpty:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+            continue;
+        case OpCodeId::Compare:
+            break;
+        default:
+            return;
+        }
+
+        auto& compare = static_cast<OpCode_Compare const&>(opcode);
+        if (compare.arguments_count() == 0)
+            return;
+
+        for (auto& [compare_type, value] : compare.flat_compares()) {
+            if (compare_type == CharacterCompareType::Reference)
+                return;
+        }
+
+        // NOTE: flat_compares() splits strings into characters, so look for those separately.
+        size_t offset = state.instruction_position + 3;
+        for (size_t i = 0; i < compare.arguments_count(); ++i) {
+            auto compare_type = (CharacterCompareType)bytecode.at(offset++);
+            switch (compare_type) {
+            case CharacterCompareType::String: {
+                auto length = bytecode.at(offset++);
+                if (length != 1)
+                    return;
+                offset += length;
+                break;
+            }
+            case CharacterCompareType::LookupTable:
+                offset += bytecode.at(offset) + 1;
+                break;
+            case CharacterCompareType::Inverse:
+            case CharacterCompareType::TemporaryInverse:
+            case CharacterCompareType::AnyChar:
+            case CharacterCompareType::RangeExpressionDummy:
+            case CharacterCompareType::And:
+            case CharacterCompareType::Or:
+            case CharacterCompareType::EndAndOr:
+                break;
+            default:
+                ++offset;
+                break;
+            }
+        }
+    }
+
+    parser_result.optimization_data.can_match_in_lockstep = true;
 }
 
 template<typename Parser>
@@ -58,6 +58,13 @@ public:
 
         struct {
             Optional<ByteString> pure_substring_search;
+            // If set, a match can only start at a character matching one of these (Char, CharRange or CharClass) compares.
+            Optional<Vector<CompareTypeAndValuePair>> starting_compares;
+            // If set, every match starts with this (ASCII) literal.
+            Optional<ByteString> literal_prefix;
+            // If set, every Compare consumes exactly one character and nothing depends on more than the current position,
+            // so the matcher may run all paths in lockstep instead of backtracking.
+            bool can_match_in_lockstep = false;
             bool only_start_of_line = false;
         } optimization_data {};
     };
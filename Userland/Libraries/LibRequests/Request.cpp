@@ -12,6 +12,7 @@ namespace Requests {
 Request::Request(RequestClient& client, i32 request_id)
     : m_client(client)
     , m_request_id(request_id)
+    , m_start_time(MonotonicTime::now())
 {
 }
 
@@ -50,23 +51,29 @@ void Request::set_buffered_request_finished_callback(BufferedRequestFinished on_
     on_headers_received = [this](auto& headers, auto response_code) {
         m_internal_buffered_data->response_headers = headers;
         m_internal_buffered_data->response_code = move(response_code);
+
+        // NOTE: If we know how big the payload is going to be, we can receive it without ever growing the buffer.
+        //       This is only a hint, so a bogus Content-Length just costs us some reallocations later.
+        static constexpr size_t max_preallocated_payload_size = 64 * MiB;
+        if (auto content_length = headers.get("Content-Length"); content_length.has_value()) {
+            if (auto length = content_length->template to_number<size_t>(); length.has_value() && *length <= max_preallocated_payload_size)
+                (void)m_internal_buffered_data->payload.try_ensure_capacity(*length);
+        }
     };
 
     on_finish = [this, on_buffered_request_finished = move(on_buffered_request_finished)](auto total_size, auto network_error) {
-        auto output_buffer = ByteBuffer::create_uninitialized(m_internal_buffered_data->payload_stream.used_buffer_size()).release_value_but_fixme_should_propagate_errors();
-        m_internal_buffered_data->payload_stream.read_until_filled(output_buffer).release_value_but_fixme_should_propagate_errors();
-
+        // NOTE: The payload was received straight into its final buffer, so it's handed over without another copy.
         on_buffered_request_finished(
             total_size,
             network_error,
             m_internal_buffered_data->response_headers,
             m_internal_buffered_data->response_code,
-            output_buffer);
+            m_internal_buffered_data->payload);
     };
 
     set_up_internal_stream_data([this](auto read_bytes) {
         // FIXME: What do we do if this fails?
-        m_internal_buffered_data->payload_stream.write_until_depleted(read_bytes).release_value_but_fixme_should_propagate_errors();
+        m_internal_buffered_data->payload.try_append(read_bytes).release_value_but_fixme_should_propagate_errors();
     });
 }
 
@@ -81,8 +88,10 @@ void Request::set_unbuffered_request_callbacks(HeadersReceived on_headers_receiv
     set_up_internal_stream_data(move(on_data_received));
 }
 
-void Request::did_finish(Badge<RequestClient>, u64 total_size, Optional<NetworkError> const& network_error)
+void Request::did_finish(Badge<RequestClient>, u64 total_size, RequestTimingInfo const& timing_info, Optional<NetworkError> const& network_error)
 {
+    m_timing_info = timing_info;
+    m_timing_info.start_time = m_start_time;
     if (on_finish)
         on_finish(total_size, network_error);
 }
@@ -17,6 +17,7 @@
 #include <LibHTTP/HeaderMap.h>
 #include <LibIPC/Forward.h>
 #include <LibRequests/NetworkErrorEnum.h>
+#include <LibRequests/RequestTimingInfo.h>
 
 namespace Requests {
 
@@ -54,7 +55,10 @@ public:
 
     Function<CertificateAndKey()> on_certificate_requested;
 
-    void did_finish(Badge<RequestClient>, u64 total_size, Optional<NetworkError> const& network_error);
+    void did_finish(Badge<RequestClient>, u64 total_size, RequestTimingInfo const& timing_info, Optional<NetworkError> const& network_error);
+
+    // NOTE: This is only known once the request has finished.
+    RequestTimingInfo const& timing_info() const { return m_timing_info; }
     void did_receive_headers(Badge<RequestClient>, HTTP::HeaderMap const& response_headers, Optional<u32> response_code);
     void did_request_certificates(Badge<RequestClient>);
 
@@ -70,6 +74,8 @@ private:
     int m_request_id { -1 };
     RefPtr<Core::Notifier> m_write_notifier;
     int m_fd { -1 };
+    MonotonicTime m_start_time;
+    RequestTimingInfo m_timing_info;
 
     enum class Mode {
         Buffered,
@@ -82,7 +88,7 @@ private:
     RequestFinished on_finish;
 
     struct InternalBufferedData {
-        AllocatingMemoryStream payload_stream;
+        ByteBuffer payload;
         HTTP::HeaderMap response_headers;
         Optional<u32> response_code;
     };
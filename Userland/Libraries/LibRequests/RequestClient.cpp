@@ -27,7 +27,7 @@ void RequestClient::ensure_connection(URL::URL const& url, ::RequestServer::Cach
     async_ensure_connection(url, cache_level);
 }
 
-RefPtr<Request> RequestClient::start_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const& proxy_data)
+RefPtr<Request> RequestClient::start_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const& proxy_data, ::RequestServer::RequestPriority priority)
 {
     auto body_result = ByteBuffer::copy(request_body);
     if (body_result.is_error())
@@ -36,7 +36,7 @@ RefPtr<Request> RequestClient::start_request(ByteString const& method, URL::URL
     static i32 s_next_request_id = 0;
     auto request_id = s_next_request_id++;
 
-    IPCProxy::async_start_request(request_id, method, url, request_headers, body_result.release_value(), proxy_data);
+    IPCProxy::async_start_request(request_id, method, url, request_headers, body_result.release_value(), proxy_data, priority);
     auto request = Request::create_from_id({}, *this, request_id);
     m_requests.set(request_id, request);
     return request;
@@ -68,11 +68,11 @@ bool RequestClient::set_certificate(Badge<Request>, Request& request, ByteString
     return IPCProxy::set_certificate(request.id(), move(certificate), move(key));
 }
 
-void RequestClient::request_finished(i32 request_id, u64 total_size, Optional<NetworkError> const& network_error)
+void RequestClient::request_finished(i32 request_id, u64 total_size, RequestTimingInfo const& timing_info, Optional<NetworkError> const& network_error)
 {
     RefPtr<Request> request;
     if ((request = m_requests.get(request_id).value_or(nullptr))) {
-        request->did_finish({}, total_size, network_error);
+        request->did_finish({}, total_size, timing_info, network_error);
     }
     m_requests.remove(request_id);
 }
@@ -110,11 +110,22 @@ void RequestClient::websocket_connected(i64 websocket_id)
         maybe_connection.value()->did_open({});
 }
 
-void RequestClient::websocket_received(i64 websocket_id, bool is_text, ByteBuffer const& data)
+void RequestClient::websocket_received(i64 websocket_id, Vector<u32> const& message_sizes, Vector<bool> const& message_is_text, ByteBuffer const& data)
 {
     auto maybe_connection = m_websockets.get(websocket_id);
-    if (maybe_connection.has_value())
-        maybe_connection.value()->did_receive({}, data, is_text);
+    if (!maybe_connection.has_value())
+        return;
+
+    // NOTE: Keep the websocket alive, in case a message handler closes it.
+    NonnullRefPtr connection = *maybe_connection.value();
+    VERIFY(message_sizes.size() == message_is_text.size());
+
+    size_t offset = 0;
+    for (size_t i = 0; i < message_sizes.size(); ++i) {
+        auto message_data = data.bytes().slice(offset, message_sizes[i]);
+        offset += message_sizes[i];
+        connection->did_receive({}, MUST(ByteBuffer::copy(message_data)), message_is_text[i]);
+    }
 }
 
 void RequestClient::websocket_errored(i64 websocket_id, i32 message)
@@ -27,7 +27,7 @@ public:
     explicit RequestClient(NonnullOwnPtr<Core::LocalSocket>);
     virtual ~RequestClient() override;
 
-    RefPtr<Request> start_request(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers = {}, ReadonlyBytes request_body = {}, Core::ProxyData const& = {});
+    RefPtr<Request> start_request(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers = {}, ReadonlyBytes request_body = {}, Core::ProxyData const& = {}, ::RequestServer::RequestPriority = ::RequestServer::RequestPriority::Medium);
 
     RefPtr<WebSocket> websocket_connect(const URL::URL&, ByteString const& origin = {}, Vector<ByteString> const& protocols = {}, Vector<ByteString> const& extensions = {}, HTTP::HeaderMap const& request_headers = {});
 
@@ -40,12 +40,12 @@ private:
     virtual void die() override;
 
     virtual void request_started(i32, IPC::File const&) override;
-    virtual void request_finished(i32, u64, Optional<NetworkError> const&) override;
+    virtual void request_finished(i32, u64, RequestTimingInfo const&, Optional<NetworkError> const&) override;
     virtual void certificate_requested(i32) override;
     virtual void headers_became_available(i32, HTTP::HeaderMap const&, Optional<u32> const&) override;
 
     virtual void websocket_connected(i64 websocket_id) override;
-    virtual void websocket_received(i64 websocket_id, bool, ByteBuffer const&) override;
+    virtual void websocket_received(i64 websocket_id, Vector<u32> const&, Vector<bool> const&, ByteBuffer const&) override;
     virtual void websocket_errored(i64 websocket_id, i32) override;
     virtual void websocket_closed(i64 websocket_id, u16, ByteString const&, bool) override;
     virtual void websocket_ready_state_changed(i64 websocket_id, u32 ready_state) override;
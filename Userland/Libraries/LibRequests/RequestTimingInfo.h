@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+
+namespace Requests {
+
+// How long the phases of a request took, as measured by RequestServer. This is what LibWeb needs to fill in the fetch
+// timing info that Resource Timing exposes to the page.
+struct RequestTimingInfo {
+    enum class CacheState : u8 {
+        // The response came from the network.
+        None,
+        // The response was served from the disk cache, without contacting the server.
+        Local,
+        // The response was served from the disk cache, after the server confirmed that it's still valid.
+        Validated,
+    };
+
+    // NOTE: These are offsets, in microseconds, from the moment RequestServer started the request.
+    //       They are 0 for phases that didn't happen, e.g. connecting when an existing connection was reused.
+    i64 domain_lookup_end_microseconds { 0 };
+    i64 connect_end_microseconds { 0 };
+    i64 secure_connect_end_microseconds { 0 };
+    i64 request_start_microseconds { 0 };
+    i64 response_start_microseconds { 0 };
+    i64 response_end_microseconds { 0 };
+
+    // The number of bytes that came over the network, before content codings were decoded.
+    u64 header_size { 0 };
+    u64 encoded_body_size { 0 };
+
+    // The ALPN protocol ID of the protocol that was used, e.g. "http/1.1" or "h2".
+    ByteString protocol;
+
+    bool connection_was_reused { false };
+    CacheState cache_state { CacheState::None };
+
+    // NOTE: This is when the client asked for the request to be started, which the offsets above can be added to.
+    //       It's filled in by LibRequests, and not sent over IPC.
+    Optional<MonotonicTime> start_time;
+};
+
+}
+
+namespace IPC {
+
+template<>
+inline ErrorOr<void> encode(Encoder& encoder, Requests::RequestTimingInfo const& timing_info)
+{
+    TRY(encoder.encode(timing_info.domain_lookup_end_microseconds));
+    TRY(encoder.encode(timing_info.connect_end_microseconds));
+    TRY(encoder.encode(timing_info.secure_connect_end_microseconds));
+    TRY(encoder.encode(timing_info.request_start_microseconds));
+    TRY(encoder.encode(timing_info.response_start_microseconds));
+    TRY(encoder.encode(timing_info.response_end_microseconds));
+    TRY(encoder.encode(timing_info.header_size));
+    TRY(encoder.encode(timing_info.encoded_body_size));
+    TRY(encoder.encode(timing_info.protocol));
+    TRY(encoder.encode(timing_info.connection_was_reused));
+    TRY(encoder.encode(timing_info.cache_state));
+    return {};
+}
+
+template<>
+inline ErrorOr<Requests::RequestTimingInfo> decode(Decoder& decoder)
+{
+    Requests::RequestTimingInfo timing_info;
+    timing_info.domain_lookup_end_microseconds = TRY(decoder.decode<i64>());
+    timing_info.connect_end_microseconds = TRY(decoder.decode<i64>());
+    timing_info.secure_connect_end_microseconds = TRY(decoder.decode<i64>());
+    timing_info.request_start_microseconds = TRY(decoder.decode<i64>());
+    timing_info.response_start_microseconds = TRY(decoder.decode<i64>());
+    timing_info.response_end_microseconds = TRY(decoder.decode<i64>());
+    timing_info.header_size = TRY(decoder.decode<u64>());
+    timing_info.encoded_body_size = TRY(decoder.decode<u64>());
+    timing_info.protocol = TRY(decoder.decode<ByteString>());
+    timing_info.connection_was_reused = TRY(decoder.decode<bool>());
+    timing_info.cache_state = TRY(decoder.decode<Requests::RequestTimingInfo::CacheState>());
+    return timing_info;
+}
+
+}
@@ -11,6 +11,7 @@
 #include <LibCrypto/ASN1/ASN1.h>
 #include <LibCrypto/ASN1/DER.h>
 #include <LibCrypto/ASN1/PEM.h>
+#include <LibCrypto/Hash/SHA2.h>
 
 namespace {
 static String s_error_string;
@@ -814,6 +815,7 @@ ErrorOr<Certificate> Certificate::parse_certificate(ReadonlyBytes buffer, bool)
 
     Certificate certificate = TRY(parse_tbs_certificate(decoder, current_scope));
     certificate.original_asn1 = TRY(ByteBuffer::copy(buffer));
+    certificate.fingerprint = TRY(ByteBuffer::copy(Crypto::Hash::SHA256::hash(buffer.data(), buffer.size()).bytes()));
 
     certificate.signature_algorithm = TRY(parse_algorithm_identifier(decoder, current_scope));
 
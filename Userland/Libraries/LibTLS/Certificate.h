@@ -273,7 +273,7 @@ public:
     u8* ocsp { nullptr };
     Crypto::UnsignedBigInteger serial_number;
     ByteBuffer sign_key {};
-    ByteBuffer fingerprint {};
+    ByteBuffer fingerprint {}; // The SHA-256 digest of original_asn1.
     ByteBuffer der {};
     ByteBuffer data {};
     AlgorithmIdentifier signature_algorithm;
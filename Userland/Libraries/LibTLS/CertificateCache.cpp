@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibTLS/CertificateCache.h>
+
+namespace TLS {
+
+// NOTE: This is never destroyed, as TLS connections may still be torn down on other threads at exit.
+CertificateCache& CertificateCache::the()
+{
+    static auto* s_cache = new CertificateCache;
+    return *s_cache;
+}
+
+template<typename Entries>
+void CertificateCache::make_room_for_one_more(Entries& entries, size_t maximum_count, UnixDateTime now)
+{
+    if (entries.size() < maximum_count)
+        return;
+
+    entries.remove_all_matching([&](auto const&, auto const& entry) {
+        return entry.expiry < now;
+    });
+
+    // NOTE: Nothing has expired, so we make room by forgetting whichever entry the table gives us first.
+    if (entries.size() >= maximum_count)
+        entries.remove(entries.begin());
+}
+
+ErrorOr<Certificate> CertificateCache::parse_certificate(ReadonlyBytes der)
+{
+    auto digest = Crypto::Hash::SHA256::hash(der.data(), der.size());
+    auto key = TRY(ByteBuffer::copy(digest.bytes()));
+    auto now = UnixDateTime::now();
+
+    {
+        Threading::MutexLocker locker(m_mutex);
+        if (auto it = m_certificates.find(key); it != m_certificates.end()) {
+            if (now <= it->value.expiry)
+                return it->value.certificate;
+            m_certificates.remove(it);
+        }
+    }
+
+    auto certificate = TRY(Certificate::parse_certificate(der));
+
+    // NOTE: There is no point in keeping expired certificates around, as no chain containing them will ever validate.
+    if (certificate.validity.not_after < now)
+        return certificate;
+
+    Threading::MutexLocker locker(m_mutex);
+    make_room_for_one_more(m_certificates, maximum_certificate_count, now);
+    m_certificates.set(move(key), CachedCertificate { .certificate = certificate, .expiry = certificate.validity.not_after });
+    return certificate;
+}
+
+static Optional<ByteBuffer> signature_key(Certificate const& subject, Certificate const& issuer)
+{
+    if (subject.fingerprint.is_empty() || issuer.fingerprint.is_empty())
+        return {};
+
+    auto key = ByteBuffer::create_uninitialized(subject.fingerprint.size() + issuer.fingerprint.size());
+    if (key.is_error())
+        return {};
+    subject.fingerprint.bytes().copy_to(key.value().bytes());
+    issuer.fingerprint.bytes().copy_to(key.value().bytes().slice(subject.fingerprint.size()));
+    return key.release_value();
+}
+
+bool CertificateCache::has_verified_signature(Certificate const& subject, Certificate const& issuer)
+{
+    auto key = signature_key(subject, issuer);
+    if (!key.has_value())
+        return false;
+
+    Threading::MutexLocker locker(m_mutex);
+    auto it = m_signatures.find(*key);
+    if (it == m_signatures.end())
+        return false;
+    if (it->value.expiry < UnixDateTime::now()) {
+        m_signatures.remove(it);
+        return false;
+    }
+    return true;
+}
+
+void CertificateCache::did_verify_signature(Certificate const& subject, Certificate const& issuer)
+{
+    auto key = signature_key(subject, issuer);
+    if (!key.has_value())
+        return;
+
+    auto expiry = min(subject.validity.not_after, issuer.validity.not_after);
+    auto now = UnixDateTime::now();
+    if (expiry < now)
+        return;
+
+    Threading::MutexLocker locker(m_mutex);
+    make_room_for_one_more(m_signatures, maximum_signature_count, now);
+    m_signatures.set(key.release_value(), CachedSignature { .expiry = expiry });
+}
+
+void CertificateCache::clear()
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_certificates.clear();
+    m_signatures.clear();
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/Time.h>
+#include <LibTLS/Certificate.h>
+#include <LibThreading/Mutex.h>
+
+namespace TLS {
+
+// Servers keep sending us the same few certificates, most of all the intermediates of the big certificate authorities,
+// so we remember what we learned about them for the whole process: the parsed certificates, keyed by the SHA-256 digest
+// of their DER encoding, and which signatures of one certificate by another we have already checked.
+//
+// NOTE: Entries are dropped once a certificate they depend on expires. A cached signature only says that the signature
+//       is correct, so callers still have to check the validity period of every certificate in a chain themselves.
+class CertificateCache {
+public:
+    static CertificateCache& the();
+
+    static constexpr size_t maximum_certificate_count = 256;
+    static constexpr size_t maximum_signature_count = 512;
+
+    // Same as Certificate::parse_certificate(), but certificates we have seen before are not parsed again.
+    ErrorOr<Certificate> parse_certificate(ReadonlyBytes der);
+
+    bool has_verified_signature(Certificate const& subject, Certificate const& issuer);
+    void did_verify_signature(Certificate const& subject, Certificate const& issuer);
+
+    void clear();
+
+private:
+    CertificateCache() = default;
+
+    template<typename Entries>
+    static void make_room_for_one_more(Entries&, size_t maximum_count, UnixDateTime now);
+
+    struct CachedCertificate {
+        Certificate certificate;
+        UnixDateTime expiry;
+    };
+
+    struct CachedSignature {
+        UnixDateTime expiry;
+    };
+
+    Threading::Mutex m_mutex;
+    HashMap<ByteBuffer, CachedCertificate> m_certificates;
+
+    // Keyed by the fingerprint of the subject, followed by that of the issuer.
+    HashMap<ByteBuffer, CachedSignature> m_signatures;
+};
+
+}
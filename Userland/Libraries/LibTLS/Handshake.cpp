@@ -19,6 +19,31 @@ ByteBuffer TLSv12::build_hello()
 {
     fill_with_random(m_context.local_random);
 
+    // RFC 5246 section 7.4.1.2: To resume a session, we send the ID of that session in our hello.
+    m_context.offered_session.clear();
+    m_context.is_resuming_session = false;
+    if (m_context.can_resume_sessions() && !m_context.extensions.SNI.is_empty())
+        m_context.offered_session = SessionCache::the().session_for_host(m_context.extensions.SNI);
+    if (m_context.offered_session.has_value()) {
+        auto& session_id = m_context.offered_session->session_id;
+
+        // RFC 5077 section 3.4: When presenting a ticket, we may make up a session ID, which lets us tell from the server
+        // hello whether the server accepted the ticket.
+        if (!m_context.offered_session->session_ticket.is_empty()) {
+            if (session_id.try_resize(sizeof(m_context.session_id)).is_error()) {
+                m_context.offered_session.clear();
+            } else {
+                fill_with_random(session_id.bytes());
+            }
+        }
+    }
+    if (m_context.offered_session.has_value()) {
+        auto const& session_id = m_context.offered_session->session_id;
+        VERIFY(session_id.size() <= sizeof(m_context.session_id));
+        memcpy(m_context.session_id, session_id.data(), session_id.size());
+        m_context.session_id_size = session_id.size();
+    }
+
     auto packet_version = (u16)m_context.options.version;
     auto version = (u16)m_context.options.version;
     PacketBuilder builder { ContentType::HANDSHAKE, packet_version };
@@ -89,6 +114,14 @@ ByteBuffer TLSv12::build_hello()
     if (enable_extended_master_secret)
         extension_length += 4;
 
+    // Servers only hand out session tickets to clients that ask for them with this extension, empty or not.
+    bool enable_session_ticket = m_context.can_resume_sessions();
+    size_t session_ticket_length = 0;
+    if (m_context.offered_session.has_value())
+        session_ticket_length = m_context.offered_session->session_ticket.size();
+    if (enable_session_ticket)
+        extension_length += 4 + session_ticket_length;
+
     builder.append((u16)extension_length);
 
     if (sni_length) {
@@ -139,6 +172,14 @@ ByteBuffer TLSv12::build_hello()
         builder.append((u16)0);
     }
 
+    if (enable_session_ticket) {
+        // session_ticket extension
+        builder.append((u16)ExtensionType::SESSION_TICKET);
+        builder.append((u16)session_ticket_length);
+        if (session_ticket_length)
+            builder.append(m_context.offered_session->session_ticket.data(), session_ticket_length);
+    }
+
     if (alpn_length) {
         // TODO
         VERIFY_NOT_REACHED();
@@ -227,6 +268,20 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
 
     // TODO: Compare Hashes
     dbgln_if(TLS_DEBUG, "FIXME: handle_handshake_finished :: Check message validity");
+
+    // RFC 5246 section 7.3: When resuming a session, the server sends its finished message first, and we answer it with
+    //                       ours, which has to cover the server's.
+    if (m_context.is_resuming_session) {
+        write_packets = WritePacketStage::Finished;
+        return index + size;
+    }
+
+    finish_handshake();
+    return index + size;
+}
+
+void TLSv12::finish_handshake()
+{
     m_context.connection_status = ConnectionStatus::Established;
 
     if (m_handshake_timeout_timer) {
@@ -236,10 +291,49 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
         m_handshake_timeout_timer = nullptr;
     }
 
+    remember_session();
+
     if (on_connected)
         on_connected();
+}
 
-    return index + size;
+void TLSv12::remember_session()
+{
+    if (!m_context.can_resume_sessions() || m_context.extensions.SNI.is_empty())
+        return;
+
+    // NOTE: A session we resumed is still in the cache, unless the server gave us a new ticket for it.
+    if (m_context.is_resuming_session && m_context.new_session_ticket.is_empty())
+        return;
+
+    if (m_context.session_id_size == 0 && m_context.new_session_ticket.is_empty())
+        return;
+
+    auto session_id = ByteBuffer::copy(m_context.session_id, m_context.session_id_size);
+    auto master_key = ByteBuffer::copy(m_context.master_key);
+    if (session_id.is_error() || master_key.is_error())
+        return;
+
+    auto lifetime = SessionCache::maximum_session_lifetime;
+    if (m_context.new_session_ticket_lifetime_hint != 0)
+        lifetime = min(lifetime, AK::Duration::from_seconds(m_context.new_session_ticket_lifetime_hint));
+
+    SessionCache::the().did_negotiate_session(m_context.extensions.SNI,
+        SessionCache::Session {
+            .session_id = session_id.release_value(),
+            .session_ticket = move(m_context.new_session_ticket),
+            .master_key = master_key.release_value(),
+            .cipher = m_context.cipher,
+            .extended_master_secret = m_context.extensions.extended_master_secret,
+            .expiry = UnixDateTime::now() + lifetime,
+        });
+}
+
+void TLSv12::forget_offered_session()
+{
+    if (m_context.offered_session.has_value() && m_context.connection_status != ConnectionStatus::Established)
+        SessionCache::the().forget_session_for_host(m_context.extensions.SNI);
+    m_context.offered_session.clear();
 }
 
 ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
@@ -371,6 +465,8 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
             if (m_context.is_server) {
                 dbgln("unsupported: server mode");
                 VERIFY_NOT_REACHED();
+            } else if (m_context.is_resuming_session) {
+                payload_res = (i8)Error::UnexpectedMessage;
             } else {
                 payload_res = handle_server_hello_done(buffer.slice(1, payload_size));
                 if (payload_res > 0)
@@ -406,6 +502,20 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
                 payload_res = (i8)Error::UnexpectedMessage;
             }
             break;
+        case HandshakeType::NEW_SESSION_TICKET:
+            if (m_context.handshake_messages[11] >= 1) {
+                dbgln("unexpected new session ticket message");
+                payload_res = (i8)Error::UnexpectedMessage;
+                break;
+            }
+            ++m_context.handshake_messages[11];
+            dbgln_if(TLS_DEBUG, "new session ticket");
+            if (m_context.connection_status == ConnectionStatus::KeyExchange) {
+                payload_res = handle_new_session_ticket(buffer.slice(1, payload_size));
+            } else {
+                payload_res = (i8)Error::UnexpectedMessage;
+            }
+            break;
         case HandshakeType::FINISHED:
             m_context.cached_handshake.clear();
             if (m_context.handshake_messages[10] >= 1) {
@@ -430,6 +540,8 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
         }
 
         // if something went wrong, send an alert about it
+        if (payload_res < 0 && payload_res != (i8)Error::NeedMoreData)
+            forget_offered_session();
         if (payload_res < 0) {
             switch ((Error)payload_res) {
             case Error::UnexpectedMessage: {
@@ -547,7 +659,7 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
                 auto packet = build_handshake_finished();
                 write_packet(packet);
             }
-            m_context.connection_status = ConnectionStatus::Established;
+            finish_handshake();
             break;
         }
         payload_size++;
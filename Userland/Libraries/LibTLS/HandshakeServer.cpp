@@ -190,12 +190,85 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
         } else if (extension_type == ExtensionType::EXTENDED_MASTER_SECRET) {
             m_context.extensions.extended_master_secret = true;
             res += extension_length;
+        } else if (extension_type == ExtensionType::SESSION_TICKET) {
+            // RFC 5077 section 3.2: The server will send us a new session ticket before its finished message.
+            res += extension_length;
         } else {
             dbgln("Encountered unknown extension {} with length {}", enum_to_string(extension_type), extension_length);
             res += extension_length;
         }
     }
 
+    if (m_context.offered_session.has_value()) {
+        auto const& offered_session = *m_context.offered_session;
+        if (ReadonlyBytes { m_context.session_id, m_context.session_id_size } != offered_session.session_id.bytes()) {
+            dbgln_if(TLS_DEBUG, "Server declined to resume the session, doing a full handshake");
+            forget_offered_session();
+            return res;
+        }
+
+        // RFC 5246 section 7.4.1.3: A server that resumes a session must pick the cipher suite of that session.
+        // RFC 7627 section 5.3: Both ends must also agree on whether the session used the extended master secret.
+        if (m_context.cipher != offered_session.cipher || m_context.extensions.extended_master_secret != offered_session.extended_master_secret) {
+            dbgln("Server resumed a session with different security parameters");
+            return (i8)Error::NotSafe;
+        }
+
+        auto master_key = ByteBuffer::copy(offered_session.master_key);
+        if (master_key.is_error())
+            return (i8)Error::OutOfMemory;
+        m_context.master_key = master_key.release_value();
+
+        // NOTE: The server follows up with its change cipher spec and finished messages right away.
+        m_context.is_resuming_session = true;
+        m_context.connection_status = ConnectionStatus::KeyExchange;
+        if (!expand_key())
+            return (i8)Error::NotSafe;
+    }
+
+    return res;
+}
+
+// RFC 5077 section 3.3
+ssize_t TLSv12::parse_new_session_ticket(ReadonlyBytes buffer, NewSessionTicket& new_session_ticket)
+{
+    // struct {
+    //     uint32 ticket_lifetime_hint;
+    //     opaque ticket<0..2^16-1>;
+    // } NewSessionTicket;
+    if (buffer.size() < 3)
+        return (i8)Error::NeedMoreData;
+    size_t size = buffer[0] * 0x10000 + buffer[1] * 0x100 + buffer[2];
+    if (buffer.size() - 3 < size)
+        return (i8)Error::NeedMoreData;
+    if (size < 6)
+        return (i8)Error::BrokenPacket;
+
+    auto lifetime_hint = AK::convert_between_host_and_network_endian(ByteReader::load32(buffer.offset_pointer(3)));
+    auto ticket_length = AK::convert_between_host_and_network_endian(ByteReader::load16(buffer.offset_pointer(7)));
+    if (size != 6u + ticket_length)
+        return (i8)Error::BrokenPacket;
+
+    new_session_ticket.lifetime_hint = lifetime_hint;
+    new_session_ticket.ticket = buffer.slice(9, ticket_length);
+
+    return 3 + size;
+}
+
+ssize_t TLSv12::handle_new_session_ticket(ReadonlyBytes buffer)
+{
+    NewSessionTicket new_session_ticket;
+    auto res = parse_new_session_ticket(buffer, new_session_ticket);
+    if (res < 0)
+        return res;
+
+    // NOTE: An empty ticket means that the server changed its mind about giving us one.
+    auto ticket = ByteBuffer::copy(new_session_ticket.ticket);
+    if (ticket.is_error())
+        return (i8)Error::OutOfMemory;
+    m_context.new_session_ticket = ticket.release_value();
+    m_context.new_session_ticket_lifetime_hint = new_session_ticket.lifetime_hint;
+
     return res;
 }
 
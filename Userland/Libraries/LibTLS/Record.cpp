@@ -35,23 +35,25 @@ void TLSv12::alert(AlertLevel level, AlertDescription code)
     MUST(flush());
 }
 
-void TLSv12::write_packet(ByteBuffer& packet, bool immediately)
+void TLSv12::schedule_or_perform_flush(bool immediately)
 {
-    auto schedule_or_perform_flush = [&](bool immediate) {
-        if (m_context.connection_status > ConnectionStatus::Disconnected) {
-            if (!m_has_scheduled_write_flush && !immediate) {
-                dbgln_if(TLS_DEBUG, "Scheduling write of {}", m_context.tls_buffer.size());
-                Core::deferred_invoke([this] { write_into_socket(); });
-                m_has_scheduled_write_flush = true;
-            } else {
-                // multiple packet are available, let's flush some out
-                dbgln_if(TLS_DEBUG, "Flushing scheduled write of {}", m_context.tls_buffer.size());
-                write_into_socket();
-                // the deferred invoke is still in place
-                m_has_scheduled_write_flush = true;
-            }
+    if (m_context.connection_status > ConnectionStatus::Disconnected) {
+        if (!m_has_scheduled_write_flush && !immediately) {
+            dbgln_if(TLS_DEBUG, "Scheduling write of {}", m_context.tls_buffer.size());
+            Core::deferred_invoke([this] { write_into_socket(); });
+            m_has_scheduled_write_flush = true;
+        } else {
+            // multiple packet are available, let's flush some out
+            dbgln_if(TLS_DEBUG, "Flushing scheduled write of {}", m_context.tls_buffer.size());
+            write_into_socket();
+            // the deferred invoke is still in place
+            m_has_scheduled_write_flush = true;
         }
-    };
+    }
+}
+
+void TLSv12::write_packet(ByteBuffer& packet, bool immediately)
+{
     // Record size limit is 18432 bytes, leave some headroom and flush at 16K.
     if (m_context.tls_buffer.size() + packet.size() > 16 * KiB)
         schedule_or_perform_flush(true);
@@ -63,6 +65,81 @@ void TLSv12::write_packet(ByteBuffer& packet, bool immediately)
     schedule_or_perform_flush(immediately);
 }
 
+void TLSv12::write_application_data_record(ReadonlyBytes data)
+{
+    VERIFY(is_aead());
+    VERIFY(m_context.cipher_spec_set && m_context.crypto.created == 1);
+
+    // NOTE: Instead of building the record in a buffer of its own, we encrypt it right where it will be sent from.
+    auto record_size = aead_record_header_size + data.size() + aead_tag_size;
+    if (m_context.tls_buffer.size() + record_size > 16 * KiB)
+        schedule_or_perform_flush(true);
+
+    auto record_or_error = m_context.tls_buffer.get_bytes_for_writing(record_size);
+    if (record_or_error.is_error()) {
+        // Toooooo bad, drop the record on the ground.
+        return;
+    }
+    auto record = record_or_error.release_value();
+
+    record[0] = (u8)ContentType::APPLICATION_DATA;
+    ByteReader::store(record.offset_pointer(1), AK::convert_between_host_and_network_endian((u16)m_context.options.version));
+    data.copy_to(record.slice(aead_record_header_size));
+    seal_aead_record(record);
+    ++m_context.local_sequence_number;
+
+    schedule_or_perform_flush(false);
+}
+
+// Encrypts a record in place. It holds the content type and version of the record header, followed by room for the rest
+// of the header and the explicit nonce, the plaintext, and room for the authentication tag.
+void TLSv12::seal_aead_record(Bytes record)
+{
+    constexpr size_t header_size = 5;
+    VERIFY(record.size() >= aead_record_header_size + aead_tag_size);
+    auto plaintext_length = record.size() - aead_record_header_size - aead_tag_size;
+
+    auto& gcm = m_cipher_local.get<Crypto::Cipher::AESCipher::GCMMode>();
+
+    // AEAD AAD (13)
+    // Seq. no (8)
+    // content type (1)
+    // version (2)
+    // length (2)
+    u8 aad[13];
+    Bytes aad_bytes { aad, 13 };
+    FixedMemoryStream aad_stream { aad_bytes };
+
+    u64 seq_no = AK::convert_between_host_and_network_endian(m_context.local_sequence_number);
+    u16 len = AK::convert_between_host_and_network_endian((u16)plaintext_length);
+
+    MUST(aad_stream.write_value(seq_no));                      // sequence number
+    MUST(aad_stream.write_until_depleted(record.slice(0, 3))); // content-type + version
+    MUST(aad_stream.write_value(len));                         // length
+    VERIFY(MUST(aad_stream.tell()) == MUST(aad_stream.size()));
+
+    // AEAD IV (12)
+    // IV (4)
+    // (Nonce) (8)
+    // -- Our GCM impl takes 16 bytes
+    // zero (4)
+    u8 iv[16];
+    Bytes iv_bytes { iv, 16 };
+    Bytes { m_context.crypto.local_aead_iv, 4 }.copy_to(iv_bytes);
+    fill_with_random(iv_bytes.slice(4, 8));
+    memset(iv_bytes.offset(12), 0, 4);
+
+    // write the random part of the iv out
+    iv_bytes.slice(4, 8).copy_to(record.slice(header_size));
+
+    // Write the encrypted data over the plaintext, followed by the tag
+    auto data = record.slice(aead_record_header_size, plaintext_length);
+    gcm.encrypt(data, data, iv_bytes, aad_bytes, record.slice(aead_record_header_size + plaintext_length, aead_tag_size));
+
+    // store the correct ciphertext length into the record
+    ByteReader::store(record.offset_pointer(header_size - 2), AK::convert_between_host_and_network_endian((u16)(record.size() - header_size)));
+}
+
 void TLSv12::update_packet(ByteBuffer& packet)
 {
     u32 header_size = 5;
@@ -102,87 +179,41 @@ void TLSv12::update_packet(ByteBuffer& packet)
                 });
 
             if (m_context.crypto.created == 1) {
-                // `buffer' will continue to be encrypted
-                auto buffer_result = ByteBuffer::create_uninitialized(length);
-                if (buffer_result.is_error()) {
-                    dbgln("LibTLS: Failed to allocate enough memory");
-                    VERIFY_NOT_REACHED();
-                }
-                auto buffer = buffer_result.release_value();
-                size_t buffer_position = 0;
-                auto iv_size = iv_length();
-
-                // copy the packet, sans the header
-                buffer.overwrite(buffer_position, packet.offset_pointer(header_size), packet.size() - header_size);
-                buffer_position += packet.size() - header_size;
-
-                ByteBuffer ct;
-
                 m_cipher_local.visit(
                     [&](Empty&) { VERIFY_NOT_REACHED(); },
-                    [&](Crypto::Cipher::AESCipher::GCMMode& gcm) {
+                    [&](Crypto::Cipher::AESCipher::GCMMode&) {
                         VERIFY(is_aead());
-                        // We need enough space for a header, the data, a tag, and the IV
-                        auto ct_buffer_result = ByteBuffer::create_uninitialized(length + header_size + iv_size + 16);
-                        if (ct_buffer_result.is_error()) {
+                        // Make room for the explicit nonce in front of the data and the tag behind it, and encrypt in place.
+                        if (packet.try_resize(aead_record_header_size + length + aead_tag_size).is_error()) {
                             dbgln("LibTLS: Failed to allocate enough memory for the ciphertext");
                             VERIFY_NOT_REACHED();
                         }
-                        ct = ct_buffer_result.release_value();
-
-                        // copy the header over
-                        ct.overwrite(0, packet.data(), header_size - 2);
-
-                        // AEAD AAD (13)
-                        // Seq. no (8)
-                        // content type (1)
-                        // version (2)
-                        // length (2)
-                        u8 aad[13];
-                        Bytes aad_bytes { aad, 13 };
-                        FixedMemoryStream aad_stream { aad_bytes };
-
-                        u64 seq_no = AK::convert_between_host_and_network_endian(m_context.local_sequence_number);
-                        u16 len = AK::convert_between_host_and_network_endian((u16)(packet.size() - header_size));
-
-                        MUST(aad_stream.write_value(seq_no));                              // sequence number
-                        MUST(aad_stream.write_until_depleted(packet.bytes().slice(0, 3))); // content-type + version
-                        MUST(aad_stream.write_value(len));                                 // length
-                        VERIFY(MUST(aad_stream.tell()) == MUST(aad_stream.size()));
-
-                        // AEAD IV (12)
-                        // IV (4)
-                        // (Nonce) (8)
-                        // -- Our GCM impl takes 16 bytes
-                        // zero (4)
-                        u8 iv[16];
-                        Bytes iv_bytes { iv, 16 };
-                        Bytes { m_context.crypto.local_aead_iv, 4 }.copy_to(iv_bytes);
-                        fill_with_random(iv_bytes.slice(4, 8));
-                        memset(iv_bytes.offset(12), 0, 4);
-
-                        // write the random part of the iv out
-                        iv_bytes.slice(4, 8).copy_to(ct.bytes().slice(header_size));
-
-                        // Write the encrypted data and the tag
-                        gcm.encrypt(
-                            packet.bytes().slice(header_size, length),
-                            ct.bytes().slice(header_size + 8, length),
-                            iv_bytes,
-                            aad_bytes,
-                            ct.bytes().slice(header_size + 8 + length, 16));
-
-                        VERIFY(header_size + 8 + length + 16 == ct.size());
+                        packet.overwrite(aead_record_header_size, packet.offset_pointer(header_size), length);
+                        seal_aead_record(packet);
                     },
                     [&](Crypto::Cipher::AESCipher::CBCMode& cbc) {
                         VERIFY(!is_aead());
+                        // `buffer' will continue to be encrypted
+                        auto buffer_result = ByteBuffer::create_uninitialized(length);
+                        if (buffer_result.is_error()) {
+                            dbgln("LibTLS: Failed to allocate enough memory");
+                            VERIFY_NOT_REACHED();
+                        }
+                        auto buffer = buffer_result.release_value();
+                        size_t buffer_position = 0;
+                        auto iv_size = iv_length();
+
+                        // copy the packet, sans the header
+                        buffer.overwrite(buffer_position, packet.offset_pointer(header_size), packet.size() - header_size);
+                        buffer_position += packet.size() - header_size;
+
                         // We need enough space for a header, iv_length bytes of IV and whatever the packet contains
                         auto ct_buffer_result = ByteBuffer::create_uninitialized(length + header_size + iv_size);
                         if (ct_buffer_result.is_error()) {
                             dbgln("LibTLS: Failed to allocate enough memory for the ciphertext");
                             VERIFY_NOT_REACHED();
                         }
-                        ct = ct_buffer_result.release_value();
+                        auto ct = ct_buffer_result.release_value();
 
                         // copy the header over
                         ct.overwrite(0, packet.data(), header_size - 2);
@@ -217,15 +248,15 @@ void TLSv12::update_packet(ByteBuffer& packet)
                         // get a block to encrypt into
                         auto view = ct.bytes().slice(header_size + iv_size, length);
                         cbc.encrypt(buffer, view, iv);
-                    });
 
-                // store the correct ciphertext length into the packet
-                u16 ct_length = (u16)ct.size() - header_size;
+                        // store the correct ciphertext length into the packet
+                        u16 ct_length = (u16)ct.size() - header_size;
 
-                ByteReader::store(ct.offset_pointer(header_size - 2), AK::convert_between_host_and_network_endian(ct_length));
+                        ByteReader::store(ct.offset_pointer(header_size - 2), AK::convert_between_host_and_network_endian(ct_length));
 
-                // replace the packet with the ciphertext
-                packet = ct;
+                        // replace the packet with the ciphertext
+                        packet = move(ct);
+                    });
             }
         }
     }
@@ -306,7 +337,7 @@ ByteBuffer TLSv12::hmac_message(ReadonlyBytes buf, Optional<ReadonlyBytes> const
     return mac_result.release_value();
 }
 
-ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
+ssize_t TLSv12::handle_message(Bytes buffer)
 {
     auto res { 5ll };
     size_t header_size = res;
@@ -365,14 +396,7 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
                 }
 
                 auto packet_length = length - iv_length() - 16;
-                auto payload = plain;
-                auto decrypted_result = ByteBuffer::create_uninitialized(packet_length);
-                if (decrypted_result.is_error()) {
-                    dbgln("Failed to allocate memory for the packet");
-                    return_value = Error::DecryptionFailed;
-                    return;
-                }
-                decrypted = decrypted_result.release_value();
+                auto payload = buffer.slice(buffer_position, length);
 
                 // AEAD AAD (13)
                 // Seq. no (8)
@@ -408,9 +432,10 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
                 auto ciphertext = payload.slice(0, payload.size() - 16);
                 auto tag = payload.slice(ciphertext.size());
 
+                // NOTE: The record is decrypted in place, as nothing needs the ciphertext once we have the plaintext.
                 auto consistency = gcm.decrypt(
                     ciphertext,
-                    decrypted,
+                    ciphertext,
                     iv_bytes,
                     aad_bytes,
                     tag);
@@ -424,7 +449,7 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
                     return;
                 }
 
-                plain = decrypted;
+                plain = ciphertext;
             },
             [&](Crypto::Cipher::AESCipher::CBCMode& cbc) {
                 VERIFY(!is_aead());
@@ -534,6 +559,7 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
 
             if (level == (u8)AlertLevel::FATAL) {
                 dbgln("We were alerted of a critical error: {} ({})", code, enum_to_string((AlertDescription)code));
+                forget_offered_session();
                 m_context.critical_error = code;
                 try_disambiguate_error();
                 res = (i8)Error::UnknownError;
@@ -541,7 +567,7 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
 
             if (code == (u8)AlertDescription::CLOSE_NOTIFY) {
                 res += 2;
-                alert(AlertLevel::FATAL, AlertDescription::CLOSE_NOTIFY);
+                alert(AlertLevel::WARNING, AlertDescription::CLOSE_NOTIFY);
                 if (!m_context.cipher_spec_set) {
                     // AWS CloudFront hits this.
                     dbgln("Server sent a close notify and we haven't agreed on a cipher suite. Treating it as a handshake failure.");
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTLS/SessionCache.h>
+
+namespace TLS {
+
+// NOTE: This is never destroyed, as TLS connections may still be torn down on other threads at exit.
+SessionCache& SessionCache::the()
+{
+    static auto* s_cache = new SessionCache;
+    return *s_cache;
+}
+
+Optional<SessionCache::Session> SessionCache::session_for_host(StringView host)
+{
+    Threading::MutexLocker locker(m_mutex);
+    auto it = m_sessions.find(host);
+    if (it == m_sessions.end())
+        return {};
+    if (it->value.expiry < UnixDateTime::now()) {
+        m_sessions.remove(it);
+        return {};
+    }
+    return it->value;
+}
+
+void SessionCache::did_negotiate_session(ByteString host, Session session)
+{
+    auto now = UnixDateTime::now();
+    session.expiry = min(session.expiry, now + maximum_session_lifetime);
+    if (session.expiry < now)
+        return;
+
+    Threading::MutexLocker locker(m_mutex);
+    if (m_sessions.size() >= maximum_session_count && !m_sessions.contains(host)) {
+        m_sessions.remove_all_matching([&](auto const&, auto const& session) {
+            return session.expiry < now;
+        });
+
+        // NOTE: Nothing has expired, so we make room by forgetting whichever session the table gives us first.
+        if (m_sessions.size() >= maximum_session_count)
+            m_sessions.remove(m_sessions.begin());
+    }
+    m_sessions.set(move(host), move(session));
+}
+
+void SessionCache::forget_session_for_host(StringView host)
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_sessions.remove(host);
+}
+
+void SessionCache::clear()
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_sessions.clear();
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Time.h>
+#include <LibTLS/CipherSuite.h>
+#include <LibThreading/Mutex.h>
+
+namespace TLS {
+
+// Remembers the master secrets of the sessions we recently negotiated with each host, so that the next connection to it
+// can resume one with an abbreviated handshake: no certificates, no key exchange, and one round trip less. Servers
+// either look sessions up by the session ID they gave us (RFC 5246 section 7.4.1.2), or give us a ticket that holds the
+// whole session state, encrypted with a key that only they know (RFC 5077).
+//
+// NOTE: Only sessions whose certificate chain was validated against the default root certificates are remembered, as
+//       resuming a session skips validating the chain again.
+class SessionCache {
+public:
+    struct Session {
+        // Either the ID the server gave the session, or, for sessions with a ticket, one we made up. A server that
+        // accepts the ticket echoes that ID back to us, which is how we know that we are resuming the session.
+        ByteBuffer session_id;
+        ByteBuffer session_ticket;
+
+        ByteBuffer master_key;
+        CipherSuite cipher { CipherSuite::TLS_NULL_WITH_NULL_NULL };
+        bool extended_master_secret { false };
+
+        UnixDateTime expiry;
+    };
+
+    static SessionCache& the();
+
+    static constexpr size_t maximum_session_count = 256;
+
+    // NOTE: This is what OpenSSL defaults to. Servers forget sessions after anything from a few minutes to a day.
+    static constexpr AK::Duration maximum_session_lifetime = AK::Duration::from_seconds(5 * 60);
+
+    Optional<Session> session_for_host(StringView host);
+    void did_negotiate_session(ByteString host, Session);
+    void forget_session_for_host(StringView host);
+
+    void clear();
+
+private:
+    SessionCache() = default;
+
+    Threading::Mutex m_mutex;
+    HashMap<ByteString, Session> m_sessions;
+};
+
+}
@@ -39,6 +39,11 @@ ErrorOr<size_t> TLSv12::write_some(ReadonlyBytes bytes)
     }
 
     for (size_t offset = 0; offset < bytes.size(); offset += MaximumApplicationDataChunkSize) {
+        if (is_aead()) {
+            write_application_data_record(bytes.slice(offset, min(bytes.size() - offset, MaximumApplicationDataChunkSize)));
+            continue;
+        }
+
         PacketBuilder builder { ContentType::APPLICATION_DATA, m_context.options.version, bytes.size() - offset };
         builder.append(bytes.slice(offset, min(bytes.size() - offset, MaximumApplicationDataChunkSize)));
         auto packet = builder.build();
@@ -299,10 +304,14 @@ ErrorOr<bool> TLSv12::flush()
     } while (!out_bytes.is_empty());
 
     if (out_bytes.is_empty() && !error.has_value()) {
-        m_context.tls_buffer.clear();
+        // NOTE: We keep the buffer around, as the next records are about to be written into it.
+        m_context.tls_buffer.clear_with_capacity();
         return true;
     }
 
+    // Don't send whatever made it out again.
+    m_context.tls_buffer.remove(0, m_context.tls_buffer.size() - out_bytes.size());
+
     if (m_context.send_retries++ == 10) {
         // drop the records, we can't send
         dbgln_if(TLS_DEBUG, "Dropping {} bytes worth of TLS records as max retries has been reached", m_context.tls_buffer.size());
@@ -315,7 +324,7 @@ ErrorOr<bool> TLSv12::flush()
 void TLSv12::close()
 {
     if (underlying_stream().is_open())
-        alert(AlertLevel::FATAL, AlertDescription::CLOSE_NOTIFY);
+        alert(AlertLevel::WARNING, AlertDescription::CLOSE_NOTIFY);
     // bye bye.
     m_context.connection_status = ConnectionStatus::Disconnected;
 }
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/Base64.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
@@ -19,7 +20,9 @@
 #include <LibCrypto/PK/Code/EMSA_PKCS1_V1_5.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibTLS/Certificate.h>
+#include <LibTLS/CertificateCache.h>
 #include <LibTLS/TLSv12.h>
+#include <LibThreading/ThreadPool.h>
 #include <errno.h>
 
 #ifndef SOCK_NONBLOCK
@@ -95,10 +98,8 @@ void TLSv12::consume(ReadonlyBytes record)
         return;
     }
 
-    if (index) {
-        // FIXME: Propagate errors.
-        m_context.message_buffer = MUST(m_context.message_buffer.slice(index, m_context.message_buffer.size() - index));
-    }
+    if (index)
+        m_context.message_buffer.remove(0, index);
 }
 
 bool Certificate::is_valid() const
@@ -245,6 +246,76 @@ static bool certificate_subject_matches_host(Certificate const& cert, StringView
     return false;
 }
 
+struct SignatureCheck {
+    Certificate const* subject { nullptr };
+    Certificate const* issuer { nullptr };
+    bool issuer_is_root { false };
+};
+
+static bool verify_signature(Context const& context, SignatureCheck const& check)
+{
+    if (!context.verify_certificate_pair(*check.subject, *check.issuer)) {
+        dbgln("verify_chain: Signature inconsistent, {} was not signed by {}{}", MUST(check.subject->subject.to_string()), MUST(check.issuer->subject.to_string()), check.issuer_is_root ? " (root certificate)"sv : ""sv);
+        return false;
+    }
+    CertificateCache::the().did_verify_signature(*check.subject, *check.issuer);
+    return true;
+}
+
+// The signatures in a chain don't depend on each other, so we spread them over the shared thread pool. This thread
+// takes on whichever checks no worker has started yet, so a busy pool never makes us wait for longer than doing all of
+// them here would.
+static bool verify_signatures(Context const& context, Vector<SignatureCheck, 4>& checks)
+{
+    checks.remove_all_matching([](auto const& check) {
+        return CertificateCache::the().has_verified_signature(*check.subject, *check.issuer);
+    });
+
+    if (checks.size() <= 1 || Threading::ThreadPool::the().thread_count() <= 1) {
+        for (auto const& check : checks) {
+            if (!verify_signature(context, check))
+                return false;
+        }
+        return true;
+    }
+
+    struct State : public AtomicRefCounted<State> {
+        Threading::Mutex mutex;
+        Threading::ConditionVariable all_finished { mutex };
+        Vector<bool, 4> claimed;
+        size_t finished_count { 0 };
+        bool all_verified { true };
+    };
+    auto state = adopt_ref(*new State);
+    state->claimed.resize(checks.size());
+
+    // NOTE: Workers that get to a check after it was claimed must not touch anything but the state, as we may have
+    //       returned by then.
+    auto run_check = [&context, &checks](State& state, size_t index) {
+        {
+            Threading::MutexLocker locker(state.mutex);
+            if (state.claimed[index])
+                return;
+            state.claimed[index] = true;
+        }
+        auto verified = verify_signature(context, checks[index]);
+
+        Threading::MutexLocker locker(state.mutex);
+        state.all_verified &= verified;
+        ++state.finished_count;
+        state.all_finished.broadcast();
+    };
+
+    for (size_t i = 1; i < checks.size(); ++i)
+        (void)Threading::ThreadPool::the().submit([state, run_check, i] { run_check(*state, i); }, Threading::ThreadPool::Priority::High);
+    for (size_t i = 0; i < checks.size(); ++i)
+        run_check(*state, i);
+
+    Threading::MutexLocker locker(state->mutex);
+    state->all_finished.wait_while([&] { return state->finished_count < checks.size(); });
+    return state->all_verified;
+}
+
 bool Context::verify_chain(StringView host) const
 {
     if (!options.validate_certificates)
@@ -282,6 +353,10 @@ bool Context::verify_chain(StringView host) const
         return false;
     }
 
+    // NOTE: The signatures are only checked once we know that the rest of the chain is fine, so that they can all be
+    //       checked at once.
+    Vector<SignatureCheck, 4> signature_checks;
+
     for (size_t cert_index = 0; cert_index < local_chain->size(); ++cert_index) {
         auto const& cert = local_chain->at(cert_index);
 
@@ -293,23 +368,17 @@ bool Context::verify_chain(StringView host) const
             return false;
         }
 
-        auto maybe_root_certificate = root_certificates.get(issuer_string.to_byte_string());
-        if (maybe_root_certificate.has_value()) {
-            auto& root_certificate = *maybe_root_certificate;
-            auto verification_correct = verify_certificate_pair(cert, root_certificate);
-
-            if (!verification_correct) {
-                dbgln("verify_chain: Signature inconsistent, {} was not signed by {} (root certificate)", subject_string, issuer_string);
-                return false;
-            }
+        auto root_certificate = root_certificates.find(issuer_string.to_byte_string());
+        if (root_certificate != root_certificates.end()) {
+            signature_checks.append({ .subject = &cert, .issuer = &root_certificate->value, .issuer_is_root = true });
 
-            // Root certificate reached, and correctly verified, so we can stop now
-            return true;
+            // Root certificate reached, so all that's left is to check the signatures along the way
+            return verify_signatures(*this, signature_checks);
         }
 
         if (subject_string == issuer_string) {
             dbgln("verify_chain: Non-root self-signed certificate");
-            return options.allow_self_signed_certificates;
+            return options.allow_self_signed_certificates && verify_signatures(*this, signature_checks);
         }
         if ((cert_index + 1) >= local_chain->size()) {
             dbgln("verify_chain: No trusted root certificate found before end of certificate chain");
@@ -332,11 +401,7 @@ bool Context::verify_chain(StringView host) const
             return false;
         }
 
-        bool verification_correct = verify_certificate_pair(cert, parent_certificate);
-        if (!verification_correct) {
-            dbgln("verify_chain: Signature inconsistent, {} was not signed by {}", subject_string, issuer_string);
-            return false;
-        }
+        signature_checks.append({ .subject = &cert, .issuer = &parent_certificate });
     }
 
     // Either a root certificate is reached, or parent validation fails as the end of the local chain is reached
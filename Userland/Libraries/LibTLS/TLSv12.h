@@ -20,6 +20,7 @@
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibCrypto/PK/RSA.h>
 #include <LibTLS/CipherSuite.h>
+#include <LibTLS/SessionCache.h>
 #include <LibTLS/TLSPacketBuilder.h>
 
 namespace TLS {
@@ -240,6 +241,13 @@ struct Context {
     bool verify_chain(StringView host) const;
     bool verify_certificate_pair(Certificate const& subject, Certificate const& issuer) const;
 
+    // Resuming a session skips validating the certificate chain, so we only resume sessions whose chain was validated in
+    // the same way as it would be for this connection.
+    bool can_resume_sessions() const
+    {
+        return !is_server && options.validate_certificates && !options.allow_self_signed_certificates && !options.root_certificates.has_value();
+    }
+
     Options options;
 
     u8 remote_random[32];
@@ -287,6 +295,14 @@ struct Context {
         bool extended_master_secret { false };
     } extensions;
 
+    // The session we asked the server to resume in our hello, and whether it agreed to.
+    Optional<SessionCache::Session> offered_session;
+    bool is_resuming_session { false };
+
+    // RFC 5077 section 3.3: The ticket the server sent us for this session, if any.
+    ByteBuffer new_session_ticket;
+    u32 new_session_ticket_lifetime_hint { 0 };
+
     u8 request_client_certificate { 0 };
 
     ByteBuffer cached_handshake;
@@ -298,7 +314,7 @@ struct Context {
     bool has_invoked_finish_or_error_callback { false };
 
     // message flags
-    u8 handshake_messages[11] { 0 };
+    u8 handshake_messages[12] { 0 };
     ByteBuffer user_data;
     HashMap<ByteString, Certificate> root_certificates;
 
@@ -378,6 +394,14 @@ public:
 
     static Vector<Certificate> parse_pem_certificate(ReadonlyBytes certificate_pem_buffer, ReadonlyBytes key_pem_buffer);
 
+    struct NewSessionTicket {
+        u32 lifetime_hint { 0 };
+        ReadonlyBytes ticket;
+    };
+    // Parses the body of a NewSessionTicket handshake message, starting at its length. Returns how many bytes the message
+    // took up, or an Error if it is incomplete or malformed.
+    static ssize_t parse_new_session_ticket(ReadonlyBytes, NewSessionTicket&);
+
     StringView alpn() const { return m_context.negotiated_alpn; }
 
     bool supports_cipher(CipherSuite suite) const
@@ -417,6 +441,13 @@ private:
     void update_hash(ReadonlyBytes in, size_t header_size);
 
     void write_packet(ByteBuffer& packet, bool immediately = false);
+    void schedule_or_perform_flush(bool immediately);
+
+    // An AEAD record starts with its header and an explicit nonce, and ends with the authentication tag.
+    static constexpr size_t aead_record_header_size = 5 + 8;
+    static constexpr size_t aead_tag_size = 16;
+    void write_application_data_record(ReadonlyBytes);
+    void seal_aead_record(Bytes record);
 
     ByteBuffer build_client_key_exchange();
     ByteBuffer build_server_key_exchange();
@@ -439,6 +470,10 @@ private:
 
     ssize_t handle_server_hello(ReadonlyBytes, WritePacketStage&);
     ssize_t handle_handshake_finished(ReadonlyBytes, WritePacketStage&);
+    ssize_t handle_new_session_ticket(ReadonlyBytes);
+    void finish_handshake();
+    void remember_session();
+    void forget_offered_session();
     ssize_t handle_certificate(ReadonlyBytes);
     ssize_t handle_server_key_exchange(ReadonlyBytes);
     ssize_t handle_dhe_rsa_server_key_exchange(ReadonlyBytes);
@@ -448,7 +483,7 @@ private:
     ssize_t handle_server_hello_done(ReadonlyBytes);
     ssize_t handle_certificate_verify(ReadonlyBytes);
     ssize_t handle_handshake_payload(ReadonlyBytes);
-    ssize_t handle_message(ReadonlyBytes);
+    ssize_t handle_message(Bytes);
 
     void pseudorandom_function(Bytes output, ReadonlyBytes secret, u8 const* label, size_t label_length, ReadonlyBytes seed, ReadonlyBytes seed_b);
 
@@ -11,6 +11,7 @@
 #include <AK/Function.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
+#include <AK/StdLibExtras.h>
 #include <LibTest/Macros.h>
 #include <LibTest/Randomized/RandomnessSource.h>
 #include <LibTest/Randomized/Shrink.h>
@@ -109,6 +110,13 @@ private:
 // Helper to hide implementation of TestSuite from users
 void add_test_case_to_suite(NonnullRefPtr<TestCase> const& test_case);
 void set_suite_setup_function(Function<void()> setup);
+
+// Keeps the optimizer from discarding a benchmark's result, or from hoisting work on it out of the measured loop.
+template<typename T>
+ALWAYS_INLINE void do_not_optimize(T& value)
+{
+    AK::taint_for_optimizer(value);
+}
 }
 
 #define TEST_SETUP                                   \
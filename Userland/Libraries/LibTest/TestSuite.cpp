@@ -6,7 +6,11 @@
  */
 
 #include <AK/Function.h>
+#include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
+#include <AK/Time.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
 #include <LibTest/Macros.h>
 #include <LibTest/TestResult.h>
 #include <LibTest/TestSuite.h>
@@ -39,6 +43,90 @@ private:
     struct timeval m_started = {};
 };
 
+struct BenchmarkStatistics {
+    size_t samples { 0 };
+    double median_ns { 0 };
+    double p95_ns { 0 };
+    double mean_ns { 0 };
+    double standard_deviation_ns { 0 };
+    i64 min_ns { 0 };
+    i64 max_ns { 0 };
+};
+
+static BenchmarkStatistics compute_benchmark_statistics(Vector<i64>& samples)
+{
+    VERIFY(!samples.is_empty());
+    quick_sort(samples);
+
+    BenchmarkStatistics statistics;
+    statistics.samples = samples.size();
+    statistics.min_ns = samples.first();
+    statistics.max_ns = samples.last();
+
+    auto middle = samples.size() / 2;
+    if (samples.size() % 2 == 0)
+        statistics.median_ns = (samples[middle - 1] + samples[middle]) / 2.0;
+    else
+        statistics.median_ns = samples[middle];
+
+    // Nearest-rank percentile, so a handful of samples still yields one of them rather than an interpolated value.
+    auto p95_rank = static_cast<size_t>(ceil(0.95 * samples.size()));
+    statistics.p95_ns = samples[max<size_t>(p95_rank, 1) - 1];
+
+    double sum = 0;
+    for (auto sample : samples)
+        sum += sample;
+    statistics.mean_ns = sum / samples.size();
+
+    if (samples.size() > 1) {
+        double sum_of_squared_deviations = 0;
+        for (auto sample : samples)
+            sum_of_squared_deviations += (sample - statistics.mean_ns) * (sample - statistics.mean_ns);
+        statistics.standard_deviation_ns = sqrt(sum_of_squared_deviations / (samples.size() - 1));
+    }
+
+    return statistics;
+}
+
+static JsonObject benchmark_statistics_to_json(BenchmarkStatistics const& statistics)
+{
+    JsonObject object;
+    object.set("samples", statistics.samples);
+    object.set("median_ns", statistics.median_ns);
+    object.set("p95_ns", statistics.p95_ns);
+    object.set("mean_ns", statistics.mean_ns);
+    object.set("stddev_ns", statistics.standard_deviation_ns);
+    object.set("min_ns", statistics.min_ns);
+    object.set("max_ns", statistics.max_ns);
+    return object;
+}
+
+static ErrorOr<JsonObject> load_benchmark_baseline(StringView path)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+    auto json = TRY(JsonValue::from_string(StringView { contents }));
+    if (!json.is_object())
+        return Error::from_string_literal("Benchmark baseline is not a JSON object");
+
+    auto benchmarks = json.as_object().get_object("benchmarks"sv);
+    if (!benchmarks.has_value())
+        return Error::from_string_literal("Benchmark baseline has no \"benchmarks\" object");
+    return *benchmarks;
+}
+
+static ErrorOr<void> write_benchmark_results(StringView path, ByteString const& suite_name, JsonObject benchmarks)
+{
+    JsonObject root;
+    root.set("suite", suite_name);
+    root.set("benchmarks", move(benchmarks));
+
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    auto json = root.serialized<StringBuilder>();
+    TRY(file->write_until_depleted(json.bytes()));
+    return {};
+}
+
 // Declared in Macros.h
 TestResult current_test_result()
 {
@@ -131,6 +219,11 @@ int TestSuite::main(ByteString const& suite_name, Span<StringView> arguments)
     args_parser.add_option(do_tests_only, "Only run tests.", "tests");
     args_parser.add_option(do_benchmarks_only, "Only run benchmarks.", "bench");
     args_parser.add_option(m_benchmark_repetitions, "Number of times to repeat each benchmark (default 1)", "benchmark_repetitions", 0, "N");
+    args_parser.add_option(m_benchmark_warmup_runs, "Number of unmeasured runs before sampling each benchmark (default 0)", "benchmark_warmup", 0, "N");
+    args_parser.add_option(m_benchmark_min_time_ms, "Keep sampling each benchmark until this much time was measured (default 0)", "benchmark_min_time", 0, "MS");
+    args_parser.add_option(m_benchmark_json_path, "Write benchmark statistics as JSON to this file", "benchmark_json", 0, "PATH");
+    args_parser.add_option(m_benchmark_baseline_path, "Fail benchmarks whose median regressed against this JSON file", "benchmark_baseline", 0, "PATH");
+    args_parser.add_option(m_benchmark_regression_threshold, "Allowed median regression against the baseline in percent (default 5)", "benchmark_threshold", 0, "PERCENT");
     args_parser.add_option(m_randomized_runs, "Number of times to run each RANDOMIZED_TEST_CASE (default 100)", "randomized_runs", 0, "RUNS");
     args_parser.add_option(do_list_cases, "List available test cases.", "list");
     args_parser.add_positional_argument(search_string, "Only run matching cases.", "pattern", Core::ArgsParser::Required::No);
@@ -184,45 +277,76 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
     size_t benchmark_failed_count = 0;
     TestElapsedTimer global_timer;
 
+    JsonObject benchmark_results;
+    Optional<JsonObject> benchmark_baseline;
+    if (!m_benchmark_baseline_path.is_empty()) {
+        auto baseline_or_error = load_benchmark_baseline(m_benchmark_baseline_path);
+        if (baseline_or_error.is_error())
+            warnln("Unable to load benchmark baseline '{}': {}", m_benchmark_baseline_path, baseline_or_error.error());
+        else
+            benchmark_baseline = baseline_or_error.release_value();
+    }
+
     for (auto const& t : tests) {
         auto const test_type = t->is_benchmark() ? "benchmark" : "test";
-        auto const repetitions = t->is_benchmark() ? m_benchmark_repetitions : 1;
+        auto const repetitions = t->is_benchmark() ? max<u64>(m_benchmark_repetitions, 1) : 1;
+        auto const min_time = t->is_benchmark() ? AK::Duration::from_milliseconds(m_benchmark_min_time_ms) : AK::Duration::zero();
 
         warnln("Running {} '{}'.", test_type, t->name());
         m_current_test_result = TestResult::NotRun;
         enable_reporting();
 
-        u64 total_time = 0;
-        u64 sum_of_squared_times = 0;
-        u64 min_time = NumericLimits<u64>::max();
-        u64 max_time = 0;
+        if (t->is_benchmark()) {
+            for (u64 i = 0; i < m_benchmark_warmup_runs; ++i)
+                t->func()();
+        }
+
+        Vector<i64> samples;
+        AK::Duration measured_time;
 
-        for (u64 i = 0; i < repetitions; ++i) {
-            TestElapsedTimer timer;
+        while (samples.size() < repetitions || measured_time < min_time) {
+            auto start = MonotonicTime::now();
             t->func()();
-            auto const iteration_time = timer.elapsed_milliseconds();
-            total_time += iteration_time;
-            sum_of_squared_times += iteration_time * iteration_time;
-            min_time = min(min_time, iteration_time);
-            max_time = max(max_time, iteration_time);
+            auto iteration_time = MonotonicTime::now() - start;
+            samples.append(iteration_time.to_nanoseconds());
+            measured_time += iteration_time;
 
             // Non-randomized tests don't touch the test result when passing.
             if (m_current_test_result == TestResult::NotRun)
                 m_current_test_result = TestResult::Passed;
         }
 
-        if (repetitions != 1) {
-            double average = total_time / double(repetitions);
-            double average_squared = average * average;
-            double standard_deviation = sqrt((sum_of_squared_times + repetitions * average_squared - 2 * total_time * average) / (repetitions - 1));
+        auto total_time = static_cast<u64>(measured_time.to_truncated_milliseconds());
 
-            dbgln("{} {} '{}' on average in {:.1f}±{:.1f}ms (min={}ms, max={}ms, total={}ms)",
+        if (samples.size() != 1) {
+            auto statistics = compute_benchmark_statistics(samples);
+
+            dbgln("{} {} '{}' in a median of {:.3f}ms (p95={:.3f}ms, mean={:.3f}±{:.3f}ms, min={:.3f}ms, max={:.3f}ms, samples={}, total={}ms)",
                 test_result_to_string(m_current_test_result), test_type, t->name(),
-                average, standard_deviation, min_time, max_time, total_time);
+                statistics.median_ns / 1e6, statistics.p95_ns / 1e6, statistics.mean_ns / 1e6, statistics.standard_deviation_ns / 1e6,
+                statistics.min_ns / 1e6, statistics.max_ns / 1e6, statistics.samples, total_time);
         } else {
             dbgln("{} {} '{}' in {}ms", test_result_to_string(m_current_test_result), test_type, t->name(), total_time);
         }
 
+        if (t->is_benchmark()) {
+            auto statistics = compute_benchmark_statistics(samples);
+            benchmark_results.set(t->name(), benchmark_statistics_to_json(statistics));
+
+            auto baseline = benchmark_baseline.has_value() ? benchmark_baseline->get_object(t->name()) : Optional<JsonObject const&> {};
+            auto baseline_median = baseline.has_value() ? baseline->get_double_with_precision_loss("median_ns"sv) : Optional<double> {};
+            if (baseline_median.has_value() && *baseline_median > 0) {
+                auto change = (statistics.median_ns - *baseline_median) / *baseline_median * 100;
+                dbgln("Benchmark '{}' median changed by {:+.1f}% against the baseline ({:.3f}ms -> {:.3f}ms)",
+                    t->name(), change, *baseline_median / 1e6, statistics.median_ns / 1e6);
+
+                if (change > m_benchmark_regression_threshold && m_current_test_result == TestResult::Passed) {
+                    warnln("\033[31;1mFAIL\033[0m: Benchmark '{}' regressed by more than {:.1f}%", t->name(), m_benchmark_regression_threshold);
+                    m_current_test_result = TestResult::Failed;
+                }
+            }
+        }
+
         if (t->is_benchmark()) {
             m_benchtime += total_time;
             benchmark_count++;
@@ -254,6 +378,11 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
         }
     }
 
+    if (!m_benchmark_json_path.is_empty()) {
+        if (auto result = write_benchmark_results(m_benchmark_json_path, m_suite_name, move(benchmark_results)); result.is_error())
+            warnln("Unable to write benchmark results to '{}': {}", m_benchmark_json_path, result.error());
+    }
+
     dbgln("Finished {} tests and {} benchmarks in {}ms ({}ms tests, {}ms benchmarks, {}ms other).",
         test_count,
         benchmark_count,
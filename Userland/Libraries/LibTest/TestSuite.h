@@ -69,6 +69,11 @@ private:
     u64 m_benchtime = 0;
     ByteString m_suite_name;
     u64 m_benchmark_repetitions = 1;
+    u64 m_benchmark_warmup_runs = 0;
+    u64 m_benchmark_min_time_ms = 0;
+    ByteString m_benchmark_json_path;
+    ByteString m_benchmark_baseline_path;
+    double m_benchmark_regression_threshold = 5.0;
     u64 m_randomized_runs = 100;
     Function<void()> m_setup;
     TestResult m_current_test_result = TestResult::NotRun;
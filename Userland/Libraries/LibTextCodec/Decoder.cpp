@@ -421,6 +421,44 @@ ErrorOr<String> UTF16LEDecoder::to_utf8(StringView input)
     return String::from_utf16(as_utf16(input, AK::Endianness::Little));
 }
 
+// Returns the length of the run of ASCII bytes at the start of the given bytes, checking a machine word at a time.
+static size_t ascii_run_length(ReadonlyBytes bytes)
+{
+    static constexpr FlatPtr non_ascii_mask = explode_byte(0x80);
+
+    size_t length = 0;
+    for (; length + sizeof(FlatPtr) <= bytes.size(); length += sizeof(FlatPtr)) {
+        FlatPtr word;
+        __builtin_memcpy(&word, bytes.data() + length, sizeof(word));
+        if (word & non_ascii_mask)
+            break;
+    }
+    while (length < bytes.size() && bytes[length] < 0x80)
+        length++;
+    return length;
+}
+
+// Decodes an encoding that maps ASCII bytes to themselves, copying runs of ASCII bytes to the output in bulk and only
+// mapping the remaining bytes one at a time.
+static ErrorOr<String> ascii_compatible_single_byte_to_utf8(StringView input, auto map_non_ascii_byte)
+{
+    auto bytes = input.bytes();
+    auto offset = ascii_run_length(bytes);
+    if (offset == bytes.size())
+        return String::from_utf8_without_validation(bytes);
+
+    StringBuilder builder(input.length() + input.length() / 2);
+    TRY(builder.try_append(input.substring_view(0, offset)));
+    while (offset < bytes.size()) {
+        TRY(builder.try_append_code_point(map_non_ascii_byte(bytes[offset++])));
+
+        auto run_length = ascii_run_length(bytes.slice(offset));
+        TRY(builder.try_append(input.substring_view(offset, run_length)));
+        offset += run_length;
+    }
+    return builder.to_string_without_validation();
+}
+
 ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
     for (u8 ch : input) {
@@ -431,6 +469,11 @@ ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u3
     return {};
 }
 
+ErrorOr<String> Latin1Decoder::to_utf8(StringView input)
+{
+    return ascii_compatible_single_byte_to_utf8(input, [](u8 byte) -> u32 { return byte; });
+}
+
 ErrorOr<void> PDFDocEncodingDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
     // PDF 1.7 spec, Appendix D.2 "PDFDocEncoding Character Set"
@@ -502,6 +545,11 @@ ErrorOr<void> XUserDefinedDecoder::process(StringView input, Function<ErrorOr<vo
     return {};
 }
 
+ErrorOr<String> XUserDefinedDecoder::to_utf8(StringView input)
+{
+    return ascii_compatible_single_byte_to_utf8(input, [](u8 byte) -> u32 { return 0xF780 + byte - 0x80; });
+}
+
 // https://encoding.spec.whatwg.org/#single-byte-decoder
 template<Integral ArrayType>
 ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
@@ -525,6 +573,22 @@ ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<E
     return {};
 }
 
+template<Integral ArrayType>
+bool SingleByteDecoder<ArrayType>::validate(StringView input)
+{
+    for (u8 const byte : input) {
+        if (byte >= 0x80 && m_translation_table[byte - 0x80] == replacement_code_point)
+            return false;
+    }
+    return true;
+}
+
+template<Integral ArrayType>
+ErrorOr<String> SingleByteDecoder<ArrayType>::to_utf8(StringView input)
+{
+    return ascii_compatible_single_byte_to_utf8(input, [this](u8 byte) -> u32 { return m_translation_table[byte - 0x80]; });
+}
+
 // https://encoding.spec.whatwg.org/#index-gb18030-ranges-code-point
 static Optional<u32> index_gb18030_ranges_code_point(u32 pointer)
 {
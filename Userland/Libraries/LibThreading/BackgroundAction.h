@@ -16,7 +16,7 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/EventReceiver.h>
 #include <LibCore/Promise.h>
-#include <LibThreading/Thread.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace Threading {
 
@@ -30,8 +30,7 @@ class BackgroundActionBase {
 private:
     BackgroundActionBase() = default;
 
-    static void enqueue_work(ESCAPING Function<void()>);
-    static Thread& background_thread();
+    static void enqueue_work(ESCAPING Function<void()>, ThreadPool::Priority);
 };
 
 template<typename Result>
@@ -55,7 +54,7 @@ public:
     bool is_canceled() const { return m_canceled; }
 
 private:
-    BackgroundAction(ESCAPING Function<ErrorOr<Result>(BackgroundAction&)> action, ESCAPING Function<ErrorOr<void>(Result)> on_complete, ESCAPING Optional<Function<void(Error)>> on_error = {})
+    BackgroundAction(ESCAPING Function<ErrorOr<Result>(BackgroundAction&)> action, ESCAPING Function<ErrorOr<void>(Result)> on_complete, ESCAPING Optional<Function<void(Error)>> on_error = {}, ThreadPool::Priority priority = ThreadPool::Priority::Normal)
         : m_promise(Promise::try_create().release_value_but_fixme_should_propagate_errors())
         , m_action(move(action))
         , m_on_complete(move(on_complete))
@@ -75,7 +74,7 @@ private:
         if (on_error.has_value())
             m_on_error = on_error.release_value();
 
-        enqueue_work([self = NonnullRefPtr(*this), origin_event_loop = &Core::EventLoop::current()]() {
+        auto work = [self = NonnullRefPtr(*this), origin_event_loop = &Core::EventLoop::current()]() {
             auto result = self->m_action(*self);
             // The event loop cancels the promise when it exits.
             self->m_canceled |= self->m_promise->is_rejected();
@@ -106,7 +105,8 @@ private:
                     self->m_on_error(move(error));
                 }
             }
-        });
+        };
+        enqueue_work(move(work), priority);
     }
 
     NonnullRefPtr<Promise> m_promise;
@@ -119,6 +119,7 @@ private:
     bool m_canceled { false };
 };
 
+// Stops the threads that run background actions. Actions that have not started yet are dropped.
 void quit_background_thread();
 
 }
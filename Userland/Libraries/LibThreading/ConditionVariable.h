@@ -7,9 +7,12 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <AK/Time.h>
 #include <LibThreading/Mutex.h>
+#include <errno.h>
 #include <pthread.h>
 #include <sys/types.h>
+#include <time.h>
 
 namespace Threading {
 
@@ -42,6 +45,17 @@ public:
         while (condition())
             wait();
     }
+    // Returns false if the time ran out before the variable was signaled.
+    ALWAYS_INLINE bool wait_for(AK::Duration timeout)
+    {
+        timespec now;
+        auto clock_result = clock_gettime(CLOCK_REALTIME, &now);
+        VERIFY(clock_result == 0);
+        auto deadline = (AK::Duration::from_timespec(now) + timeout).to_timespec();
+        auto result = pthread_cond_timedwait(&m_condition, &m_to_wait_on.m_mutex, &deadline);
+        VERIFY(result == 0 || result == ETIMEDOUT);
+        return result == 0;
+    }
     // Release at least one of the threads waiting on this variable.
     ALWAYS_INLINE void signal()
     {
@@ -9,6 +9,9 @@
 
 namespace Threading {
 
+class Thread;
+class ThreadPool;
+
 template<typename ErrorType>
 class WorkerThread;
 
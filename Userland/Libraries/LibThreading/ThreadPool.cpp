@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteString.h>
+#include <LibCore/System.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Threading {
+
+static pthread_mutex_t s_default_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static ThreadPool* s_default_pool;
+static size_t s_default_thread_count;
+
+// The pool and worker that the current thread belongs to, if it is a worker thread.
+static thread_local ThreadPool* s_current_pool;
+static thread_local size_t s_current_worker_index;
+
+ThreadPool& ThreadPool::the()
+{
+    pthread_mutex_lock(&s_default_pool_mutex);
+    if (!s_default_pool) {
+        auto thread_count = s_default_thread_count;
+        if (thread_count == 0)
+            thread_count = max(Core::System::hardware_concurrency(), 1u);
+        s_default_pool = new ThreadPool(thread_count, "Background Thread"sv);
+    }
+    auto& pool = *s_default_pool;
+    pthread_mutex_unlock(&s_default_pool_mutex);
+    return pool;
+}
+
+void ThreadPool::set_default_thread_count(size_t thread_count)
+{
+    pthread_mutex_lock(&s_default_pool_mutex);
+    VERIFY(!s_default_pool);
+    s_default_thread_count = thread_count;
+    pthread_mutex_unlock(&s_default_pool_mutex);
+}
+
+void ThreadPool::shut_down_default()
+{
+    pthread_mutex_lock(&s_default_pool_mutex);
+    auto* pool = exchange(s_default_pool, nullptr);
+    pthread_mutex_unlock(&s_default_pool_mutex);
+
+    delete pool;
+}
+
+ThreadPool::ThreadPool(size_t thread_count, StringView name)
+{
+    VERIFY(thread_count > 0);
+
+    m_workers.ensure_capacity(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+        m_workers.unchecked_append(make<Worker>());
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto thread_name = thread_count == 1 ? ByteString(name) : ByteString::formatted("{} {}", name, i);
+        m_workers[i]->thread = Thread::construct([this, i] { return run_worker(i); }, thread_name);
+        m_workers[i]->thread->start();
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    shut_down();
+}
+
+NonnullRefPtr<ThreadPool::Task> ThreadPool::submit(Function<void()> work, Priority priority)
+{
+    auto task = adopt_ref(*new Task(move(work), priority));
+
+    // NOTE: Work queued by a worker stays on that worker, everything else is spread over all of them.
+    auto worker_index = s_current_pool == this
+        ? s_current_worker_index
+        : m_next_worker.fetch_add(1, AK::MemoryOrder::memory_order_relaxed) % m_workers.size();
+
+    m_unfinished_task_count.fetch_add(1, AK::MemoryOrder::memory_order_acq_rel);
+
+    auto& worker = *m_workers[worker_index];
+    {
+        MutexLocker locker(worker.mutex);
+        worker.queues[to_underlying(priority)].append(task);
+    }
+
+    MutexLocker locker(m_mutex);
+    m_queued_task_count.fetch_add(1, AK::MemoryOrder::memory_order_acq_rel);
+    m_work_available.signal();
+
+    return task;
+}
+
+RefPtr<ThreadPool::Task> ThreadPool::take_task(size_t index)
+{
+    for (size_t priority = 0; priority < priority_count; ++priority) {
+        // NOTE: Our own queue comes first, the other workers are visited starting with our neighbor.
+        for (size_t offset = 0; offset < m_workers.size(); ++offset) {
+            auto& worker = *m_workers[(index + offset) % m_workers.size()];
+            MutexLocker locker(worker.mutex);
+            if (auto& queue = worker.queues[priority]; !queue.is_empty())
+                return queue.take_first();
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::finish_task()
+{
+    if (m_unfinished_task_count.fetch_sub(1, AK::MemoryOrder::memory_order_acq_rel) != 1)
+        return;
+
+    MutexLocker locker(m_mutex);
+    m_all_tasks_done.broadcast();
+}
+
+intptr_t ThreadPool::run_worker(size_t index)
+{
+    s_current_pool = this;
+    s_current_worker_index = index;
+
+    while (true) {
+        {
+            MutexLocker locker(m_mutex);
+            m_work_available.wait_while([this] {
+                return m_queued_task_count.load(AK::MemoryOrder::memory_order_acquire) <= 0 && !m_should_exit;
+            });
+            if (m_should_exit)
+                break;
+        }
+
+        auto task = take_task(index);
+        if (!task)
+            continue;
+        m_queued_task_count.fetch_sub(1, AK::MemoryOrder::memory_order_acq_rel);
+
+        if (!task->is_canceled())
+            task->m_work();
+
+        // NOTE: Drop whatever the work captured on this thread, rather than whenever the last reference to the task goes away.
+        task->m_work = nullptr;
+        finish_task();
+    }
+
+    return 0;
+}
+
+void ThreadPool::wait_for_all()
+{
+    VERIFY(s_current_pool != this);
+
+    MutexLocker locker(m_mutex);
+    m_all_tasks_done.wait_while([this] {
+        return m_unfinished_task_count.load(AK::MemoryOrder::memory_order_acquire) > 0;
+    });
+}
+
+void ThreadPool::shut_down()
+{
+    {
+        MutexLocker locker(m_mutex);
+        if (m_should_exit)
+            return;
+        m_should_exit = true;
+        m_work_available.broadcast();
+    }
+
+    for (auto& worker : m_workers)
+        MUST(worker->thread->join());
+
+    // Tasks that never got to run are finished all the same, so that nobody waits for them forever.
+    for (auto& worker : m_workers) {
+        for (auto& queue : worker->queues) {
+            for (size_t i = 0; i < queue.size(); ++i)
+                finish_task();
+            queue.clear();
+        }
+    }
+}
+
+}
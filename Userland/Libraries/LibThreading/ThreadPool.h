@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// A pool of worker threads that run submitted tasks. Every worker has its own queue of tasks for each priority, and
+// runs the tasks in its own queue in order. When a worker runs out of tasks of some priority, it steals one from the
+// other workers before moving on to a lower priority. Tasks queued from inside a worker stay on that worker, so related
+// work tends to stay on one core.
+class ThreadPool {
+    AK_MAKE_NONCOPYABLE(ThreadPool);
+    AK_MAKE_NONMOVABLE(ThreadPool);
+
+public:
+    enum class Priority : u8 {
+        High,
+        Normal,
+        Low,
+    };
+
+    class Task : public AtomicRefCounted<Task> {
+    public:
+        // A canceled task that has not started yet will never run. A task that is already running is not interrupted.
+        void cancel() { m_canceled.store(true, AK::MemoryOrder::memory_order_release); }
+        bool is_canceled() const { return m_canceled.load(AK::MemoryOrder::memory_order_acquire); }
+
+        Priority priority() const { return m_priority; }
+
+    private:
+        friend class ThreadPool;
+
+        Task(Function<void()> work, Priority priority)
+            : m_work(move(work))
+            , m_priority(priority)
+        {
+        }
+
+        Function<void()> m_work;
+        Priority m_priority { Priority::Normal };
+        Atomic<bool> m_canceled { false };
+    };
+
+    // The pool shared by everything in the process, e.g. BackgroundAction. It is created on first use.
+    static ThreadPool& the();
+
+    // Must be called before the shared pool is first used. By default, the shared pool has one thread per core.
+    static void set_default_thread_count(size_t);
+
+    // Stops the shared pool's threads. Tasks that have not started yet are dropped. Using the shared pool again creates
+    // a new one.
+    static void shut_down_default();
+
+    explicit ThreadPool(size_t thread_count, StringView name = "Thread Pool"sv);
+    ~ThreadPool();
+
+    NonnullRefPtr<Task> submit(ESCAPING Function<void()> work, Priority = Priority::Normal);
+
+    // Blocks until every task submitted so far has either run or been canceled.
+    void wait_for_all();
+
+    // Stops all threads once they are done with their current task. Tasks that have not started yet are dropped.
+    void shut_down();
+
+    size_t thread_count() const { return m_workers.size(); }
+
+private:
+    static constexpr size_t priority_count = 3;
+
+    struct Worker {
+        Mutex mutex;
+        Array<Vector<NonnullRefPtr<Task>>, priority_count> queues;
+        RefPtr<Thread> thread;
+    };
+
+    intptr_t run_worker(size_t index);
+    RefPtr<Task> take_task(size_t index);
+    void finish_task();
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+    Atomic<size_t> m_next_worker { 0 };
+
+    Mutex m_mutex;
+    ConditionVariable m_work_available { m_mutex };
+    ConditionVariable m_all_tasks_done { m_mutex };
+
+    // Tasks that are queued, but not taken by a worker yet. This may briefly drop below zero, when a worker takes a task
+    // before the thread that queued it got to count it.
+    Atomic<i64> m_queued_task_count { 0 };
+
+    // Tasks that are queued or running.
+    Atomic<size_t> m_unfinished_task_count { 0 };
+
+    bool m_should_exit { false };
+};
+
+}
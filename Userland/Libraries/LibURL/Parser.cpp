@@ -817,10 +817,109 @@ String Parser::percent_encode_after_encoding(TextCodec::Encoder& encoder, String
 }
 
 // https://url.spec.whatwg.org/#concept-basic-url-parser
+static bool is_in_none_of_percent_encode_sets(StringView input, PercentEncodeSet percent_encode_set)
+{
+    return all_of(input, [&](char character) {
+        return is_ascii_printable(character) && character != ' ' && !code_point_is_in_percent_encode_set(character, percent_encode_set);
+    });
+}
+
+// OPTIMIZATION: Most URLs are already normalized ASCII URLs with a special scheme, like "https://example.com/a/b?c#d".
+//               For those, the basic URL parser only copies each component over as-is, so we can split the input in a
+//               single pass and skip the state machine. Anything that would need percent-encoding, lowercasing, IDNA,
+//               IP address parsing, path normalization or credentials returns nothing and is left to the full parser.
+//               A base URL doesn't matter here: with a special scheme followed by "//", the state machine always ends
+//               up in the special authority ignore slashes state, whether or not there is a base URL.
+Optional<URL> Parser::parse_normalized_special_url(StringView input)
+{
+    auto scheme_end = input.find("://"sv);
+    if (!scheme_end.has_value())
+        return {};
+    auto scheme = input.substring_view(0, *scheme_end);
+    if (!scheme.is_one_of("http"sv, "https"sv, "ws"sv, "wss"sv))
+        return {};
+
+    auto rest = input.substring_view(*scheme_end + 3);
+    auto authority_end = rest.find_any_of("/?#"sv).value_or(rest.length());
+    auto authority = rest.substring_view(0, authority_end);
+    rest = rest.substring_view(authority_end);
+
+    StringView host = authority;
+    Optional<u16> port;
+    if (auto port_start = authority.find(':'); port_start.has_value()) {
+        host = authority.substring_view(0, *port_start);
+        auto port_digits = authority.substring_view(*port_start + 1);
+        if (port_digits.is_empty() || port_digits.length() > 5 || !all_of(port_digits, is_ascii_digit))
+            return {};
+        auto port_number = port_digits.to_number<u32>();
+        if (!port_number.has_value() || *port_number > NumericLimits<u16>::max())
+            return {};
+        if (*port_number != default_port_for_scheme(scheme).value())
+            port = static_cast<u16>(*port_number);
+    }
+
+    // The host must already be what parsing it as a domain would produce: a lowercase ASCII domain without punycode
+    // labels that is not an IPv4 address.
+    if (host.is_empty() || host.starts_with('.') || host.ends_with('.') || host.contains(".."sv))
+        return {};
+    if (!all_of(host, [](char character) { return is_ascii_lower_alpha(character) || is_ascii_digit(character) || character == '-' || character == '.'; }))
+        return {};
+    if (host.starts_with("xn--"sv) || host.contains(".xn--"sv) || ends_in_a_number_checker(host))
+        return {};
+
+    auto path = rest;
+    Optional<StringView> query;
+    Optional<StringView> fragment;
+    if (auto fragment_start = path.find('#'); fragment_start.has_value()) {
+        fragment = path.substring_view(*fragment_start + 1);
+        path = path.substring_view(0, *fragment_start);
+    }
+    if (auto query_start = path.find('?'); query_start.has_value()) {
+        query = path.substring_view(*query_start + 1);
+        path = path.substring_view(0, *query_start);
+    }
+
+    if (!is_in_none_of_percent_encode_sets(path, PercentEncodeSet::Path) || path.contains('\\'))
+        return {};
+    if (query.has_value() && !is_in_none_of_percent_encode_sets(*query, PercentEncodeSet::SpecialQuery))
+        return {};
+    if (fragment.has_value() && !is_in_none_of_percent_encode_sets(*fragment, PercentEncodeSet::Fragment))
+        return {};
+
+    // NOTE: Both "" and "/" produce a single empty path segment.
+    URL url;
+    if (path.length() <= 1) {
+        url.m_data->paths.append(String {});
+    } else {
+        path.substring_view(1).for_each_split_view('/', SplitBehavior::KeepEmpty, [&](auto segment) {
+            url.m_data->paths.append(String::from_utf8_without_validation(segment.bytes()));
+        });
+        for (auto const& segment : url.m_data->paths) {
+            if (is_single_dot_path_segment(segment) || is_double_dot_path_segment(segment))
+                return {};
+        }
+    }
+
+    url.m_data->scheme = String::from_utf8_without_validation(scheme.bytes());
+    url.m_data->host = String::from_utf8_without_validation(host.bytes());
+    url.m_data->port = port;
+    if (query.has_value())
+        url.m_data->query = String::from_utf8_without_validation(query->bytes());
+    if (fragment.has_value())
+        url.m_data->fragment = String::from_utf8_without_validation(fragment->bytes());
+    url.m_data->valid = true;
+    return url;
+}
+
 URL Parser::basic_parse(StringView raw_input, Optional<URL> const& base_url, URL* url, Optional<State> state_override, Optional<StringView> encoding)
 {
     dbgln_if(URL_PARSER_DEBUG, "URL::Parser::basic_parse: Parsing '{}'", raw_input);
 
+    if (!url && !state_override.has_value()) {
+        if (auto parsed_url = parse_normalized_special_url(raw_input); parsed_url.has_value())
+            return parsed_url.release_value();
+    }
+
     size_t start_index = 0;
     size_t end_index = raw_input.length();
 
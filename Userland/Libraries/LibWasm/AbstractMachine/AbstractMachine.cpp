@@ -132,6 +132,79 @@ DataInstance* Store::get(DataAddress address)
     return &m_datas[value];
 }
 
+// Replaces common instruction sequences in a validated function body with fused synthetic instructions.
+// NOTE: The fused instruction takes the place of the first instruction of its sequence, and the rest are left in place for
+//       the interpreter to skip over, so the instruction pointers stored in structured instructions all stay valid.
+//       Nothing can branch into the middle of such a sequence, as branch targets always follow a structured instruction.
+//       Validation has already established the types of all operands, so the fused instructions don't have to check them.
+static void compile_into_synthetic_instructions(Expression& expression)
+{
+    auto& instructions = expression.instructions();
+    auto is_at = [&](size_t index, OpCode opcode) {
+        return index < instructions.size() && instructions[index].opcode() == opcode;
+    };
+    auto local_at = [&](size_t index) { return instructions[index].arguments().get<LocalIndex>(); };
+    auto i32_at = [&](size_t index) { return instructions[index].arguments().get<i32>(); };
+    auto is_fusable_i32_operation_at = [&](size_t index) {
+        if (index >= instructions.size())
+            return false;
+        switch (instructions[index].opcode().value()) {
+        case Instructions::i32_add.value():
+        case Instructions::i32_sub.value():
+        case Instructions::i32_mul.value():
+        case Instructions::i32_and.value():
+        case Instructions::i32_or.value():
+        case Instructions::i32_xor.value():
+        case Instructions::i32_shl.value():
+        case Instructions::i32_shru.value():
+            return true;
+        default:
+            return false;
+        }
+    };
+
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        if (is_at(i, Instructions::local_get)) {
+            // Operations whose operands come from locals, and whose result immediately goes into a local, don't need to touch the value stack at all.
+            if (is_at(i + 1, Instructions::local_get) && is_fusable_i32_operation_at(i + 2) && is_at(i + 3, Instructions::local_set)) {
+                instructions[i] = Instruction(Instructions::synthetic_i32_op2local_to_local, Instruction::LocalsBinaryOperationArgs { instructions[i + 2].opcode(), local_at(i), local_at(i + 1), local_at(i + 3) });
+                i += 3;
+                continue;
+            }
+            if (is_at(i + 1, Instructions::i32_const) && is_fusable_i32_operation_at(i + 2) && is_at(i + 3, Instructions::local_set)) {
+                instructions[i] = Instruction(Instructions::synthetic_i32_opconstlocal_to_local, Instruction::LocalAndConstBinaryOperationArgs { instructions[i + 2].opcode(), local_at(i), i32_at(i + 1), local_at(i + 3) });
+                i += 3;
+                continue;
+            }
+            if (is_at(i + 1, Instructions::local_get) && is_at(i + 2, Instructions::i32_add)) {
+                instructions[i] = Instruction(Instructions::synthetic_i32_add2local, Instruction::LocalIndexPair { local_at(i), local_at(i + 1) });
+                i += 2;
+                continue;
+            }
+            if (is_at(i + 1, Instructions::i32_const) && is_at(i + 2, Instructions::i32_add)) {
+                instructions[i] = Instruction(Instructions::synthetic_i32_addconstlocal, Instruction::LocalIndexAndI32 { local_at(i), i32_at(i + 1) });
+                i += 2;
+                continue;
+            }
+            if (is_at(i + 1, Instructions::i32_const) && is_at(i + 2, Instructions::i32_and)) {
+                instructions[i] = Instruction(Instructions::synthetic_i32_andconstlocal, Instruction::LocalIndexAndI32 { local_at(i), i32_at(i + 1) });
+                i += 2;
+                continue;
+            }
+            if (is_at(i + 1, Instructions::local_set)) {
+                instructions[i] = Instruction(Instructions::synthetic_local_copy, Instruction::LocalIndexPair { local_at(i), local_at(i + 1) });
+                i += 1;
+                continue;
+            }
+        }
+        if (is_at(i, Instructions::i32_const) && is_at(i + 1, Instructions::local_set)) {
+            instructions[i] = Instruction(Instructions::synthetic_local_seti32_const, Instruction::LocalIndexAndI32 { local_at(i + 1), i32_at(i) });
+            i += 1;
+            continue;
+        }
+    }
+}
+
 ErrorOr<void, ValidationError> AbstractMachine::validate(Module& module)
 {
     if (module.validation_status() != Module::ValidationStatus::Unchecked) {
@@ -147,6 +220,9 @@ ErrorOr<void, ValidationError> AbstractMachine::validate(Module& module)
         return result.release_error();
     }
 
+    for (auto& code : module.code_section().functions())
+        compile_into_synthetic_instructions(code.func().body());
+
     return {};
 }
 InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<ExternValue> externs)
@@ -427,6 +427,18 @@ public:
     {
         MemoryInstance instance { type };
 
+        // OPTIMIZATION: Growing a memory would copy all of its contents whenever the buffer has to be reallocated.
+        //               If the memory declares how large it can get, allocate up to that much capacity up front instead.
+        //               Allocations this large are mapped lazily, so their pages are only backed once a grow zeroes them.
+        //               That still takes up address space, so we only do this on 64-bit targets, and never for more
+        //               than a limited size. If it fails, we simply fall back to reallocating on grow.
+        if constexpr (sizeof(FlatPtr) == 8) {
+            if (auto max = type.limits().max(); max.has_value() && *max > type.limits().min()) {
+                auto max_size = min(static_cast<u64>(*max) * Constants::page_size, Constants::max_reserved_memory_size);
+                (void)instance.m_data.try_ensure_capacity(max_size);
+            }
+        }
+
         if (!instance.grow(type.limits().min() * Constants::page_size, GrowType::No))
             return Error::from_string_literal("Failed to grow to requested size");
 
@@ -56,6 +56,32 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     }
 }
 
+// Evaluates one of the i32 operations that the fused synthetic instructions can be made of (see AbstractMachine.cpp),
+// with the same operand types as the regular instruction would use.
+static ALWAYS_INLINE i32 evaluate_fused_i32_operation(OpCode operation, i32 lhs, i32 rhs)
+{
+    switch (operation.value()) {
+    case Instructions::i32_add.value():
+        return static_cast<i32>(Operators::Add {}(bit_cast<u32>(lhs), bit_cast<u32>(rhs)));
+    case Instructions::i32_sub.value():
+        return static_cast<i32>(Operators::Subtract {}(bit_cast<u32>(lhs), bit_cast<u32>(rhs)));
+    case Instructions::i32_mul.value():
+        return static_cast<i32>(Operators::Multiply {}(bit_cast<u32>(lhs), bit_cast<u32>(rhs)));
+    case Instructions::i32_and.value():
+        return Operators::BitAnd {}(lhs, rhs);
+    case Instructions::i32_or.value():
+        return Operators::BitOr {}(lhs, rhs);
+    case Instructions::i32_xor.value():
+        return Operators::BitXor {}(lhs, rhs);
+    case Instructions::i32_shl.value():
+        return static_cast<i32>(Operators::BitShiftLeft {}(bit_cast<u32>(lhs), bit_cast<u32>(rhs)));
+    case Instructions::i32_shru.value():
+        return static_cast<i32>(Operators::BitShiftRight {}(bit_cast<u32>(lhs), bit_cast<u32>(rhs)));
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
 void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
@@ -369,38 +395,26 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
     data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
 }
 
+// NOTE: The callers have already checked that the value lies within the bounds of the memory, so these can't fail.
 template<typename T>
 T BytecodeInterpreter::read_value(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto value_or_error = stream.read_value<LittleEndian<T>>();
-    if (value_or_error.is_error()) {
-        dbgln("Read from {} failed", data.data());
-        m_trap = Trap { "Read from memory failed" };
-    }
-    return value_or_error.release_value();
+    VERIFY(data.size() >= sizeof(T));
+    LittleEndian<T> value;
+    __builtin_memcpy(&value, data.data(), sizeof(T));
+    return value;
 }
 
 template<>
 float BytecodeInterpreter::read_value<float>(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u32>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap { "Read from memory failed" };
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<float>(static_cast<u32>(raw_value));
+    return bit_cast<float>(read_value<u32>(data));
 }
 
 template<>
 double BytecodeInterpreter::read_value<double>(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u64>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap { "Read from memory failed" };
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<double>(static_cast<u64>(raw_value));
+    return bit_cast<double>(read_value<u64>(data));
 }
 
 ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
@@ -421,6 +435,55 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         configuration.frame().locals()[instruction.arguments().get<LocalIndex>().value()] = value;
         return;
     }
+    case Instructions::synthetic_i32_add2local.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalIndexPair>();
+        auto& locals = configuration.frame().locals();
+        auto result = locals[args.first.value()].to<u32>() + locals[args.second.value()].to<u32>();
+        configuration.value_stack().append(Value(static_cast<i32>(result)));
+        configuration.ip() = ip.value() + 3;
+        return;
+    }
+    case Instructions::synthetic_i32_addconstlocal.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalIndexAndI32>();
+        auto result = configuration.frame().locals()[args.local.value()].to<u32>() + static_cast<u32>(args.value);
+        configuration.value_stack().append(Value(static_cast<i32>(result)));
+        configuration.ip() = ip.value() + 3;
+        return;
+    }
+    case Instructions::synthetic_i32_andconstlocal.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalIndexAndI32>();
+        auto result = configuration.frame().locals()[args.local.value()].to<i32>() & args.value;
+        configuration.value_stack().append(Value(result));
+        configuration.ip() = ip.value() + 3;
+        return;
+    }
+    case Instructions::synthetic_local_seti32_const.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalIndexAndI32>();
+        configuration.frame().locals()[args.local.value()] = Value(args.value);
+        configuration.ip() = ip.value() + 2;
+        return;
+    }
+    case Instructions::synthetic_local_copy.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalIndexPair>();
+        auto& locals = configuration.frame().locals();
+        locals[args.second.value()] = locals[args.first.value()];
+        configuration.ip() = ip.value() + 2;
+        return;
+    }
+    case Instructions::synthetic_i32_op2local_to_local.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalsBinaryOperationArgs>();
+        auto& locals = configuration.frame().locals();
+        locals[args.result.value()] = Value(evaluate_fused_i32_operation(args.operation, locals[args.lhs.value()].to<i32>(), locals[args.rhs.value()].to<i32>()));
+        configuration.ip() = ip.value() + 4;
+        return;
+    }
+    case Instructions::synthetic_i32_opconstlocal_to_local.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalAndConstBinaryOperationArgs>();
+        auto& locals = configuration.frame().locals();
+        locals[args.result.value()] = Value(evaluate_fused_i32_operation(args.operation, locals[args.lhs.value()].to<i32>(), args.rhs));
+        configuration.ip() = ip.value() + 4;
+        return;
+    }
     case Instructions::i32_const.value():
         configuration.value_stack().append(Value(instruction.arguments().get<i32>()));
         return;
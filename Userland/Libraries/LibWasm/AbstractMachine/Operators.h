@@ -330,6 +330,19 @@ struct VectorReplaceLane {
     }
 };
 
+// These operators give the same result for every lane when applied to an entire native vector at once, as their scalar
+// results don't depend on the integer promotions that the element types go through (unlike e.g. Average or Q15Mul).
+template<typename Op>
+constexpr bool is_lane_wise_integer_operation = IsOneOf<Op, Add, Subtract, Multiply, BitAnd, BitOr, BitXor>;
+
+template<typename Op>
+constexpr bool is_lane_wise_float_operation = IsOneOf<Op, Add, Subtract, Multiply, Divide>;
+
+// Comparing native vectors produces a mask with all bits set in the lanes where the comparison holds, which is exactly
+// what the Wasm comparison instructions produce.
+template<typename Op>
+constexpr bool is_lane_wise_comparison = IsOneOf<Op, Equals, NotEquals, GreaterThan, LessThan, LessThanOrEquals, GreaterThanOrEquals>;
+
 template<size_t VectorSize, typename Op, template<typename> typename SetSign = MakeSigned>
 struct VectorCmpOp {
     auto operator()(u128 c1, u128 c2) const
@@ -338,6 +351,9 @@ struct VectorCmpOp {
         auto result = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c1);
         auto other = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c2);
         Op op;
+        if constexpr (is_lane_wise_comparison<Op>)
+            return bit_cast<u128>(op(result, other));
+
         for (size_t i = 0; i < VectorSize; ++i) {
             SetSign<ElementType> lhs = result[i];
             SetSign<ElementType> rhs = other[i];
@@ -372,6 +388,9 @@ struct VectorFloatCmpOp {
         using ElementType = NativeIntegralType<128 / VectorSize>;
         Native128ByteVectorOf<ElementType, MakeUnsigned> result;
         Op op;
+        if constexpr (is_lane_wise_comparison<Op>)
+            return bit_cast<u128>(op(first, other));
+
         for (size_t i = 0; i < VectorSize; ++i)
             result[i] = op(first[i], other[i]) ? static_cast<ElementType>(-1) : 0;
         return bit_cast<u128>(result);
@@ -689,13 +708,18 @@ template<size_t VectorSize, typename Op, template<typename> typename SetSign = M
 struct VectorIntegerBinaryOp {
     auto operator()(u128 lhs, u128 rhs) const
     {
+        if constexpr (is_lane_wise_integer_operation<Op>) {
+            // NOTE: These wrap around the same way regardless of the signedness, but only do so well-definedly when unsigned.
+            using UnsignedVectorType = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
+            return bit_cast<u128>(Op {}(bit_cast<UnsignedVectorType>(lhs), bit_cast<UnsignedVectorType>(rhs)));
+        }
+
         using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
         auto first = bit_cast<VectorType>(lhs);
         auto second = bit_cast<VectorType>(rhs);
         VectorType result;
         Op op;
 
-        // FIXME: Find a way to not loop here
         for (size_t i = 0; i < VectorSize; ++i) {
             result[i] = op(first[i], second[i]);
         }
@@ -834,6 +858,18 @@ struct VectorFloatBinaryOp {
         using VectorType = NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>;
         auto first = bit_cast<VectorType>(lhs);
         auto second = bit_cast<VectorType>(rhs);
+        if constexpr (is_lane_wise_float_operation<Op>) {
+            // NOTE: Divide's scalar operator can't tell that a vector is floating point, so spell the operations out.
+            if constexpr (IsSame<Op, Add>)
+                return bit_cast<u128>(first + second);
+            else if constexpr (IsSame<Op, Subtract>)
+                return bit_cast<u128>(first - second);
+            else if constexpr (IsSame<Op, Multiply>)
+                return bit_cast<u128>(first * second);
+            else
+                return bit_cast<u128>(first / second);
+        }
+
         VectorType result;
         Op op;
         for (size_t i = 0; i < VectorSize; ++i) {
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/LEB128.h>
+#include <AK/MemoryStream.h>
+#include <AK/QuickSort.h>
+#include <LibWasm/AbstractMachine/Profiler.h>
+#include <LibWasm/Printer/Printer.h>
+
+namespace Wasm {
+
+// https://webassembly.github.io/spec/core/appendix/custom.html#function-names
+static ErrorOr<HashMap<u32, ByteString>> parse_function_names(ReadonlyBytes contents)
+{
+    static constexpr u8 function_names_subsection_id = 1;
+
+    HashMap<u32, ByteString> names;
+    FixedMemoryStream stream { contents };
+    while (!stream.is_eof()) {
+        auto id = TRY(stream.read_value<u8>());
+        u32 size = TRY(stream.read_value<LEB128<u32>>());
+        if (id != function_names_subsection_id) {
+            TRY(stream.discard(size));
+            continue;
+        }
+
+        u32 count = TRY(stream.read_value<LEB128<u32>>());
+        for (u32 i = 0; i < count; ++i) {
+            u32 index = TRY(stream.read_value<LEB128<u32>>());
+            u32 length = TRY(stream.read_value<LEB128<u32>>());
+            auto name = TRY(ByteBuffer::create_uninitialized(length));
+            TRY(stream.read_until_filled(name));
+            names.set(index, ByteString(name.bytes()));
+        }
+        break;
+    }
+    return names;
+}
+
+void Profiler::add_module(Module const& module, ModuleInstance const& instance, Store& store)
+{
+    HashMap<u32, ByteString> names;
+    for (auto& section : module.custom_sections()) {
+        if (section.name() != "name"sv)
+            continue;
+        auto names_or_error = parse_function_names(section.contents());
+        if (names_or_error.is_error()) {
+            dbgln("Ignoring malformed name section: {}", names_or_error.error());
+            break;
+        }
+        names = names_or_error.release_value();
+        break;
+    }
+
+    for (size_t index = 0; index < instance.functions().size(); ++index) {
+        auto* function = store.get(instance.functions()[index]);
+        if (!function || !function->has<WasmFunction>())
+            continue;
+        auto& body = function->get<WasmFunction>().code().func().body();
+        auto name = names.get(index);
+        m_function_names.set(&body, name.has_value() ? name.release_value() : ByteString::formatted("func{}", index));
+    }
+}
+
+void Profiler::attach(DebuggerBytecodeInterpreter& interpreter)
+{
+    interpreter.pre_interpret_hook = [this, previous_hook = move(interpreter.pre_interpret_hook)](auto& configuration, auto& ip, auto& instruction) {
+        record_instruction(configuration, ip, instruction);
+        return previous_hook ? previous_hook(configuration, ip, instruction) : true;
+    };
+    interpreter.post_interpret_hook = [this, previous_hook = move(interpreter.post_interpret_hook)](auto& configuration, auto& ip, auto& instruction, auto& interpreter) {
+        auto opcode = instruction.opcode();
+        if (opcode == Instructions::br || opcode == Instructions::br_if || opcode == Instructions::br_table)
+            record_branch(configuration, m_last_ip, ip);
+        return previous_hook ? previous_hook(configuration, ip, instruction, interpreter) : true;
+    };
+}
+
+void Profiler::record_instruction(Configuration const& configuration, InstructionPointer ip, Instruction const& instruction)
+{
+    m_last_ip = ip;
+    m_opcode_counts.ensure(instruction.opcode().value())++;
+    m_functions.ensure(&configuration.frame().expression()).executed_instructions++;
+}
+
+void Profiler::record_branch(Configuration const& configuration, InstructionPointer from, InstructionPointer to)
+{
+    // Loops are the only constructs that branch backwards.
+    if (to >= from)
+        return;
+    m_functions.ensure(&configuration.frame().expression()).loop_iterations.ensure(to.value())++;
+}
+
+ByteString Profiler::function_name(Expression const* expression) const
+{
+    if (auto name = m_function_names.get(expression); name.has_value())
+        return name.release_value();
+    return "<unknown>";
+}
+
+template<typename T>
+static Vector<T> take_largest(Vector<T> entries, size_t count, auto get_weight)
+{
+    quick_sort(entries, [&](auto const& a, auto const& b) { return get_weight(a) > get_weight(b); });
+    if (entries.size() > count)
+        entries.shrink(count);
+    return entries;
+}
+
+ErrorOr<void> Profiler::dump(Stream& stream, size_t max_entries_per_report) const
+{
+    u64 total_instructions = 0;
+    for (auto& entry : m_opcode_counts)
+        total_instructions += entry.value;
+    if (total_instructions == 0)
+        return stream.write_until_depleted("No instructions were executed\n"sv);
+
+    auto percentage = [&](u64 count) { return static_cast<double>(count) * 100 / static_cast<double>(total_instructions); };
+
+    struct FunctionEntry {
+        Expression const* expression;
+        u64 executed_instructions;
+    };
+    Vector<FunctionEntry> functions;
+    for (auto& entry : m_functions)
+        functions.append({ entry.key, entry.value.executed_instructions });
+    functions = take_largest(move(functions), max_entries_per_report, [](auto& entry) { return entry.executed_instructions; });
+
+    TRY(stream.write_formatted("Executed {} instructions\n\nInstructions per function:\n", total_instructions));
+    for (auto& entry : functions)
+        TRY(stream.write_formatted("  {:>12} {:>6.2}% {}\n", entry.executed_instructions, percentage(entry.executed_instructions), function_name(entry.expression)));
+
+    struct OpcodeEntry {
+        OpCode opcode;
+        u64 count;
+    };
+    Vector<OpcodeEntry> opcodes;
+    for (auto& entry : m_opcode_counts)
+        opcodes.append({ OpCode { entry.key }, entry.value });
+    opcodes = take_largest(move(opcodes), max_entries_per_report, [](auto& entry) { return entry.count; });
+
+    TRY(stream.write_until_depleted("\nOpcodes:\n"sv));
+    for (auto& entry : opcodes)
+        TRY(stream.write_formatted("  {:>12} {:>6.2}% {}\n", entry.count, percentage(entry.count), instruction_name(entry.opcode)));
+
+    struct LoopEntry {
+        Expression const* expression;
+        size_t ip;
+        u64 iterations;
+    };
+    Vector<LoopEntry> loops;
+    for (auto& function : m_functions) {
+        for (auto& loop : function.value.loop_iterations)
+            loops.append({ function.key, loop.key, loop.value });
+    }
+    if (loops.is_empty())
+        return {};
+    loops = take_largest(move(loops), max_entries_per_report, [](auto& entry) { return entry.iterations; });
+
+    TRY(stream.write_until_depleted("\nHot loops (backward branches taken):\n"sv));
+    for (auto& entry : loops)
+        TRY(stream.write_formatted("  {:>12} {} at ip={}\n", entry.iterations, function_name(entry.expression), entry.ip));
+
+    return {};
+}
+
+}
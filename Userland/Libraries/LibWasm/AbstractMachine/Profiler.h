@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Stream.h>
+#include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+
+namespace Wasm {
+
+// Collects an execution profile through the hooks of a DebuggerBytecodeInterpreter: how many instructions each
+// function executed, how often each opcode was executed, and how often each loop was branched back to.
+class Profiler {
+public:
+    // Makes the functions of the given module known to the profiler, naming them after the module's "name" section if it has one.
+    void add_module(Module const&, ModuleInstance const&, Store&);
+
+    // Installs the profiler's hooks, keeping any hooks that were already installed.
+    void attach(DebuggerBytecodeInterpreter&);
+
+    void record_instruction(Configuration const&, InstructionPointer, Instruction const&);
+    void record_branch(Configuration const&, InstructionPointer from, InstructionPointer to);
+
+    ErrorOr<void> dump(Stream&, size_t max_entries_per_report = 20) const;
+
+private:
+    struct FunctionProfile {
+        u64 executed_instructions { 0 };
+        // Keyed by the instruction pointer that was branched back to.
+        HashMap<size_t, u64> loop_iterations;
+    };
+
+    ByteString function_name(Expression const*) const;
+
+    HashMap<Expression const*, ByteString> m_function_names;
+    HashMap<Expression const*, FunctionProfile> m_functions;
+    HashMap<u64, u64> m_opcode_counts;
+    InstructionPointer m_last_ip { 0 };
+};
+
+}
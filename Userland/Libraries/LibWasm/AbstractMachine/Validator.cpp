@@ -9,11 +9,16 @@
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
+#include <LibCore/System.h>
+#include <LibThreading/Thread.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
 namespace Wasm {
 
+static constexpr size_t minimum_code_size_for_parallel_validation = 1 * MiB;
+static constexpr unsigned max_validation_thread_count = 8;
+
 ErrorOr<void, ValidationError> Validator::validate(Module& module)
 {
     // Pre-emptively make invalid. The module will be set to `Valid` at the end
@@ -242,26 +247,91 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
 
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
+    struct FunctionToValidate {
+        NonnullOwnPtr<Validator> validator;
+        CodeSection::Func const& function;
+        FunctionType const& type;
+        Optional<ValidationError> error;
+    };
+
+    // NOTE: The forks are all set up on this thread, as copying the context touches the (non-atomic) reference counts of
+    //       its vectors. Validating a function body only ever reads from the shared parts of the context after that.
+    Vector<FunctionToValidate> functions_to_validate;
+    functions_to_validate.ensure_capacity(section.functions().size());
+
     size_t index = m_context.imported_function_count;
+    size_t total_code_size = 0;
     for (auto& entry : section.functions()) {
         auto function_index = index++;
         TRY(validate(FunctionIndex { function_index }));
         auto& function_type = m_context.functions[function_index];
         auto& function = entry.func();
 
-        auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
+        auto function_validator = adopt_own(*new Validator(m_context));
+        function_validator->m_context.locals = {};
+        function_validator->m_context.locals.extend(function_type.parameters());
         for (auto& local : function.locals()) {
             for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
+                function_validator->m_context.locals.append(local.type());
         }
 
-        function_validator.m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+        function_validator->m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+
+        functions_to_validate.append({ move(function_validator), function, function_type, {} });
+        total_code_size += entry.size();
+    }
+
+    auto validate_function = [](FunctionToValidate& function_to_validate) {
+        auto& [validator, function, type, error] = function_to_validate;
+        auto results = validator->validate(function.body(), type.results());
+        if (results.is_error())
+            error = results.release_error();
+        else if (results.value().result_types.size() != type.results().size())
+            error = Errors::invalid("function result"sv, type.results(), results.value().result_types);
+    };
+
+    // OPTIMIZATION: Large modules spend most of their validation time in function bodies, which are independent of each other,
+    //               so spread them across a few threads.
+    auto thread_count = min(Core::System::hardware_concurrency(), max_validation_thread_count);
+    if (total_code_size >= minimum_code_size_for_parallel_validation && thread_count > 1) {
+        Atomic<size_t> next_function_to_validate { 0 };
+        auto validate_remaining_functions = [&] {
+            while (true) {
+                auto function_index = next_function_to_validate.fetch_add(1);
+                if (function_index >= functions_to_validate.size())
+                    break;
+                validate_function(functions_to_validate[function_index]);
+            }
+        };
+
+        Vector<NonnullRefPtr<Threading::Thread>> threads;
+        for (size_t i = 1; i < thread_count; ++i) {
+            auto thread = Threading::Thread::try_create([&] {
+                validate_remaining_functions();
+                return static_cast<intptr_t>(0);
+            },
+                "Wasm Validator"sv);
+            if (thread.is_error())
+                break;
+            thread.value()->start();
+            threads.append(thread.release_value());
+        }
+
+        validate_remaining_functions();
+
+        for (auto& thread : threads)
+            (void)thread->join();
+    } else {
+        for (auto& function_to_validate : functions_to_validate) {
+            validate_function(function_to_validate);
+            if (function_to_validate.error.has_value())
+                break;
+        }
+    }
 
-        auto results = TRY(function_validator.validate(function.body(), function_type.results()));
-        if (results.result_types.size() != function_type.results().size())
-            return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+    for (auto& function_to_validate : functions_to_validate) {
+        if (function_to_validate.error.has_value())
+            return function_to_validate.error.release_value();
     }
 
     return {};
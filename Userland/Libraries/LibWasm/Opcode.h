@@ -460,8 +460,20 @@ namespace Instructions {
     ENUMERATE_SINGLE_BYTE_WASM_OPCODES(M) \
     ENUMERATE_MULTI_BYTE_WASM_OPCODES(M)
 
+// These are fused forms of common instruction sequences, which are only ever produced by compiling an already validated
+// function body (see AbstractMachine::validate()), and never appear in a binary.
+#define ENUMERATE_SYNTHETIC_INSTRUCTION_OPCODES(M)                \
+    M(synthetic_i32_add2local, 0xff00000000000000ull)             \
+    M(synthetic_i32_addconstlocal, 0xff00000000000001ull)         \
+    M(synthetic_i32_andconstlocal, 0xff00000000000002ull)         \
+    M(synthetic_local_seti32_const, 0xff00000000000003ull)        \
+    M(synthetic_local_copy, 0xff00000000000004ull)                \
+    M(synthetic_i32_op2local_to_local, 0xff00000000000005ull)     \
+    M(synthetic_i32_opconstlocal_to_local, 0xff00000000000006ull)
+
 #define M(name, value) static constexpr OpCode name = value;
 ENUMERATE_WASM_OPCODES(M)
+ENUMERATE_SYNTHETIC_INSTRUCTION_OPCODES(M)
 #undef M
 
 }
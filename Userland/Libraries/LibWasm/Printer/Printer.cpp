@@ -446,6 +446,10 @@ void Printer::print(Wasm::Instruction const& instruction)
             [&](GlobalIndex const& index) { print("(global index {})", index.value()); },
             [&](LabelIndex const& index) { print("(label index {})", index.value()); },
             [&](LocalIndex const& index) { print("(local index {})", index.value()); },
+            [&](Instruction::LocalIndexAndI32 const& args) { print("(local index {}) (value {})", args.local.value(), args.value); },
+            [&](Instruction::LocalIndexPair const& args) { print("(local index {}) (local index {})", args.first.value(), args.second.value()); },
+            [&](Instruction::LocalsBinaryOperationArgs const& args) { print("({} (local index {}) (local index {}) to (local index {}))", instruction_name(args.operation), args.lhs.value(), args.rhs.value(), args.result.value()); },
+            [&](Instruction::LocalAndConstBinaryOperationArgs const& args) { print("({} (local index {}) (value {}) to (local index {}))", instruction_name(args.operation), args.lhs.value(), args.rhs, args.result.value()); },
             [&](TableIndex const& index) { print("(table index {})", index.value()); },
             [&](Instruction::IndirectCallArgs const& args) { print("(indirect (type index {}) (table index {}))", args.type.value(), args.table.value()); },
             [&](Instruction::MemoryArgument const& args) { print("(memory index {} (align {}) (offset {}))", args.memory_index.value(), args.align, args.offset); },
@@ -1140,5 +1144,12 @@ HashMap<Wasm::OpCode, ByteString> Wasm::Names::instruction_names {
     { Instructions::f64x2_convert_low_i32x4_u, "f64x2.convert_low_i32x4_u" },
     { Instructions::structured_else, "synthetic:else" },
     { Instructions::structured_end, "synthetic:end" },
+    { Instructions::synthetic_i32_add2local, "synthetic:i32.add2local" },
+    { Instructions::synthetic_i32_addconstlocal, "synthetic:i32.addconstlocal" },
+    { Instructions::synthetic_i32_andconstlocal, "synthetic:i32.andconstlocal" },
+    { Instructions::synthetic_local_seti32_const, "synthetic:local.seti32_const" },
+    { Instructions::synthetic_local_copy, "synthetic:local.copy" },
+    { Instructions::synthetic_i32_op2local_to_local, "synthetic:i32.op2local_to_local" },
+    { Instructions::synthetic_i32_opconstlocal_to_local, "synthetic:i32.opconstlocal_to_local" },
 };
 HashMap<ByteString, Wasm::OpCode> Wasm::Names::instructions_by_name;
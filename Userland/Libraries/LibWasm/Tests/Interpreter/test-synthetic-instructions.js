@@ -0,0 +1,51 @@
+test("fused instruction sequences behave like the instructions they replace", () => {
+    // (func (export "calc") (param $a i32) (param $b i32) (result i32) (local $c i32) (local $d i32)
+    //     (local.set $c (i32.const 7))
+    //     (local.set $d (local.get $c))
+    //     (i32.add (i32.add (local.get $a) (local.get $b)) (local.get $d))
+    //     (i32.add (i32.and (local.get $a) (i32.const 15)))
+    //     (i32.add (i32.add (local.get $b) (i32.const -3))))
+    // prettier-ignore
+    const binary = new Uint8Array([
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x07, 0x01, 0x60, 0x02, 0x7f, 0x7f, 0x01,
+        0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x08, 0x01, 0x04, 0x63, 0x61, 0x6c, 0x63, 0x00, 0x00, 0x0a,
+        0x22, 0x01, 0x20, 0x01, 0x02, 0x7f, 0x41, 0x07, 0x21, 0x02, 0x20, 0x02, 0x21, 0x03, 0x20, 0x00,
+        0x20, 0x01, 0x6a, 0x20, 0x03, 0x6a, 0x20, 0x00, 0x41, 0x0f, 0x71, 0x6a, 0x20, 0x01, 0x41, 0x7d,
+        0x6a, 0x6a, 0x0b,
+    ]);
+    const module = parseWebAssemblyModule(binary);
+    const calc = module.getExport("calc");
+
+    expect(module.invoke(calc, 10, 20)).toBe(64);
+    expect(module.invoke(calc, 255, 3)).toBe(280);
+
+    // Additions wrap around like i32.add does.
+    expect(module.invoke(calc, -1, 0x7fffffff)).toBe(16);
+    expect(module.invoke(calc, -2147483648, -1)).toBe(-2147483646);
+});
+
+test("operations between locals that write to a local", () => {
+    // (func (export "ops") (param $a i32) (param $b i32) (result i32) (local $c i32)
+    //     (local.set $c (i32.sub (local.get $a) (local.get $b)))
+    //     (local.set $c (i32.mul (local.get $c) (local.get $b)))
+    //     (local.set $c (i32.shl (local.get $c) (i32.const 3)))
+    //     (local.set $c (i32.shr_u (local.get $c) (i32.const 2)))
+    //     (local.set $c (i32.xor (local.get $c) (local.get $a)))
+    //     (local.set $c (i32.or (local.get $c) (i32.const 1)))
+    //     (local.get $c))
+    // prettier-ignore
+    const binary = new Uint8Array([
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x07, 0x01, 0x60, 0x02, 0x7f, 0x7f, 0x01,
+        0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03, 0x6f, 0x70, 0x73, 0x00, 0x00, 0x0a, 0x32,
+        0x01, 0x30, 0x01, 0x01, 0x7f, 0x20, 0x00, 0x20, 0x01, 0x6b, 0x21, 0x02, 0x20, 0x02, 0x20, 0x01,
+        0x6c, 0x21, 0x02, 0x20, 0x02, 0x41, 0x03, 0x74, 0x21, 0x02, 0x20, 0x02, 0x41, 0x02, 0x76, 0x21,
+        0x02, 0x20, 0x02, 0x20, 0x00, 0x73, 0x21, 0x02, 0x20, 0x02, 0x41, 0x01, 0x72, 0x21, 0x02, 0x20,
+        0x02, 0x0b,
+    ]);
+    const module = parseWebAssemblyModule(binary);
+    const ops = module.getExport("ops");
+
+    expect(module.invoke(ops, 10, 3)).toBe(33);
+    expect(module.invoke(ops, -5, 7)).toBe(-1073741661);
+    expect(module.invoke(ops, 0x12345678, -1)).toBe(161678711);
+});
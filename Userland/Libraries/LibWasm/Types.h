@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/Badge.h>
 #include <AK/ByteString.h>
 #include <AK/DistinctNumeric.h>
@@ -269,17 +270,26 @@ private:
 // https://webassembly.github.io/spec/core/bikeshed/#memory-types%E2%91%A4
 class MemoryType {
 public:
-    explicit MemoryType(Limits limits)
+    // https://webassembly.github.io/threads/core/syntax/types.html#memory-types
+    enum class Shared {
+        No,
+        Yes,
+    };
+
+    explicit MemoryType(Limits limits, Shared shared = Shared::No)
         : m_limits(move(limits))
+        , m_shared(shared)
     {
     }
 
     auto& limits() const { return m_limits; }
+    bool is_shared() const { return m_shared == Shared::Yes; }
 
     static ParseResult<MemoryType> parse(Stream& stream);
 
 private:
     Limits m_limits;
+    Shared m_shared { Shared::No };
 };
 
 // https://webassembly.github.io/spec/core/bikeshed/#table-types%E2%91%A4
@@ -442,6 +452,32 @@ public:
         MemoryIndex memory_index;
     };
 
+    // Arguments of the synthetic instructions.
+    struct LocalIndexPair {
+        LocalIndex first;
+        LocalIndex second;
+    };
+
+    struct LocalIndexAndI32 {
+        LocalIndex local;
+        i32 value;
+    };
+
+    // An i32 operation that reads its operands from locals (or a constant), and writes its result to a local.
+    struct LocalsBinaryOperationArgs {
+        OpCode operation;
+        LocalIndex lhs;
+        LocalIndex rhs;
+        LocalIndex result;
+    };
+
+    struct LocalAndConstBinaryOperationArgs {
+        OpCode operation;
+        LocalIndex lhs;
+        i32 rhs;
+        LocalIndex result;
+    };
+
     struct ShuffleArgument {
         explicit ShuffleArgument(u8 (&lanes)[16])
             : lanes {
@@ -478,7 +514,11 @@ private:
         IndirectCallArgs,
         LabelIndex,
         LaneIndex,
+        LocalAndConstBinaryOperationArgs,
         LocalIndex,
+        LocalIndexAndI32,
+        LocalIndexPair,
+        LocalsBinaryOperationArgs,
         MemoryArgument,
         MemoryAndLaneArgument,
         MemoryCopyArgs,
@@ -705,6 +745,7 @@ public:
     }
 
     auto& instructions() const { return m_instructions; }
+    auto& instructions() { return m_instructions; }
 
     static ParseResult<Expression> parse(Stream& stream, Optional<size_t> size_hint = {});
 
@@ -884,6 +925,7 @@ public:
 
         auto& locals() const { return m_locals; }
         auto& body() const { return m_body; }
+        auto& body() { return m_body; }
 
         static ParseResult<Func> parse(Stream& stream, size_t size_hint);
 
@@ -901,6 +943,7 @@ public:
 
         auto size() const { return m_size; }
         auto& func() const { return m_func; }
+        auto& func() { return m_func; }
 
         static ParseResult<Code> parse(Stream& stream);
 
@@ -917,6 +960,7 @@ public:
     }
 
     auto& functions() const { return m_functions; }
+    auto& functions() { return m_functions; }
 
     static ParseResult<CodeSection> parse(Stream& stream);
 
@@ -983,7 +1027,8 @@ private:
     Optional<u32> m_count;
 };
 
-class Module : public RefCounted<Module>
+// NOTE: Modules may be shared between threads that each run their own instances of it, see Userland/Utilities/wasm.cpp.
+class Module : public AtomicRefCounted<Module>
     , public Weakable<Module> {
 public:
     enum class ValidationStatus {
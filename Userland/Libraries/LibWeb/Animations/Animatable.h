@@ -43,6 +43,7 @@ public:
     Vector<JS::NonnullGCPtr<Animation>> get_animations(GetAnimationsOptions options = {});
     Vector<JS::NonnullGCPtr<Animation>> get_animations_internal(GetAnimationsOptions options = {});
 
+    [[nodiscard]] bool has_associated_animations() const { return !m_associated_animations.is_empty(); }
     void associate_with_animation(JS::NonnullGCPtr<Animation>);
     void disassociate_with_animation(JS::NonnullGCPtr<Animation>);
 
@@ -968,24 +968,40 @@ void KeyframeEffect::update_style_properties()
     auto& document = target->document();
     document.style_computer().collect_animation_into(*target, pseudo_element_type(), *this, *style, CSS::StyleComputer::AnimationRefresh::Yes);
 
-    // Traversal of the subtree is necessary to update the animated properties inherited from the target element.
-    target->for_each_in_subtree_of_type<DOM::Element>([&](auto& element) {
-        auto* element_style = element.computed_css_values();
-        if (!element_style || !element.layout_node())
-            return TraversalDecision::Continue;
+    auto const& animated_properties_after_update = style->animated_property_values();
+
+    // OPTIMIZATION: Only the animated properties that are inherited can change in the target's subtree. Most animations
+    //               (e.g. of transform or opacity) have none of those, so then we don't have to visit the subtree at all.
+    Vector<CSS::PropertyID> animated_inherited_properties;
+    for (auto const& [property_id, _] : animated_properties_before_update) {
+        if (CSS::is_inherited_property(property_id))
+            animated_inherited_properties.append(property_id);
+    }
+    for (auto const& [property_id, _] : animated_properties_after_update) {
+        if (CSS::is_inherited_property(property_id) && !animated_properties_before_update.contains(property_id))
+            animated_inherited_properties.append(property_id);
+    }
 
-        for (auto i = to_underlying(CSS::first_property_id); i <= to_underlying(CSS::last_property_id); ++i) {
-            if (element_style->is_property_inherited(static_cast<CSS::PropertyID>(i))) {
-                auto new_value = CSS::StyleComputer::get_inherit_value(document.realm(), static_cast<CSS::PropertyID>(i), &element);
-                element_style->set_property(static_cast<CSS::PropertyID>(i), *new_value, CSS::StyleProperties::Inherited::Yes);
+    // Traversal of the subtree is necessary to update the animated properties inherited from the target element.
+    if (!animated_inherited_properties.is_empty()) {
+        target->for_each_in_subtree_of_type<DOM::Element>([&](auto& element) {
+            auto* element_style = element.computed_css_values();
+            if (!element_style || !element.layout_node())
+                return TraversalDecision::Continue;
+
+            for (auto property_id : animated_inherited_properties) {
+                if (element_style->is_property_inherited(property_id)) {
+                    auto new_value = CSS::StyleComputer::get_inherit_value(document.realm(), property_id, &element);
+                    element_style->set_property(property_id, *new_value, CSS::StyleProperties::Inherited::Yes);
+                }
             }
-        }
 
-        element.layout_node()->apply_style(*element_style);
-        return TraversalDecision::Continue;
-    });
+            element.layout_node()->apply_style(*element_style);
+            return TraversalDecision::Continue;
+        });
+    }
 
-    auto invalidation = compute_required_invalidation(animated_properties_before_update, style->animated_property_values());
+    auto invalidation = compute_required_invalidation(animated_properties_before_update, animated_properties_after_update);
 
     if (!pseudo_element_type().has_value()) {
         if (target->layout_node())
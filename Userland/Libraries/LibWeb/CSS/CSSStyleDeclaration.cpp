@@ -470,14 +470,14 @@ JS::ThrowCompletionOr<JS::Value> CSSStyleDeclaration::internal_get(JS::PropertyK
     return JS::PrimitiveString::create(vm(), get_property_value(string_from_property_id(property_id)));
 }
 
-JS::ThrowCompletionOr<bool> CSSStyleDeclaration::internal_set(JS::PropertyKey const& name, JS::Value value, JS::Value receiver, JS::CacheablePropertyMetadata* cacheable_metadata)
+JS::ThrowCompletionOr<bool> CSSStyleDeclaration::internal_set(JS::PropertyKey const& name, JS::Value value, JS::Value receiver, JS::CacheablePropertyMetadata* cacheable_metadata, PropertyLookupPhase phase)
 {
     auto& vm = this->vm();
     if (!name.is_string())
-        return Base::internal_set(name, value, receiver, cacheable_metadata);
+        return Base::internal_set(name, value, receiver, cacheable_metadata, phase);
     auto property_id = property_id_from_name(name.to_string());
     if (property_id == CSS::PropertyID::Invalid)
-        return Base::internal_set(name, value, receiver, cacheable_metadata);
+        return Base::internal_set(name, value, receiver, cacheable_metadata, phase);
 
     auto css_text = value.is_null() ? String {} : TRY(value.to_string(vm));
 
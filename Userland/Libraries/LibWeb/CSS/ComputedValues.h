@@ -159,6 +159,8 @@ public:
     static CSS::Size height() { return CSS::Size::make_auto(); }
     static CSS::Size min_height() { return CSS::Size::make_auto(); }
     static CSS::Size max_height() { return CSS::Size::make_none(); }
+    static CSS::Size contain_intrinsic_width() { return CSS::Size::make_none(); }
+    static CSS::Size contain_intrinsic_height() { return CSS::Size::make_none(); }
     static CSS::GridTrackSizeList grid_template_columns() { return CSS::GridTrackSizeList::make_none(); }
     static CSS::GridTrackSizeList grid_template_rows() { return CSS::GridTrackSizeList::make_none(); }
     static CSS::GridTrackPlacement grid_column_end() { return CSS::GridTrackPlacement::make_auto(); }
@@ -413,6 +415,8 @@ public:
     CSS::Size const& height() const { return m_noninherited.height; }
     CSS::Size const& min_height() const { return m_noninherited.min_height; }
     CSS::Size const& max_height() const { return m_noninherited.max_height; }
+    CSS::Size const& contain_intrinsic_width() const { return m_noninherited.contain_intrinsic_width; }
+    CSS::Size const& contain_intrinsic_height() const { return m_noninherited.contain_intrinsic_height; }
     Variant<CSS::VerticalAlign, CSS::LengthPercentage> const& vertical_align() const { return m_noninherited.vertical_align; }
     CSS::GridTrackSizeList const& grid_auto_columns() const { return m_noninherited.grid_auto_columns; }
     CSS::GridTrackSizeList const& grid_auto_rows() const { return m_noninherited.grid_auto_rows; }
@@ -590,6 +594,8 @@ protected:
         CSS::Size height { InitialValues::height() };
         CSS::Size min_height { InitialValues::min_height() };
         CSS::Size max_height { InitialValues::max_height() };
+        CSS::Size contain_intrinsic_width { InitialValues::contain_intrinsic_width() };
+        CSS::Size contain_intrinsic_height { InitialValues::contain_intrinsic_height() };
         CSS::LengthBox inset { InitialValues::inset() };
         CSS::LengthBox margin { InitialValues::margin() };
         CSS::LengthBox padding { InitialValues::padding() };
@@ -727,6 +733,8 @@ public:
     void set_height(CSS::Size const& height) { m_noninherited.height = height; }
     void set_min_height(CSS::Size const& height) { m_noninherited.min_height = height; }
     void set_max_height(CSS::Size const& height) { m_noninherited.max_height = height; }
+    void set_contain_intrinsic_width(CSS::Size const& width) { m_noninherited.contain_intrinsic_width = width; }
+    void set_contain_intrinsic_height(CSS::Size const& height) { m_noninherited.contain_intrinsic_height = height; }
     void set_inset(CSS::LengthBox const& inset) { m_noninherited.inset = inset; }
     void set_margin(const CSS::LengthBox& margin) { m_noninherited.margin = margin; }
     void set_padding(const CSS::LengthBox& padding) { m_noninherited.padding = padding; }
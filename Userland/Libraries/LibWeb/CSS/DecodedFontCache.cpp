@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibGfx/Font/FontData.h>
+#include <LibGfx/Font/WOFF/Loader.h>
+#include <LibGfx/Font/WOFF2/Loader.h>
+#include <LibWeb/CSS/DecodedFontCache.h>
+
+namespace Web::CSS {
+
+DecodedFontCache& DecodedFontCache::the()
+{
+    static DecodedFontCache s_cache;
+    return s_cache;
+}
+
+ErrorOr<NonnullRefPtr<Gfx::Typeface>> DecodedFontCache::decode_ttf(ReadonlyBytes encoded_data)
+{
+    auto font_data = Gfx::FontData::create_from_byte_buffer(TRY(ByteBuffer::copy(encoded_data)));
+    return Gfx::Typeface::try_load_from_font_data(move(font_data));
+}
+
+ErrorOr<NonnullRefPtr<Gfx::Typeface>> DecodedFontCache::decode_woff(ReadonlyBytes encoded_data)
+{
+    // NOTE: WOFF fonts are decompressed into a buffer of their own, so they don't refer to the encoded data.
+    return WOFF::try_load_from_externally_owned_memory(encoded_data);
+}
+
+ErrorOr<NonnullRefPtr<Gfx::Typeface>> DecodedFontCache::decode_woff2(ReadonlyBytes encoded_data)
+{
+    return WOFF2::try_load_from_externally_owned_memory(encoded_data);
+}
+
+ErrorOr<NonnullRefPtr<Gfx::Typeface>> DecodedFontCache::get_or_decode(ReadonlyBytes encoded_data, ReadonlySpan<ErrorOr<NonnullRefPtr<Gfx::Typeface>> (*)(ReadonlyBytes)> decoders)
+{
+    auto digest = ::Crypto::Hash::SHA256::hash(encoded_data.data(), encoded_data.size());
+    if (auto it = m_entries.find(digest); it != m_entries.end()) {
+        it->value.last_access_generation = ++m_access_generation;
+        return it->value.typeface;
+    }
+
+    for (auto decoder : decoders) {
+        auto typeface_or_error = decoder(encoded_data);
+        if (typeface_or_error.is_error())
+            continue;
+        auto typeface = typeface_or_error.release_value();
+
+        // NOTE: Don't let a single huge font push everything else out of the cache.
+        if (encoded_data.size() <= maximum_size / 4) {
+            m_entries.set(digest,
+                Entry {
+                    .typeface = typeface,
+                    .size_in_bytes = encoded_data.size(),
+                    .last_access_generation = ++m_access_generation,
+                });
+            m_total_size += encoded_data.size();
+            evict_least_recently_used_entries();
+        }
+        return typeface;
+    }
+
+    return Error::from_string_literal("Automatic format detection failed");
+}
+
+void DecodedFontCache::remove(EncodedDataDigest const& digest)
+{
+    auto it = m_entries.find(digest);
+    if (it == m_entries.end())
+        return;
+    m_total_size -= it->value.size_in_bytes;
+    m_entries.remove(it);
+}
+
+void DecodedFontCache::clear()
+{
+    m_entries.clear();
+    m_total_size = 0;
+}
+
+void DecodedFontCache::evict_least_recently_used_entries()
+{
+    if (m_total_size <= maximum_size)
+        return;
+
+    Vector<EncodedDataDigest> digests;
+    digests.ensure_capacity(m_entries.size());
+    for (auto const& it : m_entries)
+        digests.unchecked_append(it.key);
+    quick_sort(digests, [&](auto const& a, auto const& b) {
+        return m_entries.find(a)->value.last_access_generation < m_entries.find(b)->value.last_access_generation;
+    });
+
+    // NOTE: Evict down to 3/4 of the budget, so we aren't doing this again for every font that is loaded.
+    // NOTE: Documents that still use an evicted font hold on to its typeface, this only stops us from handing it out again.
+    for (auto const& digest : digests) {
+        if (m_total_size <= maximum_size / 4 * 3)
+            break;
+        remove(digest);
+    }
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteReader.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibGfx/Font/Typeface.h>
+
+namespace Web::CSS {
+
+// A process-wide cache of decoded web fonts, so that documents that load the same font file (usually the same URL, but
+// any copy of the same bytes will do) don't have to decompress and parse it again. Entries are keyed by the digest of the
+// encoded bytes, which is also what lets fonts given to the FontFace constructor as binary data share them.
+class DecodedFontCache {
+public:
+    static DecodedFontCache& the();
+
+    // Returns the cached typeface for these bytes, or one made by decoding them with the first of the given decoders
+    // that succeeds. The decoders are tried in order, as the format of a font file is often not known up front.
+    ErrorOr<NonnullRefPtr<Gfx::Typeface>> get_or_decode(ReadonlyBytes encoded_data, ReadonlySpan<ErrorOr<NonnullRefPtr<Gfx::Typeface>> (*)(ReadonlyBytes)> decoders);
+
+    // Loads a TrueType/OpenType font from a copy of the given bytes, as cached typefaces outlive the resource they came from.
+    static ErrorOr<NonnullRefPtr<Gfx::Typeface>> decode_ttf(ReadonlyBytes);
+    static ErrorOr<NonnullRefPtr<Gfx::Typeface>> decode_woff(ReadonlyBytes);
+    static ErrorOr<NonnullRefPtr<Gfx::Typeface>> decode_woff2(ReadonlyBytes);
+
+    // NOTE: Like eviction, this only drops the typefaces that no document is using anymore.
+    void clear();
+
+    // NOTE: This budget is measured in encoded font bytes, as that's what we know the size of.
+    static constexpr size_t maximum_size = 32 * MiB;
+
+private:
+    DecodedFontCache() = default;
+
+    using EncodedDataDigest = ::Crypto::Hash::SHA256::DigestType;
+
+    struct EncodedDataDigestTraits : public DefaultTraits<EncodedDataDigest> {
+        // NOTE: The digest is already as good a hash as there is, so we just use some of its bytes.
+        static unsigned hash(EncodedDataDigest const& digest) { return ByteReader::load32(digest.data); }
+    };
+
+    struct Entry {
+        NonnullRefPtr<Gfx::Typeface> typeface;
+        size_t size_in_bytes { 0 };
+        u64 last_access_generation { 0 };
+    };
+
+    void remove(EncodedDataDigest const&);
+    void evict_least_recently_used_entries();
+
+    HashMap<EncodedDataDigest, Entry, EncodedDataDigestTraits> m_entries;
+    size_t m_total_size { 0 };
+    u64 m_access_generation { 0 };
+};
+
+}
@@ -6,13 +6,12 @@
 
 #include <LibCore/Promise.h>
 #include <LibGfx/Font/Typeface.h>
-#include <LibGfx/Font/WOFF/Loader.h>
-#include <LibGfx/Font/WOFF2/Loader.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/Realm.h>
 #include <LibWeb/Bindings/FontFacePrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/CSS/DecodedFontCache.h>
 #include <LibWeb/CSS/FontFace.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/StyleComputer.h>
@@ -32,24 +31,13 @@ static NonnullRefPtr<Core::Promise<NonnullRefPtr<Gfx::Typeface>>> load_vector_fo
     // FIXME: 'Asynchronously' shouldn't mean 'later on the main thread'.
     //        Can we defer this to a background thread?
     Platform::EventLoopPlugin::the().deferred_invoke([&data, promise] {
-        // FIXME: This should be de-duplicated with StyleComputer::FontLoader::try_load_font
         // We don't have the luxury of knowing the MIME type, so we have to try all formats.
-        auto ttf = Gfx::Typeface::try_load_from_externally_owned_memory(data);
-        if (!ttf.is_error()) {
-            promise->resolve(ttf.release_value());
+        auto typeface = DecodedFontCache::the().get_or_decode(data, Array { DecodedFontCache::decode_ttf, DecodedFontCache::decode_woff, DecodedFontCache::decode_woff2 });
+        if (typeface.is_error()) {
+            promise->reject(typeface.release_error());
             return;
         }
-        auto woff = WOFF::try_load_from_externally_owned_memory(data);
-        if (!woff.is_error()) {
-            promise->resolve(woff.release_value());
-            return;
-        }
-        auto woff2 = WOFF2::try_load_from_externally_owned_memory(data);
-        if (!woff2.is_error()) {
-            promise->resolve(woff2.release_value());
-            return;
-        }
-        promise->reject(Error::from_string_literal("Automatic format detection failed"));
+        promise->resolve(typeface.release_value());
     });
 
     return promise;
@@ -24,6 +24,14 @@ CSS::CSSStyleSheet* parse_css_stylesheet(CSS::Parser::ParsingContext const& cont
         style_sheet->set_source_text({});
         return style_sheet;
     }
+    // OPTIMIZATION: Documents often load the same large stylesheets (think of iframes using a site's shared stylesheet),
+    //               so we share the raw rules of those between documents instead of tokenizing them again each time.
+    //               The CSSOM objects are still created per document, as they belong to its realm and can be modified.
+    if (auto raw_style_sheet = CSS::Parser::Parser::shared_raw_style_sheet(context, css)) {
+        auto* style_sheet = CSS::Parser::Parser::create(context, ""sv).parse_as_css_stylesheet(*raw_style_sheet, location);
+        style_sheet->set_source_text(raw_style_sheet->source);
+        return style_sheet;
+    }
     auto* style_sheet = CSS::Parser::Parser::create(context, css).parse_as_css_stylesheet(location);
     // FIXME: Avoid this copy
     style_sheet->set_source_text(MUST(String::from_utf8(css)));
@@ -160,26 +160,94 @@ Vector<Rule> Parser::parse_a_stylesheets_contents(TokenStream<T>& input)
 CSSStyleSheet* Parser::parse_as_css_stylesheet(Optional<URL::URL> location)
 {
     // To parse a CSS stylesheet, first parse a stylesheet.
-    auto style_sheet = parse_a_stylesheet(m_token_stream, {});
+    // OPTIMIZATION: Instead of collecting all of the stylesheet's rules first, we interpret each one as soon as it has
+    //               been consumed. That way, only a single rule's raw form is kept in memory at a time.
+    JS::MarkedVector<CSSRule*> rules(m_context.realm().heap());
+    consume_a_stylesheets_contents(m_token_stream, [&](Rule raw_rule) {
+        interpret_top_level_rule(raw_rule, rules);
+    });
+    return create_style_sheet(rules, move(location));
+}
 
-    // Interpret all of the resulting top-level qualified rules as style rules, defined below.
+CSSStyleSheet* Parser::parse_as_css_stylesheet(RawStyleSheet const& raw_style_sheet, Optional<URL::URL> location)
+{
     JS::MarkedVector<CSSRule*> rules(m_context.realm().heap());
-    for (auto const& raw_rule : style_sheet.rules) {
-        auto rule = convert_to_rule(raw_rule, Nested::No);
-        // If any style rule is invalid, or any at-rule is not recognized or is invalid according to its grammar or context, it’s a parse error.
-        // Discard that rule.
-        if (!rule) {
-            log_parse_error();
-            continue;
-        }
-        rules.append(rule);
+    for (auto const& raw_rule : raw_style_sheet.rules)
+        interpret_top_level_rule(raw_rule, rules);
+    return create_style_sheet(rules, move(location));
+}
+
+void Parser::interpret_top_level_rule(Rule const& raw_rule, JS::MarkedVector<CSSRule*>& rules)
+{
+    // Interpret all of the resulting top-level qualified rules as style rules, defined below.
+    auto rule = convert_to_rule(raw_rule, Nested::No);
+    // If any style rule is invalid, or any at-rule is not recognized or is invalid according to its grammar or context, it’s a parse error.
+    // Discard that rule.
+    if (!rule) {
+        log_parse_error();
+        return;
     }
+    rules.append(rule);
+}
 
+CSSStyleSheet* Parser::create_style_sheet(JS::MarkedVector<CSSRule*> const& rules, Optional<URL::URL> location)
+{
     auto rule_list = CSSRuleList::create(m_context.realm(), rules);
     auto media_list = MediaList::create(m_context.realm(), {});
     return CSSStyleSheet::create(m_context.realm(), rule_list, media_list, move(location));
 }
 
+// NOTE: Small stylesheets are cheap enough to tokenize again, and the raw rules of a stylesheet take up several times
+//       as much memory as its source, so we only keep a limited amount of them around.
+static constexpr size_t minimum_shared_raw_style_sheet_size = 4 * KiB;
+static constexpr size_t maximum_shared_raw_style_sheets_size = 4 * MiB;
+static constexpr size_t maximum_seen_style_sheet_hashes = 64;
+
+RefPtr<Parser::RawStyleSheet const> Parser::shared_raw_style_sheet(ParsingContext const& context, StringView css)
+{
+    if (css.length() < minimum_shared_raw_style_sheet_size || css.length() > maximum_shared_raw_style_sheets_size)
+        return nullptr;
+
+    // Least recently used first.
+    static Vector<NonnullRefPtr<RawStyleSheet const>> s_shared_raw_style_sheets;
+    static size_t s_shared_raw_style_sheets_size = 0;
+
+    for (size_t i = 0; i < s_shared_raw_style_sheets.size(); ++i) {
+        auto& raw_style_sheet = s_shared_raw_style_sheets[i];
+        if (raw_style_sheet->source.bytes_as_string_view() != css)
+            continue;
+        auto shared_raw_style_sheet = raw_style_sheet;
+        s_shared_raw_style_sheets.remove(i);
+        s_shared_raw_style_sheets.append(shared_raw_style_sheet);
+        return shared_raw_style_sheet;
+    }
+
+    // NOTE: Most stylesheets are only ever parsed once. Keeping their raw rules around would undo the point of
+    //       interpreting each rule as soon as it has been consumed, so we only start sharing a stylesheet's raw rules
+    //       once it's parsed a second time. Until then, we only remember a hash of its source.
+    static Vector<unsigned> s_seen_style_sheet_hashes;
+    auto hash = css.hash();
+    if (!s_seen_style_sheet_hashes.contains_slow(hash)) {
+        if (s_seen_style_sheet_hashes.size() == maximum_seen_style_sheet_hashes)
+            s_seen_style_sheet_hashes.remove(0);
+        s_seen_style_sheet_hashes.append(hash);
+        return nullptr;
+    }
+
+    auto raw_style_sheet = adopt_ref(*new RawStyleSheet);
+    raw_style_sheet->source = MUST(String::from_utf8(css));
+    auto parser = Parser::create(context, css);
+    raw_style_sheet->rules = parser.consume_a_stylesheets_contents(parser.m_token_stream);
+
+    while (s_shared_raw_style_sheets_size + css.length() > maximum_shared_raw_style_sheets_size) {
+        s_shared_raw_style_sheets_size -= s_shared_raw_style_sheets.first()->source.bytes().size();
+        s_shared_raw_style_sheets.remove(0);
+    }
+    s_shared_raw_style_sheets_size += css.length();
+    s_shared_raw_style_sheets.append(raw_style_sheet);
+    return raw_style_sheet;
+}
+
 RefPtr<Supports> Parser::parse_as_supports()
 {
     return parse_a_supports(m_token_stream);
@@ -369,6 +437,16 @@ Vector<Rule> Parser::consume_a_stylesheets_contents(TokenStream<T>& input)
     // Let rules be an initially empty list of rules.
     Vector<Rule> rules;
 
+    consume_a_stylesheets_contents(input, [&](Rule rule) { rules.append(move(rule)); });
+
+    // Return rules.
+    return rules;
+}
+
+// NOTE: This is the algorithm above, with "append it to rules" replaced by calling on_rule.
+template<typename T>
+void Parser::consume_a_stylesheets_contents(TokenStream<T>& input, AK::Function<void(Rule)> const& on_rule)
+{
     // Process input:
     for (;;) {
         auto& token = input.next_token();
@@ -383,7 +461,7 @@ Vector<Rule> Parser::consume_a_stylesheets_contents(TokenStream<T>& input)
         // <EOF-token>
         if (token.is(Token::Type::EndOfFile)) {
             // Return rules.
-            return rules;
+            return;
         }
 
         // <CDO-token>
@@ -398,7 +476,7 @@ Vector<Rule> Parser::consume_a_stylesheets_contents(TokenStream<T>& input)
         if (token.is(Token::Type::AtKeyword)) {
             // Consume an at-rule from input. If anything is returned, append it to rules.
             if (auto maybe_at_rule = consume_an_at_rule(input); maybe_at_rule.has_value())
-                rules.append(*maybe_at_rule);
+                on_rule(maybe_at_rule.release_value());
             continue;
         }
 
@@ -406,7 +484,7 @@ Vector<Rule> Parser::consume_a_stylesheets_contents(TokenStream<T>& input)
         {
             // Consume a qualified rule from input. If a rule is returned, append it to rules.
             consume_a_qualified_rule(input).visit(
-                [&](QualifiedRule qualified_rule) { rules.append(move(qualified_rule)); },
+                [&](QualifiedRule qualified_rule) { on_rule(move(qualified_rule)); },
                 [](auto&) {});
         }
     }
@@ -4800,6 +4878,26 @@ RefPtr<CSSStyleValue> Parser::parse_single_shadow_value(TokenStream<ComponentVal
     return ShadowStyleValue::create(color.release_nonnull(), offset_x.release_nonnull(), offset_y.release_nonnull(), blur_radius.release_nonnull(), spread_distance.release_nonnull(), placement.release_value());
 }
 
+// https://drafts.csswg.org/css-sizing-4/#intrinsic-size-override
+RefPtr<CSSStyleValue> Parser::parse_contain_intrinsic_size_value(TokenStream<ComponentValue>& tokens)
+{
+    // FIXME: Support `auto <length>`.
+    auto transaction = tokens.begin_transaction();
+    auto width_value = parse_css_value_for_property(PropertyID::ContainIntrinsicWidth, tokens);
+    if (!width_value)
+        return nullptr;
+    tokens.discard_whitespace();
+    auto height_value = parse_css_value_for_property(PropertyID::ContainIntrinsicHeight, tokens);
+    transaction.commit();
+
+    // If the second value is omitted, it is set to the same as the first.
+    if (!height_value)
+        height_value = width_value;
+    return ShorthandStyleValue::create(PropertyID::ContainIntrinsicSize,
+        { PropertyID::ContainIntrinsicWidth, PropertyID::ContainIntrinsicHeight },
+        { width_value.release_nonnull(), height_value.release_nonnull() });
+}
+
 RefPtr<CSSStyleValue> Parser::parse_content_value(TokenStream<ComponentValue>& tokens)
 {
     // FIXME: `content` accepts several kinds of function() type, which we don't handle in property_accepts_value() yet.
@@ -7818,6 +7916,10 @@ Parser::ParseErrorOr<NonnullRefPtr<CSSStyleValue>> Parser::parse_css_value(Prope
         if (auto parsed_value = parse_columns_value(tokens); parsed_value && !tokens.has_next_token())
             return parsed_value.release_nonnull();
         return ParseError::SyntaxError;
+    case PropertyID::ContainIntrinsicSize:
+        if (auto parsed_value = parse_contain_intrinsic_size_value(tokens); parsed_value && !tokens.has_next_token())
+            return parsed_value.release_nonnull();
+        return ParseError::SyntaxError;
     case PropertyID::Content:
         if (auto parsed_value = parse_content_value(tokens); parsed_value && !tokens.has_next_token())
             return parsed_value.release_nonnull();
@@ -8697,7 +8799,7 @@ bool Parser::has_ignored_vendor_prefix(StringView string)
     return true;
 }
 
-NonnullRefPtr<CSSStyleValue> Parser::resolve_unresolved_style_value(ParsingContext const& context, DOM::Element& element, Optional<Selector::PseudoElement::Type> pseudo_element, PropertyID property_id, UnresolvedStyleValue const& unresolved)
+NonnullRefPtr<CSSStyleValue> Parser::resolve_unresolved_style_value(ParsingContext const& context, DOM::Element& element, Optional<Selector::PseudoElement::Type> pseudo_element, PropertyID property_id, UnresolvedStyleValue const& unresolved, UnresolvedStyleValueDependencies* dependencies)
 {
     // Unresolved always contains a var() or attr(), unless it is a custom property's value, in which case we shouldn't be trying
     // to produce a different CSSStyleValue from it.
@@ -8706,7 +8808,7 @@ NonnullRefPtr<CSSStyleValue> Parser::resolve_unresolved_style_value(ParsingConte
     // If the value is invalid, we fall back to `unset`: https://www.w3.org/TR/css-variables-1/#invalid-at-computed-value-time
 
     auto parser = Parser::create(context, ""sv);
-    return parser.resolve_unresolved_style_value(element, pseudo_element, property_id, unresolved);
+    return parser.resolve_unresolved_style_value(element, pseudo_element, property_id, unresolved, dependencies);
 }
 
 class PropertyDependencyNode : public RefCounted<PropertyDependencyNode> {
@@ -8752,13 +8854,35 @@ private:
     bool m_marked { false };
 };
 
-NonnullRefPtr<CSSStyleValue> Parser::resolve_unresolved_style_value(DOM::Element& element, Optional<Selector::PseudoElement::Type> pseudo_element, PropertyID property_id, UnresolvedStyleValue const& unresolved)
+static bool contains_attr_function(Vector<ComponentValue> const& values)
+{
+    for (auto const& value : values) {
+        if (value.is_block() && contains_attr_function(value.block().value))
+            return true;
+        if (value.is_function() && (value.function().name.equals_ignoring_ascii_case("attr"sv) || contains_attr_function(value.function().value)))
+            return true;
+    }
+    return false;
+}
+
+NonnullRefPtr<CSSStyleValue> Parser::resolve_unresolved_style_value(DOM::Element& element, Optional<Selector::PseudoElement::Type> pseudo_element, PropertyID property_id, UnresolvedStyleValue const& unresolved, UnresolvedStyleValueDependencies* dependencies)
 {
     TokenStream unresolved_values_without_variables_expanded { unresolved.values() };
     Vector<ComponentValue> values_with_variables_expanded;
 
-    HashMap<FlyString, NonnullRefPtr<PropertyDependencyNode>> dependencies;
-    if (!expand_variables(element, pseudo_element, string_from_property_id(property_id), dependencies, unresolved_values_without_variables_expanded, values_with_variables_expanded))
+    HashMap<FlyString, NonnullRefPtr<PropertyDependencyNode>> dependency_nodes;
+    bool expanded_variables = expand_variables(element, pseudo_element, string_from_property_id(property_id), dependency_nodes, unresolved_values_without_variables_expanded, values_with_variables_expanded);
+
+    // NOTE: Every custom property that expand_variables() looked up has a dependency node, even if expansion failed.
+    if (dependencies) {
+        for (auto const& [name, _] : dependency_nodes) {
+            if (name.bytes_as_string_view().starts_with("--"sv))
+                dependencies->custom_property_names.append(name);
+        }
+        dependencies->uses_attributes = contains_attr_function(values_with_variables_expanded);
+    }
+
+    if (!expanded_variables)
         return CSSKeywordValue::create(Keyword::Unset);
 
     TokenStream unresolved_values_with_variables_expanded { values_with_variables_expanded };
@@ -8773,7 +8897,7 @@ NonnullRefPtr<CSSStyleValue> Parser::resolve_unresolved_style_value(DOM::Element
     return CSSKeywordValue::create(Keyword::Unset);
 }
 
-static RefPtr<CSSStyleValue const> get_custom_property(DOM::Element const& element, Optional<CSS::Selector::PseudoElement::Type> pseudo_element, FlyString const& custom_property_name)
+RefPtr<CSSStyleValue const> Parser::custom_property_value(DOM::Element const& element, Optional<CSS::Selector::PseudoElement::Type> pseudo_element, FlyString const& custom_property_name)
 {
     if (pseudo_element.has_value()) {
         if (auto it = element.custom_properties(pseudo_element).find(custom_property_name); it != element.custom_properties(pseudo_element).end())
@@ -8853,7 +8977,7 @@ bool Parser::expand_variables(DOM::Element& element, Optional<Selector::PseudoEl
         if (parent->has_cycles())
             return false;
 
-        if (auto custom_property_value = get_custom_property(element, pseudo_element, custom_property_name)) {
+        if (auto custom_property_value = Parser::custom_property_value(element, pseudo_element, custom_property_name)) {
             VERIFY(custom_property_value->is_unresolved());
             TokenStream custom_property_tokens { custom_property_value->as_unresolved().values() };
             if (!expand_variables(element, pseudo_element, custom_property_name, dependencies, custom_property_tokens, dest))
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibGfx/Font/UnicodeRange.h>
@@ -41,6 +42,16 @@ public:
     Parser(Parser&&);
 
     CSSStyleSheet* parse_as_css_stylesheet(Optional<URL::URL> location);
+
+    // The top-level rules of a stylesheet, before they've been interpreted as CSSRules. These don't depend on the
+    // parsing context, so every document that loads an identical stylesheet can share them.
+    struct RawStyleSheet : public RefCounted<RawStyleSheet> {
+        String source;
+        Vector<Rule> rules;
+    };
+    // Returns the shared raw rules for the given stylesheet source, or null if it's not worth sharing (yet).
+    static RefPtr<RawStyleSheet const> shared_raw_style_sheet(ParsingContext const&, StringView css);
+    CSSStyleSheet* parse_as_css_stylesheet(RawStyleSheet const&, Optional<URL::URL> location);
     ElementInlineCSSStyleDeclaration* parse_as_style_attribute(DOM::Element&);
     CSSRule* parse_as_css_rule();
     Optional<StyleProperty> parse_as_supports_condition();
@@ -69,13 +80,23 @@ public:
 
     Vector<ParsedFontFace::Source> parse_as_font_face_src();
 
-    static NonnullRefPtr<CSSStyleValue> resolve_unresolved_style_value(ParsingContext const&, DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, PropertyID, UnresolvedStyleValue const&);
+    // What the result of resolving an unresolved style value depends on, other than the value itself and the parsing context.
+    struct UnresolvedStyleValueDependencies {
+        // The names of the custom properties that were looked up for the element.
+        Vector<FlyString> custom_property_names;
+        bool uses_attributes { false };
+    };
+    static NonnullRefPtr<CSSStyleValue> resolve_unresolved_style_value(ParsingContext const&, DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, PropertyID, UnresolvedStyleValue const&, UnresolvedStyleValueDependencies* = nullptr);
+    static RefPtr<CSSStyleValue const> custom_property_value(DOM::Element const&, Optional<CSS::Selector::PseudoElement::Type>, FlyString const& custom_property_name);
 
     [[nodiscard]] LengthOrCalculated parse_as_sizes_attribute(DOM::Element const& element, HTML::HTMLImageElement const* img = nullptr);
 
 private:
     Parser(ParsingContext const&, Vector<Token>);
 
+    void interpret_top_level_rule(Rule const&, JS::MarkedVector<CSSRule*>&);
+    CSSStyleSheet* create_style_sheet(JS::MarkedVector<CSSRule*> const&, Optional<URL::URL> location);
+
     enum class ParseError {
         IncludesIgnoredVendorPrefix,
         InternalError,
@@ -137,6 +158,9 @@ private:
 
     template<typename T>
     [[nodiscard]] Vector<Rule> consume_a_stylesheets_contents(TokenStream<T>&);
+    // Like the above, but hands each rule to the callback as soon as it has been consumed, instead of collecting them all first.
+    template<typename T>
+    void consume_a_stylesheets_contents(TokenStream<T>&, AK::Function<void(Rule)> const& on_rule);
     enum class Nested {
         No,
         Yes,
@@ -301,6 +325,7 @@ private:
     RefPtr<CSSStyleValue> parse_border_radius_value(TokenStream<ComponentValue>&);
     RefPtr<CSSStyleValue> parse_border_radius_shorthand_value(TokenStream<ComponentValue>&);
     RefPtr<CSSStyleValue> parse_columns_value(TokenStream<ComponentValue>&);
+    RefPtr<CSSStyleValue> parse_contain_intrinsic_size_value(TokenStream<ComponentValue>&);
     RefPtr<CSSStyleValue> parse_content_value(TokenStream<ComponentValue>&);
     RefPtr<CSSStyleValue> parse_counter_increment_value(TokenStream<ComponentValue>&);
     RefPtr<CSSStyleValue> parse_counter_reset_value(TokenStream<ComponentValue>&);
@@ -368,7 +393,7 @@ private:
     Optional<Supports::InParens> parse_supports_in_parens(TokenStream<ComponentValue>&);
     Optional<Supports::Feature> parse_supports_feature(TokenStream<ComponentValue>&);
 
-    NonnullRefPtr<CSSStyleValue> resolve_unresolved_style_value(DOM::Element&, Optional<Selector::PseudoElement::Type>, PropertyID, UnresolvedStyleValue const&);
+    NonnullRefPtr<CSSStyleValue> resolve_unresolved_style_value(DOM::Element&, Optional<Selector::PseudoElement::Type>, PropertyID, UnresolvedStyleValue const&, UnresolvedStyleValueDependencies*);
     bool expand_variables(DOM::Element&, Optional<Selector::PseudoElement::Type>, FlyString const& property_name, HashMap<FlyString, NonnullRefPtr<PropertyDependencyNode>>& dependencies, TokenStream<ComponentValue>& source, Vector<ComponentValue>& dest);
     bool expand_unresolved_values(DOM::Element&, FlyString const& property_name, TokenStream<ComponentValue>& source, Vector<ComponentValue>& dest);
     bool substitute_attr_function(DOM::Element& element, FlyString const& property_name, Function const& attr_function, Vector<ComponentValue>& dest);
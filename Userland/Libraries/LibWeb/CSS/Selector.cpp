@@ -50,6 +50,7 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     }
 
     collect_ancestor_hashes();
+    collect_subject_bloom_filter();
 }
 
 void Selector::collect_ancestor_hashes()
@@ -97,6 +98,40 @@ void Selector::collect_ancestor_hashes()
         m_ancestor_hashes[i] = 0;
 }
 
+static u64 bloom_filter_for_compound_selector(Selector::CompoundSelector const& compound_selector)
+{
+    u64 bloom_filter = 0;
+    for (auto const& simple_selector : compound_selector.simple_selectors) {
+        switch (simple_selector.type) {
+        case Selector::SimpleSelector::Type::Id:
+        case Selector::SimpleSelector::Type::Class:
+            bloom_filter |= Selector::bloom_filter_bits_for_hash(simple_selector.name().hash());
+            break;
+        case Selector::SimpleSelector::Type::TagName:
+            bloom_filter |= Selector::bloom_filter_bits_for_hash(simple_selector.qualified_name().name.lowercase_name.hash());
+            break;
+        case Selector::SimpleSelector::Type::Attribute:
+            bloom_filter |= Selector::bloom_filter_bits_for_hash(simple_selector.attribute().qualified_name.name.name.hash());
+            break;
+        case Selector::SimpleSelector::Type::PseudoClass: {
+            // NOTE: The subject of the only argument of :is() or :where() has to match the element as well.
+            auto const& pseudo_class = simple_selector.pseudo_class();
+            if (first_is_one_of(pseudo_class.type, PseudoClass::Is, PseudoClass::Where) && pseudo_class.argument_selector_list.size() == 1)
+                bloom_filter |= bloom_filter_for_compound_selector(pseudo_class.argument_selector_list.first()->compound_selectors().last());
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return bloom_filter;
+}
+
+void Selector::collect_subject_bloom_filter()
+{
+    m_subject_bloom_filter = bloom_filter_for_compound_selector(m_compound_selectors.last());
+}
+
 // https://www.w3.org/TR/selectors-4/#specificity-rules
 u32 Selector::specificity() const
 {
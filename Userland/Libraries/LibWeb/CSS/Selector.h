@@ -252,6 +252,11 @@ public:
 
     auto const& ancestor_hashes() const { return m_ancestor_hashes; }
 
+    // A small bloom filter of the tag name, ID, classes and attribute names that an element needs to have to match this
+    // selector's subject. Matching can be skipped for elements whose own filter doesn't contain all of them.
+    u64 subject_bloom_filter() const { return m_subject_bloom_filter; }
+    static constexpr u64 bloom_filter_bits_for_hash(u32 hash) { return (1ull << (hash & 63)) | (1ull << ((hash >> 6) & 63)); }
+
 private:
     explicit Selector(Vector<CompoundSelector>&&);
 
@@ -261,8 +266,10 @@ private:
     bool m_contains_the_nesting_selector { false };
 
     void collect_ancestor_hashes();
+    void collect_subject_bloom_filter();
 
     Array<u32, 8> m_ancestor_hashes;
+    u64 m_subject_bloom_filter { 0 };
 };
 
 String serialize_a_group_of_selectors(SelectorList const& selectors);
@@ -7,6 +7,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
+#include <AK/AnyOf.h>
 #include <AK/BinarySearch.h>
 #include <AK/Debug.h>
 #include <AK/Error.h>
@@ -22,8 +24,6 @@
 #include <LibGfx/Font/FontWeight.h>
 #include <LibGfx/Font/ScaledFont.h>
 #include <LibGfx/Font/Typeface.h>
-#include <LibGfx/Font/WOFF/Loader.h>
-#include <LibGfx/Font/WOFF2/Loader.h>
 #include <LibWeb/Animations/AnimationEffect.h>
 #include <LibWeb/Animations/DocumentTimeline.h>
 #include <LibWeb/CSS/AnimationEvent.h>
@@ -35,6 +35,7 @@
 #include <LibWeb/CSS/CSSNestedDeclarations.h>
 #include <LibWeb/CSS/CSSStyleRule.h>
 #include <LibWeb/CSS/CSSTransition.h>
+#include <LibWeb/CSS/DecodedFontCache.h>
 #include <LibWeb/CSS/Interpolation.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/SelectorEngine.h>
@@ -70,10 +71,12 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ShadowRoot.h>
+#include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
+#include <LibWeb/HTML/TagNames.h>
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/MimeSniff/MimeType.h>
@@ -215,21 +218,12 @@ ErrorOr<NonnullRefPtr<Gfx::Typeface>> FontLoader::try_load_font()
         mime_type = MimeSniff::Resource::sniff(resource()->encoded_data(), Web::MimeSniff::SniffingConfiguration { .sniffing_context = Web::MimeSniff::SniffingContext::Font });
     }
     if (mime_type.has_value()) {
-        if (mime_type->essence() == "font/ttf"sv || mime_type->essence() == "application/x-font-ttf"sv) {
-            if (auto result = Gfx::Typeface::try_load_from_externally_owned_memory(resource()->encoded_data()); !result.is_error()) {
-                return result;
-            }
-        }
-        if (mime_type->essence() == "font/woff"sv || mime_type->essence() == "application/font-woff"sv) {
-            if (auto result = WOFF::try_load_from_externally_owned_memory(resource()->encoded_data()); !result.is_error()) {
-                return result;
-            }
-        }
-        if (mime_type->essence() == "font/woff2"sv || mime_type->essence() == "application/font-woff2"sv) {
-            if (auto result = WOFF2::try_load_from_externally_owned_memory(resource()->encoded_data()); !result.is_error()) {
-                return result;
-            }
-        }
+        if (mime_type->essence() == "font/ttf"sv || mime_type->essence() == "application/x-font-ttf"sv)
+            return DecodedFontCache::the().get_or_decode(resource()->encoded_data(), Array { DecodedFontCache::decode_ttf });
+        if (mime_type->essence() == "font/woff"sv || mime_type->essence() == "application/font-woff"sv)
+            return DecodedFontCache::the().get_or_decode(resource()->encoded_data(), Array { DecodedFontCache::decode_woff });
+        if (mime_type->essence() == "font/woff2"sv || mime_type->essence() == "application/font-woff2"sv)
+            return DecodedFontCache::the().get_or_decode(resource()->encoded_data(), Array { DecodedFontCache::decode_woff2 });
     }
 
     return Error::from_string_literal("Automatic format detection failed");
@@ -376,6 +370,28 @@ bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector)
     return false;
 }
 
+// The counterpart of Selector::subject_bloom_filter() for an element.
+static u64 subject_bloom_filter_for_element(DOM::Element const& element)
+{
+    // NOTE: Classes are matched case-insensitively in quirks mode, as are tag names outside of HTML documents, so we
+    //       can't match them by their hashes.
+    if (element.document().in_quirks_mode() || element.document().document_type() != DOM::Document::Type::HTML)
+        return NumericLimits<u64>::max();
+
+    u64 bloom_filter = Selector::bloom_filter_bits_for_hash(element.local_name().hash());
+    if (auto const& id = element.id(); id.has_value())
+        bloom_filter |= Selector::bloom_filter_bits_for_hash(id->hash());
+    for (auto const& class_name : element.class_names())
+        bloom_filter |= Selector::bloom_filter_bits_for_hash(class_name.hash());
+
+    // NOTE: Attribute selectors match the lowercased qualified names of the attributes of HTML elements (see matches_attribute()).
+    bool is_html_element = element.namespace_uri() == Namespace::HTML;
+    element.for_each_attribute([&](DOM::Attribute const& attribute) {
+        bloom_filter |= Selector::bloom_filter_bits_for_hash(is_html_element ? attribute.lowercase_name().hash() : attribute.name().hash());
+    });
+    return bloom_filter;
+}
+
 Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::Selector::PseudoElement::Type> pseudo_element, FlyString const& qualified_layer_name) const
 {
     auto const& root_node = element.root();
@@ -435,6 +451,9 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
     add_rules_to_run(rule_cache.other_rules);
 
     size_t maximum_match_count = 0;
+    size_t rules_rejected_by_subject_filter = 0;
+    size_t rules_rejected_by_ancestor_filter = 0;
+    auto element_bloom_filter = subject_bloom_filter_for_element(element);
 
     for (auto& rule_to_run : rules_to_run) {
         // FIXME: This needs to be revised when adding support for the ::shadow selector, as it needs to cross shadow boundaries.
@@ -457,14 +476,26 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
         }
 
         auto const& selector = rule_to_run.absolutized_selectors()[rule_to_run.selector_index];
+        if ((selector->subject_bloom_filter() & ~element_bloom_filter) != 0) {
+            rule_to_run.skip = true;
+            ++rules_rejected_by_subject_filter;
+            continue;
+        }
         if (should_reject_with_ancestor_filter(*selector)) {
             rule_to_run.skip = true;
+            ++rules_rejected_by_ancestor_filter;
             continue;
         }
 
         ++maximum_match_count;
     }
 
+    auto& statistics = m_document->rendering_statistics();
+    statistics.rules_considered += rules_to_run.size();
+    statistics.rules_rejected_by_subject_filter += rules_rejected_by_subject_filter;
+    statistics.rules_rejected_by_ancestor_filter += rules_rejected_by_ancestor_filter;
+    statistics.rules_matched_against_elements += maximum_match_count;
+
     if (maximum_match_count == 0)
         return {};
 
@@ -838,7 +869,7 @@ void StyleComputer::for_each_property_expanding_shorthands(PropertyID property_i
 void StyleComputer::set_property_expanding_shorthands(StyleProperties& style, PropertyID property_id, CSSStyleValue const& value, CSSStyleDeclaration const* declaration, StyleProperties const& style_for_revert, StyleProperties const& style_for_revert_layer, Important important)
 {
     auto revert_shorthand = [&](PropertyID shorthand_id, StyleProperties const& style_for_revert) {
-        auto previous_value = style_for_revert.m_data->m_property_values[to_underlying(shorthand_id)];
+        auto previous_value = style_for_revert.value_slot(shorthand_id);
         if (!previous_value)
             previous_value = CSSKeywordValue::create(Keyword::Initial);
 
@@ -908,6 +939,39 @@ void StyleComputer::set_all_properties(DOM::Element& element, Optional<CSS::Sele
     }
 }
 
+NonnullRefPtr<CSSStyleValue> StyleComputer::resolve_unresolved_style_value(DOM::Element& element, Optional<CSS::Selector::PseudoElement::Type> pseudo_element, PropertyID property_id, UnresolvedStyleValue const& unresolved_value) const
+{
+    // NOTE: We only keep the most recent result for each value, and start over when there are too many of them, as
+    //       e.g. changing inline styles keeps creating new values.
+    static constexpr size_t max_resolved_style_values = 4096;
+
+    if (auto it = m_resolved_style_values.find(&unresolved_value); it != m_resolved_style_values.end() && it->value.property_id == property_id) {
+        auto const& resolved = it->value;
+        bool dependencies_are_unchanged = all_of(resolved.custom_property_dependencies, [&](auto const& dependency) {
+            return Parser::Parser::custom_property_value(element, pseudo_element, dependency.name) == dependency.value;
+        });
+        if (dependencies_are_unchanged)
+            return resolved.value;
+    }
+
+    Parser::Parser::UnresolvedStyleValueDependencies dependencies;
+    auto value = Parser::Parser::resolve_unresolved_style_value(Parser::ParsingContext { document() }, element, pseudo_element, property_id, unresolved_value, &dependencies);
+    if (dependencies.uses_attributes)
+        return value;
+
+    ResolvedStyleValue resolved { unresolved_value, property_id, {}, value };
+    resolved.custom_property_dependencies.ensure_capacity(dependencies.custom_property_names.size());
+    for (auto& name : dependencies.custom_property_names) {
+        auto custom_property_value = Parser::Parser::custom_property_value(element, pseudo_element, name);
+        resolved.custom_property_dependencies.unchecked_append({ move(name), move(custom_property_value) });
+    }
+
+    if (m_resolved_style_values.size() >= max_resolved_style_values)
+        m_resolved_style_values.clear();
+    m_resolved_style_values.set(&unresolved_value, move(resolved));
+    return value;
+}
+
 void StyleComputer::cascade_declarations(StyleProperties& style, DOM::Element& element, Optional<CSS::Selector::PseudoElement::Type> pseudo_element, Vector<MatchingRule> const& matching_rules, CascadeOrigin cascade_origin, Important important, StyleProperties const& style_for_revert, StyleProperties const& style_for_revert_layer) const
 {
     for (auto const& match : matching_rules) {
@@ -922,7 +986,7 @@ void StyleComputer::cascade_declarations(StyleProperties& style, DOM::Element& e
 
             auto property_value = property.value;
             if (property.value->is_unresolved())
-                property_value = Parser::Parser::resolve_unresolved_style_value(Parser::ParsingContext { document() }, element, pseudo_element, property.property_id, property.value->as_unresolved());
+                property_value = resolve_unresolved_style_value(element, pseudo_element, property.property_id, property.value->as_unresolved());
             if (!property_value->is_unresolved())
                 set_property_expanding_shorthands(style, property.property_id, property_value, &match.declaration(), style_for_revert, style_for_revert_layer, important);
         }
@@ -941,7 +1005,7 @@ void StyleComputer::cascade_declarations(StyleProperties& style, DOM::Element& e
 
                 auto property_value = property.value;
                 if (property.value->is_unresolved())
-                    property_value = Parser::Parser::resolve_unresolved_style_value(Parser::ParsingContext { document() }, element, pseudo_element, property.property_id, property.value->as_unresolved());
+                    property_value = resolve_unresolved_style_value(element, pseudo_element, property.property_id, property.value->as_unresolved());
                 if (!property_value->is_unresolved())
                     set_property_expanding_shorthands(style, property.property_id, property_value, inline_style, style_for_revert, style_for_revert_layer, important);
             }
@@ -1511,9 +1575,11 @@ void StyleComputer::compute_cascaded_values(StyleProperties& style, DOM::Element
             // FIXME: This is not very efficient, we should only resolve the custom properties that are actually used.
             for (auto i = to_underlying(CSS::first_property_id); i <= to_underlying(CSS::last_property_id); ++i) {
                 auto property_id = (CSS::PropertyID)i;
-                auto& property = style.m_data->m_property_values[i];
-                if (property && property->is_unresolved())
-                    property = Parser::Parser::resolve_unresolved_style_value(Parser::ParsingContext { document() }, element, pseudo_element, property_id, property->as_unresolved());
+                auto const& property = style.value_slot(property_id);
+                if (property && property->is_unresolved()) {
+                    auto resolved_property = Parser::Parser::resolve_unresolved_style_value(Parser::ParsingContext { document() }, element, pseudo_element, property_id, property->as_unresolved());
+                    style.mutable_value_slot(property_id) = move(resolved_property);
+                }
             }
         }
     }
@@ -1633,7 +1699,7 @@ void StyleComputer::compute_defaulted_property_value(StyleProperties& style, DOM
 {
     // FIXME: If we don't know the correct initial value for a property, we fall back to `initial`.
 
-    auto& value_slot = style.m_data->m_property_values[to_underlying(property_id)];
+    auto const& value_slot = style.value_slot(property_id);
     if (!value_slot) {
         if (is_inherited_property(property_id)) {
             style.set_property(
@@ -1648,12 +1714,12 @@ void StyleComputer::compute_defaulted_property_value(StyleProperties& style, DOM
     }
 
     if (value_slot->is_initial()) {
-        value_slot = property_initial_value(document().realm(), property_id);
+        style.mutable_value_slot(property_id) = property_initial_value(document().realm(), property_id);
         return;
     }
 
     if (value_slot->is_inherit()) {
-        value_slot = get_inherit_value(document().realm(), property_id, element, pseudo_element);
+        style.mutable_value_slot(property_id) = get_inherit_value(document().realm(), property_id, element, pseudo_element);
         style.set_property_inherited(property_id, StyleProperties::Inherited::Yes);
         return;
     }
@@ -1663,11 +1729,11 @@ void StyleComputer::compute_defaulted_property_value(StyleProperties& style, DOM
     if (value_slot->is_unset()) {
         if (is_inherited_property(property_id)) {
             // then if it is an inherited property, this is treated as inherit,
-            value_slot = get_inherit_value(document().realm(), property_id, element, pseudo_element);
+            style.mutable_value_slot(property_id) = get_inherit_value(document().realm(), property_id, element, pseudo_element);
             style.set_property_inherited(property_id, StyleProperties::Inherited::Yes);
         } else {
             // and if it is not, this is treated as initial.
-            value_slot = property_initial_value(document().realm(), property_id);
+            style.mutable_value_slot(property_id) = property_initial_value(document().realm(), property_id);
         }
     }
 }
@@ -2104,9 +2170,8 @@ void StyleComputer::absolutize_values(StyleProperties& style) const
     //       We have to resolve them right away, so that the *computed* line-height is ready for inheritance.
     //       We can't simply absolutize *all* percentage values against the font size,
     //       because most percentages are relative to containing block metrics.
-    auto& line_height_value_slot = style.m_data->m_property_values[to_underlying(CSS::PropertyID::LineHeight)];
-    if (line_height_value_slot && line_height_value_slot->is_percentage()) {
-        line_height_value_slot = LengthStyleValue::create(
+    if (auto const& line_height_value_slot = style.value_slot(CSS::PropertyID::LineHeight); line_height_value_slot && line_height_value_slot->is_percentage()) {
+        style.mutable_value_slot(CSS::PropertyID::LineHeight) = LengthStyleValue::create(
             Length::make_px(CSSPixels::nearest_value_for(font_size * static_cast<double>(line_height_value_slot->as_percentage().percentage().as_fraction()))));
     }
 
@@ -2114,14 +2179,18 @@ void StyleComputer::absolutize_values(StyleProperties& style) const
     font_metrics.line_height = line_height;
 
     // NOTE: line-height might be using lh which should be resolved against the parent line height (like we did here already)
-    if (line_height_value_slot && line_height_value_slot->is_length())
-        line_height_value_slot = LengthStyleValue::create(Length::make_px(line_height));
+    if (auto const& line_height_value_slot = style.value_slot(CSS::PropertyID::LineHeight); line_height_value_slot && line_height_value_slot->is_length())
+        style.mutable_value_slot(CSS::PropertyID::LineHeight) = LengthStyleValue::create(Length::make_px(line_height));
 
-    for (size_t i = 0; i < style.m_data->m_property_values.size(); ++i) {
-        auto& value_slot = style.m_data->m_property_values[i];
+    for (size_t i = 0; i < StyleProperties::number_of_properties; ++i) {
+        auto property_id = static_cast<CSS::PropertyID>(i);
+        auto const& value_slot = style.value_slot(property_id);
         if (!value_slot)
             continue;
-        value_slot = value_slot->absolutized(viewport_rect(), font_metrics, m_root_element_font_metrics);
+        // NOTE: Only touch the slot if the value actually changed, so the property values stay shared where possible.
+        auto absolutized_value = value_slot->absolutized(viewport_rect(), font_metrics, m_root_element_font_metrics);
+        if (absolutized_value.ptr() != value_slot.ptr())
+            style.mutable_value_slot(property_id) = move(absolutized_value);
     }
 
     style.set_line_height({}, line_height);
@@ -2297,6 +2366,7 @@ RefPtr<StyleProperties> StyleComputer::compute_pseudo_element_style_if_needed(DO
 RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element, Optional<CSS::Selector::PseudoElement::Type> pseudo_element, ComputeStyleMode mode) const
 {
     build_rule_cache_if_needed();
+    ++m_document->rendering_statistics().elements_styled;
 
     // Special path for elements that use pseudo element as style selector
     if (element.use_pseudo_element().has_value()) {
@@ -2313,6 +2383,11 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
 
     ScopeGuard guard { [&element]() { element.set_needs_style_update(false); } };
 
+    if (mode == ComputeStyleMode::Normal && !pseudo_element.has_value()) {
+        if (auto style = find_shareable_style(element))
+            return style;
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
@@ -2375,9 +2450,122 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
         start_needed_transitions(*previous_style, style, element, pseudo_element);
     }
 
+    // 10. Share the computed values with other elements that computed the same ones
+    share_property_values(style);
+
     return style;
 }
 
+template<typename PropertyValues>
+void StyleComputer::SharedPropertyValues<PropertyValues>::share(AK::CopyOnWrite<PropertyValues>& property_values)
+{
+    auto const& values = property_values.value();
+    if (auto it = m_property_values.find(values.hash(), [&](auto const& shared_values) { return *shared_values == values; }); it != m_property_values.end()) {
+        property_values = *it;
+        return;
+    }
+
+    // NOTE: We drop the property values that no StyleProperties uses anymore whenever the table has doubled in size.
+    if (m_property_values.size() >= m_size_before_next_purge) {
+        m_property_values.remove_all_matching([](auto const& shared_values) { return shared_values->ref_count() == 1; });
+        m_size_before_next_purge = max(m_size_before_next_purge, m_property_values.size() * 2);
+    }
+    m_property_values.set(*property_values.ptr());
+}
+
+void StyleComputer::share_property_values(StyleProperties& style) const
+{
+    m_shared_inherited_property_values.share(style.m_data->m_inherited_property_values);
+    m_shared_other_property_values.share(style.m_data->m_other_property_values);
+}
+
+// These elements commonly appear as long runs of identically styled siblings (list items, table cells, ...), and whether
+// a selector matches them only depends on their attributes, their ancestors and siblings, and the document's hovered,
+// focused, active and target elements.
+static bool is_eligible_for_style_sharing(DOM::Element const& element)
+{
+    if (!element.is_html_element())
+        return false;
+    if (!element.local_name().is_one_of(HTML::TagNames::li, HTML::TagNames::td, HTML::TagNames::th, HTML::TagNames::tr, HTML::TagNames::div, HTML::TagNames::span, HTML::TagNames::p, HTML::TagNames::a, HTML::TagNames::dt, HTML::TagNames::dd))
+        return false;
+
+    // NOTE: An inline style is a separate declaration block per element, and the popover and dir=auto states aren't
+    //       reflected in the attributes, so don't bother with any of these.
+    if (element.inline_style() || element.has_attribute(HTML::AttributeNames::popover) || element.has_attribute(HTML::AttributeNames::dir))
+        return false;
+    if (element.is_shadow_host() || element.use_pseudo_element().has_value())
+        return false;
+    if (element.has_associated_animations() || element.cached_animation_name_source({}) || element.cached_transition_property_source())
+        return false;
+
+    auto const& document = element.document();
+    auto contains = [&](DOM::Node const* node) { return node && element.is_inclusive_ancestor_of(*node); };
+    if (contains(document.hovered_node()) || contains(document.focused_element()) || contains(document.active_element()) || contains(document.target_element()))
+        return false;
+
+    return true;
+}
+
+static bool have_same_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.attribute_list_size() != b.attribute_list_size())
+        return false;
+    bool same_attributes = true;
+    a.for_each_attribute([&](FlyString const& name, String const& value) {
+        if (!same_attributes)
+            return;
+        auto other_value = b.get_attribute(name);
+        same_attributes = other_value.has_value() && *other_value == value;
+    });
+    return same_attributes;
+}
+
+bool StyleComputer::may_be_subject_of_sibling_sensitive_rules(DOM::Element const& element) const
+{
+    for (auto const* rule_cache : Array<RuleCache const*, 3> { m_author_rule_cache.ptr(), m_user_rule_cache.ptr(), m_user_agent_rule_cache }) {
+        if (rule_cache->has_unkeyed_sibling_sensitive_rules)
+            return true;
+        if (rule_cache->tag_names_with_sibling_sensitive_rules.contains(element.local_name()))
+            return true;
+        if (auto id = element.id(); id.has_value() && rule_cache->ids_with_sibling_sensitive_rules.contains(*id))
+            return true;
+        for (auto const& class_name : element.class_names()) {
+            if (rule_cache->classes_with_sibling_sensitive_rules.contains(class_name))
+                return true;
+        }
+    }
+    return false;
+}
+
+// Instead of running the cascade for an element, reuse the computed style of a preceding sibling if that is provably
+// the same: an element of the same type with the same attributes, that no selector can tell apart from this one.
+RefPtr<StyleProperties> StyleComputer::find_shareable_style(DOM::Element& element) const
+{
+    // NOTE: Looking further back than this rarely finds anything that the previous few siblings didn't.
+    static constexpr size_t max_candidates_to_check = 4;
+
+    if (!is_eligible_for_style_sharing(element) || may_be_subject_of_sibling_sensitive_rules(element))
+        return nullptr;
+
+    size_t checked_candidates = 0;
+    for (auto* candidate = element.previous_element_sibling(); candidate && checked_candidates < max_candidates_to_check; candidate = candidate->previous_element_sibling(), ++checked_candidates) {
+        auto const* candidate_style = candidate->computed_css_values();
+        if (!candidate_style || candidate->needs_style_update())
+            continue;
+        if (candidate->local_name() != element.local_name() || candidate->namespace_uri() != element.namespace_uri())
+            continue;
+        if (!have_same_attributes(element, *candidate) || !is_eligible_for_style_sharing(*candidate))
+            continue;
+        if (candidate_style->animation_name_source() || candidate_style->transition_property_source() || !candidate_style->animated_property_values().is_empty())
+            continue;
+
+        // NOTE: The cascade would also have resolved the element's custom properties, which aren't part of the computed style.
+        element.set_custom_properties({}, candidate->custom_properties({}));
+        return candidate_style->clone();
+    }
+    return nullptr;
+}
+
 void StyleComputer::build_rule_cache_if_needed() const
 {
     if (m_author_rule_cache && m_user_rule_cache && m_user_agent_rule_cache)
@@ -2421,6 +2609,113 @@ static Optional<SimplifiedSelectorForBucketing> is_roundabout_selector_bucketabl
     return {};
 }
 
+static bool is_sibling_sensitive(CSS::Selector const&);
+
+static bool is_sibling_sensitive(CSS::Selector::SimpleSelector const& simple_selector)
+{
+    if (simple_selector.type != CSS::Selector::SimpleSelector::Type::PseudoClass)
+        return false;
+
+    auto const& pseudo_class = simple_selector.pseudo_class();
+    switch (pseudo_class.type) {
+    case CSS::PseudoClass::FirstChild:
+    case CSS::PseudoClass::LastChild:
+    case CSS::PseudoClass::OnlyChild:
+    case CSS::PseudoClass::NthChild:
+    case CSS::PseudoClass::NthLastChild:
+    case CSS::PseudoClass::FirstOfType:
+    case CSS::PseudoClass::LastOfType:
+    case CSS::PseudoClass::OnlyOfType:
+    case CSS::PseudoClass::NthOfType:
+    case CSS::PseudoClass::NthLastOfType:
+    case CSS::PseudoClass::Empty:
+    case CSS::PseudoClass::Has:
+        return true;
+    default:
+        break;
+    }
+
+    // NOTE: The argument selectors of :is(), :where() and :not() have the same subject as the selector they're in, so
+    //       their combinators can make it depend on its siblings too, as in `li:is(li + li)`.
+    return any_of(pseudo_class.argument_selector_list, [](auto const& argument_selector) { return is_sibling_sensitive(*argument_selector); });
+}
+
+// Whether matching the selector's subject can depend on the element's siblings or children, rather than just on the
+// element itself and its ancestors.
+static bool is_sibling_sensitive(CSS::Selector const& selector)
+{
+    auto const& subject = selector.compound_selectors().last();
+    if (first_is_one_of(subject.combinator, CSS::Selector::Combinator::NextSibling, CSS::Selector::Combinator::SubsequentSibling, CSS::Selector::Combinator::Column))
+        return true;
+    return any_of(subject.simple_selectors, [](auto const& simple_selector) { return is_sibling_sensitive(simple_selector); });
+}
+
+static void collect_invalidation_sets(CSS::Selector const&, InvalidationSet const& subject_invalidation_set, auto& rule_cache);
+
+static void collect_invalidation_sets(Vector<CSS::Selector::SimpleSelector> const& simple_selectors, InvalidationSet const& invalidation_set, auto& rule_cache)
+{
+    for (auto const& simple_selector : simple_selectors) {
+        switch (simple_selector.type) {
+        case CSS::Selector::SimpleSelector::Type::Id:
+            rule_cache.invalidation_sets_by_id.ensure(simple_selector.name()) |= invalidation_set;
+            break;
+        case CSS::Selector::SimpleSelector::Type::Class:
+            rule_cache.invalidation_sets_by_class.ensure(simple_selector.name()) |= invalidation_set;
+            break;
+        case CSS::Selector::SimpleSelector::Type::Attribute:
+            rule_cache.invalidation_sets_by_attribute_name.ensure(simple_selector.attribute().qualified_name.name.lowercase_name) |= invalidation_set;
+            break;
+        case CSS::Selector::SimpleSelector::Type::PseudoClass: {
+            auto const& pseudo_class = simple_selector.pseudo_class();
+            // NOTE: The arguments of :is(), :where() and :not() match the same element as the compound they're in, but
+            //       the arguments of :has(), :host() and :nth-child(... of S) match its relatives (or its host).
+            auto argument_invalidation_set = first_is_one_of(pseudo_class.type, CSS::PseudoClass::Is, CSS::PseudoClass::Where, CSS::PseudoClass::Not)
+                ? invalidation_set
+                : InvalidationSet::whole_document_set();
+            for (auto const& argument_selector : pseudo_class.argument_selector_list)
+                collect_invalidation_sets(*argument_selector, argument_invalidation_set, rule_cache);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+// Records, for every class, ID and attribute the selector mentions, which elements relative to one that gains or loses
+// it may start or stop matching the selector's subject.
+static void collect_invalidation_sets(CSS::Selector const& selector, InvalidationSet const& subject_invalidation_set, auto& rule_cache)
+{
+    auto const& compound_selectors = selector.compound_selectors();
+    for (size_t i = 0; i < compound_selectors.size(); ++i) {
+        if (i == compound_selectors.size() - 1) {
+            collect_invalidation_sets(compound_selectors[i].simple_selectors, subject_invalidation_set, rule_cache);
+            continue;
+        }
+
+        // NOTE: Whatever follows the first combinator to the right of a compound can't reach outside of the element's
+        //       subtree (for > and descendant combinators) or the subtrees of its subsequent siblings (for + and ~).
+        //       This also holds when the selector is an argument of the subject's :is(), so the subject's own
+        //       invalidation set only matters if it reaches further than that.
+        InvalidationSet invalidation_set;
+        switch (compound_selectors[i + 1].combinator) {
+        case CSS::Selector::Combinator::ImmediateChild:
+        case CSS::Selector::Combinator::Descendant:
+            invalidation_set.descendants = true;
+            break;
+        case CSS::Selector::Combinator::NextSibling:
+        case CSS::Selector::Combinator::SubsequentSibling:
+            invalidation_set.subsequent_siblings = true;
+            break;
+        default:
+            invalidation_set.whole_document = true;
+            break;
+        }
+        invalidation_set.whole_document |= subject_invalidation_set.whole_document;
+        collect_invalidation_sets(compound_selectors[i].simple_selectors, invalidation_set, rule_cache);
+    }
+}
+
 NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin)
 {
     auto rule_cache = make<RuleCache>();
@@ -2433,6 +2728,25 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
     size_t num_attribute_rules = 0;
     size_t num_hover_rules = 0;
 
+    auto record_sibling_sensitive_rule = [&](CSS::Selector const& selector) {
+        for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
+            switch (simple_selector.type) {
+            case CSS::Selector::SimpleSelector::Type::Id:
+                rule_cache->ids_with_sibling_sensitive_rules.set(simple_selector.name());
+                return;
+            case CSS::Selector::SimpleSelector::Type::Class:
+                rule_cache->classes_with_sibling_sensitive_rules.set(simple_selector.name());
+                return;
+            case CSS::Selector::SimpleSelector::Type::TagName:
+                rule_cache->tag_names_with_sibling_sensitive_rules.set(simple_selector.qualified_name().name.lowercase_name);
+                return;
+            default:
+                break;
+            }
+        }
+        rule_cache->has_unkeyed_sibling_sensitive_rules = true;
+    };
+
     Vector<MatchingRule> matching_rules;
     size_t style_sheet_index = 0;
     for_each_stylesheet(cascade_origin, [&](auto& sheet, JS::GCPtr<DOM::ShadowRoot> shadow_root) {
@@ -2504,6 +2818,10 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                     }
                 }
 
+                if (!matching_rule.contains_pseudo_element && is_sibling_sensitive(selector))
+                    record_sibling_sensitive_rule(selector);
+                collect_invalidation_sets(selector, InvalidationSet { .element = true }, *rule_cache);
+
                 // NOTE: We traverse the simple selectors in reverse order to make sure that class/ID buckets are preferred over tag buckets
                 //       in the common case of div.foo or div#foo selectors.
                 bool added_to_bucket = false;
@@ -2635,6 +2953,19 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
     return rule_cache;
 }
 
+// NOTE: The UA style sheets are parsed once per process, and their media rules are never evaluated, so every document
+//       in the same quirks mode ends up with the same UA rule cache. We build each of them once and share it.
+StyleComputer::RuleCache const& StyleComputer::shared_user_agent_rule_cache()
+{
+    static OwnPtr<RuleCache> rule_cache;
+    static OwnPtr<RuleCache> quirks_mode_rule_cache;
+
+    auto& shared_rule_cache = document().in_quirks_mode() ? quirks_mode_rule_cache : rule_cache;
+    if (!shared_rule_cache)
+        shared_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent);
+    return *shared_rule_cache;
+}
+
 struct LayerNode {
     OrderedHashMap<FlyString, LayerNode> children {};
 };
@@ -2714,14 +3045,41 @@ void StyleComputer::build_rule_cache()
 
     m_author_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::Author);
     m_user_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::User);
-    m_user_agent_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent);
+    m_user_agent_rule_cache = &shared_user_agent_rule_cache();
 
     m_has_has_selectors = m_author_rule_cache->has_has_selectors || m_user_rule_cache->has_has_selectors || m_user_agent_rule_cache->has_has_selectors;
 }
 
+InvalidationSet StyleComputer::invalidation_set_for_changed_names(FlyString const& attribute_name, ReadonlySpan<FlyString> names, HashMap<FlyString, InvalidationSet> RuleCache::*invalidation_sets) const
+{
+    build_rule_cache_if_needed();
+
+    InvalidationSet invalidation_set;
+    for (auto const* rule_cache : Array<RuleCache const*, 3> { m_author_rule_cache.ptr(), m_user_rule_cache.ptr(), m_user_agent_rule_cache }) {
+        if (auto attribute_invalidation_set = rule_cache->invalidation_sets_by_attribute_name.get(attribute_name); attribute_invalidation_set.has_value())
+            invalidation_set |= *attribute_invalidation_set;
+        for (auto const& name : names) {
+            if (auto name_invalidation_set = (rule_cache->*invalidation_sets).get(name); name_invalidation_set.has_value())
+                invalidation_set |= *name_invalidation_set;
+        }
+    }
+    return invalidation_set;
+}
+
+InvalidationSet StyleComputer::invalidation_set_for_changed_classes(ReadonlySpan<FlyString> class_names) const
+{
+    return invalidation_set_for_changed_names(HTML::AttributeNames::class_, class_names, &RuleCache::invalidation_sets_by_class);
+}
+
+InvalidationSet StyleComputer::invalidation_set_for_changed_ids(ReadonlySpan<FlyString> ids) const
+{
+    return invalidation_set_for_changed_names(HTML::AttributeNames::id, ids, &RuleCache::invalidation_sets_by_id);
+}
+
 void StyleComputer::invalidate_rule_cache()
 {
     m_author_rule_cache = nullptr;
+    m_resolved_style_values.clear();
 
     // NOTE: We could be smarter about keeping the user rule cache, and style sheet.
     //       Currently we are re-parsing the user style sheet every time we build the caches,
@@ -2729,8 +3087,7 @@ void StyleComputer::invalidate_rule_cache()
     m_user_rule_cache = nullptr;
     m_user_style_sheet = nullptr;
 
-    // NOTE: It might not be necessary to throw away the UA rule cache.
-    //       If we are sure that it's safe, we could keep it as an optimization.
+    // NOTE: The UA rule cache itself is kept, this only makes us look up the right one for the document's quirks mode again.
     m_user_agent_rule_cache = nullptr;
 }
 
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <AK/CopyOnWrite.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Font/Typeface.h>
@@ -16,6 +18,7 @@
 #include <LibWeb/CSS/CSSKeyframesRule.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
 #include <LibWeb/CSS/Selector.h>
+#include <LibWeb/CSS/StyleInvalidation.h>
 #include <LibWeb/CSS/StyleProperties.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Loader/ResourceLoader.h>
@@ -164,6 +167,10 @@ public:
 
     [[nodiscard]] bool has_has_selectors() const { return m_has_has_selectors; }
 
+    // Which elements may need their style recomputed after an element gained or lost the given classes or IDs.
+    [[nodiscard]] InvalidationSet invalidation_set_for_changed_classes(ReadonlySpan<FlyString> class_names) const;
+    [[nodiscard]] InvalidationSet invalidation_set_for_changed_ids(ReadonlySpan<FlyString> ids) const;
+
     size_t number_of_css_font_faces_with_loading_in_progress() const;
 
 private:
@@ -177,6 +184,8 @@ private:
     [[nodiscard]] bool should_reject_with_ancestor_filter(Selector const&) const;
 
     RefPtr<StyleProperties> compute_style_impl(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, ComputeStyleMode) const;
+    RefPtr<StyleProperties> find_shareable_style(DOM::Element&) const;
+    [[nodiscard]] bool may_be_subject_of_sibling_sensitive_rules(DOM::Element const&) const;
     void compute_cascaded_values(StyleProperties&, DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, bool& did_match_any_pseudo_element_rules, ComputeStyleMode) const;
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_ascending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_descending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
@@ -233,16 +242,71 @@ private:
         HashMap<FlyString, NonnullRefPtr<Animations::KeyframeEffect::KeyFrameSet>> rules_by_animation_keyframes;
 
         bool has_has_selectors { false };
+
+        // The ID, class or tag name of the subject of every rule whose matching depends on the element's siblings or
+        // children (e.g. li:first-child or .foo + .bar). Elements that may be the subject of such a rule can't share
+        // their style with a sibling (see find_shareable_style()).
+        HashTable<FlyString> ids_with_sibling_sensitive_rules;
+        HashTable<FlyString> classes_with_sibling_sensitive_rules;
+        HashTable<FlyString> tag_names_with_sibling_sensitive_rules;
+        bool has_unkeyed_sibling_sensitive_rules { false };
+
+        // What to invalidate when an element gains or loses a class or ID, or when an attribute that appears in an
+        // attribute selector changes, as determined by where in the selectors that mention it it appears.
+        HashMap<FlyString, InvalidationSet> invalidation_sets_by_id;
+        HashMap<FlyString, InvalidationSet> invalidation_sets_by_class;
+        HashMap<FlyString, InvalidationSet, AK::ASCIICaseInsensitiveFlyStringTraits> invalidation_sets_by_attribute_name;
     };
 
     NonnullOwnPtr<RuleCache> make_rule_cache_for_cascade_origin(CascadeOrigin);
+    RuleCache const& shared_user_agent_rule_cache();
+    InvalidationSet invalidation_set_for_changed_names(FlyString const& attribute_name, ReadonlySpan<FlyString> names, HashMap<FlyString, InvalidationSet> RuleCache::*invalidation_sets) const;
 
     RuleCache const& rule_cache_for_cascade_origin(CascadeOrigin) const;
 
+    // Property values that some StyleProperties computed, so that others that compute the same ones can share them.
+    template<typename PropertyValues>
+    class SharedPropertyValues {
+    public:
+        void share(AK::CopyOnWrite<PropertyValues>&);
+
+    private:
+        struct Traits : public DefaultTraits<NonnullRefPtr<PropertyValues>> {
+            static unsigned hash(NonnullRefPtr<PropertyValues> const& property_values) { return property_values->hash(); }
+            static bool equals(NonnullRefPtr<PropertyValues> const& a, NonnullRefPtr<PropertyValues> const& b) { return *a == *b; }
+        };
+
+        HashTable<NonnullRefPtr<PropertyValues>, Traits> m_property_values;
+        size_t m_size_before_next_purge { 256 };
+    };
+
+    void share_property_values(StyleProperties&) const;
+
+    mutable SharedPropertyValues<StyleProperties::InheritedPropertyValues> m_shared_inherited_property_values;
+    mutable SharedPropertyValues<StyleProperties::OtherPropertyValues> m_shared_other_property_values;
+
+    // The result of resolving the var()s in a property value for some element. It can be reused for every other element
+    // for which the custom properties that it looked up have the same values.
+    struct ResolvedStyleValue {
+        struct CustomPropertyDependency {
+            FlyString name;
+            RefPtr<CSSStyleValue const> value;
+        };
+
+        NonnullRefPtr<UnresolvedStyleValue const> unresolved_value;
+        PropertyID property_id;
+        Vector<CustomPropertyDependency> custom_property_dependencies;
+        NonnullRefPtr<CSSStyleValue> value;
+    };
+
+    NonnullRefPtr<CSSStyleValue> resolve_unresolved_style_value(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, PropertyID, UnresolvedStyleValue const&) const;
+
+    mutable HashMap<UnresolvedStyleValue const*, ResolvedStyleValue> m_resolved_style_values;
+
     bool m_has_has_selectors { false };
     OwnPtr<RuleCache> m_author_rule_cache;
     OwnPtr<RuleCache> m_user_rule_cache;
-    OwnPtr<RuleCache> m_user_agent_rule_cache;
+    RuleCache const* m_user_agent_rule_cache { nullptr };
     JS::Handle<CSSStyleSheet> m_user_style_sheet;
 
     using FontLoaderList = Vector<NonnullOwnPtr<FontLoader>>;
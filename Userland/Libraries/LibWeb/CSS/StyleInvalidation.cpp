@@ -50,6 +50,11 @@ RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::Property
         if (old_value_opacity != new_value_opacity && (old_value_opacity == 1 || new_value_opacity == 1)) {
             invalidation.rebuild_stacking_context_tree = true;
         }
+    } else if (property_id == CSS::PropertyID::Transform && old_value && new_value) {
+        // OPTIMIZATION: Likewise, only a change from or to `none` creates or removes the stacking context for a transform.
+        //               This keeps transform animations from rebuilding the stacking context tree on every frame.
+        if ((old_value->to_keyword() == CSS::Keyword::None) != (new_value->to_keyword() == CSS::Keyword::None))
+            invalidation.rebuild_stacking_context_tree = true;
     } else if (CSS::property_affects_stacking_context(property_id)) {
         invalidation.rebuild_stacking_context_tree = true;
     }
@@ -29,6 +29,28 @@ struct RequiredInvalidationAfterStyleChange {
     static RequiredInvalidationAfterStyleChange full() { return { true, true, true, true }; }
 };
 
+// The elements, relative to an element that gained or lost a class or ID, whose style may change as a result. This is
+// derived from every selector that mentions the class or ID (see StyleComputer::invalidation_set_for_class_or_id_change()).
+struct InvalidationSet {
+    bool element : 1 { false };
+    bool descendants : 1 { false };
+    // NOTE: This includes the descendants of those siblings.
+    bool subsequent_siblings : 1 { false };
+    // Set when the scope can't be expressed relative to the element, e.g. for classes inside :has().
+    bool whole_document : 1 { false };
+
+    void operator|=(InvalidationSet const& other)
+    {
+        element |= other.element;
+        descendants |= other.descendants;
+        subsequent_siblings |= other.subsequent_siblings;
+        whole_document |= other.whole_document;
+    }
+
+    [[nodiscard]] bool is_empty() const { return !element && !descendants && !subsequent_siblings && !whole_document; }
+    static InvalidationSet whole_document_set() { return { false, false, false, true }; }
+};
+
 RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::PropertyID property_id, RefPtr<CSSStyleValue const> const& old_value, RefPtr<CSSStyleValue const> const& new_value);
 
 }
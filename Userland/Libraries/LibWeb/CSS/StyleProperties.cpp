@@ -43,9 +43,8 @@ NonnullRefPtr<StyleProperties::Data> StyleProperties::Data::clone() const
     auto clone = adopt_ref(*new StyleProperties::Data);
     clone->m_animation_name_source = m_animation_name_source;
     clone->m_transition_property_source = m_transition_property_source;
-    clone->m_property_values = m_property_values;
-    clone->m_property_important = m_property_important;
-    clone->m_property_inherited = m_property_inherited;
+    clone->m_inherited_property_values = m_inherited_property_values;
+    clone->m_other_property_values = m_other_property_values;
     clone->m_animated_property_values = m_animated_property_values;
     clone->m_math_depth = m_math_depth;
     clone->m_font_list = m_font_list;
@@ -60,46 +59,69 @@ NonnullRefPtr<StyleProperties> StyleProperties::clone() const
     return cloned;
 }
 
+static bool get_bit(ReadonlyBytes bits, size_t n)
+{
+    return bits[n / 8] & (1 << (n % 8));
+}
+
+static void set_bit(Bytes bits, size_t n, bool value)
+{
+    if (value)
+        bits[n / 8] |= (1 << (n % 8));
+    else
+        bits[n / 8] &= ~(1 << (n % 8));
+}
+
 bool StyleProperties::is_property_important(CSS::PropertyID property_id) const
 {
-    size_t n = to_underlying(property_id);
-    return m_data->m_property_important[n / 8] & (1 << (n % 8));
+    auto n = index_in_property_values(property_id);
+    if (is_inherited_longhand(property_id))
+        return get_bit(m_data->m_inherited_property_values->important, n);
+    return get_bit(m_data->m_other_property_values->important, n);
 }
 
 void StyleProperties::set_property_important(CSS::PropertyID property_id, Important important)
 {
-    size_t n = to_underlying(property_id);
-    if (important == Important::Yes)
-        m_data->m_property_important[n / 8] |= (1 << (n % 8));
+    if (is_property_important(property_id) == (important == Important::Yes))
+        return;
+    auto n = index_in_property_values(property_id);
+    if (is_inherited_longhand(property_id))
+        set_bit(m_data->m_inherited_property_values->important, n, important == Important::Yes);
     else
-        m_data->m_property_important[n / 8] &= ~(1 << (n % 8));
+        set_bit(m_data->m_other_property_values->important, n, important == Important::Yes);
 }
 
 bool StyleProperties::is_property_inherited(CSS::PropertyID property_id) const
 {
-    size_t n = to_underlying(property_id);
-    return m_data->m_property_inherited[n / 8] & (1 << (n % 8));
+    auto n = index_in_property_values(property_id);
+    if (is_inherited_longhand(property_id))
+        return get_bit(m_data->m_inherited_property_values->inherited, n);
+    return get_bit(m_data->m_other_property_values->inherited, n);
 }
 
 void StyleProperties::set_property_inherited(CSS::PropertyID property_id, Inherited inherited)
 {
-    size_t n = to_underlying(property_id);
-    if (inherited == Inherited::Yes)
-        m_data->m_property_inherited[n / 8] |= (1 << (n % 8));
+    if (is_property_inherited(property_id) == (inherited == Inherited::Yes))
+        return;
+    auto n = index_in_property_values(property_id);
+    if (is_inherited_longhand(property_id))
+        set_bit(m_data->m_inherited_property_values->inherited, n, inherited == Inherited::Yes);
     else
-        m_data->m_property_inherited[n / 8] &= ~(1 << (n % 8));
+        set_bit(m_data->m_other_property_values->inherited, n, inherited == Inherited::Yes);
 }
 
 void StyleProperties::set_property(CSS::PropertyID id, NonnullRefPtr<CSSStyleValue const> value, Inherited inherited, Important important)
 {
-    m_data->m_property_values[to_underlying(id)] = move(value);
+    if (value_slot(id).ptr() != value.ptr())
+        mutable_value_slot(id) = move(value);
     set_property_important(id, important);
     set_property_inherited(id, inherited);
 }
 
 void StyleProperties::revert_property(CSS::PropertyID id, StyleProperties const& style_for_revert)
 {
-    m_data->m_property_values[to_underlying(id)] = style_for_revert.m_data->m_property_values[to_underlying(id)];
+    if (value_slot(id) != style_for_revert.value_slot(id))
+        mutable_value_slot(id) = style_for_revert.value_slot(id);
     set_property_important(id, style_for_revert.is_property_important(id) ? Important::Yes : Important::No);
     set_property_inherited(id, style_for_revert.is_property_inherited(id) ? Inherited::Yes : Inherited::No);
 }
@@ -122,14 +144,14 @@ NonnullRefPtr<CSSStyleValue const> StyleProperties::property(CSS::PropertyID pro
     }
 
     // By the time we call this method, all properties have values assigned.
-    return *m_data->m_property_values[to_underlying(property_id)];
+    return *value_slot(property_id);
 }
 
 RefPtr<CSSStyleValue const> StyleProperties::maybe_null_property(CSS::PropertyID property_id) const
 {
     if (auto animated_value = m_data->m_animated_property_values.get(property_id).value_or(nullptr))
         return *animated_value;
-    return m_data->m_property_values[to_underlying(property_id)];
+    return value_slot(property_id);
 }
 
 CSS::Size StyleProperties::size_value(CSS::PropertyID id) const
@@ -629,12 +651,12 @@ Optional<CSS::Positioning> StyleProperties::position() const
 
 bool StyleProperties::operator==(StyleProperties const& other) const
 {
-    if (m_data->m_property_values.size() != other.m_data->m_property_values.size())
-        return false;
+    if (m_data.ptr() == other.m_data.ptr())
+        return true;
 
-    for (size_t i = 0; i < m_data->m_property_values.size(); ++i) {
-        auto const& my_style = m_data->m_property_values[i];
-        auto const& other_style = other.m_data->m_property_values[i];
+    for (size_t i = 0; i < number_of_properties; ++i) {
+        auto const& my_style = value_slot((CSS::PropertyID)i);
+        auto const& other_style = other.value_slot((CSS::PropertyID)i);
         if (!my_style) {
             if (other_style)
                 return false;
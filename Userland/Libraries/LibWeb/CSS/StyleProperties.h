@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/CopyOnWrite.h>
+#include <AK/HashFunctions.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
 #include <LibGfx/Font/Font.h>
@@ -24,6 +26,46 @@ public:
     static constexpr size_t number_of_properties = to_underlying(CSS::last_property_id) + 1;
 
 private:
+    static constexpr size_t number_of_inherited_longhands = to_underlying(CSS::last_inherited_longhand_property_id) - to_underlying(CSS::first_inherited_longhand_property_id) + 1;
+
+    // The values of a group of properties. Groups are compared by the identity of their values, so that StyleProperties
+    // with the same values can share them (see StyleComputer::share_property_values()).
+    template<size_t property_count>
+    struct PropertyValues : public RefCounted<PropertyValues<property_count>> {
+        NonnullRefPtr<PropertyValues> clone() const
+        {
+            auto clone = adopt_ref(*new PropertyValues);
+            clone->values = values;
+            clone->important = important;
+            clone->inherited = inherited;
+            return clone;
+        }
+
+        bool operator==(PropertyValues const& other) const
+        {
+            return values == other.values && important == other.important && inherited == other.inherited;
+        }
+
+        unsigned hash() const
+        {
+            unsigned hash = 0;
+            for (auto const& value : values)
+                hash = pair_int_hash(hash, ptr_hash(value.ptr()));
+            for (size_t i = 0; i < important.size(); ++i)
+                hash = pair_int_hash(hash, (important[i] << 8) | inherited[i]);
+            return hash;
+        }
+
+        Array<RefPtr<CSSStyleValue const>, property_count> values;
+        Array<u8, ceil_div(property_count, 8uz)> important {};
+        Array<u8, ceil_div(property_count, 8uz)> inherited {};
+    };
+
+    // Inherited longhands are kept apart from all other properties, as they are usually the same for an element and
+    // its children, whereas the others tend to be the same for elements matched by the same rules.
+    using InheritedPropertyValues = PropertyValues<number_of_inherited_longhands>;
+    using OtherPropertyValues = PropertyValues<number_of_properties - number_of_inherited_longhands>;
+
     struct Data : public RefCounted<Data> {
         friend class StyleComputer;
 
@@ -33,9 +75,8 @@ private:
         JS::GCPtr<CSS::CSSStyleDeclaration const> m_animation_name_source;
         JS::GCPtr<CSS::CSSStyleDeclaration const> m_transition_property_source;
 
-        Array<RefPtr<CSSStyleValue const>, number_of_properties> m_property_values;
-        Array<u8, ceil_div(number_of_properties, 8uz)> m_property_important {};
-        Array<u8, ceil_div(number_of_properties, 8uz)> m_property_inherited {};
+        AK::CopyOnWrite<InheritedPropertyValues> m_inherited_property_values;
+        AK::CopyOnWrite<OtherPropertyValues> m_other_property_values;
 
         HashMap<CSS::PropertyID, NonnullRefPtr<CSSStyleValue const>> m_animated_property_values;
 
@@ -54,9 +95,9 @@ public:
     template<typename Callback>
     inline void for_each_property(Callback callback) const
     {
-        for (size_t i = 0; i < m_data->m_property_values.size(); ++i) {
-            if (m_data->m_property_values[i])
-                callback((CSS::PropertyID)i, *m_data->m_property_values[i]);
+        for (size_t i = 0; i < number_of_properties; ++i) {
+            if (auto const& value = value_slot((CSS::PropertyID)i))
+                callback((CSS::PropertyID)i, *value);
         }
     }
 
@@ -220,6 +261,34 @@ public:
 private:
     friend class StyleComputer;
 
+    static bool is_inherited_longhand(CSS::PropertyID property_id) { return property_id >= CSS::first_inherited_longhand_property_id && property_id <= CSS::last_inherited_longhand_property_id; }
+
+    // The index of a property within the group of property values that it belongs to.
+    static size_t index_in_property_values(CSS::PropertyID property_id)
+    {
+        auto index = to_underlying(property_id);
+        if (property_id < CSS::first_inherited_longhand_property_id)
+            return index;
+        if (is_inherited_longhand(property_id))
+            return index - to_underlying(CSS::first_inherited_longhand_property_id);
+        return index - number_of_inherited_longhands;
+    }
+
+    RefPtr<CSSStyleValue const> const& value_slot(CSS::PropertyID property_id) const
+    {
+        if (is_inherited_longhand(property_id))
+            return m_data->m_inherited_property_values->values[index_in_property_values(property_id)];
+        return m_data->m_other_property_values->values[index_in_property_values(property_id)];
+    }
+
+    // NOTE: This unshares the property values that the slot belongs to, so only use it to actually change the value.
+    RefPtr<CSSStyleValue const>& mutable_value_slot(CSS::PropertyID property_id)
+    {
+        if (is_inherited_longhand(property_id))
+            return m_data->m_inherited_property_values->values[index_in_property_values(property_id)];
+        return m_data->m_other_property_values->values[index_in_property_values(property_id)];
+    }
+
     Optional<CSS::Overflow> overflow(CSS::PropertyID) const;
     Vector<CSS::ShadowData> shadow(CSS::PropertyID, Layout::Node const&) const;
 
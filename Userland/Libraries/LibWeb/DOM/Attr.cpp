@@ -10,9 +10,6 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
-#include <LibWeb/DOM/MutationType.h>
-#include <LibWeb/DOM/StaticNodeList.h>
-#include <LibWeb/HTML/CustomElements/CustomElementReactionNames.h>
 
 namespace Web::DOM {
 
@@ -42,6 +39,21 @@ Attr::Attr(Document& document, QualifiedName qualified_name, String value, Eleme
 {
 }
 
+Attribute::Attribute(QualifiedName qualified_name, String value)
+    : m_qualified_name(move(qualified_name))
+    , m_lowercase_name(MUST(String(m_qualified_name.as_string()).to_lowercase()))
+    , m_value(move(value))
+{
+}
+
+Attribute::Attribute(Attr& attr)
+    : m_qualified_name(attr.qualified_name())
+    , m_lowercase_name(attr.lowercase_name())
+    , m_value(attr.value())
+    , m_node(attr)
+{
+}
+
 void Attr::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
@@ -78,44 +90,8 @@ void Attr::set_value(String value)
     }
     // 2. Otherwise, change attribute to value.
     else {
-        change_attribute(move(value));
+        owner_element()->change_attribute(*this, move(value));
     }
 }
 
-// https://dom.spec.whatwg.org/#concept-element-attributes-change
-void Attr::change_attribute(String value)
-{
-    // 1. Let oldValue be attribute’s value.
-    auto old_value = move(m_value);
-
-    // 2. Set attribute’s value to value.
-    m_value = move(value);
-
-    // 3. Handle attribute changes for attribute with attribute’s element, oldValue, and value.
-    handle_attribute_changes(*owner_element(), old_value, m_value);
-}
-
-// https://dom.spec.whatwg.org/#handle-attribute-changes
-void Attr::handle_attribute_changes(Element& element, Optional<String> const& old_value, Optional<String> const& new_value)
-{
-    // 1. Queue a mutation record of "attributes" for element with attribute’s local name, attribute’s namespace, oldValue, « », « », null, and null.
-    element.queue_mutation_record(MutationType::attributes, local_name(), namespace_uri(), old_value, {}, {}, nullptr, nullptr);
-
-    // 2. If element is custom, then enqueue a custom element callback reaction with element, callback name "attributeChangedCallback", and an argument list containing attribute’s local name, oldValue, newValue, and attribute’s namespace.
-    if (element.is_custom()) {
-        auto& vm = this->vm();
-
-        JS::MarkedVector<JS::Value> arguments { vm.heap() };
-        arguments.append(JS::PrimitiveString::create(vm, local_name()));
-        arguments.append(!old_value.has_value() ? JS::js_null() : JS::PrimitiveString::create(vm, old_value.value()));
-        arguments.append(!new_value.has_value() ? JS::js_null() : JS::PrimitiveString::create(vm, new_value.value()));
-        arguments.append(!namespace_uri().has_value() ? JS::js_null() : JS::PrimitiveString::create(vm, namespace_uri().value()));
-
-        element.enqueue_a_custom_element_callback_reaction(HTML::CustomElementReactionNames::attributeChangedCallback, move(arguments));
-    }
-
-    // 3. Run the attribute change steps with element, attribute’s local name, oldValue, newValue, and attribute’s namespace.
-    element.run_attribute_change_steps(local_name(), old_value, new_value, namespace_uri());
-}
-
 }
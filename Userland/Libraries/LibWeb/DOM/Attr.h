@@ -26,6 +26,7 @@ public:
 
     virtual FlyString node_name() const override { return name(); }
 
+    QualifiedName const& qualified_name() const { return m_qualified_name; }
     Optional<FlyString> const& namespace_uri() const { return m_qualified_name.namespace_(); }
     Optional<FlyString> const& prefix() const { return m_qualified_name.prefix(); }
     FlyString const& local_name() const { return m_qualified_name.local_name(); }
@@ -34,7 +35,9 @@ public:
 
     String const& value() const { return m_value; }
     void set_value(String value);
-    void change_attribute(String value);
+
+    // NOTE: While an attribute is in an element's attribute list, the element keeps the value of its Attr node in sync.
+    void set_value_from_owner_element(Badge<Element>, String value) { m_value = move(value); }
 
     Element* owner_element();
     Element const* owner_element() const;
@@ -43,8 +46,6 @@ public:
     // Always returns true: https://dom.spec.whatwg.org/#dom-attr-specified
     constexpr bool specified() const { return true; }
 
-    void handle_attribute_changes(Element&, Optional<String> const& old_value, Optional<String> const& new_value);
-
 private:
     Attr(Document&, QualifiedName, String value, Element*);
 
@@ -60,4 +61,32 @@ private:
 template<>
 inline bool Node::fast_is<Attr>() const { return is_attribute(); }
 
+// An attribute in an element's attribute list. Elements store their attributes like this, and only create an Attr node
+// for one once script asks for it, so that the attributes of elements nobody looks at from JS don't cost a GC cell each.
+class Attribute {
+public:
+    Attribute(QualifiedName, String value);
+    explicit Attribute(Attr&);
+
+    QualifiedName const& qualified_name() const { return m_qualified_name; }
+    Optional<FlyString> const& namespace_uri() const { return m_qualified_name.namespace_(); }
+    Optional<FlyString> const& prefix() const { return m_qualified_name.prefix(); }
+    FlyString const& local_name() const { return m_qualified_name.local_name(); }
+    FlyString const& name() const { return m_qualified_name.as_string(); }
+    FlyString const& lowercase_name() const { return m_lowercase_name; }
+
+    String const& value() const { return m_value; }
+
+    // The Attr node representing this attribute, if one has been created.
+    JS::GCPtr<Attr> node() const { return m_node; }
+
+private:
+    friend class Element;
+
+    QualifiedName m_qualified_name;
+    FlyString m_lowercase_name;
+    String m_value;
+    mutable JS::GCPtr<Attr> m_node;
+};
+
 }
@@ -6,6 +6,7 @@
 
 #include <LibUnicode/Segmenter.h>
 #include <LibWeb/Bindings/CharacterDataPrototype.h>
+#include <LibWeb/CSS/StyleProperties.h>
 #include <LibWeb/DOM/CharacterData.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/MutationType.h>
@@ -63,6 +64,26 @@ WebIDL::ExceptionOr<String> CharacterData::substring_data(size_t offset, size_t
     return MUST(utf16_view.substring_view(offset, count).to_utf8(Utf16View::AllowInvalidCodeUnits::Yes));
 }
 
+bool CharacterData::data_may_affect_layout() const
+{
+    // Comments and processing instructions are never rendered.
+    if (!is_text() && !is_cdata_section())
+        return false;
+
+    // Neither is text inside an element that doesn't generate a box, such as one with `display: none` or inside <head>.
+    // NOTE: If the layout tree is going to be rebuilt anyway, the layout nodes of the ancestors may not exist yet.
+    if (!document().layout_node())
+        return true;
+    for (auto const* ancestor = parent_element(); ancestor; ancestor = ancestor->parent_element()) {
+        if (ancestor->layout_node())
+            return true;
+        auto const* style = ancestor->computed_css_values();
+        if (!style || !style->display().is_contents())
+            return false;
+    }
+    return true;
+}
+
 // https://dom.spec.whatwg.org/#concept-cd-replace
 WebIDL::ExceptionOr<void> CharacterData::replace_data(size_t offset, size_t count, String const& data)
 {
@@ -90,7 +111,9 @@ WebIDL::ExceptionOr<void> CharacterData::replace_data(size_t offset, size_t coun
     builder.append(MUST(utf16_view.substring_view(0, offset).to_utf8(Utf16View::AllowInvalidCodeUnits::Yes)));
     builder.append(data);
     builder.append(MUST(utf16_view.substring_view(offset + count).to_utf8(Utf16View::AllowInvalidCodeUnits::Yes)));
-    m_data = MUST(builder.to_string());
+    auto new_data = MUST(builder.to_string());
+    bool data_did_change = new_data != m_data;
+    m_data = move(new_data);
 
     // 8. For each live range whose start node is node and start offset is greater than offset but less than or equal to offset plus count, set its start offset to offset.
     for (auto& range : Range::live_ranges()) {
@@ -120,13 +143,16 @@ WebIDL::ExceptionOr<void> CharacterData::replace_data(size_t offset, size_t coun
     if (parent())
         parent()->children_changed();
 
-    // NOTE: Since the text node's data has changed, we need to invalidate the text for rendering.
-    //       This ensures that the new text is reflected in layout, even if we don't end up
-    //       doing a full layout tree rebuild.
-    if (auto* layout_node = this->layout_node(); layout_node && layout_node->is_text_node())
-        static_cast<Layout::TextNode&>(*layout_node).invalidate_text_for_rendering();
+    // OPTIMIZATION: Only relayout if the data actually changed, and could be visible in the layout tree.
+    if (data_did_change && data_may_affect_layout()) {
+        // NOTE: Since the text node's data has changed, we need to invalidate the text for rendering.
+        //       This ensures that the new text is reflected in layout, even if we don't end up
+        //       doing a full layout tree rebuild.
+        if (auto* layout_node = this->layout_node(); layout_node && layout_node->is_text_node())
+            static_cast<Layout::TextNode&>(*layout_node).invalidate_text_for_rendering();
 
-    document().set_needs_layout();
+        document().set_needs_layout();
+    }
 
     if (m_grapheme_segmenter)
         m_grapheme_segmenter->set_segmented_text(m_data);
@@ -49,6 +49,8 @@ protected:
     virtual void initialize(JS::Realm&) override;
 
 private:
+    [[nodiscard]] bool data_may_affect_layout() const;
+
     String m_data;
 
     mutable OwnPtr<Unicode::Segmenter> m_grapheme_segmenter;
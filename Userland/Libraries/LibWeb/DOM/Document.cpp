@@ -8,10 +8,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/GenericLexer.h>
 #include <AK/InsertionSort.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 #include <LibCore/Timer.h>
@@ -33,6 +35,7 @@
 #include <LibWeb/CSS/FontFaceSet.h>
 #include <LibWeb/CSS/MediaQueryList.h>
 #include <LibWeb/CSS/MediaQueryListEvent.h>
+#include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CSS/StyleSheetIdentifier.h>
 #include <LibWeb/CSS/SystemColor.h>
@@ -65,6 +68,7 @@
 #include <LibWeb/Dump.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
 #include <LibWeb/FileAPI/BlobURLStore.h>
+#include <LibWeb/Geometry/DOMRect.h>
 #include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/CustomElements/CustomElementDefinition.h>
@@ -458,6 +462,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_page);
     visitor.visit(m_window);
     visitor.visit(m_layout_root);
+    visitor.visit(m_elements_with_invalidated_layout_contents);
     visitor.visit(m_style_sheets);
     visitor.visit(m_hovered_node);
     visitor.visit(m_inspected_node);
@@ -509,6 +514,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
         visitor.visit(form_associated_element->form_associated_element_to_html_element());
 
     visitor.visit(m_potentially_named_elements);
+    m_element_by_id_map.visit_edges(visitor);
 
     for (auto& event : m_pending_animation_event_queue) {
         visitor.visit(event.event);
@@ -976,6 +982,7 @@ void Document::tear_down_layout_tree()
 {
     m_layout_root = nullptr;
     m_paintable = nullptr;
+    m_elements_with_invalidated_layout_contents.clear();
 }
 
 Color Document::background_color() const
@@ -1088,6 +1095,52 @@ void Document::invalidate_layout_tree()
     schedule_layout_update();
 }
 
+void Document::invalidate_layout_tree_for_subtree_of(Node& node)
+{
+    if (!m_layout_root) {
+        invalidate_layout_tree();
+        return;
+    }
+
+    for (auto* ancestor = &node; ancestor; ancestor = ancestor->parent_or_shadow_host()) {
+        if (!is<Element>(*ancestor))
+            continue;
+        auto& element = static_cast<Element&>(*ancestor);
+        if (!Layout::TreeBuilder::can_rebuild_contents_of(element))
+            continue;
+        if (!any_of(m_elements_with_invalidated_layout_contents, [&](auto& other) { return other.ptr() == &element; }))
+            m_elements_with_invalidated_layout_contents.append(element);
+        set_needs_layout();
+        return;
+    }
+
+    invalidate_layout_tree();
+}
+
+void Document::rebuild_invalidated_layout_subtrees()
+{
+    auto elements = move(m_elements_with_invalidated_layout_contents);
+    for (auto& element : elements) {
+        // Elements that were removed since have had their old parent invalidated instead.
+        if (!element->is_connected() || &element->document() != this)
+            continue;
+        // The contents of elements inside another invalidated element get rebuilt along with it.
+        if (any_of(elements, [&](auto& other) { return other->is_shadow_including_ancestor_of(*element); }))
+            continue;
+
+        Layout::TreeBuilder tree_builder;
+        if (!tree_builder.rebuild_contents_of(*element)) {
+            tear_down_layout_tree();
+            return;
+        }
+        ++m_rendering_statistics.layout_subtree_rebuilds;
+        element->layout_node()->for_each_in_subtree([&](auto&) {
+            ++m_rendering_statistics.layout_nodes_built;
+            return TraversalDecision::Continue;
+        });
+    }
+}
+
 static void propagate_scrollbar_width_to_viewport(Element& root_element, Layout::Viewport& viewport)
 {
     // https://drafts.csswg.org/css-scrollbars/#scrollbar-width
@@ -1151,12 +1204,28 @@ void Document::update_layout()
 
     invalidate_display_list();
 
+    auto layout_start_time = MonotonicTime::now();
+    auto cells_allocated_before_layout = heap().total_allocated_cells();
+    ScopeGuard record_layout_update_time = [&] {
+        m_rendering_statistics.time_spent_updating_layout += MonotonicTime::now() - layout_start_time;
+        m_rendering_statistics.cells_allocated_updating_layout += heap().total_allocated_cells() - cells_allocated_before_layout;
+    };
+    ++m_rendering_statistics.layout_updates;
+
     auto* document_element = this->document_element();
     auto viewport_rect = navigable->viewport_rect();
 
+    if (m_layout_root && !m_elements_with_invalidated_layout_contents.is_empty())
+        rebuild_invalidated_layout_subtrees();
+
     if (!m_layout_root) {
         Layout::TreeBuilder tree_builder;
         m_layout_root = verify_cast<Layout::Viewport>(*tree_builder.build(*this));
+        ++m_rendering_statistics.layout_tree_builds;
+        m_layout_root->for_each_in_inclusive_subtree([&](auto&) {
+            ++m_rendering_statistics.layout_nodes_built;
+            return TraversalDecision::Continue;
+        });
 
         if (document_element && document_element->layout_node()) {
             propagate_overflow_to_viewport(*document_element, *m_layout_root);
@@ -1303,6 +1372,14 @@ void Document::update_style()
     if (m_created_for_appropriate_template_contents)
         return;
 
+    auto style_start_time = MonotonicTime::now();
+    auto cells_allocated_before_style_update = heap().total_allocated_cells();
+    ScopeGuard record_style_update_time = [&] {
+        m_rendering_statistics.time_spent_updating_style += MonotonicTime::now() - style_start_time;
+        m_rendering_statistics.cells_allocated_updating_style += heap().total_allocated_cells() - cells_allocated_before_style_update;
+    };
+    ++m_rendering_statistics.style_updates;
+
     // Fetch the viewport rect once, instead of repeatedly, during style computation.
     style_computer().set_viewport_rect({}, viewport_rect());
 
@@ -1902,6 +1979,10 @@ void Document::adopt_node(Node& node)
             // 1. Set inclusiveDescendant’s node document to document.
             inclusive_descendant.set_document({}, *this);
 
+            // NOTE: Observers registered on nodes of oldDocument keep observing them in this document.
+            if (inclusive_descendant.registered_observer_list())
+                set_may_have_mutation_observers();
+
             // FIXME: 2. If inclusiveDescendant is an element, then set the node document of each attribute in inclusiveDescendant’s
             //           attribute list to document.
             return TraversalDecision::Continue;
@@ -2993,6 +3074,25 @@ void Document::invalidate_stacking_context_tree()
         paintable_box->invalidate_stacking_context();
 }
 
+Vector<JS::NonnullGCPtr<Element>> Document::elements_with_content_visibility_auto()
+{
+    Vector<JS::NonnullGCPtr<Element>> elements;
+    if (!m_layout_root)
+        return elements;
+    m_layout_root->for_each_in_inclusive_subtree([&](auto& layout_node) {
+        auto* dom_node = layout_node.dom_node();
+        if (!dom_node || !dom_node->is_element())
+            return TraversalDecision::Continue;
+        auto& element = static_cast<Element&>(*dom_node);
+        if (element.layout_node() != &layout_node || !element.computed_css_values())
+            return TraversalDecision::Continue;
+        if (element.computed_css_values()->content_visibility() == CSS::ContentVisibility::Auto)
+            elements.append(element);
+        return TraversalDecision::Continue;
+    });
+    return elements;
+}
+
 void Document::check_favicon_after_loading_link_resource()
 {
     // https://html.spec.whatwg.org/multipage/links.html#rel-icon
@@ -3913,10 +4013,11 @@ void Document::queue_an_intersection_observer_entry(IntersectionObserver::Inters
 }
 
 // https://www.w3.org/TR/intersection-observer/#compute-the-intersection
-static JS::NonnullGCPtr<Geometry::DOMRectReadOnly> compute_intersection(JS::NonnullGCPtr<Element> target, IntersectionObserver::IntersectionObserver const& observer)
+static CSSPixelRect compute_intersection(CSSPixelRect target_bounding_box, CSSPixelRect root_intersection_rectangle)
 {
     // 1. Let intersectionRect be the result of getting the bounding box for target.
-    auto intersection_rect = target->get_bounding_client_rect();
+    // NOTE: The caller already has target's bounding box, so it is passed in rather than computed again.
+    auto intersection_rect = target_bounding_box;
 
     // FIXME: 2. Let container be the containing block of target.
     // FIXME: 3. While container is not root:
@@ -3931,13 +4032,7 @@ static JS::NonnullGCPtr<Geometry::DOMRectReadOnly> compute_intersection(JS::Nonn
 
     // 5. Update intersectionRect by intersecting it with the root intersection rectangle.
     // FIXME: Pass in target so we can properly apply rootMargin.
-    auto root_intersection_rectangle = observer.root_intersection_rectangle();
-    CSSPixelRect intersection_rect_as_pixel_rect(intersection_rect->x(), intersection_rect->y(), intersection_rect->width(), intersection_rect->height());
-    intersection_rect_as_pixel_rect.intersect(root_intersection_rectangle);
-    intersection_rect->set_x(static_cast<double>(intersection_rect_as_pixel_rect.x()));
-    intersection_rect->set_y(static_cast<double>(intersection_rect_as_pixel_rect.y()));
-    intersection_rect->set_width(static_cast<double>(intersection_rect_as_pixel_rect.width()));
-    intersection_rect->set_height(static_cast<double>(intersection_rect_as_pixel_rect.height()));
+    intersection_rect.intersect(root_intersection_rectangle);
 
     // FIXME: 6. Map intersectionRect to the coordinate space of the viewport of the document containing target.
 
@@ -3950,6 +4045,14 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
 {
     auto& realm = this->realm();
 
+    // NOTE: A target may be observed by several observers (e.g. a lazy loading image that a page also observes), but its
+    //       bounding box is the same for all of them during this update. Compute it once per target, and only create
+    //       DOMRects for the entries that actually get queued; most targets don't change state on any given frame.
+    HashMap<Element const*, CSSPixelRect> target_bounding_boxes;
+    auto bounding_box_for_target = [&](Element const& target) {
+        return target_bounding_boxes.ensure(&target, [&] { return target.bounding_client_rect(); });
+    };
+
     // 1. Let observer list be a list of all IntersectionObservers whose root is in the DOM tree of document.
     //    For the top-level browsing context, this includes implicit root observers.
     // 2. For each observer in observer list:
@@ -3968,10 +4071,10 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
             bool is_intersecting = false;
 
             // targetRect be a DOMRectReadOnly with x, y, width, and height set to 0.
-            auto target_rect = Geometry::DOMRectReadOnly::construct_impl(realm, 0, 0, 0, 0).release_value_but_fixme_should_propagate_errors();
+            CSSPixelRect target_rect;
 
             // intersectionRect be a DOMRectReadOnly with x, y, width, and height set to 0.
-            auto intersection_rect = Geometry::DOMRectReadOnly::construct_impl(realm, 0, 0, 0, 0).release_value_but_fixme_should_propagate_errors();
+            CSSPixelRect intersection_rect;
 
             // SPEC ISSUE: It doesn't pass in intersection ratio to "queue an IntersectionObserverEntry" despite needing it.
             //             This is default 0, as isIntersecting is default false, see step 9.
@@ -3987,22 +4090,21 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
             if (!(observer->root().has<Empty>() && &target->document() == intersection_root_document.ptr())
                 || !(intersection_root.has<JS::Handle<DOM::Element>>() && !target->is_descendant_of(*intersection_root.get<JS::Handle<DOM::Element>>()))) {
                 // 4. Set targetRect to the DOMRectReadOnly obtained by getting the bounding box for target.
-                target_rect = target->get_bounding_client_rect();
+                target_rect = bounding_box_for_target(*target);
 
                 // 5. Let intersectionRect be the result of running the compute the intersection algorithm on target and
                 //    observer’s intersection root.
-                intersection_rect = compute_intersection(target, observer);
+                intersection_rect = compute_intersection(target_rect, root_bounds);
 
                 // 6. Let targetArea be targetRect’s area.
-                auto target_area = target_rect->width() * target_rect->height();
+                auto target_area = target_rect.width().to_double() * target_rect.height().to_double();
 
                 // 7. Let intersectionArea be intersectionRect’s area.
-                auto intersection_area = intersection_rect->width() * intersection_rect->height();
+                auto intersection_area = intersection_rect.width().to_double() * intersection_rect.height().to_double();
 
                 // 8. Let isIntersecting be true if targetRect and rootBounds intersect or are edge-adjacent, even if the
                 //    intersection has zero area (because rootBounds or targetRect have zero area).
-                CSSPixelRect target_rect_as_pixel_rect(target_rect->x(), target_rect->y(), target_rect->width(), target_rect->height());
-                is_intersecting = target_rect_as_pixel_rect.intersects(root_bounds);
+                is_intersecting = target_rect.intersects(root_bounds);
 
                 // 9. If targetArea is non-zero, let intersectionRatio be intersectionArea divided by targetArea.
                 //    Otherwise, let intersectionRatio be 1 if isIntersecting is true, or 0 if isIntersecting is false.
@@ -4035,9 +4137,11 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
             //     rootBounds, targetRect, intersectionRect, isIntersecting, and target.
             if (threshold_index != previous_threshold_index || is_intersecting != previous_is_intersecting) {
                 auto root_bounds_as_dom_rect = Geometry::DOMRectReadOnly::construct_impl(realm, static_cast<double>(root_bounds.x()), static_cast<double>(root_bounds.y()), static_cast<double>(root_bounds.width()), static_cast<double>(root_bounds.height())).release_value_but_fixme_should_propagate_errors();
+                auto target_rect_as_dom_rect = Geometry::DOMRect::create(realm, target_rect.to_type<float>());
+                auto intersection_rect_as_dom_rect = Geometry::DOMRect::create(realm, intersection_rect.to_type<float>());
 
                 // SPEC ISSUE: It doesn't pass in intersectionRatio, but it's required.
-                queue_an_intersection_observer_entry(observer, time, root_bounds_as_dom_rect, target_rect, intersection_rect, is_intersecting, intersection_ratio, target);
+                queue_an_intersection_observer_entry(observer, time, root_bounds_as_dom_rect, target_rect_as_dom_rect, intersection_rect_as_dom_rect, is_intersecting, intersection_ratio, target);
             }
 
             // 15. Assign thresholdIndex to intersectionObserverRegistration’s previousThresholdIndex property.
@@ -4977,6 +5081,23 @@ JS::Value Document::named_item_value(FlyString const& name) const
     });
 }
 
+Optional<CSS::SelectorList> Document::parse_selector_for_dom_api(StringView selector_text)
+{
+    auto key = MUST(String::from_utf8(selector_text));
+    if (auto it = m_parsed_selectors_for_dom_api.find(key); it != m_parsed_selectors_for_dom_api.end()) {
+        auto selectors = move(it->value);
+        m_parsed_selectors_for_dom_api.remove(it);
+        m_parsed_selectors_for_dom_api.set(key, selectors);
+        return selectors;
+    }
+
+    auto selectors = parse_selector(CSS::Parser::ParsingContext(*this), selector_text);
+    if (m_parsed_selectors_for_dom_api.size() >= max_parsed_selectors_for_dom_api)
+        m_parsed_selectors_for_dom_api.remove(m_parsed_selectors_for_dom_api.begin());
+    m_parsed_selectors_for_dom_api.set(move(key), selectors);
+    return selectors;
+}
+
 // https://w3c.github.io/editing/docs/execCommand/#execcommand()
 bool Document::exec_command(String const& command, bool show_ui, String const& value)
 {
@@ -5551,15 +5672,17 @@ void Document::set_needs_display(InvalidateDisplayList should_invalidate_display
     set_needs_display(viewport_rect(), should_invalidate_display_list);
 }
 
-void Document::set_needs_display(CSSPixelRect const&, InvalidateDisplayList should_invalidate_display_list)
+void Document::set_needs_display(CSSPixelRect const& rect, InvalidateDisplayList should_invalidate_display_list)
 {
-    // FIXME: Ignore updates outside the visible viewport rect.
-    //        This requires accounting for fixed-position elements in the input rect, which we don't do yet.
-
     m_needs_repaint = true;
+    m_damaged_rect = m_damaged_rect.united(rect);
 
     if (should_invalidate_display_list == InvalidateDisplayList::Yes) {
-        invalidate_display_list();
+        // NOTE: We don't call invalidate_display_list() here, as that would damage the whole viewport.
+        m_cached_display_list.clear();
+    } else if (m_cached_display_list) {
+        // NOTE: The display list stays the same, but what it paints doesn't, so its rasterization can't be reused.
+        m_cached_display_list->set_rasterized_layer(nullptr);
     }
 
     auto navigable = this->navigable();
@@ -5576,10 +5699,39 @@ void Document::set_needs_display(CSSPixelRect const&, InvalidateDisplayList shou
     }
 }
 
+Document::ViewportDamage Document::take_viewport_damage()
+{
+    auto viewport_rect = this->viewport_rect();
+
+    ViewportDamage damage;
+    if (!m_viewport_position_at_last_damage_update.has_value()) {
+        m_damaged_rect = viewport_rect;
+    } else if (auto scroll_delta = viewport_rect.location() - *m_viewport_position_at_last_damage_update; !scroll_delta.is_zero()) {
+        // NOTE: Scrolling the viewport doesn't damage anything by itself, as long as everything the viewport paints moves
+        //       along with it. Its scrollbars don't, so we always paint those again.
+        if (paintable() && paintable()->contents_move_along_when_scrolled()) {
+            damage.scroll_delta = scroll_delta;
+            for (auto const& scrollbar_rect : paintable()->scrollbar_rects())
+                damage.damaged_rects.append(scrollbar_rect);
+        } else {
+            m_damaged_rect = viewport_rect;
+        }
+    }
+    m_viewport_position_at_last_damage_update = viewport_rect.location();
+
+    if (auto damaged_rect = m_damaged_rect.intersected(viewport_rect); !damaged_rect.is_empty())
+        damage.damaged_rects.append(damaged_rect.translated(-viewport_rect.location()));
+    m_damaged_rect = {};
+    return damage;
+}
+
 void Document::invalidate_display_list()
 {
     m_cached_display_list.clear();
 
+    // NOTE: We don't know what the new display list will paint differently, so the whole viewport has to be repainted.
+    m_damaged_rect = m_damaged_rect.united(viewport_rect());
+
     auto navigable = this->navigable();
     if (!navigable)
         return;
@@ -5594,6 +5746,14 @@ RefPtr<Painting::DisplayList> Document::record_display_list(PaintConfig config)
     if (m_cached_display_list && m_cached_display_list_paint_config == config)
         return m_cached_display_list;
 
+    auto recording_start_time = MonotonicTime::now();
+    auto cells_allocated_before_recording = heap().total_allocated_cells();
+    ScopeGuard record_display_list_recording_time = [&] {
+        m_rendering_statistics.time_spent_recording_display_lists += MonotonicTime::now() - recording_start_time;
+        m_rendering_statistics.cells_allocated_recording_display_lists += heap().total_allocated_cells() - cells_allocated_before_recording;
+    };
+    ++m_rendering_statistics.display_list_recordings;
+
     auto display_list = Painting::DisplayList::create();
     Painting::DisplayListRecorder display_list_recorder(display_list);
 
@@ -22,10 +22,12 @@
 #include <LibURL/URL.h>
 #include <LibUnicode/Forward.h>
 #include <LibWeb/CSS/CSSStyleSheet.h>
+#include <LibWeb/CSS/Selector.h>
 #include <LibWeb/CSS/StyleSheetList.h>
 #include <LibWeb/Cookie/Cookie.h>
 #include <LibWeb/DOM/NonElementParentNode.h>
 #include <LibWeb/DOM/ParentNode.h>
+#include <LibWeb/DOM/RenderingStatistics.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/CrossOrigin/OpenerPolicy.h>
 #include <LibWeb/HTML/DocumentReadyState.h>
@@ -107,11 +109,6 @@ public:
     static WebIDL::ExceptionOr<JS::NonnullGCPtr<Document>> construct_impl(JS::Realm&);
     virtual ~Document() override;
 
-    // AD-HOC: This number increments whenever a node is added or removed from the document, or an element attribute changes.
-    //         It can be used as a crude invalidation mechanism for caches that depend on the DOM structure.
-    u64 dom_tree_version() const { return m_dom_tree_version; }
-    void bump_dom_tree_version() { ++m_dom_tree_version; }
-
     WebIDL::ExceptionOr<void> populate_with_html_head_and_body();
 
     JS::GCPtr<Selection::Selection> get_selection() const;
@@ -159,6 +156,9 @@ public:
     CSS::StyleComputer& style_computer() { return *m_style_computer; }
     const CSS::StyleComputer& style_computer() const { return *m_style_computer; }
 
+    RenderingStatistics& rendering_statistics() { return m_rendering_statistics; }
+    RenderingStatistics const& rendering_statistics() const { return m_rendering_statistics; }
+
     CSS::StyleSheetList& style_sheets();
     CSS::StyleSheetList const& style_sheets() const;
 
@@ -245,8 +245,14 @@ public:
     void set_needs_layout();
 
     void invalidate_layout_tree();
+    // Only rebuilds the layout nodes for the contents of the nearest ancestor of the node that allows it,
+    // and falls back to rebuilding the whole layout tree if there is none.
+    void invalidate_layout_tree_for_subtree_of(Node&);
     void invalidate_stacking_context_tree();
 
+    // The elements in the layout tree whose used value of content-visibility is auto, in tree order.
+    Vector<JS::NonnullGCPtr<Element>> elements_with_content_visibility_auto();
+
     virtual bool is_child_allowed(Node const&) const override;
 
     Layout::Viewport const* layout_node() const;
@@ -484,6 +490,11 @@ public:
             callback(*node_iterator);
     }
 
+    // NOTE: This is set as soon as any node in this document gets a registered observer, and never cleared again.
+    //       While it's unset, DOM mutations can skip all the work of queueing mutation records nobody would receive.
+    bool may_have_mutation_observers() const { return m_may_have_mutation_observers; }
+    void set_may_have_mutation_observers() { m_may_have_mutation_observers = true; }
+
     bool needs_full_style_update() const { return m_needs_full_style_update; }
     void set_needs_full_style_update(bool b) { m_needs_full_style_update = b; }
 
@@ -664,6 +675,13 @@ public:
     virtual Vector<FlyString> supported_property_names() const override;
     Vector<JS::NonnullGCPtr<DOM::Element>> const& potentially_named_elements() const { return m_potentially_named_elements; }
 
+    ElementByIdMap* element_by_id_map() { return &m_element_by_id_map; }
+    ElementByIdMap const* element_by_id_map() const { return &m_element_by_id_map; }
+
+    // Parses a selector passed to one of the DOM APIs that take one, like querySelector(). Scripts tend to pass the
+    // same few selectors over and over, so we hold on to the most recently used ones.
+    Optional<CSS::SelectorList> parse_selector_for_dom_api(StringView);
+
     void gather_active_observations_at_depth(size_t depth);
     [[nodiscard]] size_t broadcast_active_resize_observations();
     [[nodiscard]] bool has_active_resize_observations();
@@ -714,8 +732,18 @@ public:
 
     [[nodiscard]] bool needs_repaint() const { return m_needs_repaint; }
     void set_needs_display(InvalidateDisplayList = InvalidateDisplayList::Yes);
+    // NOTE: The rect must cover everything that looks different now, in the coordinate space of the initial containing block.
     void set_needs_display(CSSPixelRect const&, InvalidateDisplayList = InvalidateDisplayList::Yes);
 
+    struct ViewportDamage {
+        // How far the viewport was scrolled since the last call, if everything it paints moved along by that much.
+        CSSPixelPoint scroll_delta;
+        // The parts of the viewport that have to be painted again, relative to the viewport.
+        Vector<CSSPixelRect, 3> damaged_rects;
+    };
+    // Returns how the viewport changed since the last call.
+    ViewportDamage take_viewport_damage();
+
     struct PaintConfig {
         bool paint_overlay { false };
         bool should_show_line_box_borders { false };
@@ -754,6 +782,7 @@ private:
     virtual JS::GCPtr<EventTarget> global_event_handlers_to_event_target(FlyString const&) final { return *this; }
 
     void tear_down_layout_tree();
+    void rebuild_invalidated_layout_subtrees();
 
     void update_active_element();
 
@@ -774,6 +803,7 @@ private:
 
     JS::NonnullGCPtr<Page> m_page;
     OwnPtr<CSS::StyleComputer> m_style_computer;
+    RenderingStatistics m_rendering_statistics;
     JS::GCPtr<CSS::StyleSheetList> m_style_sheets;
     JS::GCPtr<Node> m_hovered_node;
     JS::GCPtr<Node> m_inspected_node;
@@ -785,6 +815,7 @@ private:
     JS::GCPtr<HTML::Window> m_window;
 
     JS::GCPtr<Layout::Viewport> m_layout_root;
+    Vector<JS::NonnullGCPtr<Element>> m_elements_with_invalidated_layout_contents;
 
     Optional<Color> m_normal_link_color;
     Optional<Color> m_active_link_color;
@@ -874,6 +905,8 @@ private:
 
     HashTable<JS::GCPtr<NodeIterator>> m_node_iterators;
 
+    bool m_may_have_mutation_observers { false };
+
     HashTable<JS::NonnullGCPtr<DocumentObserver>> m_document_observers;
 
     // https://html.spec.whatwg.org/multipage/dom.html#is-initial-about:blank
@@ -984,6 +1017,12 @@ private:
 
     Vector<JS::NonnullGCPtr<DOM::Element>> m_potentially_named_elements;
 
+    ElementByIdMap m_element_by_id_map;
+
+    static constexpr size_t max_parsed_selectors_for_dom_api = 64;
+    // NOTE: Ordered from least to most recently used. Selectors that failed to parse are cached as empty.
+    OrderedHashMap<String, Optional<CSS::SelectorList>> m_parsed_selectors_for_dom_api;
+
     bool m_design_mode_enabled { false };
 
     bool m_needs_to_resolve_paint_only_properties { true };
@@ -994,8 +1033,6 @@ private:
 
     Optional<Core::DateTime> m_last_modified;
 
-    u64 m_dom_tree_version { 0 };
-
     // https://drafts.csswg.org/css-position-4/#document-top-layer
     // Documents have a top layer, an ordered set containing elements from the document.
     // Elements in the top layer do not lay out normally based on their position in the document;
@@ -1019,6 +1056,8 @@ private:
     WeakPtr<HTML::Navigable> m_cached_navigable;
 
     bool m_needs_repaint { false };
+    CSSPixelRect m_damaged_rect;
+    Optional<CSSPixelPoint> m_viewport_position_at_last_damage_update;
 
     Optional<PaintConfig> m_cached_display_list_paint_config;
     RefPtr<Painting::DisplayList> m_cached_display_list;
@@ -27,6 +27,7 @@ void DocumentFragment::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_host);
+    m_element_by_id_map.visit_edges(visitor);
 }
 
 void DocumentFragment::set_host(Web::DOM::Element* element)
@@ -30,6 +30,10 @@ public:
 
     void set_host(Element*);
 
+    // NOTE: Only shadow roots keep track of the elements with an ID in them, other fragments are just searched.
+    ElementByIdMap* element_by_id_map() { return is_shadow_root() ? &m_element_by_id_map : nullptr; }
+    ElementByIdMap const* element_by_id_map() const { return is_shadow_root() ? &m_element_by_id_map : nullptr; }
+
 protected:
     explicit DocumentFragment(Document& document);
 
@@ -39,6 +43,8 @@ protected:
 private:
     // https://dom.spec.whatwg.org/#concept-documentfragment-host
     JS::GCPtr<Element> m_host;
+
+    ElementByIdMap m_element_by_id_map;
 };
 
 template<>
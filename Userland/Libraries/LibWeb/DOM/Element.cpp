@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/AnyOf.h>
 #include <AK/Debug.h>
 #include <AK/StringBuilder.h>
@@ -26,6 +27,7 @@
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/DOM/HTMLCollection.h>
+#include <LibWeb/DOM/MutationType.h>
 #include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/DOM/Text.h>
@@ -85,8 +87,6 @@ void Element::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
     WEB_SET_PROTOTYPE_FOR_INTERFACE(Element);
-
-    m_attributes = NamedNodeMap::create(*this);
 }
 
 void Element::visit_edges(Cell::Visitor& visitor)
@@ -95,6 +95,8 @@ void Element::visit_edges(Cell::Visitor& visitor)
     SlottableMixin::visit_edges(visitor);
     Animatable::visit_edges(visitor);
 
+    for (auto const& attribute : m_attribute_list)
+        visitor.visit(attribute.m_node);
     visitor.visit(m_attributes);
     visitor.visit(m_inline_style);
     visitor.visit(m_class_list);
@@ -115,7 +117,7 @@ void Element::visit_edges(Cell::Visitor& visitor)
 Optional<String> Element::get_attribute(FlyString const& name) const
 {
     // 1. Let attr be the result of getting an attribute given qualifiedName and this.
-    auto const* attribute = m_attributes->get_attribute(name);
+    auto const* attribute = find_attribute(name);
 
     // 2. If attr is null, return null.
     if (!attribute)
@@ -129,7 +131,7 @@ Optional<String> Element::get_attribute(FlyString const& name) const
 Optional<String> Element::get_attribute_ns(Optional<FlyString> const& namespace_, FlyString const& name) const
 {
     // 1. Let attr be the result of getting an attribute given namespace, localName, and this.
-    auto const* attribute = m_attributes->get_attribute_ns(namespace_, name);
+    auto const* attribute = find_attribute_ns(namespace_, name);
 
     // 2. If attr is null, return null.
     if (!attribute)
@@ -143,7 +145,7 @@ Optional<String> Element::get_attribute_ns(Optional<FlyString> const& namespace_
 String Element::get_attribute_value(FlyString const& local_name, Optional<FlyString> const& namespace_) const
 {
     // 1. Let attr be the result of getting an attribute given namespace, localName, and element.
-    auto const* attribute = m_attributes->get_attribute_ns(namespace_, local_name);
+    auto const* attribute = find_attribute_ns(namespace_, local_name);
 
     // 2. If attr is null, then return the empty string.
     if (!attribute)
@@ -157,14 +159,20 @@ String Element::get_attribute_value(FlyString const& local_name, Optional<FlyStr
 JS::GCPtr<Attr> Element::get_attribute_node(FlyString const& name) const
 {
     // The getAttributeNode(qualifiedName) method steps are to return the result of getting an attribute given qualifiedName and this.
-    return m_attributes->get_attribute(name);
+    size_t index = 0;
+    if (!find_attribute(name, &index))
+        return nullptr;
+    return attribute_node(index);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-getattributenodens
 JS::GCPtr<Attr> Element::get_attribute_node_ns(Optional<FlyString> const& namespace_, FlyString const& name) const
 {
     // The getAttributeNodeNS(namespace, localName) method steps are to return the result of getting an attribute given namespace, localName, and this.
-    return m_attributes->get_attribute_ns(namespace_, name);
+    size_t index = 0;
+    if (!find_attribute_ns(namespace_, name, &index))
+        return nullptr;
+    return attribute_node(index);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-setattribute
@@ -178,19 +186,18 @@ WebIDL::ExceptionOr<void> Element::set_attribute(FlyString const& name, String c
     bool insert_as_lowercase = namespace_uri() == Namespace::HTML && document().document_type() == Document::Type::HTML;
 
     // 3. Let attribute be the first attribute in this’s attribute list whose qualified name is qualifiedName, and null otherwise.
-    auto* attribute = m_attributes->get_attribute(name);
+    size_t index = 0;
+    auto const* attribute = find_attribute(name, &index);
 
     // 4. If attribute is null, create an attribute whose local name is qualifiedName, value is value, and node document
     //    is this’s node document, then append this attribute to this, and then return.
     if (!attribute) {
-        auto new_attribute = Attr::create(document(), insert_as_lowercase ? name.to_ascii_lowercase() : name, value);
-        m_attributes->append_attribute(new_attribute);
-
+        append_attribute(QualifiedName { insert_as_lowercase ? name.to_ascii_lowercase() : name, {}, {} }, value);
         return {};
     }
 
     // 5. Change attribute to value.
-    attribute->change_attribute(value);
+    change_attribute(index, value);
 
     return {};
 }
@@ -253,75 +260,283 @@ WebIDL::ExceptionOr<void> Element::set_attribute_ns(Optional<FlyString> const& n
 // https://dom.spec.whatwg.org/#concept-element-attributes-append
 void Element::append_attribute(FlyString const& name, String const& value)
 {
-    m_attributes->append_attribute(Attr::create(document(), name, value));
+    append_attribute(QualifiedName { name, {}, {} }, value);
+}
+
+// https://dom.spec.whatwg.org/#concept-element-attributes-append
+void Element::append_attribute(QualifiedName qualified_name, String value)
+{
+    // 1. Append attribute to element’s attribute list.
+    // 2. Set attribute’s element to element.
+    // NOTE: The attribute doesn't have an Attr node yet, so there's nothing to point at element.
+    m_attribute_list.empend(qualified_name, value);
+
+    // 3. Handle attribute changes for attribute with element, null, and attribute’s value.
+    handle_attribute_changes(qualified_name, {}, value);
 }
 
 // https://dom.spec.whatwg.org/#concept-element-attributes-append
 void Element::append_attribute(Attr& attribute)
 {
-    m_attributes->append_attribute(attribute);
+    // 1. Append attribute to element’s attribute list.
+    m_attribute_list.append(Attribute { attribute });
+
+    // 2. Set attribute’s element to element.
+    attribute.set_owner_element(this);
+
+    // 3. Handle attribute changes for attribute with element, null, and attribute’s value.
+    handle_attribute_changes(attribute.qualified_name(), {}, attribute.value());
+}
+
+// https://dom.spec.whatwg.org/#concept-element-attributes-change
+void Element::change_attribute(size_t index, String value)
+{
+    auto& attribute = m_attribute_list[index];
+
+    // 1. Let oldValue be attribute’s value.
+    auto old_value = move(attribute.m_value);
+
+    // 2. Set attribute’s value to value.
+    attribute.m_value = move(value);
+    if (attribute.m_node)
+        attribute.m_node->set_value_from_owner_element({}, attribute.m_value);
+
+    // 3. Handle attribute changes for attribute with attribute’s element, oldValue, and value.
+    // NOTE: The attribute change steps may change the attribute list, so we can't hold on to attribute while they run.
+    auto qualified_name = attribute.qualified_name();
+    auto new_value = attribute.m_value;
+    handle_attribute_changes(qualified_name, old_value, new_value);
+}
+
+void Element::change_attribute(Attr& attr, String value)
+{
+    VERIFY(attr.owner_element() == this);
+    auto index = m_attribute_list.find_first_index_if([&](auto const& attribute) { return attribute.m_node == &attr; });
+    change_attribute(index.value(), move(value));
+}
+
+// https://dom.spec.whatwg.org/#concept-element-attributes-replace
+void Element::replace_attribute(size_t old_attribute_index, Attr& new_attribute)
+{
+    // 1. Replace oldAttr by newAttr in oldAttr’s element’s attribute list.
+    auto old_attribute = exchange(m_attribute_list[old_attribute_index], Attribute { new_attribute });
+
+    // 2. Set newAttr’s element to oldAttr’s element.
+    new_attribute.set_owner_element(this);
+
+    // 3. Set oldAttr’s element to null.
+    if (old_attribute.m_node)
+        old_attribute.m_node->set_owner_element(nullptr);
+
+    // 4. Handle attribute changes for oldAttr with newAttr’s element, oldAttr’s value, and newAttr’s value.
+    handle_attribute_changes(old_attribute.qualified_name(), old_attribute.value(), new_attribute.value());
+}
+
+// https://dom.spec.whatwg.org/#concept-element-attributes-remove
+void Element::remove_attribute_at_index(size_t index)
+{
+    // 1. Let element be attribute’s element.
+    // 2. Remove attribute from element’s attribute list.
+    auto attribute = m_attribute_list.take(index);
+
+    // 3. Set attribute’s element to null.
+    if (attribute.m_node)
+        attribute.m_node->set_owner_element(nullptr);
+
+    // 4. Handle attribute changes for attribute with element, attribute’s value, and null.
+    handle_attribute_changes(attribute.qualified_name(), attribute.value(), {});
+}
+
+// https://dom.spec.whatwg.org/#handle-attribute-changes
+void Element::handle_attribute_changes(QualifiedName const& qualified_name, Optional<String> const& old_value, Optional<String> const& new_value)
+{
+    auto const& local_name = qualified_name.local_name();
+    auto const& namespace_ = qualified_name.namespace_();
+
+    // 1. Queue a mutation record of "attributes" for element with attribute’s local name, attribute’s namespace, oldValue, « », « », null, and null.
+    queue_mutation_record(MutationType::attributes, local_name, namespace_, old_value, {}, {}, nullptr, nullptr);
+
+    // 2. If element is custom, then enqueue a custom element callback reaction with element, callback name "attributeChangedCallback", and an argument list containing attribute’s local name, oldValue, newValue, and attribute’s namespace.
+    if (is_custom()) {
+        auto& vm = this->vm();
+
+        JS::MarkedVector<JS::Value> arguments { vm.heap() };
+        arguments.append(JS::PrimitiveString::create(vm, local_name));
+        arguments.append(!old_value.has_value() ? JS::js_null() : JS::PrimitiveString::create(vm, old_value.value()));
+        arguments.append(!new_value.has_value() ? JS::js_null() : JS::PrimitiveString::create(vm, new_value.value()));
+        arguments.append(!namespace_.has_value() ? JS::js_null() : JS::PrimitiveString::create(vm, namespace_.value()));
+
+        enqueue_a_custom_element_callback_reaction(HTML::CustomElementReactionNames::attributeChangedCallback, move(arguments));
+    }
+
+    // 3. Run the attribute change steps with element, attribute’s local name, oldValue, newValue, and attribute’s namespace.
+    run_attribute_change_steps(local_name, old_value, new_value, namespace_);
+}
+
+// https://dom.spec.whatwg.org/#concept-element-attributes-get-by-name
+Attribute const* Element::find_attribute(FlyString const& qualified_name, size_t* index) const
+{
+    // 1. If element is in the HTML namespace and its node document is an HTML document, then set qualifiedName to qualifiedName in ASCII lowercase.
+    // FIXME: Handle the second condition, assume it is an HTML document for now.
+    bool compare_as_lowercase = namespace_uri() == Namespace::HTML;
+
+    // 2. Return the first attribute in element’s attribute list whose qualified name is qualifiedName; otherwise null.
+    for (size_t i = 0; i < m_attribute_list.size(); ++i) {
+        auto const& attribute = m_attribute_list[i];
+        if (compare_as_lowercase ? attribute.name().equals_ignoring_ascii_case(qualified_name) : attribute.name() == qualified_name) {
+            if (index)
+                *index = i;
+            return &attribute;
+        }
+    }
+
+    return nullptr;
+}
+
+Attribute const* Element::find_attribute_with_lowercase_qualified_name(FlyString const& lowercase_qualified_name) const
+{
+    VERIFY(namespace_uri() == Namespace::HTML);
+
+    for (auto const& attribute : m_attribute_list) {
+        if (attribute.lowercase_name() == lowercase_qualified_name)
+            return &attribute;
+    }
+
+    return nullptr;
+}
+
+// https://dom.spec.whatwg.org/#concept-element-attributes-get-by-namespace
+Attribute const* Element::find_attribute_ns(Optional<FlyString> const& namespace_, FlyString const& local_name, size_t* index) const
+{
+    // 1. If namespace is the empty string, then set it to null.
+    Optional<FlyString> normalized_namespace;
+    if (namespace_ != String {})
+        normalized_namespace = namespace_;
+
+    // 2. Return the attribute in element’s attribute list whose namespace is namespace and local name is localName, if any; otherwise null.
+    for (size_t i = 0; i < m_attribute_list.size(); ++i) {
+        auto const& attribute = m_attribute_list[i];
+        if (attribute.namespace_uri() == normalized_namespace && attribute.local_name() == local_name) {
+            if (index)
+                *index = i;
+            return &attribute;
+        }
+    }
+
+    return nullptr;
+}
+
+JS::NonnullGCPtr<Attr> Element::attribute_node(size_t index) const
+{
+    auto const& attribute = m_attribute_list[index];
+    if (!attribute.m_node)
+        attribute.m_node = Attr::create(const_cast<Document&>(document()), attribute.qualified_name(), attribute.value(), const_cast<Element*>(this));
+    return *attribute.m_node;
+}
+
+NamedNodeMap const* Element::attributes() const
+{
+    if (!m_attributes)
+        m_attributes = NamedNodeMap::create(const_cast<Element&>(*this));
+    return m_attributes;
 }
 
 // https://dom.spec.whatwg.org/#concept-element-attributes-set-value
 void Element::set_attribute_value(FlyString const& local_name, String const& value, Optional<FlyString> const& prefix, Optional<FlyString> const& namespace_)
 {
     // 1. Let attribute be the result of getting an attribute given namespace, localName, and element.
-    auto* attribute = m_attributes->get_attribute_ns(namespace_, local_name);
+    size_t index = 0;
+    auto const* attribute = find_attribute_ns(namespace_, local_name, &index);
 
     // 2. If attribute is null, create an attribute whose namespace is namespace, namespace prefix is prefix, local name
     //    is localName, value is value, and node document is element’s node document, then append this attribute to element,
     //    and then return.
     if (!attribute) {
-        QualifiedName name { local_name, prefix, namespace_ };
-
-        auto new_attribute = Attr::create(document(), move(name), value);
-        m_attributes->append_attribute(new_attribute);
-
+        append_attribute(QualifiedName { local_name, prefix, namespace_ }, value);
         return;
     }
 
     // 3. Change attribute to value.
-    attribute->change_attribute(value);
+    change_attribute(index, value);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-setattributenode
 WebIDL::ExceptionOr<JS::GCPtr<Attr>> Element::set_attribute_node(Attr& attr)
 {
     // The setAttributeNode(attr) and setAttributeNodeNS(attr) methods steps are to return the result of setting an attribute given attr and this.
-    return m_attributes->set_attribute(attr);
+    // https://dom.spec.whatwg.org/#concept-element-attributes-set
+    // 1. If attr’s element is neither null nor element, throw an "InUseAttributeError" DOMException.
+    if (attr.owner_element() && attr.owner_element() != this)
+        return WebIDL::InUseAttributeError::create(realm(), "Attribute must not already be in use"_string);
+
+    // 2. Let oldAttr be the result of getting an attribute given attr’s namespace, attr’s local name, and element.
+    size_t old_attribute_index = 0;
+    auto const* old_attribute = find_attribute_ns(attr.namespace_uri(), attr.local_name(), &old_attribute_index);
+
+    // 3. If oldAttr is attr, return attr.
+    if (old_attribute && old_attribute->node() == &attr)
+        return &attr;
+
+    // 4. If oldAttr is non-null, then replace oldAttr with attr.
+    if (old_attribute) {
+        auto old_attribute_node = attribute_node(old_attribute_index);
+        replace_attribute(old_attribute_index, attr);
+
+        // 6. Return oldAttr.
+        return old_attribute_node;
+    }
+
+    // 5. Otherwise, append attr to element.
+    append_attribute(attr);
+
+    // 6. Return oldAttr.
+    return nullptr;
 }
 
 // https://dom.spec.whatwg.org/#dom-element-setattributenodens
 WebIDL::ExceptionOr<JS::GCPtr<Attr>> Element::set_attribute_node_ns(Attr& attr)
 {
     // The setAttributeNode(attr) and setAttributeNodeNS(attr) methods steps are to return the result of setting an attribute given attr and this.
-    return m_attributes->set_attribute(attr);
+    return set_attribute_node(attr);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-removeattribute
 void Element::remove_attribute(FlyString const& name)
 {
     // The removeAttribute(qualifiedName) method steps are to remove an attribute given qualifiedName and this, and then return undefined.
-    m_attributes->remove_attribute(name);
+    size_t index = 0;
+    if (find_attribute(name, &index))
+        remove_attribute_at_index(index);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-removeattributens
 void Element::remove_attribute_ns(Optional<FlyString> const& namespace_, FlyString const& name)
 {
     // The removeAttributeNS(namespace, localName) method steps are to remove an attribute given namespace, localName, and this, and then return undefined.
-    m_attributes->remove_attribute_ns(namespace_, name);
+    size_t index = 0;
+    if (find_attribute_ns(namespace_, name, &index))
+        remove_attribute_at_index(index);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-removeattributenode
 WebIDL::ExceptionOr<JS::NonnullGCPtr<Attr>> Element::remove_attribute_node(JS::NonnullGCPtr<Attr> attr)
 {
-    return m_attributes->remove_attribute_node(attr);
+    // 1. If this’s attribute list does not contain attr, then throw a "NotFoundError" DOMException.
+    auto index = m_attribute_list.find_first_index_if([&](auto const& attribute) { return attribute.m_node == attr; });
+    if (!index.has_value())
+        return WebIDL::NotFoundError::create(realm(), "Attribute not found"_string);
+
+    // 2. Remove attr.
+    remove_attribute_at_index(index.value());
+
+    // 3. Return attr.
+    return attr;
 }
 
 // https://dom.spec.whatwg.org/#dom-element-hasattribute
 bool Element::has_attribute(FlyString const& name) const
 {
-    return m_attributes->get_attribute(name) != nullptr;
+    return find_attribute(name) != nullptr;
 }
 
 // https://dom.spec.whatwg.org/#dom-element-hasattributens
@@ -330,9 +545,9 @@ bool Element::has_attribute_ns(Optional<FlyString> const& namespace_, FlyString
     // 1. If namespace is the empty string, then set it to null.
     // 2. Return true if this has an attribute whose namespace is namespace and local name is localName; otherwise false.
     if (namespace_ == FlyString {})
-        return m_attributes->get_attribute_ns(OptionalNone {}, name) != nullptr;
+        return find_attribute_ns(OptionalNone {}, name) != nullptr;
 
-    return m_attributes->get_attribute_ns(namespace_, name) != nullptr;
+    return find_attribute_ns(namespace_, name) != nullptr;
 }
 
 // https://dom.spec.whatwg.org/#dom-element-toggleattribute
@@ -346,16 +561,15 @@ WebIDL::ExceptionOr<bool> Element::toggle_attribute(FlyString const& name, Optio
     bool insert_as_lowercase = namespace_uri() == Namespace::HTML && document().document_type() == Document::Type::HTML;
 
     // 3. Let attribute be the first attribute in this’s attribute list whose qualified name is qualifiedName, and null otherwise.
-    auto* attribute = m_attributes->get_attribute(name);
+    size_t index = 0;
+    auto const* attribute = find_attribute(name, &index);
 
     // 4. If attribute is null, then:
     if (!attribute) {
         // 1. If force is not given or is true, create an attribute whose local name is qualifiedName, value is the empty
         //    string, and node document is this’s node document, then append this attribute to this, and then return true.
         if (!force.has_value() || force.value()) {
-            auto new_attribute = Attr::create(document(), insert_as_lowercase ? name.to_ascii_lowercase() : name.to_string(), String {});
-            m_attributes->append_attribute(new_attribute);
-
+            append_attribute(QualifiedName { insert_as_lowercase ? name.to_ascii_lowercase() : name, {}, {} }, String {});
             return true;
         }
 
@@ -365,7 +579,7 @@ WebIDL::ExceptionOr<bool> Element::toggle_attribute(FlyString const& name, Optio
 
     // 5. Otherwise, if force is not given or is false, remove an attribute given qualifiedName and this, and then return false.
     if (!force.has_value() || !force.value()) {
-        m_attributes->remove_attribute(name);
+        remove_attribute_at_index(index);
         return false;
     }
 
@@ -378,10 +592,9 @@ Vector<String> Element::get_attribute_names() const
 {
     // The getAttributeNames() method steps are to return the qualified names of the attributes in this’s attribute list, in order; otherwise a new list.
     Vector<String> names;
-    for (size_t i = 0; i < m_attributes->length(); ++i) {
-        auto const* attribute = m_attributes->item(i);
-        names.append(attribute->name().to_string());
-    }
+    names.ensure_capacity(m_attribute_list.size());
+    for (auto const& attribute : m_attribute_list)
+        names.append(attribute.name().to_string());
     return names;
 }
 
@@ -449,8 +662,8 @@ void Element::run_attribute_change_steps(FlyString const& local_name, Optional<S
     attribute_changed(local_name, old_value, value);
 
     if (old_value != value) {
-        invalidate_style_after_attribute_change(local_name);
-        document().bump_dom_tree_version();
+        invalidate_style_after_attribute_change(local_name, old_value, value);
+        bump_dom_tree_version();
     }
 }
 
@@ -459,11 +672,18 @@ void Element::attribute_changed(FlyString const& name, Optional<String> const&,
     auto value_or_empty = value.value_or(String {});
 
     if (name == HTML::AttributeNames::id) {
+        auto* element_by_id_map = ElementByIdMap::for_root(root());
+        if (element_by_id_map && m_id.has_value())
+            element_by_id_map->remove(*m_id, *this);
+
         if (value_or_empty.is_empty())
             m_id = {};
         else
             m_id = value_or_empty;
 
+        if (element_by_id_map && m_id.has_value())
+            element_by_id_map->add(*m_id, *this);
+
         document().element_id_changed({}, *this);
     } else if (name == HTML::AttributeNames::name) {
         if (value_or_empty.is_empty())
@@ -752,7 +972,7 @@ JS::GCPtr<ShadowRoot> Element::shadow_root_for_bindings() const
 WebIDL::ExceptionOr<bool> Element::matches(StringView selectors) const
 {
     // 1. Let s be the result of parse a selector from selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingContext(static_cast<ParentNode&>(const_cast<Element&>(*this))), selectors);
+    auto maybe_selectors = const_cast<Document&>(document()).parse_selector_for_dom_api(selectors);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
@@ -771,7 +991,7 @@ WebIDL::ExceptionOr<bool> Element::matches(StringView selectors) const
 WebIDL::ExceptionOr<DOM::Element const*> Element::closest(StringView selectors) const
 {
     // 1. Let s be the result of parse a selector from selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingContext(static_cast<ParentNode&>(const_cast<Element&>(*this))), selectors);
+    auto maybe_selectors = const_cast<Document&>(document()).parse_selector_for_dom_api(selectors);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
@@ -915,45 +1135,52 @@ bool Element::serializes_as_void() const
 
 // https://drafts.csswg.org/cssom-view/#dom-element-getboundingclientrect
 JS::NonnullGCPtr<Geometry::DOMRect> Element::get_bounding_client_rect() const
+{
+    return Geometry::DOMRect::create(realm(), bounding_client_rect().to_type<float>());
+}
+
+CSSPixelRect Element::bounding_client_rect() const
 {
     // 1. Let list be the result of invoking getClientRects() on element.
-    auto list = get_client_rects();
+    auto list = client_rects();
 
     // 2. If the list is empty return a DOMRect object whose x, y, width and height members are zero.
-    if (list->length() == 0)
-        return Geometry::DOMRect::construct_impl(realm(), 0, 0, 0, 0).release_value_but_fixme_should_propagate_errors();
+    if (list.is_empty())
+        return {};
 
     // 3. If all rectangles in list have zero width or height, return the first rectangle in list.
-    auto all_rectangle_has_zero_width_or_height = true;
-    for (auto i = 0u; i < list->length(); ++i) {
-        auto const& rect = list->item(i);
-        if (rect->width() != 0 && rect->height() != 0) {
-            all_rectangle_has_zero_width_or_height = false;
-            break;
-        }
-    }
+    auto all_rectangle_has_zero_width_or_height = all_of(list, [](auto const& rect) {
+        return rect.width() == 0 || rect.height() == 0;
+    });
     if (all_rectangle_has_zero_width_or_height)
-        return JS::NonnullGCPtr { *const_cast<Geometry::DOMRect*>(list->item(0)) };
+        return list.first();
 
     // 4. Otherwise, return a DOMRect object describing the smallest rectangle that includes all of the rectangles in
     //    list of which the height or width is not zero.
-    auto const* first_rect = list->item(0);
-    auto bounding_rect = Gfx::Rect { first_rect->x(), first_rect->y(), first_rect->width(), first_rect->height() };
-    for (auto i = 1u; i < list->length(); ++i) {
-        auto const& rect = list->item(i);
-        if (rect->width() == 0 || rect->height() == 0)
+    auto bounding_rect = list.first();
+    for (size_t i = 1; i < list.size(); ++i) {
+        auto const& rect = list[i];
+        if (rect.width() == 0 || rect.height() == 0)
             continue;
-        bounding_rect = bounding_rect.united({ rect->x(), rect->y(), rect->width(), rect->height() });
+        bounding_rect = bounding_rect.united(rect);
     }
-    return Geometry::DOMRect::create(realm(), bounding_rect.to_type<float>());
+    return bounding_rect;
 }
 
 // https://drafts.csswg.org/cssom-view/#dom-element-getclientrects
 JS::NonnullGCPtr<Geometry::DOMRectList> Element::get_client_rects() const
+{
+    Vector<JS::Handle<Geometry::DOMRect>> rects;
+    for (auto const& rect : client_rects())
+        rects.append(Geometry::DOMRect::create(realm(), rect.to_type<float>()));
+    return Geometry::DOMRectList::create(realm(), move(rects));
+}
+
+Vector<CSSPixelRect> Element::client_rects() const
 {
     auto navigable = document().navigable();
     if (!navigable)
-        return Geometry::DOMRectList::create(realm(), {});
+        return {};
 
     // NOTE: Ensure that layout is up-to-date before looking at metrics.
     const_cast<Document&>(document()).update_layout();
@@ -961,7 +1188,7 @@ JS::NonnullGCPtr<Geometry::DOMRectList> Element::get_client_rects() const
     // 1. If the element on which it was invoked does not have an associated layout box return an empty DOMRectList
     //    object and stop this algorithm.
     if (!layout_node())
-        return Geometry::DOMRectList::create(realm(), {});
+        return {};
 
     // FIXME: 2. If the element has an associated SVG layout box return a DOMRectList object containing a single
     //          DOMRect object that describes the bounding box of the element as defined by the SVG specification,
@@ -982,7 +1209,7 @@ JS::NonnullGCPtr<Geometry::DOMRectList> Element::get_client_rects() const
     CSSPixelPoint scroll_offset;
     auto const* paintable = this->paintable();
 
-    Vector<JS::Handle<Geometry::DOMRect>> rects;
+    Vector<CSSPixelRect> rects;
     if (auto const* paintable_box = this->paintable_box()) {
         transform = Gfx::extract_2d_affine_transform(paintable_box->transform());
         for (auto const* containing_block = paintable->containing_block(); !containing_block->is_viewport(); containing_block = containing_block->containing_block()) {
@@ -998,12 +1225,12 @@ JS::NonnullGCPtr<Geometry::DOMRectList> Element::get_client_rects() const
                                     .to_type<CSSPixels>()
                                     .translated(paintable_box->transform_origin())
                                     .translated(-scroll_offset);
-        rects.append(Geometry::DOMRect::create(realm(), transformed_rect.to_type<float>()));
+        rects.append(transformed_rect);
     } else if (paintable) {
         dbgln("FIXME: Failed to get client rects for element ({})", debug_description());
     }
 
-    return Geometry::DOMRectList::create(realm(), move(rects));
+    return rects;
 }
 
 int Element::client_top() const
@@ -1098,8 +1325,11 @@ void Element::inserted()
 {
     Base::inserted();
 
-    if (m_id.has_value())
+    if (m_id.has_value()) {
+        if (auto* element_by_id_map = ElementByIdMap::for_root(root()))
+            element_by_id_map->add(*m_id, *this);
         document().element_with_id_was_added({}, *this);
+    }
 
     if (m_name.has_value())
         document().element_with_name_was_added({}, *this);
@@ -1109,6 +1339,18 @@ void Element::removed_from(Node* node)
 {
     Base::removed_from(node);
 
+    // NOTE: Only the root of the removed subtree is told what it was removed from, so it takes care of its descendants
+    //       too. They were all in the tree of its old parent, and elements in shadow trees below them stay in theirs.
+    if (node) {
+        if (auto* element_by_id_map = ElementByIdMap::for_root(node->root())) {
+            for_each_in_inclusive_subtree_of_type<Element>([&](Element& element) {
+                if (element.id().has_value())
+                    element_by_id_map->remove(*element.id(), element);
+                return TraversalDecision::Continue;
+            });
+        }
+    }
+
     if (m_id.has_value())
         document().element_with_id_was_removed({}, *this);
 
@@ -1925,11 +2167,49 @@ ErrorOr<void> Element::scroll_into_view(Optional<Variant<bool, ScrollIntoViewOpt
     // FIXME: 8. Optionally perform some other action that brings the element to the user’s attention.
 }
 
-void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name)
+static Vector<FlyString> split_into_class_names(Optional<String> const& value)
 {
-    // FIXME: Only invalidate if the attribute can actually affect style.
-    (void)attribute_name;
+    Vector<FlyString> class_names;
+    if (!value.has_value())
+        return class_names;
+    for (auto class_name : value->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace))
+        class_names.append(MUST(FlyString::from_utf8(class_name)));
+    return class_names;
+}
+
+void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value)
+{
+    // NOTE: Which elements a class or ID change can affect follows from the selectors that mention that class or ID.
+    //       In quirks mode, those are matched case-insensitively, so we can't look them up by name.
+    if (!document().in_quirks_mode()) {
+        if (attribute_name == HTML::AttributeNames::class_) {
+            auto old_class_names = split_into_class_names(old_value);
+            auto new_class_names = split_into_class_names(new_value);
+            Vector<FlyString> changed_class_names;
+            for (auto const& class_name : old_class_names) {
+                if (!new_class_names.contains_slow(class_name))
+                    changed_class_names.append(class_name);
+            }
+            for (auto const& class_name : new_class_names) {
+                if (!old_class_names.contains_slow(class_name))
+                    changed_class_names.append(class_name);
+            }
+            invalidate_style(StyleInvalidationReason::ElementAttributeChange, document().style_computer().invalidation_set_for_changed_classes(changed_class_names));
+            return;
+        }
+        if (attribute_name == HTML::AttributeNames::id) {
+            Vector<FlyString> changed_ids;
+            for (auto const& id : { old_value, new_value }) {
+                if (id.has_value() && !id->is_empty())
+                    changed_ids.append(*id);
+            }
+            invalidate_style(StyleInvalidationReason::ElementAttributeChange, document().style_computer().invalidation_set_for_changed_ids(changed_ids));
+            return;
+        }
+    }
 
+    // FIXME: Only invalidate if the attribute can actually affect style. Apart from attribute selectors, this also
+    //        includes presentational hints and pseudo-classes like :checked, so it needs more than the rule cache.
     // FIXME: This will need to become smarter when we implement the :has() selector.
     invalidate_style(StyleInvalidationReason::ElementAttributeChange);
 }
@@ -2097,16 +2377,13 @@ JS::ThrowCompletionOr<void> Element::upgrade_element(JS::NonnullGCPtr<HTML::Cust
 
     // 4. For each attribute in element's attribute list, in order, enqueue a custom element callback reaction with element, callback name "attributeChangedCallback",
     //    and an argument list containing attribute's local name, null, attribute's value, and attribute's namespace.
-    for (size_t attribute_index = 0; attribute_index < m_attributes->length(); ++attribute_index) {
-        auto const* attribute = m_attributes->item(attribute_index);
-        VERIFY(attribute);
-
+    for (auto const& attribute : m_attribute_list) {
         JS::MarkedVector<JS::Value> arguments { vm.heap() };
 
-        arguments.append(JS::PrimitiveString::create(vm, attribute->local_name()));
+        arguments.append(JS::PrimitiveString::create(vm, attribute.local_name()));
         arguments.append(JS::js_null());
-        arguments.append(JS::PrimitiveString::create(vm, attribute->value()));
-        arguments.append(attribute->namespace_uri().has_value() ? JS::PrimitiveString::create(vm, attribute->namespace_uri().value()) : JS::js_null());
+        arguments.append(JS::PrimitiveString::create(vm, attribute.value()));
+        arguments.append(attribute.namespace_uri().has_value() ? JS::PrimitiveString::create(vm, attribute.namespace_uri().value()) : JS::js_null());
 
         enqueue_a_custom_element_callback_reaction(HTML::CustomElementReactionNames::attributeChangedCallback, move(arguments));
     }
@@ -2224,12 +2501,9 @@ Optional<String> Element::locate_a_namespace_prefix(Optional<String> const& name
         return this->prefix()->to_string();
 
     // 2. If element has an attribute whose namespace prefix is "xmlns" and value is namespace, then return element’s first such attribute’s local name.
-    if (auto* attributes = this->attributes()) {
-        for (size_t i = 0; i < attributes->length(); ++i) {
-            auto& attr = *attributes->item(i);
-            if (attr.prefix() == "xmlns" && attr.value() == namespace_)
-                return attr.local_name().to_string();
-        }
+    for (auto const& attribute : m_attribute_list) {
+        if (attribute.prefix() == "xmlns" && attribute.value() == namespace_)
+            return attribute.local_name().to_string();
     }
 
     // 3. If element’s parent element is not null, then return the result of running locate a namespace prefix on that element using namespace.
@@ -2240,17 +2514,16 @@ Optional<String> Element::locate_a_namespace_prefix(Optional<String> const& name
     return {};
 }
 
-void Element::for_each_attribute(Function<void(Attr const&)> callback) const
+void Element::for_each_attribute(Function<void(Attribute const&)> callback) const
 {
-    for (size_t i = 0; i < m_attributes->length(); ++i)
-        callback(*m_attributes->item(i));
+    for (auto const& attribute : m_attribute_list)
+        callback(attribute);
 }
 
 void Element::for_each_attribute(Function<void(FlyString const&, String const&)> callback) const
 {
-    for_each_attribute([&callback](Attr const& attr) {
-        callback(attr.name(), attr.value());
-    });
+    for (auto const& attribute : m_attribute_list)
+        callback(attribute.name(), attribute.value());
 }
 
 JS::GCPtr<Layout::NodeWithStyle> Element::layout_node()
@@ -2265,12 +2538,12 @@ JS::GCPtr<Layout::NodeWithStyle const> Element::layout_node() const
 
 bool Element::has_attributes() const
 {
-    return !m_attributes->is_empty();
+    return !m_attribute_list.is_empty();
 }
 
 size_t Element::attribute_list_size() const
 {
-    return m_attributes->length();
+    return m_attribute_list.size();
 }
 
 void Element::set_computed_css_values(RefPtr<CSS::StyleProperties> style)
@@ -2469,11 +2742,9 @@ bool Element::check_visibility(Optional<CheckVisibilityOptions> options)
     }
 
     // 5. If the contentVisibilityAuto dictionary member of options is true and an ancestor of this in the flat tree skips its contents due to content-visibility: auto, return false.
-    // FIXME: Currently we do not skip any content if content-visibility is auto: https://drafts.csswg.org/css-contain-2/#proximity-to-the-viewport
-    auto const skipped_contents_due_to_content_visibility_auto = false;
-    if (options->content_visibility_auto && skipped_contents_due_to_content_visibility_auto) {
-        for (auto* element = this; element; element = element->parent_element()) {
-            if (element->computed_css_values()->content_visibility() == CSS::ContentVisibility::Auto)
+    if (options->content_visibility_auto) {
+        for (auto* element = parent_element(); element; element = element->parent_element()) {
+            if (element->computed_css_values()->content_visibility() == CSS::ContentVisibility::Auto && element->skips_its_contents())
                 return false;
         }
     }
@@ -2482,6 +2753,61 @@ bool Element::check_visibility(Optional<CheckVisibilityOptions> options)
     return true;
 }
 
+// https://drafts.csswg.org/css-contain-2/#determine-proximity-to-the-viewport
+void Element::determine_proximity_to_the_viewport()
+{
+    auto skipped_its_contents = skips_its_contents();
+
+    // FIXME: The margin around the viewport is implementation-defined. We use half the viewport size on every side,
+    //        so that contents are laid out a little before they get scrolled into view.
+    auto viewport_rect = document().viewport_rect();
+    viewport_rect.inflate(viewport_rect.width(), viewport_rect.height());
+
+    auto const* paintable_box = this->paintable_box();
+    if (paintable_box && paintable_box->absolute_border_box_rect().intersects(viewport_rect))
+        m_proximity_to_the_viewport = ProximityToTheViewport::CloseToTheViewport;
+    else
+        m_proximity_to_the_viewport = ProximityToTheViewport::FarAwayFromTheViewport;
+
+    if (skips_its_contents() != skipped_its_contents)
+        document().invalidate_layout_tree_for_subtree_of(*this);
+}
+
+// https://drafts.csswg.org/css-contain-2/#relevant-to-the-user
+bool Element::is_relevant_to_the_user() const
+{
+    // An element is relevant to the user if any of the following conditions are true:
+    // - The element is "close to the viewport".
+    if (m_proximity_to_the_viewport == ProximityToTheViewport::CloseToTheViewport)
+        return true;
+
+    // FIXME: - Either the element or its contents are focused, as described in the focus section of the HTML spec.
+    // FIXME: - Either the element or its contents are selected, where selection is described in the selection API.
+
+    // - Either the element or its contents are placed in the top layer.
+    // FIXME: Check the contents too.
+    return in_top_layer();
+}
+
+// https://drafts.csswg.org/css-contain-2/#skips-its-contents
+bool Element::skips_its_contents() const
+{
+    auto style = computed_css_values();
+    if (!style)
+        return false;
+
+    switch (style->content_visibility().value_or(CSS::ContentVisibility::Visible)) {
+    case CSS::ContentVisibility::Visible:
+        return false;
+    case CSS::ContentVisibility::Hidden:
+        return true;
+    case CSS::ContentVisibility::Auto:
+        // If the element is not relevant to the user, it also skips its contents.
+        return !is_relevant_to_the_user();
+    }
+    VERIFY_NOT_REACHED();
+}
+
 bool Element::id_reference_exists(String const& id_reference) const
 {
     return document().get_element_by_id(id_reference);
@@ -15,6 +15,7 @@
 #include <LibWeb/CSS/Selector.h>
 #include <LibWeb/CSS/StyleInvalidation.h>
 #include <LibWeb/CSS/StyleProperty.h>
+#include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/ChildNode.h>
 #include <LibWeb/DOM/NonDocumentTypeChildNode.h>
 #include <LibWeb/DOM/ParentNode.h>
@@ -26,6 +27,7 @@
 #include <LibWeb/HTML/ScrollOptions.h>
 #include <LibWeb/HTML/TagNames.h>
 #include <LibWeb/IntersectionObserver/IntersectionObserver.h>
+#include <LibWeb/PixelUnits.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
 
 namespace Web::DOM {
@@ -129,16 +131,27 @@ public:
     WebIDL::ExceptionOr<JS::GCPtr<Attr>> set_attribute_node_ns(Attr&);
 
     void append_attribute(FlyString const& name, String const& value);
+    void append_attribute(QualifiedName, String value);
     void append_attribute(Attr&);
+    void change_attribute(Attr&, String value);
     void remove_attribute(FlyString const& name);
     void remove_attribute_ns(Optional<FlyString> const& namespace_, FlyString const& name);
+    void remove_attribute_at_index(size_t);
     WebIDL::ExceptionOr<JS::NonnullGCPtr<Attr>> remove_attribute_node(JS::NonnullGCPtr<Attr>);
 
     WebIDL::ExceptionOr<bool> toggle_attribute(FlyString const& name, Optional<bool> force);
     size_t attribute_list_size() const;
-    NamedNodeMap const* attributes() const { return m_attributes.ptr(); }
+    NamedNodeMap const* attributes() const;
     Vector<String> get_attribute_names() const;
 
+    Vector<Attribute> const& attribute_list() const { return m_attribute_list; }
+    Attribute const* find_attribute(FlyString const& qualified_name, size_t* index = nullptr) const;
+    Attribute const* find_attribute_ns(Optional<FlyString> const& namespace_, FlyString const& local_name, size_t* index = nullptr) const;
+    Attribute const* find_attribute_with_lowercase_qualified_name(FlyString const&) const;
+
+    // Returns the Attr node for the attribute at the given index in the attribute list, creating it if needed.
+    JS::NonnullGCPtr<Attr> attribute_node(size_t index) const;
+
     JS::GCPtr<Attr> get_attribute_node(FlyString const& name) const;
     JS::GCPtr<Attr> get_attribute_node_ns(Optional<FlyString> const& namespace_, FlyString const& name) const;
 
@@ -157,7 +170,7 @@ public:
     int client_height() const;
     [[nodiscard]] double current_css_zoom() const;
 
-    void for_each_attribute(Function<void(Attr const&)>) const;
+    void for_each_attribute(Function<void(Attribute const&)>) const;
 
     void for_each_attribute(Function<void(FlyString const&, String const&)>) const;
 
@@ -235,6 +248,10 @@ public:
     JS::NonnullGCPtr<Geometry::DOMRect> get_bounding_client_rect() const;
     JS::NonnullGCPtr<Geometry::DOMRectList> get_client_rects() const;
 
+    // The geometry behind get_bounding_client_rect() and get_client_rects(), for callers that don't need DOMRect objects.
+    CSSPixelRect bounding_client_rect() const;
+    Vector<CSSPixelRect> client_rects() const;
+
     virtual JS::GCPtr<Layout::Node> create_layout_node(NonnullRefPtr<CSS::StyleProperties>);
     virtual void adjust_computed_style(CSS::StyleProperties&) { }
 
@@ -370,6 +387,18 @@ public:
 
     bool check_visibility(Optional<CheckVisibilityOptions>);
 
+    // https://drafts.csswg.org/css-contain-2/#proximity-to-the-viewport
+    enum class ProximityToTheViewport {
+        NotDetermined,
+        CloseToTheViewport,
+        FarAwayFromTheViewport,
+    };
+    ProximityToTheViewport proximity_to_the_viewport() const { return m_proximity_to_the_viewport; }
+    void determine_proximity_to_the_viewport();
+
+    bool is_relevant_to_the_user() const;
+    bool skips_its_contents() const;
+
     void register_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserverRegistration);
     void unregister_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, JS::NonnullGCPtr<IntersectionObserver::IntersectionObserver>);
     IntersectionObserver::IntersectionObserverRegistration& get_intersection_observer_registration(Badge<DOM::Document>, IntersectionObserver::IntersectionObserver const&);
@@ -432,7 +461,11 @@ protected:
 private:
     void make_html_uppercased_qualified_name();
 
-    void invalidate_style_after_attribute_change(FlyString const& attribute_name);
+    void invalidate_style_after_attribute_change(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value);
+
+    void change_attribute(size_t index, String value);
+    void replace_attribute(size_t old_attribute_index, Attr& new_attribute);
+    void handle_attribute_changes(QualifiedName const&, Optional<String> const& old_value, Optional<String> const& new_value);
 
     WebIDL::ExceptionOr<JS::GCPtr<Node>> insert_adjacent(StringView where, JS::NonnullGCPtr<Node> node);
 
@@ -446,7 +479,8 @@ private:
     QualifiedName m_qualified_name;
     FlyString m_html_uppercased_qualified_name;
 
-    JS::GCPtr<NamedNodeMap> m_attributes;
+    Vector<Attribute> m_attribute_list;
+    mutable JS::GCPtr<NamedNodeMap> m_attributes;
     JS::GCPtr<CSS::ElementInlineCSSStyleDeclaration> m_inline_style;
     JS::GCPtr<DOMTokenList> m_class_list;
     JS::GCPtr<ShadowRoot> m_shadow_root;
@@ -496,6 +530,8 @@ private:
 
     bool m_in_top_layer { false };
 
+    ProximityToTheViewport m_proximity_to_the_viewport { ProximityToTheViewport::NotDetermined };
+
     OwnPtr<CSS::CountersSet> m_counters_set;
 };
 
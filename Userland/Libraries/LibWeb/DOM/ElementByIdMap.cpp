@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/DocumentFragment.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementByIdMap.h>
+
+namespace Web::DOM {
+
+ElementByIdMap* ElementByIdMap::for_root(Node& root)
+{
+    if (is<Document>(root))
+        return static_cast<Document&>(root).element_by_id_map();
+    if (is<DocumentFragment>(root))
+        return static_cast<DocumentFragment&>(root).element_by_id_map();
+    return nullptr;
+}
+
+void ElementByIdMap::add(FlyString const& id, Element& element)
+{
+    auto& entry = m_elements.ensure(id);
+    if (entry.elements.contains_slow(JS::NonnullGCPtr { element }))
+        return;
+    entry.elements.append(element);
+    if (entry.elements.size() > 1)
+        entry.is_in_tree_order = false;
+}
+
+void ElementByIdMap::remove(FlyString const& id, Element& element)
+{
+    auto it = m_elements.find(id);
+    if (it == m_elements.end())
+        return;
+    it->value.elements.remove_first_matching([&](auto const& entry) { return entry.ptr() == &element; });
+    if (it->value.elements.is_empty())
+        m_elements.remove(it);
+}
+
+ElementByIdMap::Elements const* ElementByIdMap::elements_in_tree_order(FlyString const& id) const
+{
+    auto it = m_elements.find(id);
+    if (it == m_elements.end())
+        return nullptr;
+
+    auto& entry = it->value;
+    if (!entry.is_in_tree_order) {
+        quick_sort(entry.elements, [](auto const& a, auto const& b) { return a->is_before(*b); });
+        entry.is_in_tree_order = true;
+    }
+    return &entry;
+}
+
+JS::GCPtr<Element> ElementByIdMap::get(FlyString const& id) const
+{
+    auto const* entry = elements_in_tree_order(id);
+    if (!entry)
+        return {};
+    return entry->elements.first();
+}
+
+Vector<JS::NonnullGCPtr<Element>> ElementByIdMap::get_all(FlyString const& id) const
+{
+    auto const* entry = elements_in_tree_order(id);
+    if (!entry)
+        return {};
+    Vector<JS::NonnullGCPtr<Element>> elements;
+    elements.extend(entry->elements);
+    return elements;
+}
+
+void ElementByIdMap::visit_edges(JS::Cell::Visitor& visitor)
+{
+    for (auto& entry : m_elements) {
+        for (auto& element : entry.value.elements)
+            visitor.visit(element);
+    }
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/Vector.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::DOM {
+
+// Keeps track of the elements with an ID in a document or shadow root, so that looking one up doesn't have to walk the tree.
+class ElementByIdMap {
+public:
+    // Returns the map that keeps track of the elements in the tree of the given root, if that kind of root has one.
+    static ElementByIdMap* for_root(Node&);
+
+    void add(FlyString const& id, Element&);
+    void remove(FlyString const& id, Element&);
+
+    // Returns the first element in tree order with the given ID.
+    JS::GCPtr<Element> get(FlyString const& id) const;
+
+    // Returns all elements with the given ID, in tree order.
+    Vector<JS::NonnullGCPtr<Element>> get_all(FlyString const& id) const;
+
+    void visit_edges(JS::Cell::Visitor&);
+
+private:
+    struct Elements {
+        Vector<JS::NonnullGCPtr<Element>, 1> elements;
+        // NOTE: With duplicate IDs, we only figure out which element comes first once somebody asks.
+        bool is_in_tree_order { true };
+    };
+
+    Elements const* elements_in_tree_order(FlyString const& id) const;
+
+    // NOTE: Looking an ID up can sort its elements, which is why this is mutable.
+    mutable HashMap<FlyString, Elements> m_elements;
+};
+
+}
@@ -146,7 +146,9 @@ void EventDispatcher::invoke(Event::PathEntry& struct_, Event& event, Event::Pha
 
     // 6. Let listeners be a clone of event’s currentTarget attribute value’s event listener list.
     // NOTE: This avoids event listeners added after this point from being run. Note that removal still has an effect due to the removed field.
-    auto listeners = event.current_target()->event_listener_list();
+    // NOTE: Inner invoke skips every listener whose type is not event's type, so we only clone those. Most targets in a path have
+    //       no listener for the event being dispatched, and for those this doesn't allocate anything.
+    auto listeners = event.current_target()->event_listener_list(event.type());
 
     // 7. Let invocationTargetInShadowTree be struct’s invocation-target-in-shadow-tree.
     bool invocation_target_in_shadow_tree = struct_.invocation_target_in_shadow_tree;
@@ -173,6 +175,9 @@ void EventDispatcher::invoke(Event::PathEntry& struct_, Event& event, Event::Pha
             return;
 
         // 3. Inner invoke with event, listeners, phase, invocationTargetInShadowTree, and legacyOutputDidListenersThrowFlag if given.
+        // NOTE: Our clone of listeners only has listeners for the original type. Since found is false no listener has run yet,
+        //       so the list can't have changed since step 6 and cloning it again for the new type is equivalent.
+        listeners = event.current_target()->event_listener_list(event.type());
         inner_invoke(event, listeners, phase, invocation_target_in_shadow_tree);
 
         // 4. Set event’s type attribute value to originalEventType.
@@ -76,13 +76,15 @@ void EventTarget::visit_edges(Cell::Visitor& visitor)
     }
 }
 
-Vector<JS::Handle<DOMEventListener>> EventTarget::event_listener_list()
+Vector<JS::Handle<DOMEventListener>> EventTarget::event_listener_list(FlyString const& type)
 {
     Vector<JS::Handle<DOMEventListener>> list;
     if (!m_data)
         return list;
-    for (auto& listener : m_data->event_listener_list)
-        list.append(*listener);
+    for (auto& listener : m_data->event_listener_list) {
+        if (listener->type == type)
+            list.append(*listener);
+    }
     return list;
 }
 
@@ -44,7 +44,8 @@ public:
     void remove_an_event_listener(DOMEventListener&);
     void remove_from_event_listener_list(DOMEventListener&);
 
-    Vector<JS::Handle<DOMEventListener>> event_listener_list();
+    // Returns a clone of the event listener list that only contains the listeners whose type is the given type.
+    Vector<JS::Handle<DOMEventListener>> event_listener_list(FlyString const& type);
 
     virtual bool has_activation_behavior() const;
     virtual void activation_behavior(Event const&);
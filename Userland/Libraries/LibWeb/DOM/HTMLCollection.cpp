@@ -77,7 +77,7 @@ void HTMLCollection::update_name_to_element_mappings_if_needed() const
 void HTMLCollection::update_cache_if_needed() const
 {
     // Nothing to do, the DOM hasn't updated since we last built the cache.
-    if (m_cached_dom_tree_version == root()->document().dom_tree_version())
+    if (m_cached_dom_tree_version == root()->dom_tree_version())
         return;
 
     m_cached_elements.clear();
@@ -95,7 +95,7 @@ void HTMLCollection::update_cache_if_needed() const
             return IterationDecision::Continue;
         });
     }
-    m_cached_dom_tree_version = root()->document().dom_tree_version();
+    m_cached_dom_tree_version = root()->dom_tree_version();
 }
 
 JS::MarkedVector<JS::NonnullGCPtr<Element>> HTMLCollection::collect_matching_elements() const
@@ -12,7 +12,6 @@
 
 namespace Web::DOM {
 
-// FIXME: Just like HTMLCollection, LiveNodeList currently does no caching.
 
 class LiveNodeList : public NodeList {
     WEB_PLATFORM_OBJECT(LiveNodeList, NodeList);
@@ -38,7 +37,10 @@ protected:
 private:
     virtual void visit_edges(Cell::Visitor&) override;
 
-    JS::MarkedVector<Node*> collection() const;
+    void update_cache_if_needed() const;
+
+    mutable u64 m_cached_dom_tree_version { 0 };
+    mutable Vector<JS::NonnullGCPtr<Node>> m_cached_nodes;
 
     JS::NonnullGCPtr<Node const> m_root;
     Function<bool(Node const&)> m_filter;
@@ -16,6 +16,7 @@
 namespace Web::DOM {
 
 // https://dom.spec.whatwg.org/#interface-namednodemap
+// NOTE: The attributes themselves live in the element's attribute list, this only exposes them to JS.
 class NamedNodeMap : public Bindings::PlatformObject {
     WEB_PLATFORM_OBJECT(NamedNodeMap, Bindings::PlatformObject);
     JS_DECLARE_ALLOCATOR(NamedNodeMap);
@@ -28,8 +29,8 @@ public:
     virtual Optional<JS::Value> item_value(size_t index) const override;
     virtual JS::Value named_item_value(FlyString const& name) const override;
 
-    size_t length() const { return m_attributes.size(); }
-    bool is_empty() const { return m_attributes.is_empty(); }
+    size_t length() const;
+    bool is_empty() const;
 
     // Methods defined by the spec for JavaScript:
     Attr const* item(u32 index) const;
@@ -40,23 +41,6 @@ public:
     WebIDL::ExceptionOr<Attr const*> remove_named_item(FlyString const& qualified_name);
     WebIDL::ExceptionOr<Attr const*> remove_named_item_ns(Optional<FlyString> const& namespace_, FlyString const& local_name);
 
-    // Methods defined by the spec for internal use:
-    Attr* get_attribute(FlyString const& qualified_name, size_t* item_index = nullptr);
-    Attr const* get_attribute(FlyString const& qualified_name, size_t* item_index = nullptr) const;
-    WebIDL::ExceptionOr<JS::GCPtr<Attr>> set_attribute(Attr& attribute);
-    void replace_attribute(Attr& old_attribute, Attr& new_attribute, size_t old_attribute_index);
-    void append_attribute(Attr& attribute);
-
-    Attr* get_attribute_ns(Optional<FlyString> const& namespace_, FlyString const& local_name, size_t* item_index = nullptr);
-    Attr const* get_attribute_ns(Optional<FlyString> const& namespace_, FlyString const& local_name, size_t* item_index = nullptr) const;
-
-    Attr const* remove_attribute(FlyString const& qualified_name);
-    Attr const* remove_attribute_ns(Optional<FlyString> const& namespace_, FlyString const& local_name);
-
-    Attr const* get_attribute_with_lowercase_qualified_name(FlyString const&) const;
-
-    WebIDL::ExceptionOr<JS::NonnullGCPtr<Attr>> remove_attribute_node(JS::NonnullGCPtr<Attr>);
-
 private:
     explicit NamedNodeMap(Element&);
 
@@ -66,10 +50,7 @@ private:
     Element& associated_element() { return *m_element; }
     Element const& associated_element() const { return *m_element; }
 
-    void remove_attribute_at_index(size_t attribute_index);
-
     JS::NonnullGCPtr<DOM::Element> m_element;
-    Vector<JS::NonnullGCPtr<Attr>> m_attributes;
 };
 
 }
@@ -14,6 +14,7 @@
 #include <LibURL/Origin.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Bindings/NodePrototype.h>
+#include <LibWeb/CSS/StyleInvalidation.h>
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/CDATASection.h>
 #include <LibWeb/DOM/Comment.h>
@@ -213,10 +214,10 @@ void Node::set_text_content(Optional<String> const& maybe_content)
         } else {
             invalidate_style(StyleInvalidationReason::NodeSetTextContent);
         }
-        document().invalidate_layout_tree();
+        document().invalidate_layout_tree_for_subtree_of(*this);
     }
 
-    document().bump_dom_tree_version();
+    bump_dom_tree_version();
 }
 
 // https://dom.spec.whatwg.org/#dom-node-normalize
@@ -380,7 +381,7 @@ JS::GCPtr<HTML::Navigable> Node::navigable() const
     return navigable;
 }
 
-[[maybe_unused]] static StringView to_string(StyleInvalidationReason reason)
+StringView to_string(StyleInvalidationReason reason)
 {
 #define __ENUMERATE_STYLE_INVALIDATION_REASON(reason) \
     case StyleInvalidationReason::reason:             \
@@ -392,11 +393,29 @@ JS::GCPtr<HTML::Navigable> Node::navigable() const
     }
 }
 
+void Node::mark_inclusive_subtree_for_style_update()
+{
+    for_each_in_inclusive_subtree([&](Node& node) {
+        node.m_needs_style_update = true;
+        if (node.has_children())
+            node.m_child_needs_style_update = true;
+        if (auto shadow_root = node.is_element() ? static_cast<DOM::Element&>(node).shadow_root() : nullptr) {
+            node.m_child_needs_style_update = true;
+            shadow_root->m_needs_style_update = true;
+            if (shadow_root->has_children())
+                shadow_root->m_child_needs_style_update = true;
+        }
+        return TraversalDecision::Continue;
+    });
+}
+
 void Node::invalidate_style(StyleInvalidationReason reason)
 {
     if (is_character_data())
         return;
 
+    ++document().rendering_statistics().style_invalidations_by_reason[to_underlying(reason)];
+
     if (!needs_style_update() && !document().needs_full_style_update()) {
         dbgln_if(STYLE_INVALIDATION_DEBUG, "Invalidate style ({}): {}", to_string(reason), debug_description());
     }
@@ -420,33 +439,54 @@ void Node::invalidate_style(StyleInvalidationReason reason)
     // - all of its subsequent siblings and their descendants
     // FIXME: This is a lot of invalidation and we should implement more sophisticated invalidation to do less work!
 
-    auto invalidate_entire_subtree = [&](Node& subtree_root) {
-        subtree_root.for_each_in_inclusive_subtree([&](Node& node) {
-            node.m_needs_style_update = true;
-            if (node.has_children())
-                node.m_child_needs_style_update = true;
-            if (auto shadow_root = node.is_element() ? static_cast<DOM::Element&>(node).shadow_root() : nullptr) {
-                node.m_child_needs_style_update = true;
-                shadow_root->m_needs_style_update = true;
-                if (shadow_root->has_children())
-                    shadow_root->m_child_needs_style_update = true;
-            }
-            return TraversalDecision::Continue;
-        });
-    };
-
-    invalidate_entire_subtree(*this);
+    mark_inclusive_subtree_for_style_update();
 
     if (reason == StyleInvalidationReason::NodeInsertBefore || reason == StyleInvalidationReason::NodeRemove) {
         for (auto* sibling = previous_sibling(); sibling; sibling = sibling->previous_sibling()) {
             if (sibling->is_element())
-                invalidate_entire_subtree(*sibling);
+                sibling->mark_inclusive_subtree_for_style_update();
         }
     }
 
     for (auto* sibling = next_sibling(); sibling; sibling = sibling->next_sibling()) {
         if (sibling->is_element())
-            invalidate_entire_subtree(*sibling);
+            sibling->mark_inclusive_subtree_for_style_update();
+    }
+
+    for (auto* ancestor = parent_or_shadow_host(); ancestor; ancestor = ancestor->parent_or_shadow_host())
+        ancestor->m_child_needs_style_update = true;
+    document().schedule_style_update();
+}
+
+void Node::invalidate_style(StyleInvalidationReason reason, CSS::InvalidationSet const& invalidation_set)
+{
+    if (invalidation_set.is_empty())
+        return;
+
+    if (invalidation_set.whole_document) {
+        document().invalidate_style(reason);
+        return;
+    }
+
+    if (is_character_data() || is_document() || document().needs_full_style_update()) {
+        invalidate_style(reason);
+        return;
+    }
+
+    ++document().rendering_statistics().style_invalidations_by_reason[to_underlying(reason)];
+
+    dbgln_if(STYLE_INVALIDATION_DEBUG, "Invalidate style ({}, element={}, descendants={}, subsequent_siblings={}): {}", to_string(reason), invalidation_set.element, invalidation_set.descendants, invalidation_set.subsequent_siblings, debug_description());
+
+    // NOTE: Even if no selector can match the descendants, they inherit from this element. Inherited properties, the
+    //       inherit keyword and font-relative lengths all depend on its computed values, so they have to be restyled too.
+    if (invalidation_set.element || invalidation_set.descendants)
+        mark_inclusive_subtree_for_style_update();
+
+    if (invalidation_set.subsequent_siblings) {
+        for (auto* sibling = next_sibling(); sibling; sibling = sibling->next_sibling()) {
+            if (sibling->is_element())
+                sibling->mark_inclusive_subtree_for_style_update();
+        }
     }
 
     for (auto* ancestor = parent_or_shadow_host(); ancestor; ancestor = ancestor->parent_or_shadow_host())
@@ -688,10 +728,10 @@ void Node::insert_before(JS::NonnullGCPtr<Node> node, JS::GCPtr<Node> child, boo
     if (is_connected()) {
         // FIXME: This will need to become smarter when we implement the :has() selector.
         invalidate_style(StyleInvalidationReason::ParentOfInsertedNode);
-        document().invalidate_layout_tree();
+        document().invalidate_layout_tree_for_subtree_of(*this);
     }
 
-    document().bump_dom_tree_version();
+    bump_dom_tree_version();
 }
 
 // https://dom.spec.whatwg.org/#concept-node-pre-insert
@@ -865,7 +905,9 @@ void Node::remove(bool suppress_observers)
     // 19. For each inclusive ancestor inclusiveAncestor of parent, and then for each registered of inclusiveAncestor’s registered observer list,
     //     if registered’s options["subtree"] is true, then append a new transient registered observer
     //     whose observer is registered’s observer, options is registered’s options, and source is registered to node’s registered observer list.
-    for (auto* inclusive_ancestor = parent; inclusive_ancestor; inclusive_ancestor = inclusive_ancestor->parent()) {
+    // OPTIMIZATION: If no node in this document has ever been observed, there's no registered observer to find.
+    bool may_have_mutation_observers = document().may_have_mutation_observers();
+    for (auto* inclusive_ancestor = may_have_mutation_observers ? parent : nullptr; inclusive_ancestor; inclusive_ancestor = inclusive_ancestor->parent()) {
         if (!inclusive_ancestor->m_registered_observer_list)
             continue;
         for (auto& registered : *inclusive_ancestor->m_registered_observer_list) {
@@ -877,7 +919,7 @@ void Node::remove(bool suppress_observers)
     }
 
     // 20. If suppress observers flag is unset, then queue a tree mutation record for parent with « », « node », oldPreviousSibling, and oldNextSibling.
-    if (!suppress_observers) {
+    if (!suppress_observers && may_have_mutation_observers) {
         parent->queue_tree_mutation_record({}, { *this }, old_previous_sibling.ptr(), old_next_sibling.ptr());
     }
 
@@ -899,11 +941,11 @@ void Node::remove(bool suppress_observers)
         // NOTE: If we didn't have a layout node before, rebuilding the layout tree isn't gonna give us one
         //       after we've been removed from the DOM.
         if (had_layout_node) {
-            document().invalidate_layout_tree();
+            document().invalidate_layout_tree_for_subtree_of(*parent);
         }
     }
 
-    document().bump_dom_tree_version();
+    parent->bump_dom_tree_version();
 }
 
 // https://dom.spec.whatwg.org/#concept-node-replace
@@ -1365,6 +1407,16 @@ JS::GCPtr<Document> Node::owner_document() const
     return m_document;
 }
 
+void Node::bump_dom_tree_version()
+{
+    // NOTE: The versions come from a single counter, so that a node that moves to another document can't end up with a
+    //       version that some cache has already seen.
+    static u64 s_next_dom_tree_version = 1;
+    auto version = s_next_dom_tree_version++;
+    for (auto* node = this; node; node = node->parent())
+        node->m_dom_tree_version = version;
+}
+
 // This function tells us whether a node is interesting enough to show up
 // in the DOM inspector. This hides two things:
 // - Non-rendered whitespace
@@ -1514,15 +1566,21 @@ bool Node::is_shadow_including_inclusive_ancestor_of(Node const& other) const
 // https://dom.spec.whatwg.org/#concept-node-replace-all
 void Node::replace_all(JS::GCPtr<Node> node)
 {
+    // OPTIMIZATION: Only take handles to the removed and added nodes if anyone could observe the mutation record.
+    bool may_have_mutation_observers = document().may_have_mutation_observers();
+
     // 1. Let removedNodes be parent’s children.
-    auto removed_nodes = children_as_vector();
+    Vector<JS::Handle<Node>> removed_nodes;
+    if (may_have_mutation_observers)
+        removed_nodes = children_as_vector();
 
     // 2. Let addedNodes be the empty set.
     Vector<JS::Handle<Node>> added_nodes;
 
     // 3. If node is a DocumentFragment node, then set addedNodes to node’s children.
     if (node && is<DocumentFragment>(*node)) {
-        added_nodes = node->children_as_vector();
+        if (may_have_mutation_observers)
+            added_nodes = node->children_as_vector();
     }
     // 4. Otherwise, if node is non-null, set addedNodes to « node ».
     else if (node) {
@@ -1734,17 +1792,14 @@ Optional<String> Node::locate_a_namespace(Optional<String> const& prefix) const
         // 4. If it has an attribute whose namespace is the XMLNS namespace, namespace prefix is "xmlns", and local name is prefix,
         //    or if prefix is null and it has an attribute whose namespace is the XMLNS namespace, namespace prefix is null,
         //    and local name is "xmlns", then return its value if it is not the empty string, and null otherwise.
-        if (auto* attributes = element.attributes()) {
-            for (size_t i = 0; i < attributes->length(); ++i) {
-                auto& attr = *attributes->item(i);
-                if (attr.namespace_uri() == Web::Namespace::XMLNS) {
-                    if ((attr.prefix() == "xmlns" && attr.local_name() == prefix) || (!prefix.has_value() && !attr.prefix().has_value() && attr.local_name() == "xmlns")) {
-                        auto value = attr.value();
-                        if (!value.is_empty())
-                            return value;
-
-                        return {};
-                    }
+        for (auto const& attr : element.attribute_list()) {
+            if (attr.namespace_uri() == Web::Namespace::XMLNS) {
+                if ((attr.prefix() == "xmlns" && attr.local_name() == prefix) || (!prefix.has_value() && !attr.prefix().has_value() && attr.local_name() == "xmlns")) {
+                    auto value = attr.value();
+                    if (!value.is_empty())
+                        return value;
+
+                    return {};
                 }
             }
         }
@@ -1957,6 +2012,10 @@ Painting::PaintableBox* Node::paintable_box()
 // https://dom.spec.whatwg.org/#queue-a-mutation-record
 void Node::queue_mutation_record(FlyString const& type, Optional<FlyString> const& attribute_name, Optional<FlyString> const& attribute_namespace, Optional<String> const& old_value, Vector<JS::Handle<Node>> added_nodes, Vector<JS::Handle<Node>> removed_nodes, Node* previous_sibling, Node* next_sibling) const
 {
+    // OPTIMIZATION: If no node in this document has ever been observed, there can't be any interested observers.
+    if (!document().may_have_mutation_observers())
+        return;
+
     // NOTE: We defer garbage collection until the end of the scope, since we can't safely use MutationObserver* as a hashmap key otherwise.
     // FIXME: This is a total hack.
     JS::DeferGC defer_gc(heap());
@@ -2427,6 +2486,7 @@ ErrorOr<void> Node::prepend_with_space(StringBuilder x, StringView const& result
 
 void Node::add_registered_observer(RegisteredObserver& registered_observer)
 {
+    document().set_may_have_mutation_observers();
     if (!m_registered_observer_list)
         m_registered_observer_list = make<Vector<JS::NonnullGCPtr<RegisteredObserver>>>();
     m_registered_observer_list->append(registered_observer);
@@ -86,6 +86,8 @@ enum class StyleInvalidationReason {
 #undef __ENUMERATE_STYLE_INVALIDATION_REASON
 };
 
+StringView to_string(StyleInvalidationReason);
+
 class Node : public EventTarget {
     WEB_PLATFORM_OBJECT(Node, EventTarget);
 
@@ -206,6 +208,11 @@ public:
 
     JS::GCPtr<Document> owner_document() const;
 
+    // AD-HOC: This number changes whenever a node is added to or removed from this node's subtree, or an attribute of an
+    //         element in it changes. It can be used as an invalidation mechanism for caches that depend on the subtree.
+    u64 dom_tree_version() const { return m_dom_tree_version; }
+    void bump_dom_tree_version();
+
     const HTML::HTMLAnchorElement* enclosing_link_element() const;
     const HTML::HTMLElement* enclosing_html_element() const;
     const HTML::HTMLElement* enclosing_html_element_with_attribute(FlyString const&) const;
@@ -263,6 +270,8 @@ public:
     void set_child_needs_style_update(bool b) { m_child_needs_style_update = b; }
 
     void invalidate_style(StyleInvalidationReason);
+    // Only invalidates the elements covered by the given invalidation set, rather than everything invalidate_style(StyleInvalidationReason) would.
+    void invalidate_style(StyleInvalidationReason, CSS::InvalidationSet const&);
 
     void set_document(Badge<Document>, Document&);
 
@@ -755,6 +764,8 @@ protected:
 
     UniqueNodeID m_unique_id;
 
+    u64 m_dom_tree_version { 0 };
+
     // https://dom.spec.whatwg.org/#registered-observer-list
     // "Nodes have a strong reference to registered observers in their registered observer list." https://dom.spec.whatwg.org/#garbage-collection
     OwnPtr<Vector<JS::NonnullGCPtr<RegisteredObserver>>> m_registered_observer_list;
@@ -764,6 +775,8 @@ protected:
     ErrorOr<String> name_or_description(NameOrDescription, Document const&, HashTable<UniqueNodeID>&) const;
 
 private:
+    void mark_inclusive_subtree_for_style_update();
+
     void queue_tree_mutation_record(Vector<JS::Handle<Node>> added_nodes, Vector<JS::Handle<Node>> removed_nodes, Node* previous_sibling, Node* next_sibling);
 
     void insert_before_impl(JS::NonnullGCPtr<Node>, JS::GCPtr<Node> child);
@@ -23,6 +23,20 @@ namespace Web::DOM {
 
 JS_DEFINE_ALLOCATOR(ParentNode);
 
+// If the selector list consists of nothing but an ID selector, like "#foo", returns that ID.
+static Optional<FlyString> lone_id_selector(CSS::SelectorList const& selectors)
+{
+    if (selectors.size() != 1 || selectors.first()->pseudo_element().has_value())
+        return {};
+    auto const& compound_selectors = selectors.first()->compound_selectors();
+    if (compound_selectors.size() != 1 || compound_selectors.first().simple_selectors.size() != 1)
+        return {};
+    auto const& simple_selector = compound_selectors.first().simple_selectors.first();
+    if (simple_selector.type != CSS::Selector::SimpleSelector::Type::Id)
+        return {};
+    return simple_selector.name();
+}
+
 // https://dom.spec.whatwg.org/#dom-parentnode-queryselector
 WebIDL::ExceptionOr<JS::GCPtr<Element>> ParentNode::query_selector(StringView selector_text)
 {
@@ -32,7 +46,7 @@ WebIDL::ExceptionOr<JS::GCPtr<Element>> ParentNode::query_selector(StringView se
     // https://dom.spec.whatwg.org/#scope-match-a-selectors-string
     // To scope-match a selectors string selectors against a node, run these steps:
     // 1. Let s be the result of parse a selector selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingContext(*this), selector_text);
+    auto maybe_selectors = document().parse_selector_for_dom_api(selector_text);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
@@ -41,6 +55,16 @@ WebIDL::ExceptionOr<JS::GCPtr<Element>> ParentNode::query_selector(StringView se
     auto selectors = maybe_selectors.value();
 
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
+    // OPTIMIZATION: The ID map of our root knows where the elements with a given ID are, so we only have to walk the tree
+    //               if the first of them isn't one of our descendants.
+    if (auto id = lone_id_selector(selectors); id.has_value()) {
+        if (auto* element_by_id_map = ElementByIdMap::for_root(root())) {
+            auto element = element_by_id_map->get(*id);
+            if (!element || element->is_descendant_of(*this))
+                return element;
+        }
+    }
+
     JS::GCPtr<Element> result;
     // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
     for_each_in_subtree_of_type<Element>([&](auto& element) {
@@ -64,7 +88,7 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<NodeList>> ParentNode::query_selector_all(S
     // https://dom.spec.whatwg.org/#scope-match-a-selectors-string
     // To scope-match a selectors string selectors against a node, run these steps:
     // 1. Let s be the result of parse a selector selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingContext(*this), selector_text);
+    auto maybe_selectors = document().parse_selector_for_dom_api(selector_text);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
@@ -74,6 +98,17 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<NodeList>> ParentNode::query_selector_all(S
 
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
     Vector<JS::Handle<Node>> elements;
+    // OPTIMIZATION: The ID map of our root already knows all elements with a given ID, in tree order.
+    if (auto id = lone_id_selector(selectors); id.has_value()) {
+        if (auto* element_by_id_map = ElementByIdMap::for_root(root())) {
+            for (auto& element : element_by_id_map->get_all(*id)) {
+                if (element->is_descendant_of(*this))
+                    elements.append(element.ptr());
+            }
+            return StaticNodeList::create(realm(), move(elements));
+        }
+    }
+
     // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
     for_each_in_subtree_of_type<Element>([&](auto& element) {
         for (auto& selector : selectors) {
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObject.h>
+#include <AK/StringBuilder.h>
+#include <LibWeb/DOM/RenderingStatistics.h>
+
+namespace Web::DOM {
+
+String RenderingStatistics::to_json() const
+{
+    JsonObject style_invalidations;
+    for (size_t reason = 0; reason < style_invalidations_by_reason.size(); ++reason) {
+        if (style_invalidations_by_reason[reason] != 0)
+            style_invalidations.set(to_string(static_cast<StyleInvalidationReason>(reason)), style_invalidations_by_reason[reason]);
+    }
+
+    JsonObject statistics;
+    statistics.set("styleUpdates"sv, style_updates);
+    statistics.set("elementsStyled"sv, elements_styled);
+    statistics.set("rulesConsidered"sv, rules_considered);
+    statistics.set("rulesRejectedBySubjectFilter"sv, rules_rejected_by_subject_filter);
+    statistics.set("rulesRejectedByAncestorFilter"sv, rules_rejected_by_ancestor_filter);
+    statistics.set("rulesMatchedAgainstElements"sv, rules_matched_against_elements);
+    statistics.set("styleUpdateTime"sv, time_spent_updating_style.to_microseconds());
+    statistics.set("styleUpdateCellsAllocated"sv, cells_allocated_updating_style);
+    statistics.set("styleInvalidations"sv, move(style_invalidations));
+    statistics.set("layoutUpdates"sv, layout_updates);
+    statistics.set("layoutTreeBuilds"sv, layout_tree_builds);
+    statistics.set("layoutSubtreeRebuilds"sv, layout_subtree_rebuilds);
+    statistics.set("layoutNodesBuilt"sv, layout_nodes_built);
+    statistics.set("layoutUpdateTime"sv, time_spent_updating_layout.to_microseconds());
+    statistics.set("layoutUpdateCellsAllocated"sv, cells_allocated_updating_layout);
+    statistics.set("displayListRecordings"sv, display_list_recordings);
+    statistics.set("displayListRecordTime"sv, time_spent_recording_display_lists.to_microseconds());
+    statistics.set("displayListRecordCellsAllocated"sv, cells_allocated_recording_display_lists);
+    statistics.set("displayListReplays"sv, display_list_replays);
+    statistics.set("partialDisplayListReplays"sv, partial_display_list_replays);
+    statistics.set("displayListReplayTime"sv, time_spent_replaying_display_lists.to_microseconds());
+
+    StringBuilder builder;
+    statistics.serialize(builder);
+    return MUST(builder.to_string());
+}
+
+}
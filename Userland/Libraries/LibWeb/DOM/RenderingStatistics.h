@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <LibWeb/DOM/Node.h>
+
+namespace Web::DOM {
+
+// Counts the work that was done to keep a document's style and layout up to date, so that we can tell why a frame was slow.
+struct RenderingStatistics {
+#define __ENUMERATE_STYLE_INVALIDATION_REASON(reason) +1
+    static constexpr size_t style_invalidation_reason_count = 0 ENUMERATE_STYLE_INVALIDATION_REASONS(__ENUMERATE_STYLE_INVALIDATION_REASON);
+#undef __ENUMERATE_STYLE_INVALIDATION_REASON
+
+    u64 style_updates { 0 };
+    u64 elements_styled { 0 };
+    // Every rule that the rule cache offered for some element.
+    u64 rules_considered { 0 };
+    u64 rules_rejected_by_subject_filter { 0 };
+    u64 rules_rejected_by_ancestor_filter { 0 };
+    // The rules whose selectors we actually had to match against some element.
+    u64 rules_matched_against_elements { 0 };
+    AK::Duration time_spent_updating_style;
+    u64 cells_allocated_updating_style { 0 };
+
+    Array<u64, style_invalidation_reason_count> style_invalidations_by_reason {};
+
+    u64 layout_updates { 0 };
+    u64 layout_tree_builds { 0 };
+    // Rebuilds of the layout nodes for the contents of a single element, see Document::invalidate_layout_tree_for_subtree_of().
+    u64 layout_subtree_rebuilds { 0 };
+    u64 layout_nodes_built { 0 };
+    AK::Duration time_spent_updating_layout;
+    u64 cells_allocated_updating_layout { 0 };
+
+    u64 display_list_recordings { 0 };
+    AK::Duration time_spent_recording_display_lists;
+    u64 cells_allocated_recording_display_lists { 0 };
+
+    u64 display_list_replays { 0 };
+    // The replays that only repainted the part of the viewport that changed since the previous frame.
+    u64 partial_display_list_replays { 0 };
+    AK::Duration time_spent_replaying_display_lists;
+
+    // Serializes the statistics as a JSON object, with times in microseconds.
+    String to_json() const;
+};
+
+}
@@ -9,6 +9,7 @@
 
 #include <AK/Base64.h>
 #include <AK/Debug.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <LibJS/Runtime/Completion.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -21,6 +22,7 @@
 #include <LibWeb/Fetch/Fetching/Fetching.h>
 #include <LibWeb/Fetch/Fetching/PendingResponse.h>
 #include <LibWeb/Fetch/Fetching/RefCountedFlag.h>
+#include <LibWeb/Fetch/Infrastructure/ConnectionTimingInfo.h>
 #include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
 #include <LibWeb/Fetch/Infrastructure/FetchParams.h>
@@ -50,6 +52,7 @@
 #include <LibWeb/MixedContent/AbstractOperations.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/ReferrerPolicy/AbstractOperations.h>
+#include <LibWeb/ResourceTiming/PerformanceResourceTiming.h>
 #include <LibWeb/SRI/SRI.h>
 #include <LibWeb/SecureContexts/AbstractOperations.h>
 #include <LibWeb/Streams/TransformStream.h>
@@ -666,13 +669,18 @@ void fetch_response_handover(JS::Realm& realm, Infrastructure::FetchParams const
                     body_info.content_type = MimeSniff::minimise_a_supported_mime_type(mime_type.value());
             }
 
-            // FIXME: 8. If fetchParams’s request’s initiator type is not null, then mark resource timing given timingInfo,
-            //           request’s URL, request’s initiator type, global, cacheState, bodyInfo, and responseStatus.
-            (void)timing_info;
-            (void)global;
-            (void)cache_state;
-            (void)body_info;
-            (void)response_status;
+            // 8. If fetchParams’s request’s initiator type is not null, then mark resource timing given timingInfo,
+            //    request’s URL, request’s initiator type, global, cacheState, bodyInfo, and responseStatus.
+            if (auto const& initiator_type = fetch_params.request()->initiator_type(); initiator_type.has_value()) {
+                ResourceTiming::PerformanceResourceTiming::mark_resource_timing(
+                    timing_info,
+                    MUST(String::from_byte_string(fetch_params.request()->url().serialize())),
+                    MUST(String::from_utf8(Infrastructure::request_initiator_type_to_string(*initiator_type))),
+                    const_cast<JS::Object&>(global),
+                    cache_state,
+                    move(body_info),
+                    response_status);
+            }
         });
 
         // 4. Let processResponseEndOfBodyTask be the following steps:
@@ -1301,6 +1309,14 @@ WebIDL::ExceptionOr<JS::GCPtr<PendingResponse>> http_redirect_fetch(JS::Realm& r
     return main_fetch(realm, fetch_params, recursive);
 }
 
+// NOTE: The HTTP cache is shared by every document in the process, so we bound the amount of memory it may use, and
+//       evict the least recently used responses when it grows past that.
+static constexpr u64 maximum_http_cache_size = 64 * MiB;
+static u64 s_http_cache_size = 0;
+static u64 s_http_cache_access_generation = 0;
+
+static void evict_least_recently_used_http_cache_responses_if_needed();
+
 class CachedResponse : public RefCounted<CachedResponse> {
 public:
     HTTP::HeaderMap headers;
@@ -1310,12 +1326,23 @@ public:
     Infrastructure::Status status;
     URL::URL url;
     UnixDateTime current_age;
+
+    // The request header fields nominated by the stored response's `Vary` header, along with their values in the
+    // request that led to the response being stored.
+    struct VaryingHeader {
+        ByteBuffer name;
+        Optional<ByteBuffer> value;
+    };
+    Vector<VaryingHeader> varying_headers;
+    bool varies_on_everything { false };
+
+    mutable u64 last_access_generation { 0 };
 };
 
 class CachePartition : public RefCounted<CachePartition> {
 public:
     // https://httpwg.org/specs/rfc9111.html#constructing.responses.from.caches
-    JS::GCPtr<Infrastructure::Response> select_response(JS::Realm& realm, URL::URL const& url, ReadonlyBytes method, Vector<Infrastructure::Header> const& headers) const
+    JS::GCPtr<Infrastructure::Response> select_response(JS::Realm& realm, URL::URL const& url, ReadonlyBytes method, Infrastructure::HeaderList const& headers) const
     {
         // When presented with a request, a cache MUST NOT reuse a stored response unless:
 
@@ -1333,8 +1360,11 @@ public:
             return {};
         }
 
-        // FIXME: - request header fields nominated by the stored response (if any) match those presented (see Section 4.1), and
-        (void)headers;
+        // - request header fields nominated by the stored response (if any) match those presented (see Section 4.1), and
+        if (!request_matches_varying_headers(cached_response, headers)) {
+            dbgln("\033[31;1mHTTP CACHE MISS!\033[0m (Vary mismatch) {}", url);
+            return {};
+        }
 
         // FIXME: - the stored response does not contain the no-cache directive (Section 5.2.2.4), unless it is successfully validated (Section 4.3), and
         //          the stored response is one of the following:
@@ -1343,6 +1373,7 @@ public:
         //          + successfully validated (see Section 4.3).
 
         dbgln("\033[32;1mHTTP CACHE HIT!\033[0m {}", url);
+        cached_response.last_access_generation = ++s_http_cache_access_generation;
 
         auto [body, _] = MUST(extract_body(realm, ReadonlyBytes(cached_response.body)));
         auto response = Infrastructure::Response::create(realm.vm());
@@ -1368,7 +1399,34 @@ public:
         cached_response->status = response.status();
         cached_response->url = http_request.current_url();
         cached_response->current_age = UnixDateTime::now();
+        store_varying_headers(http_request, *cached_response);
+        cached_response->last_access_generation = ++s_http_cache_access_generation;
+
+        // NOTE: Don't let a single response push everything else out of the cache.
+        if (cached_response->body.size() > maximum_http_cache_size / 4)
+            return;
+
+        remove_response(http_request.current_url());
+        s_http_cache_size += cached_response->body.size();
         m_cache.set(http_request.current_url(), move(cached_response));
+
+        evict_least_recently_used_http_cache_responses_if_needed();
+    }
+
+    void remove_response(URL::URL const& url)
+    {
+        auto it = m_cache.find(url);
+        if (it == m_cache.end())
+            return;
+        s_http_cache_size -= it->value->body.size();
+        m_cache.remove(it);
+    }
+
+    template<typename Callback>
+    void for_each_response(Callback callback) const
+    {
+        for (auto const& it : m_cache)
+            callback(*it.value);
     }
 
     // https://httpwg.org/specs/rfc9111.html#freshening.responses
@@ -1385,6 +1443,46 @@ public:
     }
 
 private:
+    // https://httpwg.org/specs/rfc9111.html#caching.negotiated.responses
+    static void store_varying_headers(Infrastructure::Request const& http_request, CachedResponse& cached_response)
+    {
+        auto vary = cached_response.headers.get("Vary"sv);
+        if (!vary.has_value())
+            return;
+
+        for (auto name : vary->split_view(',')) {
+            name = name.trim_whitespace();
+            if (name.is_empty())
+                continue;
+
+            // A stored response with a Vary header field value containing a member "*" always fails to match.
+            if (name == "*"sv) {
+                cached_response.varies_on_everything = true;
+                cached_response.varying_headers.clear();
+                return;
+            }
+
+            cached_response.varying_headers.append({
+                .name = MUST(ByteBuffer::copy(name.bytes())),
+                .value = http_request.header_list()->get(name.bytes()),
+            });
+        }
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#caching.negotiated.responses
+    static bool request_matches_varying_headers(CachedResponse const& cached_response, Infrastructure::HeaderList const& headers)
+    {
+        if (cached_response.varies_on_everything)
+            return false;
+
+        // FIXME: The header field values are compared byte for byte, without normalizing whitespace or the order of list members.
+        for (auto const& varying_header : cached_response.varying_headers) {
+            if (headers.get(varying_header.name) != varying_header.value)
+                return false;
+        }
+        return true;
+    }
+
     // https://httpwg.org/specs/rfc9111.html#update
     void update_stored_header_fields(Infrastructure::Response const& response, HTTP::HeaderMap& headers)
     {
@@ -1503,10 +1601,41 @@ public:
         return s_cache;
     }
 
+    void evict_least_recently_used_responses_if_needed()
+    {
+        if (s_http_cache_size <= maximum_http_cache_size)
+            return;
+
+        struct EvictionCandidate {
+            u64 last_access_generation { 0 };
+            CachePartition* partition { nullptr };
+            URL::URL url;
+        };
+        Vector<EvictionCandidate> candidates;
+        for (auto& it : m_cache) {
+            it.value->for_each_response([&](CachedResponse const& cached_response) {
+                candidates.append({ cached_response.last_access_generation, it.value.ptr(), cached_response.url });
+            });
+        }
+        quick_sort(candidates, [](auto const& a, auto const& b) { return a.last_access_generation < b.last_access_generation; });
+
+        // NOTE: Evict down to 3/4 of the budget, so we aren't doing this again for every response that is stored.
+        for (auto& candidate : candidates) {
+            if (s_http_cache_size <= maximum_http_cache_size / 4 * 3)
+                break;
+            candidate.partition->remove_response(candidate.url);
+        }
+    }
+
 private:
     HashMap<Infrastructure::NetworkPartitionKey, NonnullRefPtr<CachePartition>> m_cache;
 };
 
+static void evict_least_recently_used_http_cache_responses_if_needed()
+{
+    HTTPCache::the().evict_least_recently_used_responses_if_needed();
+}
+
 // https://fetch.spec.whatwg.org/#determine-the-http-cache-partition
 static RefPtr<CachePartition> determine_the_http_cache_partition(Infrastructure::Request const& request)
 {
@@ -2127,6 +2256,146 @@ static void log_response(auto const& status_code, auto const& headers, auto cons
 #endif
 
 // https://fetch.spec.whatwg.org/#concept-http-network-fetch
+// AD-HOC: How much the request matters for getting the page on screen, so that RequestServer can prioritize it against
+//         the other requests that share its connection.
+static RequestServer::RequestPriority network_priority_for_request(Infrastructure::Request const& request)
+{
+    using RequestServer::RequestPriority;
+
+    if (request.initiator() == Infrastructure::Request::Initiator::Prefetch || request.initiator() == Infrastructure::Request::Initiator::Prerender)
+        return RequestPriority::Lowest;
+
+    auto priority = RequestPriority::Medium;
+    if (request.render_blocking()) {
+        priority = RequestPriority::Highest;
+    } else if (request.destination().has_value()) {
+        switch (*request.destination()) {
+        case Infrastructure::Request::Destination::Document:
+        case Infrastructure::Request::Destination::Frame:
+        case Infrastructure::Request::Destination::IFrame:
+        case Infrastructure::Request::Destination::Style:
+            priority = RequestPriority::Highest;
+            break;
+        case Infrastructure::Request::Destination::Script:
+        case Infrastructure::Request::Destination::Font:
+        case Infrastructure::Request::Destination::Worker:
+        case Infrastructure::Request::Destination::SharedWorker:
+        case Infrastructure::Request::Destination::ServiceWorker:
+        case Infrastructure::Request::Destination::XSLT:
+            priority = RequestPriority::High;
+            break;
+        case Infrastructure::Request::Destination::Image:
+        case Infrastructure::Request::Destination::Audio:
+        case Infrastructure::Request::Destination::Video:
+        case Infrastructure::Request::Destination::Track:
+            priority = RequestPriority::Low;
+            break;
+        case Infrastructure::Request::Destination::Report:
+            priority = RequestPriority::Lowest;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // https://fetch.spec.whatwg.org/#request-priority
+    // NOTE: The fetchpriority hint moves the request up or down a level from where its destination puts it.
+    if (request.priority() == Infrastructure::Request::Priority::High && priority != RequestPriority::Highest)
+        priority = static_cast<RequestPriority>(to_underlying(priority) + 1);
+    else if (request.priority() == Infrastructure::Request::Priority::Low && priority != RequestPriority::Lowest)
+        priority = static_cast<RequestPriority>(to_underlying(priority) - 1);
+    return priority;
+}
+
+// https://fetch.spec.whatwg.org/#clamp-and-coarsen-connection-timing-info
+static JS::NonnullGCPtr<Infrastructure::ConnectionTimingInfo> clamp_and_coarsen_connection_timing_info(JS::VM& vm, Infrastructure::ConnectionTimingInfo const& timing_info, HighResolutionTime::DOMHighResTimeStamp default_start_time, bool cross_origin_isolated_capability)
+{
+    auto clamped_timing_info = Infrastructure::ConnectionTimingInfo::create(vm);
+
+    // 1. If timingInfo’s connection start time is less than defaultStartTime, then return a new connection timing info
+    //    whose domain lookup start time is defaultStartTime, domain lookup end time is defaultStartTime, connection
+    //    start time is defaultStartTime, connection end time is defaultStartTime, secure connection start time is
+    //    defaultStartTime, and ALPN negotiated protocol is timingInfo’s ALPN negotiated protocol.
+    if (timing_info.connection_start_time() < default_start_time) {
+        clamped_timing_info->set_domain_lookup_start_time(default_start_time);
+        clamped_timing_info->set_domain_lookup_end_time(default_start_time);
+        clamped_timing_info->set_connection_start_time(default_start_time);
+        clamped_timing_info->set_connection_end_time(default_start_time);
+        clamped_timing_info->set_secure_connection_start_time(default_start_time);
+        clamped_timing_info->set_lpn_negotiated_protocol(MUST(ByteBuffer::copy(timing_info.lpn_negotiated_protocol())));
+        return clamped_timing_info;
+    }
+
+    // 2. Return a new connection timing info whose domain lookup start time is the result of coarsen time given
+    //    timingInfo’s domain lookup start time and crossOriginIsolatedCapability, domain lookup end time is the result
+    //    of coarsen time given timingInfo’s domain lookup end time and crossOriginIsolatedCapability, connection start
+    //    time is the result of coarsen time given timingInfo’s connection start time and crossOriginIsolatedCapability,
+    //    connection end time is the result of coarsen time given timingInfo’s connection end time and
+    //    crossOriginIsolatedCapability, secure connection start time is the result of coarsen time given timingInfo’s
+    //    connection end time and crossOriginIsolatedCapability, and ALPN negotiated protocol is timingInfo’s ALPN
+    //    negotiated protocol.
+    clamped_timing_info->set_domain_lookup_start_time(HighResolutionTime::coarsen_time(timing_info.domain_lookup_start_time(), cross_origin_isolated_capability));
+    clamped_timing_info->set_domain_lookup_end_time(HighResolutionTime::coarsen_time(timing_info.domain_lookup_end_time(), cross_origin_isolated_capability));
+    clamped_timing_info->set_connection_start_time(HighResolutionTime::coarsen_time(timing_info.connection_start_time(), cross_origin_isolated_capability));
+    clamped_timing_info->set_connection_end_time(HighResolutionTime::coarsen_time(timing_info.connection_end_time(), cross_origin_isolated_capability));
+    clamped_timing_info->set_secure_connection_start_time(HighResolutionTime::coarsen_time(timing_info.secure_connection_start_time(), cross_origin_isolated_capability));
+    clamped_timing_info->set_lpn_negotiated_protocol(MUST(ByteBuffer::copy(timing_info.lpn_negotiated_protocol())));
+    return clamped_timing_info;
+}
+
+// AD-HOC: Fills in the parts of fetchParams’s timing info that only the connection knows about, from what RequestServer
+//         measured while it was handling the request.
+static void update_timing_info_from_network(JS::VM& vm, Infrastructure::FetchParams const& fetch_params, Requests::RequestTimingInfo const& network_timing_info)
+{
+    if (!network_timing_info.start_time.has_value() || network_timing_info.cache_state == Requests::RequestTimingInfo::CacheState::Local)
+        return;
+
+    auto timing_info = fetch_params.timing_info();
+    bool const cross_origin_isolated_capability = fetch_params.cross_origin_isolated_capability() == HTML::CanUseCrossOriginIsolatedAPIs::Yes;
+
+    // NOTE: These are on the same clock as the unsafe shared current time.
+    auto start_time = network_timing_info.start_time->nanoseconds() / 1.0e6;
+    auto time_at_offset = [&](i64 microseconds) -> HighResolutionTime::DOMHighResTimeStamp {
+        return start_time + static_cast<double>(microseconds) / 1000.0;
+    };
+
+    auto connection_timing_info = Infrastructure::ConnectionTimingInfo::create(vm);
+    if (!network_timing_info.connection_was_reused) {
+        connection_timing_info->set_domain_lookup_start_time(start_time);
+        connection_timing_info->set_domain_lookup_end_time(time_at_offset(network_timing_info.domain_lookup_end_microseconds));
+        connection_timing_info->set_connection_start_time(time_at_offset(network_timing_info.domain_lookup_end_microseconds));
+        if (network_timing_info.secure_connect_end_microseconds > 0) {
+            connection_timing_info->set_secure_connection_start_time(time_at_offset(network_timing_info.connect_end_microseconds));
+            connection_timing_info->set_connection_end_time(time_at_offset(network_timing_info.secure_connect_end_microseconds));
+        } else {
+            connection_timing_info->set_connection_end_time(time_at_offset(network_timing_info.connect_end_microseconds));
+        }
+    }
+    connection_timing_info->set_lpn_negotiated_protocol(MUST(ByteBuffer::copy(network_timing_info.protocol.bytes())));
+
+    // 11. Set timingInfo’s final connection timing info to the result of calling clamp and coarsen connection timing
+    //     info with connection’s timing info, timingInfo’s post-redirect start time, and fetchParams’s cross-origin
+    //     isolated capability.
+    timing_info->set_final_connection_timing_info(clamp_and_coarsen_connection_timing_info(vm, connection_timing_info, timing_info->post_redirect_start_time(), cross_origin_isolated_capability));
+
+    // NOTE: The user agent sets these when it starts sending the request and when it receives the first byte of the response.
+    timing_info->set_final_network_request_start_time(HighResolutionTime::coarsen_time(time_at_offset(network_timing_info.request_start_microseconds), cross_origin_isolated_capability));
+    timing_info->set_final_network_response_start_time(HighResolutionTime::coarsen_time(time_at_offset(network_timing_info.response_start_microseconds), cross_origin_isolated_capability));
+}
+
+static Optional<Infrastructure::Response::CacheState> cache_state_from_network(Requests::RequestTimingInfo const& network_timing_info)
+{
+    switch (network_timing_info.cache_state) {
+    case Requests::RequestTimingInfo::CacheState::None:
+        return {};
+    case Requests::RequestTimingInfo::CacheState::Local:
+        return Infrastructure::Response::CacheState::Local;
+    case Requests::RequestTimingInfo::CacheState::Validated:
+        return Infrastructure::Response::CacheState::Validated;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 // Drop-in replacement for 'HTTP-network fetch', but obviously non-standard :^)
 // It also handles file:// URLs since those can also go through ResourceLoader.
 WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_loader_file_or_http_network_fetch(JS::Realm& realm, Infrastructure::FetchParams const& fetch_params, IncludeCredentials include_credentials, IsNewConnectionFetch is_new_connection_fetch)
@@ -2148,6 +2417,7 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
     load_request.set_url(request->current_url());
     load_request.set_page(page);
     load_request.set_method(ByteString::copy(request->method()));
+    load_request.set_priority(network_priority_for_request(*request));
 
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
@@ -2249,6 +2519,7 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
                 // FIXME: 2. Let codings be the result of extracting header list values given `Content-Encoding` and response’s header list.
                 // FIXME: 3. Increase response’s body info’s encoded size by bytes’s length.
                 // FIXME: 4. Set bytes to the result of handling content codings given codings and bytes.
+                // NOTE: Until then, RequestServer decodes the content codings for us, incrementally as the bytes arrive.
                 // FIXME: 5. Increase response’s body info’s decoded size by bytes’s length.
                 // FIXME: 6. If bytes is failure, then terminate fetchParams’s controller.
 
@@ -2260,9 +2531,11 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
             }
         };
 
-        auto on_complete = [&vm, &realm, pending_response, stream](auto success, auto error_message) {
+        auto on_complete = [&vm, &realm, &fetch_params, pending_response, stream](auto success, auto const& network_timing_info, auto error_message) {
             HTML::TemporaryExecutionContext execution_context { Bindings::host_defined_environment_settings_object(realm), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
 
+            update_timing_info_from_network(vm, fetch_params, network_timing_info);
+
             // 16.1.1.2. Otherwise, if the bytes transmission for response’s message body is done normally and stream is readable,
             //           then close stream, and abort these in-parallel steps.
             if (success) {
@@ -2281,16 +2554,23 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
             }
         };
 
-        ResourceLoader::the().load_unbuffered(load_request, move(on_headers_received), move(on_data_received), move(on_complete));
+        fetch_params.controller()->set_network_load(ResourceLoader::the().load_unbuffered(load_request, move(on_headers_received), move(on_data_received), move(on_complete)));
     } else {
-        auto on_load_success = [&realm, &vm, request, pending_response](auto data, auto& response_headers, auto status_code) {
+        auto on_load_success = [&realm, &vm, &fetch_params, request, pending_response](auto data, auto& response_headers, auto status_code, auto const& network_timing_info) {
             dbgln_if(WEB_FETCH_DEBUG, "Fetch: ResourceLoader load for '{}' complete", request->url());
             if constexpr (WEB_FETCH_DEBUG)
                 log_response(status_code, response_headers, data);
+            update_timing_info_from_network(vm, fetch_params, network_timing_info);
             auto [body, _] = TRY_OR_IGNORE(extract_body(realm, data));
             auto response = Infrastructure::Response::create(vm);
             response->set_status(status_code.value_or(200));
             response->set_body(move(body));
+            response->set_cache_state(cache_state_from_network(network_timing_info));
+            response->set_body_info({
+                .encoded_size = network_timing_info.encoded_body_size > 0 ? network_timing_info.encoded_body_size : data.size(),
+                .decoded_size = data.size(),
+                .content_type = {},
+            });
             for (auto const& [name, value] : response_headers.headers()) {
                 auto header = Infrastructure::Header::from_string_pair(name, value);
                 response->header_list()->append(move(header));
@@ -2299,10 +2579,11 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
             pending_response->resolve(response);
         };
 
-        auto on_load_error = [&realm, &vm, request, pending_response](auto& error, auto status_code, auto data, auto& response_headers) {
+        auto on_load_error = [&realm, &vm, &fetch_params, request, pending_response](auto& error, auto status_code, auto data, auto& response_headers, auto const& network_timing_info) {
             dbgln_if(WEB_FETCH_DEBUG, "Fetch: ResourceLoader load for '{}' failed: {} (status {})", request->url(), error, status_code.value_or(0));
             if constexpr (WEB_FETCH_DEBUG)
                 log_response(status_code, response_headers, data);
+            update_timing_info_from_network(vm, fetch_params, network_timing_info);
             auto response = Infrastructure::Response::create(vm);
             // FIXME: This is ugly, ResourceLoader should tell us.
             if (status_code.value_or(0) == 0) {
@@ -2321,7 +2602,7 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
             pending_response->resolve(response);
         };
 
-        ResourceLoader::the().load(load_request, move(on_load_success), move(on_load_error));
+        fetch_params.controller()->set_network_load(ResourceLoader::the().load(load_request, move(on_load_success), move(on_load_error)));
     }
 
     return pending_response;
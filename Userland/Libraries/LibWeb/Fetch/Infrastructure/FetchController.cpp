@@ -10,6 +10,7 @@
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
 #include <LibWeb/Fetch/Infrastructure/FetchParams.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/WebIDL/DOMException.h>
 
 namespace Web::Fetch::Infrastructure {
@@ -18,6 +19,8 @@ JS_DEFINE_ALLOCATOR(FetchController);
 
 FetchController::FetchController() = default;
 
+FetchController::~FetchController() = default;
+
 JS::NonnullGCPtr<FetchController> FetchController::create(JS::VM& vm)
 {
     return vm.heap().allocate_without_realm<FetchController>();
@@ -119,6 +122,16 @@ void FetchController::stop_fetch()
         auto fetch_algorithms = FetchAlgorithms::create(vm, {});
         m_fetch_params->set_algorithms(fetch_algorithms);
     }
+
+    // NOTE: Nobody is interested in the response anymore, so there's no need to keep loading it. This also takes the
+    //       load out of ResourceLoader's queue if it hasn't been started yet.
+    if (auto network_load = move(m_network_load))
+        network_load->cancel();
+}
+
+void FetchController::set_network_load(RefPtr<NetworkLoad> network_load)
+{
+    m_network_load = move(network_load);
 }
 
 void FetchController::fetch_task_queued(u64 fetch_task_id, HTML::TaskID event_id)
@@ -33,6 +33,7 @@ public:
     };
 
     [[nodiscard]] static JS::NonnullGCPtr<FetchController> create(JS::VM&);
+    virtual ~FetchController() override;
 
     void set_full_timing_info(JS::NonnullGCPtr<FetchTimingInfo> full_timing_info) { m_full_timing_info = full_timing_info; }
     void set_report_timing_steps(Function<void(JS::Object const&)> report_timing_steps);
@@ -50,6 +51,8 @@ public:
 
     void stop_fetch();
 
+    void set_network_load(RefPtr<NetworkLoad>);
+
     u64 next_fetch_task_id() { return m_next_fetch_task_id++; }
     void fetch_task_queued(u64 fetch_task_id, HTML::TaskID event_id);
     void fetch_task_complete(u64 fetch_task_id);
@@ -85,6 +88,9 @@ private:
 
     JS::GCPtr<FetchParams> m_fetch_params;
 
+    // The network load that ResourceLoader is performing for this fetch, if any.
+    RefPtr<NetworkLoad> m_network_load;
+
     HashMap<u64, HTML::TaskID> m_ongoing_fetch_tasks;
     u64 m_next_fetch_task_id { 0 };
 };
@@ -5,6 +5,7 @@
  */
 
 #include <LibJS/Runtime/PromiseCapability.h>
+#include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Fetch/BodyInit.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
@@ -87,21 +88,49 @@ void Body::fully_read(JS::Realm& realm, Web::Fetch::Infrastructure::Body::Proces
         }));
     };
 
-    // 4. Let reader be the result of getting a reader for body’s stream. If that threw an exception, then run errorSteps with that exception and return.
-    // 5. Read all bytes from reader, given successSteps and errorSteps.
-    // FIXME: Use streams for these steps.
-    m_source.visit(
+    // NOTE: If the body's bytes are already at hand, we hand them over directly rather than reading them back out of the
+    //       stream.
+    auto handled_source = m_source.visit(
         [&](ByteBuffer const& byte_buffer) {
             if (auto result = success_steps(byte_buffer); result.is_error())
                 error_steps(WebIDL::UnknownError::create(realm, "Out-of-memory"_string));
+            return true;
         },
         [&](JS::Handle<FileAPI::Blob> const& blob) {
             if (auto result = success_steps(blob->raw_bytes()); result.is_error())
                 error_steps(WebIDL::UnknownError::create(realm, "Out-of-memory"_string));
+            return true;
         },
         [&](Empty) {
-            error_steps(WebIDL::DOMException::create(realm, "DOMException"_fly_string, "Reading from Blob, FormData or null source is not yet implemented"_string));
+            return false;
         });
+    if (handled_source)
+        return;
+
+    HTML::TemporaryExecutionContext const execution_context { Bindings::host_defined_environment_settings_object(m_stream->realm()), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+
+    // 4. Let reader be the result of getting a reader for body’s stream. If that threw an exception, then run errorSteps with that exception and return.
+    auto reader = Streams::acquire_readable_stream_default_reader(m_stream);
+    if (reader.is_exception()) {
+        auto throw_completion = Bindings::dom_exception_to_throw_completion(realm.vm(), reader.release_error());
+        auto error = throw_completion.value().value_or(JS::js_undefined());
+        queue_fetch_task(*task_destination_object, JS::create_heap_function(realm.heap(), [process_body_error, error]() {
+            process_body_error->function()(error);
+        }));
+        return;
+    }
+
+    // 5. Read all bytes from reader, given successSteps and errorSteps.
+    auto read_all_success_steps = JS::create_heap_function(realm.heap(), [&realm, success_steps = move(success_steps), error_steps = move(error_steps)](ByteBuffer bytes) {
+        if (auto result = success_steps(bytes); result.is_error())
+            error_steps(WebIDL::UnknownError::create(realm, "Out-of-memory"_string));
+    });
+    auto read_all_failure_steps = JS::create_heap_function(realm.heap(), [&realm, process_body_error, task_destination_object](JS::Value error) {
+        queue_fetch_task(*task_destination_object, JS::create_heap_function(realm.heap(), [process_body_error, error]() {
+            process_body_error->function()(error);
+        }));
+    });
+    reader.value()->read_all_bytes(read_all_success_steps, read_all_failure_steps);
 }
 
 // https://fetch.spec.whatwg.org/#body-incrementally-read
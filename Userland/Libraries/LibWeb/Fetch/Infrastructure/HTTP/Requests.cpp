@@ -269,7 +269,7 @@ void Request::add_range_header(u64 first, Optional<u64> const& last)
     VERIFY(!last.has_value() || first <= last.value());
 
     // 2. Let rangeValue be `bytes=`.
-    auto range_value = MUST(ByteBuffer::copy("bytes"sv.bytes()));
+    auto range_value = MUST(ByteBuffer::copy("bytes="sv.bytes()));
 
     // 3. Serialize and isomorphic encode first, and append the result to rangeValue.
     range_value.append(String::number(first).bytes());
@@ -439,6 +439,55 @@ StringView request_mode_to_string(Request::Mode mode)
     VERIFY_NOT_REACHED();
 }
 
+StringView request_initiator_type_to_string(Request::InitiatorType initiator_type)
+{
+    switch (initiator_type) {
+    case Request::InitiatorType::Audio:
+        return "audio"sv;
+    case Request::InitiatorType::Beacon:
+        return "beacon"sv;
+    case Request::InitiatorType::Body:
+        return "body"sv;
+    case Request::InitiatorType::CSS:
+        return "css"sv;
+    case Request::InitiatorType::EarlyHint:
+        return "early-hint"sv;
+    case Request::InitiatorType::Embed:
+        return "embed"sv;
+    case Request::InitiatorType::Fetch:
+        return "fetch"sv;
+    case Request::InitiatorType::Font:
+        return "font"sv;
+    case Request::InitiatorType::Frame:
+        return "frame"sv;
+    case Request::InitiatorType::IFrame:
+        return "iframe"sv;
+    case Request::InitiatorType::Image:
+        return "image"sv;
+    case Request::InitiatorType::IMG:
+        return "img"sv;
+    case Request::InitiatorType::Input:
+        return "input"sv;
+    case Request::InitiatorType::Link:
+        return "link"sv;
+    case Request::InitiatorType::Object:
+        return "object"sv;
+    case Request::InitiatorType::Ping:
+        return "ping"sv;
+    case Request::InitiatorType::Script:
+        return "script"sv;
+    case Request::InitiatorType::Track:
+        return "track"sv;
+    case Request::InitiatorType::Video:
+        return "video"sv;
+    case Request::InitiatorType::XMLHttpRequest:
+        return "xmlhttprequest"sv;
+    case Request::InitiatorType::Other:
+        return "other"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 Optional<Request::Priority> request_priority_from_string(StringView string)
 {
     if (string.equals_ignoring_ascii_case("high"sv))
@@ -17,6 +17,7 @@ class DragAndDropEventHandler;
 class EditEventHandler;
 class EventHandler;
 class LoadRequest;
+class NetworkLoad;
 class Page;
 class PageClient;
 class PaintContext;
@@ -230,6 +231,7 @@ enum class PropertyID;
 
 struct BackgroundLayerData;
 struct CSSStyleSheetInit;
+struct InvalidationSet;
 struct StyleSheetIdentifier;
 }
 
@@ -252,6 +254,7 @@ class AbortSignal;
 class AbstractRange;
 class AccessibilityTreeNode;
 class Attr;
+class Attribute;
 class BeforeUnloadEvent;
 class CDATASection;
 class CharacterData;
@@ -372,6 +375,7 @@ struct DOMPointInit;
 }
 
 namespace Web::HTML {
+class AnimatedBitmapDecodedImageData;
 class AudioTrack;
 class AudioTrackList;
 class BroadcastChannel;
@@ -387,6 +391,7 @@ class CustomElementRegistry;
 class DataTransfer;
 class DataTransferItem;
 class DataTransferItemList;
+class DecodedImageBudget;
 class DecodedImageData;
 class DocumentState;
 class DOMParser;
@@ -473,6 +478,7 @@ class HTMLTemplateElement;
 class HTMLTextAreaElement;
 class HTMLTimeElement;
 class HTMLTitleElement;
+class HTMLTokenizer;
 class HTMLTrackElement;
 class HTMLUListElement;
 class HTMLUnknownElement;
@@ -497,6 +503,8 @@ class NavigationDestination;
 class NavigationHistoryEntry;
 class NavigationTransition;
 class Navigator;
+class OffscreenCanvas;
+class OffscreenCanvasRenderingContext2D;
 class PageTransitionEvent;
 class Path2D;
 class Plugin;
@@ -523,6 +531,7 @@ class UserActivation;
 class ValidityState;
 class VideoTrack;
 class VideoTrackList;
+class WebWorkerClient;
 class Window;
 class WindowEnvironmentSettingsObject;
 class WindowProxy;
@@ -559,9 +568,12 @@ class Performance;
 }
 
 namespace Web::IndexedDB {
+class Database;
+class IDBDatabase;
 class IDBFactory;
 class IDBOpenDBRequest;
 class IDBRequest;
+class IDBVersionChangeEvent;
 }
 
 namespace Web::Internals {
@@ -662,6 +674,8 @@ class AutoplayAllowlist;
 
 namespace Web::Platform {
 class AudioCodecPlugin;
+struct DecodedImage;
+class DecodingSession;
 class Timer;
 }
 
@@ -677,6 +691,10 @@ namespace Web::ResizeObserver {
 class ResizeObserver;
 }
 
+namespace Web::ResourceTiming {
+class PerformanceResourceTiming;
+}
+
 namespace Web::Selection {
 class Selection;
 }
@@ -7,31 +7,223 @@
 #include <LibGfx/Bitmap.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/Realm.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+#include <LibWeb/HTML/DecodedImageBudget.h>
 
 namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(AnimatedBitmapDecodedImageData);
 
-ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create(JS::Realm& realm, Vector<Frame>&& frames, size_t loop_count, bool animated)
+ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create(JS::Realm& realm, Vector<Frame>&& frames, size_t loop_count, bool animated, Gfx::IntSize natural_size)
 {
-    return realm.heap().allocate<AnimatedBitmapDecodedImageData>(realm, move(frames), loop_count, animated);
+    return realm.heap().allocate<AnimatedBitmapDecodedImageData>(realm, move(frames), loop_count, animated, nullptr, natural_size);
 }
 
-AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated)
+ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create_streamed(JS::Realm& realm, Vector<Frame>&& first_frames, size_t frame_count, size_t loop_count, NonnullRefPtr<Platform::FrameStream> frame_stream, Gfx::IntSize natural_size)
+{
+    VERIFY(!first_frames.is_empty());
+    VERIFY(first_frames.size() <= frame_count);
+
+    // NOTE: Until we've decoded a frame, we assume it shows as long as the first one.
+    auto first_frame_duration = first_frames.first().duration;
+    TRY(first_frames.try_resize(frame_count));
+    for (size_t i = 0; i < frame_count; ++i) {
+        if (!first_frames[i].bitmap)
+            first_frames[i].duration = first_frame_duration;
+    }
+
+    return realm.heap().allocate<AnimatedBitmapDecodedImageData>(realm, move(first_frames), loop_count, true, move(frame_stream), natural_size);
+}
+
+AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated, RefPtr<Platform::FrameStream> frame_stream, Gfx::IntSize natural_size)
     : m_frames(move(frames))
     , m_loop_count(loop_count)
     , m_animated(animated)
+    , m_size(natural_size.is_empty() ? m_frames.first().bitmap->size() : natural_size)
+    , m_frame_stream(move(frame_stream))
+{
+    if (m_frame_stream) {
+        // NOTE: The stream can't outlive us, as we hold its only reference, and we unhook ourselves when we go away.
+        m_frame_stream->on_frames_decoded = [this](size_t start_frame_index, Vector<Platform::Frame>& frames) {
+            did_decode_streamed_frames(start_frame_index, frames);
+        };
+    }
+}
+
+AnimatedBitmapDecodedImageData::~AnimatedBitmapDecodedImageData()
 {
+    if (m_frame_stream)
+        m_frame_stream->on_frames_decoded = nullptr;
 }
 
-AnimatedBitmapDecodedImageData::~AnimatedBitmapDecodedImageData() = default;
+void AnimatedBitmapDecodedImageData::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_document);
+}
+
+void AnimatedBitmapDecodedImageData::finalize()
+{
+    Base::finalize();
+    DecodedImageBudget::the().remove(*this);
+}
 
 RefPtr<Gfx::ImmutableBitmap> AnimatedBitmapDecodedImageData::bitmap(size_t frame_index, Gfx::IntSize) const
 {
     if (frame_index >= m_frames.size())
         return nullptr;
-    return m_frames[frame_index].bitmap;
+
+    if (m_frames_are_discarded) {
+        // NOTE: Asking for the bitmap is what makes us want it back, so the const_cast is only a formality.
+        const_cast<AnimatedBitmapDecodedImageData&>(*this).redecode_discarded_frames();
+        return nullptr;
+    }
+
+    if (!m_frame_stream) {
+        DecodedImageBudget::the().did_use(*this);
+        return m_frames[frame_index].bitmap;
+    }
+
+    update_streamed_frames(frame_index);
+
+    // NOTE: If the frame isn't there yet, we keep showing the last one, rather than nothing.
+    if (auto const& bitmap = m_frames[frame_index].bitmap)
+        m_last_returned_bitmap = bitmap;
+    return m_last_returned_bitmap;
+}
+
+void AnimatedBitmapDecodedImageData::update_streamed_frames(size_t current_frame_index) const
+{
+    if (m_current_streamed_frame_index == current_frame_index)
+        return;
+    m_current_streamed_frame_index = current_frame_index;
+
+    auto frame_count = m_frames.size();
+    auto distance_from_current_frame = [&](size_t frame_index) {
+        return (frame_index + frame_count - current_frame_index) % frame_count;
+    };
+
+    // Drop the frames that we've shown already, and that we're not going to show soon again.
+    for (size_t i = 0; i < frame_count; ++i) {
+        if (distance_from_current_frame(i) >= streamed_frame_window_size)
+            m_frames[i].bitmap = nullptr;
+    }
+
+    if (m_has_pending_frame_request || m_frame_stream_failed)
+        return;
+
+    // Ask for the first frame in the window we don't have, and those that come after it.
+    for (size_t distance = 0; distance < min(streamed_frame_window_size, frame_count); ++distance) {
+        auto frame_index = (current_frame_index + distance) % frame_count;
+        if (m_frames[frame_index].bitmap)
+            continue;
+
+        auto request_size = min(streamed_frame_window_size - distance, frame_count - frame_index);
+        m_has_pending_frame_request = true;
+        m_frame_stream->request_frames(frame_index, request_size);
+        return;
+    }
+}
+
+void AnimatedBitmapDecodedImageData::did_decode_streamed_frames(size_t start_frame_index, Vector<Platform::Frame>& frames)
+{
+    m_has_pending_frame_request = false;
+
+    // NOTE: If a frame fails to decode, asking for it again won't help, so we just keep showing what we've got.
+    if (frames.is_empty()) {
+        m_frame_stream_failed = true;
+        return;
+    }
+
+    for (size_t i = 0; i < frames.size() && start_frame_index + i < m_frames.size(); ++i) {
+        auto& frame = m_frames[start_frame_index + i];
+        frame.bitmap = Gfx::ImmutableBitmap::create(*frames[i].bitmap);
+        frame.duration = static_cast<int>(frames[i].duration);
+    }
+
+    // The current frame may have moved on while we were waiting, so see if there is more to ask for.
+    if (auto current_frame_index = m_current_streamed_frame_index; current_frame_index.has_value()) {
+        m_current_streamed_frame_index.clear();
+        update_streamed_frames(*current_frame_index);
+    }
+}
+
+size_t AnimatedBitmapDecodedImageData::size_in_bytes() const
+{
+    size_t size_in_bytes = 0;
+    for (auto const& frame : m_frames) {
+        if (frame.bitmap)
+            size_in_bytes += frame.bitmap->bitmap().size_in_bytes();
+    }
+    return size_in_bytes;
+}
+
+void AnimatedBitmapDecodedImageData::set_encoded_data(ByteBuffer encoded_data, DOM::Document& document)
+{
+    m_encoded_data = move(encoded_data);
+    m_document = document;
+
+    // NOTE: Streamed images only keep a few frames decoded anyway.
+    if (m_frame_stream || m_encoded_data.is_empty())
+        return;
+
+    m_decoded_size = m_frames.first().bitmap->size();
+    DecodedImageBudget::the().did_decode(*this, size_in_bytes());
+}
+
+void AnimatedBitmapDecodedImageData::discard_frames()
+{
+    VERIFY(!m_encoded_data.is_empty());
+
+    DecodedImageBudget::the().remove(*this);
+    for (auto& frame : m_frames)
+        frame.bitmap = nullptr;
+    m_frames_are_discarded = true;
+}
+
+void AnimatedBitmapDecodedImageData::redecode_discarded_frames()
+{
+    if (m_is_redecoding || m_redecoding_failed)
+        return;
+    m_is_redecoding = true;
+
+    // NOTE: If the image was decoded at a reduced size, that's still all we need.
+    Optional<Gfx::IntSize> ideal_size;
+    if (m_decoded_size != m_size)
+        ideal_size = m_decoded_size;
+
+    (void)Platform::ImageCodecPlugin::the().decode_image(
+        m_encoded_data,
+        [strong_this = JS::Handle(*this)](Platform::DecodedImage& result) -> ErrorOr<void> {
+            strong_this->did_redecode_frames(result);
+            return {};
+        },
+        [strong_this = JS::Handle(*this)](Error& error) {
+            dbgln("Unable to decode discarded image again: {}", error);
+            strong_this->m_is_redecoding = false;
+            strong_this->m_redecoding_failed = true;
+        },
+        ideal_size);
+}
+
+void AnimatedBitmapDecodedImageData::did_redecode_frames(Platform::DecodedImage& result)
+{
+    m_is_redecoding = false;
+
+    if (result.frames.size() != m_frames.size()) {
+        dbgln("Discarded image came back with {} frames instead of {}", result.frames.size(), m_frames.size());
+        m_redecoding_failed = true;
+        return;
+    }
+
+    for (size_t i = 0; i < m_frames.size(); ++i)
+        m_frames[i].bitmap = Gfx::ImmutableBitmap::create(*result.frames[i].bitmap);
+    m_frames_are_discarded = false;
+    DecodedImageBudget::the().did_decode(*this, size_in_bytes());
+
+    if (m_document)
+        m_document->set_needs_display();
 }
 
 int AnimatedBitmapDecodedImageData::frame_duration(size_t frame_index) const
@@ -43,17 +235,17 @@ int AnimatedBitmapDecodedImageData::frame_duration(size_t frame_index) const
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_width() const
 {
-    return m_frames.first().bitmap->width();
+    return m_size.width();
 }
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_height() const
 {
-    return m_frames.first().bitmap->height();
+    return m_size.height();
 }
 
 Optional<CSSPixelFraction> AnimatedBitmapDecodedImageData::intrinsic_aspect_ratio() const
 {
-    return CSSPixels(m_frames.first().bitmap->width()) / CSSPixels(m_frames.first().bitmap->height());
+    return CSSPixels(m_size.width()) / CSSPixels(m_size.height());
 }
 
 }
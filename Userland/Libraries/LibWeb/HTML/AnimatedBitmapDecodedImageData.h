@@ -6,8 +6,12 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <LibGfx/ImmutableBitmap.h>
+#include <LibJS/Heap/CellAllocator.h>
+#include <LibWeb/Forward.h>
 #include <LibWeb/HTML/DecodedImageData.h>
+#include <LibWeb/Platform/ImageCodecPlugin.h>
 
 namespace Web::HTML {
 
@@ -21,7 +25,13 @@ public:
         int duration { 0 };
     };
 
-    static ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> create(JS::Realm&, Vector<Frame>&&, size_t loop_count, bool animated);
+    // NOTE: If the frames were decoded at a smaller size than the image has, natural_size is the latter.
+    static ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> create(JS::Realm&, Vector<Frame>&&, size_t loop_count, bool animated, Gfx::IntSize natural_size = {});
+
+    // Creates an image that only keeps a few frames around the one being shown, decoding the others from the stream as
+    // they are needed. The given frames are the first ones of the image.
+    static ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> create_streamed(JS::Realm&, Vector<Frame>&&, size_t frame_count, size_t loop_count, NonnullRefPtr<Platform::FrameStream>, Gfx::IntSize natural_size = {});
+
     virtual ~AnimatedBitmapDecodedImageData() override;
 
     virtual RefPtr<Gfx::ImmutableBitmap> bitmap(size_t frame_index, Gfx::IntSize = {}) const override;
@@ -35,12 +45,52 @@ public:
     virtual Optional<CSSPixels> intrinsic_height() const override;
     virtual Optional<CSSPixelFraction> intrinsic_aspect_ratio() const override;
 
+    // Keeps the data this image was decoded from. Unless the image is streamed, this lets its bitmaps be discarded when
+    // we're over the decoded image budget, after which they are decoded again once they are asked for. Until they are
+    // back, there is nothing to show, and the document is repainted once they are.
+    void set_encoded_data(ByteBuffer, DOM::Document&);
+    ReadonlyBytes encoded_data() const { return m_encoded_data; }
+
+    // NOTE: Only to be called by DecodedImageBudget.
+    void discard_frames();
+
 private:
-    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated);
+    // How many frames of a streamed image we keep decoded, starting with the one being shown.
+    static constexpr size_t streamed_frame_window_size = 8;
+
+    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated, RefPtr<Platform::FrameStream>, Gfx::IntSize natural_size);
+
+    virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
-    Vector<Frame> m_frames;
+    size_t size_in_bytes() const;
+    void redecode_discarded_frames();
+    void did_redecode_frames(Platform::DecodedImage&);
+
+    void update_streamed_frames(size_t current_frame_index) const;
+    void did_decode_streamed_frames(size_t start_frame_index, Vector<Platform::Frame>&);
+
+    // NOTE: For streamed images, the frames outside of the window have no bitmap.
+    mutable Vector<Frame> m_frames;
     size_t m_loop_count { 0 };
     bool m_animated { false };
+    Gfx::IntSize m_size;
+
+    RefPtr<Platform::FrameStream> m_frame_stream;
+    mutable Optional<size_t> m_current_streamed_frame_index;
+    mutable bool m_has_pending_frame_request { false };
+    bool m_frame_stream_failed { false };
+
+    // The bitmap we last handed out, so that we have something to show if the stream falls behind.
+    mutable RefPtr<Gfx::ImmutableBitmap> m_last_returned_bitmap;
+
+    // The data to decode discarded frames again from, and the size they were decoded at.
+    ByteBuffer m_encoded_data;
+    JS::GCPtr<DOM::Document> m_document;
+    Gfx::IntSize m_decoded_size;
+    bool m_frames_are_discarded { false };
+    bool m_is_redecoding { false };
+    bool m_redecoding_failed { false };
 };
 
 }
@@ -5,6 +5,7 @@
  */
 
 #include <LibWeb/HTML/Canvas/CanvasDrawImage.h>
+#include <LibWeb/HTML/HTMLImageElement.h>
 #include <LibWeb/HTML/ImageBitmap.h>
 #include <LibWeb/SVG/SVGImageElement.h>
 
@@ -13,6 +14,15 @@ namespace Web::HTML {
 static void default_source_size(CanvasImageSource const& image, float& source_width, float& source_height)
 {
     image.visit(
+        [&source_width, &source_height](JS::Handle<HTML::HTMLImageElement> const& source) {
+            if (auto size = source->current_image_natural_size(); size.has_value()) {
+                source_width = size->width();
+                source_height = size->height();
+            } else {
+                source_width = source->width();
+                source_height = source->height();
+            }
+        },
         [&source_width, &source_height](JS::Handle<SVG::SVGImageElement> const& source) {
             if (source->bitmap()) {
                 source_width = source->bitmap()->width();
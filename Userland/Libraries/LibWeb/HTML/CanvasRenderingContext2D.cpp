@@ -8,18 +8,23 @@
 
 #include <AK/OwnPtr.h>
 #include <LibGfx/DeprecatedPainter.h>
+#include <LibGfx/PaintingSurface.h>
 #include <LibGfx/Quad.h>
 #include <LibGfx/Rect.h>
 #include <LibUnicode/Segmenter.h>
 #include <LibWeb/Bindings/CanvasRenderingContext2DPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/CSS/StyleValues/LengthStyleValue.h>
 #include <LibWeb/HTML/CanvasRenderingContext2D.h>
 #include <LibWeb/HTML/HTMLCanvasElement.h>
 #include <LibWeb/HTML/HTMLImageElement.h>
 #include <LibWeb/HTML/ImageBitmap.h>
 #include <LibWeb/HTML/ImageData.h>
+#include <LibWeb/HTML/OffscreenCanvas.h>
 #include <LibWeb/HTML/Path2D.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/TextMetrics.h>
+#include <LibWeb/HTML/Window.h>
 #include <LibWeb/Infra/CharacterTypes.h>
 #include <LibWeb/Layout/TextNode.h>
 #include <LibWeb/Painting/Paintable.h>
@@ -33,13 +38,13 @@ JS_DEFINE_ALLOCATOR(CanvasRenderingContext2D);
 
 JS::NonnullGCPtr<CanvasRenderingContext2D> CanvasRenderingContext2D::create(JS::Realm& realm, HTMLCanvasElement& element)
 {
-    return realm.heap().allocate<CanvasRenderingContext2D>(realm, realm, element);
+    return realm.heap().allocate<CanvasRenderingContext2D>(realm, realm, JS::NonnullGCPtr { element });
 }
 
-CanvasRenderingContext2D::CanvasRenderingContext2D(JS::Realm& realm, HTMLCanvasElement& element)
+CanvasRenderingContext2D::CanvasRenderingContext2D(JS::Realm& realm, Canvas canvas)
     : PlatformObject(realm)
     , CanvasPath(static_cast<Bindings::PlatformObject&>(*this), *this)
-    , m_element(element)
+    , m_canvas(move(canvas))
 {
 }
 
@@ -54,22 +59,27 @@ void CanvasRenderingContext2D::initialize(JS::Realm& realm)
 void CanvasRenderingContext2D::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
-    visitor.visit(m_element);
+    m_canvas.visit([&](auto const& canvas) { visitor.visit(canvas); });
 }
 
 HTMLCanvasElement& CanvasRenderingContext2D::canvas_element()
 {
-    return *m_element;
+    return *m_canvas.get<JS::NonnullGCPtr<HTMLCanvasElement>>();
 }
 
 HTMLCanvasElement const& CanvasRenderingContext2D::canvas_element() const
 {
-    return *m_element;
+    return *m_canvas.get<JS::NonnullGCPtr<HTMLCanvasElement>>();
 }
 
 JS::NonnullGCPtr<HTMLCanvasElement> CanvasRenderingContext2D::canvas_for_binding() const
 {
-    return *m_element;
+    return m_canvas.get<JS::NonnullGCPtr<HTMLCanvasElement>>();
+}
+
+Gfx::Bitmap* CanvasRenderingContext2D::canvas_bitmap() const
+{
+    return m_canvas.visit([](auto const& canvas) { return canvas->bitmap(); });
 }
 
 Gfx::Path CanvasRenderingContext2D::rect_path(float x, float y, float width, float height)
@@ -136,6 +146,13 @@ WebIDL::ExceptionOr<void> CanvasRenderingContext2D::draw_image_internal(CanvasIm
 
     //    The source rectangle is the rectangle whose corners are the four points (sx, sy), (sx+sw, sy), (sx+sw, sy+sh), (sx, sy+sh).
     auto source_rect = Gfx::FloatRect { source_x, source_y, source_width, source_height };
+
+    // NOTE: Images may have been decoded at a smaller size than they have, in which case the source rectangle has to be
+    //       mapped from image pixels to the pixels of their bitmap.
+    if (auto const* image_element = image.get_pointer<JS::Handle<HTMLImageElement>>()) {
+        if (auto natural_size = (*image_element)->current_image_natural_size(); natural_size.has_value() && natural_size != bitmap->size() && !natural_size->is_empty())
+            source_rect.scale_by(static_cast<float>(bitmap->width()) / natural_size->width(), static_cast<float>(bitmap->height()) / natural_size->height());
+    }
     //    The destination rectangle is the rectangle whose corners are the four points (dx, dy), (dx+dw, dy), (dx+dw, dy+dh), (dx, dy+dh).
     auto destination_rect = Gfx::FloatRect { destination_x, destination_y, destination_width, destination_height };
     //    When the source rectangle is outside the source image, the source rectangle must be clipped
@@ -172,23 +189,62 @@ WebIDL::ExceptionOr<void> CanvasRenderingContext2D::draw_image_internal(CanvasIm
 
 void CanvasRenderingContext2D::did_draw(Gfx::FloatRect const&)
 {
-    // FIXME: Make use of the rect to reduce the invalidated area when possible.
-    if (!canvas_element().paintable())
-        return;
-    canvas_element().paintable()->set_needs_display(InvalidateDisplayList::No);
+    m_canvas.visit(
+        [](JS::NonnullGCPtr<HTMLCanvasElement> const& element) {
+            // FIXME: Make use of the rect to reduce the invalidated area when possible.
+            if (!element->paintable())
+                return;
+            element->paintable()->set_needs_display(InvalidateDisplayList::No);
+        },
+        [](JS::NonnullGCPtr<OffscreenCanvas> const& offscreen_canvas) {
+            offscreen_canvas->did_draw();
+        });
 }
 
 Gfx::Painter* CanvasRenderingContext2D::painter()
 {
-    if (!canvas_element().bitmap()) {
-        if (!canvas_element().create_bitmap())
-            return nullptr;
-        canvas_element().document().invalidate_display_list();
-        m_painter = Gfx::Painter::create(*canvas_element().bitmap());
-    }
+    auto created_surface = m_canvas.visit(
+        [](JS::NonnullGCPtr<HTMLCanvasElement> const& element) {
+            if (element->surface())
+                return false;
+            if (!element->create_surface())
+                return false;
+            element->document().invalidate_display_list();
+            return true;
+        },
+        [](JS::NonnullGCPtr<OffscreenCanvas> const& offscreen_canvas) {
+            return !offscreen_canvas->surface() && offscreen_canvas->create_surface();
+        });
+
+    auto* surface = m_canvas.visit([](auto const& canvas) { return canvas->surface(); });
+    if (!surface)
+        return nullptr;
+    if (created_surface || !m_painter)
+        m_painter = Gfx::Painter::create(*surface);
     return m_painter.ptr();
 }
 
+RefPtr<Gfx::FontCascadeList const> CanvasRenderingContext2D::compute_font_for_style_values(CSS::CSSStyleValue const& font_family, CSS::CSSStyleValue const& font_size, CSS::CSSStyleValue const& font_style, CSS::CSSStyleValue const& font_weight, CSS::CSSStyleValue const& font_width)
+{
+    return m_canvas.visit(
+        [&](JS::NonnullGCPtr<HTMLCanvasElement> const& element) {
+            return element->document().style_computer().compute_font_for_style_values(element, {}, font_family, font_size, font_style, font_weight, font_width);
+        },
+        [&](JS::NonnullGCPtr<OffscreenCanvas> const& offscreen_canvas) -> RefPtr<Gfx::FontCascadeList const> {
+            // NOTE: Within a window, the fonts of the associated document apply to an OffscreenCanvas too.
+            if (auto& global_object = HTML::relevant_global_object(*offscreen_canvas); is<Window>(global_object))
+                return verify_cast<Window>(global_object).associated_document().style_computer().compute_font_for_style_values(nullptr, {}, font_family, font_size, font_style, font_weight, font_width);
+
+            // FIXME: Resolve font families and relative sizes in workers, which don't have a style computer.
+            float font_size_in_px = 10;
+            if (font_size.is_length() && font_size.as_length().length().is_absolute())
+                font_size_in_px = font_size.as_length().length().absolute_length_to_px().to_float();
+            auto font_list = Gfx::FontCascadeList::create();
+            font_list->add(Platform::FontPlugin::the().default_font().with_size(font_size_in_px * 0.75f));
+            return font_list;
+        });
+}
+
 Gfx::Path CanvasRenderingContext2D::text_path(StringView text, float x, float y, Optional<double> max_width)
 {
     if (max_width.has_value() && max_width.value() <= 0)
@@ -375,9 +431,9 @@ WebIDL::ExceptionOr<JS::GCPtr<ImageData>> CanvasRenderingContext2D::get_image_da
     auto image_data = TRY(ImageData::create(realm(), abs_width, abs_height, settings));
 
     // NOTE: We don't attempt to create the underlying bitmap here; if it doesn't exist, it's like copying only transparent black pixels (which is a no-op).
-    if (!canvas_element().bitmap())
+    if (!canvas_bitmap())
         return image_data;
-    auto const& bitmap = *canvas_element().bitmap();
+    auto const& bitmap = *canvas_bitmap();
 
     // 5. Let the source rectangle be the rectangle whose corners are the four points (sx, sy), (sx+sw, sy), (sx+sw, sy+sh), (sx, sy+sh).
     auto source_rect = Gfx::Rect { x, y, abs_width, abs_height };
@@ -419,7 +475,7 @@ void CanvasRenderingContext2D::put_image_data(ImageData const& image_data, float
 // https://html.spec.whatwg.org/multipage/canvas.html#reset-the-rendering-context-to-its-default-state
 void CanvasRenderingContext2D::reset_to_default_state()
 {
-    auto* bitmap = canvas_element().bitmap();
+    auto* bitmap = canvas_bitmap();
 
     // 1. Clear canvas's bitmap to transparent black.
     if (bitmap) {
@@ -636,11 +692,11 @@ WebIDL::ExceptionOr<CanvasImageSourceUsability> check_usability_of_image(CanvasI
         },
 
         // HTMLCanvasElement
-        // FIXME: OffscreenCanvas
-        [](JS::Handle<HTMLCanvasElement> const& canvas_element) -> WebIDL::ExceptionOr<Optional<CanvasImageSourceUsability>> {
+        // OffscreenCanvas
+        [](OneOf<JS::Handle<HTMLCanvasElement>, JS::Handle<OffscreenCanvas>> auto const& canvas) -> WebIDL::ExceptionOr<Optional<CanvasImageSourceUsability>> {
             // If image has either a horizontal dimension or a vertical dimension equal to zero, then throw an "InvalidStateError" DOMException.
-            if (canvas_element->width() == 0 || canvas_element->height() == 0)
-                return WebIDL::InvalidStateError::create(canvas_element->realm(), "Canvas width or height is zero"_string);
+            if (canvas->width() == 0 || canvas->height() == 0)
+                return WebIDL::InvalidStateError::create(canvas->realm(), "Canvas width or height is zero"_string);
             return Optional<CanvasImageSourceUsability> {};
         },
 
@@ -677,7 +733,9 @@ bool image_is_not_origin_clean(CanvasImageSource const& image)
             return false;
         },
         // HTMLCanvasElement
-        [](OneOf<JS::Handle<HTMLCanvasElement>, JS::Handle<ImageBitmap>> auto const&) {
+        // ImageBitmap
+        // OffscreenCanvas
+        [](OneOf<JS::Handle<HTMLCanvasElement>, JS::Handle<ImageBitmap>, JS::Handle<OffscreenCanvas>> auto const&) {
             // FIXME: image's bitmap's origin-clean flag is false.
             return false;
         });
@@ -11,6 +11,7 @@
 #include <AK/Variant.h>
 #include <LibGfx/AffineTransform.h>
 #include <LibGfx/Color.h>
+#include <LibGfx/FontCascadeList.h>
 #include <LibGfx/Forward.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/Path.h>
@@ -104,12 +105,23 @@ public:
 
     [[nodiscard]] Gfx::Painter* painter();
 
-private:
-    explicit CanvasRenderingContext2D(JS::Realm&, HTMLCanvasElement&);
+    bool origin_clean() const { return m_origin_clean; }
+
+    RefPtr<Gfx::FontCascadeList const> compute_font_for_style_values(CSS::CSSStyleValue const& font_family, CSS::CSSStyleValue const& font_size, CSS::CSSStyleValue const& font_style, CSS::CSSStyleValue const& font_weight, CSS::CSSStyleValue const& font_width);
+
+protected:
+    using Canvas = Variant<JS::NonnullGCPtr<HTMLCanvasElement>, JS::NonnullGCPtr<OffscreenCanvas>>;
+
+    explicit CanvasRenderingContext2D(JS::Realm&, Canvas);
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    Canvas const& canvas() const { return m_canvas; }
+
+private:
+    Gfx::Bitmap* canvas_bitmap() const;
+
     virtual Gfx::Painter* painter_for_canvas_state() override { return painter(); }
     virtual Gfx::Path& path_for_canvas_state() override { return path(); }
 
@@ -132,7 +144,7 @@ private:
     void fill_internal(Gfx::Path const&, Gfx::WindingRule);
     void clip_internal(Gfx::Path&, Gfx::WindingRule);
 
-    JS::NonnullGCPtr<HTMLCanvasElement> m_element;
+    Canvas m_canvas;
     OwnPtr<Gfx::Painter> m_painter;
 
     // https://html.spec.whatwg.org/multipage/canvas.html#concept-canvas-origin-clean
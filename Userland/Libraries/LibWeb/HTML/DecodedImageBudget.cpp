@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+#include <LibWeb/HTML/DecodedImageBudget.h>
+#include <LibWeb/Platform/Timer.h>
+
+namespace Web::HTML {
+
+// NOTE: This is never destroyed, as the images that are still around at exit unregister themselves from it.
+DecodedImageBudget& DecodedImageBudget::the()
+{
+    static auto* s_budget = new DecodedImageBudget;
+    return *s_budget;
+}
+
+void DecodedImageBudget::did_decode(AnimatedBitmapDecodedImageData& image, size_t size_in_bytes)
+{
+    remove(image);
+
+    m_entries.set(&image, Entry { .size_in_bytes = size_in_bytes, .last_use = MonotonicTime::now_coarse() });
+    m_total_size += size_in_bytes;
+
+    discard_least_recently_used_images();
+}
+
+void DecodedImageBudget::did_use(AnimatedBitmapDecodedImageData const& image)
+{
+    if (auto it = m_entries.find(const_cast<AnimatedBitmapDecodedImageData*>(&image)); it != m_entries.end())
+        it->value.last_use = MonotonicTime::now_coarse();
+}
+
+void DecodedImageBudget::remove(AnimatedBitmapDecodedImageData const& image)
+{
+    auto it = m_entries.find(const_cast<AnimatedBitmapDecodedImageData*>(&image));
+    if (it == m_entries.end())
+        return;
+    m_total_size -= it->value.size_in_bytes;
+    m_entries.remove(it);
+}
+
+void DecodedImageBudget::discard_least_recently_used_images()
+{
+    if (m_total_size <= maximum_size)
+        return;
+
+    Vector<AnimatedBitmapDecodedImageData*> images;
+    images.ensure_capacity(m_entries.size());
+    for (auto const& it : m_entries)
+        images.unchecked_append(it.key);
+    quick_sort(images, [&](auto* a, auto* b) {
+        return m_entries.get(a)->last_use < m_entries.get(b)->last_use;
+    });
+
+    // NOTE: Discard down to 3/4 of the budget, so we aren't doing this again for every image that is decoded.
+    auto now = MonotonicTime::now_coarse();
+    for (auto* image : images) {
+        if (m_total_size <= maximum_size / 4 * 3)
+            return;
+        if (now - m_entries.get(image)->last_use < minimum_unused_time_before_discard)
+            break;
+
+        // NOTE: This takes the image out of the budget.
+        image->discard_frames();
+    }
+
+    if (m_total_size <= maximum_size)
+        return;
+
+    // NOTE: Everything that's left has been painted recently, so we try again once some of it may have gone out of use.
+    //       This is also how the images of pages that are no longer painted at all, e.g. in background tabs, go away.
+    if (!m_retry_timer) {
+        m_retry_timer = Platform::Timer::create_single_shot(minimum_unused_time_before_discard.to_milliseconds(), [this] {
+            discard_least_recently_used_images();
+        });
+    }
+    if (!m_retry_timer->is_active())
+        m_retry_timer->start();
+}
+
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/RefPtr.h>
+#include <AK/Time.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// Keeps the bitmaps of decoded images within a process-wide budget, by discarding those of the images that have gone the
+// longest without being painted. Discarded images hold on to their encoded data, and are decoded again once they are
+// painted next.
+//
+// NOTE: Images that have been painted recently are never discarded, no matter how far over budget we are, as we'd only
+//       have to decode them again right away. Instead, we try again once they have had time to go out of use.
+class DecodedImageBudget {
+public:
+    static DecodedImageBudget& the();
+
+    // NOTE: This budget is measured in decoded bitmap bytes.
+    static constexpr size_t maximum_size = 256 * MiB;
+    static constexpr AK::Duration minimum_unused_time_before_discard = AK::Duration::from_seconds(5);
+
+    void did_decode(AnimatedBitmapDecodedImageData&, size_t size_in_bytes);
+    void did_use(AnimatedBitmapDecodedImageData const&);
+    void remove(AnimatedBitmapDecodedImageData const&);
+
+    size_t total_size() const { return m_total_size; }
+
+private:
+    DecodedImageBudget() = default;
+
+    void discard_least_recently_used_images();
+
+    struct Entry {
+        size_t size_in_bytes { 0 };
+        MonotonicTime last_use;
+    };
+
+    HashMap<AnimatedBitmapDecodedImageData*, Entry> m_entries;
+    size_t m_total_size { 0 };
+    RefPtr<Platform::Timer> m_retry_timer;
+};
+
+}
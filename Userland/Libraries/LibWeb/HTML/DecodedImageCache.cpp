@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibWeb/HTML/DecodedImageCache.h>
+
+namespace Web::HTML {
+
+DecodedImageCache& DecodedImageCache::the()
+{
+    static DecodedImageCache s_cache;
+    return s_cache;
+}
+
+DecodedImageCache::EncodedDataDigest DecodedImageCache::digest_encoded_data(ReadonlyBytes encoded_data)
+{
+    return ::Crypto::Hash::SHA256::hash(encoded_data.data(), encoded_data.size());
+}
+
+Optional<DecodedImageCache::Entry> DecodedImageCache::get(URL::URL const& url, EncodedDataDigest const& encoded_data_digest)
+{
+    auto key = url.serialize();
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return {};
+
+    // NOTE: The resource may have changed since we decoded it, in which case the stored bitmaps are useless.
+    if (it->value.encoded_data_digest != encoded_data_digest) {
+        remove(key);
+        return {};
+    }
+
+    it->value.last_access_generation = ++m_access_generation;
+    return it->value.entry;
+}
+
+void DecodedImageCache::set(URL::URL const& url, EncodedDataDigest const& encoded_data_digest, Entry entry)
+{
+    size_t size_in_bytes = 0;
+    for (auto const& frame : entry.frames) {
+        if (frame.bitmap)
+            size_in_bytes += frame.bitmap->bitmap().size_in_bytes();
+    }
+
+    // NOTE: Don't let a single huge image push everything else out of the cache.
+    if (size_in_bytes > maximum_size / 4)
+        return;
+
+    auto key = url.serialize();
+    remove(key);
+
+    m_entries.set(key,
+        StoredEntry {
+            .encoded_data_digest = encoded_data_digest,
+            .entry = move(entry),
+            .size_in_bytes = size_in_bytes,
+            .last_access_generation = ++m_access_generation,
+        });
+    m_total_size += size_in_bytes;
+
+    evict_least_recently_used_entries();
+}
+
+void DecodedImageCache::remove(ByteString const& key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return;
+    m_total_size -= it->value.size_in_bytes;
+    m_entries.remove(it);
+}
+
+void DecodedImageCache::evict_least_recently_used_entries()
+{
+    if (m_total_size <= maximum_size)
+        return;
+
+    Vector<ByteString> keys;
+    keys.ensure_capacity(m_entries.size());
+    for (auto const& it : m_entries)
+        keys.unchecked_append(it.key);
+    quick_sort(keys, [&](auto const& a, auto const& b) {
+        return m_entries.find(a)->value.last_access_generation < m_entries.find(b)->value.last_access_generation;
+    });
+
+    // NOTE: Evict down to 3/4 of the budget, so we aren't doing this again for every image that is decoded.
+    for (auto const& key : keys) {
+        if (m_total_size <= maximum_size / 4 * 3)
+            break;
+        remove(key);
+    }
+}
+
+}
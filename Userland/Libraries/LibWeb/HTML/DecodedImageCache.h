@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Vector.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibJS/Heap/CellAllocator.h>
+#include <LibURL/URL.h>
+#include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+
+namespace Web::HTML {
+
+// A process-wide cache of decoded bitmap images, so that documents (and iframes, and documents restored through session
+// history) that fetch the same image don't have to decode it again. Entries are keyed by URL, and are only handed out
+// when the encoded bytes that were fetched are identical to those that the cached bitmaps were decoded from.
+class DecodedImageCache {
+public:
+    static DecodedImageCache& the();
+
+    // The digest of the encoded bytes that an entry's bitmaps were decoded from.
+    using EncodedDataDigest = ::Crypto::Hash::SHA256::DigestType;
+    static EncodedDataDigest digest_encoded_data(ReadonlyBytes);
+
+    struct Entry {
+        Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+        size_t loop_count { 0 };
+        bool is_animated { false };
+    };
+
+    Optional<Entry> get(URL::URL const&, EncodedDataDigest const&);
+    void set(URL::URL const&, EncodedDataDigest const&, Entry);
+
+    // NOTE: This budget is measured in decoded bitmap bytes, which are usually far more than the encoded bytes.
+    static constexpr size_t maximum_size = 128 * MiB;
+
+private:
+    DecodedImageCache() = default;
+
+    struct StoredEntry {
+        EncodedDataDigest encoded_data_digest;
+        Entry entry;
+        size_t size_in_bytes { 0 };
+        u64 last_access_generation { 0 };
+    };
+
+    void remove(ByteString const& key);
+    void evict_least_recently_used_entries();
+
+    HashMap<ByteString, StoredEntry> m_entries;
+    size_t m_total_size { 0 };
+    u64 m_access_generation { 0 };
+};
+
+}
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibCore/EventLoop.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -149,7 +150,7 @@ void EventLoop::process()
 
     // 1. Let oldestTask and taskStartTime be null.
     JS::GCPtr<Task> oldest_task;
-    [[maybe_unused]] double task_start_time = 0;
+    double task_start_time = 0;
 
     // 2. If the event loop has a task queue with at least one runnable task, then:
     if (m_task_queue->has_runnable_tasks()) {
@@ -178,7 +179,7 @@ void EventLoop::process()
     }
 
     // 3. Let taskEndTime be the unsafe shared current time. [HRT]
-    [[maybe_unused]] auto task_end_time = HighResolutionTime::unsafe_shared_current_time();
+    auto task_end_time = HighResolutionTime::unsafe_shared_current_time();
 
     // 4. If oldestTask is not null, then:
     if (oldest_task) {
@@ -189,7 +190,9 @@ void EventLoop::process()
         // FIXME: 2.3. If global's browsing context is null, then continue.
         // FIXME: 2.4. Let tlbc be global's browsing context's top-level browsing context.
         // FIXME: 2.5. If tlbc is not null, then append it to top-level browsing contexts.
-        // FIXME: 3. Report long tasks, passing in taskStartTime, taskEndTime, top-level browsing contexts, and oldestTask.
+        // 3. Report long tasks, passing in taskStartTime, taskEndTime, top-level browsing contexts, and oldestTask.
+        // FIXME: We don't support PerformanceLongTaskTiming yet, so long tasks only end up in the debug log for now.
+        report_long_task(task_start_time, task_end_time, *oldest_task);
         // FIXME: 4. If oldestTask's document is not null, then record task end time given taskEndTime and oldestTask's document.
     }
 
@@ -198,6 +201,11 @@ void EventLoop::process()
         // 1. Set this event loop's last idle period start time to the unsafe shared current time.
         m_last_idle_period_start_time = HighResolutionTime::unsafe_shared_current_time();
 
+        // OPTIMIZATION: Nothing is runnable right now, so this is a good time to collect garbage if we're getting
+        //               close to the point where an allocation would trigger a collection anyway. That way, it's much
+        //               less likely that a collection will happen in the middle of a task or a rendering update.
+        heap().collect_garbage_if_close_to_threshold();
+
         // 2. Let computeDeadline be the following steps:
         // Implemented in EventLoop::compute_deadline()
 
@@ -213,6 +221,22 @@ void EventLoop::process()
     }
 }
 
+// https://w3c.github.io/longtasks/#report-long-tasks
+void EventLoop::report_long_task(double start_time, double end_time, Task const& task)
+{
+    // 1. If end time minus start time is less than the long tasks threshold of 50 ms, abort these steps.
+    static constexpr double long_tasks_threshold_ms = 50;
+    if (end_time - start_time < long_tasks_threshold_ms)
+        return;
+
+    auto const* document = task.document();
+    dbgln_if(HTML_LONG_TASK_DEBUG, "Long task from the {} task source took {:.1}ms{}{}",
+        Task::source_name(task.source()),
+        end_time - start_time,
+        document ? " in "sv : ""sv,
+        document ? document->url_string() : String {});
+}
+
 // https://html.spec.whatwg.org/multipage/webappapis.html#event-loop-processing-model
 void EventLoop::queue_task_to_update_the_rendering()
 {
@@ -326,9 +350,25 @@ void EventLoop::queue_task_to_update_the_rendering()
                     // NOTE: Recalculation of styles is handled by update_layout()
                     document->update_layout();
 
-                    // FIXME: 2. Let hadInitialVisibleContentVisibilityDetermination be false.
-                    // FIXME: 3. For each element element with 'auto' used value of 'content-visibility':
-                    // FIXME: 4. If hadInitialVisibleContentVisibilityDetermination is true, then continue.
+                    // 2. Let hadInitialVisibleContentVisibilityDetermination be false.
+                    bool had_initial_visible_content_visibility_determination = false;
+
+                    // 3. For each element element with 'auto' used value of 'content-visibility':
+                    for (auto& element : document->elements_with_content_visibility_auto()) {
+                        // 1. Let checkForInitialDetermination be true if element's proximity to the viewport is not determined and it is not relevant to the user. Otherwise, let checkForInitialDetermination be false.
+                        bool check_for_initial_determination = element->proximity_to_the_viewport() == DOM::Element::ProximityToTheViewport::NotDetermined && !element->is_relevant_to_the_user();
+
+                        // 2. Determine proximity to the viewport for element.
+                        element->determine_proximity_to_the_viewport();
+
+                        // 3. If checkForInitialDetermination is true and element is now relevant to the user, then set hadInitialVisibleContentVisibilityDetermination to true.
+                        if (check_for_initial_determination && element->is_relevant_to_the_user())
+                            had_initial_visible_content_visibility_determination = true;
+                    }
+
+                    // 4. If hadInitialVisibleContentVisibilityDetermination is true, then continue.
+                    if (had_initial_visible_content_visibility_determination)
+                        continue;
 
                     // 5. Gather active resize observations at depth resizeObserverDepth for doc.
                     document->gather_active_observations_at_depth(resize_observer_depth);
@@ -81,6 +81,8 @@ private:
 
     virtual void visit_edges(Visitor&) override;
 
+    void report_long_task(double start_time, double end_time, Task const&);
+
     Type m_type { Type::Window };
 
     JS::GCPtr<TaskQueue> m_task_queue;
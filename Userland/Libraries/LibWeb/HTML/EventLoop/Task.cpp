@@ -20,6 +20,74 @@ static IDAllocator s_unique_task_source_allocator { static_cast<int>(Task::Sourc
     return next_task_id++;
 }
 
+// NOTE: Networking, DOM manipulation, posted messages and everything else that isn't singled out here have Normal priority.
+Task::Priority Task::priority_for_source(Source source)
+{
+    switch (source) {
+    case Source::UserInteraction:
+        return Priority::UserInteraction;
+    case Source::Rendering:
+        return Priority::Rendering;
+    case Source::TimerTask:
+        return Priority::Timer;
+    case Source::IdleTask:
+        return Priority::Idle;
+    default:
+        return Priority::Normal;
+    }
+}
+
+StringView Task::source_name(Source source)
+{
+    switch (source) {
+    case Source::Unspecified:
+        return "Unspecified"sv;
+    case Source::DOMManipulation:
+        return "DOMManipulation"sv;
+    case Source::UserInteraction:
+        return "UserInteraction"sv;
+    case Source::Networking:
+        return "Networking"sv;
+    case Source::HistoryTraversal:
+        return "HistoryTraversal"sv;
+    case Source::IdleTask:
+        return "IdleTask"sv;
+    case Source::PostedMessage:
+        return "PostedMessage"sv;
+    case Source::Microtask:
+        return "Microtask"sv;
+    case Source::TimerTask:
+        return "TimerTask"sv;
+    case Source::JavaScriptEngine:
+        return "JavaScriptEngine"sv;
+    case Source::NavigationAndTraversal:
+        return "NavigationAndTraversal"sv;
+    case Source::FileReading:
+        return "FileReading"sv;
+    case Source::IntersectionObserver:
+        return "IntersectionObserver"sv;
+    case Source::PerformanceTimeline:
+        return "PerformanceTimeline"sv;
+    case Source::CanvasBlobSerializationTask:
+        return "CanvasBlobSerializationTask"sv;
+    case Source::Clipboard:
+        return "Clipboard"sv;
+    case Source::Permissions:
+        return "Permissions"sv;
+    case Source::FontLoading:
+        return "FontLoading"sv;
+    case Source::RemoteEvent:
+        return "RemoteEvent"sv;
+    case Source::Rendering:
+        return "Rendering"sv;
+    case Source::DatabaseAccess:
+        return "DatabaseAccess"sv;
+    case Source::UniqueTaskSourceStart:
+        break;
+    }
+    return "Unique"sv;
+}
+
 JS::NonnullGCPtr<Task> Task::create(JS::VM& vm, Source source, JS::GCPtr<DOM::Document const> document, JS::NonnullGCPtr<JS::HeapFunction<void()>> steps)
 {
     return vm.heap().allocate_without_realm<Task>(source, document, move(steps));
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/DistinctNumeric.h>
+#include <AK/Time.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/SafeFunction.h>
@@ -14,6 +16,7 @@
 
 namespace Web::HTML {
 
+class TaskQueue;
 struct UniqueTaskSource;
 
 AK_TYPEDEF_DISTINCT_NUMERIC_GENERAL(u64, TaskID, Comparison);
@@ -66,20 +69,40 @@ public:
         // https://html.spec.whatwg.org/multipage/webappapis.html#rendering-task-source
         Rendering,
 
+        // https://w3c.github.io/IndexedDB/#database-access-task-source
+        DatabaseAccess,
+
         // !!! IMPORTANT: Keep this field last!
         // This serves as the base value of all unique task sources.
         // Some elements, such as the HTMLMediaElement, must have a unique task source per instance.
         UniqueTaskSourceStart
     };
 
+    // The order in which the event loop picks tasks from different sources, see TaskQueue::take_first_runnable().
+    enum class Priority {
+        UserInteraction,
+        Rendering,
+        Normal,
+        Timer,
+        Idle,
+    };
+    static constexpr size_t priority_count = to_underlying(Priority::Idle) + 1;
+
+    static Priority priority_for_source(Source);
+    static StringView source_name(Source);
+
     static JS::NonnullGCPtr<Task> create(JS::VM&, Source, JS::GCPtr<DOM::Document const>, JS::NonnullGCPtr<JS::HeapFunction<void()>> steps);
 
     virtual ~Task() override;
 
     [[nodiscard]] TaskID id() const { return m_id; }
     Source source() const { return m_source; }
+    Priority priority() const { return priority_for_source(m_source); }
     void execute();
 
+    MonotonicTime queued_at() const { return m_queued_at; }
+    void set_queued_at(Badge<TaskQueue>, MonotonicTime queued_at) { m_queued_at = queued_at; }
+
     DOM::Document const* document() const;
 
     bool is_runnable() const;
@@ -93,6 +116,7 @@ private:
     Source m_source { Source::Unspecified };
     JS::NonnullGCPtr<JS::HeapFunction<void()>> m_steps;
     JS::GCPtr<DOM::Document const> m_document;
+    MonotonicTime m_queued_at { MonotonicTime::now_coarse() };
 };
 
 struct UniqueTaskSource {
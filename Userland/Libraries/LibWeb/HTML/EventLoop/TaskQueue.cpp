@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/QuickSort.h>
 #include <LibJS/Heap/MarkedVector.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/EventLoop/TaskQueue.h>
@@ -23,25 +24,70 @@ void TaskQueue::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_event_loop);
-    visitor.visit(m_tasks);
+    for (auto& tasks : m_tasks)
+        visitor.visit(tasks);
+}
+
+bool TaskQueue::is_empty() const
+{
+    for (auto const& tasks : m_tasks) {
+        if (!tasks.is_empty())
+            return false;
+    }
+    return true;
 }
 
 void TaskQueue::add(JS::NonnullGCPtr<Task> task)
 {
-    m_tasks.append(task);
+    task->set_queued_at({}, MonotonicTime::now_coarse());
+    tasks_with_priority(task->priority()).append(task);
     m_event_loop->schedule();
 }
 
+JS::GCPtr<Task> TaskQueue::dequeue()
+{
+    for (auto& tasks : m_tasks) {
+        if (!tasks.is_empty())
+            return tasks.take_first();
+    }
+    return {};
+}
+
 JS::GCPtr<Task> TaskQueue::take_first_runnable()
 {
     if (m_event_loop->execution_paused())
         return nullptr;
 
-    for (size_t i = 0; i < m_tasks.size(); ++i) {
-        if (m_tasks[i]->is_runnable())
-            return m_tasks.take(i);
+    // NOTE: Each queue is in the order its tasks were added in, so their first runnable tasks are the only candidates.
+    Optional<size_t> chosen_priority;
+    size_t chosen_index = 0;
+    Optional<MonotonicTime> chosen_queued_at;
+
+    auto starving_before = MonotonicTime::now_coarse() - starvation_limit;
+    for (size_t priority = 0; priority < Task::priority_count; ++priority) {
+        auto const& tasks = m_tasks[priority];
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            if (!tasks[i]->is_runnable())
+                continue;
+
+            auto queued_at = tasks[i]->queued_at();
+            if (!chosen_priority.has_value()) {
+                chosen_priority = priority;
+                chosen_index = i;
+                chosen_queued_at = queued_at <= starving_before ? Optional<MonotonicTime> { queued_at } : OptionalNone {};
+            } else if (queued_at <= starving_before && (!chosen_queued_at.has_value() || queued_at < *chosen_queued_at)) {
+                // This task has waited for too long, and for longer than anything we've seen so far.
+                chosen_priority = priority;
+                chosen_index = i;
+                chosen_queued_at = queued_at;
+            }
+            break;
+        }
     }
-    return nullptr;
+
+    if (!chosen_priority.has_value())
+        return nullptr;
+    return m_tasks[*chosen_priority].take(chosen_index);
 }
 
 bool TaskQueue::has_runnable_tasks() const
@@ -49,52 +95,63 @@ bool TaskQueue::has_runnable_tasks() const
     if (m_event_loop->execution_paused())
         return false;
 
-    for (auto& task : m_tasks) {
-        if (task->is_runnable())
-            return true;
+    for (auto const& tasks : m_tasks) {
+        for (auto const& task : tasks) {
+            if (task->is_runnable())
+                return true;
+        }
     }
     return false;
 }
 
 void TaskQueue::remove_tasks_matching(Function<bool(HTML::Task const&)> filter)
 {
-    m_tasks.remove_all_matching([&](auto& task) {
-        return filter(*task);
-    });
+    for (auto& tasks : m_tasks) {
+        tasks.remove_all_matching([&](auto& task) {
+            return filter(*task);
+        });
+    }
 }
 
 JS::MarkedVector<JS::NonnullGCPtr<Task>> TaskQueue::take_tasks_matching(Function<bool(HTML::Task const&)> filter)
 {
     JS::MarkedVector<JS::NonnullGCPtr<Task>> matching_tasks(heap());
 
-    for (size_t i = 0; i < m_tasks.size();) {
-        auto& task = m_tasks.at(i);
+    for (auto& tasks : m_tasks) {
+        for (size_t i = 0; i < tasks.size();) {
+            auto& task = tasks.at(i);
 
-        if (filter(*task)) {
-            matching_tasks.append(task);
-            m_tasks.remove(i);
-        } else {
-            ++i;
+            if (filter(*task)) {
+                matching_tasks.append(task);
+                tasks.remove(i);
+            } else {
+                ++i;
+            }
         }
     }
 
+    // NOTE: Callers expect these in the order they were added in, regardless of their priority.
+    quick_sort(matching_tasks, [](auto const& a, auto const& b) {
+        return a->id() < b->id();
+    });
+
     return matching_tasks;
 }
 
 Task const* TaskQueue::last_added_task() const
 {
-    if (m_tasks.is_empty())
-        return nullptr;
-    return m_tasks.last();
+    // NOTE: Task IDs only ever go up, so the most recently added task has the highest one.
+    Task const* last_added_task = nullptr;
+    for (auto const& tasks : m_tasks) {
+        if (!tasks.is_empty() && (!last_added_task || tasks.last()->id() > last_added_task->id()))
+            last_added_task = tasks.last();
+    }
+    return last_added_task;
 }
 
 bool TaskQueue::has_rendering_tasks() const
 {
-    for (auto const& task : m_tasks) {
-        if (task->source() == Task::Source::Rendering)
-            return true;
-    }
-    return false;
+    return !tasks_with_priority(Task::Priority::Rendering).is_empty();
 }
 
 }
@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Queue.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/HTML/EventLoop/Task.h>
 
 namespace Web::HTML {
 
+// Tasks are kept in one queue per Task::Priority, in the order they were added in. Tasks from higher priority queues
+// run first, unless a task has been waiting for longer than starvation_limit, in which case the oldest of those goes.
 class TaskQueue : public JS::Cell {
     JS_CELL(TaskQueue, JS::Cell);
     JS_DECLARE_ALLOCATOR(TaskQueue);
@@ -20,7 +23,10 @@ public:
     explicit TaskQueue(HTML::EventLoop&);
     virtual ~TaskQueue() override;
 
-    bool is_empty() const { return m_tasks.is_empty(); }
+    // NOTE: Even low priority tasks go after this long, so that a busy page can't keep them from running at all.
+    static constexpr auto starvation_limit = AK::Duration::from_milliseconds(100);
+
+    bool is_empty() const;
 
     bool has_runnable_tasks() const;
     bool has_rendering_tasks() const;
@@ -29,12 +35,7 @@ public:
     JS::GCPtr<HTML::Task> take_first_runnable();
 
     void enqueue(JS::NonnullGCPtr<HTML::Task> task) { add(task); }
-    JS::GCPtr<HTML::Task> dequeue()
-    {
-        if (m_tasks.is_empty())
-            return {};
-        return m_tasks.take_first();
-    }
+    JS::GCPtr<HTML::Task> dequeue();
 
     void remove_tasks_matching(Function<bool(HTML::Task const&)>);
     JS::MarkedVector<JS::NonnullGCPtr<Task>> take_tasks_matching(Function<bool(HTML::Task const&)>);
@@ -44,9 +45,14 @@ public:
 private:
     virtual void visit_edges(Visitor&) override;
 
+    using Tasks = Vector<JS::NonnullGCPtr<HTML::Task>>;
+
+    Tasks& tasks_with_priority(HTML::Task::Priority priority) { return m_tasks[to_underlying(priority)]; }
+    Tasks const& tasks_with_priority(HTML::Task::Priority priority) const { return m_tasks[to_underlying(priority)]; }
+
     JS::NonnullGCPtr<HTML::EventLoop> m_event_loop;
 
-    Vector<JS::NonnullGCPtr<HTML::Task>> m_tasks;
+    Array<Tasks, HTML::Task::priority_count> m_tasks;
 };
 
 }
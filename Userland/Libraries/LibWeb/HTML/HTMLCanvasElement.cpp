@@ -10,6 +10,7 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/JPEGWriter.h>
 #include <LibGfx/ImageFormats/PNGWriter.h>
+#include <LibGfx/PaintingSurface.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/HTMLCanvasElementPrototype.h>
 #include <LibWeb/CSS/StyleComputer.h>
@@ -20,7 +21,9 @@
 #include <LibWeb/HTML/CanvasRenderingContext2D.h>
 #include <LibWeb/HTML/HTMLCanvasElement.h>
 #include <LibWeb/HTML/Numbers.h>
+#include <LibWeb/HTML/OffscreenCanvas.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
+#include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/Layout/CanvasBox.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
@@ -29,8 +32,6 @@ namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(HTMLCanvasElement);
 
-static constexpr auto max_canvas_area = 16384 * 16384;
-
 HTMLCanvasElement::HTMLCanvasElement(DOM::Document& document, DOM::QualifiedName qualified_name)
     : HTMLElement(document, move(qualified_name))
 {
@@ -54,6 +55,9 @@ void HTMLCanvasElement::visit_edges(Cell::Visitor& visitor)
         [&](JS::NonnullGCPtr<WebGL::WebGLRenderingContext>& context) {
             visitor.visit(context);
         },
+        [&](JS::NonnullGCPtr<OffscreenCanvas>& offscreen_canvas) {
+            visitor.visit(offscreen_canvas);
+        },
         [](Empty) {
         });
 }
@@ -107,6 +111,9 @@ void HTMLCanvasElement::reset_context_to_default_state()
         [](JS::NonnullGCPtr<WebGL::WebGLRenderingContext>&) {
             TODO();
         },
+        [](JS::NonnullGCPtr<OffscreenCanvas>&) {
+            // Do nothing, the placeholder can't be resized.
+        },
         [](Empty) {
             // Do nothing.
         });
@@ -114,16 +121,32 @@ void HTMLCanvasElement::reset_context_to_default_state()
 
 WebIDL::ExceptionOr<void> HTMLCanvasElement::set_width(unsigned value)
 {
+    // https://html.spec.whatwg.org/multipage/canvas.html#attr-canvas-width
+    // When setting the value of the width or height attribute, if the context mode of the canvas element is set to
+    // placeholder, the user agent must throw an "InvalidStateError" DOMException and leave the attribute's value
+    // unchanged.
+    if (m_context.has<JS::NonnullGCPtr<OffscreenCanvas>>())
+        return WebIDL::InvalidStateError::create(realm(), "Canvas has transferred its control to an OffscreenCanvas"_string);
+
     TRY(set_attribute(HTML::AttributeNames::width, String::number(value)));
     m_bitmap = nullptr;
+    m_surface = nullptr;
     reset_context_to_default_state();
     return {};
 }
 
 WebIDL::ExceptionOr<void> HTMLCanvasElement::set_height(unsigned value)
 {
+    // https://html.spec.whatwg.org/multipage/canvas.html#attr-canvas-width
+    // When setting the value of the width or height attribute, if the context mode of the canvas element is set to
+    // placeholder, the user agent must throw an "InvalidStateError" DOMException and leave the attribute's value
+    // unchanged.
+    if (m_context.has<JS::NonnullGCPtr<OffscreenCanvas>>())
+        return WebIDL::InvalidStateError::create(realm(), "Canvas has transferred its control to an OffscreenCanvas"_string);
+
     TRY(set_attribute(HTML::AttributeNames::height, String::number(value)));
     m_bitmap = nullptr;
+    m_surface = nullptr;
     reset_context_to_default_state();
     return {};
 }
@@ -156,7 +179,7 @@ JS::ThrowCompletionOr<HTMLCanvasElement::HasOrCreatedContext> HTMLCanvasElement:
 }
 
 // https://html.spec.whatwg.org/multipage/canvas.html#dom-canvas-getcontext
-JS::ThrowCompletionOr<HTMLCanvasElement::RenderingContext> HTMLCanvasElement::get_context(String const& type, JS::Value options)
+WebIDL::ExceptionOr<HTMLCanvasElement::RenderingContext> HTMLCanvasElement::get_context(String const& type, JS::Value options)
 {
     // 1. If options is not an object, then set options to null.
     if (!options.is_object())
@@ -167,6 +190,9 @@ JS::ThrowCompletionOr<HTMLCanvasElement::RenderingContext> HTMLCanvasElement::ge
 
     // 3. Run the steps in the cell of the following table whose column header matches this canvas element's canvas context mode and whose row header matches contextId:
     // NOTE: See the spec for the full table.
+    if (m_context.has<JS::NonnullGCPtr<OffscreenCanvas>>())
+        return WebIDL::InvalidStateError::create(realm(), "Canvas has transferred its control to an OffscreenCanvas"_string);
+
     if (type == "2d"sv) {
         if (create_2d_context() == HasOrCreatedContext::Yes)
             return JS::make_handle(*m_context.get<JS::NonnullGCPtr<HTML::CanvasRenderingContext2D>>());
@@ -209,6 +235,7 @@ bool HTMLCanvasElement::create_bitmap(size_t minimum_width, size_t minimum_heigh
     auto size = bitmap_size_for_canvas(*this, minimum_width, minimum_height);
     if (size.is_empty()) {
         m_bitmap = nullptr;
+        m_surface = nullptr;
         return false;
     }
     if (!m_bitmap || m_bitmap->size() != size) {
@@ -216,17 +243,48 @@ bool HTMLCanvasElement::create_bitmap(size_t minimum_width, size_t minimum_heigh
         if (bitmap_or_error.is_error())
             return false;
         m_bitmap = bitmap_or_error.release_value_but_fixme_should_propagate_errors();
+        m_surface = nullptr;
     }
     return m_bitmap;
 }
 
-struct SerializeBitmapResult {
-    ByteBuffer buffer;
-    StringView mime_type;
-};
+bool HTMLCanvasElement::create_surface()
+{
+    if (!create_bitmap())
+        return false;
+    if (m_surface)
+        return true;
+
+    if (auto navigable = document().navigable()) {
+        auto* skia_backend_context = navigable->traversable_navigable()->skia_backend_context();
+        if (skia_backend_context && skia_backend_context->sk_context())
+            m_surface = Gfx::PaintingSurface::create_on_gpu(*skia_backend_context->sk_context(), *m_bitmap);
+    }
+    if (!m_surface)
+        m_surface = Gfx::PaintingSurface::wrap_bitmap(*m_bitmap);
+    return true;
+}
+
+Gfx::Bitmap const* HTMLCanvasElement::bitmap() const
+{
+    if (auto const* offscreen_canvas = m_context.get_pointer<JS::NonnullGCPtr<OffscreenCanvas>>())
+        return (*offscreen_canvas)->bitmap();
+    if (m_surface)
+        m_surface->flush();
+    return m_bitmap;
+}
+
+Gfx::Bitmap* HTMLCanvasElement::bitmap()
+{
+    if (auto* offscreen_canvas = m_context.get_pointer<JS::NonnullGCPtr<OffscreenCanvas>>())
+        return (*offscreen_canvas)->bitmap();
+    if (m_surface)
+        m_surface->flush();
+    return m_bitmap;
+}
 
 // https://html.spec.whatwg.org/multipage/canvas.html#a-serialisation-of-the-bitmap-as-a-file
-static ErrorOr<SerializeBitmapResult> serialize_bitmap(Gfx::Bitmap const& bitmap, StringView type, Optional<double> quality)
+ErrorOr<SerializeBitmapResult> serialize_bitmap(Gfx::Bitmap const& bitmap, StringView type, Optional<double> quality)
 {
     // If type is an image format that supports variable quality (such as "image/jpeg"), quality is given, and type is not "image/png", then,
     // if Type(quality) is Number, and quality is in the range 0.0 to 1.0 inclusive, the user agent must treat quality as the desired quality level.
@@ -324,6 +382,30 @@ WebIDL::ExceptionOr<void> HTMLCanvasElement::to_blob(JS::NonnullGCPtr<WebIDL::Ca
     return {};
 }
 
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-canvas-transfercontroltooffscreen
+WebIDL::ExceptionOr<JS::NonnullGCPtr<OffscreenCanvas>> HTMLCanvasElement::transfer_control_to_offscreen()
+{
+    // 1. If this canvas element's context mode is not set to none, throw an "InvalidStateError" DOMException.
+    if (!m_context.has<Empty>())
+        return WebIDL::InvalidStateError::create(realm(), "Canvas already has a rendering context"_string);
+
+    // 2. Let offscreenCanvas be a new OffscreenCanvas object with its width and height equal to the values of the width
+    //    and height content attributes of this canvas element.
+    // 3. Set the placeholder canvas element of offscreenCanvas to a weak reference to this canvas element.
+    auto offscreen_canvas = OffscreenCanvas::create(realm(), width(), height(), *this);
+
+    // 4. Set this canvas element's context mode to placeholder.
+    m_context = offscreen_canvas;
+    m_bitmap = nullptr;
+    m_surface = nullptr;
+
+    // FIXME: 5. Set offscreenCanvas's inherited language to the language of this canvas element.
+    // FIXME: 6. Set offscreenCanvas's inherited direction to the directionality of this canvas element.
+
+    // 7. Return offscreenCanvas.
+    return offscreen_canvas;
+}
+
 void HTMLCanvasElement::present()
 {
     m_context.visit(
@@ -333,6 +415,9 @@ void HTMLCanvasElement::present()
         [](JS::NonnullGCPtr<WebGL::WebGLRenderingContext>& context) {
             context->present();
         },
+        [](JS::NonnullGCPtr<OffscreenCanvas>&) {
+            // Do nothing, the OffscreenCanvas marks the placeholder as needing to be painted when it draws.
+        },
         [](Empty) {
             // Do nothing.
         });
@@ -13,6 +13,8 @@
 
 namespace Web::HTML {
 
+static constexpr auto max_canvas_area = 16384 * 16384;
+
 class HTMLCanvasElement final : public HTMLElement {
     WEB_PLATFORM_OBJECT(HTMLCanvasElement, HTMLElement);
     JS_DECLARE_ALLOCATOR(HTMLCanvasElement);
@@ -22,11 +24,16 @@ public:
 
     virtual ~HTMLCanvasElement() override;
 
-    Gfx::Bitmap const* bitmap() const { return m_bitmap; }
-    Gfx::Bitmap* bitmap() { return m_bitmap; }
+    // NOTE: Getting the bitmap first copies anything the 2D context has drawn on the GPU into it.
+    Gfx::Bitmap const* bitmap() const;
+    Gfx::Bitmap* bitmap();
     bool create_bitmap(size_t minimum_width = 0, size_t minimum_height = 0);
 
-    JS::ThrowCompletionOr<RenderingContext> get_context(String const& type, JS::Value options);
+    // The surface that the 2D context draws on, which records its drawing on the GPU when possible.
+    Gfx::PaintingSurface* surface() { return m_surface; }
+    bool create_surface();
+
+    WebIDL::ExceptionOr<RenderingContext> get_context(String const& type, JS::Value options);
 
     unsigned width() const;
     unsigned height() const;
@@ -37,6 +44,8 @@ public:
     String to_data_url(StringView type, Optional<double> quality);
     WebIDL::ExceptionOr<void> to_blob(JS::NonnullGCPtr<WebIDL::CallbackType> callback, StringView type, Optional<double> quality);
 
+    WebIDL::ExceptionOr<JS::NonnullGCPtr<OffscreenCanvas>> transfer_control_to_offscreen();
+
     void present();
 
 private:
@@ -59,8 +68,18 @@ private:
     void reset_context_to_default_state();
 
     RefPtr<Gfx::Bitmap> m_bitmap;
+    RefPtr<Gfx::PaintingSurface> m_surface;
 
-    Variant<JS::NonnullGCPtr<HTML::CanvasRenderingContext2D>, JS::NonnullGCPtr<WebGL::WebGLRenderingContext>, Empty> m_context;
+    // NOTE: Holding the OffscreenCanvas means that the context mode is placeholder.
+    Variant<JS::NonnullGCPtr<HTML::CanvasRenderingContext2D>, JS::NonnullGCPtr<WebGL::WebGLRenderingContext>, JS::NonnullGCPtr<OffscreenCanvas>, Empty> m_context;
 };
 
+struct SerializeBitmapResult {
+    ByteBuffer buffer;
+    StringView mime_type;
+};
+
+// https://html.spec.whatwg.org/multipage/canvas.html#a-serialisation-of-the-bitmap-as-a-file
+ErrorOr<SerializeBitmapResult> serialize_bitmap(Gfx::Bitmap const&, StringView type, Optional<double> quality);
+
 }
@@ -160,6 +160,23 @@ RefPtr<Gfx::ImmutableBitmap> HTMLImageElement::current_image_bitmap(Gfx::IntSize
     return nullptr;
 }
 
+Optional<Gfx::IntSize> HTMLImageElement::current_image_natural_size() const
+{
+    auto image_data = m_current_request->image_data();
+    if (!image_data)
+        return {};
+
+    // NOTE: This doesn't need the bitmap, which may have been discarded to save memory.
+    auto width = image_data->intrinsic_width();
+    auto height = image_data->intrinsic_height();
+    if (width.has_value() && height.has_value())
+        return Gfx::IntSize { width->to_int(), height->to_int() };
+
+    if (auto bitmap = current_image_bitmap())
+        return bitmap->size();
+    return {};
+}
+
 void HTMLImageElement::set_visible_in_viewport(bool)
 {
     // FIXME: Loosen grip on image data when it's not visible, e.g via volatile memory.
@@ -182,8 +199,8 @@ unsigned HTMLImageElement::width() const
 
     // ...or else the density-corrected intrinsic width and height of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available but not being rendered.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->width();
+    if (auto size = current_image_natural_size(); size.has_value())
+        return size->width();
 
     // ...or else 0, if the image is not available or does not have intrinsic dimensions.
     return 0;
@@ -211,8 +228,8 @@ unsigned HTMLImageElement::height() const
 
     // ...or else the density-corrected intrinsic height and height of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available but not being rendered.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->height();
+    if (auto size = current_image_natural_size(); size.has_value())
+        return size->height();
 
     // ...or else 0, if the image is not available or does not have intrinsic dimensions.
     return 0;
@@ -228,8 +245,8 @@ unsigned HTMLImageElement::natural_width() const
 {
     // Return the density-corrected intrinsic width of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->width();
+    if (auto size = current_image_natural_size(); size.has_value())
+        return size->width();
 
     // ...or else 0.
     return 0;
@@ -240,8 +257,8 @@ unsigned HTMLImageElement::natural_height() const
 {
     // Return the density-corrected intrinsic height of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->height();
+    if (auto size = current_image_natural_size(); size.has_value())
+        return size->height();
 
     // ...or else 0.
     return 0;
@@ -699,7 +716,9 @@ void HTMLImageElement::add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequ
                 image_request->set_state(ImageRequest::State::CompletelyAvailable);
 
                 // 3. Add the image to the list of available images using the key key, with the ignore higher-layer caching flag set.
-                document().list_of_available_images().add(key, *image_data, true);
+                // NOTE: An image that was decoded at a reduced size is no good for other images that may be larger.
+                if (!image_request->shared_resource_request()->was_decoded_at_reduced_size())
+                    document().list_of_available_images().add(key, *image_data, true);
 
                 // 4. If maybe omit events is not set or previousURL is not equal to urlString, then fire an event named load at the img element.
                 if (!maybe_omit_events || previous_url != url_string)
@@ -738,9 +757,75 @@ void HTMLImageElement::add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequ
                 dispatch_event(DOM::Event::create(realm(), HTML::EventNames::error));
 
             m_load_event_delayer.clear();
+        },
+        [this, image_request]() {
+            // The next task that is queued by the networking task source while the image is being fetched must run these steps:
+            if (image_request != m_current_request && image_request != m_pending_request)
+                return;
+            if (image_request->state() == ImageRequest::State::CompletelyAvailable || image_request->state() == ImageRequest::State::Broken)
+                return;
+
+            VERIFY(image_request->shared_resource_request());
+            auto image_data = image_request->shared_resource_request()->image_data();
+            if (!image_data)
+                return;
+            bool const was_partially_available = image_request->state() == ImageRequest::State::PartiallyAvailable;
+            image_request->set_image_data(image_data);
+
+            // 1. If the user agent is able to determine image request's image's width and height,
+            //    and image request is the pending request, set image request's state to partially available.
+            if (image_request == m_pending_request) {
+                image_request->set_state(ImageRequest::State::PartiallyAvailable);
+                return;
+            }
+
+            // 2. Otherwise, if the user agent is able to determine image request's image's width and height,
+            //    and image request is the current request, update the img element's presentation appropriately
+            //    and set image request's state to partially available.
+            image_request->set_state(ImageRequest::State::PartiallyAvailable);
+            if (!was_partially_available) {
+                set_needs_style_update(true);
+                document().set_needs_layout();
+            } else if (paintable()) {
+                paintable()->set_needs_display();
+            }
+        },
+        [this] {
+            return display_size_for_decoding();
         });
 }
 
+// NOTE: If the author told us how large the image is going to be, there's no need to decode it at a larger size than
+//       that, in device pixels. Otherwise, it's shown at its natural size, which we don't know until it's decoded.
+Optional<Gfx::IntSize> HTMLImageElement::display_size_for_decoding() const
+{
+    auto width_attribute = get_attribute(HTML::AttributeNames::width);
+    auto height_attribute = get_attribute(HTML::AttributeNames::height);
+    if (!width_attribute.has_value() || !height_attribute.has_value())
+        return {};
+
+    // NOTE: An image that's shown at its natural size whatever the size of its box needs all of its pixels.
+    if (auto const* style = computed_css_values(); style && style->object_fit() == CSS::ObjectFit::None)
+        return {};
+
+    CSSPixelSize size;
+    if (auto const* paintable_box = this->paintable_box()) {
+        size = paintable_box->content_size();
+    } else {
+        auto width = width_attribute->to_number<unsigned>();
+        auto height = height_attribute->to_number<unsigned>();
+        if (!width.has_value() || !height.has_value())
+            return {};
+        size = { *width, *height };
+    }
+
+    auto device_pixels_per_css_pixel = document().page().client().device_pixels_per_css_pixel();
+    return Gfx::IntSize {
+        ceil(size.width().to_double() * device_pixels_per_css_pixel),
+        ceil(size.height().to_double() * device_pixels_per_css_pixel),
+    };
+}
+
 void HTMLImageElement::did_set_viewport_rect(CSSPixelRect const& viewport_rect)
 {
     if (viewport_rect.size() == m_last_seen_viewport_size)
@@ -54,6 +54,9 @@ public:
     unsigned natural_width() const;
     unsigned natural_height() const;
 
+    // The size of the image in image pixels, which may be larger than that of its current bitmap.
+    Optional<Gfx::IntSize> current_image_natural_size() const;
+
     // https://html.spec.whatwg.org/multipage/embedded-content.html#dom-img-complete
     bool complete() const;
 
@@ -130,6 +133,7 @@ private:
     void handle_successful_fetch(URL::URL const&, StringView mime_type, ImageRequest&, ByteBuffer, bool maybe_omit_events, URL::URL const& previous_url);
     void handle_failed_fetch();
     void add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequest>, bool maybe_omit_events, URL::URL const& url_string, URL::URL const& previous_url);
+    Optional<Gfx::IntSize> display_size_for_decoding() const;
 
     void animate();
 
@@ -8,6 +8,7 @@
 #include <LibJS/Runtime/Promise.h>
 #include <LibMedia/Audio/Loader.h>
 #include <LibMedia/PlaybackManager.h>
+#include <LibMedia/StreamedMediaData.h>
 #include <LibWeb/Bindings/HTMLMediaElementPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/DOM/Document.h>
@@ -531,6 +532,8 @@ WebIDL::ExceptionOr<void> HTMLMediaElement::load_element()
         // 2. If a fetching process is in progress for the media element, the user agent should stop it.
         if (m_fetch_controller && m_fetch_controller->state() == Fetch::Infrastructure::FetchController::State::Ongoing)
             m_fetch_controller->stop_fetch();
+        m_streamed_media_data = nullptr;
+        m_streamed_media_failure_callback = nullptr;
 
         // FIXME: 3. If the media element's assigned media provider object is a MediaSource object, then detach it.
 
@@ -964,22 +967,8 @@ WebIDL::ExceptionOr<void> HTMLMediaElement::fetch_resource(URL::URL const& url_r
         //            6. Set the element's delaying-the-load-event flag back to true (this delays the load event again, in case it hasn't been fired yet).
         //            7. Set the networkState to NETWORK_LOADING.
 
-        // 2. Let destination be "audio" if the media element is an audio element, or "video" otherwise.
-        auto destination = is<HTMLAudioElement>(*this)
-            ? Fetch::Infrastructure::Request::Destination::Audio
-            : Fetch::Infrastructure::Request::Destination::Video;
-
-        // 3. Let request be the result of creating a potential-CORS request given current media resource's URL record, destination, and the current state
-        //    of media element's crossorigin content attribute.
-        auto request = create_potential_CORS_request(vm, url_record, destination, m_crossorigin);
-
-        // 4. Set request's client to the media element's node document's relevant settings object.
-        request->set_client(&document().relevant_settings_object());
-
-        // 5. Set request's initiator type to destination.
-        request->set_initiator_type(destination == Fetch::Infrastructure::Request::Destination::Audio
-                ? Fetch::Infrastructure::Request::InitiatorType::Audio
-                : Fetch::Infrastructure::Request::InitiatorType::Video);
+        // 2-5.
+        auto request = create_media_request(url_record);
 
         // 6. Let byteRange, which is "entire resource" or a (number, number or "until end") tuple, be the byte range required to satisfy missing data in
         //    media data. This value is implementation-defined and may rely on codec, network conditions or other heuristics. The user-agent may determine
@@ -995,7 +984,7 @@ WebIDL::ExceptionOr<void> HTMLMediaElement::fetch_resource(URL::URL const& url_r
         // 8. Fetch request, with processResponse set to the following steps given response response:
         Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
 
-        fetch_algorithms_input.process_response = [this, byte_range = move(byte_range), failure_callback = move(failure_callback)](auto response) mutable {
+        fetch_algorithms_input.process_response = [this, url_record, byte_range = move(byte_range), failure_callback = move(failure_callback)](auto response) mutable {
             auto& realm = this->realm();
 
             // FIXME: If the response is CORS cross-origin, we must use its internal response to query any of its data. See:
@@ -1013,6 +1002,24 @@ WebIDL::ExceptionOr<void> HTMLMediaElement::fetch_resource(URL::URL const& url_r
                 return;
             }
 
+            if (should_stream_media_resource(response)) {
+                auto length = response->header_list()->extract_length().template get<u64>();
+                auto streamed_media_data = Media::StreamedMediaData::create(length, [weak_element = make_weak_ptr<HTMLMediaElement>()](size_t offset) {
+                    if (weak_element)
+                        weak_element->fetch_streamed_media_data(offset).release_value_but_fixme_should_propagate_errors();
+                });
+                if (streamed_media_data.is_error()) {
+                    failure_callback("Failed to allocate memory for the media resource"_string);
+                    return;
+                }
+
+                m_streamed_media_data = streamed_media_data.release_value();
+                m_streamed_media_url = url_record;
+                m_streamed_media_failure_callback = move(failure_callback);
+                receive_streamed_media_data(response, 0);
+                return;
+            }
+
             // 2. Let updateMedia be to queue a media element task given the media element to run the first appropriate steps from the media data processing
             //    steps list below. (A new task is used for this so that the work described below occurs relative to the appropriate media element event task
             //    source rather than using the networking task source.)
@@ -1077,6 +1084,142 @@ WebIDL::ExceptionOr<void> HTMLMediaElement::fetch_resource(URL::URL const& url_r
     return {};
 }
 
+JS::NonnullGCPtr<Fetch::Infrastructure::Request> HTMLMediaElement::create_media_request(URL::URL const& url_record)
+{
+    // 2. Let destination be "audio" if the media element is an audio element, or "video" otherwise.
+    auto destination = is<HTMLAudioElement>(*this)
+        ? Fetch::Infrastructure::Request::Destination::Audio
+        : Fetch::Infrastructure::Request::Destination::Video;
+
+    // 3. Let request be the result of creating a potential-CORS request given current media resource's URL record, destination, and the current state
+    //    of media element's crossorigin content attribute.
+    auto request = create_potential_CORS_request(vm(), url_record, destination, m_crossorigin);
+
+    // 4. Set request's client to the media element's node document's relevant settings object.
+    request->set_client(&document().relevant_settings_object());
+
+    // 5. Set request's initiator type to destination.
+    request->set_initiator_type(destination == Fetch::Infrastructure::Request::Destination::Audio
+            ? Fetch::Infrastructure::Request::InitiatorType::Audio
+            : Fetch::Infrastructure::Request::InitiatorType::Video);
+
+    return request;
+}
+
+// AD-HOC: Below this size, we read the whole media resource before processing it, since it doesn't take long to fetch.
+//         Audio::Loader needs all of the data up front, so doing so also lets us play the audio of smaller videos.
+static constexpr u64 minimum_streamed_media_resource_size = 16 * MiB;
+
+bool HTMLMediaElement::should_stream_media_resource(Fetch::Infrastructure::Response const& response) const
+{
+    // FIXME: Stream the audio as well, once we can decode it incrementally.
+    if (!is<HTMLVideoElement>(*this))
+        return false;
+    if (response.status() != 200)
+        return false;
+
+    // We need to be able to ask for the parts of the resource that a seek needs.
+    auto accept_ranges = response.header_list()->get("Accept-Ranges"sv.bytes());
+    if (!accept_ranges.has_value() || !StringView { *accept_ranges }.equals_ignoring_ascii_case("bytes"sv))
+        return false;
+
+    auto length = response.header_list()->extract_length();
+    return length.has<u64>() && length.get<u64>() >= minimum_streamed_media_resource_size;
+}
+
+void HTMLMediaElement::receive_streamed_media_data(JS::NonnullGCPtr<Fetch::Infrastructure::Response> response, u64 offset)
+{
+    auto& global = document().realm().global_object();
+    auto fetch_id = m_streamed_media_fetch_id;
+
+    auto process_body_chunk = JS::create_heap_function(heap(), [this, fetch_id, offset](ByteBuffer chunk) mutable {
+        if (!m_streamed_media_data || fetch_id != m_streamed_media_fetch_id)
+            return;
+        m_streamed_media_data->write(offset, chunk);
+        offset += chunk.size();
+
+        // Once the media data is being processed, the demuxer asks for whatever else it needs on its own.
+        if (!m_streamed_media_failure_callback)
+            return;
+
+        // NOTE: This fails until we have received enough of the media data to know its tracks.
+        auto playback_manager = Media::PlaybackManager::from_streamed_data(*m_streamed_media_data);
+        if (playback_manager.is_error() && playback_manager.error().category() == Media::DecoderErrorCategory::NeedsMoreInput)
+            return;
+
+        queue_a_media_element_task([this, playback_manager = move(playback_manager), failure_callback = move(m_streamed_media_failure_callback)]() mutable {
+            // -> If the media data can be fetched but is found by inspection to be in an unsupported format, or can otherwise not be rendered at all
+            if (playback_manager.is_error()) {
+                // 1. The user agent should cancel the fetching process.
+                m_fetch_controller->stop_fetch();
+
+                // 2. Abort this subalgorithm, returning to the resource selection algorithm.
+                failure_callback(MUST(String::from_utf8(playback_manager.error().description())));
+                return;
+            }
+
+            process_media_tracks(nullptr, playback_manager.release_value()).release_value_but_fixme_should_propagate_errors();
+
+            // NOTE: Playback waits for any data it needs that hasn't been received yet, so we claim to have enough data
+            //       as soon as we know the video metadata.
+            if (m_ready_state == ReadyState::HaveMetadata)
+                set_ready_state(ReadyState::HaveEnoughData);
+        });
+    });
+
+    // FIXME: Fire progress events while the data is being received, and suspend once all of it has been.
+    auto process_end_of_body = JS::create_heap_function(heap(), [this, fetch_id]() {
+        if (m_streamed_media_data && fetch_id == m_streamed_media_fetch_id)
+            m_streamed_media_data->did_finish_receiving();
+    });
+    // NOTE: After an error, the next time the demuxer asks for data, we try again with a new range request.
+    auto process_body_error = JS::create_heap_function(heap(), [this, fetch_id](JS::Value) {
+        if (m_streamed_media_data && fetch_id == m_streamed_media_fetch_id)
+            m_streamed_media_data->did_finish_receiving();
+    });
+
+    VERIFY(response->body());
+    response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, JS::NonnullGCPtr { global });
+}
+
+WebIDL::ExceptionOr<void> HTMLMediaElement::fetch_streamed_media_data(u64 offset)
+{
+    if (!m_streamed_media_data)
+        return {};
+
+    auto& realm = this->realm();
+    auto& vm = realm.vm();
+
+    // NOTE: This replaces the fetch that is underway, which is receiving data that isn't needed right now.
+    if (m_fetch_controller && m_fetch_controller->state() == Fetch::Infrastructure::FetchController::State::Ongoing)
+        m_fetch_controller->stop_fetch();
+    auto fetch_id = ++m_streamed_media_fetch_id;
+
+    ByteRange byte_range = UntilEnd { offset };
+
+    auto request = create_media_request(m_streamed_media_url);
+    request->add_range_header(offset, {});
+
+    Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
+    fetch_algorithms_input.process_response = [this, fetch_id, offset, byte_range = move(byte_range)](auto response) {
+        if (!m_streamed_media_data || fetch_id != m_streamed_media_fetch_id)
+            return;
+        response = response->unsafe_response();
+
+        if (!verify_response(response, byte_range)) {
+            dbgln("Failed to fetch media resource from offset {}: {}", offset, response->network_error_message().value_or("Unexpected response"sv));
+            m_streamed_media_data->did_finish_receiving();
+            return;
+        }
+
+        // NOTE: A server may send us the entire resource instead of the range we asked for.
+        receive_streamed_media_data(response, response->status() == 206 ? offset : 0);
+    };
+
+    m_fetch_controller = TRY(Fetch::Fetching::fetch(realm, request, Fetch::Infrastructure::FetchAlgorithms::create(vm, move(fetch_algorithms_input))));
+    return {};
+}
+
 // https://html.spec.whatwg.org/multipage/media.html#verify-a-media-response
 bool HTMLMediaElement::verify_response(JS::NonnullGCPtr<Fetch::Infrastructure::Response> response, ByteRange const& byte_range)
 {
@@ -1089,18 +1232,25 @@ bool HTMLMediaElement::verify_response(JS::NonnullGCPtr<Fetch::Infrastructure::R
         return true;
 
     // 3. Let internalResponse be response's unsafe response.
+    auto internal_response = response->unsafe_response();
+
     // 4. If internalResponse's status is 200, then return true.
+    if (internal_response->status() == 200)
+        return true;
+
     // 5. If internalResponse's status is not 206, then return false.
-    // 6. If the result of extracting content-range values from internalResponse is failure, then return false.
-    TODO();
+    if (internal_response->status() != 206)
+        return false;
+
+    // FIXME: 6. If the result of extracting content-range values from internalResponse is failure, then return false.
+    // FIXME: 7. Let (rangeFirst, rangeLast, rangeLength) be the result of extracting content-range values from internalResponse.
+    // FIXME: 8-12. Check that the range and the length match byteRange and the length of the resource we already know of.
+    return true;
 }
 
 // https://html.spec.whatwg.org/multipage/media.html#media-data-processing-steps-list
 WebIDL::ExceptionOr<void> HTMLMediaElement::process_media_data(Function<void(String)> failure_callback)
 {
-    auto& realm = this->realm();
-    auto& vm = realm.vm();
-
     auto audio_loader = Audio::Loader::create(m_media_data.bytes());
     auto playback_manager = Media::PlaybackManager::from_data(m_media_data);
 
@@ -1116,13 +1266,42 @@ WebIDL::ExceptionOr<void> HTMLMediaElement::process_media_data(Function<void(Str
         return {};
     }
 
+    RefPtr<Audio::Loader> audio_track_loader;
+    if (!audio_loader.is_error())
+        audio_track_loader = audio_loader.release_value();
+    OwnPtr<Media::PlaybackManager> video_track_playback_manager;
+    if (!playback_manager.is_error())
+        video_track_playback_manager = playback_manager.release_value();
+    TRY(process_media_tracks(move(audio_track_loader), move(video_track_playback_manager)));
+
+    // -> Once the entire media resource has been fetched (but potentially before any of it has been decoded)
+    // Fire an event named progress at the media element.
+    dispatch_event(DOM::Event::create(this->realm(), HTML::EventNames::progress));
+
+    // Set the networkState to NETWORK_IDLE and fire an event named suspend at the media element.
+    m_network_state = NetworkState::Idle;
+    dispatch_event(DOM::Event::create(this->realm(), HTML::EventNames::suspend));
+
+    // If the user agent ever discards any media data and then needs to resume the network activity to obtain it again, then it must queue a media
+    // element task given the media element to set the networkState to NETWORK_LOADING.
+
+    return {};
+}
+
+WebIDL::ExceptionOr<void> HTMLMediaElement::process_media_tracks(RefPtr<Audio::Loader> audio_loader, OwnPtr<Media::PlaybackManager> playback_manager)
+{
+    VERIFY(audio_loader || playback_manager);
+
+    auto& realm = this->realm();
+    auto& vm = realm.vm();
+
     JS::GCPtr<AudioTrack> audio_track;
     JS::GCPtr<VideoTrack> video_track;
 
     // -> If the media resource is found to have an audio track
-    if (!audio_loader.is_error()) {
+    if (audio_loader) {
         // 1. Create an AudioTrack object to represent the audio track.
-        audio_track = vm.heap().allocate<AudioTrack>(realm, realm, *this, audio_loader.release_value());
+        audio_track = vm.heap().allocate<AudioTrack>(realm, realm, *this, audio_loader.release_nonnull());
 
         // 2. Update the media element's audioTracks attribute's AudioTrackList object with the new AudioTrack object.
         m_audio_tracks->add_track({}, *audio_track);
@@ -1152,9 +1331,9 @@ WebIDL::ExceptionOr<void> HTMLMediaElement::process_media_data(Function<void(Str
     }
 
     // -> If the media resource is found to have a video track
-    if (!playback_manager.is_error()) {
+    if (playback_manager) {
         // 1. Create a VideoTrack object to represent the video track.
-        video_track = vm.heap().allocate<VideoTrack>(realm, realm, *this, playback_manager.release_value());
+        video_track = vm.heap().allocate<VideoTrack>(realm, realm, *this, playback_manager.release_nonnull());
 
         // 2. Update the media element's videoTracks attribute's VideoTrackList object with the new VideoTrack object.
         m_video_tracks->add_track({}, *video_track);
@@ -1246,19 +1425,6 @@ WebIDL::ExceptionOr<void> HTMLMediaElement::process_media_data(Function<void(Str
             video_track->set_selected(true);
     }
 
-    // -> Once the entire media resource has been fetched (but potentially before any of it has been decoded)
-    if (audio_track != nullptr || video_track != nullptr) {
-        // Fire an event named progress at the media element.
-        dispatch_event(DOM::Event::create(this->realm(), HTML::EventNames::progress));
-
-        // Set the networkState to NETWORK_IDLE and fire an event named suspend at the media element.
-        m_network_state = NetworkState::Idle;
-        dispatch_event(DOM::Event::create(this->realm(), HTML::EventNames::suspend));
-
-        // If the user agent ever discards any media data and then needs to resume the network activity to obtain it again, then it must queue a media
-        // element task given the media element to set the networkState to NETWORK_LOADING.
-    }
-
     // FIXME: -> If the connection is interrupted after some media data has been received, causing the user agent to give up trying to fetch the resource
     // FIXME: -> If the media data fetching process is aborted by the user
     // FIXME: -> If the media data can be fetched but has non-fatal errors or uses, in part, codecs that are unsupported, preventing the user agent from
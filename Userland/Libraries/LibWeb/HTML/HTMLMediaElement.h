@@ -14,6 +14,8 @@
 #include <LibGfx/Rect.h>
 #include <LibJS/Heap/MarkedVector.h>
 #include <LibJS/SafeFunction.h>
+#include <LibMedia/Audio/Forward.h>
+#include <LibMedia/Forward.h>
 #include <LibWeb/DOM/DocumentLoadEventDelayer.h>
 #include <LibWeb/HTML/CORSSettingAttribute.h>
 #include <LibWeb/HTML/EventLoop/Task.h>
@@ -160,14 +162,23 @@ private:
     friend SourceElementSelector;
 
     struct EntireResource { };
-    using ByteRange = Variant<EntireResource>; // FIXME: This will need to include "until end" and an actual byte range.
+    struct UntilEnd {
+        u64 start { 0 };
+    };
+    using ByteRange = Variant<EntireResource, UntilEnd>; // FIXME: This will need to include an actual byte range.
 
     Task::Source media_element_event_task_source() const { return m_media_element_event_task_source.source; }
 
     WebIDL::ExceptionOr<void> load_element();
     WebIDL::ExceptionOr<void> fetch_resource(URL::URL const&, ESCAPING Function<void(String)> failure_callback);
+    JS::NonnullGCPtr<Fetch::Infrastructure::Request> create_media_request(URL::URL const&);
     static bool verify_response(JS::NonnullGCPtr<Fetch::Infrastructure::Response>, ByteRange const&);
     WebIDL::ExceptionOr<void> process_media_data(Function<void(String)> failure_callback);
+    WebIDL::ExceptionOr<void> process_media_tracks(RefPtr<Audio::Loader>, OwnPtr<Media::PlaybackManager>);
+
+    bool should_stream_media_resource(Fetch::Infrastructure::Response const&) const;
+    void receive_streamed_media_data(JS::NonnullGCPtr<Fetch::Infrastructure::Response>, u64 offset);
+    WebIDL::ExceptionOr<void> fetch_streamed_media_data(u64 offset);
     WebIDL::ExceptionOr<void> handle_media_source_failure(Span<JS::NonnullGCPtr<WebIDL::Promise>> promises, String error_message);
     void forget_media_resource_specific_tracks();
     void set_ready_state(ReadyState);
@@ -269,6 +280,15 @@ private:
     // https://html.spec.whatwg.org/multipage/media.html#media-data
     ByteBuffer m_media_data;
 
+    // AD-HOC: Large video resources are handed to the demuxer while they are being received, instead of being read
+    //         into m_media_data. The demuxer asks for the parts that it needs next, which we fetch with range requests.
+    RefPtr<Media::StreamedMediaData> m_streamed_media_data;
+    URL::URL m_streamed_media_url;
+    // Identifies the latest fetch of the streamed media data, since chunks of the fetches it replaced may still arrive.
+    u64 m_streamed_media_fetch_id { 0 };
+    // Holds the failure callback of the resource fetch until the streamed media data could be processed.
+    Function<void(String)> m_streamed_media_failure_callback;
+
     // https://html.spec.whatwg.org/multipage/media.html#can-autoplay-flag
     bool m_can_autoplay { true };
 
@@ -2049,7 +2049,8 @@ void Navigable::perform_scroll_of_viewport(CSSPixelPoint new_position)
         scroll_offset_did_change();
 
         if (auto document = active_document()) {
-            document->set_needs_display(InvalidateDisplayList::No);
+            // NOTE: The scroll itself doesn't damage the page, see Document::take_viewport_damage().
+            document->set_needs_display(CSSPixelRect {}, InvalidateDisplayList::No);
             document->set_needs_to_refresh_scroll_state(true);
             document->inform_all_viewport_clients_about_the_current_viewport_rect();
         }
@@ -2081,11 +2082,14 @@ bool Navigable::has_a_rendering_opportunity() const
     // or whether the document's visibility state is "visible".
     // Rendering opportunities typically occur at regular intervals.
 
-    // FIXME: Return `false` here if we're an inactive browser tab.
     auto browsing_context = const_cast<Navigable*>(this)->active_browsing_context();
     if (!browsing_context)
         return false;
-    return browsing_context->page().client().is_ready_to_paint();
+
+    auto& client = browsing_context->page().client();
+    if (!client.is_visible_for_rendering())
+        return false;
+    return client.is_ready_to_paint();
 }
 
 // https://html.spec.whatwg.org/multipage/nav-history-apis.html#inform-the-navigation-api-about-aborting-navigation
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Checked.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibWeb/Bindings/HostDefined.h>
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Bindings/OffscreenCanvasPrototype.h>
+#include <LibWeb/FileAPI/Blob.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/HTMLCanvasElement.h>
+#include <LibWeb/HTML/ImageBitmap.h>
+#include <LibWeb/HTML/OffscreenCanvas.h>
+#include <LibWeb/HTML/OffscreenCanvasRenderingContext2D.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
+#include <LibWeb/Painting/Paintable.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
+#include <LibWeb/WebIDL/Promise.h>
+
+namespace Web::HTML {
+
+JS_DEFINE_ALLOCATOR(OffscreenCanvas);
+
+JS::NonnullGCPtr<OffscreenCanvas> OffscreenCanvas::create(JS::Realm& realm, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height, JS::GCPtr<HTMLCanvasElement> placeholder_canvas_element)
+{
+    return realm.heap().allocate<OffscreenCanvas>(realm, realm, width, height, placeholder_canvas_element);
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-offscreencanvas
+WebIDL::ExceptionOr<JS::NonnullGCPtr<OffscreenCanvas>> OffscreenCanvas::construct_impl(JS::Realm& realm, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height)
+{
+    // The new OffscreenCanvas(width, height) constructor steps are:
+    // 1. Initialize the bitmap of this to a rectangular array of transparent black pixels of the dimensions specified by
+    //    width and height.
+    // NOTE: The bitmap is created once something first draws on it.
+    // 2. Initialize the width of this to width.
+    // 3. Initialize the height of this to height.
+    return create(realm, width, height);
+}
+
+OffscreenCanvas::OffscreenCanvas(JS::Realm& realm, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height, JS::GCPtr<HTMLCanvasElement> placeholder_canvas_element)
+    : DOM::EventTarget(realm)
+    , m_width(width)
+    , m_height(height)
+    , m_placeholder_canvas_element(placeholder_canvas_element)
+{
+}
+
+OffscreenCanvas::~OffscreenCanvas() = default;
+
+void OffscreenCanvas::initialize(JS::Realm& realm)
+{
+    Base::initialize(realm);
+    WEB_SET_PROTOTYPE_FOR_INTERFACE(OffscreenCanvas);
+}
+
+void OffscreenCanvas::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_context);
+    visitor.visit(m_placeholder_canvas_element);
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-offscreencanvas-width
+void OffscreenCanvas::set_width(WebIDL::UnsignedLongLong width)
+{
+    // On setting the width or height attributes, the user agent must set the value of the corresponding dimension of
+    // the bitmap to the new value, and then reset the rendering context to its default state if the context mode is 2d.
+    m_width = width;
+    reset_bitmap();
+}
+
+void OffscreenCanvas::set_height(WebIDL::UnsignedLongLong height)
+{
+    m_height = height;
+    reset_bitmap();
+}
+
+void OffscreenCanvas::reset_bitmap()
+{
+    m_bitmap = nullptr;
+    m_surface = nullptr;
+    if (m_context)
+        m_context->reset_to_default_state();
+}
+
+bool OffscreenCanvas::create_surface()
+{
+    if (m_surface)
+        return true;
+
+    Checked<size_t> area = m_width;
+    area *= m_height;
+    if (m_width == 0 || m_height == 0 || area.has_overflow() || area.value() > max_canvas_area) {
+        dbgln("Refusing to create {}x{} offscreen canvas", m_width, m_height);
+        return false;
+    }
+
+    auto bitmap = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, { m_width, m_height });
+    if (bitmap.is_error())
+        return false;
+    m_bitmap = bitmap.release_value();
+    m_surface = Gfx::PaintingSurface::wrap_bitmap(*m_bitmap);
+    return true;
+}
+
+void OffscreenCanvas::did_draw()
+{
+    // https://html.spec.whatwg.org/multipage/canvas.html#offscreencanvas-placeholder
+    // When an OffscreenCanvas object with a placeholder canvas element has its bitmap updated, the placeholder's output
+    // bitmap is updated to match it during the next rendering update.
+    if (!m_placeholder_canvas_element || !m_placeholder_canvas_element->paintable())
+        return;
+    m_placeholder_canvas_element->paintable()->set_needs_display(InvalidateDisplayList::Yes);
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-offscreencanvas-getcontext
+WebIDL::ExceptionOr<JS::GCPtr<OffscreenCanvasRenderingContext2D>> OffscreenCanvas::get_context(String const& context_id, JS::Value)
+{
+    // AD-HOC: The context ID should be an OffscreenRenderingContextId, which would reject unknown values on conversion.
+    if (!context_id.is_one_of("2d"sv, "bitmaprenderer"sv, "webgl"sv, "webgl2"sv, "webgpu"sv))
+        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, MUST(String::formatted("'{}' is not a valid OffscreenCanvas context ID", context_id)) };
+
+    // 1. If options is not an object, then set options to null.
+    // 2. Set options to the result of converting options to a JavaScript value.
+    // NOTE: The 2D context doesn't have any settings that we support yet.
+
+    // 3. Run the steps in the cell of the following table whose column header matches this OffscreenCanvas object's
+    //    context mode and whose row header matches contextId:
+    if (context_id == "2d"sv) {
+        // none: Let context be the result of running the offscreen 2D context creation algorithm given this and
+        //       options. Set this's context mode to 2d. Return context.
+        // 2d: Return the same object as was returned the last time the method was invoked with this same first argument.
+        if (!m_context)
+            m_context = OffscreenCanvasRenderingContext2D::create(realm(), *this);
+        return m_context;
+    }
+
+    // FIXME: Support the bitmaprenderer, webgl, webgl2 and webgpu contexts.
+    return nullptr;
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-offscreencanvas-transfertoimagebitmap
+WebIDL::ExceptionOr<JS::NonnullGCPtr<ImageBitmap>> OffscreenCanvas::transfer_to_image_bitmap()
+{
+    // 1. If the value of this OffscreenCanvas object's [[Detached]] internal slot is set to true, then throw an
+    //    "InvalidStateError" DOMException.
+    // NOTE: OffscreenCanvas objects can't be transferred yet, so they are never detached.
+
+    // 2. If this OffscreenCanvas object's context mode is set to none, then throw an "InvalidStateError" DOMException.
+    if (!m_context)
+        return WebIDL::InvalidStateError::create(realm(), "OffscreenCanvas has no rendering context"_string);
+
+    // 3. Let image be a newly created ImageBitmap object that references the same underlying bitmap data as this
+    //    OffscreenCanvas object's bitmap.
+    auto image = ImageBitmap::create(realm());
+    if (create_surface())
+        image->set_bitmap(m_bitmap);
+
+    // 4. Set this OffscreenCanvas object's bitmap to reference a newly created bitmap of the same dimensions and color
+    //    space as the previous bitmap, and with its pixels initialized to transparent black, or opaque black if the
+    //    rendering context's alpha is false.
+    // NOTE: The image now owns the old bitmap, so the context gets a new one the next time it draws.
+    m_bitmap = nullptr;
+    m_surface = nullptr;
+
+    // 5. Return image.
+    return image;
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-offscreencanvas-converttoblob
+WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> OffscreenCanvas::convert_to_blob(ImageEncodeOptions const& options)
+{
+    auto& realm = this->realm();
+
+    // 1. If the value of this's [[Detached]] internal slot is true, then return a promise rejected with an
+    //    "InvalidStateError" DOMException.
+    // NOTE: OffscreenCanvas objects can't be transferred yet, so they are never detached.
+
+    // 2. If this's context mode is 2d and the rendering context's output bitmap's origin-clean flag is set to false,
+    //    then return a promise rejected with a "SecurityError" DOMException.
+    if (m_context && !m_context->origin_clean())
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::SecurityError::create(realm, "OffscreenCanvas is not origin-clean"_string));
+
+    // 3. If this's bitmap has no pixels (i.e., either its horizontal dimension or its vertical dimension is zero), then
+    //    return a promise rejected with an "IndexSizeError" DOMException.
+    if (m_width == 0 || m_height == 0)
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::IndexSizeError::create(realm, "OffscreenCanvas width or height is zero"_string));
+
+    // 4. Let bitmap be a copy of this's bitmap.
+    // NOTE: A canvas that nothing has drawn on yet is serialized as transparent black.
+    if (!create_surface())
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::EncodingError::create(realm, "Failed to create the OffscreenCanvas bitmap"_string));
+    auto bitmap = TRY_OR_THROW_OOM(realm.vm(), m_bitmap->clone());
+
+    // 5. Let result be a new promise object.
+    auto result = WebIDL::create_promise(realm);
+
+    // 6. Run these steps in parallel:
+    Platform::EventLoopPlugin::the().deferred_invoke([self = JS::make_handle(*this), result = JS::make_handle(*result), bitmap = move(bitmap), type = options.type, quality = options.quality] {
+        // 1. Let file be a serialization of bitmap as a file, with options's type and quality if present.
+        auto file = serialize_bitmap(*bitmap, type, quality);
+
+        // 2. Queue a global task on the canvas blob serialization task source given this's relevant global object to
+        //    run these steps:
+        queue_global_task(Task::Source::CanvasBlobSerializationTask, HTML::relevant_global_object(*self), JS::create_heap_function(self->heap(), [self = self.ptr(), result = result.ptr(), file = move(file)] {
+            auto& realm = self->realm();
+            HTML::TemporaryExecutionContext context(Bindings::host_defined_environment_settings_object(realm), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+
+            // 1. If file is null, then reject result with an "EncodingError" DOMException.
+            if (file.is_error()) {
+                WebIDL::reject_promise(realm, *result, WebIDL::EncodingError::create(realm, "Failed to encode the OffscreenCanvas bitmap"_string));
+                return;
+            }
+
+            // 2. Otherwise, resolve result with a new Blob object, created in this's relevant realm, representing file.
+            auto blob = FileAPI::Blob::create(realm, file.value().buffer, MUST(String::from_utf8(file.value().mime_type)));
+            WebIDL::resolve_promise(realm, *result, blob);
+        }));
+    });
+
+    // 7. Return result.
+    return JS::NonnullGCPtr { verify_cast<JS::Promise>(*result->promise().ptr()) };
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibGfx/Forward.h>
+#include <LibWeb/DOM/EventTarget.h>
+#include <LibWeb/WebIDL/ExceptionOr.h>
+#include <LibWeb/WebIDL/Types.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/canvas.html#imageencodeoptions
+struct ImageEncodeOptions {
+    String type;
+    Optional<double> quality;
+};
+
+// https://html.spec.whatwg.org/multipage/canvas.html#the-offscreencanvas-interface
+class OffscreenCanvas final : public DOM::EventTarget {
+    WEB_PLATFORM_OBJECT(OffscreenCanvas, DOM::EventTarget);
+    JS_DECLARE_ALLOCATOR(OffscreenCanvas);
+
+public:
+    static JS::NonnullGCPtr<OffscreenCanvas> create(JS::Realm&, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height, JS::GCPtr<HTMLCanvasElement> placeholder_canvas_element = {});
+    static WebIDL::ExceptionOr<JS::NonnullGCPtr<OffscreenCanvas>> construct_impl(JS::Realm&, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height);
+
+    virtual ~OffscreenCanvas() override;
+
+    WebIDL::UnsignedLongLong width() const { return m_width; }
+    WebIDL::UnsignedLongLong height() const { return m_height; }
+    void set_width(WebIDL::UnsignedLongLong);
+    void set_height(WebIDL::UnsignedLongLong);
+
+    WebIDL::ExceptionOr<JS::GCPtr<OffscreenCanvasRenderingContext2D>> get_context(String const& context_id, JS::Value options);
+    WebIDL::ExceptionOr<JS::NonnullGCPtr<ImageBitmap>> transfer_to_image_bitmap();
+    WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> convert_to_blob(ImageEncodeOptions const&);
+
+    Gfx::Bitmap* bitmap() const { return m_bitmap; }
+
+    // The surface that the 2D context draws on, which writes straight into the bitmap.
+    Gfx::PaintingSurface* surface() { return m_surface; }
+    bool create_surface();
+
+    // Called by the 2D context after it has drawn on the bitmap.
+    void did_draw();
+
+private:
+    OffscreenCanvas(JS::Realm&, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height, JS::GCPtr<HTMLCanvasElement> placeholder_canvas_element);
+
+    virtual void initialize(JS::Realm&) override;
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    void reset_bitmap();
+
+    WebIDL::UnsignedLongLong m_width { 0 };
+    WebIDL::UnsignedLongLong m_height { 0 };
+
+    RefPtr<Gfx::Bitmap> m_bitmap;
+    RefPtr<Gfx::PaintingSurface> m_surface;
+
+    // https://html.spec.whatwg.org/multipage/canvas.html#offscreencanvas-context-mode
+    // NOTE: If there's no context, the context mode is none.
+    JS::GCPtr<OffscreenCanvasRenderingContext2D> m_context;
+
+    // https://html.spec.whatwg.org/multipage/canvas.html#offscreencanvas-placeholder
+    // NOTE: The placeholder lives in the same event loop as this canvas, so the frames pushed to it are simply this
+    //       canvas's bitmap, painted by the placeholder as it changes.
+    JS::GCPtr<HTMLCanvasElement> m_placeholder_canvas_element;
+};
+
+}
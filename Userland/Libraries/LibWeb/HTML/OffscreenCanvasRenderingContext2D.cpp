@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Bindings/OffscreenCanvasRenderingContext2DPrototype.h>
+#include <LibWeb/HTML/OffscreenCanvas.h>
+#include <LibWeb/HTML/OffscreenCanvasRenderingContext2D.h>
+
+namespace Web::HTML {
+
+JS_DEFINE_ALLOCATOR(OffscreenCanvasRenderingContext2D);
+
+JS::NonnullGCPtr<OffscreenCanvasRenderingContext2D> OffscreenCanvasRenderingContext2D::create(JS::Realm& realm, OffscreenCanvas& offscreen_canvas)
+{
+    return realm.heap().allocate<OffscreenCanvasRenderingContext2D>(realm, realm, offscreen_canvas);
+}
+
+OffscreenCanvasRenderingContext2D::OffscreenCanvasRenderingContext2D(JS::Realm& realm, OffscreenCanvas& offscreen_canvas)
+    : CanvasRenderingContext2D(realm, JS::NonnullGCPtr { offscreen_canvas })
+{
+}
+
+OffscreenCanvasRenderingContext2D::~OffscreenCanvasRenderingContext2D() = default;
+
+void OffscreenCanvasRenderingContext2D::initialize(JS::Realm& realm)
+{
+    Base::initialize(realm);
+    WEB_SET_PROTOTYPE_FOR_INTERFACE(OffscreenCanvasRenderingContext2D);
+}
+
+JS::NonnullGCPtr<OffscreenCanvas> OffscreenCanvasRenderingContext2D::offscreen_canvas_for_binding() const
+{
+    return canvas().get<JS::NonnullGCPtr<OffscreenCanvas>>();
+}
+
+}
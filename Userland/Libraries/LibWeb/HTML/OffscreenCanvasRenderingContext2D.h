@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibWeb/HTML/CanvasRenderingContext2D.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/canvas.html#offscreencanvasrenderingcontext2d
+// NOTE: This shares its whole implementation with CanvasRenderingContext2D, which draws on whichever kind of canvas it
+//       was created for.
+class OffscreenCanvasRenderingContext2D final : public CanvasRenderingContext2D {
+    WEB_PLATFORM_OBJECT(OffscreenCanvasRenderingContext2D, CanvasRenderingContext2D);
+    JS_DECLARE_ALLOCATOR(OffscreenCanvasRenderingContext2D);
+
+public:
+    [[nodiscard]] static JS::NonnullGCPtr<OffscreenCanvasRenderingContext2D> create(JS::Realm&, OffscreenCanvas&);
+    virtual ~OffscreenCanvasRenderingContext2D() override;
+
+    JS::NonnullGCPtr<OffscreenCanvas> offscreen_canvas_for_binding() const;
+
+private:
+    OffscreenCanvasRenderingContext2D(JS::Realm&, OffscreenCanvas&);
+
+    virtual void initialize(JS::Realm&) override;
+};
+
+}
@@ -713,8 +713,7 @@ JS::NonnullGCPtr<DOM::Element> HTMLParser::create_element_for(HTMLToken const& t
     // 10. Append each attribute in the given token to element.
     token.for_each_attribute([&](auto const& attribute) {
         DOM::QualifiedName qualified_name { attribute.local_name, attribute.prefix, attribute.namespace_ };
-        auto dom_attribute = realm().heap().allocate<DOM::Attr>(realm(), *document, move(qualified_name), attribute.value, element);
-        element->append_attribute(dom_attribute);
+        element->append_attribute(move(qualified_name), attribute.value);
         return IterationDecision::Continue;
     });
 
@@ -2930,7 +2929,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    m_speculative_parser.start(*m_document, m_tokenizer);
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -2949,7 +2949,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: Our speculative HTML parser runs to completion when it's started, so there's nothing to stop.
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -4392,40 +4393,63 @@ enum class AttributeMode {
     Yes,
 };
 
-static String escape_string(StringView string, AttributeMode attribute_mode)
+// https://html.spec.whatwg.org/multipage/parsing.html#escapingString
+static void append_escaped_string(StringBuilder& builder, StringView string, AttributeMode attribute_mode)
 {
-    // https://html.spec.whatwg.org/multipage/parsing.html#escapingString
-    StringBuilder builder;
-    for (auto code_point : Utf8View { string }) {
+    // NOTE: Everything that needs escaping is either ASCII or U+00A0 (0xC2 0xA0 in UTF-8), neither of which can be part of
+    //       another code point's UTF-8 sequence. So we look at the string byte by byte, and append everything between the
+    //       characters that need escaping in one go.
+    size_t run_start = 0;
+    auto flush_run = [&](size_t run_end) {
+        builder.append(string.substring_view(run_start, run_end - run_start));
+    };
+
+    for (size_t i = 0; i < string.length(); ++i) {
+        StringView replacement;
+        size_t length = 1;
+        auto byte = static_cast<u8>(string[i]);
+
         // 1. Replace any occurrence of the "&" character by the string "&amp;".
-        if (code_point == '&')
-            builder.append("&amp;"sv);
+        if (byte == '&') {
+            replacement = "&amp;"sv;
+        }
         // 2. Replace any occurrences of the U+00A0 NO-BREAK SPACE character by the string "&nbsp;".
-        else if (code_point == 0xA0)
-            builder.append("&nbsp;"sv);
+        else if (byte == 0xC2 && i + 1 < string.length() && static_cast<u8>(string[i + 1]) == 0xA0) {
+            replacement = "&nbsp;"sv;
+            length = 2;
+        }
         // 3. If the algorithm was invoked in the attribute mode, replace any occurrences of the """ character by the string "&quot;".
-        else if (code_point == '"' && attribute_mode == AttributeMode::Yes)
-            builder.append("&quot;"sv);
+        else if (byte == '"' && attribute_mode == AttributeMode::Yes) {
+            replacement = "&quot;"sv;
+        }
         // 4. If the algorithm was not invoked in the attribute mode, replace any occurrences of the "<" character by the string "&lt;", and any occurrences of the ">" character by the string "&gt;".
-        else if (code_point == '<' && attribute_mode == AttributeMode::No)
-            builder.append("&lt;"sv);
-        else if (code_point == '>' && attribute_mode == AttributeMode::No)
-            builder.append("&gt;"sv);
-        else
-            builder.append_code_point(code_point);
+        else if (byte == '<' && attribute_mode == AttributeMode::No) {
+            replacement = "&lt;"sv;
+        } else if (byte == '>' && attribute_mode == AttributeMode::No) {
+            replacement = "&gt;"sv;
+        } else {
+            continue;
+        }
+
+        flush_run(i);
+        builder.append(replacement);
+        i += length - 1;
+        run_start = i + 1;
     }
-    return builder.to_string_without_validation();
+    flush_run(string.length());
 }
 
 // https://html.spec.whatwg.org/multipage/parsing.html#html-fragment-serialisation-algorithm
-String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableShadowRoots serializable_shadow_roots, Vector<JS::Handle<DOM::ShadowRoot>> const& shadow_roots, DOM::FragmentSerializationMode fragment_serialization_mode)
+// NOTE: Rather than building a string for every element and appending it to the one of its parent, the whole fragment is
+//       serialized into the same builder.
+static void serialize_html_fragment_into(StringBuilder& builder, DOM::Node const& node, HTMLParser::SerializableShadowRoots serializable_shadow_roots, Vector<JS::Handle<DOM::ShadowRoot>> const& shadow_roots, DOM::FragmentSerializationMode fragment_serialization_mode = DOM::FragmentSerializationMode::Inner)
 {
     // NOTE: Steps in this function are jumbled a bit to accommodate the Element.outerHTML API.
     //       When called with FragmentSerializationMode::Outer, we will serialize the element itself,
     //       not just its children.
 
     // 2. Let s be a string, and initialize it to the empty string.
-    StringBuilder builder;
+    // NOTE: This is the builder we were given.
 
     auto serialize_element = [&](DOM::Element const& element) {
         // If current node is an element in the HTML namespace, the MathML namespace, or the SVG namespace, then let tagname be current node's local name.
@@ -4447,7 +4471,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
         // followed by a U+0022 QUOTATION MARK character (").
         if (element.is_value().has_value() && !element.has_attribute(AttributeNames::is)) {
             builder.append(" is=\""sv);
-            builder.append(escape_string(element.is_value().value(), AttributeMode::Yes));
+            append_escaped_string(builder, element.is_value().value(), AttributeMode::Yes);
             builder.append('"');
         }
 
@@ -4480,7 +4504,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
             builder.append(attribute.name());
 
             builder.append("=\""sv);
-            builder.append(escape_string(attribute.value(), AttributeMode::Yes));
+            append_escaped_string(builder, attribute.value(), AttributeMode::Yes);
             builder.append('"');
         });
 
@@ -4497,7 +4521,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
         // a U+002F SOLIDUS character (/),
         // tagname again,
         // and finally a U+003E GREATER-THAN SIGN character (>).
-        builder.append(serialize_html_fragment(element, serializable_shadow_roots, shadow_roots));
+        serialize_html_fragment_into(builder, element, serializable_shadow_roots, shadow_roots);
         builder.append("</"sv);
         builder.append(tag_name);
         builder.append('>');
@@ -4507,7 +4531,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
 
     if (fragment_serialization_mode == DOM::FragmentSerializationMode::Outer) {
         serialize_element(verify_cast<DOM::Element>(node));
-        return builder.to_string_without_validation();
+        return;
     }
 
     // The algorithm takes as input a DOM Element, Document, or DocumentFragment referred to as the node.
@@ -4520,7 +4544,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
         // 1. If the node serializes as void, then return the empty string.
         //    (NOTE: serializes as void is defined only on elements in the spec)
         if (element.serializes_as_void())
-            return String {};
+            return;
 
         // 3. If the node is a template element, then let the node instead be the template element's template contents (a DocumentFragment node).
         //    (NOTE: This is out of order of the spec to avoid another dynamic cast. The second step just creates a string builder, so it shouldn't matter)
@@ -4535,7 +4559,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
             // 2. If one of the following is true:
             //    - serializableShadowRoots is true and shadow's serializable is true; or
             //    - shadowRoots contains shadow,
-            if ((serializable_shadow_roots == SerializableShadowRoots::Yes && shadow->serializable())
+            if ((serializable_shadow_roots == HTMLParser::SerializableShadowRoots::Yes && shadow->serializable())
                 || shadow_roots.find_first_index_if([&](auto& entry) { return entry == shadow; }).has_value()) {
                 // then:
                 // 1. Append "<template shadowrootmode="".
@@ -4564,7 +4588,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
 
                 // 8. Append the value of running the HTML fragment serialization algorithm with shadow,
                 //    serializableShadowRoots, and shadowRoots (thus recursing into this algorithm for that element).
-                builder.append(serialize_html_fragment(*shadow, serializable_shadow_roots, shadow_roots));
+                serialize_html_fragment_into(builder, *shadow, serializable_shadow_roots, shadow_roots);
 
                 // 9. Append "</template>".
                 builder.append("</template>"sv);
@@ -4603,7 +4627,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
             }
 
             // Otherwise, append the value of current node's data IDL attribute, escaped as described below.
-            builder.append(escape_string(text_node.data(), AttributeMode::No));
+            append_escaped_string(builder, text_node.data(), AttributeMode::No);
         }
 
         if (is<DOM::Comment>(current_node)) {
@@ -4647,9 +4671,15 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
 
         return IterationDecision::Continue;
     });
+}
+
+String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableShadowRoots serializable_shadow_roots, Vector<JS::Handle<DOM::ShadowRoot>> const& shadow_roots, DOM::FragmentSerializationMode fragment_serialization_mode)
+{
+    StringBuilder builder;
+    serialize_html_fragment_into(builder, node, serializable_shadow_roots, shadow_roots, fragment_serialization_mode);
 
     // 6. Return s.
-    return MUST(builder.to_string());
+    return builder.to_string_without_validation();
 }
 
 // https://html.spec.whatwg.org/multipage/common-microsyntaxes.html#current-dimension-value
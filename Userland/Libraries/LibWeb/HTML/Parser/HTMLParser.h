@@ -11,6 +11,7 @@
 #include <LibWeb/DOM/Node.h>
 #include <LibWeb/HTML/Parser/HTMLTokenizer.h>
 #include <LibWeb/HTML/Parser/ListOfActiveFormattingElements.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
 #include <LibWeb/HTML/Parser/StackOfOpenElements.h>
 
 namespace Web::HTML {
@@ -185,6 +186,7 @@ private:
     ListOfActiveFormattingElements m_list_of_active_formatting_elements;
 
     HTMLTokenizer m_tokenizer;
+    SpeculativeHTMLParser m_speculative_parser;
 
     bool m_foster_parenting { false };
     bool m_frameset_ok { true };
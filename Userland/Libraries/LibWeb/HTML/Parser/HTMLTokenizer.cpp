@@ -5,9 +5,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/GenericShorthands.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/SourceLocation.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
@@ -61,16 +64,24 @@ namespace Web::HTML {
         goto _StartOfFunction;                   \
     } while (0)
 
-#define SWITCH_TO_AND_EMIT_CURRENT_TOKEN(new_state)     \
+// NOTE: Most tokens are emitted while nothing else is queued, in which case there's no need to go through the queue.
+#define EMIT_CURRENT_TOKEN_AFTER_QUEUED_TOKENS          \
     do {                                                \
-        VERIFY(m_current_builder.is_empty());           \
-        will_switch_to(State::new_state);               \
-        m_state = State::new_state;                     \
-        will_emit(m_current_token);                     \
+        if (m_queued_tokens.is_empty())                 \
+            return move(m_current_token);               \
         m_queued_tokens.enqueue(move(m_current_token)); \
         return m_queued_tokens.dequeue();               \
     } while (0)
 
+#define SWITCH_TO_AND_EMIT_CURRENT_TOKEN(new_state) \
+    do {                                            \
+        VERIFY(m_current_builder.is_empty());       \
+        will_switch_to(State::new_state);           \
+        m_state = State::new_state;                 \
+        will_emit(m_current_token);                 \
+        EMIT_CURRENT_TOKEN_AFTER_QUEUED_TOKENS;     \
+    } while (0)
+
 #define EMIT_CHARACTER_AND_RECONSUME_IN(code_point, new_state)          \
     do {                                                                \
         m_queued_tokens.enqueue(HTMLToken::make_character(code_point)); \
@@ -151,12 +162,11 @@ namespace Web::HTML {
         return m_queued_tokens.dequeue();               \
     } while (0)
 
-#define EMIT_CHARACTER(code_point)                      \
-    do {                                                \
-        create_new_token(HTMLToken::Type::Character);   \
-        m_current_token.set_code_point(code_point);     \
-        m_queued_tokens.enqueue(move(m_current_token)); \
-        return m_queued_tokens.dequeue();               \
+#define EMIT_CHARACTER(code_point)                    \
+    do {                                              \
+        create_new_token(HTMLToken::Type::Character); \
+        m_current_token.set_code_point(code_point);   \
+        EMIT_CURRENT_TOKEN_AFTER_QUEUED_TOKENS;       \
     } while (0)
 
 #define EMIT_CURRENT_CHARACTER \
@@ -238,6 +248,69 @@ void HTMLTokenizer::skip(size_t count)
     }
 }
 
+// Returns the number of bytes before the first occurrence of any of the given ASCII characters, or the number of bytes
+// if there is none. All bytes of a multi-byte UTF-8 sequence have their high bit set, so this never stops in the middle
+// of a code point.
+template<u8... stop_characters>
+static size_t length_of_run_without(ReadonlyBytes bytes)
+{
+    using AK::SIMD::u64x2;
+    using AK::SIMD::u8x16;
+
+    size_t offset = 0;
+    for (; offset + sizeof(u8x16) <= bytes.size(); offset += sizeof(u8x16)) {
+        auto chunk = AK::SIMD::load_unaligned<u8x16>(bytes.offset(offset));
+        auto matches = bit_cast<u64x2>(((chunk == stop_characters) | ...));
+        if (matches[0] != 0 || matches[1] != 0)
+            break;
+    }
+    for (; offset < bytes.size(); ++offset) {
+        if (((bytes[offset] == stop_characters) || ...))
+            break;
+    }
+    return offset;
+}
+
+// Consumes the code points up to the next occurrence of any of the given ASCII characters, a NULL, a carriage return, or
+// the insertion point, and returns them. States that only accumulate "anything else" code points use this to take a
+// whole run of them at once, instead of going around the tokenizer loop for each of them.
+template<u8... stop_characters>
+StringView HTMLTokenizer::consume_run_of_code_points_without()
+{
+    auto start = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto end = m_utf8_view.byte_length();
+    if (m_insertion_point.defined)
+        end = clamp(m_insertion_point.position, start, end);
+
+    auto bytes = ReadonlyBytes { m_utf8_view.bytes() + start, end - start };
+    auto length = length_of_run_without<'\0', '\r', stop_characters...>(bytes);
+    if (length == 0)
+        return {};
+
+    auto last_code_point_offset = length - 1;
+    while (last_code_point_offset > 0 && (bytes[last_code_point_offset] & 0xC0) == 0x80)
+        --last_code_point_offset;
+    m_prev_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(start + last_code_point_offset);
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(start + length);
+
+    // NOTE: Nothing looks further back than the code point after the run, so a single position for the whole run will do.
+    if (!m_source_positions.is_empty()) {
+        m_source_positions.append(m_source_positions.last());
+        auto& position = m_source_positions.last();
+        for (size_t i = 0; i < length; ++i) {
+            if (bytes[i] == '\n') {
+                position.column = 0;
+                position.line++;
+            } else if ((bytes[i] & 0xC0) != 0x80) {
+                position.column++;
+            }
+        }
+        position.byte_offset += length;
+    }
+
+    return StringView { bytes.trim(length) };
+}
+
 Optional<u32> HTMLTokenizer::peek_code_point(size_t offset) const
 {
     auto it = m_utf8_iterator;
@@ -1272,6 +1345,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    m_current_builder.append(consume_run_of_code_points_without<'"', '&'>());
                     continue;
                 }
             }
@@ -1304,6 +1378,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    m_current_builder.append(consume_run_of_code_points_without<'\'', '&'>());
                     continue;
                 }
             }
@@ -1474,6 +1549,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    m_current_builder.append(consume_run_of_code_points_without<'<', '-'>());
                     continue;
                 }
             }
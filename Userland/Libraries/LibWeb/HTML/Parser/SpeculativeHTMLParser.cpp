@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOMURL/DOMURL.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
+#include <LibWeb/HTML/SourceSet.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+
+namespace Web::HTML {
+
+static bool link_type_list_contains(StringView rel, StringView link_type)
+{
+    for (auto keyword : rel.split_view_if(Infra::is_ascii_whitespace)) {
+        if (keyword.equals_ignoring_ascii_case(link_type))
+            return true;
+    }
+    return false;
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#start-the-speculative-html-parser
+void SpeculativeHTMLParser::start(DOM::Document& document, HTMLTokenizer const& parser_tokenizer)
+{
+    auto input = parser_tokenizer.unparsed_input();
+    auto input_length = parser_tokenizer.input_length();
+
+    // NOTE: We have seen everything ahead of the parser already, except for the input that scripts have inserted since
+    //       we last started. That's inserted where the parser was blocked, so it's right in front of the parser.
+    auto unseen_input_length = input.length();
+    if (m_input_length_at_last_start.has_value())
+        unseen_input_length = min(input_length - *m_input_length_at_last_start, input.length());
+    m_input_length_at_last_start = input_length;
+    if (unseen_input_length == 0)
+        return;
+
+    // NOTE: Only the first base element with an href attribute counts, so one that comes later can only matter if the
+    //       document doesn't have one yet.
+    auto base_url = document.base_url();
+    bool may_find_base_url = base_url == document.fallback_base_url();
+
+    HTMLTokenizer tokenizer { input.substring_view(0, unseen_input_length), "UTF-8"sv };
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            return;
+        if (!token->is_start_tag())
+            continue;
+
+        // NOTE: The tree builder is what switches the tokenizer into the states for raw text, so we have to do that ourselves.
+        auto const& tag_name = token->tag_name();
+        if (tag_name == TagNames::script) {
+            tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+            if (auto src = token->attribute(AttributeNames::src); src.has_value())
+                speculatively_connect(document, base_url, *src);
+        } else if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes)) {
+            tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        } else if (tag_name.is_one_of(TagNames::textarea, TagNames::title)) {
+            tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+        } else if (tag_name == TagNames::plaintext) {
+            return;
+        } else if (tag_name == TagNames::link) {
+            auto rel = token->attribute(AttributeNames::rel).value_or({});
+            if (link_type_list_contains(rel, "stylesheet"sv) || link_type_list_contains(rel, "preload"sv)) {
+                if (auto href = token->attribute(AttributeNames::href); href.has_value())
+                    speculatively_connect(document, base_url, *href);
+            }
+        } else if (tag_name == TagNames::img) {
+            if (auto src = token->attribute(AttributeNames::src); src.has_value())
+                speculatively_connect(document, base_url, *src);
+            if (auto srcset = token->attribute(AttributeNames::srcset); srcset.has_value()) {
+                for (auto const& source : parse_a_srcset_attribute(*srcset).m_sources)
+                    speculatively_connect(document, base_url, source.url);
+            }
+        } else if (tag_name == TagNames::base && may_find_base_url) {
+            if (auto href = token->attribute(AttributeNames::href); href.has_value()) {
+                if (auto url = DOMURL::parse(*href, base_url); url.is_valid())
+                    base_url = move(url);
+                may_find_base_url = false;
+            }
+        }
+    }
+}
+
+void SpeculativeHTMLParser::speculatively_connect(DOM::Document& document, URL::URL const& base_url, StringView url_string)
+{
+    auto url = DOMURL::parse(url_string, base_url);
+    if (!url.is_valid() || !url.scheme().is_one_of("http"sv, "https"sv))
+        return;
+
+    // NOTE: We are already connected to the document's own origin.
+    auto origin = url.origin();
+    if (origin.is_same_origin(document.origin()))
+        return;
+    if (m_connected_origins.set(origin.serialize()) != HashSetResult::InsertedNewEntry)
+        return;
+
+    ResourceLoader::the().preconnect(url);
+}
+
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashTable.h>
+#include <AK/Optional.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+// Looks through the input that an HTML parser hasn't gotten to yet for resources that are going to be fetched, while the
+// parser is blocked on a script.
+// NOTE: There is no cache that speculatively fetched responses could be handed to the real fetches through, so instead of
+//       fetching these resources, we connect to their origins ahead of time.
+class SpeculativeHTMLParser {
+public:
+    void start(DOM::Document&, HTMLTokenizer const&);
+
+private:
+    void speculatively_connect(DOM::Document&, URL::URL const& base_url, StringView url);
+
+    HashTable<ByteString> m_connected_origins;
+
+    // NOTE: Input only ever gets added to the parser's input, so its growth since we last started is what we haven't seen
+    //       yet. That way, every part of the input is only looked at once, however often the parser blocks.
+    Optional<size_t> m_input_length_at_last_start;
+};
+
+}
@@ -12,6 +12,7 @@
 #include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Statuses.h>
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+#include <LibWeb/HTML/DecodedImageCache.h>
 #include <LibWeb/HTML/DecodedImageData.h>
 #include <LibWeb/HTML/SharedResourceRequest.h>
 #include <LibWeb/Page/Page.h>
@@ -46,6 +47,10 @@ SharedResourceRequest::~SharedResourceRequest() = default;
 void SharedResourceRequest::finalize()
 {
     Base::finalize();
+    if (m_decoding_session) {
+        m_decoding_session->on_partial_image = nullptr;
+        m_decoding_session = nullptr;
+    }
     auto& shared_resource_requests = m_document->shared_resource_requests();
     shared_resource_requests.remove(m_url);
 }
@@ -59,6 +64,8 @@ void SharedResourceRequest::visit_edges(JS::Cell::Visitor& visitor)
     for (auto& callback : m_callbacks) {
         visitor.visit(callback.on_finish);
         visitor.visit(callback.on_fail);
+        visitor.visit(callback.on_partial);
+        visitor.visit(callback.display_size);
     }
     visitor.visit(m_image_data);
 }
@@ -86,10 +93,16 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, JS::NonnullGCPtr<Fe
         //        https://github.com/whatwg/html/issues/9355
         response = response->unsafe_response();
 
-        auto process_body = JS::create_heap_function(heap(), [this, request, response](ByteBuffer data) {
-            auto extracted_mime_type = response->header_list()->extract_mime_type();
-            auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence().bytes_as_string_view() : StringView {};
-            handle_successful_fetch(request->url(), mime_type, move(data));
+        auto extracted_mime_type = response->header_list()->extract_mime_type();
+        auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence() : String {};
+        bool const is_svg_image = mime_type == "image/svg+xml"sv || request->url().basename().ends_with(".svg"sv);
+
+        // NOTE: We read the body as it arrives, so that we can show what we've got of an image before it has fully loaded.
+        auto process_body_chunk = JS::create_heap_function(heap(), [this, is_svg_image](ByteBuffer chunk) {
+            handle_received_data(chunk, is_svg_image);
+        });
+        auto process_end_of_body = JS::create_heap_function(heap(), [this, request, mime_type] {
+            handle_successful_fetch(request->url(), mime_type, move(m_encoded_data));
         });
         auto process_body_error = JS::create_heap_function(heap(), [this](JS::Value) {
             handle_failed_fetch();
@@ -101,7 +114,7 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, JS::NonnullGCPtr<Fe
             return;
         }
 
-        response->body()->fully_read(realm, process_body, process_body_error, JS::NonnullGCPtr { realm.global_object() });
+        response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, JS::NonnullGCPtr { realm.global_object() });
     };
 
     m_state = State::Fetching;
@@ -115,12 +128,19 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, JS::NonnullGCPtr<Fe
     set_fetch_controller(fetch_controller);
 }
 
-void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial, Function<Optional<Gfx::IntSize>()> display_size)
 {
-    if (m_state == State::Finished) {
-        if (on_finish)
-            on_finish();
-        return;
+    bool needs_decoding_at_natural_size = false;
+    if (m_state == State::Finished && !m_is_decoding_at_natural_size) {
+        if (can_use_reduced_size_image(display_size)) {
+            if (on_finish)
+                on_finish();
+            return;
+        }
+
+        // NOTE: The image was decoded at a smaller size than this user needs, so we decode it again. Until then, the
+        //       callbacks wait in line with those of anyone else who comes along.
+        needs_decoding_at_natural_size = true;
     }
 
     if (m_state == State::Failed) {
@@ -134,8 +154,81 @@ void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<v
         callbacks.on_finish = JS::create_heap_function(vm().heap(), move(on_finish));
     if (on_fail)
         callbacks.on_fail = JS::create_heap_function(vm().heap(), move(on_fail));
+    if (on_partial)
+        callbacks.on_partial = JS::create_heap_function(vm().heap(), move(on_partial));
+    if (display_size)
+        callbacks.display_size = JS::create_heap_function(vm().heap(), move(display_size));
 
     m_callbacks.append(move(callbacks));
+
+    if (needs_decoding_at_natural_size)
+        decode_at_natural_size();
+}
+
+Optional<Gfx::IntSize> SharedResourceRequest::ideal_decode_size() const
+{
+    // NOTE: We can only decode the image at a smaller size if we know how large every one of its users is going to show it.
+    Optional<Gfx::IntSize> ideal_size;
+    for (auto const& callback : m_callbacks) {
+        if (!callback.display_size)
+            return {};
+        auto display_size = callback.display_size->function()();
+        if (!display_size.has_value() || display_size->is_empty())
+            return {};
+        if (!ideal_size.has_value())
+            ideal_size = *display_size;
+        else
+            ideal_size = Gfx::IntSize { max(ideal_size->width(), display_size->width()), max(ideal_size->height(), display_size->height()) };
+    }
+    return ideal_size;
+}
+
+bool SharedResourceRequest::can_use_reduced_size_image(Function<Optional<Gfx::IntSize>()> const& display_size) const
+{
+    if (!m_reduced_decode_size.has_value())
+        return true;
+    if (!display_size)
+        return false;
+    auto size = display_size();
+    return size.has_value() && size->width() <= m_reduced_decode_size->width() && size->height() <= m_reduced_decode_size->height();
+}
+
+void SharedResourceRequest::handle_received_data(ReadonlyBytes data, bool is_svg_image)
+{
+    m_encoded_data.append(data);
+
+    // NOTE: SVG images have to be parsed as a whole, so there's no point in decoding them as they come in.
+    if (!m_did_try_to_start_decoding_session && !is_svg_image) {
+        m_did_try_to_start_decoding_session = true;
+        m_decoding_session = Web::Platform::ImageCodecPlugin::the().start_decoding_session();
+        if (m_decoding_session) {
+            m_decoding_session->on_partial_image = [this](NonnullRefPtr<Gfx::Bitmap> bitmap) {
+                handle_partially_decoded_image(move(bitmap));
+            };
+        }
+    }
+
+    if (m_decoding_session) {
+        if (auto result = m_decoding_session->append(data); result.is_error()) {
+            dbgln("Unable to decode image as it arrives: {}", result.error());
+            m_decoding_session = nullptr;
+        }
+    }
+}
+
+void SharedResourceRequest::handle_partially_decoded_image(NonnullRefPtr<Gfx::Bitmap> bitmap)
+{
+    if (m_state != State::Fetching)
+        return;
+
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    frames.append({ .bitmap = Gfx::ImmutableBitmap::create(*bitmap), .duration = 0 });
+    m_image_data = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), 0, false).release_value_but_fixme_should_propagate_errors();
+
+    for (auto& callback : m_callbacks) {
+        if (callback.on_partial)
+            callback.on_partial->function()();
+    }
 }
 
 void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string, StringView mime_type, ByteBuffer data)
@@ -145,6 +238,11 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
 
     bool const is_svg_image = mime_type == "image/svg+xml"sv || url_string.basename().ends_with(".svg"sv);
 
+    // NOTE: From here on, the session only gets to give us the complete image.
+    auto decoding_session = move(m_decoding_session);
+    if (decoding_session)
+        decoding_session->on_partial_image = nullptr;
+
     if (is_svg_image) {
         auto result = SVG::SVGDecodedImageData::create(m_document->realm(), m_page, url_string, data);
         if (result.is_error()) {
@@ -156,24 +254,103 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
         return;
     }
 
-    auto handle_successful_bitmap_decode = [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
-        Vector<AnimatedBitmapDecodedImageData::Frame> frames;
-        for (auto& frame : result.frames) {
-            frames.append(AnimatedBitmapDecodedImageData::Frame {
-                .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap),
-                .duration = static_cast<int>(frame.duration),
-            });
+    // NOTE: Another document in this process may already have decoded the very same bytes.
+    auto encoded_data_digest = DecodedImageCache::digest_encoded_data(data);
+    if (auto cached_image = DecodedImageCache::the().get(url_string, encoded_data_digest); cached_image.has_value()) {
+        auto image_data = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(cached_image->frames), cached_image->loop_count, cached_image->is_animated).release_value_but_fixme_should_propagate_errors();
+        image_data->set_encoded_data(move(data), *m_document);
+        m_image_data = image_data;
+        handle_successful_resource_load();
+        return;
+    }
+
+    auto ideal_size = ideal_decode_size();
+
+    auto handle_successful_bitmap_decode = [strong_this = JS::Handle(*this), url = url_string, encoded_data_digest, ideal_size](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+        auto natural_size = result.natural_size;
+        bool const is_reduced_size = !natural_size.is_empty() && !result.frames.is_empty() && result.frames.first().bitmap->size() != natural_size;
+        bool const can_be_shared = !result.frame_stream && !is_reduced_size;
+
+        if (is_reduced_size)
+            strong_this->m_reduced_decode_size = ideal_size;
+
+        // NOTE: Streamed images only hold on to a few of their frames at a time, and images decoded at a reduced size
+        //       are of no use to anyone who shows them larger, so we only share the others.
+        if (can_be_shared) {
+            Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+            for (auto& frame : result.frames)
+                frames.append({ .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap), .duration = static_cast<int>(frame.duration) });
+            DecodedImageCache::the().set(url, encoded_data_digest, { frames, result.loop_count, result.is_animated });
         }
-        strong_this->m_image_data = AnimatedBitmapDecodedImageData::create(strong_this->m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
+
+        strong_this->set_image_data_from_decoded_image(result, move(strong_this->m_encoded_data));
         strong_this->handle_successful_resource_load();
         return {};
     };
 
     auto handle_failed_decode = [strong_this = JS::Handle(*this)](Error&) -> void {
+        strong_this->m_encoded_data.clear();
         strong_this->handle_failed_fetch();
     };
 
-    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode));
+    // NOTE: We hold on to the encoded data until the image is decoded, then hand it to the image data, so that it can be
+    //       decoded again at its natural size, or after its bitmaps have been discarded.
+    m_encoded_data = move(data);
+
+    if (decoding_session) {
+        (void)decoding_session->finish(move(handle_successful_bitmap_decode), move(handle_failed_decode), ideal_size);
+        return;
+    }
+
+    (void)Web::Platform::ImageCodecPlugin::the().decode_image(m_encoded_data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode), ideal_size);
+}
+
+void SharedResourceRequest::set_image_data_from_decoded_image(Platform::DecodedImage& result, ByteBuffer encoded_data)
+{
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    for (auto& frame : result.frames) {
+        frames.append(AnimatedBitmapDecodedImageData::Frame {
+            .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap),
+            .duration = static_cast<int>(frame.duration),
+        });
+    }
+
+    JS::GCPtr<AnimatedBitmapDecodedImageData> image_data;
+    if (result.frame_stream)
+        image_data = AnimatedBitmapDecodedImageData::create_streamed(m_document->realm(), move(frames), result.frame_count, result.loop_count, result.frame_stream.release_nonnull(), result.natural_size).release_value_but_fixme_should_propagate_errors();
+    else
+        image_data = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), result.loop_count, result.is_animated, result.natural_size).release_value_but_fixme_should_propagate_errors();
+
+    image_data->set_encoded_data(move(encoded_data), *m_document);
+    m_image_data = image_data;
+}
+
+void SharedResourceRequest::decode_at_natural_size()
+{
+    VERIFY(m_reduced_decode_size.has_value());
+    m_is_decoding_at_natural_size = true;
+
+    // NOTE: Anyone who already uses the image at its reduced size keeps doing so, so we need a copy of its data.
+    m_encoded_data = MUST(ByteBuffer::copy(verify_cast<AnimatedBitmapDecodedImageData>(*m_image_data).encoded_data()));
+
+    auto handle_successful_bitmap_decode = [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+        strong_this->m_is_decoding_at_natural_size = false;
+        strong_this->m_reduced_decode_size.clear();
+        strong_this->set_image_data_from_decoded_image(result, move(strong_this->m_encoded_data));
+        strong_this->handle_successful_resource_load();
+        return {};
+    };
+
+    // NOTE: We still have the image at a reduced size, which is better than nothing, so we settle for that.
+    auto handle_failed_decode = [strong_this = JS::Handle(*this)](Error& error) -> void {
+        dbgln("Unable to decode image at its natural size: {}", error);
+        strong_this->m_is_decoding_at_natural_size = false;
+        strong_this->m_reduced_decode_size.clear();
+        strong_this->m_encoded_data.clear();
+        strong_this->handle_successful_resource_load();
+    };
+
+    (void)Web::Platform::ImageCodecPlugin::the().decode_image(m_encoded_data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode));
 }
 
 void SharedResourceRequest::handle_failed_fetch()
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/ByteBuffer.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Size.h>
 #include <LibJS/Heap/Handle.h>
@@ -35,9 +36,13 @@ public:
 
     void fetch_resource(JS::Realm&, JS::NonnullGCPtr<Fetch::Infrastructure::Request>);
 
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    // NOTE: on_partial is called whenever image_data() has been updated with a partially decoded image while fetching.
+    //       display_size tells us how many device pixels the image is going to be shown at, if that's known up front. Only
+    //       if it is known for every user of the image do we decode it at a smaller size than it has.
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial = {}, Function<Optional<Gfx::IntSize>()> display_size = {});
 
     bool is_fetching() const;
+    bool was_decoded_at_reduced_size() const { return m_reduced_decode_size.has_value(); }
     bool needs_fetching() const;
 
 private:
@@ -46,7 +51,11 @@ private:
     virtual void finalize() override;
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
+    void handle_received_data(ReadonlyBytes, bool is_svg_image);
+    void handle_partially_decoded_image(NonnullRefPtr<Gfx::Bitmap>);
     void handle_successful_fetch(URL::URL const&, StringView mime_type, ByteBuffer data);
+    void set_image_data_from_decoded_image(Platform::DecodedImage&, ByteBuffer encoded_data);
+    void decode_at_natural_size();
     void handle_failed_fetch();
     void handle_successful_resource_load();
 
@@ -64,9 +73,25 @@ private:
     struct Callbacks {
         JS::GCPtr<JS::HeapFunction<void()>> on_finish;
         JS::GCPtr<JS::HeapFunction<void()>> on_fail;
+        JS::GCPtr<JS::HeapFunction<void()>> on_partial;
+        JS::GCPtr<JS::HeapFunction<Optional<Gfx::IntSize>()>> display_size;
     };
     Vector<Callbacks> m_callbacks;
 
+    Optional<Gfx::IntSize> ideal_decode_size() const;
+    bool can_use_reduced_size_image(Function<Optional<Gfx::IntSize>()> const& display_size) const;
+
+    // The data we've received so far, and the session decoding it as it comes in, if any. Once the image is decoded, the
+    // data goes to its image data.
+    ByteBuffer m_encoded_data;
+    RefPtr<Platform::DecodingSession> m_decoding_session;
+    bool m_did_try_to_start_decoding_session { false };
+
+    // If the image was decoded at a smaller size than it has, the size it was decoded for. We then decode it again at its
+    // natural size if someone needs it larger later on.
+    Optional<Gfx::IntSize> m_reduced_decode_size;
+    bool m_is_decoding_at_natural_size { false };
+
     URL::URL m_url;
     JS::GCPtr<DecodedImageData> m_image_data;
     JS::GCPtr<Fetch::Infrastructure::FetchController> m_fetch_controller;
@@ -9,11 +9,23 @@
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/StoragePrototype.h>
 #include <LibWeb/HTML/Storage.h>
+#include <LibWeb/Platform/StoragePlugin.h>
 
 namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(Storage);
 
+static HashMap<URL::Origin, JS::Handle<Storage>>& local_storage_per_origin()
+{
+    static HashMap<URL::Origin, JS::Handle<Storage>> local_storage_per_origin;
+    return local_storage_per_origin;
+}
+
+static size_t item_size(StringView key, StringView value)
+{
+    return key.length() + value.length();
+}
+
 JS::NonnullGCPtr<Storage> Storage::create(JS::Realm& realm)
 {
     return realm.heap().allocate<Storage>(realm, realm);
@@ -37,6 +49,73 @@ Storage::Storage(JS::Realm& realm)
 
 Storage::~Storage() = default;
 
+JS::NonnullGCPtr<Storage> Storage::local_storage_for_origin(JS::Realm& realm, URL::Origin const& origin)
+{
+    auto storage = local_storage_per_origin().ensure(origin, [&]() -> JS::Handle<Storage> {
+        auto storage = create(realm);
+
+        // NOTE: Opaque origins are never the same as an origin in another process, so there is nothing to share.
+        if (auto* plugin = Platform::StoragePlugin::the(); plugin && !origin.is_opaque()) {
+            storage->m_plugin_origin = MUST(String::from_byte_string(origin.serialize()));
+            storage->m_map = plugin->load_local_storage(*storage->m_plugin_origin);
+            for (auto const& it : storage->m_map)
+                storage->m_size_in_bytes += item_size(it.key, it.value);
+        }
+
+        return storage;
+    });
+    return JS::NonnullGCPtr { *storage };
+}
+
+void Storage::apply_local_storage_change(String const& origin, Optional<String> const& key, Optional<String> const& value, bool is_own_change)
+{
+    // NOTE: If no document in this process has used the origin's storage yet, it will load the change with the rest.
+    for (auto& it : local_storage_per_origin()) {
+        if (it.value->m_plugin_origin == origin) {
+            it.value->apply_change(key, value, is_own_change);
+            return;
+        }
+    }
+}
+
+void Storage::apply_change(Optional<String> const& key, Optional<String> const& value, bool is_own_change)
+{
+    if (is_own_change) {
+        // Our map already has the change, we only have to stop protecting it.
+        if (!key.has_value()) {
+            VERIFY(m_pending_clears > 0);
+            --m_pending_clears;
+        } else if (auto it = m_pending_changes_per_key.find(*key); it != m_pending_changes_per_key.end() && --it->value == 0) {
+            m_pending_changes_per_key.remove(it);
+        }
+        return;
+    }
+
+    // NOTE: Our pending changes are stored after this one, so every process will apply them on top of it.
+    if (!key.has_value()) {
+        m_map.remove_all_matching([&](auto const& item_key, auto const&) {
+            return !m_pending_changes_per_key.contains(item_key);
+        });
+        m_size_in_bytes = 0;
+        for (auto const& it : m_map)
+            m_size_in_bytes += item_size(it.key, it.value);
+    } else {
+        if (m_pending_clears > 0 || m_pending_changes_per_key.contains(*key))
+            return;
+
+        if (auto it = m_map.find(*key); it != m_map.end()) {
+            m_size_in_bytes -= item_size(it->key, it->value);
+            m_map.remove(it);
+        }
+        if (value.has_value()) {
+            m_size_in_bytes += item_size(*key, *value);
+            m_map.set(*key, *value);
+        }
+    }
+
+    // FIXME: Fire a storage event at the windows of this origin, once we implement StorageEvent.
+}
+
 void Storage::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
@@ -98,11 +177,24 @@ WebIDL::ExceptionOr<void> Storage::set_item(String const& key, String const& val
         reorder = false;
     }
 
-    // FIXME: 4. If value cannot be stored, then throw a "QuotaExceededError" DOMException exception.
+    // 4. If value cannot be stored, then throw a "QuotaExceededError" DOMException exception.
+    if (m_plugin_origin.has_value()) {
+        auto new_size = m_size_in_bytes + item_size(key, value);
+        if (!reorder)
+            new_size -= item_size(key, old_value);
+        if (new_size > Platform::StoragePlugin::local_storage_quota_in_bytes)
+            return WebIDL::QuotaExceededError::create(realm(), "Local storage quota exceeded"_string);
+        m_size_in_bytes = new_size;
+    }
 
     // 5. Set this's map[key] to value.
     m_map.set(key, value);
 
+    if (m_plugin_origin.has_value()) {
+        m_pending_changes_per_key.ensure(key, [] { return 0; })++;
+        Platform::StoragePlugin::the()->set_local_storage_item(*m_plugin_origin, key, value);
+    }
+
     // 6. If reorder is true, then reorder this.
     if (reorder)
         this->reorder();
@@ -128,6 +220,13 @@ void Storage::remove_item(StringView key)
     // 3. Remove this's map[key].
     m_map.remove(it);
 
+    if (m_plugin_origin.has_value()) {
+        m_size_in_bytes -= item_size(key, old_value);
+        auto key_string = MUST(String::from_utf8(key));
+        m_pending_changes_per_key.ensure(key_string, [] { return 0; })++;
+        Platform::StoragePlugin::the()->remove_local_storage_item(*m_plugin_origin, key_string);
+    }
+
     // 4. Reorder this.
     reorder();
 
@@ -141,6 +240,12 @@ void Storage::clear()
     // 1. Clear this's map.
     m_map.clear();
 
+    if (m_plugin_origin.has_value()) {
+        m_size_in_bytes = 0;
+        ++m_pending_clears;
+        Platform::StoragePlugin::the()->clear_local_storage(*m_plugin_origin);
+    }
+
     // 2. Broadcast this with null, null, and null.
     broadcast({}, {}, {});
 }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <LibURL/Origin.h>
 #include <LibWeb/Bindings/PlatformObject.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
 
@@ -21,6 +22,14 @@ public:
     [[nodiscard]] static JS::NonnullGCPtr<Storage> create(JS::Realm&);
     ~Storage();
 
+    // The local storage of an origin is shared by all of the documents in the process that have that origin.
+    static JS::NonnullGCPtr<Storage> local_storage_for_origin(JS::Realm&, URL::Origin const&);
+
+    // Applies a change that the storage plugin has stored. Without a key, the change clears the storage, and without a
+    // value it removes the key. Our own changes are reported back as well, so that every process applies the changes
+    // to an origin in the same order and ends up agreeing with what was stored.
+    static void apply_local_storage_change(String const& origin, Optional<String> const& key, Optional<String> const& value, bool is_own_change);
+
     size_t length() const;
     Optional<String> key(size_t index);
     Optional<String> get_item(StringView key) const;
@@ -48,7 +57,17 @@ private:
     void reorder();
     void broadcast(StringView key, StringView old_value, StringView new_value);
 
+    void apply_change(Optional<String> const& key, Optional<String> const& value, bool is_own_change);
+
     OrderedHashMap<String, String> m_map;
+
+    // NOTE: These are only for the local storage of origins that the storage plugin keeps.
+    Optional<String> m_plugin_origin;
+    size_t m_size_in_bytes { 0 };
+    // Our changes that haven't been reported back yet, which the changes of other processes must not undo, as they
+    // were stored first.
+    HashMap<String, size_t> m_pending_changes_per_key;
+    size_t m_pending_clears { 0 };
 };
 
 }
@@ -58,6 +58,11 @@ namespace Web::HTML {
 // The format is generally u32-aligned (hence this leaking out into the type)
 // Each value has a length based on its type, as defined below.
 //
+// The values in the memory are numbered in the order in which they are first
+// encountered, starting after the values of the transfer list (if any). Both
+// the serializer and the deserializer count them the same way, so that an
+// ObjectReference only needs to store that number.
+//
 // (Should more redundancy be added, e.g., for lengths/positions of values?)
 
 enum ValueTag {
@@ -125,6 +130,21 @@ enum ValueTag {
     ValueTagMax,
 };
 
+// The keys of the properties of Array and Object values. Objects of the same
+// shape tend to share all of their keys, so every string key is only written
+// out once, and is referred to by its position in the list of keys written so
+// far afterwards.
+enum class PropertyKeyTag : u8 {
+    // Following u32 is the array index.
+    ArrayIndex,
+
+    // Followed by the string, which is added to the list of keys.
+    String,
+
+    // Following u32 is the position of the string in the list of keys.
+    StringReference,
+};
+
 enum ErrorType {
     Error,
 #define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType) \
@@ -149,20 +169,23 @@ static ErrorType error_name_to_type(String const& name)
 
 class Serializer {
 public:
-    Serializer(JS::VM& vm, SerializationMemory& memory, bool for_storage)
+    Serializer(JS::VM& vm, SerializationMemory& memory, bool for_storage, SerializationRecord& serialized)
         : m_vm(vm)
         , m_memory(memory)
+        , m_serialized(serialized)
         , m_for_storage(for_storage)
     {
     }
 
     // https://html.spec.whatwg.org/multipage/structured-data.html#structuredserializeinternal
-    WebIDL::ExceptionOr<SerializationRecord> serialize(JS::Value value)
+    // NOTE: Values are appended to the record given at construction, including the values nested inside of them.
+    WebIDL::ExceptionOr<void> serialize(JS::Value value)
     {
         // 2. If memory[value] exists, then return memory[value].
-        if (m_memory.contains(value)) {
-            auto index = m_memory.get(value).value();
-            return Vector<u32> { ValueTag::ObjectReference, index };
+        if (auto index = m_memory.get(value); index.has_value()) {
+            serialize_enum(m_serialized, ValueTag::ObjectReference);
+            serialize_primitive_type(m_serialized, *index);
+            return {};
         }
 
         // 3. Let deep be false.
@@ -191,7 +214,7 @@ public:
         }
 
         if (return_primitive_type)
-            return m_serialized;
+            return {};
 
         // 5. If Type(value) is Symbol, then throw a "DataCloneError" DOMException.
         if (value.is_symbol())
@@ -348,7 +371,7 @@ public:
         }
 
         // 25. Set memory[value] to serialized.
-        m_memory.set(make_handle(value), m_next_id++);
+        m_memory.set(make_handle(value), static_cast<u32>(m_memory.size()));
 
         // 26. If deep is true, then:
         if (deep) {
@@ -371,10 +394,8 @@ public:
                 for (auto copied_value : copied_list) {
                     // 1. Let serializedKey be ? StructuredSerializeInternal(entry.[[Key]], forStorage, memory).
                     // 2. Let serializedValue be ? StructuredSerializeInternal(entry.[[Value]], forStorage, memory).
-                    auto serialized_value = TRY(structured_serialize_internal(m_vm, copied_value, m_for_storage, m_memory));
-
                     // 3. Append { [[Key]]: serializedKey, [[Value]]: serializedValue } to serialized.[[MapData]].
-                    m_serialized.extend(serialized_value);
+                    TRY(serialize(copied_value));
                 }
             }
 
@@ -393,10 +414,8 @@ public:
                 // 3. For each entry of copiedList:
                 for (auto copied_value : copied_list) {
                     // 1. Let serializedEntry be ? StructuredSerializeInternal(entry, forStorage, memory).
-                    auto serialized_value = TRY(structured_serialize_internal(m_vm, copied_value, m_for_storage, m_memory));
-
                     // 2. Append serializedEntry to serialized.[[SetData]].
-                    m_serialized.extend(serialized_value);
+                    TRY(serialize(copied_value));
                 }
             }
 
@@ -420,11 +439,9 @@ public:
                         auto input_value = TRY(value.as_object().internal_get(property_key, value));
 
                         // 2. Let outputValue be ? StructuredSerializeInternal(inputValue, forStorage, memory).
-                        auto output_value = TRY(structured_serialize_internal(m_vm, input_value, m_for_storage, m_memory));
-
                         // 3. Append { [[Key]]: key, [[Value]]: outputValue } to serialized.[[Properties]].
-                        TRY(serialize_string(m_vm, m_serialized, key.as_string()));
-                        m_serialized.extend(output_value);
+                        TRY(serialize_property_key(property_key));
+                        TRY(serialize(input_value));
 
                         property_count++;
                     }
@@ -434,14 +451,35 @@ public:
         }
 
         // 27. Return serialized.
-        return m_serialized;
+        return {};
     }
 
 private:
+    WebIDL::ExceptionOr<void> serialize_property_key(JS::PropertyKey const& key)
+    {
+        if (key.is_number()) {
+            serialize_enum(m_serialized, PropertyKeyTag::ArrayIndex);
+            serialize_primitive_type(m_serialized, key.as_number());
+            return {};
+        }
+
+        auto const& string = key.as_string();
+        if (auto index = m_property_keys.get(string); index.has_value()) {
+            serialize_enum(m_serialized, PropertyKeyTag::StringReference);
+            serialize_primitive_type(m_serialized, *index);
+            return {};
+        }
+
+        m_property_keys.set(string, static_cast<u32>(m_property_keys.size()));
+        serialize_enum(m_serialized, PropertyKeyTag::String);
+        TRY(serialize_string(m_vm, m_serialized, string));
+        return {};
+    }
+
     JS::VM& m_vm;
     SerializationMemory& m_memory; // JS value -> index
-    u32 m_next_id { 0 };
-    SerializationRecord m_serialized;
+    SerializationRecord& m_serialized;
+    HashMap<DeprecatedFlyString, u32> m_property_keys; // Property key -> index
     bool m_for_storage { false };
 };
 
@@ -526,19 +564,10 @@ WebIDL::ExceptionOr<void> serialize_bytes(JS::VM& vm, Vector<u32>& vector, Reado
     // Append size of the buffer to the serialized structure.
     u64 const size = bytes.size();
     serialize_primitive_type(vector, size);
-    // Append the bytes of the buffer to the serialized structure.
-    u64 byte_position = 0;
-    while (byte_position < size) {
-        u32 combined_value = 0;
-        for (u8 i = 0; i < 4; ++i) {
-            u8 const byte = bytes[byte_position];
-            combined_value |= byte << (i * 8);
-            byte_position++;
-            if (byte_position == size)
-                break;
-        }
-        TRY_OR_THROW_OOM(vm, vector.try_append(combined_value));
-    }
+    // Append the bytes of the buffer to the serialized structure, zero-padded to a whole number of u32s.
+    auto const offset = vector.size();
+    TRY_OR_THROW_OOM(vm, vector.try_resize(offset + ceil_div(size, static_cast<u64>(sizeof(u32)))));
+    bytes.copy_to({ reinterpret_cast<u8*>(vector.data() + offset), size });
     return {};
 }
 
@@ -635,18 +664,21 @@ WebIDL::ExceptionOr<void> serialize_viewed_array_buffer(JS::VM& vm, Vector<u32>&
     // 2. Let buffer be the value of value's [[ViewedArrayBuffer]] internal slot.
     auto* buffer = view.viewed_array_buffer();
 
+    // NOTE: The [[Type]] of serialized is "ArrayBufferView" in both of the cases below, and bufferSerialized directly follows it.
+    serialize_enum(vector, ValueTag::ArrayBufferView);
+
     // 3. Let bufferSerialized be ? StructuredSerializeInternal(buffer, forStorage, memory).
-    auto buffer_serialized = TRY(structured_serialize_internal(vm, JS::Value(buffer), for_storage, memory));
+    auto buffer_serialized_position = vector.size();
+    Serializer serializer(vm, memory, for_storage, vector);
+    TRY(serializer.serialize(JS::Value(buffer)));
 
     // 4. Assert: bufferSerialized.[[Type]] is "ArrayBuffer", "ResizableArrayBuffer", "SharedArrayBuffer", or "GrowableSharedArrayBuffer".
-    // NOTE: We currently only implement this for ArrayBuffer
-    VERIFY(buffer_serialized[0] == ValueTag::ArrayBuffer);
+    // NOTE: We currently only implement this for ArrayBuffer. The buffer may also have already been serialized as part of another view.
+    VERIFY(vector[buffer_serialized_position] == ValueTag::ArrayBuffer || vector[buffer_serialized_position] == ValueTag::ObjectReference);
 
     // 5. If value has a [[DataView]] internal slot, then set serialized to { [[Type]]: "ArrayBufferView", [[Constructor]]: "DataView",
     //    [[ArrayBufferSerialized]]: bufferSerialized, [[ByteLength]]: value.[[ByteLength]], [[ByteOffset]]: value.[[ByteOffset]] }.
     if constexpr (IsSame<ViewType, JS::DataView>) {
-        serialize_enum(vector, ValueTag::ArrayBufferView);
-        vector.extend(move(buffer_serialized));               // [[ArrayBufferSerialized]]
         TRY(serialize_string(vm, vector, "DataView"_string)); // [[Constructor]]
         serialize_primitive_type(vector, JS::get_view_byte_length(view_record));
         serialize_primitive_type(vector, view.byte_offset());
@@ -659,8 +691,6 @@ WebIDL::ExceptionOr<void> serialize_viewed_array_buffer(JS::VM& vm, Vector<u32>&
         // 2. Set serialized to { [[Type]]: "ArrayBufferView", [[Constructor]]: value.[[TypedArrayName]],
         //    [[ArrayBufferSerialized]]: bufferSerialized, [[ByteLength]]: value.[[ByteLength]],
         //    [[ByteOffset]]: value.[[ByteOffset]], [[ArrayLength]]: value.[[ArrayLength]] }.
-        serialize_enum(vector, ValueTag::ArrayBufferView);
-        vector.extend(move(buffer_serialized));                 // [[ArrayBufferSerialized]]
         TRY(serialize_string(vm, vector, view.element_name())); // [[Constructor]]
         serialize_primitive_type(vector, JS::typed_array_byte_length(view_record));
         serialize_primitive_type(vector, view.byte_offset());
@@ -691,10 +721,8 @@ public:
 
         // 2. If memory[serialized] exists, then return memory[serialized].
         if (tag == ValueTag::ObjectReference) {
-            auto index = m_serialized[m_position++];
-            if (index == NumericLimits<u32>::max()) {
-                return JS::Object::create(*m_vm.current_realm(), nullptr);
-            }
+            auto index = deserialize_primitive_type<u32>(m_serialized, m_position);
+            VERIFY(index < m_memory.size());
             return m_memory[index];
         }
 
@@ -945,13 +973,13 @@ public:
                 auto length = deserialize_primitive_type<u64>(m_serialized, m_position);
                 // 1. For each Record { [[Key]], [[Value]] } entry of serialized.[[Properties]]:
                 for (u64 i = 0u; i < length; ++i) {
-                    auto key = TRY(deserialize_string(m_vm, m_serialized, m_position));
+                    auto key = TRY(deserialize_property_key());
 
                     // 1. Let deserializedValue be ? StructuredDeserialize(entry.[[Value]], targetRealm, memory).
                     auto deserialized_value = TRY(deserialize());
 
                     // 2. Let result be ! CreateDataProperty(value, entry.[[Key]], deserializedValue).
-                    auto result = MUST(object.create_data_property(key.to_byte_string(), deserialized_value));
+                    auto result = MUST(object.create_data_property(key, deserialized_value));
 
                     // 3. Assert: result is true.
                     VERIFY(result);
@@ -971,9 +999,30 @@ public:
     }
 
 private:
+    WebIDL::ExceptionOr<JS::PropertyKey> deserialize_property_key()
+    {
+        auto tag = deserialize_primitive_type<PropertyKeyTag>(m_serialized, m_position);
+        switch (tag) {
+        case PropertyKeyTag::ArrayIndex:
+            return JS::PropertyKey { deserialize_primitive_type<u32>(m_serialized, m_position) };
+        case PropertyKeyTag::String: {
+            auto key = TRY(deserialize_string(m_vm, m_serialized, m_position));
+            m_property_keys.append(key.to_byte_string());
+            return m_property_keys.last();
+        }
+        case PropertyKeyTag::StringReference: {
+            auto index = deserialize_primitive_type<u32>(m_serialized, m_position);
+            VERIFY(index < m_property_keys.size());
+            return m_property_keys[index];
+        }
+        }
+        VERIFY_NOT_REACHED();
+    }
+
     JS::VM& m_vm;
     ReadonlySpan<u32> m_serialized;
-    JS::MarkedVector<JS::Value> m_memory; // Index -> JS value
+    DeserializationMemory& m_memory; // Index -> JS value
+    Vector<JS::PropertyKey> m_property_keys; // Index -> property key
     size_t m_position { 0 };
 
     static WebIDL::ExceptionOr<JS::NonnullGCPtr<Bindings::PlatformObject>> create_serialized_type(StringView interface_name, JS::Realm& realm)
@@ -1064,16 +1113,12 @@ WebIDL::ExceptionOr<ByteBuffer> deserialize_bytes(JS::VM& vm, ReadonlySpan<u32>
 {
     u64 const size = deserialize_primitive_type<u64>(vector, position);
 
+    auto const word_count = ceil_div(size, static_cast<u64>(sizeof(u32)));
+    VERIFY(position + word_count <= vector.size());
+
     auto bytes = TRY_OR_THROW_OOM(vm, ByteBuffer::create_uninitialized(size));
-    u64 byte_position = 0;
-    while (position < vector.size() && byte_position < size) {
-        for (u8 i = 0; i < 4; ++i) {
-            bytes[byte_position++] = (vector[position] >> (i * 8) & 0xFF);
-            if (byte_position == size)
-                break;
-        }
-        position++;
-    }
+    memcpy(bytes.data(), vector.offset_pointer(position), size);
+    position += word_count;
     return bytes;
 }
 
@@ -1112,8 +1157,7 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
     for (auto const& transferable : transfer_list) {
 
         // 1. If transferable has neither an [[ArrayBufferData]] internal slot nor a [[Detached]] internal slot, then throw a "DataCloneError" DOMException.
-        // FIXME: Handle transferring ArrayBufferData objects
-        if (!is<Bindings::Transferable>(*transferable)) {
+        if (!is<JS::ArrayBuffer>(*transferable) && !is<Bindings::Transferable>(*transferable)) {
             return WebIDL::DataCloneError::create(*vm.current_realm(), "Cannot transfer type"_string);
         }
 
@@ -1126,7 +1170,8 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
         }
 
         // 4. Set memory[transferable] to { [[Type]]: an uninitialized value }.
-        memory.set(JS::make_handle(transferable_value), NumericLimits<u32>::max());
+        // NOTE: The deserializer adds the transferred values to its memory first, in the same order.
+        memory.set(JS::make_handle(transferable_value), static_cast<u32>(memory.size()));
     }
 
     // 3. Let serialized be ? StructuredSerializeInternal(value, false, memory).
@@ -1138,7 +1183,10 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
 
     // 5. For each transferable of transferList:
     for (auto& transferable : transfer_list) {
-        // 1. FIXME: If transferable has an [[ArrayBufferData]] internal slot and IsDetachedBuffer(transferable) is true, then throw a "DataCloneError" DOMException.
+        // 1. If transferable has an [[ArrayBufferData]] internal slot and IsDetachedBuffer(transferable) is true, then throw a "DataCloneError" DOMException.
+        if (is<JS::ArrayBuffer>(*transferable) && static_cast<JS::ArrayBuffer&>(*transferable).is_detached()) {
+            return WebIDL::DataCloneError::create(*vm.current_realm(), "Cannot transfer detached buffer"_string);
+        }
 
         // 2. If transferable has a [[Detached]] internal slot and transferable.[[Detached]] is true, then throw a "DataCloneError" DOMException.
         if (is<Bindings::Transferable>(*transferable)) {
@@ -1152,8 +1200,28 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
         // IMPLEMENTATION DEFINED: We just create a data holder here, our memory holds indices into the SerializationRecord
         TransferDataHolder data_holder;
 
-        // FIXME 4. If transferable has an [[ArrayBufferData]] internal slot, then:
-        if (false) {
+        // 4. If transferable has an [[ArrayBufferData]] internal slot, then:
+        if (is<JS::ArrayBuffer>(*transferable)) {
+            auto& array_buffer = static_cast<JS::ArrayBuffer&>(*transferable);
+
+            // FIXME: 1. If transferable has an [[ArrayBufferMaxByteLength]] internal slot, then:
+            //     1. Set dataHolder.[[Type]] to "ResizableArrayBuffer".
+            //     2. Set dataHolder.[[ArrayBufferData]] to transferable.[[ArrayBufferData]].
+            //     3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
+            //     4. Set dataHolder.[[ArrayBufferMaxByteLength]] to transferable.[[ArrayBufferMaxByteLength]].
+
+            // 2. Otherwise:
+            // 1. Set dataHolder.[[Type]] to "ArrayBuffer".
+            // 2. Set dataHolder.[[ArrayBufferData]] to transferable.[[ArrayBufferData]].
+            // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
+            // NOTE: The data holder may have to be sent to another process, so it holds on to a copy of the data instead.
+            TRY_OR_THROW_OOM(vm, data_holder.data.try_ensure_capacity(1 + array_buffer.byte_length()));
+            data_holder.data.unchecked_append(to_underlying(TransferType::ArrayBuffer));
+            data_holder.data.unchecked_append(array_buffer.buffer().data(), array_buffer.byte_length());
+
+            // 3. Perform ? DetachArrayBuffer(transferable).
+            // NOTE: Specifications can use the [[ArrayBufferDetachKey]] internal slot to prevent ArrayBuffers from being detached. This is used in WebAssembly JavaScript Interface, for example. See: https://webassembly.github.io/spec/js-api/#dom-memory-buffer
+            TRY(JS::detach_array_buffer(vm, array_buffer));
         }
 
         // 5. Otherwise:
@@ -1205,6 +1273,8 @@ static WebIDL::ExceptionOr<JS::NonnullGCPtr<Bindings::PlatformObject>> create_tr
         TRY(message_port->transfer_receiving_steps(transfer_data_holder));
         return message_port;
     }
+    case TransferType::ArrayBuffer:
+        break;
     }
     VERIFY_NOT_REACHED();
 }
@@ -1225,14 +1295,16 @@ WebIDL::ExceptionOr<DeserializedTransferRecord> structured_deserialize_with_tran
         // 1. Let value be an uninitialized value.
         JS::Value value;
 
-        // FIXME: 2. If transferDataHolder.[[Type]] is "ArrayBuffer", then set value to a new ArrayBuffer object in targetRealm
+        // 2. If transferDataHolder.[[Type]] is "ArrayBuffer", then set value to a new ArrayBuffer object in targetRealm
         //    whose [[ArrayBufferData]] internal slot value is transferDataHolder.[[ArrayBufferData]], and
         //    whose [[ArrayBufferByteLength]] internal slot value is transferDataHolder.[[ArrayBufferByteLength]].
         // NOTE: In cases where the original memory occupied by [[ArrayBufferData]] is accessible during the deserialization,
         //       this step is unlikely to throw an exception, as no new memory needs to be allocated: the memory occupied by
         //       [[ArrayBufferData]] is instead just getting transferred into the new ArrayBuffer. This could be true, for example,
         //       when both the source and target realms are in the same process.
-        if (false) {
+        if (transfer_data_holder.data.first() == to_underlying(TransferType::ArrayBuffer)) {
+            auto data = TRY_OR_THROW_OOM(vm, ByteBuffer::copy(transfer_data_holder.data.span().slice(1)));
+            value = JS::ArrayBuffer::create(target_realm, move(data));
         }
 
         // FIXME: 3. Otherwise, if transferDataHolder.[[Type]] is "ResizableArrayBuffer", then set value to a new ArrayBuffer object
@@ -1293,8 +1365,10 @@ WebIDL::ExceptionOr<SerializationRecord> structured_serialize_internal(JS::VM& v
     // 1. If memory was not supplied, let memory be an empty map.
     // IMPLEMENTATION DEFINED: We move this requirement up to the callers to make recursion easier
 
-    Serializer serializer(vm, memory, for_storage);
-    return serializer.serialize(value);
+    SerializationRecord serialized;
+    Serializer serializer(vm, memory, for_storage, serialized);
+    TRY(serializer.serialize(value));
+    return serialized;
 }
 
 // https://html.spec.whatwg.org/multipage/structured-data.html#structureddeserialize
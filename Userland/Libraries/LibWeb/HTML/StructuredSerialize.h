@@ -48,6 +48,7 @@ struct DeserializedRecord {
 
 enum class TransferType : u8 {
     MessagePort,
+    ArrayBuffer,
 };
 
 WebIDL::ExceptionOr<SerializationRecord> structured_serialize(JS::VM& vm, JS::Value);
@@ -5,6 +5,7 @@
  */
 
 #include <AK/QuickSort.h>
+#include <AK/ScopeGuard.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/BrowsingContextGroup.h>
@@ -27,6 +28,9 @@ TraversableNavigable::TraversableNavigable(JS::NonnullGCPtr<Page> page)
     : Navigable(page)
     , m_session_history_traversal_queue(vm().heap().allocate_without_realm<SessionHistoryTraversalQueue>())
 {
+    if (Painting::g_enable_paint_tracing)
+        m_paint_trace = make<Painting::DisplayListTrace>();
+
 #ifdef AK_OS_MACOS
     auto display_list_player_type = page->client().display_list_player_type();
     if (display_list_player_type == DisplayListPlayerType::SkiaGPUIfAvailable) {
@@ -1391,6 +1395,32 @@ void TraversableNavigable::paint(DevicePixelRect const& content_rect, Painting::
         return;
     }
 
+    Optional<Vector<Gfx::IntRect>> rects_to_repaint;
+    if (paint_options.rects_to_repaint.has_value()) {
+        rects_to_repaint = Vector<Gfx::IntRect> {};
+        for (auto const& rect : *paint_options.rects_to_repaint)
+            rects_to_repaint->append(rect.to_type<int>());
+    }
+
+    auto replay_start_time = MonotonicTime::now();
+    ScopeGuard record_display_list_replay_time = [&] {
+        auto& statistics = document->rendering_statistics();
+        statistics.time_spent_replaying_display_lists += MonotonicTime::now() - replay_start_time;
+        ++statistics.display_list_replays;
+        if (rects_to_repaint.has_value())
+            ++statistics.partial_display_list_replays;
+    };
+
+    auto execute = [&](Painting::DisplayListPlayer& player) {
+        player.set_trace(m_paint_trace.ptr());
+        if (!rects_to_repaint.has_value()) {
+            player.execute(*display_list);
+            return;
+        }
+        for (auto const& rect : *rects_to_repaint)
+            player.execute(*display_list, rect);
+    };
+
     switch (page().client().display_list_player_type()) {
     case DisplayListPlayerType::SkiaGPUIfAvailable: {
 #ifdef AK_OS_MACOS
@@ -1398,27 +1428,29 @@ void TraversableNavigable::paint(DevicePixelRect const& content_rect, Painting::
             auto& iosurface_backing_store = static_cast<Painting::IOSurfaceBackingStore&>(target);
             auto texture = m_metal_context->create_texture_from_iosurface(iosurface_backing_store.iosurface_handle());
             Painting::DisplayListPlayerSkia player(*m_skia_backend_context, *texture);
-            player.execute(*display_list);
+            execute(player);
             return;
         }
 #endif
 
 #ifdef USE_VULKAN
         if (m_skia_backend_context) {
+            // NOTE: This player reads its whole surface back into the target, so it can't leave anything untouched.
+            rects_to_repaint.clear();
             Painting::DisplayListPlayerSkia player(*m_skia_backend_context, target.bitmap());
-            player.execute(*display_list);
+            execute(player);
             return;
         }
 #endif
 
         // Fallback to CPU backend if GPU is not available
         Painting::DisplayListPlayerSkia player(target.bitmap());
-        player.execute(*display_list);
+        execute(player);
         break;
     }
     case DisplayListPlayerType::SkiaCPU: {
         Painting::DisplayListPlayerSkia player(target.bitmap());
-        player.execute(*display_list);
+        execute(player);
         break;
     }
     default:
@@ -98,6 +98,12 @@ public:
 
     void paint(Web::DevicePixelRect const&, Painting::BackingStore&, Web::PaintOptions);
 
+    // Only recorded if paint tracing was enabled when this traversable was created.
+    Painting::DisplayListTrace const* paint_trace() const { return m_paint_trace.ptr(); }
+
+    // NOTE: This is only present when painting on the GPU.
+    Painting::SkiaBackendContext* skia_backend_context() const { return m_skia_backend_context.ptr(); }
+
     enum class CheckIfUnloadingIsCanceledResult {
         CanceledByBeforeUnload,
         CanceledByNavigate,
@@ -145,6 +151,7 @@ private:
     String m_window_handle;
 
     OwnPtr<Web::Painting::SkiaBackendContext> m_skia_backend_context;
+    OwnPtr<Painting::DisplayListTrace> m_paint_trace;
 
 #ifdef AK_OS_MACOS
     OwnPtr<Core::MetalContext> m_metal_context;
@@ -431,11 +431,7 @@ void Window::fire_a_page_transition_event(FlyString const& event_name, bool pers
 WebIDL::ExceptionOr<JS::NonnullGCPtr<Storage>> Window::local_storage()
 {
     // FIXME: Implement according to spec.
-    static HashMap<URL::Origin, JS::Handle<Storage>> local_storage_per_origin;
-    auto storage = local_storage_per_origin.ensure(associated_document().origin(), [this]() -> JS::Handle<Storage> {
-        return Storage::create(realm());
-    });
-    return JS::NonnullGCPtr { *storage };
+    return Storage::local_storage_for_origin(realm(), associated_document().origin());
 }
 
 // https://html.spec.whatwg.org/multipage/webstorage.html#dom-sessionstorage
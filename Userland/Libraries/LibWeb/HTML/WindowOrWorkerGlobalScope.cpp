@@ -26,6 +26,7 @@
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
 #include <LibWeb/HTML/Scripting/Fetching.h>
+#include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HTML/StructuredSerialize.h>
 #include <LibWeb/HTML/StructuredSerializeOptions.h>
 #include <LibWeb/HTML/Timer.h>
@@ -39,6 +40,7 @@
 #include <LibWeb/PerformanceTimeline/PerformanceObserverEntryList.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/Platform/ImageCodecPlugin.h>
+#include <LibWeb/ResourceTiming/PerformanceResourceTiming.h>
 #include <LibWeb/UserTiming/PerformanceMark.h>
 #include <LibWeb/UserTiming/PerformanceMeasure.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
@@ -257,18 +259,17 @@ JS::NonnullGCPtr<JS::Promise> WindowOrWorkerGlobalScopeMixin::create_image_bitma
 WebIDL::ExceptionOr<JS::Value> WindowOrWorkerGlobalScopeMixin::structured_clone(JS::Value value, StructuredSerializeOptions const& options) const
 {
     auto& vm = this_impl().vm();
-    (void)options;
 
     // 1. Let serialized be ? StructuredSerializeWithTransfer(value, options["transfer"]).
-    // FIXME: Use WithTransfer variant of the AO
-    auto serialized = TRY(structured_serialize(vm, value));
+    auto serialized = TRY(structured_serialize_with_transfer(vm, value, options.transfer));
 
     // 2. Let deserializeRecord be ? StructuredDeserializeWithTransfer(serialized, this's relevant realm).
-    // FIXME: Use WithTransfer variant of the AO
-    auto deserialized = TRY(structured_deserialize(vm, serialized, relevant_realm(this_impl()), {}));
+    auto& settings_object = Bindings::host_defined_environment_settings_object(relevant_realm(this_impl()));
+    auto temporary_execution_context = TemporaryExecutionContext { settings_object };
+    auto deserialize_record = TRY(structured_deserialize_with_transfer(vm, serialized));
 
     // 3. Return deserializeRecord.[[Deserialized]].
-    return deserialized;
+    return deserialize_record.deserialized;
 }
 
 JS::NonnullGCPtr<JS::Promise> WindowOrWorkerGlobalScopeMixin::fetch(Fetch::RequestInfo const& input, Fetch::RequestInit const& init) const
@@ -678,6 +679,17 @@ void WindowOrWorkerGlobalScopeMixin::run_steps_after_a_timeout(i32 timeout, Func
     return run_steps_after_a_timeout_impl(timeout, move(completion_step));
 }
 
+static i32 align_timeout_for_hidden_document(i32 timeout)
+{
+    static constexpr i64 hidden_document_timer_alignment_ms = 1000;
+
+    // NOTE: Core::Timer measures timeouts from the coarse monotonic clock as well, so these all land on the same tick.
+    auto now_ms = MonotonicTime::now_coarse().milliseconds();
+    auto deadline_ms = now_ms + max(timeout, 0);
+    auto aligned_deadline_ms = (deadline_ms + hidden_document_timer_alignment_ms - 1) / hidden_document_timer_alignment_ms * hidden_document_timer_alignment_ms;
+    return static_cast<i32>(min<i64>(aligned_deadline_ms - now_ms, NumericLimits<i32>::max()));
+}
+
 void WindowOrWorkerGlobalScopeMixin::run_steps_after_a_timeout_impl(i32 timeout, Function<void()> completion_step, Optional<i32> timer_key)
 {
     // 1. Assert: if timerKey is given, then the caller of this algorithm is the timer initialization steps. (Other specifications must not pass timerKey.)
@@ -688,6 +700,13 @@ void WindowOrWorkerGlobalScopeMixin::run_steps_after_a_timeout_impl(i32 timeout,
         timer_key = m_timer_id_allocator.allocate();
 
     // FIXME: 3. Let startTime be the current high resolution time given global.
+
+    // NOTE: This implements step 5.3 (waiting a further implementation-defined length of time) up front. Timers of hidden
+    //       documents are held back until the next whole second, so that however many of them there are, a background
+    //       tab wakes us up at most once per second.
+    if (is<Window>(this_impl()) && static_cast<Window&>(this_impl()).associated_document().hidden())
+        timeout = align_timeout_for_hidden_document(timeout);
+
     auto timer = Timer::create(this_impl(), timeout, move(completion_step), timer_key.value());
 
     // FIXME: 4. Set global's map of active timers[timerKey] to startTime plus milliseconds.
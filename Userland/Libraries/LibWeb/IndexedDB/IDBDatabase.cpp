@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Bindings/IDBDatabasePrototype.h>
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/HTML/DOMStringList.h>
+#include <LibWeb/HTML/EventNames.h>
+#include <LibWeb/IndexedDB/IDBDatabase.h>
+#include <LibWeb/IndexedDB/Internal/Algorithms.h>
+
+namespace Web::IndexedDB {
+
+JS_DEFINE_ALLOCATOR(IDBDatabase);
+
+JS::NonnullGCPtr<IDBDatabase> IDBDatabase::create(JS::Realm& realm, Database& database)
+{
+    auto connection = realm.heap().allocate<IDBDatabase>(realm, realm, database);
+    database.add_connection(connection);
+    return connection;
+}
+
+IDBDatabase::IDBDatabase(JS::Realm& realm, Database& database)
+    : EventTarget(realm)
+    , m_associated_database(database)
+{
+}
+
+IDBDatabase::~IDBDatabase() = default;
+
+void IDBDatabase::initialize(JS::Realm& realm)
+{
+    Base::initialize(realm);
+    WEB_SET_PROTOTYPE_FOR_INTERFACE(IDBDatabase);
+}
+
+void IDBDatabase::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_associated_database);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-objectstorenames
+JS::NonnullGCPtr<HTML::DOMStringList> IDBDatabase::object_store_names()
+{
+    // 1. Let names be a list of the names of the object stores in this's object store set.
+    // FIXME: Keep track of the object store set once we have object stores.
+    Vector<String> names;
+
+    // 2. Return the result (a DOMStringList) of creating a sorted name list with names.
+    return HTML::DOMStringList::create(realm(), move(names));
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-close
+void IDBDatabase::close()
+{
+    // The close() method steps are to run close a database connection with this connection.
+    close_a_database_connection(*this);
+}
+
+void IDBDatabase::set_closed()
+{
+    VERIFY(!m_closed);
+    m_closed = true;
+    m_associated_database->connection_was_closed(*this);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onabort
+void IDBDatabase::set_onabort(WebIDL::CallbackType* event_handler)
+{
+    set_event_handler_attribute(HTML::EventNames::abort, event_handler);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onabort
+WebIDL::CallbackType* IDBDatabase::onabort()
+{
+    return event_handler_attribute(HTML::EventNames::abort);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onclose
+void IDBDatabase::set_onclose(WebIDL::CallbackType* event_handler)
+{
+    set_event_handler_attribute(HTML::EventNames::close, event_handler);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onclose
+WebIDL::CallbackType* IDBDatabase::onclose()
+{
+    return event_handler_attribute(HTML::EventNames::close);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onerror
+void IDBDatabase::set_onerror(WebIDL::CallbackType* event_handler)
+{
+    set_event_handler_attribute(HTML::EventNames::error, event_handler);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onerror
+WebIDL::CallbackType* IDBDatabase::onerror()
+{
+    return event_handler_attribute(HTML::EventNames::error);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onversionchange
+void IDBDatabase::set_onversionchange(WebIDL::CallbackType* event_handler)
+{
+    set_event_handler_attribute(HTML::EventNames::versionchange, event_handler);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onversionchange
+WebIDL::CallbackType* IDBDatabase::onversionchange()
+{
+    return event_handler_attribute(HTML::EventNames::versionchange);
+}
+
+}
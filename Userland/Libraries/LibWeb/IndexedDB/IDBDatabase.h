@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibWeb/DOM/EventTarget.h>
+#include <LibWeb/IndexedDB/Internal/Database.h>
+
+namespace Web::IndexedDB {
+
+// https://w3c.github.io/IndexedDB/#idbdatabase
+// NOTE: An IDBDatabase is a connection to a database, as opposed to the database itself.
+class IDBDatabase final : public DOM::EventTarget {
+    WEB_PLATFORM_OBJECT(IDBDatabase, DOM::EventTarget);
+    JS_DECLARE_ALLOCATOR(IDBDatabase);
+
+public:
+    [[nodiscard]] static JS::NonnullGCPtr<IDBDatabase> create(JS::Realm&, Database&);
+
+    virtual ~IDBDatabase() override;
+
+    String const& name() const { return m_associated_database->name(); }
+    u64 version() const { return m_version; }
+    JS::NonnullGCPtr<HTML::DOMStringList> object_store_names();
+    void close();
+
+    void set_onabort(WebIDL::CallbackType*);
+    WebIDL::CallbackType* onabort();
+    void set_onclose(WebIDL::CallbackType*);
+    WebIDL::CallbackType* onclose();
+    void set_onerror(WebIDL::CallbackType*);
+    WebIDL::CallbackType* onerror();
+    void set_onversionchange(WebIDL::CallbackType*);
+    WebIDL::CallbackType* onversionchange();
+
+    Database& associated_database() { return m_associated_database; }
+
+    void set_version(u64 version) { m_version = version; }
+
+    bool close_pending() const { return m_close_pending; }
+    void set_close_pending(bool close_pending) { m_close_pending = close_pending; }
+
+    bool is_closed() const { return m_closed; }
+    void set_closed();
+
+private:
+    IDBDatabase(JS::Realm&, Database&);
+
+    virtual void initialize(JS::Realm&) override;
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    // https://w3c.github.io/IndexedDB/#connection
+    // Each connection is associated with a database.
+    JS::NonnullGCPtr<Database> m_associated_database;
+
+    // A connection has a version, which is set when the connection is created. It remains constant for the lifetime
+    // of the connection unless an upgrade is aborted, in which case it is set to the previous version of the database.
+    u64 m_version { 0 };
+
+    // A connection has a close pending flag. It is initially false.
+    bool m_close_pending { false };
+
+    // NOTE: A connection is closed once the transactions created using it have completed after close pending was set.
+    bool m_closed { false };
+};
+
+}
@@ -4,9 +4,25 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/Promise.h>
 #include <LibWeb/Bindings/IDBFactoryPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/DOM/Event.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/EventNames.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
+#include <LibWeb/IndexedDB/IDBDatabase.h>
 #include <LibWeb/IndexedDB/IDBFactory.h>
+#include <LibWeb/IndexedDB/IDBOpenDBRequest.h>
+#include <LibWeb/IndexedDB/Internal/Algorithms.h>
+#include <LibWeb/IndexedDB/Internal/Database.h>
+#include <LibWeb/IndexedDB/Internal/Key.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
+#include <LibWeb/StorageAPI/StorageKey.h>
+#include <LibWeb/WebIDL/DOMException.h>
+#include <LibWeb/WebIDL/Promise.h>
 
 namespace Web::IndexedDB {
 
@@ -25,4 +41,201 @@ void IDBFactory::initialize(JS::Realm& realm)
     WEB_SET_PROTOTYPE_FOR_INTERFACE(IDBFactory);
 }
 
+// https://w3c.github.io/IndexedDB/#dom-idbfactory-open
+WebIDL::ExceptionOr<JS::NonnullGCPtr<IDBOpenDBRequest>> IDBFactory::open(String const& name, Optional<u64> version)
+{
+    auto& realm = this->realm();
+
+    // 1. If version is 0 (zero), throw a TypeError.
+    if (version.has_value() && version.value() == 0)
+        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "The version provided must not be 0"sv };
+
+    // 2. Let environment be this's relevant settings object.
+    auto& environment = HTML::relevant_settings_object(*this);
+
+    // 3. Let storageKey be the result of running obtain a storage key given environment. If failure is returned, then
+    //    throw a "SecurityError" DOMException and abort these steps.
+    auto storage_key = StorageAPI::obtain_a_storage_key(environment);
+    if (!storage_key.has_value())
+        return WebIDL::SecurityError::create(realm, "Failed to obtain a storage key"_string);
+
+    // 4. Let request be a new open request.
+    auto request = IDBOpenDBRequest::create(realm);
+
+    // 5. Run these steps in parallel:
+    Platform::EventLoopPlugin::the().deferred_invoke([&realm, storage_key = storage_key.release_value(), name, version, request]() mutable {
+        // 1. Let result be the result of opening a database connection, with storageKey, name, version if given and
+        //    undefined otherwise, and request.
+        open_a_database_connection(realm, move(storage_key), name, version, request, JS::create_heap_function(realm.heap(), [&realm, request](ConnectionOrError result) {
+            // 2. Set request’s processed flag to true.
+            request->set_processed(true);
+
+            // 3. Queue a task to run these steps:
+            HTML::queue_global_task(HTML::Task::Source::DatabaseAccess, realm.global_object(), JS::create_heap_function(realm.heap(), [&realm, request, result = move(result)] {
+                result.visit(
+                    // 1. If result is an error, then:
+                    [&](JS::NonnullGCPtr<WebIDL::DOMException> const& error) {
+                        // 1. Set request’s result to undefined.
+                        // 2. Set request’s error to result.
+                        // 3. Set request’s done flag to true.
+                        request->set_error(error);
+
+                        // 4. Fire an event named error at request with its bubbles and cancelable attributes
+                        //    initialized to true.
+                        request->dispatch_event(DOM::Event::create(realm, HTML::EventNames::error, { .bubbles = true, .cancelable = true }));
+                    },
+                    // 2. Otherwise:
+                    [&](JS::NonnullGCPtr<IDBDatabase> const& connection) {
+                        // 1. Set request’s result to result.
+                        // 2. Set request’s done flag to true.
+                        request->set_result(connection);
+
+                        // 3. Fire an event named success at request.
+                        request->dispatch_event(DOM::Event::create(realm, HTML::EventNames::success));
+                    });
+            }));
+        }));
+    });
+
+    // 6. Return a new IDBOpenDBRequest object for request.
+    return request;
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbfactory-deletedatabase
+WebIDL::ExceptionOr<JS::NonnullGCPtr<IDBOpenDBRequest>> IDBFactory::delete_database(String const& name)
+{
+    auto& realm = this->realm();
+
+    // 1. Let environment be this's relevant settings object.
+    auto& environment = HTML::relevant_settings_object(*this);
+
+    // 2. Let storageKey be the result of running obtain a storage key given environment. If failure is returned, then
+    //    throw a "SecurityError" DOMException and abort these steps.
+    auto storage_key = StorageAPI::obtain_a_storage_key(environment);
+    if (!storage_key.has_value())
+        return WebIDL::SecurityError::create(realm, "Failed to obtain a storage key"_string);
+
+    // 3. Let request be a new open request.
+    auto request = IDBOpenDBRequest::create(realm);
+
+    // 4. Run these steps in parallel:
+    Platform::EventLoopPlugin::the().deferred_invoke([&realm, storage_key = storage_key.release_value(), name, request]() mutable {
+        // 1. Let result be the result of deleting a database, with storageKey, name, and request.
+        delete_a_database(realm, move(storage_key), name, request, JS::create_heap_function(realm.heap(), [&realm, request](VersionOrError result) {
+            // 2. Set request’s processed flag to true.
+            request->set_processed(true);
+
+            // 3. Queue a task to run these steps:
+            HTML::queue_global_task(HTML::Task::Source::DatabaseAccess, realm.global_object(), JS::create_heap_function(realm.heap(), [&realm, request, result = move(result)] {
+                result.visit(
+                    // 1. If result is an error, set request’s error to result, set request’s done flag to true, and
+                    //    fire an event named error at request with its bubbles and cancelable attributes initialized
+                    //    to true.
+                    [&](JS::NonnullGCPtr<WebIDL::DOMException> const& error) {
+                        request->set_error(error);
+                        request->dispatch_event(DOM::Event::create(realm, HTML::EventNames::error, { .bubbles = true, .cancelable = true }));
+                    },
+                    // 2. Otherwise, set request’s result to undefined, set request’s done flag to true, and fire a
+                    //    version change event named success at request with result and null.
+                    [&](u64 version) {
+                        request->set_result(JS::js_undefined());
+                        fire_a_version_change_event(HTML::EventNames::success, request, version, {});
+                    });
+            }));
+        }));
+    });
+
+    // 5. Return a new IDBOpenDBRequest object for request.
+    return request;
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbfactory-databases
+JS::NonnullGCPtr<JS::Promise> IDBFactory::databases()
+{
+    auto& realm = this->realm();
+
+    // 1. Let environment be this's relevant settings object.
+    auto& environment = HTML::relevant_settings_object(*this);
+
+    // 2. Let storageKey be the result of running obtain a storage key given environment. If failure is returned, then
+    //    return a promise rejected with a "SecurityError" DOMException.
+    auto storage_key = StorageAPI::obtain_a_storage_key(environment);
+    if (!storage_key.has_value()) {
+        auto error = WebIDL::SecurityError::create(realm, "Failed to obtain a storage key"_string);
+        return WebIDL::create_rejected_promise_from_exception(realm, error);
+    }
+
+    // 3. Let p be a new promise.
+    auto promise = WebIDL::create_promise(realm);
+
+    // 4. Run these steps in parallel:
+    Platform::EventLoopPlugin::the().deferred_invoke([&realm, storage_key = storage_key.release_value(), promise] {
+        // 1. Let databases be the set of databases in storageKey. If this cannot be determined for any reason, then
+        //    queue a database task to reject p with an appropriate error (e.g. an "UnknownError" DOMException) and
+        //    terminate these steps.
+        auto databases = Database::databases_for_key(storage_key);
+
+        // 2. Let result be a new list.
+        struct DatabaseInfo {
+            String name;
+            u64 version { 0 };
+        };
+        Vector<DatabaseInfo> result;
+
+        // 3. For each db of databases:
+        for (auto const& db : databases) {
+            // 1. If db’s version is 0, then continue.
+            if (db->version() == 0)
+                continue;
+
+            // 2. Let info be a new IDBDatabaseInfo dictionary.
+            // 3. Set info’s name dictionary member to db’s name.
+            // 4. Set info’s version dictionary member to db’s version.
+            // 5. Append info to result.
+            result.append({ db->name(), db->version() });
+        }
+
+        // 4. Queue a database task to resolve p with result.
+        HTML::queue_global_task(HTML::Task::Source::DatabaseAccess, realm.global_object(), JS::create_heap_function(realm.heap(), [&realm, promise, result = move(result)] {
+            HTML::TemporaryExecutionContext execution_context { Bindings::host_defined_environment_settings_object(realm) };
+            auto& vm = realm.vm();
+
+            auto array = MUST(JS::Array::create(realm, 0));
+            for (size_t i = 0; i < result.size(); ++i) {
+                auto info = JS::Object::create(realm, realm.intrinsics().object_prototype());
+                MUST(info->create_data_property("name"_fly_string, JS::PrimitiveString::create(vm, result[i].name)));
+                MUST(info->create_data_property("version"_fly_string, JS::Value(static_cast<double>(result[i].version))));
+                MUST(array->create_data_property(i, info));
+            }
+            WebIDL::resolve_promise(realm, promise, array);
+        }));
+    });
+
+    // 5. Return p.
+    return JS::NonnullGCPtr { verify_cast<JS::Promise>(*promise->promise()) };
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbfactory-cmp
+WebIDL::ExceptionOr<WebIDL::Short> IDBFactory::cmp(JS::Value first, JS::Value second)
+{
+    auto& realm = this->realm();
+
+    // 1. Let a be the result of converting a value to a key with first. Rethrow any exceptions.
+    auto a = TRY(convert_a_value_to_a_key(realm, first));
+
+    // 2. If a is invalid, throw a "DataError" DOMException.
+    if (!a.has_value())
+        return WebIDL::DataError::create(realm, "The first argument is not a valid key"_string);
+
+    // 3. Let b be the result of converting a value to a key with second. Rethrow any exceptions.
+    auto b = TRY(convert_a_value_to_a_key(realm, second));
+
+    // 4. If b is invalid, throw a "DataError" DOMException.
+    if (!b.has_value())
+        return WebIDL::DataError::create(realm, "The second argument is not a valid key"_string);
+
+    // 5. Return the results of comparing two keys with a and b.
+    return Key::compare_two_keys(a.value(), b.value());
+}
+
 }
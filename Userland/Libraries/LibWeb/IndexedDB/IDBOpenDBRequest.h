@@ -17,6 +17,8 @@ class IDBOpenDBRequest : public IDBRequest {
     JS_DECLARE_ALLOCATOR(IDBOpenDBRequest);
 
 public:
+    [[nodiscard]] static JS::NonnullGCPtr<IDBOpenDBRequest> create(JS::Realm&);
+
     virtual ~IDBOpenDBRequest();
 
     void set_onblocked(WebIDL::CallbackType*);
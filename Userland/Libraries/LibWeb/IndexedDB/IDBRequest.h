@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <LibWeb/Bindings/IDBRequestPrototype.h>
 #include <LibWeb/DOM/EventTarget.h>
 
 namespace Web::IndexedDB {
@@ -18,6 +19,18 @@ class IDBRequest : public DOM::EventTarget {
 public:
     virtual ~IDBRequest() override;
 
+    WebIDL::ExceptionOr<JS::Value> result() const;
+    WebIDL::ExceptionOr<JS::GCPtr<WebIDL::DOMException>> error() const;
+    Bindings::IDBRequestReadyState ready_state() const;
+
+    bool done() const { return m_done; }
+    bool processed() const { return m_processed; }
+    void set_processed(bool processed) { m_processed = processed; }
+
+    // NOTE: These are the steps that deliver the outcome of an operation, which the spec spells out for each request.
+    void set_result(JS::Value);
+    void set_error(JS::NonnullGCPtr<WebIDL::DOMException>);
+
     void set_onsuccess(WebIDL::CallbackType*);
     WebIDL::CallbackType* onsuccess();
     void set_onerror(WebIDL::CallbackType*);
@@ -27,6 +40,20 @@ protected:
     explicit IDBRequest(JS::Realm&);
 
     virtual void initialize(JS::Realm&) override;
+    virtual void visit_edges(Cell::Visitor&) override;
+
+private:
+    // https://w3c.github.io/IndexedDB/#request-processed-flag
+    bool m_processed { false };
+
+    // https://w3c.github.io/IndexedDB/#request-done-flag
+    bool m_done { false };
+
+    // https://w3c.github.io/IndexedDB/#request-result
+    JS::Value m_result;
+
+    // https://w3c.github.io/IndexedDB/#request-error
+    JS::GCPtr<WebIDL::DOMException> m_error;
 };
 
 }
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/EventNames.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/IndexedDB/IDBDatabase.h>
+#include <LibWeb/IndexedDB/IDBRequest.h>
+#include <LibWeb/IndexedDB/IDBVersionChangeEvent.h>
+#include <LibWeb/IndexedDB/Internal/Algorithms.h>
+#include <LibWeb/IndexedDB/Internal/ConnectionQueue.h>
+#include <LibWeb/IndexedDB/Internal/Database.h>
+#include <LibWeb/WebIDL/DOMException.h>
+
+namespace Web::IndexedDB {
+
+static void queue_a_database_task(JS::Object& global, Function<void()> steps)
+{
+    HTML::queue_global_task(HTML::Task::Source::DatabaseAccess, global, JS::create_heap_function(global.heap(), move(steps)));
+}
+
+// Steps 1 to 5 of https://w3c.github.io/IndexedDB/#open-a-database-connection and of
+// https://w3c.github.io/IndexedDB/#delete-a-database, which both tell the connections to a database that is about to
+// change that they should close, and wait for them to do so. The steps are run once all of them have been closed.
+static void wait_for_other_connections_to_close(Database& db, IDBDatabase* connection, Optional<u64> new_version, IDBRequest& request, JS::NonnullGCPtr<JS::HeapFunction<void()>> steps)
+{
+    // 1. Let openConnections be the set of all connections, except connection, associated with db.
+    Vector<JS::NonnullGCPtr<IDBDatabase>> open_connections;
+    for (auto const& entry : db.connections()) {
+        if (entry.ptr() != connection)
+            open_connections.append(entry);
+    }
+
+    // 2. For each entry of openConnections that does not have its close pending flag set to true, queue a task to fire
+    //    a version change event named versionchange at entry with db’s version and version.
+    auto old_version = db.version();
+    for (auto const& entry : open_connections) {
+        if (entry->close_pending())
+            continue;
+        queue_a_database_task(HTML::relevant_global_object(*entry), [entry, old_version, new_version] {
+            // NOTE: The connection may have been closed by the time the task runs, in which case it doesn't need to
+            //       be told anymore.
+            if (entry->close_pending())
+                return;
+            fire_a_version_change_event(HTML::EventNames::versionchange, *entry, old_version, new_version);
+        });
+    }
+
+    // 3. Wait for all of the events to be fired.
+    // NOTE: Tasks from the same task source run in the order they were queued in, so this runs after all of them.
+    queue_a_database_task(HTML::relevant_global_object(request), [db = JS::NonnullGCPtr { db }, open_connections = move(open_connections), old_version, new_version, request = JS::NonnullGCPtr { request }, steps]() mutable {
+        // 4. If any of the connections in openConnections are still not closed, queue a task to fire a version change
+        //    event named blocked at request with db’s version and version.
+        if (open_connections.first_matching([](auto const& entry) { return !entry->is_closed(); }).has_value()) {
+            queue_a_database_task(HTML::relevant_global_object(*request), [request, old_version, new_version] {
+                fire_a_version_change_event(HTML::EventNames::blocked, *request, old_version, new_version);
+            });
+        }
+
+        // 5. Wait until all connections in openConnections are closed.
+        db->wait_for_connections_to_close(move(open_connections), steps);
+    });
+}
+
+// https://w3c.github.io/IndexedDB/#upgrade-a-database
+static void upgrade_a_database(JS::Realm& realm, IDBDatabase& connection, u64 version, IDBRequest& request, JS::NonnullGCPtr<JS::HeapFunction<void()>> on_complete)
+{
+    // 1. Let db be connection’s database.
+    auto& db = connection.associated_database();
+
+    // 2. Let transaction be a new upgrade transaction with connection used as connection.
+    // 3. Set transaction’s scope to connection’s object store set.
+    // 4. Set db’s upgrade transaction to transaction.
+    // 5. Set transaction’s state to inactive.
+    // 6. Start transaction.
+    // FIXME: Create the upgrade transaction once we have transactions.
+
+    // 7. Let old version be db’s version.
+    auto old_version = db.version();
+
+    // 8. Set db’s version to version. This change is considered part of the transaction, and so if the transaction is
+    //    aborted, this change is reverted.
+    db.set_version(version);
+
+    // 9. Set request’s processed flag to true.
+    request.set_processed(true);
+
+    // 10. Queue a task to run these steps:
+    queue_a_database_task(realm.global_object(), [connection = JS::NonnullGCPtr { connection }, request = JS::NonnullGCPtr { request }, old_version, version, on_complete] {
+        // 1. Set request’s result to connection.
+        // 2. Set request’s transaction to transaction.
+        // 3. Set request’s done flag to true.
+        request->set_result(connection);
+
+        // 4. Set transaction’s state to active.
+
+        // 5. Let didThrow be the result of firing a version change event named upgradeneeded at request with old
+        //    version and version.
+        [[maybe_unused]] auto did_throw = fire_a_version_change_event(HTML::EventNames::upgradeneeded, *request, old_version, version);
+
+        // 6. Set transaction’s state to inactive.
+
+        // 7. If didThrow is true, run abort a transaction with transaction and a newly created "AbortError"
+        //    DOMException.
+        // FIXME: Abort the transaction once we have transactions, and event dispatch tells us whether a listener threw.
+
+        // 11. Wait for transaction to finish.
+        // NOTE: Without object stores there is nothing for the transaction to do, so it finishes as soon as the
+        //       upgradeneeded event has been dispatched.
+        on_complete->function()();
+    });
+}
+
+// https://w3c.github.io/IndexedDB/#open-a-database-connection
+void open_a_database_connection(JS::Realm& realm, StorageAPI::StorageKey storage_key, String name, Optional<u64> maybe_version, JS::NonnullGCPtr<IDBRequest> request, JS::NonnullGCPtr<JS::HeapFunction<void(ConnectionOrError)>> on_complete)
+{
+    // NOTE: Once the request has been processed, the next request in the queue can go ahead.
+    auto complete = [storage_key, name, request, on_complete](ConnectionOrError result) {
+        on_complete->function()(move(result));
+        ConnectionQueue::for_key_and_name(storage_key, name).request_was_processed(request);
+    };
+
+    // 1. Let queue be the connection queue for storageKey and name.
+    auto& queue = ConnectionQueue::for_key_and_name(storage_key, name);
+
+    // 2. Add request to queue.
+    // 3. Wait until all previous requests in queue have been processed.
+    queue.append(request, JS::create_heap_function(realm.heap(), [&realm, storage_key, name, maybe_version, request, complete = move(complete)]() mutable {
+        // 4. Let db be the database named name in storageKey, or null otherwise.
+        auto db = Database::for_key_and_name(storage_key, name);
+
+        // 5. If version is undefined, let version be 1 if db is null, or db’s version otherwise.
+        u64 version = 0;
+        if (maybe_version.has_value())
+            version = maybe_version.value();
+        else
+            version = db ? db->version() : 1;
+
+        // 6. If db is null, let db be a new database with name name, version 0 (zero), and with no object stores. If
+        //    this fails for any reason, return an appropriate error (e.g. a "QuotaExceededError" or "UnknownError"
+        //    DOMException).
+        if (!db)
+            db = Database::create_for_key_and_name(realm.vm(), storage_key, name);
+
+        // 7. If db’s version is greater than version, return a newly created "VersionError" DOMException and abort
+        //    these steps.
+        if (db->version() > version) {
+            complete(WebIDL::VersionError::create(realm, "The requested version is lower than the version of the database"_string));
+            return;
+        }
+
+        // 8. Let connection be a new connection to db.
+        auto connection = IDBDatabase::create(realm, *db);
+
+        // 9. Set connection’s version to version.
+        connection->set_version(version);
+
+        // 10. If db’s version is less than version, then:
+        if (db->version() < version) {
+            // 1-5. (Tell the other connections about the change, and wait until they have been closed.)
+            wait_for_other_connections_to_close(*db, connection, version, request, JS::create_heap_function(realm.heap(), [&realm, connection, version, request, complete = move(complete)]() mutable {
+                // 6. Run upgrade a database using connection, version and request.
+                upgrade_a_database(realm, connection, version, request, JS::create_heap_function(realm.heap(), [&realm, connection, complete = move(complete)]() mutable {
+                    // 7. If connection was closed, return a newly created "AbortError" DOMException and abort these
+                    //    steps.
+                    if (connection->is_closed()) {
+                        complete(WebIDL::AbortError::create(realm, "The connection was closed before the upgrade finished"_string));
+                        return;
+                    }
+
+                    // 8. If the upgrade transaction was aborted, run the steps to close a database connection with
+                    //    connection, return a newly created "AbortError" DOMException and abort these steps.
+                    // FIXME: Check this once we have transactions.
+
+                    // 11. Return connection.
+                    complete(connection);
+                }));
+            }));
+            return;
+        }
+
+        // 11. Return connection.
+        complete(connection);
+    }));
+}
+
+// https://w3c.github.io/IndexedDB/#delete-a-database
+void delete_a_database(JS::Realm& realm, StorageAPI::StorageKey storage_key, String name, JS::NonnullGCPtr<IDBRequest> request, JS::NonnullGCPtr<JS::HeapFunction<void(VersionOrError)>> on_complete)
+{
+    // NOTE: Once the request has been processed, the next request in the queue can go ahead.
+    auto complete = [storage_key, name, request, on_complete](VersionOrError result) {
+        on_complete->function()(move(result));
+        ConnectionQueue::for_key_and_name(storage_key, name).request_was_processed(request);
+    };
+
+    // 1. Let queue be the connection queue for storageKey and name.
+    auto& queue = ConnectionQueue::for_key_and_name(storage_key, name);
+
+    // 2. Add request to queue.
+    // 3. Wait until all previous requests in queue have been processed.
+    queue.append(request, JS::create_heap_function(realm.heap(), [storage_key, name, request, complete = move(complete)]() mutable {
+        // 4. Let db be the database named name in storageKey, if one exists. Otherwise, return 0 (zero).
+        auto db = Database::for_key_and_name(storage_key, name);
+        if (!db) {
+            complete(u64 { 0 });
+            return;
+        }
+
+        // 5-7. (Tell the connections to the database that it is being deleted, and wait until they have been closed.)
+        wait_for_other_connections_to_close(*db, nullptr, {}, request, JS::create_heap_function(request->heap(), [storage_key, name, db = JS::NonnullGCPtr { *db }, complete = move(complete)]() mutable {
+            // 8. Let version be db’s version.
+            auto version = db->version();
+
+            // 9. Delete db. If this fails for any reason, return an appropriate error (e.g. "QuotaExceededError" or
+            //    "UnknownError" DOMException).
+            Database::delete_for_key_and_name(storage_key, name);
+
+            // 10. Return version.
+            complete(version);
+        }));
+    }));
+}
+
+// https://w3c.github.io/IndexedDB/#close-a-database-connection
+void close_a_database_connection(IDBDatabase& connection, bool forced)
+{
+    // 1. Set connection’s close pending flag to true.
+    connection.set_close_pending(true);
+
+    // 2. If the forced flag is true, then for each transaction created using connection run abort a transaction with
+    //    transaction and newly created "AbortError" DOMException.
+    // 3. Wait for all transactions created using connection to complete. Once they are complete, connection is closed.
+    // FIXME: Wait for the transactions once we have them.
+    if (!connection.is_closed())
+        connection.set_closed();
+
+    // 4. If the forced flag is true, then fire an event named close at connection.
+    if (forced)
+        connection.dispatch_event(DOM::Event::create(connection.realm(), HTML::EventNames::close));
+}
+
+// https://w3c.github.io/IndexedDB/#fire-a-version-change-event
+bool fire_a_version_change_event(FlyString const& event_name, DOM::EventTarget& target, u64 old_version, Optional<u64> new_version)
+{
+    IDBVersionChangeEventInit event_init {};
+
+    // 3. Set event’s bubbles and cancelable attributes to false.
+    event_init.bubbles = false;
+    event_init.cancelable = false;
+
+    // 4. Set event’s oldVersion attribute to oldVersion.
+    event_init.old_version = old_version;
+
+    // 5. Set event’s newVersion attribute to newVersion.
+    event_init.new_version = new_version;
+
+    // 1. Let event be the result of creating an event using IDBVersionChangeEvent.
+    // 2. Set event’s type attribute to e.
+    auto event = IDBVersionChangeEvent::create(target.realm(), event_name, event_init);
+
+    // 6. Let legacyOutputDidListenersThrowFlag be false.
+    // 7. Dispatch event at target with legacyOutputDidListenersThrowFlag.
+    // FIXME: Have event dispatch set the flag when a listener throws.
+    target.dispatch_event(event);
+
+    // 8. Return legacyOutputDidListenersThrowFlag.
+    return false;
+}
+
+}
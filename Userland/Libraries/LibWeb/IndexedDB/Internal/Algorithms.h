@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/Optional.h>
+#include <AK/Variant.h>
+#include <LibJS/Heap/HeapFunction.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/StorageAPI/StorageKey.h>
+
+namespace Web::IndexedDB {
+
+using ConnectionOrError = Variant<JS::NonnullGCPtr<IDBDatabase>, JS::NonnullGCPtr<WebIDL::DOMException>>;
+using VersionOrError = Variant<u64, JS::NonnullGCPtr<WebIDL::DOMException>>;
+
+// NOTE: These algorithms run in parallel, and may have to wait for other connections to be closed. So instead of
+//       returning their result, they hand it to the given steps once they have one.
+void open_a_database_connection(JS::Realm&, StorageAPI::StorageKey, String name, Optional<u64> version, JS::NonnullGCPtr<IDBRequest>, JS::NonnullGCPtr<JS::HeapFunction<void(ConnectionOrError)>> on_complete);
+void delete_a_database(JS::Realm&, StorageAPI::StorageKey, String name, JS::NonnullGCPtr<IDBRequest>, JS::NonnullGCPtr<JS::HeapFunction<void(VersionOrError)>> on_complete);
+
+void close_a_database_connection(IDBDatabase&, bool forced = false);
+bool fire_a_version_change_event(FlyString const& event_name, DOM::EventTarget&, u64 old_version, Optional<u64> new_version);
+
+}
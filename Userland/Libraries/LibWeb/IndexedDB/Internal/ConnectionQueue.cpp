@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <LibWeb/IndexedDB/IDBRequest.h>
+#include <LibWeb/IndexedDB/Internal/ConnectionQueue.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
+
+namespace Web::IndexedDB {
+
+// https://w3c.github.io/IndexedDB/#connection-queue
+// There is a connection queue for each storage key and name, which is initially empty.
+static HashMap<StorageAPI::StorageKey, HashMap<String, ConnectionQueue>>& connection_queues()
+{
+    static HashMap<StorageAPI::StorageKey, HashMap<String, ConnectionQueue>> connection_queues;
+    return connection_queues;
+}
+
+ConnectionQueue& ConnectionQueue::for_key_and_name(StorageAPI::StorageKey const& key, String const& name)
+{
+    return connection_queues().ensure(key).ensure(name);
+}
+
+void ConnectionQueue::append(IDBRequest& request, JS::NonnullGCPtr<JS::HeapFunction<void()>> steps)
+{
+    m_entries.append({ JS::make_handle(request), JS::make_handle(steps) });
+    if (m_entries.size() == 1)
+        run_steps_of_first_request();
+}
+
+void ConnectionQueue::request_was_processed(IDBRequest& request)
+{
+    VERIFY(!m_entries.is_empty());
+    VERIFY(m_entries.first().request.ptr() == &request);
+    m_entries.take_first();
+
+    if (!m_entries.is_empty())
+        run_steps_of_first_request();
+}
+
+void ConnectionQueue::run_steps_of_first_request()
+{
+    // NOTE: The steps run in parallel, so we don't start them while the algorithm that caused this is still going.
+    Platform::EventLoopPlugin::the().deferred_invoke([steps = m_entries.first().steps] {
+        steps->function()();
+    });
+}
+
+}
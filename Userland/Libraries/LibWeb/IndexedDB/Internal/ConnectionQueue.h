@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibJS/Heap/Handle.h>
+#include <LibJS/Heap/HeapFunction.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/StorageAPI/StorageKey.h>
+
+namespace Web::IndexedDB {
+
+// https://w3c.github.io/IndexedDB/#connection-queue
+// A connection queue is a queue of requests to open or delete the database of some name in some storage key. Each of
+// them waits for all the requests before it to have been processed.
+class ConnectionQueue {
+public:
+    static ConnectionQueue& for_key_and_name(StorageAPI::StorageKey const&, String const& name);
+
+    // Adds the request to the queue, and runs the steps once all previous requests in the queue have been processed. The
+    // steps must let the queue know through request_was_processed() once they are done with the request.
+    void append(IDBRequest&, JS::NonnullGCPtr<JS::HeapFunction<void()>> steps);
+    void request_was_processed(IDBRequest&);
+
+private:
+    void run_steps_of_first_request();
+
+    struct Entry {
+        JS::Handle<IDBRequest> request;
+        JS::Handle<JS::HeapFunction<void()>> steps;
+    };
+    Vector<Entry> m_entries;
+};
+
+}
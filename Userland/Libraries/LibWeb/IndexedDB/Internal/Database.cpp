@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <LibJS/Heap/Handle.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibWeb/IndexedDB/IDBDatabase.h>
+#include <LibWeb/IndexedDB/Internal/Database.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
+
+namespace Web::IndexedDB {
+
+JS_DEFINE_ALLOCATOR(Database);
+
+// https://w3c.github.io/IndexedDB/#database-construct
+// Each storage key has an associated set of databases.
+static HashMap<StorageAPI::StorageKey, Vector<JS::Handle<Database>>>& databases_per_storage_key()
+{
+    static HashMap<StorageAPI::StorageKey, Vector<JS::Handle<Database>>> databases_per_storage_key;
+    return databases_per_storage_key;
+}
+
+JS::GCPtr<Database> Database::for_key_and_name(StorageAPI::StorageKey const& key, String const& name)
+{
+    auto databases = databases_per_storage_key().get(key);
+    if (!databases.has_value())
+        return nullptr;
+
+    for (auto const& database : *databases) {
+        if (database->name() == name)
+            return *database;
+    }
+    return nullptr;
+}
+
+JS::NonnullGCPtr<Database> Database::create_for_key_and_name(JS::VM& vm, StorageAPI::StorageKey const& key, String const& name)
+{
+    VERIFY(!for_key_and_name(key, name));
+
+    auto database = vm.heap().allocate_without_realm<Database>(name);
+    databases_per_storage_key().ensure(key).append(JS::make_handle(database));
+    return database;
+}
+
+void Database::delete_for_key_and_name(StorageAPI::StorageKey const& key, String const& name)
+{
+    auto databases = databases_per_storage_key().find(key);
+    if (databases == databases_per_storage_key().end())
+        return;
+
+    databases->value.remove_first_matching([&](auto const& database) {
+        return database->name() == name;
+    });
+    if (databases->value.is_empty())
+        databases_per_storage_key().remove(databases);
+}
+
+Vector<JS::NonnullGCPtr<Database>> Database::databases_for_key(StorageAPI::StorageKey const& key)
+{
+    Vector<JS::NonnullGCPtr<Database>> result;
+    if (auto databases = databases_per_storage_key().get(key); databases.has_value()) {
+        for (auto const& database : *databases)
+            result.append(*database);
+    }
+    return result;
+}
+
+Database::Database(String name)
+    : m_name(move(name))
+{
+}
+
+Database::~Database() = default;
+
+void Database::visit_edges(Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_connections);
+    for (auto& waiter : m_connections_closed_waiters) {
+        visitor.visit(waiter.connections);
+        visitor.visit(waiter.steps);
+    }
+}
+
+void Database::add_connection(IDBDatabase& connection)
+{
+    m_connections.append(connection);
+}
+
+void Database::connection_was_closed(IDBDatabase& connection)
+{
+    m_connections.remove_first_matching([&](auto const& entry) { return entry.ptr() == &connection; });
+
+    // NOTE: The steps may start waiting for other connections, so take out the ones that are done first.
+    Vector<JS::NonnullGCPtr<JS::HeapFunction<void()>>> steps_to_run;
+    m_connections_closed_waiters.remove_all_matching([&](auto const& waiter) {
+        if (!waiter.connections.first_matching([](auto const& entry) { return !entry->is_closed(); }).has_value()) {
+            steps_to_run.append(waiter.steps);
+            return true;
+        }
+        return false;
+    });
+
+    // NOTE: Whoever is waiting does so in parallel, so we don't run their steps while the connection is still closing.
+    for (auto& steps : steps_to_run) {
+        Platform::EventLoopPlugin::the().deferred_invoke([steps] {
+            steps->function()();
+        });
+    }
+}
+
+void Database::wait_for_connections_to_close(Vector<JS::NonnullGCPtr<IDBDatabase>> connections, JS::NonnullGCPtr<JS::HeapFunction<void()>> steps)
+{
+    if (!connections.first_matching([](auto const& entry) { return !entry->is_closed(); }).has_value()) {
+        steps->function()();
+        return;
+    }
+    m_connections_closed_waiters.append({ move(connections), steps });
+}
+
+}
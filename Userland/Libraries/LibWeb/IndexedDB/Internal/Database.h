@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibJS/Heap/HeapFunction.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/StorageAPI/StorageKey.h>
+
+namespace Web::IndexedDB {
+
+// https://w3c.github.io/IndexedDB/#database-construct
+// FIXME: Databases only live as long as the process does. Keep them on disk, and share them between processes.
+class Database final : public JS::Cell {
+    JS_CELL(Database, JS::Cell);
+    JS_DECLARE_ALLOCATOR(Database);
+
+public:
+    static JS::GCPtr<Database> for_key_and_name(StorageAPI::StorageKey const&, String const& name);
+    static JS::NonnullGCPtr<Database> create_for_key_and_name(JS::VM&, StorageAPI::StorageKey const&, String const& name);
+    static void delete_for_key_and_name(StorageAPI::StorageKey const&, String const& name);
+    static Vector<JS::NonnullGCPtr<Database>> databases_for_key(StorageAPI::StorageKey const&);
+
+    virtual ~Database() override;
+
+    String const& name() const { return m_name; }
+
+    u64 version() const { return m_version; }
+    void set_version(u64 version) { m_version = version; }
+
+    // NOTE: Only the connections that have not been closed yet.
+    Vector<JS::NonnullGCPtr<IDBDatabase>> const& connections() const { return m_connections; }
+    void add_connection(IDBDatabase&);
+    void connection_was_closed(IDBDatabase&);
+
+    // Runs the steps once all of the given connections have been closed.
+    void wait_for_connections_to_close(Vector<JS::NonnullGCPtr<IDBDatabase>>, JS::NonnullGCPtr<JS::HeapFunction<void()>> steps);
+
+private:
+    explicit Database(String name);
+
+    virtual void visit_edges(Visitor&) override;
+
+    // https://w3c.github.io/IndexedDB/#database-name
+    String m_name;
+
+    // https://w3c.github.io/IndexedDB/#database-version
+    u64 m_version { 0 };
+
+    Vector<JS::NonnullGCPtr<IDBDatabase>> m_connections;
+
+    struct ConnectionsClosedWaiter {
+        Vector<JS::NonnullGCPtr<IDBDatabase>> connections;
+        JS::NonnullGCPtr<JS::HeapFunction<void()>> steps;
+    };
+    Vector<ConnectionsClosedWaiter> m_connections_closed_waiters;
+};
+
+}
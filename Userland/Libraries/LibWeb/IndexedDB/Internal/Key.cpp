@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Runtime/AbstractOperations.h>
+#include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/ArrayBuffer.h>
+#include <LibJS/Runtime/DataView.h>
+#include <LibJS/Runtime/Date.h>
+#include <LibJS/Runtime/TypedArray.h>
+#include <LibWeb/IndexedDB/Internal/Key.h>
+#include <LibWeb/Infra/Strings.h>
+#include <LibWeb/WebIDL/AbstractOperations.h>
+
+namespace Web::IndexedDB {
+
+static WebIDL::ExceptionOr<Optional<Key>> convert_a_value_to_a_key(JS::Realm& realm, JS::Value input, Vector<JS::Object const*>& seen)
+{
+    auto& vm = realm.vm();
+
+    // 1. If seen was not given, then let seen be a new empty set.
+    // NOTE: This is handled by the caller.
+
+    // 2. If seen contains input, then return invalid.
+    // NOTE: Only arrays are ever added to seen.
+    if (input.is_object() && seen.contains_slow(&input.as_object()))
+        return Optional<Key> {};
+
+    // 3. Jump to the appropriate step below:
+
+    // If Type(input) is Number
+    if (input.is_number()) {
+        // 1. If input is NaN then return invalid.
+        if (input.is_nan())
+            return Optional<Key> {};
+
+        // 2. Otherwise, return a new key with type number and value input.
+        return Key::create_number(input.as_double());
+    }
+
+    // If Type(input) is String
+    if (input.is_string()) {
+        // 1. Return a new key with type string and value input.
+        return Key::create_string(input.as_string().utf8_string());
+    }
+
+    if (!input.is_object())
+        return Optional<Key> {};
+    auto& object = input.as_object();
+
+    // If input is a Date (has a [[DateValue]] internal slot)
+    if (is<JS::Date>(object)) {
+        // 1. Let ms be the value of input’s [[DateValue]] internal slot.
+        auto ms = static_cast<JS::Date&>(object).date_value();
+
+        // 2. If ms is NaN then return invalid.
+        if (isnan(ms))
+            return Optional<Key> {};
+
+        // 3. Otherwise, return a new key with type date and value ms.
+        return Key::create_date(ms);
+    }
+
+    // If input is a buffer source type
+    if (is<JS::ArrayBuffer>(object) || is<JS::TypedArrayBase>(object) || is<JS::DataView>(object)) {
+        // 1. If input is detached then return invalid.
+        JS::ArrayBuffer const* buffer = nullptr;
+        if (is<JS::ArrayBuffer>(object))
+            buffer = &static_cast<JS::ArrayBuffer&>(object);
+        else if (is<JS::TypedArrayBase>(object))
+            buffer = static_cast<JS::TypedArrayBase&>(object).viewed_array_buffer();
+        else
+            buffer = static_cast<JS::DataView&>(object).viewed_array_buffer();
+        if (buffer->is_detached())
+            return Optional<Key> {};
+
+        // 2. Let bytes be the result of getting a copy of the bytes held by the buffer source input.
+        auto bytes = TRY_OR_THROW_OOM(vm, WebIDL::get_buffer_source_copy(object));
+
+        // 3. Return a new key with type binary and value bytes.
+        return Key::create_binary(move(bytes));
+    }
+
+    // If input is an Array exotic object
+    if (is<JS::Array>(object)) {
+        // 1. Let len be ? ToLength( ? Get(input, "length")).
+        auto length = TRY(JS::length_of_array_like(vm, object));
+
+        // 2. Append input to seen.
+        seen.append(&object);
+
+        // 3. Let keys be a new empty list.
+        Vector<Key> keys;
+        TRY_OR_THROW_OOM(vm, keys.try_ensure_capacity(length));
+
+        // 4. Let index be 0.
+        // 5. While index is less than len:
+        for (size_t index = 0; index < length; ++index) {
+            // 1. Let hop be ? HasOwnProperty(input, index).
+            auto hop = TRY(object.has_own_property(index));
+
+            // 2. If hop is false, return invalid.
+            if (!hop)
+                return Optional<Key> {};
+
+            // 3. Let entry be ? Get(input, index).
+            auto entry = TRY(object.get(index));
+
+            // 4. Let key be the result of converting a value to a key with arguments entry and seen.
+            // 5. ReturnIfAbrupt(key).
+            auto key = TRY(convert_a_value_to_a_key(realm, entry, seen));
+
+            // 6. If key is invalid abort these steps and return invalid.
+            if (!key.has_value())
+                return Optional<Key> {};
+
+            // 7. Append key to keys.
+            keys.unchecked_append(key.release_value());
+
+            // 8. Increase index by 1.
+        }
+
+        // 6. Return a new array key with value keys.
+        return Key::create_array(move(keys));
+    }
+
+    // Otherwise
+    // 1. Return invalid.
+    return Optional<Key> {};
+}
+
+WebIDL::ExceptionOr<Optional<Key>> convert_a_value_to_a_key(JS::Realm& realm, JS::Value input)
+{
+    Vector<JS::Object const*> seen;
+    return convert_a_value_to_a_key(realm, input, seen);
+}
+
+int Key::compare_two_keys(Key const& a, Key const& b)
+{
+    // 1. Let ta be the type of a.
+    auto ta = a.type();
+
+    // 2. Let tb be the type of b.
+    auto tb = b.type();
+
+    // 3. If ta does not equal tb, then run these steps:
+    if (ta != tb) {
+        // 1. If ta is array, then return 1.
+        if (ta == Type::Array)
+            return 1;
+
+        // 2. If tb is array, then return -1.
+        if (tb == Type::Array)
+            return -1;
+
+        // 3. If ta is binary, then return 1.
+        if (ta == Type::Binary)
+            return 1;
+
+        // 4. If tb is binary, then return -1.
+        if (tb == Type::Binary)
+            return -1;
+
+        // 5. If ta is string, then return 1.
+        if (ta == Type::String)
+            return 1;
+
+        // 6. If tb is string, then return -1.
+        if (tb == Type::String)
+            return -1;
+
+        // 7. If ta is date, then return 1.
+        if (ta == Type::Date)
+            return 1;
+
+        // 8. Assert: tb is date.
+        VERIFY(tb == Type::Date);
+
+        // 9. Return -1.
+        return -1;
+    }
+
+    // 4. Let va be the value of a.
+    // 5. Let vb be the value of b.
+    // 6. Switch on ta:
+    switch (ta) {
+    // number
+    // date
+    case Type::Number:
+    case Type::Date:
+        // 1. If va is greater than vb, then return 1.
+        if (a.number() > b.number())
+            return 1;
+
+        // 2. If va is less than vb, then return -1.
+        if (a.number() < b.number())
+            return -1;
+
+        break;
+
+    // string
+    case Type::String:
+        // 1. If va is code unit less than vb, then return -1.
+        if (Infra::code_unit_less_than(a.string(), b.string()))
+            return -1;
+
+        // 2. If vb is code unit less than va, then return 1.
+        if (Infra::code_unit_less_than(b.string(), a.string()))
+            return 1;
+
+        break;
+
+    // binary
+    case Type::Binary: {
+        // 1. If va is byte less than vb, then return -1.
+        // 2. If vb is byte less than va, then return 1.
+        auto common_length = min(a.binary().size(), b.binary().size());
+        if (auto result = __builtin_memcmp(a.binary().data(), b.binary().data(), common_length); result != 0)
+            return result < 0 ? -1 : 1;
+        if (a.binary().size() != b.binary().size())
+            return a.binary().size() < b.binary().size() ? -1 : 1;
+
+        break;
+    }
+
+    // array
+    case Type::Array: {
+        auto const& va = a.array();
+        auto const& vb = b.array();
+
+        // 1. Let length be the lesser of va’s size and vb’s size.
+        auto length = min(va.size(), vb.size());
+
+        // 2. Let i be 0.
+        // 3. While i is less than length, then:
+        for (size_t i = 0; i < length; ++i) {
+            // 1. Let c be the result of recursively comparing two keys with va[i] and vb[i].
+            auto c = compare_two_keys(va[i], vb[i]);
+
+            // 2. If c is not 0, return c.
+            if (c != 0)
+                return c;
+
+            // 3. Increase i by 1.
+        }
+
+        // 4. If va’s size is greater than vb’s size, then return 1.
+        if (va.size() > vb.size())
+            return 1;
+
+        // 5. If va’s size is less than vb’s size, then return -1.
+        if (va.size() < vb.size())
+            return -1;
+
+        break;
+    }
+    }
+
+    // 7. Return 0.
+    return 0;
+}
+
+}
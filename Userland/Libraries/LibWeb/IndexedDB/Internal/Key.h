@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+#include <LibWeb/WebIDL/ExceptionOr.h>
+
+namespace Web::IndexedDB {
+
+// https://w3c.github.io/IndexedDB/#key-construct
+class Key {
+public:
+    // https://w3c.github.io/IndexedDB/#key-type
+    enum class Type {
+        Number,
+        Date,
+        String,
+        Binary,
+        Array,
+    };
+
+    static Key create_number(double value) { return Key { Type::Number, value }; }
+    static Key create_date(double value) { return Key { Type::Date, value }; }
+    static Key create_string(String value) { return Key { Type::String, move(value) }; }
+    static Key create_binary(ByteBuffer value) { return Key { Type::Binary, move(value) }; }
+    static Key create_array(Vector<Key> value) { return Key { Type::Array, move(value) }; }
+
+    Type type() const { return m_type; }
+
+    // NOTE: For number and date keys.
+    double number() const { return m_value.get<double>(); }
+    String const& string() const { return m_value.get<String>(); }
+    ByteBuffer const& binary() const { return m_value.get<ByteBuffer>(); }
+    Vector<Key> const& array() const { return m_value.get<Vector<Key>>(); }
+
+    // https://w3c.github.io/IndexedDB/#compare-two-keys
+    static int compare_two_keys(Key const& a, Key const& b);
+
+    bool operator==(Key const& other) const { return compare_two_keys(*this, other) == 0; }
+
+private:
+    using Value = Variant<double, String, ByteBuffer, Vector<Key>>;
+
+    Key(Type type, Value value)
+        : m_type(type)
+        , m_value(move(value))
+    {
+    }
+
+    Type m_type;
+    Value m_value;
+};
+
+// https://w3c.github.io/IndexedDB/#convert-value-to-key
+// NOTE: An empty Optional means that the value is not a valid key.
+WebIDL::ExceptionOr<Optional<Key>> convert_a_value_to_a_key(JS::Realm&, JS::Value input);
+
+}
@@ -102,6 +102,44 @@ bool is_code_unit_prefix(StringView potential_prefix, StringView input)
     }
 }
 
+// https://infra.spec.whatwg.org/#code-unit-less-than
+bool code_unit_less_than(StringView a, StringView b)
+{
+    // NOTE: Comparing the strings code point by code point gives the same result as comparing their code units, except
+    //       where the first code points that differ are a supplementary one and one at or above U+E000. So we only
+    //       bring those two code points to their UTF-16 form, instead of converting both strings up front.
+    auto a_view = Utf8View { a };
+    auto b_view = Utf8View { b };
+    auto a_it = a_view.begin();
+    auto b_it = b_view.begin();
+
+    for (; a_it != a_view.end() && b_it != b_view.end(); ++a_it, ++b_it) {
+        if (*a_it == *b_it)
+            continue;
+
+        // 3. Let n be the smallest index such that the nth code unit of a is different from the nth code unit of b.
+        //    (There has to be such an index, since neither string is a prefix of the other.)
+        // 4. If the nth code unit of a is less than the nth code unit of b, then return true.
+        // 5. Return false.
+        auto first_code_unit = [](u32 code_point) -> u32 {
+            if (code_point < 0x10000)
+                return code_point;
+            return 0xD800 + ((code_point - 0x10000) >> 10);
+        };
+        auto a_code_unit = first_code_unit(*a_it);
+        auto b_code_unit = first_code_unit(*b_it);
+        if (a_code_unit != b_code_unit)
+            return a_code_unit < b_code_unit;
+
+        // NOTE: The code points share a leading surrogate, so their trailing surrogates differ in the same way they do.
+        return *a_it < *b_it;
+    }
+
+    // 1. If b is a code unit prefix of a, then return false.
+    // 2. If a is a code unit prefix of b, then return true.
+    return a_it == a_view.end() && b_it != b_view.end();
+}
+
 // https://infra.spec.whatwg.org/#scalar-value-string
 ErrorOr<String> convert_to_scalar_value_string(StringView string)
 {
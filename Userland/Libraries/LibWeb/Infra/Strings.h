@@ -17,6 +17,7 @@ bool is_ascii_case_insensitive_match(StringView a, StringView b);
 String normalize_newlines(String const&);
 ErrorOr<String> strip_and_collapse_whitespace(StringView string);
 bool is_code_unit_prefix(StringView potential_prefix, StringView input);
+bool code_unit_less_than(StringView a, StringView b);
 ErrorOr<String> convert_to_scalar_value_string(StringView string);
 ErrorOr<String> to_ascii_lowercase(StringView string);
 ErrorOr<String> to_ascii_uppercase(StringView string);
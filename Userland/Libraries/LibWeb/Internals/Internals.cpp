@@ -189,4 +189,14 @@ void Internals::expire_cookies_with_time_offset(WebIDL::LongLong seconds)
     internals_page().client().page_did_expire_cookies_with_time_offset(AK::Duration::from_seconds(seconds));
 }
 
+String Internals::rendering_statistics()
+{
+    return internals_window().associated_document().rendering_statistics().to_json();
+}
+
+void Internals::reset_rendering_statistics()
+{
+    internals_window().associated_document().rendering_statistics() = {};
+}
+
 }
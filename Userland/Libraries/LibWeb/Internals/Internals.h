@@ -46,6 +46,9 @@ public:
 
     void expire_cookies_with_time_offset(WebIDL::LongLong seconds);
 
+    String rendering_statistics();
+    void reset_rendering_statistics();
+
 private:
     explicit Internals(JS::Realm&);
     virtual void initialize(JS::Realm&) override;
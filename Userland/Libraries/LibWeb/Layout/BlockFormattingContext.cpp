@@ -537,6 +537,9 @@ void BlockFormattingContext::layout_inline_children(BlockContainer const& block_
 
 CSSPixels BlockFormattingContext::compute_auto_height_for_block_level_element(Box const& box, AvailableSpace const& available_space)
 {
+    if (auto height = explicit_intrinsic_inner_height(box); height.has_value())
+        return *height;
+
     if (creates_block_formatting_context(box)) {
         return compute_auto_height_for_block_formatting_context_root(box);
     }
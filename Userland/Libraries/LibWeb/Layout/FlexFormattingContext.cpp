@@ -1138,6 +1138,17 @@ void FlexFormattingContext::determine_hypothetical_cross_size_of_item(FlexItem&
     }
 
     // For indefinite cross sizes, we perform a throwaway layout and then measure it.
+    // Flex items nested in flex items would repeat that for every level of nesting, so the result is cached for the rest of the layout.
+    auto get_cache_slot = [&]() -> Optional<CSSPixels>& {
+        auto& cache = m_state.m_root.intrinsic_sizes_for(item.box);
+        return cache.flex_item_cross_size_for_main_size.ensure(item.main_size.value());
+    };
+
+    if (auto& cache_slot = get_cache_slot(); cache_slot.has_value()) {
+        item.hypothetical_cross_size = css_clamp(cache_slot.value(), clamp_min, clamp_max);
+        return;
+    }
+
     LayoutState throwaway_state(&m_state);
 
     auto& box_state = throwaway_state.get_mutable(item.box);
@@ -1160,6 +1171,7 @@ void FlexFormattingContext::determine_hypothetical_cross_size_of_item(FlexItem&
     auto automatic_cross_size = is_row_layout() ? independent_formatting_context->automatic_content_height()
                                                 : independent_formatting_context->automatic_content_width();
 
+    get_cache_slot() = automatic_cross_size;
     item.hypothetical_cross_size = css_clamp(automatic_cross_size, clamp_min, clamp_max);
 }
 
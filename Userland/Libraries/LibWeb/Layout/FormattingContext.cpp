@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWeb/DOM/Element.h>
 #include <LibWeb/Dump.h>
 #include <LibWeb/Layout/BlockFormattingContext.h>
 #include <LibWeb/Layout/Box.h>
@@ -331,9 +332,37 @@ Optional<CSSPixels> FormattingContext::compute_auto_height_for_absolutely_positi
     return calculate_fit_content_height(box, m_state.get(box).available_inner_space_or_constraints_from(available_space));
 }
 
+// https://drafts.csswg.org/css-contain-2/#containment-size
+static bool has_size_containment(Box const& box)
+{
+    // FIXME: We don't support the contain property yet, so boxes only get size containment by skipping their contents.
+    auto const* dom_node = box.dom_node();
+    return dom_node && dom_node->is_element() && static_cast<DOM::Element const&>(*dom_node).skips_its_contents();
+}
+
+// https://drafts.csswg.org/css-sizing-4/#intrinsic-size-override
+Optional<CSSPixels> FormattingContext::explicit_intrinsic_inner_width(Box const& box)
+{
+    auto const& contain_intrinsic_width = box.computed_values().contain_intrinsic_width();
+    if (!contain_intrinsic_width.is_length() || !has_size_containment(box))
+        return {};
+    return contain_intrinsic_width.length().to_px(box);
+}
+
+Optional<CSSPixels> FormattingContext::explicit_intrinsic_inner_height(Box const& box)
+{
+    auto const& contain_intrinsic_height = box.computed_values().contain_intrinsic_height();
+    if (!contain_intrinsic_height.is_length() || !has_size_containment(box))
+        return {};
+    return contain_intrinsic_height.length().to_px(box);
+}
+
 // https://www.w3.org/TR/CSS22/visudet.html#root-height
 CSSPixels FormattingContext::compute_auto_height_for_block_formatting_context_root(Box const& root) const
 {
+    if (auto height = explicit_intrinsic_inner_height(root); height.has_value())
+        return *height;
+
     // 10.6.7 'Auto' heights for block formatting context roots
     Optional<CSSPixels> top;
     Optional<CSSPixels> bottom;
@@ -1412,9 +1441,12 @@ CSSPixels FormattingContext::calculate_min_content_width(Layout::Box const& box)
     if (box.has_natural_width())
         return *box.natural_width();
 
+    if (auto width = explicit_intrinsic_inner_width(box); width.has_value())
+        return *width;
+
     auto& root_state = m_state.m_root;
 
-    auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cache = root_state.intrinsic_sizes_for(box);
     if (cache.min_content_width.has_value())
         return *cache.min_content_width;
 
@@ -1452,9 +1484,12 @@ CSSPixels FormattingContext::calculate_max_content_width(Layout::Box const& box)
     if (box.has_natural_width())
         return *box.natural_width();
 
+    if (auto width = explicit_intrinsic_inner_width(box); width.has_value())
+        return *width;
+
     auto& root_state = m_state.m_root;
 
-    auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cache = root_state.intrinsic_sizes_for(box);
     if (cache.max_content_width.has_value())
         return *cache.max_content_width;
 
@@ -1497,9 +1532,12 @@ CSSPixels FormattingContext::calculate_min_content_height(Layout::Box const& box
     if (box.has_natural_height())
         return *box.natural_height();
 
+    if (auto height = explicit_intrinsic_inner_height(box); height.has_value())
+        return *height;
+
     auto get_cache_slot = [&]() -> Optional<CSSPixels>* {
         auto& root_state = m_state.m_root;
-        auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+        auto& cache = root_state.intrinsic_sizes_for(box);
         return &cache.min_content_height.ensure(width);
     };
 
@@ -1541,9 +1579,12 @@ CSSPixels FormattingContext::calculate_max_content_height(Layout::Box const& box
     if (box.has_natural_height())
         return *box.natural_height();
 
+    if (auto height = explicit_intrinsic_inner_height(box); height.has_value())
+        return *height;
+
     auto get_cache_slot = [&]() -> Optional<CSSPixels>* {
         auto& root_state = m_state.m_root;
-        auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+        auto& cache = root_state.intrinsic_sizes_for(box);
         return &cache.max_content_height.ensure(width);
     };
 
@@ -117,6 +117,10 @@ protected:
     static bool should_treat_width_as_auto(Box const&, AvailableSpace const&);
     static bool should_treat_height_as_auto(Box const&, AvailableSpace const&);
 
+    // The size given by contain-intrinsic-size, for boxes with size containment that have one.
+    static Optional<CSSPixels> explicit_intrinsic_inner_width(Box const&);
+    static Optional<CSSPixels> explicit_intrinsic_inner_height(Box const&);
+
     [[nodiscard]] bool should_treat_max_width_as_none(Box const&, AvailableSize const&) const;
     [[nodiscard]] bool should_treat_max_height_as_none(Box const&, AvailableSize const&) const;
 
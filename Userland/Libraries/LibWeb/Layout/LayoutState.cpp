@@ -29,6 +29,21 @@ LayoutState::~LayoutState()
 {
 }
 
+LayoutState::UsedValues& LayoutState::allocate_used_values(UsedValues&& used_values)
+{
+    m_used_values_storage.append(move(used_values));
+    return m_used_values_storage[m_used_values_storage.size() - 1];
+}
+
+LayoutState::IntrinsicSizes& LayoutState::intrinsic_sizes_for(NodeWithStyle const& node) const
+{
+    return *intrinsic_sizes.ensure(&node, [&] {
+        auto* sizes = m_intrinsic_sizes_storage.allocate();
+        VERIFY(sizes);
+        return sizes;
+    });
+}
+
 LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
 {
     if (auto* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
@@ -36,20 +51,18 @@ LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
 
     for (auto const* ancestor = m_parent; ancestor; ancestor = ancestor->m_parent) {
         if (auto* ancestor_used_values = ancestor->used_values_per_layout_node.get(node).value_or(nullptr)) {
-            auto cow_used_values = adopt_own(*new UsedValues(*ancestor_used_values));
-            auto* cow_used_values_ptr = cow_used_values.ptr();
-            used_values_per_layout_node.set(node, move(cow_used_values));
-            return *cow_used_values_ptr;
+            auto& cow_used_values = allocate_used_values(UsedValues(*ancestor_used_values));
+            used_values_per_layout_node.set(node, &cow_used_values);
+            return cow_used_values;
         }
     }
 
     auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    auto& new_used_values = allocate_used_values({});
+    new_used_values.set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
+    used_values_per_layout_node.set(node, &new_used_values);
+    return new_used_values;
 }
 
 LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
@@ -64,11 +77,11 @@ LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
 
     auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    const_cast<LayoutState*>(this)->used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    auto& mutable_this = const_cast<LayoutState&>(*this);
+    auto& new_used_values = mutable_this.allocate_used_values({});
+    new_used_values.set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
+    mutable_this.used_values_per_layout_node.set(node, &new_used_values);
+    return new_used_values;
 }
 
 // https://www.w3.org/TR/css-overflow-3/#scrollable-overflow
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/BumpAllocator.h>
 #include <AK/HashMap.h>
+#include <AK/SegmentedVector.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/Point.h>
 #include <LibWeb/Layout/Box.h>
@@ -223,7 +225,7 @@ struct LayoutState {
     // NOTE: get() will not CoW the UsedValues.
     UsedValues const& get(NodeWithStyle const&) const;
 
-    HashMap<JS::NonnullGCPtr<Layout::Node const>, NonnullOwnPtr<UsedValues>> used_values_per_layout_node;
+    HashMap<JS::NonnullGCPtr<Layout::Node const>, UsedValues*> used_values_per_layout_node;
 
     // We cache intrinsic sizes once determined, as they will not change over the course of a full layout.
     // This avoids computing them several times while performing flex layout.
@@ -233,15 +235,31 @@ struct LayoutState {
 
         HashMap<CSSPixels, Optional<CSSPixels>> min_content_height;
         HashMap<CSSPixels, Optional<CSSPixels>> max_content_height;
+
+        // The automatic cross size of a flex item laid out with a given main size.
+        HashMap<CSSPixels, Optional<CSSPixels>> flex_item_cross_size_for_main_size;
     };
 
-    HashMap<JS::GCPtr<NodeWithStyle const>, NonnullOwnPtr<IntrinsicSizes>> mutable intrinsic_sizes;
+    HashMap<JS::GCPtr<NodeWithStyle const>, IntrinsicSizes*> mutable intrinsic_sizes;
+
+    // NOTE: Only call this on the root state, which owns the cache for the whole layout.
+    IntrinsicSizes& intrinsic_sizes_for(NodeWithStyle const&) const;
 
     LayoutState const* m_parent { nullptr };
     LayoutState const& m_root;
 
 private:
     void resolve_relative_positions();
+
+    UsedValues& allocate_used_values(UsedValues&&);
+
+    // Backing storage for used_values_per_layout_node. Allocating the values in segments keeps their addresses
+    // stable while saving an allocation per node, which adds up over the many throwaway states of intrinsic sizing.
+    AK::SegmentedVector<UsedValues, 16> m_used_values_storage;
+
+    // Backing storage for intrinsic_sizes. The cache is dropped with the root state, so there is no need to free its
+    // entries one by one.
+    mutable AK::UniformBumpAllocator<IntrinsicSizes> m_intrinsic_sizes_storage;
 };
 
 }
@@ -103,6 +103,7 @@ void TableFormattingContext::compute_cell_measures()
 
     compute_constrainedness();
 
+    auto fixed_mode_layout = use_fixed_mode_layout();
     for (auto& cell : m_cells) {
         auto const& computed_values = cell.box->computed_values();
         CSSPixels padding_top = computed_values.padding().top().to_px(cell.box, containing_block.content_height());
@@ -118,30 +119,40 @@ void TableFormattingContext::compute_cell_measures()
         CSSPixels border_left = use_collapsing_borders_model ? round(cell_state.border_left / 2) : computed_values.border_left().width;
         CSSPixels border_right = use_collapsing_borders_model ? round(cell_state.border_right / 2) : computed_values.border_right().width;
 
+        auto min_height = computed_values.min_height().to_px(cell.box, containing_block.content_height());
+        auto cell_intrinsic_height_offsets = padding_top + padding_bottom + border_top + border_bottom;
+        auto height = computed_values.height().is_length() ? computed_values.height().to_px(cell.box, containing_block.content_height()) : 0;
+
+        // For fixed mode, according to https://www.w3.org/TR/css-tables-3/#computing-column-measures:
+        // The min-content and max-content width of cells is considered zero unless they are directly specified as a length-percentage,
+        // in which case they are resolved based on the table width (if it is definite, otherwise use 0).
+        auto width_is_specified_length_or_percentage = computed_values.width().is_length() || computed_values.width().is_percentage();
+        if (fixed_mode_layout && !width_is_specified_length_or_percentage && cell.row_span == 1) {
+            // Such a cell doesn't affect the widths of the columns, and the height of its row comes from laying it out
+            // at its used width in compute_table_height(), so we can skip measuring its contents. That way, a fixed
+            // table only needs a single layout of each cell.
+            cell.outer_min_height = min_height + cell_intrinsic_height_offsets;
+            cell.outer_max_height = max(min_height, height) + cell_intrinsic_height_offsets;
+            continue;
+        }
+
         auto min_content_width = calculate_min_content_width(cell.box);
         auto max_content_width = calculate_max_content_width(cell.box);
         auto min_content_height = calculate_min_content_height(cell.box, max_content_width);
         auto max_content_height = calculate_max_content_height(cell.box, min_content_width);
 
         // The outer min-content height of a table-cell is max(min-height, min-content height) adjusted by the cell intrinsic offsets.
-        auto min_height = computed_values.min_height().to_px(cell.box, containing_block.content_height());
-        auto cell_intrinsic_height_offsets = padding_top + padding_bottom + border_top + border_bottom;
         cell.outer_min_height = max(min_height, min_content_height) + cell_intrinsic_height_offsets;
         // The outer min-content width of a table-cell is max(min-width, min-content width) adjusted by the cell intrinsic offsets.
         auto min_width = computed_values.min_width().to_px(cell.box, containing_block.content_width());
         auto cell_intrinsic_width_offsets = padding_left + padding_right + border_left + border_right;
-        // For fixed mode, according to https://www.w3.org/TR/css-tables-3/#computing-column-measures:
-        // The min-content and max-content width of cells is considered zero unless they are directly specified as a length-percentage,
-        // in which case they are resolved based on the table width (if it is definite, otherwise use 0).
-        auto width_is_specified_length_or_percentage = computed_values.width().is_length() || computed_values.width().is_percentage();
-        if (!use_fixed_mode_layout() || width_is_specified_length_or_percentage) {
+        if (!fixed_mode_layout || width_is_specified_length_or_percentage) {
             cell.outer_min_width = max(min_width, min_content_width) + cell_intrinsic_width_offsets;
         }
 
         // The tables specification isn't explicit on how to use the height and max-height CSS properties in the outer max-content formulas.
         // However, during this early phase we don't have enough information to resolve percentage sizes yet and the formulas for outer sizes
         // in the specification give enough clues to pick defaults in a way that makes sense.
-        auto height = computed_values.height().is_length() ? computed_values.height().to_px(cell.box, containing_block.content_height()) : 0;
         auto max_height = computed_values.max_height().is_length() ? computed_values.max_height().to_px(cell.box, containing_block.content_height()) : CSSPixels::max();
         if (m_rows[cell.row_index].is_constrained) {
             // The outer max-content height of a table-cell in a constrained row is
@@ -157,7 +168,7 @@ void TableFormattingContext::compute_cell_measures()
         // See the explanation for height and max_height above.
         auto width = computed_values.width().is_length() ? computed_values.width().to_px(cell.box, containing_block.content_width()) : 0;
         auto max_width = computed_values.max_width().is_length() ? computed_values.max_width().to_px(cell.box, containing_block.content_width()) : CSSPixels::max();
-        if (use_fixed_mode_layout() && !width_is_specified_length_or_percentage) {
+        if (fixed_mode_layout && !width_is_specified_length_or_percentage) {
             continue;
         }
         if (m_columns[cell.column_index].is_constrained) {
@@ -240,7 +251,20 @@ void TableFormattingContext::initialize_table_measures<TableFormattingContext::C
 }
 
 template<class RowOrColumn>
-void TableFormattingContext::compute_intrinsic_percentage(size_t max_cell_span)
+Vector<Vector<TableFormattingContext::Cell const*>> TableFormattingContext::cells_by_span() const
+{
+    Vector<Vector<Cell const*>> cells_by_span;
+    for (auto const& cell : m_cells) {
+        auto span = cell_span<RowOrColumn>(cell);
+        if (span >= cells_by_span.size())
+            cells_by_span.resize(span + 1);
+        cells_by_span[span].append(&cell);
+    }
+    return cells_by_span;
+}
+
+template<class RowOrColumn>
+void TableFormattingContext::compute_intrinsic_percentage(Vector<Vector<Cell const*>> const& cells_by_span)
 {
     auto& rows_or_columns = table_rows_or_columns<RowOrColumn>();
 
@@ -255,13 +279,13 @@ void TableFormattingContext::compute_intrinsic_percentage(size_t max_cell_span)
         intrinsic_percentage_contribution_by_index[rc_index] = rows_or_columns[rc_index].intrinsic_percentage;
     }
 
-    for (size_t current_span = 2; current_span <= max_cell_span; current_span++) {
+    for (size_t current_span = 2; current_span < cells_by_span.size(); current_span++) {
+        if (cells_by_span[current_span].is_empty())
+            continue;
         // https://www.w3.org/TR/css-tables-3/#intrinsic-percentage-width-of-a-column-based-on-cells-of-span-up-to-n-n--1
-        for (auto& cell : m_cells) {
-            auto cell_span_value = cell_span<RowOrColumn>(cell);
-            if (cell_span_value != current_span) {
-                continue;
-            }
+        for (auto const* cell_pointer : cells_by_span[current_span]) {
+            auto const& cell = *cell_pointer;
+            auto cell_span_value = current_span;
             auto cell_start_rc_index = cell_index<RowOrColumn>(cell);
             auto cell_end_rc_index = cell_start_rc_index + cell_span_value;
             // 1. Start with the percentage contribution of the cell.
@@ -326,82 +350,81 @@ void TableFormattingContext::compute_table_measures()
 
     auto& rows_or_columns = table_rows_or_columns<RowOrColumn>();
 
-    size_t max_cell_span = 1;
-    for (auto& cell : m_cells) {
-        max_cell_span = max(max_cell_span, cell_span<RowOrColumn>(cell));
-    }
+    auto cells_by_span = this->cells_by_span<RowOrColumn>();
 
     // Since the intrinsic percentage specification uses non-spanning max-content size for the iterative algorithm,
     // run it before we compute the spanning max-content size with its own iterative algorithm for span up to N.
-    compute_intrinsic_percentage<RowOrColumn>(max_cell_span);
+    compute_intrinsic_percentage<RowOrColumn>(cells_by_span);
 
-    for (size_t current_span = 2; current_span <= max_cell_span; current_span++) {
+    for (size_t current_span = 2; current_span < cells_by_span.size(); current_span++) {
+        // Every step below is a no-op for spans that no cell has, and stepping through them is quadratic for long spans.
+        if (cells_by_span[current_span].is_empty())
+            continue;
         // https://www.w3.org/TR/css-tables-3/#min-content-width-of-a-column-based-on-cells-of-span-up-to-n-n--1
         Vector<Vector<CSSPixels>> cell_min_contributions_by_rc_index;
         cell_min_contributions_by_rc_index.resize(rows_or_columns.size());
         // https://www.w3.org/TR/css-tables-3/#max-content-width-of-a-column-based-on-cells-of-span-up-to-n-n--1
         Vector<Vector<CSSPixels>> cell_max_contributions_by_rc_index;
         cell_max_contributions_by_rc_index.resize(rows_or_columns.size());
-        for (auto& cell : m_cells) {
-            auto cell_span_value = cell_span<RowOrColumn>(cell);
-            if (cell_span_value == current_span) {
-                // Define the baseline max-content size as the sum of the max-content sizes based on cells of span up to N-1 of all columns that the cell spans.
-                auto cell_start_rc_index = cell_index<RowOrColumn>(cell);
-                auto cell_end_rc_index = cell_start_rc_index + cell_span_value;
-                CSSPixels baseline_max_content_size = 0;
-                for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
-                    baseline_max_content_size += rows_or_columns[rc_index].max_size;
-                }
-                CSSPixels baseline_min_content_size = 0;
-                for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
-                    baseline_min_content_size += rows_or_columns[rc_index].min_size;
+        for (auto const* cell_pointer : cells_by_span[current_span]) {
+            auto const& cell = *cell_pointer;
+            auto cell_span_value = current_span;
+            // Define the baseline max-content size as the sum of the max-content sizes based on cells of span up to N-1 of all columns that the cell spans.
+            auto cell_start_rc_index = cell_index<RowOrColumn>(cell);
+            auto cell_end_rc_index = cell_start_rc_index + cell_span_value;
+            CSSPixels baseline_max_content_size = 0;
+            for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
+                baseline_max_content_size += rows_or_columns[rc_index].max_size;
+            }
+            CSSPixels baseline_min_content_size = 0;
+            for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
+                baseline_min_content_size += rows_or_columns[rc_index].min_size;
+            }
+
+            // Define the baseline border spacing as the sum of the horizontal border-spacing for any columns spanned by the cell, other than the one in which the cell originates.
+            auto baseline_border_spacing = border_spacing<RowOrColumn>() * (cell_span_value - 1);
+
+            // Add contribution from all rows / columns, since we've weighted the gap to the desired spanned size by the the
+            // ratio of the max-content size based on cells of span up to N-1 of the row / column to the baseline max-content width.
+            for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
+                // The contribution of the cell is the sum of:
+                // the min-content size of the column based on cells of span up to N-1
+                auto cell_min_contribution = rows_or_columns[rc_index].min_size;
+                // the product of:
+                // - the ratio of:
+                //   - the max-content size of the row / column based on cells of span up to N-1 of the row / column minus the
+                //     min-content size of the row / column based on cells of span up to N-1 of the row / column, to
+                //   - the baseline max-content size minus the baseline min-content size
+                //   or zero if this ratio is undefined, and
+                // - the outer min-content size of the cell minus the baseline min-content size and the baseline border spacing, clamped
+                //   to be at least 0 and at most the difference between the baseline max-content size and the baseline min-content size
+                auto normalized_max_min_diff = baseline_max_content_size != baseline_min_content_size
+                    ? (rows_or_columns[rc_index].max_size - rows_or_columns[rc_index].min_size) / static_cast<double>(baseline_max_content_size - baseline_min_content_size)
+                    : 0;
+                auto clamped_diff_to_baseline_min = min(
+                    max(cell_min_size<RowOrColumn>(cell) - baseline_min_content_size - baseline_border_spacing, 0),
+                    baseline_max_content_size - baseline_min_content_size);
+                cell_min_contribution += CSSPixels::nearest_value_for(normalized_max_min_diff * clamped_diff_to_baseline_min);
+                // the product of:
+                // - the ratio of the max-content size based on cells of span up to N-1 of the column to the baseline max-content size
+                // - the outer min-content size of the cell minus the baseline max-content size and baseline border spacing, or 0 if this is negative
+                if (baseline_max_content_size != 0) {
+                    cell_min_contribution += CSSPixels::nearest_value_for(rows_or_columns[rc_index].max_size / static_cast<double>(baseline_max_content_size))
+                        * max(CSSPixels(0), cell_min_size<RowOrColumn>(cell) - baseline_max_content_size - baseline_border_spacing);
                 }
 
-                // Define the baseline border spacing as the sum of the horizontal border-spacing for any columns spanned by the cell, other than the one in which the cell originates.
-                auto baseline_border_spacing = border_spacing<RowOrColumn>() * (cell_span_value - 1);
-
-                // Add contribution from all rows / columns, since we've weighted the gap to the desired spanned size by the the
-                // ratio of the max-content size based on cells of span up to N-1 of the row / column to the baseline max-content width.
-                for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
-                    // The contribution of the cell is the sum of:
-                    // the min-content size of the column based on cells of span up to N-1
-                    auto cell_min_contribution = rows_or_columns[rc_index].min_size;
-                    // the product of:
-                    // - the ratio of:
-                    //   - the max-content size of the row / column based on cells of span up to N-1 of the row / column minus the
-                    //     min-content size of the row / column based on cells of span up to N-1 of the row / column, to
-                    //   - the baseline max-content size minus the baseline min-content size
-                    //   or zero if this ratio is undefined, and
-                    // - the outer min-content size of the cell minus the baseline min-content size and the baseline border spacing, clamped
-                    //   to be at least 0 and at most the difference between the baseline max-content size and the baseline min-content size
-                    auto normalized_max_min_diff = baseline_max_content_size != baseline_min_content_size
-                        ? (rows_or_columns[rc_index].max_size - rows_or_columns[rc_index].min_size) / static_cast<double>(baseline_max_content_size - baseline_min_content_size)
-                        : 0;
-                    auto clamped_diff_to_baseline_min = min(
-                        max(cell_min_size<RowOrColumn>(cell) - baseline_min_content_size - baseline_border_spacing, 0),
-                        baseline_max_content_size - baseline_min_content_size);
-                    cell_min_contribution += CSSPixels::nearest_value_for(normalized_max_min_diff * clamped_diff_to_baseline_min);
-                    // the product of:
-                    // - the ratio of the max-content size based on cells of span up to N-1 of the column to the baseline max-content size
-                    // - the outer min-content size of the cell minus the baseline max-content size and baseline border spacing, or 0 if this is negative
-                    if (baseline_max_content_size != 0) {
-                        cell_min_contribution += CSSPixels::nearest_value_for(rows_or_columns[rc_index].max_size / static_cast<double>(baseline_max_content_size))
-                            * max(CSSPixels(0), cell_min_size<RowOrColumn>(cell) - baseline_max_content_size - baseline_border_spacing);
-                    }
-
-                    // The contribution of the cell is the sum of:
-                    // the max-content size of the column based on cells of span up to N-1
-                    auto cell_max_contribution = rows_or_columns[rc_index].max_size;
-                    // and the product of:
-                    // - the ratio of the max-content size based on cells of span up to N-1 of the column to the baseline max-content size
-                    // - the outer max-content size of the cell minus the baseline max-content size and the baseline border spacing, or 0 if this is negative
-                    if (baseline_max_content_size != 0) {
-                        cell_max_contribution += CSSPixels::nearest_value_for(rows_or_columns[rc_index].max_size / static_cast<double>(baseline_max_content_size))
-                            * max(CSSPixels(0), cell_max_size<RowOrColumn>(cell) - baseline_max_content_size - baseline_border_spacing);
-                    }
-                    cell_min_contributions_by_rc_index[rc_index].append(cell_min_contribution);
-                    cell_max_contributions_by_rc_index[rc_index].append(cell_max_contribution);
+                // The contribution of the cell is the sum of:
+                // the max-content size of the column based on cells of span up to N-1
+                auto cell_max_contribution = rows_or_columns[rc_index].max_size;
+                // and the product of:
+                // - the ratio of the max-content size based on cells of span up to N-1 of the column to the baseline max-content size
+                // - the outer max-content size of the cell minus the baseline max-content size and the baseline border spacing, or 0 if this is negative
+                if (baseline_max_content_size != 0) {
+                    cell_max_contribution += CSSPixels::nearest_value_for(rows_or_columns[rc_index].max_size / static_cast<double>(baseline_max_content_size))
+                        * max(CSSPixels(0), cell_max_size<RowOrColumn>(cell) - baseline_max_content_size - baseline_border_spacing);
                 }
+                cell_min_contributions_by_rc_index[rc_index].append(cell_min_contribution);
+                cell_max_contributions_by_rc_index[rc_index].append(cell_max_contribution);
             }
         }
 
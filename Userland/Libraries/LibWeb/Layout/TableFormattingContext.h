@@ -50,8 +50,12 @@ private:
     void initialize_table_measures();
     template<class RowOrColumn>
     void compute_table_measures();
+    // Indexed by the number of rows or columns the cells span, so that the span-by-span algorithms only visit
+    // the cells of each span once instead of going over every cell for every span.
     template<class RowOrColumn>
-    void compute_intrinsic_percentage(size_t max_cell_span);
+    Vector<Vector<TableGrid::Cell const*>> cells_by_span() const;
+    template<class RowOrColumn>
+    void compute_intrinsic_percentage(Vector<Vector<TableGrid::Cell const*>> const& cells_by_span);
     void compute_table_width();
     void distribute_width_to_columns();
     void distribute_excess_width_to_columns(CSSPixels available_width);
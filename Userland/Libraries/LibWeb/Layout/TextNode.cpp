@@ -305,6 +305,7 @@ void TextNode::invalidate_text_for_rendering()
 {
     m_text_for_rendering = {};
     m_grapheme_segmenter.clear();
+    m_chunk_cache.clear();
 }
 
 String const& TextNode::text_for_rendering() const
@@ -402,15 +403,6 @@ Unicode::Segmenter& TextNode::grapheme_segmenter() const
     return *m_grapheme_segmenter;
 }
 
-TextNode::ChunkIterator::ChunkIterator(TextNode const& text_node, bool wrap_lines, bool respect_linebreaks)
-    : m_wrap_lines(wrap_lines)
-    , m_respect_linebreaks(respect_linebreaks)
-    , m_utf8_view(text_node.text_for_rendering())
-    , m_font_cascade_list(text_node.computed_values().font_list())
-    , m_grapheme_segmenter(text_node.grapheme_segmenter())
-{
-}
-
 static Gfx::GlyphRun::TextType text_type_for_code_point(u32 code_point)
 {
     switch (Unicode::bidirectional_class(code_point)) {
@@ -452,129 +444,160 @@ static Gfx::GlyphRun::TextType text_type_for_code_point(u32 code_point)
     }
 }
 
-Optional<TextNode::Chunk> TextNode::ChunkIterator::next()
+static Vector<TextNode::Chunk> split_into_chunks(TextNode const& text_node, bool wrap_lines, bool respect_linebreaks)
 {
-    if (!m_peek_queue.is_empty())
-        return m_peek_queue.take_first();
-    return next_without_peek();
-}
+    Utf8View utf8_view { text_node.text_for_rendering() };
+    auto const& font_cascade_list = text_node.computed_values().font_list();
+    auto& grapheme_segmenter = text_node.grapheme_segmenter();
+    size_t current_index = 0;
+
+    auto try_commit_chunk = [&](size_t start, size_t end, bool has_breaking_newline, bool has_breaking_tab, Gfx::Font const& font, Gfx::GlyphRun::TextType text_type) -> Optional<TextNode::Chunk> {
+        if (auto byte_length = end - start; byte_length > 0) {
+            auto chunk_view = utf8_view.substring_view(start, byte_length);
+            return TextNode::Chunk {
+                .view = chunk_view,
+                .font = font,
+                .start = start,
+                .length = byte_length,
+                .has_breaking_newline = has_breaking_newline,
+                .has_breaking_tab = has_breaking_tab,
+                .is_all_whitespace = is_all_whitespace(chunk_view.as_string()),
+                .text_type = text_type,
+            };
+        }
 
-Optional<TextNode::Chunk> TextNode::ChunkIterator::peek(size_t count)
-{
-    while (m_peek_queue.size() <= count) {
-        auto next = next_without_peek();
-        if (!next.has_value())
-            return {};
-        m_peek_queue.append(*next);
-    }
+        return {};
+    };
 
-    return m_peek_queue[count];
-}
+    auto next_chunk = [&]() -> Optional<TextNode::Chunk> {
+        if (current_index >= utf8_view.byte_length())
+            return {};
 
-Optional<TextNode::Chunk> TextNode::ChunkIterator::next_without_peek()
-{
-    if (m_current_index >= m_utf8_view.byte_length())
-        return {};
+        auto current_code_point = [&]() {
+            return *utf8_view.iterator_at_byte_offset_without_validation(current_index);
+        };
+        auto next_grapheme_boundary = [&]() {
+            return grapheme_segmenter.next_boundary(current_index).value_or(utf8_view.byte_length());
+        };
 
-    auto current_code_point = [this]() {
-        return *m_utf8_view.iterator_at_byte_offset_without_validation(m_current_index);
-    };
-    auto next_grapheme_boundary = [this]() {
-        return m_grapheme_segmenter.next_boundary(m_current_index).value_or(m_utf8_view.byte_length());
-    };
+        auto code_point = current_code_point();
+        auto start_of_chunk = current_index;
 
-    auto code_point = current_code_point();
-    auto start_of_chunk = m_current_index;
+        Gfx::Font const& font = font_cascade_list.font_for_code_point(code_point);
+        auto text_type = text_type_for_code_point(code_point);
 
-    Gfx::Font const& font = m_font_cascade_list.font_for_code_point(code_point);
-    auto text_type = text_type_for_code_point(code_point);
+        auto broken_on_tab = false;
 
-    auto broken_on_tab = false;
+        while (current_index < utf8_view.byte_length()) {
+            code_point = current_code_point();
 
-    while (m_current_index < m_utf8_view.byte_length()) {
-        code_point = current_code_point();
+            if (code_point == '\t') {
+                if (auto result = try_commit_chunk(start_of_chunk, current_index, false, broken_on_tab, font, text_type); result.has_value())
+                    return result.release_value();
 
-        if (code_point == '\t') {
-            if (auto result = try_commit_chunk(start_of_chunk, m_current_index, false, broken_on_tab, font, text_type); result.has_value())
-                return result.release_value();
+                broken_on_tab = true;
+                // consume any consecutive tabs
+                while (current_index < utf8_view.byte_length() && current_code_point() == '\t') {
+                    current_index = next_grapheme_boundary();
+                }
+            }
 
-            broken_on_tab = true;
-            // consume any consecutive tabs
-            while (m_current_index < m_utf8_view.byte_length() && current_code_point() == '\t') {
-                m_current_index = next_grapheme_boundary();
+            if (&font != &font_cascade_list.font_for_code_point(code_point)) {
+                if (auto result = try_commit_chunk(start_of_chunk, current_index, false, broken_on_tab, font, text_type); result.has_value())
+                    return result.release_value();
             }
-        }
 
-        if (&font != &m_font_cascade_list.font_for_code_point(code_point)) {
-            if (auto result = try_commit_chunk(start_of_chunk, m_current_index, false, broken_on_tab, font, text_type); result.has_value())
-                return result.release_value();
-        }
+            if (respect_linebreaks && code_point == '\n') {
+                // Newline encountered, and we're supposed to preserve them.
+                // If we have accumulated some code points in the current chunk, commit them now and continue with the newline next time.
+                if (auto result = try_commit_chunk(start_of_chunk, current_index, false, broken_on_tab, font, text_type); result.has_value())
+                    return result.release_value();
 
-        if (m_respect_linebreaks && code_point == '\n') {
-            // Newline encountered, and we're supposed to preserve them.
-            // If we have accumulated some code points in the current chunk, commit them now and continue with the newline next time.
-            if (auto result = try_commit_chunk(start_of_chunk, m_current_index, false, broken_on_tab, font, text_type); result.has_value())
+                // Otherwise, commit the newline!
+                current_index = next_grapheme_boundary();
+                auto result = try_commit_chunk(start_of_chunk, current_index, true, broken_on_tab, font, text_type);
+                VERIFY(result.has_value());
                 return result.release_value();
+            }
 
-            // Otherwise, commit the newline!
-            m_current_index = next_grapheme_boundary();
-            auto result = try_commit_chunk(start_of_chunk, m_current_index, true, broken_on_tab, font, text_type);
-            VERIFY(result.has_value());
-            return result.release_value();
-        }
+            if (wrap_lines) {
+                if (text_type != text_type_for_code_point(code_point)) {
+                    if (auto result = try_commit_chunk(start_of_chunk, current_index, false, broken_on_tab, font, text_type); result.has_value()) {
+                        return result.release_value();
+                    }
+                }
 
-        if (m_wrap_lines) {
-            if (text_type != text_type_for_code_point(code_point)) {
-                if (auto result = try_commit_chunk(start_of_chunk, m_current_index, false, broken_on_tab, font, text_type); result.has_value()) {
-                    return result.release_value();
+                if (is_ascii_space(code_point)) {
+                    // Whitespace encountered, and we're allowed to break on whitespace.
+                    // If we have accumulated some code points in the current chunk, commit them now and continue with the whitespace next time.
+                    if (auto result = try_commit_chunk(start_of_chunk, current_index, false, broken_on_tab, font, text_type); result.has_value()) {
+                        return result.release_value();
+                    }
+
+                    // Otherwise, commit the whitespace!
+                    current_index = next_grapheme_boundary();
+                    if (auto result = try_commit_chunk(start_of_chunk, current_index, false, broken_on_tab, font, text_type); result.has_value())
+                        return result.release_value();
+                    continue;
                 }
             }
 
-            if (is_ascii_space(code_point)) {
-                // Whitespace encountered, and we're allowed to break on whitespace.
-                // If we have accumulated some code points in the current chunk, commit them now and continue with the whitespace next time.
-                if (auto result = try_commit_chunk(start_of_chunk, m_current_index, false, broken_on_tab, font, text_type); result.has_value()) {
-                    return result.release_value();
-                }
+            current_index = next_grapheme_boundary();
+        }
 
-                // Otherwise, commit the whitespace!
-                m_current_index = next_grapheme_boundary();
-                if (auto result = try_commit_chunk(start_of_chunk, m_current_index, false, broken_on_tab, font, text_type); result.has_value())
-                    return result.release_value();
-                continue;
-            }
+        if (start_of_chunk != utf8_view.byte_length()) {
+            // Try to output whatever's left at the end of the text node.
+            if (auto result = try_commit_chunk(start_of_chunk, utf8_view.byte_length(), false, broken_on_tab, font, text_type); result.has_value())
+                return result.release_value();
         }
 
-        m_current_index
-            = next_grapheme_boundary();
-    }
+        return {};
+    };
 
-    if (start_of_chunk != m_utf8_view.byte_length()) {
-        // Try to output whatever's left at the end of the text node.
-        if (auto result = try_commit_chunk(start_of_chunk, m_utf8_view.byte_length(), false, broken_on_tab, font, text_type); result.has_value())
-            return result.release_value();
+    Vector<TextNode::Chunk> chunks;
+    while (true) {
+        auto chunk = next_chunk();
+        if (!chunk.has_value())
+            break;
+        chunks.append(chunk.release_value());
     }
-
-    return {};
+    return chunks;
 }
 
-Optional<TextNode::Chunk> TextNode::ChunkIterator::try_commit_chunk(size_t start, size_t end, bool has_breaking_newline, bool has_breaking_tab, Gfx::Font const& font, Gfx::GlyphRun::TextType text_type) const
+Vector<TextNode::Chunk> const& TextNode::chunks(bool wrap_lines, bool respect_linebreaks) const
 {
-    if (auto byte_length = end - start; byte_length > 0) {
-        auto chunk_view = m_utf8_view.substring_view(start, byte_length);
-        return Chunk {
-            .view = chunk_view,
-            .font = font,
-            .start = start,
-            .length = byte_length,
-            .has_breaking_newline = has_breaking_newline,
-            .has_breaking_tab = has_breaking_tab,
-            .is_all_whitespace = is_all_whitespace(chunk_view.as_string()),
-            .text_type = text_type,
+    auto const& font_cascade_list = computed_values().font_list();
+    if (!m_chunk_cache.has_value()
+        || m_chunk_cache->font_cascade_list.ptr() != &font_cascade_list
+        || m_chunk_cache->wrap_lines != wrap_lines
+        || m_chunk_cache->respect_linebreaks != respect_linebreaks) {
+        m_chunk_cache = ChunkCache {
+            .font_cascade_list = font_cascade_list,
+            .wrap_lines = wrap_lines,
+            .respect_linebreaks = respect_linebreaks,
+            .chunks = split_into_chunks(*this, wrap_lines, respect_linebreaks),
         };
     }
+    return m_chunk_cache->chunks;
+}
+
+TextNode::ChunkIterator::ChunkIterator(TextNode const& text_node, bool wrap_lines, bool respect_linebreaks)
+    : m_chunks(text_node.chunks(wrap_lines, respect_linebreaks))
+{
+}
+
+Optional<TextNode::Chunk> TextNode::ChunkIterator::next()
+{
+    if (m_index >= m_chunks.size())
+        return {};
+    return m_chunks[m_index++];
+}
 
-    return {};
+Optional<TextNode::Chunk> TextNode::ChunkIterator::peek(size_t count)
+{
+    if (m_index + count >= m_chunks.size())
+        return {};
+    return m_chunks[m_index + count];
 }
 
 JS::GCPtr<Painting::Paintable> TextNode::create_paintable() const
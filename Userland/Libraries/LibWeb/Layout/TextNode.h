@@ -46,20 +46,14 @@ public:
         Optional<Chunk> peek(size_t);
 
     private:
-        Optional<Chunk> next_without_peek();
-        Optional<Chunk> try_commit_chunk(size_t start, size_t end, bool has_breaking_newline, bool has_breaking_tab, Gfx::Font const&, Gfx::GlyphRun::TextType) const;
-
-        bool const m_wrap_lines;
-        bool const m_respect_linebreaks;
-        Utf8View m_utf8_view;
-        Gfx::FontCascadeList const& m_font_cascade_list;
-
-        Unicode::Segmenter& m_grapheme_segmenter;
-        size_t m_current_index { 0 };
-
-        Vector<Chunk> m_peek_queue;
+        Vector<Chunk> const& m_chunks;
+        size_t m_index { 0 };
     };
 
+    // The chunks only depend on the text for rendering, the fonts and the line breaking mode, so they are kept around
+    // for the layouts that follow until one of those changes.
+    Vector<Chunk> const& chunks(bool wrap_lines, bool respect_linebreaks) const;
+
     void invalidate_text_for_rendering();
     void compute_text_for_rendering();
 
@@ -72,6 +66,14 @@ private:
 
     Optional<String> m_text_for_rendering;
     mutable OwnPtr<Unicode::Segmenter> m_grapheme_segmenter;
+
+    struct ChunkCache {
+        NonnullRefPtr<Gfx::FontCascadeList const> font_cascade_list;
+        bool wrap_lines { false };
+        bool respect_linebreaks { false };
+        Vector<Chunk> chunks;
+    };
+    mutable Optional<ChunkCache> m_chunk_cache;
 };
 
 template<>
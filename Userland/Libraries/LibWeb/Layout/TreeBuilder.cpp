@@ -6,13 +6,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/Error.h>
 #include <AK/Optional.h>
 #include <AK/TemporaryChange.h>
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CSS/StyleValues/CSSKeywordValue.h>
+#include <LibWeb/CSS/StyleValues/ContentStyleValue.h>
 #include <LibWeb/CSS/StyleValues/DisplayStyleValue.h>
 #include <LibWeb/CSS/StyleValues/PercentageStyleValue.h>
+#include <LibWeb/CSS/StyleValues/StyleValueList.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ParentNode.h>
@@ -188,6 +191,29 @@ void TreeBuilder::insert_node_into_inline_or_block_ancestor(Layout::Node& node,
     }
 }
 
+static bool content_depends_on_document_order(CSS::StyleProperties const& style)
+{
+    auto value = style.property(CSS::PropertyID::Content);
+    if (!value->is_content())
+        return false;
+
+    auto depends_on_document_order = [](auto const& item) {
+        if (item->is_counter())
+            return true;
+        if (!item->is_keyword())
+            return false;
+        auto keyword = item->to_keyword();
+        return keyword == CSS::Keyword::OpenQuote
+            || keyword == CSS::Keyword::CloseQuote
+            || keyword == CSS::Keyword::NoOpenQuote
+            || keyword == CSS::Keyword::NoCloseQuote;
+    };
+    auto const& content = value->as_content();
+    if (any_of(content.content().values(), depends_on_document_order))
+        return true;
+    return content.has_alt_text() && any_of(content.alt_text()->values(), depends_on_document_order);
+}
+
 void TreeBuilder::create_pseudo_element_if_needed(DOM::Element& element, CSS::Selector::PseudoElement::Type pseudo_element, AppendOrPrepend mode)
 {
     auto& document = element.document();
@@ -196,6 +222,9 @@ void TreeBuilder::create_pseudo_element_if_needed(DOM::Element& element, CSS::Se
     if (!pseudo_element_style)
         return;
 
+    if (content_depends_on_document_order(*pseudo_element_style))
+        m_has_generated_content_depending_on_document_order = true;
+
     auto initial_quote_nesting_level = m_quote_nesting_level;
     auto [pseudo_element_content, final_quote_nesting_level] = pseudo_element_style->content(element, initial_quote_nesting_level);
     m_quote_nesting_level = final_quote_nesting_level;
@@ -301,6 +330,46 @@ i32 TreeBuilder::calculate_list_item_index(DOM::Node& dom_node)
     return 1;
 }
 
+void TreeBuilder::remove_stale_layout_nodes(DOM::Node& dom_node)
+{
+    dom_node.for_each_in_inclusive_subtree([&](auto& node) {
+        node.detach_layout_node({});
+        node.clear_paintable();
+        if (is<DOM::Element>(node))
+            static_cast<DOM::Element&>(node).clear_pseudo_element_nodes({});
+        return TraversalDecision::Continue;
+    });
+}
+
+void TreeBuilder::remove_stale_layout_nodes_of_skipped_contents(DOM::Element& element)
+{
+    auto remove_stale_layout_nodes_in_subtree = [](DOM::Node& root) {
+        root.for_each_in_inclusive_subtree([&](auto& node) {
+            auto had_layout_node = node.layout_node() || node.paintable();
+            node.detach_layout_node({});
+            node.clear_paintable();
+            if (!is<DOM::Element>(node))
+                return TraversalDecision::Continue;
+            auto& element = static_cast<DOM::Element&>(node);
+            element.clear_pseudo_element_nodes({});
+
+            // Contents that were skipped or not displayed last time around have nothing to forget either,
+            // so we don't have to walk all of a large skipped subtree on every build.
+            auto is_display_contents = element.computed_css_values() && element.computed_css_values()->display().is_contents();
+            if (!had_layout_node && !is_display_contents)
+                return TraversalDecision::SkipChildrenAndContinue;
+            return TraversalDecision::Continue;
+        });
+    };
+
+    for (auto* node = element.first_child(); node; node = node->next_sibling())
+        remove_stale_layout_nodes_in_subtree(*node);
+    if (auto shadow_root = element.shadow_root()) {
+        for (auto* node = shadow_root->first_child(); node; node = node->next_sibling())
+            remove_stale_layout_nodes_in_subtree(*node);
+    }
+}
+
 void TreeBuilder::create_layout_tree(DOM::Node& dom_node, TreeBuilder::Context& context)
 {
     if (dom_node.is_element()) {
@@ -322,15 +391,8 @@ void TreeBuilder::create_layout_tree(DOM::Node& dom_node, TreeBuilder::Context&
     ScopeGuard remove_stale_layout_node_guard = [&] {
         // If we didn't create a layout node for this DOM node,
         // go through the DOM tree and remove any old layout & paint nodes since they are now all stale.
-        if (!layout_node) {
-            dom_node.for_each_in_inclusive_subtree([&](auto& node) {
-                node.detach_layout_node({});
-                node.clear_paintable();
-                if (is<DOM::Element>(node))
-                    static_cast<DOM::Element&>(node).clear_pseudo_element_nodes({});
-                return TraversalDecision::Continue;
-            });
-        }
+        if (!layout_node)
+            remove_stale_layout_nodes(dom_node);
     };
 
     if (dom_node.is_svg_container()) {
@@ -388,23 +450,20 @@ void TreeBuilder::create_layout_tree(DOM::Node& dom_node, TreeBuilder::Context&
 
     auto shadow_root = is<DOM::Element>(dom_node) ? verify_cast<DOM::Element>(dom_node).shadow_root() : nullptr;
 
-    auto element_has_content_visibility_hidden = [&dom_node]() {
-        if (is<DOM::Element>(dom_node)) {
-            auto& element = static_cast<DOM::Element&>(dom_node);
-            return element.computed_css_values()->content_visibility() == CSS::ContentVisibility::Hidden;
-        }
-        return false;
-    }();
+    auto element_skips_its_contents = is<DOM::Element>(dom_node) && static_cast<DOM::Element&>(dom_node).skips_its_contents();
+    // Skipped contents don't get any layout nodes, so forget the ones they had in the previous layout tree.
+    if (element_skips_its_contents)
+        remove_stale_layout_nodes_of_skipped_contents(static_cast<DOM::Element&>(dom_node));
 
     // Add node for the ::before pseudo-element.
-    if (is<DOM::Element>(dom_node) && layout_node->can_have_children() && !element_has_content_visibility_hidden) {
+    if (is<DOM::Element>(dom_node) && layout_node->can_have_children() && !element_skips_its_contents) {
         auto& element = static_cast<DOM::Element&>(dom_node);
         push_parent(verify_cast<NodeWithStyle>(*layout_node));
         create_pseudo_element_if_needed(element, CSS::Selector::PseudoElement::Type::Before, AppendOrPrepend::Prepend);
         pop_parent();
     }
 
-    if ((dom_node.has_children() || shadow_root) && layout_node->can_have_children() && !element_has_content_visibility_hidden) {
+    if ((dom_node.has_children() || shadow_root) && layout_node->can_have_children() && !element_skips_its_contents) {
         push_parent(verify_cast<NodeWithStyle>(*layout_node));
         if (shadow_root) {
             for (auto* node = shadow_root->first_child(); node; node = node->next_sibling()) {
@@ -438,7 +497,7 @@ void TreeBuilder::create_layout_tree(DOM::Node& dom_node, TreeBuilder::Context&
     if (is<HTML::HTMLSlotElement>(dom_node)) {
         auto& slot_element = static_cast<HTML::HTMLSlotElement&>(dom_node);
 
-        if (slot_element.computed_css_values()->content_visibility() == CSS::ContentVisibility::Hidden)
+        if (slot_element.skips_its_contents())
             return;
 
         auto slottables = slot_element.assigned_nodes_internal();
@@ -529,7 +588,7 @@ void TreeBuilder::create_layout_tree(DOM::Node& dom_node, TreeBuilder::Context&
     }
 
     // Add nodes for the ::after pseudo-element.
-    if (is<DOM::Element>(dom_node) && layout_node->can_have_children() && !element_has_content_visibility_hidden) {
+    if (is<DOM::Element>(dom_node) && layout_node->can_have_children() && !element_skips_its_contents) {
         auto& element = static_cast<DOM::Element&>(dom_node);
         push_parent(verify_cast<NodeWithStyle>(*layout_node));
         create_pseudo_element_if_needed(element, CSS::Selector::PseudoElement::Type::After, AppendOrPrepend::Append);
@@ -545,14 +604,95 @@ JS::GCPtr<Layout::Node> TreeBuilder::build(DOM::Node& dom_node)
 
     Context context;
     m_quote_nesting_level = 0;
+    m_has_generated_content_depending_on_document_order = false;
     create_layout_tree(dom_node, context);
 
-    if (auto* root = dom_node.document().layout_node())
+    if (auto* root = dom_node.document().layout_node()) {
         fixup_tables(*root);
+        root->set_has_generated_content_depending_on_document_order(m_has_generated_content_depending_on_document_order);
+    }
 
     return move(m_layout_root);
 }
 
+bool TreeBuilder::can_rebuild_contents_of(DOM::Element const& element)
+{
+    auto layout_node = element.layout_node();
+    if (!layout_node || layout_node->is_anonymous() || !layout_node->is_box() || !layout_node->can_have_children())
+        return false;
+
+    // The root element's contents include the box whose overflow got propagated to the viewport.
+    if (element.document().document_element() == &element)
+        return false;
+
+    // List items, buttons and table parts get extra boxes around or among their contents, which only a full build knows how to make.
+    if (is<ListItemBox>(*layout_node) || is<HTML::HTMLButtonElement>(element) || is<HTML::HTMLInputElement>(element))
+        return false;
+    auto display = verify_cast<NodeWithStyle>(*layout_node).display();
+    if (!display.is_block_outside())
+        return false;
+    if (!display.is_flow_inside() && !display.is_flow_root_inside() && !display.is_flex_inside() && !display.is_grid_inside())
+        return false;
+
+    // Shadow hosts and slots lay out nodes that aren't their children.
+    if (element.is_shadow_host() || is<HTML::HTMLSlotElement>(element))
+        return false;
+    // The contents of SVG elements are laid out differently depending on what surrounds them.
+    for (auto const* ancestor = &element; ancestor; ancestor = ancestor->parent_or_shadow_host_element()) {
+        if (ancestor->is_svg_element())
+            return false;
+    }
+    return true;
+}
+
+bool TreeBuilder::rebuild_contents_of(DOM::Element& element)
+{
+    auto& document = element.document();
+    auto* viewport = document.layout_node();
+    if (!viewport || viewport->has_generated_content_depending_on_document_order())
+        return false;
+    if (!can_rebuild_contents_of(element) || !viewport->is_ancestor_of(*element.layout_node()))
+        return false;
+
+    auto& layout_node = *element.layout_node();
+    while (auto* child = layout_node.first_child())
+        layout_node.remove_child(*child);
+    layout_node.set_children_are_inline(false);
+    element.clear_pseudo_element_nodes({});
+
+    // The ancestor filter has to know about every ancestor of the elements we're going to compute ::before/::after styles for.
+    auto& style_computer = document.style_computer();
+    style_computer.reset_ancestor_filter();
+    Vector<DOM::Element const*> ancestors;
+    for (auto const* ancestor = &element; ancestor; ancestor = ancestor->parent_or_shadow_host_element())
+        ancestors.append(ancestor);
+    for (auto const* ancestor : ancestors.in_reverse())
+        style_computer.push_ancestor(*ancestor);
+
+    Context context;
+    m_quote_nesting_level = 0;
+    m_has_generated_content_depending_on_document_order = false;
+
+    if (!element.skips_its_contents()) {
+        push_parent(layout_node);
+        create_pseudo_element_if_needed(element, CSS::Selector::PseudoElement::Type::Before, AppendOrPrepend::Prepend);
+        for (auto* node = element.first_child(); node; node = node->next_sibling())
+            create_layout_tree(*node, context);
+        create_pseudo_element_if_needed(element, CSS::Selector::PseudoElement::Type::After, AppendOrPrepend::Append);
+        pop_parent();
+    } else {
+        remove_stale_layout_nodes_of_skipped_contents(element);
+    }
+
+    for (auto const* ancestor : ancestors)
+        style_computer.pop_ancestor(*ancestor);
+
+    fixup_tables(layout_node);
+    viewport->invalidate_text_blocks();
+
+    return !m_has_generated_content_depending_on_document_order;
+}
+
 template<CSS::DisplayInternal internal, typename Callback>
 void TreeBuilder::for_each_in_tree_with_internal_display(NodeWithStyle& root, Callback callback)
 {
@@ -20,6 +20,13 @@ public:
 
     JS::GCPtr<Layout::Node> build(DOM::Node&);
 
+    // Whether the layout nodes for the contents of this element can be rebuilt without touching the rest of the layout tree.
+    static bool can_rebuild_contents_of(DOM::Element const&);
+
+    // Replaces the layout nodes for the contents of the element, keeping its own layout node in place.
+    // Returns false if the result depends on content elsewhere in the document, in which case the whole layout tree must be rebuilt.
+    bool rebuild_contents_of(DOM::Element&);
+
 private:
     struct Context {
         bool has_svg_root = false;
@@ -31,6 +38,9 @@ private:
 
     void create_layout_tree(DOM::Node&, Context&);
 
+    static void remove_stale_layout_nodes(DOM::Node&);
+    static void remove_stale_layout_nodes_of_skipped_contents(DOM::Element&);
+
     void push_parent(Layout::NodeWithStyle& node) { m_ancestor_stack.append(node); }
     void pop_parent() { m_ancestor_stack.take_last(); }
 
@@ -57,6 +67,7 @@ private:
     Vector<JS::NonnullGCPtr<Layout::NodeWithStyle>> m_ancestor_stack;
 
     u32 m_quote_nesting_level { 0 };
+    bool m_has_generated_content_depending_on_document_order { false };
 };
 
 }
@@ -28,9 +28,15 @@ public:
         Vector<TextPosition> positions;
     };
     Vector<TextBlock> const& text_blocks();
+    void invalidate_text_blocks() { m_text_blocks.clear(); }
 
     const DOM::Document& dom_node() const { return static_cast<const DOM::Document&>(*Node::dom_node()); }
 
+    // Quotes and counters in generated content depend on everything that comes before them in the document,
+    // so a tree that has them can't have parts of it rebuilt in isolation.
+    bool has_generated_content_depending_on_document_order() const { return m_has_generated_content_depending_on_document_order; }
+    void set_has_generated_content_depending_on_document_order(bool value) { m_has_generated_content_depending_on_document_order = value; }
+
     virtual void visit_edges(Visitor&) override;
 
 private:
@@ -41,6 +47,7 @@ private:
     virtual bool is_viewport() const override { return true; }
 
     Optional<Vector<TextBlock>> m_text_blocks;
+    bool m_has_generated_content_depending_on_document_order { false };
 };
 
 template<>
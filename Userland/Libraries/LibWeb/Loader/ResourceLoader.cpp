@@ -81,6 +81,16 @@ void ResourceLoader::preconnect(URL::URL const& url)
 
 static HashMap<LoadRequest, NonnullRefPtr<Resource>> s_resource_cache;
 
+static bool is_critical_network_load(RequestServer::RequestPriority priority)
+{
+    return priority >= RequestServer::RequestPriority::High;
+}
+
+static bool is_delayable_network_load(RequestServer::RequestPriority priority)
+{
+    return priority <= RequestServer::RequestPriority::Low;
+}
+
 RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, LoadRequest& request)
 {
     if (!request.is_valid())
@@ -107,10 +117,10 @@ RefPtr<Resource> ResourceLoader::load_resource(Resource::Type type, LoadRequest&
 
     load(
         request,
-        [=](auto data, auto& headers, auto status_code) {
+        [=](auto data, auto& headers, auto status_code, auto const&) {
             const_cast<Resource&>(*resource).did_load({}, data, headers, status_code);
         },
-        [=](auto& error, auto status_code, auto data, auto& headers) {
+        [=](auto& error, auto status_code, auto data, auto& headers, auto const&) {
             const_cast<Resource&>(*resource).did_fail({}, error, data, headers, status_code);
         });
 
@@ -229,7 +239,7 @@ static bool should_block_request(LoadRequest const& request)
     return false;
 }
 
-void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback, ErrorCallback error_callback, Optional<u32> timeout, TimeoutCallback timeout_callback)
+RefPtr<NetworkLoad> ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback, ErrorCallback error_callback, Optional<u32> timeout, TimeoutCallback timeout_callback)
 {
     auto const& url = request.url();
 
@@ -237,8 +247,8 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
     request.start_timer();
 
     if (should_block_request(request)) {
-        error_callback("Request was blocked", {}, {}, {});
-        return;
+        error_callback("Request was blocked", {}, {}, {}, {});
+        return nullptr;
     }
 
     auto respond_directory_page = [](LoadRequest const& request, URL::URL const& url, SuccessCallback const& success_callback, ErrorCallback const& error_callback) {
@@ -246,14 +256,14 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         if (maybe_response.is_error()) {
             log_failure(request, maybe_response.error());
             if (error_callback)
-                error_callback(ByteString::formatted("{}", maybe_response.error()), 500u, {}, {});
+                error_callback(ByteString::formatted("{}", maybe_response.error()), 500u, {}, {}, {});
             return;
         }
 
         log_success(request);
         HTTP::HeaderMap response_headers;
         response_headers.set("Content-Type"sv, "text/html"sv);
-        success_callback(maybe_response.release_value().bytes(), response_headers, {});
+        success_callback(maybe_response.release_value().bytes(), response_headers, {}, {});
     };
 
     if (url.scheme() == "about") {
@@ -265,22 +275,22 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
 
         // About version page
         if (url.path_segment_at_index(0) == "version") {
-            success_callback(MUST(load_about_version_page()).bytes(), response_headers, {});
-            return;
+            success_callback(MUST(load_about_version_page()).bytes(), response_headers, {}, {});
+            return nullptr;
         }
 
         // Other about static HTML pages
         auto resource = Core::Resource::load_from_uri(MUST(String::formatted("resource://ladybird/{}.html", url.path_segment_at_index(0))));
         if (!resource.is_error()) {
             auto data = resource.value()->data();
-            success_callback(data, response_headers, {});
-            return;
+            success_callback(data, response_headers, {}, {});
+            return nullptr;
         }
 
         Platform::EventLoopPlugin::the().deferred_invoke([success_callback = move(success_callback), response_headers = move(response_headers)] {
-            success_callback(ByteString::empty().to_byte_buffer(), response_headers, {});
+            success_callback(ByteString::empty().to_byte_buffer(), response_headers, {}, {});
         });
-        return;
+        return nullptr;
     }
 
     if (url.scheme() == "data") {
@@ -288,8 +298,8 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         if (data_url_or_error.is_error()) {
             auto error_message = data_url_or_error.error().string_literal();
             log_failure(request, error_message);
-            error_callback(error_message, {}, {}, {});
-            return;
+            error_callback(error_message, {}, {}, {}, {});
+            return nullptr;
         }
         auto data_url = data_url_or_error.release_value();
 
@@ -303,9 +313,9 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         log_success(request);
 
         Platform::EventLoopPlugin::the().deferred_invoke([data = move(data_url.body), response_headers = move(response_headers), success_callback = move(success_callback)] {
-            success_callback(data, response_headers, {});
+            success_callback(data, response_headers, {}, {});
         });
-        return;
+        return nullptr;
     }
 
     if (url.scheme() == "resource") {
@@ -313,23 +323,23 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         if (resource.is_error()) {
             log_failure(request, resource.error());
             if (error_callback)
-                error_callback(ByteString::formatted("{}", resource.error()), {}, {}, {});
-            return;
+                error_callback(ByteString::formatted("{}", resource.error()), {}, {}, {}, {});
+            return nullptr;
         }
 
         // When resource URI is a directory use file directory loader to generate response
         if (resource.value()->is_directory()) {
             respond_directory_page(request, resource.value()->file_url(), success_callback, error_callback);
-            return;
+            return nullptr;
         }
 
         auto data = resource.value()->data();
         auto response_headers = response_headers_for_file(URL::percent_decode(url.serialize_path()), resource.value()->modified_time());
 
         log_success(request);
-        success_callback(data, response_headers, {});
+        success_callback(data, response_headers, {}, {});
 
-        return;
+        return nullptr;
     }
 
     if (url.scheme() == "file") {
@@ -338,7 +348,7 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
 
         if (!m_page.has_value()) {
             log_failure(request, "INTERNAL ERROR: No Page for request");
-            return;
+            return nullptr;
         }
 
         FileRequest file_request(URL::percent_decode(url.serialize_path()), [this, success_callback = move(success_callback), error_callback = move(error_callback), request, respond_directory_page](ErrorOr<i32> file_or_error) {
@@ -349,7 +359,7 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
             if (file_or_error.is_error()) {
                 log_failure(request, file_or_error.error());
                 if (error_callback)
-                    error_callback(ByteString::formatted("{}", file_or_error.error()), {}, {}, {});
+                    error_callback(ByteString::formatted("{}", file_or_error.error()), {}, {}, {}, {});
                 return;
             }
 
@@ -366,7 +376,7 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
             if (st_or_error.is_error()) {
                 log_failure(request, st_or_error.error());
                 if (error_callback)
-                    error_callback(ByteString::formatted("{}", st_or_error.error()), {}, {}, {});
+                    error_callback(ByteString::formatted("{}", st_or_error.error()), {}, {}, {}, {});
                 return;
             }
 
@@ -375,7 +385,7 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
             if (maybe_file.is_error()) {
                 log_failure(request, maybe_file.error());
                 if (error_callback)
-                    error_callback(ByteString::formatted("{}", maybe_file.error()), {}, {}, {});
+                    error_callback(ByteString::formatted("{}", maybe_file.error()), {}, {}, {}, {});
                 return;
             }
 
@@ -384,7 +394,7 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
             if (maybe_data.is_error()) {
                 log_failure(request, maybe_data.error());
                 if (error_callback)
-                    error_callback(ByteString::formatted("{}", maybe_data.error()), {}, {}, {});
+                    error_callback(ByteString::formatted("{}", maybe_data.error()), {}, {}, {}, {});
                 return;
             }
 
@@ -392,7 +402,7 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
             auto response_headers = response_headers_for_file(URL::percent_decode(request.url().serialize_path()), st_or_error.value().st_mtime);
 
             log_success(request);
-            success_callback(data, response_headers, {});
+            success_callback(data, response_headers, {}, {});
         });
 
         (*m_page)->client().request_file(move(file_request));
@@ -401,62 +411,68 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         if (on_load_counter_change)
             on_load_counter_change();
 
-        return;
+        return nullptr;
     }
 
     if (url.scheme() == "http" || url.scheme() == "https") {
-        auto protocol_request = start_network_request(request);
-        if (!protocol_request) {
-            if (error_callback)
-                error_callback("Failed to start network request"sv, {}, {}, {});
-            return;
-        }
+        return schedule_network_load(request.priority(), [this, request, success_callback = move(success_callback), error_callback = move(error_callback), timeout, timeout_callback = move(timeout_callback)](NetworkLoad& network_load) mutable -> RefPtr<Requests::Request> {
+            auto protocol_request = start_network_request(request);
+            if (!protocol_request) {
+                if (error_callback)
+                    error_callback("Failed to start network request"sv, {}, {}, {}, {});
+                return nullptr;
+            }
 
-        if (timeout.has_value() && timeout.value() > 0) {
-            auto timer = Platform::Timer::create_single_shot(timeout.value(), nullptr);
-            timer->on_timeout = [timer, protocol_request, timeout_callback = move(timeout_callback)] {
-                protocol_request->stop();
-                if (timeout_callback)
-                    timeout_callback();
-            };
-            timer->start();
-        }
+            if (timeout.has_value() && timeout.value() > 0) {
+                auto timer = Platform::Timer::create_single_shot(timeout.value(), nullptr);
+                timer->on_timeout = [this, timer, protocol_request, network_load = NonnullRefPtr { network_load }, timeout_callback = move(timeout_callback)] {
+                    if (network_load->is_canceled())
+                        return;
+                    protocol_request->stop();
+                    finish_network_request(*protocol_request);
+                    if (timeout_callback)
+                        timeout_callback();
+                };
+                timer->start();
+            }
 
-        auto on_buffered_request_finished = [this, success_callback = move(success_callback), error_callback = move(error_callback), request, &protocol_request = *protocol_request](auto, auto const& network_error, auto& response_headers, auto status_code, ReadonlyBytes payload) mutable {
-            handle_network_response_headers(request, response_headers);
-            finish_network_request(protocol_request);
+            auto on_buffered_request_finished = [this, success_callback = move(success_callback), error_callback = move(error_callback), request, &protocol_request = *protocol_request](auto, auto const& network_error, auto& response_headers, auto status_code, ReadonlyBytes payload) mutable {
+                handle_network_response_headers(request, response_headers);
+                finish_network_request(protocol_request);
 
-            if (network_error.has_value() || (status_code.has_value() && *status_code >= 400 && *status_code <= 599 && (payload.is_empty() || !request.is_main_resource()))) {
-                StringBuilder error_builder;
-                if (network_error.has_value())
-                    error_builder.appendff("{}", network_error_to_string_view(*network_error));
-                else
-                    error_builder.append("Load failed"sv);
+                if (network_error.has_value() || (status_code.has_value() && *status_code >= 400 && *status_code <= 599 && (payload.is_empty() || !request.is_main_resource()))) {
+                    StringBuilder error_builder;
+                    if (network_error.has_value())
+                        error_builder.appendff("{}", network_error_to_string_view(*network_error));
+                    else
+                        error_builder.append("Load failed"sv);
 
-                if (status_code.has_value() && *status_code > 0)
-                    error_builder.appendff(" (status: {} {})", *status_code, HTTP::HttpResponse::reason_phrase_for_code(*status_code));
+                    if (status_code.has_value() && *status_code > 0)
+                        error_builder.appendff(" (status: {} {})", *status_code, HTTP::HttpResponse::reason_phrase_for_code(*status_code));
 
-                log_failure(request, error_builder.string_view());
-                if (error_callback)
-                    error_callback(error_builder.to_byte_string(), status_code, payload, response_headers);
-                return;
-            }
+                    log_failure(request, error_builder.string_view());
+                    if (error_callback)
+                        error_callback(error_builder.to_byte_string(), status_code, payload, response_headers, protocol_request.timing_info());
+                    return;
+                }
 
-            log_success(request);
-            success_callback(payload, response_headers, status_code);
-        };
+                log_success(request);
+                success_callback(payload, response_headers, status_code, protocol_request.timing_info());
+            };
 
-        protocol_request->set_buffered_request_finished_callback(move(on_buffered_request_finished));
-        return;
+            protocol_request->set_buffered_request_finished_callback(move(on_buffered_request_finished));
+            return protocol_request;
+        });
     }
 
     auto not_implemented_error = ByteString::formatted("Protocol not implemented: {}", url.scheme());
     log_failure(request, not_implemented_error);
     if (error_callback)
-        error_callback(not_implemented_error, {}, {}, {});
+        error_callback(not_implemented_error, {}, {}, {}, {});
+    return nullptr;
 }
 
-void ResourceLoader::load_unbuffered(LoadRequest& request, OnHeadersReceived on_headers_received, OnDataReceived on_data_received, OnComplete on_complete)
+RefPtr<NetworkLoad> ResourceLoader::load_unbuffered(LoadRequest& request, OnHeadersReceived on_headers_received, OnDataReceived on_data_received, OnComplete on_complete)
 {
     auto const& url = request.url();
 
@@ -464,44 +480,47 @@ void ResourceLoader::load_unbuffered(LoadRequest& request, OnHeadersReceived on_
     request.start_timer();
 
     if (should_block_request(request)) {
-        on_complete(false, "Request was blocked"sv);
-        return;
+        on_complete(false, {}, "Request was blocked"sv);
+        return nullptr;
     }
 
     if (!url.scheme().is_one_of("http"sv, "https"sv)) {
         // FIXME: Non-network requests from fetch should not go through this path.
-        on_complete(false, "Cannot establish connection non-network scheme"sv);
-        return;
+        on_complete(false, {}, "Cannot establish connection non-network scheme"sv);
+        return nullptr;
     }
 
-    auto protocol_request = start_network_request(request);
-    if (!protocol_request) {
-        on_complete(false, "Failed to start network request"sv);
-        return;
-    }
+    return schedule_network_load(request.priority(), [this, request, on_headers_received = move(on_headers_received), on_data_received = move(on_data_received), on_complete = move(on_complete)](NetworkLoad&) mutable -> RefPtr<Requests::Request> {
+        auto protocol_request = start_network_request(request);
+        if (!protocol_request) {
+            on_complete(false, {}, "Failed to start network request"sv);
+            return nullptr;
+        }
 
-    auto protocol_headers_received = [this, on_headers_received = move(on_headers_received), request](auto const& response_headers, auto status_code) {
-        handle_network_response_headers(request, response_headers);
-        on_headers_received(response_headers, move(status_code));
-    };
+        auto protocol_headers_received = [this, on_headers_received = move(on_headers_received), request](auto const& response_headers, auto status_code) {
+            handle_network_response_headers(request, response_headers);
+            on_headers_received(response_headers, move(status_code));
+        };
 
-    auto protocol_data_received = [on_data_received = move(on_data_received)](auto data) {
-        on_data_received(data);
-    };
+        auto protocol_data_received = [on_data_received = move(on_data_received)](auto data) {
+            on_data_received(data);
+        };
 
-    auto protocol_complete = [this, on_complete = move(on_complete), request, &protocol_request = *protocol_request](u64, Optional<Requests::NetworkError> const& network_error) {
-        finish_network_request(protocol_request);
+        auto protocol_complete = [this, on_complete = move(on_complete), request, &protocol_request = *protocol_request](u64, Optional<Requests::NetworkError> const& network_error) {
+            finish_network_request(protocol_request);
 
-        if (!network_error.has_value()) {
-            log_success(request);
-            on_complete(true, {});
-        } else {
-            log_failure(request, "Request finished with error"sv);
-            on_complete(false, "Request finished with error"sv);
-        }
-    };
+            if (!network_error.has_value()) {
+                log_success(request);
+                on_complete(true, protocol_request.timing_info(), {});
+            } else {
+                log_failure(request, "Request finished with error"sv);
+                on_complete(false, protocol_request.timing_info(), "Request finished with error"sv);
+            }
+        };
 
-    protocol_request->set_unbuffered_request_callbacks(move(protocol_headers_received), move(protocol_data_received), move(protocol_complete));
+        protocol_request->set_unbuffered_request_callbacks(move(protocol_headers_received), move(protocol_data_received), move(protocol_complete));
+        return protocol_request;
+    });
 }
 
 RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest const& request)
@@ -517,7 +536,7 @@ RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest cons
     if (!headers.contains("User-Agent"))
         headers.set("User-Agent", m_user_agent.to_byte_string());
 
-    auto protocol_request = m_request_client->start_request(request.method(), request.url(), headers, request.body(), proxy);
+    auto protocol_request = m_request_client->start_request(request.method(), request.url(), headers, request.body(), proxy, request.priority());
     if (!protocol_request) {
         log_failure(request, "Failed to initiate load"sv);
         return nullptr;
@@ -532,6 +551,14 @@ RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest cons
         on_load_counter_change();
 
     m_active_requests.set(*protocol_request);
+
+    auto priority = request.priority();
+    m_network_load_priorities.set(protocol_request.ptr(), priority);
+    if (is_critical_network_load(priority))
+        ++m_critical_network_loads_in_flight;
+    else if (is_delayable_network_load(priority))
+        ++m_delayable_network_loads_in_flight;
+
     return protocol_request;
 }
 
@@ -554,6 +581,11 @@ void ResourceLoader::handle_network_response_headers(LoadRequest const& request,
 
 void ResourceLoader::finish_network_request(NonnullRefPtr<Requests::Request> const& protocol_request)
 {
+    // NOTE: A request that timed out may still finish later on, or the other way around. Only the first of these counts.
+    auto priority = m_network_load_priorities.take(protocol_request.ptr());
+    if (!priority.has_value())
+        return;
+
     --m_pending_loads;
     if (on_load_counter_change)
         on_load_counter_change();
@@ -561,6 +593,73 @@ void ResourceLoader::finish_network_request(NonnullRefPtr<Requests::Request> con
     Platform::EventLoopPlugin::the().deferred_invoke([this, protocol_request] {
         m_active_requests.remove(protocol_request);
     });
+
+    if (is_critical_network_load(*priority))
+        --m_critical_network_loads_in_flight;
+    else if (is_delayable_network_load(*priority))
+        --m_delayable_network_loads_in_flight;
+    start_delayed_network_loads_if_possible();
+}
+
+bool ResourceLoader::can_start_delayable_network_load() const
+{
+    // NOTE: With nothing critical in flight, there is nothing for low priority loads to get in the way of.
+    static constexpr size_t max_delayable_network_loads_during_critical_loads = 2;
+    return m_critical_network_loads_in_flight == 0 || m_delayable_network_loads_in_flight < max_delayable_network_loads_during_critical_loads;
+}
+
+NonnullRefPtr<NetworkLoad> ResourceLoader::schedule_network_load(RequestServer::RequestPriority priority, NetworkLoad::StartFunction start)
+{
+    auto network_load = adopt_ref(*new NetworkLoad(priority, move(start)));
+    if (!is_delayable_network_load(priority) || (m_delayed_network_loads.is_empty() && can_start_delayable_network_load())) {
+        start_network_load(network_load);
+        return network_load;
+    }
+
+    // NOTE: Delayed loads start in priority order, and in the order they were scheduled within the same priority.
+    auto index = m_delayed_network_loads.find_first_index_if([&](auto const& delayed_load) {
+        return delayed_load->m_priority < priority;
+    });
+    m_delayed_network_loads.insert(index.value_or(m_delayed_network_loads.size()), network_load);
+    return network_load;
+}
+
+void ResourceLoader::start_network_load(NetworkLoad& network_load)
+{
+    auto start = move(network_load.m_start);
+    network_load.m_protocol_request = start(network_load);
+}
+
+void ResourceLoader::start_delayed_network_loads_if_possible()
+{
+    while (!m_delayed_network_loads.is_empty() && can_start_delayable_network_load()) {
+        auto delayed_load = m_delayed_network_loads.take_first();
+        start_network_load(delayed_load);
+    }
+}
+
+void ResourceLoader::cancel_network_load(NetworkLoad& network_load)
+{
+    network_load.m_start = nullptr;
+    m_delayed_network_loads.remove_first_matching([&](auto const& delayed_load) {
+        return delayed_load.ptr() == &network_load;
+    });
+
+    // NOTE: Stopping the request drops its callbacks, so none of them are invoked after this.
+    if (auto protocol_request = move(network_load.m_protocol_request)) {
+        protocol_request->stop();
+        finish_network_request(*protocol_request);
+    }
+}
+
+NetworkLoad::~NetworkLoad() = default;
+
+void NetworkLoad::cancel()
+{
+    if (m_canceled)
+        return;
+    m_canceled = true;
+    ResourceLoader::the().cancel_network_load(*this);
 }
 
 void ResourceLoader::clear_cache()
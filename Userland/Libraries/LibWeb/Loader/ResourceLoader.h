@@ -10,15 +10,45 @@
 #include <AK/ByteString.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/RefCounted.h>
 #include <LibCore/EventReceiver.h>
 #include <LibJS/SafeFunction.h>
 #include <LibRequests/Forward.h>
+#include <LibRequests/RequestTimingInfo.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Loader/Resource.h>
 #include <LibWeb/Loader/UserAgent.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web {
 
+// A network load made through ResourceLoader. Low priority loads may wait in a queue before they are started.
+class NetworkLoad : public RefCounted<NetworkLoad> {
+public:
+    // Takes the load out of the queue if it hasn't been started yet, and stops it otherwise. None of its callbacks are
+    // invoked after this.
+    void cancel();
+    bool is_canceled() const { return m_canceled; }
+
+    ~NetworkLoad();
+
+private:
+    friend class ResourceLoader;
+
+    using StartFunction = JS::SafeFunction<RefPtr<Requests::Request>(NetworkLoad&)>;
+
+    NetworkLoad(RequestServer::RequestPriority priority, StartFunction start)
+        : m_priority(priority)
+        , m_start(move(start))
+    {
+    }
+
+    RequestServer::RequestPriority m_priority;
+    StartFunction m_start;
+    RefPtr<Requests::Request> m_protocol_request;
+    bool m_canceled { false };
+};
+
 class ResourceLoader : public Core::EventReceiver {
     C_OBJECT_ABSTRACT(ResourceLoader)
 public:
@@ -27,17 +57,18 @@ public:
 
     RefPtr<Resource> load_resource(Resource::Type, LoadRequest&);
 
-    using SuccessCallback = JS::SafeFunction<void(ReadonlyBytes, HTTP::HeaderMap const& response_headers, Optional<u32> status_code)>;
-    using ErrorCallback = JS::SafeFunction<void(ByteString const&, Optional<u32> status_code, ReadonlyBytes payload, HTTP::HeaderMap const& response_headers)>;
+    using SuccessCallback = JS::SafeFunction<void(ReadonlyBytes, HTTP::HeaderMap const& response_headers, Optional<u32> status_code, Requests::RequestTimingInfo const& timing_info)>;
+    using ErrorCallback = JS::SafeFunction<void(ByteString const&, Optional<u32> status_code, ReadonlyBytes payload, HTTP::HeaderMap const& response_headers, Requests::RequestTimingInfo const& timing_info)>;
     using TimeoutCallback = JS::SafeFunction<void()>;
 
-    void load(LoadRequest&, SuccessCallback success_callback, ErrorCallback error_callback = nullptr, Optional<u32> timeout = {}, TimeoutCallback timeout_callback = nullptr);
+    // Network loads return a NetworkLoad, which can be used to cancel them. Other loads return null.
+    RefPtr<NetworkLoad> load(LoadRequest&, SuccessCallback success_callback, ErrorCallback error_callback = nullptr, Optional<u32> timeout = {}, TimeoutCallback timeout_callback = nullptr);
 
     using OnHeadersReceived = JS::SafeFunction<void(HTTP::HeaderMap const& response_headers, Optional<u32> status_code)>;
     using OnDataReceived = JS::SafeFunction<void(ReadonlyBytes data)>;
-    using OnComplete = JS::SafeFunction<void(bool success, Optional<StringView> error_message)>;
+    using OnComplete = JS::SafeFunction<void(bool success, Requests::RequestTimingInfo const& timing_info, Optional<StringView> error_message)>;
 
-    void load_unbuffered(LoadRequest&, OnHeadersReceived, OnDataReceived, OnComplete);
+    RefPtr<NetworkLoad> load_unbuffered(LoadRequest&, OnHeadersReceived, OnDataReceived, OnComplete);
 
     Requests::RequestClient& request_client() { return *m_request_client; }
 
@@ -75,16 +106,31 @@ public:
     void evict_from_cache(LoadRequest const&);
 
 private:
+    friend class NetworkLoad;
+
     explicit ResourceLoader(NonnullRefPtr<Requests::RequestClient>);
 
     RefPtr<Requests::Request> start_network_request(LoadRequest const&);
     void handle_network_response_headers(LoadRequest const&, HTTP::HeaderMap const&);
     void finish_network_request(NonnullRefPtr<Requests::Request> const&);
 
+    // Low priority network loads (images, prefetches, ...) are held back while too many of them would compete with
+    // the loads that the page can't be displayed without.
+    NonnullRefPtr<NetworkLoad> schedule_network_load(RequestServer::RequestPriority, NetworkLoad::StartFunction);
+    void start_network_load(NetworkLoad&);
+    void start_delayed_network_loads_if_possible();
+    bool can_start_delayable_network_load() const;
+    void cancel_network_load(NetworkLoad&);
+
+    Vector<NonnullRefPtr<NetworkLoad>> m_delayed_network_loads;
+    size_t m_critical_network_loads_in_flight { 0 };
+    size_t m_delayable_network_loads_in_flight { 0 };
+
     int m_pending_loads { 0 };
 
     NonnullRefPtr<Requests::RequestClient> m_request_client;
     HashTable<NonnullRefPtr<Requests::Request>> m_active_requests;
+    HashMap<Requests::Request const*, RequestServer::RequestPriority> m_network_load_priorities;
 
     String m_user_agent;
     String m_platform;
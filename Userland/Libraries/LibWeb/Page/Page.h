@@ -279,6 +279,8 @@ struct PaintOptions {
     PaintOverlay paint_overlay { PaintOverlay::Yes };
     bool should_show_line_box_borders { false };
     bool has_focus { false };
+    // The parts of the target that have to be repainted, if it already holds a frame that is correct everywhere else.
+    Optional<Vector<DevicePixelRect>> rects_to_repaint;
 };
 
 enum class DisplayListPlayerType {
@@ -386,6 +388,9 @@ public:
 
     virtual bool is_ready_to_paint() const = 0;
 
+    // Whether the page can be presented to the user at all right now, e.g. because it's not in a hidden or occluded view.
+    virtual bool is_visible_for_rendering() const { return true; }
+
     virtual DisplayListPlayerType display_list_player_type() const = 0;
 
 protected:
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/QuickSort.h>
+#include <LibGfx/Matrix4x4.h>
 #include <LibWeb/Painting/DisplayList.h>
 
 namespace Web::Painting {
@@ -11,6 +13,7 @@ namespace Web::Painting {
 void DisplayList::append(Command&& command, Optional<i32> scroll_frame_id)
 {
     m_commands.append({ scroll_frame_id, move(command) });
+    m_culling_index = nullptr;
 }
 
 static Optional<Gfx::IntRect> command_bounding_rectangle(Command const& command)
@@ -24,16 +27,137 @@ static Optional<Gfx::IntRect> command_bounding_rectangle(Command const& command)
         });
 }
 
-void DisplayListPlayer::execute(DisplayList& display_list)
+static int band_containing(int y, int band_height)
+{
+    auto band = y / band_height;
+    if (y < 0 && y % band_height != 0)
+        --band;
+    return band;
+}
+
+DisplayList::CullingIndex const& DisplayList::culling_index() const
+{
+    if (m_culling_index)
+        return *m_culling_index;
+    m_culling_index = make<CullingIndex>();
+    auto& culling_index = *m_culling_index;
+
+    // NOTE: For every save, whether the commands after it are painted in transformed coordinates.
+    Vector<bool, 64> is_transformed_stack { false };
+    bool saves_and_restores_are_unbalanced = false;
+
+    for (size_t index = 0; index < m_commands.size(); ++index) {
+        auto const& [scroll_frame_id, command] = m_commands[index];
+
+        command.visit(
+            [&](Save const&) { is_transformed_stack.append(is_transformed_stack.last()); },
+            [&](PushStackingContext const& command) {
+                auto is_transformed = !Gfx::extract_2d_affine_transform(command.transform.matrix).is_identity();
+                is_transformed_stack.append(is_transformed_stack.last() || is_transformed);
+            },
+            [&](Restore const&) {
+                if (is_transformed_stack.size() > 1)
+                    is_transformed_stack.take_last();
+                else
+                    saves_and_restores_are_unbalanced = true;
+            },
+            [&](PopStackingContext const&) {
+                if (is_transformed_stack.size() > 1)
+                    is_transformed_stack.take_last();
+                else
+                    saves_and_restores_are_unbalanced = true;
+            },
+            [&](Translate const&) { is_transformed_stack.last() = true; },
+            [&](ApplyTransform const&) { is_transformed_stack.last() = true; },
+            [&](auto const&) {});
+
+        auto bounding_rect = command_bounding_rectangle(command);
+        if (bounding_rect.has_value() && bounding_rect->is_empty())
+            continue;
+
+        // NOTE: Skipping a clip or a mask would mean painting more than we should, so we only leave that to the painter.
+        //       Scrollbars are moved by the offset of the frame they belong to, which isn't known until they're painted.
+        auto can_be_culled = bounding_rect.has_value()
+            && !command.has<AddRoundedRectClip>()
+            && !command.has<AddMask>()
+            && !command.has<PaintScrollBar>()
+            && !is_transformed_stack.last()
+            && !saves_and_restores_are_unbalanced;
+        if (!can_be_culled) {
+            culling_index.commands_that_are_always_executed.append(index);
+            continue;
+        }
+
+        auto first_band = band_containing(bounding_rect->top(), CullingIndex::band_height);
+        auto last_band = band_containing(bounding_rect->bottom() - 1, CullingIndex::band_height);
+        if (last_band - first_band >= CullingIndex::max_bands_per_command) {
+            culling_index.commands_that_are_always_executed.append(index);
+            continue;
+        }
+
+        auto& bands = culling_index.bands_by_scroll_frame.ensure(scroll_frame_id.value_or(-1));
+        for (auto band = first_band; band <= last_band; ++band)
+            bands.ensure(band).append({ index, *bounding_rect });
+    }
+
+    return culling_index;
+}
+
+Vector<size_t> DisplayList::indices_of_commands_to_execute_within(Gfx::IntRect const& rect) const
+{
+    auto const& culling_index = this->culling_index();
+
+    Vector<size_t> indices;
+    indices.extend(culling_index.commands_that_are_always_executed);
+    for (auto const& [scroll_frame_id, bands] : culling_index.bands_by_scroll_frame) {
+        auto rect_in_scroll_frame = rect;
+        if (scroll_frame_id >= 0) {
+            auto cumulative_offset = m_scroll_state.cumulative_offset_for_frame_with_id(scroll_frame_id);
+            rect_in_scroll_frame.translate_by(-cumulative_offset.to_type<double>().scaled(m_device_pixels_per_css_pixel).to_type<int>());
+        }
+
+        auto last_band = band_containing(rect_in_scroll_frame.bottom() - 1, CullingIndex::band_height);
+        for (auto band = band_containing(rect_in_scroll_frame.top(), CullingIndex::band_height); band <= last_band; ++band) {
+            auto commands = bands.get(band);
+            if (!commands.has_value())
+                continue;
+            for (auto const& command : *commands) {
+                if (command.rect.intersects(rect_in_scroll_frame))
+                    indices.append(command.index);
+            }
+        }
+    }
+    quick_sort(indices);
+
+    // NOTE: Commands that cover several bands were found once per band.
+    Vector<size_t> unique_indices;
+    unique_indices.ensure_capacity(indices.size());
+    for (auto index : indices) {
+        if (unique_indices.is_empty() || unique_indices.last() != index)
+            unique_indices.unchecked_append(index);
+    }
+    return unique_indices;
+}
+
+void DisplayListPlayer::execute(DisplayList& display_list, Optional<Gfx::IntRect> rect_to_repaint)
 {
     auto const& commands = display_list.commands();
     auto const& scroll_state = display_list.scroll_state();
     auto device_pixels_per_css_pixel = display_list.device_pixels_per_css_pixel();
 
-    size_t next_command_index = 0;
-    while (next_command_index < commands.size()) {
-        auto scroll_frame_id = commands[next_command_index].scroll_frame_id;
-        auto command = commands[next_command_index++].command;
+    if (m_trace)
+        m_trace->did_begin_replay();
+
+    // NOTE: Clipping to the rect to repaint makes would_be_fully_clipped_by_painter() reject every command outside of it.
+    if (rect_to_repaint.has_value()) {
+        save({});
+        add_clip_rect({ *rect_to_repaint });
+    }
+
+    auto const command_indices = display_list.indices_of_commands_to_execute_within(local_clip_bounds());
+    for (auto command_index : command_indices) {
+        auto scroll_frame_id = commands[command_index].scroll_frame_id;
+        auto command = commands[command_index].command;
 
         if (command.has<PaintScrollBar>()) {
             auto& paint_scroll_bar = command.get<PaintScrollBar>();
@@ -63,8 +187,21 @@ void DisplayListPlayer::execute(DisplayList& display_list)
             continue;
         }
 
+        Optional<MonotonicTime> command_start_time;
+        if (m_trace) {
+            command_start_time = MonotonicTime::now();
+            if (command.has<PushStackingContext>()) {
+                m_trace->did_push_stacking_context();
+                if (command.get<PushStackingContext>().clip_path.has_value())
+                    m_trace->did_add_clip();
+            } else if (command.has<AddClipRect>() || command.has<AddRoundedRectClip>() || command.has<AddMask>())
+                m_trace->did_add_clip();
+        }
+        StringView command_name;
+
 #define HANDLE_COMMAND(command_type, executor_method) \
     if (command.has<command_type>()) {                \
+        command_name = #command_type##sv;             \
         executor_method(command.get<command_type>()); \
     }
 
@@ -106,7 +243,19 @@ void DisplayListPlayer::execute(DisplayList& display_list)
         else HANDLE_COMMAND(ApplyMaskBitmap, apply_mask_bitmap)
         else VERIFY_NOT_REACHED();
         // clang-format on
+
+        if (m_trace) {
+            m_trace->did_execute_command(command_name, *command_start_time);
+            if (command.has<PopStackingContext>())
+                m_trace->did_pop_stacking_context();
+        }
     }
+
+    if (rect_to_repaint.has_value())
+        restore({});
+
+    if (m_trace)
+        m_trace->did_end_replay();
 }
 
 }
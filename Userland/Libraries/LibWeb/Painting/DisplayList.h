@@ -7,7 +7,9 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/SegmentedVector.h>
 #include <AK/Utf8View.h>
 #include <AK/Vector.h>
@@ -27,6 +29,7 @@
 #include <LibWeb/Painting/BorderRadiiData.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
 #include <LibWeb/Painting/Command.h>
+#include <LibWeb/Painting/DisplayListTrace.h>
 #include <LibWeb/Painting/GradientData.h>
 #include <LibWeb/Painting/PaintBoxShadowParams.h>
 #include <LibWeb/Painting/ScrollFrame.h>
@@ -40,7 +43,13 @@ class DisplayListPlayer {
 public:
     virtual ~DisplayListPlayer() = default;
 
-    void execute(DisplayList& display_list);
+    // If a rect to repaint is given, everything outside of it is left untouched, and commands that can't affect it are skipped.
+    void execute(DisplayList& display_list, Optional<Gfx::IntRect> rect_to_repaint = {});
+
+    void set_trace(DisplayListTrace* trace) { m_trace = trace; }
+
+protected:
+    DisplayListTrace* trace() const { return m_trace; }
 
 private:
     virtual void draw_glyph_run(DrawGlyphRun const&) = 0;
@@ -79,6 +88,17 @@ private:
     virtual void apply_transform(ApplyTransform const&) = 0;
     virtual void apply_mask_bitmap(ApplyMaskBitmap const&) = 0;
     virtual bool would_be_fully_clipped_by_painter(Gfx::IntRect) const = 0;
+    // The bounds of what can still be painted, in the coordinates the next command would be painted in.
+    virtual Gfx::IntRect local_clip_bounds() const = 0;
+
+    DisplayListTrace* m_trace { nullptr };
+};
+
+// Something a display list player made out of a display list painted as a layer, kept around so that painting the same
+// display list again can reuse it instead of replaying every command.
+class RasterizedLayer : public RefCounted<RasterizedLayer> {
+public:
+    virtual ~RasterizedLayer() = default;
 };
 
 class DisplayList : public RefCounted<DisplayList> {
@@ -97,18 +117,47 @@ public:
 
     AK::SegmentedVector<CommandListItem, 512> const& commands() const { return m_commands; }
 
+    // Returns the indices of the commands that have to be executed to paint everything within the given rect, in order.
+    Vector<size_t> indices_of_commands_to_execute_within(Gfx::IntRect const&) const;
+
     void set_scroll_state(ScrollState scroll_state) { m_scroll_state = move(scroll_state); }
     ScrollState const& scroll_state() const { return m_scroll_state; }
 
     void set_device_pixels_per_css_pixel(double device_pixels_per_css_pixel) { m_device_pixels_per_css_pixel = device_pixels_per_css_pixel; }
     double device_pixels_per_css_pixel() const { return m_device_pixels_per_css_pixel; }
 
+    // NOTE: Whoever recorded this display list has to clear the rasterized layer when what it paints changes without the
+    //       display list being recorded again, like when the painted canvas bitmaps change or a scroll frame is scrolled.
+    RefPtr<RasterizedLayer> const& rasterized_layer() const { return m_rasterized_layer; }
+    void set_rasterized_layer(RefPtr<RasterizedLayer> rasterized_layer) { m_rasterized_layer = move(rasterized_layer); }
+
 private:
     DisplayList() = default;
 
+    // Buckets the commands that are painted where they were recorded (give or take the offset of their scroll frame) into
+    // horizontal bands, so that replaying a display list only has to look at the commands in the bands it can paint into.
+    struct CullingIndex {
+        static constexpr int band_height = 512;
+        // Commands covering more bands than this are treated as if they couldn't be culled.
+        static constexpr int max_bands_per_command = 32;
+
+        struct IndexedCommand {
+            size_t index;
+            Gfx::IntRect rect;
+        };
+
+        // Keyed by scroll frame ID, or -1 for commands outside of any scroll frame, then by band.
+        HashMap<i32, HashMap<int, Vector<IndexedCommand>>> bands_by_scroll_frame;
+        // State changes, like saves and clips, and drawing commands that something like a transform applies to.
+        Vector<size_t> commands_that_are_always_executed;
+    };
+    CullingIndex const& culling_index() const;
+
     AK::SegmentedVector<CommandListItem, 512> m_commands;
+    mutable OwnPtr<CullingIndex> m_culling_index;
     ScrollState m_scroll_state;
     double m_device_pixels_per_css_pixel;
+    RefPtr<RasterizedLayer> m_rasterized_layer;
 };
 
 }
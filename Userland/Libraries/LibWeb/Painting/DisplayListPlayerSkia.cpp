@@ -21,6 +21,7 @@
 #include <effects/SkImageFilters.h>
 #include <effects/SkRuntimeEffect.h>
 #include <gpu/GrDirectContext.h>
+#include <gpu/ganesh/SkImageGanesh.h>
 #include <gpu/ganesh/SkSurfaceGanesh.h>
 #include <pathops/SkPathOps.h>
 
@@ -90,10 +91,19 @@ public:
         m_context->submit(GrSyncCpu::kYes);
     }
 
-    sk_sp<SkSurface> create_surface(int width, int height)
+    GrDirectContext* sk_context() const override { return m_context.get(); }
+
+    // NOTE: Every frame is painted in full and then read back, so the same render target can be used for every frame of
+    //       the same size instead of allocating a new one on the GPU each time.
+    sk_sp<SkSurface> surface_for_frame(int width, int height)
     {
+        if (m_surface && m_surface->width() == width && m_surface->height() == height) {
+            m_surface->getCanvas()->restoreToCount(1);
+            return m_surface;
+        }
         auto image_info = SkImageInfo::Make(width, height, kBGRA_8888_SkColorType, kPremul_SkAlphaType);
-        return SkSurfaces::RenderTarget(m_context.get(), skgpu::Budgeted::kYes, image_info);
+        m_surface = SkSurfaces::RenderTarget(m_context.get(), skgpu::Budgeted::kYes, image_info);
+        return m_surface;
     }
 
     skgpu::VulkanExtensions const* extensions() const { return m_extensions.ptr(); }
@@ -101,6 +111,7 @@ public:
 private:
     sk_sp<GrDirectContext> m_context;
     NonnullOwnPtr<skgpu::VulkanExtensions> m_extensions;
+    sk_sp<SkSurface> m_surface;
 };
 
 OwnPtr<SkiaBackendContext> DisplayListPlayerSkia::create_vulkan_context(Core::VulkanContext& vulkan_context)
@@ -130,7 +141,7 @@ OwnPtr<SkiaBackendContext> DisplayListPlayerSkia::create_vulkan_context(Core::Vu
 DisplayListPlayerSkia::DisplayListPlayerSkia(SkiaBackendContext& context, Gfx::Bitmap& bitmap)
 {
     VERIFY(bitmap.format() == Gfx::BitmapFormat::BGRA8888);
-    auto surface = static_cast<SkiaVulkanBackendContext&>(context).create_surface(bitmap.width(), bitmap.height());
+    auto surface = static_cast<SkiaVulkanBackendContext&>(context).surface_for_frame(bitmap.width(), bitmap.height());
     m_surface = make<SkiaSurface>(surface);
     m_flush_context = [&bitmap, &surface = m_surface, &context] {
         context.flush_and_submit();
@@ -166,6 +177,8 @@ public:
         m_context->submit(GrSyncCpu::kYes);
     }
 
+    GrDirectContext* sk_context() const override { return m_context.get(); }
+
 private:
     sk_sp<GrDirectContext> m_context;
 };
@@ -375,21 +388,55 @@ void DisplayListPlayerSkia::draw_scaled_bitmap(DrawScaledBitmap const& command)
     canvas.drawImageRect(image, src_rect, dst_rect, to_skia_sampling_options(command.scaling_mode), &paint, SkCanvas::kStrict_SrcRectConstraint);
 }
 
+class SkiaPreparedImmutableBitmap final : public Gfx::PreparedImmutableBitmap {
+public:
+    SkiaPreparedImmutableBitmap(sk_sp<SkImage> image, GrRecordingContext* recording_context)
+        : m_image(move(image))
+        , m_recording_context(recording_context)
+    {
+    }
+
+    sk_sp<SkImage> const& image() const { return m_image; }
+    GrRecordingContext* recording_context() const { return m_recording_context; }
+
+private:
+    sk_sp<SkImage> m_image;
+    GrRecordingContext* m_recording_context { nullptr };
+};
+
+static sk_sp<SkImage> prepared_skia_image(Gfx::ImmutableBitmap const& bitmap, SkCanvas& canvas)
+{
+    // NOTE: Every SkImage made from our pixels gets an ID of its own, and Skia caches what it derives from an image (like
+    //       a texture that it uploaded the pixels into) by that ID. Keeping the image around for as long as the bitmap
+    //       means that happens once per bitmap instead of once per frame.
+    auto* recording_context = canvas.recordingContext();
+    if (auto const* prepared_bitmap = static_cast<SkiaPreparedImmutableBitmap const*>(bitmap.prepared_bitmap().ptr())) {
+        if (prepared_bitmap->recording_context() == recording_context)
+            return prepared_bitmap->image();
+    }
+
+    auto image = SkImages::RasterFromBitmap(to_skia_bitmap(bitmap.bitmap()));
+    if (auto* direct_context = recording_context ? recording_context->asDirectContext() : nullptr) {
+        if (auto texture_image = SkImages::TextureFromImage(direct_context, image.get(), skgpu::Mipmapped::kNo, skgpu::Budgeted::kYes))
+            image = move(texture_image);
+    }
+    bitmap.set_prepared_bitmap(adopt_ref(*new SkiaPreparedImmutableBitmap(image, recording_context)));
+    return image;
+}
+
 void DisplayListPlayerSkia::draw_scaled_immutable_bitmap(DrawScaledImmutableBitmap const& command)
 {
     auto src_rect = to_skia_rect(command.src_rect);
     auto dst_rect = to_skia_rect(command.dst_rect);
-    auto bitmap = to_skia_bitmap(command.bitmap->bitmap());
-    auto image = SkImages::RasterFromBitmap(bitmap);
     auto& canvas = surface().canvas();
+    auto image = prepared_skia_image(*command.bitmap, canvas);
     SkPaint paint;
     canvas.drawImageRect(image, src_rect, dst_rect, to_skia_sampling_options(command.scaling_mode), &paint, SkCanvas::kStrict_SrcRectConstraint);
 }
 
 void DisplayListPlayerSkia::draw_repeated_immutable_bitmap(DrawRepeatedImmutableBitmap const& command)
 {
-    auto bitmap = to_skia_bitmap(command.bitmap->bitmap());
-    auto image = SkImages::RasterFromBitmap(bitmap);
+    auto image = prepared_skia_image(*command.bitmap, surface().canvas());
 
     SkMatrix matrix;
     auto dst_rect = command.dst_rect.to_type<float>();
@@ -448,6 +495,8 @@ void DisplayListPlayerSkia::push_stacking_context(PushStackingContext const& com
         auto source_paintable_rect = to_skia_rect(command.source_paintable_rect);
         SkRect dest;
         matrix.mapRect(&dest, source_paintable_rect);
+        if (auto* trace = this->trace())
+            trace->did_save_layer();
         canvas.saveLayerAlphaf(&dest, command.opacity);
     } else {
         canvas.save();
@@ -625,6 +674,84 @@ static void add_spread_distance_to_border_radius(int& border_radius, int spread_
     }
 }
 
+// A blurred rounded rect only varies near its corners, so it's enough to blur the smallest rounded rect with the same corners
+// once, and to stretch the middle of that to the size of every shadow that's painted afterwards.
+struct BlurredShadowMaskKey {
+    CornerRadii corner_radii;
+    int blur_radius { 0 };
+
+    bool operator==(BlurredShadowMaskKey const& other) const
+    {
+        auto radius_equals = [](CornerRadius const& a, CornerRadius const& b) {
+            return a.horizontal_radius == b.horizontal_radius && a.vertical_radius == b.vertical_radius;
+        };
+        return radius_equals(corner_radii.top_left, other.corner_radii.top_left)
+            && radius_equals(corner_radii.top_right, other.corner_radii.top_right)
+            && radius_equals(corner_radii.bottom_right, other.corner_radii.bottom_right)
+            && radius_equals(corner_radii.bottom_left, other.corner_radii.bottom_left)
+            && blur_radius == other.blur_radius;
+    }
+};
+
+struct BlurredShadowMaskKeyTraits : public DefaultTraits<BlurredShadowMaskKey> {
+    static unsigned hash(BlurredShadowMaskKey const& key)
+    {
+        auto hash = int_hash(key.blur_radius);
+        for (auto const& radius : { key.corner_radii.top_left, key.corner_radii.top_right, key.corner_radii.bottom_right, key.corner_radii.bottom_left })
+            hash = pair_int_hash(hash, pair_int_hash(radius.horizontal_radius, radius.vertical_radius));
+        return hash;
+    }
+};
+
+struct BlurredShadowMask {
+    sk_sp<SkImage> image;
+    // The size of the rounded rect that was blurred, and the part of the image that can be stretched to make it bigger.
+    Gfx::IntSize shape_size;
+    Gfx::IntRect stretchable_rect;
+};
+
+static Optional<BlurredShadowMask const&> blurred_shadow_mask(CornerRadii const& corner_radii, int blur_radius, Gfx::IntSize shadow_size)
+{
+    static HashMap<BlurredShadowMaskKey, BlurredShadowMask, BlurredShadowMaskKeyTraits> s_masks;
+
+    BlurredShadowMaskKey key { corner_radii, blur_radius };
+    if (auto it = s_masks.find(key); it != s_masks.end()) {
+        if (shadow_size.width() < it->value.shape_size.width() || shadow_size.height() < it->value.shape_size.height())
+            return {};
+        return it->value;
+    }
+
+    // NOTE: A blur doesn't reach further than three times its sigma (plus a pixel for rounding).
+    auto sigma = blur_radius / 2;
+    auto blur_extent = 3 * sigma + 1;
+    auto left = max(corner_radii.top_left.horizontal_radius, corner_radii.bottom_left.horizontal_radius) + blur_extent;
+    auto right = max(corner_radii.top_right.horizontal_radius, corner_radii.bottom_right.horizontal_radius) + blur_extent;
+    auto top = max(corner_radii.top_left.vertical_radius, corner_radii.top_right.vertical_radius) + blur_extent;
+    auto bottom = max(corner_radii.bottom_left.vertical_radius, corner_radii.bottom_right.vertical_radius) + blur_extent;
+    Gfx::IntSize shape_size { left + right + 1, top + bottom + 1 };
+    if (shadow_size.width() < shape_size.width() || shadow_size.height() < shape_size.height())
+        return {};
+
+    auto surface = SkSurfaces::Raster(SkImageInfo::MakeA8(shape_size.width() + 2 * blur_extent, shape_size.height() + 2 * blur_extent));
+    if (!surface)
+        return {};
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, sigma));
+    surface->getCanvas()->drawRRect(to_skia_rrect(Gfx::IntRect { { blur_extent, blur_extent }, shape_size }, corner_radii), paint);
+
+    constexpr size_t max_cached_mask_count = 128;
+    if (s_masks.size() > max_cached_mask_count)
+        s_masks.remove(s_masks.begin());
+
+    BlurredShadowMask mask {
+        .image = surface->makeImageSnapshot(),
+        .shape_size = shape_size,
+        .stretchable_rect = { blur_extent + left, blur_extent + top, 1, 1 },
+    };
+    return s_masks.ensure(key, [&] { return move(mask); });
+}
+
 void DisplayListPlayerSkia::paint_outer_box_shadow(PaintOuterBoxShadow const& command)
 {
     auto const& outer_box_shadow_params = command.box_shadow_params;
@@ -657,6 +784,16 @@ void DisplayListPlayerSkia::paint_outer_box_shadow(PaintOuterBoxShadow const& co
     SkPaint paint;
     paint.setAntiAlias(true);
     paint.setColor(to_skia_color(color));
+    if (auto mask = blurred_shadow_mask(corner_radii, blur_radius, shadow_rect.size()); mask.has_value()) {
+        // NOTE: The mask is an alpha-only image, so it's painted in the color of the paint.
+        auto blur_extent = (mask->image->width() - mask->shape_size.width()) / 2;
+        auto destination_rect = shadow_rect.inflated(blur_extent * 2, blur_extent * 2);
+        auto const& stretchable_rect = mask->stretchable_rect;
+        auto center = SkIRect::MakeXYWH(stretchable_rect.x(), stretchable_rect.y(), stretchable_rect.width(), stretchable_rect.height());
+        canvas.drawImageNine(mask->image.get(), center, to_skia_rect(destination_rect), SkFilterMode::kNearest, &paint);
+        canvas.restore();
+        return;
+    }
     paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, blur_radius / 2));
     auto shadow_rounded_rect = to_skia_rrect(shadow_rect, corner_radii);
     canvas.drawRRect(shadow_rounded_rect, paint);
@@ -724,6 +861,8 @@ void DisplayListPlayerSkia::paint_text_shadow(PaintTextShadow const& command)
     auto blur_image_filter = SkImageFilters::Blur(command.blur_radius / 2, command.blur_radius / 2, nullptr);
     SkPaint blur_paint;
     blur_paint.setImageFilter(blur_image_filter);
+    if (auto* trace = this->trace())
+        trace->did_save_layer();
     canvas.saveLayer(SkCanvas::SaveLayerRec(nullptr, &blur_paint, nullptr, 0));
     draw_glyph_run({
         .glyph_run = command.glyph_run,
@@ -966,6 +1105,8 @@ void DisplayListPlayerSkia::apply_backdrop_filter(ApplyBackdropFilter const& com
         filter_function.visit(
             [&](CSS::ResolvedBackdropFilter::Blur const& blur_filter) {
                 auto blur_image_filter = SkImageFilters::Blur(blur_filter.radius, blur_filter.radius, nullptr);
+                if (auto* trace = this->trace())
+                    trace->did_save_layer();
                 canvas.saveLayer(SkCanvas::SaveLayerRec(nullptr, nullptr, blur_image_filter.get(), 0));
                 canvas.restore();
             },
@@ -1051,6 +1192,8 @@ void DisplayListPlayerSkia::apply_backdrop_filter(ApplyBackdropFilter const& com
                 }
 
                 auto image_filter = SkImageFilters::ColorFilter(color_filter, nullptr);
+                if (auto* trace = this->trace())
+                    trace->did_save_layer();
                 canvas.saveLayer(SkCanvas::SaveLayerRec(nullptr, nullptr, image_filter.get(), 0));
                 canvas.restore();
             },
@@ -1079,6 +1222,8 @@ void DisplayListPlayerSkia::apply_backdrop_filter(ApplyBackdropFilter const& com
 
                 auto color_filter = SkColorFilters::Matrix(matrix);
                 auto image_filter = SkImageFilters::ColorFilter(color_filter, nullptr);
+                if (auto* trace = this->trace())
+                    trace->did_save_layer();
                 canvas.saveLayer(SkCanvas::SaveLayerRec(nullptr, nullptr, image_filter.get(), 0));
                 canvas.restore();
             },
@@ -1219,11 +1364,63 @@ void DisplayListPlayerSkia::add_mask(AddMask const& command)
     surface().canvas().clipShader(shader);
 }
 
+class SkiaRasterizedLayer final : public RasterizedLayer {
+public:
+    SkiaRasterizedLayer(sk_sp<SkImage> image, GrRecordingContext* recording_context)
+        : m_image(move(image))
+        , m_recording_context(recording_context)
+    {
+    }
+
+    sk_sp<SkImage> const& image() const { return m_image; }
+    GrRecordingContext* recording_context() const { return m_recording_context; }
+
+private:
+    sk_sp<SkImage> m_image;
+    GrRecordingContext* m_recording_context { nullptr };
+};
+
 void DisplayListPlayerSkia::paint_nested_display_list(PaintNestedDisplayList const& command)
 {
     auto& canvas = surface().canvas();
     canvas.translate(command.rect.x(), command.rect.y());
-    execute(*command.display_list);
+
+    // NOTE: Nested display lists are painted as layers: the first time we paint one, we rasterize it into an image of
+    //       its own that later frames can composite again, for as long as the same display list keeps getting painted.
+    //       Drawing that image is only pixel-exact while the canvas is merely translated by whole pixels, though, so
+    //       under any other transform we replay the display list instead.
+    // FIXME: Promote stacking contexts with transforms, opacity or fixed positioning to layers too. That needs their
+    //        contents to be recorded into display lists that survive changes elsewhere in the document, while any
+    //        change to a document currently invalidates its whole display list.
+    auto const& matrix = canvas.getTotalMatrix();
+    auto rect = command.rect;
+    if (rect.is_empty() || !matrix.isTranslate() || !SkScalarIsInt(matrix.getTranslateX()) || !SkScalarIsInt(matrix.getTranslateY())) {
+        execute(*command.display_list);
+        return;
+    }
+
+    auto& display_list = *command.display_list;
+    if (auto const* layer = static_cast<SkiaRasterizedLayer const*>(display_list.rasterized_layer().ptr())) {
+        if (layer->recording_context() == canvas.recordingContext() && layer->image()->width() == rect.width() && layer->image()->height() == rect.height()) {
+            canvas.drawImage(layer->image(), 0, 0);
+            return;
+        }
+    }
+
+    auto layer_surface = m_surface->make_surface(rect.width(), rect.height());
+    if (!layer_surface) {
+        execute(display_list);
+        return;
+    }
+
+    auto previous_surface = move(m_surface);
+    m_surface = make<SkiaSurface>(layer_surface);
+    execute(display_list);
+    m_surface = move(previous_surface);
+
+    auto image = layer_surface->makeImageSnapshot();
+    display_list.set_rasterized_layer(adopt_ref(*new SkiaRasterizedLayer(image, surface().canvas().recordingContext())));
+    surface().canvas().drawImage(image, 0, 0);
 }
 
 void DisplayListPlayerSkia::paint_scrollbar(PaintScrollBar const& command)
@@ -1252,6 +1449,8 @@ void DisplayListPlayerSkia::apply_opacity(ApplyOpacity const& command)
     auto& canvas = surface().canvas();
     SkPaint paint;
     paint.setAlphaf(command.opacity);
+    if (auto* trace = this->trace())
+        trace->did_save_layer();
     canvas.saveLayer(nullptr, &paint);
 }
 
@@ -1315,4 +1514,10 @@ bool DisplayListPlayerSkia::would_be_fully_clipped_by_painter(Gfx::IntRect rect)
     return surface().canvas().quickReject(to_skia_rect(rect));
 }
 
+Gfx::IntRect DisplayListPlayerSkia::local_clip_bounds() const
+{
+    auto bounds = surface().canvas().getLocalClipBounds().roundOut();
+    return { bounds.x(), bounds.y(), bounds.width(), bounds.height() };
+}
+
 }
@@ -18,6 +18,8 @@
 #    include <LibCore/VulkanContext.h>
 #endif
 
+class GrDirectContext;
+
 namespace Web::Painting {
 
 class SkiaBackendContext {
@@ -29,6 +31,7 @@ public:
     virtual ~SkiaBackendContext() {};
 
     virtual void flush_and_submit() {};
+    virtual GrDirectContext* sk_context() const = 0;
 };
 
 class DisplayListPlayerSkia : public DisplayListPlayer {
@@ -85,6 +88,7 @@ private:
     void apply_mask_bitmap(ApplyMaskBitmap const&) override;
 
     bool would_be_fully_clipped_by_painter(Gfx::IntRect) const override;
+    Gfx::IntRect local_clip_bounds() const override;
 
     class SkiaSurface;
     SkiaSurface& surface() const;
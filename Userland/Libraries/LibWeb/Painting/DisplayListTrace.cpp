@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArraySerializer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/StringBuilder.h>
+#include <LibWeb/Painting/DisplayListTrace.h>
+
+namespace Web::Painting {
+
+bool g_enable_paint_tracing = false;
+
+i64 DisplayListTrace::microseconds_since_start(MonotonicTime time) const
+{
+    return (time - m_start_time).to_microseconds();
+}
+
+void DisplayListTrace::append_event(Event event)
+{
+    if (m_events.size() >= max_event_count) {
+        ++m_dropped_event_count;
+        return;
+    }
+    m_events.append(event);
+}
+
+void DisplayListTrace::did_begin_replay()
+{
+    // NOTE: Nested display lists are replayed by the same player, in the middle of the replay of their parent.
+    if (m_replay_depth++ > 0)
+        return;
+    m_replay_start_time = MonotonicTime::now();
+    m_stacking_context_start_times.clear();
+    m_time_spent_per_command.clear();
+    m_executions_per_command.clear();
+    m_save_layers = 0;
+    m_clips = 0;
+}
+
+void DisplayListTrace::did_end_replay()
+{
+    VERIFY(m_replay_depth > 0);
+    if (--m_replay_depth > 0)
+        return;
+
+    JsonObject time_spent_per_command;
+    for (auto const& [name, time] : m_time_spent_per_command)
+        time_spent_per_command.set(name, time.to_microseconds());
+    JsonObject executions_per_command;
+    for (auto const& [name, count] : m_executions_per_command)
+        executions_per_command.set(name, count);
+
+    Replay replay {
+        .start_time_in_microseconds = microseconds_since_start(m_replay_start_time),
+        .duration_in_microseconds = (MonotonicTime::now() - m_replay_start_time).to_microseconds(),
+        .summary = {},
+    };
+    replay.summary.set("timePerCommand"sv, move(time_spent_per_command));
+    replay.summary.set("executionsPerCommand"sv, move(executions_per_command));
+    replay.summary.set("saveLayers"sv, m_save_layers);
+    replay.summary.set("clips"sv, m_clips);
+    m_replays.append(move(replay));
+}
+
+void DisplayListTrace::did_execute_command(StringView command_name, MonotonicTime start_time)
+{
+    auto duration = MonotonicTime::now() - start_time;
+    m_time_spent_per_command.ensure(command_name) += duration;
+    ++m_executions_per_command.ensure(command_name);
+    append_event({
+        .name = command_name,
+        .category = "command"sv,
+        .start_time_in_microseconds = microseconds_since_start(start_time),
+        .duration_in_microseconds = duration.to_microseconds(),
+    });
+}
+
+void DisplayListTrace::did_push_stacking_context()
+{
+    m_stacking_context_start_times.append(MonotonicTime::now());
+}
+
+void DisplayListTrace::did_pop_stacking_context()
+{
+    if (m_stacking_context_start_times.is_empty())
+        return;
+    auto start_time = m_stacking_context_start_times.take_last();
+    append_event({
+        .name = "Stacking context"sv,
+        .category = "stacking-context"sv,
+        .start_time_in_microseconds = microseconds_since_start(start_time),
+        .duration_in_microseconds = (MonotonicTime::now() - start_time).to_microseconds(),
+    });
+}
+
+String DisplayListTrace::to_chrome_trace_json() const
+{
+    StringBuilder builder;
+    auto trace = MUST(JsonObjectSerializer<>::try_create(builder));
+    auto events = MUST(trace.add_array("traceEvents"sv));
+
+    auto add_event = [&](StringView name, StringView category, i64 start_time, i64 duration) {
+        auto event = MUST(events.add_object());
+        MUST(event.add("name"sv, name));
+        MUST(event.add("cat"sv, category));
+        MUST(event.add("ph"sv, "X"sv));
+        MUST(event.add("ts"sv, start_time));
+        MUST(event.add("dur"sv, duration));
+        MUST(event.add("pid"sv, 1));
+        MUST(event.add("tid"sv, 1));
+        return event;
+    };
+
+    for (auto const& replay : m_replays) {
+        auto event = add_event("Replay display list"sv, "replay"sv, replay.start_time_in_microseconds, replay.duration_in_microseconds);
+        MUST(event.add("args"sv, replay.summary));
+        MUST(event.finish());
+    }
+    for (auto const& event : m_events)
+        MUST(add_event(event.name, event.category, event.start_time_in_microseconds, event.duration_in_microseconds).finish());
+
+    MUST(events.finish());
+    MUST(trace.add("displayTimeUnit"sv, "ms"sv));
+    if (m_dropped_event_count > 0)
+        MUST(trace.add("droppedEvents"sv, m_dropped_event_count));
+    MUST(trace.finish());
+    return MUST(builder.to_string());
+}
+
+}
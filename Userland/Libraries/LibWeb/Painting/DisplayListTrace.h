@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/JsonObject.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+
+namespace Web::Painting {
+
+extern bool g_enable_paint_tracing;
+
+// Records how long a display list player spent on every command it executed and on every stacking context it painted,
+// so that the replay of a frame can be looked at in a trace viewer that understands Chrome's trace event format.
+class DisplayListTrace {
+public:
+    void did_begin_replay();
+    void did_end_replay();
+
+    void did_execute_command(StringView command_name, MonotonicTime start_time);
+    void did_push_stacking_context();
+    void did_pop_stacking_context();
+    void did_save_layer() { ++m_save_layers; }
+    void did_add_clip() { ++m_clips; }
+
+    // Serializes everything recorded so far as a JSON object in Chrome's trace event format, with times in microseconds.
+    String to_chrome_trace_json() const;
+
+private:
+    // NOTE: Tracing a long session shouldn't eat all of our memory, so we stop recording events after this many.
+    static constexpr size_t max_event_count = 500'000;
+
+    struct Event {
+        StringView name;
+        StringView category;
+        i64 start_time_in_microseconds { 0 };
+        i64 duration_in_microseconds { 0 };
+    };
+
+    // A replay, along with what the trace viewer should show as its arguments.
+    struct Replay {
+        i64 start_time_in_microseconds { 0 };
+        i64 duration_in_microseconds { 0 };
+        JsonObject summary;
+    };
+
+    i64 microseconds_since_start(MonotonicTime) const;
+    void append_event(Event);
+
+    MonotonicTime m_start_time { MonotonicTime::now() };
+    Vector<Event> m_events;
+    Vector<Replay> m_replays;
+    size_t m_dropped_event_count { 0 };
+
+    // Everything below only covers the replay that is currently in progress.
+    size_t m_replay_depth { 0 };
+    MonotonicTime m_replay_start_time { MonotonicTime::now() };
+    Vector<MonotonicTime> m_stacking_context_start_times;
+    OrderedHashMap<StringView, AK::Duration> m_time_spent_per_command;
+    OrderedHashMap<StringView, u64> m_executions_per_command;
+    u64 m_save_layers { 0 };
+    u64 m_clips { 0 };
+};
+
+}
@@ -151,19 +151,40 @@ void Paintable::invalidate_stacking_context()
 void Paintable::set_needs_display(InvalidateDisplayList should_invalidate_display_list)
 {
     auto& document = const_cast<DOM::Document&>(this->document());
-    if (should_invalidate_display_list == InvalidateDisplayList::Yes)
-        document.invalidate_display_list();
 
     auto* containing_block = this->containing_block();
-    if (!containing_block)
+    if (!containing_block || !is<Painting::PaintableWithLines>(*containing_block) || !is_painted_at_its_absolute_rects()) {
+        document.set_needs_display(should_invalidate_display_list);
         return;
+    }
 
-    if (!is<Painting::PaintableWithLines>(*containing_block))
-        return;
+    CSSPixelRect damaged_rect;
     static_cast<Painting::PaintableWithLines const&>(*containing_block).for_each_fragment([&](auto& fragment) {
-        document.set_needs_display(fragment.absolute_rect(), InvalidateDisplayList::No);
+        damaged_rect = damaged_rect.united(fragment.absolute_rect());
         return IterationDecision::Continue;
     });
+    document.set_needs_display(damaged_rect, should_invalidate_display_list);
+}
+
+bool Paintable::is_painted_at_its_absolute_rects() const
+{
+    for (auto const* paintable = this; paintable; paintable = paintable->parent()) {
+        if (paintable->is_fixed_position() || paintable->is_sticky_position() || paintable->is_svg_paintable())
+            return false;
+        if (!paintable->is_paintable_box())
+            continue;
+        auto const& paintable_box = static_cast<PaintableBox const&>(*paintable);
+        if (paintable_box.is_viewport())
+            return true;
+        if (paintable_box.has_css_transform() || paintable_box.own_scroll_frame())
+            return false;
+        // NOTE: A backdrop filter reads what has been painted behind it. Outside of the damaged part of the viewport,
+        //       that would be what the previous frame left there, which has been filtered already.
+        // FIXME: Also bail out for the filter property, once we support it.
+        if (!paintable_box.computed_values().backdrop_filter().is_none())
+            return false;
+    }
+    return true;
 }
 
 CSSPixelPoint Paintable::box_type_agnostic_position() const
@@ -203,6 +203,10 @@ public:
 
     virtual void set_needs_display(InvalidateDisplayList = InvalidateDisplayList::Yes);
 
+    // Whether this paintable ends up on screen at its absolute rects, shifted by nothing but the viewport's scroll offset.
+    // Only then can those rects tell the document which part of the viewport to repaint.
+    [[nodiscard]] bool is_painted_at_its_absolute_rects() const;
+
     PaintableBox* containing_block() const;
 
     template<typename T>
@@ -987,7 +987,15 @@ TraversalDecision PaintableWithLines::hit_test(CSSPixelPoint position, HitTestTy
 
 void PaintableBox::set_needs_display(InvalidateDisplayList should_invalidate_display_list)
 {
-    document().set_needs_display(absolute_rect(), should_invalidate_display_list);
+    // NOTE: Outlines are painted outside of the absolute paint rect, and the backgrounds of the root element and the
+    //       body can be propagated to the canvas, which covers the whole viewport.
+    auto const* dom_node = this->dom_node();
+    if (!is_painted_at_its_absolute_rects() || is_viewport() || outline_data().has_value()
+        || (dom_node && (dom_node == document().document_element() || dom_node == document().body()))) {
+        document().set_needs_display(should_invalidate_display_list);
+        return;
+    }
+    document().set_needs_display(absolute_paint_rect(), should_invalidate_display_list);
 }
 
 Optional<CSSPixelRect> PaintableBox::get_masking_area() const
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <LibGfx/AffineTransform.h>
 #include <LibGfx/Path.h>
 #include <LibWeb/Layout/SVGGraphicsBox.h>
 #include <LibWeb/Painting/SVGGraphicsPaintable.h>
@@ -28,6 +29,7 @@ public:
     void set_computed_path(Gfx::Path path)
     {
         m_computed_path = move(path);
+        m_device_pixel_paths.clear();
     }
 
     Optional<Gfx::Path> const& computed_path() const { return m_computed_path; }
@@ -36,6 +38,19 @@ protected:
     SVGPathPaintable(Layout::SVGGraphicsBox const&);
 
     Optional<Gfx::Path> m_computed_path = {};
+
+private:
+    struct DevicePixelPaths {
+        Gfx::AffineTransform paint_transform;
+        Gfx::Path path;
+        Gfx::Path closed_path;
+    };
+
+    DevicePixelPaths const& device_pixel_paths(Gfx::AffineTransform const& paint_transform) const;
+
+    // The computed path mapped to device pixels for the last paint transform. Repaints that don't change the transform
+    // (e.g. caused by something else on the page) reuse it instead of transforming and closing the path again.
+    mutable Optional<DevicePixelPaths> m_device_pixel_paths;
 };
 
 }
@@ -68,7 +68,16 @@ void ViewportPaintable::paint_all_phases(PaintContext& context)
 
 void ViewportPaintable::assign_scroll_frames()
 {
+    m_has_contents_that_stay_in_place_when_scrolled = false;
+
     for_each_in_inclusive_subtree_of_type<PaintableBox>([&](auto& paintable_box) {
+        if (paintable_box.is_fixed_position() || paintable_box.is_sticky_position())
+            m_has_contents_that_stay_in_place_when_scrolled = true;
+        for (auto const& layer : paintable_box.computed_values().background_layers()) {
+            if (layer.attachment == CSS::BackgroundAttachment::Fixed)
+                m_has_contents_that_stay_in_place_when_scrolled = true;
+        }
+
         RefPtr<ScrollFrame> sticky_scroll_frame;
         if (paintable_box.is_sticky_position()) {
             auto const* nearest_scrollable_ancestor = paintable_box.nearest_scrollable_ancestor();
@@ -119,6 +128,21 @@ void ViewportPaintable::assign_scroll_frames()
     });
 }
 
+Vector<CSSPixelRect, 2> ViewportPaintable::scrollbar_rects() const
+{
+    Vector<CSSPixelRect, 2> rects;
+    auto padding_rect = absolute_padding_box_rect();
+    if (auto scrollbar_data = compute_scrollbar_data(ScrollDirection::Vertical); scrollbar_data.has_value()) {
+        auto const& thumb_rect = scrollbar_data->thumb_rect;
+        rects.append({ thumb_rect.x() - padding_rect.x(), 0, thumb_rect.width(), padding_rect.height() });
+    }
+    if (auto scrollbar_data = compute_scrollbar_data(ScrollDirection::Horizontal); scrollbar_data.has_value()) {
+        auto const& thumb_rect = scrollbar_data->thumb_rect;
+        rects.append({ 0, thumb_rect.y() - padding_rect.y(), padding_rect.width(), thumb_rect.height() });
+    }
+    return rects;
+}
+
 void ViewportPaintable::assign_clip_frames()
 {
     for_each_in_subtree_of_type<PaintableBox>([&](auto const& paintable_box) {
@@ -41,6 +41,13 @@ public:
 
     ScrollState const& scroll_state() const { return m_scroll_state; }
 
+    // Whether everything this viewport paints, apart from its scrollbars, moves along when it's scrolled. If so, a new
+    // frame can be made by moving the pixels of the previous one.
+    bool contents_move_along_when_scrolled() const { return !m_has_contents_that_stay_in_place_when_scrolled; }
+
+    // The areas that the viewport's scrollbars are painted in, relative to the viewport.
+    Vector<CSSPixelRect, 2> scrollbar_rects() const;
+
 private:
     void build_stacking_context_tree();
 
@@ -50,6 +57,7 @@ private:
 
     ScrollState m_scroll_state;
     bool m_needs_to_refresh_scroll_state { true };
+    bool m_has_contents_that_stay_in_place_when_scrolled { false };
 };
 
 }
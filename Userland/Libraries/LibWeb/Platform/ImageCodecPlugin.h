@@ -7,10 +7,14 @@
 
 #pragma once
 
+#include <AK/Function.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibCore/Promise.h>
 #include <LibGfx/Forward.h>
+#include <LibGfx/Size.h>
 
 namespace Web::Platform {
 
@@ -19,10 +23,39 @@ struct Frame {
     size_t duration { 0 };
 };
 
+// The frames of an animated image that are decoded as they are needed, rather than all up front.
+class FrameStream : public RefCounted<FrameStream> {
+public:
+    virtual ~FrameStream() = default;
+
+    // Frames that fail to decode are left out, so on_frames_decoded may be given fewer frames than were requested.
+    virtual void request_frames(size_t start_frame_index, size_t frame_count) = 0;
+    Function<void(size_t start_frame_index, Vector<Frame>&)> on_frames_decoded;
+};
+
 struct DecodedImage {
     bool is_animated { false };
     u32 loop_count { 0 };
+
+    // NOTE: The frames may be smaller than this if the image was decoded for an ideal size.
+    Gfx::IntSize natural_size;
+
+    // NOTE: If there is a frame stream, this only holds the first few frames, and the stream provides the others.
     Vector<Frame> frames;
+    size_t frame_count { 0 };
+    RefPtr<FrameStream> frame_stream;
+};
+
+// An image whose encoded data is decoded bit by bit as it arrives. Until the session is finished, on_partial_image is
+// called now and then with what could be made of the data so far.
+class DecodingSession : public RefCounted<DecodingSession> {
+public:
+    virtual ~DecodingSession() = default;
+
+    virtual ErrorOr<void> append(ReadonlyBytes) = 0;
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> finish(ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}) = 0;
+
+    Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image;
 };
 
 class ImageCodecPlugin {
@@ -32,7 +65,12 @@ public:
 
     virtual ~ImageCodecPlugin();
 
-    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+    // If an ideal size is given, the image may be decoded at a smaller size that still covers it. That's only worth it
+    // for images that are shown smaller than they are.
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}) = 0;
+
+    // Returns null if images can't be decoded as their data arrives, in which case they have to be decoded in one go.
+    virtual RefPtr<DecodingSession> start_decoding_session() { return nullptr; }
 };
 
 }
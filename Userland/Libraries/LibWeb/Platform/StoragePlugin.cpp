@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Platform/StoragePlugin.h>
+
+namespace Web::Platform {
+
+static StoragePlugin* s_the;
+
+StoragePlugin::~StoragePlugin() = default;
+
+StoragePlugin* StoragePlugin::the()
+{
+    return s_the;
+}
+
+void StoragePlugin::install(StoragePlugin& plugin)
+{
+    VERIFY(!s_the);
+    s_the = &plugin;
+}
+
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/String.h>
+
+namespace Web::Platform {
+
+// Keeps the local storage of each origin somewhere that outlives the process, and that every process with a document
+// of that origin shares. The Storage object of an origin loads its items once, and from then on keeps its copy up to
+// date with the changes it makes and the changes it is told about, so reading from it never leaves the process.
+class StoragePlugin {
+public:
+    // Returns null if no plugin has been installed, in which case local storage only lives as long as the process does.
+    static StoragePlugin* the();
+    static void install(StoragePlugin&);
+
+    virtual ~StoragePlugin();
+
+    // The most that the keys and values that an origin stores may add up to, in UTF-8 bytes.
+    static constexpr size_t local_storage_quota_in_bytes = 5 * MiB;
+
+    virtual OrderedHashMap<String, String> load_local_storage(String const& origin) = 0;
+
+    // NOTE: These must not wait for the change to be stored. Every change is reported back to Storage with
+    //       apply_local_storage_change(), in the order in which it was stored.
+    virtual void set_local_storage_item(String const& origin, String const& key, String const& value) = 0;
+    virtual void remove_local_storage_item(String const& origin, String const& key) = 0;
+    virtual void clear_local_storage(String const& origin) = 0;
+};
+
+}
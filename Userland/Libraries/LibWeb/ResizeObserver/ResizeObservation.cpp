@@ -40,11 +40,12 @@ void ResizeObservation::visit_edges(JS::Cell::Visitor& visitor)
 bool ResizeObservation::is_active()
 {
     // 1. Set currentSize by calculate box size given target and observedBox.
-    auto current_size = ResizeObserverSize::calculate_box_size(m_realm, m_target, m_observed_box);
+    // NOTE: This runs for every observation each time observations are gathered, so don't allocate a ResizeObserverSize.
+    auto current_size = ResizeObserverSize::compute_box_size(m_target, m_observed_box);
 
     // 2. Return true if currentSize is not equal to the first entry in this.lastReportedSizes.
     VERIFY(!m_last_reported_sizes.is_empty());
-    if (!m_last_reported_sizes.first()->equals(*current_size))
+    if (!m_last_reported_sizes.first()->equals(current_size))
         return true;
 
     // 3. Return false.
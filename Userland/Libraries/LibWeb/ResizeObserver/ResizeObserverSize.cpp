@@ -26,6 +26,19 @@ JS::NonnullGCPtr<ResizeObserverSize> ResizeObserverSize::calculate_box_size(JS::
     // 1. Let computedSize be a new ResizeObserverSize object.
     auto computed_size = realm.heap().allocate<ResizeObserverSize>(realm, realm);
 
+    // NOTE: Steps 2 and onwards are implemented by compute_box_size().
+    auto box_size = compute_box_size(target, observed_box);
+    computed_size->set_inline_size(box_size.inline_size);
+    computed_size->set_block_size(box_size.block_size);
+
+    // 3. Return computedSize.s
+    return computed_size;
+}
+
+ResizeObserverSize::BoxSize ResizeObserverSize::compute_box_size(DOM::Element& target, Bindings::ResizeObserverBoxOptions observed_box)
+{
+    BoxSize computed_size;
+
     // FIXME: 2. If target is an SVGGraphicsElement that does not have an associated CSS layout box:
     // Otherwise:
     if (target.paintable_box()) {
@@ -33,22 +46,22 @@ JS::NonnullGCPtr<ResizeObserverSize> ResizeObserverSize::calculate_box_size(JS::
         switch (observed_box) {
         case Bindings::ResizeObserverBoxOptions::BorderBox:
             // 1. Set computedSize’s inlineSize attribute to target’s border area inline length.
-            computed_size->set_inline_size(paintable_box.border_box_width().to_double());
+            computed_size.inline_size = paintable_box.border_box_width().to_double();
             // 2. Set computedSize’s blockSize attribute to target’s border area block length.
-            computed_size->set_block_size(paintable_box.border_box_height().to_double());
+            computed_size.block_size = paintable_box.border_box_height().to_double();
             break;
         case Bindings::ResizeObserverBoxOptions::ContentBox:
             // 1. Set computedSize’s inlineSize attribute to target’s content area inline length.
-            computed_size->set_inline_size(paintable_box.content_width().to_double());
+            computed_size.inline_size = paintable_box.content_width().to_double();
             // 2. Set computedSize’s blockSize attribute to target’s content area block length.
-            computed_size->set_block_size(paintable_box.content_height().to_double());
+            computed_size.block_size = paintable_box.content_height().to_double();
             break;
         case Bindings::ResizeObserverBoxOptions::DevicePixelContentBox: {
             auto device_pixel_ratio = target.document().window()->device_pixel_ratio();
             // 1. Set computedSize’s inlineSize attribute to target’s content area inline length, in integral device pixels.
-            computed_size->set_inline_size(paintable_box.border_box_width().to_double() * device_pixel_ratio);
+            computed_size.inline_size = paintable_box.border_box_width().to_double() * device_pixel_ratio;
             // 2. Set computedSize’s blockSize attribute to target’s content area block length, in integral device pixels.
-            computed_size->set_block_size(paintable_box.border_box_height().to_double() * device_pixel_ratio);
+            computed_size.block_size = paintable_box.border_box_height().to_double() * device_pixel_ratio;
             break;
         }
         default:
@@ -56,7 +69,6 @@ JS::NonnullGCPtr<ResizeObserverSize> ResizeObserverSize::calculate_box_size(JS::
         }
     }
 
-    // 3. Return computedSize.s
     return computed_size;
 }
 
@@ -65,4 +77,9 @@ bool ResizeObserverSize::equals(ResizeObserverSize const& other) const
     return m_inline_size == other.m_inline_size && m_block_size == other.m_block_size;
 }
 
+bool ResizeObserverSize::equals(BoxSize const& other) const
+{
+    return m_inline_size == other.inline_size && m_block_size == other.block_size;
+}
+
 }
@@ -17,8 +17,16 @@ class ResizeObserverSize : public Bindings::PlatformObject {
     JS_DECLARE_ALLOCATOR(ResizeObserverSize);
 
 public:
+    struct BoxSize {
+        double inline_size { 0 };
+        double block_size { 0 };
+    };
+
     static JS::NonnullGCPtr<ResizeObserverSize> calculate_box_size(JS::Realm& realm, DOM::Element& target, Bindings::ResizeObserverBoxOptions observed_box);
 
+    // Same as calculate_box_size(), but without allocating a ResizeObserverSize, as isActive() only compares it.
+    static BoxSize compute_box_size(DOM::Element& target, Bindings::ResizeObserverBoxOptions observed_box);
+
     double inline_size() const { return m_inline_size; }
     void set_inline_size(double inline_size) { m_inline_size = inline_size; }
 
@@ -26,6 +34,7 @@ public:
     void set_block_size(double block_size) { m_block_size = block_size; }
 
     bool equals(ResizeObserverSize const& other) const;
+    bool equals(BoxSize const& other) const;
 
 private:
     explicit ResizeObserverSize(JS::Realm& realm)
@@ -30,6 +30,9 @@ private:
     virtual void initialize(JS::Realm&) override;
 
     Vector<PathInstruction> m_instructions;
+
+    // The path built from m_instructions, kept until "d" changes since it does not depend on the viewport.
+    Optional<Gfx::Path> m_path;
 };
 
 [[nodiscard]] Gfx::Path path_from_path_instructions(ReadonlySpan<PathInstruction>);
@@ -17,6 +17,7 @@
 #include <LibWeb/Bindings/ReadableStreamDefaultReaderPrototype.h>
 #include <LibWeb/Fetch/Infrastructure/IncrementalReadLoopReadRequest.h>
 #include <LibWeb/Streams/AbstractOperations.h>
+#include <LibWeb/Streams/ReadableByteStreamController.h>
 #include <LibWeb/Streams/ReadableStream.h>
 #include <LibWeb/Streams/ReadableStreamDefaultReader.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
@@ -89,24 +90,42 @@ void ReadLoopReadRequest::on_chunk(JS::Value chunk)
     }
 
     auto const& array = static_cast<JS::Uint8Array const&>(chunk.as_object());
-    auto const& buffer = array.viewed_array_buffer()->buffer();
 
     // 2. Append the bytes represented by chunk to bytes.
-    m_bytes.append(buffer);
-
-    if (m_chunk_steps) {
-        // FIXME: Can we move the buffer out of the `chunk`? Unclear if that is safe.
-        m_chunk_steps->function()(MUST(ByteBuffer::copy(buffer)));
+    append_bytes(array.data());
+
+    // NOTE: Any chunks that a byte stream already has queued up are taken straight from its controller's queue, the way
+    //       ReadableByteStreamControllerFillReadRequestFromQueue would, but without creating a Uint8Array and going
+    //       through another read request for each of them. Nothing else can observe these chunks, as the stream is
+    //       locked to our reader.
+    if (auto stream = m_reader->stream(); stream && stream->controller()->has<JS::NonnullGCPtr<ReadableByteStreamController>>()) {
+        auto controller = stream->controller()->get<JS::NonnullGCPtr<ReadableByteStreamController>>();
+
+        while (stream->is_readable() && controller->queue_total_size() > 0) {
+            auto entry = controller->queue().take_first();
+            controller->set_queue_total_size(controller->queue_total_size() - entry.byte_length);
+            readable_byte_stream_controller_handle_queue_drain(controller);
+
+            append_bytes(entry.buffer->buffer().bytes().slice(entry.byte_offset, entry.byte_length));
+        }
     }
 
-    // FIXME: As the spec suggests, implement this non-recursively - instead of directly. It is not too big of a deal currently
-    //        as we enqueue the entire blob buffer in one go, meaning that we only recurse a single time. Once we begin queuing
-    //        up more than one chunk at a time, we may run into stack overflow problems.
+    // FIXME: As the spec suggests, implement this non-recursively - instead of directly. This is only a problem for streams
+    //        that aren't byte streams now, as the chunks queued up in byte streams are all taken above, meaning that we
+    //        only recurse once for each time that we have to wait for more data.
     //
     // 3. Read-loop given reader, bytes, successSteps, and failureSteps.
     readable_stream_default_reader_read(m_reader, *this);
 }
 
+void ReadLoopReadRequest::append_bytes(ReadonlyBytes bytes)
+{
+    m_bytes.append(bytes);
+
+    if (m_chunk_steps)
+        m_chunk_steps->function()(MUST(ByteBuffer::copy(bytes)));
+}
+
 // close steps
 void ReadLoopReadRequest::on_close()
 {
@@ -56,6 +56,8 @@ public:
 private:
     virtual void visit_edges(Visitor&) override;
 
+    void append_bytes(ReadonlyBytes);
+
     JS::VM& m_vm;
     JS::NonnullGCPtr<JS::Realm> m_realm;
     JS::NonnullGCPtr<ReadableStreamDefaultReader> m_reader;
@@ -21,8 +21,12 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<Memory>> Memory::construct_impl(JS::Realm&
 {
     auto& vm = realm.vm();
 
+    // https://webassembly.github.io/threads/js-api/index.html#dom-memory-memory
+    if (descriptor.shared && !descriptor.maximum.has_value())
+        return vm.throw_completion<JS::TypeError>("Shared Wasm Memory must have a maximum"sv);
+
     Wasm::Limits limits { descriptor.initial, move(descriptor.maximum) };
-    Wasm::MemoryType memory_type { move(limits) };
+    Wasm::MemoryType memory_type { move(limits), descriptor.shared ? Wasm::MemoryType::Shared::Yes : Wasm::MemoryType::Shared::No };
 
     auto& cache = Detail::get_cache(realm);
     auto address = cache.abstract_machine().store().allocate(memory_type);
@@ -83,7 +87,10 @@ WebIDL::ExceptionOr<void> Memory::reset_the_memory_buffer()
     auto& vm = this->vm();
     auto& realm = *vm.current_realm();
 
-    MUST(JS::detach_array_buffer(vm, *m_buffer, JS::PrimitiveString::create(vm, "WebAssembly.Memory"_string)));
+    // NOTE: A SharedArrayBuffer can't be detached, and aliases the memory instance's storage directly, so it keeps
+    //       seeing the same data after growing.
+    if (!m_buffer->is_shared_array_buffer())
+        MUST(JS::detach_array_buffer(vm, *m_buffer, JS::PrimitiveString::create(vm, "WebAssembly.Memory"_string)));
 
     auto buffer = TRY(create_a_memory_buffer(vm, realm, m_address));
     m_buffer = buffer;
@@ -111,6 +118,13 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::ArrayBuffer>> Memory::create_a_memory_b
     if (!memory)
         return vm.throw_completion<JS::RangeError>("Could not find the memory instance"sv);
 
+    // https://webassembly.github.io/threads/js-api/index.html#create-a-memory-buffer
+    if (memory->type().is_shared()) {
+        auto array_buffer = JS::ArrayBuffer::create(realm, &memory->data(), JS::DataBlock::Shared::Yes);
+        MUST(array_buffer->set_integrity_level(JS::Object::IntegrityLevel::Frozen));
+        return JS::NonnullGCPtr(*array_buffer);
+    }
+
     auto array_buffer = JS::ArrayBuffer::create(realm, &memory->data());
     array_buffer->set_detach_key(JS::PrimitiveString::create(vm, "WebAssembly.Memory"_string));
 
@@ -20,6 +20,7 @@ namespace Web::WebAssembly {
 struct MemoryDescriptor {
     u32 initial { 0 };
     Optional<u32> maximum;
+    bool shared { false };
 };
 
 class Memory : public Bindings::PlatformObject {
@@ -8,6 +8,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -37,6 +38,56 @@ WebAssemblyCache& get_cache(JS::Realm& realm)
     return s_caches.ensure(realm.global_object());
 }
 
+void WebAssemblyCache::add_function_instance(Wasm::FunctionAddress address, JS::GCPtr<JS::NativeFunction> function)
+{
+    m_function_instances.set(address, function);
+    m_function_addresses.set(function.ptr(), address);
+}
+
+// Once parsed and validated, a module is never modified again, so it can be shared by every realm in this process that
+// compiles the same bytes (e.g. when a page is reloaded), and only needs to be instantiated anew.
+struct CachedModule {
+    ::Crypto::Hash::SHA256::DigestType digest;
+    size_t size { 0 };
+    NonnullRefPtr<Wasm::Module> module;
+};
+
+static constexpr size_t max_number_of_cached_modules = 16;
+static constexpr size_t max_total_size_of_cached_modules = 256 * MiB;
+
+// Most recently used first.
+static Vector<CachedModule> s_cached_modules;
+
+static RefPtr<Wasm::Module> find_cached_module(::Crypto::Hash::SHA256::DigestType const& digest, size_t size)
+{
+    for (size_t i = 0; i < s_cached_modules.size(); ++i) {
+        if (s_cached_modules[i].digest != digest || s_cached_modules[i].size != size)
+            continue;
+        auto cached_module = s_cached_modules.take(i);
+        auto module = cached_module.module;
+        s_cached_modules.prepend(move(cached_module));
+        return module;
+    }
+    return nullptr;
+}
+
+static void cache_module(::Crypto::Hash::SHA256::DigestType const& digest, size_t size, NonnullRefPtr<Wasm::Module> module)
+{
+    if (size > max_total_size_of_cached_modules)
+        return;
+
+    s_cached_modules.prepend({ digest, size, move(module) });
+
+    size_t total_size = 0;
+    for (size_t i = 0; i < s_cached_modules.size(); ++i) {
+        total_size += s_cached_modules[i].size;
+        if (i >= max_number_of_cached_modules || total_size > max_total_size_of_cached_modules) {
+            s_cached_modules.shrink(i);
+            break;
+        }
+    }
+}
+
 }
 
 void visit_edges(JS::Object& object, JS::Cell::Visitor& visitor)
@@ -189,8 +240,17 @@ JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS
                         return {};
                     auto& function = import_.as_function();
                     cache.add_imported_object(function);
-                    // FIXME: If this is a function created by create_native_function(),
-                    //        just extract its address and resolve to that.
+
+                    // If this is an exported Wasm function with the same signature, call it directly instead of going through JS.
+                    if (auto address = cache.get_function_address(function); address.has_value()) {
+                        Wasm::FunctionType const* function_type = nullptr;
+                        cache.abstract_machine().store().get(*address)->visit([&](auto const& value) { function_type = &value.type(); });
+                        if (function_type->parameters() == type.parameters() && function_type->results() == type.results()) {
+                            resolved_imports.set(import_name, Wasm::ExternValue { *address });
+                            return {};
+                        }
+                    }
+
                     Wasm::HostFunction host_function {
                         [&](auto&, auto& arguments) -> Wasm::Result {
                             JS::MarkedVector<JS::Value> argument_values { vm.heap() };
@@ -332,6 +392,15 @@ JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> parse_module(JS:
     } else {
         return vm.throw_completion<JS::TypeError>("Not a BufferSource"sv);
     }
+    auto& cache = get_cache(*vm.current_realm());
+
+    auto digest = ::Crypto::Hash::SHA256::hash(data.data(), data.size());
+    if (auto module = find_cached_module(digest, data.size())) {
+        auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module.release_nonnull());
+        cache.add_compiled_module(compiled_module);
+        return compiled_module;
+    }
+
     FixedMemoryStream stream { data };
     auto module_result = Wasm::Module::parse(stream);
     if (module_result.is_error()) {
@@ -339,11 +408,12 @@ JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> parse_module(JS:
         return vm.throw_completion<JS::TypeError>(Wasm::parse_error_to_byte_string(module_result.error()));
     }
 
-    auto& cache = get_cache(*vm.current_realm());
     if (auto validation_result = cache.abstract_machine().validate(module_result.value()); validation_result.is_error()) {
         // FIXME: Throw CompileError instead.
         return vm.throw_completion<JS::TypeError>(validation_result.error().error_string);
     }
+    cache_module(digest, data.size(), module_result.value());
+
     auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_result.release_value());
     cache.add_compiled_module(compiled_module);
     return compiled_module;
@@ -352,12 +422,13 @@ JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> parse_module(JS:
 JS::NativeFunction* create_native_function(JS::VM& vm, Wasm::FunctionAddress address, ByteString const& name, Instance* instance)
 {
     auto& realm = *vm.current_realm();
-    Optional<Wasm::FunctionType> type;
     auto& cache = get_cache(realm);
-    cache.abstract_machine().store().get(address)->visit([&](auto const& value) { type = value.type(); });
     if (auto entry = cache.get_function_instance(address); entry.has_value())
         return *entry;
 
+    Optional<Wasm::FunctionType> type;
+    cache.abstract_machine().store().get(address)->visit([&](auto const& value) { type = value.type(); });
+
     auto function = JS::NativeFunction::create(
         realm,
         name,
@@ -431,12 +502,9 @@ JS::ThrowCompletionOr<Wasm::Value> to_webassembly_value(JS::VM& vm, JS::Value va
             return Wasm::Value(Wasm::ValueType { Wasm::ValueType::Kind::FunctionReference });
 
         if (value.is_function()) {
-            auto& function = value.as_function();
             auto& cache = get_cache(*vm.current_realm());
-            for (auto& entry : cache.function_instances()) {
-                if (entry.value == &function)
-                    return Wasm::Value { Wasm::Reference { Wasm::Reference::Func { entry.key, cache.abstract_machine().store().get_module_for(entry.key) } } };
-            }
+            if (auto address = cache.get_function_address(value.as_function()); address.has_value())
+                return Wasm::Value { Wasm::Reference { Wasm::Reference::Func { *address, cache.abstract_machine().store().get_module_for(*address) } } };
         }
 
         return vm.throw_completion<JS::TypeError>(JS::ErrorType::NotAnObjectOfType, "Exported function");
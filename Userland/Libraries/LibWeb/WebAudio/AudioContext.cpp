@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/ThreadedPromise.h>
 #include <LibWeb/Bindings/AudioContextPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/DOM/Event.h>
@@ -64,8 +65,8 @@ AudioContext::AudioContext(JS::Realm& realm, AudioContextOptions const& context_
 
     // FIXME: 5: If the context is allowed to start, send a control message to start processing.
     // FIXME: Implement control message queue to run following steps on the rendering thread
-    if (m_allowed_to_start) {
-        // FIXME: 5.1: Attempt to acquire system resources. In case of failure, abort the following steps.
+    // 5.1: Attempt to acquire system resources. In case of failure, abort the following steps.
+    if (m_allowed_to_start && start_rendering_audio_graph()) {
 
         // 5.2: Set the [[rendering thread state]] to "running" on the AudioContext.
         BaseAudioContext::set_rendering_state(Bindings::AudioContextState::Running);
@@ -221,7 +222,9 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> AudioContext::suspend()
     // 7. Queue a control message to suspend the AudioContext.
     // FIXME: Implement control message queue to run following steps on the rendering thread
 
-    // FIXME: 7.1: Attempt to release system resources.
+    // 7.1: Attempt to release system resources.
+    if (m_playback_stream)
+        (void)m_playback_stream->discard_buffer_and_suspend();
 
     // 7.2: Set the [[rendering thread state]] on the AudioContext to suspended.
     set_rendering_state(Bindings::AudioContextState::Suspended);
@@ -272,7 +275,9 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> AudioContext::close()
     // 5. Queue a control message to close the AudioContext.
     // FIXME: Implement control message queue to run following steps on the rendering thread
 
-    // FIXME: 5.1: Attempt to release system resources.
+    // 5.1: Attempt to release system resources.
+    if (m_playback_stream)
+        (void)m_playback_stream->discard_buffer_and_suspend();
 
     // 5.2: Set the [[rendering thread state]] to "suspended".
     set_rendering_state(Bindings::AudioContextState::Suspended);
@@ -299,11 +304,56 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> AudioContext::close()
     return JS::NonnullGCPtr { verify_cast<JS::Promise>(*promise->promise()) };
 }
 
-// FIXME: Actually implement the rendering thread
+// https://webaudio.github.io/web-audio-api/#dom-baseaudiocontext-currenttime
+double AudioContext::current_time() const
+{
+    // This is the time in seconds of the sample frame immediately following the last sample-frame in the block of audio
+    // most recently processed by the context’s rendering graph.
+    if (!m_renderer)
+        return BaseAudioContext::current_time();
+    return static_cast<double>(m_renderer->rendered_frames()) / sample_rate();
+}
+
+void AudioContext::render_graph_did_change()
+{
+    if (m_renderer)
+        m_renderer->set_graph(build_render_graph());
+}
+
+// NOTE: The playback stream asks for audio from its own thread, which the platform's audio system runs at a high
+//       priority. That thread renders the graph one quantum at a time, so it is our rendering thread.
 bool AudioContext::start_rendering_audio_graph()
 {
-    bool render_result = true;
-    return render_result;
+    if (m_playback_stream) {
+        (void)m_playback_stream->resume();
+        return true;
+    }
+
+    // FIXME: Follow the channel count of the destination node.
+    static constexpr u8 channel_count = 2;
+    // FIXME: Derive this from the latency hint.
+    static constexpr u32 target_latency_ms = 20;
+
+    auto renderer = GraphRenderer::create(sample_rate(), channel_count);
+    auto playback_stream = Audio::PlaybackStream::create(
+        Audio::OutputState::Playing, static_cast<u32>(sample_rate()), channel_count, target_latency_ms,
+        [renderer](Bytes buffer, Audio::PcmSampleFormat format, size_t sample_count) -> ReadonlyBytes {
+            VERIFY(format == Audio::PcmSampleFormat::Float32);
+            VERIFY(buffer.size() >= sample_count * channel_count * sizeof(float));
+
+            Span<float> samples { reinterpret_cast<float*>(buffer.data()), sample_count * channel_count };
+            renderer->render(samples);
+            return buffer.trim(samples.size() * sizeof(float));
+        });
+    if (playback_stream.is_error()) {
+        dbgln("Failed to start rendering the audio graph: {}", playback_stream.error());
+        return false;
+    }
+
+    m_renderer = move(renderer);
+    m_renderer->set_graph(build_render_graph());
+    m_playback_stream = playback_stream.release_value();
+    return true;
 }
 
 }
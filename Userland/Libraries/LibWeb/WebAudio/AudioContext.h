@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include <LibMedia/Audio/PlaybackStream.h>
 #include <LibWeb/Bindings/AudioContextPrototype.h>
 #include <LibWeb/HighResolutionTime/DOMHighResTimeStamp.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
 
 namespace Web::WebAudio {
 
@@ -39,6 +41,9 @@ public:
     WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> suspend();
     WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> close();
 
+    virtual double current_time() const override;
+    virtual void render_graph_did_change() override;
+
 private:
     explicit AudioContext(JS::Realm&, AudioContextOptions const& context_options);
 
@@ -53,6 +58,10 @@ private:
     bool m_suspended_by_user = false;
 
     bool start_rendering_audio_graph();
+
+    // NOTE: The playback stream calls into the renderer from its own thread, which is our rendering thread.
+    RefPtr<GraphRenderer> m_renderer;
+    RefPtr<Audio::PlaybackStream> m_playback_stream;
 };
 
 }
@@ -34,6 +34,8 @@ protected:
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
+
+    virtual NonnullRefPtr<RenderNode> create_render_node() const override { return PassThroughRenderNode::create(); }
 };
 
 }
@@ -32,9 +32,23 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<AudioNode>> AudioNode::connect(JS::NonnullG
         return WebIDL::InvalidAccessError::create(realm(), "Cannot connect to an AudioNode in a different AudioContext"_string);
     }
 
-    (void)output;
-    (void)input;
-    dbgln("FIXME: Implement Audio::connect(AudioNode)");
+    // The output parameter is an index describing which output of the AudioNode from which to connect. If this parameter is out-of-bounds,
+    // an IndexSizeError exception MUST be thrown.
+    if (output >= number_of_outputs())
+        return WebIDL::IndexSizeError::create(realm(), "Output index is out of range"_string);
+
+    // The input parameter is an index describing which input of the destination AudioNode to connect to. If this parameter is out-of-bounds,
+    // an IndexSizeError exception MUST be thrown.
+    if (input >= destination_node->number_of_inputs())
+        return WebIDL::IndexSizeError::create(realm(), "Input index is out of range"_string);
+
+    Connection output_connection { destination_node, output, input };
+    if (m_output_connections.contains_slow(output_connection))
+        return destination_node;
+
+    m_output_connections.append(output_connection);
+    destination_node->m_input_connections.append({ *this, output, input });
+    m_context->render_graph_did_change();
     return destination_node;
 }
 
@@ -46,41 +60,56 @@ void AudioNode::connect(JS::NonnullGCPtr<AudioParam> destination_param, WebIDL::
     dbgln("FIXME: Implement AudioNode::connect(AudioParam)");
 }
 
+void AudioNode::remove_output_connections(Function<bool(Connection const&)> const& predicate)
+{
+    auto removed_any = m_output_connections.remove_all_matching([&](auto const& connection) {
+        if (!predicate(connection))
+            return false;
+        connection.node->m_input_connections.remove_first_matching([&](auto const& input_connection) {
+            return input_connection == Connection { *this, connection.output, connection.input };
+        });
+        return true;
+    });
+    if (removed_any)
+        m_context->render_graph_did_change();
+}
+
+// FIXME: The disconnect() overloads that are given an output or a destination should throw if they don't match any
+//        connection.
+
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect
 void AudioNode::disconnect()
 {
-    dbgln("FIXME: Implement AudioNode::disconnect()");
+    // Disconnects all outgoing connections from the AudioNode.
+    remove_output_connections([](auto const&) { return true; });
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-output
 void AudioNode::disconnect(WebIDL::UnsignedLong output)
 {
-    (void)output;
-    dbgln("FIXME: Implement AudioNode::disconnect(output)");
+    // Disconnects all outgoing connections from the given output of the AudioNode.
+    remove_output_connections([&](auto const& connection) { return connection.output == output; });
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationnode
 void AudioNode::disconnect(JS::NonnullGCPtr<AudioNode> destination_node)
 {
-    (void)destination_node;
-    dbgln("FIXME: Implement AudioNode::disconnect(destination_node)");
+    // Disconnects all outputs of the AudioNode that go to a specific destination AudioNode.
+    remove_output_connections([&](auto const& connection) { return connection.node == destination_node; });
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationnode-output
 void AudioNode::disconnect(JS::NonnullGCPtr<AudioNode> destination_node, WebIDL::UnsignedLong output)
 {
-    (void)destination_node;
-    (void)output;
-    dbgln("FIXME: Implement AudioNode::disconnect(destination_node, output)");
+    // Disconnects a specific output of the AudioNode from any and all inputs of some destination AudioNode.
+    remove_output_connections([&](auto const& connection) { return connection.node == destination_node && connection.output == output; });
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationnode-output-input
 void AudioNode::disconnect(JS::NonnullGCPtr<AudioNode> destination_node, WebIDL::UnsignedLong output, WebIDL::UnsignedLong input)
 {
-    (void)destination_node;
-    (void)output;
-    (void)input;
-    dbgln("FIXME: Implement AudioNode::disconnect(destination_node, output, input)");
+    // Disconnects a specific output of the AudioNode from a specific input of some destination AudioNode.
+    remove_output_connections([&](auto const& connection) { return connection == Connection { destination_node, output, input }; });
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationparam
@@ -98,6 +127,13 @@ void AudioNode::disconnect(JS::NonnullGCPtr<AudioParam> destination_param, WebID
     dbgln("FIXME: Implement AudioNode::disconnect(destination_param, output)");
 }
 
+RenderNode& AudioNode::render_node() const
+{
+    if (!m_render_node)
+        m_render_node = create_render_node();
+    return *m_render_node;
+}
+
 // https://webaudio.github.io/web-audio-api/#dom-audionode-channelcount
 WebIDL::ExceptionOr<void> AudioNode::set_channel_count(WebIDL::UnsignedLong channel_count)
 {
@@ -146,6 +182,10 @@ void AudioNode::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_context);
+    for (auto const& connection : m_input_connections)
+        visitor.visit(connection.node);
+    for (auto const& connection : m_output_connections)
+        visitor.visit(connection.node);
 }
 
 }
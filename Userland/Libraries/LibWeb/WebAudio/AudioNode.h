@@ -11,6 +11,7 @@
 #include <LibWeb/Bindings/AudioNodePrototype.h>
 #include <LibWeb/Bindings/PlatformObject.h>
 #include <LibWeb/DOM/EventTarget.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
 #include <LibWeb/WebIDL/Types.h>
 
 namespace Web::WebAudio {
@@ -62,14 +63,39 @@ public:
     WebIDL::ExceptionOr<void> set_channel_interpretation(Bindings::ChannelInterpretation);
     Bindings::ChannelInterpretation channel_interpretation();
 
+    struct Connection {
+        JS::NonnullGCPtr<AudioNode> node;
+        WebIDL::UnsignedLong output { 0 };
+        WebIDL::UnsignedLong input { 0 };
+
+        bool operator==(Connection const&) const = default;
+    };
+    // The nodes connected to the inputs of this node, with the output of theirs they are connected from.
+    Vector<Connection> const& input_connections() const { return m_input_connections; }
+
+    // The part of this node that runs on the rendering thread.
+    RenderNode& render_node() const;
+
 protected:
     AudioNode(JS::Realm&, JS::NonnullGCPtr<BaseAudioContext>);
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    // FIXME: Render the nodes that still use the default, which renders silence.
+    virtual NonnullRefPtr<RenderNode> create_render_node() const { return RenderNode::create_silent(); }
+
 private:
+    void remove_output_connections(Function<bool(Connection const&)> const& predicate);
+
     JS::NonnullGCPtr<BaseAudioContext> m_context;
+
+    Vector<Connection> m_input_connections;
+    // The nodes connected to the outputs of this node, with the input of theirs they are connected to.
+    Vector<Connection> m_output_connections;
+
+    // NOTE: This is created on first use, as it depends on the node type.
+    mutable RefPtr<RenderNode> m_render_node;
     WebIDL::UnsignedLong m_channel_count { 2 };
     Bindings::ChannelCountMode m_channel_count_mode { Bindings::ChannelCountMode::Max };
     Bindings::ChannelInterpretation m_channel_interpretation { Bindings::ChannelInterpretation::Speakers };
@@ -9,6 +9,7 @@
 #include <LibJS/Forward.h>
 #include <LibWeb/Bindings/AudioParamPrototype.h>
 #include <LibWeb/Bindings/PlatformObject.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
 
 namespace Web::WebAudio {
 
@@ -40,6 +41,9 @@ public:
     WebIDL::ExceptionOr<JS::NonnullGCPtr<AudioParam>> cancel_scheduled_values(double cancel_time);
     WebIDL::ExceptionOr<JS::NonnullGCPtr<AudioParam>> cancel_and_hold_at_time(double cancel_time);
 
+    // The value as the rendering thread sees it.
+    NonnullRefPtr<RenderParam> render_param() const { return m_render_param; }
+
 private:
     AudioParam(JS::Realm&, float default_value, float min_value, float max_value, Bindings::AutomationRate);
 
@@ -53,6 +57,8 @@ private:
 
     Bindings::AutomationRate m_automation_rate {};
 
+    NonnullRefPtr<RenderParam> m_render_param;
+
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 };
@@ -29,6 +29,12 @@ protected:
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
+
+    virtual NonnullRefPtr<RenderNode> create_render_node() const override { return ScheduledSourceRenderNode::create(); }
+
+private:
+    // https://webaudio.github.io/web-audio-api/#dom-audioscheduledsourcenode-source-started-slot
+    bool m_source_started { false };
 };
 
 }
@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashMap.h>
 #include <LibWeb/Bindings/BaseAudioContextPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/HTML/EventNames.h>
@@ -127,6 +128,37 @@ void BaseAudioContext::queue_a_media_element_task(JS::NonnullGCPtr<JS::HeapFunct
     HTML::main_thread_event_loop().task_queue().add(task);
 }
 
+// Orders the nodes that feed into the destination so that every node comes after its inputs, for the rendering thread.
+// https://webaudio.github.io/web-audio-api/#rendering-loop
+NonnullRefPtr<RenderGraph> BaseAudioContext::build_render_graph() const
+{
+    Vector<RenderGraph::Entry> entries;
+    // NOTE: A node without an index is still having its inputs visited.
+    HashMap<AudioNode const*, Optional<size_t>> indices;
+
+    auto visit = [&](auto& self, AudioNode const& node) -> Optional<size_t> {
+        if (auto index = indices.get(&node); index.has_value())
+            return *index;
+        indices.set(&node, {});
+
+        Vector<size_t> inputs;
+        for (auto const& connection : node.input_connections()) {
+            // FIXME: Cycles that don't contain a DelayNode should render silence. For now we just skip the connection
+            //        that closes the cycle.
+            if (auto input = self(self, *connection.node); input.has_value())
+                inputs.append(*input);
+        }
+
+        auto index = entries.size();
+        entries.append({ node.render_node(), move(inputs) });
+        indices.set(&node, index);
+        return index;
+    };
+    (void)visit(visit, *m_destination);
+
+    return RenderGraph::create(move(entries));
+}
+
 // https://webaudio.github.io/web-audio-api/#dom-baseaudiocontext-decodeaudiodata
 JS::NonnullGCPtr<JS::Promise> BaseAudioContext::decode_audio_data(JS::Handle<WebIDL::BufferSource> audio_data, JS::GCPtr<WebIDL::CallbackType> success_callback, JS::GCPtr<WebIDL::CallbackType> error_callback)
 {
@@ -12,6 +12,7 @@
 #include <LibWeb/DOM/EventTarget.h>
 #include <LibWeb/WebAudio/AudioListener.h>
 #include <LibWeb/WebAudio/BiquadFilterNode.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
 #include <LibWeb/WebIDL/Types.h>
 
 namespace Web::WebAudio {
@@ -38,7 +39,7 @@ public:
 
     JS::NonnullGCPtr<AudioDestinationNode> destination() const { return m_destination; }
     float sample_rate() const { return m_sample_rate; }
-    double current_time() const { return m_current_time; }
+    virtual double current_time() const { return m_current_time; }
     JS::NonnullGCPtr<AudioListener> listener() const { return m_listener; }
     Bindings::AudioContextState state() const { return m_control_thread_state; }
 
@@ -63,11 +64,16 @@ public:
 
     JS::NonnullGCPtr<JS::Promise> decode_audio_data(JS::Handle<WebIDL::BufferSource>, JS::GCPtr<WebIDL::CallbackType>, JS::GCPtr<WebIDL::CallbackType>);
 
+    // Called whenever nodes are connected or disconnected.
+    virtual void render_graph_did_change() { }
+
 protected:
     explicit BaseAudioContext(JS::Realm&, float m_sample_rate = 0);
 
     void queue_a_media_element_task(JS::NonnullGCPtr<JS::HeapFunction<void()>>);
 
+    NonnullRefPtr<RenderGraph> build_render_graph() const;
+
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
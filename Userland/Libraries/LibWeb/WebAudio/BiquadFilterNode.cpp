@@ -30,6 +30,7 @@ BiquadFilterNode::~BiquadFilterNode() = default;
 WebIDL::ExceptionOr<void> BiquadFilterNode::set_type(Bindings::BiquadFilterType type)
 {
     m_type = type;
+    static_cast<BiquadFilterRenderNode&>(render_node()).set_type(type);
     return {};
 }
 
@@ -88,6 +89,11 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<BiquadFilterNode>> BiquadFilterNode::constr
     return node;
 }
 
+NonnullRefPtr<RenderNode> BiquadFilterNode::create_render_node() const
+{
+    return BiquadFilterRenderNode::create(m_type, { m_frequency->render_param(), m_detune->render_param(), m_q->render_param(), m_gain->render_param() });
+}
+
 void BiquadFilterNode::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
@@ -37,6 +37,18 @@ DynamicsCompressorNode::DynamicsCompressorNode(JS::Realm& realm, JS::NonnullGCPt
 {
 }
 
+// https://webaudio.github.io/web-audio-api/#dom-dynamicscompressornode-reduction
+float DynamicsCompressorNode::reduction() const
+{
+    // NOTE: The rendering thread keeps the [[internal reduction]] slot.
+    return static_cast<DynamicsCompressorRenderNode const&>(render_node()).reduction();
+}
+
+NonnullRefPtr<RenderNode> DynamicsCompressorNode::create_render_node() const
+{
+    return DynamicsCompressorRenderNode::create({ m_threshold->render_param(), m_knee->render_param(), m_ratio->render_param(), m_attack->render_param(), m_release->render_param() });
+}
+
 void DynamicsCompressorNode::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
@@ -38,7 +38,7 @@ public:
     JS::NonnullGCPtr<AudioParam const> ratio() const { return m_ratio; }
     JS::NonnullGCPtr<AudioParam const> attack() const { return m_attack; }
     JS::NonnullGCPtr<AudioParam const> release() const { return m_release; }
-    float reduction() const { return m_reduction; }
+    float reduction() const;
 
 protected:
     DynamicsCompressorNode(JS::Realm&, JS::NonnullGCPtr<BaseAudioContext>, DynamicsCompressorOptions const& = {});
@@ -46,6 +46,8 @@ protected:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual NonnullRefPtr<RenderNode> create_render_node() const override;
+
 private:
     // https://webaudio.github.io/web-audio-api/#dom-dynamicscompressornode-threshold
     JS::NonnullGCPtr<AudioParam> m_threshold;
@@ -61,9 +63,6 @@ private:
 
     // https://webaudio.github.io/web-audio-api/#dom-dynamicscompressornode-release
     JS::NonnullGCPtr<AudioParam> m_release;
-
-    // https://webaudio.github.io/web-audio-api/#dom-dynamicscompressornode-internal-reduction-slot
-    float m_reduction { 0 }; // [[internal reduction]]
 };
 
 }
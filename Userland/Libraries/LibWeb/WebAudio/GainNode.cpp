@@ -34,6 +34,11 @@ GainNode::GainNode(JS::Realm& realm, JS::NonnullGCPtr<BaseAudioContext> context,
 {
 }
 
+NonnullRefPtr<RenderNode> GainNode::create_render_node() const
+{
+    return GainRenderNode::create(m_gain->render_param());
+}
+
 void GainNode::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
@@ -38,6 +38,8 @@ protected:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual NonnullRefPtr<RenderNode> create_render_node() const override;
+
 private:
     // https://webaudio.github.io/web-audio-api/#dom-gainnode-gain
     JS::NonnullGCPtr<AudioParam> m_gain;
@@ -4,10 +4,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibJS/Runtime/TypedArray.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/DOM/Event.h>
 #include <LibWeb/HTML/EventNames.h>
 #include <LibWeb/HTML/Window.h>
+#include <LibWeb/WebAudio/AudioBuffer.h>
 #include <LibWeb/WebAudio/OfflineAudioContext.h>
+#include <LibWeb/WebIDL/Promise.h>
 
 namespace Web::WebAudio {
 
@@ -34,7 +38,89 @@ OfflineAudioContext::~OfflineAudioContext() = default;
 // https://webaudio.github.io/web-audio-api/#dom-offlineaudiocontext-startrendering
 WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> OfflineAudioContext::start_rendering()
 {
-    return WebIDL::NotSupportedError::create(realm(), "FIXME: Implement OfflineAudioContext::start_rendering"_string);
+    auto& realm = this->realm();
+
+    // 1. If this's relevant global object's associated Document is not fully active then return a promise rejected with "InvalidStateError" DOMException.
+    auto const& associated_document = verify_cast<HTML::Window>(HTML::relevant_global_object(*this)).associated_document();
+    if (!associated_document.is_fully_active())
+        return WebIDL::InvalidStateError::create(realm, "Document is not fully active"_string);
+
+    // 2. If the [[rendering started]] slot on the OfflineAudioContext is true, return a rejected promise with InvalidStateError, and abort these steps.
+    if (m_rendering_started)
+        return WebIDL::InvalidStateError::create(realm, "OfflineAudioContext has already started rendering"_string);
+
+    // 3. Set the [[rendering started]] slot of the OfflineAudioContext to true.
+    m_rendering_started = true;
+
+    // 4. Let promise be a new promise.
+    // NOTE: We create the promise after the AudioBuffer, so that an exception from step 5 can reject a promise of its own.
+
+    // 5. Create a new AudioBuffer, with a number of channels, length and sample rate equal respectively to the numberOfChannels, length and sampleRate
+    //    values passed to this instance's constructor in the contextOptions parameter. Assign this buffer to an internal slot [[rendered buffer]] in the OfflineAudioContext.
+    auto buffer_or_exception = AudioBuffer::create(realm, m_number_of_channels, m_length, sample_rate());
+
+    // 6. If an exception was thrown during the preceding AudioBuffer constructor call, reject promise with this exception.
+    if (buffer_or_exception.is_exception())
+        return WebIDL::create_rejected_promise_from_exception(realm, buffer_or_exception.release_error());
+    m_rendered_buffer = buffer_or_exception.release_value();
+    auto promise = WebIDL::create_promise(realm);
+
+    // 7. Otherwise, in the case that the buffer was successfully constructed, begin offline rendering.
+    begin_offline_rendering(promise);
+
+    // 8. Append promise to [[pending promises]].
+    m_pending_promises.append(promise);
+
+    // 9. Return promise.
+    return JS::NonnullGCPtr { verify_cast<JS::Promise>(*promise->promise()) };
+}
+
+// https://webaudio.github.io/web-audio-api/#begin-offline-rendering
+void OfflineAudioContext::begin_offline_rendering(JS::NonnullGCPtr<WebIDL::Promise> promise)
+{
+    auto& realm = this->realm();
+
+    // 1. Given the current connections and scheduled changes, start rendering length sample-frames of audio into [[rendered buffer]].
+    // FIXME: Render on a rendering thread instead of the control thread.
+    // FIXME: Render more than two channels once the render graph supports them. The other channels stay silent.
+    auto channel_count = min<size_t>(m_number_of_channels, AudioBus::max_channel_count);
+    auto renderer = GraphRenderer::create(sample_rate(), channel_count);
+    renderer->set_graph(build_render_graph());
+
+    Vector<Span<float>> channels;
+    for (size_t channel = 0; channel < channel_count; ++channel)
+        channels.append(MUST(m_rendered_buffer->get_channel_data(channel))->data());
+
+    Array<float, render_quantum_size * AudioBus::max_channel_count> interleaved_samples;
+    for (size_t frame = 0; frame < m_length; frame += render_quantum_size) {
+        // FIXME: 2. For every render quantum, check and suspend rendering if necessary.
+        auto frame_count = min<size_t>(m_length - frame, render_quantum_size);
+        auto samples = interleaved_samples.span().trim(frame_count * channel_count);
+        renderer->render(samples);
+
+        for (size_t channel = 0; channel < channel_count; ++channel) {
+            for (size_t i = 0; i < frame_count; ++i)
+                channels[channel][frame + i] = samples[i * channel_count + channel];
+        }
+    }
+
+    // FIXME: 3. If a suspended context is resumed, continue to render the buffer.
+
+    // 4. Once the rendering is complete, queue a media element task to execute the following steps:
+    queue_a_media_element_task(JS::create_heap_function(heap(), [&realm, promise, this]() {
+        // 1. Resolve the promise created by startRendering() with [[rendered buffer]].
+        WebIDL::resolve_promise(realm, promise, m_rendered_buffer);
+        m_pending_promises.remove_first_matching([&promise](auto& pending_promise) {
+            return pending_promise == promise;
+        });
+
+        // 2. Queue a media element task to fire an event named complete using an instance of OfflineAudioCompletionEvent whose renderedBuffer property
+        //    is set to [[rendered buffer]].
+        // FIXME: Fire an OfflineAudioCompletionEvent once it is implemented.
+        queue_a_media_element_task(JS::create_heap_function(heap(), [&realm, this]() {
+            dispatch_event(DOM::Event::create(realm, HTML::EventNames::complete));
+        }));
+    }));
 }
 
 WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> OfflineAudioContext::resume()
@@ -75,8 +161,8 @@ OfflineAudioContext::OfflineAudioContext(JS::Realm& realm, OfflineAudioContextOp
 OfflineAudioContext::OfflineAudioContext(JS::Realm& realm, WebIDL::UnsignedLong number_of_channels, WebIDL::UnsignedLong length, float sample_rate)
     : BaseAudioContext(realm, sample_rate)
     , m_length(length)
+    , m_number_of_channels(number_of_channels)
 {
-    (void)number_of_channels;
 }
 
 void OfflineAudioContext::initialize(JS::Realm& realm)
@@ -88,6 +174,7 @@ void OfflineAudioContext::initialize(JS::Realm& realm)
 void OfflineAudioContext::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
+    visitor.visit(m_rendered_buffer);
 }
 
 }
@@ -48,7 +48,12 @@ private:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    void begin_offline_rendering(JS::NonnullGCPtr<WebIDL::Promise>);
+
     WebIDL::UnsignedLong m_length {};
+    WebIDL::UnsignedLong m_number_of_channels {};
+    bool m_rendering_started { false };
+    JS::GCPtr<AudioBuffer> m_rendered_buffer;
 };
 
 }
@@ -60,9 +60,15 @@ WebIDL::ExceptionOr<void> OscillatorNode::set_type(Bindings::OscillatorType type
 {
     TRY(verify_valid_type(realm(), type));
     m_type = type;
+    static_cast<OscillatorRenderNode&>(render_node()).set_type(type);
     return {};
 }
 
+NonnullRefPtr<RenderNode> OscillatorNode::create_render_node() const
+{
+    return OscillatorRenderNode::create(m_type, m_frequency->render_param());
+}
+
 void OscillatorNode::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
@@ -0,0 +1,515 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
+
+namespace Web::WebAudio {
+
+using AK::SIMD::f32x4;
+
+static_assert(render_quantum_size % 4 == 0);
+
+// destination = source * scale
+static void scale_samples(Span<float> destination, ReadonlySpan<float> source, float scale)
+{
+    auto scale4 = AK::SIMD::expand4(scale);
+    for (size_t i = 0; i < render_quantum_size; i += 4) {
+        auto samples = AK::SIMD::load_unaligned<f32x4>(&source[i]);
+        AK::SIMD::store_unaligned(&destination[i], samples * scale4);
+    }
+}
+
+// destination += source * scale
+static void add_scaled_samples(Span<float> destination, ReadonlySpan<float> source, float scale)
+{
+    auto scale4 = AK::SIMD::expand4(scale);
+    for (size_t i = 0; i < render_quantum_size; i += 4) {
+        auto samples = AK::SIMD::load_unaligned<f32x4>(&destination[i]);
+        samples += AK::SIMD::load_unaligned<f32x4>(&source[i]) * scale4;
+        AK::SIMD::store_unaligned(&destination[i], samples);
+    }
+}
+
+// destination *= gains
+static void multiply_samples(Span<float> destination, ReadonlySpan<float> gains)
+{
+    for (size_t i = 0; i < render_quantum_size; i += 4) {
+        auto samples = AK::SIMD::load_unaligned<f32x4>(&destination[i]);
+        samples *= AK::SIMD::load_unaligned<f32x4>(&gains[i]);
+        AK::SIMD::store_unaligned(&destination[i], samples);
+    }
+}
+
+void AudioBus::clear(size_t new_channel_count)
+{
+    VERIFY(new_channel_count >= 1 && new_channel_count <= max_channel_count);
+    channel_count = new_channel_count;
+    for (size_t i = 0; i < channel_count; ++i)
+        channels[i].fill(0);
+}
+
+// https://webaudio.github.io/web-audio-api/#channel-up-mixing-and-down-mixing
+void AudioBus::mix_from(AudioBus const& other)
+{
+    if (other.channel_count == channel_count) {
+        for (size_t i = 0; i < channel_count; ++i)
+            add_scaled_samples(channel(i), other.channel(i), 1);
+        return;
+    }
+
+    // Mono up-mix: output.L = input; output.R = input;
+    if (other.channel_count == 1) {
+        add_scaled_samples(channel(0), other.channel(0), 1);
+        add_scaled_samples(channel(1), other.channel(0), 1);
+        return;
+    }
+
+    // Mono down-mix: output = 0.5 * (input.L + input.R);
+    add_scaled_samples(channel(0), other.channel(0), 0.5f);
+    add_scaled_samples(channel(0), other.channel(1), 0.5f);
+}
+
+void AudioBus::mix_to_channel_count(size_t new_channel_count)
+{
+    VERIFY(new_channel_count >= 1 && new_channel_count <= max_channel_count);
+    if (new_channel_count == channel_count)
+        return;
+
+    if (channel_count == 1) {
+        channels[1] = channels[0];
+    } else {
+        scale_samples(channel(0), channel(0), 0.5f);
+        add_scaled_samples(channel(0), channel(1), 0.5f);
+    }
+    channel_count = new_channel_count;
+}
+
+NonnullRefPtr<RenderParam> RenderParam::create(float value, float min_value, float max_value)
+{
+    return adopt_ref(*new RenderParam(value, min_value, max_value));
+}
+
+RenderParam::RenderParam(float value, float min_value, float max_value)
+    : m_value(clamp(value, min_value, max_value))
+    , m_min_value(min_value)
+    , m_max_value(max_value)
+{
+}
+
+NonnullRefPtr<RenderNode> RenderNode::create_silent()
+{
+    return adopt_ref(*new RenderNode);
+}
+
+void RenderNode::process(RenderQuantum const&, AudioBus const&, AudioBus& output)
+{
+    output.clear(1);
+}
+
+NonnullRefPtr<PassThroughRenderNode> PassThroughRenderNode::create()
+{
+    return adopt_ref(*new PassThroughRenderNode);
+}
+
+void PassThroughRenderNode::process(RenderQuantum const&, AudioBus const& input, AudioBus& output)
+{
+    output = input;
+}
+
+NonnullRefPtr<ScheduledSourceRenderNode> ScheduledSourceRenderNode::create()
+{
+    return adopt_ref(*new ScheduledSourceRenderNode);
+}
+
+// https://webaudio.github.io/web-audio-api/#dom-audioscheduledsourcenode-start
+// https://webaudio.github.io/web-audio-api/#dom-audioscheduledsourcenode-stop
+ScheduledSourceRenderNode::ActiveFrames ScheduledSourceRenderNode::active_frames(RenderQuantum const& quantum) const
+{
+    auto start_time = m_start_time.load(AK::MemoryOrder::memory_order_acquire);
+    auto stop_time = m_stop_time.load(AK::MemoryOrder::memory_order_acquire);
+    if (start_time == AK::Infinity<double>)
+        return {};
+
+    auto frame_in_quantum = [&](double time) -> size_t {
+        auto frame = AK::ceil(time * quantum.sample_rate) - static_cast<double>(quantum.first_frame);
+        return static_cast<size_t>(clamp(frame, 0.0, static_cast<double>(render_quantum_size)));
+    };
+    auto start = frame_in_quantum(start_time);
+    auto end = frame_in_quantum(stop_time);
+    return { start, max(start, end) };
+}
+
+NonnullRefPtr<OscillatorRenderNode> OscillatorRenderNode::create(Bindings::OscillatorType type, NonnullRefPtr<RenderParam> frequency)
+{
+    return adopt_ref(*new OscillatorRenderNode(type, move(frequency)));
+}
+
+OscillatorRenderNode::OscillatorRenderNode(Bindings::OscillatorType type, NonnullRefPtr<RenderParam> frequency)
+    : m_type(type)
+    , m_frequency(move(frequency))
+{
+}
+
+// https://webaudio.github.io/web-audio-api/#oscillator-coefficients
+// FIXME: These waveforms are not band-limited, so high frequencies alias.
+static float oscillator_sample(Bindings::OscillatorType type, double phase)
+{
+    switch (type) {
+    case Bindings::OscillatorType::Sine:
+        return static_cast<float>(AK::sin(2 * AK::Pi<double> * phase));
+    case Bindings::OscillatorType::Square:
+        return phase < 0.5 ? 1.0f : -1.0f;
+    case Bindings::OscillatorType::Sawtooth:
+        return static_cast<float>(2 * (phase - AK::floor(phase + 0.5)));
+    case Bindings::OscillatorType::Triangle:
+        return static_cast<float>(4 * AK::fabs(phase - AK::floor(phase + 0.75) + 0.25) - 1);
+    case Bindings::OscillatorType::Custom:
+        // FIXME: Render the PeriodicWave.
+        return 0;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void OscillatorRenderNode::process(RenderQuantum const& quantum, AudioBus const&, AudioBus& output)
+{
+    output.clear(1);
+    auto [start, end] = active_frames(quantum);
+    if (start == end)
+        return;
+
+    // FIXME: Follow the frequency for every frame once AudioParam automation is implemented, and apply detune.
+    auto type = m_type.load(AK::MemoryOrder::memory_order_relaxed);
+    auto phase_increment = static_cast<double>(m_frequency->value()) / quantum.sample_rate;
+    auto samples = output.channel(0);
+    for (size_t i = start; i < end; ++i) {
+        samples[i] = oscillator_sample(type, m_phase);
+        m_phase += phase_increment;
+        m_phase -= AK::floor(m_phase);
+    }
+}
+
+NonnullRefPtr<GainRenderNode> GainRenderNode::create(NonnullRefPtr<RenderParam> gain)
+{
+    return adopt_ref(*new GainRenderNode(move(gain)));
+}
+
+GainRenderNode::GainRenderNode(NonnullRefPtr<RenderParam> gain)
+    : m_gain(move(gain))
+{
+}
+
+void GainRenderNode::process(RenderQuantum const&, AudioBus const& input, AudioBus& output)
+{
+    auto gain = m_gain->value();
+    output.channel_count = input.channel_count;
+    for (size_t i = 0; i < input.channel_count; ++i)
+        scale_samples(output.channel(i), input.channel(i), gain);
+}
+
+NonnullRefPtr<BiquadFilterRenderNode> BiquadFilterRenderNode::create(Bindings::BiquadFilterType type, Parameters parameters)
+{
+    return adopt_ref(*new BiquadFilterRenderNode(type, move(parameters)));
+}
+
+BiquadFilterRenderNode::BiquadFilterRenderNode(Bindings::BiquadFilterType type, Parameters parameters)
+    : m_type(type)
+    , m_parameters(move(parameters))
+{
+}
+
+struct BiquadCoefficients {
+    double b0 { 1 };
+    double b1 { 0 };
+    double b2 { 0 };
+    double a1 { 0 };
+    double a2 { 0 };
+};
+
+// https://webaudio.github.io/web-audio-api/#filters-characteristics
+static BiquadCoefficients biquad_coefficients(Bindings::BiquadFilterType type, double frequency, double q, double gain, double sample_rate)
+{
+    // NOTE: We keep the frequency strictly between 0 and the Nyquist frequency, where the formulas below would divide by
+    //       zero. The spec describes the limits separately.
+    auto nyquist = sample_rate / 2;
+    frequency = clamp(frequency, 1.0, nyquist - 1.0);
+
+    auto a = AK::pow(10.0, gain / 40);
+    auto w0 = 2 * AK::Pi<double> * frequency / sample_rate;
+    auto cos_w0 = AK::cos(w0);
+    auto sin_w0 = AK::sin(w0);
+    auto alpha_q = sin_w0 / (2 * q);
+    auto alpha_q_db = sin_w0 / (2 * AK::pow(10.0, q / 20));
+    auto alpha_s = sin_w0 / 2 * AK::sqrt(2.0);
+    auto two_sqrt_a_alpha_s = 2 * AK::sqrt(a) * alpha_s;
+
+    double b0 = 1, b1 = 0, b2 = 0, a0 = 1, a1 = 0, a2 = 0;
+    switch (type) {
+    case Bindings::BiquadFilterType::Lowpass:
+        b0 = (1 - cos_w0) / 2;
+        b1 = 1 - cos_w0;
+        b2 = (1 - cos_w0) / 2;
+        a0 = 1 + alpha_q_db;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q_db;
+        break;
+    case Bindings::BiquadFilterType::Highpass:
+        b0 = (1 + cos_w0) / 2;
+        b1 = -(1 + cos_w0);
+        b2 = (1 + cos_w0) / 2;
+        a0 = 1 + alpha_q_db;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q_db;
+        break;
+    case Bindings::BiquadFilterType::Bandpass:
+        b0 = alpha_q;
+        b1 = 0;
+        b2 = -alpha_q;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Notch:
+        b0 = 1;
+        b1 = -2 * cos_w0;
+        b2 = 1;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Allpass:
+        b0 = 1 - alpha_q;
+        b1 = -2 * cos_w0;
+        b2 = 1 + alpha_q;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Peaking:
+        b0 = 1 + alpha_q * a;
+        b1 = -2 * cos_w0;
+        b2 = 1 - alpha_q * a;
+        a0 = 1 + alpha_q / a;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q / a;
+        break;
+    case Bindings::BiquadFilterType::Lowshelf:
+        b0 = a * ((a + 1) - (a - 1) * cos_w0 + two_sqrt_a_alpha_s);
+        b1 = 2 * a * ((a - 1) - (a + 1) * cos_w0);
+        b2 = a * ((a + 1) - (a - 1) * cos_w0 - two_sqrt_a_alpha_s);
+        a0 = (a + 1) + (a - 1) * cos_w0 + two_sqrt_a_alpha_s;
+        a1 = -2 * ((a - 1) + (a + 1) * cos_w0);
+        a2 = (a + 1) + (a - 1) * cos_w0 - two_sqrt_a_alpha_s;
+        break;
+    case Bindings::BiquadFilterType::Highshelf:
+        b0 = a * ((a + 1) + (a - 1) * cos_w0 + two_sqrt_a_alpha_s);
+        b1 = -2 * a * ((a - 1) + (a + 1) * cos_w0);
+        b2 = a * ((a + 1) + (a - 1) * cos_w0 - two_sqrt_a_alpha_s);
+        a0 = (a + 1) - (a - 1) * cos_w0 + two_sqrt_a_alpha_s;
+        a1 = 2 * ((a - 1) - (a + 1) * cos_w0);
+        a2 = (a + 1) - (a - 1) * cos_w0 - two_sqrt_a_alpha_s;
+        break;
+    }
+
+    return { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+}
+
+void BiquadFilterRenderNode::process(RenderQuantum const& quantum, AudioBus const& input, AudioBus& output)
+{
+    // FIXME: Recompute the coefficients for every frame when any of the parameters are automated.
+    // https://webaudio.github.io/web-audio-api/#computedfrequency
+    auto computed_frequency = m_parameters.frequency->value() * AK::pow(2.0, m_parameters.detune->value() / 1200.0);
+    auto coefficients = biquad_coefficients(m_type.load(AK::MemoryOrder::memory_order_relaxed), computed_frequency, m_parameters.q->value(), m_parameters.gain->value(), quantum.sample_rate);
+
+    // NOTE: The filter depends on its previous output, so it can't be computed four samples at a time like the
+    //       other kernels.
+    output.channel_count = input.channel_count;
+    for (size_t channel = 0; channel < input.channel_count; ++channel) {
+        auto& history = m_history[channel];
+        auto in = input.channel(channel);
+        auto out = output.channel(channel);
+        for (size_t i = 0; i < render_quantum_size; ++i) {
+            double x = in[i];
+            double y = coefficients.b0 * x + coefficients.b1 * history.x1 + coefficients.b2 * history.x2 - coefficients.a1 * history.y1 - coefficients.a2 * history.y2;
+            history.x2 = history.x1;
+            history.x1 = x;
+            history.y2 = history.y1;
+            history.y1 = y;
+            out[i] = static_cast<float>(y);
+        }
+    }
+}
+
+NonnullRefPtr<DynamicsCompressorRenderNode> DynamicsCompressorRenderNode::create(Parameters parameters)
+{
+    return adopt_ref(*new DynamicsCompressorRenderNode(move(parameters)));
+}
+
+DynamicsCompressorRenderNode::DynamicsCompressorRenderNode(Parameters parameters)
+    : m_parameters(move(parameters))
+{
+}
+
+// Returns the output level in decibels for an input level in decibels.
+// https://webaudio.github.io/web-audio-api/#compression-curve
+static float compression_curve(float input_db, float threshold, float knee, float ratio)
+{
+    if (input_db <= threshold - knee / 2)
+        return input_db;
+    if (knee > 0 && input_db < threshold + knee / 2) {
+        auto over = input_db - threshold + knee / 2;
+        return input_db + (1 / ratio - 1) * over * over / (2 * knee);
+    }
+    return threshold + (input_db - threshold) / ratio;
+}
+
+// FIXME: Delay the signal by the spec's 6ms of lookahead.
+void DynamicsCompressorRenderNode::process(RenderQuantum const& quantum, AudioBus const& input, AudioBus& output)
+{
+    auto threshold = m_parameters.threshold->value();
+    auto knee = m_parameters.knee->value();
+    auto ratio = m_parameters.ratio->value();
+    auto attack_time = m_parameters.attack->value();
+    auto release_time = m_parameters.release->value();
+
+    auto smoothing = [&](float time) {
+        return time > 0 ? AK::exp(-1.0f / (time * quantum.sample_rate)) : 0.0f;
+    };
+    auto attack = smoothing(attack_time);
+    auto release = smoothing(release_time);
+
+    // https://webaudio.github.io/web-audio-api/#makeup-gain
+    auto makeup_db = -0.6f * compression_curve(0, threshold, knee, ratio);
+
+    Array<float, render_quantum_size> gains;
+    for (size_t i = 0; i < render_quantum_size; ++i) {
+        float level = 0;
+        for (size_t channel = 0; channel < input.channel_count; ++channel)
+            level = max(level, AK::fabs(input.channel(channel)[i]));
+        auto level_db = level > 0 ? 20 * AK::log10(level) : -1000.0f;
+        auto target = compression_curve(level_db, threshold, knee, ratio) - level_db;
+
+        // The gain goes down at the attack rate and comes back up at the release rate.
+        auto coefficient = target < m_envelope ? attack : release;
+        m_envelope = target + coefficient * (m_envelope - target);
+
+        gains[i] = AK::pow(10.0f, (m_envelope + makeup_db) / 20);
+    }
+    m_reduction.store(m_envelope, AK::MemoryOrder::memory_order_relaxed);
+
+    output = input;
+    for (size_t channel = 0; channel < output.channel_count; ++channel)
+        multiply_samples(output.channel(channel), gains);
+}
+
+NonnullRefPtr<RenderGraph> RenderGraph::create(Vector<Entry> entries)
+{
+    return adopt_ref(*new RenderGraph(move(entries)));
+}
+
+RenderGraph::RenderGraph(Vector<Entry> entries)
+    : m_entries(move(entries))
+{
+    VERIFY(!m_entries.is_empty());
+    m_outputs.resize(m_entries.size());
+}
+
+AudioBus const& RenderGraph::render_quantum(RenderQuantum const& quantum)
+{
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto& entry = m_entries[i];
+
+        size_t channel_count = 1;
+        for (auto input : entry.inputs)
+            channel_count = max(channel_count, m_outputs[input].channel_count);
+
+        m_input.clear(channel_count);
+        for (auto input : entry.inputs)
+            m_input.mix_from(m_outputs[input]);
+
+        entry.node->process(quantum, m_input, m_outputs[i]);
+    }
+    return m_outputs.last();
+}
+
+NonnullRefPtr<GraphRenderer> GraphRenderer::create(float sample_rate, size_t channel_count)
+{
+    return adopt_ref(*new GraphRenderer(sample_rate, channel_count));
+}
+
+GraphRenderer::GraphRenderer(float sample_rate, size_t channel_count)
+    : m_sample_rate(sample_rate)
+    , m_channel_count(channel_count)
+{
+    VERIFY(channel_count >= 1 && channel_count <= AudioBus::max_channel_count);
+}
+
+GraphRenderer::~GraphRenderer()
+{
+    if (auto* graph = m_pending_graph.exchange(nullptr))
+        graph->unref();
+    if (auto* graph = m_retired_graph.exchange(nullptr))
+        graph->unref();
+}
+
+void GraphRenderer::set_graph(NonnullRefPtr<RenderGraph> graph)
+{
+    if (auto* retired_graph = m_retired_graph.exchange(nullptr, AK::MemoryOrder::memory_order_acq_rel))
+        retired_graph->unref();
+    if (auto* replaced_graph = m_pending_graph.exchange(&graph.leak_ref(), AK::MemoryOrder::memory_order_acq_rel))
+        replaced_graph->unref();
+}
+
+void GraphRenderer::pick_up_pending_graph()
+{
+    auto* graph = m_pending_graph.exchange(nullptr, AK::MemoryOrder::memory_order_acq_rel);
+    if (!graph)
+        return;
+
+    auto* previous_graph = m_graph.leak_ref();
+    m_graph = adopt_ref(*graph);
+    if (!previous_graph)
+        return;
+
+    // NOTE: If the control thread has not freed the graph we retired before, the graph changed twice within one
+    //       quantum. That is rare enough that we can afford to free it here.
+    if (auto* unclaimed_graph = m_retired_graph.exchange(previous_graph, AK::MemoryOrder::memory_order_acq_rel))
+        unclaimed_graph->unref();
+}
+
+void GraphRenderer::render(Span<float> interleaved_samples)
+{
+    VERIFY(interleaved_samples.size() % m_channel_count == 0);
+    auto frame_count = interleaved_samples.size() / m_channel_count;
+
+    size_t frame = 0;
+    while (frame < frame_count) {
+        if (m_quantum_offset == render_quantum_size) {
+            pick_up_pending_graph();
+            if (m_graph) {
+                m_quantum = m_graph->render_quantum({ .first_frame = m_next_quantum_frame, .sample_rate = m_sample_rate });
+                m_quantum.mix_to_channel_count(m_channel_count);
+            } else {
+                m_quantum.clear(m_channel_count);
+            }
+            m_quantum_offset = 0;
+            m_next_quantum_frame += render_quantum_size;
+            m_rendered_frames.store(m_next_quantum_frame, AK::MemoryOrder::memory_order_relaxed);
+        }
+
+        auto frames = min(frame_count - frame, render_quantum_size - m_quantum_offset);
+        for (size_t i = 0; i < frames; ++i) {
+            for (size_t channel = 0; channel < m_channel_count; ++channel)
+                interleaved_samples[(frame + i) * m_channel_count + channel] = m_quantum.channel(channel)[m_quantum_offset + i];
+        }
+        frame += frames;
+        m_quantum_offset += frames;
+    }
+}
+
+}
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/Math.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibWeb/Bindings/BiquadFilterNodePrototype.h>
+#include <LibWeb/Bindings/OscillatorNodePrototype.h>
+
+// The classes in this file make up the part of the audio graph that the rendering thread sees. The control thread
+// (the one running JS) only ever talks to them through atomics, so that nothing it does can make the rendering thread
+// wait and drop out. Graph changes are published as a whole new RenderGraph, which the rendering thread picks up
+// at the start of its next render quantum.
+
+namespace Web::WebAudio {
+
+// https://webaudio.github.io/web-audio-api/#render-quantum-size
+static constexpr size_t render_quantum_size = 128;
+
+struct RenderQuantum {
+    u64 first_frame { 0 };
+    float sample_rate { 0 };
+};
+
+// The output of a node for one render quantum.
+// FIXME: Support more than two channels, and the channel count modes and interpretations other than "max" and
+//        "speakers".
+struct AudioBus {
+    static constexpr size_t max_channel_count = 2;
+
+    void clear(size_t new_channel_count);
+    void mix_from(AudioBus const&);
+    void mix_to_channel_count(size_t new_channel_count);
+
+    Span<float> channel(size_t index) { return channels[index]; }
+    ReadonlySpan<float> channel(size_t index) const { return channels[index]; }
+
+    size_t channel_count { 1 };
+    Array<Array<float, render_quantum_size>, max_channel_count> channels {};
+};
+
+// https://webaudio.github.io/web-audio-api/#dom-audioparam-current-value-slot
+class RenderParam final : public AtomicRefCounted<RenderParam> {
+public:
+    static NonnullRefPtr<RenderParam> create(float value, float min_value, float max_value);
+
+    // FIXME: Follow the automation events of the AudioParam, and sum the AudioNodes connected to it.
+    float value() const { return m_value.load(AK::MemoryOrder::memory_order_relaxed); }
+    void set_value(float value) { m_value.store(clamp(value, m_min_value, m_max_value), AK::MemoryOrder::memory_order_relaxed); }
+
+private:
+    RenderParam(float value, float min_value, float max_value);
+
+    Atomic<float> m_value;
+    float m_min_value { 0 };
+    float m_max_value { 0 };
+};
+
+class RenderNode : public AtomicRefCounted<RenderNode> {
+public:
+    static NonnullRefPtr<RenderNode> create_silent();
+
+    virtual ~RenderNode() = default;
+
+    // Renders one quantum from the mix of all the node's inputs. The default renders silence, for nodes whose output
+    // we don't compute yet.
+    virtual void process(RenderQuantum const&, AudioBus const& input, AudioBus& output);
+
+protected:
+    RenderNode() = default;
+};
+
+class PassThroughRenderNode final : public RenderNode {
+public:
+    static NonnullRefPtr<PassThroughRenderNode> create();
+
+    virtual void process(RenderQuantum const&, AudioBus const& input, AudioBus& output) override;
+
+private:
+    PassThroughRenderNode() = default;
+};
+
+// https://webaudio.github.io/web-audio-api/#AudioScheduledSourceNode
+class ScheduledSourceRenderNode : public RenderNode {
+public:
+    // For the sources we don't render yet, which only keep track of when they play.
+    static NonnullRefPtr<ScheduledSourceRenderNode> create();
+
+    void set_start_time(double when) { m_start_time.store(when, AK::MemoryOrder::memory_order_release); }
+    void set_stop_time(double when) { m_stop_time.store(when, AK::MemoryOrder::memory_order_release); }
+
+protected:
+    ScheduledSourceRenderNode() = default;
+
+    struct ActiveFrames {
+        size_t start { 0 };
+        size_t end { 0 };
+    };
+    // Returns which frames of the quantum the source plays in.
+    ActiveFrames active_frames(RenderQuantum const&) const;
+
+private:
+    // NOTE: Infinity for the start time means start() has not been called yet.
+    Atomic<double> m_start_time { AK::Infinity<double> };
+    Atomic<double> m_stop_time { AK::Infinity<double> };
+};
+
+// https://webaudio.github.io/web-audio-api/#OscillatorNode
+class OscillatorRenderNode final : public ScheduledSourceRenderNode {
+public:
+    static NonnullRefPtr<OscillatorRenderNode> create(Bindings::OscillatorType, NonnullRefPtr<RenderParam> frequency);
+
+    void set_type(Bindings::OscillatorType type) { m_type.store(type, AK::MemoryOrder::memory_order_relaxed); }
+
+    virtual void process(RenderQuantum const&, AudioBus const& input, AudioBus& output) override;
+
+private:
+    OscillatorRenderNode(Bindings::OscillatorType, NonnullRefPtr<RenderParam> frequency);
+
+    Atomic<Bindings::OscillatorType> m_type;
+    NonnullRefPtr<RenderParam> m_frequency;
+
+    // Only touched by the rendering thread, in cycles.
+    double m_phase { 0 };
+};
+
+// https://webaudio.github.io/web-audio-api/#GainNode
+class GainRenderNode final : public RenderNode {
+public:
+    static NonnullRefPtr<GainRenderNode> create(NonnullRefPtr<RenderParam> gain);
+
+    virtual void process(RenderQuantum const&, AudioBus const& input, AudioBus& output) override;
+
+private:
+    explicit GainRenderNode(NonnullRefPtr<RenderParam> gain);
+
+    NonnullRefPtr<RenderParam> m_gain;
+};
+
+// https://webaudio.github.io/web-audio-api/#BiquadFilterNode
+class BiquadFilterRenderNode final : public RenderNode {
+public:
+    struct Parameters {
+        NonnullRefPtr<RenderParam> frequency;
+        NonnullRefPtr<RenderParam> detune;
+        NonnullRefPtr<RenderParam> q;
+        NonnullRefPtr<RenderParam> gain;
+    };
+    static NonnullRefPtr<BiquadFilterRenderNode> create(Bindings::BiquadFilterType, Parameters);
+
+    void set_type(Bindings::BiquadFilterType type) { m_type.store(type, AK::MemoryOrder::memory_order_relaxed); }
+
+    virtual void process(RenderQuantum const&, AudioBus const& input, AudioBus& output) override;
+
+private:
+    BiquadFilterRenderNode(Bindings::BiquadFilterType, Parameters);
+
+    Atomic<Bindings::BiquadFilterType> m_type;
+    Parameters m_parameters;
+
+    // Only touched by the rendering thread.
+    struct History {
+        double x1 { 0 };
+        double x2 { 0 };
+        double y1 { 0 };
+        double y2 { 0 };
+    };
+    Array<History, AudioBus::max_channel_count> m_history {};
+};
+
+// https://webaudio.github.io/web-audio-api/#DynamicsCompressorNode
+class DynamicsCompressorRenderNode final : public RenderNode {
+public:
+    struct Parameters {
+        NonnullRefPtr<RenderParam> threshold;
+        NonnullRefPtr<RenderParam> knee;
+        NonnullRefPtr<RenderParam> ratio;
+        NonnullRefPtr<RenderParam> attack;
+        NonnullRefPtr<RenderParam> release;
+    };
+    static NonnullRefPtr<DynamicsCompressorRenderNode> create(Parameters);
+
+    // https://webaudio.github.io/web-audio-api/#dom-dynamicscompressornode-internal-reduction-slot
+    float reduction() const { return m_reduction.load(AK::MemoryOrder::memory_order_relaxed); }
+
+    virtual void process(RenderQuantum const&, AudioBus const& input, AudioBus& output) override;
+
+private:
+    explicit DynamicsCompressorRenderNode(Parameters);
+
+    Parameters m_parameters;
+    Atomic<float> m_reduction { 0 };
+
+    // Only touched by the rendering thread, in decibels.
+    float m_envelope { 0 };
+};
+
+// An immutable schedule of the nodes that feed the destination, in an order where every node comes after all of its
+// inputs. The destination is the last node.
+class RenderGraph final : public AtomicRefCounted<RenderGraph> {
+public:
+    struct Entry {
+        NonnullRefPtr<RenderNode> node;
+        Vector<size_t> inputs;
+    };
+    static NonnullRefPtr<RenderGraph> create(Vector<Entry>);
+
+    AudioBus const& render_quantum(RenderQuantum const&);
+
+private:
+    explicit RenderGraph(Vector<Entry>);
+
+    Vector<Entry> m_entries;
+    Vector<AudioBus> m_outputs;
+    AudioBus m_input;
+};
+
+// Renders the graph that was last handed to it into interleaved samples for an audio output. set_graph() is meant to
+// be called from the control thread and render() from the rendering thread; neither ever blocks the other.
+class GraphRenderer final : public AtomicRefCounted<GraphRenderer> {
+public:
+    static NonnullRefPtr<GraphRenderer> create(float sample_rate, size_t channel_count);
+
+    ~GraphRenderer();
+
+    void set_graph(NonnullRefPtr<RenderGraph>);
+
+    void render(Span<float> interleaved_samples);
+
+    // https://webaudio.github.io/web-audio-api/#dom-baseaudiocontext-currenttime
+    u64 rendered_frames() const { return m_rendered_frames.load(AK::MemoryOrder::memory_order_relaxed); }
+
+private:
+    GraphRenderer(float sample_rate, size_t channel_count);
+
+    void pick_up_pending_graph();
+
+    float m_sample_rate { 0 };
+    size_t m_channel_count { 0 };
+
+    // NOTE: These hold a reference to the graph they point to. The rendering thread swaps out the pending graph, and
+    //       leaves the one it stops using behind as retired for the control thread to free, so that it doesn't have to
+    //       free anything itself.
+    Atomic<RenderGraph*> m_pending_graph { nullptr };
+    Atomic<RenderGraph*> m_retired_graph { nullptr };
+
+    // Only touched by the rendering thread.
+    RefPtr<RenderGraph> m_graph;
+    AudioBus m_quantum;
+    size_t m_quantum_offset { render_quantum_size };
+    u64 m_next_quantum_frame { 0 };
+
+    Atomic<u64> m_rendered_frames { 0 };
+};
+
+}
@@ -230,27 +230,67 @@ ErrorOr<void, Client::WrappedError> Client::on_ready_to_read()
         }
     }
 
-    if (m_remaining_request.is_empty())
-        return {};
-
-    auto maybe_parsed_request = HTTP::HttpRequest::from_raw_request(TRY(m_remaining_request.to_byte_buffer()));
-    if (maybe_parsed_request.is_error()) {
-        if (maybe_parsed_request.error() == HTTP::HttpRequest::ParseError::RequestIncomplete) {
+    // NOTE: Clients may pipeline several commands on a keep-alive connection without waiting for each response, so
+    //       handle every complete request that has arrived, in order, and keep a trailing partial one for the next read.
+    while (!m_remaining_request.is_empty()) {
+        auto request_length = complete_request_length(m_remaining_request.string_view());
+        if (!request_length.has_value()) {
             // If request is not complete we need to wait for more data to arrive
             return {};
         }
-        return maybe_parsed_request.error();
-    }
 
-    m_remaining_request.clear();
-    m_request = maybe_parsed_request.value();
+        auto raw_request = m_remaining_request.string_view().substring_view(0, *request_length);
+        auto maybe_parsed_request = HTTP::HttpRequest::from_raw_request(raw_request.bytes());
+        if (maybe_parsed_request.is_error())
+            return maybe_parsed_request.error();
+
+        auto pipelined_requests = TRY(ByteBuffer::copy(m_remaining_request.string_view().substring_view(*request_length).bytes()));
+        m_remaining_request.clear();
+        TRY(m_remaining_request.try_append(StringView { pipelined_requests }));
 
-    auto body = TRY(read_body_as_json());
-    TRY(handle_request(move(body)));
+        m_request = maybe_parsed_request.release_value();
+
+        auto body = TRY(read_body_as_json());
+        TRY(handle_request(move(body)));
+
+        if (!request_wants_keep_alive())
+            break;
+        m_request = {};
+    }
 
     return {};
 }
 
+Optional<size_t> Client::complete_request_length(StringView data)
+{
+    auto end_of_headers = data.find("\r\n\r\n"sv);
+    if (!end_of_headers.has_value())
+        return {};
+
+    size_t content_length = 0;
+    for (auto line : data.substring_view(0, *end_of_headers).split_view("\r\n"sv)) {
+        auto colon = line.find(':');
+        if (!colon.has_value())
+            continue;
+        if (line.substring_view(0, *colon).trim_whitespace().equals_ignoring_ascii_case("Content-Length"sv)) {
+            content_length = line.substring_view(*colon + 1).to_number<size_t>(TrimWhitespace::Yes).value_or(0);
+            break;
+        }
+    }
+
+    auto length = *end_of_headers + 4 + content_length;
+    if (data.length() < length)
+        return {};
+    return length;
+}
+
+bool Client::request_wants_keep_alive() const
+{
+    if (auto it = m_request->headers().headers().find_if([](auto& header) { return header.name.equals_ignoring_ascii_case("Connection"sv); }); !it.is_end())
+        return it->value.trim_whitespace().equals_ignoring_ascii_case("keep-alive"sv);
+    return false;
+}
+
 ErrorOr<JsonValue, Client::WrappedError> Client::read_body_as_json()
 {
     // FIXME: If we received a multipart body here, this would fail badly.
@@ -285,9 +325,7 @@ ErrorOr<void, Client::WrappedError> Client::handle_request(JsonValue body)
 
 ErrorOr<void, Client::WrappedError> Client::send_success_response(JsonValue result)
 {
-    bool keep_alive = false;
-    if (auto it = m_request->headers().headers().find_if([](auto& header) { return header.name.equals_ignoring_ascii_case("Connection"sv); }); !it.is_end())
-        keep_alive = it->value.trim_whitespace().equals_ignoring_ascii_case("keep-alive"sv);
+    bool keep_alive = request_wants_keep_alive();
 
     result = make_success_response(move(result));
     auto content = result.serialized<StringBuilder>();
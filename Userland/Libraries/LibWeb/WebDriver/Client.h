@@ -124,6 +124,8 @@ private:
 
     void die();
     ErrorOr<void, WrappedError> on_ready_to_read();
+    static Optional<size_t> complete_request_length(StringView);
+    bool request_wants_keep_alive() const;
     ErrorOr<JsonValue, WrappedError> read_body_as_json();
     ErrorOr<void, WrappedError> handle_request(JsonValue body);
     ErrorOr<void, WrappedError> send_success_response(JsonValue result);
@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Base64.h>
 #include <AK/Optional.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageFormats/PNGWriter.h>
 #include <LibGfx/Rect.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/ElementFactory.h>
@@ -33,18 +35,25 @@ static Response encode_canvas_element(HTML::HTMLCanvasElement& canvas)
         return Error::from_code(ErrorCode::UnableToCaptureScreen, "Captured screenshot is empty"sv);
 
     // 3. Let file be a serialization of the canvas element’s bitmap as a file, using "image/png" as an argument.
-    // 4. Let data url be a data: URL representing file. [RFC2397]
-    auto data_url = canvas.to_data_url("image/png"sv, {});
+    // NOTE: Screenshots are taken from the WebContent main thread and mostly consumed by test harnesses, so favor encoding
+    //       speed over file size.
+    Gfx::PNGWriter::Options options;
+    options.compression_level = 1;
 
-    // 5. Let index be the index of "," in data url.
-    auto index = data_url.find_byte_offset(',');
-    VERIFY(index.has_value());
+    auto file = Gfx::PNGWriter::encode(*canvas.bitmap(), options);
+    if (file.is_error())
+        return Error::from_code(ErrorCode::UnableToCaptureScreen, "Unable to encode screenshot"sv);
 
+    // 4. Let data url be a data: URL representing file. [RFC2397]
+    // 5. Let index be the index of "," in data url.
     // 6. Let encoded string be a substring of data url using (index + 1) as the start argument.
-    auto encoded_string = MUST(data_url.substring_from_byte_offset(*index + 1));
+    // NOTE: The substring after "," is just the Base64 encoding of file, so we produce it directly.
+    auto encoded_string = encode_base64(file.value());
+    if (encoded_string.is_error())
+        return Error::from_code(ErrorCode::UnableToCaptureScreen, "Unable to encode screenshot"sv);
 
     // 7. Return success with data encoded string.
-    return JsonValue { move(encoded_string) };
+    return JsonValue { encoded_string.release_value() };
 }
 
 // Common animation callback steps between:
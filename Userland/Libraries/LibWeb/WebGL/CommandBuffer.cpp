@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/WebGL/CommandBuffer.h>
+
+namespace Web::WebGL {
+
+void CommandBuffer::execute(OpenGLContext& context)
+{
+    for (auto const& command : m_commands) {
+        command.visit(
+            [&](ActiveTexture const& command) { context.gl_active_texture(command.texture); },
+            [&](Clear const& command) { context.gl_clear(command.mask); },
+            [&](ClearColor const& command) { context.gl_clear_color(command.red, command.green, command.blue, command.alpha); },
+            [&](ClearDepth const& command) { context.gl_clear_depth(command.depth); },
+            [&](ClearStencil const& command) { context.gl_clear_stencil(command.s); },
+            [&](ColorMask const& command) { context.gl_color_mask(command.red, command.green, command.blue, command.alpha); },
+            [&](CullFace const& command) { context.gl_cull_face(command.mode); },
+            [&](DepthFunc const& command) { context.gl_depth_func(command.func); },
+            [&](DepthMask const& command) { context.gl_depth_mask(command.mask); },
+            [&](DepthRange const& command) { context.gl_depth_range(command.z_near, command.z_far); },
+            [&](Flush const&) { context.gl_flush(); },
+            [&](FrontFace const& command) { context.gl_front_face(command.mode); },
+            [&](LineWidth const& command) { context.gl_line_width(command.width); },
+            [&](PolygonOffset const& command) { context.gl_polygon_offset(command.factor, command.units); },
+            [&](Scissor const& command) { context.gl_scissor(command.x, command.y, command.width, command.height); },
+            [&](StencilOpSeparate const& command) { context.gl_stencil_op_separate(command.face, command.fail, command.zfail, command.zpass); },
+            [&](Viewport const& command) { context.gl_viewport(command.x, command.y, command.width, command.height); });
+    }
+    m_commands.clear_with_capacity();
+}
+
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibWeb/WebGL/OpenGLContext.h>
+#include <LibWeb/WebGL/Types.h>
+
+namespace Web::WebGL {
+
+// Records the GL calls made by a WebGL context so that they can be executed against the OpenGLContext in one batch.
+// Calls that need an answer from GL (e.g. getError) or that hand the drawing buffer off (e.g. present) must execute
+// the recorded commands first.
+class CommandBuffer {
+public:
+    struct ActiveTexture {
+        GLenum texture;
+    };
+    struct Clear {
+        GLbitfield mask;
+    };
+    struct ClearColor {
+        GLfloat red;
+        GLfloat green;
+        GLfloat blue;
+        GLfloat alpha;
+    };
+    struct ClearDepth {
+        GLdouble depth;
+    };
+    struct ClearStencil {
+        GLint s;
+    };
+    struct ColorMask {
+        GLboolean red;
+        GLboolean green;
+        GLboolean blue;
+        GLboolean alpha;
+    };
+    struct CullFace {
+        GLenum mode;
+    };
+    struct DepthFunc {
+        GLenum func;
+    };
+    struct DepthMask {
+        GLboolean mask;
+    };
+    struct DepthRange {
+        GLdouble z_near;
+        GLdouble z_far;
+    };
+    struct Flush {
+    };
+    struct FrontFace {
+        GLenum mode;
+    };
+    struct LineWidth {
+        GLfloat width;
+    };
+    struct PolygonOffset {
+        GLfloat factor;
+        GLfloat units;
+    };
+    struct Scissor {
+        GLint x;
+        GLint y;
+        GLsizei width;
+        GLsizei height;
+    };
+    struct StencilOpSeparate {
+        GLenum face;
+        GLenum fail;
+        GLenum zfail;
+        GLenum zpass;
+    };
+    struct Viewport {
+        GLint x;
+        GLint y;
+        GLsizei width;
+        GLsizei height;
+    };
+
+    using Command = Variant<
+        ActiveTexture,
+        Clear,
+        ClearColor,
+        ClearDepth,
+        ClearStencil,
+        ColorMask,
+        CullFace,
+        DepthFunc,
+        DepthMask,
+        DepthRange,
+        Flush,
+        FrontFace,
+        LineWidth,
+        PolygonOffset,
+        Scissor,
+        StencilOpSeparate,
+        Viewport>;
+
+    void append(Command command) { m_commands.append(move(command)); }
+    bool is_empty() const { return m_commands.is_empty(); }
+
+    // Executes every recorded command in order, then empties the buffer while keeping its storage for the next batch.
+    void execute(OpenGLContext&);
+
+private:
+    Vector<Command> m_commands;
+};
+
+}
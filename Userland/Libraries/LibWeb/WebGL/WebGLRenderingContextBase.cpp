@@ -51,7 +51,8 @@ void WebGLRenderingContextBase::present()
 
     // "Before the drawing buffer is presented for compositing the implementation shall ensure that all rendering operations have been flushed to the drawing buffer."
     // FIXME: Is this the operation it means?
-    m_context->gl_flush();
+    m_command_buffer.append(CommandBuffer::Flush {});
+    execute_recorded_commands();
 
     m_context->present(*canvas_element().bitmap());
 
@@ -87,8 +88,16 @@ void WebGLRenderingContextBase::needs_to_present()
     canvas_element().paintable()->set_needs_display();
 }
 
+void WebGLRenderingContextBase::execute_recorded_commands()
+{
+    if (m_command_buffer.is_empty())
+        return;
+    m_command_buffer.execute(*m_context);
+}
+
 void WebGLRenderingContextBase::set_error(GLenum error)
 {
+    execute_recorded_commands();
     auto context_error = m_context->gl_get_error();
     if (context_error != GL_NO_ERROR)
         m_error = context_error;
@@ -130,7 +139,7 @@ void WebGLRenderingContextBase::active_texture(GLenum texture)
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::active_texture(texture={:#08x})", texture);
-    m_context->gl_active_texture(texture);
+    m_command_buffer.append(CommandBuffer::ActiveTexture { texture });
 }
 
 void WebGLRenderingContextBase::clear(GLbitfield mask)
@@ -139,7 +148,7 @@ void WebGLRenderingContextBase::clear(GLbitfield mask)
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::clear(mask={:#08x})", mask);
-    m_context->gl_clear(mask);
+    m_command_buffer.append(CommandBuffer::Clear { mask });
 
     // FIXME: This should only be done if this is targeting the front buffer.
     needs_to_present();
@@ -151,7 +160,7 @@ void WebGLRenderingContextBase::clear_color(GLclampf red, GLclampf green, GLclam
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::clear_color(red={}, green={}, blue={}, alpha={})", red, green, blue, alpha);
-    m_context->gl_clear_color(red, green, blue, alpha);
+    m_command_buffer.append(CommandBuffer::ClearColor { red, green, blue, alpha });
 }
 
 void WebGLRenderingContextBase::clear_depth(GLclampf depth)
@@ -160,7 +169,7 @@ void WebGLRenderingContextBase::clear_depth(GLclampf depth)
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::clear_depth(depth={})", depth);
-    m_context->gl_clear_depth(depth);
+    m_command_buffer.append(CommandBuffer::ClearDepth { depth });
 }
 
 void WebGLRenderingContextBase::clear_stencil(GLint s)
@@ -169,7 +178,7 @@ void WebGLRenderingContextBase::clear_stencil(GLint s)
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::clear_stencil(s={:#08x})", s);
-    m_context->gl_clear_stencil(s);
+    m_command_buffer.append(CommandBuffer::ClearStencil { s });
 }
 
 void WebGLRenderingContextBase::color_mask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
@@ -178,7 +187,7 @@ void WebGLRenderingContextBase::color_mask(GLboolean red, GLboolean green, GLboo
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::color_mask(red={}, green={}, blue={}, alpha={})", red, green, blue, alpha);
-    m_context->gl_color_mask(red, green, blue, alpha);
+    m_command_buffer.append(CommandBuffer::ColorMask { red, green, blue, alpha });
 }
 
 void WebGLRenderingContextBase::cull_face(GLenum mode)
@@ -187,7 +196,7 @@ void WebGLRenderingContextBase::cull_face(GLenum mode)
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::cull_face(mode={:#08x})", mode);
-    m_context->gl_cull_face(mode);
+    m_command_buffer.append(CommandBuffer::CullFace { mode });
 }
 
 void WebGLRenderingContextBase::depth_func(GLenum func)
@@ -196,7 +205,7 @@ void WebGLRenderingContextBase::depth_func(GLenum func)
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::depth_func(func={:#08x})", func);
-    m_context->gl_depth_func(func);
+    m_command_buffer.append(CommandBuffer::DepthFunc { func });
 }
 
 void WebGLRenderingContextBase::depth_mask(GLboolean mask)
@@ -205,7 +214,7 @@ void WebGLRenderingContextBase::depth_mask(GLboolean mask)
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::depth_mask(mask={})", mask);
-    m_context->gl_depth_mask(mask);
+    m_command_buffer.append(CommandBuffer::DepthMask { mask });
 }
 
 void WebGLRenderingContextBase::depth_range(GLclampf z_near, GLclampf z_far)
@@ -218,7 +227,7 @@ void WebGLRenderingContextBase::depth_range(GLclampf z_near, GLclampf z_far)
     // https://www.khronos.org/registry/webgl/specs/latest/1.0/#VIEWPORT_DEPTH_RANGE
     // "The WebGL API does not support depth ranges with where the near plane is mapped to a value greater than that of the far plane. A call to depthRange will generate an INVALID_OPERATION error if zNear is greater than zFar."
     RETURN_WITH_WEBGL_ERROR_IF(z_near > z_far, GL_INVALID_OPERATION);
-    m_context->gl_depth_range(z_near, z_far);
+    m_command_buffer.append(CommandBuffer::DepthRange { z_near, z_far });
 }
 
 void WebGLRenderingContextBase::finish()
@@ -227,6 +236,7 @@ void WebGLRenderingContextBase::finish()
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::finish()");
+    execute_recorded_commands();
     m_context->gl_finish();
 }
 
@@ -236,6 +246,7 @@ void WebGLRenderingContextBase::flush()
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::flush()");
+    execute_recorded_commands();
     m_context->gl_flush();
 }
 
@@ -245,7 +256,7 @@ void WebGLRenderingContextBase::front_face(GLenum mode)
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::front_face(mode={:#08x})", mode);
-    m_context->gl_front_face(mode);
+    m_command_buffer.append(CommandBuffer::FrontFace { mode });
 }
 
 GLenum WebGLRenderingContextBase::get_error()
@@ -261,6 +272,7 @@ GLenum WebGLRenderingContextBase::get_error()
         return last_error;
     }
 
+    execute_recorded_commands();
     return m_context->gl_get_error();
 }
 
@@ -274,7 +286,7 @@ void WebGLRenderingContextBase::line_width(GLfloat width)
     // https://www.khronos.org/registry/webgl/specs/latest/1.0/#NAN_LINE_WIDTH
     // "In the WebGL API, if the width parameter passed to lineWidth is set to NaN, an INVALID_VALUE error is generated and the line width is not changed."
     RETURN_WITH_WEBGL_ERROR_IF(isnan(width), GL_INVALID_VALUE);
-    m_context->gl_line_width(width);
+    m_command_buffer.append(CommandBuffer::LineWidth { width });
 }
 
 void WebGLRenderingContextBase::polygon_offset(GLfloat factor, GLfloat units)
@@ -283,7 +295,7 @@ void WebGLRenderingContextBase::polygon_offset(GLfloat factor, GLfloat units)
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::polygon_offset(factor={}, units={})", factor, units);
-    m_context->gl_polygon_offset(factor, units);
+    m_command_buffer.append(CommandBuffer::PolygonOffset { factor, units });
 }
 
 void WebGLRenderingContextBase::scissor(GLint x, GLint y, GLsizei width, GLsizei height)
@@ -292,7 +304,7 @@ void WebGLRenderingContextBase::scissor(GLint x, GLint y, GLsizei width, GLsizei
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::scissor(x={}, y={}, width={}, height={})", x, y, width, height);
-    m_context->gl_scissor(x, y, width, height);
+    m_command_buffer.append(CommandBuffer::Scissor { x, y, width, height });
 }
 
 void WebGLRenderingContextBase::stencil_op(GLenum fail, GLenum zfail, GLenum zpass)
@@ -301,7 +313,7 @@ void WebGLRenderingContextBase::stencil_op(GLenum fail, GLenum zfail, GLenum zpa
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::stencil_op(fail={:#08x}, zfail={:#08x}, zpass={:#08x})", fail, zfail, zpass);
-    m_context->gl_stencil_op_separate(GL_FRONT_AND_BACK, fail, zfail, zpass);
+    m_command_buffer.append(CommandBuffer::StencilOpSeparate { GL_FRONT_AND_BACK, fail, zfail, zpass });
 }
 
 void WebGLRenderingContextBase::stencil_op_separate(GLenum face, GLenum fail, GLenum zfail, GLenum zpass)
@@ -310,7 +322,7 @@ void WebGLRenderingContextBase::stencil_op_separate(GLenum face, GLenum fail, GL
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::stencil_op_separate(face={:#08x}, fail={:#08x}, zfail={:#08x}, zpass={:#08x})", face, fail, zfail, zpass);
-    m_context->gl_stencil_op_separate(face, fail, zfail, zpass);
+    m_command_buffer.append(CommandBuffer::StencilOpSeparate { face, fail, zfail, zpass });
 }
 
 void WebGLRenderingContextBase::viewport(GLint x, GLint y, GLsizei width, GLsizei height)
@@ -319,7 +331,7 @@ void WebGLRenderingContextBase::viewport(GLint x, GLint y, GLsizei width, GLsize
         return;
 
     dbgln_if(WEBGL_CONTEXT_DEBUG, "WebGLRenderingContextBase::viewport(x={}, y={}, width={}, height={})", x, y, width, height);
-    m_context->gl_viewport(x, y, width, height);
+    m_command_buffer.append(CommandBuffer::Viewport { x, y, width, height });
 }
 
 }
@@ -12,6 +12,7 @@
 #include <LibJS/Heap/GCPtr.h>
 #include <LibWeb/Bindings/PlatformObject.h>
 #include <LibWeb/Forward.h>
+#include <LibWeb/WebGL/CommandBuffer.h>
 #include <LibWeb/WebGL/OpenGLContext.h>
 #include <LibWeb/WebGL/WebGLContextAttributes.h>
 
@@ -75,6 +76,10 @@ private:
 
     NonnullOwnPtr<OpenGLContext> m_context;
 
+    // GL calls that don't return anything are recorded here and only executed against m_context when something needs
+    // to observe their results, so that a frame's worth of calls reaches GL in one batch.
+    CommandBuffer m_command_buffer;
+
     // https://www.khronos.org/registry/webgl/specs/latest/1.0/#context-creation-parameters
     // Each WebGLRenderingContext has context creation parameters, set upon creation, in a WebGLContextAttributes object.
     WebGLContextAttributes m_context_creation_parameters {};
@@ -98,6 +103,7 @@ private:
     HTML::HTMLCanvasElement& canvas_element();
     HTML::HTMLCanvasElement const& canvas_element() const;
 
+    void execute_recorded_commands();
     void needs_to_present();
     void set_error(GLenum error);
 };
@@ -7,6 +7,7 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/Checked.h>
 #include <AK/Math.h>
 #include <AK/NumericLimits.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -337,6 +338,11 @@ double integer_part(double n)
 template<Integral T>
 JS::ThrowCompletionOr<T> convert_to_int(JS::VM& vm, JS::Value value, EnforceRange enforce_range, Clamp clamp)
 {
+    // NOTE: An Int32 that fits in T comes out of the steps below unchanged whether or not [EnforceRange] or [Clamp] apply,
+    //       and bindings see plenty of them, so skip ToNumber() and the floating-point math for it.
+    if (value.is_int32() && AK::is_within_range<T>(value.as_i32()))
+        return static_cast<T>(value.as_i32());
+
     double upper_bound = 0;
     double lower_bound = 0;
 
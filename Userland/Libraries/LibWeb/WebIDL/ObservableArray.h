@@ -19,7 +19,7 @@ class ObservableArray final : public JS::Array {
 public:
     static JS::NonnullGCPtr<ObservableArray> create(JS::Realm& realm);
 
-    virtual JS::ThrowCompletionOr<bool> internal_set(JS::PropertyKey const& property_key, JS::Value value, JS::Value receiver, JS::CacheablePropertyMetadata* metadata = nullptr) override;
+    virtual JS::ThrowCompletionOr<bool> internal_set(JS::PropertyKey const& property_key, JS::Value value, JS::Value receiver, JS::CacheablePropertyMetadata* metadata = nullptr, PropertyLookupPhase = PropertyLookupPhase::OwnProperty) override;
     virtual JS::ThrowCompletionOr<bool> internal_delete(JS::PropertyKey const& property_key) override;
 
     using SetAnIndexedValueCallbackFunction = Function<ExceptionOr<void>(JS::Value&)>;
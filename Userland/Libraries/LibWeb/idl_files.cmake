@@ -212,6 +212,8 @@ libweb_js_bindings(HTML/NavigationDestination)
 libweb_js_bindings(HTML/NavigationHistoryEntry)
 libweb_js_bindings(HTML/NavigationTransition)
 libweb_js_bindings(HTML/Navigator)
+libweb_js_bindings(HTML/OffscreenCanvas)
+libweb_js_bindings(HTML/OffscreenCanvasRenderingContext2D)
 libweb_js_bindings(HTML/PageTransitionEvent)
 libweb_js_bindings(HTML/Path2D)
 libweb_js_bindings(HTML/Plugin)
@@ -241,9 +243,11 @@ libweb_js_bindings(HTML/WorkerGlobalScope)
 libweb_js_bindings(HTML/WorkerLocation)
 libweb_js_bindings(HTML/WorkerNavigator)
 libweb_js_bindings(HighResolutionTime/Performance)
+libweb_js_bindings(IndexedDB/IDBDatabase)
 libweb_js_bindings(IndexedDB/IDBFactory)
 libweb_js_bindings(IndexedDB/IDBOpenDBRequest)
 libweb_js_bindings(IndexedDB/IDBRequest)
+libweb_js_bindings(IndexedDB/IDBVersionChangeEvent)
 libweb_js_bindings(Internals/Inspector)
 libweb_js_bindings(Internals/InternalAnimationTimeline)
 libweb_js_bindings(Internals/Internals)
@@ -260,6 +264,7 @@ libweb_js_bindings(RequestIdleCallback/IdleDeadline)
 libweb_js_bindings(ResizeObserver/ResizeObserver)
 libweb_js_bindings(ResizeObserver/ResizeObserverEntry)
 libweb_js_bindings(ResizeObserver/ResizeObserverSize)
+libweb_js_bindings(ResourceTiming/PerformanceResourceTiming)
 libweb_js_bindings(Streams/ByteLengthQueuingStrategy)
 libweb_js_bindings(Streams/CountQueuingStrategy)
 libweb_js_bindings(Streams/ReadableByteStreamController)
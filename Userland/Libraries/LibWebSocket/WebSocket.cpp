@@ -145,8 +145,21 @@ void WebSocket::drain_read()
             return;
         }
         auto bytes = result.release_value();
+        if (bytes.is_empty() && m_buffered_data.is_empty()) {
+            // The connection got closed.
+            set_state(WebSocket::InternalState::Closed);
+            notify_close(m_last_close_code, m_last_close_message, true);
+            discard_connection();
+            return;
+        }
         m_buffered_data.append(bytes.data(), bytes.size());
-        read_frame();
+
+        // NOTE: A single read often contains many small frames, so handle all of them now instead of waiting for the
+        //       socket to become readable again. The consumed bytes are dropped from the buffer all at once afterwards.
+        size_t cursor = 0;
+        while ((m_state == WebSocket::InternalState::Open || m_state == WebSocket::InternalState::Closing) && read_frame(cursor))
+            ;
+        m_buffered_data.remove(0, cursor);
     } break;
     case InternalState::Closed:
     case InternalState::Errored: {
@@ -383,12 +396,31 @@ void WebSocket::read_server_handshake()
     // If needed, we will keep reading the header on the next drain_read call
 }
 
-void WebSocket::read_frame()
+// Applies (or removes, which is the same operation) the masking key, as defined in section 5.3
+static void apply_masking_key(Bytes payload, u8 const (&masking_key)[4])
+{
+    // NOTE: XOR eight bytes at a time, which compilers turn into vector instructions where they are available.
+    u8 const repeated_masking_key[8] = { masking_key[0], masking_key[1], masking_key[2], masking_key[3], masking_key[0], masking_key[1], masking_key[2], masking_key[3] };
+    u64 wide_masking_key;
+    __builtin_memcpy(&wide_masking_key, repeated_masking_key, sizeof(wide_masking_key));
+
+    size_t i = 0;
+    for (; i + sizeof(u64) <= payload.size(); i += sizeof(u64)) {
+        u64 chunk;
+        __builtin_memcpy(&chunk, payload.offset_pointer(i), sizeof(chunk));
+        chunk ^= wide_masking_key;
+        __builtin_memcpy(payload.offset_pointer(i), &chunk, sizeof(chunk));
+    }
+    for (; i < payload.size(); ++i)
+        payload[i] ^= masking_key[i % 4];
+}
+
+bool WebSocket::read_frame(size_t& buffered_data_cursor)
 {
     VERIFY(m_impl);
     VERIFY(m_state == WebSocket::InternalState::Open || m_state == WebSocket::InternalState::Closing);
 
-    size_t cursor = 0;
+    size_t cursor = buffered_data_cursor;
     auto get_buffered_bytes = [&](size_t count) -> ReadonlyBytes {
         if (cursor + count > m_buffered_data.size())
             return {};
@@ -397,14 +429,10 @@ void WebSocket::read_frame()
         return bytes;
     };
 
+    // NOTE: If the frame hasn't fully arrived yet, we will keep reading it on the next drain_read call.
     auto head_bytes = get_buffered_bytes(2);
-    if (head_bytes.is_null() || head_bytes.is_empty()) {
-        // The connection got closed.
-        set_state(WebSocket::InternalState::Closed);
-        notify_close(m_last_close_code, m_last_close_message, true);
-        discard_connection();
-        return;
-    }
+    if (head_bytes.is_null())
+        return false;
 
     auto op_code = (WebSocket::OpCode)(head_bytes[0] & 0x0f);
     bool is_final_frame = head_bytes[0] & 0x80;
@@ -417,7 +445,7 @@ void WebSocket::read_frame()
         // A code of 127 means that the next 8 bytes contains the payload length
         auto actual_bytes = get_buffered_bytes(8);
         if (actual_bytes.is_null())
-            return;
+            return false;
         u64 full_payload_length = (u64)((u64)(actual_bytes[0] & 0xff) << 56)
             | (u64)((u64)(actual_bytes[1] & 0xff) << 48)
             | (u64)((u64)(actual_bytes[2] & 0xff) << 40)
@@ -432,7 +460,7 @@ void WebSocket::read_frame()
         // A code of 126 means that the next 2 bytes contains the payload length
         auto actual_bytes = get_buffered_bytes(2);
         if (actual_bytes.is_null())
-            return;
+            return false;
         payload_length = (size_t)((size_t)(actual_bytes[0] & 0xff) << 8)
             | (size_t)((size_t)(actual_bytes[1] & 0xff) << 0);
     } else {
@@ -449,37 +477,24 @@ void WebSocket::read_frame()
     if (is_masked) {
         auto masking_key_data = get_buffered_bytes(4);
         if (masking_key_data.is_null())
-            return;
+            return false;
         masking_key[0] = masking_key_data[0];
         masking_key[1] = masking_key_data[1];
         masking_key[2] = masking_key_data[2];
         masking_key[3] = masking_key_data[3];
     }
 
-    auto payload = ByteBuffer::create_uninitialized(payload_length).release_value_but_fixme_should_propagate_errors(); // FIXME: Handle possible OOM situation.
-    u64 read_length = 0;
-    while (read_length < payload_length) {
-        auto payload_part = get_buffered_bytes(payload_length - read_length);
-        if (payload_part.is_null())
-            return;
-        // We read at most "actual_length - read" bytes, so this is safe to do.
-        payload.overwrite(read_length, payload_part.data(), payload_part.size());
-        read_length += payload_part.size();
-    }
-
-    if (cursor == m_buffered_data.size()) {
-        m_buffered_data.clear();
-    } else {
-        Vector<u8> new_buffered_data;
-        new_buffered_data.append(m_buffered_data.data() + cursor, m_buffered_data.size() - cursor);
-        m_buffered_data = move(new_buffered_data);
-    }
+    if (cursor + payload_length > m_buffered_data.size())
+        return false;
+    // NOTE: The payload is unmasked and read right where it sits in the buffer. Only a complete data message gets
+    //       copied out, since the message owns its data.
+    auto payload = m_buffered_data.span().slice(cursor, payload_length);
+    cursor += payload_length;
+    buffered_data_cursor = cursor;
 
     if (is_masked) {
         // Unmask the payload
-        for (size_t i = 0; i < payload.size(); ++i) {
-            payload[i] = payload[i] ^ (masking_key[i % 4]);
-        }
+        apply_masking_key(payload, masking_key);
     }
 
     if (op_code == WebSocket::OpCode::ConnectionClose) {
@@ -492,16 +507,16 @@ void WebSocket::read_frame()
             m_last_close_code = 1000;
             m_last_close_message = {};
         }
-        return;
+        return true;
     }
     if (op_code == WebSocket::OpCode::Ping) {
         // Immediately send a pong frame as a reply, with the given payload.
         send_frame(WebSocket::OpCode::Pong, payload, true);
-        return;
+        return true;
     }
     if (op_code == WebSocket::OpCode::Pong) {
         // We can safely ignore the pong
-        return;
+        return true;
     }
     if (!is_final_frame) {
         if (op_code != WebSocket::OpCode::Continuation) {
@@ -510,33 +525,38 @@ void WebSocket::read_frame()
         }
         // First and next fragmented message
         m_fragmented_data_buffer.append(payload.data(), payload_length);
-        return;
+        return true;
     }
     if (is_final_frame && op_code == WebSocket::OpCode::Continuation) {
         // Last fragmented message
         m_fragmented_data_buffer.append(payload.data(), payload_length);
         op_code = m_initial_fragment_opcode;
-        payload.clear();
-        payload.append(m_fragmented_data_buffer.data(), m_fragmented_data_buffer.size());
-        m_fragmented_data_buffer.clear();
-    }
-    if (op_code == WebSocket::OpCode::Text) {
-        notify_message(Message(payload, true));
-        return;
-    }
-    if (op_code == WebSocket::OpCode::Binary) {
-        notify_message(Message(payload, false));
-        return;
+        auto message_data = move(m_fragmented_data_buffer);
+        m_fragmented_data_buffer = {};
+        if (op_code == WebSocket::OpCode::Text || op_code == WebSocket::OpCode::Binary) {
+            notify_message(Message(move(message_data), op_code == WebSocket::OpCode::Text));
+            return true;
+        }
+    } else if (op_code == WebSocket::OpCode::Text || op_code == WebSocket::OpCode::Binary) {
+        auto message_data = ByteBuffer::copy(payload).release_value_but_fixme_should_propagate_errors(); // FIXME: Handle possible OOM situation.
+        notify_message(Message(move(message_data), op_code == WebSocket::OpCode::Text));
+        return true;
     }
     dbgln("Websocket: Found unknown opcode {}", (u8)op_code);
+    return true;
 }
 
 void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, bool is_final)
 {
     VERIFY(m_impl);
     VERIFY(m_state == WebSocket::InternalState::Open);
+
+    // NOTE: The whole frame is assembled in a buffer that we keep around, so that sending a frame allocates nothing
+    //       (once the buffer has grown large enough) and only hands a single write to the socket.
+    m_send_buffer.clear_with_capacity();
+
     u8 frame_head[1] = { (u8)((is_final ? 0x80 : 0x00) | ((u8)(op_code) & 0xf)) };
-    m_impl->send(ReadonlyBytes(frame_head, 1));
+    m_send_buffer.append(frame_head, 1);
     // Section 5.1 : a client MUST mask all frames that it sends to the server
     bool has_mask = true;
     // FIXME: If the payload has a size > size_t max on a 32-bit platform, we could
@@ -556,7 +576,7 @@ void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, boo
                 (u8)((payload.size() >> 8) & 0xff),
                 (u8)((payload.size() >> 0) & 0xff),
             };
-            m_impl->send(ReadonlyBytes(payload_length, 9));
+            m_send_buffer.append(payload_length, 9);
         } else {
             u8 payload_length[9] = {
                 (u8)((has_mask ? 0x80 : 0x00) | 127),
@@ -569,7 +589,7 @@ void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, boo
                 (u8)((payload.size() >> 8) & 0xff),
                 (u8)((payload.size() >> 0) & 0xff),
             };
-            m_impl->send(ReadonlyBytes(payload_length, 9));
+            m_send_buffer.append(payload_length, 9);
         }
     } else if (payload.size() >= 126) {
         // Send (the 'mask' flag + 126) + the 2-byte payload length
@@ -578,13 +598,13 @@ void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, boo
             (u8)((payload.size() >> 8) & 0xff),
             (u8)((payload.size() >> 0) & 0xff),
         };
-        m_impl->send(ReadonlyBytes(payload_length, 3));
+        m_send_buffer.append(payload_length, 3);
     } else {
         // Send the mask flag + the payload in a single byte
         u8 payload_length[1] = {
             (u8)((has_mask ? 0x80 : 0x00) | (u8)(payload.size() & 0x7f)),
         };
-        m_impl->send(ReadonlyBytes(payload_length, 1));
+        m_send_buffer.append(payload_length, 1);
     }
     if (has_mask) {
         // Section 10.3 :
@@ -592,22 +612,17 @@ void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, boo
         // > that cannot be predicted by end applications that provide data
         u8 masking_key[4];
         fill_with_random(masking_key);
-        m_impl->send(ReadonlyBytes(masking_key, 4));
-        // don't try to send empty payload
-        if (payload.size() == 0)
-            return;
+        m_send_buffer.append(masking_key, 4);
+
         // Mask the payload
-        auto buffer_result = ByteBuffer::create_uninitialized(payload.size());
-        if (!buffer_result.is_error()) {
-            auto& masked_payload = buffer_result.value();
-            for (size_t i = 0; i < payload.size(); ++i) {
-                masked_payload[i] = payload[i] ^ (masking_key[i % 4]);
-            }
-            m_impl->send(masked_payload);
-        }
-    } else if (payload.size() > 0) {
-        m_impl->send(payload);
+        auto payload_offset = m_send_buffer.size();
+        m_send_buffer.append(payload.data(), payload.size());
+        apply_masking_key(m_send_buffer.span().slice(payload_offset), masking_key);
+    } else {
+        m_send_buffer.append(payload.data(), payload.size());
     }
+
+    m_impl->send(m_send_buffer.span());
 }
 
 void WebSocket::fatal_error(WebSocket::Error error)
@@ -89,7 +89,7 @@ private:
     void send_client_handshake();
     void read_server_handshake();
 
-    void read_frame();
+    bool read_frame(size_t& buffered_data_cursor);
     void send_frame(OpCode, ReadonlyBytes, bool is_final);
 
     void notify_open();
@@ -134,6 +134,7 @@ private:
     RefPtr<WebSocketImpl> m_impl;
 
     Vector<u8> m_buffered_data;
+    Vector<u8> m_send_buffer;
     ByteBuffer m_fragmented_data_buffer;
     WebSocket::OpCode m_initial_fragment_opcode;
 };
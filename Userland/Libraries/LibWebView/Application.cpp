@@ -10,11 +10,14 @@
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibCore/TimeZoneWatcher.h>
+#include <LibCore/Timer.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibImageDecoderClient/Client.h>
+#include <LibWeb/Worker/WebWorkerClient.h>
 #include <LibWebView/Application.h>
 #include <LibWebView/CookieJar.h>
 #include <LibWebView/Database.h>
+#include <LibWebView/StorageJar.h>
 #include <LibWebView/URL.h>
 #include <LibWebView/UserAgent.h>
 #include <LibWebView/WebContentClient.h>
@@ -23,6 +26,8 @@ namespace WebView {
 
 Application* Application::s_the = nullptr;
 
+static constexpr int memory_pressure_sampling_interval_ms = 5000;
+
 Application::Application()
 {
     VERIFY(!s_the);
@@ -73,11 +78,16 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
     Optional<StringView> user_agent_preset;
     bool log_all_js_exceptions = false;
     bool enable_idl_tracing = false;
+    bool enable_paint_tracing = false;
     bool enable_http_cache = false;
     bool enable_autoplay = false;
     bool expose_internals_object = false;
     bool force_cpu_painting = false;
     bool force_fontconfig = false;
+    size_t spare_web_content_processes = 1;
+    size_t spare_web_worker_processes = 1;
+    size_t memory_pressure_process_limit_mib = 0;
+    size_t memory_pressure_total_limit_mib = 0;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("The Ladybird web browser :^)");
@@ -93,11 +103,16 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
     args_parser.add_option(webdriver_content_ipc_path, "Path to WebDriver IPC for WebContent", "webdriver-content-path", 0, "path", Core::ArgsParser::OptionHideMode::CommandLineAndMarkdown);
     args_parser.add_option(log_all_js_exceptions, "Log all JavaScript exceptions", "log-all-js-exceptions");
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
+    args_parser.add_option(enable_paint_tracing, "Enable paint tracing", "enable-paint-tracing");
     args_parser.add_option(enable_http_cache, "Enable HTTP cache", "enable-http-cache");
     args_parser.add_option(enable_autoplay, "Enable multimedia autoplay", "enable-autoplay");
     args_parser.add_option(expose_internals_object, "Expose internals object", "expose-internals-object");
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
+    args_parser.add_option(spare_web_content_processes, "Number of WebContent processes to keep ready for new views", "spare-web-content-processes", 0, "count");
+    args_parser.add_option(spare_web_worker_processes, "Number of WebWorker processes to keep ready for new workers", "spare-web-worker-processes", 0, "count");
+    args_parser.add_option(memory_pressure_process_limit_mib, "Ask processes that use more memory than this to free what they can", "memory-pressure-process-limit", 0, "MiB");
+    args_parser.add_option(memory_pressure_total_limit_mib, "Ask processes to free what memory they can when they use more than this together", "memory-pressure-total-limit", 0, "MiB");
     args_parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
         .help_string = "Name of the User-Agent preset to use in place of the default User-Agent",
@@ -125,6 +140,13 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
     if (profile_process.has_value())
         profile_process_type = process_type_from_name(*profile_process);
 
+    // A spare process would be the one that waits for the debugger or gets profiled, rather than the one for the view
+    // that is opened next.
+    if (debug_process_type == ProcessType::WebContent || profile_process_type == ProcessType::WebContent)
+        spare_web_content_processes = 0;
+    if (debug_process_type == ProcessType::WebWorker || profile_process_type == ProcessType::WebWorker)
+        spare_web_worker_processes = 0;
+
     m_chrome_options = {
         .urls = sanitize_urls(raw_urls, new_tab_page_url),
         .raw_urls = move(raw_urls),
@@ -137,6 +159,10 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
         .disable_sql_database = disable_sql_database ? DisableSQLDatabase::Yes : DisableSQLDatabase::No,
         .debug_helper_process = move(debug_process_type),
         .profile_helper_process = move(profile_process_type),
+        .spare_web_content_processes = spare_web_content_processes,
+        .spare_web_worker_processes = spare_web_worker_processes,
+        .memory_pressure_process_limit_mib = memory_pressure_process_limit_mib,
+        .memory_pressure_total_limit_mib = memory_pressure_total_limit_mib,
     };
 
     if (webdriver_content_ipc_path.has_value())
@@ -148,6 +174,7 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
         .user_agent_preset = move(user_agent_preset),
         .log_all_js_exceptions = log_all_js_exceptions ? LogAllJSExceptions::Yes : LogAllJSExceptions::No,
         .enable_idl_tracing = enable_idl_tracing ? EnableIDLTracing::Yes : EnableIDLTracing::No,
+        .enable_paint_tracing = enable_paint_tracing ? EnablePaintTracing::Yes : EnablePaintTracing::No,
         .enable_http_cache = enable_http_cache ? EnableHTTPCache::Yes : EnableHTTPCache::No,
         .expose_internals_object = expose_internals_object ? ExposeInternalsObject::Yes : ExposeInternalsObject::No,
         .force_cpu_painting = force_cpu_painting ? ForceCPUPainting::Yes : ForceCPUPainting::No,
@@ -157,11 +184,22 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
 
     create_platform_options(m_chrome_options, m_web_content_options);
 
+    m_process_manager.set_memory_pressure_limits(m_chrome_options.memory_pressure_process_limit_mib * MiB, m_chrome_options.memory_pressure_total_limit_mib * MiB);
+    if (m_process_manager.has_memory_pressure_limits()) {
+        m_memory_pressure_timer = Core::Timer::create_repeating(memory_pressure_sampling_interval_ms, [this] {
+            m_process_manager.update_all_process_statistics();
+            m_process_manager.notify_processes_under_memory_pressure();
+        });
+        m_memory_pressure_timer->start();
+    }
+
     if (m_chrome_options.disable_sql_database == DisableSQLDatabase::No) {
         m_database = Database::create().release_value_but_fixme_should_propagate_errors();
         m_cookie_jar = CookieJar::create(*m_database).release_value_but_fixme_should_propagate_errors();
+        m_storage_jar = StorageJar::create(*m_database).release_value_but_fixme_should_propagate_errors();
     } else {
         m_cookie_jar = CookieJar::create();
+        m_storage_jar = StorageJar::create();
     }
 }
 
@@ -184,6 +222,40 @@ void Application::set_process_mach_port(pid_t pid, Core::MachPort&& port)
 }
 #endif
 
+RefPtr<WebContentClient> Application::take_spare_web_content_client()
+{
+    if (m_spare_web_content_clients.is_empty())
+        return nullptr;
+    return m_spare_web_content_clients.take_first();
+}
+
+void Application::add_spare_web_content_client(NonnullRefPtr<WebContentClient> client)
+{
+    m_spare_web_content_clients.append(move(client));
+}
+
+bool Application::needs_spare_web_content_client() const
+{
+    return !m_in_shutdown && m_spare_web_content_clients.size() < m_chrome_options.spare_web_content_processes;
+}
+
+RefPtr<Web::HTML::WebWorkerClient> Application::take_spare_web_worker_client()
+{
+    if (m_spare_web_worker_clients.is_empty())
+        return nullptr;
+    return m_spare_web_worker_clients.take_first();
+}
+
+void Application::add_spare_web_worker_client(NonnullRefPtr<Web::HTML::WebWorkerClient> client)
+{
+    m_spare_web_worker_clients.append(move(client));
+}
+
+bool Application::needs_spare_web_worker_client() const
+{
+    return !m_in_shutdown && m_spare_web_worker_clients.size() < m_chrome_options.spare_web_worker_processes;
+}
+
 Optional<Process&> Application::find_process(pid_t pid)
 {
     return m_process_manager.find_process(pid);
@@ -194,6 +266,11 @@ void Application::update_process_statistics()
     m_process_manager.update_all_process_statistics();
 }
 
+Optional<u64> Application::process_memory_usage(pid_t pid)
+{
+    return m_process_manager.memory_usage_of_process(pid);
+}
+
 String Application::generate_process_statistics_html()
 {
     return m_process_manager.generate_html();
@@ -220,12 +297,24 @@ void Application::process_did_exit(Process&& process)
         break;
     case ProcessType::WebContent:
         if (auto client = process.client<WebContentClient>(); client.has_value()) {
+            // NOTE: There is no view to tell about spare processes, they are just replaced the next time a view is opened.
+            auto was_spare = m_spare_web_content_clients.remove_first_matching([&](auto const& spare_client) {
+                return spare_client.ptr() == &client.value();
+            });
+            if (was_spare)
+                break;
+
             dbgln_if(WEBVIEW_PROCESS_DEBUG, "Restart WebContent process");
             if (auto on_web_content_process_crash = move(client->on_web_content_process_crash))
                 on_web_content_process_crash();
         }
         break;
     case ProcessType::WebWorker:
+        if (auto client = process.client<Web::HTML::WebWorkerClient>(); client.has_value()) {
+            m_spare_web_worker_clients.remove_first_matching([&](auto const& spare_client) {
+                return spare_client.ptr() == &client.value();
+            });
+        }
         dbgln_if(WEBVIEW_PROCESS_DEBUG, "WebWorker {} died, not sure what to do.", process.pid());
         break;
     case ProcessType::Chrome:
@@ -15,6 +15,7 @@
 #include <LibCore/Forward.h>
 #include <LibMain/Main.h>
 #include <LibURL/URL.h>
+#include <LibWeb/Forward.h>
 #include <LibWebView/Options.h>
 #include <LibWebView/Process.h>
 #include <LibWebView/ProcessManager.h>
@@ -35,11 +36,22 @@ public:
     static WebContentOptions const& web_content_options() { return the().m_web_content_options; }
 
     static CookieJar& cookie_jar() { return *the().m_cookie_jar; }
+    static StorageJar& storage_jar() { return *the().m_storage_jar; }
 
     Core::EventLoop& event_loop() { return m_event_loop; }
 
     void add_child_process(Process&&);
 
+    // Spare WebContent processes are launched ahead of time, so that new views don't have to wait for one to start up.
+    RefPtr<WebContentClient> take_spare_web_content_client();
+    void add_spare_web_content_client(NonnullRefPtr<WebContentClient>);
+    bool needs_spare_web_content_client() const;
+
+    // Likewise, spare WebWorker processes save new workers from waiting for their VM to be set up.
+    RefPtr<Web::HTML::WebWorkerClient> take_spare_web_worker_client();
+    void add_spare_web_worker_client(NonnullRefPtr<Web::HTML::WebWorkerClient>);
+    bool needs_spare_web_worker_client() const;
+
     // FIXME: Should these methods be part of Application, instead of deferring to ProcessManager?
 #if defined(AK_OS_MACH)
     void set_process_mach_port(pid_t, Core::MachPort&&);
@@ -48,6 +60,7 @@ public:
 
     // FIXME: Should we just expose the ProcessManager via a getter?
     void update_process_statistics();
+    Optional<u64> process_memory_usage(pid_t);
     String generate_process_statistics_html();
 
     ErrorOr<LexicalPath> path_for_downloaded_file(StringView file) const;
@@ -81,11 +94,15 @@ private:
 
     RefPtr<Database> m_database;
     OwnPtr<CookieJar> m_cookie_jar;
+    OwnPtr<StorageJar> m_storage_jar;
 
     OwnPtr<Core::TimeZoneWatcher> m_time_zone_watcher;
 
     Core::EventLoop m_event_loop;
     ProcessManager m_process_manager;
+    RefPtr<Core::Timer> m_memory_pressure_timer;
+    Vector<NonnullRefPtr<WebContentClient>> m_spare_web_content_clients;
+    Vector<NonnullRefPtr<Web::HTML::WebWorkerClient>> m_spare_web_worker_clients;
     bool m_in_shutdown { false };
 } SWIFT_IMMORTAL_REFERENCE;
 
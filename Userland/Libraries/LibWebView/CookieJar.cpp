@@ -46,6 +46,8 @@ ErrorOr<NonnullOwnPtr<CookieJar>> CookieJar::create(Database& database)
     statements.insert_cookie = TRY(database.prepare_statement("INSERT OR REPLACE INTO Cookies VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);"sv));
     statements.expire_cookie = TRY(database.prepare_statement("DELETE FROM Cookies WHERE (expiry_time < ?);"sv));
     statements.select_all_cookies = TRY(database.prepare_statement("SELECT * FROM Cookies;"sv));
+    statements.begin_transaction = TRY(database.prepare_statement("BEGIN TRANSACTION;"sv));
+    statements.commit_transaction = TRY(database.prepare_statement("COMMIT;"sv));
 
     return adopt_own(*new CookieJar { PersistedStorage { database, statements } });
 }
@@ -68,11 +70,20 @@ CookieJar::CookieJar(Optional<PersistedStorage> persisted_storage)
     m_persisted_storage->synchronization_timer = Core::Timer::create_repeating(
         static_cast<int>(DATABASE_SYNCHRONIZATION_TIMER.to_milliseconds()),
         [this]() {
+            auto& database = m_persisted_storage->database;
+            auto const& statements = m_persisted_storage->statements;
+
+            // NOTE: Without a transaction, sqlite commits and syncs to disk after every single statement, which adds up
+            //       quickly for pages that set hundreds of cookies.
+            database.execute_statement(statements.begin_transaction, {});
+
             for (auto const& it : m_transient_storage.take_dirty_cookies())
                 m_persisted_storage->insert_cookie(it.value);
 
             auto now = m_transient_storage.purge_expired_cookies();
-            m_persisted_storage->database.execute_statement(m_persisted_storage->statements.expire_cookie, {}, now);
+            database.execute_statement(statements.expire_cookie, {}, now);
+
+            database.execute_statement(statements.commit_transaction, {});
         });
     m_persisted_storage->synchronization_timer->start();
 }
@@ -557,10 +568,13 @@ Vector<Web::Cookie::Cookie> CookieJar::get_matching_cookies(const URL::URL& url,
 {
     auto now = UnixDateTime::now();
 
+    auto request_path = url.serialize_path();
+    auto is_secure = url.scheme() == "https"sv;
+
     // 1. Let cookie-list be the set of cookies from the cookie store that meets all of the following requirements:
     Vector<Web::Cookie::Cookie> cookie_list;
 
-    m_transient_storage.for_each_cookie([&](Web::Cookie::Cookie& cookie) {
+    auto match_cookie = [&](Web::Cookie::Cookie& cookie) {
         // * Either:
         //     The cookie's host-only-flag is true and the canonicalized host of the retrieval's URI is identical to
         //     the cookie's domain.
@@ -574,12 +588,12 @@ Vector<Web::Cookie::Cookie> CookieJar::get_matching_cookies(const URL::URL& url,
             return;
 
         // * The retrieval's URI's path path-matches the cookie's path.
-        if (!path_matches(url.serialize_path(), cookie.path))
+        if (!path_matches(request_path, cookie.path))
             return;
 
         // * If the cookie's secure-only-flag is true, then the retrieval's URI must denote a "secure" connection (as
         //   defined by the user agent).
-        if (cookie.secure && url.scheme() != "https"sv)
+        if (cookie.secure && !is_secure)
             return;
 
         // * If the cookie's http-only-flag is true, then exclude the cookie if the retrieval's type is "non-HTTP".
@@ -623,7 +637,20 @@ Vector<Web::Cookie::Cookie> CookieJar::get_matching_cookies(const URL::URL& url,
 
             return false;
         });
-    });
+    };
+
+    // NOTE: The only domains that the canonicalized host can domain-match are the host itself, and the domains that are
+    //       left when dropping its labels from the left one by one, which is all we need to look at.
+    m_transient_storage.for_each_cookie_on_domain(canonicalized_domain, match_cookie);
+    if (!AK::IPv4Address::from_string(canonicalized_domain).has_value()) {
+        for (auto domain = canonicalized_domain; true;) {
+            auto dot = domain.find('.');
+            if (!dot.has_value())
+                break;
+            domain = domain.substring_view(*dot + 1);
+            m_transient_storage.for_each_cookie_on_domain(domain, match_cookie);
+        }
+    }
 
     if (mode != MatchingCookiesSpecMode::WebDriver)
         m_transient_storage.purge_expired_cookies();
@@ -633,19 +660,36 @@ Vector<Web::Cookie::Cookie> CookieJar::get_matching_cookies(const URL::URL& url,
 
 void CookieJar::TransientStorage::set_cookies(Cookies cookies)
 {
-    m_cookies = move(cookies);
+    m_cookies_by_domain.clear();
+    m_size = 0;
+    m_next_expiry_time = {};
+
+    for (auto& it : cookies) {
+        if (!m_next_expiry_time.has_value() || it.value.expiry_time < *m_next_expiry_time)
+            m_next_expiry_time = it.value.expiry_time;
+        m_cookies_by_domain.ensure(it.key.domain).set(it.key, move(it.value));
+        ++m_size;
+    }
+
     purge_expired_cookies();
 }
 
 void CookieJar::TransientStorage::set_cookie(CookieStorageKey key, Web::Cookie::Cookie cookie)
 {
-    m_cookies.set(key, cookie);
+    if (!m_next_expiry_time.has_value() || cookie.expiry_time < *m_next_expiry_time)
+        m_next_expiry_time = cookie.expiry_time;
+
+    if (m_cookies_by_domain.ensure(key.domain).set(key, cookie) == HashSetResult::InsertedNewEntry)
+        ++m_size;
     m_dirty_cookies.set(move(key), move(cookie));
 }
 
 Optional<Web::Cookie::Cookie> CookieJar::TransientStorage::get_cookie(CookieStorageKey const& key)
 {
-    return m_cookies.get(key);
+    auto it = m_cookies_by_domain.find(key.domain);
+    if (it == m_cookies_by_domain.end())
+        return {};
+    return it->value.get(key);
 }
 
 UnixDateTime CookieJar::TransientStorage::purge_expired_cookies(Optional<AK::Duration> offset)
@@ -658,8 +702,25 @@ UnixDateTime CookieJar::TransientStorage::purge_expired_cookies(Optional<AK::Dur
             cookie.value.expiry_time -= *offset;
     }
 
-    auto is_expired = [&](auto const&, auto const& cookie) { return cookie.expiry_time < now; };
-    m_cookies.remove_all_matching(is_expired);
+    // NOTE: This is called whenever cookies are read or written, so we avoid looking at all of them when we know that
+    //       none has expired yet.
+    if (!m_next_expiry_time.has_value() || now <= *m_next_expiry_time)
+        return now;
+
+    m_next_expiry_time = {};
+
+    m_cookies_by_domain.remove_all_matching([&](auto const&, Cookies& cookies) {
+        cookies.remove_all_matching([&](auto const&, auto const& cookie) {
+            if (cookie.expiry_time < now) {
+                --m_size;
+                return true;
+            }
+            if (!m_next_expiry_time.has_value() || cookie.expiry_time < *m_next_expiry_time)
+                m_next_expiry_time = cookie.expiry_time;
+            return false;
+        });
+        return cookies.is_empty();
+    });
 
     return now;
 }
@@ -35,6 +35,8 @@ class CookieJar {
         Database::StatementID insert_cookie { 0 };
         Database::StatementID expire_cookie { 0 };
         Database::StatementID select_all_cookies { 0 };
+        Database::StatementID begin_transaction { 0 };
+        Database::StatementID commit_transaction { 0 };
     };
 
     class TransientStorage {
@@ -45,7 +47,7 @@ class CookieJar {
         void set_cookie(CookieStorageKey, Web::Cookie::Cookie);
         Optional<Web::Cookie::Cookie> get_cookie(CookieStorageKey const&);
 
-        size_t size() const { return m_cookies.size(); }
+        size_t size() const { return m_size; }
 
         UnixDateTime purge_expired_cookies(Optional<AK::Duration> offset = {});
 
@@ -53,22 +55,47 @@ class CookieJar {
 
         template<typename Callback>
         void for_each_cookie(Callback callback)
+        {
+            for (auto& it : m_cookies_by_domain) {
+                if (for_each_cookie_in(it.value, callback) == IterationDecision::Break)
+                    return;
+            }
+        }
+
+        // Only visits the cookies whose domain is exactly the given one.
+        template<typename Callback>
+        void for_each_cookie_on_domain(StringView domain, Callback callback)
+        {
+            if (auto it = m_cookies_by_domain.find(domain); it != m_cookies_by_domain.end())
+                for_each_cookie_in(it->value, callback);
+        }
+
+    private:
+        template<typename Callback>
+        static IterationDecision for_each_cookie_in(Cookies& cookies, Callback& callback)
         {
             using ReturnType = InvokeResult<Callback, Web::Cookie::Cookie&>;
 
-            for (auto& it : m_cookies) {
+            for (auto& it : cookies) {
                 if constexpr (IsSame<ReturnType, IterationDecision>) {
                     if (callback(it.value) == IterationDecision::Break)
-                        return;
+                        return IterationDecision::Break;
                 } else {
                     static_assert(IsSame<ReturnType, void>);
                     callback(it.value);
                 }
             }
+            return IterationDecision::Continue;
         }
 
-    private:
-        Cookies m_cookies;
+        // NOTE: Cookies are grouped by their domain, so that the cookies for a URL can be found by looking at the domains
+        //       that its host domain-matches, rather than at every cookie we have.
+        HashMap<String, Cookies> m_cookies_by_domain;
+        size_t m_size { 0 };
+
+        // No cookie expires before this, so there's nothing to purge until then.
+        Optional<UnixDateTime> m_next_expiry_time;
+
         Cookies m_dirty_cookies;
     };
 
@@ -15,6 +15,7 @@ class Database;
 class InspectorClient;
 class OutOfProcessWebView;
 class ProcessManager;
+class StorageJar;
 class ViewImplementation;
 class WebContentClient;
 
@@ -58,6 +58,13 @@ struct ChromeOptions {
     Optional<ProcessType> debug_helper_process {};
     Optional<ProcessType> profile_helper_process {};
     Optional<ByteString> webdriver_content_ipc_path {};
+    size_t spare_web_content_processes { 1 };
+    size_t spare_web_worker_processes { 1 };
+
+    // Processes are asked to free what memory they can when one of them uses more than the per-process limit, or all
+    // of them together use more than the total limit. Zero means no limit.
+    size_t memory_pressure_process_limit_mib { 0 };
+    size_t memory_pressure_total_limit_mib { 0 };
 };
 
 enum class IsLayoutTestMode {
@@ -75,6 +82,11 @@ enum class EnableIDLTracing {
     Yes,
 };
 
+enum class EnablePaintTracing {
+    No,
+    Yes,
+};
+
 enum class EnableHTTPCache {
     No,
     Yes,
@@ -103,6 +115,7 @@ struct WebContentOptions {
     IsLayoutTestMode is_layout_test_mode { IsLayoutTestMode::No };
     LogAllJSExceptions log_all_js_exceptions { LogAllJSExceptions::No };
     EnableIDLTracing enable_idl_tracing { EnableIDLTracing::No };
+    EnablePaintTracing enable_paint_tracing { EnablePaintTracing::No };
     EnableHTTPCache enable_http_cache { EnableHTTPCache::No };
     ExposeInternalsObject expose_internals_object { ExposeInternalsObject::No };
     ForceCPUPainting force_cpu_painting { ForceCPUPainting::No };
@@ -15,6 +15,8 @@ enum class PageInfoType {
     LayoutTree = 1 << 2,
     PaintTree = 1 << 3,
     GCGraph = 1 << 4,
+    RenderingStatistics = 1 << 5,
+    PaintTrace = 1 << 6,
 };
 
 AK_ENUM_BITWISE_OPERATORS(PageInfoType);
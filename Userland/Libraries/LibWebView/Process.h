@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/String.h>
+#include <AK/Time.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Process.h>
 #include <LibIPC/Connection.h>
@@ -36,11 +37,15 @@ public:
 
     pid_t pid() const { return m_process.pid(); }
 
+    Optional<MonotonicTime> last_memory_pressure_notification() const { return m_last_memory_pressure_notification; }
+    void set_last_memory_pressure_notification(MonotonicTime time) { m_last_memory_pressure_notification = time; }
+
 private:
     Core::Process m_process;
     ProcessType m_type;
     Optional<String> m_title;
     WeakPtr<IPC::ConnectionBase> m_connection;
+    Optional<MonotonicTime> m_last_memory_pressure_notification;
 };
 
 }
@@ -4,11 +4,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <AK/NumberFormat.h>
 #include <AK/String.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/System.h>
+#include <LibImageDecoderClient/Client.h>
 #include <LibWebView/ProcessManager.h>
+#include <LibWebView/WebContentClient.h>
 
 namespace WebView {
 
@@ -119,6 +122,76 @@ void ProcessManager::update_all_process_statistics()
     (void)update_process_statistics(m_statistics);
 }
 
+Optional<u64> ProcessManager::memory_usage_of_process(pid_t pid)
+{
+    Threading::MutexLocker locker { m_lock };
+    for (auto const& info : m_statistics.processes) {
+        if (info->pid == pid)
+            return info->memory_usage_bytes;
+    }
+    return {};
+}
+
+// NOTE: The proportional memory usage doesn't count the memory that is shared between our processes more than once, so
+//       we go by that where we can.
+static u64 memory_footprint(Core::Platform::ProcessInfo const& info)
+{
+    return info.proportional_memory_usage_bytes.value_or(info.memory_usage_bytes);
+}
+
+u64 ProcessManager::total_memory_usage() const
+{
+    u64 total = 0;
+    for (auto const& info : m_statistics.processes)
+        total += memory_footprint(*info);
+    return total;
+}
+
+void ProcessManager::set_memory_pressure_limits(u64 process_limit_bytes, u64 total_limit_bytes)
+{
+    Threading::MutexLocker locker { m_lock };
+    m_memory_pressure_process_limit_bytes = process_limit_bytes;
+    m_memory_pressure_total_limit_bytes = total_limit_bytes;
+}
+
+void ProcessManager::notify_processes_under_memory_pressure()
+{
+    Threading::MutexLocker locker { m_lock };
+
+    auto now = MonotonicTime::now();
+    auto total_limit_exceeded = m_memory_pressure_total_limit_bytes != 0 && total_memory_usage() > m_memory_pressure_total_limit_bytes;
+
+    for (auto const& info : m_statistics.processes) {
+        auto process_limit_exceeded = m_memory_pressure_process_limit_bytes != 0 && memory_footprint(*info) > m_memory_pressure_process_limit_bytes;
+        if (!total_limit_exceeded && !process_limit_exceeded)
+            continue;
+
+        auto process = m_processes.get(info->pid);
+        if (!process.has_value())
+            continue;
+        if (auto last_notification = process->last_memory_pressure_notification(); last_notification.has_value() && now - *last_notification < minimum_memory_pressure_notification_interval)
+            continue;
+
+        // NOTE: These are the only processes that keep caches around that they could drop.
+        if (process->type() == ProcessType::WebContent) {
+            auto client = process->client<WebContentClient>();
+            if (!client.has_value())
+                continue;
+            client->async_memory_pressure_detected();
+        } else if (process->type() == ProcessType::ImageDecoder) {
+            auto client = process->client<ImageDecoderClient::Client>();
+            if (!client.has_value())
+                continue;
+            client->async_memory_pressure_detected();
+        } else {
+            continue;
+        }
+
+        dbgln_if(WEBVIEW_PROCESS_DEBUG, "Notifying {} process {} of memory pressure, it uses {}", process_name_from_type(process->type()), info->pid, human_readable_size(memory_footprint(*info)));
+        process->set_last_memory_pressure_notification(now);
+    }
+}
+
 String ProcessManager::generate_html()
 {
     Threading::MutexLocker locker { m_lock };
@@ -162,18 +235,35 @@ String ProcessManager::generate_html()
         </style>
         </head>
         <body>
+    )"sv);
+
+    builder.appendff("<p>Total memory usage: {}</p>", human_readable_size(total_memory_usage()));
+    if (has_memory_pressure_limits()) {
+        auto describe_limit = [](u64 limit) {
+            return limit == 0 ? "none"_string : human_readable_size(limit);
+        };
+        builder.appendff("<p>Memory pressure limits: {} per process, {} in total</p>",
+            describe_limit(m_memory_pressure_process_limit_bytes),
+            describe_limit(m_memory_pressure_total_limit_bytes));
+    }
+
+    builder.append(R"(
         <table>
                 <thead>
                 <tr>
                         <th>Name</th>
                         <th>PID</th>
                         <th>Memory Usage</th>
+                        <th>Proportional Memory Usage</th>
                         <th>CPU %</th>
+                        <th>Last Memory Pressure Notification</th>
                 </tr>
                 </thead>
                 <tbody>
     )"sv);
 
+    auto now = MonotonicTime::now();
+
     m_statistics.for_each_process([&](auto const& process) {
         builder.append("<tr>"sv);
         builder.append("<td>"sv);
@@ -189,8 +279,20 @@ String ProcessManager::generate_html()
         builder.append(human_readable_size(process.memory_usage_bytes));
         builder.append("</td>"sv);
         builder.append("<td>"sv);
+        if (process.proportional_memory_usage_bytes.has_value())
+            builder.append(human_readable_size(*process.proportional_memory_usage_bytes));
+        else
+            builder.append("-"sv);
+        builder.append("</td>"sv);
+        builder.append("<td>"sv);
         builder.append(MUST(String::formatted("{:.1f}", process.cpu_percent)));
         builder.append("</td>"sv);
+        builder.append("<td>"sv);
+        if (auto last_notification = process_handle.last_memory_pressure_notification(); last_notification.has_value())
+            builder.appendff("{}s ago", (now - *last_notification).to_seconds());
+        else
+            builder.append("-"sv);
+        builder.append("</td>"sv);
         builder.append("</tr>"sv);
     });
 
@@ -36,14 +36,29 @@ public:
 #endif
 
     void update_all_process_statistics();
+    Optional<u64> memory_usage_of_process(pid_t);
     String generate_html();
 
+    // Processes that use more memory than the per-process limit, or all of them when our processes together use more
+    // than the total limit, are asked to free what they can. A limit of zero means there is none.
+    void set_memory_pressure_limits(u64 process_limit_bytes, u64 total_limit_bytes);
+    bool has_memory_pressure_limits() const { return m_memory_pressure_process_limit_bytes != 0 || m_memory_pressure_total_limit_bytes != 0; }
+    void notify_processes_under_memory_pressure();
+
+    // NOTE: Freeing memory takes a while to show up in the statistics, and dropping caches again right away won't get us
+    //       much, so a process is notified at most this often.
+    static constexpr auto minimum_memory_pressure_notification_interval = AK::Duration::from_seconds(30);
+
     Function<void(Process&&)> on_process_exited;
 
 private:
+    u64 total_memory_usage() const;
+
     Core::Platform::ProcessStatistics m_statistics;
     HashMap<pid_t, Process> m_processes;
     int m_signal_handle { -1 };
+    u64 m_memory_pressure_process_limit_bytes { 0 };
+    u64 m_memory_pressure_total_limit_bytes { 0 };
     Threading::Mutex m_lock;
 };
 
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Platform/StoragePlugin.h>
+#include <LibWebView/StorageJar.h>
+
+namespace WebView {
+
+// NOTE: This is short as a crash loses whatever hasn't been written yet, but long enough to batch up the writes of a
+//       page that stores a lot of items in one go.
+static constexpr int DATABASE_SYNCHRONIZATION_DELAY_MS = 1000;
+
+static size_t item_size(StringView key, StringView value)
+{
+    return key.length() + value.length();
+}
+
+ErrorOr<NonnullOwnPtr<StorageJar>> StorageJar::create(Database& database)
+{
+    Statements statements {};
+
+    auto create_table = TRY(database.prepare_statement(R"#(
+        CREATE TABLE IF NOT EXISTS LocalStorage (
+            origin TEXT,
+            key TEXT,
+            value TEXT,
+            PRIMARY KEY(origin, key)
+        );)#"sv));
+    database.execute_statement(create_table, {});
+
+    statements.set_item = TRY(database.prepare_statement("INSERT OR REPLACE INTO LocalStorage VALUES (?, ?, ?);"sv));
+    statements.remove_item = TRY(database.prepare_statement("DELETE FROM LocalStorage WHERE (origin = ? AND key = ?);"sv));
+    statements.clear = TRY(database.prepare_statement("DELETE FROM LocalStorage WHERE (origin = ?);"sv));
+    statements.select_items = TRY(database.prepare_statement("SELECT key, value FROM LocalStorage WHERE (origin = ?);"sv));
+    statements.begin_transaction = TRY(database.prepare_statement("BEGIN TRANSACTION;"sv));
+    statements.commit_transaction = TRY(database.prepare_statement("COMMIT;"sv));
+
+    return adopt_own(*new StorageJar { PersistedStorage { database, statements } });
+}
+
+NonnullOwnPtr<StorageJar> StorageJar::create()
+{
+    return adopt_own(*new StorageJar { OptionalNone {} });
+}
+
+StorageJar::StorageJar(Optional<PersistedStorage> persisted_storage)
+    : m_persisted_storage(move(persisted_storage))
+{
+    if (!m_persisted_storage.has_value())
+        return;
+
+    m_persisted_storage->synchronization_timer = Core::Timer::create_single_shot(DATABASE_SYNCHRONIZATION_DELAY_MS, [this]() {
+        synchronize();
+    });
+}
+
+StorageJar::~StorageJar()
+{
+    if (!m_persisted_storage.has_value())
+        return;
+
+    m_persisted_storage->synchronization_timer->stop();
+    synchronize();
+}
+
+OrderedHashMap<String, String> const& StorageJar::items(String const& origin)
+{
+    return storage_for_origin(origin).items;
+}
+
+bool StorageJar::set_item(String const& origin, String const& key, String const& value)
+{
+    auto& storage = storage_for_origin(origin);
+
+    auto new_size = storage.size_in_bytes + item_size(key, value);
+    if (auto it = storage.items.find(key); it != storage.items.end())
+        new_size -= item_size(key, it->value);
+
+    // NOTE: WebContent checks the quota itself before it sends us an item, so this only happens if it misbehaves.
+    if (new_size > Web::Platform::StoragePlugin::local_storage_quota_in_bytes)
+        return false;
+
+    storage.items.set(key, value);
+    storage.size_in_bytes = new_size;
+
+    if (m_persisted_storage.has_value()) {
+        m_dirty_items.ensure(origin).set(key, value);
+        schedule_synchronization();
+    }
+    return true;
+}
+
+void StorageJar::remove_item(String const& origin, String const& key)
+{
+    auto& storage = storage_for_origin(origin);
+    auto it = storage.items.find(key);
+    if (it == storage.items.end())
+        return;
+
+    storage.size_in_bytes -= item_size(key, it->value);
+    storage.items.remove(it);
+
+    if (m_persisted_storage.has_value()) {
+        m_dirty_items.ensure(origin).set(key, OptionalNone {});
+        schedule_synchronization();
+    }
+}
+
+void StorageJar::clear(String const& origin)
+{
+    auto& storage = storage_for_origin(origin);
+    storage.items.clear();
+    storage.size_in_bytes = 0;
+
+    if (m_persisted_storage.has_value()) {
+        m_dirty_items.remove(origin);
+        m_cleared_origins.set(origin);
+        schedule_synchronization();
+    }
+}
+
+StorageJar::OriginStorage& StorageJar::storage_for_origin(String const& origin)
+{
+    return m_origins.ensure(origin, [&] {
+        OriginStorage storage;
+        if (!m_persisted_storage.has_value())
+            return storage;
+
+        // NOTE: Changes to an origin are only ever made after it has been loaded, so there's nothing dirty to merge in.
+        m_persisted_storage->database.execute_statement(
+            m_persisted_storage->statements.select_items,
+            [&](auto statement_id) {
+                auto key = m_persisted_storage->database.result_column<String>(statement_id, 0);
+                auto value = m_persisted_storage->database.result_column<String>(statement_id, 1);
+                storage.size_in_bytes += item_size(key, value);
+                storage.items.set(move(key), move(value));
+            },
+            origin);
+        return storage;
+    });
+}
+
+void StorageJar::schedule_synchronization()
+{
+    if (!m_persisted_storage->synchronization_timer->is_active())
+        m_persisted_storage->synchronization_timer->start();
+}
+
+void StorageJar::synchronize()
+{
+    if (m_cleared_origins.is_empty() && m_dirty_items.is_empty())
+        return;
+
+    auto& database = m_persisted_storage->database;
+    auto const& statements = m_persisted_storage->statements;
+
+    // NOTE: Writing the whole batch in one transaction means the database only has to sync to disk once.
+    database.execute_statement(statements.begin_transaction, {});
+
+    // NOTE: The items that an origin got after it was cleared are still dirty, so we clear before writing those.
+    for (auto const& origin : m_cleared_origins)
+        database.execute_statement(statements.clear, {}, origin);
+    m_cleared_origins.clear();
+
+    for (auto const& [origin, items] : m_dirty_items) {
+        for (auto const& [key, value] : items) {
+            if (value.has_value())
+                database.execute_statement(statements.set_item, {}, origin, key, *value);
+            else
+                database.execute_statement(statements.remove_item, {}, origin, key);
+        }
+    }
+    m_dirty_items.clear();
+
+    database.execute_statement(statements.commit_transaction, {});
+}
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibCore/Timer.h>
+#include <LibWebView/Database.h>
+#include <LibWebView/Forward.h>
+
+namespace WebView {
+
+// The local storage of every origin, shared by all of our WebContent processes. An origin's items are loaded from the
+// database the first time it is used, and changes are written back in batches shortly after they are made, so that a
+// page that writes to its storage in a loop doesn't end up waiting on the disk.
+class StorageJar {
+    struct Statements {
+        Database::StatementID set_item { 0 };
+        Database::StatementID remove_item { 0 };
+        Database::StatementID clear { 0 };
+        Database::StatementID select_items { 0 };
+        Database::StatementID begin_transaction { 0 };
+        Database::StatementID commit_transaction { 0 };
+    };
+
+    struct PersistedStorage {
+        Database& database;
+        Statements statements;
+        RefPtr<Core::Timer> synchronization_timer {};
+    };
+
+public:
+    static ErrorOr<NonnullOwnPtr<StorageJar>> create(Database&);
+    static NonnullOwnPtr<StorageJar> create();
+
+    ~StorageJar();
+
+    OrderedHashMap<String, String> const& items(String const& origin);
+
+    // Returns false if this would take the origin over its quota, in which case the item isn't stored.
+    bool set_item(String const& origin, String const& key, String const& value);
+    void remove_item(String const& origin, String const& key);
+    void clear(String const& origin);
+
+private:
+    explicit StorageJar(Optional<PersistedStorage>);
+
+    AK_MAKE_NONCOPYABLE(StorageJar);
+    AK_MAKE_NONMOVABLE(StorageJar);
+
+    struct OriginStorage {
+        OrderedHashMap<String, String> items;
+        size_t size_in_bytes { 0 };
+    };
+    OriginStorage& storage_for_origin(String const& origin);
+
+    void schedule_synchronization();
+    void synchronize();
+
+    Optional<PersistedStorage> m_persisted_storage;
+    HashMap<String, OriginStorage> m_origins;
+
+    // The changes that haven't been written to the database yet. A missing value means the item was removed.
+    HashMap<String, HashMap<String, Optional<String>>> m_dirty_items;
+    HashTable<String> m_cleared_origins;
+};
+
+}
@@ -9,6 +9,7 @@
 #include "ViewImplementation.h"
 #include <LibWeb/Cookie/ParsedCookie.h>
 #include <LibWebView/CookieJar.h>
+#include <LibWebView/StorageJar.h>
 
 namespace WebView {
 
@@ -30,6 +31,12 @@ WebContentClient::WebContentClient(NonnullOwnPtr<Core::LocalSocket> socket, View
     m_views.set(0, &view);
 }
 
+WebContentClient::WebContentClient(NonnullOwnPtr<Core::LocalSocket> socket)
+    : IPC::ConnectionToServer<WebContentClientEndpoint, WebContentServerEndpoint>(*this, move(socket))
+{
+    s_clients.set(this);
+}
+
 WebContentClient::~WebContentClient()
 {
     s_clients.remove(this);
@@ -40,6 +47,12 @@ void WebContentClient::die()
     // Intentionally empty. Restart is handled at another level.
 }
 
+void WebContentClient::set_initial_view(ViewImplementation& view)
+{
+    VERIFY(m_views.is_empty());
+    m_views.set(0, &view);
+}
+
 void WebContentClient::register_view(u64 page_id, ViewImplementation& view)
 {
     VERIFY(page_id > 0);
@@ -450,6 +463,45 @@ void WebContentClient::did_expire_cookies_with_time_offset(AK::Duration offset)
     Application::cookie_jar().expire_cookies_with_time_offset(offset);
 }
 
+// NOTE: Every process hears about every change, including the one that made it, so that they all apply the changes to
+//       an origin in the order in which we stored them.
+static void broadcast_local_storage_change(WebContentClient& source, String const& origin, Optional<String> const& key, Optional<String> const& value)
+{
+    WebContentClient::for_each_client([&](WebContentClient& client) {
+        client.async_local_storage_changed(origin, key, value, &client == &source);
+        return IterationDecision::Continue;
+    });
+}
+
+Messages::WebContentClient::DidRequestLocalStorageResponse WebContentClient::did_request_local_storage(String const& origin)
+{
+    return Application::storage_jar().items(origin);
+}
+
+void WebContentClient::did_set_local_storage_item(String const& origin, String const& key, String const& value)
+{
+    if (Application::storage_jar().set_item(origin, key, value)) {
+        broadcast_local_storage_change(*this, origin, key, value);
+        return;
+    }
+
+    // The item went over the quota, so we tell the process that sent it what we have instead.
+    async_local_storage_changed(origin, key, value, true);
+    async_local_storage_changed(origin, key, Application::storage_jar().items(origin).get(key), false);
+}
+
+void WebContentClient::did_remove_local_storage_item(String const& origin, String const& key)
+{
+    Application::storage_jar().remove_item(origin, key);
+    broadcast_local_storage_change(*this, origin, key, {});
+}
+
+void WebContentClient::did_clear_local_storage(String const& origin)
+{
+    Application::storage_jar().clear(origin);
+    broadcast_local_storage_change(*this, origin, {}, {});
+}
+
 Messages::WebContentClient::DidRequestNewWebViewResponse WebContentClient::did_request_new_web_view(u64 page_id, Web::HTML::ActivateTab const& activate_tab, Web::HTML::WebViewHints const& hints, Optional<u64> const& page_index)
 {
     if (auto view = view_for_page_id(page_id); view.has_value()) {
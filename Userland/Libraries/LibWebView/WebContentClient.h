@@ -38,11 +38,16 @@ public:
     WebContentClient(NonnullOwnPtr<Core::LocalSocket>, ViewImplementation&);
     ~WebContentClient();
 
+    // For spare processes, which are launched before there is a view to show their initial page.
+    explicit WebContentClient(NonnullOwnPtr<Core::LocalSocket>);
+    void set_initial_view(ViewImplementation&);
+
     void register_view(u64 page_id, ViewImplementation&);
     void unregister_view(u64 page_id);
 
     Function<void()> on_web_content_process_crash;
 
+    pid_t pid() const { return m_process_handle.pid; }
     void set_pid(pid_t pid) { m_process_handle.pid = pid; }
 
 private:
@@ -94,6 +99,10 @@ private:
     virtual void did_set_cookie(URL::URL const&, Web::Cookie::ParsedCookie const&, Web::Cookie::Source) override;
     virtual void did_update_cookie(Web::Cookie::Cookie const&) override;
     virtual void did_expire_cookies_with_time_offset(AK::Duration) override;
+    virtual Messages::WebContentClient::DidRequestLocalStorageResponse did_request_local_storage(String const& origin) override;
+    virtual void did_set_local_storage_item(String const& origin, String const& key, String const& value) override;
+    virtual void did_remove_local_storage_item(String const& origin, String const& key) override;
+    virtual void did_clear_local_storage(String const& origin) override;
     virtual Messages::WebContentClient::DidRequestNewWebViewResponse did_request_new_web_view(u64 page_id, Web::HTML::ActivateTab const&, Web::HTML::WebViewHints const&, Optional<u64> const& page_index) override;
     virtual void did_request_activate_tab(u64 page_id) override;
     virtual void did_close_browsing_context(u64 page_id) override;
@@ -70,6 +70,14 @@ size_t Parser::s_debug_indent_level { 0 };
 
 void Parser::append_node(NonnullOwnPtr<Node> node)
 {
+    // NOTE: A listener is told about every node as it is parsed, so there's no need to keep a tree around.
+    //       Only the currently open elements are kept alive, which bounds memory use by the nesting depth.
+    if (m_listener) {
+        m_open_elements_for_listener.append(move(node));
+        enter_node(*m_open_elements_for_listener.last());
+        return;
+    }
+
     if (m_entered_node) {
         auto& entered_element = m_entered_node->content.get<Node::Element>();
         entered_element.children.append(move(node));
@@ -155,6 +163,8 @@ void Parser::leave_node()
     }
 
     m_entered_node = m_entered_node->parent;
+    if (m_listener)
+        (void)m_open_elements_for_listener.take_last();
 }
 
 ErrorOr<Document, ParseError> Parser::parse()
@@ -183,6 +193,7 @@ ErrorOr<void, ParseError> Parser::parse_with_listener(Listener& listener)
         m_listener->error(result.error());
     m_listener->document_end();
     m_root_node.clear();
+    m_open_elements_for_listener.clear();
     return result;
 }
 
@@ -898,6 +909,17 @@ ErrorOr<void, ParseError> Parser::parse_content()
     return {};
 }
 
+// Returns whether any byte of the word is a '<', a '&' or a ']', i.e. something that may end a run of character data.
+static constexpr bool word_may_end_char_data(FlatPtr word)
+{
+    constexpr FlatPtr ones = explode_byte(0x01);
+    constexpr FlatPtr high_bits = explode_byte(0x80);
+
+    auto has_zero_byte = [&](FlatPtr value) { return (value - ones) & ~value & high_bits; };
+
+    return has_zero_byte(word ^ explode_byte('<')) || has_zero_byte(word ^ explode_byte('&')) || has_zero_byte(word ^ explode_byte(']'));
+}
+
 // 2.4.14 CharData, https://www.w3.org/TR/2006/REC-xml11-20060816/#NT-CharData
 ErrorOr<StringView, ParseError> Parser::parse_char_data()
 {
@@ -905,8 +927,23 @@ ErrorOr<StringView, ParseError> Parser::parse_char_data()
     auto rule = enter_rule();
 
     // CharData ::= [^<&]* - ([^<&]* ']]>' [^<&]*)
+    auto text_start = m_lexer.tell();
+
+    // OPTIMIZATION: Skip over a machine word's worth of bytes at a time while none of them can end the character data,
+    //               and only run the byte loop below from the word that might.
+    auto remaining_input = m_lexer.remaining();
+    size_t plain_characters = 0;
+    while (plain_characters + sizeof(FlatPtr) <= remaining_input.length()) {
+        FlatPtr word;
+        __builtin_memcpy(&word, remaining_input.characters_without_null_termination() + plain_characters, sizeof(word));
+        if (word_may_end_char_data(word))
+            break;
+        plain_characters += sizeof(word);
+    }
+    m_lexer.ignore(plain_characters);
+
     auto cend_state = 0; // 1: ], 2: ], 3: >
-    auto text = m_lexer.consume_while([&](auto ch) {
+    m_lexer.consume_while([&](auto ch) {
         if (ch == '<' || ch == '&' || cend_state == 3)
             return false;
         switch (cend_state) {
@@ -928,11 +965,10 @@ ErrorOr<StringView, ParseError> Parser::parse_char_data()
             VERIFY_NOT_REACHED();
         }
     });
-    if (cend_state == 3) {
+    if (cend_state == 3)
         m_lexer.retreat(3);
-        text = text.substring_view(0, text.length() - 3);
-    }
 
+    auto text = m_lexer.input().substring_view(text_start, m_lexer.tell() - text_start);
     rollback.disarm();
     return text;
 }
@@ -206,6 +206,7 @@ private:
     Listener* m_listener { nullptr };
 
     OwnPtr<Node> m_root_node;
+    Vector<NonnullOwnPtr<Node>> m_open_elements_for_listener;
     Node* m_entered_node { nullptr };
     Version m_version { Version::Version11 };
     bool m_in_compatibility_mode { false };
@@ -12,6 +12,10 @@
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
 
+#if defined(AK_LIBC_GLIBC)
+#    include <malloc.h>
+#endif
+
 namespace ImageDecoder {
 
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
@@ -29,6 +33,12 @@ void ConnectionFromClient::die()
         job->cancel();
     }
     m_pending_jobs.clear();
+    m_streamed_images.clear();
+    for (auto& [_, session] : m_decoding_sessions) {
+        if (session.partial_decode_job)
+            session.partial_decode_job->cancel();
+    }
+    m_decoding_sessions.clear();
 
     auto client_id = this->client_id();
     s_connections.remove(client_id);
@@ -75,9 +85,30 @@ Messages::ImageDecoderServer::ConnectNewClientsResponse ConnectionFromClient::co
     return files;
 }
 
-static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>>& bitmaps, Vector<u32>& durations)
+// Animated images whose frames would take up more than this once decoded are streamed to the client instead.
+static constexpr size_t maximum_decoded_size_of_all_frames = 32 * MiB;
+
+// How many frames of a streamed image we decode right away. The client asks for the others as it plays them.
+static constexpr size_t frames_decoded_up_front_when_streaming = 4;
+
+// The most frames that a client can ask for at once.
+static constexpr size_t maximum_frames_per_request = 16;
+
+static bool should_stream_frames(Gfx::ImageDecoder const& decoder)
 {
-    for (size_t i = 0; i < decoder.frame_count(); ++i) {
+    if (!decoder.is_animated() || decoder.frame_count() <= frames_decoded_up_front_when_streaming)
+        return false;
+
+    Checked<size_t> decoded_size = decoder.size().width();
+    decoded_size *= decoder.size().height();
+    decoded_size *= sizeof(Gfx::ARGB32);
+    decoded_size *= decoder.frame_count();
+    return decoded_size.has_overflow() || decoded_size.value() > maximum_decoded_size_of_all_frames;
+}
+
+static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, size_t start_frame_index, size_t frame_count, Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>>& bitmaps, Vector<u32>& durations)
+{
+    for (size_t i = start_frame_index; i < start_frame_index + frame_count; ++i) {
         auto frame_or_error = decoder.frame(i, ideal_size);
         if (frame_or_error.is_error()) {
             bitmaps.append({});
@@ -103,6 +134,7 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
     ConnectionFromClient::DecodeResult result;
     result.is_animated = decoder->is_animated();
     result.loop_count = decoder->loop_count();
+    result.frame_count = decoder->frame_count();
 
     Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>> bitmaps;
 
@@ -118,11 +150,20 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
         }
     }
 
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), bitmaps, result.durations);
+    auto frames_to_decode = decoder->frame_count();
+    if (should_stream_frames(*decoder)) {
+        frames_to_decode = frames_decoded_up_front_when_streaming;
+        result.streamed_image = adopt_ref(*new ConnectionFromClient::StreamedImage(encoded_buffer, *decoder, ideal_size));
+    }
+
+    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), 0, frames_to_decode, bitmaps, result.durations);
 
     if (bitmaps.is_empty())
         return Error::from_string_literal("Could not decode image");
 
+    // NOTE: The frames may have been decoded at a smaller size than this, if that's all the client asked for.
+    //       Some decoders only know the size once they've decoded something, so we ask after that.
+    result.natural_size = decoder->size();
     result.bitmaps = Gfx::BitmapSequence { bitmaps };
 
     return result;
@@ -135,7 +176,9 @@ NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image
             return TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
         },
         [strong_this = NonnullRefPtr(*this), image_id](DecodeResult result) -> ErrorOr<void> {
-            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.bitmaps, result.durations, result.scale);
+            if (result.streamed_image)
+                strong_this->m_streamed_images.set(image_id, result.streamed_image.release_nonnull());
+            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.frame_count, result.bitmaps, result.durations, result.scale, result.natural_size);
             strong_this->m_pending_jobs.remove(image_id);
             return {};
         },
@@ -166,6 +209,145 @@ void ConnectionFromClient::cancel_decoding(i64 image_id)
     if (auto job = m_pending_jobs.take(image_id); job.has_value()) {
         job.value()->cancel();
     }
+    if (auto session = m_decoding_sessions.take(image_id); session.has_value() && session->partial_decode_job) {
+        session->partial_decode_job->cancel();
+    }
+}
+
+// We don't decode what we've got of an image before there's at least this much.
+static constexpr size_t minimum_encoded_size_for_partial_decode = 16 * KiB;
+
+Messages::ImageDecoderServer::StartDecodingSessionResponse ConnectionFromClient::start_decoding_session(Optional<ByteString> const& mime_type)
+{
+    auto image_id = m_next_image_id++;
+    m_decoding_sessions.set(image_id, DecodingSession { .mime_type = mime_type });
+    return image_id;
+}
+
+void ConnectionFromClient::append_to_decoding_session(i64 image_id, ByteBuffer const& data)
+{
+    auto session = m_decoding_sessions.get(image_id);
+    if (!session.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "No decoding session with ID {}", image_id);
+        return;
+    }
+
+    if (auto result = session->encoded_data.try_append(data); result.is_error()) {
+        dbgln("Unable to append to decoding session {}: {}", image_id, result.error());
+        m_decoding_sessions.remove(image_id);
+        async_did_fail_to_decode_image(image_id, "Out of memory"_string);
+        return;
+    }
+
+    decode_partial_image_if_needed(image_id, *session);
+}
+
+void ConnectionFromClient::decode_partial_image_if_needed(i64 image_id, DecodingSession& session)
+{
+    auto encoded_size = session.encoded_data.size();
+    if (session.partial_decode_job || encoded_size < minimum_encoded_size_for_partial_decode)
+        return;
+
+    // NOTE: Every partial decode starts over from the first byte, so we wait for the data to grow by a good chunk in
+    //       between. That keeps the total work linear in the size of the image.
+    if (encoded_size < session.encoded_size_at_last_partial_decode + session.encoded_size_at_last_partial_decode / 4)
+        return;
+    session.encoded_size_at_last_partial_decode = encoded_size;
+
+    auto encoded_data = ByteBuffer::copy(session.encoded_data);
+    if (encoded_data.is_error())
+        return;
+
+    session.partial_decode_job = DecodePartialImageJob::construct(
+        [encoded_data = encoded_data.release_value(), mime_type = session.mime_type](auto&) -> ErrorOr<DecodePartialImageResult> {
+            // NOTE: Decoders that can't make sense of incomplete data just fail here, in which case we show nothing until
+            //       the image has finished loading. We don't treat that as an error, so that we get to try again later.
+            DecodePartialImageResult result;
+            auto decoder = Gfx::ImageDecoder::try_create_for_raw_bytes(encoded_data, mime_type);
+            if (decoder.is_error() || !decoder.value() || !decoder.value()->frame_count())
+                return result;
+            if (auto frame = decoder.value()->frame(0); !frame.is_error() && frame.value().image)
+                result.bitmaps.bitmaps.append(frame.value().image.release_nonnull());
+            return result;
+        },
+        [strong_this = NonnullRefPtr(*this), image_id](DecodePartialImageResult result) -> ErrorOr<void> {
+            auto session = strong_this->m_decoding_sessions.get(image_id);
+            if (!session.has_value())
+                return {};
+            session->partial_decode_job = nullptr;
+            if (!result.bitmaps.bitmaps.is_empty())
+                strong_this->async_did_decode_partial_image(image_id, result.bitmaps);
+
+            // More data may have come in while we were busy.
+            strong_this->decode_partial_image_if_needed(image_id, *session);
+            return {};
+        },
+        [](Error) {});
+}
+
+void ConnectionFromClient::finish_decoding_session(i64 image_id, Optional<Gfx::IntSize> const& ideal_size)
+{
+    auto session = m_decoding_sessions.take(image_id);
+    if (!session.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "No decoding session with ID {}", image_id);
+        return;
+    }
+    if (session->partial_decode_job)
+        session->partial_decode_job->cancel();
+
+    auto encoded_buffer = Core::AnonymousBuffer::create_with_size(session->encoded_data.size());
+    if (encoded_buffer.is_error()) {
+        async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", encoded_buffer.error())));
+        return;
+    }
+    memcpy(encoded_buffer.value().data<void>(), session->encoded_data.data(), session->encoded_data.size());
+
+    m_pending_jobs.set(image_id, make_decode_image_job(image_id, encoded_buffer.release_value(), ideal_size, move(session->mime_type)));
+}
+
+void ConnectionFromClient::decode_frames(i64 image_id, u32 start_frame_index, u32 frame_count)
+{
+    auto streamed_image = m_streamed_images.get(image_id);
+    if (!streamed_image.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "No streamed image with ID {}", image_id);
+        return;
+    }
+
+    auto total_frame_count = streamed_image.value()->decoder->frame_count();
+    if (start_frame_index >= total_frame_count)
+        return;
+    frame_count = min(min<size_t>(frame_count, total_frame_count - start_frame_index), maximum_frames_per_request);
+
+    // NOTE: The job only reports back if the client hasn't released the image (or gone away) in the meantime.
+    (void)DecodeFramesJob::construct(
+        [streamed_image = NonnullRefPtr(*streamed_image.value()), start_frame_index, frame_count](auto& job) -> ErrorOr<DecodeFramesResult> {
+            DecodeFramesResult result;
+            Threading::MutexLocker locker(streamed_image->mutex);
+            if (job.is_canceled())
+                return Error::from_errno(ECANCELED);
+            decode_image_to_bitmaps_and_durations_with_decoder(streamed_image->decoder, streamed_image->ideal_size, start_frame_index, frame_count, result.bitmaps.bitmaps, result.durations);
+            return result;
+        },
+        [strong_this = NonnullRefPtr(*this), image_id, start_frame_index](DecodeFramesResult result) -> ErrorOr<void> {
+            if (strong_this->is_open() && strong_this->m_streamed_images.contains(image_id))
+                strong_this->async_did_decode_frames(image_id, start_frame_index, result.bitmaps, result.durations);
+            return {};
+        },
+        [](Error) {});
+}
+
+void ConnectionFromClient::release_image(i64 image_id)
+{
+    m_streamed_images.remove(image_id);
+}
+
+void ConnectionFromClient::memory_pressure_detected()
+{
+    // NOTE: We don't keep anything around that the client hasn't asked us to, so all we can do is hand the memory of the
+    //       images that we've already sent back to the system.
+#if defined(AK_LIBC_GLIBC)
+    malloc_trim(0);
+#endif
 }
 
 }
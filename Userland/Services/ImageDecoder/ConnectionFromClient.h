@@ -6,13 +6,16 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/HashMap.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
 #include <LibGfx/BitmapSequence.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibThreading/BackgroundAction.h>
+#include <LibThreading/Mutex.h>
 
 namespace ImageDecoder {
 
@@ -25,29 +28,80 @@ public:
 
     virtual void die() override;
 
+    // An animated image whose frames are decoded as the client asks for them, rather than all at once. This keeps the
+    // encoded data and its decoder around until the client releases the image.
+    struct StreamedImage : public AtomicRefCounted<StreamedImage> {
+        StreamedImage(Core::AnonymousBuffer encoded_data, NonnullRefPtr<Gfx::ImageDecoder> decoder, Optional<Gfx::IntSize> ideal_size)
+            : encoded_data(move(encoded_data))
+            , decoder(move(decoder))
+            , ideal_size(move(ideal_size))
+        {
+        }
+
+        Core::AnonymousBuffer encoded_data;
+        NonnullRefPtr<Gfx::ImageDecoder> decoder;
+        Optional<Gfx::IntSize> ideal_size;
+
+        // NOTE: Decoders aren't thread-safe, but requests for frames may be worked on by several background threads.
+        Threading::Mutex mutex;
+    };
+
     struct DecodeResult {
         bool is_animated = false;
         u32 loop_count = 0;
+        u32 frame_count = 0;
         Gfx::FloatPoint scale { 1, 1 };
+        Gfx::IntSize natural_size;
+        Gfx::BitmapSequence bitmaps;
+        Vector<u32> durations;
+        RefPtr<StreamedImage> streamed_image;
+    };
+
+    struct DecodeFramesResult {
         Gfx::BitmapSequence bitmaps;
         Vector<u32> durations;
     };
 
+    struct DecodePartialImageResult {
+        Gfx::BitmapSequence bitmaps;
+    };
+
 private:
     using Job = Threading::BackgroundAction<DecodeResult>;
+    using DecodeFramesJob = Threading::BackgroundAction<DecodeFramesResult>;
+    using DecodePartialImageJob = Threading::BackgroundAction<DecodePartialImageResult>;
+
+    // An image whose encoded data the client sends us bit by bit as it arrives. Until it's all there, we now and then
+    // decode what we have so far, so that the client can show the image before it has finished loading.
+    struct DecodingSession {
+        Optional<ByteString> mime_type;
+        ByteBuffer encoded_data;
+        size_t encoded_size_at_last_partial_decode { 0 };
+        RefPtr<DecodePartialImageJob> partial_decode_job;
+    };
 
     explicit ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>);
 
     virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type) override;
     virtual void cancel_decoding(i64 image_id) override;
+    virtual void decode_frames(i64 image_id, u32 start_frame_index, u32 frame_count) override;
+    virtual void release_image(i64 image_id) override;
+    virtual Messages::ImageDecoderServer::StartDecodingSessionResponse start_decoding_session(Optional<ByteString> const& mime_type) override;
+    virtual void append_to_decoding_session(i64 image_id, ByteBuffer const& data) override;
+    virtual void finish_decoding_session(i64 image_id, Optional<Gfx::IntSize> const& ideal_size) override;
     virtual Messages::ImageDecoderServer::ConnectNewClientsResponse connect_new_clients(size_t count) override;
+    virtual void memory_pressure_detected() override;
 
     ErrorOr<IPC::File> connect_new_client();
 
+    void decode_partial_image_if_needed(i64 image_id, DecodingSession&);
+
     NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
 
     i64 m_next_image_id { 0 };
     HashMap<i64, NonnullRefPtr<Job>> m_pending_jobs;
+    HashMap<i64, NonnullRefPtr<StreamedImage>> m_streamed_images;
+    HashMap<i64, DecodingSession> m_decoding_sessions;
 };
 
 }
@@ -5,7 +5,9 @@
  */
 
 #include <AK/Badge.h>
+#include <AK/Debug.h>
 #include <AK/IDAllocator.h>
+#include <AK/JsonObject.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Weakable.h>
@@ -13,6 +15,7 @@
 #include <LibCore/Proxy.h>
 #include <LibCore/Socket.h>
 #include <LibRequests/NetworkErrorEnum.h>
+#include <LibRequests/RequestTimingInfo.h>
 #include <LibWebSocket/ConnectionInfo.h>
 #include <LibWebSocket/Message.h>
 #include <RequestServer/ConnectionFromClient.h>
@@ -26,6 +29,88 @@ ByteString g_default_certificate_path;
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
 static IDAllocator s_client_ids;
 
+// NOTE: Browsers commonly allow this many simultaneous connections to the same host.
+static constexpr long max_connections_per_host = 6;
+
+// Every client's requests go through the same share handle, so that connections, TLS sessions and DNS results are reused
+// across tabs and WebContent processes. All of them run on the main thread, so the share handle doesn't need any locking.
+static CURLSH* shared_curl_state()
+{
+    static CURLSH* s_share = [] {
+        auto* share = curl_share_init();
+        VERIFY(share);
+
+        auto share_data = [share](curl_lock_data data) {
+            auto result = curl_share_setopt(share, CURLSHOPT_SHARE, data);
+            if (result != CURLSHE_OK)
+                dbgln("Failed to share curl data {}: {}", to_underlying(data), curl_share_strerror(result));
+        };
+        share_data(CURL_LOCK_DATA_CONNECT);
+        share_data(CURL_LOCK_DATA_SSL_SESSION);
+        share_data(CURL_LOCK_DATA_DNS);
+        return share;
+    }();
+    return s_share;
+}
+
+// The default pipe capacity (64 KiB on Linux) means a large body wakes up both us and the client for every 64 KiB,
+// and has us spinning on EAGAIN whenever the client isn't reading fast enough. A bigger pipe batches that up.
+// https://httpwg.org/specs/rfc7540.html#StreamPriority
+static long http2_stream_weight(RequestPriority priority)
+{
+    switch (priority) {
+    case RequestPriority::Lowest:
+        return 16;
+    case RequestPriority::Low:
+        return 64;
+    case RequestPriority::Medium:
+        return 128;
+    case RequestPriority::High:
+        return 192;
+    case RequestPriority::Highest:
+        return 256;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// https://httpwg.org/specs/rfc9218.html#urgency
+static u8 http_urgency(RequestPriority priority)
+{
+    switch (priority) {
+    case RequestPriority::Lowest:
+        return 6;
+    case RequestPriority::Low:
+        return 4;
+    case RequestPriority::Medium:
+        return 3;
+    case RequestPriority::High:
+        return 1;
+    case RequestPriority::Highest:
+        return 0;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static long preferred_http_version()
+{
+    // NOTE: curl falls back to earlier HTTP versions when an HTTP/3 connection can't be made since 7.88.0.
+#if LIBCURL_VERSION_NUM >= 0x075800
+    static bool const supports_http3 = (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP3) != 0;
+    if (supports_http3)
+        return CURL_HTTP_VERSION_3;
+#endif
+    return CURL_HTTP_VERSION_2TLS;
+}
+
+static void enlarge_response_pipe([[maybe_unused]] int writer_fd)
+{
+#ifdef F_SETPIPE_SZ
+    static constexpr int response_pipe_size = 1 * MiB;
+    // NOTE: This fails if it's above the system's limit for unprivileged users, in which case we just keep the default size.
+    (void)Core::System::fcntl(writer_fd, F_SETPIPE_SZ, response_pipe_size);
+#endif
+}
+
 struct ConnectionFromClient::ActiveRequest {
     CURLM* multi { nullptr };
     CURL* easy { nullptr };
@@ -39,6 +124,15 @@ struct ConnectionFromClient::ActiveRequest {
     String url;
     ByteBuffer body;
 
+    // The disk cache's view of this request.
+    URL::URL cache_url;
+    bool may_store_in_disk_cache { false };
+    ByteBuffer body_for_disk_cache;
+    Optional<DiskCache::CachedResponse> response_to_validate;
+    bool response_was_validated { false };
+    UnixDateTime request_time;
+    UnixDateTime response_time;
+
     ActiveRequest(ConnectionFromClient& client, CURLM* multi, CURL* easy, i32 request_id, int writer_fd)
         : multi(multi)
         , easy(easy)
@@ -50,7 +144,8 @@ struct ConnectionFromClient::ActiveRequest {
 
     ~ActiveRequest()
     {
-        MUST(Core::System::close(writer_fd));
+        if (writer_fd >= 0)
+            MUST(Core::System::close(writer_fd));
         auto result = curl_multi_remove_handle(multi, easy);
         VERIFY(result == CURLM_OK);
         curl_easy_cleanup(easy);
@@ -64,10 +159,112 @@ struct ConnectionFromClient::ActiveRequest {
         long http_status_code = 0;
         auto result = curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &http_status_code);
         VERIFY(result == CURLE_OK);
+        response_time = UnixDateTime::now();
+
+        // NOTE: If the server told us our stored response is still good, the client gets that once the request finishes.
+        if (response_to_validate.has_value() && http_status_code == 304) {
+            response_was_validated = true;
+            return;
+        }
+        response_to_validate.clear();
+        if (may_store_in_disk_cache)
+            may_store_in_disk_cache = DiskCache::is_cacheable(http_status_code, headers);
+
         client->async_headers_became_available(request_id, headers, http_status_code);
     }
+
+    Requests::RequestTimingInfo timing_info() const
+    {
+        Requests::RequestTimingInfo timing_info;
+
+        auto get_time = [&](CURLINFO info) -> i64 {
+            curl_off_t microseconds = 0;
+            if (curl_easy_getinfo(easy, info, &microseconds) != CURLE_OK)
+                return 0;
+            return static_cast<i64>(microseconds);
+        };
+        timing_info.domain_lookup_end_microseconds = get_time(CURLINFO_NAMELOOKUP_TIME_T);
+        timing_info.connect_end_microseconds = get_time(CURLINFO_CONNECT_TIME_T);
+        timing_info.secure_connect_end_microseconds = get_time(CURLINFO_APPCONNECT_TIME_T);
+        timing_info.request_start_microseconds = get_time(CURLINFO_PRETRANSFER_TIME_T);
+        timing_info.response_start_microseconds = get_time(CURLINFO_STARTTRANSFER_TIME_T);
+        timing_info.response_end_microseconds = get_time(CURLINFO_TOTAL_TIME_T);
+
+        long header_size = 0;
+        if (curl_easy_getinfo(easy, CURLINFO_HEADER_SIZE, &header_size) == CURLE_OK)
+            timing_info.header_size = static_cast<u64>(header_size);
+
+        // NOTE: curl counts the body bytes as they came off the wire, before decoding any content codings.
+        curl_off_t encoded_body_size = 0;
+        if (curl_easy_getinfo(easy, CURLINFO_SIZE_DOWNLOAD_T, &encoded_body_size) == CURLE_OK)
+            timing_info.encoded_body_size = static_cast<u64>(encoded_body_size);
+
+        long new_connections = 0;
+        if (curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &new_connections) == CURLE_OK)
+            timing_info.connection_was_reused = new_connections == 0;
+
+        long http_version = CURL_HTTP_VERSION_NONE;
+        curl_easy_getinfo(easy, CURLINFO_HTTP_VERSION, &http_version);
+        switch (http_version) {
+        case CURL_HTTP_VERSION_1_0:
+            timing_info.protocol = "http/1.0"sv;
+            break;
+        case CURL_HTTP_VERSION_1_1:
+            timing_info.protocol = "http/1.1"sv;
+            break;
+        case CURL_HTTP_VERSION_2_0:
+            timing_info.protocol = "h2"sv;
+            break;
+#if LIBCURL_VERSION_NUM >= 0x074200
+        case CURL_HTTP_VERSION_3:
+            timing_info.protocol = "h3"sv;
+            break;
+#endif
+        default:
+            break;
+        }
+
+        if (response_was_validated)
+            timing_info.cache_state = Requests::RequestTimingInfo::CacheState::Validated;
+
+        return timing_info;
+    }
 };
 
+// Logs the timings of a finished request as a single line of JSON, so they can be collected and compared by tools.
+static void log_request_timing_info(StringView url, Requests::RequestTimingInfo const& timing_info)
+{
+    if constexpr (REQUESTSERVER_DEBUG) {
+        JsonObject metrics;
+        metrics.set("url"sv, url);
+        metrics.set("protocol"sv, timing_info.protocol);
+        metrics.set("connectionReused"sv, timing_info.connection_was_reused);
+        switch (timing_info.cache_state) {
+        case Requests::RequestTimingInfo::CacheState::None:
+            metrics.set("cache"sv, "miss"sv);
+            break;
+        case Requests::RequestTimingInfo::CacheState::Local:
+            metrics.set("cache"sv, "hit"sv);
+            break;
+        case Requests::RequestTimingInfo::CacheState::Validated:
+            metrics.set("cache"sv, "validated"sv);
+            break;
+        }
+        metrics.set("dnsEndUs"sv, timing_info.domain_lookup_end_microseconds);
+        metrics.set("connectEndUs"sv, timing_info.connect_end_microseconds);
+        metrics.set("tlsEndUs"sv, timing_info.secure_connect_end_microseconds);
+        metrics.set("requestStartUs"sv, timing_info.request_start_microseconds);
+        metrics.set("ttfbUs"sv, timing_info.response_start_microseconds);
+        metrics.set("totalUs"sv, timing_info.response_end_microseconds);
+        metrics.set("headerBytes"sv, timing_info.header_size);
+        metrics.set("encodedBodyBytes"sv, timing_info.encoded_body_size);
+        dbgln("RequestServer timing: {}", metrics.serialized<StringBuilder>());
+    } else {
+        (void)url;
+        (void)timing_info;
+    }
+}
+
 size_t ConnectionFromClient::on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data)
 {
     auto* request = static_cast<ActiveRequest*>(user_data);
@@ -118,6 +315,13 @@ size_t ConnectionFromClient::on_data_received(void* buffer, size_t size, size_t
 
     request->downloaded_so_far += total_size;
 
+    if (request->may_store_in_disk_cache) {
+        if (request->body_for_disk_cache.size() + total_size > DiskCache::maximum_entry_size || request->body_for_disk_cache.try_append(buffer, total_size).is_error()) {
+            request->may_store_in_disk_cache = false;
+            request->body_for_disk_cache.clear();
+        }
+    }
+
     return total_size;
 }
 
@@ -175,6 +379,55 @@ int ConnectionFromClient::on_timeout_callback(void*, long timeout_ms, void* user
     return 0;
 }
 
+struct ConnectionFromClient::CachedResponseTransfer {
+    i32 request_id { 0 };
+    int writer_fd { -1 };
+    ByteBuffer body;
+    size_t written_so_far { 0 };
+    RefPtr<Core::Notifier> notifier;
+    Requests::RequestTimingInfo timing_info;
+
+    ~CachedResponseTransfer()
+    {
+        MUST(Core::System::close(writer_fd));
+    }
+};
+
+void ConnectionFromClient::serve_cached_response(i32 request_id, int writer_fd, DiskCache::CachedResponse response, Requests::RequestTimingInfo timing_info)
+{
+    async_headers_became_available(request_id, response.headers, response.status_code);
+
+    auto transfer = make<CachedResponseTransfer>(request_id, writer_fd, move(response.body), 0, nullptr, move(timing_info));
+    if (transfer->body.is_empty()) {
+        async_request_finished(request_id, 0, transfer->timing_info, {});
+        return;
+    }
+
+    // NOTE: The client drains the pipe at its own pace, so we feed it the body whenever there is room.
+    transfer->notifier = Core::Notifier::construct(writer_fd, Core::NotificationType::Write);
+    transfer->notifier->on_activation = [this, request_id] {
+        auto& transfer = *m_cached_response_transfers.get(request_id).value();
+        auto result = Core::System::write(transfer.writer_fd, transfer.body.bytes().slice(transfer.written_so_far));
+        if (result.is_error()) {
+            if (result.error().code() == EAGAIN)
+                return;
+            dbgln("serve_cached_response: write failed: {}", result.error());
+        } else {
+            transfer.written_so_far += result.value();
+            if (transfer.written_so_far < transfer.body.size())
+                return;
+        }
+
+        transfer.notifier->set_enabled(false);
+        async_request_finished(request_id, transfer.written_so_far, transfer.timing_info, result.is_error() ? Requests::NetworkError::Unknown : Optional<Requests::NetworkError> {});
+        Core::deferred_invoke([this, request_id] {
+            m_cached_response_transfers.remove(request_id);
+        });
+    };
+    transfer->notifier->set_enabled(true);
+    m_cached_response_transfers.set(request_id, move(transfer));
+}
+
 ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> socket)
     : IPC::ConnectionFromClient<RequestClientEndpoint, RequestServerEndpoint>(*this, move(socket), s_client_ids.allocate())
 {
@@ -190,6 +443,8 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> sock
     set_option(CURLMOPT_SOCKETDATA, this);
     set_option(CURLMOPT_TIMERFUNCTION, &on_timeout_callback);
     set_option(CURLMOPT_TIMERDATA, this);
+    set_option(CURLMOPT_MAX_HOST_CONNECTIONS, max_connections_per_host);
+    set_option(CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
 
     m_timer = Core::Timer::create_single_shot(0, [this] {
         int still_running = 0;
@@ -201,11 +456,17 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> sock
 
 ConnectionFromClient::~ConnectionFromClient()
 {
+    for (auto const& it : m_preconnections) {
+        auto* easy = static_cast<CURL*>(it.key);
+        curl_multi_remove_handle(m_curl_multi, easy);
+        curl_easy_cleanup(easy);
+    }
 }
 
 void ConnectionFromClient::die()
 {
     auto client_id = this->client_id();
+    m_pending_disk_cache_lookups.clear();
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
 
@@ -240,14 +501,52 @@ Messages::RequestServer::IsSupportedProtocolResponse ConnectionFromClient::is_su
     return protocol == "http"sv || protocol == "https"sv;
 }
 
-void ConnectionFromClient::start_request(i32 request_id, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ByteBuffer const& request_body, Core::ProxyData const& proxy_data)
+void ConnectionFromClient::start_request(i32 request_id, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ByteBuffer const& request_body, Core::ProxyData const& proxy_data, ::RequestServer::RequestPriority const& priority)
 {
     if (!url.is_valid()) {
         dbgln("StartRequest: Invalid URL requested: '{}'", url);
-        async_request_finished(request_id, 0, Requests::NetworkError::MalformedUrl);
+        async_request_finished(request_id, 0, {}, Requests::NetworkError::MalformedUrl);
+        return;
+    }
+
+    auto request_time = UnixDateTime::now();
+    bool may_use_disk_cache = g_disk_cache && request_body.is_empty() && DiskCache::may_be_used_for_request(method, request_headers);
+    if (!may_use_disk_cache) {
+        issue_network_request(request_id, method, url, request_headers, request_body, proxy_data, priority, request_time, false, {});
         return;
     }
 
+    // NOTE: The stored response is read on the disk cache's I/O thread, the request goes on once that's done.
+    m_pending_disk_cache_lookups.set(request_id);
+    g_disk_cache->open_entry(url, request_headers, [this, strong_this = NonnullRefPtr(*this), request_id, method, url, request_headers, proxy_data, priority, request_time](Optional<DiskCache::CachedResponse> cached_response) {
+        // NOTE: The request may have been stopped in the meantime.
+        if (!m_pending_disk_cache_lookups.remove(request_id))
+            return;
+
+        HTTP::HeaderMap effective_request_headers = request_headers;
+        Optional<DiskCache::CachedResponse> response_to_validate;
+        if (cached_response.has_value()) {
+            if (!cached_response->needs_validation) {
+                auto fds_or_error = Core::System::pipe2(O_NONBLOCK);
+                if (fds_or_error.is_error()) {
+                    dbgln("StartRequest: Failed to create pipe: {}", fds_or_error.error());
+                    return;
+                }
+                auto fds = fds_or_error.release_value();
+                enlarge_response_pipe(fds[1]);
+                async_request_started(request_id, IPC::File::adopt_fd(fds[0]));
+                serve_cached_response(request_id, fds[1], cached_response.release_value(), { .cache_state = Requests::RequestTimingInfo::CacheState::Local });
+                return;
+            }
+            if (DiskCache::add_validators(*cached_response, effective_request_headers))
+                response_to_validate = cached_response.release_value();
+        }
+        issue_network_request(request_id, method, url, move(effective_request_headers), {}, proxy_data, priority, request_time, true, move(response_to_validate));
+    });
+}
+
+void ConnectionFromClient::issue_network_request(i32 request_id, ByteString const& method, URL::URL const& url, HTTP::HeaderMap effective_request_headers, ByteBuffer const& request_body, Core::ProxyData const& proxy_data, RequestPriority priority, UnixDateTime request_time, bool may_use_disk_cache, Optional<DiskCache::CachedResponse> response_to_validate)
+{
     auto* easy = curl_easy_init();
     if (!easy) {
         dbgln("StartRequest: Failed to initialize curl easy handle");
@@ -263,10 +562,15 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString const& metho
     auto fds = fds_or_error.release_value();
     auto writer_fd = fds[1];
     auto reader_fd = fds[0];
+    enlarge_response_pipe(writer_fd);
     async_request_started(request_id, IPC::File::adopt_fd(reader_fd));
 
     auto request = make<ActiveRequest>(*this, m_curl_multi, easy, request_id, writer_fd);
     request->url = url.to_string().value();
+    request->cache_url = url;
+    request->may_store_in_disk_cache = may_use_disk_cache;
+    request->response_to_validate = move(response_to_validate);
+    request->request_time = request_time;
 
     auto set_option = [easy](auto option, auto value) {
         auto result = curl_easy_setopt(easy, option, value);
@@ -278,15 +582,24 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString const& metho
     };
 
     set_option(CURLOPT_PRIVATE, request.ptr());
+    set_option(CURLOPT_SHARE, shared_curl_state());
 
     if (!g_default_certificate_path.is_empty())
         set_option(CURLOPT_CAINFO, g_default_certificate_path.characters());
 
+    // NOTE: curl decodes these content codings as the response body arrives, with a fixed-size window per request, so the
+    //       bodies we forward to our clients are already decoded and never have to be buffered in full for decoding.
     set_option(CURLOPT_ACCEPT_ENCODING, "gzip, deflate, br");
     set_option(CURLOPT_URL, url.to_string().value().to_byte_string().characters());
     set_option(CURLOPT_PORT, url.port_or_default());
     set_option(CURLOPT_CONNECTTIMEOUT, 90L);
 
+    // NOTE: Requests to the same origin are multiplexed over one HTTP/2 or HTTP/3 connection, rather than opening another
+    //       connection while the first one is still being negotiated.
+    set_option(CURLOPT_HTTP_VERSION, preferred_http_version());
+    set_option(CURLOPT_PIPEWAIT, 1L);
+    set_option(CURLOPT_STREAM_WEIGHT, http2_stream_weight(priority));
+
     if (method == "GET"sv) {
         set_option(CURLOPT_HTTPGET, 1L);
     } else if (method.is_one_of("POST"sv, "PUT"sv, "PATCH"sv, "DELETE"sv)) {
@@ -300,8 +613,12 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString const& metho
 
     set_option(CURLOPT_FOLLOWLOCATION, 0);
 
+    // NOTE: curl has no way to prioritize HTTP/3 streams, but servers also take the urgency from this header.
+    if (auto urgency = http_urgency(priority); urgency != http_urgency(RequestPriority::Medium) && !effective_request_headers.contains("Priority"))
+        effective_request_headers.set("Priority", ByteString::formatted("u={}", urgency));
+
     struct curl_slist* curl_headers = nullptr;
-    for (auto const& header : request_headers.headers()) {
+    for (auto const& header : effective_request_headers.headers()) {
         auto header_string = ByteString::formatted("{}: {}", header.name, header.value);
         curl_headers = curl_slist_append(curl_headers, header_string.characters());
     }
@@ -356,6 +673,17 @@ void ConnectionFromClient::check_active_requests()
         ActiveRequest* request = nullptr;
         auto result = curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &request);
         VERIFY(result == CURLE_OK);
+
+        if (!request) {
+            // NOTE: Only pre-connections don't have a request attached. Whatever they were able to set up lives on in the shared state.
+            auto* easy = msg->easy_handle;
+            VERIFY(m_preconnections.remove(easy));
+            auto remove_result = curl_multi_remove_handle(m_curl_multi, easy);
+            VERIFY(remove_result == CURLM_OK);
+            curl_easy_cleanup(easy);
+            continue;
+        }
+
         request->flush_headers_if_needed();
 
         auto result_code = msg->data.result;
@@ -371,7 +699,26 @@ void ConnectionFromClient::check_active_requests()
             }
         }
 
-        async_request_finished(request->request_id, request->downloaded_so_far, network_error);
+        auto timing_info = request->timing_info();
+        log_request_timing_info(request->url, timing_info);
+
+        if (request_was_successful && request->response_was_validated) {
+            auto request_id = request->request_id;
+            auto writer_fd = exchange(request->writer_fd, -1);
+            auto response = request->response_to_validate.release_value();
+            g_disk_cache->freshen_stored_response(request->cache_url, response, request->headers, request->request_time, request->response_time);
+            m_active_requests.remove(request_id);
+            serve_cached_response(request_id, writer_fd, move(response), move(timing_info));
+            continue;
+        }
+
+        if (request_was_successful && request->may_store_in_disk_cache) {
+            long http_status_code = 0;
+            curl_easy_getinfo(request->easy, CURLINFO_RESPONSE_CODE, &http_status_code);
+            g_disk_cache->store_response(request->cache_url, http_status_code, request->headers, request->body_for_disk_cache, request->request_time, request->response_time);
+        }
+
+        async_request_finished(request->request_id, request->downloaded_so_far, timing_info, network_error);
 
         m_active_requests.remove(request->request_id);
     }
@@ -379,6 +726,12 @@ void ConnectionFromClient::check_active_requests()
 
 Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(i32 request_id)
 {
+    if (m_pending_disk_cache_lookups.remove(request_id))
+        return true;
+
+    if (m_cached_response_transfers.remove(request_id))
+        return true;
+
     auto request = m_active_requests.take(request_id);
     if (!request.has_value()) {
         dbgln("StopRequest: Request ID {} not found", request_id);
@@ -420,8 +773,49 @@ void ConnectionFromClient::ensure_connection(URL::URL const& url, ::RequestServe
         return;
     }
 
-    (void)cache_level;
-    dbgln("FIXME: EnsureConnection: Pre-connect to {}", url);
+    if (!is_supported_protocol(url.scheme().to_byte_string()).supported())
+        return;
+
+    auto origin = url.origin().serialize();
+    for (auto const& it : m_preconnections) {
+        if (it.value == origin)
+            return;
+    }
+
+    auto* easy = curl_easy_init();
+    if (!easy) {
+        dbgln("EnsureConnection: Failed to initialize curl easy handle");
+        return;
+    }
+
+    auto set_option = [easy](auto option, auto value) {
+        auto result = curl_easy_setopt(easy, option, value);
+        if (result != CURLE_OK)
+            dbgln("EnsureConnection: Failed to set curl option: {}", curl_easy_strerror(result));
+    };
+
+    // NOTE: Resolved hosts and TLS sessions go into the state that is shared with every request, which is what later
+    //       requests to this origin will benefit from. curl doesn't hand connections made with CONNECT_ONLY to other
+    //       transfers, so the connection itself is closed once it's been established.
+    set_option(CURLOPT_SHARE, shared_curl_state());
+    set_option(CURLOPT_URL, url.to_byte_string().characters());
+    set_option(CURLOPT_PORT, url.port_or_default());
+    set_option(CURLOPT_CONNECTTIMEOUT, 90L);
+    set_option(CURLOPT_CONNECT_ONLY, 1L);
+    if (!g_default_certificate_path.is_empty())
+        set_option(CURLOPT_CAINFO, g_default_certificate_path.characters());
+
+    if (cache_level == CacheLevel::ResolveOnly) {
+        // NOTE: curl calls this once the host has been resolved, and refusing to open a socket stops it right there.
+        set_option(CURLOPT_OPENSOCKETFUNCTION, +[](void*, curlsocktype, curl_sockaddr*) -> curl_socket_t {
+            return CURL_SOCKET_BAD;
+        });
+    }
+
+    auto result = curl_multi_add_handle(m_curl_multi, easy);
+    VERIFY(result == CURLM_OK);
+
+    m_preconnections.set(easy, move(origin));
 }
 
 void ConnectionFromClient::websocket_connect(i64 websocket_id, URL::URL const& url, ByteString const& origin, Vector<ByteString> const& protocols, Vector<ByteString> const& extensions, HTTP::HeaderMap const& additional_request_headers)
@@ -442,15 +836,19 @@ void ConnectionFromClient::websocket_connect(i64 websocket_id, URL::URL const& u
         async_websocket_connected(websocket_id);
     };
     connection->on_message = [this, websocket_id](auto message) {
-        async_websocket_received(websocket_id, message.is_text(), message.data());
+        queue_websocket_message(websocket_id, message);
     };
+    // NOTE: The client must see every message that arrived before the websocket errored, closed, or changed state.
     connection->on_error = [this, websocket_id](auto message) {
+        flush_websocket_messages(websocket_id);
         async_websocket_errored(websocket_id, (i32)message);
     };
     connection->on_close = [this, websocket_id](u16 code, ByteString reason, bool was_clean) {
+        flush_websocket_messages(websocket_id);
         async_websocket_closed(websocket_id, code, move(reason), was_clean);
     };
     connection->on_ready_state_change = [this, websocket_id](auto state) {
+        flush_websocket_messages(websocket_id);
         async_websocket_ready_state_changed(websocket_id, (u32)state);
     };
 
@@ -458,6 +856,45 @@ void ConnectionFromClient::websocket_connect(i64 websocket_id, URL::URL const& u
     m_websockets.set(websocket_id, move(connection));
 }
 
+void ConnectionFromClient::queue_websocket_message(i64 websocket_id, WebSocket::Message const& message)
+{
+    auto& pending_messages = m_pending_websocket_messages.ensure(websocket_id);
+    pending_messages.message_sizes.append(message.data().size());
+    pending_messages.message_is_text.append(message.is_text());
+    pending_messages.data.append(message.data());
+
+    if (pending_messages.data.size() >= maximum_pending_websocket_message_data_size) {
+        flush_websocket_messages(websocket_id);
+        return;
+    }
+
+    // NOTE: All frames that arrived in a single read from the socket are handled before we get back to the event loop,
+    //       so flushing from there sends them to the client as one batch.
+    if (m_has_scheduled_websocket_message_flush)
+        return;
+    m_has_scheduled_websocket_message_flush = true;
+    Core::deferred_invoke([weak_this = make_weak_ptr<ConnectionFromClient>()] {
+        if (weak_this)
+            weak_this->flush_all_websocket_messages();
+    });
+}
+
+void ConnectionFromClient::flush_websocket_messages(i64 websocket_id)
+{
+    auto pending_messages = m_pending_websocket_messages.take(websocket_id);
+    if (!pending_messages.has_value())
+        return;
+    async_websocket_received(websocket_id, move(pending_messages->message_sizes), move(pending_messages->message_is_text), move(pending_messages->data));
+}
+
+void ConnectionFromClient::flush_all_websocket_messages()
+{
+    m_has_scheduled_websocket_message_flush = false;
+    auto pending_messages = move(m_pending_websocket_messages);
+    for (auto& [websocket_id, messages] : pending_messages)
+        async_websocket_received(websocket_id, move(messages.message_sizes), move(messages.message_is_text), move(messages.data));
+}
+
 void ConnectionFromClient::websocket_send(i64 websocket_id, bool is_text, ByteBuffer const& data)
 {
     if (auto connection = m_websockets.get(websocket_id).value_or({}); connection && connection->ready_state() == WebSocket::ReadyState::Open)
@@ -7,8 +7,11 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <LibIPC/ConnectionFromClient.h>
+#include <LibRequests/RequestTimingInfo.h>
 #include <LibWebSocket/WebSocket.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/Forward.h>
 #include <RequestServer/RequestClientEndpoint.h>
 #include <RequestServer/RequestServerEndpoint.h>
@@ -34,7 +37,7 @@ private:
 
     virtual Messages::RequestServer::ConnectNewClientResponse connect_new_client() override;
     virtual Messages::RequestServer::IsSupportedProtocolResponse is_supported_protocol(ByteString const&) override;
-    virtual void start_request(i32 request_id, ByteString const&, URL::URL const&, HTTP::HeaderMap const&, ByteBuffer const&, Core::ProxyData const&) override;
+    virtual void start_request(i32 request_id, ByteString const&, URL::URL const&, HTTP::HeaderMap const&, ByteBuffer const&, Core::ProxyData const&, ::RequestServer::RequestPriority const&) override;
     virtual Messages::RequestServer::StopRequestResponse stop_request(i32) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(i32, ByteString const&, ByteString const&) override;
     virtual void ensure_connection(URL::URL const& url, ::RequestServer::CacheLevel const& cache_level) override;
@@ -46,6 +49,21 @@ private:
 
     HashMap<i32, RefPtr<WebSocket::WebSocket>> m_websockets;
 
+    // Messages received on a websocket are coalesced and sent to the client in batches, rather than one IPC message each.
+    struct PendingWebSocketMessages {
+        Vector<u32> message_sizes;
+        Vector<bool> message_is_text;
+        ByteBuffer data;
+    };
+    void queue_websocket_message(i64 websocket_id, WebSocket::Message const&);
+    void flush_websocket_messages(i64 websocket_id);
+    void flush_all_websocket_messages();
+    HashMap<i64, PendingWebSocketMessages> m_pending_websocket_messages;
+    bool m_has_scheduled_websocket_message_flush { false };
+
+    // NOTE: Once this much data is pending, we send it right away instead of waiting for the current event to finish.
+    static constexpr size_t maximum_pending_websocket_message_data_size = 1 * MiB;
+
     struct ActiveRequest;
     friend struct ActiveRequest;
 
@@ -54,8 +72,19 @@ private:
     static size_t on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data);
     static size_t on_data_received(void* buffer, size_t size, size_t nmemb, void* user_data);
 
+    void issue_network_request(i32 request_id, ByteString const& method, URL::URL const&, HTTP::HeaderMap effective_request_headers, ByteBuffer const& request_body, Core::ProxyData const&, RequestPriority, UnixDateTime request_time, bool may_use_disk_cache, Optional<DiskCache::CachedResponse> response_to_validate);
     HashMap<i32, NonnullOwnPtr<ActiveRequest>> m_active_requests;
 
+    // Requests that wait for the disk cache to read their stored response.
+    HashTable<i32> m_pending_disk_cache_lookups;
+
+    struct CachedResponseTransfer;
+    void serve_cached_response(i32 request_id, int writer_fd, DiskCache::CachedResponse, Requests::RequestTimingInfo);
+    HashMap<i32, NonnullOwnPtr<CachedResponseTransfer>> m_cached_response_transfers;
+
+    // Easy handles that only resolve or connect ahead of time, along with the origin they are warming up.
+    HashMap<void*, ByteString> m_preconnections;
+
     void check_active_requests();
     void* m_curl_multi { nullptr };
     RefPtr<Core::Timer> m_timer;
@@ -0,0 +1,578 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <AK/Hex.h>
+#include <AK/MemoryStream.h>
+#include <AK/QuickSort.h>
+#include <LibCore/DateTime.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <RequestServer/DiskCache.h>
+
+namespace RequestServer {
+
+OwnPtr<DiskCache> g_disk_cache;
+
+static constexpr u32 cache_entry_magic = 0x4c424843; // "LBHC"
+static constexpr u32 cache_entry_version = 1;
+
+struct StoredResponse {
+    ByteString url;
+    u32 status_code { 0 };
+    HTTP::HeaderMap headers;
+    UnixDateTime request_time;
+    UnixDateTime response_time;
+    ByteBuffer body;
+};
+
+static ErrorOr<void> write_string(Stream& stream, StringView string)
+{
+    TRY(stream.write_value<LittleEndian<u32>>(string.length()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<ByteString> read_string(Stream& stream)
+{
+    u32 length = TRY(stream.read_value<LittleEndian<u32>>());
+    auto buffer = TRY(ByteBuffer::create_uninitialized(length));
+    TRY(stream.read_until_filled(buffer));
+    return ByteString { buffer.bytes() };
+}
+
+static ErrorOr<ByteBuffer> serialize_stored_response(StoredResponse const& response)
+{
+    AllocatingMemoryStream stream;
+    TRY(stream.write_value<LittleEndian<u32>>(cache_entry_magic));
+    TRY(stream.write_value<LittleEndian<u32>>(cache_entry_version));
+    TRY(write_string(stream, response.url));
+    TRY(stream.write_value<LittleEndian<u32>>(response.status_code));
+    TRY(stream.write_value<LittleEndian<i64>>(response.request_time.seconds_since_epoch()));
+    TRY(stream.write_value<LittleEndian<i64>>(response.response_time.seconds_since_epoch()));
+    TRY(stream.write_value<LittleEndian<u32>>(response.headers.headers().size()));
+    for (auto const& header : response.headers.headers()) {
+        TRY(write_string(stream, header.name));
+        TRY(write_string(stream, header.value));
+    }
+    TRY(stream.write_value<LittleEndian<u64>>(response.body.size()));
+    TRY(stream.write_until_depleted(response.body));
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(stream.used_buffer_size()));
+    TRY(stream.read_until_filled(buffer));
+    return buffer;
+}
+
+static ErrorOr<StoredResponse> deserialize_stored_response(ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
+    if (TRY(stream.read_value<LittleEndian<u32>>()) != cache_entry_magic)
+        return Error::from_string_literal("Not a cache entry");
+    if (TRY(stream.read_value<LittleEndian<u32>>()) != cache_entry_version)
+        return Error::from_string_literal("Unsupported cache entry version");
+
+    StoredResponse response;
+    response.url = TRY(read_string(stream));
+    response.status_code = TRY(stream.read_value<LittleEndian<u32>>());
+    response.request_time = UnixDateTime::from_seconds_since_epoch(TRY(stream.read_value<LittleEndian<i64>>()));
+    response.response_time = UnixDateTime::from_seconds_since_epoch(TRY(stream.read_value<LittleEndian<i64>>()));
+    u32 header_count = TRY(stream.read_value<LittleEndian<u32>>());
+    for (u32 i = 0; i < header_count; ++i) {
+        auto name = TRY(read_string(stream));
+        auto value = TRY(read_string(stream));
+        response.headers.set(move(name), move(value));
+    }
+    u64 body_size = TRY(stream.read_value<LittleEndian<u64>>());
+    if (body_size > stream.remaining())
+        return Error::from_string_literal("Truncated cache entry");
+    response.body = TRY(ByteBuffer::create_uninitialized(body_size));
+    TRY(stream.read_until_filled(response.body));
+    return response;
+}
+
+static ByteString cache_key_for_url(URL::URL const& url)
+{
+    // Fragments are never sent to the server, so they can't influence the response.
+    auto digest = Crypto::Hash::SHA256::hash(url.serialize(URL::ExcludeFragment::Yes));
+    return encode_hex(digest.bytes());
+}
+
+// https://httpwg.org/specs/rfc9111.html#field.cache-control
+static HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> parse_cache_control(HTTP::HeaderMap const& headers)
+{
+    HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> directives;
+    for (auto const& header : headers.headers()) {
+        if (!header.name.equals_ignoring_ascii_case("Cache-Control"sv))
+            continue;
+        header.value.view().for_each_split_view(',', SplitBehavior::Nothing, [&](StringView directive) {
+            directive = directive.trim_whitespace();
+            if (directive.is_empty())
+                return;
+            auto equals_index = directive.find('=');
+            if (!equals_index.has_value()) {
+                directives.set(directive, {});
+                return;
+            }
+            auto name = directive.substring_view(0, *equals_index).trim_whitespace();
+            auto argument = directive.substring_view(*equals_index + 1).trim_whitespace().trim("\""sv);
+            directives.set(name, argument);
+        });
+    }
+    return directives;
+}
+
+static Optional<i64> parse_delta_seconds(HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const& directives, StringView name)
+{
+    auto argument = directives.get(name);
+    if (!argument.has_value())
+        return {};
+    return argument->to_number<i64>();
+}
+
+// https://httpwg.org/specs/rfc9110.html#http.date
+static Optional<UnixDateTime> parse_http_date(Optional<ByteString> const& value)
+{
+    if (!value.has_value())
+        return {};
+    auto date = Core::DateTime::parse("%a, %d %b %Y %H:%M:%S %Z"sv, *value);
+    if (!date.has_value())
+        return {};
+    return UnixDateTime::from_seconds_since_epoch(date->timestamp());
+}
+
+// https://httpwg.org/specs/rfc9110.html#overview.of.status.codes
+static bool is_heuristically_cacheable_status(u32 status_code)
+{
+    switch (status_code) {
+    case 200:
+    case 203:
+    case 204:
+    case 300:
+    case 301:
+    case 308:
+    case 404:
+    case 405:
+    case 410:
+    case 414:
+    case 501:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
+static AK::Duration freshness_lifetime(StoredResponse const& response)
+{
+    auto directives = parse_cache_control(response.headers);
+
+    // If the cache is shared and the s-maxage response directive is present, use its value, or
+    // NOTE: We are a private cache, so that doesn't apply.
+
+    // If the max-age response directive is present, use its value, or
+    if (auto max_age = parse_delta_seconds(directives, "max-age"sv); max_age.has_value())
+        return AK::Duration::from_seconds(*max_age);
+
+    auto date = parse_http_date(response.headers.get("Date")).value_or(response.response_time);
+
+    // If the Expires response header field is present, use its value minus the value of the Date response header field, or
+    if (response.headers.contains("Expires")) {
+        // A cache recipient MUST interpret invalid date formats, especially the value "0", as representing a time in the past.
+        auto expires = parse_http_date(response.headers.get("Expires"));
+        if (!expires.has_value())
+            return {};
+        return *expires - date;
+    }
+
+    // Otherwise, no explicit expiration time is present in the response. A heuristic freshness lifetime might be applicable.
+    // https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+    if (!is_heuristically_cacheable_status(response.status_code))
+        return {};
+    auto last_modified = parse_http_date(response.headers.get("Last-Modified"));
+    if (!last_modified.has_value() || *last_modified > date)
+        return {};
+
+    // If the response has a Last-Modified header field, caches are encouraged to use a heuristic expiration value that is
+    // no more than some fraction of the interval since that time. A typical setting of this fraction might be 10%.
+    return AK::Duration::from_seconds((date - *last_modified).to_seconds() / 10);
+}
+
+// https://httpwg.org/specs/rfc9111.html#age.calculations
+static AK::Duration current_age(StoredResponse const& response, UnixDateTime now)
+{
+    auto age_value = AK::Duration::from_seconds(response.headers.get("Age").value_or("0").to_number<i64>().value_or(0));
+    auto date_value = parse_http_date(response.headers.get("Date")).value_or(response.response_time);
+
+    auto apparent_age = max(AK::Duration {}, response.response_time - date_value);
+    auto response_delay = response.response_time - response.request_time;
+    auto corrected_age_value = age_value + response_delay;
+    auto corrected_initial_age = max(apparent_age, corrected_age_value);
+
+    auto resident_time = now - response.response_time;
+    return corrected_initial_age + resident_time;
+}
+
+NonnullOwnPtr<DiskCache> DiskCache::create(ByteString directory, u64 maximum_size)
+{
+    auto cache = adopt_own(*new DiskCache(move(directory), maximum_size));
+    cache->load_index();
+    return cache;
+}
+
+DiskCache::DiskCache(ByteString directory, u64 maximum_size)
+    : m_directory(move(directory))
+    , m_maximum_size(maximum_size)
+{
+}
+
+DiskCache::~DiskCache()
+{
+    // NOTE: Finish writing the responses that were stored last, instead of dropping them.
+    m_io_thread.wait_for_all();
+}
+
+void DiskCache::load_index()
+{
+    // NOTE: Until the index has been read, every lookup misses. Responses stored in the meantime take precedence over
+    //       what's on disk, as they're written after the index has been read.
+    // NOTE: The I/O thread gets a copy of the directory's path that isn't shared with ours, as ByteStrings aren't
+    //       reference counted atomically. The same goes for everything else we hand over to it.
+    (void)m_io_thread.submit([this, directory = ByteString(m_directory.view()), &event_loop = Core::EventLoop::current()] {
+        auto index_or_error = read_index(directory);
+        event_loop.deferred_invoke([this, index_or_error = move(index_or_error)]() mutable {
+            if (index_or_error.is_error()) {
+                dbgln("DiskCache: Unable to read the index of {}: {}", m_directory, index_or_error.error());
+                return;
+            }
+            for (auto& it : index_or_error.value()) {
+                if (m_index.contains(it.key))
+                    continue;
+                m_total_size += it.value.size;
+                m_index.set(it.key, it.value);
+            }
+            evict_least_recently_used_entries();
+        });
+        event_loop.wake();
+    });
+}
+
+ErrorOr<HashMap<ByteString, DiskCache::IndexEntry>> DiskCache::read_index(ByteString const& directory)
+{
+    TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+
+    Core::DirIterator iterator { directory, Core::DirIterator::SkipDots };
+    if (iterator.has_error())
+        return iterator.error();
+
+    HashMap<ByteString, IndexEntry> index;
+    while (iterator.has_next()) {
+        auto name = iterator.next_path();
+        auto path = ByteString::formatted("{}/{}", directory, name);
+
+        // NOTE: Temporary files are left behind by writes that were interrupted, they never become entries.
+        if (name.ends_with(".tmp"sv)) {
+            (void)Core::System::unlink(path);
+            continue;
+        }
+
+        auto stat = Core::System::stat(path);
+        if (stat.is_error() || !S_ISREG(stat.value().st_mode))
+            continue;
+
+        // NOTE: We don't record accesses on disk, so the modification time will have to do as the last access of entries from earlier sessions.
+        IndexEntry entry {
+            .size = static_cast<u64>(stat.value().st_size),
+            .last_access = UnixDateTime::from_seconds_since_epoch(stat.value().st_mtime),
+        };
+        index.set(move(name), entry);
+    }
+    return index;
+}
+
+ByteString DiskCache::path_for_key(StringView key) const
+{
+    return ByteString::formatted("{}/{}", m_directory, key);
+}
+
+void DiskCache::remove_entry(ByteString const& key)
+{
+    auto entry = m_index.take(key);
+    if (!entry.has_value())
+        return;
+    m_total_size -= entry->size;
+    (void)m_io_thread.submit([path = path_for_key(key)] {
+        (void)Core::System::unlink(path);
+    });
+}
+
+void DiskCache::evict_least_recently_used_entries()
+{
+    if (m_total_size <= m_maximum_size)
+        return;
+
+    Vector<ByteString> keys;
+    keys.ensure_capacity(m_index.size());
+    for (auto const& it : m_index)
+        keys.append(it.key);
+    quick_sort(keys, [&](auto const& a, auto const& b) {
+        return m_index.get(a)->last_access < m_index.get(b)->last_access;
+    });
+
+    // NOTE: Evict down to a bit below the limit, so that we don't have to do this again on the very next store.
+    auto target_size = m_maximum_size / 10 * 9;
+    for (auto const& key : keys) {
+        if (m_total_size <= target_size)
+            break;
+        remove_entry(key);
+    }
+}
+
+void DiskCache::open_entry(URL::URL const& url, HTTP::HeaderMap const& request_headers, Function<void(Optional<CachedResponse>)> on_complete)
+{
+    auto key = cache_key_for_url(url);
+    if (!m_index.contains(key)) {
+        on_complete({});
+        return;
+    }
+
+    auto path = path_for_key(key);
+    (void)m_io_thread.submit([this, path = move(path), key = move(key), url, request_headers, on_complete = move(on_complete), &event_loop = Core::EventLoop::current()]() mutable {
+        auto load = [&]() -> ErrorOr<StoredResponse> {
+            auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+            return deserialize_stored_response(TRY(file->read_until_eof()));
+        };
+        event_loop.deferred_invoke([this, key = move(key), url = move(url), request_headers = move(request_headers), on_complete = move(on_complete), stored_response_or_error = load()]() mutable {
+            on_complete(finish_opening_entry(key, url, request_headers, move(stored_response_or_error)));
+        });
+        event_loop.wake();
+    });
+}
+
+Optional<DiskCache::CachedResponse> DiskCache::finish_opening_entry(ByteString const& key, URL::URL const& url, HTTP::HeaderMap const& request_headers, ErrorOr<StoredResponse> stored_response_or_error)
+{
+    if (stored_response_or_error.is_error()) {
+        dbgln("DiskCache: Dropping unreadable entry for {}: {}", url, stored_response_or_error.error());
+        remove_entry(key);
+        return {};
+    }
+    auto stored_response = stored_response_or_error.release_value();
+
+    // When presented with a request, a cache MUST NOT reuse a stored response unless:
+
+    // - the presented target URI and that of the stored response match, and
+    if (stored_response.url != url.serialize(URL::ExcludeFragment::Yes))
+        return {};
+
+    // - the request method associated with the stored response allows it to be used for the presented request, and
+    // NOTE: We only ever store responses to GET requests, and the caller only asks for those.
+
+    // - request header fields nominated by the stored response (if any) match those presented, and
+    // NOTE: We don't store responses that nominate any header field but Accept-Encoding, which is always the same for us.
+
+    // NOTE: The entry may have been evicted while it was being read.
+    if (auto it = m_index.find(key); it != m_index.end())
+        it->value.last_access = UnixDateTime::now();
+
+    CachedResponse response {
+        .status_code = stored_response.status_code,
+        .headers = move(stored_response.headers),
+        .body = move(stored_response.body),
+        .needs_validation = false,
+    };
+
+    // - the stored response does not contain the no-cache directive, unless it is successfully validated, and
+    auto response_directives = parse_cache_control(response.headers);
+    auto request_directives = parse_cache_control(request_headers);
+    if (response_directives.contains("no-cache"sv) || request_directives.contains("no-cache"sv)) {
+        response.needs_validation = true;
+        return response;
+    }
+
+    // - the stored response is one of the following: fresh, allowed to be served stale, or successfully validated.
+    // https://httpwg.org/specs/rfc9111.html#expiration.model
+    stored_response.headers = response.headers;
+    auto lifetime = freshness_lifetime(stored_response);
+    auto age = current_age(stored_response, UnixDateTime::now());
+
+    // https://httpwg.org/specs/rfc9111.html#cache-request-directive.max-age
+    if (auto max_age = parse_delta_seconds(request_directives, "max-age"sv); max_age.has_value())
+        lifetime = min(lifetime, AK::Duration::from_seconds(*max_age));
+
+    // NOTE: Serving stale responses (e.g. for stale-while-revalidate) would need a revalidation that isn't tied to a
+    //       request from a client, so every stale response is validated before it's used.
+    response.needs_validation = lifetime <= age;
+    return response;
+}
+
+bool DiskCache::may_be_used_for_request(ByteString const& method, HTTP::HeaderMap const& request_headers)
+{
+    // NOTE: The only method whose responses we understand is GET.
+    if (method != "GET"sv)
+        return false;
+
+    // https://httpwg.org/specs/rfc9111.html#cache-request-directive.no-store
+    if (parse_cache_control(request_headers).contains("no-store"sv))
+        return false;
+
+    // AD-HOC: Requests that carry credentials, ranges or conditional header fields from the client are left alone, the
+    //         client is then doing its own caching or authentication.
+    return !request_headers.contains("Authorization")
+        && !request_headers.contains("Range")
+        && !request_headers.contains("If-None-Match")
+        && !request_headers.contains("If-Modified-Since");
+}
+
+bool DiskCache::is_cacheable(u32 status_code, HTTP::HeaderMap const& response_headers)
+{
+    // A cache MUST NOT store a response to a request unless:
+
+    // - the request method is understood by the cache;
+    // NOTE: This is checked by may_be_used_for_request().
+
+    // - the response status code is final;
+    // - if the response status code is 206 or 304, or the must-understand cache directive is present: the cache understands the response status code;
+    // NOTE: We don't understand partial content, and 304 responses are only ever used to freshen a stored response.
+    if (status_code < 200 || status_code == 206 || status_code == 304)
+        return false;
+
+    // - the no-store cache directive is not present in the response;
+    auto directives = parse_cache_control(response_headers);
+    if (directives.contains("no-store"sv))
+        return false;
+
+    // - if the cache is shared: ...
+    // NOTE: We are a private cache.
+
+    // AD-HOC: Replaying a response would set its cookies again, so we don't store those.
+    if (response_headers.contains("Set-Cookie"))
+        return false;
+
+    // AD-HOC: We don't key entries on request header fields, so we can only store responses that vary on Accept-Encoding,
+    //         which is the same for every request we make.
+    if (auto vary = response_headers.get("Vary"); vary.has_value()) {
+        bool varies_on_other_fields = false;
+        vary->view().for_each_split_view(',', SplitBehavior::Nothing, [&](StringView field) {
+            field = field.trim_whitespace();
+            if (!field.is_empty() && !field.equals_ignoring_ascii_case("Accept-Encoding"sv))
+                varies_on_other_fields = true;
+        });
+        if (varies_on_other_fields)
+            return false;
+    }
+
+    // - the response contains at least one of the following: a public response directive; a private response directive,
+    //   if the cache is not shared; an Expires header field; a max-age response directive; ...; or a status code that is
+    //   defined as heuristically cacheable.
+    return directives.contains("public"sv)
+        || directives.contains("private"sv)
+        || directives.contains("max-age"sv)
+        || response_headers.contains("Expires")
+        || is_heuristically_cacheable_status(status_code);
+}
+
+void DiskCache::store_response(URL::URL const& url, u32 status_code, HTTP::HeaderMap const& response_headers, ReadonlyBytes body, UnixDateTime request_time, UnixDateTime response_time)
+{
+    auto key = cache_key_for_url(url);
+
+    // NOTE: This also covers stored responses that were freshened, as a 304 may e.g. add the no-store directive. Those
+    //       mustn't be kept any longer.
+    if (!is_cacheable(status_code, response_headers) || body.size() > maximum_entry_size) {
+        remove_entry(key);
+        return;
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#storing.fields
+    // Caches MUST include all received response header fields — including unrecognized ones — when storing a response,
+    // except for those that are required to be removed before forwarding the message.
+    HTTP::HeaderMap headers;
+    for (auto const& header : response_headers.headers()) {
+        if (header.name.is_one_of_ignoring_ascii_case("Connection"sv, "Proxy-Connection"sv, "Keep-Alive"sv, "TE"sv, "Transfer-Encoding"sv, "Upgrade"sv))
+            continue;
+        headers.set(header.name, header.value);
+    }
+
+    StoredResponse stored_response {
+        .url = url.serialize(URL::ExcludeFragment::Yes),
+        .status_code = status_code,
+        .headers = move(headers),
+        .request_time = request_time,
+        .response_time = response_time,
+        .body = {},
+    };
+    auto body_or_error = ByteBuffer::copy(body);
+    if (body_or_error.is_error())
+        return;
+    stored_response.body = body_or_error.release_value();
+
+    auto data_or_error = serialize_stored_response(stored_response);
+    if (data_or_error.is_error()) {
+        dbgln("DiskCache: Unable to store response for {}: {}", url, data_or_error.error());
+        return;
+    }
+    auto size = data_or_error.value().size();
+
+    // NOTE: If writing the entry fails, reading it fails as well, and it's removed from the index then.
+    (void)m_io_thread.submit([path = path_for_key(key), data = data_or_error.release_value()] {
+        auto write = [&]() -> ErrorOr<void> {
+            // NOTE: Write to a temporary file first, so that a crash can't leave a half-written entry behind.
+            auto temporary_path = ByteString::formatted("{}.tmp", path);
+            auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate, 0600));
+            TRY(file->write_until_depleted(data));
+            file->close();
+            TRY(Core::System::rename(temporary_path, path));
+            return {};
+        };
+        if (auto result = write(); result.is_error())
+            dbgln("DiskCache: Unable to write {}: {}", path, result.error());
+    });
+
+    if (auto previous_entry = m_index.get(key); previous_entry.has_value())
+        m_total_size -= previous_entry->size;
+    m_index.set(key, { .size = size, .last_access = UnixDateTime::now() });
+    m_total_size += size;
+
+    evict_least_recently_used_entries();
+}
+
+void DiskCache::freshen_stored_response(URL::URL const& url, CachedResponse& response, HTTP::HeaderMap const& not_modified_headers, UnixDateTime request_time, UnixDateTime response_time)
+{
+    // For each stored response identified, the cache MUST update its header fields with the header fields provided in
+    // the 304 (Not Modified) response, as per Section 3.2.
+    // https://httpwg.org/specs/rfc9111.html#update
+    auto is_excluded_from_update = [](ByteString const& name) {
+        return name.is_one_of_ignoring_ascii_case("Connection"sv, "Proxy-Connection"sv, "Keep-Alive"sv, "TE"sv, "Transfer-Encoding"sv, "Upgrade"sv, "Content-Length"sv);
+    };
+
+    HTTP::HeaderMap headers;
+    for (auto const& header : response.headers.headers()) {
+        if (is_excluded_from_update(header.name) || !not_modified_headers.contains(header.name))
+            headers.set(header.name, header.value);
+    }
+    for (auto const& header : not_modified_headers.headers()) {
+        if (!is_excluded_from_update(header.name))
+            headers.set(header.name, header.value);
+    }
+    response.headers = move(headers);
+
+    store_response(url, response.status_code, response.headers, response.body, request_time, response_time);
+}
+
+bool DiskCache::add_validators(CachedResponse const& response, HTTP::HeaderMap& request_headers)
+{
+    auto etag = response.headers.get("ETag");
+    auto last_modified = response.headers.get("Last-Modified");
+    if (etag.has_value())
+        request_headers.set("If-None-Match", *etag);
+    if (last_modified.has_value())
+        request_headers.set("If-Modified-Since", *last_modified);
+    return etag.has_value() || last_modified.has_value();
+}
+
+}
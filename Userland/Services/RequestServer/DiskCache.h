@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibThreading/ThreadPool.h>
+#include <LibURL/URL.h>
+
+namespace RequestServer {
+
+struct StoredResponse;
+
+// A private HTTP cache (https://httpwg.org/specs/rfc9111.html) that keeps GET responses on disk, so that they survive a
+// restart of the browser. Every response lives in its own file, named after a hash of its URL.
+// All file system access happens on an I/O thread of the cache's own, in the order it was requested. The index of
+// entries is only ever used on the thread that created the cache.
+class DiskCache {
+public:
+    static NonnullOwnPtr<DiskCache> create(ByteString directory, u64 maximum_size);
+    ~DiskCache();
+
+    struct CachedResponse {
+        u32 status_code { 0 };
+        HTTP::HeaderMap headers;
+        ByteBuffer body;
+
+        // True if the response is stale and has to be validated with the origin server before it may be used.
+        bool needs_validation { false };
+    };
+
+    // Calls on_complete with the stored response once it has been read, or right away if there is no stored response.
+    // https://httpwg.org/specs/rfc9111.html#constructing.responses.from.caches
+    void open_entry(URL::URL const&, HTTP::HeaderMap const& request_headers, ESCAPING Function<void(Optional<CachedResponse>)> on_complete);
+
+    // Whether the cache may be used at all for a request, i.e. to reuse a stored response or to store the response to it.
+    static bool may_be_used_for_request(ByteString const& method, HTTP::HeaderMap const& request_headers);
+
+    // https://httpwg.org/specs/rfc9111.html#response.cacheability
+    static bool is_cacheable(u32 status_code, HTTP::HeaderMap const& response_headers);
+
+    void store_response(URL::URL const&, u32 status_code, HTTP::HeaderMap const& response_headers, ReadonlyBytes body, UnixDateTime request_time, UnixDateTime response_time);
+
+    // https://httpwg.org/specs/rfc9111.html#freshening.responses
+    void freshen_stored_response(URL::URL const&, CachedResponse&, HTTP::HeaderMap const& not_modified_headers, UnixDateTime request_time, UnixDateTime response_time);
+
+    // Adds the conditional request header fields that let the origin server validate a stored response.
+    // Returns false if the stored response has no validators, in which case it can only be replaced.
+    // https://httpwg.org/specs/rfc9111.html#validation.sent
+    static bool add_validators(CachedResponse const&, HTTP::HeaderMap& request_headers);
+
+    // NOTE: We don't keep responses bigger than this around, to keep a single huge download from evicting everything else.
+    static constexpr size_t maximum_entry_size = 16 * MiB;
+
+private:
+    struct IndexEntry {
+        u64 size { 0 };
+        UnixDateTime last_access;
+    };
+    DiskCache(ByteString directory, u64 maximum_size);
+
+    void load_index();
+    static ErrorOr<HashMap<ByteString, IndexEntry>> read_index(ByteString const& directory);
+    Optional<CachedResponse> finish_opening_entry(ByteString const& key, URL::URL const&, HTTP::HeaderMap const& request_headers, ErrorOr<StoredResponse>);
+    ByteString path_for_key(StringView key) const;
+    void remove_entry(ByteString const& key);
+    void evict_least_recently_used_entries();
+
+    ByteString m_directory;
+    u64 m_maximum_size { 0 };
+    u64 m_total_size { 0 };
+    HashMap<ByteString, IndexEntry> m_index;
+    Threading::ThreadPool m_io_thread { 1, "DiskCache I/O"sv };
+};
+
+extern OwnPtr<DiskCache> g_disk_cache;
+
+}
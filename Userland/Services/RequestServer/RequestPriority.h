@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace RequestServer {
+
+// How much a request matters for getting a page on screen, used to prioritize it against other requests on the same connection.
+enum class RequestPriority : u8 {
+    Lowest,
+    Low,
+    Medium,
+    High,
+    Highest,
+};
+
+}
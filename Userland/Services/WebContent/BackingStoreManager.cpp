@@ -40,6 +40,9 @@ void BackingStoreManager::restart_resize_timer()
 
 void BackingStoreManager::reallocate_backing_stores(Gfx::IntSize size)
 {
+    m_front_store_stale_rect.clear();
+    m_back_store_stale_rect.clear();
+
 #ifdef AK_OS_MACOS
     if (s_browser_mach_port.has_value()) {
         auto back_iosurface = Core::IOSurfaceHandle::create(size.width(), size.height());
@@ -130,6 +133,54 @@ void BackingStoreManager::swap_back_and_front()
 {
     swap(m_front_store, m_back_store);
     swap(m_front_bitmap_id, m_back_bitmap_id);
+    swap(m_front_store_stale_rect, m_back_store_stale_rect);
+}
+
+Optional<Vector<Gfx::IntRect>> BackingStoreManager::prepare_back_store_for_next_frame(Optional<Vector<Gfx::IntRect>> damaged_rects, Gfx::IntPoint scroll_delta)
+{
+    if (!damaged_rects.has_value()) {
+        m_front_store_stale_rect.clear();
+        m_back_store_stale_rect = Gfx::IntRect {};
+        return {};
+    }
+
+    Vector<Gfx::IntRect> rects_to_paint;
+    if (!scroll_delta.is_zero() || !m_back_store_stale_rect.has_value()) {
+        // NOTE: The back store would have to be painted all over, but the front store shows the previous frame, so we can
+        //       start out from a copy of that instead.
+        if (m_front_store_stale_rect != Gfx::IntRect {})
+            return prepare_back_store_for_next_frame({}, {});
+        rects_to_paint.extend(copy_front_store_into_back_store(scroll_delta));
+        if (!scroll_delta.is_zero())
+            m_front_store_stale_rect.clear();
+    } else {
+        // NOTE: The back store still shows the frame before the previous one, so it's usually missing the previous frame's damage too.
+        rects_to_paint.append(*m_back_store_stale_rect);
+    }
+
+    for (auto const& damaged_rect : *damaged_rects) {
+        rects_to_paint.append(damaged_rect);
+        if (m_front_store_stale_rect.has_value())
+            m_front_store_stale_rect = m_front_store_stale_rect->united(damaged_rect);
+    }
+    m_back_store_stale_rect = Gfx::IntRect {};
+    return rects_to_paint;
+}
+
+// Copies the front store into the back store, with everything moved up and to the left by the given scroll delta, and
+// returns the parts of the back store that nothing was copied into.
+Vector<Gfx::IntRect, 4> BackingStoreManager::copy_front_store_into_back_store(Gfx::IntPoint scroll_delta)
+{
+    auto& source = m_front_store->bitmap();
+    auto& target = m_back_store->bitmap();
+    VERIFY(source.size() == target.size());
+
+    auto target_rect = target.rect().intersected(source.rect().translated(-scroll_delta));
+    for (int y = target_rect.top(); y < target_rect.bottom(); ++y) {
+        auto const* source_pixels = source.scanline(y + scroll_delta.y()) + target_rect.left() + scroll_delta.x();
+        memcpy(target.scanline(y) + target_rect.left(), source_pixels, target_rect.width() * sizeof(Gfx::ARGB32));
+    }
+    return target.rect().shatter(target_rect);
 }
 
 }
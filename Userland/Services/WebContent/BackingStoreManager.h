@@ -32,9 +32,16 @@ public:
 
     void swap_back_and_front();
 
+    // Gets the back store as close to the next frame as possible without painting, and returns the parts of it that still
+    // have to be painted. The next frame differs from the previous one in the given rects, and by everything having moved
+    // by the given scroll delta. An empty Optional means the whole back store has to be painted.
+    Optional<Vector<Gfx::IntRect>> prepare_back_store_for_next_frame(Optional<Vector<Gfx::IntRect>> damaged_rects, Gfx::IntPoint scroll_delta);
+
     BackingStoreManager(PageClient&);
 
 private:
+    Vector<Gfx::IntRect, 4> copy_front_store_into_back_store(Gfx::IntPoint scroll_delta);
+
     // FIXME: We should come up with an ownership model for this class that makes the GC-checker happy
     IGNORE_GC PageClient& m_page_client;
 
@@ -44,6 +51,10 @@ private:
     OwnPtr<Web::Painting::BackingStore> m_back_store;
     int m_next_bitmap_id { 0 };
 
+    // The parts of each backing store that don't show the latest frame yet, or an empty Optional if nothing they show can be kept.
+    Optional<Gfx::IntRect> m_front_store_stale_rect;
+    Optional<Gfx::IntRect> m_back_store_stale_rect;
+
     RefPtr<Core::Timer> m_backing_store_shrink_timer;
 };
 
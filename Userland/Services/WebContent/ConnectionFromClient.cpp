@@ -13,13 +13,16 @@
 #include <AK/QuickSort.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/Font/TypefaceSkia.h>
 #include <LibGfx/SystemTheme.h>
+#include <LibIPC/Statistics.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/Date.h>
 #include <LibUnicode/TimeZone.h>
 #include <LibWeb/ARIA/RoleType.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/CSS/DecodedFontCache.h>
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/CharacterData.h>
@@ -30,6 +33,7 @@
 #include <LibWeb/Dump.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/HTMLInputElement.h>
+#include <LibWeb/HTML/ListOfAvailableImages.h>
 #include <LibWeb/HTML/SelectedFile.h>
 #include <LibWeb/HTML/Storage.h>
 #include <LibWeb/HTML/TraversableNavigable.h>
@@ -51,6 +55,10 @@
 #include <WebContent/PageHost.h>
 #include <WebContent/WebContentClientEndpoint.h>
 
+#if defined(AK_LIBC_GLIBC)
+#    include <malloc.h>
+#endif
+
 namespace WebContent {
 
 ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> socket)
@@ -357,6 +365,20 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString const& request,
         return;
     }
 
+    if (request == "js-sampling-profiler") {
+        auto& vm = Web::Bindings::main_thread_vm();
+        if (argument == "on") {
+            if (!vm.sampling_profiler())
+                vm.start_sampling_profiler();
+            return;
+        }
+        if (auto sampling_profiler = vm.stop_sampling_profiler()) {
+            dbgln("JS sampling profile ({} samples, in collapsed stack format):", sampling_profiler->sample_count());
+            dbgln("{}", sampling_profiler->to_collapsed_stacks());
+        }
+        return;
+    }
+
     if (request == "set-line-box-borders") {
         bool state = argument == "on";
         page->set_should_show_line_box_borders(state);
@@ -389,6 +411,11 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString const& request,
         return;
     }
 
+    if (request == "dump-ipc-statistics") {
+        IPC::Statistics::dump();
+        return;
+    }
+
     if (request == "dump-local-storage") {
         if (auto* document = page->page().top_level_browsing_context().active_document())
             document->window()->local_storage().release_value_but_fixme_should_propagate_errors()->dump();
@@ -903,6 +930,28 @@ static void append_gc_graph(StringBuilder& builder)
     gc_graph.serialize(builder);
 }
 
+static void append_rendering_statistics(Web::Page& page, StringBuilder& builder)
+{
+    auto* document = page.top_level_browsing_context().active_document();
+    if (!document) {
+        builder.append("(no DOM tree)"sv);
+        return;
+    }
+
+    builder.append(document->rendering_statistics().to_json());
+}
+
+static void append_paint_trace(Web::Page& page, StringBuilder& builder)
+{
+    auto const* paint_trace = page.top_level_traversable()->paint_trace();
+    if (!paint_trace) {
+        builder.append("(paint tracing is not enabled)"sv);
+        return;
+    }
+
+    builder.append(paint_trace->to_chrome_trace_json());
+}
+
 void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::PageInfoType type)
 {
     auto page = this->page(page_id);
@@ -935,6 +984,18 @@ void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::Page
         append_gc_graph(builder);
     }
 
+    if (has_flag(type, WebView::PageInfoType::RenderingStatistics)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        append_rendering_statistics(page->page(), builder);
+    }
+
+    if (has_flag(type, WebView::PageInfoType::PaintTrace)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        append_paint_trace(page->page(), builder);
+    }
+
     async_did_get_internal_page_info(page_id, type, MUST(builder.to_string()));
 }
 
@@ -1070,6 +1131,12 @@ void ConnectionFromClient::set_device_pixels_per_css_pixel(u64 page_id, float de
         page->set_device_pixels_per_css_pixel(device_pixels_per_css_pixel);
 }
 
+void ConnectionFromClient::set_maximum_frames_per_second(u64 page_id, double maximum_frames_per_second)
+{
+    if (auto page = this->page(page_id); page.has_value())
+        page->set_maximum_frames_per_second(maximum_frames_per_second);
+}
+
 void ConnectionFromClient::set_window_position(u64 page_id, Web::DevicePixelPoint position)
 {
     if (auto page = this->page(page_id); page.has_value())
@@ -1131,6 +1198,7 @@ void ConnectionFromClient::set_system_visibility_state(u64 page_id, bool visible
             visible
                 ? Web::HTML::VisibilityState::Visible
                 : Web::HTML::VisibilityState::Hidden);
+        page->set_is_visible(visible);
     }
 }
 
@@ -1238,4 +1306,30 @@ void ConnectionFromClient::system_time_zone_changed()
     Unicode::clear_system_time_zone_cache();
 }
 
+void ConnectionFromClient::local_storage_changed(String const& origin, Optional<String> const& key, Optional<String> const& value, bool is_own_change)
+{
+    Web::HTML::Storage::apply_local_storage_change(origin, key, value, is_own_change);
+}
+
+void ConnectionFromClient::memory_pressure_detected()
+{
+    // NOTE: Everything that is dropped here is only being kept around in case it's needed again, anything that a page is
+    //       still using stays alive.
+    for (auto* navigable : Web::HTML::all_navigables()) {
+        if (auto document = navigable->active_document())
+            document->list_of_available_images().clear();
+    }
+    Web::ResourceLoader::the().clear_cache();
+    Web::CSS::DecodedFontCache::the().clear();
+    Gfx::TypefaceSkia::purge_glyph_cache();
+
+    auto& heap = Web::Bindings::main_thread_vm().heap();
+    heap.collect_garbage();
+    heap.release_free_blocks();
+
+#if defined(AK_LIBC_GLIBC)
+    malloc_trim(0);
+#endif
+}
+
 }
@@ -103,6 +103,7 @@ private:
     virtual void set_has_focus(u64 page_id, bool) override;
     virtual void set_is_scripting_enabled(u64 page_id, bool) override;
     virtual void set_device_pixels_per_css_pixel(u64 page_id, float) override;
+    virtual void set_maximum_frames_per_second(u64 page_id, double) override;
     virtual void set_window_position(u64 page_id, Web::DevicePixelPoint) override;
     virtual void set_window_size(u64 page_id, Web::DevicePixelSize) override;
     virtual void handle_file_return(u64 page_id, i32 error, Optional<IPC::File> const& file, i32 request_id) override;
@@ -148,6 +149,8 @@ private:
     virtual void paste(u64 page_id, String const& text) override;
 
     virtual void system_time_zone_changed() override;
+    virtual void local_storage_changed(String const& origin, Optional<String> const& key, Optional<String> const& value, bool is_own_change) override;
+    virtual void memory_pressure_detected() override;
 
     void report_finished_handling_input_event(u64 page_id, Web::EventResult event_was_handled);
 
@@ -21,9 +21,12 @@ public:
     ImageCodecPluginSerenity();
     virtual ~ImageCodecPluginSerenity() override;
 
-    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) override;
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size) override;
+    virtual RefPtr<Web::Platform::DecodingSession> start_decoding_session() override;
 
 private:
+    ImageDecoderClient::Client& client();
+
     RefPtr<ImageDecoderClient::Client> m_client;
 };
 
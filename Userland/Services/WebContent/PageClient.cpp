@@ -53,7 +53,8 @@ PageClient::PageClient(PageHost& owner, u64 id)
 {
     setup_palette();
 
-    int refresh_interval = 1000 / 60; // FIXME: Account for the actual refresh rate of the display
+    // NOTE: This is replaced by the refresh rate of the display once the UI process tells us about it.
+    int refresh_interval = 1000 / 60;
     m_paint_refresh_timer = Core::Timer::create_repeating(refresh_interval, [] {
         Web::HTML::main_thread_event_loop().queue_task_to_update_the_rendering();
     });
@@ -68,6 +69,43 @@ bool PageClient::is_ready_to_paint() const
     return m_paint_state == PaintState::Ready;
 }
 
+bool PageClient::is_visible_for_rendering() const
+{
+    // NOTE: Screenshots are taken during rendering updates, so a hidden page still gets them while any are requested.
+    return m_is_visible || !m_screenshot_tasks.is_empty();
+}
+
+void PageClient::set_maximum_frames_per_second(double maximum_frames_per_second)
+{
+    if (maximum_frames_per_second <= 0)
+        return;
+
+    auto refresh_interval = max(static_cast<int>(1000.0 / maximum_frames_per_second), 1);
+    if (refresh_interval == m_paint_refresh_timer->interval())
+        return;
+
+    m_paint_refresh_timer->set_interval(refresh_interval);
+    update_paint_refresh_timer();
+}
+
+void PageClient::set_is_visible(bool is_visible)
+{
+    m_is_visible = is_visible;
+    update_paint_refresh_timer();
+}
+
+// NOTE: The refresh timer only runs while the page is visible for rendering, so that hidden pages don't wake us up for
+//       frames that they won't render anyway.
+void PageClient::update_paint_refresh_timer()
+{
+    if (is_visible_for_rendering()) {
+        if (!m_paint_refresh_timer->is_active())
+            m_paint_refresh_timer->start();
+    } else {
+        m_paint_refresh_timer->stop();
+    }
+}
+
 void PageClient::ready_to_paint()
 {
     m_paint_state = PaintState::Ready;
@@ -89,7 +127,12 @@ ConnectionFromClient& PageClient::client() const
 
 void PageClient::set_has_focus(bool has_focus)
 {
+    if (m_has_focus == has_focus)
+        return;
     m_has_focus = has_focus;
+
+    // NOTE: Focus changes how the page is painted without damaging any part of it, so make sure the next frame repaints everything.
+    page().top_level_traversable()->set_needs_display();
 }
 
 void PageClient::setup_palette()
@@ -188,6 +231,8 @@ void PageClient::process_screenshot_requests()
             client().async_did_take_screenshot(m_id, bitmap->to_shareable_bitmap());
         }
     }
+
+    update_paint_refresh_timer();
 }
 
 void PageClient::paint_next_frame()
@@ -197,7 +242,29 @@ void PageClient::paint_next_frame()
         return;
 
     auto viewport_rect = page().css_to_device_rect(page().top_level_traversable()->viewport_rect());
-    paint(viewport_rect, *back_store);
+
+    Optional<Vector<Gfx::IntRect>> damaged_rects;
+    Gfx::IntPoint scroll_delta;
+    if (auto document = page().top_level_traversable()->active_document()) {
+        auto damage = document->take_viewport_damage();
+        damaged_rects = Vector<Gfx::IntRect> {};
+        for (auto const& rect : damage.damaged_rects)
+            damaged_rects->append(page().enclosing_device_rect(rect).to_type<int>());
+
+        // NOTE: We can only move the previous frame's pixels by whole device pixels.
+        auto device_scroll_delta = damage.scroll_delta.to_type<double>().scaled(device_pixels_per_css_pixel());
+        scroll_delta = device_scroll_delta.to_type<int>();
+        if (scroll_delta.to_type<double>() != device_scroll_delta)
+            damaged_rects.clear();
+    }
+
+    Web::PaintOptions paint_options;
+    if (auto rects_to_repaint = m_backing_store_manager.prepare_back_store_for_next_frame(move(damaged_rects), scroll_delta); rects_to_repaint.has_value()) {
+        paint_options.rects_to_repaint = Vector<Web::DevicePixelRect> {};
+        for (auto const& rect : *rects_to_repaint)
+            paint_options.rects_to_repaint->append(rect.to_type<Web::DevicePixels>());
+    }
+    paint(viewport_rect, *back_store, paint_options);
 
     m_backing_store_manager.swap_back_and_front();
 
@@ -850,5 +917,6 @@ void PageClient::queue_screenshot_task(Optional<Web::UniqueNodeID> node_id)
 {
     m_screenshot_tasks.enqueue({ node_id });
     page().top_level_traversable()->set_needs_display();
+    update_paint_refresh_timer();
 }
 }
@@ -35,6 +35,7 @@ public:
     static void set_use_skia_painter(UseSkiaPainter);
 
     virtual bool is_ready_to_paint() const override;
+    virtual bool is_visible_for_rendering() const override;
 
     virtual Web::Page& page() override { return *m_page; }
     virtual Web::Page const& page() const override { return *m_page; }
@@ -49,6 +50,8 @@ public:
     void set_viewport_size(Web::DevicePixelSize const&);
     void set_screen_rects(Vector<Web::DevicePixelRect, 4> const& rects, size_t main_screen_index) { m_screen_rect = rects[main_screen_index]; }
     void set_device_pixels_per_css_pixel(float device_pixels_per_css_pixel) { m_device_pixels_per_css_pixel = device_pixels_per_css_pixel; }
+    void set_maximum_frames_per_second(double);
+    void set_is_visible(bool);
     void set_preferred_color_scheme(Web::CSS::PreferredColorScheme);
     void set_preferred_contrast(Web::CSS::PreferredContrast);
     void set_preferred_motion(Web::CSS::PreferredMotion);
@@ -187,6 +190,7 @@ private:
     u64 m_id { 0 };
     bool m_should_show_line_box_borders { false };
     bool m_has_focus { false };
+    bool m_is_visible { true };
 
     enum class PaintState {
         Ready,
@@ -212,6 +216,8 @@ private:
 
     JS::Handle<JS::GlobalObject> m_console_global_object;
 
+    void update_paint_refresh_timer();
+
     RefPtr<Core::Timer> m_paint_refresh_timer;
 };
 
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <WebContent/ConnectionFromClient.h>
+#include <WebContent/StoragePlugin.h>
+
+namespace WebContent {
+
+StoragePlugin::StoragePlugin(ConnectionFromClient& client)
+    : m_client(client)
+{
+}
+
+StoragePlugin::~StoragePlugin() = default;
+
+OrderedHashMap<String, String> StoragePlugin::load_local_storage(String const& origin)
+{
+    auto response = m_client->send_sync_but_allow_failure<Messages::WebContentClient::DidRequestLocalStorage>(origin);
+    if (!response) {
+        dbgln("WebContent client disconnected during DidRequestLocalStorage. Exiting peacefully.");
+        exit(0);
+    }
+    return response->take_items();
+}
+
+void StoragePlugin::set_local_storage_item(String const& origin, String const& key, String const& value)
+{
+    m_client->async_did_set_local_storage_item(origin, key, value);
+}
+
+void StoragePlugin::remove_local_storage_item(String const& origin, String const& key)
+{
+    m_client->async_did_remove_local_storage_item(origin, key);
+}
+
+void StoragePlugin::clear_local_storage(String const& origin)
+{
+    m_client->async_did_clear_local_storage(origin);
+}
+
+}
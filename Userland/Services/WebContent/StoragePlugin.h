@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <LibWeb/Platform/StoragePlugin.h>
+#include <WebContent/Forward.h>
+
+namespace WebContent {
+
+// Keeps local storage in the UI process, which stores it in its database and tells all of its WebContent processes
+// about the changes.
+class StoragePlugin final : public Web::Platform::StoragePlugin {
+public:
+    explicit StoragePlugin(ConnectionFromClient&);
+    virtual ~StoragePlugin() override;
+
+    virtual OrderedHashMap<String, String> load_local_storage(String const& origin) override;
+    virtual void set_local_storage_item(String const& origin, String const& key, String const& value) override;
+    virtual void remove_local_storage_item(String const& origin, String const& key) override;
+    virtual void clear_local_storage(String const& origin) override;
+
+private:
+    NonnullRefPtr<ConnectionFromClient> m_client;
+};
+
+}
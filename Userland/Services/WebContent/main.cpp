@@ -23,6 +23,7 @@
 #include <LibWebView/RequestServerAdapter.h>
 #include <LibWebView/WebSocketClientAdapter.h>
 #include <WebContent/ConnectionFromClient.h>
+#include <WebContent/StoragePlugin.h>
 
 ErrorOr<int> serenity_main(Main::Arguments)
 {
@@ -54,5 +55,6 @@ ErrorOr<int> serenity_main(Main::Arguments)
     TRY(Web::Bindings::initialize_main_thread_vm(Web::HTML::EventLoop::Type::Window));
 
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<WebContent::ConnectionFromClient>());
+    Web::Platform::StoragePlugin::install(*new WebContent::StoragePlugin(*client));
     return event_loop.exec();
 }
@@ -20,11 +20,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool keep_input_files { false };
     bool write_to_stdout { false };
     bool decompress { false };
+    size_t thread_count { 1 };
 
     Core::ArgsParser args_parser;
     args_parser.add_option(keep_input_files, "Keep (don't delete) input files", "keep", 'k');
     args_parser.add_option(write_to_stdout, "Write to stdout, keep original files unchanged", "stdout", 'c');
     args_parser.add_option(decompress, "Decompress", "decompress", 'd');
+    args_parser.add_option(thread_count, "Compress on this many threads, or one per core if 0", "threads", 'p', "count");
     args_parser.add_positional_argument(filenames, "Files", "FILES", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -74,14 +76,22 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (decompress) {
             input_stream = TRY(try_make<Compress::GzipDecompressor>(move(input_stream)));
         } else {
-            output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull()));
+            output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull(), thread_count));
         }
 
-        auto buffer = TRY(ByteBuffer::create_uninitialized(1 * MiB));
+        // NOTE: Every write to the compressor produces a gzip member of its own, so when compressing on several threads, we
+        //       fill the buffer with enough data to give each of them a few chunks of every member to work on.
+        bool compress_in_parallel = !decompress && thread_count != 1;
+        auto buffer_size = 1 * MiB;
+        if (compress_in_parallel)
+            buffer_size = max(buffer_size, (thread_count == 0 ? Core::System::hardware_concurrency() : thread_count) * 4 * Compress::DeflateCompressor::parallel_chunk_size);
+        auto buffer = TRY(ByteBuffer::create_uninitialized(buffer_size));
 
         while (!input_stream->is_eof()) {
-            auto span = TRY(input_stream->read_some(buffer));
-            TRY(output_stream->write_until_depleted(span));
+            auto buffer_used = TRY(input_stream->read_some(buffer)).size();
+            while (compress_in_parallel && buffer_used < buffer.size() && !input_stream->is_eof())
+                buffer_used += TRY(input_stream->read_some(buffer.bytes().slice(buffer_used))).size();
+            TRY(output_stream->write_until_depleted(buffer.bytes().trim(buffer_used)));
         }
 
         if (!keep_input_files)
@@ -7,6 +7,7 @@
  */
 
 #include <AK/JsonValue.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
@@ -77,6 +78,7 @@ static bool s_as_module = false;
 static bool s_print_last_result = false;
 static bool s_strip_ansi = false;
 static bool s_disable_source_location_hints = false;
+static bool s_dump_property_lookup_cache_statistics = false;
 static RefPtr<Line::Editor> s_editor;
 static String s_history_path = String {};
 static int s_repl_line_level = 0;
@@ -532,6 +534,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool disable_debug_printing = false;
     bool use_test262_global = false;
     StringView evaluate_script;
+    StringView sampling_profile_path;
     Vector<StringView> script_paths;
 
     Core::ArgsParser args_parser;
@@ -542,22 +545,51 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
+    args_parser.add_option(s_dump_property_lookup_cache_statistics, "Dump property lookup cache statistics on exit", "dump-property-lookup-cache-statistics", {});
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
     args_parser.add_option(use_test262_global, "Use test262 global ($262)", "use-test262-global", {});
+    args_parser.add_option(sampling_profile_path, "Sample the call stack, and write the samples in collapsed stack format to a file on exit", "sampling-profile", {}, "path");
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
     bool syntax_highlight = !disable_syntax_highlight;
 
+    ScopeGuard dump_property_lookup_cache_statistics = [] {
+        if (!s_dump_property_lookup_cache_statistics)
+            return;
+        auto const& statistics = JS::Bytecode::PropertyLookupCache::statistics();
+        warnln("Property lookup cache statistics:");
+        warnln("    Sites that became monomorphic: {}", statistics.sites_that_became_monomorphic);
+        warnln("    Sites that became polymorphic: {}", statistics.sites_that_became_polymorphic);
+        warnln("    Sites that became megamorphic: {}", statistics.sites_that_became_megamorphic);
+    };
+
     AK::set_debug_enabled(!disable_debug_printing);
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
 
     g_vm = TRY(JS::VM::create());
     g_vm->set_dynamic_imports_allowed(true);
 
+    if (!sampling_profile_path.is_empty())
+        g_vm->start_sampling_profiler();
+
+    ScopeGuard write_sampling_profile = [&] {
+        auto sampling_profiler = g_vm->stop_sampling_profiler();
+        if (!sampling_profiler)
+            return;
+        auto file = Core::File::open(sampling_profile_path, Core::File::OpenMode::Write);
+        if (file.is_error()) {
+            warnln("Failed to open {} for writing: {}", sampling_profile_path, file.error());
+            return;
+        }
+        auto collapsed_stacks = sampling_profiler->to_collapsed_stacks();
+        if (auto result = file.value()->write_until_depleted(collapsed_stacks.bytes()); result.is_error())
+            warnln("Failed to write sampling profile to {}: {}", sampling_profile_path, result.error());
+    };
+
     if (!disable_debug_printing) {
         // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
         // which is, as far as I can tell, correct - a promise is created, rejected without handler, and a
@@ -8,6 +8,7 @@
 #include <AK/GenericLexer.h>
 #include <AK/Hex.h>
 #include <AK/MemoryStream.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StackInfo.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
@@ -15,8 +16,12 @@
 #include <LibFileSystem/FileSystem.h>
 #include <LibLine/Editor.h>
 #include <LibMain/Main.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/Profiler.h>
+#include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 #include <LibWasm/Types.h>
 #include <LibWasm/Wasi.h>
@@ -514,6 +519,158 @@ static void print_link_error(Wasm::LinkError const& error)
         warnln("Missing import '{}'", missing);
 }
 
+static void link_wasi_imports(Wasm::Linker& linker, Wasm::AbstractMachine& machine, Wasm::Wasi::Implementation& wasi_impl)
+{
+    HashMap<Wasm::Linker::Name, Wasm::ExternValue> wasi_exports;
+    for (auto& entry : linker.unresolved_imports()) {
+        if (entry.module != "wasi_snapshot_preview1"sv)
+            continue;
+        auto function = wasi_impl.function_by_name(entry.name);
+        if (function.is_error()) {
+            dbgln("wasi function {} not implemented :(", entry.name);
+            continue;
+        }
+        auto address = machine.store().allocate(function.release_value());
+        wasi_exports.set(entry, *address);
+    }
+
+    linker.link(wasi_exports);
+}
+
+// Runs an exported function in several independent instances of the same module, each on its own thread.
+// The parsed and validated module is shared between the instances, but each of them gets its own store (and thus
+// its own memories, tables and globals) and its own interpreter for the thread's stack.
+static ErrorOr<int> run_instances_in_parallel(NonnullRefPtr<Wasm::Module> module, ByteString const& function_name, Vector<ParsedValue> const& arguments, size_t instance_count, Function<Wasm::Wasi::Implementation::Details()> make_wasi_details)
+{
+    // NOTE: Validation rewrites the function bodies, so do it once up front rather than in each instance.
+    if (auto result = Wasm::AbstractMachine {}.validate(*module); result.is_error()) {
+        warnln("Module validation failed: {}", result.error().error_string);
+        return 1;
+    }
+
+    struct InstanceResult {
+        Optional<Wasm::FunctionType> type;
+        Vector<Wasm::Value> values;
+        ByteString error;
+        Optional<i32> exit_code;
+    };
+    Vector<InstanceResult> results;
+    results.resize(instance_count);
+
+    // NOTE: Instantiating and tearing down an instance touches the module's (non-atomic) weak link, so those are
+    //       serialized; only the execution itself runs in parallel.
+    Threading::Mutex instantiation_mutex;
+
+    auto run_instance = [&](InstanceResult& instance_result) {
+        StackInfo stack_info;
+        Wasm::BytecodeInterpreter interpreter(stack_info);
+        Optional<Wasm::Wasi::Implementation> wasi_impl;
+        if (make_wasi_details)
+            wasi_impl.emplace(make_wasi_details());
+
+        OwnPtr<Wasm::AbstractMachine> machine = make<Wasm::AbstractMachine>();
+        OwnPtr<Wasm::ModuleInstance> module_instance;
+        Optional<Wasm::FunctionAddress> run_address;
+        Vector<Wasm::Value> values;
+        ScopeGuard tear_down = [&] {
+            Threading::MutexLocker locker(instantiation_mutex);
+            module_instance = nullptr;
+            machine = nullptr;
+        };
+
+        {
+            Threading::MutexLocker locker(instantiation_mutex);
+            Wasm::Linker linker { *module };
+            if (wasi_impl.has_value())
+                link_wasi_imports(linker, *machine, *wasi_impl);
+            auto link_result = linker.finish();
+            if (link_result.is_error()) {
+                instance_result.error = ByteString::formatted("Linking failed, {} import(s) are missing", link_result.error().missing_imports.size());
+                return;
+            }
+            auto result = machine->instantiate(*module, link_result.release_value());
+            if (result.is_error()) {
+                instance_result.error = ByteString::formatted("Module instantiation failed: {}", result.error().error);
+                return;
+            }
+            module_instance = result.release_value();
+
+            for (auto& entry : module_instance->exports()) {
+                if (entry.name() == function_name) {
+                    if (auto address = entry.value().get_pointer<Wasm::FunctionAddress>())
+                        run_address = *address;
+                }
+            }
+            auto* function = run_address.has_value() ? machine->store().get(*run_address) : nullptr;
+            if (!function || !function->has<Wasm::WasmFunction>()) {
+                instance_result.error = "No such exported Wasm function";
+                return;
+            }
+
+            auto pending_arguments = arguments;
+            instance_result.type = function->get<Wasm::WasmFunction>().type();
+            for (auto& parameter : instance_result.type->parameters()) {
+                if (pending_arguments.is_empty()) {
+                    values.append(Wasm::Value(parameter));
+                } else if (parameter == pending_arguments.last().type) {
+                    values.append(pending_arguments.take_last().value);
+                } else {
+                    instance_result.error = "Type mismatch in argument";
+                    return;
+                }
+            }
+        }
+
+        auto result = machine->invoke(interpreter, *run_address, move(values)).assert_wasm_result();
+        if (result.is_trap()) {
+            if (result.trap().reason.starts_with("exit:"sv))
+                instance_result.exit_code = result.trap().reason.substring_view(5).to_number<i32>().value_or(-1);
+            else
+                instance_result.error = ByteString::formatted("Execution trapped: {}", result.trap().reason);
+            return;
+        }
+        instance_result.values = result.values();
+    };
+
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 1; i < instance_count; ++i) {
+        auto thread = TRY(Threading::Thread::try_create([&, i] {
+            run_instance(results[i]);
+            return static_cast<intptr_t>(0);
+        },
+            "Wasm Instance"sv));
+        thread->start();
+        threads.append(move(thread));
+    }
+
+    run_instance(results[0]);
+
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    int exit_code = 0;
+    for (size_t i = 0; i < instance_count; ++i) {
+        auto& result = results[i];
+        if (!result.error.is_empty()) {
+            warnln("Instance {}: {}", i, result.error);
+            exit_code = 1;
+            continue;
+        }
+        if (result.exit_code.has_value()) {
+            warnln("Instance {}: exited with code {}", i, *result.exit_code);
+            if (*result.exit_code != 0)
+                exit_code = -*result.exit_code;
+            continue;
+        }
+        warnln("Instance {} returned:", i);
+        for (size_t index = 0; index < result.values.size(); ++index) {
+            g_stdout->write_until_depleted("  -> "sv.bytes()).release_value_but_fixme_should_propagate_errors();
+            g_printer->print(result.values[index], result.type->results()[index]);
+        }
+    }
+    return exit_code;
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     StringView filename;
@@ -523,6 +680,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool export_all_imports = false;
     bool shell_mode = false;
     bool wasi = false;
+    bool profile = false;
+    size_t instance_count = 1;
     ByteString exported_function_to_execute;
     Vector<ParsedValue> values_to_push;
     Vector<ByteString> modules_to_link_in;
@@ -538,6 +697,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     parser.add_option(export_all_imports, "Export noop functions corresponding to imports", "export-noop");
     parser.add_option(shell_mode, "Launch a REPL in the module's context (implies -i)", "shell", 's');
     parser.add_option(wasi, "Enable WASI", "wasi", 'w');
+    parser.add_option(instance_count, "Run the executed function in this many independent instances of the module in parallel", "instances", 'j', "count");
+    parser.add_option(profile, "Print an execution profile of the executed function (implies -i)", "profile");
     parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
         .help_string = "Directory mappings to expose via WASI",
@@ -599,7 +760,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         old_signal = signal(SIGINT, sigint_handler);
     }
 
-    if (!exported_function_to_execute.is_empty())
+    if (!exported_function_to_execute.is_empty() || profile)
         attempt_instantiate = true;
 
     auto parse_result = parse(filename);
@@ -614,35 +775,49 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         printer.print(*parse_result);
     }
 
+    auto make_wasi_details = [&] {
+        return Wasm::Wasi::Implementation::Details {
+            .provide_arguments = [&] {
+                Vector<String> strings;
+                for (auto& string : args_if_wasi)
+                    strings.append(String::from_utf8(string).release_value_but_fixme_should_propagate_errors());
+                return strings; },
+            .provide_environment = {},
+            .provide_preopened_directories = [&] {
+                Vector<Wasm::Wasi::Implementation::MappedPath> paths;
+                for (auto& string : wasi_preopened_mappings) {
+                    auto split_index = string.find(':');
+                    if (split_index.has_value()) {
+                        LexicalPath host_path { FileSystem::real_path(string.substring_view(0, *split_index)).release_value_but_fixme_should_propagate_errors() };
+                        LexicalPath mapped_path { string.substring_view(*split_index + 1) };
+                        paths.append({move(host_path), move(mapped_path)});
+                    } else {
+                        LexicalPath host_path { FileSystem::real_path(string).release_value_but_fixme_should_propagate_errors() };
+                        LexicalPath mapped_path { string };
+                        paths.append({move(host_path), move(mapped_path)});
+                    }
+                }
+                return paths; },
+        };
+    };
+
+    if (instance_count > 1) {
+        if (exported_function_to_execute.is_empty() || debug || shell_mode || profile || !modules_to_link_in.is_empty()) {
+            warnln("Running multiple instances requires -e, and can't be combined with --debug, --shell, --profile or --link");
+            return 1;
+        }
+        Function<Wasm::Wasi::Implementation::Details()> make_instance_wasi_details;
+        if (wasi)
+            make_instance_wasi_details = [&] { return make_wasi_details(); };
+        return run_instances_in_parallel(parse_result.release_nonnull(), exported_function_to_execute, values_to_push, instance_count, move(make_instance_wasi_details));
+    }
+
     if (attempt_instantiate) {
         Wasm::AbstractMachine machine;
         Optional<Wasm::Wasi::Implementation> wasi_impl;
 
-        if (wasi) {
-            wasi_impl.emplace(Wasm::Wasi::Implementation::Details {
-                .provide_arguments = [&] {
-                    Vector<String> strings;
-                    for (auto& string : args_if_wasi)
-                        strings.append(String::from_utf8(string).release_value_but_fixme_should_propagate_errors());
-                    return strings; },
-                .provide_environment = {},
-                .provide_preopened_directories = [&] {
-                    Vector<Wasm::Wasi::Implementation::MappedPath> paths;
-                    for (auto& string : wasi_preopened_mappings) {
-                        auto split_index = string.find(':');
-                        if (split_index.has_value()) {
-                            LexicalPath host_path { FileSystem::real_path(string.substring_view(0, *split_index)).release_value_but_fixme_should_propagate_errors() };
-                            LexicalPath mapped_path { string.substring_view(*split_index + 1) };
-                            paths.append({move(host_path), move(mapped_path)});
-                        } else {
-                            LexicalPath host_path { FileSystem::real_path(string).release_value_but_fixme_should_propagate_errors() };
-                            LexicalPath mapped_path { string };
-                            paths.append({move(host_path), move(mapped_path)});
-                        }
-                    }
-                    return paths; },
-            });
-        }
+        if (wasi)
+            wasi_impl.emplace(make_wasi_details());
 
         Core::EventLoop main_loop;
         if (debug) {
@@ -651,6 +826,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             g_interpreter.post_interpret_hook = post_interpret_hook;
         }
 
+        Wasm::Profiler profiler;
+        if (profile)
+            profiler.attach(g_interpreter);
+
         // First, resolve the linked modules
         Vector<NonnullOwnPtr<Wasm::ModuleInstance>> linked_instances;
         Vector<NonnullRefPtr<Wasm::Module>> linked_modules;
@@ -676,28 +855,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 return 1;
             }
             linked_instances.append(instantiation_result.release_value());
+            if (profile)
+                profiler.add_module(linked_modules.last(), *linked_instances.last(), machine.store());
         }
 
         Wasm::Linker linker { *parse_result };
         for (auto& instance : linked_instances)
             linker.link(*instance);
 
-        if (wasi) {
-            HashMap<Wasm::Linker::Name, Wasm::ExternValue> wasi_exports;
-            for (auto& entry : linker.unresolved_imports()) {
-                if (entry.module != "wasi_snapshot_preview1"sv)
-                    continue;
-                auto function = wasi_impl->function_by_name(entry.name);
-                if (function.is_error()) {
-                    dbgln("wasi function {} not implemented :(", entry.name);
-                    continue;
-                }
-                auto address = machine.store().allocate(function.release_value());
-                wasi_exports.set(entry, *address);
-            }
-
-            linker.link(wasi_exports);
-        }
+        if (wasi)
+            link_wasi_imports(linker, machine, *wasi_impl);
 
         if (export_all_imports) {
             HashMap<Wasm::Linker::Name, Wasm::ExternValue> exports;
@@ -750,6 +917,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             return 1;
         }
         auto module_instance = result.release_value();
+        if (profile)
+            profiler.add_module(*parse_result, *module_instance, machine.store());
 
         auto launch_repl = [&] {
             Wasm::Configuration config { machine.store() };
@@ -838,6 +1007,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             if (debug)
                 launch_repl();
 
+            if (profile)
+                TRY(profiler.dump(*g_stdout));
+
             if (result.is_trap()) {
                 if (result.trap().reason.starts_with("exit:"sv))
                     return -result.trap().reason.substring_view(5).to_number<i32>().value_or(-1);
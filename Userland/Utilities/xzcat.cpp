@@ -12,13 +12,24 @@
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     StringView filename;
+    size_t thread_count { 1 };
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("Decompress and print an XZ archive");
+    args_parser.add_option(thread_count, "Decompress on this many threads, or one per core if 0", "threads", 'T', "count");
     args_parser.add_positional_argument(filename, "File to decompress", "file");
     args_parser.parse(arguments);
 
     auto file = TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read));
+
+    // NOTE: Blocks can only be decompressed in parallel once we know where they are, so this reads the whole file first.
+    if (thread_count != 1) {
+        auto compressed = TRY(file->read_until_eof());
+        auto decompressed = TRY(Compress::XzDecompressor::decompress_all(compressed, thread_count));
+        out("{:s}", decompressed.bytes());
+        return 0;
+    }
+
     auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
     auto stream = TRY(Compress::XzDecompressor::create(move(buffered_file)));
 